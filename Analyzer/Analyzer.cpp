@@ -199,7 +199,7 @@ std::shared_ptr<Analyzer::Expr> OffsetInFragment::deep_copy() const {
 
 std::shared_ptr<Analyzer::Expr> WindowFunction::deep_copy() const {
   return makeExpr<WindowFunction>(
-      type_info, kind_, args_, partition_keys_, order_keys_, collation_);
+      type_info, kind_, args_, partition_keys_, order_keys_, collation_, frame_);
 }
 
 ExpressionPtr ArrayExpr::deep_copy() const {
@@ -2394,7 +2394,8 @@ bool WindowFunction::operator==(const Expr& rhs) const {
   }
   if (kind_ != rhs_window->kind_ || args_.size() != rhs_window->args_.size() ||
       partition_keys_.size() != rhs_window->partition_keys_.size() ||
-      order_keys_.size() != rhs_window->order_keys_.size()) {
+      order_keys_.size() != rhs_window->order_keys_.size() ||
+      frame_ != rhs_window->frame_) {
     return false;
   }
   return expr_list_match(args_, rhs_window->args_) &&
@@ -2795,6 +2796,10 @@ std::string WindowFunction::toString() const {
   for (const auto& arg : args_) {
     result += " " + arg->toString();
   }
+  if (frame_) {
+    result += " ROWS " + std::to_string(frame_->lower_offset) + " " +
+              std::to_string(frame_->upper_offset);
+  }
   return result + ") ";
 }
 
@@ -27,6 +27,7 @@
 #include <cstdint>
 #include <iostream>
 #include <list>
+#include <optional>
 #include <set>
 #include <string>
 #include <type_traits>
@@ -1432,18 +1433,33 @@ struct OrderEntry {
  */
 class WindowFunction : public Expr {
  public:
+  // Explicit ROWS frame of an aggregate. The bounds are row offsets from the current row,
+  // negative for preceding rows, with unbounded ones at the int64_t limits.
+  struct Frame {
+    int64_t lower_offset;
+    int64_t upper_offset;
+
+    bool operator==(const Frame& that) const {
+      return lower_offset == that.lower_offset && upper_offset == that.upper_offset;
+    }
+
+    bool operator!=(const Frame& that) const { return !(*this == that); }
+  };
+
   WindowFunction(const SQLTypeInfo& ti,
                  const SqlWindowFunctionKind kind,
                  const std::vector<std::shared_ptr<Analyzer::Expr>>& args,
                  const std::vector<std::shared_ptr<Analyzer::Expr>>& partition_keys,
                  const std::vector<std::shared_ptr<Analyzer::Expr>>& order_keys,
-                 const std::vector<OrderEntry>& collation)
+                 const std::vector<OrderEntry>& collation,
+                 const std::optional<Frame>& frame = std::nullopt)
       : Expr(ti)
       , kind_(kind)
       , args_(args)
       , partition_keys_(partition_keys)
       , order_keys_(order_keys)
-      , collation_(collation){};
+      , collation_(collation)
+      , frame_(frame){};
 
   std::shared_ptr<Analyzer::Expr> deep_copy() const override;
 
@@ -1464,12 +1480,16 @@ class WindowFunction : public Expr {
 
   const std::vector<OrderEntry>& getCollation() const { return collation_; }
 
+  // Not set for the default frame, which aggregates are computed over while projecting.
+  const std::optional<Frame>& getFrame() const { return frame_; }
+
  private:
   const SqlWindowFunctionKind kind_;
   const std::vector<std::shared_ptr<Analyzer::Expr>> args_;
   const std::vector<std::shared_ptr<Analyzer::Expr>> partition_keys_;
   const std::vector<std::shared_ptr<Analyzer::Expr>> order_keys_;
   const std::vector<OrderEntry> collation_;
+  const std::optional<Frame> frame_;
 };
 
 /*
@@ -22,6 +22,7 @@
 #include <aws/s3/model/GetObjectRequest.h>
 #include <aws/s3/model/ListObjectsV2Request.h>
 #include <aws/s3/model/Object.h>
+#include <aws/s3/model/PutObjectRequest.h>
 #include <atomic>
 #include <boost/filesystem.hpp>
 #include <fstream>
@@ -54,29 +55,7 @@ void S3Archive::init_for_read() {
     objects_request.WithPrefix(prefix_name);
     objects_request.SetMaxKeys(1 << 20);
 
-    // for a daemon like omnisci_server it seems improper to set s3 credentials
-    // via AWS_ACCESS_KEY_ID/AWS_SECRET_ACCESS_KEY env's because that way
-    // credentials are configured *globally* while different users with private
-    // s3 resources may need separate credentials to access.in that case, use
-    // WITH s3_access_key/s3_secret_key parameters.
-    Aws::Client::ClientConfiguration s3_config;
-    s3_config.region = s3_region.size() ? s3_region : Aws::Region::US_EAST_1;
-    s3_config.endpointOverride = s3_endpoint;
-    auto ssl_config = omnisci_aws_sdk::get_ssl_config();
-    s3_config.caPath = ssl_config.ca_path;
-    s3_config.caFile = ssl_config.ca_file;
-
-    if (!s3_access_key.empty() && !s3_secret_key.empty()) {
-      s3_client.reset(new Aws::S3::S3Client(
-          Aws::Auth::AWSCredentials(s3_access_key, s3_secret_key, s3_session_token),
-          s3_config));
-    } else if (g_allow_s3_server_privileges) {
-      s3_client.reset(new Aws::S3::S3Client(
-          std::make_shared<Aws::Auth::DefaultAWSCredentialsProviderChain>(), s3_config));
-    } else {
-      s3_client.reset(new Aws::S3::S3Client(
-          std::make_shared<Aws::Auth::AnonymousAWSCredentialsProvider>(), s3_config));
-    }
+    init_client();
     while (true) {
       auto list_objects_outcome = s3_client->ListObjectsV2(objects_request);
       if (list_objects_outcome.IsSuccess()) {
@@ -137,6 +116,60 @@ void S3Archive::init_for_read() {
   }
 }
 
+void S3Archive::init_client() {
+  // for a daemon like omnisci_server it seems improper to set s3 credentials
+  // via AWS_ACCESS_KEY_ID/AWS_SECRET_ACCESS_KEY env's because that way
+  // credentials are configured *globally* while different users with private
+  // s3 resources may need separate credentials to access.in that case, use
+  // WITH s3_access_key/s3_secret_key parameters.
+  Aws::Client::ClientConfiguration s3_config;
+  s3_config.region = s3_region.size() ? s3_region : Aws::Region::US_EAST_1;
+  s3_config.endpointOverride = s3_endpoint;
+  auto ssl_config = omnisci_aws_sdk::get_ssl_config();
+  s3_config.caPath = ssl_config.ca_path;
+  s3_config.caFile = ssl_config.ca_file;
+
+  if (!s3_access_key.empty() && !s3_secret_key.empty()) {
+    s3_client.reset(new Aws::S3::S3Client(
+        Aws::Auth::AWSCredentials(s3_access_key, s3_secret_key, s3_session_token),
+        s3_config));
+  } else if (g_allow_s3_server_privileges) {
+    s3_client.reset(new Aws::S3::S3Client(
+        std::make_shared<Aws::Auth::DefaultAWSCredentialsProviderChain>(), s3_config));
+  } else {
+    s3_client.reset(new Aws::S3::S3Client(
+        std::make_shared<Aws::Auth::AnonymousAWSCredentialsProvider>(), s3_config));
+  }
+}
+
+void S3Archive::upload(const std::string& file_path) {
+  bucket_name = url_part(4);
+  prefix_name = url_part(5);
+  if (prefix_name.size() && '/' == prefix_name.front()) {
+    prefix_name = prefix_name.substr(1);
+  }
+  if (bucket_name.empty() || prefix_name.empty() || '/' == prefix_name.back()) {
+    throw std::runtime_error("s3 url '" + url + "' does not name an object");
+  }
+
+  init_client();
+  Aws::S3::Model::PutObjectRequest object_request;
+  object_request.WithBucket(bucket_name).WithKey(prefix_name);
+  auto body = Aws::MakeShared<Aws::FStream>(
+      "S3Archive", file_path.c_str(), std::ios_base::in | std::ios_base::binary);
+  if (!body->good()) {
+    throw std::runtime_error("failed to open file '" + file_path + "' for upload");
+  }
+  object_request.SetBody(body);
+  LOG(INFO) << "Uploading '" << file_path << "' to s3 url '" << url << "'";
+  auto put_object_outcome = s3_client->PutObject(object_request);
+  if (!put_object_outcome.IsSuccess()) {
+    throw std::runtime_error("failed to put object to s3 url '" + url + "': " +
+                             put_object_outcome.GetError().GetExceptionName() + ": " +
+                             put_object_outcome.GetError().GetMessage());
+  }
+}
+
 // a bit complicated with S3 archive of parquet files is that these files
 // use parquet api (not libarchive) and the files must be landed locally
 // to be imported. besides, since parquet archives are often big in size
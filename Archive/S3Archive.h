@@ -114,8 +114,19 @@ class S3Archive : public Archive {
 #endif  // HAVE_AWS_S3
   size_t get_total_file_size() const { return total_file_size; }
 
+  // uploads a local file as the object named by the url of this archive
+#ifdef HAVE_AWS_S3
+  void upload(const std::string& file_path);
+#else
+  void upload(const std::string& file_path) {
+    throw std::runtime_error("AWS S3 support not available");
+  }
+#endif  // HAVE_AWS_S3
+
  private:
 #ifdef HAVE_AWS_S3
+  void init_client();
+
   static int awsapi_count;
   static std::mutex awsapi_mtx;
   static Aws::SDKOptions awsapi_options;
@@ -29,6 +29,7 @@
 #include "Shared/ThriftClient.h"
 #include "Shared/fixautotools.h"
 #include "Shared/measure.h"
+#include "StringDictionary/LruCache.hpp"
 #include "ThriftHandler/QueryState.h"
 
 #include <thrift/protocol/TBinaryProtocol.h>
@@ -44,6 +45,8 @@
 
 #include "rapidjson/document.h"
 
+#include <sstream>
+#include <unordered_map>
 #include <utility>
 
 using namespace rapidjson;
@@ -363,6 +366,21 @@ Calcite::Calcite(const int db_port,
   init(db_port, calcite_port, data_dir, calcite_max_mem, udf_filename);
 }
 
+size_t g_calcite_plan_cache_size{0};
+
+/**
+ * Plans returned by the Calcite server for recent queries, so that repeated queries do
+ * not go to the server. The keys include the version of the catalog, which DDL on the
+ * catalog increments, leaving the plans of the previous version to be evicted.
+ */
+struct Calcite::PlanCache {
+  explicit PlanCache(const size_t max_size) : plans(max_size) {}
+
+  std::mutex mutex;
+  LruCache<std::string, TPlanResult> plans;
+  std::unordered_map<std::string, size_t> catalog_versions;
+};
+
 void Calcite::init(const int db_port,
                    const int calcite_port,
                    const std::string& data_dir,
@@ -370,6 +388,7 @@ void Calcite::init(const int db_port,
                    const std::string& udf_filename) {
   LOG(INFO) << "Creating Calcite Handler,  Calcite Port is " << calcite_port
             << " base data dir is " << data_dir;
+  plan_cache_ = std::make_unique<PlanCache>(g_calcite_plan_cache_size);
   connMgr_ = std::make_shared<ThriftClientConnection>();
   if (calcite_port < 0) {
     CHECK(false) << "JNI mode no longer supported.";
@@ -405,6 +424,7 @@ Calcite::Calcite(const SystemParameters& system_parameters,
 }
 
 void Calcite::updateMetadata(std::string catalog, std::string table) {
+  invalidatePlanCache(catalog);
   if (server_available_) {
     auto ms = measure<>::execution([&]() {
       auto clientP = getClient(remote_calcite_port_);
@@ -465,19 +485,82 @@ TPlanResult Calcite::process(
     const bool is_view_optimize,
     const bool check_privileges,
     const std::string& calcite_session_id) {
-  TPlanResult result = processImpl(query_state_proxy,
-                                   std::move(sql_string),
-                                   filter_push_down_info,
-                                   legacy_syntax,
-                                   is_explain,
-                                   is_view_optimize,
-                                   calcite_session_id);
+  auto timer = DEBUG_TIMER(__func__);
+  const auto plan_cache_key = getPlanCacheKey(query_state_proxy,
+                                              sql_string,
+                                              filter_push_down_info,
+                                              legacy_syntax,
+                                              is_explain,
+                                              is_view_optimize);
+  TPlanResult result;
+  bool is_cached_plan{false};
+  if (!plan_cache_key.empty()) {
+    std::lock_guard<std::mutex> lock(plan_cache_->mutex);
+    if (const auto cached_plan = plan_cache_->plans.get(plan_cache_key)) {
+      result = *cached_plan;
+      result.execution_time_ms = 0;
+      is_cached_plan = true;
+    }
+  }
+  if (is_cached_plan) {
+    VLOG(1) << "Using the cached Calcite plan of sql '" << sql_string << "'";
+  } else {
+    result = processImpl(query_state_proxy,
+                         std::move(sql_string),
+                         filter_push_down_info,
+                         legacy_syntax,
+                         is_explain,
+                         is_view_optimize,
+                         calcite_session_id);
+    if (!plan_cache_key.empty()) {
+      std::lock_guard<std::mutex> lock(plan_cache_->mutex);
+      plan_cache_->plans.put(plan_cache_key, result);
+    }
+  }
+  // Privileges are checked on cached plans as well, they may have been revoked since.
   if (check_privileges && !is_explain) {
     checkAccessedObjectsPrivileges(query_state_proxy, result);
   }
   return result;
 }
 
+/**
+ * Returns the key of the plan of the query in the plan cache, or an empty key if the
+ * plan can not be cached: plans with filter push down or for sessions with a row
+ * restriction depend on more than the query text.
+ */
+std::string Calcite::getPlanCacheKey(
+    query_state::QueryStateProxy query_state_proxy,
+    const std::string& sql_string,
+    const std::vector<TFilterPushDownInfo>& filter_push_down_info,
+    const bool legacy_syntax,
+    const bool is_explain,
+    const bool is_view_optimize) {
+  if (!g_calcite_plan_cache_size || !filter_push_down_info.empty()) {
+    return "";
+  }
+  const auto& session_info = query_state_proxy.getQueryState().getConstSessionInfo();
+  const auto restriction = session_info->get_restriction_ptr();
+  if (restriction && !restriction->column.empty()) {
+    return "";
+  }
+  const auto& catalog = session_info->getCatalog().getCurrentDB().dbName;
+  std::ostringstream key;
+  {
+    std::lock_guard<std::mutex> lock(plan_cache_->mutex);
+    key << catalog << '\n' << plan_cache_->catalog_versions[catalog] << '\n';
+  }
+  key << session_info->get_currentUser().userName << '\n'
+      << legacy_syntax << is_explain << is_view_optimize << '\n'
+      << sql_string;
+  return key.str();
+}
+
+void Calcite::invalidatePlanCache(const std::string& catalog) {
+  std::lock_guard<std::mutex> lock(plan_cache_->mutex);
+  ++plan_cache_->catalog_versions[catalog];
+}
+
 void Calcite::checkAccessedObjectsPrivileges(
     query_state::QueryStateProxy query_state_proxy,
     TPlanResult plan) const {
@@ -688,6 +771,11 @@ void Calcite::setRuntimeExtensionFunctions(
     const std::vector<TUserDefinedFunction>& udfs,
     const std::vector<TUserDefinedTableFunction>& udtfs,
     bool isruntime) {
+  {
+    // Plans may call the functions by their old signatures.
+    std::lock_guard<std::mutex> lock(plan_cache_->mutex);
+    plan_cache_->plans.clear();
+  }
   if (server_available_) {
     auto clientP = getClient(remote_calcite_port_);
     clientP.first->setRuntimeExtensionFunctions(udfs, udtfs, isruntime);
@@ -27,12 +27,16 @@
 
 #include <thrift/transport/TTransport.h>
 
+#include <memory>
 #include <mutex>
 #include <string>
 #include <vector>
 
 using namespace apache::thrift::transport;
 
+// Number of query plans cached by Calcite::process, 0 disables the plan cache.
+extern size_t g_calcite_plan_cache_size;
+
 namespace {
 constexpr char const* kCalciteUserName = "calcite";
 constexpr char const* kCalciteUserPassword = "HyperInteractive";
@@ -88,6 +92,8 @@ class Calcite final {
   std::string getExtensionFunctionWhitelist();
   std::string getUserDefinedFunctionWhitelist();
   void updateMetadata(std::string catalog, std::string table);
+  // Drops the cached plans of queries on `catalog`, after its tables or views changed.
+  void invalidatePlanCache(const std::string& catalog);
   void close_calcite_server(bool log = true);
   ~Calcite();
   std::string getRuntimeExtensionFunctionWhitelist();
@@ -116,6 +122,13 @@ class Calcite final {
                           const bool is_view_optimize,
                           const std::string& calcite_session_id);
   std::vector<std::string> get_db_objects(const std::string ra);
+  std::string getPlanCacheKey(
+      query_state::QueryStateProxy query_state_proxy,
+      const std::string& sql_string,
+      const std::vector<TFilterPushDownInfo>& filter_push_down_info,
+      const bool legacy_syntax,
+      const bool is_explain,
+      const bool is_view_optimize);
   void inner_close_calcite_server(bool log);
   std::pair<std::shared_ptr<CalciteServerClient>, std::shared_ptr<TTransport>> getClient(
       int port);
@@ -135,4 +148,7 @@ class Calcite final {
   std::string ssl_ca_file_;
   std::string db_config_file_;
   std::once_flag shutdown_once_flag_;
+
+  struct PlanCache;
+  std::unique_ptr<PlanCache> plan_cache_;
 };
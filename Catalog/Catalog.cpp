@@ -56,6 +56,7 @@
 #include "QueryEngine/Execute.h"
 #include "QueryEngine/TableOptimizer.h"
 
+#include "CudaMgr/CudaMgr.h"
 #include "DataMgr/FileMgr/FileMgr.h"
 #include "DataMgr/FileMgr/GlobalFileMgr.h"
 #include "DataMgr/ForeignStorage/AbstractFileStorageDataWrapper.h"
@@ -64,6 +65,7 @@
 #include "Fragmenter/SortedOrderFragmenter.h"
 #include "LockMgr/LockMgr.h"
 #include "MigrationMgr/MigrationMgr.h"
+#include "OSDependent/omnisci_fs.h"
 #include "Parser/ParserNode.h"
 #include "QueryEngine/Execute.h"
 #include "QueryEngine/TableOptimizer.h"
@@ -93,6 +95,10 @@ bool g_enable_fsi{false};
 bool g_enable_s3_fsi{false};
 extern bool g_cache_string_hash;
 
+// Pick the fragment size of new tables without a FRAGMENT_SIZE from their row width.
+bool g_enable_adaptive_fragment_size{false};
+size_t g_adaptive_fragment_target_bytes{size_t(1) << 30};
+
 // Serialize temp tables to a json file in the Catalogs directory for Calcite parsing
 // under unit testing.
 bool g_serialize_temp_tables{false};
@@ -938,6 +944,35 @@ std::string getUserFromId(const int32_t id) {
   // a user could be deleted and a dashboard still exist?
   return "Unknown";
 }
+
+// CLUSTER_COLUMNS, KEEP_RESIDENT and the PARTITION_* options have no columns of their
+// own in mapd_tables and are kept in key_metainfo.
+void set_key_metainfo_table_options(TableDescriptor* td) {
+  rapidjson::Document document;
+  document.Parse(td->keyMetainfo.c_str());
+  if (document.HasParseError() || !document.IsArray()) {
+    return;
+  }
+  for (const auto& key : document.GetArray()) {
+    if (!key.IsObject() || !key.HasMember("type") || !key["type"].IsString()) {
+      continue;
+    }
+    const std::string type = key["type"].GetString();
+    if (type == "CLUSTER COLUMNS" && key.HasMember("column_ids") &&
+        key["column_ids"].IsArray()) {
+      for (const auto& column_id : key["column_ids"].GetArray()) {
+        td->clusterColumnIds.push_back(column_id.GetInt());
+      }
+    } else if (type == "PARTITION" && key.HasMember("column_id") &&
+               key.HasMember("interval_seconds") && key.HasMember("retention")) {
+      td->partitionColumnId = key["column_id"].GetInt();
+      td->partitionIntervalSeconds = key["interval_seconds"].GetInt64();
+      td->partitionRetention = key["retention"].GetInt();
+    } else if (type == "KEEP RESIDENT") {
+      td->keepResident = true;
+    }
+  }
+}
 }  // namespace
 
 void Catalog::buildMaps() {
@@ -1005,6 +1040,7 @@ void Catalog::buildMaps() {
     td->shard = sqliteConnector_.getData<int>(r, 12);
     td->nShards = sqliteConnector_.getData<int>(r, 13);
     td->keyMetainfo = sqliteConnector_.getData<string>(r, 14);
+    set_key_metainfo_table_options(td);
     td->userId = sqliteConnector_.getData<int>(r, 15);
     td->sortedColumnId =
         sqliteConnector_.isNull(r, 16) ? 0 : sqliteConnector_.getData<int>(r, 16);
@@ -1016,6 +1052,9 @@ void Catalog::buildMaps() {
 
     tableDescriptorMap_[to_upper(td->tableName)] = td;
     tableDescriptorMapById_[td->tableId] = td;
+    if (td->keepResident) {
+      dataMgr_->setTableEvictionHint(currentDB_.dbId, td->tableId, true);
+    }
   }
 
   if (g_enable_fsi) {
@@ -1158,6 +1197,10 @@ void Catalog::buildMaps() {
   }
 
   buildCustomExpressionsMap();
+
+  for (const auto& [dict_ref, dd] : dictDescriptorMapByRef_) {
+    recoverDictionaryCompaction(*dd);
+  }
 }
 
 void Catalog::buildCustomExpressionsMap() {
@@ -1568,6 +1611,140 @@ const DictDescriptor* Catalog::getMetadataForDictUnlocked(const int dictId,
   return dd.get();
 }
 
+std::map<int, size_t> Catalog::getLoadedDictionaryEntryCounts() const {
+  cat_read_lock read_lock(this);
+  std::map<int, size_t> entry_counts;
+  for (const auto& [dict_ref, dd] : dictDescriptorMapByRef_) {
+    std::lock_guard string_dict_lock(*dd->string_dict_mutex);
+    if (dd->stringDict) {
+      entry_counts.emplace(dict_ref.dictId, dd->stringDict->storageEntryCount());
+    }
+  }
+  return entry_counts;
+}
+
+namespace {
+
+constexpr const char* kCompactedDictionarySuffix{".compacted"};
+constexpr const char* kDictionaryCompactionJournal{"CompactionJournal"};
+
+// Retires the dictionary folder and moves the compacted copy in its place. Safe to run
+// again after a crash at any step, until the journal is removed.
+void swap_in_compacted_dictionary(const std::string& dict_folder_path,
+                                  const std::string& compacted_path) {
+  if (boost::filesystem::exists(compacted_path)) {
+    if (boost::filesystem::exists(dict_folder_path)) {
+      File_Namespace::renameForDelete(dict_folder_path);
+    }
+    boost::filesystem::rename(compacted_path, dict_folder_path);
+  }
+  boost::system::error_code ec;
+  boost::filesystem::remove(
+      boost::filesystem::path(dict_folder_path) / kDictionaryCompactionJournal, ec);
+}
+
+}  // namespace
+
+std::string Catalog::getCompactedDictionaryPath(const DictDescriptor& dd) {
+  return dd.dictFolderPath + kCompactedDictionarySuffix;
+}
+
+void Catalog::writeDictionaryCompactionJournal(const DictDescriptor& dd,
+                                               const int32_t table_id) const {
+  const auto journal_path = (boost::filesystem::path(getCompactedDictionaryPath(dd)) /
+                             kDictionaryCompactionJournal)
+                                .string();
+  const auto epoch = getTableEpoch(currentDB_.dbId, table_id);
+  auto journal = std::fopen(journal_path.c_str(), "w");
+  if (!journal) {
+    throw std::runtime_error("Could not create dictionary compaction journal " +
+                             journal_path);
+  }
+  const bool written = std::fprintf(journal, "%d %d\n", table_id, epoch) > 0 &&
+                       std::fflush(journal) == 0 &&
+                       omnisci::fsync(fileno(journal)) == 0;
+  std::fclose(journal);
+  if (!written) {
+    throw std::runtime_error("Could not write dictionary compaction journal " +
+                             journal_path);
+  }
+}
+
+void Catalog::replaceWithCompactedDictionary(const int dict_id) const {
+  cat_write_lock write_lock(this);
+  const auto dict_it = dictDescriptorMapByRef_.find(DictRef(currentDB_.dbId, dict_id));
+  CHECK(dict_it != dictDescriptorMapByRef_.end());
+  auto& dd = dict_it->second;
+  {
+    // Holders of the old dictionary keep reading it, the next load opens the new one.
+    std::lock_guard string_dict_lock(*dd->string_dict_mutex);
+    dd->stringDict.reset();
+  }
+  swap_in_compacted_dictionary(dd->dictFolderPath, getCompactedDictionaryPath(*dd));
+}
+
+void Catalog::removeCompactedDictionary(const DictDescriptor& dd) const {
+  boost::system::error_code ec;
+  boost::filesystem::remove_all(getCompactedDictionaryPath(dd), ec);
+}
+
+void Catalog::recoverDictionaryCompaction(const DictDescriptor& dd) {
+  const auto compacted_path = getCompactedDictionaryPath(dd);
+  const auto in_place_journal_path =
+      boost::filesystem::path(dd.dictFolderPath) / kDictionaryCompactionJournal;
+  if (boost::filesystem::exists(in_place_journal_path)) {
+    // crashed after moving the compacted copy in place
+    swap_in_compacted_dictionary(dd.dictFolderPath, compacted_path);
+    return;
+  }
+  if (!boost::filesystem::exists(compacted_path)) {
+    return;
+  }
+  int32_t table_id{-1};
+  int32_t epoch{-1};
+  std::ifstream journal(
+      (boost::filesystem::path(compacted_path) / kDictionaryCompactionJournal).string());
+  journal >> table_id >> epoch;
+  if (journal && tableDescriptorMapById_.count(table_id) &&
+      getTableEpoch(currentDB_.dbId, table_id) > epoch) {
+    LOG(INFO) << "Completing the compaction of dictionary " << dd.dictFolderPath;
+    swap_in_compacted_dictionary(dd.dictFolderPath, compacted_path);
+  } else {
+    LOG(INFO) << "Discarding an unfinished compaction of dictionary "
+              << dd.dictFolderPath;
+    removeCompactedDictionary(dd);
+  }
+}
+
+void Catalog::setDictionaryEncodingSize(const ColumnDescriptor* cd, const int size) {
+  CHECK(cd->columnType.is_dict_encoded_string());
+  cat_write_lock write_lock(this);
+  cat_sqlite_lock sqlite_lock(getObjForLock());
+  const auto dict_id = cd->columnType.get_comp_param();
+  sqliteConnector_.query("BEGIN TRANSACTION");
+  try {
+    sqliteConnector_.query_with_text_params(
+        "UPDATE mapd_columns SET size = ? WHERE tableid = ? AND columnid = ?",
+        std::vector<std::string>{std::to_string(size),
+                                 std::to_string(cd->tableId),
+                                 std::to_string(cd->columnId)});
+    sqliteConnector_.query_with_text_params(
+        "UPDATE mapd_dictionaries SET nbits = ? WHERE dictid = ?",
+        std::vector<std::string>{std::to_string(size * 8), std::to_string(dict_id)});
+  } catch (std::exception& e) {
+    sqliteConnector_.query("ROLLBACK TRANSACTION");
+    throw;
+  }
+  sqliteConnector_.query("END TRANSACTION");
+  const auto column_it =
+      columnDescriptorMapById_.find(ColumnIdKey(cd->tableId, cd->columnId));
+  CHECK(column_it != columnDescriptorMapById_.end());
+  column_it->second->columnType.set_size(size);
+  const auto dict_it = dictDescriptorMapByRef_.find(DictRef(currentDB_.dbId, dict_id));
+  CHECK(dict_it != dictDescriptorMapByRef_.end());
+  dict_it->second->dictNBits = size * 8;
+}
+
 const std::vector<LeafHostInfo>& Catalog::getStringDictionaryHosts() const {
   return string_dict_hosts_;
 }
@@ -2228,6 +2405,46 @@ int64_t get_next_refresh_time(const foreign_storage::ForeignTable& foreign_table
   }
   return foreign_storage::ForeignTable::NULL_REFRESH_TIME;
 }
+
+// Estimated bytes per row of a none encoded string, geo or variable length array column.
+constexpr size_t varlen_column_estimated_bytes{32};
+
+// A fragment of all the columns takes at most this fraction of the smallest GPU, which
+// also holds the hash tables and the output buffers of the kernel.
+constexpr size_t gpu_memory_per_fragment_divisor{16};
+
+constexpr size_t adaptive_fragment_rows_granularity{size_t(1) << 20};
+constexpr size_t min_adaptive_fragment_rows{adaptive_fragment_rows_granularity};
+constexpr size_t max_adaptive_fragment_rows{4 * DEFAULT_FRAGMENT_ROWS};
+
+size_t get_row_bytes(const list<ColumnDescriptor>& columns) {
+  size_t row_bytes{0};
+  for (const auto& cd : columns) {
+    const auto& ti = cd.columnType;
+    if (ti.is_geometry()) {
+      // stored in the physical columns which follow
+      continue;
+    }
+    row_bytes += ti.is_varlen() ? varlen_column_estimated_bytes
+                                : static_cast<size_t>(ti.get_size());
+  }
+  return std::max(row_bytes, size_t(1));
+}
+
+size_t get_adaptive_fragment_rows(const list<ColumnDescriptor>& columns,
+                                  const CudaMgr_Namespace::CudaMgr* cuda_mgr) {
+  auto target_bytes = g_adaptive_fragment_target_bytes;
+  if (cuda_mgr) {
+    for (const auto& device_properties : cuda_mgr->getAllDeviceProperties()) {
+      target_bytes = std::min(
+          target_bytes, device_properties.globalMem / gpu_memory_per_fragment_divisor);
+    }
+  }
+  auto fragment_rows = target_bytes / get_row_bytes(columns);
+  fragment_rows -= fragment_rows % adaptive_fragment_rows_granularity;
+  return std::clamp(
+      fragment_rows, min_adaptive_fragment_rows, max_adaptive_fragment_rows);
+}
 }  // namespace
 
 void Catalog::createTable(
@@ -2262,6 +2479,16 @@ void Catalog::createTable(
   }
   cds.clear();
 
+  // A FRAGMENT_SIZE equal to the default is taken as not given. The physical tables of a
+  // sharded table reuse the fragment size picked for the logical table.
+  if (g_enable_adaptive_fragment_size && isLogicalTable && !td.isView &&
+      td.storageType.empty() && td.maxFragRows == DEFAULT_FRAGMENT_ROWS) {
+    td.maxFragRows = static_cast<int32_t>(
+        get_adaptive_fragment_rows(columns, dataMgr_->getCudaMgr()));
+    LOG(INFO) << "Picked a fragment size of " << td.maxFragRows << " rows for table "
+              << td.tableName;
+  }
+
   ColumnDescriptor cd;
   // add row_id column -- Must be last column in the table
   cd.columnName = "rowid";
@@ -2450,6 +2677,9 @@ void Catalog::createTable(
     }
 
     addTableToMap(&td, cds, dds);
+    if (td.keepResident) {
+      dataMgr_->setTableEvictionHint(currentDB_.dbId, td.tableId, true);
+    }
     calciteMgr_->updateMetadata(currentDB_.dbName, td.tableName);
     if (!td.storageType.empty() && td.storageType != StorageType::FOREIGN_TABLE) {
       dataMgr_->getForeignStorageInterface()->registerTable(this, td, cds);
@@ -3444,6 +3674,10 @@ void Catalog::doTruncateTable(const TableDescriptor* td) {
   dataMgr_->deleteChunksWithPrefix(chunkKeyPrefix, MemoryLevel::GPU_LEVEL);
 
   dataMgr_->removeTableRelatedDS(currentDB_.dbId, tableId);
+  if (td->keepResident) {
+    // the truncated table stays around, so does its eviction hint
+    dataMgr_->setTableEvictionHint(currentDB_.dbId, tableId, true);
+  }
 
   std::unique_ptr<StringDictionaryClient> client;
   if (SysCatalog::instance().isAggregator()) {
@@ -4463,6 +4697,41 @@ std::vector<std::string> Catalog::getTableDictDirectories(
 // returns table schema in a string
 // NOTE(sy): Might be able to replace dumpSchema() later with
 //           dumpCreateTable() after a deeper review of the TableArchiver code.
+std::vector<std::string> Catalog::getKeyMetainfoTableOptions(
+    const TableDescriptor* td) const {
+  std::vector<std::string> options;
+  if (!td->clusterColumnIds.empty()) {
+    std::vector<std::string> cluster_column_names;
+    for (const auto column_id : td->clusterColumnIds) {
+      const auto cluster_cd = getMetadataForColumn(td->tableId, column_id);
+      CHECK(cluster_cd);
+      cluster_column_names.push_back(cluster_cd->columnName);
+    }
+    options.push_back("CLUSTER_COLUMNS='" +
+                      boost::algorithm::join(cluster_column_names, ",") + "'");
+  }
+  if (td->partitionColumnId > 0) {
+    const auto partition_cd = getMetadataForColumn(td->tableId, td->partitionColumnId);
+    CHECK(partition_cd);
+    options.push_back("PARTITION_COLUMN='" + partition_cd->columnName + "'");
+    const std::map<int64_t, std::string> interval_names{
+        {3600, "'HOUR'"}, {86400, "'DAY'"}, {604800, "'WEEK'"}};
+    const auto name_it = interval_names.find(td->partitionIntervalSeconds);
+    options.push_back("PARTITION_INTERVAL=" +
+                      (name_it != interval_names.end()
+                           ? name_it->second
+                           : std::to_string(td->partitionIntervalSeconds)));
+    if (td->partitionRetention > 0) {
+      options.push_back("PARTITION_RETENTION=" +
+                        std::to_string(td->partitionRetention));
+    }
+  }
+  if (td->keepResident) {
+    options.push_back("KEEP_RESIDENT='TRUE'");
+  }
+  return options;
+}
+
 std::string Catalog::dumpSchema(const TableDescriptor* td) const {
   cat_read_lock read_lock(this);
 
@@ -4555,6 +4824,9 @@ std::string Catalog::dumpSchema(const TableDescriptor* td) const {
     CHECK(sort_cd);
     with_options.push_back("SORT_COLUMN='" + sort_cd->columnName + "'");
   }
+  for (auto& option : getKeyMetainfoTableOptions(td)) {
+    with_options.push_back(std::move(option));
+  }
   if (td->maxRollbackEpochs != DEFAULT_MAX_ROLLBACK_EPOCHS &&
       td->maxRollbackEpochs != -1) {
     with_options.push_back("MAX_ROLLBACK_EPOCHS=" +
@@ -4732,6 +5004,11 @@ std::string Catalog::dumpCreateTable(const TableDescriptor* td,
     CHECK(sort_cd);
     with_options.push_back("SORT_COLUMN='" + sort_cd->columnName + "'");
   }
+  if (!foreign_table) {
+    for (auto& option : getKeyMetainfoTableOptions(td)) {
+      with_options.push_back(std::move(option));
+    }
+  }
 
   if (!with_options.empty()) {
     if (!multiline_formatting) {
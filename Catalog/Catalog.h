@@ -226,6 +226,23 @@ class Catalog final {
 
   const DictDescriptor* getMetadataForDict(int dict_ref, bool loadDict = true) const;
   const DictDescriptor* getMetadataForDictUnlocked(int dict_ref, bool loadDict) const;
+  // Entry counts of the dictionaries loaded in memory, by dictionary id. Dictionaries
+  // which were not loaded yet are left out rather than loaded.
+  std::map<int, size_t> getLoadedDictionaryEntryCounts() const;
+
+  // Dictionary compaction, see TableOptimizer::compactDictionaries(). The dense copy of a
+  // dictionary is built in a folder next to it. A journal in that folder records the
+  // epoch of the table whose chunks get the new ids, the copy replaces the dictionary
+  // once the table checkpointed past that epoch, also when recovering after a crash.
+  static std::string getCompactedDictionaryPath(const DictDescriptor& dd);
+  void writeDictionaryCompactionJournal(const DictDescriptor& dd,
+                                        const int32_t table_id) const;
+  void replaceWithCompactedDictionary(const int dict_id) const;
+  void removeCompactedDictionary(const DictDescriptor& dd) const;
+
+  // Sets the width in bytes of the ids of a dictionary encoded text column, see
+  // import_export::Loader. The caller rewrites the chunks of the column.
+  void setDictionaryEncodingSize(const ColumnDescriptor* cd, const int size);
 
   const std::vector<LeafHostInfo>& getStringDictionaryHosts() const;
 
@@ -654,6 +671,8 @@ class Catalog final {
                             std::set<std::string>& shared_dict_column_names,
                             const TableDescriptor* td) const;
   std::string quoteIfRequired(const std::string& column_name) const;
+  // WITH options of the table options kept in key_metainfo.
+  std::vector<std::string> getKeyMetainfoTableOptions(const TableDescriptor* td) const;
   DeletedColumnPerTableMap deletedColumnPerTable_;
   void adjustAlteredTableFiles(
       const std::string& temp_data_dir,
@@ -699,6 +718,7 @@ class Catalog final {
   void removeChunksUnlocked(const int table_id) const;
 
   void buildCustomExpressionsMap();
+  void recoverDictionaryCompaction(const DictDescriptor& dd);
   std::unique_ptr<CustomExpression> getCustomExpressionFromConnector(size_t row);
 
  public:
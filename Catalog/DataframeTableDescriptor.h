@@ -56,6 +56,11 @@ struct DataframeTableDescriptor : TableDescriptor {
     nShards = td.nShards;
     shardedColumnId = td.shardedColumnId;
     sortedColumnId = td.sortedColumnId;
+    clusterColumnIds = td.clusterColumnIds;
+    partitionColumnId = td.partitionColumnId;
+    partitionIntervalSeconds = td.partitionIntervalSeconds;
+    partitionRetention = td.partitionRetention;
+    keepResident = td.keepResident;
     persistenceLevel = td.persistenceLevel;
     hasDeletedCol = td.hasDeletedCol;
     columnIdBySpi_ = td.columnIdBySpi_;
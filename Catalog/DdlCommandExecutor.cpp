@@ -31,6 +31,7 @@
 
 #include "QueryEngine/Execute.h"  // Executor::getArenaBlockSize()
 #include "QueryEngine/ExternalCacheInvalidators.h"
+#include "QueryEngine/QueryProfile.h"
 #include "QueryEngine/ResultSetBuilder.h"
 
 extern bool g_enable_fsi;
@@ -420,10 +421,14 @@ ExecutionResult DdlCommandExecutor::execute() {
     result = RefreshForeignTablesCommand{*ddl_data_, session_ptr_}.execute();
   } else if (ddl_command_ == "SHOW_QUERIES") {
     LOG(ERROR) << "SHOW QUERIES DDL is not ready yet!\n";
+  } else if (ddl_command_ == "SHOW_QUERY_PROFILES") {
+    result = ShowQueryProfilesCommand{*ddl_data_, session_ptr_}.execute();
   } else if (ddl_command_ == "SHOW_DISK_CACHE_USAGE") {
     result = ShowDiskCacheUsageCommand{*ddl_data_, session_ptr_}.execute();
   } else if (ddl_command_ == "SHOW_USER_DETAILS") {
     result = ShowUserDetailsCommand{*ddl_data_, session_ptr_}.execute();
+  } else if (ddl_command_ == "DEFRAGMENT_MEMORY") {
+    result = DefragmentMemoryCommand{*ddl_data_, session_ptr_}.execute();
   } else if (ddl_command_ == "KILL_QUERY") {
     auto& ddl_payload = extractPayload(*ddl_data_);
     CHECK(ddl_payload.HasMember("querySession"));
@@ -460,7 +465,7 @@ DistributedExecutionDetails DdlCommandExecutor::getDistributedExecutionDetails()
       ddl_command_ == "CREATE_DB" || ddl_command_ == "DROP_DB" ||
       ddl_command_ == "RENAME_DB" || ddl_command_ == "CREATE_USER" ||
       ddl_command_ == "DROP_USER" || ddl_command_ == "ALTER_USER" ||
-      ddl_command_ == "RENAME_USER") {
+      ddl_command_ == "RENAME_USER" || ddl_command_ == "DEFRAGMENT_MEMORY") {
     execution_details.execution_location = ExecutionLocation::ALL_NODES;
     execution_details.aggregation_type = AggregationType::NONE;
   } else if (ddl_command_ == "SHOW_TABLE_DETAILS") {
@@ -1557,6 +1562,110 @@ ExecutionResult ShowDiskCacheUsageCommand::execute() {
   return ExecutionResult(rSet, label_infos);
 }
 
+ShowQueryProfilesCommand::ShowQueryProfilesCommand(
+    const DdlCommandData& ddl_data,
+    std::shared_ptr<Catalog_Namespace::SessionInfo const> session_ptr)
+    : DdlCommand(ddl_data, session_ptr) {}
+
+ExecutionResult ShowQueryProfilesCommand::execute() {
+  // label_infos -> column labels
+  std::vector<std::string> text_labels{
+      "user_name", "session_id", "query_str", "submitted"};
+  std::vector<std::string> bigint_labels{"compilation_time_us",
+                                         "fetch_time_us",
+                                         "cpu_bytes_fetched",
+                                         "gpu_bytes_fetched",
+                                         "kernel_count",
+                                         "kernel_time_us",
+                                         "reduction_time_us",
+                                         "step_count",
+                                         "code_cache_hits",
+                                         "code_cache_misses",
+                                         "recycled_results"};
+  std::vector<TargetMetaInfo> label_infos;
+  for (const auto& label : text_labels) {
+    label_infos.emplace_back(label, SQLTypeInfo(kTEXT, true));
+  }
+  for (const auto& label : bigint_labels) {
+    label_infos.emplace_back(label, SQLTypeInfo(kBIGINT, true));
+  }
+
+  // logical_values -> table data
+  const auto& user = session_ptr_->get_currentUser();
+  std::vector<RelLogicalValues::RowValues> logical_values;
+  for (const auto& query_profile_info : QueryProfileHistory::instance().get()) {
+    // Users other than super users only see the profiles of their own queries.
+    if (!user.isSuper && query_profile_info.user_name != user.userLoggable()) {
+      continue;
+    }
+    size_t kernel_count{0};
+    int64_t kernel_time_us{0};
+    for (const auto& kernel_time : query_profile_info.kernel_times) {
+      kernel_count += kernel_time.kernel_count;
+      kernel_time_us += kernel_time.time_us;
+    }
+    const auto& fetched_bytes = query_profile_info.fetched_bytes;
+    logical_values.emplace_back(RelLogicalValues::RowValues{});
+    auto& row = logical_values.back();
+    row.emplace_back(genLiteralStr(query_profile_info.user_name));
+    row.emplace_back(genLiteralStr(query_profile_info.public_session_id));
+    row.emplace_back(genLiteralStr(query_profile_info.query_str));
+    row.emplace_back(genLiteralStr(query_profile_info.submitted));
+    row.emplace_back(genLiteralBigInt(query_profile_info.compilation_time_us));
+    row.emplace_back(genLiteralBigInt(query_profile_info.fetch_time_us));
+    row.emplace_back(genLiteralBigInt(fetched_bytes[Data_Namespace::CPU_LEVEL]));
+    row.emplace_back(genLiteralBigInt(fetched_bytes[Data_Namespace::GPU_LEVEL]));
+    row.emplace_back(genLiteralBigInt(kernel_count));
+    row.emplace_back(genLiteralBigInt(kernel_time_us));
+    row.emplace_back(genLiteralBigInt(query_profile_info.reduction_time_us));
+    row.emplace_back(genLiteralBigInt(query_profile_info.steps.size()));
+    row.emplace_back(genLiteralBigInt(query_profile_info.code_cache_hits));
+    row.emplace_back(genLiteralBigInt(query_profile_info.code_cache_misses));
+    row.emplace_back(genLiteralBigInt(query_profile_info.recycled_results));
+  }
+
+  // Create ResultSet
+  std::shared_ptr<ResultSet> rSet = std::shared_ptr<ResultSet>(
+      ResultSetLogicalValuesBuilder::create(label_infos, logical_values));
+
+  return ExecutionResult(rSet, label_infos);
+}
+
+DefragmentMemoryCommand::DefragmentMemoryCommand(
+    const DdlCommandData& ddl_data,
+    std::shared_ptr<Catalog_Namespace::SessionInfo const> session_ptr)
+    : DdlCommand(ddl_data, session_ptr) {
+  auto& ddl_payload = extractPayload(ddl_data_);
+  CHECK(ddl_payload.HasMember("memoryLevel"));
+  CHECK(ddl_payload["memoryLevel"].IsString());
+}
+
+ExecutionResult DefragmentMemoryCommand::execute() {
+  if (!session_ptr_->get_currentUser().isSuper) {
+    throw std::runtime_error("Superuser privilege is required to defragment memory.");
+  }
+  auto& ddl_payload = extractPayload(ddl_data_);
+  const std::string memory_level = ddl_payload["memoryLevel"].GetString();
+  CHECK(memory_level == "CPU" || memory_level == "GPU");
+  const auto moved_chunks = Executor::defragmentMemory(
+      memory_level == "CPU" ? Data_Namespace::MemoryLevel::CPU_LEVEL
+                            : Data_Namespace::MemoryLevel::GPU_LEVEL);
+
+  // label_infos -> column labels
+  std::vector<TargetMetaInfo> label_infos;
+  label_infos.emplace_back("moved chunks", SQLTypeInfo(kBIGINT, true));
+
+  // logical_values -> table data
+  std::vector<RelLogicalValues::RowValues> logical_values;
+  logical_values.emplace_back(RelLogicalValues::RowValues{});
+  logical_values.back().emplace_back(genLiteralBigInt(moved_chunks));
+
+  std::shared_ptr<ResultSet> rSet = std::shared_ptr<ResultSet>(
+      ResultSetLogicalValuesBuilder::create(label_infos, logical_values));
+
+  return ExecutionResult(rSet, label_infos);
+}
+
 ShowUserDetailsCommand::ShowUserDetailsCommand(
     const DdlCommandData& ddl_data,
     std::shared_ptr<Catalog_Namespace::SessionInfo const> session_ptr)
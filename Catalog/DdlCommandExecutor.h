@@ -182,6 +182,24 @@ class ShowUserDetailsCommand : public DdlCommand {
   ExecutionResult execute() override;
 };
 
+class ShowQueryProfilesCommand : public DdlCommand {
+ public:
+  ShowQueryProfilesCommand(
+      const DdlCommandData& ddl_data,
+      std::shared_ptr<Catalog_Namespace::SessionInfo const> session_ptr);
+
+  ExecutionResult execute() override;
+};
+
+class DefragmentMemoryCommand : public DdlCommand {
+ public:
+  DefragmentMemoryCommand(
+      const DdlCommandData& ddl_data,
+      std::shared_ptr<Catalog_Namespace::SessionInfo const> session_ptr);
+
+  ExecutionResult execute() override;
+};
+
 class RefreshForeignTablesCommand : public DdlCommand {
  public:
   RefreshForeignTablesCommand(
@@ -27,6 +27,7 @@
 #include <cassert>
 #include <exception>
 #include <filesystem>
+#include <future>
 #include <list>
 #include <memory>
 #include <random>
@@ -48,6 +49,7 @@
 #include "Shared/File.h"
 #include "Shared/StringTransform.h"
 #include "Shared/measure.h"
+#include "Shared/thread_count.h"
 #include "include/bcrypt.h"
 
 using std::list;
@@ -120,6 +122,7 @@ using sys_write_lock = write_lock<SysCatalog>;
 using sys_sqlite_lock = sqlite_lock<SysCatalog>;
 
 bool g_log_user_id{false};  // --log-user-id
+bool g_preload_catalogs{false};
 
 std::string UserMetadata::userLoggable() const {
   return g_log_user_id ? std::to_string(userId) : userName;
@@ -920,10 +923,27 @@ void SysCatalog::dropUser(const string& name) {
 }
 
 std::vector<std::shared_ptr<Catalog>> SysCatalog::getCatalogsForAllDbs() {
-  std::vector<std::shared_ptr<Catalog>> catalogs{};
   const auto& db_metadata_list = getAllDBMetadata();
-  for (const auto& db_metadata : db_metadata_list) {
-    catalogs.emplace_back(getCatalog(db_metadata, false));
+  std::vector<DBMetadata> db_metadata_vec(db_metadata_list.begin(),
+                                          db_metadata_list.end());
+  std::vector<std::shared_ptr<Catalog>> catalogs(db_metadata_vec.size());
+  // Every database has its own SQLite file, so the catalogs not loaded yet are built
+  // concurrently, by at most cpu_threads() threads pulling the next database.
+  std::atomic<size_t> next_db{0};
+  const auto load_catalogs = [&]() {
+    for (size_t i = next_db++; i < db_metadata_vec.size(); i = next_db++) {
+      catalogs[i] = getCatalog(db_metadata_vec[i], false);
+    }
+  };
+  const auto num_threads =
+      std::min(static_cast<size_t>(cpu_threads()), db_metadata_vec.size());
+  std::vector<std::future<void>> load_threads;
+  for (size_t i = 1; i < num_threads; ++i) {
+    load_threads.push_back(std::async(std::launch::async, load_catalogs));
+  }
+  load_catalogs();
+  for (auto& load_thread : load_threads) {
+    load_thread.get();
   }
   return catalogs;
 }
@@ -2533,6 +2553,9 @@ std::shared_ptr<Catalog> SysCatalog::getCatalog(const DBMetadata& curDB, bool is
 }
 
 void SysCatalog::removeCatalog(const std::string& dbName) {
+  if (calciteMgr_) {
+    calciteMgr_->invalidatePlanCache(dbName);
+  }
   cat_map_.erase(dbName);
 }
 
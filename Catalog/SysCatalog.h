@@ -65,6 +65,8 @@ const std::string OMNISCI_ROOT_PASSWD_DEFAULT = "HyperInteractive";
 class Calcite;
 
 extern std::string g_base_path;
+// Load the catalogs of all databases at server startup instead of on first access.
+extern bool g_preload_catalogs;
 
 namespace Catalog_Namespace {
 
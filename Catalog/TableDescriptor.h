@@ -66,6 +66,11 @@ struct TableDescriptor {
       nShards;  // # of shards, i.e. physical tables for this logical table (default: 0)
   int shardedColumnId;  // Id of the column to be sharded on
   int sortedColumnId;   // Id of the column to be sorted on
+  std::vector<int> clusterColumnIds;  // Ids of the columns to cluster on, in Z-order
+  int partitionColumnId;              // Id of the time column to partition on
+  int64_t partitionIntervalSeconds;   // Time range of each partition
+  int32_t partitionRetention;         // Newest partitions kept, 0 keeps all of them
+  bool keepResident;                  // Buffer pools evict the table's chunks last
   Data_Namespace::MemoryLevel persistenceLevel;
   bool hasDeletedCol;  // Does table has a delete col, Yes (VACUUM = DELAYED)
                        //                              No  (VACUUM = IMMEDIATE)
@@ -85,6 +90,10 @@ struct TableDescriptor {
       , nShards(0)
       , shardedColumnId(0)
       , sortedColumnId(0)
+      , partitionColumnId(0)
+      , partitionIntervalSeconds(0)
+      , partitionRetention(0)
+      , keepResident(false)
       , persistenceLevel(Data_Namespace::MemoryLevel::DISK_LEVEL)
       , hasDeletedCol(true)
       , maxRollbackEpochs(DEFAULT_MAX_ROLLBACK_EPOCHS)
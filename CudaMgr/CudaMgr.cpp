@@ -25,6 +25,8 @@
 
 #include "Logger/Logger.h"
 
+bool g_enable_gpu_peer_access{false};
+
 namespace CudaMgr_Namespace {
 
 CudaErrorException::CudaErrorException(CUresult status)
@@ -61,6 +63,10 @@ CudaMgr::CudaMgr(const int num_gpus, const int start_gpu)
   fillDeviceProperties();
   initDeviceGroup();
   createDeviceContexts();
+  if (g_enable_gpu_peer_access) {
+    enablePeerAccess();
+  }
+  createCopyStreams();
   printDeviceProperties();
 
   // warm up the GPU JIT
@@ -85,6 +91,11 @@ CudaMgr::~CudaMgr() {
 
     synchronizeDevices();
     for (int d = 0; d < device_count_; ++d) {
+      setContext(d);
+      checkError(cuStreamDestroy(copy_streams_[d]));
+      for (const auto& [stream_id, stream] : query_streams_[d]) {
+        checkError(cuStreamDestroy(stream));
+      }
       checkError(cuCtxDestroy(device_contexts_[d]));
     }
   } catch (const CudaErrorException& e) {
@@ -136,14 +147,52 @@ void CudaMgr::copyDeviceToDevice(int8_t* dest_ptr,
                         reinterpret_cast<CUdeviceptr>(src_ptr),
                         num_bytes));
   } else {
+    // Goes over NVLink or PCIe directly if enablePeerAccess() enabled the pair, and is
+    // staged through host memory by the driver otherwise.
     checkError(cuMemcpyPeer(reinterpret_cast<CUdeviceptr>(dest_ptr),
                             device_contexts_[dest_device_num],
                             reinterpret_cast<CUdeviceptr>(src_ptr),
                             device_contexts_[src_device_num],
-                            num_bytes));  // will we always have peer?
+                            num_bytes));
   }
 }
 
+void CudaMgr::copyPinnedHostToDevice(int8_t* device_ptr,
+                                     const int8_t* host_ptr,
+                                     const size_t num_bytes,
+                                     const int device_num) {
+  CHECK_LT(static_cast<size_t>(device_num), copy_streams_.size());
+  setContext(device_num);
+  checkError(cuMemcpyHtoDAsync(reinterpret_cast<CUdeviceptr>(device_ptr),
+                               host_ptr,
+                               num_bytes,
+                               copy_streams_[device_num]));
+  checkError(cuStreamSynchronize(copy_streams_[device_num]));
+}
+
+void CudaMgr::copyDeviceToPinnedHost(int8_t* host_ptr,
+                                     const int8_t* device_ptr,
+                                     const size_t num_bytes,
+                                     const int device_num) {
+  CHECK_LT(static_cast<size_t>(device_num), copy_streams_.size());
+  setContext(device_num);
+  checkError(cuMemcpyDtoHAsync(host_ptr,
+                               reinterpret_cast<const CUdeviceptr>(device_ptr),
+                               num_bytes,
+                               copy_streams_[device_num]));
+  checkError(cuStreamSynchronize(copy_streams_[device_num]));
+}
+
+bool CudaMgr::isPinnedHostMem(const int8_t* host_ptr, const size_t num_bytes) const {
+  std::lock_guard<std::mutex> pinned_host_mem_lock(pinned_host_mem_mutex_);
+  auto it = pinned_host_allocations_.upper_bound(host_ptr);
+  if (it == pinned_host_allocations_.begin()) {
+    return false;
+  }
+  --it;
+  return host_ptr + num_bytes <= it->first + it->second;
+}
+
 void CudaMgr::loadGpuModuleData(CUmodule* module,
                                 const void* image,
                                 unsigned int num_options,
@@ -246,6 +295,8 @@ int8_t* CudaMgr::allocatePinnedHostMem(const size_t num_bytes) {
   setContext(0);
   void* host_ptr;
   checkError(cuMemHostAlloc(&host_ptr, num_bytes, CU_MEMHOSTALLOC_PORTABLE));
+  std::lock_guard<std::mutex> pinned_host_mem_lock(pinned_host_mem_mutex_);
+  pinned_host_allocations_[reinterpret_cast<int8_t*>(host_ptr)] = num_bytes;
   return reinterpret_cast<int8_t*>(host_ptr);
 }
 
@@ -257,6 +308,10 @@ int8_t* CudaMgr::allocateDeviceMem(const size_t num_bytes, const int device_num)
 }
 
 void CudaMgr::freePinnedHostMem(int8_t* host_ptr) {
+  {
+    std::lock_guard<std::mutex> pinned_host_mem_lock(pinned_host_mem_mutex_);
+    pinned_host_allocations_.erase(host_ptr);
+  }
   checkError(cuMemFreeHost(reinterpret_cast<void*>(host_ptr)));
 }
 
@@ -358,6 +413,57 @@ void CudaMgr::createDeviceContexts() {
   }
 }
 
+void CudaMgr::enablePeerAccess() {
+  for (int d = 0; d < device_count_; ++d) {
+    setContext(d);
+    for (int peer_d = 0; peer_d < device_count_; ++peer_d) {
+      if (peer_d == d) {
+        continue;
+      }
+      int can_access_peer{0};
+      checkError(cuDeviceCanAccessPeer(&can_access_peer,
+                                       device_properties_[d].device,
+                                       device_properties_[peer_d].device));
+      if (!can_access_peer) {
+        LOG(INFO) << "GPU " << d << " cannot access the memory of GPU " << peer_d
+                  << " peer to peer.";
+        continue;
+      }
+      const auto status = cuCtxEnablePeerAccess(device_contexts_[peer_d], 0);
+      if (status != CUDA_ERROR_PEER_ACCESS_ALREADY_ENABLED) {
+        checkError(status);
+      }
+      VLOG(1) << "Enabled peer access from GPU " << d << " to GPU " << peer_d;
+    }
+  }
+}
+
+void CudaMgr::createCopyStreams() {
+  CHECK_EQ(copy_streams_.size(), size_t(0));
+  copy_streams_.resize(device_count_);
+  query_streams_.resize(device_count_);
+  for (int d = 0; d < device_count_; ++d) {
+    setContext(d);
+    // Non blocking, so copies do not wait for the kernels on the legacy default stream
+    checkError(cuStreamCreate(&copy_streams_[d], CU_STREAM_NON_BLOCKING));
+  }
+}
+
+CUstream CudaMgr::getQueryStream(const int device_num, const size_t stream_id) {
+  std::lock_guard<std::mutex> query_streams_lock(query_streams_mutex_);
+  CHECK_LT(static_cast<size_t>(device_num), query_streams_.size());
+  auto& device_streams = query_streams_[device_num];
+  auto it = device_streams.find(stream_id);
+  if (it == device_streams.end()) {
+    setContext(device_num);
+    CUstream stream;
+    // Blocking, so kernels wait for the copies issued on the legacy default stream
+    checkError(cuStreamCreate(&stream, CU_STREAM_DEFAULT));
+    it = device_streams.emplace(stream_id, stream).first;
+  }
+  return it->second;
+}
+
 void CudaMgr::setContext(const int device_num) const {
   // deviceNum is the device number relative to startGpu (realDeviceNum - startGpu_)
   CHECK_LT(device_num, device_count_);
@@ -16,6 +16,7 @@
 #pragma once
 
 #include <cstdlib>
+#include <map>
 #include <mutex>
 #include <string>
 #include <vector>
@@ -29,6 +30,10 @@
 #include "Shared/nocuda.h"
 #endif  // HAVE_CUDA
 
+// Lets the GPUs access each other's memory where the topology allows it, so that copies
+// between devices go over NVLink or PCIe peer to peer instead of through the host.
+extern bool g_enable_gpu_peer_access;
+
 namespace CudaMgr_Namespace {
 
 enum class NvidiaDeviceArch {
@@ -101,6 +106,30 @@ class CudaMgr {
                           const int dest_device_num,
                           const int src_device_num);
 
+  /**
+   * Copies between page-locked host memory from allocatePinnedHostMem() and a device on
+   * the copy stream of the device. The DMA engine reads the host pages directly, with no
+   * staging copy, and the copy does not queue behind kernels running on the device.
+   * Returns once the copy is done.
+   */
+  void copyPinnedHostToDevice(int8_t* device_ptr,
+                              const int8_t* host_ptr,
+                              const size_t num_bytes,
+                              const int device_num);
+  void copyDeviceToPinnedHost(int8_t* host_ptr,
+                              const int8_t* device_ptr,
+                              const size_t num_bytes,
+                              const int device_num);
+  // Whether the host range lies in a single allocation from allocatePinnedHostMem().
+  bool isPinnedHostMem(const int8_t* host_ptr, const size_t num_bytes) const;
+
+  /**
+   * Returns the stream of the device reserved for the kernels of `stream_id`, created on
+   * first use. Kernels on the streams of different ids may run at the same time on the
+   * device, while still being ordered with the work on the legacy default stream.
+   */
+  CUstream getQueryStream(const int device_num, const size_t stream_id);
+
   int8_t* allocatePinnedHostMem(const size_t num_bytes);
   int8_t* allocateDeviceMem(const size_t num_bytes, const int device_num);
   void freePinnedHostMem(int8_t* host_ptr);
@@ -226,6 +255,8 @@ class CudaMgr {
   void fillDeviceProperties();
   void initDeviceGroup();
   void createDeviceContexts();
+  void enablePeerAccess();
+  void createCopyStreams();
   size_t computeMinSharedMemoryPerBlockForAllDevices() const;
   size_t computeMinNumMPsForAllDevices() const;
   void checkError(CUresult cu_result) const;
@@ -240,6 +271,14 @@ class CudaMgr {
   std::vector<DeviceProperties> device_properties_;
   omnisci::DeviceGroup device_group_;
   std::vector<CUcontext> device_contexts_;
+  std::vector<CUstream> copy_streams_;
+
+  std::mutex query_streams_mutex_;
+  // Query streams of each device, keyed on stream id.
+  std::vector<std::map<size_t, CUstream>> query_streams_;
+
+  mutable std::mutex pinned_host_mem_mutex_;
+  std::map<const int8_t*, size_t> pinned_host_allocations_;
 
   mutable std::mutex device_cleanup_mutex_;
 };
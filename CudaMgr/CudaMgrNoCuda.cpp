@@ -17,6 +17,8 @@
 #include "CudaMgr.h"
 #include "Logger/Logger.h"
 
+bool g_enable_gpu_peer_access{false};
+
 namespace CudaMgr_Namespace {
 
 CudaMgr::CudaMgr(const int, const int) : device_count_(-1), start_gpu_(-1) {
@@ -49,6 +51,28 @@ void CudaMgr::copyDeviceToDevice(int8_t* dest_ptr,
   CHECK(false);
 }
 
+void CudaMgr::copyPinnedHostToDevice(int8_t* device_ptr,
+                                     const int8_t* host_ptr,
+                                     const size_t num_bytes,
+                                     const int device_num) {
+  CHECK(false);
+}
+void CudaMgr::copyDeviceToPinnedHost(int8_t* host_ptr,
+                                     const int8_t* device_ptr,
+                                     const size_t num_bytes,
+                                     const int device_num) {
+  CHECK(false);
+}
+bool CudaMgr::isPinnedHostMem(const int8_t* host_ptr, const size_t num_bytes) const {
+  CHECK(false);
+  return false;
+}
+
+CUstream CudaMgr::getQueryStream(const int device_num, const size_t stream_id) {
+  CHECK(false);
+  return nullptr;
+}
+
 int8_t* CudaMgr::allocatePinnedHostMem(const size_t num_bytes) {
   CHECK(false);
   return nullptr;
@@ -32,7 +32,8 @@ void AbstractBuffer::initEncoder(const SQLTypeInfo& tmp_sql_type) {
 
 void AbstractBuffer::syncEncoder(const AbstractBuffer* src_buffer) {
   if (src_buffer->hasEncoder()) {
-    if (!hasEncoder()) {
+    // The chunks of a dictionary encoded column change width when its ids are widened.
+    if (!hasEncoder() || sql_type_.get_size() != src_buffer->sql_type_.get_size()) {
       initEncoder(src_buffer->sql_type_);
     }
     encoder_->copyMetadata(src_buffer->encoder_.get());
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include "DataMgr/Allocators/HugePageAllocator.h"
 #include "DataMgr/DataMgr.h"
 #include "Shared/checked_alloc.h"
 
@@ -33,10 +34,10 @@ class SysAllocator {
   constexpr SysAllocator(const SysAllocator<U>&) noexcept {}
 
   [[nodiscard]] T* allocate(size_t count) {
-    return reinterpret_cast<T*>(checked_malloc(count));
+    return reinterpret_cast<T*>(huge_page_checked_malloc(count));
   }
 
-  void deallocate(T* p, size_t /* count */) { free(p); }
+  void deallocate(T* p, size_t /* count */) { huge_page_free(p); }
 
   friend bool operator==(Self const&, Self const&) noexcept { return true; }
   friend bool operator!=(Self const&, Self const&) noexcept { return false; }
@@ -0,0 +1,68 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdlib>
+
+#include "OSDependent/omnisci_hugepages.h"
+#include "Shared/checked_alloc.h"
+
+extern bool g_enable_huge_pages;
+
+/**
+ * Allocations spanning at least one huge page are placed on huge pages when enabled,
+ * which cuts the TLB misses of random accesses into multi-GB buffers such as buffer pool
+ * slabs, group by buffers and join hash tables. Falls back to malloc otherwise.
+ */
+inline void* huge_page_checked_malloc(const size_t size) {
+  if (g_enable_huge_pages && size >= omnisci::kHugePageSize) {
+    if (auto addr = omnisci::allocate_huge_pages(size)) {
+      return addr;
+    }
+  }
+  return checked_malloc(size);
+}
+
+inline void huge_page_free(void* addr) {
+  if (!omnisci::free_huge_pages(addr)) {
+    free(addr);
+  }
+}
+
+template <class T>
+class HugePageAllocator {
+ public:
+  using value_type = T;
+
+  constexpr HugePageAllocator() = default;
+
+  template <class U>
+  constexpr HugePageAllocator(const HugePageAllocator<U>&) noexcept {}
+
+  [[nodiscard]] T* allocate(size_t count) {
+    return reinterpret_cast<T*>(huge_page_checked_malloc(count * sizeof(T)));
+  }
+
+  void deallocate(T* p, size_t /* count */) { huge_page_free(p); }
+
+  friend bool operator==(const HugePageAllocator&, const HugePageAllocator&) noexcept {
+    return true;
+  }
+  friend bool operator!=(const HugePageAllocator&, const HugePageAllocator&) noexcept {
+    return false;
+  }
+};
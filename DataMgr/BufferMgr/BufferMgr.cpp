@@ -32,6 +32,9 @@
 
 using namespace std;
 
+bool g_enable_scan_resistant_buffer_eviction{false};
+bool g_enable_buffer_pool_defragmentation{false};
+
 namespace Buffer_Namespace {
 
 std::string BufferMgr::keyToString(const ChunkKey& key) {
@@ -164,6 +167,20 @@ BufferList::iterator BufferMgr::evict(BufferList::iterator& evict_start,
     }
     num_pages += evict_it->num_pages;
     if (evict_it->mem_status == USED && evict_it->chunk_key.size() > 0) {
+      switch (getEvictionTier(*evict_it)) {
+        case EvictionTier::SINGLE_USE:
+          ++num_evicted_single_use_chunks_;
+          break;
+        case EvictionTier::REUSED:
+          ++num_evicted_reused_chunks_;
+          break;
+        case EvictionTier::HINTED:
+          ++num_evicted_hinted_chunks_;
+          break;
+      }
+      if (evict_it->chunk_key[0] != -1 && !evict_it->buffer->isDirty()) {
+        retainEvictedChunk(evict_it->chunk_key, evict_it->buffer);
+      }
       chunk_index_.erase(evict_it->chunk_key);
     }
     evict_it = slab_segments_[slab_num].erase(
@@ -174,6 +191,7 @@ BufferList::iterator BufferMgr::evict(BufferList::iterator& evict_start,
       start_page, num_pages_requested, USED, buffer_epoch_++);  // until we can
   // data_seg.pinCount++;
   data_seg.slab_num = slab_num;
+  data_seg.access_count = 1;
   auto data_seg_it =
       slab_segments_[slab_num].insert(evict_it, data_seg);  // Will insert before evict_it
   if (num_pages_requested < num_pages) {
@@ -217,11 +235,12 @@ BufferList::iterator BufferMgr::reserveBuffer(
   }
   // If we're here then we couldn't keep buffer in existing slot
   // need to find new segment, copy data over, and then delete old
-  auto new_seg_it = findFreeBuffer(num_bytes);
+  auto new_seg_it = findFreeBuffer(num_bytes, seg_it->chunk_key);
 
   // Below should be in copy constructor for BufferSeg?
   new_seg_it->buffer = seg_it->buffer;
   new_seg_it->chunk_key = seg_it->chunk_key;
+  new_seg_it->access_count = std::max(new_seg_it->access_count, seg_it->access_count);
   int8_t* old_mem = new_seg_it->buffer->mem_;
   new_seg_it->buffer->mem_ =
       slabs_[new_seg_it->slab_num] + new_seg_it->start_page * page_size_;
@@ -256,6 +275,7 @@ BufferList::iterator BufferMgr::findFreeBufferInSlab(const size_t slab_num,
       buffer_it->num_pages = num_pages_requested;
       buffer_it->mem_status = USED;
       buffer_it->last_touched = buffer_epoch_++;
+      buffer_it->access_count = 1;
       buffer_it->slab_num = slab_num;
       if (excess_pages > 0) {
         BufferSeg free_seg(
@@ -273,7 +293,8 @@ BufferList::iterator BufferMgr::findFreeBufferInSlab(const size_t slab_num,
   return slab_segments_[slab_num].end();
 }
 
-BufferList::iterator BufferMgr::findFreeBuffer(size_t num_bytes) {
+BufferList::iterator BufferMgr::findFreeBuffer(size_t num_bytes,
+                                               const ChunkKey& chunk_key) {
   size_t num_pages_requested = (num_bytes + page_size_ - 1) / page_size_;
   if (num_pages_requested > max_num_pages_per_slab_) {
     throw TooBigForSlab(num_bytes);
@@ -281,7 +302,18 @@ BufferList::iterator BufferMgr::findFreeBuffer(size_t num_bytes) {
 
   size_t num_slabs = slab_segments_.size();
 
+  std::vector<size_t> other_slabs;
   for (size_t slab_num = 0; slab_num != num_slabs; ++slab_num) {
+    if (!isPreferredSlab(slab_num, chunk_key)) {
+      other_slabs.push_back(slab_num);
+      continue;
+    }
+    auto seg_it = findFreeBufferInSlab(slab_num, num_pages_requested);
+    if (seg_it != slab_segments_[slab_num].end()) {
+      return seg_it;
+    }
+  }
+  for (const auto slab_num : other_slabs) {
     auto seg_it = findFreeBufferInSlab(slab_num, num_pages_requested);
     if (seg_it != slab_segments_[slab_num].end()) {
       return seg_it;
@@ -343,7 +375,22 @@ BufferList::iterator BufferMgr::findFreeBuffer(size_t num_bytes) {
     throw FailedToCreateFirstSlab(num_bytes);
   }
 
+  // Enough pages may be free, just not in one piece; coalescing them beats evicting
+  if (g_enable_buffer_pool_defragmentation &&
+      getFragmentationInfo().free_pages >= num_pages_requested) {
+    const auto num_moved = defragmentSlabsUnlocked();
+    VLOG(1) << "ALLOCATION defragmentation moved " << num_moved << " chunks "
+            << getStringMgrType() << ":" << device_id_;
+    for (size_t slab_num = 0; slab_num != num_slabs; ++slab_num) {
+      auto seg_it = findFreeBufferInSlab(slab_num, num_pages_requested);
+      if (seg_it != slab_segments_[slab_num].end()) {
+        return seg_it;
+      }
+    }
+  }
+
   // If here then we can't add a slab - so we need to evict
+  std::lock_guard<std::mutex> eviction_hints_lock(eviction_hints_mutex_);
 
   size_t min_score = std::numeric_limits<size_t>::max();
   // We're going for lowest score here, like golf
@@ -383,7 +430,16 @@ BufferList::iterator BufferMgr::findFreeBuffer(size_t num_bytes) {
           // chunk score was larger than one large chunk so it always would evict a large
           // chunk so under memory pressure a query would evict its own current chunks and
           // cause reloads rather than evict several smaller unused older chunks.
-          score = std::max(score, static_cast<size_t>(evict_it->last_touched));
+          size_t seg_score = evict_it->last_touched;
+          // Scan resistance: rank segments by tier first and by recency second, so
+          // chunks read once by a large scan go before the reused working set and
+          // hinted tables go last.
+          auto tier = getEvictionTier(*evict_it);
+          if (!g_enable_scan_resistant_buffer_eviction && tier == EvictionTier::REUSED) {
+            tier = EvictionTier::SINGLE_USE;
+          }
+          seg_score |= static_cast<size_t>(tier) << 32;
+          score = std::max(score, seg_score);
         }
         if (page_count >= num_pages_requested) {
           solution_found = true;
@@ -448,6 +504,11 @@ std::string BufferMgr::printSlab(size_t slab_num) {
     }
     tss << std::endl;
   }
+  const auto fragmentation = getSlabFragmentationInfo(slab_num);
+  tss << "Free pages " << fragmentation.free_pages << " in "
+      << fragmentation.num_free_segments << " segments, largest "
+      << fragmentation.largest_free_segment_pages << ", fragmentation "
+      << fragmentation.getFragmentationPercent() << "%" << std::endl;
   return tss.str();
 }
 
@@ -477,6 +538,7 @@ void BufferMgr::clearSlabs() {
       }
     }
   }
+  discardEvictedChunks({});
   if (!pinned_exists) {
     // lets actually clear the buffer from memory
     freeAllMem();
@@ -599,6 +661,7 @@ void BufferMgr::deleteBuffer(const ChunkKey& key, const bool) {
   auto seg_it = buffer_it->second;
   chunk_index_.erase(buffer_it);
   chunk_index_lock.unlock();
+  discardEvictedChunks(key);
   std::lock_guard<std::mutex> sized_segs_lock(sized_segs_mutex_);
   if (seg_it->buffer) {
     delete seg_it->buffer;  // Delete Buffer for segment
@@ -615,6 +678,7 @@ void BufferMgr::deleteBuffersWithPrefix(const ChunkKey& key_prefix, const bool)
                            // reserveBuffer which needs segs_mutex_ and then
                            // chunk_index_mutex_
   std::lock_guard<std::mutex> chunk_index_lock(chunk_index_mutex_);
+  discardEvictedChunks(key_prefix);
   auto startChunkIt = chunk_index_.lower_bound(key_prefix);
   if (startChunkIt == chunk_index_.end()) {
     return;
@@ -726,6 +790,8 @@ AbstractBuffer* BufferMgr::getBuffer(const ChunkKey& key, const size_t num_bytes
     sized_segs_lock.unlock();
 
     buffer_it->second->last_touched = buffer_epoch_++;  // race
+    buffer_it->second->access_count++;
+    ++num_hits_;
 
     if (buffer_it->second->buffer->size() < num_bytes) {
       // need to fetch part of buffer we don't have - up to numBytes
@@ -734,8 +800,15 @@ AbstractBuffer* BufferMgr::getBuffer(const ChunkKey& key, const size_t num_bytes
     return buffer_it->second->buffer;
   } else {  // If wasn't in pool then we need to fetch it
     sized_segs_lock.unlock();
+    ++num_misses_;
     // createChunk pins for us
     AbstractBuffer* buffer = createBuffer(key, page_size_, num_bytes);
+    if (restoreEvictedChunk(key, buffer)) {
+      ++num_restored_chunks_;
+      if (num_bytes == 0 || buffer->size() >= num_bytes) {
+        return buffer;
+      }
+    }
     try {
       parent_mgr_->fetchBuffer(
           key, buffer, num_bytes);  // this should put buffer in a BufferSegment
@@ -768,7 +841,13 @@ void BufferMgr::fetchBuffer(const ChunkKey& key,
     CHECK(parent_mgr_ != 0);
     buffer = createBuffer(key, page_size_, num_bytes);  // will pin buffer
     try {
-      parent_mgr_->fetchBuffer(key, buffer, num_bytes);
+      const bool restored = restoreEvictedChunk(key, buffer);
+      if (restored) {
+        ++num_restored_chunks_;
+      }
+      if (!restored || num_bytes > buffer->size()) {
+        parent_mgr_->fetchBuffer(key, buffer, num_bytes);
+      }
     } catch (std::runtime_error& error) {
       LOG(FATAL) << "Could not fetch parent buffer " << keyToString(key);
     }
@@ -796,6 +875,7 @@ AbstractBuffer* BufferMgr::putBuffer(const ChunkKey& key,
   auto buffer_it = chunk_index_.find(key);
   bool found_buffer = buffer_it != chunk_index_.end();
   chunk_index_lock.unlock();
+  discardEvictedChunks(key);
   AbstractBuffer* buffer;
   if (!found_buffer) {
     buffer = createBuffer(key, page_size_);
@@ -875,6 +955,148 @@ const std::vector<BufferList>& BufferMgr::getSlabSegments() {
   return slab_segments_;
 }
 
+void BufferMgr::setTableEvictionHint(const int db_id,
+                                     const int tb_id,
+                                     const bool keep_resident) {
+  std::lock_guard<std::mutex> eviction_hints_lock(eviction_hints_mutex_);
+  if (keep_resident) {
+    keep_resident_tables_.emplace(db_id, tb_id);
+  } else {
+    keep_resident_tables_.erase({db_id, tb_id});
+  }
+}
+
+bool BufferMgr::hasTableEvictionHint(const int db_id, const int tb_id) {
+  std::lock_guard<std::mutex> eviction_hints_lock(eviction_hints_mutex_);
+  return keep_resident_tables_.count({db_id, tb_id}) > 0;
+}
+
+BufferPoolStats BufferMgr::getBufferPoolStats() {
+  BufferPoolStats stats;
+  stats.hits = num_hits_;
+  stats.misses = num_misses_;
+  stats.evicted_single_use_chunks = num_evicted_single_use_chunks_;
+  stats.evicted_reused_chunks = num_evicted_reused_chunks_;
+  stats.evicted_hinted_chunks = num_evicted_hinted_chunks_;
+  stats.evicted_chunks = stats.evicted_single_use_chunks + stats.evicted_reused_chunks +
+                         stats.evicted_hinted_chunks;
+  stats.restored_chunks = num_restored_chunks_;
+  stats.retained_chunk_bytes = getRetainedChunkBytes();
+  return stats;
+}
+
+SlabFragmentationInfo BufferMgr::getSlabFragmentationInfo(const size_t slab_num) const {
+  SlabFragmentationInfo info;
+  for (const auto& segment : slab_segments_[slab_num]) {
+    if (segment.mem_status == FREE) {
+      info.free_pages += segment.num_pages;
+      info.num_free_segments++;
+      info.largest_free_segment_pages =
+          std::max(info.largest_free_segment_pages, segment.num_pages);
+    }
+  }
+  return info;
+}
+
+SlabFragmentationInfo BufferMgr::getFragmentationInfo() {
+  SlabFragmentationInfo info;
+  for (size_t slab_num = 0; slab_num < slab_segments_.size(); ++slab_num) {
+    const auto slab_info = getSlabFragmentationInfo(slab_num);
+    info.free_pages += slab_info.free_pages;
+    info.num_free_segments += slab_info.num_free_segments;
+    info.largest_free_segment_pages =
+        std::max(info.largest_free_segment_pages, slab_info.largest_free_segment_pages);
+  }
+  return info;
+}
+
+size_t BufferMgr::defragmentSlabs() {
+  std::lock_guard<std::mutex> lock(global_mutex_);
+  std::lock_guard<std::mutex> sized_segs_lock(sized_segs_mutex_);
+  const auto before = getFragmentationInfo();
+  size_t num_moved{0};
+  auto defrag_ms = measure<>::execution([&]() { num_moved = defragmentSlabsUnlocked(); });
+  const auto after = getFragmentationInfo();
+  LOG(INFO) << "Defragmented " << getStringMgrType() << ":" << device_id_ << " moving "
+            << num_moved << " chunks in " << defrag_ms << " ms, free segments "
+            << before.num_free_segments << " -> " << after.num_free_segments
+            << ", largest free segment " << before.largest_free_segment_pages << " -> "
+            << after.largest_free_segment_pages << " pages";
+  return num_moved;
+}
+
+size_t BufferMgr::defragmentSlabsUnlocked() {
+  size_t num_moved{0};
+  for (size_t slab_num = 0; slab_num < slab_segments_.size(); ++slab_num) {
+    for (auto seg_it = slab_segments_[slab_num].begin();
+         seg_it != slab_segments_[slab_num].end();
+         ++seg_it) {
+      // Pinned chunks are being read or written, their memory cannot move
+      if (seg_it->mem_status == USED && seg_it->buffer && seg_it->buffer->mem_ &&
+          seg_it->buffer->getPinCount() < 1 && relocateSegment(seg_it, slab_num)) {
+        num_moved++;
+      }
+    }
+  }
+  return num_moved;
+}
+
+bool BufferMgr::relocateSegment(BufferList::iterator& seg_it, const size_t slab_num) {
+  // First fit among the free segments at lower addresses, which never overlap the
+  // segment being moved
+  const auto num_pages = seg_it->num_pages;
+  BufferList::iterator target_it;
+  int target_slab = -1;
+  for (size_t candidate_slab = 0; candidate_slab <= slab_num && target_slab < 0;
+       ++candidate_slab) {
+    auto& segs = slab_segments_[candidate_slab];
+    const auto end_it = candidate_slab == slab_num ? seg_it : segs.end();
+    for (auto it = segs.begin(); it != end_it; ++it) {
+      if (it->mem_status == FREE && it->num_pages >= num_pages) {
+        target_it = it;
+        target_slab = candidate_slab;
+        break;
+      }
+    }
+  }
+  if (target_slab < 0) {
+    return false;
+  }
+
+  if (target_it->num_pages > num_pages) {
+    BufferSeg free_seg(
+        target_it->start_page + num_pages, target_it->num_pages - num_pages, FREE);
+    slab_segments_[target_slab].insert(std::next(target_it), free_seg);
+    target_it->num_pages = num_pages;
+  }
+  target_it->mem_status = USED;
+  target_it->slab_num = target_slab;
+  target_it->buffer = seg_it->buffer;
+  target_it->chunk_key = seg_it->chunk_key;
+  target_it->last_touched = seg_it->last_touched;
+  target_it->access_count = seg_it->access_count;
+
+  auto buffer = target_it->buffer;
+  int8_t* old_mem = buffer->mem_;
+  buffer->mem_ = slabs_[target_slab] + target_it->start_page * page_size_;
+  buffer->writeData(old_mem, buffer->size(), 0, buffer->getType(), device_id_);
+  buffer->seg_it_ = target_it;
+  {
+    std::lock_guard<std::mutex> lock(chunk_index_mutex_);
+    chunk_index_[target_it->chunk_key] = target_it;
+  }
+  removeSegment(seg_it);
+  return true;
+}
+
+BufferMgr::EvictionTier BufferMgr::getEvictionTier(const BufferSeg& seg) const {
+  if (seg.chunk_key.size() >= 2 &&
+      keep_resident_tables_.count({seg.chunk_key[0], seg.chunk_key[1]})) {
+    return EvictionTier::HINTED;
+  }
+  return seg.access_count > 1 ? EvictionTier::REUSED : EvictionTier::SINGLE_USE;
+}
+
 void BufferMgr::removeTableRelatedDS(const int db_id, const int table_id) {
   UNREACHABLE();
 }
@@ -26,10 +26,12 @@
 
 #define BOOST_STACKTRACE_GNU_SOURCE_NOT_REQUIRED 1
 
+#include <atomic>
 #include <iostream>
 #include <list>
 #include <map>
 #include <mutex>
+#include <set>
 
 #include "DataMgr/AbstractBuffer.h"
 #include "DataMgr/AbstractBufferMgr.h"
@@ -84,8 +86,36 @@ class TooBigForSlab : public OutOfMemory {
 
 using namespace Data_Namespace;
 
+// Evict chunks touched only once before the frequently reused ones, so a large scan
+// cannot flush the working set out of the buffer pool.
+extern bool g_enable_scan_resistant_buffer_eviction;
+// Move unpinned chunks together to coalesce fragmented free space before evicting.
+extern bool g_enable_buffer_pool_defragmentation;
+
 namespace Buffer_Namespace {
 
+struct BufferPoolStats {
+  size_t hits{0};
+  size_t misses{0};
+  size_t evicted_chunks{0};
+  size_t evicted_single_use_chunks{0};
+  size_t evicted_reused_chunks{0};
+  size_t evicted_hinted_chunks{0};
+  size_t restored_chunks{0};       // misses served from evicted chunks kept by the pool
+  size_t retained_chunk_bytes{0};  // bytes of the evicted chunks kept by the pool
+};
+
+struct SlabFragmentationInfo {
+  size_t free_pages{0};
+  size_t num_free_segments{0};
+  size_t largest_free_segment_pages{0};
+
+  // Share of the free pages lying outside of the largest free segment.
+  size_t getFragmentationPercent() const {
+    return free_pages ? 100 - (largest_free_segment_pages * 100) / free_pages : 0;
+  }
+};
+
 /**
  * @class   BufferMgr
  * @brief
@@ -169,6 +199,23 @@ class BufferMgr : public AbstractBufferMgr {  // implements
   void getChunkMetadataVecForKeyPrefix(ChunkMetadataVector& chunk_metadata_vec,
                                        const ChunkKey& key_prefix) override;
 
+  /**
+   * Hints that the chunks of the given table should stay resident. Unpinned chunks of
+   * hinted tables are only evicted once no other chunk can make room, they are never
+   * pinned for good.
+   */
+  void setTableEvictionHint(const int db_id, const int tb_id, const bool keep_resident);
+  bool hasTableEvictionHint(const int db_id, const int tb_id);
+  BufferPoolStats getBufferPoolStats();
+
+  /**
+   * Moves unpinned chunks into free segments at lower addresses, within and across
+   * slabs, so the free space coalesces into fewer and larger segments. Meant for idle
+   * windows since every move copies the chunk. Returns the number of chunks moved.
+   */
+  size_t defragmentSlabs();
+  SlabFragmentationInfo getFragmentationInfo();
+
  protected:
   const size_t
       max_buffer_pool_size_;    /// max number of bytes allocated for the buffer pool
@@ -187,8 +234,27 @@ class BufferMgr : public AbstractBufferMgr {  // implements
   void removeSegment(BufferList::iterator& seg_it);
   BufferList::iterator findFreeBufferInSlab(const size_t slab_num,
                                             const size_t num_pages_requested);
+  SlabFragmentationInfo getSlabFragmentationInfo(const size_t slab_num) const;
+  size_t defragmentSlabsUnlocked();
+  bool relocateSegment(BufferList::iterator& seg_it, const size_t slab_num);
   int getBufferId();
   virtual void addSlab(const size_t slab_size) = 0;
+  /// Whether free space for the chunk should be looked for in this slab first, before
+  /// falling back to the others.
+  virtual bool isPreferredSlab(const size_t slab_num, const ChunkKey& chunk_key) const {
+    return true;
+  }
+  /// Lets the pool keep a clean chunk which is being evicted in another form, such as
+  /// compressed. The memory of the chunk is reused once this returns.
+  virtual void retainEvictedChunk(const ChunkKey& chunk_key, AbstractBuffer* buffer) {}
+  /// Fills a newly created buffer with a chunk kept by retainEvictedChunk(), returning
+  /// false if there is none.
+  virtual bool restoreEvictedChunk(const ChunkKey& chunk_key, AbstractBuffer* buffer) {
+    return false;
+  }
+  /// Drops the kept chunks whose keys start with the prefix, all of them if empty.
+  virtual void discardEvictedChunks(const ChunkKey& key_prefix) {}
+  virtual size_t getRetainedChunkBytes() { return 0; }
   virtual void freeAllMem() = 0;
   virtual void allocateBuffer(BufferList::iterator seg_it,
                               const size_t page_size,
@@ -212,6 +278,20 @@ class BufferMgr : public AbstractBufferMgr {  // implements
 
   BufferList unsized_segs_;
 
+  std::mutex eviction_hints_mutex_;
+  std::set<std::pair<int, int>> keep_resident_tables_;
+
+  std::atomic<size_t> num_hits_{0};
+  std::atomic<size_t> num_misses_{0};
+  std::atomic<size_t> num_evicted_single_use_chunks_{0};
+  std::atomic<size_t> num_evicted_reused_chunks_{0};
+  std::atomic<size_t> num_evicted_hinted_chunks_{0};
+  std::atomic<size_t> num_restored_chunks_{0};
+
+  enum class EvictionTier { SINGLE_USE = 0, REUSED = 1, HINTED = 2 };
+  // Must be called with eviction_hints_mutex_ held.
+  EvictionTier getEvictionTier(const BufferSeg& seg) const;
+
   BufferList::iterator evict(BufferList::iterator& evict_start,
                              const size_t num_pages_requested,
                              const int slab_num);
@@ -228,7 +308,7 @@ class BufferMgr : public AbstractBufferMgr {  // implements
    * USED if applicable
    *
    */
-  BufferList::iterator findFreeBuffer(size_t num_bytes);
+  BufferList::iterator findFreeBuffer(size_t num_bytes, const ChunkKey& chunk_key);
 };
 
 }  // namespace Buffer_Namespace
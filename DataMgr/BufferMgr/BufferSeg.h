@@ -36,9 +36,15 @@ struct BufferSeg {
   unsigned int pin_count;
   int slab_num;
   unsigned int last_touched;
+  unsigned int access_count;  // number of times the chunk was requested while resident
 
   BufferSeg()
-      : mem_status(FREE), buffer(0), pin_count(0), slab_num(-1), last_touched(0) {}
+      : mem_status(FREE)
+      , buffer(0)
+      , pin_count(0)
+      , slab_num(-1)
+      , last_touched(0)
+      , access_count(0) {}
   BufferSeg(const int start_page, const size_t num_pages)
       : start_page(start_page)
       , num_pages(num_pages)
@@ -46,7 +52,8 @@ struct BufferSeg {
       , buffer(0)
       , pin_count(0)
       , slab_num(-1)
-      , last_touched(0) {}
+      , last_touched(0)
+      , access_count(0) {}
   BufferSeg(const int start_page, const size_t num_pages, const MemStatus mem_status)
       : start_page(start_page)
       , num_pages(num_pages)
@@ -54,7 +61,8 @@ struct BufferSeg {
       , buffer(0)
       , pin_count(0)
       , slab_num(-1)
-      , last_touched(0) {}
+      , last_touched(0)
+      , access_count(0) {}
   BufferSeg(const int start_page,
             const size_t num_pages,
             const MemStatus mem_status,
@@ -65,7 +73,8 @@ struct BufferSeg {
       , buffer(0)
       , pin_count(0)
       , slab_num(-1)
-      , last_touched(last_touched) {}
+      , last_touched(last_touched)
+      , access_count(0) {}
 };
 
 using BufferList = std::list<BufferSeg>;
@@ -19,26 +19,103 @@
 #include "CudaMgr/CudaMgr.h"
 #include "DataMgr/Allocators/ArenaAllocator.h"
 #include "DataMgr/BufferMgr/CpuBufferMgr/CpuBuffer.h"
+#include "OSDependent/omnisci_numa.h"
+#include "Shared/Compressor.h"
+
+bool g_enable_numa_aware_buffers{false};
+bool g_enable_huge_pages{false};
+size_t g_cpu_buffer_pool_pinned_bytes{0};
+size_t g_cpu_compressed_chunk_cache_bytes{0};
 
 namespace Buffer_Namespace {
 
+namespace {
+
+// Slabs are assigned to the NUMA nodes round robin, in allocation order.
+int get_slab_numa_node(const size_t slab_num) {
+  return slab_num % omnisci::get_numa_node_count();
+}
+
+const char* get_chunk_compression_codec() {
+  static const char* codec =
+      BloscCompressor::isCodecAvailable("lz4") ? "lz4" : "blosclz";
+  return codec;
+}
+
+bool key_has_prefix(const ChunkKey& key, const ChunkKey& key_prefix) {
+  return key.size() >= key_prefix.size() &&
+         std::equal(key_prefix.begin(), key_prefix.end(), key.begin());
+}
+
+}  // namespace
+
+int CpuBufferMgr::getNumaNodeForFragment(const int fragment_id) {
+  const auto node_count = omnisci::get_numa_node_count();
+  if (!g_enable_numa_aware_buffers || node_count < 2 || fragment_id < 0) {
+    return -1;
+  }
+  return fragment_id % node_count;
+}
+
 void CpuBufferMgr::addSlab(const size_t slab_size) {
   CHECK(allocator_);
   slabs_.resize(slabs_.size() + 1);
-  try {
-    slabs_.back() = reinterpret_cast<int8_t*>(allocator_->allocate(slab_size));
-  } catch (std::bad_alloc&) {
-    slabs_.resize(slabs_.size() - 1);
-    throw FailedToCreateSlab(slab_size);
+  slabs_.back() = nullptr;
+  bool pinned = false;
+  // Pinned slabs let the GPU copy chunks straight out of the buffer pool
+  if (cuda_mgr_ && pinned_bytes_ + slab_size <= g_cpu_buffer_pool_pinned_bytes) {
+    try {
+      slabs_.back() = cuda_mgr_->allocatePinnedHostMem(slab_size);
+      pinned_slabs_.push_back(slabs_.back());
+      pinned_bytes_ += slab_size;
+      pinned = true;
+    } catch (const std::runtime_error& e) {
+      LOG(WARNING) << "Could not allocate CPU buffer pool slab " << slabs_.size() - 1
+                   << " as pinned memory, using pageable memory instead: " << e.what();
+    }
+  }
+  if (!pinned) {
+    try {
+      slabs_.back() = reinterpret_cast<int8_t*>(allocator_->allocate(slab_size));
+    } catch (std::bad_alloc&) {
+      slabs_.resize(slabs_.size() - 1);
+      throw FailedToCreateSlab(slab_size);
+    }
+  }
+  if (!pinned && g_enable_numa_aware_buffers && omnisci::get_numa_node_count() > 1) {
+    const auto node = get_slab_numa_node(slabs_.size() - 1);
+    if (!omnisci::bind_memory_to_numa_node(slabs_.back(), slab_size, node)) {
+      LOG(WARNING) << "Could not bind CPU buffer pool slab " << slabs_.size() - 1
+                   << " to NUMA node " << node;
+    }
   }
   slab_segments_.resize(slab_segments_.size() + 1);
   slab_segments_[slab_segments_.size() - 1].push_back(
       BufferSeg(0, slab_size / page_size_));
 }
 
+bool CpuBufferMgr::isPreferredSlab(const size_t slab_num,
+                                   const ChunkKey& chunk_key) const {
+  if (chunk_key.size() <= CHUNK_KEY_FRAGMENT_IDX) {
+    return true;
+  }
+  const auto node = getNumaNodeForFragment(chunk_key[CHUNK_KEY_FRAGMENT_IDX]);
+  return node < 0 || get_slab_numa_node(slab_num) == node;
+}
+
 void CpuBufferMgr::freeAllMem() {
   CHECK(allocator_);
   allocator_.reset(new Arena(max_slab_size_ + kArenaBlockOverhead));
+  freePinnedSlabs();
+}
+
+void CpuBufferMgr::freePinnedSlabs() {
+  for (auto slab : pinned_slabs_) {
+    CHECK(cuda_mgr_);
+    cuda_mgr_->freePinnedHostMem(slab);
+  }
+  pinned_slabs_.clear();
+  pinned_bytes_ = 0;
 }
 
 void CpuBufferMgr::allocateBuffer(BufferList::iterator seg_it,
@@ -55,4 +132,109 @@ void CpuBufferMgr::allocateBuffer(BufferList::iterator seg_it,
                                 // buffer member
 }
 
+void CpuBufferMgr::retainEvictedChunk(const ChunkKey& chunk_key,
+                                      AbstractBuffer* buffer) {
+  const auto size = buffer->size();
+  if (size == 0 || size > g_cpu_compressed_chunk_cache_bytes) {
+    return;
+  }
+  // Chunks which do not shrink by a quarter are cheaper to read from disk again.
+  CompressedChunk chunk;
+  chunk.data.resize(size - size / 4);
+  chunk.size = size;
+  const auto type_size =
+      buffer->hasEncoder() ? std::max(buffer->getSqlType().get_size(), 1) : 1;
+  size_t compressed_size{0};
+  try {
+    compressed_size = BloscCompressor::compressBlock(
+        reinterpret_cast<const uint8_t*>(buffer->getMemoryPtr()),
+        size,
+        chunk.data.data(),
+        chunk.data.size(),
+        get_chunk_compression_codec(),
+        type_size);
+  } catch (const CompressionFailedError&) {
+    return;
+  }
+  if (compressed_size == 0) {
+    return;
+  }
+  chunk.data.resize(compressed_size);
+  chunk.data.shrink_to_fit();
+  if (buffer->hasEncoder()) {
+    chunk.sql_type = buffer->getSqlType();
+    chunk.encoder.reset(Encoder::Create(nullptr, chunk.sql_type));
+    chunk.encoder->copyMetadata(buffer->getEncoder());
+  }
+
+  std::lock_guard<std::mutex> lock(compressed_chunks_mutex_);
+  auto chunk_it = compressed_chunks_.find(chunk_key);
+  if (chunk_it != compressed_chunks_.end()) {
+    eraseCompressedChunk(chunk_it);
+  }
+  compressed_chunks_lru_.push_front(chunk_key);
+  chunk.lru_it = compressed_chunks_lru_.begin();
+  compressed_chunk_bytes_ += compressed_size;
+  compressed_chunks_.emplace(chunk_key, std::move(chunk));
+  while (compressed_chunk_bytes_ > g_cpu_compressed_chunk_cache_bytes) {
+    eraseCompressedChunk(compressed_chunks_.find(compressed_chunks_lru_.back()));
+  }
+}
+
+bool CpuBufferMgr::restoreEvictedChunk(const ChunkKey& chunk_key,
+                                       AbstractBuffer* buffer) {
+  CompressedChunk chunk;
+  {
+    std::lock_guard<std::mutex> lock(compressed_chunks_mutex_);
+    auto chunk_it = compressed_chunks_.find(chunk_key);
+    if (chunk_it == compressed_chunks_.end()) {
+      return false;
+    }
+    chunk.data = std::move(chunk_it->second.data);
+    chunk.size = chunk_it->second.size;
+    chunk.sql_type = chunk_it->second.sql_type;
+    chunk.encoder = std::move(chunk_it->second.encoder);
+    eraseCompressedChunk(chunk_it);
+  }
+  // Reserving may evict other chunks, so the lock is not held from here on.
+  buffer->reserve(chunk.size);
+  try {
+    BloscCompressor::decompressBlock(chunk.data.data(),
+                                     reinterpret_cast<uint8_t*>(buffer->getMemoryPtr()),
+                                     chunk.size);
+  } catch (const CompressionFailedError& e) {
+    LOG(WARNING) << "Could not decompress evicted chunk " << show_chunk(chunk_key)
+                 << ", reading it again: " << e.what();
+    return false;
+  }
+  buffer->setSize(chunk.size);
+  if (chunk.encoder) {
+    buffer->initEncoder(chunk.sql_type);
+    buffer->getEncoder()->copyMetadata(chunk.encoder.get());
+  }
+  return true;
+}
+
+void CpuBufferMgr::discardEvictedChunks(const ChunkKey& key_prefix) {
+  std::lock_guard<std::mutex> lock(compressed_chunks_mutex_);
+  auto chunk_it = compressed_chunks_.lower_bound(key_prefix);
+  while (chunk_it != compressed_chunks_.end() &&
+         key_has_prefix(chunk_it->first, key_prefix)) {
+    eraseCompressedChunk(chunk_it++);
+  }
+}
+
+size_t CpuBufferMgr::getRetainedChunkBytes() {
+  std::lock_guard<std::mutex> lock(compressed_chunks_mutex_);
+  return compressed_chunk_bytes_;
+}
+
+void CpuBufferMgr::eraseCompressedChunk(
+    std::map<ChunkKey, CompressedChunk>::iterator chunk_it) {
+  CHECK(chunk_it != compressed_chunks_.end());
+  compressed_chunk_bytes_ -= chunk_it->second.data.size();
+  compressed_chunks_lru_.erase(chunk_it->second.lru_it);
+  compressed_chunks_.erase(chunk_it);
+}
+
 }  // namespace Buffer_Namespace
@@ -18,7 +18,20 @@
 
 #include "DataMgr/BufferMgr/BufferMgr.h"
 
+#include <list>
+#include <map>
+#include <mutex>
+#include <vector>
+
 #include "DataMgr/Allocators/ArenaAllocator.h"
+#include "DataMgr/Encoder.h"
+
+// Spreads the CPU buffer pool slabs and the fragments stored in them over NUMA nodes.
+extern bool g_enable_numa_aware_buffers;
+// Bytes of CPU buffer pool slabs allocated as CUDA pinned host memory, 0 disables.
+extern size_t g_cpu_buffer_pool_pinned_bytes;
+// Bytes of compressed copies of evicted chunks kept by the CPU buffer pool, 0 disables.
+extern size_t g_cpu_compressed_chunk_cache_bytes;
 
 namespace CudaMgr_Namespace {
 class CudaMgr;
@@ -47,20 +60,50 @@ class CpuBufferMgr : public BufferMgr {
 
   ~CpuBufferMgr() {
     /* the destruction of the allocator automatically frees all memory */
+    freePinnedSlabs();
   }
 
   inline MgrType getMgrType() override { return CPU_MGR; }
   inline std::string getStringMgrType() override { return ToString(CPU_MGR); }
 
+  /**
+   * Returns the NUMA node whose slabs, if there is room, hold the chunks of the given
+   * fragment, or -1 when NUMA aware placement is off or the machine has a single node.
+   */
+  static int getNumaNodeForFragment(const int fragment_id);
+
  private:
   void addSlab(const size_t slab_size) override;
+  bool isPreferredSlab(const size_t slab_num, const ChunkKey& chunk_key) const override;
   void freeAllMem() override;
+  void freePinnedSlabs();
   void allocateBuffer(BufferList::iterator segment_iter,
                       const size_t page_size,
                       const size_t initial_size) override;
+  void retainEvictedChunk(const ChunkKey& chunk_key, AbstractBuffer* buffer) override;
+  bool restoreEvictedChunk(const ChunkKey& chunk_key, AbstractBuffer* buffer) override;
+  void discardEvictedChunks(const ChunkKey& key_prefix) override;
+  size_t getRetainedChunkBytes() override;
+
+  struct CompressedChunk {
+    std::vector<uint8_t> data;
+    size_t size;
+    SQLTypeInfo sql_type;
+    std::unique_ptr<Encoder> encoder;  // holds the chunk metadata only
+    std::list<ChunkKey>::iterator lru_it;
+  };
+  // Must be called with compressed_chunks_mutex_ held.
+  void eraseCompressedChunk(std::map<ChunkKey, CompressedChunk>::iterator chunk_it);
 
   CudaMgr_Namespace::CudaMgr* cuda_mgr_;
   std::unique_ptr<Arena> allocator_;
+  std::vector<int8_t*> pinned_slabs_;
+  size_t pinned_bytes_{0};
+
+  std::mutex compressed_chunks_mutex_;
+  std::map<ChunkKey, CompressedChunk> compressed_chunks_;
+  std::list<ChunkKey> compressed_chunks_lru_;  // most recently evicted first
+  size_t compressed_chunk_bytes_{0};
 };
 
 }  // namespace Buffer_Namespace
@@ -37,6 +37,10 @@ void GpuCudaBuffer::readData(int8_t* const dst,
                              const MemoryLevel dst_buffer_type,
                              const int dst_device_id) {
   if (dst_buffer_type == CPU_LEVEL) {
+    if (cuda_mgr_->isPinnedHostMem(dst, num_bytes)) {
+      cuda_mgr_->copyDeviceToPinnedHost(dst, mem_ + offset, num_bytes, device_id_);
+      return;
+    }
     cuda_mgr_->copyDeviceToHost(
         dst, mem_ + offset, num_bytes, device_id_);  // need to replace 0 with gpu num
   } else if (dst_buffer_type == GPU_LEVEL) {
@@ -55,6 +59,10 @@ void GpuCudaBuffer::writeData(int8_t* const src,
                               const int src_device_id) {
   if (src_buffer_type == CPU_LEVEL) {
     // std::cout << "Writing to GPU from source CPU" << std::endl;
+    if (cuda_mgr_->isPinnedHostMem(src, num_bytes)) {
+      cuda_mgr_->copyPinnedHostToDevice(mem_ + offset, src, num_bytes, device_id_);
+      return;
+    }
 
     cuda_mgr_->copyHostToDevice(
         mem_ + offset, src, num_bytes, device_id_);  // need to replace 0 with gpu num
@@ -20,6 +20,11 @@
  */
 
 #include "DataMgr/Chunk/Chunk.h"
+
+#include <cstring>
+#include <mutex>
+#include <vector>
+
 #include "DataMgr/ArrayNoneEncoder.h"
 #include "DataMgr/FixedLengthArrayNoneEncoder.h"
 #include "DataMgr/StringNoneEncoder.h"
@@ -104,6 +109,35 @@ void Chunk::getChunkBuffer(DataMgr* data_mgr,
     }
   } else {
     buffer_ = data_mgr->getChunkBuffer(key, mem_level, device_id, num_bytes);
+    replicateSingleValue(mem_level, num_bytes);
+  }
+}
+
+void Chunk::replicateSingleValue(const MemoryLevel mem_level, const size_t num_bytes) {
+  const auto& ti = column_desc_->columnType;
+  if (!isReplicatedValueType(ti) || !buffer_->hasEncoder()) {
+    return;
+  }
+  const size_t elem_size = ti.get_size();
+  // Partial reads of other chunks are not mistaken for a single value.
+  if (buffer_->size() != elem_size || (num_bytes != 0 && num_bytes != elem_size)) {
+    return;
+  }
+  static std::mutex replicate_mutex;
+  std::lock_guard<std::mutex> lock(replicate_mutex);
+  const size_t num_elems = buffer_->getEncoder()->getNumElems();
+  if (buffer_->size() != elem_size || num_elems < 2) {
+    return;
+  }
+  std::vector<int8_t> values(elem_size * (num_elems - 1));
+  buffer_->read(values.data(), elem_size);
+  for (size_t offset = elem_size; offset < values.size(); offset += elem_size) {
+    std::memcpy(values.data() + offset, values.data(), elem_size);
+  }
+  buffer_->append(values.data(), values.size());
+  if (mem_level != Data_Namespace::DISK_LEVEL) {
+    // The buffer pools only hold the replicated rows, the chunk on disk is unchanged.
+    buffer_->clearDirtyBits();
   }
 }
 
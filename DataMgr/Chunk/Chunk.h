@@ -97,6 +97,17 @@ class Chunk {
                                          const size_t num_bytes,
                                          const size_t num_elems);
 
+  /**
+   * Columns added to a table with ALTER TABLE ADD COLUMN can store a single copy of the
+   * default value in the chunks of the existing fragments, with the row count of the
+   * fragment in the encoder. getChunkBuffer() replicates the value over all the rows
+   * when such a chunk is read, into the buffer pools only, and on disk when the chunk
+   * is opened at the disk level to be written.
+   */
+  static bool isReplicatedValueType(const SQLTypeInfo& ti) {
+    return !ti.is_varlen() && !ti.is_array() && !ti.is_geometry() && ti.get_size() > 0;
+  }
+
   bool isChunkOnDevice(DataMgr* data_mgr,
                        const ChunkKey& key,
                        const MemoryLevel mem_level,
@@ -126,6 +137,7 @@ class Chunk {
   const ColumnDescriptor* column_desc_;
 
   void unpinBuffer();
+  void replicateSingleValue(const MemoryLevel mem_level, const size_t num_bytes);
 };
 
 }  // namespace Chunk_NS
@@ -0,0 +1,94 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "DataMgr/Chunk/ChunkPrefetcher.h"
+
+#include <algorithm>
+
+#include "Logger/Logger.h"
+
+namespace Chunk_NS {
+
+ChunkPrefetcher::ChunkPrefetcher(DataMgr* data_mgr,
+                                 std::vector<std::vector<ChunkPrefetchRequest>>&& batches,
+                                 const size_t depth)
+    : data_mgr_(data_mgr), batches_(std::move(batches)), depth_(depth) {
+  CHECK(data_mgr_);
+  CHECK_GT(depth_, size_t(0));
+  prefetch_thread_ = std::thread([this] { run(); });
+}
+
+ChunkPrefetcher::~ChunkPrefetcher() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopped_ = true;
+  }
+  batch_started_.notify_all();
+  prefetch_thread_.join();
+}
+
+void ChunkPrefetcher::startBatch(const size_t batch_idx) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    started_batch_count_ = std::max(started_batch_count_, batch_idx + 1);
+  }
+  batch_started_.notify_all();
+}
+
+void ChunkPrefetcher::run() {
+  size_t prefetched_chunk_count{0};
+  for (size_t batch_idx = 0; batch_idx < batches_.size(); ++batch_idx) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      batch_started_.wait(lock, [this, batch_idx] {
+        return stopped_ || batch_idx < started_batch_count_ + depth_;
+      });
+      if (stopped_) {
+        break;
+      }
+      if (batch_idx < started_batch_count_) {
+        // its consumer is already fetching these chunks
+        continue;
+      }
+    }
+    for (const auto& request : batches_[batch_idx]) {
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopped_) {
+          return;
+        }
+      }
+      try {
+        // dropping the chunk right away unpins it, the buffers stay in the pool
+        Chunk::getChunk(request.cd,
+                        data_mgr_,
+                        request.key,
+                        Data_Namespace::CPU_LEVEL,
+                        0,
+                        request.num_bytes,
+                        request.num_elems);
+      } catch (const std::exception& e) {
+        // out of buffer pool memory most likely, leave it to the consumers
+        VLOG(1) << "Stopped prefetching chunks: " << e.what();
+        return;
+      }
+      ++prefetched_chunk_count;
+    }
+  }
+  VLOG(1) << "Prefetched " << prefetched_chunk_count << " chunks.";
+}
+
+}  // namespace Chunk_NS
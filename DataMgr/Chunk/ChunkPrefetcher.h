@@ -0,0 +1,67 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "DataMgr/Chunk/Chunk.h"
+
+namespace Chunk_NS {
+
+struct ChunkPrefetchRequest {
+  const ColumnDescriptor* cd;
+  ChunkKey key;
+  size_t num_bytes;
+  size_t num_elems;
+};
+
+/**
+ * Reads chunks into the CPU buffer pool on a background thread, ahead of the consumers
+ * which will fetch them. Requests come in batches, typically the input chunks of one
+ * execution kernel, and the prefetcher never runs more than `depth` batches ahead of the
+ * last batch a consumer has started on. Prefetched chunks aren't kept pinned, they stay
+ * in the buffer pool like any other chunk until evicted.
+ */
+class ChunkPrefetcher {
+ public:
+  ChunkPrefetcher(DataMgr* data_mgr,
+                  std::vector<std::vector<ChunkPrefetchRequest>>&& batches,
+                  const size_t depth);
+
+  ~ChunkPrefetcher();
+
+  // Called by the consumer of batch `batch_idx` before fetching its chunks.
+  void startBatch(const size_t batch_idx);
+
+ private:
+  void run();
+
+  DataMgr* data_mgr_;
+  const std::vector<std::vector<ChunkPrefetchRequest>> batches_;
+  const size_t depth_;
+
+  std::mutex mutex_;
+  std::condition_variable batch_started_;
+  size_t started_batch_count_{0};
+  bool stopped_{false};
+  std::thread prefetch_thread_;
+};
+
+}  // namespace Chunk_NS
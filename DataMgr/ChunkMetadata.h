@@ -16,7 +16,11 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <cstddef>
+#include <memory>
+#include <vector>
 #include "../Shared/sqltypes.h"
 #include "Shared/types.h"
 
@@ -28,11 +32,76 @@ struct ChunkStats {
   bool has_nulls;
 };
 
+// Min and max of the non null values in a block of rows, min > max if only nulls.
+struct BlockStats {
+  int64_t min;
+  int64_t max;
+  bool has_nulls;
+  // Sorted distinct non null values, null when the block isn't value indexed.
+  std::shared_ptr<const std::vector<int64_t>> values;
+
+  bool mayContain(const int64_t val) const {
+    if (val < min || val > max) {
+      return false;
+    }
+    return !values || std::binary_search(values->begin(), values->end(), val);
+  }
+};
+
+// Zone maps of the consecutive blocks of rows of an integer or time chunk. Blocks hold
+// `block_rows` rows each, or end at the rows in `block_end_rows` when it isn't empty.
+struct BlockZoneMaps {
+  size_t block_rows;
+  std::vector<BlockStats> blocks;
+  std::vector<size_t> block_end_rows;
+
+  // Number of blocks over the first `num_rows` rows of the chunk, 0 if inconsistent.
+  size_t getNumBlocks(const size_t num_rows) const {
+    if (!block_end_rows.empty()) {
+      return block_end_rows.size() == blocks.size() && block_end_rows.back() == num_rows
+                 ? blocks.size()
+                 : 0;
+    }
+    return block_rows ? (num_rows + block_rows - 1) / block_rows : 0;
+  }
+
+  size_t getBlockEndRow(const size_t block) const {
+    return block_end_rows.empty() ? (block + 1) * block_rows : block_end_rows[block];
+  }
+
+  bool hasSameBlocks(const BlockZoneMaps& that) const {
+    return block_rows == that.block_rows && block_end_rows == that.block_end_rows;
+  }
+};
+
+// Bounding boxes of the consecutive blocks of `block_rows` rows of the coords of a point
+// chunk or of the bounds of a linestring or polygon chunk, a one level R-tree packed in
+// insert order.
+struct BlockBounds {
+  size_t block_rows;
+  // X min, y min, x max and y max of each block, min > max if the block only has nulls.
+  std::vector<std::array<double, 4>> bounds;
+
+  bool mayIntersect(const size_t block, const std::array<double, 4>& box) const {
+    const auto& block_box = bounds[block];
+    return block_box[0] <= box[2] && box[0] <= block_box[2] && block_box[1] <= box[3] &&
+           box[1] <= block_box[3];
+  }
+};
+
+struct ColumnStats;
+
 struct ChunkMetadata {
   SQLTypeInfo sqlType;
   size_t numBytes;
   size_t numElements;
   ChunkStats chunkStats;
+  // Only kept in memory, null when the encoder has no valid block zone maps.
+  std::shared_ptr<const BlockZoneMaps> blockZoneMaps;
+  // Only kept in memory, null when the encoder has no valid column stats.
+  std::shared_ptr<const ColumnStats> columnStats;
+  // Only kept in memory, null when the encoder has no valid block bounds.
+  std::shared_ptr<const BlockBounds> blockBounds;
 
   std::string dump() const {
     auto type = sqlType.is_array() ? sqlType.get_elem_type() : sqlType;
@@ -0,0 +1,221 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "DataMgr/ColumnStats.h"
+
+#include <algorithm>
+#include <cmath>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#include "Logger/Logger.h"
+
+bool g_enable_column_stats{false};
+
+namespace {
+
+constexpr size_t kHllRegisters{size_t(1) << ColumnStats::kHllBits};
+
+// Finalizer of MurmurHash3, spreads the bits of integer keys well enough for the sketch.
+uint64_t hash_value(const int64_t val) {
+  auto hash = static_cast<uint64_t>(val);
+  hash ^= hash >> 33;
+  hash *= 0xff51afd7ed558ccdULL;
+  hash ^= hash >> 33;
+  hash *= 0xc4ceb3f99b6b4bc5ULL;
+  hash ^= hash >> 33;
+  return hash;
+}
+
+// Keeps `max_size` values of a sorted weighted sample, evenly spaced by weight.
+void compact_sample(std::vector<std::pair<int64_t, double>>& sample,
+                    const size_t max_size) {
+  if (sample.size() <= max_size) {
+    return;
+  }
+  double total_weight{0};
+  for (const auto& entry : sample) {
+    total_weight += entry.second;
+  }
+  const auto weight = total_weight / max_size;
+  std::vector<std::pair<int64_t, double>> compacted;
+  compacted.reserve(max_size);
+  double cumulative_weight{0};
+  for (const auto& entry : sample) {
+    cumulative_weight += entry.second;
+    while (compacted.size() < max_size &&
+           cumulative_weight >= (compacted.size() + 0.5) * weight) {
+      compacted.emplace_back(entry.first, weight);
+    }
+  }
+  sample = std::move(compacted);
+}
+
+}  // namespace
+
+double ColumnStats::getDistinctValuesEstimate() const {
+  if (!num_values || hll_registers.size() != kHllRegisters) {
+    return 0;
+  }
+  const double m = kHllRegisters;
+  double denominator{0};
+  size_t zeros{0};
+  for (const auto reg : hll_registers) {
+    denominator += std::ldexp(1.0, -static_cast<int>(reg));
+    zeros += reg == 0;
+  }
+  auto estimate = 0.7213 / (1 + 1.079 / m) * m * m / denominator;
+  if (estimate <= 2.5 * m && zeros) {
+    estimate = m * std::log(m / zeros);
+  }
+  return std::min(std::max(estimate, 1.0), static_cast<double>(num_values));
+}
+
+double ColumnStats::getNullFraction() const {
+  const auto num_rows = num_values + num_nulls;
+  return num_rows ? static_cast<double>(num_nulls) / num_rows : 0;
+}
+
+std::vector<int64_t> ColumnStats::getHistogramBounds(const size_t num_buckets) const {
+  CHECK_GT(num_buckets, size_t(0));
+  if (sample.empty()) {
+    return {};
+  }
+  double total_weight{0};
+  for (const auto& entry : sample) {
+    total_weight += entry.second;
+  }
+  std::vector<int64_t> bounds{sample.front().first};
+  double cumulative_weight{0};
+  auto sample_it = sample.begin();
+  for (size_t bucket = 1; bucket < num_buckets; ++bucket) {
+    const auto bound_weight = total_weight * bucket / num_buckets;
+    while (sample_it + 1 != sample.end() &&
+           cumulative_weight + sample_it->second < bound_weight) {
+      cumulative_weight += sample_it->second;
+      ++sample_it;
+    }
+    bounds.push_back(sample_it->first);
+  }
+  bounds.push_back(sample.back().first);
+  return bounds;
+}
+
+void ColumnStats::merge(const ColumnStats& that) {
+  if (hll_registers.empty()) {
+    hll_registers = that.hll_registers;
+  } else if (!that.hll_registers.empty()) {
+    CHECK_EQ(hll_registers.size(), that.hll_registers.size());
+    for (size_t i = 0; i < hll_registers.size(); ++i) {
+      hll_registers[i] = std::max(hll_registers[i], that.hll_registers[i]);
+    }
+  }
+  std::vector<std::pair<int64_t, double>> merged_sample;
+  merged_sample.reserve(sample.size() + that.sample.size());
+  std::merge(sample.begin(),
+             sample.end(),
+             that.sample.begin(),
+             that.sample.end(),
+             std::back_inserter(merged_sample));
+  compact_sample(merged_sample, kMaxSampleSize);
+  sample = std::move(merged_sample);
+  num_values += that.num_values;
+  num_nulls += that.num_nulls;
+}
+
+void ColumnStatsBuilder::reset() {
+  valid_ = g_enable_column_stats;
+  num_rows_ = 0;
+  num_values_ = 0;
+  num_nulls_ = 0;
+  hll_registers_.clear();
+  if (valid_) {
+    hll_registers_.resize(kHllRegisters, 0);
+  }
+  sample_.clear();
+  rng_.seed();
+}
+
+void ColumnStatsBuilder::invalidate() {
+  valid_ = false;
+  hll_registers_.clear();
+  sample_.clear();
+}
+
+void ColumnStatsBuilder::update(const size_t row, const int64_t val, const bool is_null) {
+  if (!valid_) {
+    return;
+  }
+  if (row > num_rows_) {
+    invalidate();
+    return;
+  }
+  if (row < num_rows_) {
+    if (!is_null) {
+      addToSketch(val);
+    }
+    return;
+  }
+  ++num_rows_;
+  if (is_null) {
+    ++num_nulls_;
+    return;
+  }
+  addToSketch(val);
+  ++num_values_;
+  if (sample_.size() < ColumnStats::kMaxSampleSize) {
+    sample_.push_back(val);
+    return;
+  }
+  const auto pos = rng_() % num_values_;
+  if (pos < sample_.size()) {
+    sample_[pos] = val;
+  }
+}
+
+void ColumnStatsBuilder::addToSketch(const int64_t val) {
+  constexpr uint32_t kRankBits{64 - ColumnStats::kHllBits};
+  const auto hash = hash_value(val);
+  const auto index = hash >> kRankBits;
+  const auto rest = hash << ColumnStats::kHllBits;
+#ifdef _MSC_VER
+  const auto leading_zeros = rest ? __lzcnt64(rest) : 64;
+#else
+  const auto leading_zeros = rest ? __builtin_clzll(rest) : 64;
+#endif
+  const auto rank = static_cast<uint8_t>(
+      std::min(kRankBits, static_cast<uint32_t>(leading_zeros)) + 1);
+  hll_registers_[index] = std::max(hll_registers_[index], rank);
+}
+
+std::shared_ptr<const ColumnStats> ColumnStatsBuilder::get(const size_t num_rows) const {
+  if (!valid_ || num_rows_ != num_rows) {
+    return nullptr;
+  }
+  auto column_stats = std::make_shared<ColumnStats>();
+  column_stats->hll_registers = hll_registers_;
+  const auto weight =
+      sample_.empty() ? 0 : static_cast<double>(num_values_) / sample_.size();
+  column_stats->sample.reserve(sample_.size());
+  for (const auto val : sample_) {
+    column_stats->sample.emplace_back(val, weight);
+  }
+  std::sort(column_stats->sample.begin(), column_stats->sample.end());
+  column_stats->num_values = num_values_;
+  column_stats->num_nulls = num_nulls_;
+  return column_stats;
+}
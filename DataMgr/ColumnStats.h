@@ -0,0 +1,89 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+// Keep distinct value sketches and histograms of integer, time and dictionary encoded
+// chunks.
+extern bool g_enable_column_stats;
+
+/**
+ * Approximate distribution of the values of a chunk, or of a whole column once the
+ * stats of its chunks are merged: a HyperLogLog sketch of the distinct non null values
+ * and a weighted sample of them, from which equi-depth histograms are drawn. Only kept
+ * in memory, like the block zone maps.
+ */
+struct ColumnStats {
+  static constexpr size_t kHllBits{10};
+  static constexpr size_t kMaxSampleSize{256};
+
+  std::vector<uint8_t> hll_registers;
+  // Sampled values in ascending order, each standing for `second` values.
+  std::vector<std::pair<int64_t, double>> sample;
+  size_t num_values{0};
+  size_t num_nulls{0};
+
+  double getDistinctValuesEstimate() const;
+
+  double getNullFraction() const;
+
+  // Returns `num_buckets` + 1 ascending bounds of buckets holding about as many values
+  // each, from the min to the max sampled value, or nothing without values.
+  std::vector<int64_t> getHistogramBounds(const size_t num_buckets) const;
+
+  void merge(const ColumnStats& that);
+};
+
+/**
+ * Builds the column stats of a chunk from the values written at each row, with the
+ * same lifecycle as the block zone maps: appends must start right after the rows seen
+ * so far and untracked writes drop the stats until the chunk is rewritten in full.
+ * Rewrites of earlier rows only add to the sketch, which keeps it an upper bound.
+ */
+class ColumnStatsBuilder {
+ public:
+  void reset();
+
+  void invalidate();
+
+  void beginAppend(const size_t first_row) {
+    if (first_row != num_rows_) {
+      invalidate();
+    }
+  }
+
+  void update(const size_t row, const int64_t val, const bool is_null);
+
+  std::shared_ptr<const ColumnStats> get(const size_t num_rows) const;
+
+ private:
+  void addToSketch(const int64_t val);
+
+  bool valid_{false};
+  size_t num_rows_{0};
+  size_t num_values_{0};
+  size_t num_nulls_{0};
+  std::vector<uint8_t> hll_registers_;
+  // Reservoir sample of the non null values.
+  std::vector<int64_t> sample_;
+  std::minstd_rand rng_;
+};
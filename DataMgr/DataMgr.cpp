@@ -25,6 +25,7 @@
 #include "CudaMgr/CudaMgr.h"
 #include "FileMgr/GlobalFileMgr.h"
 #include "PersistentStorageMgr/PersistentStorageMgr.h"
+#include "Shared/measure.h"
 
 #ifdef __APPLE__
 #include <sys/sysctl.h>
@@ -315,6 +316,10 @@ std::vector<MemoryInfo> DataMgr::getMemoryInfo(const MemoryLevel memLevel) {
     mi.maxNumPages = cpu_buffer->getMaxSize() / mi.pageSize;
     mi.isAllocationCapped = cpu_buffer->isAllocationCapped();
     mi.numPageAllocated = cpu_buffer->getAllocated() / mi.pageSize;
+    const auto fragmentation = cpu_buffer->getFragmentationInfo();
+    mi.numFreeSegments = fragmentation.num_free_segments;
+    mi.largestFreeSegmentPages = fragmentation.largest_free_segment_pages;
+    mi.fragmentationPercent = fragmentation.getFragmentationPercent();
 
     const auto& slab_segments = cpu_buffer->getSlabSegments();
     for (size_t slab_num = 0; slab_num < slab_segments.size(); ++slab_num) {
@@ -344,6 +349,10 @@ std::vector<MemoryInfo> DataMgr::getMemoryInfo(const MemoryLevel memLevel) {
       mi.maxNumPages = gpu_buffer->getMaxSize() / mi.pageSize;
       mi.isAllocationCapped = gpu_buffer->isAllocationCapped();
       mi.numPageAllocated = gpu_buffer->getAllocated() / mi.pageSize;
+      const auto fragmentation = gpu_buffer->getFragmentationInfo();
+      mi.numFreeSegments = fragmentation.num_free_segments;
+      mi.largestFreeSegmentPages = fragmentation.largest_free_segment_pages;
+      mi.fragmentationPercent = fragmentation.getFragmentationPercent();
 
       const auto& slab_segments = gpu_buffer->getSlabSegments();
       for (size_t slab_num = 0; slab_num < slab_segments.size(); ++slab_num) {
@@ -400,6 +409,73 @@ void DataMgr::clearMemory(const MemoryLevel memLevel) {
   }
 }
 
+void DataMgr::setTableEvictionHint(const int db_id,
+                                   const int tb_id,
+                                   const bool keep_resident) {
+  std::lock_guard<std::mutex> buffer_lock(buffer_access_mutex_);
+  for (size_t level = MemoryLevel::CPU_LEVEL; level < bufferMgrs_.size(); ++level) {
+    for (auto buffer_mgr : bufferMgrs_[level]) {
+      auto pool = dynamic_cast<Buffer_Namespace::BufferMgr*>(buffer_mgr);
+      CHECK(pool);
+      pool->setTableEvictionHint(db_id, tb_id, keep_resident);
+    }
+  }
+}
+
+bool DataMgr::hasTableEvictionHint(const int db_id, const int tb_id) {
+  std::lock_guard<std::mutex> buffer_lock(buffer_access_mutex_);
+  // every pool gets the same hints, the CPU pool speaks for all of them
+  auto pool = dynamic_cast<Buffer_Namespace::BufferMgr*>(
+      bufferMgrs_[MemoryLevel::CPU_LEVEL][0]);
+  CHECK(pool);
+  return pool->hasTableEvictionHint(db_id, tb_id);
+}
+
+Buffer_Namespace::BufferPoolStats DataMgr::getBufferPoolStats(
+    const MemoryLevel memLevel) {
+  Buffer_Namespace::BufferPoolStats stats;
+  for (const auto& pool_stats : getBufferPoolStatsPerDevice(memLevel)) {
+    stats.hits += pool_stats.hits;
+    stats.misses += pool_stats.misses;
+    stats.evicted_chunks += pool_stats.evicted_chunks;
+    stats.evicted_single_use_chunks += pool_stats.evicted_single_use_chunks;
+    stats.evicted_reused_chunks += pool_stats.evicted_reused_chunks;
+    stats.evicted_hinted_chunks += pool_stats.evicted_hinted_chunks;
+  }
+  return stats;
+}
+
+std::vector<Buffer_Namespace::BufferPoolStats> DataMgr::getBufferPoolStatsPerDevice(
+    const MemoryLevel memLevel) {
+  std::lock_guard<std::mutex> buffer_lock(buffer_access_mutex_);
+  CHECK_NE(memLevel, MemoryLevel::DISK_LEVEL);
+  std::vector<Buffer_Namespace::BufferPoolStats> stats;
+  if (static_cast<size_t>(memLevel) >= bufferMgrs_.size()) {
+    return stats;
+  }
+  for (auto buffer_mgr : bufferMgrs_[memLevel]) {
+    auto pool = dynamic_cast<Buffer_Namespace::BufferMgr*>(buffer_mgr);
+    CHECK(pool);
+    stats.push_back(pool->getBufferPoolStats());
+  }
+  return stats;
+}
+
+size_t DataMgr::defragmentMemory(const MemoryLevel memLevel) {
+  std::lock_guard<std::mutex> buffer_lock(buffer_access_mutex_);
+  CHECK_NE(memLevel, MemoryLevel::DISK_LEVEL);
+  size_t num_moved{0};
+  if (static_cast<size_t>(memLevel) >= bufferMgrs_.size()) {
+    return num_moved;
+  }
+  for (auto buffer_mgr : bufferMgrs_[memLevel]) {
+    auto pool = dynamic_cast<Buffer_Namespace::BufferMgr*>(buffer_mgr);
+    CHECK(pool);
+    num_moved += pool->defragmentSlabs();
+  }
+  return num_moved;
+}
+
 bool DataMgr::isBufferOnDevice(const ChunkKey& key,
                                const MemoryLevel memLevel,
                                const int deviceId) {
@@ -490,12 +566,14 @@ void DataMgr::checkpoint(const int db_id, const int tb_id) {
   // TODO(adb): do we need a buffer mgr lock here?
   // MAT Yes to reduce Parallel Executor TSAN issues (and correctness for now)
   std::lock_guard<std::mutex> buffer_lock(buffer_access_mutex_);
+  const auto clock_begin = timer_start();
   for (auto levelIt = bufferMgrs_.rbegin(); levelIt != bufferMgrs_.rend(); ++levelIt) {
     // use reverse iterator so we start at GPU level, then CPU then DISK
     for (auto deviceIt = levelIt->begin(); deviceIt != levelIt->end(); ++deviceIt) {
       (*deviceIt)->checkpoint(db_id, tb_id);
     }
   }
+  checkpoint_latencies_.record(timer_stop(clock_begin));
 }
 
 void DataMgr::checkpoint(const int db_id,
@@ -504,9 +582,11 @@ void DataMgr::checkpoint(const int db_id,
   std::lock_guard<std::mutex> buffer_lock(buffer_access_mutex_);
   CHECK_LT(static_cast<size_t>(memory_level), bufferMgrs_.size());
   CHECK_LT(static_cast<size_t>(memory_level), levelSizes_.size());
+  const auto clock_begin = timer_start();
   for (int device_id = 0; device_id < levelSizes_[memory_level]; device_id++) {
     bufferMgrs_[memory_level][device_id]->checkpoint(db_id, table_id);
   }
+  checkpoint_latencies_.record(timer_stop(clock_begin));
 }
 
 void DataMgr::checkpoint() {
@@ -524,6 +604,13 @@ void DataMgr::checkpoint() {
 void DataMgr::removeTableRelatedDS(const int db_id, const int tb_id) {
   std::lock_guard<std::mutex> buffer_lock(buffer_access_mutex_);
   bufferMgrs_[0][0]->removeTableRelatedDS(db_id, tb_id);
+  for (size_t level = MemoryLevel::CPU_LEVEL; level < bufferMgrs_.size(); ++level) {
+    for (auto buffer_mgr : bufferMgrs_[level]) {
+      auto pool = dynamic_cast<Buffer_Namespace::BufferMgr*>(buffer_mgr);
+      CHECK(pool);
+      pool->setTableEvictionHint(db_id, tb_id, false);
+    }
+  }
 }
 
 void DataMgr::setTableEpoch(const int db_id, const int tb_id, const int start_epoch) {
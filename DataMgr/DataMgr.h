@@ -21,6 +21,7 @@
 #ifndef DATAMGR_H
 #define DATAMGR_H
 
+#include "../Shared/LatencyHistogram.h"
 #include "../Shared/SystemParameters.h"
 #include "../Shared/mapd_shared_mutex.h"
 #include "AbstractBuffer.h"
@@ -62,6 +63,9 @@ struct MemoryInfo {
   size_t maxNumPages;
   size_t numPageAllocated;
   bool isAllocationCapped;
+  size_t numFreeSegments;
+  size_t largestFreeSegmentPages;
+  size_t fragmentationPercent;
   std::vector<MemoryData> nodeMemoryData;
 };
 
@@ -193,11 +197,24 @@ class DataMgr {
   std::vector<MemoryInfo> getMemoryInfo(const MemoryLevel memLevel);
   std::string dumpLevel(const MemoryLevel memLevel);
   void clearMemory(const MemoryLevel memLevel);
+  // Hints the CPU and GPU buffer pools to keep the chunks of the table resident.
+  void setTableEvictionHint(const int db_id, const int tb_id, const bool keep_resident);
+  bool hasTableEvictionHint(const int db_id, const int tb_id);
+  Buffer_Namespace::BufferPoolStats getBufferPoolStats(const MemoryLevel memLevel);
+  // Stats of each buffer pool of the level, indexed by device.
+  std::vector<Buffer_Namespace::BufferPoolStats> getBufferPoolStatsPerDevice(
+      const MemoryLevel memLevel);
+  // Coalesces the free space of the buffer pools of the level, returns the chunks moved.
+  size_t defragmentMemory(const MemoryLevel memLevel);
 
   const std::map<ChunkKey, File_Namespace::FileBuffer*>& getChunkMap();
   void checkpoint(const int db_id,
                   const int tb_id);  // checkpoint for individual table of DB
   void checkpoint(const int db_id, const int table_id, const MemoryLevel memory_level);
+  // Latencies of the table checkpoints, at all levels.
+  LatencyHistogram::Snapshot getCheckpointLatencies() const {
+    return checkpoint_latencies_.get();
+  }
   void getChunkMetadataVecForKeyPrefix(ChunkMetadataVector& chunkMetadataVec,
                                        const ChunkKey& keyPrefix);
   inline bool gpusPresent() const { return hasGpus_; }
@@ -244,6 +261,7 @@ class DataMgr {
   bool hasGpus_;
   size_t reservedGpuMem_;
   std::mutex buffer_access_mutex_;
+  LatencyHistogram checkpoint_latencies_;
 };
 
 std::ostream& operator<<(std::ostream& os, const DataMgr::SystemMemoryUsage&);
@@ -31,6 +31,7 @@ class DateDaysEncoder : public Encoder {
  public:
   DateDaysEncoder(Data_Namespace::AbstractBuffer* buffer) : Encoder(buffer) {
     resetChunkStats();
+    resetRowStats();
   }
 
   std::shared_ptr<ChunkMetadata> appendData(int8_t*& src_data,
@@ -41,12 +42,22 @@ class DateDaysEncoder : public Encoder {
     CHECK(ti.is_date_in_days());
     if (offset == 0 && num_elems_to_append >= num_elems_) {
       resetChunkStats();
+      resetRowStats();
+    }
+    const size_t start_row = offset == -1 ? num_elems_ : static_cast<size_t>(offset);
+    if (offset == -1) {
+      beginRowStatsAppend(start_row);
     }
     T* unencoded_data = reinterpret_cast<T*>(src_data);
     auto encoded_data = std::make_unique<V[]>(num_elems_to_append);
     for (size_t i = 0; i < num_elems_to_append; ++i) {
       size_t ri = replicating ? 0 : i;
       encoded_data.get()[i] = encodeDataAndUpdateStats(unencoded_data[ri]);
+      const bool is_null = unencoded_data[ri] == std::numeric_limits<V>::min();
+      const int64_t seconds =
+          is_null ? 0
+                  : DateConverters::get_epoch_seconds_from_days(encoded_data.get()[i]);
+      updateRowStats(start_row + i, seconds, is_null);
     }
 
     if (offset == -1) {
@@ -84,6 +95,7 @@ class DateDaysEncoder : public Encoder {
 
   // Only called from the executor for synthesized meta-information.
   void updateStats(const int64_t val, const bool is_null) override {
+    invalidateRowStats();
     if (is_null) {
       has_nulls = true;
     } else {
@@ -95,6 +107,7 @@ class DateDaysEncoder : public Encoder {
 
   // Only called from the executor for synthesized meta-information.
   void updateStats(const double val, const bool is_null) override {
+    invalidateRowStats();
     if (is_null) {
       has_nulls = true;
     } else {
@@ -105,6 +118,7 @@ class DateDaysEncoder : public Encoder {
   }
 
   void updateStats(const int8_t* const src_data, const size_t num_elements) override {
+    invalidateRowStats();
     const T* unencoded_data = reinterpret_cast<const T*>(src_data);
     for (size_t i = 0; i < num_elements; ++i) {
       encodeDataAndUpdateStats(unencoded_data[i]);
@@ -158,6 +172,7 @@ class DateDaysEncoder : public Encoder {
   }
 
   bool resetChunkStats(const ChunkStats& stats) override {
+    invalidateRowStats();
     const auto new_min = DatumFetcher::getDatumVal<T>(stats.min);
     const auto new_max = DatumFetcher::getDatumVal<T>(stats.max);
 
@@ -172,6 +187,7 @@ class DateDaysEncoder : public Encoder {
   }
 
   void resetChunkStats() override {
+    invalidateRowStats();
     dataMin = std::numeric_limits<T>::max();
     dataMax = std::numeric_limits<T>::lowest();
     has_nulls = false;
@@ -19,10 +19,15 @@
 #include "DateDaysEncoder.h"
 #include "FixedLengthArrayNoneEncoder.h"
 #include "FixedLengthEncoder.h"
+#include "Geospatial/CompressionRuntime.h"
 #include "Logger/Logger.h"
 #include "NoneEncoder.h"
 #include "StringNoneEncoder.h"
 
+size_t g_zone_map_block_rows{0};
+size_t g_dictionary_index_max_block_values{0};
+bool g_enable_geo_block_bounds{false};
+
 Encoder* Encoder::Create(Data_Namespace::AbstractBuffer* buffer,
                          const SQLTypeInfo sqlType) {
   switch (sqlType.get_compression()) {
@@ -180,20 +185,23 @@ Encoder* Encoder::Create(Data_Namespace::AbstractBuffer* buffer,
         return new ArrayNoneEncoder(buffer);
       } else {
         CHECK(sqlType.is_string());
+        Encoder* encoder{nullptr};
         switch (sqlType.get_size()) {
           case 1:
-            return new NoneEncoder<uint8_t>(buffer);
+            encoder = new NoneEncoder<uint8_t>(buffer);
             break;
           case 2:
-            return new NoneEncoder<uint16_t>(buffer);
+            encoder = new NoneEncoder<uint16_t>(buffer);
             break;
           case 4:
-            return new NoneEncoder<int32_t>(buffer);
+            encoder = new NoneEncoder<int32_t>(buffer);
             break;
           default:
             CHECK(false);
             break;
         }
+        encoder->block_zone_maps_.enableValueIndex();
+        return encoder;
       }
       break;
     }
@@ -218,6 +226,201 @@ Encoder* Encoder::Create(Data_Namespace::AbstractBuffer* buffer,
   return 0;
 }
 
+void BlockZoneMapBuilder::reset() {
+  block_rows_ = g_zone_map_block_rows;
+  blocks_.clear();
+  num_rows_ = 0;
+  valid_ = block_rows_ > 0;
+  open_block_values_.clear();
+  open_block_overflow_ = false;
+}
+
+void BlockZoneMapBuilder::enableValueIndex() {
+  max_block_values_ = g_dictionary_index_max_block_values;
+}
+
+void BlockZoneMapBuilder::invalidate() {
+  valid_ = false;
+  blocks_.clear();
+  open_block_values_.clear();
+  open_block_overflow_ = false;
+}
+
+void BlockZoneMapBuilder::update(const size_t row,
+                                 const int64_t val,
+                                 const bool is_null) {
+  if (!valid_) {
+    return;
+  }
+  if (row > num_rows_) {
+    invalidate();
+    return;
+  }
+  const auto block = row / block_rows_;
+  if (block == blocks_.size()) {
+    if (!blocks_.empty()) {
+      blocks_.back().values = getOpenBlockValues();
+      open_block_values_.clear();
+      open_block_overflow_ = false;
+    }
+    blocks_.push_back(BlockStats{std::numeric_limits<int64_t>::max(),
+                                 std::numeric_limits<int64_t>::lowest(),
+                                 false,
+                                 nullptr});
+  }
+  auto& stats = blocks_[block];
+  if (is_null) {
+    stats.has_nulls = true;
+  } else {
+    stats.min = std::min(stats.min, val);
+    stats.max = std::max(stats.max, val);
+    if (max_block_values_) {
+      addValue(block, val);
+    }
+  }
+  num_rows_ = std::max(num_rows_, row + 1);
+}
+
+void BlockZoneMapBuilder::addValue(const size_t block, const int64_t val) {
+  if (block + 1 == blocks_.size()) {
+    if (open_block_overflow_) {
+      return;
+    }
+    open_block_values_.insert(val);
+    if (open_block_values_.size() > max_block_values_) {
+      open_block_overflow_ = true;
+      open_block_values_.clear();
+    }
+    return;
+  }
+  // Rewrite of a row in an earlier block, whose values may already be shared.
+  auto& values = blocks_[block].values;
+  if (!values || std::binary_search(values->begin(), values->end(), val)) {
+    return;
+  }
+  if (values->size() >= max_block_values_) {
+    values = nullptr;
+    return;
+  }
+  auto new_values = std::make_shared<std::vector<int64_t>>(*values);
+  new_values->insert(std::lower_bound(new_values->begin(), new_values->end(), val), val);
+  values = new_values;
+}
+
+std::shared_ptr<const std::vector<int64_t>> BlockZoneMapBuilder::getOpenBlockValues()
+    const {
+  if (!max_block_values_ || open_block_overflow_) {
+    return nullptr;
+  }
+  auto values = std::make_shared<std::vector<int64_t>>(open_block_values_.begin(),
+                                                       open_block_values_.end());
+  std::sort(values->begin(), values->end());
+  return values;
+}
+
+std::shared_ptr<const BlockZoneMaps> BlockZoneMapBuilder::get(
+    const size_t num_rows) const {
+  if (!valid_ || blocks_.empty() || num_rows_ != num_rows) {
+    return nullptr;
+  }
+  auto zone_maps = std::make_shared<BlockZoneMaps>(BlockZoneMaps{block_rows_, blocks_});
+  zone_maps->blocks.back().values = getOpenBlockValues();
+  return zone_maps;
+}
+
+void BlockBoundsBuilder::reset(const SQLTypeInfo& type) {
+  layout_ = Layout::kNone;
+  if (type.is_array() && type.get_subtype() == kDOUBLE &&
+      type.get_size() == 4 * sizeof(double)) {
+    layout_ = Layout::kBounds;
+  } else if (type.is_array() && type.get_subtype() == kTINYINT &&
+             type.get_size() == 2 * sizeof(double)) {
+    layout_ = Layout::kPointCoords;
+  } else if (type.is_array() && type.get_subtype() == kTINYINT &&
+             type.get_size() == 2 * sizeof(int32_t)) {
+    layout_ = Layout::kCompressedPointCoords;
+  }
+  block_rows_ = g_enable_geo_block_bounds ? g_zone_map_block_rows : 0;
+  bounds_.clear();
+  num_rows_ = 0;
+  valid_ = layout_ != Layout::kNone && block_rows_ > 0;
+}
+
+void BlockBoundsBuilder::invalidate() {
+  valid_ = false;
+  bounds_.clear();
+}
+
+void BlockBoundsBuilder::update(const size_t row,
+                                const int8_t* array,
+                                const bool is_null) {
+  if (!valid_) {
+    return;
+  }
+  if (row != num_rows_) {
+    invalidate();
+    return;
+  }
+  const auto block = row / block_rows_;
+  if (block == bounds_.size()) {
+    bounds_.push_back({std::numeric_limits<double>::max(),
+                       std::numeric_limits<double>::max(),
+                       std::numeric_limits<double>::lowest(),
+                       std::numeric_limits<double>::lowest()});
+  }
+  ++num_rows_;
+  if (is_null) {
+    return;
+  }
+  std::array<double, 4> box;
+  switch (layout_) {
+    case Layout::kBounds: {
+      const auto bounds = reinterpret_cast<const double*>(array);
+      if (bounds[0] == NULL_ARRAY_DOUBLE || bounds[0] == NULL_DOUBLE) {
+        return;
+      }
+      box = {bounds[0], bounds[1], bounds[2], bounds[3]};
+      break;
+    }
+    case Layout::kPointCoords: {
+      const auto coords = reinterpret_cast<const double*>(array);
+      if (coords[0] == NULL_ARRAY_DOUBLE || coords[0] == NULL_DOUBLE) {
+        return;
+      }
+      box = {coords[0], coords[1], coords[0], coords[1]};
+      break;
+    }
+    case Layout::kCompressedPointCoords: {
+      const auto coords = reinterpret_cast<const int32_t*>(array);
+      if (Geospatial::is_null_point_longitude_geoint32(coords[0])) {
+        return;
+      }
+      // Widened by the tolerance of the compression, rows are compared decompressed.
+      const auto x = Geospatial::decompress_longitude_coord_geoint32(coords[0]);
+      const auto y = Geospatial::decompress_lattitude_coord_geoint32(coords[1]);
+      box = {x - TOLERANCE_GEOINT32,
+             y - TOLERANCE_GEOINT32,
+             x + TOLERANCE_GEOINT32,
+             y + TOLERANCE_GEOINT32};
+      break;
+    }
+    default:
+      UNREACHABLE();
+  }
+  auto& block_box = bounds_[block];
+  block_box[0] = std::min(block_box[0], box[0]);
+  block_box[1] = std::min(block_box[1], box[1]);
+  block_box[2] = std::max(block_box[2], box[2]);
+  block_box[3] = std::max(block_box[3], box[3]);
+}
+
+std::shared_ptr<const BlockBounds> BlockBoundsBuilder::get(const size_t num_rows) const {
+  if (!valid_ || bounds_.empty() || num_rows_ != num_rows) {
+    return nullptr;
+  }
+  return std::make_shared<BlockBounds>(BlockBounds{block_rows_, bounds_});
+}
+
 Encoder::Encoder(Data_Namespace::AbstractBuffer* buffer)
     : num_elems_(0)
     , buffer_(buffer)
@@ -228,4 +431,6 @@ void Encoder::getMetadata(const std::shared_ptr<ChunkMetadata>& chunkMetadata) {
   chunkMetadata->sqlType = buffer_->getSqlType();
   chunkMetadata->numBytes = buffer_->size();
   chunkMetadata->numElements = num_elems_;
+  chunkMetadata->blockZoneMaps = block_zone_maps_.get(num_elems_);
+  chunkMetadata->columnStats = column_stats_.get(num_elems_);
 }
@@ -21,11 +21,15 @@
 #include "../Shared/sqltypes.h"
 #include "../Shared/types.h"
 #include "ChunkMetadata.h"
+#include "ColumnStats.h"
 
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 #include <limits>
+#include <memory>
 #include <stdexcept>
+#include <unordered_set>
 #include <vector>
 
 namespace Data_Namespace {
@@ -35,6 +39,92 @@ class AbstractBuffer;
 // default max input buffer size to 1MB
 #define MAX_INPUT_BUF_SIZE 1048576
 
+// Rows per block of the zone maps kept by the integer and time encoders, 0 disables.
+extern size_t g_zone_map_block_rows;
+// Max distinct dictionary ids indexed per zone map block of dictionary encoded
+// columns, 0 disables the index.
+extern size_t g_dictionary_index_max_block_values;
+// Keep the bounding boxes of the zone map blocks of point, linestring and polygon
+// columns.
+extern bool g_enable_geo_block_bounds;
+
+/**
+ * Builds the block zone maps of a chunk from the values written at each row. Writes
+ * which cannot be tracked by row, such as vacuuming or stats only updates, drop the
+ * maps until the chunk is rewritten in full, since stale maps would let the executor
+ * skip rows which match.
+ *
+ * With the value index enabled, the distinct values of each block are kept as well,
+ * which makes the maps an inverted index from dictionary id to the blocks holding it.
+ */
+class BlockZoneMapBuilder {
+ public:
+  void reset();
+
+  void enableValueIndex();
+
+  void invalidate();
+
+  // Appends must start right after the rows seen so far.
+  void beginAppend(const size_t first_row) {
+    if (first_row != num_rows_) {
+      invalidate();
+    }
+  }
+
+  void update(const size_t row, const int64_t val, const bool is_null);
+
+  std::shared_ptr<const BlockZoneMaps> get(const size_t num_rows) const;
+
+ private:
+  void addValue(const size_t block, const int64_t val);
+
+  std::shared_ptr<const std::vector<int64_t>> getOpenBlockValues() const;
+
+  size_t block_rows_{0};
+  std::vector<BlockStats> blocks_;
+  size_t num_rows_{0};
+  bool valid_{false};
+
+  // Distinct values of the last block, which is still being appended to.
+  size_t max_block_values_{0};
+  std::unordered_set<int64_t> open_block_values_;
+  bool open_block_overflow_{false};
+};
+
+/**
+ * Builds the block bounds of a geo coords or bounds chunk from the rows appended to it.
+ * Only appends in row order are tracked, any other write drops the bounds until the
+ * chunk is rewritten in full.
+ */
+class BlockBoundsBuilder {
+ public:
+  // Picks the layout of the rows from the type of the physical geo column, fixed length
+  // arrays of other types get no bounds.
+  void reset(const SQLTypeInfo& type);
+
+  void invalidate();
+
+  void beginAppend(const size_t first_row) {
+    if (first_row != num_rows_) {
+      invalidate();
+    }
+  }
+
+  void update(const size_t row, const int8_t* array, const bool is_null);
+
+  std::shared_ptr<const BlockBounds> get(const size_t num_rows) const;
+
+ private:
+  enum class Layout { kNone, kBounds, kPointCoords, kCompressedPointCoords };
+
+  Layout layout_{Layout::kNone};
+  size_t block_rows_{0};
+  std::vector<std::array<double, 4>> bounds_;
+  size_t num_rows_{0};
+  bool valid_{false};
+};
+
 class DecimalOverflowValidator {
  public:
   DecimalOverflowValidator(SQLTypeInfo type) {
@@ -233,13 +323,43 @@ class Encoder {
   size_t getNumElems() const { return num_elems_; }
   void setNumElems(const size_t num_elems) { num_elems_ = num_elems; }
 
+  // Sets the number of rows of a chunk which stores a single value for all its rows, see
+  // Chunk::isReplicatedValueType(). The row level stats no longer cover the rows.
+  void setReplicatedNumElems(const size_t num_elems) {
+    num_elems_ = num_elems;
+    invalidateRowStats();
+  }
+
  protected:
+  // Row level stats of the chunk, the block zone maps and the column stats.
+  void resetRowStats() {
+    block_zone_maps_.reset();
+    column_stats_.reset();
+  }
+
+  void invalidateRowStats() {
+    block_zone_maps_.invalidate();
+    column_stats_.invalidate();
+  }
+
+  void beginRowStatsAppend(const size_t first_row) {
+    block_zone_maps_.beginAppend(first_row);
+    column_stats_.beginAppend(first_row);
+  }
+
+  void updateRowStats(const size_t row, const int64_t val, const bool is_null) {
+    block_zone_maps_.update(row, val, is_null);
+    column_stats_.update(row, val, is_null);
+  }
+
   size_t num_elems_;
 
   Data_Namespace::AbstractBuffer* buffer_;
 
   DecimalOverflowValidator decimal_overflow_validator_;
   DateDaysOverflowValidator date_days_overflow_validator_;
+  BlockZoneMapBuilder block_zone_maps_;
+  ColumnStatsBuilder column_stats_;
 };
 
 #endif  // Encoder_h
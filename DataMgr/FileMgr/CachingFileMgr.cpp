@@ -37,7 +37,7 @@ size_t size_of_dir(const std::string& dir) {
   return space_used;
 }
 
-ChunkKey evict_chunk_or_fail(LRUEvictionAlgorithm& alg) {
+ChunkKey evict_chunk_or_fail(CacheEvictionAlgorithm& alg) {
   ChunkKey ret;
   try {
     ret = alg.evictNextChunk();
@@ -52,6 +52,13 @@ ChunkKey evict_chunk_or_fail(LRUEvictionAlgorithm& alg) {
 namespace File_Namespace {
 
 CachingFileMgr::CachingFileMgr(const DiskCacheConfig& config) {
+  cost_aware_eviction_ = config.cost_aware_eviction;
+  table_size_limit_ = config.table_size_limit;
+  if (cost_aware_eviction_) {
+    chunk_evict_alg_ = std::make_unique<CostAwareEvictionAlgorithm>(table_size_limit_);
+  } else {
+    chunk_evict_alg_ = std::make_unique<LRUEvictionAlgorithm>();
+  }
   fileMgrBasePath_ = config.path;
   maxRollbackEpochs_ = 0;
   defaultPageSize_ = config.page_size;
@@ -268,6 +275,7 @@ FileBuffer* CachingFileMgr::createBufferFromHeaders(
     // with the metadata size.  If data are missing, discard the chunk.
     buffer->freeChunkPages();
   }
+  chunk_evict_alg_->setChunkSize(key, buffer->reservedSize());
   return buffer;
 }
 
@@ -363,6 +371,7 @@ void CachingFileMgr::writeDirtyBuffers(int32_t db_id, int32_t tb_id) {
       buf->writeMetadata(epoch(db_id, tb_id));
       buf->clearDirtyBits();
       touchKey(key);
+      chunk_evict_alg_->setChunkSize(key, buf->reservedSize());
     }
   }
 }
@@ -478,7 +487,7 @@ FileInfo* CachingFileMgr::evictPages() {
   FileInfo* file_info{nullptr};
   FileBuffer* buf{nullptr};
   while (!file_info) {
-    buf = chunkIndex_.at(evict_chunk_or_fail(chunk_evict_alg_));
+    buf = chunkIndex_.at(evict_chunk_or_fail(*chunk_evict_alg_));
     CHECK(buf);
     if (!buf->hasDataPages()) {
       // This buffer contains no chunk data (metadata only, uninitialized, size == 0,
@@ -502,13 +511,13 @@ FileInfo* CachingFileMgr::evictPages() {
 }
 
 void CachingFileMgr::touchKey(const ChunkKey& key) const {
-  chunk_evict_alg_.touchChunk(key);
+  chunk_evict_alg_->touchChunk(key);
   table_evict_alg_.touchChunk(get_table_key(key));
 }
 
 void CachingFileMgr::removeKey(const ChunkKey& key) const {
   // chunkIndex lock should already be acquired.
-  chunk_evict_alg_.removeChunk(key);
+  chunk_evict_alg_->removeChunk(key);
   auto [db_id, tb_id] = get_table_prefix(key);
   ChunkKey table_key{db_id, tb_id};
   ChunkKey max_table_key{db_id, tb_id, std::numeric_limits<int32_t>::max()};
@@ -525,6 +534,10 @@ void CachingFileMgr::removeKey(const ChunkKey& key) const {
   table_evict_alg_.removeChunk(table_key);
 }
 
+void CachingFileMgr::setTableRefetchCost(int32_t db_id, int32_t tb_id, double cost) {
+  chunk_evict_alg_->setTableRefetchCost({db_id, tb_id}, cost);
+}
+
 size_t CachingFileMgr::getFilesSize() const {
   mapd_shared_lock<mapd_shared_mutex> read_lock(files_rw_mutex_);
   size_t sum = 0;
@@ -575,7 +588,7 @@ void CachingFileMgr::removeChunkKeepMetadata(const ChunkKey& key) {
     auto& buf = chunkIt->second;
     if (buf->hasDataPages()) {
       buf->freeChunkPages();
-      chunk_evict_alg_.removeChunk(key);
+      chunk_evict_alg_->removeChunk(key);
     }
   }
 }
@@ -618,7 +631,9 @@ std::unique_ptr<CachingFileMgr> CachingFileMgr::reconstruct() const {
                          DiskCacheLevel::none,
                          num_reader_threads_,
                          max_size_,
-                         defaultPageSize_};
+                         defaultPageSize_,
+                         cost_aware_eviction_,
+                         table_size_limit_};
   return std::make_unique<CachingFileMgr>(config);
 }
 
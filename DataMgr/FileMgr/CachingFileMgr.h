@@ -28,6 +28,7 @@
 
 #pragma once
 
+#include "DataMgr/ForeignStorage/CacheEvictionAlgorithms/CostAwareEvictionAlgorithm.h"
 #include "DataMgr/ForeignStorage/CacheEvictionAlgorithms/LRUEvictionAlgorithm.h"
 #include "FileMgr.h"
 #include "Shared/File.h"
@@ -43,6 +44,16 @@ struct DiskCacheConfig {
   size_t num_reader_threads = 0;
   size_t size_limit = DEFAULT_MAX_SIZE;
   size_t page_size = DEFAULT_PAGE_SIZE;
+  // Evict chunks by refetch cost, size and access frequency instead of by recency.
+  bool cost_aware_eviction = false;
+  // With cost aware eviction, the bytes of chunk data a table can cache before its
+  // chunks are evicted ahead of those of other tables, 0 means unlimited.
+  size_t table_size_limit = 0;
+  // Write the mutable table chunks fetched from storage to the cache in the background
+  // instead of before the fetch returns.
+  bool async_population = false;
+  // The fetches from storage of a mutable table chunk before it is cached.
+  size_t admission_fetch_count = 1;
   inline bool isEnabledForMutableTables() const {
     return enabled_level == DiskCacheLevel::non_fsi ||
            enabled_level == DiskCacheLevel::all;
@@ -346,6 +357,12 @@ class CachingFileMgr : public FileMgr {
   void getChunkMetadataVecForKeyPrefix(ChunkMetadataVector& chunkMetadataVec,
                                        const ChunkKey& keyPrefix) override;
 
+  /**
+   * @brief Sets the cost of refetching the chunks of a table relative to other tables,
+   * for eviction algorithms which take it into account.
+   **/
+  void setTableRefetchCost(int32_t db_id, int32_t tb_id, double cost);
+
   // Useful for debugging.
   std::string dumpKeysWithMetadata() const;
   std::string dumpKeysWithChunkData() const;
@@ -479,7 +496,9 @@ class CachingFileMgr : public FileMgr {
   size_t max_num_meta_files_;  // set based on max_size_.
   size_t max_wrapper_space_;   // set based on max_size_.
   size_t max_size_;
-  mutable LRUEvictionAlgorithm chunk_evict_alg_;  // last chunk touched.
+  bool cost_aware_eviction_;
+  size_t table_size_limit_;
+  std::unique_ptr<CacheEvictionAlgorithm> chunk_evict_alg_;  // chunk to evict next.
   mutable LRUEvictionAlgorithm table_evict_alg_;  // last table touched.
 };
 
@@ -28,13 +28,143 @@
 #include <utility>  // std::pair
 
 #include "DataMgr/FileMgr/FileMgr.h"
+#include "Shared/Compressor.h"
 #include "Shared/File.h"
 #include "Shared/checked_alloc.h"
 
 using namespace std;
 
+bool g_enable_vectored_page_reads{false};
+std::string g_page_compression_codec{"none"};
+
 namespace File_Namespace {
 
+namespace {
+
+const char* get_blosc_codec_name(const PageCompressionCodec codec) {
+  switch (codec) {
+    case PageCompressionCodec::LZ4:
+    case PageCompressionCodec::LZ4_DELTA:
+      return "lz4";
+    case PageCompressionCodec::ZSTD:
+    case PageCompressionCodec::ZSTD_DELTA:
+      return "zstd";
+    default:
+      UNREACHABLE();
+  }
+  return nullptr;
+}
+
+bool is_delta_codec(const PageCompressionCodec codec) {
+  return codec == PageCompressionCodec::LZ4_DELTA ||
+         codec == PageCompressionCodec::ZSTD_DELTA;
+}
+
+// Width of the values delta encoded by the delta codecs, 0 for types which are not fixed
+// width integers.
+size_t get_delta_width(const SQLTypeInfo& type) {
+  if (type.is_integer() || type.is_time() || type.is_decimal() || type.is_boolean() ||
+      (type.is_string() && type.get_compression() == kENCODING_DICT)) {
+    const auto size = type.get_size();
+    if (size == 1 || size == 2 || size == 4 || size == 8) {
+      return size;
+    }
+  }
+  return 0;
+}
+
+// Deltas wrap around in the unsigned type and are zigzag encoded, so small negative
+// deltas have few significant bits as well. Values are copied, since page data is not
+// aligned to the value width.
+template <typename T>
+void delta_encode(int8_t* data, const size_t count) {
+  constexpr size_t sign_shift = sizeof(T) * 8 - 1;
+  T previous{0};
+  for (size_t i = 0; i < count; ++i) {
+    T value;
+    memcpy(&value, data + i * sizeof(T), sizeof(T));
+    const T delta = value - previous;
+    const T encoded =
+        static_cast<T>(delta << 1) ^ static_cast<T>(0 - (delta >> sign_shift));
+    memcpy(data + i * sizeof(T), &encoded, sizeof(T));
+    previous = value;
+  }
+}
+
+template <typename T>
+void delta_decode(int8_t* data, const size_t count) {
+  T previous{0};
+  for (size_t i = 0; i < count; ++i) {
+    T encoded;
+    memcpy(&encoded, data + i * sizeof(T), sizeof(T));
+    const T delta = static_cast<T>(encoded >> 1) ^ static_cast<T>(0 - (encoded & 1));
+    previous += delta;
+    memcpy(data + i * sizeof(T), &previous, sizeof(T));
+  }
+}
+
+void delta_encode(int8_t* data, const size_t numBytes, const size_t width) {
+  switch (width) {
+    case 1:
+      delta_encode<uint8_t>(data, numBytes);
+      break;
+    case 2:
+      delta_encode<uint16_t>(data, numBytes / 2);
+      break;
+    case 4:
+      delta_encode<uint32_t>(data, numBytes / 4);
+      break;
+    case 8:
+      delta_encode<uint64_t>(data, numBytes / 8);
+      break;
+    default:
+      UNREACHABLE();
+  }
+}
+
+void delta_decode(int8_t* data, const size_t numBytes, const size_t width) {
+  switch (width) {
+    case 1:
+      delta_decode<uint8_t>(data, numBytes);
+      break;
+    case 2:
+      delta_decode<uint16_t>(data, numBytes / 2);
+      break;
+    case 4:
+      delta_decode<uint32_t>(data, numBytes / 4);
+      break;
+    case 8:
+      delta_decode<uint64_t>(data, numBytes / 8);
+      break;
+    default:
+      UNREACHABLE();
+  }
+}
+
+}  // namespace
+
+PageCompressionCodec get_page_compression_codec(const std::string& codec_name) {
+  PageCompressionCodec codec;
+  if (codec_name == "none") {
+    return PageCompressionCodec::NONE;
+  } else if (codec_name == "lz4") {
+    codec = PageCompressionCodec::LZ4;
+  } else if (codec_name == "zstd") {
+    codec = PageCompressionCodec::ZSTD;
+  } else if (codec_name == "lz4-delta") {
+    codec = PageCompressionCodec::LZ4_DELTA;
+  } else if (codec_name == "zstd-delta") {
+    codec = PageCompressionCodec::ZSTD_DELTA;
+  } else {
+    throw std::runtime_error("Unknown page compression codec: " + codec_name);
+  }
+  if (!BloscCompressor::isCodecAvailable(get_blosc_codec_name(codec))) {
+    throw std::runtime_error("Page compression codec " + codec_name +
+                             " is not supported by the blosc library.");
+  }
+  return codec;
+}
+
 FileBuffer::FileBuffer(FileMgr* fm,
                        const size_t pageSize,
                        const ChunkKey& chunkKey,
@@ -43,12 +173,13 @@ FileBuffer::FileBuffer(FileMgr* fm,
     , fm_(fm)
     , metadataPages_(METADATA_PAGE_SIZE)
     , pageSize_(pageSize)
-    , chunkKey_(chunkKey) {
+    , chunkKey_(chunkKey)
+    , pageCompressionCodec_(get_page_compression_codec(g_page_compression_codec)) {
   // Create a new FileBuffer
   CHECK(fm_);
   calcHeaderBuffer();
-  CHECK_GT(pageSize_, reservedHeaderSize_);
-  pageDataSize_ = pageSize_ - reservedHeaderSize_;
+  CHECK_GT(pageSize_, reservedHeaderSize_ + compressedPageHeaderSize_);
+  initPageDataSize();
   //@todo reintroduce initialSize - need to develop easy way of
   // differentiating these pre-allocated pages from "written-to" pages
   /*
@@ -73,10 +204,11 @@ FileBuffer::FileBuffer(FileMgr* fm,
     , fm_(fm)
     , metadataPages_(METADATA_PAGE_SIZE)
     , pageSize_(pageSize)
-    , chunkKey_(chunkKey) {
+    , chunkKey_(chunkKey)
+    , pageCompressionCodec_(get_page_compression_codec(g_page_compression_codec)) {
   CHECK(fm_);
   calcHeaderBuffer();
-  pageDataSize_ = pageSize_ - reservedHeaderSize_;
+  initPageDataSize();
 }
 
 FileBuffer::FileBuffer(FileMgr* fm,
@@ -137,6 +269,9 @@ void FileBuffer::reserve(const size_t numBytes) {
   for (size_t pageNum = numCurrentPages; pageNum < numPagesRequested; ++pageNum) {
     Page page = addNewMultiPage(epoch);
     writeHeader(page, pageNum, epoch);
+    if (pageCompressionCodec_ != PageCompressionCodec::NONE) {
+      writeCompressedPageData(page, nullptr, 0, pageNum * pageDataSize_);
+    }
   }
 }
 
@@ -159,6 +294,21 @@ void FileBuffer::freePage(const Page& page, const bool isRolloff) {
   fileInfo->freePage(page.pageNum, isRolloff, getFileMgrEpoch());
 }
 
+void FileBuffer::remapPages(const std::map<Page, Page>& page_map) {
+  auto remap_multi_page = [&page_map](MultiPage& multi_page) {
+    for (auto& epoched_page : multi_page.pageVersions) {
+      auto it = page_map.find(epoched_page.page);
+      if (it != page_map.end()) {
+        epoched_page.page = it->second;
+      }
+    }
+  };
+  remap_multi_page(metadataPages_);
+  for (auto& multi_page : multiPages_) {
+    remap_multi_page(multi_page);
+  }
+}
+
 size_t FileBuffer::freeMetadataPages() {
   size_t num_pages_freed = metadataPages_.pageVersions.size();
   for (auto metaPageIt = metadataPages_.pageVersions.begin();
@@ -258,7 +408,37 @@ static size_t readForThread(FileBuffer* fileBuffer, const readThreadDS threadDS)
     // Read the page into the destination (dst) buffer at its
     // current (cur) location
     size_t bytesRead = 0;
-    if (isFirstPage) {
+    if (fileBuffer->getPageCompressionCodec() != PageCompressionCodec::NONE) {
+      const size_t pageOffset = isFirstPage ? threadDS.t_startPageOffset : 0;
+      bytesRead = fileBuffer->readCompressedPage(
+          page,
+          pageOffset,
+          min(fileBuffer->pageDataSize() - pageOffset, bytesLeft),
+          curPtr);
+      isFirstPage = false;
+    } else if (g_enable_vectored_page_reads) {
+      // Logical pages which are also consecutive in the file are read all at once
+      size_t runEndPage = pageNum + 1;
+      while (runEndPage < endPage) {
+        CHECK(threadDS.multiPages[runEndPage].pageSize == fileBuffer->pageSize());
+        const auto& nextPage = threadDS.multiPages[runEndPage].current().page;
+        if (nextPage.fileId != page.fileId ||
+            nextPage.pageNum != page.pageNum + (runEndPage - pageNum)) {
+          break;
+        }
+        ++runEndPage;
+      }
+      const size_t pageOffset = isFirstPage ? threadDS.t_startPageOffset : 0;
+      bytesRead = fileInfo->readPageData(
+          page.pageNum,
+          fileBuffer->reservedHeaderSize(),
+          pageOffset,
+          min((runEndPage - pageNum) * fileBuffer->pageDataSize() - pageOffset,
+              bytesLeft),
+          curPtr);
+      isFirstPage = false;
+      pageNum = runEndPage - 1;
+    } else if (isFirstPage) {
       bytesRead = fileInfo->read(
           page.pageNum * fileBuffer->pageSize() + threadDS.t_startPageOffset +
               fileBuffer->reservedHeaderSize(),
@@ -383,6 +563,167 @@ void FileBuffer::read(int8_t* const dst,
   CHECK(bytesRead == numBytes);
 }
 
+size_t FileBuffer::readCompressedPage(const Page& page,
+                                      const size_t offset,
+                                      const size_t numBytes,
+                                      int8_t* dst) {
+  CHECK_LE(offset + numBytes, pageDataSize_);
+  if (offset == 0 && numBytes == pageDataSize_) {
+    CHECK_EQ(readCompressedPageData(page, dst), numBytes);
+    return numBytes;
+  }
+  std::vector<int8_t> page_data(pageDataSize_);
+  CHECK_GE(readCompressedPageData(page, page_data.data()), offset + numBytes);
+  memcpy(dst, page_data.data() + offset, numBytes);
+  return numBytes;
+}
+
+// Reads and decompresses the data of the given page into dst, which must have room for
+// pageDataSize_ bytes. Returns the number of uncompressed bytes.
+size_t FileBuffer::readCompressedPageData(const Page& page, int8_t* dst) {
+  FileInfo* fileInfo = fm_->getFileInfoForFileId(page.fileId);
+  const size_t dataOffset = page.pageNum * pageSize_ + reservedHeaderSize_;
+  int32_t storedSize{0};
+  CHECK_EQ(fileInfo->read(dataOffset, sizeof(storedSize), (int8_t*)&storedSize),
+           sizeof(storedSize));
+  if (storedSize <= 0) {
+    const size_t rawSize = -static_cast<int64_t>(storedSize);
+    CHECK_LE(rawSize, pageDataSize_);
+    CHECK_EQ(fileInfo->read(dataOffset + compressedPageHeaderSize_, rawSize, dst),
+             rawSize);
+    return rawSize;
+  }
+  CHECK_LE(static_cast<size_t>(storedSize), pageDataSize_);
+  std::vector<uint8_t> compressed_data(storedSize);
+  CHECK_EQ(fileInfo->read(dataOffset + compressedPageHeaderSize_,
+                          storedSize,
+                          reinterpret_cast<int8_t*>(compressed_data.data())),
+           static_cast<size_t>(storedSize));
+  if (!is_delta_codec(pageCompressionCodec_)) {
+    return BloscCompressor::decompressBlock(
+        compressed_data.data(), reinterpret_cast<uint8_t*>(dst), pageDataSize_);
+  }
+  CHECK_GT(compressed_data.size(), deltaPageHeaderSize_);
+  const size_t width = compressed_data[0];
+  const size_t skipBytes = compressed_data[1];
+  const auto size = BloscCompressor::decompressBlock(compressed_data.data() +
+                                                         deltaPageHeaderSize_,
+                                                     reinterpret_cast<uint8_t*>(dst),
+                                                     pageDataSize_);
+  if (width > 0 && size > skipBytes) {
+    delta_decode(dst + skipBytes, size - skipBytes, width);
+  }
+  return size;
+}
+
+// Compresses numBytes of page data from src and writes it to the given page. Data which
+// does not compress is written as is. chunkOffset is the offset of the page data in the
+// chunk, which locates the value boundaries for the delta codecs.
+void FileBuffer::writeCompressedPageData(const Page& page,
+                                         const int8_t* src,
+                                         const size_t numBytes,
+                                         const size_t chunkOffset) {
+  CHECK_LE(numBytes, pageDataSize_);
+  std::vector<uint8_t> page_data(compressedPageHeaderSize_ + numBytes);
+  size_t compressedSize{0};
+  if (numBytes > 0 && !is_delta_codec(pageCompressionCodec_)) {
+    const auto typeSize = sql_type_.get_size();
+    compressedSize = BloscCompressor::compressBlock(
+        reinterpret_cast<const uint8_t*>(src),
+        numBytes,
+        page_data.data() + compressedPageHeaderSize_,
+        numBytes,
+        get_blosc_codec_name(pageCompressionCodec_),
+        typeSize > 0 && typeSize < 256 ? typeSize : 1);
+  } else if (numBytes > deltaPageHeaderSize_) {
+    // The width is kept in each page rather than taken from the chunk type on reads, as
+    // the type of a chunk can be widened after its pages are written.
+    const auto width = get_delta_width(sql_type_);
+    const auto skipBytes = width > 0 ? (width - chunkOffset % width) % width : 0;
+    std::vector<int8_t> delta_data;
+    const int8_t* data = src;
+    if (width > 0 && numBytes > skipBytes) {
+      delta_data.assign(src, src + numBytes);
+      delta_encode(delta_data.data() + skipBytes, numBytes - skipBytes, width);
+      data = delta_data.data();
+    }
+    page_data[compressedPageHeaderSize_] = static_cast<uint8_t>(width);
+    page_data[compressedPageHeaderSize_ + 1] = static_cast<uint8_t>(skipBytes);
+    compressedSize = BloscCompressor::compressBlock(
+        reinterpret_cast<const uint8_t*>(data),
+        numBytes,
+        page_data.data() + compressedPageHeaderSize_ + deltaPageHeaderSize_,
+        numBytes - deltaPageHeaderSize_,
+        get_blosc_codec_name(pageCompressionCodec_),
+        width > 0 ? width : 1,
+        /*bit_shuffle=*/width > 0);
+    if (compressedSize > 0) {
+      compressedSize += deltaPageHeaderSize_;
+    }
+  }
+  int32_t storedSize;
+  if (compressedSize > 0 && compressedSize < numBytes) {
+    storedSize = static_cast<int32_t>(compressedSize);
+  } else {
+    if (numBytes > 0) {
+      memcpy(page_data.data() + compressedPageHeaderSize_, src, numBytes);
+    }
+    storedSize = -static_cast<int32_t>(numBytes);
+    compressedSize = numBytes;
+  }
+  memcpy(page_data.data(), &storedSize, sizeof(storedSize));
+  FileInfo* fileInfo = fm_->getFileInfoForFileId(page.fileId);
+  const size_t bytesToWrite = compressedPageHeaderSize_ + compressedSize;
+  CHECK_EQ(fileInfo->write(page.pageNum * pageSize_ + reservedHeaderSize_,
+                           bytesToWrite,
+                           reinterpret_cast<int8_t*>(page_data.data())),
+           bytesToWrite);
+}
+
+// Compressed pages are always rewritten whole, so writes and appends merge their data
+// with the current contents of the first and last affected pages. Pages in a gap
+// between the end of the buffer and offset are written as zeros.
+void FileBuffer::writeCompressedPages(int8_t* src,
+                                      const size_t numBytes,
+                                      const size_t offset) {
+  CHECK_LE(offset + numBytes, size_);
+  const size_t startPage = offset / pageDataSize_;
+  const size_t endPage = (offset + numBytes + pageDataSize_ - 1) / pageDataSize_;
+  const size_t initialNumPages = multiPages_.size();
+  const auto epoch = getFileMgrEpoch();
+  std::vector<int8_t> page_data(pageDataSize_);
+  for (size_t pageNum = min(startPage, initialNumPages); pageNum < endPage; ++pageNum) {
+    const size_t pageStart = pageNum * pageDataSize_;
+    const size_t pageBytes = min(pageDataSize_, size_ - pageStart);
+    const size_t writeStart = max(offset, pageStart);
+    const size_t writeEnd =
+        max(writeStart, min(offset + numBytes, pageStart + pageBytes));
+    std::fill(page_data.begin(), page_data.end(), 0);
+    if (pageNum < initialNumPages &&
+        (writeStart > pageStart || writeEnd < pageStart + pageBytes)) {
+      readCompressedPageData(multiPages_[pageNum].current().page, page_data.data());
+    }
+    if (writeEnd > writeStart) {
+      memcpy(page_data.data() + (writeStart - pageStart),
+             src + (writeStart - offset),
+             writeEnd - writeStart);
+    }
+
+    Page page;
+    if (pageNum >= initialNumPages) {
+      page = addNewMultiPage(epoch);
+      writeHeader(page, pageNum, epoch);
+    } else if (multiPages_[pageNum].current().epoch < epoch) {
+      page = fm_->requestFreePage(pageSize_, false);
+      multiPages_[pageNum].push(page, epoch);
+      writeHeader(page, pageNum, epoch);
+    } else {
+      page = multiPages_[pageNum].current().page;
+    }
+    writeCompressedPageData(page, page_data.data(), pageBytes, pageStart);
+  }
+}
+
 void FileBuffer::copyPage(Page& srcPage,
                           Page& destPage,
                           const size_t numBytes,
@@ -440,7 +781,13 @@ void FileBuffer::readMetadata(const Page& page) {
                       // encodingType, encodingBits all as int
   fread((int8_t*)&(typeData[0]), sizeof(int32_t), typeData.size(), f);
   int32_t version = typeData[0];
-  CHECK(version == METADATA_VERSION);  // add backward compatibility code here
+  CHECK(version == METADATA_VERSION ||
+        version == COMPRESSED_PAGES_METADATA_VERSION);  // add backward compatibility
+                                                        // code here
+  pageCompressionCodec_ = PageCompressionCodec::NONE;
+  if (version == COMPRESSED_PAGES_METADATA_VERSION) {
+    fread((int8_t*)&pageCompressionCodec_, sizeof(int32_t), 1, f);
+  }
   bool has_encoder = static_cast<bool>(typeData[1]);
   if (has_encoder) {
     sql_type_.set_type(static_cast<SQLTypes>(typeData[2]));
@@ -468,7 +815,9 @@ void FileBuffer::writeMetadata(const int32_t epoch) {
   vector<int32_t> typeData(
       NUM_METADATA);  // assumes we will encode hasEncoder, bufferType,
                       // encodingType, encodingBits all as int32_t
-  typeData[0] = METADATA_VERSION;
+  // Chunks with uncompressed pages keep the original metadata format
+  const bool hasCompressedPages = pageCompressionCodec_ != PageCompressionCodec::NONE;
+  typeData[0] = hasCompressedPages ? COMPRESSED_PAGES_METADATA_VERSION : METADATA_VERSION;
   typeData[1] = static_cast<int32_t>(hasEncoder());
   if (hasEncoder()) {
     typeData[2] = static_cast<int32_t>(sql_type_.get_type());
@@ -481,6 +830,9 @@ void FileBuffer::writeMetadata(const int32_t epoch) {
     typeData[9] = sql_type_.get_size();
   }
   fwrite((int8_t*)&(typeData[0]), sizeof(int32_t), typeData.size(), f);
+  if (hasCompressedPages) {
+    fwrite((int8_t*)&pageCompressionCodec_, sizeof(int32_t), 1, f);
+  }
   if (hasEncoder()) {  // redundant
     encoder_->writeMetadata(f);
   }
@@ -493,6 +845,13 @@ void FileBuffer::append(int8_t* src,
                         const int32_t deviceId) {
   setAppended();
 
+  if (pageCompressionCodec_ != PageCompressionCodec::NONE) {
+    const size_t offset = size_;
+    size_ = size_ + numBytes;
+    writeCompressedPages(src, numBytes, offset);
+    return;
+  }
+
   size_t startPage = size_ / pageDataSize_;
   size_t startPageOffset = size_ % pageDataSize_;
   size_t numPagesToWrite =
@@ -550,6 +909,11 @@ void FileBuffer::write(int8_t* src,
     size_ = offset + numBytes;
   }
 
+  if (pageCompressionCodec_ != PageCompressionCodec::NONE) {
+    writeCompressedPages(src, numBytes, offset);
+    return;
+  }
+
   size_t startPage = offset / pageDataSize_;
   size_t startPageOffset = offset % pageDataSize_;
   size_t numPagesToWrite =
@@ -637,7 +1001,14 @@ std::string FileBuffer::dump() const {
 void FileBuffer::initMetadataAndPageDataSize() {
   CHECK(metadataPages_.current().page.fileId != -1);  // was initialized
   readMetadata(metadataPages_.current().page);
+  initPageDataSize();
+}
+
+void FileBuffer::initPageDataSize() {
   pageDataSize_ = pageSize_ - reservedHeaderSize_;
+  if (pageCompressionCodec_ != PageCompressionCodec::NONE) {
+    pageDataSize_ -= compressedPageHeaderSize_;
+  }
 }
 
 bool FileBuffer::isMissingPages() const {
@@ -26,18 +26,41 @@
 #include "DataMgr/FileMgr/Page.h"
 
 #include <iostream>
+#include <map>
 #include <stdexcept>
+#include <string>
 
 #include "Logger/Logger.h"
 
 using namespace Data_Namespace;
 
+// Read the file pages of a chunk which are consecutive on disk with vectored reads.
+extern bool g_enable_vectored_page_reads;
+// Codec used to compress the data pages of new chunks: "none", "lz4" or "zstd".
+extern std::string g_page_compression_codec;
+
 #define NUM_METADATA 10
 #define METADATA_VERSION 0
+// Metadata of chunks with compressed data pages, stores the codec after the type data.
+#define COMPRESSED_PAGES_METADATA_VERSION 1
 #define METADATA_PAGE_SIZE 4096
 
 namespace File_Namespace {
 
+// The delta codecs store the zigzag encoded differences between consecutive values of
+// integer columns, bit shuffled, before compressing. Pages of other types are compressed
+// as with their plain codec.
+enum class PageCompressionCodec : int32_t {
+  NONE = 0,
+  LZ4 = 1,
+  ZSTD = 2,
+  LZ4_DELTA = 3,
+  ZSTD_DELTA = 4
+};
+
+// Throws std::runtime_error for unknown codecs or codecs missing from the blosc build.
+PageCompressionCodec get_page_compression_codec(const std::string& codec_name);
+
 // forward declarations
 class FileMgr;
 class CachingFileMgr;
@@ -130,6 +153,16 @@ class FileBuffer : public AbstractBuffer {
   /// Returns the number of pages in the FileBuffer.
   inline size_t pageCount() const override { return multiPages_.size(); }
 
+  inline PageCompressionCodec getPageCompressionCodec() const {
+    return pageCompressionCodec_;
+  }
+
+  /// Reads numBytes of the uncompressed data of a compressed page, starting at offset.
+  size_t readCompressedPage(const Page& page,
+                            const size_t offset,
+                            const size_t numBytes,
+                            int8_t* dst);
+
   /// Returns whether or not a buffer has data pages.  It is possible for a buffer to
   /// represent metadata (have a size and encode) but not contain actual data.
   inline bool hasDataPages() const { return pageCount() > 0; }
@@ -163,8 +196,20 @@ class FileBuffer : public AbstractBuffer {
   // Used for testing
   void freePage(const Page& page);
 
+  /// Points page versions that were moved by data compaction at their new location.
+  void remapPages(const std::map<Page, Page>& page_map);
+
   static constexpr size_t headerBufferOffset_ = 32;
 
+  /// Compressed pages start with the signed size of their stored data, which is negative
+  /// if the data did not compress and is stored as is.
+  static constexpr size_t compressedPageHeaderSize_ = sizeof(int32_t);
+
+  /// Compressed data of pages with a delta codec starts with the width of the delta
+  /// encoded integers, 0 if the page is not delta encoded, and the number of leading
+  /// bytes before the first whole integer of the page.
+  static constexpr size_t deltaPageHeaderSize_ = 2 * sizeof(uint8_t);
+
  private:
   // FileBuffer(const FileBuffer&);      // private copy constructor
   // FileBuffer& operator=(const FileBuffer&); // private overloaded assignment operator
@@ -186,8 +231,16 @@ class FileBuffer : public AbstractBuffer {
                                         const int32_t targetEpoch,
                                         const int32_t currentEpoch);
   void initMetadataAndPageDataSize();
+  void initPageDataSize();
   int32_t getFileMgrEpoch();
 
+  size_t readCompressedPageData(const Page& page, int8_t* dst);
+  void writeCompressedPageData(const Page& page,
+                               const int8_t* src,
+                               const size_t numBytes,
+                               const size_t chunkOffset);
+  void writeCompressedPages(int8_t* src, const size_t numBytes, const size_t offset);
+
   FileMgr* fm_;  // a reference to FileMgr is needed for writing to new pages in available
                  // files
   MultiPage metadataPages_;
@@ -196,6 +249,7 @@ class FileBuffer : public AbstractBuffer {
   size_t pageDataSize_;
   size_t reservedHeaderSize_;  // lets make this a constant now for simplicity - 128 bytes
   ChunkKey chunkKey_;
+  PageCompressionCodec pageCompressionCodec_{PageCompressionCodec::NONE};
 };
 
 }  // namespace File_Namespace
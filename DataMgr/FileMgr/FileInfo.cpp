@@ -20,6 +20,7 @@
 #include "FileMgr.h"
 #include "Page.h"
 
+#include <algorithm>
 #include <utility>
 using namespace std;
 
@@ -68,6 +69,42 @@ size_t FileInfo::read(const size_t offset, const size_t size, int8_t* buf) {
   return File_Namespace::read(f, offset, size, buf);
 }
 
+size_t FileInfo::readPageData(const size_t page_num,
+                              const size_t header_size,
+                              const size_t offset,
+                              const size_t size,
+                              int8_t* buf) {
+  CHECK_LT(header_size, pageSize);
+  const auto page_data_size = pageSize - header_size;
+  CHECK_LT(offset, page_data_size);
+  {
+    // the vectored read goes around the stream, which may still buffer some writes
+    std::lock_guard<std::mutex> lock(readWriteMutex_);
+    if (isDirty && fflush(f) != 0) {
+      LOG(FATAL) << "Error trying to flush changes to disk, the error was: "
+                 << std::strerror(errno);
+    }
+  }
+  std::vector<int8_t> header_scratch(header_size);
+  std::vector<std::pair<int8_t*, size_t>> buffers;
+  size_t header_bytes{0};
+  size_t page_offset = offset;
+  for (size_t bytes_left = size; bytes_left > 0;) {
+    if (!buffers.empty()) {
+      buffers.emplace_back(header_scratch.data(), header_size);
+      header_bytes += header_size;
+    }
+    const auto page_bytes = std::min(page_data_size - page_offset, bytes_left);
+    buffers.emplace_back(buf + (size - bytes_left), page_bytes);
+    bytes_left -= page_bytes;
+    page_offset = 0;
+  }
+  const auto bytes_read = omnisci::checked_read_vectored(
+      fileno(f), page_num * pageSize + header_size + offset, buffers);
+  CHECK_EQ(bytes_read, size + header_bytes);
+  return size;
+}
+
 void FileInfo::openExistingFile(std::vector<HeaderInfo>& headerVec) {
   // HeaderInfo is defined in Page.h
 
@@ -176,6 +213,7 @@ static void sighandler(int sig) {
 #endif
 
 void FileInfo::freePage(int pageId, const bool isRolloff, int32_t epoch) {
+  fileMgr->invalidateChunkIndexSnapshot();
   std::lock_guard<std::mutex> lock(readWriteMutex_);
   int32_t epoch_freed_page[2] = {DELETE_CONTINGENT, epoch};
   if (isRolloff) {
@@ -236,6 +274,20 @@ int32_t FileInfo::syncToDisk() {
   return 0;  // if file was not dirty and no syncing was needed
 }
 
+bool FileInfo::flushToOs() {
+  std::lock_guard<std::mutex> lock(readWriteMutex_);
+  if (isDirty && fflush(f) != 0) {
+    LOG(FATAL) << "Error trying to flush changes to disk, the error was: "
+               << std::strerror(errno);
+  }
+  return isDirty;
+}
+
+void FileInfo::setSynced() {
+  std::lock_guard<std::mutex> lock(readWriteMutex_);
+  isDirty = false;
+}
+
 void FileInfo::freePageImmediate(int32_t page_num) {
   // we should not get here but putting protection in place
   // as it seems we are no guaranteed to have f/synced so
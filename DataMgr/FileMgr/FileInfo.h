@@ -84,6 +84,18 @@ struct FileInfo {
   size_t write(const size_t offset, const size_t size, const int8_t* buf);
   size_t read(const size_t offset, const size_t size, int8_t* buf);
 
+  /**
+   * Reads `size` bytes of page data, starting `offset` bytes into the data of page
+   * `page_num` and continuing into the data of the pages which follow it in the file,
+   * skipping their `header_size` byte headers. The pages are read with a single
+   * vectored read rather than one read per page.
+   */
+  size_t readPageData(const size_t page_num,
+                      const size_t header_size,
+                      const size_t offset,
+                      const size_t size,
+                      int8_t* buf);
+
   void openExistingFile(std::vector<HeaderInfo>& headerVec);
   /// Prints a summary of the file to stdout
   void print(bool pagesummary);
@@ -95,6 +107,13 @@ struct FileInfo {
   /// systems)
   int32_t syncToDisk();
 
+  /// Flushes buffered writes to the OS without syncing them. Returns true if the file has
+  /// writes which still need to be synced.
+  bool flushToOs();
+
+  /// Marks pending writes as synced, once the file system holding the file was synced.
+  void setSynced();
+
   /// Returns the number of free bytes available
   inline size_t available() { return freePages.size() * pageSize; }
 
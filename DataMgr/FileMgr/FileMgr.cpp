@@ -24,6 +24,7 @@
 
 #include <fcntl.h>
 #include <algorithm>
+#include <cstring>
 #include <fstream>
 #include <future>
 #include <string>
@@ -39,9 +40,13 @@
 #include "Shared/File.h"
 #include "Shared/checked_alloc.h"
 #include "Shared/measure.h"
+#include "Shared/threadpool.h"
 
 using namespace std;
 
+size_t g_data_compaction_max_bytes_per_sec{0};
+bool g_enable_chunk_index_snapshot{false};
+
 namespace File_Namespace {
 
 FileMgr::FileMgr(const int32_t deviceId,
@@ -201,7 +206,7 @@ OpenFilesResult FileMgr::openFiles() {
     FileMetadata file_metadata = getMetadataForFile(file_it);
     if (file_metadata.is_data_file) {
       result.max_file_id = std::max(result.max_file_id, file_metadata.file_id);
-      file_futures.emplace_back(std::async(std::launch::async, [file_metadata, this] {
+      file_futures.emplace_back(threadpool::async([file_metadata, this] {
         std::vector<HeaderInfo> temp_header_vec;
         openExistingFile(file_metadata.file_path,
                          file_metadata.file_id,
@@ -233,6 +238,263 @@ OpenFilesResult FileMgr::openFiles() {
   return result;
 }
 
+namespace {
+constexpr int32_t kChunkIndexSnapshotVersion{1};
+// Written over the epoch of a snapshot to invalidate it.
+constexpr int32_t kInvalidChunkIndexSnapshotEpoch{-1};
+
+template <typename T>
+void append_to_snapshot(std::vector<char>& snapshot, const T value) {
+  const auto bytes = reinterpret_cast<const char*>(&value);
+  snapshot.insert(snapshot.end(), bytes, bytes + sizeof(T));
+}
+
+class ChunkIndexSnapshotReader {
+ public:
+  explicit ChunkIndexSnapshotReader(const std::vector<char>& snapshot)
+      : snapshot_(snapshot) {}
+
+  // Returns false, leaving `value` unset, if the snapshot ends before it.
+  template <typename T>
+  bool read(T& value) {
+    if (sizeof(T) > remaining()) {
+      return false;
+    }
+    std::memcpy(&value, snapshot_.data() + offset_, sizeof(T));
+    offset_ += sizeof(T);
+    return true;
+  }
+
+  size_t remaining() const { return snapshot_.size() - offset_; }
+
+ private:
+  const std::vector<char>& snapshot_;
+  size_t offset_{0};
+};
+}  // namespace
+
+/**
+ * Serializes the epoch, the data files and the header of every checkpointed page of the
+ * table, as they would be read back from the page headers by openFiles().
+ */
+void FileMgr::writeChunkIndexSnapshot() {
+  std::vector<char> snapshot;
+  append_to_snapshot(snapshot, kChunkIndexSnapshotVersion);
+  append_to_snapshot(snapshot, epoch());
+  {
+    mapd_shared_lock<mapd_shared_mutex> read_lock(files_rw_mutex_);
+    append_to_snapshot(snapshot, static_cast<int64_t>(files_.size()));
+    for (const auto& [file_id, file_info] : files_) {
+      append_to_snapshot(snapshot, file_id);
+      append_to_snapshot(snapshot, static_cast<int64_t>(file_info->pageSize));
+      append_to_snapshot(snapshot, static_cast<int64_t>(file_info->numPages));
+    }
+  }
+  int64_t num_headers{0};
+  std::vector<char> headers;
+  const auto append_header = [&num_headers, &headers](const ChunkKey& chunk_key,
+                                                      const int32_t page_id,
+                                                      const EpochedPage& epoched_page) {
+    append_to_snapshot(headers, static_cast<int32_t>(chunk_key.size()));
+    for (const auto key_elem : chunk_key) {
+      append_to_snapshot(headers, key_elem);
+    }
+    append_to_snapshot(headers, page_id);
+    append_to_snapshot(headers, epoched_page.epoch);
+    append_to_snapshot(headers, epoched_page.page.fileId);
+    append_to_snapshot(headers, static_cast<int64_t>(epoched_page.page.pageNum));
+    ++num_headers;
+  };
+  {
+    mapd_shared_lock<mapd_shared_mutex> chunk_index_read_lock(chunkIndexMutex_);
+    for (const auto& [chunk_key, buffer] : chunkIndex_) {
+      for (const auto& epoched_page : buffer->metadataPages_.pageVersions) {
+        append_header(chunk_key, -1, epoched_page);
+      }
+      for (size_t page_id = 0; page_id < buffer->multiPages_.size(); ++page_id) {
+        for (const auto& epoched_page : buffer->multiPages_[page_id].pageVersions) {
+          append_header(chunk_key, page_id, epoched_page);
+        }
+      }
+    }
+  }
+  append_to_snapshot(snapshot, num_headers);
+  snapshot.insert(snapshot.end(), headers.begin(), headers.end());
+
+  // The snapshot is only replaced once complete, a crash leaves the previous one, whose
+  // epoch no longer matches.
+  std::lock_guard<std::mutex> lock(chunk_index_snapshot_mutex_);
+  const auto snapshot_path = getFilePath(CHUNK_INDEX_SNAPSHOT_FILENAME);
+  const auto temp_snapshot_path = 
+      getFilePath(std::string(CHUNK_INDEX_SNAPSHOT_FILENAME) + ".tmp");
+  FILE* f = fopen(temp_snapshot_path.string().c_str(), "wb");
+  bool written{false};
+  if (f) {
+    written = fwrite(snapshot.data(), 1, snapshot.size(), f) == snapshot.size() &&
+              fflush(f) == 0 && omnisci::fsync(fileno(f)) == 0;
+    fclose(f);
+  }
+  boost::system::error_code ec;
+  if (written) {
+    boost::filesystem::rename(temp_snapshot_path, snapshot_path, ec);
+  }
+  if (!written || ec) {
+    LOG(WARNING) << "Could not write the chunk index snapshot of " << describeSelf();
+    return;
+  }
+  chunk_index_snapshot_valid_ = true;
+}
+
+/**
+ * Opens the data files of the table and returns the page headers listed by the chunk
+ * index snapshot, without reading the headers from the files. Returns false, having
+ * opened no file, if there is no snapshot or it does not match the files on disk.
+ */
+bool FileMgr::openFilesFromChunkIndexSnapshot(OpenFilesResult& result) {
+  auto clock_begin = timer_start();
+  std::ifstream snapshot_file{getFilePath(CHUNK_INDEX_SNAPSHOT_FILENAME).string(),
+                              std::ios::in | std::ios::binary | std::ios::ate};
+  if (!snapshot_file.is_open()) {
+    return false;
+  }
+  std::vector<char> snapshot(snapshot_file.tellg());
+  snapshot_file.seekg(0, std::ios::beg);
+  snapshot_file.read(snapshot.data(), snapshot.size());
+  if (!snapshot_file) {
+    return false;
+  }
+  ChunkIndexSnapshotReader reader(snapshot);
+  int32_t version;
+  int32_t snapshot_epoch;
+  if (!reader.read(version) || version != kChunkIndexSnapshotVersion ||
+      !reader.read(snapshot_epoch) || snapshot_epoch != epoch()) {
+    return false;
+  }
+
+  std::map<int32_t, FileMetadata> data_files;
+  boost::filesystem::directory_iterator end_itr;
+  boost::filesystem::path path(fileMgrBasePath_);
+  for (boost::filesystem::directory_iterator file_it(path); file_it != end_itr;
+       ++file_it) {
+    if (is_compaction_status_file(file_it->path().filename().string())) {
+      return false;
+    }
+    FileMetadata file_metadata = getMetadataForFile(file_it);
+    if (file_metadata.is_data_file) {
+      data_files.emplace(file_metadata.file_id, file_metadata);
+    }
+  }
+  int64_t num_files;
+  if (!reader.read(num_files) || static_cast<size_t>(num_files) != data_files.size()) {
+    return false;
+  }
+  std::map<int32_t, std::vector<bool>> used_pages;
+  for (int64_t i = 0; i < num_files; ++i) {
+    int32_t file_id;
+    int64_t page_size;
+    int64_t num_pages;
+    if (!reader.read(file_id) || !reader.read(page_size) || !reader.read(num_pages)) {
+      return false;
+    }
+    const auto file_it = data_files.find(file_id);
+    if (file_it == data_files.end() ||
+        file_it->second.page_size != static_cast<size_t>(page_size) ||
+        file_it->second.num_pages != static_cast<size_t>(num_pages)) {
+      return false;
+    }
+    used_pages[file_id].resize(num_pages);
+  }
+
+  int64_t num_headers;
+  if (!reader.read(num_headers)) {
+    return false;
+  }
+  std::vector<HeaderInfo> header_infos;
+  for (int64_t i = 0; i < num_headers; ++i) {
+    int32_t key_size;
+    if (!reader.read(key_size) || key_size <= 0 ||
+        key_size * sizeof(int32_t) > reader.remaining()) {
+      return false;
+    }
+    ChunkKey chunk_key(key_size);
+    for (auto& key_elem : chunk_key) {
+      reader.read(key_elem);
+    }
+    int32_t page_id;
+    int32_t version_epoch;
+    int32_t file_id;
+    int64_t page_num;
+    if (!reader.read(page_id) || !reader.read(version_epoch) || !reader.read(file_id) ||
+        !reader.read(page_num)) {
+      return false;
+    }
+    auto used_pages_it = used_pages.find(file_id);
+    if (used_pages_it == used_pages.end() || page_num < 0 ||
+        static_cast<size_t>(page_num) >= used_pages_it->second.size()) {
+      return false;
+    }
+    used_pages_it->second[page_num] = true;
+    header_infos.emplace_back(chunk_key, page_id, version_epoch, Page(file_id, page_num));
+  }
+  if (reader.remaining()) {
+    return false;
+  }
+
+  result.max_file_id = -1;
+  for (const auto& [file_id, file_metadata] : data_files) {
+    FileInfo* file_info = new FileInfo(this,
+                                       file_id,
+                                       open(file_metadata.file_path),
+                                       file_metadata.page_size,
+                                       file_metadata.num_pages,
+                                       false);
+    const auto& file_used_pages = used_pages[file_id];
+    for (size_t page_num = 0; page_num < file_used_pages.size(); ++page_num) {
+      if (!file_used_pages[page_num]) {
+        file_info->freePages.insert(page_num);
+      }
+    }
+    mapd_unique_lock<mapd_shared_mutex> write_lock(files_rw_mutex_);
+    files_[file_id] = file_info;
+    fileIndex_.insert(std::pair<size_t, int32_t>(file_metadata.page_size, file_id));
+    result.max_file_id = std::max(result.max_file_id, file_id);
+  }
+  result.header_infos = std::move(header_infos);
+  LOG(INFO) << "Read table's file metadata from its chunk index snapshot, Elapsed time : "
+            << timer_stop(clock_begin) << "ms Epoch: " << epoch_.ceiling()
+            << " files: " << data_files.size() << " table location: '"
+            << fileMgrBasePath_ << "'";
+  return true;
+}
+
+/**
+ * Durably marks the chunk index snapshot as stale, before pages it does not list are
+ * written, so that it is not used to open the table after a crash.
+ */
+void FileMgr::invalidateChunkIndexSnapshot() {
+  if (!chunk_index_snapshot_valid_ || g_read_only) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(chunk_index_snapshot_mutex_);
+  if (!chunk_index_snapshot_valid_) {
+    return;
+  }
+  chunk_index_snapshot_valid_ = false;
+  FILE* f = fopen(getFilePath(CHUNK_INDEX_SNAPSHOT_FILENAME).string().c_str(), "r+b");
+  if (!f) {
+    return;
+  }
+  write(f,
+        sizeof(int32_t),
+        sizeof(int32_t),
+        reinterpret_cast<const int8_t*>(&kInvalidChunkIndexSnapshotEpoch));
+  CHECK_EQ(fflush(f), 0) << "Could not invalidate the chunk index snapshot of "
+                         << describeSelf();
+  CHECK_EQ(omnisci::fsync(fileno(f)), 0)
+      << "Could not invalidate the chunk index snapshot of " << describeSelf();
+  close(f);
+}
+
 void FileMgr::clearFileInfos() {
   for (auto file_info_entry : files_) {
     auto file_info = file_info_entry.second;
@@ -255,7 +517,16 @@ void FileMgr::init(const size_t num_reader_threads, const int32_t epochOverride)
       setEpoch(epochOverride);
     }
 
-    auto open_files_result = openFiles();
+    // A snapshot which is not used may be stale once pages are written, so it is
+    // invalidated up front.
+    chunk_index_snapshot_valid_ =
+        boost::filesystem::exists(getFilePath(CHUNK_INDEX_SNAPSHOT_FILENAME));
+    OpenFilesResult open_files_result;
+    if (!g_enable_chunk_index_snapshot || epochOverride != -1 ||
+        !openFilesFromChunkIndexSnapshot(open_files_result)) {
+      invalidateChunkIndexSnapshot();
+      open_files_result = openFiles();
+    }
     if (!open_files_result.compaction_status_file_name.empty()) {
       resumeFileCompaction(open_files_result.compaction_status_file_name);
       clearFileInfos();
@@ -313,6 +584,7 @@ void FileMgr::init(const size_t num_reader_threads, const int32_t epochOverride)
     incrementEpoch();
   }
 
+  writes_chunk_index_snapshot_ = g_enable_chunk_index_snapshot;
   initializeNumThreads(num_reader_threads);
   isFullyInitted_ = true;
 }
@@ -428,7 +700,7 @@ void FileMgr::init(const std::string& dataPathToConvertFrom,
       FileMetadata fileMetadata = getMetadataForFile(fileIt);
       if (fileMetadata.is_data_file) {
         maxFileId = std::max(maxFileId, fileMetadata.file_id);
-        file_futures.emplace_back(std::async(std::launch::async, [fileMetadata, this] {
+        file_futures.emplace_back(threadpool::async([fileMetadata, this] {
           std::vector<HeaderInfo> tempHeaderVec;
           openExistingFile(fileMetadata.file_path,
                            fileMetadata.file_id,
@@ -629,16 +901,25 @@ void FileMgr::openAndReadEpochFile(const std::string& epochFileName) {
 }
 
 void FileMgr::writeAndSyncEpochToDisk() {
-  CHECK(epochFile_);
-  write(epochFile_, 0, Epoch::byte_size(), epoch_.storage_ptr());
-  int32_t status = fflush(epochFile_);
-  CHECK(status == 0) << "Could not flush epoch file to disk";
+  const auto fd = flushEpochForSync();
 #ifdef __APPLE__
-  status = fcntl(fileno(epochFile_), 51);
+  int32_t status = fcntl(fd, 51);
 #else
-  status = omnisci::fsync(fileno(epochFile_));
+  int32_t status = omnisci::fsync(fd);
 #endif
   CHECK(status == 0) << "Could not sync epoch file to disk";
+  setEpochSynced();
+}
+
+int FileMgr::flushEpochForSync() {
+  CHECK(epochFile_);
+  write(epochFile_, 0, Epoch::byte_size(), epoch_.storage_ptr());
+  int32_t status = fflush(epochFile_);
+  CHECK(status == 0) << "Could not flush epoch file to disk";
+  return fileno(epochFile_);
+}
+
+void FileMgr::setEpochSynced() {
   epochIsCheckpointed_ = true;
 }
 
@@ -676,11 +957,22 @@ std::string FileMgr::describeSelf() const {
 }
 
 void FileMgr::checkpoint() {
+  prepareCheckpoint();
+  syncFilesToDisk();
+  writeAndSyncEpochToDisk();
+  completeCheckpoint();
+}
+
+void FileMgr::prepareCheckpoint() {
   VLOG(2) << "Checkpointing " << describeSelf() << " epoch: " << epoch();
   writeDirtyBuffers();
   rollOffOldData(epoch(), false /* shouldCheckpoint */);
-  syncFilesToDisk();
-  writeAndSyncEpochToDisk();
+}
+
+void FileMgr::completeCheckpoint() {
+  if (writes_chunk_index_snapshot_) {
+    writeChunkIndexSnapshot();
+  }
   incrementEpoch();
   freePages();
 }
@@ -850,6 +1142,7 @@ void FileMgr::free(AbstractBuffer* buffer) {
 
 Page FileMgr::requestFreePage(size_t pageSize, const bool isMetadata) {
   std::lock_guard<std::mutex> lock(getPageMutex_);
+  invalidateChunkIndexSnapshot();
 
   auto candidateFiles = fileIndex_.equal_range(pageSize);
   int32_t pageNum = -1;
@@ -879,6 +1172,7 @@ void FileMgr::requestFreePages(size_t numPagesRequested,
   // not used currently
   // @todo add method to FileInfo to get more than one page
   std::lock_guard<std::mutex> lock(getPageMutex_);
+  invalidateChunkIndexSnapshot();
   auto candidateFiles = fileIndex_.equal_range(pageSize);
   size_t numPagesNeeded = numPagesRequested;
   for (auto fileIt = candidateFiles.first; fileIt != candidateFiles.second; ++fileIt) {
@@ -1193,12 +1487,20 @@ void FileMgr::resumeFileCompaction(const std::string& status_file_name) {
  * Rename status file to a file name that indicates initiation of this
  * phase. Delete all empty files (files containing only free pages).
  * Delete status file.
+ *
+ * Page copying is throttled to `g_data_compaction_max_bytes_per_sec`, if set.
+ * In-memory buffers are pointed at the copied pages before empty files are
+ * deleted, so the file manager remains usable once compaction completes.
  */
 void FileMgr::compactFiles() {
+  mapd_unique_lock<mapd_shared_mutex> chunk_index_write_lock(chunkIndexMutex_);
   mapd_unique_lock<mapd_shared_mutex> write_lock(files_rw_mutex_);
   if (files_.empty()) {
     return;
   }
+  invalidateChunkIndexSnapshot();
+  compaction_copy_start_ = std::chrono::steady_clock::now();
+  compaction_bytes_copied_ = 0;
 
   auto copy_pages_status_file_path = getFilePath(COPY_PAGES_STATUS);
   CHECK(!boost::filesystem::exists(copy_pages_status_file_path));
@@ -1220,6 +1522,7 @@ void FileMgr::compactFiles() {
   renameCompactionStatusFile(COPY_PAGES_STATUS, UPDATE_PAGE_VISIBILITY_STATUS);
 
   updateMappedPagesVisibility(page_mappings);
+  remapCompactedPages(page_mappings);
   renameCompactionStatusFile(UPDATE_PAGE_VISIBILITY_STATUS, DELETE_EMPTY_FILES_STATUS);
 
   deleteEmptyFiles();
@@ -1347,6 +1650,27 @@ void FileMgr::copySourcePageForCompaction(const Page& source_page,
                              header_size,
                              static_cast<size_t>(destination_page.fileId),
                              destination_page.pageNum);
+  throttleCompactionCopy(destination_file_info->pageSize);
+}
+
+/**
+ * Sleeps as needed to keep the page copy rate of the ongoing data compaction
+ * under `g_data_compaction_max_bytes_per_sec`. A value of 0 disables throttling.
+ */
+void FileMgr::throttleCompactionCopy(const size_t num_bytes) {
+  if (g_data_compaction_max_bytes_per_sec == 0) {
+    return;
+  }
+  compaction_bytes_copied_ += num_bytes;
+  const std::chrono::duration<double> copy_budget_time(
+      static_cast<double>(compaction_bytes_copied_) /
+      g_data_compaction_max_bytes_per_sec);
+  const auto resume_time =
+      compaction_copy_start_ +
+      std::chrono::duration_cast<std::chrono::steady_clock::duration>(copy_budget_time);
+  if (resume_time > std::chrono::steady_clock::now()) {
+    std::this_thread::sleep_until(resume_time);
+  }
 }
 
 /**
@@ -1415,18 +1739,60 @@ void FileMgr::updateMappedPagesVisibility(const std::vector<PageMapping>& page_m
   }
 }
 
+/**
+ * Points the pages of in-memory buffers and of deferred page frees at the
+ * destination pages of the given page mapping.
+ */
+void FileMgr::remapCompactedPages(const std::vector<PageMapping>& page_mappings) {
+  if (page_mappings.empty()) {
+    return;
+  }
+  std::map<Page, Page> page_map;
+  for (const auto& page_mapping : page_mappings) {
+    page_map.emplace(Page{static_cast<int32_t>(page_mapping.source_file_id),
+                          page_mapping.source_page_num},
+                     Page{static_cast<int32_t>(page_mapping.destination_file_id),
+                          page_mapping.destination_page_num});
+  }
+  for (auto [key, buffer] : chunkIndex_) {
+    buffer->remapPages(page_map);
+  }
+
+  mapd_unique_lock<mapd_shared_mutex> free_pages_write_lock(mutex_free_page_);
+  for (auto& [file_info, page_num] : free_pages_) {
+    auto it = page_map.find(Page{file_info->fileId, static_cast<size_t>(page_num)});
+    if (it != page_map.end()) {
+      file_info = files_.at(it->second.fileId);
+      page_num = static_cast<int32_t>(it->second.pageNum);
+    }
+  }
+}
+
 /**
  * Deletes files that contain only free pages. Also deletes the compaction
  * status file.
  */
 void FileMgr::deleteEmptyFiles() {
-  for (auto [file_id, file_info] : files_) {
+  for (auto file_it = files_.begin(); file_it != files_.end();) {
+    auto [file_id, file_info] = *file_it;
     CHECK_EQ(file_id, file_info->fileId);
     if (file_info->freePages.size() == file_info->numPages) {
       fclose(file_info->f);
       file_info->f = nullptr;
       auto file_path = get_data_file_path(fileMgrBasePath_, file_id, file_info->pageSize);
       boost::filesystem::remove(file_path);
+
+      auto range = fileIndex_.equal_range(file_info->pageSize);
+      for (auto index_it = range.first; index_it != range.second; ++index_it) {
+        if (index_it->second == file_id) {
+          fileIndex_.erase(index_it);
+          break;
+        }
+      }
+      delete file_info;
+      file_it = files_.erase(file_it);
+    } else {
+      ++file_it;
     }
   }
 
@@ -1510,6 +1876,24 @@ void FileMgr::syncFilesToDisk() {
   }
 }
 
+void FileMgr::flushFilesForSync(std::vector<int>& fds) {
+  mapd_shared_lock<mapd_shared_mutex> files_read_lock(files_rw_mutex_);
+  for (auto [file_id, file_info] : files_) {
+    if (file_info->flushToOs()) {
+      fds.emplace_back(fileno(file_info->f));
+    }
+  }
+}
+
+// Writes to the files of a table are done before its checkpoint, so no write can occur
+// between flushing the files and syncing them.
+void FileMgr::setFilesSynced() {
+  mapd_shared_lock<mapd_shared_mutex> files_read_lock(files_rw_mutex_);
+  for (auto [file_id, file_info] : files_) {
+    file_info->setSynced();
+  }
+}
+
 void FileMgr::initializeNumThreads(size_t num_reader_threads) {
   // # of threads is based on # of cores on the host
   size_t num_hardware_based_threads = std::thread::hardware_concurrency();
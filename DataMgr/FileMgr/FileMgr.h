@@ -25,6 +25,8 @@
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <future>
 #include <iostream>
 #include <map>
@@ -43,6 +45,10 @@
 
 using namespace Data_Namespace;
 
+extern size_t g_data_compaction_max_bytes_per_sec;
+// Persist the chunk index of each table at checkpoints and open tables from it.
+extern bool g_enable_chunk_index_snapshot;
+
 namespace File_Namespace {
 class GlobalFileMgr;  // forward declaration
 /**
@@ -327,6 +333,8 @@ class FileMgr : public AbstractBufferMgr {  // implements
   void removeTableRelatedDS(const int32_t db_id, const int32_t table_id) override;
 
   virtual void free_page(std::pair<FileInfo*, int32_t>&& page);
+  // Called before pages are written, see openFilesFromChunkIndexSnapshot().
+  void invalidateChunkIndexSnapshot();
   inline virtual bool hasFileMgrKey() const { return true; }
   const TablePair get_fileMgrKey() const { return fileMgrKey_; }
 
@@ -377,6 +385,7 @@ class FileMgr : public AbstractBufferMgr {  // implements
   static constexpr char EPOCH_FILENAME[] = "epoch_metadata";
   static constexpr char DB_META_FILENAME[] = "dbmeta";
   static constexpr char FILE_MGR_VERSION_FILENAME[] = "filemgr_version";
+  static constexpr char CHUNK_INDEX_SNAPSHOT_FILENAME[] = "chunk_index_snapshot";
   static constexpr int32_t INVALID_VERSION = -1;
 
  protected:
@@ -405,6 +414,16 @@ class FileMgr : public AbstractBufferMgr {  // implements
   std::vector<std::pair<FileInfo*, int32_t>> free_pages_;
   bool isFullyInitted_{false};
 
+  // Page copy progress of an ongoing data compaction, used to throttle its I/O.
+  std::chrono::steady_clock::time_point compaction_copy_start_;
+  size_t compaction_bytes_copied_{0};
+
+  // Whether checkpoints write the chunk index snapshot, and whether the one on disk
+  // still describes the files, i.e. no page was written since it was taken.
+  bool writes_chunk_index_snapshot_{false};
+  std::atomic<bool> chunk_index_snapshot_valid_{false};
+  std::mutex chunk_index_snapshot_mutex_;
+
   static size_t num_pages_per_data_file_;
   static size_t num_pages_per_metadata_file_;
 
@@ -454,6 +473,15 @@ class FileMgr : public AbstractBufferMgr {  // implements
 
   OpenFilesResult openFiles();
 
+  /**
+   * The chunk index snapshot lists the page headers of the table as of its last
+   * checkpoint, so that the table can be opened without reading the header of every
+   * page. It is invalidated before the first page is written after the checkpoint, and
+   * is only used if its epoch and data files match those on disk.
+   */
+  void writeChunkIndexSnapshot();
+  bool openFilesFromChunkIndexSnapshot(OpenFilesResult& result);
+
   void clearFileInfos();
 
   // Data compaction methods
@@ -467,6 +495,8 @@ class FileMgr : public AbstractBufferMgr {  // implements
                                          std::vector<PageMapping>& page_mappings,
                                          std::set<Page>& touched_pages);
   void updateMappedPagesVisibility(const std::vector<PageMapping>& page_mappings);
+  void remapCompactedPages(const std::vector<PageMapping>& page_mappings);
+  void throttleCompactionCopy(const size_t num_bytes);
   void deleteEmptyFiles();
   void resumeFileCompaction(const std::string& status_file_name);
   std::vector<PageMapping> readPageMappingsFromStatusFile();
@@ -477,6 +507,19 @@ class FileMgr : public AbstractBufferMgr {  // implements
   void closePhysicalUnlocked();
   void syncFilesToDisk();
   void freePages();
+
+  /**
+   * Steps of checkpoint() around the file syncs, used by GlobalFileMgr to sync the files
+   * of concurrently checkpointed tables together. The flush methods flush pending writes
+   * to the OS and return the descriptors of the files to sync, after which the set
+   * methods record that those files were synced.
+   */
+  void prepareCheckpoint();
+  void flushFilesForSync(std::vector<int>& fds);
+  void setFilesSynced();
+  int flushEpochForSync();
+  void setEpochSynced();
+  void completeCheckpoint();
   void initializeNumThreads(size_t num_reader_threads = 0);
   virtual FileBuffer* allocateBuffer(const size_t page_size,
                                      const ChunkKey& key,
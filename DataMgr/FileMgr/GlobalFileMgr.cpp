@@ -26,6 +26,7 @@
 #include <algorithm>
 #include <boost/filesystem.hpp>
 #include <boost/lexical_cast.hpp>
+#include <chrono>
 #include <string>
 #include <thread>
 #include <utility>
@@ -33,10 +34,13 @@
 
 #include "DataMgr/ForeignStorage/ArrowForeignStorage.h"
 #include "DataMgr/ForeignStorage/ForeignStorageInterface.h"
+#include "OSDependent/omnisci_fs.h"
 #include "Shared/File.h"
 
 using namespace std;
 
+size_t g_checkpoint_group_commit_window_us{0};
+
 namespace File_Namespace {
 
 GlobalFileMgr::GlobalFileMgr(const int32_t deviceId,
@@ -77,14 +81,116 @@ void GlobalFileMgr::init() {
 
 void GlobalFileMgr::checkpoint() {
   mapd_unique_lock<mapd_shared_mutex> write_lock(fileMgrs_mutex_);
-  for (auto fileMgrsIt = allFileMgrs_.begin(); fileMgrsIt != allFileMgrs_.end();
-       ++fileMgrsIt) {
-    fileMgrsIt->second->checkpoint();
+  if (g_checkpoint_group_commit_window_us == 0) {
+    for (auto fileMgrsIt = allFileMgrs_.begin(); fileMgrsIt != allFileMgrs_.end();
+         ++fileMgrsIt) {
+      fileMgrsIt->second->checkpoint();
+    }
+    return;
+  }
+
+  // All tables are checkpointed with a single sync of their files
+  std::vector<FileMgr*> file_mgrs;
+  for (auto [table_key, buffer_mgr] : allFileMgrs_) {
+    auto file_mgr = dynamic_cast<FileMgr*>(buffer_mgr);
+    if (file_mgr) {
+      file_mgr->prepareCheckpoint();
+      file_mgrs.emplace_back(file_mgr);
+    } else {
+      buffer_mgr->checkpoint();
+    }
+  }
+  syncCheckpointedFiles(file_mgrs);
+  for (auto file_mgr : file_mgrs) {
+    file_mgr->completeCheckpoint();
   }
 }
 
 void GlobalFileMgr::checkpoint(const int32_t db_id, const int32_t tb_id) {
-  getFileMgr(db_id, tb_id)->checkpoint();
+  auto buffer_mgr = getFileMgr(db_id, tb_id);
+  auto file_mgr = dynamic_cast<FileMgr*>(buffer_mgr);
+  if (g_checkpoint_group_commit_window_us == 0 || !file_mgr) {
+    buffer_mgr->checkpoint();
+    return;
+  }
+  groupCommitCheckpoint(file_mgr);
+}
+
+/**
+ * Checkpoints the given table, syncing its files together with those of the tables
+ * checkpointed concurrently. The first checkpoint of a group waits for
+ * `g_checkpoint_group_commit_window_us` to let other checkpoints join, then syncs the
+ * files of the whole group while the others wait. Each table still writes its own
+ * epoch, after its data files were synced.
+ */
+void GlobalFileMgr::groupCommitCheckpoint(FileMgr* file_mgr) {
+  file_mgr->prepareCheckpoint();
+
+  std::shared_ptr<CheckpointGroup> group;
+  bool is_group_leader{false};
+  {
+    std::lock_guard<std::mutex> lock(checkpoint_group_mutex_);
+    if (!pending_checkpoint_group_) {
+      pending_checkpoint_group_ = std::make_shared<CheckpointGroup>();
+      is_group_leader = true;
+    }
+    group = pending_checkpoint_group_;
+    group->file_mgrs.emplace_back(file_mgr);
+  }
+
+  if (is_group_leader) {
+    std::this_thread::sleep_for(
+        std::chrono::microseconds(g_checkpoint_group_commit_window_us));
+    {
+      // Later checkpoints start a new group
+      std::lock_guard<std::mutex> lock(checkpoint_group_mutex_);
+      pending_checkpoint_group_.reset();
+    }
+    VLOG(2) << "Syncing files of " << group->file_mgrs.size()
+            << " checkpointed tables together";
+    syncCheckpointedFiles(group->file_mgrs);
+    {
+      std::lock_guard<std::mutex> lock(checkpoint_group_mutex_);
+      group->synced = true;
+    }
+    checkpoint_group_cv_.notify_all();
+  } else {
+    std::unique_lock<std::mutex> lock(checkpoint_group_mutex_);
+    checkpoint_group_cv_.wait(lock, [&group] { return group->synced; });
+  }
+  file_mgr->completeCheckpoint();
+}
+
+/**
+ * Syncs the data files and then the epoch files of the given tables, with one sync per
+ * file system where supported and one per file otherwise.
+ */
+void GlobalFileMgr::syncCheckpointedFiles(const std::vector<FileMgr*>& file_mgrs) {
+  std::vector<int> fds;
+  for (auto file_mgr : file_mgrs) {
+    file_mgr->flushFilesForSync(fds);
+  }
+  const bool data_files_synced = omnisci::sync_file_systems(fds);
+  for (auto file_mgr : file_mgrs) {
+    if (data_files_synced) {
+      file_mgr->setFilesSynced();
+    } else {
+      file_mgr->syncFilesToDisk();
+    }
+  }
+
+  fds.clear();
+  for (auto file_mgr : file_mgrs) {
+    fds.emplace_back(file_mgr->flushEpochForSync());
+  }
+  const bool epoch_files_synced = omnisci::sync_file_systems(fds);
+  for (auto file_mgr : file_mgrs) {
+    if (epoch_files_synced) {
+      file_mgr->setEpochSynced();
+    } else {
+      file_mgr->writeAndSyncEpochToDisk();
+    }
+  }
 }
 
 size_t GlobalFileMgr::getNumChunks() {
@@ -321,16 +427,12 @@ StorageStats GlobalFileMgr::getStorageStats(const int32_t db_id, const int32_t t
 }
 
 void GlobalFileMgr::compactDataFiles(const int32_t db_id, const int32_t tb_id) {
-  auto file_mgr = dynamic_cast<File_Namespace::FileMgr*>(findFileMgr(db_id, tb_id));
-  {
-    mapd_unique_lock<mapd_shared_mutex> write_lock(fileMgrs_mutex_);
-    if (file_mgr) {
-      file_mgr->compactFiles();
-      deleteFileMgr(db_id, tb_id);
-    }
+  // Compaction only locks the file manager of the given table and keeps its in-memory
+  // buffers up to date, so file managers of other tables remain accessible and the
+  // table does not need to be re-initialized from disk afterwards.
+  auto file_mgr = dynamic_cast<File_Namespace::FileMgr*>(getFileMgr(db_id, tb_id));
+  if (file_mgr) {
+    file_mgr->compactFiles();
   }
-
-  // Re-initialize file manager
-  getFileMgr(db_id, tb_id);
 }
 }  // namespace File_Namespace
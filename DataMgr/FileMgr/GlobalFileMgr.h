@@ -26,8 +26,10 @@
 #ifndef DATAMGR_MEMORY_FILE_GLOBAL_FILEMGR_H
 #define DATAMGR_MEMORY_FILE_GLOBAL_FILEMGR_H
 
+#include <condition_variable>
 #include <iostream>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <set>
 #include "../Shared/mapd_shared_mutex.h"
@@ -40,6 +42,10 @@ class ForeignStorageInterface;
 
 using namespace Data_Namespace;
 
+// Window in microseconds during which concurrent table checkpoints are grouped to sync
+// their files together, 0 disables grouping.
+extern size_t g_checkpoint_group_commit_window_us;
+
 namespace File_Namespace {
 
 struct FileMgrParams {
@@ -154,6 +160,15 @@ class GlobalFileMgr : public AbstractBufferMgr {  // implements
   AbstractBufferMgr* findFileMgrUnlocked(const int32_t db_id, const int32_t tb_id);
   void deleteFileMgr(const int32_t db_id, const int32_t tb_id);
 
+  // Table checkpoints waiting for the sync of their files by the first of them.
+  struct CheckpointGroup {
+    std::vector<FileMgr*> file_mgrs;
+    bool synced{false};
+  };
+
+  void groupCommitCheckpoint(FileMgr* file_mgr);
+  static void syncCheckpointedFiles(const std::vector<FileMgr*>& file_mgrs);
+
  public:
   AbstractBufferMgr* findFileMgr(const int32_t db_id, const int32_t tb_id) {
     mapd_shared_lock<mapd_shared_mutex> read_lock(fileMgrs_mutex_);
@@ -219,6 +234,10 @@ class GlobalFileMgr : public AbstractBufferMgr {  // implements
   std::shared_ptr<ForeignStorageInterface> fsi_;
 
   mapd_shared_mutex fileMgrs_mutex_;
+
+  std::mutex checkpoint_group_mutex_;
+  std::condition_variable checkpoint_group_cv_;
+  std::shared_ptr<CheckpointGroup> pending_checkpoint_group_;
 };
 
 }  // namespace File_Namespace
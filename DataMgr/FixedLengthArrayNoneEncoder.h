@@ -41,7 +41,9 @@ using Data_Namespace::AbstractBuffer;
 class FixedLengthArrayNoneEncoder : public Encoder {
  public:
   FixedLengthArrayNoneEncoder(AbstractBuffer* buffer, size_t as)
-      : Encoder(buffer), has_nulls(false), initialized(false), array_size(as) {}
+      : Encoder(buffer), has_nulls(false), initialized(false), array_size(as) {
+    block_bounds_.reset(buffer ? buffer->getSqlType() : SQLTypeInfo());
+  }
 
   size_t getNumElemsForBytesInsertData(const std::vector<ArrayDatum>* srcData,
                                        const int start_idx,
@@ -71,6 +73,7 @@ class FixedLengthArrayNoneEncoder : public Encoder {
     size_t data_size = array_size * numAppendElems;
     buffer_->reserve(data_size);
 
+    block_bounds_.beginAppend(num_elems_);
     for (size_t i = start_idx; i < start_idx + numAppendElems; i++) {
       size_t len = (*srcData)[replicating ? 0 : i].length;
       // Length of the appended array should be equal to the fixed length,
@@ -79,6 +82,9 @@ class FixedLengthArrayNoneEncoder : public Encoder {
       // NULL arrays have been filled with subtype's NULL sentinels,
       // should be appended as regular data, same size
       buffer_->append((*srcData)[replicating ? 0 : i].pointer, len);
+      block_bounds_.update(num_elems_ + i - start_idx,
+                           (*srcData)[replicating ? 0 : i].pointer,
+                           (*srcData)[replicating ? 0 : i].is_null);
 
       // keep Chunk statistics with array elements
       update_elem_stats((*srcData)[replicating ? 0 : i]);
@@ -98,6 +104,7 @@ class FixedLengthArrayNoneEncoder : public Encoder {
   void getMetadata(const std::shared_ptr<ChunkMetadata>& chunkMetadata) override {
     Encoder::getMetadata(chunkMetadata);  // call on parent class
     chunkMetadata->fillChunkStats(elem_min, elem_max, has_nulls);
+    chunkMetadata->blockBounds = block_bounds_.get(num_elems_);
   }
 
   // Only called from the executor for synthesized meta-information.
@@ -126,6 +133,7 @@ class FixedLengthArrayNoneEncoder : public Encoder {
   void updateStats(const std::vector<ArrayDatum>* const src_data,
                    const size_t start_idx,
                    const size_t num_elements) override {
+    block_bounds_.invalidate();
     for (size_t n = start_idx; n < start_idx + num_elements; n++) {
       update_elem_stats((*src_data)[n]);
     }
@@ -160,6 +168,7 @@ class FixedLengthArrayNoneEncoder : public Encoder {
   }
 
   void updateMetadata(int8_t* array) {
+    block_bounds_.invalidate();
     update_elem_stats(ArrayDatum(array_size, array, is_null(array), DoNothingDeleter()));
   }
 
@@ -241,6 +250,7 @@ class FixedLengthArrayNoneEncoder : public Encoder {
  private:
   std::mutex EncoderMutex_;
   size_t array_size;
+  BlockBoundsBuilder block_bounds_;
 
   bool is_null(int8_t* array) { return is_null(buffer_->getSqlType(), array); }
 
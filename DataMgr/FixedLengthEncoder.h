@@ -34,6 +34,7 @@ class FixedLengthEncoder : public Encoder {
  public:
   FixedLengthEncoder(Data_Namespace::AbstractBuffer* buffer) : Encoder(buffer) {
     resetChunkStats();
+    resetRowStats();
   }
 
   std::shared_ptr<ChunkMetadata> appendData(int8_t*& src_data,
@@ -45,13 +46,21 @@ class FixedLengthEncoder : public Encoder {
         num_elems_to_append >=
             num_elems_) {  // we're rewriting entire buffer so fully recompute metadata
       resetChunkStats();
+      resetRowStats();
     }
 
+    const size_t start_row = offset == -1 ? num_elems_ : static_cast<size_t>(offset);
+    if (offset == -1) {
+      beginRowStatsAppend(start_row);
+    }
     T* unencoded_data = reinterpret_cast<T*>(src_data);
     auto encoded_data = std::make_unique<V[]>(num_elems_to_append);
     for (size_t i = 0; i < num_elems_to_append; ++i) {
       size_t ri = replicating ? 0 : i;
       encoded_data.get()[i] = encodeDataAndUpdateStats(unencoded_data[ri]);
+      updateRowStats(start_row + i,
+                     unencoded_data[ri],
+                     encoded_data.get()[i] == std::numeric_limits<V>::min());
     }
 
     // assume always CPU_BUFFER?
@@ -89,6 +98,7 @@ class FixedLengthEncoder : public Encoder {
 
   // Only called from the executor for synthesized meta-information.
   void updateStats(const int64_t val, const bool is_null) override {
+    invalidateRowStats();
     if (is_null) {
       has_nulls = true;
     } else {
@@ -100,6 +110,7 @@ class FixedLengthEncoder : public Encoder {
 
   // Only called from the executor for synthesized meta-information.
   void updateStats(const double val, const bool is_null) override {
+    invalidateRowStats();
     if (is_null) {
       has_nulls = true;
     } else {
@@ -110,6 +121,7 @@ class FixedLengthEncoder : public Encoder {
   }
 
   void updateStats(const int8_t* const src_data, const size_t num_elements) override {
+    invalidateRowStats();
     const T* unencoded_data = reinterpret_cast<const T*>(src_data);
     for (size_t i = 0; i < num_elements; ++i) {
       encodeDataAndUpdateStats(unencoded_data[i]);
@@ -118,6 +130,7 @@ class FixedLengthEncoder : public Encoder {
 
   void updateStatsEncoded(const int8_t* const dst_data,
                           const size_t num_elements) override {
+    invalidateRowStats();
     const V* data = reinterpret_cast<const V*>(dst_data);
 
     std::tie(dataMin, dataMax, has_nulls) = tbb::parallel_reduce(
@@ -193,6 +206,7 @@ class FixedLengthEncoder : public Encoder {
   }
 
   bool resetChunkStats(const ChunkStats& stats) override {
+    invalidateRowStats();
     const auto new_min = DatumFetcher::getDatumVal<T>(stats.min);
     const auto new_max = DatumFetcher::getDatumVal<T>(stats.max);
 
@@ -207,6 +221,7 @@ class FixedLengthEncoder : public Encoder {
   }
 
   void resetChunkStats() override {
+    invalidateRowStats();
     dataMin = std::numeric_limits<T>::max();
     dataMax = std::numeric_limits<T>::lowest();
     has_nulls = false;
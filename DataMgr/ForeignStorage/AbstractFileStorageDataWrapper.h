@@ -27,7 +27,6 @@ class AbstractFileStorageDataWrapper : public ForeignDataWrapper {
   inline static const std::array<std::string, 1> supported_storage_types{
       LOCAL_FILE_STORAGE_TYPE};
 
- protected:
   /**
   @brief Returns the path to the source file/dir of the table.  Depending on options
   this may result from a concatenation of server and table path options.
@@ -83,13 +83,13 @@ class ArrowForeignStorageBase : public PersistentForeignStorageInterface {
       const ColumnDescriptor& c,
       std::shared_ptr<arrow::ChunkedArray> arr_col_chunked_array);
 
-  void generateNullValues(const std::vector<Frag>& fragments,
-                          std::shared_ptr<arrow::ChunkedArray> arr_col_chunked_array,
-                          const SQLTypeInfo& columnType);
+  std::shared_ptr<arrow::ChunkedArray> generateNullValues(
+      std::shared_ptr<arrow::ChunkedArray> arr_col_chunked_array,
+      const SQLTypeInfo& columnType);
 
   template <typename T>
-  void setNullValues(const std::vector<Frag>& fragments,
-                     std::shared_ptr<arrow::ChunkedArray> arr_col_chunked_array);
+  std::shared_ptr<arrow::ChunkedArray> convertNullValues(
+      std::shared_ptr<arrow::ChunkedArray> arr_col_chunked_array);
 
   template <typename T>
   void setNulls(int8_t* data, int count);
@@ -111,93 +111,69 @@ class ArrowForeignStorageBase : public PersistentForeignStorageInterface {
   std::map<std::array<int, 3>, std::vector<ArrowFragment>> m_columns;
 };
 
-void ArrowForeignStorageBase::generateNullValues(
-    const std::vector<Frag>& fragments,
+std::shared_ptr<arrow::ChunkedArray> ArrowForeignStorageBase::generateNullValues(
     std::shared_ptr<arrow::ChunkedArray> arr_col_chunked_array,
     const SQLTypeInfo& columnType) {
   const size_t typeSize = columnType.get_size();
   if (columnType.is_integer() || is_datetime(columnType.get_type())) {
     switch (typeSize) {
       case 1:
-        setNullValues<int8_t>(fragments, arr_col_chunked_array);
-        break;
+        return convertNullValues<int8_t>(arr_col_chunked_array);
       case 2:
-        setNullValues<int16_t>(fragments, arr_col_chunked_array);
-        break;
+        return convertNullValues<int16_t>(arr_col_chunked_array);
       case 4:
-        setNullValues<int32_t>(fragments, arr_col_chunked_array);
-        break;
+        return convertNullValues<int32_t>(arr_col_chunked_array);
       case 8:
-        setNullValues<int64_t>(fragments, arr_col_chunked_array);
-        break;
+        return convertNullValues<int64_t>(arr_col_chunked_array);
       default:
         // TODO: throw unsupported integer type exception
         CHECK(false);
     }
-  } else {
+  } else if (columnType.is_fp()) {
     if (typeSize == 4) {
-      setNullValues<float>(fragments, arr_col_chunked_array);
+      return convertNullValues<float>(arr_col_chunked_array);
     } else {
-      setNullValues<double>(fragments, arr_col_chunked_array);
+      return convertNullValues<double>(arr_col_chunked_array);
     }
   }
+  return arr_col_chunked_array;
 }
 
 template <typename T>
-void ArrowForeignStorageBase::setNullValues(
-    const std::vector<Frag>& fragments,
+std::shared_ptr<arrow::ChunkedArray> ArrowForeignStorageBase::convertNullValues(
     std::shared_ptr<arrow::ChunkedArray> arr_col_chunked_array) {
   const T null_value = std::is_signed<T>::value ? std::numeric_limits<T>::min()
                                                 : std::numeric_limits<T>::max();
 
+  // Chunks without nulls already have our layout and are referenced by the chunk
+  // buffers directly. Chunks with some nulls are converted to copies with null
+  // sentinels, the Arrow memory may be shared with the caller and is not written to.
+  // Chunks with only nulls are filled with sentinels in the read function.
+  std::vector<std::shared_ptr<arrow::Array>> chunks = arr_col_chunked_array->chunks();
   tbb::parallel_for(
-      tbb::blocked_range<size_t>(0, fragments.size()),
-      [&](const tbb::blocked_range<size_t>& r0) {
-        for (size_t f = r0.begin(); f != r0.end(); ++f) {
-          tbb::parallel_for(
-              tbb::blocked_range<size_t>(fragments[f].first_chunk,
-                                         fragments[f].last_chunk + 1),
-              [&](const tbb::blocked_range<size_t>& r1) {
-                for (auto chunk_index = r1.begin(); chunk_index != r1.end();
-                     ++chunk_index) {
-                  auto chunk = arr_col_chunked_array->chunk(chunk_index).get();
-                  if (chunk->data()->null_count == chunk->data()->length) {
-                    // it means we will insert sentinel values in read function
-                    continue;
-                  }
-                  // We can not use mutable_data in case of shared access
-                  // This is not realy safe, but it is the only way to do this without
-                  // copiing
-                  // TODO: add support for sentinel values to read_csv
-                  auto data = const_cast<uint8_t*>(chunk->data()->buffers[1]->data());
-                  if (data && chunk->null_bitmap()) {  // TODO: to be checked and possibly
-                                                       // reimplemented
-                    // CHECK(data) << " is null";
-                    T* dataT = reinterpret_cast<T*>(data);
-                    const uint8_t* bitmap_data = chunk->null_bitmap_data();
-                    const int64_t length = chunk->length();
-                    const int64_t bitmap_length = chunk->null_bitmap()->size() - 1;
-
-                    for (int64_t bitmap_idx = 0; bitmap_idx < bitmap_length;
-                         ++bitmap_idx) {
-                      T* res = dataT + bitmap_idx * 8;
-                      for (int8_t bitmap_offset = 0; bitmap_offset < 8; ++bitmap_offset) {
-                        auto is_null = (~bitmap_data[bitmap_idx] >> bitmap_offset) & 1;
-                        auto val = is_null ? null_value : res[bitmap_offset];
-                        res[bitmap_offset] = val;
-                      }
-                    }
-
-                    for (int64_t j = bitmap_length * 8; j < length; ++j) {
-                      auto is_null = (~bitmap_data[bitmap_length] >> (j % 8)) & 1;
-                      auto val = is_null ? null_value : dataT[j];
-                      dataT[j] = val;
-                    }
-                  }
-                }
-              });
+      tbb::blocked_range<size_t>(0, chunks.size()),
+      [&](const tbb::blocked_range<size_t>& r) {
+        for (auto chunk_index = r.begin(); chunk_index != r.end(); ++chunk_index) {
+          auto& chunk = chunks[chunk_index];
+          const auto& array_data = chunk->data();
+          if (array_data->GetNullCount() == 0 ||
+              array_data->GetNullCount() == array_data->length) {
+            continue;
+          }
+          const int64_t length = chunk->length();
+          auto res = arrow::AllocateBuffer(length * sizeof(T));
+          CHECK(res.ok());
+          std::shared_ptr<arrow::Buffer> values_buffer = std::move(res).ValueOrDie();
+          const T* src = array_data->GetValues<T>(1);
+          T* dst = reinterpret_cast<T*>(values_buffer->mutable_data());
+          for (int64_t j = 0; j < length; ++j) {
+            dst[j] = chunk->IsNull(j) ? null_value : src[j];
+          }
+          chunk = arrow::MakeArray(arrow::ArrayData::Make(
+              array_data->type, length, {nullptr, values_buffer}, 0));
         }
       });
+  return std::make_shared<arrow::ChunkedArray>(chunks, arr_col_chunked_array->type());
 }
 
 template <typename T>
@@ -395,6 +371,9 @@ void ArrowForeignStorageBase::parseArrowTable(Catalog_Namespace::Catalog* catalo
                 CHECK(false);
                 break;
             }
+          } else if (!c.columnType.is_string()) {
+            arr_col_chunked_array =
+                generateNullValues(arr_col_chunked_array, c.columnType);
           }
           auto empty =
               arr_col_chunked_array->null_count() == arr_col_chunked_array->length();
@@ -451,10 +430,6 @@ void ArrowForeignStorageBase::parseArrowTable(Catalog_Namespace::Catalog* catalo
               b->getEncoder()->setNumElems(frag.sz);
             }
           }
-          if (column_type != kDECIMAL && column_type != kNUMERIC &&
-              !c.columnType.is_string()) {
-            generateNullValues(fragments, arr_col_chunked_array, c.columnType);
-          }
         }
       });  // each col and fragment
 
@@ -40,4 +40,7 @@ class CacheEvictionAlgorithm {
   virtual const ChunkKey evictNextChunk() = 0;
   virtual void touchChunk(const ChunkKey&) = 0;
   virtual void removeChunk(const ChunkKey&) = 0;
+  // Hints for algorithms which weight chunks by size and refetch cost, ignored otherwise.
+  virtual void setChunkSize(const ChunkKey&, const size_t) {}
+  virtual void setTableRefetchCost(const ChunkKey&, const double) {}
 };
@@ -0,0 +1,133 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "CostAwareEvictionAlgorithm.h"
+
+#include <algorithm>
+
+CostAwareEvictionAlgorithm::CostAwareEvictionAlgorithm(const size_t table_size_limit)
+    : table_size_limit_(table_size_limit) {}
+
+const ChunkKey CostAwareEvictionAlgorithm::evictNextChunk() {
+  mapd_unique_lock<mapd_shared_mutex> lock(cache_mutex_);
+  if (eviction_queue_.empty()) {
+    throw NoEntryFoundException();
+  }
+  const auto key = getChunkToEvict();
+  auto it = chunks_.find(key);
+  CHECK(it != chunks_.end()) << "Chunk not evicted!";
+  inflation_ = std::max(inflation_, it->second.priority);
+  eraseChunk(it);
+  return key;
+}
+
+void CostAwareEvictionAlgorithm::touchChunk(const ChunkKey& key) {
+  mapd_unique_lock<mapd_shared_mutex> lock(cache_mutex_);
+  auto& entry = chunks_[key];
+  entry.num_accesses++;
+  updatePriority(key, entry);
+}
+
+void CostAwareEvictionAlgorithm::removeChunk(const ChunkKey& key) {
+  mapd_unique_lock<mapd_shared_mutex> lock(cache_mutex_);
+  auto it = chunks_.find(key);
+  if (it == chunks_.end()) {
+    return;
+  }
+  eraseChunk(it);
+}
+
+void CostAwareEvictionAlgorithm::setChunkSize(const ChunkKey& key,
+                                              const size_t num_bytes) {
+  mapd_unique_lock<mapd_shared_mutex> lock(cache_mutex_);
+  auto it = chunks_.find(key);
+  if (it == chunks_.end()) {
+    return;
+  }
+  auto& entry = it->second;
+  const auto table_key = get_table_key(key);
+  auto& table_size = table_sizes_[table_key];
+  CHECK_GE(table_size, entry.num_bytes);
+  table_size = table_size - entry.num_bytes + num_bytes;
+  if (table_size == 0) {
+    table_sizes_.erase(table_key);
+  }
+  entry.num_bytes = num_bytes;
+  updatePriority(key, entry);
+}
+
+void CostAwareEvictionAlgorithm::setTableRefetchCost(const ChunkKey& table_key,
+                                                     const double cost) {
+  mapd_unique_lock<mapd_shared_mutex> lock(cache_mutex_);
+  CHECK_GT(cost, 0);
+  table_refetch_costs_[table_key] = cost;
+}
+
+std::string CostAwareEvictionAlgorithm::dumpEvictionQueue() {
+  mapd_shared_lock<mapd_shared_mutex> lock(cache_mutex_);
+  std::string ret = "Eviction queue:\n{";
+  for (const auto& [priority, chunk] : eviction_queue_) {
+    ret += show_chunk(chunk) + ": " + std::to_string(priority) + ", ";
+  }
+  ret += "}\n";
+  return ret;
+}
+
+void CostAwareEvictionAlgorithm::updatePriority(const ChunkKey& key, ChunkEntry& entry) {
+  eviction_queue_.erase({entry.priority, key});
+  entry.priority = inflation_;
+  if (entry.num_bytes > 0) {
+    // Chunks without data free no space, so they are evicted (and dropped) first.
+    auto cost_it = table_refetch_costs_.find(get_table_key(key));
+    const double refetch_cost =
+        (cost_it == table_refetch_costs_.end() ? 1.0 : cost_it->second) *
+        (REFETCH_OVERHEAD_BYTES + entry.num_bytes);
+    entry.priority += entry.num_accesses * refetch_cost / entry.num_bytes;
+  }
+  eviction_queue_.emplace(entry.priority, key);
+}
+
+void CostAwareEvictionAlgorithm::eraseChunk(ChunkEntryMap::iterator it) {
+  const auto& [key, entry] = *it;
+  CHECK(eviction_queue_.erase({entry.priority, key}) > 0);
+  if (entry.num_bytes > 0) {
+    auto table_it = table_sizes_.find(get_table_key(key));
+    CHECK(table_it != table_sizes_.end());
+    CHECK_GE(table_it->second, entry.num_bytes);
+    table_it->second -= entry.num_bytes;
+    if (table_it->second == 0) {
+      table_sizes_.erase(table_it);
+    }
+  }
+  chunks_.erase(it);
+}
+
+ChunkKey CostAwareEvictionAlgorithm::getChunkToEvict() const {
+  if (table_size_limit_ > 0) {
+    for (const auto& [table_key, table_size] : table_sizes_) {
+      if (table_size <= table_size_limit_) {
+        continue;
+      }
+      // Keep a table over its limit from evicting the chunks of other tables.
+      for (const auto& [priority, key] : eviction_queue_) {
+        if (get_table_key(key) == table_key) {
+          return key;
+        }
+      }
+    }
+  }
+  return eviction_queue_.begin()->second;
+}
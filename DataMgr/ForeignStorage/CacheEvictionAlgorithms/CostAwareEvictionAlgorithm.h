@@ -0,0 +1,78 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file CostAwareEvictionAlgorithm.h
+ *
+ * This file includes the class specification for the cost aware cache eviction algorithm
+ * used by the Foreign Storage Interface (FSI).
+ *
+ * This is a Greedy-Dual-Size-Frequency algorithm. Every chunk has a priority of
+ * L + accesses * refetch cost / size, and the chunk with the lowest priority is evicted
+ * first. L is the priority of the last evicted chunk, so that chunks which are no longer
+ * used age out. The refetch cost of a chunk is a fixed request overhead plus its size,
+ * scaled by the refetch cost of its table (e.g. higher for tables on remote storage).
+ * Chunks of tables caching more than the per table size limit are evicted first.
+ */
+
+#pragma once
+
+#include <map>
+#include <set>
+#include "CacheEvictionAlgorithm.h"
+#include "Shared/mapd_shared_mutex.h"
+
+class CostAwareEvictionAlgorithm : public CacheEvictionAlgorithm {
+ public:
+  // A table size limit of 0 means unlimited.
+  CostAwareEvictionAlgorithm(const size_t table_size_limit = 0);
+  ~CostAwareEvictionAlgorithm() override {}
+  // Returns the next chunk to evict and evicts.
+  const ChunkKey evictNextChunk() override;
+  // Counts an access to this chunk.
+  void touchChunk(const ChunkKey&) override;
+  // Removes a chunk from the eviction queue if present.
+  void removeChunk(const ChunkKey&) override;
+  // Sets the number of bytes cached for a chunk in the eviction queue.
+  void setChunkSize(const ChunkKey&, const size_t num_bytes) override;
+  // Sets the refetch cost of the chunks of a table, relative to the default of 1.
+  void setTableRefetchCost(const ChunkKey& table_key, const double cost) override;
+  // Used for debugging.
+  std::string dumpEvictionQueue();
+
+  // Fixed cost of fetching a chunk, in bytes worth of reads.
+  static constexpr size_t REFETCH_OVERHEAD_BYTES{1024 * 1024};
+
+ private:
+  struct ChunkEntry {
+    size_t num_bytes{0};
+    size_t num_accesses{0};
+    double priority{0};
+  };
+  using ChunkEntryMap = std::map<const ChunkKey, ChunkEntry>;
+
+  void updatePriority(const ChunkKey& key, ChunkEntry& entry);
+  void eraseChunk(ChunkEntryMap::iterator it);
+  ChunkKey getChunkToEvict() const;
+
+  const size_t table_size_limit_;
+  double inflation_{0};
+  ChunkEntryMap chunks_;
+  std::set<std::pair<double, ChunkKey>> eviction_queue_;
+  std::map<const ChunkKey, size_t> table_sizes_;
+  std::map<const ChunkKey, double> table_refetch_costs_;
+  mutable mapd_shared_mutex cache_mutex_;
+};
@@ -27,6 +27,23 @@ namespace foreign_storage {
 
 namespace {
 constexpr int64_t MAX_REFRESH_TIME_IN_SECONDS = 60 * 60;
+// Approximate cost of refetching a chunk from S3 compared to fetching it from local disk.
+constexpr double S3_REFETCH_COST = 100.0;
+
+double get_refetch_cost(int32_t db_id, int32_t tb_id) {
+  auto catalog = Catalog_Namespace::SysCatalog::instance().getCatalog(db_id);
+  CHECK(catalog);
+  auto foreign_table = catalog->getForeignTableUnlocked(tb_id);
+  CHECK(foreign_table);
+  const auto& server_options = foreign_table->foreign_server->options;
+  auto storage_type_entry =
+      server_options.find(AbstractFileStorageDataWrapper::STORAGE_TYPE_KEY);
+  if (storage_type_entry != server_options.end() &&
+      storage_type_entry->second == AbstractFileStorageDataWrapper::S3_STORAGE_TYPE) {
+    return S3_REFETCH_COST;
+  }
+  return 1.0;
+}
 }  // namespace
 
 CachingForeignStorageMgr::CachingForeignStorageMgr(ForeignStorageCache* cache)
@@ -272,6 +289,7 @@ bool CachingForeignStorageMgr::createDataWrapperIfNotExists(const ChunkKey& chun
   }
   auto [db, tb] = get_table_prefix(chunk_key);
   createDataWrapperUnlocked(db, tb);
+  disk_cache_->setTableRefetchCost(db, tb, get_refetch_cost(db, tb));
   auto wrapper_file = disk_cache_->getSerializedWrapperPath(db, tb);
   if (boost::filesystem::exists(wrapper_file)) {
     ChunkMetadataVector chunk_metadata;
@@ -34,6 +34,8 @@
 #include "Shared/sqltypes.h"
 #include "Utils/DdlUtils.h"
 
+bool g_enable_csv_read_ahead{false};
+
 namespace foreign_storage {
 CsvDataWrapper::CsvDataWrapper() : db_id_(-1), foreign_table_(nullptr) {}
 
@@ -875,13 +877,20 @@ void CsvDataWrapper::populateChunkMetadata(ChunkMetadataVector& chunk_metadata_v
     }
 
     try {
-      dispatch_metadata_scan_requests(buffer_size,
-                                      file_path,
-                                      (*csv_reader_),
-                                      copy_params,
-                                      multi_threading_params,
-                                      num_rows_,
-                                      append_start_offset_);
+      std::unique_ptr<ReadAheadReader> read_ahead_reader;
+      if (g_enable_csv_read_ahead) {
+        // Reads ahead at most one buffer per scan thread.
+        read_ahead_reader = std::make_unique<ReadAheadReader>(
+            *csv_reader_, file_path, copy_params, buffer_size, thread_count);
+      }
+      dispatch_metadata_scan_requests(
+          buffer_size,
+          file_path,
+          read_ahead_reader ? *read_ahead_reader : *csv_reader_,
+          copy_params,
+          multi_threading_params,
+          num_rows_,
+          append_start_offset_);
     } catch (...) {
       {
         std::unique_lock<std::mutex> pending_requests_lock(
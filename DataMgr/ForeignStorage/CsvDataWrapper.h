@@ -28,6 +28,9 @@
 #include "ForeignDataWrapper.h"
 #include "ImportExport/Importer.h"
 
+// Reads CSV files on a separate thread during metadata scans.
+extern bool g_enable_csv_read_ahead;
+
 namespace foreign_storage {
 
 class CsvDataWrapper : public AbstractFileStorageDataWrapper {
@@ -693,4 +693,116 @@ size_t MultiFileReader::readRegion(void* buffer, size_t offset, size_t size) {
   return bytes_read;
 }
 
+ReadAheadReader::ReadAheadReader(CsvReader& reader,
+                                 const std::string& file_path,
+                                 const import_export::CopyParams& copy_params,
+                                 const size_t block_size,
+                                 const size_t max_blocks)
+    : CsvReader(file_path, copy_params)
+    , reader_(reader)
+    , block_size_(block_size)
+    , max_blocks_(max_blocks)
+    , remaining_size_known_(reader.isRemainingSizeKnown())
+    , remaining_size_(remaining_size_known_ ? reader.getRemainingSize() : 0)
+    , front_block_offset_(0)
+    , reader_finished_(reader.isScanFinished())
+    , stop_reading_(false) {
+  CHECK_GT(block_size_, size_t(1));
+  CHECK_GT(max_blocks_, size_t(0));
+  read_thread_ = std::thread(&ReadAheadReader::readBlocks, this);
+}
+
+ReadAheadReader::~ReadAheadReader() {
+  {
+    std::lock_guard<std::mutex> lock(blocks_mutex_);
+    stop_reading_ = true;
+  }
+  blocks_condition_.notify_all();
+  read_thread_.join();
+}
+
+void ReadAheadReader::readBlocks() {
+  try {
+    while (true) {
+      {
+        std::unique_lock<std::mutex> lock(blocks_mutex_);
+        blocks_condition_.wait(lock, [this] {
+          return blocks_.size() < max_blocks_ || stop_reading_;
+        });
+        if (stop_reading_ || reader_finished_) {
+          break;
+        }
+      }
+      std::vector<char> block(block_size_);
+      const auto bytes_read = reader_.read(block.data(), block.size());
+      block.resize(bytes_read);
+      {
+        std::lock_guard<std::mutex> lock(blocks_mutex_);
+        if (!block.empty()) {
+          blocks_.emplace_back(std::move(block));
+        }
+        reader_finished_ = reader_.isScanFinished();
+      }
+      blocks_condition_.notify_all();
+    }
+  } catch (...) {
+    {
+      std::lock_guard<std::mutex> lock(blocks_mutex_);
+      read_error_ = std::current_exception();
+      reader_finished_ = true;
+    }
+    blocks_condition_.notify_all();
+  }
+}
+
+size_t ReadAheadReader::read(void* buffer, size_t max_size) {
+  std::unique_lock<std::mutex> lock(blocks_mutex_);
+  blocks_condition_.wait(lock, [this] { return !blocks_.empty() || reader_finished_; });
+  if (blocks_.empty()) {
+    if (read_error_) {
+      std::rethrow_exception(read_error_);
+    }
+    return 0;
+  }
+  auto& block = blocks_.front();
+  const auto bytes_read = std::min(max_size, block.size() - front_block_offset_);
+  memcpy(buffer, block.data() + front_block_offset_, bytes_read);
+  front_block_offset_ += bytes_read;
+  if (remaining_size_known_) {
+    remaining_size_ -= std::min(remaining_size_, bytes_read);
+  }
+  if (front_block_offset_ == block.size()) {
+    blocks_.pop_front();
+    front_block_offset_ = 0;
+  }
+  lock.unlock();
+  blocks_condition_.notify_all();
+  return bytes_read;
+}
+
+bool ReadAheadReader::isScanFinished() {
+  std::lock_guard<std::mutex> lock(blocks_mutex_);
+  if (read_error_ && blocks_.empty()) {
+    std::rethrow_exception(read_error_);
+  }
+  return reader_finished_ && blocks_.empty();
+}
+
+size_t ReadAheadReader::readRegion(void* buffer, size_t offset, size_t size) {
+  CHECK(isScanFinished());
+  std::lock_guard<std::mutex> lock(blocks_mutex_);
+  return reader_.readRegion(buffer, offset, size);
+}
+
+size_t ReadAheadReader::getRemainingSize() {
+  // The wrapped reader is only accessed by the read thread while it runs.
+  std::lock_guard<std::mutex> lock(blocks_mutex_);
+  return remaining_size_;
+}
+
+void ReadAheadReader::serialize(rapidjson::Value& value,
+                                rapidjson::Document::AllocatorType& allocator) const {
+  reader_.serialize(value, allocator);
+}
+
 }  // namespace foreign_storage
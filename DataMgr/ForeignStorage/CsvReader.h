@@ -16,6 +16,13 @@
 
 #pragma once
 
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 #include <boost/filesystem.hpp>
 #include "rapidjson/document.h"
 
@@ -339,4 +346,55 @@ class LocalMultiFileReader : public MultiFileReader {
   void insertFile(std::string location);
 };
 
+/**
+ * Reads from another reader on a background thread, so that the reads, and the
+ * decompression of compressed files, overlap with the processing of the data already
+ * read. At most `max_blocks` blocks of `block_size` bytes are read ahead. Each call to
+ * read() returns data from a single block, so the wrapped reader's end of file
+ * handling is unchanged.
+ */
+class ReadAheadReader : public CsvReader {
+ public:
+  ReadAheadReader(CsvReader& reader,
+                  const std::string& file_path,
+                  const import_export::CopyParams& copy_params,
+                  const size_t block_size,
+                  const size_t max_blocks);
+  ~ReadAheadReader() override;
+
+  ReadAheadReader(const ReadAheadReader&) = delete;
+  ReadAheadReader& operator=(const ReadAheadReader&) = delete;
+
+  size_t read(void* buffer, size_t max_size) override;
+
+  bool isScanFinished() override;
+
+  size_t readRegion(void* buffer, size_t offset, size_t size) override;
+
+  size_t getRemainingSize() override;
+
+  bool isRemainingSizeKnown() override { return remaining_size_known_; }
+
+  void serialize(rapidjson::Value& value,
+                 rapidjson::Document::AllocatorType& allocator) const override;
+
+ private:
+  void readBlocks();
+
+  CsvReader& reader_;
+  const size_t block_size_;
+  const size_t max_blocks_;
+  const bool remaining_size_known_;
+  size_t remaining_size_;
+
+  std::mutex blocks_mutex_;
+  std::condition_variable blocks_condition_;
+  std::deque<std::vector<char>> blocks_;
+  size_t front_block_offset_;
+  bool reader_finished_;
+  bool stop_reading_;
+  std::exception_ptr read_error_;
+  std::thread read_thread_;
+};
+
 }  // namespace foreign_storage
@@ -25,6 +25,8 @@
 
 #pragma once
 
+#include <atomic>
+
 #include "../Shared/mapd_shared_mutex.h"
 #include "DataMgr/AbstractBufferMgr.h"
 #include "DataMgr/FileMgr/CachingFileMgr.h"
@@ -68,6 +70,9 @@ class ForeignStorageCache {
   inline size_t getNumCachedMetadata() const {
     return caching_file_mgr_->getNumChunksWithMetadata();
   }
+  inline std::set<ChunkKey> getCachedChunkKeys() const {
+    return caching_file_mgr_->getKeysWithMetadata();
+  }
 
   // Useful for debugging.
   std::string dumpCachedChunkEntries() const;
@@ -95,6 +100,21 @@ class ForeignStorageCache {
 
   void storeDataWrapper(const std::string& doc, int32_t db_id, int32_t tb_id);
 
+  inline void setTableRefetchCost(int32_t db_id, int32_t tb_id, double cost) {
+    caching_file_mgr_->setTableRefetchCost(db_id, tb_id, cost);
+  }
+
+  // Counts of the chunk fetches served, or missed, by the cache.
+  inline void recordChunkLookup(bool hit) {
+    (hit ? num_chunk_hits_ : num_chunk_misses_).fetch_add(1, std::memory_order_relaxed);
+  }
+  inline size_t getNumChunkHits() const {
+    return num_chunk_hits_.load(std::memory_order_relaxed);
+  }
+  inline size_t getNumChunkMisses() const {
+    return num_chunk_misses_.load(std::memory_order_relaxed);
+  }
+
  private:
   // These methods are private and assume locks are already acquired when called.
   std::set<ChunkKey>::iterator eraseChunk(const std::set<ChunkKey>::iterator&);
@@ -104,5 +124,8 @@ class ForeignStorageCache {
   // Underlying storage is handled by a CachingFileMgr unique to the cache.
   std::unique_ptr<File_Namespace::CachingFileMgr> caching_file_mgr_;
 
+  std::atomic<size_t> num_chunk_hits_{0};
+  std::atomic<size_t> num_chunk_misses_{0};
+
 };  // ForeignStorageCache
 }  // namespace foreign_storage
@@ -16,6 +16,10 @@
 
 #include "ForeignTableRefresh.h"
 
+#include <boost/filesystem.hpp>
+#include <boost/functional/hash.hpp>
+
+#include "AbstractFileStorageDataWrapper.h"
 #include "LockMgr/LockMgr.h"
 
 namespace foreign_storage {
@@ -68,4 +72,41 @@ void refresh_foreign_table(Catalog_Namespace::Catalog& catalog,
     throw e.getOriginalException();
   }
 }
+
+std::optional<size_t> get_foreign_table_files_signature(
+    const ForeignTable& foreign_table) {
+  auto storage_type = foreign_table.foreign_server->getOption(
+      AbstractFileStorageDataWrapper::STORAGE_TYPE_KEY);
+  if (!storage_type ||
+      *storage_type != AbstractFileStorageDataWrapper::LOCAL_FILE_STORAGE_TYPE) {
+    return std::nullopt;
+  }
+  const boost::filesystem::path path{
+      AbstractFileStorageDataWrapper::getFullFilePath(&foreign_table)};
+  boost::system::error_code ec;
+  size_t signature{0};
+  auto add_file = [&signature, &ec](const boost::filesystem::path& file_path) {
+    size_t file_hash{0};
+    boost::hash_combine(file_hash, file_path.string());
+    boost::hash_combine(file_hash, boost::filesystem::file_size(file_path, ec));
+    boost::hash_combine(file_hash, boost::filesystem::last_write_time(file_path, ec));
+    // Directory iteration order is unspecified, so combine the files commutatively.
+    signature += file_hash;
+  };
+  if (boost::filesystem::is_directory(path, ec)) {
+    for (boost::filesystem::recursive_directory_iterator it(path, ec), end;
+         !ec && it != end;
+         it.increment(ec)) {
+      if (boost::filesystem::is_regular_file(it->path(), ec)) {
+        add_file(it->path());
+      }
+    }
+  } else if (!ec) {
+    add_file(path);
+  }
+  if (ec) {
+    return std::nullopt;
+  }
+  return signature;
+}
 }  // namespace foreign_storage
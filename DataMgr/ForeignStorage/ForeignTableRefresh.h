@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <optional>
 #include <string>
 
 #include "Catalog/Catalog.h"
@@ -24,4 +25,12 @@ namespace foreign_storage {
 void refresh_foreign_table(Catalog_Namespace::Catalog& catalog,
                            const std::string& table_name,
                            const bool evict_cached_entries);
+
+/**
+ * Returns a signature of the paths, sizes and modification times of the files backing a
+ * foreign table, which changes whenever a file is added to or appended to. Returns
+ * std::nullopt for tables which are not backed by local files.
+ */
+std::optional<size_t> get_foreign_table_files_signature(
+    const ForeignTable& foreign_table);
 }  // namespace foreign_storage
@@ -38,6 +38,11 @@
 #include "ParquetTimestampEncoder.h"
 #include "ParquetVariableLengthArrayEncoder.h"
 
+#include <deque>
+#include <future>
+
+size_t g_parquet_row_group_read_ahead{0};
+
 namespace foreign_storage {
 
 namespace {
@@ -1386,6 +1391,103 @@ std::map<int, std::shared_ptr<ParquetEncoder>> populate_encoder_map(
   }
   return encoder_map;
 }
+
+// Levels and values of a row group column chunk, read in batches of at most
+// `batch_reader_num_elements` levels. The values of each batch get a region of
+// `batch_values_size` bytes, which the encoders may convert in place.
+struct DecodedRowGroup {
+  int row_group_index;
+  std::string column_path;
+  std::string file_path;
+  std::vector<int16_t> def_levels;
+  std::vector<int16_t> rep_levels;
+  std::vector<int8_t> values;
+  std::vector<std::pair<int64_t, int64_t>> batch_levels_and_values_read;
+};
+
+bool is_byte_array_column(const parquet::ColumnDescriptor* parquet_column) {
+  return parquet_column->physical_type() == parquet::Type::BYTE_ARRAY ||
+         parquet_column->physical_type() == parquet::Type::FIXED_LEN_BYTE_ARRAY;
+}
+
+DecodedRowGroup decode_row_group(parquet::ParquetFileReader* parquet_reader,
+                                 const int row_group_index,
+                                 const int parquet_column_index,
+                                 const parquet::ColumnDescriptor* parquet_column,
+                                 const size_t batch_values_size,
+                                 const std::string& file_path) {
+  // Byte array values point into the page buffers of the column reader, which are
+  // reused by the next batch, so only fixed width values can be decoded ahead.
+  CHECK(!is_byte_array_column(parquet_column));
+  const auto batch_size = LazyParquetChunkLoader::batch_reader_num_elements;
+  DecodedRowGroup row_group;
+  row_group.row_group_index = row_group_index;
+  row_group.column_path = parquet_column->path()->ToDotString();
+  row_group.file_path = file_path;
+  auto group_reader = parquet_reader->RowGroup(row_group_index);
+  std::shared_ptr<parquet::ColumnReader> col_reader =
+      group_reader->Column(parquet_column_index);
+  try {
+    while (col_reader->HasNext()) {
+      const auto levels_offset = row_group.def_levels.size();
+      const auto values_offset = row_group.values.size();
+      row_group.def_levels.resize(levels_offset + batch_size);
+      row_group.rep_levels.resize(levels_offset + batch_size);
+      row_group.values.resize(values_offset + batch_values_size);
+      int64_t values_read = 0;
+      int64_t levels_read =
+          parquet::ScanAllValues(batch_size,
+                                 row_group.def_levels.data() + levels_offset,
+                                 row_group.rep_levels.data() + levels_offset,
+                                 reinterpret_cast<uint8_t*>(row_group.values.data() +
+                                                            values_offset),
+                                 &values_read,
+                                 col_reader.get());
+      validate_definition_levels(parquet_reader,
+                                 row_group_index,
+                                 parquet_column_index,
+                                 row_group.def_levels.data() + levels_offset,
+                                 levels_read,
+                                 parquet_column);
+      row_group.def_levels.resize(levels_offset + levels_read);
+      row_group.rep_levels.resize(levels_offset + levels_read);
+      row_group.batch_levels_and_values_read.emplace_back(levels_read, values_read);
+    }
+  } catch (const std::exception& error) {
+    throw ForeignStorageException(
+        std::string(error.what()) + " Row group: " + std::to_string(row_group_index) +
+        ", Parquet column: '" + row_group.column_path + "', Parquet file: '" +
+        file_path + "'");
+  }
+  return row_group;
+}
+
+void append_decoded_row_group(DecodedRowGroup& row_group,
+                              const size_t batch_values_size,
+                              ParquetEncoder* encoder) {
+  size_t levels_offset{0};
+  size_t values_offset{0};
+  try {
+    for (const auto& [levels_read, values_read] :
+         row_group.batch_levels_and_values_read) {
+      encoder->appendData(row_group.def_levels.data() + levels_offset,
+                          row_group.rep_levels.data() + levels_offset,
+                          values_read,
+                          levels_read,
+                          row_group.values.data() + values_offset);
+      levels_offset += levels_read;
+      values_offset += batch_values_size;
+    }
+    if (auto array_encoder = dynamic_cast<ParquetArrayEncoder*>(encoder)) {
+      array_encoder->finalizeRowGroup();
+    }
+  } catch (const std::exception& error) {
+    throw ForeignStorageException(
+        std::string(error.what()) + " Row group: " +
+        std::to_string(row_group.row_group_index) + ", Parquet column: '" +
+        row_group.column_path + "', Parquet file: '" + row_group.file_path + "'");
+  }
+}
 }  // namespace
 
 std::list<std::unique_ptr<ChunkMetadata>> LazyParquetChunkLoader::appendRowGroups(
@@ -1417,6 +1519,17 @@ std::list<std::unique_ptr<ChunkMetadata>> LazyParquetChunkLoader::appendRowGroup
                                         chunk_metadata);
   CHECK(encoder.get());
 
+  // Row groups decoded by worker threads, appended to the encoder in order. At most
+  // `g_parquet_row_group_read_ahead` row groups are in flight, which bounds memory use.
+  const bool decode_ahead = g_parquet_row_group_read_ahead > 0 &&
+                            !is_byte_array_column(first_parquet_column_descriptor);
+  std::deque<std::future<DecodedRowGroup>> decoded_row_groups;
+  const auto append_next_decoded_row_group = [&]() {
+    auto row_group = decoded_row_groups.front().get();
+    decoded_row_groups.pop_front();
+    append_decoded_row_group(row_group, values.size(), encoder.get());
+  };
+
   for (const auto& row_group_interval : row_group_intervals) {
     const auto& file_path = row_group_interval.file_path;
     auto file_reader = file_reader_cache_->getOrInsert(file_path, file_system_);
@@ -1440,6 +1553,20 @@ std::list<std::unique_ptr<ChunkMetadata>> LazyParquetChunkLoader::appendRowGroup
     for (int row_group_index = row_group_interval.start_index;
          row_group_index <= row_group_interval.end_index;
          ++row_group_index) {
+      if (decode_ahead) {
+        if (decoded_row_groups.size() >= g_parquet_row_group_read_ahead) {
+          append_next_decoded_row_group();
+        }
+        decoded_row_groups.emplace_back(std::async(std::launch::async,
+                                                   decode_row_group,
+                                                   parquet_reader,
+                                                   row_group_index,
+                                                   parquet_column_index,
+                                                   parquet_column_descriptor,
+                                                   values.size(),
+                                                   file_path));
+        continue;
+      }
       auto group_reader = parquet_reader->RowGroup(row_group_index);
       std::shared_ptr<parquet::ColumnReader> col_reader =
           group_reader->Column(parquet_column_index);
@@ -1478,6 +1605,9 @@ std::list<std::unique_ptr<ChunkMetadata>> LazyParquetChunkLoader::appendRowGroup
       }
     }
   }
+  while (!decoded_row_groups.empty()) {
+    append_next_decoded_row_group();
+  }
   return chunk_metadata;
 }
 
@@ -26,6 +26,9 @@
 #include "ParquetShared.h"
 
 extern size_t g_max_import_threads;
+// Row groups of a column decoded ahead of the encoder by worker threads when loading a
+// chunk, 0 decodes them serially.
+extern size_t g_parquet_row_group_read_ahead;
 
 namespace foreign_storage {
 
@@ -28,6 +28,8 @@
 #include "Shared/misc.h"
 #include "Utils/DdlUtils.h"
 
+bool g_enable_parquet_row_group_zone_maps{false};
+
 namespace foreign_storage {
 
 namespace {
@@ -66,6 +68,43 @@ void reduce_metadata(std::shared_ptr<ChunkMetadata> reduce_to,
   encoder_to->getMetadata(updated_metadata);
   reduce_to->chunkStats = updated_metadata->chunkStats;
 }
+
+bool has_row_group_zone_maps(const SQLTypeInfo& type_info) {
+  return type_info.is_integer() || type_info.is_time();
+}
+
+int64_t get_row_group_stat(const Datum& datum, const SQLTypeInfo& type_info) {
+  switch (type_info.get_type()) {
+    case kTINYINT:
+      return datum.tinyintval;
+    case kSMALLINT:
+      return datum.smallintval;
+    case kINT:
+      return datum.intval;
+    case kBIGINT:
+    case kTIME:
+    case kTIMESTAMP:
+    case kDATE:
+      return datum.bigintval;
+    default:
+      UNREACHABLE();
+  }
+  return 0;
+}
+
+// Appends the stats of a row group ending at `end_row` of the fragment as the next zone
+// map block of a chunk.
+void add_row_group_zone_map_block(BlockZoneMaps& zone_maps,
+                                  const ChunkMetadata& row_group_metadata,
+                                  const size_t end_row) {
+  const auto& type_info = row_group_metadata.sqlType;
+  BlockStats block{get_row_group_stat(row_group_metadata.chunkStats.min, type_info),
+                   get_row_group_stat(row_group_metadata.chunkStats.max, type_info),
+                   row_group_metadata.chunkStats.has_nulls,
+                   nullptr};
+  zone_maps.blocks.emplace_back(block);
+  zone_maps.block_end_rows.emplace_back(end_row);
+}
 }  // namespace
 
 ParquetDataWrapper::ParquetDataWrapper() : db_id_(-1), foreign_table_(nullptr) {}
@@ -312,6 +351,8 @@ std::set<std::string> ParquetDataWrapper::getAllFilePaths() {
 void ParquetDataWrapper::metadataScanFiles(const std::set<std::string>& file_paths) {
   LazyParquetChunkLoader chunk_loader(file_system_, file_reader_cache_.get());
   auto row_group_metadata = chunk_loader.metadataScan(file_paths, *schema_);
+  // Each row group becomes a zone map block of the fragment chunks it is part of.
+  std::map<ChunkKey, std::shared_ptr<BlockZoneMaps>> row_group_zone_maps;
   auto column_interval =
       Interval<ColumnType>{schema_->getLogicalAndPhysicalColumns().front()->columnId,
                            schema_->getLogicalAndPhysicalColumns().back()->columnId};
@@ -345,7 +386,30 @@ void ParquetDataWrapper::metadataScanFiles(const std::set<std::string>& file_pat
         data_chunk_key.emplace_back(1);
       }
       std::shared_ptr<ChunkMetadata> chunk_metadata = *column_chunk_metadata_iter;
-      if (chunk_metadata_map_.find(data_chunk_key) == chunk_metadata_map_.end()) {
+      const bool is_new_chunk =
+          chunk_metadata_map_.find(data_chunk_key) == chunk_metadata_map_.end();
+      if (g_enable_parquet_row_group_zone_maps && !type_info.is_array() &&
+          has_row_group_zone_maps(type_info)) {
+        auto zone_maps_it = row_group_zone_maps.find(data_chunk_key);
+        if (zone_maps_it == row_group_zone_maps.end()) {
+          // A fragment continued from an earlier scan extends the zone maps of that
+          // scan, if there are any.
+          std::shared_ptr<BlockZoneMaps> zone_maps;
+          if (is_new_chunk) {
+            zone_maps = std::make_shared<BlockZoneMaps>();
+          } else if (const auto& previous_zone_maps =
+                         chunk_metadata_map_[data_chunk_key]->blockZoneMaps) {
+            zone_maps = std::make_shared<BlockZoneMaps>(*previous_zone_maps);
+          }
+          zone_maps_it = row_group_zone_maps.emplace(data_chunk_key, zone_maps).first;
+        }
+        if (zone_maps_it->second) {
+          add_row_group_zone_map_block(*zone_maps_it->second,
+                                       *chunk_metadata,
+                                       last_fragment_row_count_ + import_row_count);
+        }
+      }
+      if (is_new_chunk) {
         chunk_metadata_map_[data_chunk_key] = chunk_metadata;
       } else {
         reduce_metadata(chunk_metadata_map_[data_chunk_key], chunk_metadata);
@@ -355,6 +419,9 @@ void ParquetDataWrapper::metadataScanFiles(const std::set<std::string>& file_pat
     total_row_count_ += import_row_count;
   }
   finalizeFragmentMap();
+  for (const auto& [chunk_key, zone_maps] : row_group_zone_maps) {
+    shared::get_from_map(chunk_metadata_map_, chunk_key)->blockZoneMaps = zone_maps;
+  }
 }
 
 bool ParquetDataWrapper::moveToNextFragment(size_t new_rows_count) const {
@@ -30,6 +30,10 @@
 #include "Interval.h"
 #include "LazyParquetChunkLoader.h"
 
+// Keep the stats of each row group as zone maps of the fragment chunks, so filters skip
+// the row groups which cannot match.
+extern bool g_enable_parquet_row_group_zone_maps;
+
 namespace foreign_storage {
 
 class ParquetDataWrapper : public AbstractFileStorageDataWrapper {
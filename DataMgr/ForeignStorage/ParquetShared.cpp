@@ -20,8 +20,160 @@
 #include <parquet/exception.h>
 #include <parquet/platform.h>
 
+#include <atomic>
+#include <cstring>
+#include <future>
+
+size_t g_parquet_read_part_size{0};
+size_t g_parquet_max_concurrent_part_reads{8};
+
 namespace foreign_storage {
 
+ParallelReadFile::ParallelReadFile(std::shared_ptr<arrow::io::RandomAccessFile> file,
+                                   const size_t part_size,
+                                   const size_t max_concurrent_reads)
+    : file_(std::move(file))
+    , part_size_(part_size)
+    , max_concurrent_reads_(std::max(max_concurrent_reads, size_t(1))) {
+  CHECK(file_);
+  CHECK_GT(part_size_, 0);
+}
+
+arrow::Status ParallelReadFile::Close() {
+  return file_->Close();
+}
+
+bool ParallelReadFile::closed() const {
+  return file_->closed();
+}
+
+arrow::Result<int64_t> ParallelReadFile::Tell() const {
+  std::lock_guard<std::mutex> lock(position_mutex_);
+  return position_;
+}
+
+arrow::Status ParallelReadFile::Seek(int64_t position) {
+  if (position < 0) {
+    return arrow::Status::Invalid("Negative seek position: ", position);
+  }
+  std::lock_guard<std::mutex> lock(position_mutex_);
+  position_ = position;
+  return arrow::Status::OK();
+}
+
+arrow::Result<int64_t> ParallelReadFile::GetSize() {
+  return file_->GetSize();
+}
+
+arrow::Result<int64_t> ParallelReadFile::Read(int64_t nbytes, void* out) {
+  std::lock_guard<std::mutex> lock(position_mutex_);
+  ARROW_ASSIGN_OR_RAISE(auto bytes_read, ReadAt(position_, nbytes, out));
+  position_ += bytes_read;
+  return bytes_read;
+}
+
+arrow::Result<std::shared_ptr<arrow::Buffer>> ParallelReadFile::Read(int64_t nbytes) {
+  std::lock_guard<std::mutex> lock(position_mutex_);
+  ARROW_ASSIGN_OR_RAISE(auto buffer, ReadAt(position_, nbytes));
+  position_ += buffer->size();
+  return buffer;
+}
+
+arrow::Result<int64_t> ParallelReadFile::ReadAt(int64_t position,
+                                                int64_t nbytes,
+                                                void* out) {
+  if (nbytes >= part_size_) {
+    return readParts(position, nbytes, static_cast<uint8_t*>(out));
+  }
+  ARROW_ASSIGN_OR_RAISE(auto buffer, readAhead(position, nbytes));
+  std::memcpy(out, buffer->data(), buffer->size());
+  return buffer->size();
+}
+
+arrow::Result<std::shared_ptr<arrow::Buffer>> ParallelReadFile::ReadAt(int64_t position,
+                                                                       int64_t nbytes) {
+  if (nbytes < part_size_) {
+    return readAhead(position, nbytes);
+  }
+  ARROW_ASSIGN_OR_RAISE(auto buffer, arrow::AllocateResizableBuffer(nbytes));
+  ARROW_ASSIGN_OR_RAISE(auto bytes_read,
+                        readParts(position, nbytes, buffer->mutable_data()));
+  ARROW_RETURN_NOT_OK(buffer->Resize(bytes_read));
+  return std::shared_ptr<arrow::Buffer>(std::move(buffer));
+}
+
+std::shared_ptr<arrow::Buffer> ParallelReadFile::getReadAheadSlice(int64_t position,
+                                                                   int64_t nbytes) {
+  std::lock_guard<std::mutex> lock(read_ahead_mutex_);
+  if (!read_ahead_buffer_ || position < read_ahead_offset_) {
+    return nullptr;
+  }
+  const auto slice_offset = position - read_ahead_offset_;
+  const auto buffer_size = read_ahead_buffer_->size();
+  // A slice cut short by the end of the file is served, a slice cut short by the end of
+  // the part is not.
+  const bool ends_in_buffer = slice_offset + nbytes <= buffer_size;
+  const bool ends_at_file_end = buffer_size < part_size_ && slice_offset <= buffer_size;
+  if (!ends_in_buffer && !ends_at_file_end) {
+    return nullptr;
+  }
+  return arrow::SliceBuffer(
+      read_ahead_buffer_, slice_offset, std::min(nbytes, buffer_size - slice_offset));
+}
+
+arrow::Result<std::shared_ptr<arrow::Buffer>> ParallelReadFile::readAhead(
+    int64_t position,
+    int64_t nbytes) {
+  if (auto slice = getReadAheadSlice(position, nbytes)) {
+    return slice;
+  }
+  // The part is read without holding the lock, so reads of other columns of the file
+  // are not serialized behind it.
+  ARROW_ASSIGN_OR_RAISE(auto part, file_->ReadAt(position, part_size_));
+  {
+    std::lock_guard<std::mutex> lock(read_ahead_mutex_);
+    read_ahead_offset_ = position;
+    read_ahead_buffer_ = part;
+  }
+  return arrow::SliceBuffer(part, 0, std::min(nbytes, part->size()));
+}
+
+arrow::Result<int64_t> ParallelReadFile::readParts(int64_t position,
+                                                   int64_t nbytes,
+                                                   uint8_t* out) {
+  const size_t num_parts = (nbytes + part_size_ - 1) / part_size_;
+  std::vector<arrow::Result<int64_t>> part_results(num_parts,
+                                                 arrow::Result<int64_t>(int64_t(0)));
+  std::atomic<size_t> next_part{0};
+  const auto read_parts = [&]() {
+    for (auto part = next_part++; part < num_parts; part = next_part++) {
+      const int64_t part_offset = part * part_size_;
+      part_results[part] = file_->ReadAt(position + part_offset,
+                                         std::min(part_size_, nbytes - part_offset),
+                                         out + part_offset);
+    }
+  };
+  std::vector<std::future<void>> part_readers;
+  for (size_t i = 1; i < std::min(num_parts, max_concurrent_reads_); ++i) {
+    part_readers.emplace_back(std::async(std::launch::async, read_parts));
+  }
+  read_parts();
+  for (auto& part_reader : part_readers) {
+    part_reader.get();
+  }
+
+  // Parts after a short part are past the end of the file.
+  int64_t bytes_read = 0;
+  for (size_t part = 0; part < num_parts; ++part) {
+    ARROW_ASSIGN_OR_RAISE(auto part_bytes_read, part_results[part]);
+    bytes_read += part_bytes_read;
+    if (part_bytes_read < std::min(part_size_, nbytes - int64_t(part * part_size_))) {
+      break;
+    }
+  }
+  return bytes_read;
+}
+
 UniqueReaderPtr open_parquet_table(const std::string& file_path,
                                    std::shared_ptr<arrow::fs::FileSystem>& file_system) {
   UniqueReaderPtr reader;
@@ -30,7 +182,11 @@ UniqueReaderPtr open_parquet_table(const std::string& file_path,
     throw std::runtime_error{"Unable to access " + file_system->type_name() + " file: " +
                              file_path + ". " + file_result.status().message()};
   }
-  auto infile = file_result.ValueOrDie();
+  std::shared_ptr<arrow::io::RandomAccessFile> infile = file_result.ValueOrDie();
+  if (g_parquet_read_part_size > 0) {
+    infile = std::make_shared<ParallelReadFile>(
+        infile, g_parquet_read_part_size, g_parquet_max_concurrent_part_reads);
+  }
   PARQUET_THROW_NOT_OK(OpenFile(infile, arrow::default_memory_pool(), &reader));
   return reader;
 }
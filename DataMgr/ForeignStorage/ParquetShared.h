@@ -23,10 +23,18 @@
 #include <parquet/statistics.h>
 #include <parquet/types.h>
 
+#include <mutex>
+
 #include "Catalog/ColumnDescriptor.h"
 #include "DataMgr/ChunkMetadata.h"
 #include "Shared/mapd_shared_mutex.h"
 
+// Size of the parallel ranged reads of Parquet files, 0 reads them through the file
+// system's file directly.
+extern size_t g_parquet_read_part_size;
+// Ranged reads of a Parquet file in flight for a single read.
+extern size_t g_parquet_max_concurrent_part_reads;
+
 namespace foreign_storage {
 
 using UniqueReaderPtr = std::unique_ptr<parquet::arrow::FileReader>;
@@ -62,6 +70,50 @@ struct RowGroupMetadata {
   std::list<std::shared_ptr<ChunkMetadata>> column_chunk_metadata;
 };
 
+/**
+ * Reads a file opened by an Arrow file system in `part_size` ranges. Reads of more than
+ * a part, such as the reads of whole column chunks, are split into parts read
+ * concurrently, which is faster than a single sequential read on network and object
+ * storage. A read of less than a part reads the whole part starting at the read, and
+ * the following reads that fall inside it, such as those of the small column chunks
+ * next to each other in a row group, are served from memory.
+ */
+class ParallelReadFile : public arrow::io::RandomAccessFile {
+ public:
+  ParallelReadFile(std::shared_ptr<arrow::io::RandomAccessFile> file,
+                   const size_t part_size,
+                   const size_t max_concurrent_reads);
+
+  arrow::Status Close() override;
+  bool closed() const override;
+  arrow::Result<int64_t> Tell() const override;
+  arrow::Status Seek(int64_t position) override;
+  arrow::Result<int64_t> GetSize() override;
+
+  arrow::Result<int64_t> Read(int64_t nbytes, void* out) override;
+  arrow::Result<std::shared_ptr<arrow::Buffer>> Read(int64_t nbytes) override;
+  arrow::Result<int64_t> ReadAt(int64_t position, int64_t nbytes, void* out) override;
+  arrow::Result<std::shared_ptr<arrow::Buffer>> ReadAt(int64_t position,
+                                                        int64_t nbytes) override;
+
+ private:
+  std::shared_ptr<arrow::Buffer> getReadAheadSlice(int64_t position, int64_t nbytes);
+  arrow::Result<std::shared_ptr<arrow::Buffer>> readAhead(int64_t position,
+                                                          int64_t nbytes);
+  arrow::Result<int64_t> readParts(int64_t position, int64_t nbytes, uint8_t* out);
+
+  std::shared_ptr<arrow::io::RandomAccessFile> file_;
+  const int64_t part_size_;
+  const size_t max_concurrent_reads_;
+
+  mutable std::mutex position_mutex_;
+  int64_t position_{0};
+
+  std::mutex read_ahead_mutex_;
+  int64_t read_ahead_offset_{0};
+  std::shared_ptr<arrow::Buffer> read_ahead_buffer_;
+};
+
 UniqueReaderPtr open_parquet_table(const std::string& file_path,
                                    std::shared_ptr<arrow::fs::FileSystem>& file_system);
 
@@ -37,6 +37,9 @@ class NoneEncoder : public Encoder {
  public:
   NoneEncoder(Data_Namespace::AbstractBuffer* buffer) : Encoder(buffer) {
     resetChunkStats();
+    if (std::is_integral<T>::value) {
+      resetRowStats();
+    }
   }
 
   std::shared_ptr<ChunkMetadata> appendData(int8_t*& src_data,
@@ -46,6 +49,13 @@ class NoneEncoder : public Encoder {
                                             const int64_t offset = -1) override {
     if (offset == 0 && num_elems_to_append >= num_elems_) {
       resetChunkStats();
+      if (std::is_integral<T>::value) {
+        resetRowStats();
+      }
+    }
+    const size_t start_row = offset == -1 ? num_elems_ : static_cast<size_t>(offset);
+    if (offset == -1) {
+      beginRowStatsAppend(start_row);
     }
     T* unencodedData = reinterpret_cast<T*>(src_data);
     std::vector<T> encoded_data;
@@ -55,6 +65,9 @@ class NoneEncoder : public Encoder {
     for (size_t i = 0; i < num_elems_to_append; ++i) {
       size_t ri = replicating ? 0 : i;
       T data = validateDataAndUpdateStats(unencodedData[ri]);
+      if constexpr (std::is_integral<T>::value) {
+        updateRowStats(start_row + i, data, data == none_encoded_null_value<T>());
+      }
       if (replicating) {
         encoded_data[i] = data;
       }
@@ -93,6 +106,7 @@ class NoneEncoder : public Encoder {
 
   // Only called from the executor for synthesized meta-information.
   void updateStats(const int64_t val, const bool is_null) override {
+    invalidateRowStats();
     if (is_null) {
       has_nulls = true;
     } else {
@@ -104,6 +118,7 @@ class NoneEncoder : public Encoder {
 
   // Only called from the executor for synthesized meta-information.
   void updateStats(const double val, const bool is_null) override {
+    invalidateRowStats();
     if (is_null) {
       has_nulls = true;
     } else {
@@ -114,6 +129,7 @@ class NoneEncoder : public Encoder {
   }
 
   void updateStats(const int8_t* const src_data, const size_t num_elements) override {
+    invalidateRowStats();
     const T* unencoded_data = reinterpret_cast<const T*>(src_data);
     for (size_t i = 0; i < num_elements; ++i) {
       validateDataAndUpdateStats(unencoded_data[i]);
@@ -122,6 +138,7 @@ class NoneEncoder : public Encoder {
 
   void updateStatsEncoded(const int8_t* const dst_data,
                           const size_t num_elements) override {
+    invalidateRowStats();
     const T* data = reinterpret_cast<const T*>(dst_data);
 
     std::tie(dataMin, dataMax, has_nulls) = tbb::parallel_reduce(
@@ -188,6 +205,7 @@ class NoneEncoder : public Encoder {
   }
 
   bool resetChunkStats(const ChunkStats& stats) override {
+    invalidateRowStats();
     const auto new_min = DatumFetcher::getDatumVal<T>(stats.min);
     const auto new_max = DatumFetcher::getDatumVal<T>(stats.max);
 
@@ -210,6 +228,7 @@ class NoneEncoder : public Encoder {
   }
 
   void resetChunkStats() override {
+    invalidateRowStats();
     dataMin = std::numeric_limits<T>::max();
     dataMax = std::numeric_limits<T>::lowest();
     has_nulls = false;
@@ -16,6 +16,21 @@
 
 #include "MutableCachePersistentStorageMgr.h"
 
+namespace {
+
+// Chunks fetched while this many bytes already wait to be cached are not cached.
+constexpr size_t kMaxPendingCachePutBytes{1UL << 30};
+
+bool is_dirty_in_storage(File_Namespace::GlobalFileMgr* global_file_mgr,
+                         const ChunkKey& chunk_key) {
+  auto [db, tb] = get_table_prefix(chunk_key);
+  auto file_mgr = global_file_mgr->findFileMgr(db, tb);
+  return file_mgr && file_mgr->isBufferOnDevice(chunk_key) &&
+         file_mgr->getBuffer(chunk_key)->isDirty();
+}
+
+}  // namespace
+
 MutableCachePersistentStorageMgr::MutableCachePersistentStorageMgr(
     const std::string& data_dir,
     const size_t num_reader_threads,
@@ -23,6 +38,23 @@ MutableCachePersistentStorageMgr::MutableCachePersistentStorageMgr(
     : PersistentStorageMgr(data_dir, num_reader_threads, disk_cache_config) {
   CHECK(disk_cache_);
   CHECK(disk_cache_config_.isEnabledForMutableTables());
+  // The chunks cached before a restart have to be written through like the new ones.
+  // Foreign table chunks have no storage buffer and are never written through.
+  cached_chunk_keys_ = disk_cache_->getCachedChunkKeys();
+  if (disk_cache_config_.async_population) {
+    cache_population_thread_ = std::thread([this] { populateCache(); });
+  }
+}
+
+MutableCachePersistentStorageMgr::~MutableCachePersistentStorageMgr() {
+  if (cache_population_thread_.joinable()) {
+    {
+      std::lock_guard<std::mutex> lock(pending_cache_puts_mutex_);
+      stop_cache_population_ = true;
+    }
+    pending_cache_puts_cv_.notify_one();
+    cache_population_thread_.join();
+  }
 }
 
 AbstractBuffer* MutableCachePersistentStorageMgr::createBuffer(
@@ -31,6 +63,7 @@ AbstractBuffer* MutableCachePersistentStorageMgr::createBuffer(
     const size_t initial_size) {
   auto buf = PersistentStorageMgr::createBuffer(chunk_key, page_size, initial_size);
   if (isChunkPrefixCacheable(chunk_key)) {
+    std::lock_guard<std::mutex> write_lock(cache_write_mutex_);
     cached_chunk_keys_.emplace(chunk_key);
   }
   return buf;
@@ -41,6 +74,8 @@ void MutableCachePersistentStorageMgr::deleteBuffer(const ChunkKey& chunk_key,
   // No need to delete for FSI-only cache as Foreign Tables are immutable and we should
   // not be deleting buffers for them.
   CHECK(!isForeignStorage(chunk_key));
+  std::lock_guard<std::mutex> write_lock(cache_write_mutex_);
+  erasePendingCachePuts(chunk_key);
   disk_cache_->deleteBufferIfExists(chunk_key);
   cached_chunk_keys_.erase(chunk_key);
   PersistentStorageMgr::deleteBuffer(chunk_key, purge);
@@ -50,6 +85,8 @@ void MutableCachePersistentStorageMgr::deleteBuffersWithPrefix(
     const ChunkKey& chunk_key_prefix,
     const bool purge) {
   CHECK(has_table_prefix(chunk_key_prefix));
+  std::lock_guard<std::mutex> write_lock(cache_write_mutex_);
+  erasePendingCachePuts(chunk_key_prefix);
   disk_cache_->clearForTablePrefix(get_table_key(chunk_key_prefix));
 
   ChunkKey upper_prefix(chunk_key_prefix);
@@ -75,8 +112,128 @@ void MutableCachePersistentStorageMgr::fetchBuffer(const ChunkKey& chunk_key,
     // updated and the cached buffer will be out of date, so we need to fetch the storage
     // buffer.
     global_file_mgr_->fetchBuffer(chunk_key, destination_buffer, num_bytes);
-  } else {
+  } else if (!isChunkPrefixCacheable(chunk_key) || isForeignStorage(chunk_key)) {
     PersistentStorageMgr::fetchBuffer(chunk_key, destination_buffer, num_bytes);
+  } else if (auto buffer = disk_cache_->getCachedChunkIfExists(chunk_key)) {
+    disk_cache_->recordChunkLookup(true);
+    buffer->copyTo(destination_buffer, num_bytes);
+  } else {
+    disk_cache_->recordChunkLookup(false);
+    // A checkpoint of the table after this epoch may change the chunk before it is
+    // cached, the chunk is not cached then.
+    const auto table_epoch = disk_cache_config_.async_population
+                                 ? global_file_mgr_->getTableEpoch(db, tb)
+                                 : size_t(0);
+    global_file_mgr_->fetchBuffer(chunk_key, destination_buffer, num_bytes);
+    if (admitFetchedChunk(chunk_key)) {
+      cacheFetchedChunk(chunk_key, destination_buffer, num_bytes, table_epoch);
+    }
+  }
+}
+
+bool MutableCachePersistentStorageMgr::admitFetchedChunk(const ChunkKey& chunk_key) {
+  if (disk_cache_config_.admission_fetch_count <= 1) {
+    return true;
+  }
+  // Chunks scanned once, e.g. by an export or a full table rewrite, would otherwise
+  // evict the chunks scanned by every query.
+  std::lock_guard<std::mutex> lock(chunk_fetch_counts_mutex_);
+  auto& fetch_count = chunk_fetch_counts_[chunk_key];
+  if (++fetch_count < disk_cache_config_.admission_fetch_count) {
+    return false;
+  }
+  chunk_fetch_counts_.erase(chunk_key);
+  return true;
+}
+
+void MutableCachePersistentStorageMgr::cacheFetchedChunk(const ChunkKey& chunk_key,
+                                                         AbstractBuffer* buffer,
+                                                         const size_t num_bytes,
+                                                         const size_t table_epoch) {
+  if (!disk_cache_config_.async_population) {
+    std::lock_guard<std::mutex> write_lock(cache_write_mutex_);
+    disk_cache_->putBuffer(chunk_key, buffer, num_bytes);
+    cached_chunk_keys_.emplace(chunk_key);
+    return;
+  }
+  auto buffer_copy = std::make_unique<foreign_storage::ForeignStorageBuffer>();
+  buffer->copyTo(buffer_copy.get(), num_bytes);
+  {
+    std::lock_guard<std::mutex> lock(pending_cache_puts_mutex_);
+    if (pending_cache_put_bytes_ + buffer_copy->size() > kMaxPendingCachePutBytes) {
+      return;
+    }
+    pending_cache_put_bytes_ += buffer_copy->size();
+    pending_cache_puts_.push_back({chunk_key, std::move(buffer_copy), table_epoch});
+  }
+  pending_cache_puts_cv_.notify_one();
+}
+
+// Writes the fetched chunks to the disk cache and checkpoints their tables in the cache,
+// so they are still cached after a restart.
+void MutableCachePersistentStorageMgr::populateCache() {
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(pending_cache_puts_mutex_);
+      pending_cache_puts_cv_.wait(lock, [this] {
+        return stop_cache_population_ || !pending_cache_puts_.empty();
+      });
+      if (stop_cache_population_) {
+        return;
+      }
+    }
+    std::lock_guard<std::mutex> write_lock(cache_write_mutex_);
+    std::vector<PendingCachePut> cache_puts;
+    {
+      std::lock_guard<std::mutex> lock(pending_cache_puts_mutex_);
+      cache_puts.swap(pending_cache_puts_);
+      pending_cache_put_bytes_ = 0;
+    }
+    std::set<File_Namespace::TablePair> tables_to_checkpoint;
+    for (auto& cache_put : cache_puts) {
+      auto [db, tb] = get_table_prefix(cache_put.chunk_key);
+      if (global_file_mgr_->getTableEpoch(db, tb) != cache_put.table_epoch ||
+          disk_cache_->getCachedChunkIfExists(cache_put.chunk_key)) {
+        continue;
+      }
+      try {
+        disk_cache_->putBuffer(cache_put.chunk_key, cache_put.buffer.get());
+      } catch (const std::exception& e) {
+        LOG(WARNING) << "Failed to cache chunk " << show_chunk(cache_put.chunk_key)
+                     << ": " << e.what();
+        continue;
+      }
+      cached_chunk_keys_.emplace(cache_put.chunk_key);
+      tables_to_checkpoint.emplace(db, tb);
+    }
+    for (auto [db, tb] : tables_to_checkpoint) {
+      disk_cache_->checkpoint(db, tb);
+    }
+  }
+}
+
+// Expects cache_write_mutex_ to be held, so the chunks being cached are not erased.
+void MutableCachePersistentStorageMgr::erasePendingCachePuts(
+    const ChunkKey& chunk_key_prefix) {
+  std::lock_guard<std::mutex> lock(pending_cache_puts_mutex_);
+  auto erase_it = std::remove_if(
+      pending_cache_puts_.begin(),
+      pending_cache_puts_.end(),
+      [&chunk_key_prefix](const PendingCachePut& cache_put) {
+        return cache_put.chunk_key.size() >= chunk_key_prefix.size() &&
+               std::equal(chunk_key_prefix.begin(),
+                          chunk_key_prefix.end(),
+                          cache_put.chunk_key.begin());
+      });
+  for (auto it = erase_it; it != pending_cache_puts_.end(); ++it) {
+    pending_cache_put_bytes_ -= it->buffer->size();
+  }
+  pending_cache_puts_.erase(erase_it, pending_cache_puts_.end());
+  std::lock_guard<std::mutex> fetch_counts_lock(chunk_fetch_counts_mutex_);
+  for (auto it = chunk_fetch_counts_.lower_bound(chunk_key_prefix);
+       it != chunk_fetch_counts_.end() &&
+       std::equal(chunk_key_prefix.begin(), chunk_key_prefix.end(), it->first.begin());) {
+    it = chunk_fetch_counts_.erase(it);
   }
 }
 
@@ -84,14 +241,18 @@ AbstractBuffer* MutableCachePersistentStorageMgr::putBuffer(const ChunkKey& chun
                                                             AbstractBuffer* source_buffer,
                                                             const size_t num_bytes) {
   auto buf = PersistentStorageMgr::putBuffer(chunk_key, source_buffer, num_bytes);
+  std::lock_guard<std::mutex> write_lock(cache_write_mutex_);
   disk_cache_->putBuffer(chunk_key, source_buffer, num_bytes);
   return buf;
 }
 
 void MutableCachePersistentStorageMgr::checkpoint() {
+  // Held until the epochs of the tables are incremented, so the chunks fetched before
+  // this checkpoint are not cached over the ones written here.
+  std::lock_guard<std::mutex> write_lock(cache_write_mutex_);
   std::set<File_Namespace::TablePair> tables_to_checkpoint;
   for (auto& key : cached_chunk_keys_) {
-    if (global_file_mgr_->getBuffer(key)->isDirty()) {
+    if (is_dirty_in_storage(global_file_mgr_.get(), key)) {
       tables_to_checkpoint.emplace(get_table_prefix(key));
       foreign_storage::ForeignStorageBuffer temp_buf;
       global_file_mgr_->fetchBuffer(key, &temp_buf, 0);
@@ -105,6 +266,7 @@ void MutableCachePersistentStorageMgr::checkpoint() {
 }
 
 void MutableCachePersistentStorageMgr::checkpoint(const int db_id, const int tb_id) {
+  std::lock_guard<std::mutex> write_lock(cache_write_mutex_);
   bool need_checkpoint{false};
   ChunkKey chunk_prefix{db_id, tb_id};
   ChunkKey upper_prefix(chunk_prefix);
@@ -113,7 +275,7 @@ void MutableCachePersistentStorageMgr::checkpoint(const int db_id, const int tb_
   for (auto&& chunk_key_it = cached_chunk_keys_.lower_bound(chunk_prefix);
        chunk_key_it != end_it;
        ++chunk_key_it) {
-    if (global_file_mgr_->getBuffer(*chunk_key_it)->isDirty()) {
+    if (is_dirty_in_storage(global_file_mgr_.get(), *chunk_key_it)) {
       need_checkpoint = true;
       foreign_storage::ForeignStorageBuffer temp_buf;
       global_file_mgr_->fetchBuffer(*chunk_key_it, &temp_buf, 0);
@@ -128,8 +290,10 @@ void MutableCachePersistentStorageMgr::checkpoint(const int db_id, const int tb_
 
 void MutableCachePersistentStorageMgr::removeTableRelatedDS(const int db_id,
                                                             const int table_id) {
-  PersistentStorageMgr::removeTableRelatedDS(db_id, table_id);
+  std::lock_guard<std::mutex> write_lock(cache_write_mutex_);
   const ChunkKey table_key{db_id, table_id};
+  erasePendingCachePuts(table_key);
+  PersistentStorageMgr::removeTableRelatedDS(db_id, table_id);
   ChunkKey upper_prefix(table_key);
   upper_prefix.push_back(std::numeric_limits<int>::max());
   auto end_it = cached_chunk_keys_.upper_bound(static_cast<const ChunkKey>(upper_prefix));
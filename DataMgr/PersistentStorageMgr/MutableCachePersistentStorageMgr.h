@@ -16,6 +16,11 @@
 
 #pragma once
 
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "DataMgr/ForeignStorage/ForeignStorageBuffer.h"
 #include "PersistentStorageMgr.h"
 
 /*
@@ -27,6 +32,7 @@ class MutableCachePersistentStorageMgr : public PersistentStorageMgr {
       const std::string& data_dir,
       const size_t num_reader_threads,
       const File_Namespace::DiskCacheConfig& disk_cache_config);
+  ~MutableCachePersistentStorageMgr() override;
   AbstractBuffer* createBuffer(const ChunkKey& chunk_key,
                                const size_t page_size,
                                const size_t initial_size) override;
@@ -44,5 +50,34 @@ class MutableCachePersistentStorageMgr : public PersistentStorageMgr {
   void removeTableRelatedDS(const int db_id, const int table_id) override;
 
  private:
+  // A chunk fetched from storage, waiting to be written to the disk cache, with the
+  // checkpointed epoch of its table before the fetch.
+  struct PendingCachePut {
+    ChunkKey chunk_key;
+    std::unique_ptr<foreign_storage::ForeignStorageBuffer> buffer;
+    size_t table_epoch;
+  };
+
+  bool admitFetchedChunk(const ChunkKey& chunk_key);
+  void cacheFetchedChunk(const ChunkKey& chunk_key,
+                         AbstractBuffer* buffer,
+                         const size_t num_bytes,
+                         const size_t table_epoch);
+  void populateCache();
+  void erasePendingCachePuts(const ChunkKey& chunk_key_prefix);
+
+  // The chunks of the cache which are written through on checkpoints.
   std::set<ChunkKey> cached_chunk_keys_;
+  // Serializes the writes to the disk cache and to cached_chunk_keys_.
+  std::mutex cache_write_mutex_;
+
+  std::mutex chunk_fetch_counts_mutex_;
+  std::map<ChunkKey, size_t> chunk_fetch_counts_;
+
+  std::mutex pending_cache_puts_mutex_;
+  std::condition_variable pending_cache_puts_cv_;
+  std::vector<PendingCachePut> pending_cache_puts_;
+  size_t pending_cache_put_bytes_{0};
+  bool stop_cache_population_{false};
+  std::thread cache_population_thread_;
 };
@@ -81,6 +81,7 @@ void PersistentStorageMgr::fetchBuffer(const ChunkKey& chunk_key,
   AbstractBufferMgr* mgr = getStorageMgrForTableKey(chunk_key);
   if (isChunkPrefixCacheable(chunk_key)) {
     AbstractBuffer* buffer = disk_cache_->getCachedChunkIfExists(chunk_key);
+    disk_cache_->recordChunkLookup(buffer != nullptr);
     if (buffer) {
       buffer->copyTo(destination_buffer, num_bytes);
       return;
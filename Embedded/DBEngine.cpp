@@ -61,6 +61,14 @@ class CursorImpl : public Cursor {
     return Row();
   }
 
+  size_t getNextRowBatch(size_t max_rows, std::vector<ColumnBatch>& columns) {
+    if (result_set_) {
+      return result_set_->getNextRowBatch(max_rows, true, false, columns);
+    }
+    columns.clear();
+    return 0;
+  }
+
   ColumnType getColType(uint32_t col_num) {
     if (col_num < getColCount()) {
       SQLTypeInfo type_info = result_set_->getColType(col_num);
@@ -115,6 +123,37 @@ class DBEngineImpl : public DBEngine {
       parameters = boost::program_options::split_unix(cmd_line);
     }
 
+    // Take out the options of the engine itself, the rest are passed to DBHandler
+    namespace po = boost::program_options;
+    bool zero_copy_arrow_results{true};
+    po::options_description dbe_desc("DBEngine options");
+    dbe_desc.add_options()(
+        "zero-copy-arrow-results",
+        po::value<bool>(&zero_copy_arrow_results)
+            ->default_value(zero_copy_arrow_results)
+            ->implicit_value(true),
+        "Materialize the query results in columns, so that their Arrow record batches "
+        "share the result set buffers instead of copying them. Sets the defaults of "
+        "--enable-columnar-output and --enable-lazy-fetch.");
+    try {
+      const auto parsed = po::command_line_parser(parameters)
+                              .options(dbe_desc)
+                              .allow_unregistered()
+                              .run();
+      po::variables_map vm;
+      po::store(parsed, vm);
+      po::notify(vm);
+      parameters = po::collect_unrecognized(parsed.options, po::include_positional);
+    } catch (const po::error& e) {
+      throw std::runtime_error("DBE parameters parsing failed: " + std::string(e.what()));
+    }
+    if (zero_copy_arrow_results) {
+      // Given before the DBHandler options are parsed, so that --enable-columnar-output
+      // and --enable-lazy-fetch on the command line still override them
+      g_enable_columnar_output = true;
+      g_enable_lazy_fetch = false;
+    }
+
     // Generate command line to initialize CommandLineOptions for DBHandler
     const char* log_option = "omnisci_dbe";
     std::vector<const char*> cstrings;
@@ -474,6 +513,13 @@ std::shared_ptr<Cursor> DBEngine::executeRA(const std::string& query) {
   return engine->executeRA(query);
 }
 
+std::future<std::shared_ptr<Cursor>> DBEngine::executeDMLAsync(const std::string& query) {
+  DBEngineImpl* engine = getImpl(this);
+  return std::async(std::launch::async, [engine, query]() -> std::shared_ptr<Cursor> {
+    return engine->executeDML(query);
+  });
+}
+
 void DBEngine::importArrowTable(const std::string& name,
                                 std::shared_ptr<arrow::Table>& table,
                                 uint64_t fragment_size) {
@@ -530,6 +576,11 @@ Row Cursor::getNextRow() {
   return cursor->getNextRow();
 }
 
+size_t Cursor::getNextRowBatch(size_t max_rows, std::vector<ColumnBatch>& columns) {
+  CursorImpl* cursor = getImpl(this);
+  return cursor->getNextRowBatch(max_rows, columns);
+}
+
 ColumnType Cursor::getColType(uint32_t col_num) {
   CursorImpl* cursor = getImpl(this);
   return cursor->getColType(col_num);
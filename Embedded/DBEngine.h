@@ -17,6 +17,7 @@
 #pragma once
 
 #include <arrow/table.h>
+#include <future>
 #include "DBETypes.h"
 
 namespace EmbeddedDatabase {
@@ -27,6 +28,9 @@ class Cursor {
   size_t getColCount();
   size_t getRowCount();
   Row getNextRow();
+  // Fetches up to max_rows rows, one ColumnBatch per column. Returns the number of rows
+  // fetched, 0 once the cursor is exhausted.
+  size_t getNextRowBatch(size_t max_rows, std::vector<ColumnBatch>& columns);
   ColumnType getColType(uint32_t col_num);
   std::shared_ptr<arrow::RecordBatch> getArrowRecordBatch();
 
@@ -42,6 +46,10 @@ class DBEngine {
   void executeDDL(const std::string& query);
   std::shared_ptr<Cursor> executeDML(const std::string& query);
   std::shared_ptr<Cursor> executeRA(const std::string& query);
+  // Runs the query on a thread of its own. Queries submitted concurrently run in parallel
+  // on the executors of the dispatch queue (--num-executors), the engine must outlive the
+  // returned future.
+  std::future<std::shared_ptr<Cursor>> executeDMLAsync(const std::string& query);
   void importArrowTable(const std::string& name,
                         std::shared_ptr<arrow::Table>& table,
                         uint64_t fragment_size = 0);
@@ -50,8 +50,8 @@ cdef extern from "DBEngine.h" namespace 'EmbeddedDatabase':
 
     cdef cppclass DBEngine:
         void executeDDL(string) except +
-        shared_ptr[Cursor] executeDML(string) except +
-        shared_ptr[Cursor] executeRA(string) except +
+        shared_ptr[Cursor] executeDML(string) nogil except +
+        shared_ptr[Cursor] executeRA(string) nogil except +
         vector[string] getTables() except +
         vector[ColumnDetails] getTableDetails(string) except +
         void importArrowTable(string, shared_ptr[CTable]&, uint64_t) except +
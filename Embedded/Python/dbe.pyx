@@ -186,14 +186,23 @@ cdef class PyDbEngine:
 
     def executeDML(self, query):
         self.check_closed()
+        cdef string c_query = bytes(query, 'utf-8')
+        cdef shared_ptr[_Cursor] c_cursor
+        # Release the GIL so that queries of several Python threads run in parallel
+        with nogil:
+            c_cursor = self.c_dbe.get().executeDML(c_query)
         obj = PyCursor();
-        obj.c_cursor = self.c_dbe.get().executeDML(bytes(query, 'utf-8'));
+        obj.c_cursor = c_cursor
         return obj;
 
     def executeRA(self, query):
         self.check_closed()
+        cdef string c_query = bytes(query, 'utf-8')
+        cdef shared_ptr[_Cursor] c_cursor
+        with nogil:
+            c_cursor = self.c_dbe.get().executeRA(c_query)
         obj = PyCursor();
-        obj.c_cursor = self.c_dbe.get().executeRA(bytes(query, 'utf-8'));
+        obj.c_cursor = c_cursor
         return obj
 
     def importArrowTable(self, name, table, **kwargs):
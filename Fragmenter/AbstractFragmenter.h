@@ -225,6 +225,44 @@ class AbstractFragmenter {
   virtual const std::vector<uint64_t> getVacuumOffsets(
       const std::shared_ptr<Chunk_NS::Chunk>& chunk) = 0;
 
+  /**
+   * Sorts the rows of the given fragments together on the fixed width `cluster_cds` and
+   * writes them back in that order, the smallest keys to the first fragment id, so that
+   * the key ranges of the fragments no longer overlap. More than one column orders the
+   * rows on a Z-order curve over the columns. Fragments keep their row counts. Nulls
+   * sort last.
+   */
+  virtual void clusterRows(const Catalog_Namespace::Catalog* catalog,
+                           const TableDescriptor* td,
+                           const std::vector<int>& fragment_ids,
+                           const std::vector<const ColumnDescriptor*>& cluster_cds,
+                           const Data_Namespace::MemoryLevel memory_level,
+                           UpdelRoll& updel_roll) = 0;
+
+  /**
+   * Rewrites the ids of the dictionary encoded string column `cd` in the given fragment
+   * to `id_map[id]`, for a dictionary replaced by a compacted copy.
+   */
+  virtual void remapDictionaryIds(const Catalog_Namespace::Catalog* catalog,
+                                  const TableDescriptor* td,
+                                  const ColumnDescriptor* cd,
+                                  const int fragment_id,
+                                  const std::vector<int32_t>& id_map,
+                                  const Data_Namespace::MemoryLevel memory_level,
+                                  UpdelRoll& updel_roll) = 0;
+
+  /**
+   * Rewrites the ids of the dictionary encoded string column `cd` in the given fragment,
+   * stored at the width of `old_type`, at the wider width of the column type.
+   */
+  virtual void widenDictionaryIds(const Catalog_Namespace::Catalog* catalog,
+                                  const TableDescriptor* td,
+                                  const ColumnDescriptor* cd,
+                                  const int fragment_id,
+                                  const SQLTypeInfo& old_type,
+                                  const Data_Namespace::MemoryLevel memory_level,
+                                  UpdelRoll& updel_roll) = 0;
+
   virtual void dropColumns(const std::vector<int>& columnIds) = 0;
 
   //! Iterates through chunk metadata to return whether any rows have been deleted.
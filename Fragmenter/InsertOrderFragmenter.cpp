@@ -20,18 +20,24 @@
 #include <boost/lexical_cast.hpp>
 #include <cassert>
 #include <cmath>
+#include <future>
 #include <iostream>
 #include <limits>
 #include <memory>
+#include <numeric>
 #include <thread>
 #include <type_traits>
 
+#include "Catalog/Catalog.h"
 #include "DataMgr/AbstractBuffer.h"
 #include "DataMgr/DataMgr.h"
 #include "DataMgr/FileMgr/GlobalFileMgr.h"
+#include "Fragmenter/SortedOrderFragmenter.h"
 #include "LockMgr/LockMgr.h"
 #include "Logger/Logger.h"
 
+#include "Shared/InlineNullValues.h"
+#include "Shared/SqlTypesLayout.h"
 #include "Shared/checked_alloc.h"
 #include "Shared/thread_count.h"
 
@@ -43,11 +49,49 @@ using Data_Namespace::AbstractBuffer;
 using Data_Namespace::DataMgr;
 
 bool g_use_table_device_offset{true};
+bool g_enable_parallel_column_inserts{true};
+bool g_enable_replicated_add_column_defaults{false};
 
 using namespace std;
 
 namespace Fragmenter_Namespace {
 
+namespace {
+
+// Column values appended per insert batch below which the columns are appended in
+// sequence, since the appends would not outweigh the thread launches.
+constexpr size_t parallel_column_insert_min_values{100000};
+
+// Rows with a null partition column get a partition of their own, never expired.
+constexpr int64_t null_partition_key{std::numeric_limits<int64_t>::min()};
+
+int64_t get_partition_key(const int64_t value, const int64_t interval) {
+  if (value == inline_int_null_value<int64_t>()) {
+    return null_partition_key;
+  }
+  // rounds down, also for times before the epoch
+  return value / interval - (value % interval < 0 ? 1 : 0);
+}
+
+std::optional<int64_t> get_fragment_partition_key(
+    const ChunkMetadataMap& chunk_metadata_map,
+    const int column_id,
+    const int64_t interval) {
+  const auto chunk_metadata_it = chunk_metadata_map.find(column_id);
+  if (chunk_metadata_it == chunk_metadata_map.end() ||
+      !chunk_metadata_it->second->numElements) {
+    return std::nullopt;
+  }
+  const auto& stats = chunk_metadata_it->second->chunkStats;
+  if (stats.min.bigintval > stats.max.bigintval) {
+    // only nulls
+    return null_partition_key;
+  }
+  return get_partition_key(stats.min.bigintval, interval);
+}
+
+}  // namespace
+
 InsertOrderFragmenter::InsertOrderFragmenter(
     const vector<int> chunkKeyPrefix,
     vector<Chunk>& chunkVec,
@@ -232,6 +276,124 @@ void InsertOrderFragmenter::dropFragmentsToSizeNoInsertLock(const size_t max_row
   }
 }
 
+std::optional<InsertOrderFragmenter::TablePartitioning>
+InsertOrderFragmenter::getTablePartitioning() const {
+  if (!catalog_) {
+    return std::nullopt;
+  }
+  const auto td = catalog_->getMetadataForTable(physicalTableId_, false);
+  if (!td || td->partitionColumnId <= 0) {
+    return std::nullopt;
+  }
+  const auto cd = catalog_->getMetadataForColumn(physicalTableId_, td->partitionColumnId);
+  CHECK(cd);
+  CHECK_GT(td->partitionIntervalSeconds, 0);
+  auto interval = td->partitionIntervalSeconds;
+  if (cd->columnType.get_type() == kTIMESTAMP) {
+    interval *= static_cast<int64_t>(exp_to_scale(cd->columnType.get_dimension()));
+  }
+  return TablePartitioning{td->partitionColumnId, interval, td->partitionRetention};
+}
+
+std::vector<int64_t> InsertOrderFragmenter::groupRowsByPartition(
+    InsertData& insert_data,
+    const TablePartitioning& partitioning) const {
+  const auto column_it = std::find(insert_data.columnIds.begin(),
+                                   insert_data.columnIds.end(),
+                                   partitioning.column_id);
+  if (column_it == insert_data.columnIds.end()) {
+    return std::vector<int64_t>(insert_data.numRows, null_partition_key);
+  }
+  const size_t partition_insert_id = column_it - insert_data.columnIds.begin();
+  const auto values =
+      reinterpret_cast<const int64_t*>(insert_data.data[partition_insert_id].numbersPtr);
+  if (insert_data.is_default[partition_insert_id]) {
+    return std::vector<int64_t>(insert_data.numRows,
+                                get_partition_key(values[0], partitioning.interval));
+  }
+  std::vector<int64_t> partition_keys(insert_data.numRows);
+  for (size_t i = 0; i < insert_data.numRows; ++i) {
+    partition_keys[i] = get_partition_key(values[i], partitioning.interval);
+  }
+  if (std::is_sorted(partition_keys.begin(), partition_keys.end())) {
+    return partition_keys;
+  }
+  // Keep the insert order of the rows within a partition.
+  std::vector<size_t> indexes(insert_data.numRows);
+  std::iota(indexes.begin(), indexes.end(), 0);
+  std::stable_sort(indexes.begin(), indexes.end(), [&](const auto a, const auto b) {
+    return partition_keys[a] < partition_keys[b];
+  });
+  for (size_t i = 0; i < insert_data.columnIds.size(); ++i) {
+    if (insert_data.is_default[i]) {
+      continue;
+    }
+    const auto cd = columnMap_.at(insert_data.columnIds[i]).getColumnDesc();
+    shuffleByIndexes(cd, indexes, insert_data.data[i]);
+  }
+  std::vector<int64_t> sorted_partition_keys(insert_data.numRows);
+  for (size_t i = 0; i < insert_data.numRows; ++i) {
+    sorted_partition_keys[i] = partition_keys[indexes[i]];
+  }
+  return sorted_partition_keys;
+}
+
+void InsertOrderFragmenter::dropExpiredPartitionsNoInsertLock(
+    const TablePartitioning& partitioning) {
+  // not safe to call from outside insertData, see dropFragmentsToSizeNoInsertLock()
+  if (partitioning.retention <= 0) {
+    return;
+  }
+  std::optional<int64_t> newest_partition_key;
+  for (const auto& fragment : fragmentInfoVec_) {
+    const auto partition_key =
+        get_fragment_partition_key(fragment->getChunkMetadataMapPhysical(),
+                                   partitioning.column_id,
+                                   partitioning.interval);
+    if (partition_key && *partition_key != null_partition_key) {
+      newest_partition_key = std::max(newest_partition_key.value_or(*partition_key),
+                                      *partition_key);
+    }
+  }
+  if (!newest_partition_key) {
+    return;
+  }
+  const int64_t oldest_kept_partition_key =
+      *newest_partition_key - (partitioning.retention - 1);
+
+  const size_t pre_num_tuples = numTuples_;
+  vector<int> drop_frag_ids;
+  {
+    mapd_unique_lock<mapd_shared_mutex> write_lock(fragmentInfoMutex_);
+    // don't ever drop the last fragment, it holds the insert buffers
+    for (auto fragment_it = fragmentInfoVec_.begin();
+         fragment_it + 1 < fragmentInfoVec_.end();) {
+      const auto& fragment = *fragment_it;
+      const auto partition_key =
+          get_fragment_partition_key(fragment->getChunkMetadataMapPhysical(),
+                                     partitioning.column_id,
+                                     partitioning.interval);
+      if (partition_key && *partition_key != null_partition_key &&
+          *partition_key < oldest_kept_partition_key) {
+        const auto num_frag_tuples = fragment->getPhysicalNumTuples();
+        drop_frag_ids.push_back(fragment->fragmentId);
+        fragment_it = fragmentInfoVec_.erase(fragment_it);
+        CHECK_GE(numTuples_, num_frag_tuples);
+        numTuples_ -= num_frag_tuples;
+      } else {
+        ++fragment_it;
+      }
+    }
+  }
+  if (drop_frag_ids.empty()) {
+    return;
+  }
+  deleteFragments(drop_frag_ids);
+  LOG(INFO) << "dropExpiredPartitions, dropped " << drop_frag_ids.size()
+            << " fragments of table " << physicalTableId_
+            << ", numTuples pre: " << pre_num_tuples << " post: " << numTuples_;
+}
+
 void InsertOrderFragmenter::deleteFragments(const vector<int>& dropFragIds) {
   // Fix a verified loophole on sharded logical table which is locked using logical
   // tableId while it's its physical tables that can come here when fragments overflow
@@ -493,7 +655,19 @@ void InsertOrderFragmenter::addColumns(const InsertData& insertDataStruct) {
                                      "' wider than existing columns is not supported");
           }
 
-          auto chunkMetadata = chunk.appendData(dataCopy, numRowsToInsert, 0, true);
+          std::shared_ptr<ChunkMetadata> chunkMetadata;
+          // The chunks of the last fragment stay complete, as inserts append to them.
+          if (g_enable_replicated_add_column_defaults && numRowsToInsert > 1 &&
+              fragmentInfo != fragmentInfoVec_.back() &&
+              Chunk_NS::Chunk::isReplicatedValueType(colDesc->columnType)) {
+            // Store the default value once, it is replicated over the rows when read.
+            chunkMetadata = chunk.appendData(dataCopy, 1, 0, true);
+            auto encoder = chunk.getBuffer()->getEncoder();
+            encoder->setReplicatedNumElems(numRowsToInsert);
+            encoder->getMetadata(chunkMetadata);
+          } else {
+            chunkMetadata = chunk.appendData(dataCopy, numRowsToInsert, 0, true);
+          }
           fragmentInfo->shadowChunkMetadataMap[columnId] = chunkMetadata;
 
           // update total size of var-len column in (actually the last) fragment
@@ -581,6 +755,13 @@ void InsertOrderFragmenter::insertDataImpl(InsertData& insert_data) {
     }
   }
   CHECK(insert_data.is_default.size() == insert_data.columnIds.size());
+  // Every fragment of a partitioned table holds the rows of a single partition, so that
+  // the fragment skipping on the chunk stats prunes whole partitions.
+  const auto partitioning = getTablePartitioning();
+  std::vector<int64_t> partition_keys;
+  if (partitioning) {
+    partition_keys = groupRowsByPartition(insert_data, *partitioning);
+  }
   std::unordered_map<int, int> inverseInsertDataColIdMap;
   for (size_t insertId = 0; insertId < insert_data.columnIds.size(); ++insertId) {
     inverseInsertDataColIdMap.insert(
@@ -632,6 +813,13 @@ void InsertOrderFragmenter::insertDataImpl(InsertData& insert_data) {
         }
       }
     }
+    if (partitioning && currentFragment->shadowNumTuples > 0 &&
+        get_fragment_partition_key(currentFragment->shadowChunkMetadataMap,
+                                   partitioning->column_id,
+                                   partitioning->interval) !=
+            partition_keys[numRowsInserted]) {
+      numRowsToInsert = 0;  // start a fragment for the next partition
+    }
 
     if (rowsLeftInCurrentFragment == 0 || numRowsToInsert == 0) {
       currentFragment = createNewFragment(defaultInsertLevel_);
@@ -659,21 +847,63 @@ void InsertOrderFragmenter::insertDataImpl(InsertData& insert_data) {
         }
       }
     }
+    if (partitioning) {
+      const auto partition_begin = partition_keys.begin() + numRowsInserted;
+      const auto partition_end = std::upper_bound(
+          partition_begin, partition_keys.begin() + numRowsInserted + numRowsToInsert,
+          *partition_begin);
+      numRowsToInsert = partition_end - partition_begin;
+    }
 
     CHECK_GT(numRowsToInsert, size_t(0));  // would put us into an endless loop as we'd
                                            // never be able to insert anything
 
+    // for each column, append the data in the appropriate insert buffer
+    const auto num_columns = insert_data.columnIds.size();
+    std::vector<std::shared_ptr<ChunkMetadata>> chunk_metadata(num_columns);
+    std::shared_ptr<ChunkMetadata> row_id_chunk_metadata;
     {
-      mapd_unique_lock<mapd_shared_mutex> writeLock(fragmentInfoMutex_);
-      // for each column, append the data in the appropriate insert buffer
-      for (size_t i = 0; i < insert_data.columnIds.size(); ++i) {
-        int columnId = insert_data.columnIds[i];
-        auto colMapIt = columnMap_.find(columnId);
+      // The appends only take a shared lock on the fragment infos, so that queries keep
+      // taking snapshots of the fragments with getFragmentsForQuery() while rows are
+      // appended, while the writers of the fragment infos and chunks still wait. Queries
+      // do not see the appended rows until the new row counts and metadata are
+      // published below.
+      mapd_shared_lock<mapd_shared_mutex> append_lock(fragmentInfoMutex_);
+      auto append_column = [&](const size_t i) {
+        auto colMapIt = columnMap_.find(insert_data.columnIds[i]);
         CHECK(colMapIt != columnMap_.end());
-        currentFragment->shadowChunkMetadataMap[columnId] = colMapIt->second.appendData(
+        chunk_metadata[i] = colMapIt->second.appendData(
             dataCopy[i], numRowsToInsert, numRowsInserted, insert_data.is_default[i]);
-        auto varLenColInfoIt = varLenColInfo_.find(columnId);
+      };
+      const size_t num_worker_threads =
+          std::min(num_columns, static_cast<size_t>(cpu_threads()));
+      if (g_enable_parallel_column_inserts && num_worker_threads > 1 &&
+          numRowsToInsert * num_columns >= parallel_column_insert_min_values) {
+        // Every column has its own chunk buffer and encoder, and the buffer managers
+        // serialize the page allocations of the appends.
+        std::vector<std::future<void>> worker_threads;
+        for (size_t thread_idx = 0; thread_idx < num_worker_threads; ++thread_idx) {
+          worker_threads.push_back(std::async(std::launch::async, [&, thread_idx]() {
+            for (size_t i = thread_idx; i < num_columns; i += num_worker_threads) {
+              append_column(i);
+            }
+          }));
+        }
+        for (auto& child : worker_threads) {
+          child.wait();
+        }
+        for (auto& child : worker_threads) {
+          child.get();
+        }
+      } else {
+        for (size_t i = 0; i < num_columns; ++i) {
+          append_column(i);
+        }
+      }
+      for (size_t i = 0; i < num_columns; ++i) {
+        auto varLenColInfoIt = varLenColInfo_.find(insert_data.columnIds[i]);
         if (varLenColInfoIt != varLenColInfo_.end()) {
+          auto colMapIt = columnMap_.find(insert_data.columnIds[i]);
           varLenColInfoIt->second = colMapIt->second.getBuffer()->size();
         }
       }
@@ -687,10 +917,20 @@ void InsertOrderFragmenter::insertDataImpl(InsertData& insert_data) {
         DataBlockPtr rowIdBlock;
         rowIdBlock.numbersPtr = reinterpret_cast<int8_t*>(row_id_data.get());
         auto colMapIt = columnMap_.find(rowIdColId_);
-        currentFragment->shadowChunkMetadataMap[rowIdColId_] =
+        row_id_chunk_metadata =
             colMapIt->second.appendData(rowIdBlock, numRowsToInsert, numRowsInserted);
       }
+    }
 
+    {
+      mapd_unique_lock<mapd_shared_mutex> writeLock(fragmentInfoMutex_);
+      for (size_t i = 0; i < num_columns; ++i) {
+        currentFragment->shadowChunkMetadataMap[insert_data.columnIds[i]] =
+            chunk_metadata[i];
+      }
+      if (row_id_chunk_metadata) {
+        currentFragment->shadowChunkMetadataMap[rowIdColId_] = row_id_chunk_metadata;
+      }
       currentFragment->shadowNumTuples =
           fragmentInfoVec_.back()->getPhysicalNumTuples() + numRowsToInsert;
       numRowsLeft -= numRowsToInsert;
@@ -706,6 +946,9 @@ void InsertOrderFragmenter::insertDataImpl(InsertData& insert_data) {
   }
   numTuples_ += insert_data.numRows;
   dropFragmentsToSizeNoInsertLock(maxRows_);
+  if (partitioning) {
+    dropExpiredPartitionsNoInsertLock(*partitioning);
+  }
 }
 
 FragmentInfo* InsertOrderFragmenter::createNewFragment(
@@ -796,6 +1039,8 @@ TableInfo InsertOrderFragmenter::getFragmentsForQuery() {
 }
 
 void InsertOrderFragmenter::resetSizesFromFragments() {
+  // Inserts append to the insert buffers under a shared fragment info lock only.
+  mapd_unique_lock<mapd_shared_mutex> insert_lock(insertMutex_);
   mapd_shared_lock<mapd_shared_mutex> read_lock(fragmentInfoMutex_);
   numTuples_ = 0;
   for (const auto& fragment_info : fragmentInfoVec_) {
@@ -23,6 +23,7 @@
 
 #include <map>
 #include <mutex>
+#include <optional>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -35,6 +36,10 @@
 #include "Shared/mapd_shared_mutex.h"
 #include "Shared/types.h"
 
+// Append the columns of large insert batches to their chunks on several threads.
+extern bool g_enable_parallel_column_inserts;
+extern bool g_enable_replicated_add_column_defaults;
+
 class Executor;
 
 namespace Data_Namespace {
@@ -166,6 +171,29 @@ class InsertOrderFragmenter : public AbstractFragmenter {
   const std::vector<uint64_t> getVacuumOffsets(
       const std::shared_ptr<Chunk_NS::Chunk>& chunk) override;
 
+  void clusterRows(const Catalog_Namespace::Catalog* catalog,
+                   const TableDescriptor* td,
+                   const std::vector<int>& fragment_ids,
+                   const std::vector<const ColumnDescriptor*>& cluster_cds,
+                   const Data_Namespace::MemoryLevel memory_level,
+                   UpdelRoll& updel_roll) override;
+
+  void remapDictionaryIds(const Catalog_Namespace::Catalog* catalog,
+                          const TableDescriptor* td,
+                          const ColumnDescriptor* cd,
+                          const int fragment_id,
+                          const std::vector<int32_t>& id_map,
+                          const Data_Namespace::MemoryLevel memory_level,
+                          UpdelRoll& updel_roll) override;
+
+  void widenDictionaryIds(const Catalog_Namespace::Catalog* catalog,
+                          const TableDescriptor* td,
+                          const ColumnDescriptor* cd,
+                          const int fragment_id,
+                          const SQLTypeInfo& old_type,
+                          const Data_Namespace::MemoryLevel memory_level,
+                          UpdelRoll& updel_roll) override;
+
   auto getChunksForAllColumns(const TableDescriptor* td,
                               const FragmentInfo& fragment,
                               const Data_Namespace::MemoryLevel memory_level);
@@ -240,9 +268,28 @@ class InsertOrderFragmenter : public AbstractFragmenter {
                           const std::shared_ptr<Chunk_NS::Chunk>& chunk,
                           const std::vector<uint64_t>& frag_offsets);
 
+  // Updates the chunk metadata of a fragment whose rows were compacted or reordered.
+  void updateRewrittenColumnsMetadata(
+      FragmentInfo& fragment,
+      const std::vector<std::shared_ptr<Chunk_NS::Chunk>>& chunks,
+      std::vector<ChunkUpdateStats>& update_stats_per_column,
+      UpdelRoll& updel_roll);
+
  private:
+  // PARTITION_COLUMN of the table, whose fragments each hold the rows of one interval.
+  struct TablePartitioning {
+    int column_id;
+    int64_t interval;  // in the units of the column values
+    int32_t retention;
+  };
+
   bool isAddingNewColumns(const InsertData& insert_data) const;
   void dropFragmentsToSizeNoInsertLock(const size_t max_rows);
+  std::optional<TablePartitioning> getTablePartitioning() const;
+  // Groups the rows of the insert by partition, returns the partition of each row.
+  std::vector<int64_t> groupRowsByPartition(InsertData& insert_data,
+                                            const TablePartitioning& partitioning) const;
+  void dropExpiredPartitionsNoInsertLock(const TablePartitioning& partitioning);
   void setLastFragmentVarLenColumnSizes();
 };
 
@@ -19,6 +19,10 @@
 
 namespace Fragmenter_Namespace {
 
+void shuffleByIndexes(const ColumnDescriptor* cd,
+                      const std::vector<size_t>& indexes,
+                      DataBlockPtr& data);
+
 class SortedOrderFragmenter : public InsertOrderFragmenter {
  public:
   SortedOrderFragmenter(
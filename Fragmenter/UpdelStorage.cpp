@@ -15,6 +15,7 @@
  */
 #include <algorithm>
 #include <mutex>
+#include <numeric>
 #include <string>
 #include <vector>
 
@@ -640,9 +641,8 @@ std::optional<ChunkUpdateStats> InsertOrderFragmenter::updateColumn(
     const SQLTypeInfo& rhs_type,
     const Data_Namespace::MemoryLevel memory_level,
     UpdelRoll& updel_roll) {
-  updel_roll.catalog = catalog;
-  updel_roll.logicalTableId = catalog->getLogicalTableId(td->tableId);
-  updel_roll.memoryLevel = memory_level;
+  updel_roll.setUpdatedTable(
+      catalog, catalog->getLogicalTableId(td->tableId), memory_level);
 
   const size_t ncore = cpu_threads();
   const auto nrow = frag_offsets.size();
@@ -1056,6 +1056,37 @@ static void set_chunk_stats(const SQLTypeInfo& col_type,
   }
 }
 
+// Recomputes the encoder stats of a fixed width chunk after its rows were rewritten.
+static void reset_fixlen_chunk_stats(const SQLTypeInfo& col_type,
+                                     Data_Namespace::AbstractBuffer* data_buffer,
+                                     const size_t nrows,
+                                     UpdateValuesStats& new_values_stats) {
+  auto daddr = data_buffer->getMemoryPtr();
+  auto element_size =
+      col_type.is_fixlen_array() ? col_type.get_size() : get_element_size(col_type);
+  data_buffer->getEncoder()->resetChunkStats();
+  for (size_t irow = 0; irow < nrows; ++irow, daddr += element_size) {
+    if (col_type.is_fixlen_array()) {
+      auto encoder =
+          dynamic_cast<FixedLengthArrayNoneEncoder*>(data_buffer->getEncoder());
+      CHECK(encoder);
+      encoder->updateMetadata((int8_t*)daddr);
+    } else if (col_type.is_fp()) {
+      set_chunk_stats(col_type,
+                      daddr,
+                      new_values_stats.has_null,
+                      new_values_stats.min_double,
+                      new_values_stats.max_double);
+    } else {
+      set_chunk_stats(col_type,
+                      daddr,
+                      new_values_stats.has_null,
+                      new_values_stats.min_int64t,
+                      new_values_stats.max_int64t);
+    }
+  }
+}
+
 static void set_chunk_metadata(const Catalog_Namespace::Catalog* catalog,
                                FragmentInfo& fragment,
                                const std::shared_ptr<Chunk_NS::Chunk>& chunk,
@@ -1313,30 +1344,10 @@ void InsertOrderFragmenter::compactRows(const Catalog_Namespace::Catalog* catalo
 
           set_chunk_metadata(catalog, fragment, chunk, nrows_to_keep, updel_roll);
 
-          auto daddr = data_addr;
-          auto element_size = col_type.is_fixlen_array() ? col_type.get_size()
-                                                         : get_element_size(col_type);
-          data_buffer->getEncoder()->resetChunkStats();
-          for (size_t irow = 0; irow < nrows_to_keep; ++irow, daddr += element_size) {
-            if (col_type.is_fixlen_array()) {
-              auto encoder =
-                  dynamic_cast<FixedLengthArrayNoneEncoder*>(data_buffer->getEncoder());
-              CHECK(encoder);
-              encoder->updateMetadata((int8_t*)daddr);
-            } else if (col_type.is_fp()) {
-              set_chunk_stats(col_type,
-                              daddr,
-                              update_stats_per_thread[ci].new_values_stats.has_null,
-                              update_stats_per_thread[ci].new_values_stats.min_double,
-                              update_stats_per_thread[ci].new_values_stats.max_double);
-            } else {
-              set_chunk_stats(col_type,
-                              daddr,
-                              update_stats_per_thread[ci].new_values_stats.has_null,
-                              update_stats_per_thread[ci].new_values_stats.min_int64t,
-                              update_stats_per_thread[ci].new_values_stats.max_int64t);
-            }
-          }
+          reset_fixlen_chunk_stats(col_type,
+                                   data_buffer,
+                                   nrows_to_keep,
+                                   update_stats_per_thread[ci].new_values_stats);
         };
 
     auto varlen_vacuum = [=, &updel_roll, &frag_offsets, &fragment] {
@@ -1371,6 +1382,15 @@ void InsertOrderFragmenter::compactRows(const Catalog_Namespace::Catalog* catalo
   wait_cleanup_threads(threads);
 
   updel_roll.setNumTuple({td, &fragment}, nrows_to_keep);
+  updateRewrittenColumnsMetadata(fragment, chunks, update_stats_per_thread, updel_roll);
+}
+
+void InsertOrderFragmenter::updateRewrittenColumnsMetadata(
+    FragmentInfo& fragment,
+    const std::vector<std::shared_ptr<Chunk_NS::Chunk>>& chunks,
+    std::vector<ChunkUpdateStats>& update_stats_per_column,
+    UpdelRoll& updel_roll) {
+  CHECK_EQ(chunks.size(), update_stats_per_column.size());
   for (size_t ci = 0; ci < chunks.size(); ++ci) {
     auto chunk = chunks[ci];
     auto cd = chunk->getColumnDesc();
@@ -1379,20 +1399,520 @@ void InsertOrderFragmenter::compactRows(const Catalog_Namespace::Catalog* catalo
       // stored in seconds. Do the metadata conversion here before updating the chunk
       // stats.
       if (cd->columnType.is_date_in_days()) {
-        auto& stats = update_stats_per_thread[ci].new_values_stats;
+        auto& stats = update_stats_per_column[ci].new_values_stats;
         stats.min_int64t = DateConverters::get_epoch_seconds_from_days(stats.min_int64t);
         stats.max_int64t = DateConverters::get_epoch_seconds_from_days(stats.max_int64t);
       }
       updateColumnMetadata(cd,
                            fragment,
                            chunk,
-                           update_stats_per_thread[ci].new_values_stats,
+                           update_stats_per_column[ci].new_values_stats,
                            cd->columnType,
                            updel_roll);
     }
   }
 }
 
+namespace {
+
+// Reads the keys of a cluster column, row indexes run over the chunks in the given order.
+template <typename T>
+void get_cluster_keys(const SQLTypeInfo& type,
+                      const std::vector<std::shared_ptr<Chunk_NS::Chunk>>& chunks,
+                      const std::vector<size_t>& row_counts,
+                      std::vector<T>& keys,
+                      std::vector<bool>& is_null) {
+  const auto element_size = get_element_size(type);
+  for (size_t i = 0; i < chunks.size(); ++i) {
+    auto data_addr = chunks[i]->getBuffer()->getMemoryPtr();
+    for (size_t irow = 0; irow < row_counts[i]; ++irow, data_addr += element_size) {
+      T key;
+      is_null.push_back(get_scalar<T>(data_addr, type, key));
+      keys.push_back(key);
+    }
+  }
+}
+
+// Orders the rows on the keys of one column, nulls last and ties in row order.
+template <typename T>
+std::vector<size_t> get_sorted_row_order(
+    const SQLTypeInfo& type,
+    const std::vector<std::shared_ptr<Chunk_NS::Chunk>>& chunks,
+    const std::vector<size_t>& row_counts) {
+  std::vector<T> keys;
+  std::vector<bool> is_null;
+  get_cluster_keys(type, chunks, row_counts, keys, is_null);
+  std::vector<size_t> order(keys.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&](const size_t a, const size_t b) {
+    if (is_null[a] || is_null[b]) {
+      return !is_null[a] && is_null[b];
+    }
+    return keys[a] < keys[b];
+  });
+  return order;
+}
+
+// Maps the keys of one column to `bits` wide codes that keep their order, scaled over
+// the range of the keys being clustered. Nulls get the largest code.
+template <typename T>
+std::vector<uint64_t> get_dimension_codes(
+    const SQLTypeInfo& type,
+    const std::vector<std::shared_ptr<Chunk_NS::Chunk>>& chunks,
+    const std::vector<size_t>& row_counts,
+    const size_t bits) {
+  std::vector<T> keys;
+  std::vector<bool> is_null;
+  get_cluster_keys(type, chunks, row_counts, keys, is_null);
+  const uint64_t max_code = bits >= 64 ? ~uint64_t(0) : (uint64_t(1) << bits) - 1;
+  std::optional<T> min_key, max_key;
+  for (size_t i = 0; i < keys.size(); ++i) {
+    if (!is_null[i]) {
+      min_key = min_key ? std::min(*min_key, keys[i]) : keys[i];
+      max_key = max_key ? std::max(*max_key, keys[i]) : keys[i];
+    }
+  }
+  std::vector<uint64_t> codes(keys.size(), max_code);
+  if (!min_key) {
+    return codes;
+  }
+  if constexpr (std::is_floating_point_v<T>) {
+    const double range = static_cast<double>(*max_key) - *min_key;
+    for (size_t i = 0; i < keys.size(); ++i) {
+      if (!is_null[i]) {
+        codes[i] = range > 0 ? static_cast<uint64_t>((keys[i] - *min_key) / range *
+                                                     static_cast<double>(max_code >> 1))
+                             : 0;
+      }
+    }
+  } else {
+    // Keep the exact keys when their range fits, drop the low bits otherwise.
+    const auto range = static_cast<uint64_t>(*max_key) - static_cast<uint64_t>(*min_key);
+    size_t shift{0};
+    while (shift < 64 && (range >> shift) > max_code) {
+      ++shift;
+    }
+    for (size_t i = 0; i < keys.size(); ++i) {
+      if (!is_null[i]) {
+        codes[i] = (static_cast<uint64_t>(keys[i]) - static_cast<uint64_t>(*min_key)) >>
+                   shift;
+      }
+    }
+  }
+  return codes;
+}
+
+// Orders the rows on a Z-order (Morton) curve over the keys of the columns, interleaving
+// the bits of their codes, so that each run of rows covers a compact box of the keys.
+std::vector<size_t> get_z_order_row_order(
+    const std::vector<const ColumnDescriptor*>& cluster_cds,
+    const std::vector<std::vector<std::shared_ptr<Chunk_NS::Chunk>>>& chunks_per_column,
+    const std::vector<size_t>& row_counts) {
+  CHECK_GT(cluster_cds.size(), size_t(1));
+  const size_t bits = 64 / cluster_cds.size();
+  std::vector<std::vector<uint64_t>> codes_per_column;
+  for (size_t ci = 0; ci < cluster_cds.size(); ++ci) {
+    const auto& type = cluster_cds[ci]->columnType;
+    const auto& chunks = chunks_per_column[ci];
+    codes_per_column.push_back(
+        type.is_fp() ? get_dimension_codes<double>(type, chunks, row_counts, bits)
+                     : get_dimension_codes<int64_t>(type, chunks, row_counts, bits));
+  }
+  const auto row_count = codes_per_column.front().size();
+  std::vector<uint64_t> z_codes(row_count, 0);
+  for (size_t irow = 0; irow < row_count; ++irow) {
+    uint64_t z_code{0};
+    for (size_t bit = bits; bit-- > 0;) {
+      for (const auto& codes : codes_per_column) {
+        z_code = (z_code << 1) | ((codes[irow] >> bit) & 1);
+      }
+    }
+    z_codes[irow] = z_code;
+  }
+  std::vector<size_t> order(row_count);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&](const size_t a, const size_t b) {
+    return z_codes[a] < z_codes[b];
+  });
+  return order;
+}
+
+}  // namespace
+
+void InsertOrderFragmenter::clusterRows(
+    const Catalog_Namespace::Catalog* catalog,
+    const TableDescriptor* td,
+    const std::vector<int>& fragment_ids,
+    const std::vector<const ColumnDescriptor*>& cluster_cds,
+    const Data_Namespace::MemoryLevel memory_level,
+    UpdelRoll& updel_roll) {
+  CHECK(!cluster_cds.empty());
+  for (const auto cd : cluster_cds) {
+    CHECK(!cd->columnType.is_varlen_indeed() && !cd->columnType.is_array());
+  }
+  std::vector<FragmentInfo*> fragments;
+  std::vector<std::vector<std::shared_ptr<Chunk_NS::Chunk>>> chunks_per_fragment;
+  std::vector<size_t> row_counts;
+  size_t total_row_count{0};
+  for (const auto fragment_id : fragment_ids) {
+    auto fragment = getFragmentInfo(fragment_id);
+    CHECK(fragment);
+    fragments.push_back(fragment);
+    chunks_per_fragment.push_back(getChunksForAllColumns(td, *fragment, memory_level));
+    row_counts.push_back(fragment->getPhysicalNumTuples());
+    total_row_count += row_counts.back();
+  }
+  if (fragments.size() < 2) {
+    return;
+  }
+  const auto ncol = chunks_per_fragment.front().size();
+
+  std::vector<std::vector<std::shared_ptr<Chunk_NS::Chunk>>> cluster_chunks_per_column(
+      cluster_cds.size());
+  for (const auto& chunks : chunks_per_fragment) {
+    CHECK_EQ(chunks.size(), ncol);
+    for (const auto& chunk : chunks) {
+      for (size_t ci = 0; ci < cluster_cds.size(); ++ci) {
+        if (chunk->getColumnDesc()->columnId == cluster_cds[ci]->columnId) {
+          cluster_chunks_per_column[ci].push_back(chunk);
+        }
+      }
+    }
+  }
+  for (const auto& cluster_chunks : cluster_chunks_per_column) {
+    CHECK_EQ(cluster_chunks.size(), fragments.size());
+  }
+  std::vector<size_t> order;
+  if (cluster_cds.size() > 1) {
+    order = get_z_order_row_order(cluster_cds, cluster_chunks_per_column, row_counts);
+  } else {
+    const auto& type = cluster_cds.front()->columnType;
+    const auto& chunks = cluster_chunks_per_column.front();
+    order = type.is_fp() ? get_sorted_row_order<double>(type, chunks, row_counts)
+                         : get_sorted_row_order<int64_t>(type, chunks, row_counts);
+  }
+  CHECK_EQ(order.size(), total_row_count);
+
+  std::vector<std::vector<ChunkUpdateStats>> update_stats_per_fragment(
+      fragments.size(), std::vector<ChunkUpdateStats>(ncol));
+
+  // Copies each column of all the fragments aside, then writes the rows back in order.
+  auto cluster_fixlen = [&](const size_t ci) {
+    const auto& col_type = chunks_per_fragment.front()[ci]->getColumnDesc()->columnType;
+    const size_t element_size =
+        col_type.is_fixlen_array() ? col_type.get_size() : get_element_size(col_type);
+    std::vector<int8_t> rows(total_row_count * element_size);
+    size_t row_offset{0};
+    for (size_t fi = 0; fi < fragments.size(); ++fi) {
+      auto data_buffer = chunks_per_fragment[fi][ci]->getBuffer();
+      std::memcpy(rows.data() + row_offset * element_size,
+                  data_buffer->getMemoryPtr(),
+                  row_counts[fi] * element_size);
+      row_offset += row_counts[fi];
+    }
+    row_offset = 0;
+    for (size_t fi = 0; fi < fragments.size(); ++fi) {
+      const auto& chunk = chunks_per_fragment[fi][ci];
+      auto data_buffer = chunk->getBuffer();
+      auto data_addr = data_buffer->getMemoryPtr();
+      for (size_t irow = 0; irow < row_counts[fi]; ++irow) {
+        std::memcpy(data_addr + irow * element_size,
+                    rows.data() + order[row_offset + irow] * element_size,
+                    element_size);
+      }
+      row_offset += row_counts[fi];
+      data_buffer->setSize(row_counts[fi] * element_size);
+      data_buffer->setUpdated();
+      set_chunk_metadata(catalog, *fragments[fi], chunk, row_counts[fi], updel_roll);
+      reset_fixlen_chunk_stats(col_type,
+                               data_buffer,
+                               row_counts[fi],
+                               update_stats_per_fragment[fi][ci].new_values_stats);
+    }
+  };
+
+  auto cluster_varlen = [&](const size_t ci) {
+    const auto& col_type = chunks_per_fragment.front()[ci]->getColumnDesc()->columnType;
+    const bool is_varlen_array = col_type.is_varlen_array();
+    std::vector<std::vector<int8_t>> data_per_fragment;
+    std::vector<std::vector<StringOffsetT>> offsets_per_fragment;
+    std::vector<std::pair<size_t, size_t>> row_locations;
+    row_locations.reserve(total_row_count);
+    // None encoded strings only track nulls, the fragments of the group share them.
+    ChunkStats string_stats;
+    string_stats.has_nulls = false;
+    for (size_t fi = 0; fi < fragments.size(); ++fi) {
+      const auto& chunk = chunks_per_fragment[fi][ci];
+      const auto& chunk_metadata_map = fragments[fi]->getChunkMetadataMapPhysical();
+      const auto chunk_metadata_it =
+          chunk_metadata_map.find(chunk->getColumnDesc()->columnId);
+      CHECK(chunk_metadata_it != chunk_metadata_map.end());
+      string_stats.has_nulls |= chunk_metadata_it->second->chunkStats.has_nulls;
+      auto data_addr = chunk->getBuffer()->getMemoryPtr();
+      data_per_fragment.emplace_back(data_addr, data_addr + chunk->getBuffer()->size());
+      auto index_array =
+          reinterpret_cast<StringOffsetT*>(chunk->getIndexBuf()->getMemoryPtr());
+      offsets_per_fragment.emplace_back(index_array, index_array + row_counts[fi] + 1);
+      for (size_t irow = 0; irow < row_counts[fi]; ++irow) {
+        row_locations.emplace_back(fi, irow);
+      }
+    }
+    size_t row_offset{0};
+    for (size_t fi = 0; fi < fragments.size(); ++fi) {
+      const auto& chunk = chunks_per_fragment[fi][ci];
+      std::vector<int8_t> data;
+      std::vector<StringOffsetT> offsets;
+      offsets.reserve(row_counts[fi] + 1);
+      for (size_t irow = 0; irow < row_counts[fi]; ++irow) {
+        const auto [src_fi, src_irow] = row_locations[order[row_offset + irow]];
+        const auto& src_offsets = offsets_per_fragment[src_fi];
+        const auto begin =
+            get_buffer_offset(is_varlen_array, src_offsets.data(), src_irow);
+        const auto end =
+            get_buffer_offset(is_varlen_array, src_offsets.data(), src_irow + 1);
+        const bool is_null = is_varlen_array && src_offsets[src_irow + 1] < 0;
+        if (irow == 0) {
+          // Same initial padding as ArrayNoneEncoder, a null array can't have a 0 offset.
+          const size_t null_padding =
+              is_varlen_array && (is_null || end - begin <= 1)
+                  ? ArrayNoneEncoder::DEFAULT_NULL_PADDING_SIZE
+                  : 0;
+          data.resize(null_padding, 0);
+          offsets.push_back(null_padding);
+        }
+        const auto& src_data = data_per_fragment[src_fi];
+        data.insert(data.end(), src_data.begin() + begin, src_data.begin() + end);
+        offsets.push_back(is_null ? -static_cast<StringOffsetT>(data.size())
+                                  : static_cast<StringOffsetT>(data.size()));
+      }
+      row_offset += row_counts[fi];
+      auto data_buffer = chunk->getBuffer();
+      auto index_buffer = chunk->getIndexBuf();
+      if (!data.empty()) {
+        data_buffer->write(data.data(), data.size(), 0);
+      }
+      data_buffer->setSize(data.size());
+      data_buffer->setUpdated();
+      if (!offsets.empty()) {
+        index_buffer->write(reinterpret_cast<int8_t*>(offsets.data()),
+                            offsets.size() * sizeof(StringOffsetT),
+                            0);
+      }
+      index_buffer->setSize(offsets.size() * sizeof(StringOffsetT));
+      index_buffer->setUpdated();
+
+      auto encoder = data_buffer->getEncoder();
+      if (is_varlen_array) {
+        std::vector<ArrayDatum> arrays;
+        arrays.reserve(row_counts[fi]);
+        for (size_t irow = 0; irow < row_counts[fi]; ++irow) {
+          const auto begin = get_buffer_offset(is_varlen_array, offsets.data(), irow);
+          const auto end = get_buffer_offset(is_varlen_array, offsets.data(), irow + 1);
+          arrays.emplace_back(end - begin,
+                              data_buffer->getMemoryPtr() + begin,
+                              offsets[irow + 1] < 0,
+                              DoNothingDeleter());
+        }
+        encoder->resetChunkStats();
+        encoder->updateStats(&arrays, 0, arrays.size());
+      } else {
+        encoder->resetChunkStats(string_stats);
+      }
+      set_chunk_metadata(catalog, *fragments[fi], chunk, row_counts[fi], updel_roll);
+    }
+  };
+
+  std::vector<std::future<void>> threads;
+  for (size_t ci = 0; ci < ncol; ++ci) {
+    const bool is_varlen =
+        chunks_per_fragment.front()[ci]->getColumnDesc()->columnType.is_varlen_indeed();
+    if (is_varlen) {
+      threads.emplace_back(std::async(std::launch::async, cluster_varlen, ci));
+    } else {
+      threads.emplace_back(std::async(std::launch::async, cluster_fixlen, ci));
+    }
+    if (threads.size() >= (size_t)cpu_threads()) {
+      wait_cleanup_threads(threads);
+    }
+  }
+  wait_cleanup_threads(threads);
+
+  for (size_t fi = 0; fi < fragments.size(); ++fi) {
+    updel_roll.setNumTuple({td, fragments[fi]}, row_counts[fi]);
+    updateRewrittenColumnsMetadata(*fragments[fi],
+                                   chunks_per_fragment[fi],
+                                   update_stats_per_fragment[fi],
+                                   updel_roll);
+  }
+}
+
+namespace {
+
+template <typename T>
+void remap_string_ids(int8_t* data_addr,
+                      const size_t nrows,
+                      const T null_id,
+                      const std::vector<int32_t>& id_map) {
+  auto string_ids = reinterpret_cast<T*>(data_addr);
+  for (size_t irow = 0; irow < nrows; ++irow) {
+    if (string_ids[irow] == null_id) {
+      continue;
+    }
+    CHECK_LT(static_cast<size_t>(string_ids[irow]), id_map.size());
+    const auto new_id = id_map[string_ids[irow]];
+    CHECK_GE(new_id, 0);
+    string_ids[irow] = static_cast<T>(new_id);
+  }
+}
+
+template <typename T>
+void read_string_ids(const int8_t* data_addr,
+                     const T null_id,
+                     std::vector<int32_t>& string_ids) {
+  const auto ids = reinterpret_cast<const T*>(data_addr);
+  for (size_t irow = 0; irow < string_ids.size(); ++irow) {
+    string_ids[irow] =
+        ids[irow] == null_id ? inline_int_null_value<int32_t>() : ids[irow];
+  }
+}
+
+template <typename T>
+void write_string_ids(const std::vector<int32_t>& string_ids,
+                      const T null_id,
+                      int8_t* data_addr) {
+  auto ids = reinterpret_cast<T*>(data_addr);
+  for (size_t irow = 0; irow < string_ids.size(); ++irow) {
+    ids[irow] = string_ids[irow] == inline_int_null_value<int32_t>()
+                    ? null_id
+                    : static_cast<T>(string_ids[irow]);
+  }
+}
+
+}  // namespace
+
+void InsertOrderFragmenter::remapDictionaryIds(
+    const Catalog_Namespace::Catalog* catalog,
+    const TableDescriptor* td,
+    const ColumnDescriptor* cd,
+    const int fragment_id,
+    const std::vector<int32_t>& id_map,
+    const Data_Namespace::MemoryLevel memory_level,
+    UpdelRoll& updel_roll) {
+  const auto& col_type = cd->columnType;
+  CHECK(col_type.is_dict_encoded_string());
+  auto fragment_ptr = getFragmentInfo(fragment_id);
+  auto& fragment = *fragment_ptr;
+  const auto chunk_meta_it = fragment.getChunkMetadataMapPhysical().find(cd->columnId);
+  CHECK(chunk_meta_it != fragment.getChunkMetadataMapPhysical().end());
+  ChunkKey chunk_key{
+      catalog->getCurrentDB().dbId, td->tableId, cd->columnId, fragment.fragmentId};
+  auto chunk = Chunk_NS::Chunk::getChunk(cd,
+                                         &catalog->getDataMgr(),
+                                         chunk_key,
+                                         memory_level,
+                                         0,
+                                         chunk_meta_it->second->numBytes,
+                                         chunk_meta_it->second->numElements);
+  const auto nrows = fragment.getPhysicalNumTuples();
+  auto data_buffer = chunk->getBuffer();
+  auto data_addr = data_buffer->getMemoryPtr();
+  const auto null_id = inline_fixed_encoding_null_val(col_type);
+  switch (col_type.get_size()) {
+    case 1:
+      remap_string_ids(data_addr, nrows, static_cast<uint8_t>(null_id), id_map);
+      break;
+    case 2:
+      remap_string_ids(data_addr, nrows, static_cast<uint16_t>(null_id), id_map);
+      break;
+    case 4:
+      remap_string_ids(data_addr, nrows, static_cast<int32_t>(null_id), id_map);
+      break;
+    default:
+      UNREACHABLE() << "Unexpected dictionary encoding size " << col_type.get_size();
+  }
+  data_buffer->setUpdated();
+  set_chunk_metadata(catalog, fragment, chunk, nrows, updel_roll);
+
+  std::vector<std::shared_ptr<Chunk_NS::Chunk>> chunks{chunk};
+  std::vector<ChunkUpdateStats> update_stats_per_column(1);
+  reset_fixlen_chunk_stats(
+      col_type, data_buffer, nrows, update_stats_per_column.front().new_values_stats);
+  updel_roll.setNumTuple({td, &fragment}, nrows);
+  updateRewrittenColumnsMetadata(fragment, chunks, update_stats_per_column, updel_roll);
+}
+
+void InsertOrderFragmenter::widenDictionaryIds(
+    const Catalog_Namespace::Catalog* catalog,
+    const TableDescriptor* td,
+    const ColumnDescriptor* cd,
+    const int fragment_id,
+    const SQLTypeInfo& old_type,
+    const Data_Namespace::MemoryLevel memory_level,
+    UpdelRoll& updel_roll) {
+  const auto& col_type = cd->columnType;
+  CHECK(col_type.is_dict_encoded_string());
+  CHECK_LT(old_type.get_size(), col_type.get_size());
+  auto fragment_ptr = getFragmentInfo(fragment_id);
+  auto& fragment = *fragment_ptr;
+  const auto chunk_meta_it = fragment.getChunkMetadataMapPhysical().find(cd->columnId);
+  CHECK(chunk_meta_it != fragment.getChunkMetadataMapPhysical().end());
+  ChunkKey chunk_key{
+      catalog->getCurrentDB().dbId, td->tableId, cd->columnId, fragment.fragmentId};
+  auto chunk = Chunk_NS::Chunk::getChunk(cd,
+                                         &catalog->getDataMgr(),
+                                         chunk_key,
+                                         memory_level,
+                                         0,
+                                         chunk_meta_it->second->numBytes,
+                                         chunk_meta_it->second->numElements);
+  const auto nrows = fragment.getPhysicalNumTuples();
+  auto data_buffer = chunk->getBuffer();
+  std::vector<int32_t> string_ids(nrows);
+  const auto old_null_id = inline_fixed_encoding_null_val(old_type);
+  switch (old_type.get_size()) {
+    case 1:
+      read_string_ids(data_buffer->getMemoryPtr(),
+                      static_cast<uint8_t>(old_null_id),
+                      string_ids);
+      break;
+    case 2:
+      read_string_ids(data_buffer->getMemoryPtr(),
+                      static_cast<uint16_t>(old_null_id),
+                      string_ids);
+      break;
+    default:
+      UNREACHABLE() << "Unexpected dictionary encoding size " << old_type.get_size();
+  }
+  std::vector<int8_t> data(nrows * col_type.get_size());
+  const auto null_id = inline_fixed_encoding_null_val(col_type);
+  switch (col_type.get_size()) {
+    case 2:
+      write_string_ids(string_ids, static_cast<uint16_t>(null_id), data.data());
+      break;
+    case 4:
+      write_string_ids(string_ids, static_cast<int32_t>(null_id), data.data());
+      break;
+    default:
+      UNREACHABLE() << "Unexpected dictionary encoding size " << col_type.get_size();
+  }
+  // The buffer takes the wider type, which also goes to its disk copy on checkpoint.
+  data_buffer->initEncoder(col_type);
+  if (!data.empty()) {
+    data_buffer->write(data.data(), data.size(), 0);
+  }
+  data_buffer->setSize(data.size());
+  data_buffer->setUpdated();
+  data_buffer->getEncoder()->setNumElems(nrows);
+  set_chunk_metadata(catalog, fragment, chunk, nrows, updel_roll);
+
+  std::vector<std::shared_ptr<Chunk_NS::Chunk>> chunks{chunk};
+  std::vector<ChunkUpdateStats> update_stats_per_column(1);
+  reset_fixlen_chunk_stats(
+      col_type, data_buffer, nrows, update_stats_per_column.front().new_values_stats);
+  updel_roll.setNumTuple({td, &fragment}, nrows);
+  updateRewrittenColumnsMetadata(fragment, chunks, update_stats_per_column, updel_roll);
+}
+
 }  // namespace Fragmenter_Namespace
 
 bool UpdelRoll::commitUpdate() {
@@ -1479,6 +1999,15 @@ void UpdelRoll::cancelUpdate() {
   }
 }
 
+void UpdelRoll::setUpdatedTable(const Catalog_Namespace::Catalog* catalog,
+                                int logical_table_id,
+                                Data_Namespace::MemoryLevel memory_level) {
+  mapd_unique_lock<mapd_shared_mutex> lock(chunk_update_tracker_mutex);
+  this->catalog = catalog;
+  logicalTableId = logical_table_id;
+  memoryLevel = memory_level;
+}
+
 void UpdelRoll::addDirtyChunk(std::shared_ptr<Chunk_NS::Chunk> chunk,
                               int32_t fragment_id) {
   mapd_unique_lock<mapd_shared_mutex> lock(chunk_update_tracker_mutex);
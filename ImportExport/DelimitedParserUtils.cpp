@@ -22,6 +22,7 @@
 
 #include "ImportExport/DelimitedParserUtils.h"
 
+#include <cstring>
 #include <string_view>
 
 #include "ImportExport/CopyParams.h"
@@ -33,6 +34,67 @@ inline bool is_eol(const char& c, const import_export::CopyParams& copy_params)
   return c == copy_params.line_delim || c == '\n' || c == '\r';
 }
 
+/**
+ * Finds the next occurrence of any of a few bytes. Eight bytes are compared at a time
+ * with word arithmetic, so that row boundary scans skip over the bytes which are
+ * neither line delimiters nor quotes without a branch per byte.
+ */
+class ByteFinder {
+ public:
+  void add(const char c) {
+    for (size_t i = 0; i < num_bytes_; ++i) {
+      if (bytes_[i] == c) {
+        return;
+      }
+    }
+    CHECK_LT(num_bytes_, max_bytes);
+    bytes_[num_bytes_] = c;
+    patterns_[num_bytes_] = low_bits * static_cast<uint8_t>(c);
+    ++num_bytes_;
+  }
+
+  // Returns the first position in [begin, end) holding one of the bytes, or end.
+  const char* find(const char* begin, const char* end) const {
+    while (end - begin >= static_cast<ptrdiff_t>(sizeof(uint64_t))) {
+      uint64_t word;
+      std::memcpy(&word, begin, sizeof(word));
+      uint64_t matches{0};
+      for (size_t i = 0; i < num_bytes_; ++i) {
+        // Sets the high bit of a byte of the word if (and below the first match, only
+        // if) the byte equals the pattern.
+        const uint64_t diff = word ^ patterns_[i];
+        matches |= (diff - low_bits) & ~diff & high_bits;
+      }
+      if (matches) {
+        break;
+      }
+      begin += sizeof(word);
+    }
+    while (begin < end && !contains(*begin)) {
+      ++begin;
+    }
+    return begin;
+  }
+
+ private:
+  bool contains(const char c) const {
+    for (size_t i = 0; i < num_bytes_; ++i) {
+      if (bytes_[i] == c) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  static constexpr size_t max_bytes{8};
+  static constexpr uint64_t low_bits{0x0101010101010101ULL};
+  static constexpr uint64_t high_bits{0x8080808080808080ULL};
+
+  char bytes_[max_bytes];
+  uint64_t patterns_[max_bytes];
+  size_t num_bytes_{0};
+};
+
 inline void trim_space(const char*& field_begin, const char*& field_end) {
   while (field_begin < field_end && (*field_begin == ' ' || *field_begin == '\r')) {
     ++field_begin;
@@ -86,36 +148,56 @@ size_t find_end(const char* buffer,
                 size_t offset) {
   size_t last_line_delim_pos = 0;
   const char* current = buffer + offset;
+  const char* const buffer_end = buffer + size;
   if (copy_params.quoted) {
-    while (current < buffer + size) {
-      while (!in_quote && current < buffer + size) {
+    ByteFinder unquoted_finder;
+    unquoted_finder.add(copy_params.line_delim);
+    unquoted_finder.add(copy_params.quote);
+    ByteFinder quoted_finder;
+    quoted_finder.add(copy_params.quote);
+    while (current < buffer_end) {
+      if (!in_quote) {
         // We are outside of quotes. We have to find the last possible line delimiter.
+        current = unquoted_finder.find(current, buffer_end);
+        if (current == buffer_end) {
+          break;
+        }
         if (*current == copy_params.line_delim) {
           last_line_delim_pos = current - buffer;
           ++num_rows_this_buffer;
-        } else if (*current == copy_params.quote) {
+        } else {
           in_quote = true;
         }
         ++current;
-      }
-
-      while (in_quote && current < buffer + size) {
+      } else {
         // We are in a quoted field. We have to find the ending quote.
-        if ((*current == copy_params.escape) && (current < buffer + size - 1) &&
-            (*(current + 1) == copy_params.quote)) {
+        const char* const quoted_begin = current;
+        current = quoted_finder.find(current, buffer_end);
+        if (current == buffer_end) {
+          break;
+        }
+        if (copy_params.escape == copy_params.quote) {
+          if (current < buffer_end - 1 && *(current + 1) == copy_params.quote) {
+            current += 2;
+            continue;
+          }
+        } else if (current > quoted_begin && *(current - 1) == copy_params.escape) {
           ++current;
-        } else if (*current == copy_params.quote) {
-          in_quote = false;
+          continue;
         }
+        in_quote = false;
         ++current;
       }
     }
   } else {
-    while (current < buffer + size) {
-      if (*current == copy_params.line_delim) {
-        last_line_delim_pos = current - buffer;
-        ++num_rows_this_buffer;
+    while (current < buffer_end) {
+      current = static_cast<const char*>(
+          std::memchr(current, copy_params.line_delim, buffer_end - current));
+      if (!current) {
+        break;
       }
+      last_line_delim_pos = current - buffer;
+      ++num_rows_this_buffer;
       ++current;
     }
   }
@@ -236,10 +318,15 @@ const char* get_row(const char* buf,
       }
     } else if (*p == copy_params.delimiter || is_eol(*p, copy_params)) {
       if (!in_quote) {
-        if (!has_escape && !strip_quotes) {
+        if (!has_escape) {
+          // Without escapes the field is used in place, quotes are only trimmed.
+          const char* field_begin = field;
           const char* field_end = p;
-          trim_space(field, field_end);
-          row.emplace_back(field, field_end - field);
+          trim_space(field_begin, field_end);
+          if (strip_quotes) {
+            trim_quotes(field_begin, field_end, copy_params);
+          }
+          row.emplace_back(field_begin, field_end - field_begin);
         } else {
           tmp_buffers.emplace_back(std::make_unique<char[]>(p - field + 1));
           auto field_buf = tmp_buffers.back().get();
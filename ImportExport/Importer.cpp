@@ -31,16 +31,19 @@
 #include <boost/filesystem.hpp>
 #include <boost/geometry.hpp>
 #include <boost/variant.hpp>
+#include <algorithm>
 #include <csignal>
 #include <cstdio>
 #include <cstdlib>
 #include <fstream>
 #include <future>
 #include <iomanip>
+#include <iterator>
 #include <list>
 #include <memory>
 #include <mutex>
 #include <numeric>
+#include <optional>
 #include <stack>
 #include <stdexcept>
 #include <thread>
@@ -58,10 +61,12 @@
 #include "Geospatial/Transforms.h"
 #include "Geospatial/Types.h"
 #include "ImportExport/DelimitedParserUtils.h"
+#include "LockMgr/LockMgr.h"
 #include "Logger/Logger.h"
 #include "OSDependent/omnisci_glob.h"
 #include "QueryEngine/ErrorHandling.h"
 #include "QueryEngine/Execute.h"
+#include "QueryEngine/ExternalCacheInvalidators.h"
 #include "QueryEngine/TypePunning.h"
 #include "RenderGroupAnalyzer.h"
 #include "Shared/DateTimeParser.h"
@@ -73,7 +78,13 @@
 #include "Shared/scope.h"
 #include "Shared/shard_key.h"
 #include "Shared/thread_count.h"
+#include "Shared/threadpool.h"
 #include "Utils/ChunkAccessorTable.h"
+#ifdef ENABLE_IMPORT_PARQUET
+#include <arrow/filesystem/localfs.h>
+#include "DataMgr/ForeignStorage/ForeignStorageBuffer.h"
+#include "DataMgr/ForeignStorage/LazyParquetChunkLoader.h"
+#endif  // ENABLE_IMPORT_PARQUET
 
 #include "gen-cpp/OmniSci.h"
 
@@ -87,6 +98,14 @@ size_t g_max_import_threads =
          // if lower, and can also be explicitly overriden in copy statement with threads
          // option)
 size_t g_archive_read_buf_size = 1 << 20;
+bool g_enable_columnar_delimited_import{false};
+// Widen the ids of text columns whose dictionary a load would overflow, instead of
+// failing the load.
+bool g_enable_dictionary_encoding_widening{false};
+// Decode parquet files with the encoders of parquet foreign tables straight into chunk
+// buffers when importing them, for the tables whose columns they all support. Files
+// with values the encoders reject are imported again value by value.
+bool g_enable_parquet_import_chunk_loader{true};
 
 inline auto get_filesize(const std::string& file_path) {
   boost::filesystem::path boost_file_path{file_path};
@@ -96,6 +115,9 @@ inline auto get_filesize(const std::string& file_path) {
 }
 
 namespace {
+// Number of rows converted at a time when importing delimited files by column.
+constexpr size_t delimited_import_block_rows{4096};
+
 bool checkInterrupt(const QuerySessionId& query_session, Executor* executor) {
   if (g_enable_non_kernel_time_query_interrupt && !query_session.empty()) {
     mapd_shared_lock<mapd_shared_mutex> session_read_lock(executor->getSessionLock());
@@ -415,6 +437,22 @@ ArrayDatum NullArray(const SQLTypeInfo& ti) {
   return ArrayDatum(0, NULL, true);
 }
 
+// Copies the values of a geo physical array column straight into an array datum,
+// rather than going through a TDatum per value.
+template <typename T>
+ArrayDatum to_array_datum(const std::vector<T>& values,
+                          const SQLTypeInfo& ti,
+                          const bool is_null) {
+  if (is_null) {
+    return NullArray(ti);
+  }
+  CHECK_EQ(sizeof(T), static_cast<size_t>(ti.get_elem_type().get_size()));
+  const size_t len = values.size() * sizeof(T);
+  int8_t* buf = (int8_t*)checked_malloc(len);
+  memcpy(buf, values.data(), len);
+  return ArrayDatum(len, buf, false);
+}
+
 ArrayDatum ImporterUtils::composeNullArray(const SQLTypeInfo& ti) {
   return NullArray(ti);
 }
@@ -520,8 +558,32 @@ void TypedImportBuffer::addDictEncodedString(const std::vector<std::string>& str
     }
     string_view_vec.push_back(str);
   }
+  if (string_dict_size_ != column_desc_->columnType.get_size()) {
+    // The loader widened the dictionary encoding of the column since the last batch.
+    switch (string_dict_size_) {
+      case 1:
+        delete string_dict_i8_buffer_;
+        break;
+      case 2:
+        delete string_dict_i16_buffer_;
+        break;
+      default:
+        CHECK(false);
+    }
+    string_dict_size_ = column_desc_->columnType.get_size();
+    switch (string_dict_size_) {
+      case 2:
+        string_dict_i16_buffer_ = new std::vector<uint16_t>();
+        break;
+      case 4:
+        string_dict_i32_buffer_ = new std::vector<int32_t>();
+        break;
+      default:
+        CHECK(false);
+    }
+  }
   try {
-    switch (column_desc_->columnType.get_size()) {
+    switch (string_dict_size_) {
       case 1:
         string_dict_i8_buffer_->resize(string_view_vec.size());
         string_dict_->getOrAddBulk(string_view_vec, string_dict_i8_buffer_->data());
@@ -546,6 +608,22 @@ void TypedImportBuffer::addDictEncodedString(const std::vector<std::string>& str
   }
 }
 
+namespace {
+
+// Same as std::atof(), without allocating a null terminated copy of short fields.
+double parse_floating_point(const std::string_view val) {
+  constexpr size_t bufsize = 64;
+  if (val.size() < bufsize) {
+    char c_str[bufsize];
+    val.copy(c_str, val.size());
+    c_str[val.size()] = '\0';
+    return std::strtod(c_str, nullptr);
+  }
+  return std::strtod(std::string(val).c_str(), nullptr);
+}
+
+}  // namespace
+
 void TypedImportBuffer::add_value(const ColumnDescriptor* cd,
                                   const std::string_view val,
                                   const bool is_null,
@@ -635,7 +713,7 @@ void TypedImportBuffer::add_value(const ColumnDescriptor* cd,
     }
     case kFLOAT:
       if (!is_null && (val[0] == '.' || isdigit(val[0]) || val[0] == '-')) {
-        addFloat(static_cast<float>(std::atof(std::string(val).c_str())));
+        addFloat(static_cast<float>(parse_floating_point(val)));
       } else {
         if (cd->columnType.get_notnull()) {
           throw std::runtime_error("NULL for column " + cd->columnName);
@@ -645,7 +723,7 @@ void TypedImportBuffer::add_value(const ColumnDescriptor* cd,
       break;
     case kDOUBLE:
       if (!is_null && (val[0] == '.' || isdigit(val[0]) || val[0] == '-')) {
-        addDouble(std::atof(std::string(val).c_str()));
+        addDouble(parse_floating_point(val));
       } else {
         if (cd->columnType.get_notnull()) {
           throw std::runtime_error("NULL for column " + cd->columnName);
@@ -749,6 +827,135 @@ void TypedImportBuffer::add_value(const ColumnDescriptor* cd,
   }
 }
 
+size_t TypedImportBuffer::add_values(const ColumnDescriptor* cd,
+                                     const std::vector<std::string_view>& fields,
+                                     const size_t num_fields_per_row,
+                                     const size_t field_idx,
+                                     const CopyParams& copy_params,
+                                     std::map<size_t, std::string>& bad_rows) {
+  CHECK_LT(field_idx, num_fields_per_row);
+  CHECK_EQ(fields.size() % num_fields_per_row, size_t(0));
+  const auto num_rows = fields.size() / num_fields_per_row;
+  const auto& col_ti = cd->columnType;
+  // StringToDatum() takes a mutable type, copy it once for the whole block.
+  auto ti = col_ti;
+  const auto check_nullable = [&]() {
+    if (col_ti.get_notnull()) {
+      throw std::runtime_error("NULL for column " + cd->columnName);
+    }
+  };
+  const auto null_value = [&]() {
+    check_nullable();
+    return inline_fixed_encoding_null_val(col_ti);
+  };
+  const auto is_numeric = [](const std::string_view val) {
+    return isdigit(val[0]) || val[0] == '-';
+  };
+  // Same nullness and conversions as add_value(), with the type dispatch hoisted out
+  // of the loop over the rows.
+  const auto append = [&](auto& buffer, const auto& convert) {
+    using value_type = typename std::decay_t<decltype(buffer)>::value_type;
+    buffer.reserve(buffer.size() + num_rows);
+    for (size_t row = 0; row < num_rows; ++row) {
+      const auto val = fields[row * num_fields_per_row + field_idx];
+      const bool is_null = val == copy_params.null_str || val == "NULL" ||
+                           (!col_ti.is_string() && val.empty());
+      try {
+        buffer.push_back(convert(val, is_null));
+      } catch (const std::exception& e) {
+        bad_rows.emplace(row, e.what());
+        buffer.push_back(value_type{});
+      }
+    }
+  };
+  const auto type = col_ti.get_type();
+  switch (type) {
+    case kBOOLEAN:
+      append(*bool_buffer_, [&](const std::string_view val, const bool is_null) {
+        return is_null ? static_cast<int8_t>(null_value())
+                       : static_cast<int8_t>(StringToDatum(val, ti).boolval);
+      });
+      break;
+    case kTINYINT:
+      append(*tinyint_buffer_, [&](const std::string_view val, const bool is_null) {
+        return !is_null && is_numeric(val) ? StringToDatum(val, ti).tinyintval
+                                           : static_cast<int8_t>(null_value());
+      });
+      break;
+    case kSMALLINT:
+      append(*smallint_buffer_, [&](const std::string_view val, const bool is_null) {
+        return !is_null && is_numeric(val) ? StringToDatum(val, ti).smallintval
+                                           : static_cast<int16_t>(null_value());
+      });
+      break;
+    case kINT:
+      append(*int_buffer_, [&](const std::string_view val, const bool is_null) {
+        return !is_null && is_numeric(val) ? StringToDatum(val, ti).intval
+                                           : static_cast<int32_t>(null_value());
+      });
+      break;
+    case kBIGINT:
+    case kTIME:
+    case kTIMESTAMP:
+    case kDATE:
+      append(*bigint_buffer_, [&](const std::string_view val, const bool is_null) {
+        return !is_null && is_numeric(val) ? StringToDatum(val, ti).bigintval
+                                           : null_value();
+      });
+      break;
+    case kDECIMAL:
+    case kNUMERIC: {
+      SQLTypeInfo numeric_ti(kNUMERIC, 0, 0, false);
+      append(*bigint_buffer_, [&](const std::string_view val, const bool is_null) {
+        if (is_null) {
+          return null_value();
+        }
+        auto src_ti = numeric_ti;
+        const auto d = StringToDatum(val, src_ti);
+        return convert_decimal_value_to_scale(d.bigintval, src_ti, col_ti);
+      });
+      break;
+    }
+    case kFLOAT:
+      append(*float_buffer_, [&](const std::string_view val, const bool is_null) {
+        if (is_null || !(val[0] == '.' || is_numeric(val))) {
+          check_nullable();
+          return NULL_FLOAT;
+        }
+        return static_cast<float>(parse_floating_point(val));
+      });
+      break;
+    case kDOUBLE:
+      append(*double_buffer_, [&](const std::string_view val, const bool is_null) {
+        if (is_null || !(val[0] == '.' || is_numeric(val))) {
+          check_nullable();
+          return NULL_DOUBLE;
+        }
+        return parse_floating_point(val);
+      });
+      break;
+    case kTEXT:
+    case kVARCHAR:
+    case kCHAR:
+      append(*string_buffer_, [&](const std::string_view val, const bool is_null) {
+        if (is_null) {
+          check_nullable();
+          return std::string();
+        }
+        if (val.length() > StringDictionary::MAX_STRLEN) {
+          throw std::runtime_error("String too long for column " + cd->columnName +
+                                   " was " + std::to_string(val.length()) + " max is " +
+                                   std::to_string(StringDictionary::MAX_STRLEN));
+        }
+        return std::string(val);
+      });
+      break;
+    default:
+      CHECK(false) << "TypedImportBuffer::add_values() does not support type " << type;
+  }
+  return num_rows;
+}
+
 void TypedImportBuffer::pop_value() {
   const auto type = column_desc_->columnType.is_decimal()
                         ? decimal_to_int_type(column_desc_->columnType)
@@ -803,10 +1010,112 @@ void TypedImportBuffer::pop_value() {
   }
 }
 
+template <typename DATA_TYPE>
+auto TypedImportBuffer::del_values(
+    std::vector<DATA_TYPE>& buffer,
+    import_export::BadRowsTracker* const bad_rows_tracker) {
+  const auto old_size = buffer.size();
+  // erase backward to minimize memory movement overhead
+  for (auto rit = bad_rows_tracker->rows.crbegin(); rit != bad_rows_tracker->rows.crend();
+       ++rit) {
+    buffer.erase(buffer.begin() + *rit);
+  }
+  return std::make_tuple(old_size, buffer.size());
+}
+
+auto TypedImportBuffer::del_values(const SQLTypes type,
+                                   BadRowsTracker* const bad_rows_tracker) {
+  switch (type) {
+    case kBOOLEAN:
+      return del_values(*bool_buffer_, bad_rows_tracker);
+    case kTINYINT:
+      return del_values(*tinyint_buffer_, bad_rows_tracker);
+    case kSMALLINT:
+      return del_values(*smallint_buffer_, bad_rows_tracker);
+    case kINT:
+      return del_values(*int_buffer_, bad_rows_tracker);
+    case kBIGINT:
+    case kNUMERIC:
+    case kDECIMAL:
+    case kTIME:
+    case kTIMESTAMP:
+    case kDATE:
+      return del_values(*bigint_buffer_, bad_rows_tracker);
+    case kFLOAT:
+      return del_values(*float_buffer_, bad_rows_tracker);
+    case kDOUBLE:
+      return del_values(*double_buffer_, bad_rows_tracker);
+    case kTEXT:
+    case kVARCHAR:
+    case kCHAR:
+      return del_values(*string_buffer_, bad_rows_tracker);
+    case kPOINT:
+    case kLINESTRING:
+    case kPOLYGON:
+    case kMULTIPOLYGON:
+      return del_values(*geo_string_buffer_, bad_rows_tracker);
+    case kARRAY:
+      return del_values(*array_buffer_, bad_rows_tracker);
+    default:
+      throw std::runtime_error("Invalid Type");
+  }
+}
+
 struct GeoImportException : std::runtime_error {
   using std::runtime_error::runtime_error;
 };
 
+namespace {
+
+// Appends a slice of an Arrow array of the same physical type as the import buffer with
+// a single copy, then writes the null sentinel of the column over the null rows. Values
+// the per value conversion rejects (the lowest value of narrower integer types collides
+// with their null sentinel) make it return false without touching the buffer, so the
+// caller falls back to the per value conversion which reports them.
+template <typename DATA_TYPE>
+bool append_arrow_fixed_width_values(const ColumnDescriptor* cd,
+                                     const Array& array,
+                                     std::vector<DATA_TYPE>& buffer,
+                                     const ArraySliceRange& slice_range) {
+  const auto& primitive_array = static_cast<const arrow::PrimitiveArray&>(array);
+  CHECK_EQ(static_cast<size_t>(
+               static_cast<const arrow::FixedWidthType&>(*array.type()).bit_width()),
+           sizeof(DATA_TYPE) * 8);
+  const auto num_values = slice_range.second - slice_range.first;
+  if (num_values == 0) {
+    return true;
+  }
+  const auto values =
+      reinterpret_cast<const DATA_TYPE*>(primitive_array.values()->data()) +
+      primitive_array.offset();
+  if constexpr (std::is_integral<DATA_TYPE>::value &&
+                !std::is_same<DATA_TYPE, int64_t>::value) {
+    for (size_t row = slice_range.first; row < slice_range.second; ++row) {
+      if (values[row] == std::numeric_limits<DATA_TYPE>::lowest() && !array.IsNull(row)) {
+        return false;
+      }
+    }
+  }
+  const auto start_idx = buffer.size();
+  buffer.insert(buffer.end(), values + slice_range.first, values + slice_range.second);
+  if (array.null_count() > 0) {
+    DATA_TYPE null_value;
+    if constexpr (std::is_integral<DATA_TYPE>::value) {
+      null_value = inline_fixed_encoding_null_val(cd->columnType);
+    } else {
+      null_value = inline_fp_null_val(cd->columnType);
+    }
+    for (size_t row = slice_range.first; row < slice_range.second; ++row) {
+      if (array.IsNull(row)) {
+        buffer[start_idx + row - slice_range.first] = null_value;
+      }
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
 // appends (streams) a slice of Arrow array of values (RHS) to TypedImportBuffer (LHS)
 template <typename DATA_TYPE>
 size_t TypedImportBuffer::convert_arrow_val_to_import_buffer(
@@ -905,6 +1214,12 @@ size_t TypedImportBuffer::add_arrow_values(const ColumnDescriptor* cd,
     arrow_throw_if(col.null_count() > 0, "NULL not allowed for column " + cd->columnName);
   }
 
+  // Arrays of the physical type of the column skip the per value conversion.
+  auto append_fixed_width_values = [&](auto& buffer) {
+    return exact_type_match && !bad_rows_tracker &&
+           append_arrow_fixed_width_values(cd, col, buffer, slice_range);
+  };
+
   switch (type) {
     case kBOOLEAN:
       if (exact_type_match) {
@@ -915,18 +1230,27 @@ size_t TypedImportBuffer::add_arrow_values(const ColumnDescriptor* cd,
     case kTINYINT:
       if (exact_type_match) {
         arrow_throw_if(col.type_id() != Type::INT8, "Expected int8 type");
+        if (append_fixed_width_values(*tinyint_buffer_)) {
+          return tinyint_buffer_->size();
+        }
       }
       return convert_arrow_val_to_import_buffer(
           cd, col, *tinyint_buffer_, slice_range, bad_rows_tracker);
     case kSMALLINT:
       if (exact_type_match) {
         arrow_throw_if(col.type_id() != Type::INT16, "Expected int16 type");
+        if (append_fixed_width_values(*smallint_buffer_)) {
+          return smallint_buffer_->size();
+        }
       }
       return convert_arrow_val_to_import_buffer(
           cd, col, *smallint_buffer_, slice_range, bad_rows_tracker);
     case kINT:
       if (exact_type_match) {
         arrow_throw_if(col.type_id() != Type::INT32, "Expected int32 type");
+        if (append_fixed_width_values(*int_buffer_)) {
+          return int_buffer_->size();
+        }
       }
       return convert_arrow_val_to_import_buffer(
           cd, col, *int_buffer_, slice_range, bad_rows_tracker);
@@ -935,18 +1259,27 @@ size_t TypedImportBuffer::add_arrow_values(const ColumnDescriptor* cd,
     case kDECIMAL:
       if (exact_type_match) {
         arrow_throw_if(col.type_id() != Type::INT64, "Expected int64 type");
+        if (append_fixed_width_values(*bigint_buffer_)) {
+          return bigint_buffer_->size();
+        }
       }
       return convert_arrow_val_to_import_buffer(
           cd, col, *bigint_buffer_, slice_range, bad_rows_tracker);
     case kFLOAT:
       if (exact_type_match) {
         arrow_throw_if(col.type_id() != Type::FLOAT, "Expected float type");
+        if (append_fixed_width_values(*float_buffer_)) {
+          return float_buffer_->size();
+        }
       }
       return convert_arrow_val_to_import_buffer(
           cd, col, *float_buffer_, slice_range, bad_rows_tracker);
     case kDOUBLE:
       if (exact_type_match) {
         arrow_throw_if(col.type_id() != Type::DOUBLE, "Expected double type");
+        if (append_fixed_width_values(*double_buffer_)) {
+          return double_buffer_->size();
+        }
       }
       return convert_arrow_val_to_import_buffer(
           cd, col, *double_buffer_, slice_range, bad_rows_tracker);
@@ -1512,63 +1845,34 @@ void Importer::set_geo_physical_import_buffer(
       is_null_geo = false;
     }
   }
-  TDatum tdd_coords;
   // Get the raw data representing [optionally compressed] non-NULL geo's coords.
   // One exception - NULL POINT geo: coords need to be processed to encode nullness
   // in a fixlen array, compressed and uncompressed.
+  std::vector<uint8_t> compressed_coords;
   if (!is_null_geo) {
-    std::vector<uint8_t> compressed_coords = Geospatial::compress_coords(coords, col_ti);
-    tdd_coords.val.arr_val.reserve(compressed_coords.size());
-    for (auto cc : compressed_coords) {
-      tdd_coords.val.arr_val.emplace_back();
-      tdd_coords.val.arr_val.back().val.int_val = cc;
-    }
+    compressed_coords = Geospatial::compress_coords(coords, col_ti);
   }
-  tdd_coords.is_null = is_null_geo;
-  import_buffers[col_idx++]->add_value(cd_coords, tdd_coords, false);
+  import_buffers[col_idx++]->addArray(
+      to_array_datum(compressed_coords, cd_coords->columnType, is_null_geo));
 
   if (col_type == kPOLYGON || col_type == kMULTIPOLYGON) {
     // Create ring_sizes array value and add it to the physical column
     auto cd_ring_sizes = catalog.getMetadataForColumn(cd->tableId, ++columnId);
-    TDatum tdd_ring_sizes;
-    tdd_ring_sizes.val.arr_val.reserve(ring_sizes.size());
-    if (!is_null_geo) {
-      for (auto ring_size : ring_sizes) {
-        tdd_ring_sizes.val.arr_val.emplace_back();
-        tdd_ring_sizes.val.arr_val.back().val.int_val = ring_size;
-      }
-    }
-    tdd_ring_sizes.is_null = is_null_geo;
-    import_buffers[col_idx++]->add_value(cd_ring_sizes, tdd_ring_sizes, false);
+    import_buffers[col_idx++]->addArray(
+        to_array_datum(ring_sizes, cd_ring_sizes->columnType, is_null_geo));
   }
 
   if (col_type == kMULTIPOLYGON) {
     // Create poly_rings array value and add it to the physical column
     auto cd_poly_rings = catalog.getMetadataForColumn(cd->tableId, ++columnId);
-    TDatum tdd_poly_rings;
-    tdd_poly_rings.val.arr_val.reserve(poly_rings.size());
-    if (!is_null_geo) {
-      for (auto num_rings : poly_rings) {
-        tdd_poly_rings.val.arr_val.emplace_back();
-        tdd_poly_rings.val.arr_val.back().val.int_val = num_rings;
-      }
-    }
-    tdd_poly_rings.is_null = is_null_geo;
-    import_buffers[col_idx++]->add_value(cd_poly_rings, tdd_poly_rings, false);
+    import_buffers[col_idx++]->addArray(
+        to_array_datum(poly_rings, cd_poly_rings->columnType, is_null_geo));
   }
 
   if (col_type == kLINESTRING || col_type == kPOLYGON || col_type == kMULTIPOLYGON) {
     auto cd_bounds = catalog.getMetadataForColumn(cd->tableId, ++columnId);
-    TDatum tdd_bounds;
-    tdd_bounds.val.arr_val.reserve(bounds.size());
-    if (!is_null_geo) {
-      for (auto b : bounds) {
-        tdd_bounds.val.arr_val.emplace_back();
-        tdd_bounds.val.arr_val.back().val.real_val = b;
-      }
-    }
-    tdd_bounds.is_null = is_null_geo;
-    import_buffers[col_idx++]->add_value(cd_bounds, tdd_bounds, false);
+    import_buffers[col_idx++]->addArray(
+        to_array_datum(bounds, cd_bounds->columnType, is_null_geo));
   }
 
   if (col_type == kPOLYGON || col_type == kMULTIPOLYGON) {
@@ -1615,20 +1919,12 @@ void Importer::set_geo_physical_import_buffer_columnar(
         is_null_geo = false;
       }
     }
-    std::vector<TDatum> td_coords_data;
+    std::vector<uint8_t> compressed_coords;
     if (!is_null_geo) {
-      std::vector<uint8_t> compressed_coords =
-          Geospatial::compress_coords(coords, col_ti);
-      for (auto const& cc : compressed_coords) {
-        TDatum td_byte;
-        td_byte.val.int_val = cc;
-        td_coords_data.push_back(td_byte);
-      }
+      compressed_coords = Geospatial::compress_coords(coords, col_ti);
     }
-    TDatum tdd_coords;
-    tdd_coords.val.arr_val = td_coords_data;
-    tdd_coords.is_null = is_null_geo;
-    import_buffers[col_idx]->add_value(cd_coords, tdd_coords, false);
+    import_buffers[col_idx]->addArray(
+        to_array_datum(compressed_coords, cd_coords->columnType, is_null_geo));
   }
   col_idx++;
 
@@ -1644,16 +1940,8 @@ void Importer::set_geo_physical_import_buffer_columnar(
         // Check for NULL geo
         is_null_geo = ring_sizes.empty();
       }
-      std::vector<TDatum> td_ring_sizes;
-      for (auto const& ring_size : ring_sizes) {
-        TDatum td_ring_size;
-        td_ring_size.val.int_val = ring_size;
-        td_ring_sizes.push_back(td_ring_size);
-      }
-      TDatum tdd_ring_sizes;
-      tdd_ring_sizes.val.arr_val = td_ring_sizes;
-      tdd_ring_sizes.is_null = is_null_geo;
-      import_buffers[col_idx]->add_value(cd_ring_sizes, tdd_ring_sizes, false);
+      import_buffers[col_idx]->addArray(
+          to_array_datum(ring_sizes, cd_ring_sizes->columnType, is_null_geo));
     }
     col_idx++;
   }
@@ -1670,16 +1958,8 @@ void Importer::set_geo_physical_import_buffer_columnar(
         // Check for NULL geo
         is_null_geo = poly_rings.empty();
       }
-      std::vector<TDatum> td_poly_rings;
-      for (auto const& num_rings : poly_rings) {
-        TDatum td_num_rings;
-        td_num_rings.val.int_val = num_rings;
-        td_poly_rings.push_back(td_num_rings);
-      }
-      TDatum tdd_poly_rings;
-      tdd_poly_rings.val.arr_val = td_poly_rings;
-      tdd_poly_rings.is_null = is_null_geo;
-      import_buffers[col_idx]->add_value(cd_poly_rings, tdd_poly_rings, false);
+      import_buffers[col_idx]->addArray(
+          to_array_datum(poly_rings, cd_poly_rings->columnType, is_null_geo));
     }
     col_idx++;
   }
@@ -1695,16 +1975,8 @@ void Importer::set_geo_physical_import_buffer_columnar(
         // Check for NULL geo
         is_null_geo = (bounds.empty() || bounds[0] == NULL_ARRAY_DOUBLE);
       }
-      std::vector<TDatum> td_bounds_data;
-      for (auto const& b : bounds) {
-        TDatum td_double;
-        td_double.val.real_val = b;
-        td_bounds_data.push_back(td_double);
-      }
-      TDatum tdd_bounds;
-      tdd_bounds.val.arr_val = td_bounds_data;
-      tdd_bounds.is_null = is_null_geo;
-      import_buffers[col_idx]->add_value(cd_bounds, tdd_bounds, false);
+      import_buffers[col_idx]->addArray(
+          to_array_datum(bounds, cd_bounds->columnType, is_null_geo));
     }
     col_idx++;
   }
@@ -1894,6 +2166,59 @@ static ImportStatus import_thread_delimited(
     for (const auto& p : import_buffers) {
       p->clear();
     }
+    // Tables of scalar columns are converted a column at a time, over blocks of rows.
+    const bool convert_by_column =
+        g_enable_columnar_delimited_import && !copy_params.geo_explode_collections &&
+        std::none_of(col_descs.begin(), col_descs.end(), [](const auto cd) {
+          return cd->columnType.is_array() || cd->columnType.is_geometry();
+        });
+    std::vector<std::string_view> block_fields;
+    std::vector<std::unique_ptr<char[]>> block_tmp_buffers;
+    auto convert_block = [&]() {
+      const auto block_num_rows = block_fields.size() / num_cols;
+      std::map<size_t, std::string> bad_rows;
+      size_t col_idx = 0;
+      for (const auto cd : col_descs) {
+        import_buffers[col_idx]->add_values(
+            cd, block_fields, num_cols, col_idx, copy_params, bad_rows);
+        ++col_idx;
+      }
+      if (!bad_rows.empty()) {
+        // The import buffers hold the rows completed so far followed by the block.
+        BadRowsTracker bad_rows_tracker;
+        for (const auto& bad_row : bad_rows) {
+          bad_rows_tracker.rows.insert(thread_import_status.rows_completed +
+                                       bad_row.first);
+        }
+        col_idx = 0;
+        for (const auto cd : col_descs) {
+          import_buffers[col_idx]->del_values(cd->columnType.get_type(),
+                                              &bad_rows_tracker);
+          ++col_idx;
+        }
+      }
+      thread_import_status.rows_completed += block_num_rows - bad_rows.size();
+      for (const auto& [bad_row, error] : bad_rows) {
+        const auto row_begin = block_fields.begin() + bad_row * num_cols;
+        thread_import_status.rows_rejected++;
+        LOG(ERROR) << "Input exception thrown: " << error << ". Row discarded. Data: "
+                   << shared::printContainer(std::vector<std::string_view>(
+                          row_begin, row_begin + num_cols));
+        if (thread_import_status.rows_rejected > copy_params.max_reject) {
+          LOG(ERROR) << "Load was cancelled due to max reject rows being reached";
+          thread_import_status.load_failed = true;
+          thread_import_status.load_msg =
+              "Load was cancelled due to max reject rows being reached";
+          break;
+        }
+      }
+      block_fields.clear();
+      block_tmp_buffers.clear();
+      if (checkInterrupt(query_session, executor)) {
+        thread_import_status.load_failed = true;
+        thread_import_status.load_msg = "Table load was cancelled via Query Interrupt";
+      }
+    };
     std::vector<std::string_view> row;
     size_t row_index_plus_one = 0;
     for (const char* p = thread_buf; p < thread_buf_end; p++) {
@@ -1936,6 +2261,21 @@ static ImportStatus import_thread_delimited(
         continue;
       }
 
+      if (convert_by_column) {
+        // The fields may point into tmp_buffers, which have to outlive the block.
+        block_fields.insert(block_fields.end(), row.begin(), row.end());
+        std::move(tmp_buffers.begin(),
+                  tmp_buffers.end(),
+                  std::back_inserter(block_tmp_buffers));
+        if (block_fields.size() >= num_cols * delimited_import_block_rows) {
+          us = measure<std::chrono::microseconds>::execution(convert_block);
+          if (thread_import_status.load_failed) {
+            break;
+          }
+        }
+        continue;
+      }
+
       //
       // lambda for importing a row (perhaps multiple times if exploding a collection)
       //
@@ -2193,6 +2533,9 @@ static ImportStatus import_thread_delimited(
         break;
       }
     }  // end thread
+    if (!block_fields.empty() && !thread_import_status.load_failed) {
+      us = measure<std::chrono::microseconds>::execution(convert_block);
+    }
     total_str_to_val_time_us += us;
     if (!thread_import_status.load_failed && thread_import_status.rows_completed > 0) {
       load_ms = measure<>::execution([&]() {
@@ -2391,38 +2734,20 @@ static ImportStatus import_thread_shapefile(
             // create coords array value and add it to the physical column
             ++cd_it;
             auto cd_coords = *cd_it;
-            std::vector<TDatum> td_coord_data;
+            std::vector<uint8_t> compressed_coords;
             if (!is_null_geo) {
-              std::vector<uint8_t> compressed_coords =
-                  Geospatial::compress_coords(coords, col_ti);
-              for (auto cc : compressed_coords) {
-                TDatum td_byte;
-                td_byte.val.int_val = cc;
-                td_coord_data.push_back(td_byte);
-              }
+              compressed_coords = Geospatial::compress_coords(coords, col_ti);
             }
-            TDatum tdd_coords;
-            tdd_coords.val.arr_val = td_coord_data;
-            tdd_coords.is_null = is_null_geo;
-            import_buffers[col_idx]->add_value(cd_coords, tdd_coords, false);
+            import_buffers[col_idx]->addArray(
+                to_array_datum(compressed_coords, cd_coords->columnType, is_null_geo));
             ++col_idx;
 
             if (col_type == kPOLYGON || col_type == kMULTIPOLYGON) {
               // Create ring_sizes array value and add it to the physical column
               ++cd_it;
               auto cd_ring_sizes = *cd_it;
-              std::vector<TDatum> td_ring_sizes;
-              if (!is_null_geo) {
-                for (auto ring_size : ring_sizes) {
-                  TDatum td_ring_size;
-                  td_ring_size.val.int_val = ring_size;
-                  td_ring_sizes.push_back(td_ring_size);
-                }
-              }
-              TDatum tdd_ring_sizes;
-              tdd_ring_sizes.val.arr_val = td_ring_sizes;
-              tdd_ring_sizes.is_null = is_null_geo;
-              import_buffers[col_idx]->add_value(cd_ring_sizes, tdd_ring_sizes, false);
+              import_buffers[col_idx]->addArray(
+                  to_array_datum(ring_sizes, cd_ring_sizes->columnType, is_null_geo));
               ++col_idx;
             }
 
@@ -2430,18 +2755,8 @@ static ImportStatus import_thread_shapefile(
               // Create poly_rings array value and add it to the physical column
               ++cd_it;
               auto cd_poly_rings = *cd_it;
-              std::vector<TDatum> td_poly_rings;
-              if (!is_null_geo) {
-                for (auto num_rings : poly_rings) {
-                  TDatum td_num_rings;
-                  td_num_rings.val.int_val = num_rings;
-                  td_poly_rings.push_back(td_num_rings);
-                }
-              }
-              TDatum tdd_poly_rings;
-              tdd_poly_rings.val.arr_val = td_poly_rings;
-              tdd_poly_rings.is_null = is_null_geo;
-              import_buffers[col_idx]->add_value(cd_poly_rings, tdd_poly_rings, false);
+              import_buffers[col_idx]->addArray(
+                  to_array_datum(poly_rings, cd_poly_rings->columnType, is_null_geo));
               ++col_idx;
             }
 
@@ -2450,18 +2765,8 @@ static ImportStatus import_thread_shapefile(
               // Create bounds array value and add it to the physical column
               ++cd_it;
               auto cd_bounds = *cd_it;
-              std::vector<TDatum> td_bounds_data;
-              if (!is_null_geo) {
-                for (auto b : bounds) {
-                  TDatum td_double;
-                  td_double.val.real_val = b;
-                  td_bounds_data.push_back(td_double);
-                }
-              }
-              TDatum tdd_bounds;
-              tdd_bounds.val.arr_val = td_bounds_data;
-              tdd_bounds.is_null = is_null_geo;
-              import_buffers[col_idx]->add_value(cd_bounds, tdd_bounds, false);
+              import_buffers[col_idx]->addArray(
+                  to_array_datum(bounds, cd_bounds->columnType, is_null_geo));
               ++col_idx;
             }
 
@@ -2641,7 +2946,10 @@ bool Loader::load(const std::vector<std::unique_ptr<TypedImportBuffer>>& import_
 
 namespace {
 
-int64_t int_value_at(const TypedImportBuffer& import_buffer, const size_t index) {
+// Below this many rows, a batch is split across and loaded into the shards serially.
+constexpr size_t parallel_shard_load_min_rows{10000};
+
+const int8_t* get_int_values_buffer(const TypedImportBuffer& import_buffer) {
   const auto& ti = import_buffer.getTypeInfo();
   const int8_t* values_buffer{nullptr};
   if (ti.is_string()) {
@@ -2651,7 +2959,90 @@ int64_t int_value_at(const TypedImportBuffer& import_buffer, const size_t index)
     values_buffer = import_buffer.getAsBytes();
   }
   CHECK(values_buffer);
-  const int logical_size = ti.is_string() ? ti.get_size() : ti.get_logical_size();
+  return values_buffer;
+}
+
+int get_int_values_size(const TypedImportBuffer& import_buffer) {
+  const auto& ti = import_buffer.getTypeInfo();
+  return ti.is_string() ? ti.get_size() : ti.get_logical_size();
+}
+
+template <typename T>
+void compute_shards(const int8_t* values_buffer,
+                    const size_t row_count,
+                    const size_t shard_count,
+                    std::vector<size_t>& shard_for_row) {
+  const auto values = reinterpret_cast<const T*>(values_buffer);
+  for (size_t i = 0; i < row_count; ++i) {
+    const int64_t key = values[i];
+    shard_for_row[i] = SHARD_FOR_KEY(key, shard_count);
+  }
+}
+
+std::vector<size_t> get_shard_for_row(const TypedImportBuffer& shard_column_buffer,
+                                      const size_t row_count,
+                                      const size_t shard_count) {
+  std::vector<size_t> shard_for_row(row_count);
+  const auto values_buffer = get_int_values_buffer(shard_column_buffer);
+  const int logical_size = get_int_values_size(shard_column_buffer);
+  switch (logical_size) {
+    case 1:
+      compute_shards<int8_t>(values_buffer, row_count, shard_count, shard_for_row);
+      break;
+    case 2:
+      compute_shards<int16_t>(values_buffer, row_count, shard_count, shard_for_row);
+      break;
+    case 4:
+      compute_shards<int32_t>(values_buffer, row_count, shard_count, shard_for_row);
+      break;
+    case 8:
+      compute_shards<int64_t>(values_buffer, row_count, shard_count, shard_for_row);
+      break;
+    default:
+      LOG(FATAL) << "Unexpected size for shard key: " << logical_size;
+  }
+  return shard_for_row;
+}
+
+size_t get_shard_load_thread_count(const size_t row_count, const size_t shard_count) {
+  if (row_count < parallel_shard_load_min_rows) {
+    return 1;
+  }
+  return std::min(
+      shard_count,
+      std::min(static_cast<size_t>(cpu_threads()), g_max_import_threads));
+}
+
+// Runs shard_func for every shard, on up to thread_count threads.
+template <typename SHARD_FUNC>
+void for_each_shard(const size_t shard_count,
+                    const size_t thread_count,
+                    SHARD_FUNC shard_func) {
+  if (thread_count <= 1) {
+    for (size_t shard = 0; shard < shard_count; ++shard) {
+      shard_func(shard);
+    }
+    return;
+  }
+  std::vector<std::future<void>> worker_threads;
+  for (size_t thread_idx = 0; thread_idx < thread_count; ++thread_idx) {
+    worker_threads.push_back(threadpool::async([&, thread_idx]() {
+      for (size_t shard = thread_idx; shard < shard_count; shard += thread_count) {
+        shard_func(shard);
+      }
+    }));
+  }
+  for (auto& child : worker_threads) {
+    child.wait();
+  }
+  for (auto& child : worker_threads) {
+    child.get();
+  }
+}
+
+int64_t int_value_at(const TypedImportBuffer& import_buffer, const size_t index) {
+  const auto values_buffer = get_int_values_buffer(import_buffer);
+  const int logical_size = get_int_values_size(import_buffer);
   switch (logical_size) {
     case 1: {
       return values_buffer[index];
@@ -2789,13 +3180,21 @@ void Loader::distributeToShardsExistingColumns(
     shard_column_input_buffer->addDictEncodedString(*payloads_ptr);
   }
 
+  const auto shard_for_row =
+      get_shard_for_row(*shard_column_input_buffer, row_count, shard_count);
+  std::vector<std::vector<size_t>> shard_rows(shard_count);
   for (size_t i = 0; i < row_count; ++i) {
-    const size_t shard =
-        SHARD_FOR_KEY(int_value_at(*shard_column_input_buffer, i), shard_count);
-    auto& shard_output_buffers = all_shard_import_buffers[shard];
-    fillShardRow(i, shard_output_buffers, import_buffers);
-    ++all_shard_row_counts[shard];
-  }
+    shard_rows[shard_for_row[i]].push_back(i);
+  }
+  // every shard has its own output buffers, the input buffers are only read
+  for_each_shard(
+      shard_count, get_shard_load_thread_count(row_count, shard_count), [&](auto shard) {
+        auto& shard_output_buffers = all_shard_import_buffers[shard];
+        for (const auto row_index : shard_rows[shard]) {
+          fillShardRow(row_index, shard_output_buffers, import_buffers);
+        }
+        all_shard_row_counts[shard] = shard_rows[shard].size();
+      });
 }
 
 void Loader::distributeToShardsNewColumns(
@@ -2871,15 +3270,22 @@ bool Loader::loadImpl(
                        row_count,
                        shard_tables.size(),
                        session_info);
-    bool success = true;
-    for (size_t shard_idx = 0; shard_idx < shard_tables.size(); ++shard_idx) {
-      success = success && loadToShard(all_shard_import_buffers[shard_idx],
-                                       all_shard_row_counts[shard_idx],
-                                       shard_tables[shard_idx],
-                                       checkpoint,
-                                       session_info);
-    }
-    return success;
+    // The shards are separate physical tables with their own fragmenters, so they are
+    // loaded concurrently. loadToShard() serializes the dictionary encoding.
+    std::vector<char> shard_success(shard_tables.size(), false);
+    for_each_shard(shard_tables.size(),
+                   get_shard_load_thread_count(row_count, shard_tables.size()),
+                   [&](auto shard_idx) {
+                     shard_success[shard_idx] =
+                         loadToShard(all_shard_import_buffers[shard_idx],
+                                     all_shard_row_counts[shard_idx],
+                                     shard_tables[shard_idx],
+                                     checkpoint,
+                                     session_info);
+                   });
+    return std::all_of(shard_success.begin(),
+                       shard_success.end(),
+                       [](const auto success) { return success; });
   }
   return loadToShard(import_buffers, row_count, table_desc_, checkpoint, session_info);
 }
@@ -2898,7 +3304,7 @@ std::vector<DataBlockPtr> TypedImportBuffer::get_data_block_pointers(
 
       encoded_data_block_ptrs_futures.emplace_back(std::make_pair(
           buf_idx,
-          std::async(std::launch::async, [buf_idx, &import_buffers, string_payload_ptr] {
+          threadpool::async([buf_idx, &import_buffers, string_payload_ptr] {
             import_buffers[buf_idx]->addDictEncodedString(*string_payload_ptr);
             return import_buffers[buf_idx]->getStringDictBuffer();
           })));
@@ -2956,6 +3362,7 @@ bool Loader::loadToShard(
   ins_data.numRows = row_count;
   bool success = false;
   try {
+    widenDictionaryEncodings(import_buffers);
     ins_data.data = TypedImportBuffer::get_data_block_pointers(import_buffers);
   } catch (std::exception& e) {
     std::ostringstream oss;
@@ -2977,6 +3384,9 @@ bool Loader::loadToShard(
   } else {
     ins_data.is_default.resize(ins_data.columnIds.size(), false);
   }
+  // Taken before releasing loader_lock, so that widening an encoding waits for the
+  // batches encoded at the old width.
+  mapd_shared_lock<mapd_shared_mutex> insert_lock(insert_mutex_);
   // release loader_lock so that in InsertOrderFragmenter::insertDat
   // we can have multiple threads sort/shuffle InsertData
   loader_lock.unlock();
@@ -2994,6 +3404,7 @@ bool Loader::loadToShard(
           << shard_table->tableName << " issue was " << e.what();
 
       LOG(ERROR) << oss.str();
+      insert_lock.unlock();
       loader_lock.lock();
       error_msg_ = oss.str();
       success = false;
@@ -3002,6 +3413,135 @@ bool Loader::loadToShard(
   return success;
 }
 
+bool Loader::loadDataBlocks(const std::vector<DataBlockPtr>& data_blocks,
+                            const size_t row_count) {
+  CHECK(!table_desc_->nShards);
+  CHECK(!load_callback_);
+  CHECK(!isAddingColumns());
+  Fragmenter_Namespace::InsertData ins_data(insert_data_);
+  CHECK_EQ(data_blocks.size(), ins_data.columnIds.size());
+  ins_data.numRows = row_count;
+  ins_data.data = data_blocks;
+  ins_data.is_default.resize(ins_data.columnIds.size(), false);
+  mapd_shared_lock<mapd_shared_mutex> insert_lock(insert_mutex_);
+  try {
+    table_desc_->fragmenter->insertDataNoCheckpoint(ins_data);
+  } catch (std::exception& e) {
+    std::ostringstream oss;
+    oss << "Fragmenter Insert Exception when processing Table  "
+        << table_desc_->tableName << " issue was " << e.what();
+    LOG(ERROR) << oss.str();
+    insert_lock.unlock();
+    std::lock_guard<std::mutex> loader_lock(loader_mutex_);
+    error_msg_ = oss.str();
+    return false;
+  }
+  return true;
+}
+
+namespace {
+
+// Ids a dictionary encoding of the given width holds, the largest value is the null.
+size_t get_dict_encoding_capacity(const int size) {
+  switch (size) {
+    case 1:
+      return max_valid_int_value<uint8_t>() + 1;
+    case 2:
+      return max_valid_int_value<uint16_t>() + 1;
+    default:
+      return max_valid_int_value<int32_t>() + 1;
+  }
+}
+
+}  // namespace
+
+void Loader::widenDictionaryEncodings(const OneShardBuffers& import_buffers) {
+  if (!g_enable_dictionary_encoding_widening || table_desc_->nShards ||
+      isAddingColumns() || !catalog_.getStringDictionaryHosts().empty()) {
+    return;
+  }
+  for (const auto& import_buffer : import_buffers) {
+    const auto cd = import_buffer->getColumnDesc();
+    const auto& ti = cd->columnType;
+    if (!ti.is_dict_encoded_string() || ti.get_size() == 4) {
+      continue;
+    }
+    const auto string_dict = getStringDict(cd);
+    CHECK(string_dict);
+    const auto& strings = *import_buffer->getStringBuffer();
+    const auto str_count = string_dict->storageEntryCount();
+    if (str_count + strings.size() <= get_dict_encoding_capacity(ti.get_size())) {
+      continue;
+    }
+    std::unordered_set<std::string_view> batch_strings;
+    size_t new_str_count{0};
+    for (const auto& str : strings) {
+      if (!str.empty() && batch_strings.insert(str).second &&
+          string_dict->getIdOfString(str) == StringDictionary::INVALID_STR_ID) {
+        ++new_str_count;
+      }
+    }
+    auto size = ti.get_size();
+    while (size < 4 && str_count + new_str_count > get_dict_encoding_capacity(size)) {
+      size *= 2;
+    }
+    if (size == ti.get_size()) {
+      continue;
+    }
+    // The other columns of a shared dictionary are in tables this load doesn't lock.
+    const auto dd = catalog_.getMetadataForDict(ti.get_comp_param(), false);
+    CHECK(dd);
+    if (dd->refcount != 1) {
+      continue;
+    }
+    widenDictionaryEncoding(cd, size);
+  }
+}
+
+void Loader::widenDictionaryEncoding(const ColumnDescriptor* cd, const int size) {
+  const auto db_id = catalog_.getDatabaseId();
+  const auto table_id = table_desc_->tableId;
+  const auto old_type = cd->columnType;
+  LOG(INFO) << "Widening the dictionary encoding of column " << cd->columnName
+            << " of table " << table_desc_->tableName << " from "
+            << old_type.get_size() * 8 << " to " << size * 8 << " bits.";
+  // The caller holds the insert lock of the table. This waits for the batches already
+  // encoded at the old width, whose inserts may lock the table data, then locks out
+  // queries.
+  mapd_unique_lock<mapd_shared_mutex> insert_lock(insert_mutex_);
+  const auto table_lock =
+      lockmgr::TableDataLockMgr::getWriteLockForTable({db_id, table_id});
+  const auto table_epochs = catalog_.getTableEpochs(db_id, table_id);
+  catalog_.setDictionaryEncodingSize(cd, size);
+  try {
+    UpdelRoll updel_roll;
+    updel_roll.catalog = &catalog_;
+    updel_roll.logicalTableId = table_id;
+    updel_roll.memoryLevel = Data_Namespace::MemoryLevel::CPU_LEVEL;
+    updel_roll.table_descriptor = table_desc_;
+    for (const auto& fragment :
+         table_desc_->fragmenter->getFragmentsForQuery().fragments) {
+      table_desc_->fragmenter->widenDictionaryIds(&catalog_,
+                                                  table_desc_,
+                                                  cd,
+                                                  fragment.fragmentId,
+                                                  old_type,
+                                                  updel_roll.memoryLevel,
+                                                  updel_roll);
+    }
+    updel_roll.stageUpdate();
+    // The fragmenter appends to the disk copies of the chunks, which take the new width
+    // on checkpoint.
+    catalog_.checkpoint(table_id);
+  } catch (...) {
+    catalog_.setTableEpochsLogExceptions(db_id, table_epochs);
+    catalog_.setDictionaryEncodingSize(cd, old_type.get_size());
+    throw;
+  }
+  widened_dictionary_sizes_.emplace(cd, old_type.get_size());
+  UpdateTriggeredCacheInvalidator::invalidateCaches();
+}
+
 void Loader::dropColumns(const std::vector<int>& columnIds) {
   std::vector<const TableDescriptor*> table_descs(1, table_desc_);
   if (table_desc_->nShards) {
@@ -3597,57 +4137,6 @@ void Detector::import_local_parquet(const std::string& file_path,
   }
 }
 
-template <typename DATA_TYPE>
-auto TypedImportBuffer::del_values(
-    std::vector<DATA_TYPE>& buffer,
-    import_export::BadRowsTracker* const bad_rows_tracker) {
-  const auto old_size = buffer.size();
-  // erase backward to minimize memory movement overhead
-  for (auto rit = bad_rows_tracker->rows.crbegin(); rit != bad_rows_tracker->rows.crend();
-       ++rit) {
-    buffer.erase(buffer.begin() + *rit);
-  }
-  return std::make_tuple(old_size, buffer.size());
-}
-
-auto TypedImportBuffer::del_values(const SQLTypes type,
-                                   BadRowsTracker* const bad_rows_tracker) {
-  switch (type) {
-    case kBOOLEAN:
-      return del_values(*bool_buffer_, bad_rows_tracker);
-    case kTINYINT:
-      return del_values(*tinyint_buffer_, bad_rows_tracker);
-    case kSMALLINT:
-      return del_values(*smallint_buffer_, bad_rows_tracker);
-    case kINT:
-      return del_values(*int_buffer_, bad_rows_tracker);
-    case kBIGINT:
-    case kNUMERIC:
-    case kDECIMAL:
-    case kTIME:
-    case kTIMESTAMP:
-    case kDATE:
-      return del_values(*bigint_buffer_, bad_rows_tracker);
-    case kFLOAT:
-      return del_values(*float_buffer_, bad_rows_tracker);
-    case kDOUBLE:
-      return del_values(*double_buffer_, bad_rows_tracker);
-    case kTEXT:
-    case kVARCHAR:
-    case kCHAR:
-      return del_values(*string_buffer_, bad_rows_tracker);
-    case kPOINT:
-    case kLINESTRING:
-    case kPOLYGON:
-    case kMULTIPOLYGON:
-      return del_values(*geo_string_buffer_, bad_rows_tracker);
-    case kARRAY:
-      return del_values(*array_buffer_, bad_rows_tracker);
-    default:
-      throw std::runtime_error("Invalid Type");
-  }
-}
-
 void Importer::import_local_parquet(const std::string& file_path,
                                     const Catalog_Namespace::SessionInfo* session_info) {
   std::shared_ptr<arrow::io::ReadableFile> infile;
@@ -3828,6 +4317,192 @@ void Importer::import_local_parquet(const std::string& file_path,
             << " took " << (double)ms_load_a_file / 1000.0 << " secs";
 }
 
+namespace {
+
+// Whether a parquet encoder fills a chunk buffer of the column in the layout InsertData
+// takes for it: compressed fixed length columns are given to the fragmenter uncompressed,
+// and arrays and geo columns as datums.
+bool is_chunk_loader_importable(const ColumnDescriptor* cd) {
+  const auto& ti = cd->columnType;
+  if (ti.is_array() || ti.is_geometry()) {
+    return false;
+  }
+  if (ti.is_string()) {
+    return ti.get_compression() == kENCODING_NONE ||
+           (ti.get_compression() == kENCODING_DICT && ti.get_size() == 4);
+  }
+  return ti.get_compression() == kENCODING_NONE;
+}
+
+}  // namespace
+
+bool Importer::import_local_parquet_with_chunk_loader(
+    const std::vector<std::string>& file_paths,
+    const std::vector<Catalog_Namespace::TableEpochInfo>& table_epochs,
+    const Catalog_Namespace::SessionInfo* session_info) {
+  // Loaders of other kinds, like distributed ones, insert through their own load().
+  if (file_paths.empty() || typeid(*loader) != typeid(Loader) ||
+      loader->getTableDesc()->nShards || loader->isAddingColumns()) {
+    return false;
+  }
+  // column_list has no $deleted
+  const auto& column_list = get_column_descs();
+  if (!std::all_of(column_list.begin(), column_list.end(), is_chunk_loader_importable)) {
+    return false;
+  }
+  std::shared_ptr<arrow::fs::FileSystem> file_system =
+      std::make_shared<arrow::fs::LocalFileSystem>();
+  foreign_storage::FileReaderMap file_reader_cache;
+  // Each row group is loaded on its own, the threads take them in turn across files.
+  std::vector<foreign_storage::RowGroupInterval> row_groups;
+  int64_t total_row_count{0};
+  for (const auto& file_path : file_paths) {
+    const auto reader = file_reader_cache.insert(file_path, file_system);
+    const auto file_metadata = reader->parquet_reader()->metadata();
+    const auto schema = file_metadata->schema();
+    if (schema->num_columns() != static_cast<int>(column_list.size())) {
+      return false;
+    }
+    int parquet_column_index = 0;
+    for (const auto cd : column_list) {
+      if (!foreign_storage::LazyParquetChunkLoader::isColumnMappingSupported(
+              cd, schema->Column(parquet_column_index++))) {
+        return false;
+      }
+    }
+    for (int row_group = 0; row_group < file_metadata->num_row_groups(); ++row_group) {
+      row_groups.push_back({file_path, row_group, row_group});
+    }
+    total_row_count += file_metadata->num_rows();
+  }
+  // checkpoint() checkpoints the string dictionaries through the first import buffers.
+  import_buffers_vec.resize(1);
+  import_buffers_vec[0].clear();
+  for (const auto cd : column_list) {
+    import_buffers_vec[0].emplace_back(
+        new TypedImportBuffer(cd, loader->getStringDict(cd)));
+  }
+  max_threads = copy_params.threads
+                    ? copy_params.threads
+                    : std::min(static_cast<size_t>(cpu_threads()), g_max_import_threads);
+  VLOG(1) << "Parquet chunk loader import # threads: " << max_threads;
+
+  Executor* executor = Executor::getExecutor(Executor::UNITARY_EXECUTOR_ID).get();
+  const auto query_session = session_info ? session_info->get_session_id() : "";
+  std::atomic<size_t> next_row_group_idx{0};
+  std::optional<std::string> encoder_error;
+  auto load_row_groups = [&] {
+    foreign_storage::LazyParquetChunkLoader chunk_loader(file_system, &file_reader_cache);
+    try {
+      for (auto row_group_idx = next_row_group_idx++; row_group_idx < row_groups.size();
+           row_group_idx = next_row_group_idx++) {
+        {
+          mapd_shared_lock<mapd_shared_mutex> read_lock(import_mutex_);
+          if (import_status_.load_failed) {
+            return;
+          }
+        }
+        if (UNLIKELY(checkInterrupt(query_session, executor))) {
+          mapd_lock_guard<mapd_shared_mutex> write_lock(import_mutex_);
+          import_status_.load_failed = true;
+          import_status_.load_msg = "Table load was cancelled via Query Interrupt";
+          return;
+        }
+        const std::vector<foreign_storage::RowGroupInterval> row_group_interval{
+            row_groups[row_group_idx]};
+        std::list<foreign_storage::ForeignStorageBuffer> buffers;
+        std::list<std::vector<std::string>> none_encoded_strings;
+        std::vector<DataBlockPtr> data_blocks;
+        std::optional<size_t> row_count;
+        int parquet_column_index = 0;
+        for (const auto cd : column_list) {
+          std::list<Chunk_NS::Chunk> chunks;
+          auto& chunk = chunks.emplace_back(cd);
+          auto data_buffer = &buffers.emplace_back();
+          chunk.setBuffer(data_buffer);
+          Data_Namespace::AbstractBuffer* index_buffer{nullptr};
+          if (cd->columnType.is_varlen_indeed()) {
+            index_buffer = &buffers.emplace_back();
+            chunk.setIndexBuffer(index_buffer);
+          }
+          chunk.initEncoder();
+          chunk_loader.loadChunk(row_group_interval,
+                                 parquet_column_index++,
+                                 chunks,
+                                 loader->getStringDict(cd));
+          DataBlockPtr data_block;
+          size_t column_row_count{0};
+          if (index_buffer) {
+            // The fragmenter takes none encoded strings as strings, empty ones are nulls.
+            const auto offsets =
+                reinterpret_cast<const StringOffsetT*>(index_buffer->getMemoryPtr());
+            const auto chars = reinterpret_cast<const char*>(data_buffer->getMemoryPtr());
+            const auto offset_count = index_buffer->size() / sizeof(StringOffsetT);
+            column_row_count = offset_count ? offset_count - 1 : 0;
+            auto& strings = none_encoded_strings.emplace_back();
+            strings.reserve(column_row_count);
+            for (size_t i = 0; i < column_row_count; ++i) {
+              strings.emplace_back(chars + offsets[i], offsets[i + 1] - offsets[i]);
+            }
+            data_block.stringsPtr = &strings;
+          } else {
+            column_row_count = data_buffer->size() / cd->columnType.get_size();
+            data_block.numbersPtr = data_buffer->getMemoryPtr();
+          }
+          if (row_count) {
+            CHECK_EQ(*row_count, column_row_count);
+          }
+          row_count = column_row_count;
+          data_blocks.push_back(data_block);
+        }
+        CHECK(row_count);
+        if (*row_count && !loader->loadDataBlocks(data_blocks, *row_count)) {
+          mapd_lock_guard<mapd_shared_mutex> write_lock(import_mutex_);
+          import_status_.load_failed = true;
+          import_status_.load_msg = loader->getErrorMessage();
+          return;
+        }
+        mapd_lock_guard<mapd_shared_mutex> write_lock(import_mutex_);
+        import_status_.rows_completed += *row_count;
+        import_status_.rows_estimated =
+            std::max<size_t>(import_status_.rows_estimated, total_row_count);
+      }
+    } catch (const std::exception& e) {
+      // A value the encoders reject, e.g. a null in a not null column, stops the load,
+      // the per-value import then deals with it the way it does with any bad row.
+      mapd_lock_guard<mapd_shared_mutex> write_lock(import_mutex_);
+      import_status_.load_failed = true;
+      import_status_.load_msg = e.what();
+      encoder_error = e.what();
+    }
+  };
+  auto ms_load_files = measure<>::execution([&]() {
+    std::vector<std::future<void>> futures;
+    const auto thread_count = std::min<size_t>(max_threads, row_groups.size());
+    for (size_t i = 0; i < thread_count; ++i) {
+      futures.emplace_back(std::async(std::launch::async, load_row_groups));
+    }
+    for (auto& future : futures) {
+      future.get();
+    }
+  });
+  LOG(INFO) << "Import " << total_row_count << " rows of " << file_paths.size()
+            << " parquet files over " << row_groups.size() << " row groups took "
+            << (double)ms_load_files / 1000.0 << " secs";
+  if (encoder_error) {
+    LOG(WARNING) << "Importing the parquet files value by value after the parquet chunk "
+                    "loader failed: "
+                 << *encoder_error;
+    loader->setTableEpochs(table_epochs);
+    // The rollback dropped the fragmenter of the table, the loader inserts through it.
+    loader->getCatalog().getMetadataForTable(loader->getTableDesc()->tableId);
+    mapd_lock_guard<mapd_shared_mutex> write_lock(import_mutex_);
+    import_status_ = ImportStatus();
+    return false;
+  }
+  return true;
+}
+
 void DataStreamSink::import_parquet(std::vector<std::string>& file_paths,
                                     const Catalog_Namespace::SessionInfo* session_info) {
   auto importer = dynamic_cast<Importer*>(this);
@@ -3835,6 +4510,18 @@ void DataStreamSink::import_parquet(std::vector<std::string>& file_paths,
                                : std::vector<Catalog_Namespace::TableEpochInfo>{};
   try {
     std::exception_ptr teptr;
+    const bool all_local_files =
+        std::none_of(file_paths.begin(), file_paths.end(), [](const auto& file_path) {
+          std::map<int, std::string> url_parts;
+          Archive::parse_url(file_path, url_parts);
+          return "s3" == url_parts[2];
+        });
+    if (importer && g_enable_parquet_import_chunk_loader && all_local_files &&
+        importer->import_local_parquet_with_chunk_loader(
+            file_paths, table_epochs, session_info)) {
+      importer->checkpoint(table_epochs);
+      return;
+    }
     // file_paths may contain one local file path, a list of local file paths
     // or a s3/hdfs/... url that may translate to 1 or 1+ remote object keys.
     for (auto const& file_path : file_paths) {
@@ -4277,18 +4964,17 @@ ImportStatus Importer::importDelimited(
       stack_thread_ids.pop();
       // LOG(INFO) << " stack_thread_ids.pop " << thread_id << std::endl;
 
-      threads.push_back(std::async(std::launch::async,
-                                   import_thread_delimited,
-                                   thread_id,
-                                   this,
-                                   std::move(scratch_buffer),
-                                   begin_pos,
-                                   end_pos,
-                                   end_pos,
-                                   columnIdToRenderGroupAnalyzerMap,
-                                   first_row_index_this_buffer,
-                                   session_info,
-                                   executor));
+      threads.push_back(threadpool::async(import_thread_delimited,
+                                          thread_id,
+                                          this,
+                                          std::move(scratch_buffer),
+                                          begin_pos,
+                                          end_pos,
+                                          end_pos,
+                                          columnIdToRenderGroupAnalyzerMap,
+                                          first_row_index_this_buffer,
+                                          session_info,
+                                          executor));
 
       first_row_index_this_buffer += num_rows_this_buffer;
 
@@ -4406,6 +5092,11 @@ std::vector<Catalog_Namespace::TableEpochInfo> Loader::getTableEpochs() const {
 void Loader::setTableEpochs(
     const std::vector<Catalog_Namespace::TableEpochInfo>& table_epochs) {
   getCatalog().setTableEpochs(getCatalog().getCurrentDB().dbId, table_epochs);
+  // The chunks are back at the widths the table had before the load.
+  for (const auto& [cd, size] : widened_dictionary_sizes_) {
+    getCatalog().setDictionaryEncodingSize(cd, size);
+  }
+  widened_dictionary_sizes_.clear();
 }
 
 /* static */
@@ -5063,6 +5754,53 @@ ImportStatus Importer::importGDAL(ColumnNameToSourceNameMapType columnNameToSour
     }
   }
 
+  // Layers with fast random access, like shapefiles, are read by the worker threads
+  // themselves, each through a dataset of its own since OGR datasets are not thread
+  // safe. The features of other layers are read here and handed to the workers.
+#if DISABLE_MULTI_THREADED_SHAPEFILE_IMPORT
+  const bool parallel_read = false;
+#else
+  const bool parallel_read =
+      max_threads > 1 && layer.TestCapability(OLCFastSetNextByIndex);
+#endif
+  std::vector<OGRDataSourceUqPtr> thread_datasets(max_threads);
+  auto read_and_import_features = [&](const size_t thread_id,
+                                      const size_t first_feature,
+                                      const size_t num_features) {
+    auto& thread_dataset = thread_datasets[thread_id];
+    if (!thread_dataset) {
+      thread_dataset.reset(openGDALDataset(file_path, copy_params));
+      if (thread_dataset == nullptr) {
+        throw std::runtime_error("openGDALDataset Error: Unable to open geo file " +
+                                 file_path);
+      }
+    }
+    OGRLayer& thread_layer =
+        getLayerWithSpecifiedName(copy_params.geo_layer_name, thread_dataset, file_path);
+    if (thread_layer.SetNextByIndex(first_feature) != OGRERR_NONE) {
+      throw std::runtime_error("Failed to seek to feature " +
+                               std::to_string(first_feature) + " of geo file " +
+                               file_path);
+    }
+    FeaturePtrVector thread_features;
+    thread_features.reserve(num_features);
+    for (size_t i = 0; i < num_features; i++) {
+      thread_features.emplace_back(thread_layer.GetNextFeature());
+    }
+    return import_thread_shapefile(thread_id,
+                                   this,
+                                   poGeographicSR.get(),
+                                   thread_features,
+                                   first_feature,
+                                   num_features,
+                                   fieldNameToIndexMap,
+                                   columnNameToSourceNameMap,
+                                   columnIdToRenderGroupAnalyzerMap,
+                                   session_info,
+                                   executor.get());
+  };
+  VLOG(1) << "GDAL import threads read their own features: " << parallel_read;
+
 #if !DISABLE_MULTI_THREADED_SHAPEFILE_IMPORT
   // threads
   std::list<std::future<ImportStatus>> threads;
@@ -5103,8 +5841,10 @@ ImportStatus Importer::importGDAL(ColumnNameToSourceNameMapType columnNameToSour
 #endif
 
     // fill features buffer for new thread
-    for (size_t i = 0; i < numFeaturesThisChunk; i++) {
-      features[thread_id].emplace_back(layer.GetNextFeature());
+    if (!parallel_read) {
+      for (size_t i = 0; i < numFeaturesThisChunk; i++) {
+        features[thread_id].emplace_back(layer.GetNextFeature());
+      }
     }
 
 #if DISABLE_MULTI_THREADED_SHAPEFILE_IMPORT
@@ -5126,19 +5866,25 @@ ImportStatus Importer::importGDAL(ColumnNameToSourceNameMapType columnNameToSour
     set_import_status(import_id, import_status);
 #else
     // fire up that thread to import this geometry
-    threads.push_back(std::async(std::launch::async,
-                                 import_thread_shapefile,
-                                 thread_id,
-                                 this,
-                                 poGeographicSR.get(),
-                                 std::move(features[thread_id]),
-                                 firstFeatureThisChunk,
-                                 numFeaturesThisChunk,
-                                 fieldNameToIndexMap,
-                                 columnNameToSourceNameMap,
-                                 columnIdToRenderGroupAnalyzerMap,
-                                 session_info,
-                                 executor.get()));
+    if (parallel_read) {
+      threads.push_back(threadpool::async(read_and_import_features,
+                                          thread_id,
+                                          firstFeatureThisChunk,
+                                          numFeaturesThisChunk));
+    } else {
+      threads.push_back(threadpool::async(import_thread_shapefile,
+                                          thread_id,
+                                          this,
+                                          poGeographicSR.get(),
+                                          std::move(features[thread_id]),
+                                          firstFeatureThisChunk,
+                                          numFeaturesThisChunk,
+                                          fieldNameToIndexMap,
+                                          columnNameToSourceNameMap,
+                                          columnIdToRenderGroupAnalyzerMap,
+                                          session_info,
+                                          executor.get()));
+    }
 
     // let the threads run
     while (threads.size() > 0) {
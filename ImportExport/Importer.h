@@ -113,7 +113,8 @@ class TypedImportBuffer : boost::noncopyable {
       case kCHAR:
         string_buffer_ = new std::vector<std::string>();
         if (col_desc->columnType.get_compression() == kENCODING_DICT) {
-          switch (col_desc->columnType.get_size()) {
+          string_dict_size_ = col_desc->columnType.get_size();
+          switch (string_dict_size_) {
             case 1:
               string_dict_i8_buffer_ = new std::vector<uint8_t>();
               break;
@@ -183,7 +184,7 @@ class TypedImportBuffer : boost::noncopyable {
       case kCHAR:
         delete string_buffer_;
         if (column_desc_->columnType.get_compression() == kENCODING_DICT) {
-          switch (column_desc_->columnType.get_size()) {
+          switch (string_dict_size_) {
             case 1:
               delete string_dict_i8_buffer_;
               break;
@@ -352,7 +353,7 @@ class TypedImportBuffer : boost::noncopyable {
   }
 
   int8_t* getStringDictBuffer() const {
-    switch (column_desc_->columnType.get_size()) {
+    switch (string_dict_size_) {
       case 1:
         return reinterpret_cast<int8_t*>(string_dict_i8_buffer_->data());
       case 2:
@@ -408,7 +409,7 @@ class TypedImportBuffer : boost::noncopyable {
       case kCHAR: {
         string_buffer_->clear();
         if (column_desc_->columnType.get_compression() == kENCODING_DICT) {
-          switch (column_desc_->columnType.get_size()) {
+          switch (string_dict_size_) {
             case 1:
               string_dict_i8_buffer_->clear();
               break;
@@ -451,6 +452,16 @@ class TypedImportBuffer : boost::noncopyable {
 
   size_t add_values(const ColumnDescriptor* cd, const TColumn& data);
 
+  // Converts one column of a block of delimited rows, given as `num_fields_per_row`
+  // fields per row. Rows which fail the conversion are recorded in `bad_rows`, by
+  // index in the block, with a placeholder value which the caller has to delete.
+  size_t add_values(const ColumnDescriptor* cd,
+                    const std::vector<std::string_view>& fields,
+                    const size_t num_fields_per_row,
+                    const size_t field_idx,
+                    const CopyParams& copy_params,
+                    std::map<size_t, std::string>& bad_rows);
+
   size_t add_arrow_values(const ColumnDescriptor* cd,
                           const arrow::Array& data,
                           const bool exact_type_match,
@@ -504,6 +515,8 @@ class TypedImportBuffer : boost::noncopyable {
   };
   const ColumnDescriptor* column_desc_;
   StringDictionary* string_dict_;
+  // Width of the ids in the string_dict_*_buffer_, the loader may widen the column.
+  int string_dict_size_{0};
 };
 
 class Loader {
@@ -554,6 +567,10 @@ class Loader {
       const std::vector<std::unique_ptr<TypedImportBuffer>>& import_buffers,
       const size_t row_count,
       const Catalog_Namespace::SessionInfo* session_info);
+  // Inserts columns already in the layout of InsertData, one block per column of
+  // get_column_descs(), into an unsharded table without checkpointing.
+  bool loadDataBlocks(const std::vector<DataBlockPtr>& data_blocks,
+                      const size_t row_count);
   virtual void checkpoint();
   virtual std::vector<Catalog_Namespace::TableEpochInfo> getTableEpochs() const;
   virtual void setTableEpochs(
@@ -563,6 +580,7 @@ class Loader {
   bool isAddingColumns() const { return adding_columns_; }
   void dropColumns(const std::vector<int>& columns);
   std::string getErrorMessage() { return error_msg_; };
+  void setErrorMessage(const std::string& error_msg) { error_msg_ = error_msg; }
 
  protected:
   void init(const bool use_catalog_locks);
@@ -611,10 +629,16 @@ class Loader {
   void fillShardRow(const size_t row_index,
                     OneShardBuffers& shard_output_buffers,
                     const OneShardBuffers& import_buffers);
+  void widenDictionaryEncodings(const OneShardBuffers& import_buffers);
+  void widenDictionaryEncoding(const ColumnDescriptor* cd, const int size);
 
   bool adding_columns_ = false;
   std::mutex loader_mutex_;
+  mapd_shared_mutex insert_mutex_;
   std::string error_msg_;
+  // Encoding widths of the columns before this loader widened them, restored when the
+  // load is rolled back.
+  std::map<const ColumnDescriptor*, int> widened_dictionary_sizes_;
 };
 
 struct ImportStatus {
@@ -773,6 +797,14 @@ class Importer : public DataStreamSink {
 #ifdef ENABLE_IMPORT_PARQUET
   void import_local_parquet(const std::string& file_path,
                             const Catalog_Namespace::SessionInfo* session_info) override;
+  // Decodes the row groups of the local parquet files in parallel with the encoders of
+  // parquet foreign tables, straight into chunk buffers. Returns false, having imported
+  // nothing, if a column of the table can't be loaded that way or if the encoders reject
+  // a value, in which case the table is rolled back to table_epochs.
+  bool import_local_parquet_with_chunk_loader(
+      const std::vector<std::string>& file_paths,
+      const std::vector<Catalog_Namespace::TableEpochInfo>& table_epochs,
+      const Catalog_Namespace::SessionInfo* session_info);
 #endif
   static ImportStatus get_import_status(const std::string& id);
   static void set_import_status(const std::string& id, const ImportStatus is);
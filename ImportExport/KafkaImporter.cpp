@@ -25,10 +25,13 @@
 #include <boost/algorithm/string.hpp>
 #include <boost/algorithm/string/trim.hpp>
 #include <boost/regex.hpp>
+#include <atomic>
 #include <cstring>
+#include <functional>
 #include <iostream>
 #include <iterator>
 #include <string>
+#include <vector>
 
 #include "Logger/Logger.h"
 #include "RowToColumnLoader.h"
@@ -47,12 +50,13 @@
 bool print_error_data = false;
 bool print_transformation = false;
 
-static bool run = true;
+static std::atomic<bool> run{true};
 static bool exit_eof = false;
-static int eof_cnt = 0;
-static int partition_cnt = 0;
-static long msg_cnt = 0;
-static int64_t msg_bytes = 0;
+// Rebalance callbacks are served on the thread of their consumer, see kafka_insert().
+static thread_local int eof_cnt = 0;
+static thread_local int partition_cnt = 0;
+static std::atomic<long> msg_cnt{0};
+static std::atomic<int64_t> msg_bytes{0};
 
 class RebalanceCb : public RdKafka::RebalanceCb {
  private:
@@ -63,7 +67,12 @@ class RebalanceCb : public RdKafka::RebalanceCb {
     }
   }
 
+  // Loads the rows consumed so far and commits their offsets.
+  std::function<void(RdKafka::KafkaConsumer*)> flush_;
+
  public:
+  RebalanceCb(std::function<void(RdKafka::KafkaConsumer*)> flush) : flush_(flush) {}
+
   void rebalance_cb(RdKafka::KafkaConsumer* consumer,
                     RdKafka::ErrorCode err,
                     std::vector<RdKafka::TopicPartition*>& partitions) override {
@@ -75,6 +84,10 @@ class RebalanceCb : public RdKafka::RebalanceCb {
       consumer->assign(partitions);
       partition_cnt = (int)partitions.size();
     } else {
+      // The revoked partitions move to another consumer of the group, which resumes
+      // from their committed offsets. Load the pending rows of this consumer first, or
+      // they would be loaded again by the new owner of their partition.
+      flush_(consumer);
       consumer->unassign();
       partition_cnt = 0;
     }
@@ -307,7 +320,17 @@ void kafka_insert(
   bool do_conf_dump = false;
   int use_ccb = 0;
 
-  RebalanceCb ex_rebalance_cb;
+  size_t recv_rows = 0;
+  int skipped = 0;
+  int rows_loaded = 0;
+
+  RebalanceCb ex_rebalance_cb([&](RdKafka::KafkaConsumer* consumer) {
+    if (recv_rows > 0) {
+      recv_rows = 0;
+      row_loader.do_load(rows_loaded, skipped, copy_params);
+      consumer->commitSync();
+    }
+  });
 
   /*
    * Create configuration objects
@@ -429,9 +452,6 @@ void kafka_insert(
   /*
    * Consume messages
    */
-  size_t recv_rows = 0;
-  int skipped = 0;
-  int rows_loaded = 0;
   while (run) {
     RdKafka::Message* msg = consumer->consume(10000);
     if (msg->err() == RdKafka::ERR_NO_ERROR) {
@@ -462,7 +482,8 @@ void kafka_insert(
   consumer->close();
   delete consumer;
 
-  LOG(INFO) << "Consumed " << msg_cnt << " messages (" << msg_bytes << " bytes)";
+  LOG(INFO) << "Consumed " << msg_cnt.load() << " messages (" << msg_bytes.load()
+            << " bytes)";
   LOG(FATAL) << "Consumer shut down, probably due to an error please review logs";
 };
 
@@ -492,6 +513,7 @@ int main(int argc, char** argv) {
   size_t batch_size = 10000;
   size_t retry_count = 10;
   size_t retry_wait = 5;
+  size_t num_consumers = 1;
   bool remove_quotes = false;
   std::vector<std::string> xforms;
   std::map<std::string,
@@ -563,6 +585,11 @@ int main(int argc, char** argv) {
   desc.add_options()("brokers",
                      po::value<std::string>(&brokers)->required(),
                      "list of kafka brokers for topic");
+  desc.add_options()(
+      "consumers",
+      po::value<size_t>(&num_consumers)->default_value(num_consumers),
+      "Number of consumers to run in parallel, each with its own server connection. "
+      "The partitions of the topic are balanced between the consumers.");
 
   po::positional_options_description positionalOptions;
   positionalOptions.add("table", 1);
@@ -720,17 +747,33 @@ int main(int argc, char** argv) {
             std::unique_ptr<std::string>(new std::string(fmt_str)));
   }
 
+  if (num_consumers < 1) {
+    std::cerr << "consumers must be >= 1" << std::endl;
+    return 1;
+  }
+
   import_export::CopyParams copy_params(
       delim, nulls, line_delim, batch_size, retry_count, retry_wait);
-  RowToColumnLoader row_loader(
-      ThriftClientConnection(
-          server_host, port, conn_type, skip_host_verify, ca_cert_name, ca_cert_name),
-      user_name,
-      passwd,
-      db_name,
-      table_name);
-
-  kafka_insert(
-      row_loader, transformations, copy_params, remove_quotes, group_id, topic, brokers);
+  const ThriftClientConnection conn_details(
+      server_host, port, conn_type, skip_host_verify, ca_cert_name, ca_cert_name);
+
+  // All the consumers join the same group, so that each partition of the topic is read
+  // and loaded by a single consumer, in order.
+  std::vector<std::thread> consumer_threads;
+  for (size_t i = 0; i < num_consumers; ++i) {
+    consumer_threads.emplace_back([&]() {
+      RowToColumnLoader row_loader(conn_details, user_name, passwd, db_name, table_name);
+      kafka_insert(row_loader,
+                   transformations,
+                   copy_params,
+                   remove_quotes,
+                   group_id,
+                   topic,
+                   brokers);
+    });
+  }
+  for (auto& consumer_thread : consumer_threads) {
+    consumer_thread.join();
+  }
   return 0;
 }
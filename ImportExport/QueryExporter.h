@@ -26,7 +26,7 @@ namespace import_export {
 
 class QueryExporter {
  public:
-  enum class FileType { kCSV, kGeoJSON, kGeoJSONL, kShapefile };
+  enum class FileType { kCSV, kGeoJSON, kGeoJSONL, kShapefile, kParquet };
   enum class FileCompression { kNone, kGZip, kZip };
   enum class ArrayNullHandling {
     kAbortWithWarning,
@@ -16,13 +16,32 @@
 
 #include "ImportExport/QueryExporterCSV.h"
 
+#include <zlib.h>
 #include <boost/variant/get.hpp>
 
+#include <charconv>
+#include <cstdio>
+#include <deque>
+#include <future>
+
 #include "QueryEngine/ResultSet.h"
 #include "Shared/misc.h"
+#include "Shared/thread_count.h"
+
+size_t g_csv_export_range_entries{65536};
 
 namespace import_export {
 
+namespace {
+
+// Bytes of formatted rows written at a time when formatting sequentially.
+constexpr size_t export_buffer_bytes{1 << 20};
+
+// Rows fetched from a result set at a time.
+constexpr size_t export_batch_rows{4096};
+
+}  // namespace
+
 QueryExporterCSV::QueryExporterCSV() : QueryExporter(FileType::kCSV) {}
 
 QueryExporterCSV::~QueryExporterCSV() {}
@@ -37,19 +56,26 @@ void QueryExporterCSV::beginExport(const std::string& file_path,
 
   // compression?
   auto actual_file_path{file_path};
-  if (file_compression != FileCompression::kNone) {
-    // @TODO(se) implement post-export compression
+  if (file_compression == FileCompression::kGZip) {
+    actual_file_path += ".gz";
+    gzip_ = true;
+  } else if (file_compression != FileCompression::kNone) {
+    // @TODO(se) implement zip compression
     throw std::runtime_error("Compression not yet supported for this file type");
   }
 
   // open file
-  outfile_.open(actual_file_path);
+  outfile_.open(actual_file_path, std::ios::binary);
   if (!outfile_) {
     throw std::runtime_error("Failed to create file '" + actual_file_path + "'");
   }
 
   // write header?
+  // keep these
+  copy_params_ = copy_params;
+
   if (copy_params.has_header == import_export::ImportHeaderRow::HAS_HEADER) {
+    std::string header;
     bool not_first{false};
     int column_index = 0;
     for (auto const& column_info : column_infos) {
@@ -57,18 +83,16 @@ void QueryExporterCSV::beginExport(const std::string& file_path,
       auto column_name = safeColumnName(column_info.get_resname(), column_index + 1);
       // output to header line
       if (not_first) {
-        outfile_ << copy_params.delimiter;
+        header += copy_params.delimiter;
       } else {
         not_first = true;
       }
-      outfile_ << column_name;
+      header += column_name;
       column_index++;
     }
-    outfile_ << copy_params.line_delim;
+    header += copy_params.line_delim;
+    writeRows(header);
   }
-
-  // keep these
-  copy_params_ = copy_params;
 }
 
 namespace {
@@ -134,131 +158,253 @@ std::string target_value_to_string(const TargetValue& tv,
   return nullable_str_to_string(*sptr);
 }
 
+template <typename T>
+void append_int(std::string& out, const T value) {
+  char buf[24];
+  const auto result = std::to_chars(buf, buf + sizeof(buf), value);
+  CHECK(result.ec == std::errc());
+  out.append(buf, result.ptr);
+}
+
+// Same output as an ostream with the given precision.
+void append_real(std::string& out, const double value, const int precision) {
+  char buf[64];
+  const auto len = snprintf(buf, sizeof(buf), "%.*g", precision, value);
+  CHECK_GT(len, 0);
+  CHECK_LT(static_cast<size_t>(len), sizeof(buf));
+  out.append(buf, len);
+}
+
+void append_int_value(std::string& out,
+                      const int64_t int_val,
+                      const SQLTypeInfo& ti,
+                      const CopyParams& copy_params) {
+  bool is_null{false};
+  switch (ti.get_type()) {
+    case kBOOLEAN:
+      is_null = (int_val == NULL_BOOLEAN);
+      break;
+    case kTINYINT:
+      is_null = (int_val == NULL_TINYINT);
+      break;
+    case kSMALLINT:
+      is_null = (int_val == NULL_SMALLINT);
+      break;
+    case kINT:
+      is_null = (int_val == NULL_INT);
+      break;
+    case kBIGINT:
+      is_null = (int_val == NULL_BIGINT);
+      break;
+    case kTIME:
+    case kTIMESTAMP:
+    case kDATE:
+      is_null = (int_val == NULL_BIGINT);
+      break;
+    default:
+      is_null = false;
+  }
+  if (is_null) {
+    out += copy_params.null_str;
+  } else if (ti.get_type() == kTIME) {
+    constexpr size_t buf_size = 9;
+    char buf[buf_size];
+    size_t const len = shared::formatHMS(buf, buf_size, int_val);
+    CHECK_EQ(8u, len);  // 8 == strlen("HH:MM:SS")
+    out.append(buf, len);
+  } else {
+    append_int(out, int_val);
+  }
+}
+
+void append_double_value(std::string& out,
+                         const double real_val,
+                         const SQLTypeInfo& ti,
+                         const CopyParams& copy_params) {
+  const bool is_null =
+      ti.get_type() == kFLOAT ? real_val == NULL_FLOAT : real_val == NULL_DOUBLE;
+  if (is_null) {
+    out += copy_params.null_str;
+  } else if (ti.get_type() == kNUMERIC) {
+    append_real(out, real_val, ti.get_precision());
+  } else {
+    append_real(out, real_val, std::numeric_limits<double>::digits10 + 1);
+  }
+}
+
+void append_float_value(std::string& out,
+                        const float real_val,
+                        const SQLTypeInfo& ti,
+                        const CopyParams& copy_params) {
+  CHECK_EQ(kFLOAT, ti.get_type());
+  if (real_val == NULL_FLOAT) {
+    out += copy_params.null_str;
+  } else {
+    append_real(out, real_val, std::numeric_limits<float>::digits10 + 1);
+  }
+}
+
+void append_string_value(std::string& out,
+                         const std::string* s,
+                         const CopyParams& copy_params) {
+  if (!s) {
+    out += copy_params.null_str;
+  } else if (!copy_params.quoted || s->find(copy_params.quote) == std::string::npos) {
+    out += *s;
+  } else {
+    for (const auto c : *s) {
+      if (c == copy_params.quote) {
+        out += copy_params.escape;
+      }
+      out += c;
+    }
+  }
+}
+
+// Formats the rows of a batch, see ResultSet::getNextRowBatch(). A scalar column
+// decodes to a single type, so the row index is also the index of its value.
+void append_rows(std::string& out,
+                 const std::vector<ColumnBatch>& columns,
+                 const size_t row_count,
+                 const std::vector<TargetMetaInfo>& targets,
+                 const CopyParams& copy_params) {
+  for (size_t row_idx = 0; row_idx < row_count; ++row_idx) {
+    for (size_t i = 0; i < columns.size(); ++i) {
+      auto const& column = columns[i];
+      if (i) {
+        out += copy_params.delimiter;
+      }
+      if (copy_params.quoted) {
+        out += copy_params.quote;
+      }
+      auto const& ti = targets[i].get_type_info();
+      if (!column.values.empty()) {
+        out += target_value_to_string(column.values[row_idx], ti, " | ");
+      } else if (!column.int_values.empty()) {
+        append_int_value(out, column.int_values[row_idx], ti, copy_params);
+      } else if (!column.double_values.empty()) {
+        append_double_value(out, column.double_values[row_idx], ti, copy_params);
+      } else if (!column.float_values.empty()) {
+        append_float_value(out, column.float_values[row_idx], ti, copy_params);
+      } else {
+        append_string_value(out,
+                            column.nulls[row_idx] ? nullptr : &column.str_values[row_idx],
+                            copy_params);
+      }
+      if (copy_params.quoted) {
+        out += copy_params.quote;
+      }
+    }
+    out += copy_params.line_delim;
+  }
+}
+
+// Compresses `data` as a gzip member. Members can be concatenated into one gzip file,
+// which lets ranges of rows be compressed independently.
+std::string gzip_compress(const std::string& data) {
+  z_stream stream{};
+  if (deflateInit2(&stream,
+                   Z_DEFAULT_COMPRESSION,
+                   Z_DEFLATED,
+                   15 + 16 /* gzip header */,
+                   8,
+                   Z_DEFAULT_STRATEGY) != Z_OK) {
+    throw std::runtime_error("Failed to initialize gzip compression");
+  }
+  std::string compressed(deflateBound(&stream, data.size()), '\0');
+  stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+  stream.avail_in = data.size();
+  stream.next_out = reinterpret_cast<Bytef*>(&compressed[0]);
+  stream.avail_out = compressed.size();
+  const auto result = deflate(&stream, Z_FINISH);
+  deflateEnd(&stream);
+  if (result != Z_STREAM_END) {
+    throw std::runtime_error("Failed to gzip compress exported rows");
+  }
+  compressed.resize(stream.total_out);
+  return compressed;
+}
+
 }  // namespace
 
 void QueryExporterCSV::exportResults(const std::vector<AggregatedResult>& query_results) {
   for (auto& agg_result : query_results) {
     auto results = agg_result.rs;
     auto const& targets = agg_result.targets_meta;
+    const auto entry_count = results->entryCount();
 
-    while (true) {
-      auto const crt_row = results->getNextRow(true, true);
-      if (crt_row.empty()) {
-        break;
-      }
-      bool not_first = false;
-      for (size_t i = 0; i < results->colCount(); ++i) {
-        bool is_null{false};
-        auto const tv = crt_row[i];
-        auto const scalar_tv = boost::get<ScalarTargetValue>(&tv);
-        if (not_first) {
-          outfile_ << copy_params_.delimiter;
-        } else {
-          not_first = true;
+    // Random access to the rows of truncated results would ignore their limit and
+    // offset, those are formatted sequentially.
+    if (results->isTruncated() || results->isExplain() ||
+        entry_count <= g_csv_export_range_entries) {
+      std::string rows;
+      std::vector<ColumnBatch> columns;
+      while (true) {
+        auto const row_count =
+            results->getNextRowBatch(export_batch_rows, true, true, columns);
+        if (!row_count) {
+          break;
         }
-        if (copy_params_.quoted) {
-          outfile_ << copy_params_.quote;
-        }
-        auto const& ti = targets[i].get_type_info();
-        if (!scalar_tv) {
-          outfile_ << target_value_to_string(crt_row[i], ti, " | ");
-          if (copy_params_.quoted) {
-            outfile_ << copy_params_.quote;
-          }
-          continue;
-        }
-        if (boost::get<int64_t>(scalar_tv)) {
-          auto int_val = *(boost::get<int64_t>(scalar_tv));
-          switch (ti.get_type()) {
-            case kBOOLEAN:
-              is_null = (int_val == NULL_BOOLEAN);
-              break;
-            case kTINYINT:
-              is_null = (int_val == NULL_TINYINT);
-              break;
-            case kSMALLINT:
-              is_null = (int_val == NULL_SMALLINT);
-              break;
-            case kINT:
-              is_null = (int_val == NULL_INT);
-              break;
-            case kBIGINT:
-              is_null = (int_val == NULL_BIGINT);
-              break;
-            case kTIME:
-            case kTIMESTAMP:
-            case kDATE:
-              is_null = (int_val == NULL_BIGINT);
-              break;
-            default:
-              is_null = false;
-          }
-          if (is_null) {
-            outfile_ << copy_params_.null_str;
-          } else if (ti.get_type() == kTIME) {
-            constexpr size_t buf_size = 9;
-            char buf[buf_size];
-            size_t const len = shared::formatHMS(buf, buf_size, int_val);
-            CHECK_EQ(8u, len);  // 8 == strlen("HH:MM:SS")
-            outfile_ << buf;
-          } else {
-            outfile_ << int_val;
-          }
-        } else if (boost::get<double>(scalar_tv)) {
-          auto real_val = *(boost::get<double>(scalar_tv));
-          if (ti.get_type() == kFLOAT) {
-            is_null = (real_val == NULL_FLOAT);
-          } else {
-            is_null = (real_val == NULL_DOUBLE);
-          }
-          if (is_null) {
-            outfile_ << copy_params_.null_str;
-          } else if (ti.get_type() == kNUMERIC) {
-            outfile_ << std::setprecision(ti.get_precision()) << real_val;
-          } else {
-            outfile_ << std::setprecision(std::numeric_limits<double>::digits10 + 1)
-                     << real_val;
-          }
-        } else if (boost::get<float>(scalar_tv)) {
-          CHECK_EQ(kFLOAT, ti.get_type());
-          auto real_val = *(boost::get<float>(scalar_tv));
-          if (real_val == NULL_FLOAT) {
-            outfile_ << copy_params_.null_str;
-          } else {
-            outfile_ << std::setprecision(std::numeric_limits<float>::digits10 + 1)
-                     << real_val;
-          }
-        } else {
-          auto s = boost::get<NullableString>(scalar_tv);
-          is_null = !s || boost::get<void*>(s);
-          if (is_null) {
-            outfile_ << copy_params_.null_str;
-          } else {
-            auto s_notnull = boost::get<std::string>(s);
-            CHECK(s_notnull);
-            if (!copy_params_.quoted) {
-              outfile_ << *s_notnull;
-            } else {
-              size_t q = s_notnull->find(copy_params_.quote);
-              if (q == std::string::npos) {
-                outfile_ << *s_notnull;
-              } else {
-                std::string str(*s_notnull);
-                while (q != std::string::npos) {
-                  str.insert(q, 1, copy_params_.escape);
-                  q = str.find(copy_params_.quote, q + 2);
-                }
-                outfile_ << str;
-              }
-            }
-          }
-        }
-        if (copy_params_.quoted) {
-          outfile_ << copy_params_.quote;
+        append_rows(rows, columns, row_count, targets, copy_params_);
+        if (rows.size() >= export_buffer_bytes) {
+          writeRows(rows);
+          rows.clear();
         }
       }
-      outfile_ << copy_params_.line_delim;
+      writeRows(rows);
+      continue;
+    }
+
+    // Ranges of rows are formatted, and compressed, on worker threads. The ranges are
+    // written in order, with a bounded number of them in flight.
+    const auto range_entries = std::max(g_csv_export_range_entries, size_t(1));
+    const auto format_range = [this, results, &targets, entry_count, range_entries](
+                                  const size_t start_entry) {
+      const auto end_entry = std::min(start_entry + range_entries, entry_count);
+      std::string rows;
+      std::vector<ColumnBatch> columns;
+      for (size_t entry_idx = start_entry; entry_idx < end_entry;
+           entry_idx += export_batch_rows) {
+        auto const row_count =
+            results->getRowBatchAt(entry_idx,
+                                   std::min(export_batch_rows, end_entry - entry_idx),
+                                   true,
+                                   true,
+                                   columns);
+        append_rows(rows, columns, row_count, targets, copy_params_);
+      }
+      return gzip_ && !rows.empty() ? gzip_compress(rows) : rows;
+    };
+    const size_t max_ranges_in_flight = 2 * static_cast<size_t>(cpu_threads());
+    std::deque<std::future<std::string>> ranges;
+    for (size_t start_entry = 0; start_entry < entry_count;
+         start_entry += range_entries) {
+      if (ranges.size() >= max_ranges_in_flight) {
+        outfile_ << ranges.front().get();
+        ranges.pop_front();
+      }
+      ranges.push_back(std::async(std::launch::async, format_range, start_entry));
+    }
+    for (auto& range : ranges) {
+      range.wait();
     }
+    for (auto& range : ranges) {
+      outfile_ << range.get();
+    }
+  }
+  if (!outfile_) {
+    throw std::runtime_error("Failed to write exported rows");
+  }
+}
+
+void QueryExporterCSV::writeRows(const std::string& rows) {
+  if (rows.empty()) {
+    return;
+  }
+  if (gzip_) {
+    outfile_ << gzip_compress(rows);
+  } else {
+    outfile_ << rows;
   }
 }
 
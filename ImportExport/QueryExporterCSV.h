@@ -20,6 +20,9 @@
 
 #include <ImportExport/QueryExporter.h>
 
+// Result set entries formatted at a time by each thread of a parallel CSV export.
+extern size_t g_csv_export_range_entries;
+
 namespace import_export {
 
 class QueryExporterCSV : public QueryExporter {
@@ -37,8 +40,12 @@ class QueryExporterCSV : public QueryExporter {
   void endExport() final;
 
  private:
+  // Writes the formatted rows, compressed as a gzip member if exporting with gzip.
+  void writeRows(const std::string& rows);
+
   std::ofstream outfile_;
   CopyParams copy_params_;
+  bool gzip_{false};
 };
 
 }  // namespace import_export
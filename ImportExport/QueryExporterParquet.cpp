@@ -0,0 +1,242 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ImportExport/QueryExporterParquet.h"
+
+#include <future>
+
+#include <arrow/api.h>
+#include <arrow/io/file.h>
+#include <parquet/arrow/writer.h>
+#include <boost/algorithm/string.hpp>
+#include <boost/filesystem.hpp>
+
+#include "Archive/S3Archive.h"
+#include "Logger/Logger.h"
+#include "QueryEngine/ArrowResultSet.h"
+#include "QueryEngine/ResultSet.h"
+#include "Shared/ArrowUtil.h"
+
+size_t g_parquet_export_row_group_rows{1 << 20};
+
+namespace import_export {
+
+namespace {
+
+// Dictionary encoded strings are converted with the entire string dictionary, trim it
+// to the strings the rows actually use so that each row group only carries those.
+std::shared_ptr<arrow::Array> trim_dictionary(const arrow::DictionaryArray& dict_array) {
+  const auto& indices = static_cast<const arrow::Int32Array&>(*dict_array.indices());
+  const auto& dictionary =
+      static_cast<const arrow::StringArray&>(*dict_array.dictionary());
+  std::vector<int32_t> trimmed_indices(dictionary.length(), -1);
+  arrow::Int32Builder indices_builder;
+  arrow::StringBuilder dictionary_builder;
+  ARROW_THROW_NOT_OK(indices_builder.Reserve(indices.length()));
+  int32_t trimmed_count{0};
+  for (int64_t i = 0; i < indices.length(); ++i) {
+    if (indices.IsNull(i)) {
+      indices_builder.UnsafeAppendNull();
+      continue;
+    }
+    const auto index = indices.Value(i);
+    auto& trimmed_index = trimmed_indices[index];
+    if (trimmed_index < 0) {
+      trimmed_index = trimmed_count++;
+      ARROW_THROW_NOT_OK(dictionary_builder.Append(dictionary.GetView(index)));
+    }
+    indices_builder.UnsafeAppend(trimmed_index);
+  }
+  std::shared_ptr<arrow::Array> trimmed_indices_array;
+  std::shared_ptr<arrow::Array> trimmed_dictionary;
+  ARROW_THROW_NOT_OK(indices_builder.Finish(&trimmed_indices_array));
+  ARROW_THROW_NOT_OK(dictionary_builder.Finish(&trimmed_dictionary));
+  ARROW_ASSIGN_OR_THROW(
+      auto trimmed_array,
+      arrow::DictionaryArray::FromArrays(
+          dict_array.type(), trimmed_indices_array, trimmed_dictionary));
+  return trimmed_array;
+}
+
+std::shared_ptr<arrow::RecordBatch> trim_dictionaries(
+    const std::shared_ptr<arrow::RecordBatch>& record_batch) {
+  if (!record_batch->num_rows()) {
+    return record_batch;
+  }
+  std::vector<std::shared_ptr<arrow::Array>> columns;
+  for (int i = 0; i < record_batch->num_columns(); ++i) {
+    auto column = record_batch->column(i);
+    if (column->type_id() == arrow::Type::DICTIONARY) {
+      column = trim_dictionary(static_cast<const arrow::DictionaryArray&>(*column));
+    }
+    columns.push_back(column);
+  }
+  return arrow::RecordBatch::Make(
+      record_batch->schema(), record_batch->num_rows(), columns);
+}
+
+}  // namespace
+
+QueryExporterParquet::QueryExporterParquet()
+    : QueryExporter(FileType::kParquet), file_compression_{FileCompression::kNone} {}
+
+QueryExporterParquet::~QueryExporterParquet() {
+  cleanUp();
+}
+
+void QueryExporterParquet::cleanUp() {
+  writer_.reset();
+  if (outfile_) {
+    const auto status = outfile_->Close();
+    if (!status.ok()) {
+      LOG(WARNING) << "Failed to close file '" << file_path_
+                   << "': " << status.ToString();
+    }
+    outfile_.reset();
+  }
+  // an S3 export only writes a local file to upload it
+  if (!s3_url_.empty() && !file_path_.empty()) {
+    boost::system::error_code ec;
+    boost::filesystem::remove(file_path_, ec);
+  }
+  file_path_.clear();
+}
+
+void QueryExporterParquet::beginExport(const std::string& file_path,
+                                       const std::string& layer_name,
+                                       const CopyParams& copy_params,
+                                       const std::vector<TargetMetaInfo>& column_infos,
+                                       const FileCompression file_compression,
+                                       const ArrayNullHandling array_null_handling) {
+  validateFileExtensions(file_path, "Parquet", {".parquet"});
+
+  if (file_compression == FileCompression::kZip) {
+    throw std::runtime_error(
+        "Selected file compression option not yet supported for file type 'Parquet'");
+  }
+
+  // capture these
+  copy_params_ = copy_params;
+  file_compression_ = file_compression;
+
+  column_names_.clear();
+  for (auto const& column_info : column_infos) {
+    auto column_name =
+        safeColumnName(column_info.get_resname(), column_names_.size() + 1);
+    auto const& type_info = column_info.get_type_info();
+    if (type_info.is_geometry() || type_info.is_array() || type_info.is_timeinterval()) {
+      throw std::runtime_error("Column '" + column_name + "' has unsupported type '" +
+                               type_info.get_type_name() + "' for file type 'Parquet'");
+    }
+    column_names_.push_back(column_name);
+  }
+
+  if (boost::istarts_with(file_path, "s3://")) {
+    s3_url_ = file_path;
+    file_path_ = (boost::filesystem::temp_directory_path() /
+                  boost::filesystem::unique_path("omnisci_export_%%%%-%%%%-%%%%.parquet"))
+                     .string();
+  } else {
+    s3_url_.clear();
+    file_path_ = file_path;
+  }
+
+  auto file_result = arrow::io::FileOutputStream::Open(file_path_);
+  if (!file_result.ok()) {
+    throw std::runtime_error("Failed to create file '" + file_path_ +
+                             "': " + file_result.status().ToString());
+  }
+  outfile_ = file_result.ValueOrDie();
+}
+
+void QueryExporterParquet::exportResults(
+    const std::vector<AggregatedResult>& query_results) {
+  CHECK(outfile_);
+  for (auto& agg_result : query_results) {
+    auto const converter =
+        std::make_shared<ArrowResultSetConverter>(agg_result.rs,
+                                                  nullptr,
+                                                  ExecutorDeviceType::CPU,
+                                                  0,
+                                                  column_names_,
+                                                  -1,
+                                                  ArrowTransport::WIRE);
+    const auto entry_count = converter->getEntryCount();
+    const auto row_group_entries = std::max(g_parquet_export_row_group_rows, size_t(1));
+    // The converter converts the columns of a row group in parallel, converting the next
+    // row group overlaps with encoding and writing the current one.
+    auto convert_row_group = [converter, entry_count, row_group_entries](
+                                 const size_t start_entry) {
+      return trim_dictionaries(converter->convertToArrow(
+          start_entry, std::min(start_entry + row_group_entries, entry_count)));
+    };
+    auto next_row_group = std::async(std::launch::async, convert_row_group, size_t(0));
+    for (size_t start_entry = 0;;) {
+      const auto row_group = next_row_group.get();
+      start_entry += row_group_entries;
+      if (start_entry < entry_count) {
+        next_row_group = std::async(std::launch::async, convert_row_group, start_entry);
+      }
+
+      if (!writer_) {
+        auto properties_builder = parquet::WriterProperties::Builder();
+        properties_builder.compression(file_compression_ == FileCompression::kGZip
+                                           ? parquet::Compression::GZIP
+                                           : parquet::Compression::SNAPPY);
+        PARQUET_THROW_NOT_OK(parquet::arrow::FileWriter::Open(
+            *row_group->schema(),
+            arrow::default_memory_pool(),
+            outfile_,
+            properties_builder.build(),
+            parquet::ArrowWriterProperties::Builder().store_schema()->build(),
+            &writer_));
+      }
+      // Empty result sets only provide the schema of the file.
+      if (row_group->num_rows()) {
+        ARROW_ASSIGN_OR_THROW(auto table, arrow::Table::FromRecordBatches({row_group}));
+        PARQUET_THROW_NOT_OK(writer_->WriteTable(*table, row_group->num_rows()));
+      }
+
+      if (start_entry >= entry_count) {
+        break;
+      }
+    }
+  }
+}
+
+void QueryExporterParquet::endExport() {
+  CHECK(outfile_);
+  if (writer_) {
+    PARQUET_THROW_NOT_OK(writer_->Close());
+    writer_.reset();
+  }
+  PARQUET_THROW_NOT_OK(outfile_->Close());
+  outfile_.reset();
+
+  if (!s3_url_.empty()) {
+    S3Archive s3_archive(s3_url_,
+                         copy_params_.s3_access_key,
+                         copy_params_.s3_secret_key,
+                         copy_params_.s3_session_token,
+                         copy_params_.s3_region,
+                         copy_params_.s3_endpoint,
+                         false);
+    s3_archive.upload(file_path_);
+  }
+  cleanUp();
+}
+
+}  // namespace import_export
@@ -0,0 +1,76 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <ImportExport/QueryExporter.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace arrow {
+namespace io {
+class FileOutputStream;
+}
+}  // namespace arrow
+
+namespace parquet {
+namespace arrow {
+class FileWriter;
+}
+}  // namespace parquet
+
+// Result set entries written to each row group of a Parquet export.
+extern size_t g_parquet_export_row_group_rows;
+
+namespace import_export {
+
+/**
+ * Writes query results to a Parquet file, one or more row groups per result set.
+ * Columns are converted through ArrowResultSetConverter, so dictionary encoded strings
+ * keep their dictionary encoding, trimmed to the strings used by each row group. Pages
+ * are compressed with Snappy, or with GZip if asked for. An s3:// file path writes the
+ * file locally, then uploads it as the object named by the path.
+ */
+class QueryExporterParquet : public QueryExporter {
+ public:
+  QueryExporterParquet();
+  ~QueryExporterParquet();
+
+  void beginExport(const std::string& file_path,
+                   const std::string& layer_name,
+                   const CopyParams& copy_params,
+                   const std::vector<TargetMetaInfo>& column_infos,
+                   const FileCompression file_compression,
+                   const ArrayNullHandling array_null_handling) final;
+  void exportResults(const std::vector<AggregatedResult>& query_results) final;
+  void endExport() final;
+
+ private:
+  void cleanUp();
+
+  CopyParams copy_params_;
+  FileCompression file_compression_;
+  std::vector<std::string> column_names_;
+  std::string file_path_;
+  // The s3:// url to upload `file_path_` to, if exporting to S3.
+  std::string s3_url_;
+  std::shared_ptr<arrow::io::FileOutputStream> outfile_;
+  std::unique_ptr<parquet::arrow::FileWriter> writer_;
+};
+
+}  // namespace import_export
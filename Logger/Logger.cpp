@@ -38,12 +38,15 @@ bool g_enable_debug_timer{false};
 
 #include <atomic>
 #include <cstdlib>
+#include <fstream>
 #include <iostream>
 #include <mutex>
 #include <regex>
 
 #include "Shared/nvtx_helpers.h"
 
+std::string g_debug_timer_trace_dir;
+
 namespace logger {
 
 namespace attr = boost::log::attributes;
@@ -149,6 +152,11 @@ void LogOptions::set_options() {
       "log-rotation-size",
       po::value<size_t>(&rotation_size_)->default_value(rotation_size_),
       "Maximum file size in bytes before new log files are started.");
+  options_->add_options()(
+      "log-async",
+      po::value<bool>(&async_)->default_value(async_)->implicit_value(true),
+      "Write log files from a background thread. Logging threads only queue their "
+      "records, which the background thread formats and writes.");
 }
 
 template <typename TAG>
@@ -263,6 +271,40 @@ std::once_flag g_fatal_func_flag;
 
 using ClogSync = sinks::synchronous_sink<sinks::text_ostream_backend>;
 using FileSync = sinks::synchronous_sink<sinks::text_file_backend>;
+// Records are queued on a lock-free queue and formatted and written by the sink thread.
+using FileAsync = sinks::asynchronous_sink<sinks::text_file_backend>;
+
+// Asynchronous sinks, which must be stopped and flushed before shutdown or abort.
+std::mutex g_async_sinks_mutex;
+std::vector<boost::shared_ptr<FileAsync>> g_async_sinks;
+
+template <typename TAG>
+void add_file_sink(LogOptions const& log_opts,
+                   boost::filesystem::path const& full_log_dir,
+                   TAG const tag) {
+  boost::shared_ptr<boost::log::core> core = boost::log::core::get();
+  if (log_opts.async_) {
+    auto sink = make_sink<FileAsync>(log_opts, full_log_dir, tag);
+    {
+      std::lock_guard<std::mutex> lock(g_async_sinks_mutex);
+      g_async_sinks.push_back(sink);
+    }
+    core->add_sink(sink);
+  } else {
+    core->add_sink(make_sink<FileSync>(log_opts, full_log_dir, tag));
+  }
+}
+
+// Write the records queued by the asynchronous sinks, and stop their threads.
+void stop_async_sinks() {
+  std::lock_guard<std::mutex> lock(g_async_sinks_mutex);
+  for (auto& sink : g_async_sinks) {
+    boost::log::core::get()->remove_sink(sink);
+    sink->stop();
+    sink->flush();
+  }
+  g_async_sinks.clear();
+}
 
 template <typename CONSOLE_SINK>
 boost::shared_ptr<CONSOLE_SINK> make_sink(LogOptions const& log_opts) {
@@ -291,14 +333,14 @@ void init(LogOptions const& log_opts) {
     Severity const min_sink_level = std::max(Severity::INFO, log_opts.severity_);
     for (int i = min_sink_level; i < Severity::_NSEVERITIES; ++i) {
       Severity const level = static_cast<Severity>(i);
-      core->add_sink(make_sink<FileSync>(log_opts, full_log_dir, level));
+      add_file_sink(log_opts, full_log_dir, level);
     }
     g_min_active_severity = std::min(g_min_active_severity, log_opts.severity_);
     if (log_dir_was_created) {
       LOG(INFO) << "Log directory(" << full_log_dir.native() << ") created.";
     }
     for (auto const channel : log_opts.channels_) {
-      core->add_sink(make_sink<FileSync>(log_opts, full_log_dir, channel));
+      add_file_sink(log_opts, full_log_dir, channel);
     }
     g_any_active_channels = !log_opts.channels_.empty();
   }
@@ -317,6 +359,7 @@ void set_once_fatal_func(FatalFunc fatal_func) {
 void shutdown() {
   static std::once_flag logger_flag;
   std::call_once(logger_flag, []() {
+    stop_async_sinks();
     boost::log::core::get()->remove_all_sinks();
     nvtx_helpers::shutdown();
   });
@@ -418,6 +461,8 @@ Logger::~Logger() {
       // Exceptions thrown by (*fatal_func)() are propagated here.
       std::call_once(g_fatal_func_flag, *fatal_func);
     }
+    // Write the FATAL record, and those queued before it, before aborting.
+    stop_async_sinks();
     abort();
   }
 }
@@ -464,6 +509,11 @@ class Duration {
   // Start time relative to parent DurationTree::start_.
   template <typename Units = std::chrono::milliseconds>
   typename Units::rep relative_start_time() const;
+  // Start time relative to `time_point`.
+  template <typename Units = std::chrono::milliseconds>
+  typename Units::rep start_time_since(Clock::time_point time_point) const {
+    return std::chrono::duration_cast<Units>(start_ - time_point).count();
+  }
   // Duration value = stop_ - start_.
   template <typename Units = std::chrono::milliseconds>
   typename Units::rep value() const;
@@ -662,6 +712,76 @@ class JsonEncoder : boost::static_visitor<rapidjson::Value> {
   }
 };
 
+// Encode DurationTree into the Chrome trace event format, one complete event per
+// Duration, to be loaded in chrome://tracing or Perfetto. The root tree and the trees
+// of the threads it spawned are laid out on one timeline starting at the root.
+class ChromeTraceEncoder : boost::static_visitor<> {
+  rapidjson::Document doc_;
+  rapidjson::Document::AllocatorType& alloc_;
+  rapidjson::Value events_;
+  Clock::time_point root_start_;
+  ThreadId thread_id_{0};
+
+ public:
+  ChromeTraceEncoder()
+      : doc_(rapidjson::kObjectType)
+      , alloc_(doc_.GetAllocator())
+      , events_(rapidjson::kArrayType) {}
+  void operator()(Duration const& duration) {
+    rapidjson::Value event(rapidjson::kObjectType);
+    event.AddMember("name", rapidjson::StringRef(duration.name_), alloc_);
+    event.AddMember("cat", "debug_timer", alloc_);
+    event.AddMember("ph", "X", alloc_);
+    auto const start_us =
+        duration.start_time_since<std::chrono::microseconds>(root_start_);
+    event.AddMember("ts", rapidjson::Value(start_us), alloc_);
+    event.AddMember(
+        "dur", rapidjson::Value(duration.value<std::chrono::microseconds>()), alloc_);
+    event.AddMember("pid", 0, alloc_);
+    event.AddMember("tid", rapidjson::Value(thread_id_), alloc_);
+    rapidjson::Value args(rapidjson::kObjectType);
+    args.AddMember("location",
+                   filename(duration.file_) + ':' + std::to_string(duration.line_),
+                   alloc_);
+    event.AddMember("args", args, alloc_);
+    events_.PushBack(event, alloc_);
+  }
+  void operator()(DurationTree const& duration_tree) {
+    auto const parent_thread_id = thread_id_;
+    thread_id_ = duration_tree.thread_id_;
+    for (auto const& duration_tree_node : duration_tree.durations()) {
+      apply_visitor(*this, duration_tree_node);
+    }
+    thread_id_ = parent_thread_id;
+  }
+  std::string str(DurationTreeMap::const_reference kv_pair) {
+    root_start_ = kv_pair.second->start_;
+    (*this)(*kv_pair.second);
+    doc_.AddMember("traceEvents", events_, alloc_);
+    doc_.AddMember("displayTimeUnit", "ms", alloc_);
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+    doc_.Accept(writer);
+    return {buffer.GetString(), buffer.GetSize()};
+  }
+};
+
+std::atomic<size_t> g_next_trace_file_id{0};
+
+// Write the Chrome trace of a root timer to a new file of g_debug_timer_trace_dir,
+// named after the root timer.
+void writeChromeTrace(char const* root_name, std::string const& chrome_trace) {
+  auto const trace_path = boost::filesystem::path(g_debug_timer_trace_dir) /
+                          (std::string("trace_") + root_name + '_' +
+                           std::to_string(g_next_trace_file_id++) + ".json");
+  std::ofstream trace_file(trace_path.string());
+  if (!trace_file) {
+    LOG(WARNING) << "Failed to open the debug timer trace file " << trace_path;
+    return;
+  }
+  trace_file << chrome_trace;
+}
+
 /// Depth-first search and erase all DurationTrees. Not thread-safe.
 struct EraseDurationTrees : boost::static_visitor<> {
   void operator()(DurationTreeMap::const_iterator const& itr) const {
@@ -680,7 +800,7 @@ struct EraseDurationTrees : boost::static_visitor<> {
 };
 
 void logAndEraseDurationTree(std::string* json_str) {
-  std::lock_guard<std::mutex> lock_guard(g_duration_tree_map_mutex);
+  std::unique_lock<std::mutex> lock(g_duration_tree_map_mutex);
   DurationTreeMap::const_iterator const itr = g_duration_tree_map.find(g_thread_id);
   CHECK(itr != g_duration_tree_map.cend());
   auto const& root_duration = itr->second->rootDuration();
@@ -691,8 +811,19 @@ void logAndEraseDurationTree(std::string* json_str) {
     JsonEncoder json_encoder;
     *json_str = json_encoder.str(*itr);
   }
+  std::string chrome_trace;
+  if (!g_debug_timer_trace_dir.empty()) {
+    ChromeTraceEncoder chrome_trace_encoder;
+    chrome_trace = chrome_trace_encoder.str(*itr);
+  }
+  // Names of the timers are string literals, they outlive the tree.
+  char const* const root_name = root_duration.name_;
   EraseDurationTrees erase_duration_trees;
   erase_duration_trees(itr);
+  lock.unlock();
+  if (!chrome_trace.empty()) {
+    writeChromeTrace(root_name, chrome_trace);
+  }
 }
 
 DebugTimer::DebugTimer(Severity severity, char const* file, int line, char const* name)
@@ -44,6 +44,7 @@
 #include <boost/log/common.hpp>
 #include <boost/program_options.hpp>
 
+#include <atomic>
 #include <memory>
 #include <set>
 
@@ -60,6 +61,8 @@
 #endif
 
 extern bool g_enable_debug_timer;
+// Directory of the Chrome trace files of the debug timers, empty disables them.
+extern std::string g_debug_timer_trace_dir;
 
 namespace logger {
 
@@ -129,6 +132,7 @@ class LogOptions {
   size_t min_free_space_{20 << 20};
   bool rotate_daily_{true};
   size_t rotation_size_{10 << 20};
+  bool async_{false};
 
   LogOptions(char const* argv0);
   boost::filesystem::path full_log_dir() const;
@@ -203,6 +207,16 @@ inline bool fast_logging_check(Severity severity) {
 
 #define VLOGGING(n) logger::fast_logging_check(logger::DEBUG##n)
 
+// Rate limited logging for hot loops: logs the 1st, (n+1)th, (2n+1)th, ... occurrence
+// of the statement. Occurrences are only counted while the tag is being logged.
+#define LOG_EVERY_N(tag, n)                                                     \
+  if (static std::atomic<size_t> _omnisci_log_every_n_{0};                      \
+      LOGGING(tag) &&                                                           \
+      _omnisci_log_every_n_.fetch_add(1, std::memory_order_relaxed) % (n) == 0) \
+  LOG(tag)
+
+#define VLOG_EVERY_N(n, every_n) LOG_EVERY_N(DEBUG##n, every_n)
+
 #define CHECK(condition)            \
   if (BOOST_UNLIKELY(!(condition))) \
   LOG(FATAL) << "Check failed: " #condition " "
@@ -27,6 +27,11 @@
 #include <thrift/protocol/TBinaryProtocol.h>
 #include <thrift/protocol/TJSONProtocol.h>
 #include <thrift/server/TThreadedServer.h>
+#ifdef HAVE_THRIFT_NONBLOCKING_SERVER
+#include <thrift/server/TNonblockingServer.h>
+#include <thrift/transport/TNonblockingSSLServerSocket.h>
+#include <thrift/transport/TNonblockingServerSocket.h>
+#endif
 #include <thrift/transport/TBufferTransports.h>
 #include <thrift/transport/THttpServer.h>
 #include <thrift/transport/TSSLServerSocket.h>
@@ -60,7 +65,13 @@
 #include "Shared/SystemParameters.h"
 #include "Shared/file_delete.h"
 #include "Shared/scope.h"
+#ifdef HAVE_ARROW_FLIGHT
+#include "ThriftHandler/ArrowFlightServer.h"
+#endif
+#include "ThriftHandler/AutoVacuumScheduler.h"
+#include "ThriftHandler/DeferredCheckpointScheduler.h"
 #include "ThriftHandler/ForeignTableRefreshScheduler.h"
+#include "ThriftHandler/MetricsServer.h"
 
 using namespace ::apache::thrift;
 using namespace ::apache::thrift::concurrency;
@@ -79,6 +90,13 @@ std::atomic<int> g_saw_signal{-1};
 
 std::shared_ptr<TThreadedServer> g_thrift_http_server;
 std::shared_ptr<TThreadedServer> g_thrift_tcp_server;
+#ifdef HAVE_THRIFT_NONBLOCKING_SERVER
+std::shared_ptr<TNonblockingServer> g_thrift_nonblocking_server;
+#endif
+#ifdef HAVE_ARROW_FLIGHT
+std::shared_ptr<ArrowFlightServer> g_arrow_flight_server;
+#endif
+std::shared_ptr<MetricsServer> g_metrics_server;
 
 std::shared_ptr<DBHandler> g_warmup_handler;
 // global "g_warmup_handler" needed to avoid circular dependency
@@ -173,7 +191,7 @@ void register_signal_handlers() {
 
 }  // anonymous namespace
 
-void start_server(std::shared_ptr<TThreadedServer> server, const int port) {
+void start_server(std::shared_ptr<TServer> server, const int port) {
   try {
     server->serve();
     if (errno != 0) {
@@ -290,6 +308,29 @@ void thrift_stop() {
     thrift_tcp_server->stop();
   }
   g_thrift_tcp_server.reset();
+
+#ifdef HAVE_THRIFT_NONBLOCKING_SERVER
+  if (auto thrift_nonblocking_server = g_thrift_nonblocking_server;
+      thrift_nonblocking_server) {
+    thrift_nonblocking_server->stop();
+  }
+  g_thrift_nonblocking_server.reset();
+#endif
+
+#ifdef HAVE_ARROW_FLIGHT
+  if (auto arrow_flight_server = g_arrow_flight_server; arrow_flight_server) {
+    const auto status = arrow_flight_server->Shutdown();
+    if (!status.ok()) {
+      LOG(WARNING) << "Arrow Flight server shutdown failed: " << status.ToString();
+    }
+  }
+  g_arrow_flight_server.reset();
+#endif
+
+  if (auto metrics_server = g_metrics_server; metrics_server) {
+    metrics_server->stop();
+  }
+  g_metrics_server.reset();
 }
 
 void heartbeat() {
@@ -378,6 +419,9 @@ int startMapdServer(CommandLineOptions& prog_config_opts, bool start_http_server
       foreign_storage::ForeignTableRefreshScheduler::stop();
     }
 
+    AutoVacuumScheduler::stop();
+    DeferredCheckpointScheduler::stop();
+
     Catalog_Namespace::SysCatalog::destroy();
 
 #ifdef HAVE_AWS_S3
@@ -457,9 +501,15 @@ int startMapdServer(CommandLineOptions& prog_config_opts, bool start_http_server
     foreign_storage::ForeignTableRefreshScheduler::start(g_running);
   }
 
+  DeferredCheckpointScheduler::start(g_running);
+  AutoVacuumScheduler::start(g_running);
+
   // TCP port setup. We use Thrift both for a TCP socket and for an optional HTTP socket.
   std::shared_ptr<TServerSocket> tcp_socket;
   std::shared_ptr<TServerSocket> http_socket;
+#ifdef HAVE_THRIFT_NONBLOCKING_SERVER
+  std::shared_ptr<TNonblockingServerSocket> nonblocking_socket;
+#endif
 
   if (!prog_config_opts.system_parameters.ssl_cert_file.empty() &&
       !prog_config_opts.system_parameters.ssl_key_file.empty()) {
@@ -481,6 +531,12 @@ int startMapdServer(CommandLineOptions& prog_config_opts, bool start_http_server
       http_socket = std::make_shared<TSSLServerSocket>(prog_config_opts.http_port,
                                                        sslSocketFactory);
     }
+#ifdef HAVE_THRIFT_NONBLOCKING_SERVER
+    if (prog_config_opts.nonblocking_port) {
+      nonblocking_socket = std::make_shared<TNonblockingSSLServerSocket>(
+          prog_config_opts.nonblocking_port, sslSocketFactory);
+    }
+#endif
     LOG(INFO) << " OmniSci server using encrypted connection. Cert file ["
               << prog_config_opts.system_parameters.ssl_cert_file << "], key file ["
               << prog_config_opts.system_parameters.ssl_key_file << "]";
@@ -493,6 +549,12 @@ int startMapdServer(CommandLineOptions& prog_config_opts, bool start_http_server
     if (start_http_server) {
       http_socket = std::make_shared<TServerSocket>(prog_config_opts.http_port);
     }
+#ifdef HAVE_THRIFT_NONBLOCKING_SERVER
+    if (prog_config_opts.nonblocking_port) {
+      nonblocking_socket =
+          std::make_shared<TNonblockingServerSocket>(prog_config_opts.nonblocking_port);
+    }
+#endif
   }
 
   // Thrift uses the same processor for both the TCP port and the HTTP port.
@@ -521,6 +583,73 @@ int startMapdServer(CommandLineOptions& prog_config_opts, bool start_http_server
         start_server, g_thrift_http_server, prog_config_opts.http_port));
   }
 
+#ifdef HAVE_THRIFT_NONBLOCKING_SERVER
+  // Thrift non-blocking server launch. Its IO thread multiplexes the connections on an
+  // event loop and only hands complete framed requests to the worker threads, idle
+  // connections cost a socket rather than a thread.
+  if (nonblocking_socket) {
+    auto thread_manager = ThreadManager::newSimpleThreadManager(
+        std::max(prog_config_opts.nonblocking_server_threads, size_t(1)));
+#ifdef HAVE_THRIFT_THREADFACTORY
+    thread_manager->threadFactory(std::make_shared<ThreadFactory>());
+#else
+    thread_manager->threadFactory(std::make_shared<PlatformThreadFactory>());
+#endif
+    thread_manager->start();
+    std::shared_ptr<TProtocolFactory> nonblocking_pf{
+        std::make_shared<TBinaryProtocolFactory>()};
+    g_thrift_nonblocking_server = std::make_shared<TNonblockingServer>(
+        processor, nonblocking_pf, nonblocking_socket, thread_manager);
+    server_threads.insert(std::make_unique<std::thread>(
+        start_server, g_thrift_nonblocking_server, prog_config_opts.nonblocking_port));
+    LOG(INFO) << " OmniSci server serving non-blocking Thrift on port "
+              << prog_config_opts.nonblocking_port << " with "
+              << thread_manager->workerCount() << " worker threads";
+  }
+#endif
+
+#ifdef HAVE_ARROW_FLIGHT
+  // Arrow Flight server launch.
+  if (prog_config_opts.arrow_flight_port) {
+    const auto port = prog_config_opts.arrow_flight_port;
+    auto arrow_flight_server = std::make_shared<ArrowFlightServer>(g_mapd_handler);
+    const auto status = arrow_flight_server->init(port);
+    if (!status.ok()) {
+      LOG(FATAL) << "Failed to start the Arrow Flight server on port " << port << ": "
+                 << status.ToString();
+    }
+    g_arrow_flight_server = arrow_flight_server;
+    server_threads.insert(std::make_unique<std::thread>([arrow_flight_server, port] {
+      const auto status = arrow_flight_server->Serve();
+      if (!status.ok()) {
+        LOG(ERROR) << "Arrow Flight server exited: " << status.ToString() << ": port "
+                   << port;
+      }
+    }));
+    LOG(INFO) << " OmniSci server serving Arrow Flight on port " << port;
+  }
+#endif
+
+  // Prometheus metrics server launch.
+  if (prog_config_opts.metrics_port) {
+    const auto port = prog_config_opts.metrics_port;
+    std::weak_ptr<DBHandler> weak_handler = g_mapd_handler;
+    auto metrics_server = std::make_shared<MetricsServer>([weak_handler] {
+      auto handler = weak_handler.lock();
+      return handler ? handler->getPrometheusMetrics() : std::string();
+    });
+    try {
+      metrics_server->init(port);
+    } catch (const boost::system::system_error& e) {
+      LOG(FATAL) << "Failed to start the metrics server on port " << port << ": "
+                 << e.what();
+    }
+    g_metrics_server = metrics_server;
+    server_threads.insert(
+        std::make_unique<std::thread>([metrics_server] { metrics_server->serve(); }));
+    LOG(INFO) << " OmniSci server serving Prometheus metrics on port " << port;
+  }
+
   // Run warm up queries if any exist.
   run_warmup_queries(
       g_mapd_handler, prog_config_opts.base_path, prog_config_opts.db_query_file);
@@ -19,6 +19,13 @@
 #include <sys/fcntl.h>
 #include <sys/mman.h>
 #include <sys/stat.h>
+#include <sys/uio.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <set>
 
 #include "Logger/Logger.h"
 
@@ -61,6 +68,24 @@ int fsync(int fd) {
   return ::fsync(fd);
 }
 
+bool sync_file_systems(const std::vector<int>& fds) {
+#ifdef __linux__
+  std::set<dev_t> synced_devices;
+  for (const auto fd : fds) {
+    struct stat buf;
+    if (fstat(fd, &buf) != 0) {
+      return false;
+    }
+    if (synced_devices.insert(buf.st_dev).second && ::syncfs(fd) != 0) {
+      return false;
+    }
+  }
+  return true;
+#else
+  return false;
+#endif
+}
+
 int open(const char* path, int flags, int mode) {
   return ::open(path, flags, mode);
 }
@@ -73,4 +98,41 @@ void close(const int fd) {
   return ::fopen(filename, mode);
 }
 
+size_t checked_read_vectored(const int fd,
+                             const size_t offset,
+                             const std::vector<std::pair<int8_t*, size_t>>& buffers) {
+  std::vector<iovec> iovecs;
+  iovecs.reserve(buffers.size());
+  size_t total_size{0};
+  for (const auto& [buf, size] : buffers) {
+    iovecs.push_back({buf, size});
+    total_size += size;
+  }
+  size_t total_bytes_read{0};
+  size_t iovec_idx{0};
+  while (total_bytes_read < total_size) {
+    const int iovec_count = std::min(iovecs.size() - iovec_idx, size_t(IOV_MAX));
+    const auto bytes_read =
+        ::preadv(fd, &iovecs[iovec_idx], iovec_count, offset + total_bytes_read);
+    if (bytes_read < 0 && errno == EINTR) {
+      continue;
+    }
+    CHECK_GT(bytes_read, 0) << "Error trying to read from file, the error was: "
+                            << std::strerror(errno);
+    total_bytes_read += bytes_read;
+    // skip the filled buffers and resume a partially filled one
+    size_t bytes_left = bytes_read;
+    while (iovec_idx < iovecs.size() && bytes_left >= iovecs[iovec_idx].iov_len) {
+      bytes_left -= iovecs[iovec_idx].iov_len;
+      ++iovec_idx;
+    }
+    if (bytes_left) {
+      iovecs[iovec_idx].iov_base = static_cast<int8_t*>(iovecs[iovec_idx].iov_base) +
+                                   bytes_left;
+      iovecs[iovec_idx].iov_len -= bytes_left;
+    }
+  }
+  return total_bytes_read;
+}
+
 }  // namespace omnisci
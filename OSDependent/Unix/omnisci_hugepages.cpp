@@ -0,0 +1,145 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "OSDependent/omnisci_hugepages.h"
+
+#include <sys/mman.h>
+
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "Logger/Logger.h"
+
+namespace omnisci {
+
+namespace {
+
+struct HugePageAllocation {
+  size_t size;
+  bool hugetlb;
+};
+
+std::mutex huge_page_allocations_mutex;
+std::unordered_map<void*, HugePageAllocation> huge_page_allocations;
+HugePageStats huge_page_stats;
+
+// AnonHugePages of /proc/self/smaps_rollup, which also covers memory collapsed into
+// huge pages by khugepaged after the allocation.
+size_t read_anon_huge_page_bytes() {
+  std::ifstream smaps_rollup("/proc/self/smaps_rollup");
+  const std::string anon_huge_pages{"AnonHugePages:"};
+  std::string line;
+  while (std::getline(smaps_rollup, line)) {
+    if (line.compare(0, anon_huge_pages.size(), anon_huge_pages) == 0) {
+      try {
+        return std::stoull(line.substr(anon_huge_pages.size())) * 1024;
+      } catch (const std::exception&) {
+        return 0;
+      }
+    }
+  }
+  return 0;
+}
+
+// Maps anonymous memory starting on a huge page boundary, the only ranges transparent
+// huge pages can back.
+void* map_huge_page_aligned(const size_t size) {
+  const auto raw_size = size + kHugePageSize;
+  auto raw_addr =
+      mmap(nullptr, raw_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (raw_addr == MAP_FAILED) {
+    return nullptr;
+  }
+  const auto raw_begin = reinterpret_cast<uintptr_t>(raw_addr);
+  const auto begin = (raw_begin + kHugePageSize - 1) & ~(kHugePageSize - 1);
+  const auto end = begin + size;
+  if (begin > raw_begin) {
+    munmap(raw_addr, begin - raw_begin);
+  }
+  if (raw_begin + raw_size > end) {
+    munmap(reinterpret_cast<void*>(end), raw_begin + raw_size - end);
+  }
+  return reinterpret_cast<void*>(begin);
+}
+
+}  // namespace
+
+void* allocate_huge_pages(const size_t size) {
+  CHECK_GE(size, kHugePageSize);
+  const auto mapped_size = (size + kHugePageSize - 1) & ~(kHugePageSize - 1);
+  void* addr{nullptr};
+  bool hugetlb{false};
+#ifdef MAP_HUGETLB
+  addr = mmap(nullptr,
+              mapped_size,
+              PROT_READ | PROT_WRITE,
+              MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB,
+              -1,
+              0);
+  if (addr == MAP_FAILED) {
+    addr = nullptr;
+  } else {
+    hugetlb = true;
+  }
+#endif
+  if (!addr) {
+    // No reserved huge pages left, or none configured.
+    addr = map_huge_page_aligned(mapped_size);
+    if (!addr) {
+      return nullptr;
+    }
+#ifdef MADV_HUGEPAGE
+    if (madvise(addr, mapped_size, MADV_HUGEPAGE)) {
+      VLOG(1) << "Transparent huge pages are not available for a " << mapped_size
+              << " bytes allocation";
+    }
+#endif
+  }
+  std::lock_guard<std::mutex> lock(huge_page_allocations_mutex);
+  huge_page_allocations.emplace(addr, HugePageAllocation{mapped_size, hugetlb});
+  (hugetlb ? huge_page_stats.hugetlb_bytes : huge_page_stats.transparent_bytes) +=
+      mapped_size;
+  return addr;
+}
+
+bool free_huge_pages(void* addr) {
+  std::lock_guard<std::mutex> lock(huge_page_allocations_mutex);
+  const auto it = huge_page_allocations.find(addr);
+  if (it == huge_page_allocations.end()) {
+    return false;
+  }
+  const auto& allocation = it->second;
+  CHECK_EQ(0, munmap(addr, allocation.size));
+  (allocation.hugetlb ? huge_page_stats.hugetlb_bytes
+                      : huge_page_stats.transparent_bytes) -= allocation.size;
+  huge_page_allocations.erase(it);
+  return true;
+}
+
+HugePageStats get_huge_page_stats() {
+  HugePageStats stats;
+  {
+    std::lock_guard<std::mutex> lock(huge_page_allocations_mutex);
+    stats = huge_page_stats;
+  }
+  stats.anon_huge_page_bytes = read_anon_huge_page_bytes();
+  return stats;
+}
+
+}  // namespace omnisci
@@ -0,0 +1,159 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "OSDependent/omnisci_numa.h"
+
+#ifdef __linux__
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "Logger/Logger.h"
+
+namespace omnisci {
+
+#ifdef __linux__
+
+namespace {
+
+const std::string sys_node_path{"/sys/devices/system/node/node"};
+
+// Parses a cpu list such as "0-3,8-11" from sysfs.
+std::vector<int> get_numa_node_cpus(const int node) {
+  std::ifstream cpulist_file(sys_node_path + std::to_string(node) + "/cpulist");
+  std::string cpulist;
+  std::vector<int> cpus;
+  if (!std::getline(cpulist_file, cpulist)) {
+    return cpus;
+  }
+  std::istringstream ranges(cpulist);
+  std::string range;
+  while (std::getline(ranges, range, ',')) {
+    const auto dash_pos = range.find('-');
+    try {
+      const int first_cpu = std::stoi(range.substr(0, dash_pos));
+      const int last_cpu = dash_pos == std::string::npos
+                               ? first_cpu
+                               : std::stoi(range.substr(dash_pos + 1));
+      for (int cpu = first_cpu; cpu <= last_cpu; ++cpu) {
+        cpus.push_back(cpu);
+      }
+    } catch (const std::exception&) {
+      return {};
+    }
+  }
+  return cpus;
+}
+
+size_t count_numa_nodes() {
+  size_t node_count = 0;
+  while (std::ifstream(sys_node_path + std::to_string(node_count) + "/cpulist")) {
+    ++node_count;
+  }
+  return std::max(node_count, size_t(1));
+}
+
+bool set_thread_cpus(const std::vector<int>& cpus) {
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  for (const auto cpu : cpus) {
+    if (cpu < CPU_SETSIZE) {
+      CPU_SET(cpu, &cpu_set);
+    }
+  }
+  return sched_setaffinity(0, sizeof(cpu_set), &cpu_set) == 0;
+}
+
+}  // namespace
+
+size_t get_numa_node_count() {
+  static const size_t node_count = count_numa_nodes();
+  return node_count;
+}
+
+bool bind_memory_to_numa_node(void* addr, const size_t size, const int node) {
+  CHECK_GE(node, 0);
+  constexpr int kMpolPreferred{1};  // MPOL_PREFERRED from linux/mempolicy.h
+  constexpr size_t kNodeMaskBits{8 * sizeof(unsigned long)};
+  if (static_cast<size_t>(node) >= kNodeMaskBits) {
+    return false;
+  }
+  // mbind requires a page aligned range, the partial pages at both ends stay put
+  const auto page_size = static_cast<uintptr_t>(getpagesize());
+  const auto addr_begin = reinterpret_cast<uintptr_t>(addr);
+  const auto begin = (addr_begin + page_size - 1) & ~(page_size - 1);
+  const auto end = (addr_begin + size) & ~(page_size - 1);
+  if (begin >= end) {
+    return true;
+  }
+  const unsigned long node_mask = 1UL << node;
+  return syscall(SYS_mbind,
+                 reinterpret_cast<void*>(begin),
+                 end - begin,
+                 kMpolPreferred,
+                 &node_mask,
+                 kNodeMaskBits,
+                 0) == 0;
+}
+
+NumaNodeThreadBinding::NumaNodeThreadBinding(const int node) {
+  const auto node_cpus = get_numa_node_cpus(node);
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  if (node_cpus.empty() || sched_getaffinity(0, sizeof(cpu_set), &cpu_set)) {
+    return;
+  }
+  std::vector<int> previous_cpus;
+  for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+    if (CPU_ISSET(cpu, &cpu_set)) {
+      previous_cpus.push_back(cpu);
+    }
+  }
+  if (set_thread_cpus(node_cpus)) {
+    previous_cpus_ = std::move(previous_cpus);
+  }
+}
+
+NumaNodeThreadBinding::~NumaNodeThreadBinding() {
+  if (!previous_cpus_.empty()) {
+    set_thread_cpus(previous_cpus_);
+  }
+}
+
+#else
+
+size_t get_numa_node_count() {
+  return 1;
+}
+
+bool bind_memory_to_numa_node(void* addr, const size_t size, const int node) {
+  return false;
+}
+
+NumaNodeThreadBinding::NumaNodeThreadBinding(const int node) {}
+
+NumaNodeThreadBinding::~NumaNodeThreadBinding() {}
+
+#endif
+
+}  // namespace omnisci
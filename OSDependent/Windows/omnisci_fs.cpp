@@ -64,6 +64,10 @@ int fsync(int fd) {
   return fflush(file);
 }
 
+bool sync_file_systems(const std::vector<int>& fds) {
+  return false;
+}
+
 int open(const char* path, int flags, int mode) {
   return _open(path, flags, mode);
 }
@@ -94,4 +98,17 @@ int get_page_size() {
   return 4096;  // TODO: reasonable guess for now
 }
 
+size_t checked_read_vectored(const int fd,
+                             const size_t offset,
+                             const std::vector<std::pair<int8_t*, size_t>>& buffers) {
+  CHECK_EQ(_lseeki64(fd, offset, SEEK_SET), static_cast<__int64>(offset));
+  size_t total_bytes_read{0};
+  for (const auto& [buf, size] : buffers) {
+    const auto bytes_read = _read(fd, buf, size);
+    CHECK_EQ(static_cast<size_t>(bytes_read), size);
+    total_bytes_read += bytes_read;
+  }
+  return total_bytes_read;
+}
+
 }  // namespace omnisci
@@ -17,8 +17,12 @@
 #pragma once
 
 #include <stddef.h>
+#include <stdint.h>
 #include <stdio.h>
 
+#include <utility>
+#include <vector>
+
 namespace omnisci {
 
 size_t file_size(const int fd);
@@ -31,6 +35,13 @@ int msync(void* addr, size_t length, bool async);
 
 int fsync(int fd);
 
+/**
+ * Syncs the file systems holding the given files to disk, with one system call per
+ * file system instead of one per file. Returns false if this is not supported by the
+ * platform or if a sync fails, in which case the files should be synced one by one.
+ */
+bool sync_file_systems(const std::vector<int>& fds);
+
 int open(const char* path, int flags, int mode);
 
 void close(const int fd);
@@ -39,4 +50,14 @@ void close(const int fd);
 
 int get_page_size();
 
+/**
+ * Reads consecutive bytes of the file starting at `offset` into the given (address,
+ * size) buffers in order, with as few system calls as the platform allows. The file
+ * position is unspecified afterwards. Returns the number of bytes read, which is the
+ * total buffer size.
+ */
+size_t checked_read_vectored(const int fd,
+                             const size_t offset,
+                             const std::vector<std::pair<int8_t*, size_t>>& buffers);
+
 }  // namespace omnisci
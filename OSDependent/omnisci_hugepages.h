@@ -0,0 +1,48 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <stddef.h>
+
+namespace omnisci {
+
+// Size of a huge page, the smallest allocation allocate_huge_pages() accepts.
+constexpr size_t kHugePageSize{size_t(1) << 21};
+
+/**
+ * Maps `size` bytes of anonymous memory backed by huge pages: explicit huge pages
+ * (MAP_HUGETLB) while the reserved pool lasts, otherwise transparent huge pages through
+ * madvise(MADV_HUGEPAGE). Returns nullptr if the memory cannot be mapped at all, callers
+ * fall back to malloc then.
+ */
+void* allocate_huge_pages(const size_t size);
+
+/**
+ * Unmaps memory returned by allocate_huge_pages(). Returns false, leaving the memory
+ * alone, for any other address, so that allocators can free it with free() instead.
+ */
+bool free_huge_pages(void* addr);
+
+struct HugePageStats {
+  size_t hugetlb_bytes{0};         // live allocations on explicit huge pages
+  size_t transparent_bytes{0};     // live allocations advised to use THP
+  size_t anon_huge_page_bytes{0};  // process memory the kernel backs with THP
+};
+
+HugePageStats get_huge_page_stats();
+
+}  // namespace omnisci
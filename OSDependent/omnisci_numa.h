@@ -0,0 +1,51 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <vector>
+
+namespace omnisci {
+
+// Number of NUMA nodes with memory, 1 where the topology isn't available.
+size_t get_numa_node_count();
+
+/**
+ * Asks the kernel to back [addr, addr + size) with memory of `node`, falling back to
+ * other nodes when it runs out. Only pages which haven't been touched yet are placed,
+ * so this must be called right after the allocation. Returns false if not supported.
+ */
+bool bind_memory_to_numa_node(void* addr, const size_t size, const int node);
+
+/**
+ * Restricts the calling thread to the cpus of a NUMA node for the lifetime of the
+ * object, restoring the previous affinity afterwards. A no-op where not supported.
+ */
+class NumaNodeThreadBinding {
+ public:
+  explicit NumaNodeThreadBinding(const int node);
+
+  ~NumaNodeThreadBinding();
+
+  NumaNodeThreadBinding(const NumaNodeThreadBinding&) = delete;
+  NumaNodeThreadBinding& operator=(const NumaNodeThreadBinding&) = delete;
+
+ private:
+  std::vector<int> previous_cpus_;
+};
+
+}  // namespace omnisci
@@ -35,6 +35,7 @@
 
 #include <cassert>
 #include <cmath>
+#include <future>
 #include <limits>
 #include <random>
 #include <regex>
@@ -75,6 +76,7 @@ bool g_enable_calcite_ddl_parser{true};
 
 size_t g_leaf_count{0};
 bool g_test_drop_column_rollback{false};
+bool g_enable_pipelined_itas{false};
 extern bool g_enable_experimental_string_functions;
 extern bool g_enable_fsi;
 
@@ -2013,7 +2015,8 @@ void set_string_field(rapidjson::Value& obj,
 
 std::string serialize_key_metainfo(
     const ShardKeyDef* shard_key_def,
-    const std::vector<SharedDictionaryDef>& shared_dict_defs) {
+    const std::vector<SharedDictionaryDef>& shared_dict_defs,
+    const TableDescriptor* td = nullptr) {
   rapidjson::Document document;
   auto& allocator = document.GetAllocator();
   rapidjson::Value arr(rapidjson::kArrayType);
@@ -2035,6 +2038,29 @@ std::string serialize_key_metainfo(
                      document);
     arr.PushBack(shared_dict_obj, allocator);
   }
+  if (td && !td->clusterColumnIds.empty()) {
+    rapidjson::Value cluster_columns_obj(rapidjson::kObjectType);
+    set_string_field(cluster_columns_obj, "type", "CLUSTER COLUMNS", document);
+    rapidjson::Value column_ids(rapidjson::kArrayType);
+    for (const auto column_id : td->clusterColumnIds) {
+      column_ids.PushBack(column_id, allocator);
+    }
+    cluster_columns_obj.AddMember("column_ids", column_ids, allocator);
+    arr.PushBack(cluster_columns_obj, allocator);
+  }
+  if (td && td->partitionColumnId > 0) {
+    rapidjson::Value partition_obj(rapidjson::kObjectType);
+    set_string_field(partition_obj, "type", "PARTITION", document);
+    partition_obj.AddMember("column_id", td->partitionColumnId, allocator);
+    partition_obj.AddMember("interval_seconds", td->partitionIntervalSeconds, allocator);
+    partition_obj.AddMember("retention", td->partitionRetention, allocator);
+    arr.PushBack(partition_obj, allocator);
+  }
+  if (td && td->keepResident) {
+    rapidjson::Value keep_resident_obj(rapidjson::kObjectType);
+    set_string_field(keep_resident_obj, "type", "KEEP RESIDENT", document);
+    arr.PushBack(keep_resident_obj, allocator);
+  }
   rapidjson::StringBuffer buffer;
   rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
   arr.Accept(writer);
@@ -2187,6 +2213,119 @@ decltype(auto) get_sort_column_def(TableDescriptor& td,
   });
 }
 
+decltype(auto) get_cluster_columns_def(TableDescriptor& td,
+                                       const NameValueAssign* p,
+                                       const std::list<ColumnDescriptor>& columns) {
+  return get_property_value<StringLiteral>(p, [&td, &columns](const auto names_upper) {
+    std::vector<std::string> names;
+    boost::split(names, names_upper, boost::is_any_of(","));
+    td.clusterColumnIds.clear();
+    for (auto& name : names) {
+      boost::trim(name);
+      const auto column_id = sort_column_index(name, columns);
+      if (!column_id) {
+        throw std::runtime_error("Specified cluster column " + name + " doesn't exist");
+      }
+      const auto cd_it =
+          std::find_if(columns.begin(), columns.end(), [&name](const auto& cd) {
+            return boost::to_upper_copy<std::string>(cd.columnName) == name;
+          });
+      CHECK(cd_it != columns.end());
+      const auto& ti = cd_it->columnType;
+      if (ti.is_array() || ti.is_geometry() ||
+          (ti.is_string() && ti.get_compression() != kENCODING_DICT)) {
+        throw std::runtime_error("Cluster column " + name +
+                                 " must be a fixed width, non array column.");
+      }
+      if (std::find(td.clusterColumnIds.begin(),
+                    td.clusterColumnIds.end(),
+                    static_cast<int>(column_id)) != td.clusterColumnIds.end()) {
+        throw std::runtime_error("Cluster column " + name + " is specified twice.");
+      }
+      td.clusterColumnIds.push_back(column_id);
+    }
+  });
+}
+
+decltype(auto) get_partition_column_def(TableDescriptor& td,
+                                        const NameValueAssign* p,
+                                        const std::list<ColumnDescriptor>& columns) {
+  return get_property_value<StringLiteral>(p, [&td, &columns](const auto name_upper) {
+    const auto column_id = sort_column_index(name_upper, columns);
+    if (!column_id) {
+      throw std::runtime_error("Specified partition column " + name_upper +
+                               " doesn't exist");
+    }
+    const auto cd_it =
+        std::find_if(columns.begin(), columns.end(), [&name_upper](const auto& cd) {
+          return boost::to_upper_copy<std::string>(cd.columnName) == name_upper;
+        });
+    CHECK(cd_it != columns.end());
+    const auto type = cd_it->columnType.get_type();
+    if (type != kTIMESTAMP && type != kDATE) {
+      throw std::runtime_error("Partition column " + name_upper +
+                               " must be a TIMESTAMP or DATE column.");
+    }
+    td.partitionColumnId = column_id;
+  });
+}
+
+decltype(auto) get_partition_interval_def(TableDescriptor& td,
+                                          const NameValueAssign* p,
+                                          const std::list<ColumnDescriptor>& columns) {
+  if (dynamic_cast<const IntLiteral*>(p->get_value())) {
+    auto assignment = [&td](const auto val) { td.partitionIntervalSeconds = val; };
+    return get_property_value<IntLiteral, decltype(assignment), PositiveOrZeroValidate>(
+        p, assignment);
+  }
+  return get_property_value<StringLiteral>(p, [&td](const auto interval_upper) {
+    static const std::map<std::string, int64_t> interval_seconds{
+        {"HOUR", 3600}, {"DAY", 86400}, {"WEEK", 604800}};
+    const auto it = interval_seconds.find(interval_upper);
+    if (it == interval_seconds.end()) {
+      throw std::runtime_error(
+          "PARTITION_INTERVAL must be HOUR, DAY, WEEK or a number of seconds.");
+    }
+    td.partitionIntervalSeconds = it->second;
+  });
+}
+
+decltype(auto) get_partition_retention_def(TableDescriptor& td,
+                                           const NameValueAssign* p,
+                                           const std::list<ColumnDescriptor>& columns) {
+  auto assignment = [&td](const auto val) { td.partitionRetention = val; };
+  return get_property_value<IntLiteral, decltype(assignment), PositiveOrZeroValidate>(
+      p, assignment);
+}
+
+decltype(auto) get_keep_resident_def(TableDescriptor& td,
+                                     const NameValueAssign* p,
+                                     const std::list<ColumnDescriptor>& columns) {
+  return get_property_value<StringLiteral>(p, [&td](const auto val) {
+    if (val == "FALSE") {
+      td.keepResident = false;
+    } else if (val == "TRUE") {
+      td.keepResident = true;
+    } else {
+      throw std::runtime_error(
+          "Option KEEP_RESIDENT support only 'true' or 'false' values.");
+    }
+  });
+}
+
+void validate_partition_options(TableDescriptor& td) {
+  if (!td.partitionColumnId) {
+    if (td.partitionIntervalSeconds || td.partitionRetention) {
+      throw std::runtime_error(
+          "PARTITION_INTERVAL and PARTITION_RETENTION need a PARTITION_COLUMN.");
+    }
+    return;
+  }
+  if (!td.partitionIntervalSeconds) {
+    td.partitionIntervalSeconds = 86400;
+  }
+}
+
 decltype(auto) get_max_rollback_epochs_def(TableDescriptor& td,
                                            const NameValueAssign* p,
                                            const std::list<ColumnDescriptor>& columns) {
@@ -2209,6 +2348,11 @@ static const std::map<const std::string, const TableDefFuncPtr> tableDefFuncMap
     {"shard_count"s, get_shard_count_def},
     {"vacuum"s, get_vacuum_def},
     {"sort_column"s, get_sort_column_def},
+    {"cluster_columns"s, get_cluster_columns_def},
+    {"partition_column"s, get_partition_column_def},
+    {"partition_interval"s, get_partition_interval_def},
+    {"partition_retention"s, get_partition_retention_def},
+    {"keep_resident"s, get_keep_resident_def},
     {"storage_type"s, get_storage_type},
     {"max_rollback_epochs", get_max_rollback_epochs_def}};
 
@@ -2221,7 +2365,9 @@ void get_table_definitions(TableDescriptor& td,
         "Invalid CREATE TABLE option " + *p->get_name() +
         ". Should be FRAGMENT_SIZE, MAX_CHUNK_SIZE, PAGE_SIZE, MAX_ROLLBACK_EPOCHS, "
         "MAX_ROWS, "
-        "PARTITIONS, SHARD_COUNT, VACUUM, SORT_COLUMN, STORAGE_TYPE.");
+        "PARTITIONS, SHARD_COUNT, VACUUM, SORT_COLUMN, CLUSTER_COLUMNS, "
+        "PARTITION_COLUMN, PARTITION_INTERVAL, PARTITION_RETENTION, KEEP_RESIDENT, "
+        "STORAGE_TYPE.");
   }
   return it->second(td, p.get(), columns);
 }
@@ -2235,7 +2381,9 @@ void get_table_definitions_for_ctas(TableDescriptor& td,
         "Invalid CREATE TABLE AS option " + *p->get_name() +
         ". Should be FRAGMENT_SIZE, MAX_CHUNK_SIZE, PAGE_SIZE, MAX_ROLLBACK_EPOCHS, "
         "MAX_ROWS, "
-        "PARTITIONS, SHARD_COUNT, VACUUM, SORT_COLUMN, STORAGE_TYPE or "
+        "PARTITIONS, SHARD_COUNT, VACUUM, SORT_COLUMN, CLUSTER_COLUMNS, "
+        "PARTITION_COLUMN, PARTITION_INTERVAL, PARTITION_RETENTION, KEEP_RESIDENT, "
+        "STORAGE_TYPE or "
         "USE_SHARED_DICTIONARIES.");
   }
   return it->second(td, p.get(), columns);
@@ -2484,7 +2632,8 @@ void CreateTableStmt::executeDryRun(const Catalog_Namespace::SessionInfo& sessio
   if (td.shardedColumnId && !td.nShards) {
     throw std::runtime_error("SHARD_COUNT needs to be specified with SHARD_KEY.");
   }
-  td.keyMetainfo = serialize_key_metainfo(shard_key_def, shared_dict_defs);
+  validate_partition_options(td);
+  td.keyMetainfo = serialize_key_metainfo(shard_key_def, shared_dict_defs, &td);
 }
 
 void CreateTableStmt::execute(const Catalog_Namespace::SessionInfo& session) {
@@ -2595,7 +2744,8 @@ std::shared_ptr<ResultSet> getResultSet(QueryStateProxy query_state_proxy,
                                         std::vector<TargetMetaInfo>& targets,
                                         bool validate_only = false,
                                         std::vector<size_t> outer_fragment_indices = {},
-                                        bool allow_interrupt = false) {
+                                        bool allow_interrupt = false,
+                                        bool output_columnar = false) {
   auto const session = query_state_proxy.getQueryState().getConstSessionInfo();
   auto& catalog = session->getCatalog();
 
@@ -2626,7 +2776,7 @@ std::shared_ptr<ResultSet> getResultSet(QueryStateProxy query_state_proxy,
   co.opt_level = ExecutorOptLevel::LoopStrengthReduction;
   // TODO(adb): Need a better method of dropping constants into this ExecutionOptions
   // struct
-  ExecutionOptions eo = {false,
+  ExecutionOptions eo = {output_columnar,
                          true,
                          false,
                          true,
@@ -2727,7 +2877,8 @@ AggregatedResult LocalConnector::query(QueryStateProxy query_state_proxy,
                                   target_metainfos,
                                   validate_only,
                                   outer_frag_indices,
-                                  allow_interrupt);
+                                  allow_interrupt,
+                                  output_columnar);
   AggregatedResult res = {result_rows, target_metainfos};
   return res;
 }
@@ -2831,6 +2982,60 @@ InsertIntoTableAsSelectStmt::InsertIntoTableAsSelectStmt(
   }
 }
 
+namespace {
+
+// Whether the result set holds the values of its target in the layout of the target
+// column, so that they can be inserted from the result set buffer as they are.
+bool is_direct_insert_target(const ResultSet& result_rows,
+                             const size_t target_idx,
+                             const SQLTypeInfo& source_ti,
+                             const ColumnDescriptor* cd) {
+  const auto& target_ti = cd->columnType;
+  if (!result_rows.isZeroCopyColumnarConversionPossible(target_idx) ||
+      source_ti.is_string() || source_ti.is_varlen() || source_ti.is_geometry() ||
+      target_ti.get_notnull()) {
+    return false;
+  }
+  return source_ti.get_type() == target_ti.get_type() &&
+         source_ti.get_dimension() == target_ti.get_dimension() &&
+         source_ti.get_scale() == target_ti.get_scale() &&
+         source_ti.get_compression() == kENCODING_NONE &&
+         target_ti.get_compression() == kENCODING_NONE &&
+         result_rows.getPaddedSlotWidthBytes(target_idx) == target_ti.get_size();
+}
+
+// Returns whether every target of the columnar projection `result_rows` can be inserted
+// from the result set buffer. Rows are only carried over this way if all of them can, the
+// value converters may emit rows in any order.
+bool can_insert_result_set_buffers(
+    const ResultSet& result_rows,
+    const std::vector<TargetMetaInfo>& targets_meta,
+    const std::vector<const ColumnDescriptor*>& target_column_descriptors) {
+  if (!result_rows.isDirectColumnarConversionPossible() || result_rows.isTruncated() ||
+      result_rows.entryCount() != result_rows.rowCount()) {
+    return false;
+  }
+  CHECK_EQ(targets_meta.size(), target_column_descriptors.size());
+  for (const auto& target_meta : targets_meta) {
+    // The buffer of a target is found by its slot index, which only matches the target
+    // index when every target has a single slot.
+    if (target_meta.get_type_info().is_varlen()) {
+      return false;
+    }
+  }
+  for (size_t target_idx = 0; target_idx < targets_meta.size(); ++target_idx) {
+    if (!is_direct_insert_target(result_rows,
+                                 target_idx,
+                                 targets_meta[target_idx].get_type_info(),
+                                 target_column_descriptors[target_idx])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
 void InsertIntoTableAsSelectStmt::populateData(QueryStateProxy query_state_proxy,
                                                const TableDescriptor* td,
                                                bool validate_table,
@@ -2840,6 +3045,7 @@ void InsertIntoTableAsSelectStmt::populateData(QueryStateProxy query_state_proxy
   foreign_storage::validate_non_foreign_table_write(td);
 
   LocalConnector local_connector;
+  local_connector.output_columnar = true;
   bool populate_table = false;
 
   if (leafs_connector_) {
@@ -3008,265 +3214,258 @@ void InsertIntoTableAsSelectStmt::populateData(QueryStateProxy query_state_proxy
   auto query_session = session ? session->get_session_id() : "";
   auto executor = Executor::getExecutor(Executor::UNITARY_EXECUTOR_ID).get();
   std::string work_type_str = for_CTAS ? "CTAS" : "ITAS";
-  try {
-    for (size_t outer_frag_idx = 0; outer_frag_idx < outer_frag_end; outer_frag_idx++) {
-      std::vector<size_t> allowed_outer_fragment_indices;
+  const auto insert_data_query_str = "INSERT_DATA for " + work_type_str;
+  const bool pipelined_load = g_enable_pipelined_itas && outer_frag_end > 1;
+  // Converts and loads the results of the query over an outer fragment. With pipelining,
+  // the results of a fragment are loaded while the query runs over the next one.
+  auto load_query_results = [&](std::vector<AggregatedResult> query_results) {
+    auto start_time = query_state_proxy.getQueryState().getQuerySubmittedTime();
+    const auto& query_str = insert_data_query_str;
+    // The pipelined loads run under the session entry enrolled around all of them.
+    if (g_enable_non_kernel_time_query_interrupt && !pipelined_load) {
+      // In the clean-up phase of the query execution for collecting aggregated result
+      // of SELECT query, we remove its query session info, so we need to enroll the
+      // session info again
+      executor->enrollQuerySession(query_session,
+                                   query_str,
+                                   start_time,
+                                   Executor::UNITARY_EXECUTOR_ID,
+                                   QuerySessionStatus::QueryStatus::RUNNING);
+    }
+
+    ScopeGuard clearInterruptStatus =
+        [executor, &query_session, &start_time, pipelined_load] {
+          // this data population is non-kernel operation, so we manually cleanup
+          // the query session info in the cleanup phase
+          if (g_enable_non_kernel_time_query_interrupt && !pipelined_load) {
+            executor->clearQuerySessionStatus(query_session, start_time, false);
+          }
+        };
 
-      if (outer_frag_count) {
-        allowed_outer_fragment_indices.push_back(outer_frag_idx);
+    for (auto& res : query_results) {
+      if (UNLIKELY(checkInterrupt(query_session, executor))) {
+        throw std::runtime_error(
+            "Query execution has been interrupted while performing " + work_type_str);
       }
+      auto& result_rows = res.rs;
+      result_rows->setGeoReturnType(ResultSet::GeoReturnType::GeoTargetValue);
+      const auto num_rows = result_rows->rowCount();
 
-      const auto query_clock_begin = timer_start();
-      std::vector<AggregatedResult> query_results =
-          leafs_connector_->query(query_state_proxy,
-                                  select_query_,
-                                  allowed_outer_fragment_indices,
-                                  g_enable_non_kernel_time_query_interrupt);
-      total_source_query_time_ms += timer_stop(query_clock_begin);
-
-      auto start_time = query_state_proxy.getQueryState().getQuerySubmittedTime();
-      auto query_str = "INSERT_DATA for " + work_type_str;
-      if (g_enable_non_kernel_time_query_interrupt) {
-        // In the clean-up phase of the query execution for collecting aggregated result
-        // of SELECT query, we remove its query session info, so we need to enroll the
-        // session info again
-        executor->enrollQuerySession(query_session,
-                                     query_str,
-                                     start_time,
-                                     Executor::UNITARY_EXECUTOR_ID,
-                                     QuerySessionStatus::QueryStatus::RUNNING);
+      if (0 == num_rows) {
+        continue;
       }
 
-      ScopeGuard clearInterruptStatus = [executor, &query_session, &start_time] {
-        // this data population is non-kernel operation, so we manually cleanup
-        // the query session info in the cleanup phase
-        if (g_enable_non_kernel_time_query_interrupt) {
-          executor->clearQuerySessionStatus(query_session, start_time, false);
-        }
-      };
+      total_row_count += num_rows;
 
-      for (auto& res : query_results) {
-        if (UNLIKELY(checkInterrupt(query_session, executor))) {
-          throw std::runtime_error(
-              "Query execution has been interrupted while performing " + work_type_str);
-        }
-        auto& result_rows = res.rs;
-        result_rows->setGeoReturnType(ResultSet::GeoReturnType::GeoTargetValue);
-        const auto num_rows = result_rows->rowCount();
+      const bool insert_result_set_buffers = can_insert_result_set_buffers(
+          *result_rows, res.targets_meta, target_column_descriptors);
 
-        if (0 == num_rows) {
-          continue;
-        }
+      size_t leaf_count = leafs_connector_->leafCount();
 
-        total_row_count += num_rows;
+      // ensure that at least 1 row is processed per block up to a maximum of 65536 rows
+      const size_t rows_per_block =
+          std::max(std::min(num_rows / leaf_count, size_t(64 * 1024)), size_t(1));
 
-        size_t leaf_count = leafs_connector_->leafCount();
+      std::vector<std::unique_ptr<TargetValueConverter>> value_converters;
 
-        // ensure that at least 1 row is processed per block up to a maximum of 65536 rows
-        const size_t rows_per_block =
-            std::max(std::min(num_rows / leaf_count, size_t(64 * 1024)), size_t(1));
+      TargetValueConverterFactory factory;
 
-        std::vector<std::unique_ptr<TargetValueConverter>> value_converters;
+      const int num_worker_threads = std::thread::hardware_concurrency();
 
-        TargetValueConverterFactory factory;
+      std::vector<size_t> thread_start_idx(num_worker_threads),
+          thread_end_idx(num_worker_threads);
+      bool can_go_parallel = !result_rows->isTruncated() && rows_per_block > 20000;
 
-        const int num_worker_threads = std::thread::hardware_concurrency();
+      std::atomic<size_t> crt_row_idx{0};
 
-        std::vector<size_t> thread_start_idx(num_worker_threads),
-            thread_end_idx(num_worker_threads);
-        bool can_go_parallel = !result_rows->isTruncated() && rows_per_block > 20000;
+      auto do_work = [&result_rows, &value_converters, &crt_row_idx](
+                         const size_t idx,
+                         const size_t block_end,
+                         const size_t num_cols,
+                         const size_t thread_id,
+                         bool& stop_convert) {
+        const auto result_row = result_rows->getRowAtNoTranslations(idx);
+        if (!result_row.empty()) {
+          size_t target_row = crt_row_idx.fetch_add(1);
+          if (target_row >= block_end) {
+            stop_convert = true;
+            return;
+          }
+          for (unsigned int col = 0; col < num_cols; col++) {
+            const auto& mapd_variant = result_row[col];
+            value_converters[col]->convertToColumnarFormat(target_row, &mapd_variant);
+          }
+        }
+      };
 
-        std::atomic<size_t> crt_row_idx{0};
+      auto convert_function = [&thread_start_idx,
+                               &thread_end_idx,
+                               &value_converters,
+                               &executor,
+                               &query_session,
+                               &work_type_str,
+                               &do_work](const int thread_id, const size_t block_end) {
+        const int num_cols = value_converters.size();
+        const size_t start = thread_start_idx[thread_id];
+        const size_t end = thread_end_idx[thread_id];
+        size_t idx = 0;
+        bool stop_convert = false;
+        if (g_enable_non_kernel_time_query_interrupt) {
+          size_t local_idx = 0;
+          for (idx = start; idx < end; ++idx, ++local_idx) {
+            if (UNLIKELY((local_idx & 0xFFFF) == 0 &&
+                         checkInterrupt(query_session, executor))) {
+              throw std::runtime_error(
+                  "Query execution has been interrupted while performing " +
+                  work_type_str);
+            }
+            do_work(idx, block_end, num_cols, thread_id, stop_convert);
+            if (stop_convert) {
+              break;
+            }
+          }
+        } else {
+          for (idx = start; idx < end; ++idx) {
+            do_work(idx, block_end, num_cols, thread_id, stop_convert);
+            if (stop_convert) {
+              break;
+            }
+          }
+        }
+        thread_start_idx[thread_id] = idx;
+      };
 
-        auto do_work = [&result_rows, &value_converters, &crt_row_idx](
-                           const size_t idx,
-                           const size_t block_end,
-                           const size_t num_cols,
-                           const size_t thread_id,
-                           bool& stop_convert) {
-          const auto result_row = result_rows->getRowAtNoTranslations(idx);
-          if (!result_row.empty()) {
+      auto single_threaded_value_converter =
+          [&crt_row_idx, &value_converters, &result_rows](const size_t idx,
+                                                          const size_t block_end,
+                                                          const size_t num_cols,
+                                                          bool& stop_convert) {
             size_t target_row = crt_row_idx.fetch_add(1);
             if (target_row >= block_end) {
               stop_convert = true;
               return;
             }
+            const auto result_row = result_rows->getNextRow(false, false);
+            CHECK(!result_row.empty());
             for (unsigned int col = 0; col < num_cols; col++) {
               const auto& mapd_variant = result_row[col];
               value_converters[col]->convertToColumnarFormat(target_row, &mapd_variant);
             }
-          }
-        };
+          };
 
-        auto convert_function = [&thread_start_idx,
-                                 &thread_end_idx,
-                                 &value_converters,
-                                 &executor,
-                                 &query_session,
-                                 &work_type_str,
-                                 &do_work](const int thread_id, const size_t block_end) {
-          const int num_cols = value_converters.size();
-          const size_t start = thread_start_idx[thread_id];
-          const size_t end = thread_end_idx[thread_id];
-          size_t idx = 0;
-          bool stop_convert = false;
-          if (g_enable_non_kernel_time_query_interrupt) {
-            size_t local_idx = 0;
-            for (idx = start; idx < end; ++idx, ++local_idx) {
-              if (UNLIKELY((local_idx & 0xFFFF) == 0 &&
-                           checkInterrupt(query_session, executor))) {
-                throw std::runtime_error(
-                    "Query execution has been interrupted while performing " +
-                    work_type_str);
-              }
-              do_work(idx, block_end, num_cols, thread_id, stop_convert);
-              if (stop_convert) {
-                break;
-              }
+      auto single_threaded_convert_function = [&value_converters,
+                                               &thread_start_idx,
+                                               &thread_end_idx,
+                                               &executor,
+                                               &query_session,
+                                               &work_type_str,
+                                               &single_threaded_value_converter](
+                                                  const int thread_id,
+                                                  const size_t block_end) {
+        const int num_cols = value_converters.size();
+        const size_t start = thread_start_idx[thread_id];
+        const size_t end = thread_end_idx[thread_id];
+        size_t idx = 0;
+        bool stop_convert = false;
+        if (g_enable_non_kernel_time_query_interrupt) {
+          size_t local_idx = 0;
+          for (idx = start; idx < end; ++idx, ++local_idx) {
+            if (UNLIKELY((local_idx & 0xFFFF) == 0 &&
+                         checkInterrupt(query_session, executor))) {
+              throw std::runtime_error(
+                  "Query execution has been interrupted while performing " +
+                  work_type_str);
             }
-          } else {
-            for (idx = start; idx < end; ++idx) {
-              do_work(idx, block_end, num_cols, thread_id, stop_convert);
-              if (stop_convert) {
-                break;
-              }
+            single_threaded_value_converter(idx, block_end, num_cols, stop_convert);
+            if (stop_convert) {
+              break;
             }
           }
-          thread_start_idx[thread_id] = idx;
-        };
-
-        auto single_threaded_value_converter =
-            [&crt_row_idx, &value_converters, &result_rows](const size_t idx,
-                                                            const size_t block_end,
-                                                            const size_t num_cols,
-                                                            bool& stop_convert) {
-              size_t target_row = crt_row_idx.fetch_add(1);
-              if (target_row >= block_end) {
-                stop_convert = true;
-                return;
-              }
-              const auto result_row = result_rows->getNextRow(false, false);
-              CHECK(!result_row.empty());
-              for (unsigned int col = 0; col < num_cols; col++) {
-                const auto& mapd_variant = result_row[col];
-                value_converters[col]->convertToColumnarFormat(target_row, &mapd_variant);
-              }
-            };
-
-        auto single_threaded_convert_function = [&value_converters,
-                                                 &thread_start_idx,
-                                                 &thread_end_idx,
-                                                 &executor,
-                                                 &query_session,
-                                                 &work_type_str,
-                                                 &single_threaded_value_converter](
-                                                    const int thread_id,
-                                                    const size_t block_end) {
-          const int num_cols = value_converters.size();
-          const size_t start = thread_start_idx[thread_id];
-          const size_t end = thread_end_idx[thread_id];
-          size_t idx = 0;
-          bool stop_convert = false;
-          if (g_enable_non_kernel_time_query_interrupt) {
-            size_t local_idx = 0;
-            for (idx = start; idx < end; ++idx, ++local_idx) {
-              if (UNLIKELY((local_idx & 0xFFFF) == 0 &&
-                           checkInterrupt(query_session, executor))) {
-                throw std::runtime_error(
-                    "Query execution has been interrupted while performing " +
-                    work_type_str);
-              }
-              single_threaded_value_converter(idx, block_end, num_cols, stop_convert);
-              if (stop_convert) {
-                break;
-              }
-            }
-          } else {
-            for (idx = start; idx < end; ++idx) {
-              single_threaded_value_converter(idx, end, num_cols, stop_convert);
-              if (stop_convert) {
-                break;
-              }
+        } else {
+          for (idx = start; idx < end; ++idx) {
+            single_threaded_value_converter(idx, end, num_cols, stop_convert);
+            if (stop_convert) {
+              break;
             }
           }
-          thread_start_idx[thread_id] = idx;
-        };
-
-        if (can_go_parallel) {
-          const size_t entry_count = result_rows->entryCount();
-          for (size_t
-                   i = 0,
-                   start_entry = 0,
-                   stride = (entry_count + num_worker_threads - 1) / num_worker_threads;
-               i < num_worker_threads && start_entry < entry_count;
-               ++i, start_entry += stride) {
-            const auto end_entry = std::min(start_entry + stride, entry_count);
-            thread_start_idx[i] = start_entry;
-            thread_end_idx[i] = end_entry;
-          }
-        } else {
-          thread_start_idx[0] = 0;
-          thread_end_idx[0] = result_rows->entryCount();
         }
+        thread_start_idx[thread_id] = idx;
+      };
 
-        for (size_t block_start = 0; block_start < num_rows;
-             block_start += rows_per_block) {
-          const auto num_rows_this_itr = block_start + rows_per_block < num_rows
-                                             ? rows_per_block
-                                             : num_rows - block_start;
-          crt_row_idx = 0;  // reset block tracker
-          value_converters.clear();
-          int colNum = 0;
-          for (const auto targetDescriptor : target_column_descriptors) {
-            auto sourceDataMetaInfo = res.targets_meta[colNum++];
-
-            ConverterCreateParameter param{
-                num_rows_this_itr,
-                catalog,
-                sourceDataMetaInfo,
-                targetDescriptor,
-                targetDescriptor->columnType,
-                !targetDescriptor->columnType.get_notnull(),
-                result_rows->getRowSetMemOwner()->getLiteralStringDictProxy(),
-                g_enable_experimental_string_functions
-                    ? executor->getStringDictionaryProxy(
-                          sourceDataMetaInfo.get_type_info().get_comp_param(),
-                          result_rows->getRowSetMemOwner(),
-                          true)
-                    : nullptr};
-            auto converter = factory.create(param);
-            value_converters.push_back(std::move(converter));
-          }
-
-          const auto translate_clock_begin = timer_start();
-          if (can_go_parallel) {
-            std::vector<std::future<void>> worker_threads;
-            for (int i = 0; i < num_worker_threads; ++i) {
-              worker_threads.push_back(
-                  std::async(std::launch::async, convert_function, i, num_rows_this_itr));
-            }
-
-            for (auto& child : worker_threads) {
-              child.wait();
-            }
-            for (auto& child : worker_threads) {
-              child.get();
-            }
+      if (can_go_parallel) {
+        const size_t entry_count = result_rows->entryCount();
+        for (size_t
+                 i = 0,
+                 start_entry = 0,
+                 stride = (entry_count + num_worker_threads - 1) / num_worker_threads;
+             i < num_worker_threads && start_entry < entry_count;
+             ++i, start_entry += stride) {
+          const auto end_entry = std::min(start_entry + stride, entry_count);
+          thread_start_idx[i] = start_entry;
+          thread_end_idx[i] = end_entry;
+        }
+      } else {
+        thread_start_idx[0] = 0;
+        thread_end_idx[0] = result_rows->entryCount();
+      }
 
-          } else {
-            single_threaded_convert_function(0, num_rows_this_itr);
+      for (size_t block_start = 0; block_start < num_rows;
+           block_start += rows_per_block) {
+        const auto num_rows_this_itr = block_start + rows_per_block < num_rows
+                                           ? rows_per_block
+                                           : num_rows - block_start;
+        if (insert_result_set_buffers) {
+          Fragmenter_Namespace::InsertData insert_data;
+          insert_data.databaseId = catalog.getCurrentDB().dbId;
+          insert_data.tableId = td->tableId;
+          insert_data.numRows = num_rows_this_itr;
+          for (size_t col_idx = 0; col_idx < target_column_descriptors.size();
+               ++col_idx) {
+            const auto cd = target_column_descriptors[col_idx];
+            DataBlockPtr data_block;
+            data_block.numbersPtr =
+                const_cast<int8_t*>(result_rows->getColumnarBuffer(col_idx)) +
+                block_start * cd->columnType.get_size();
+            insert_data.data.push_back(data_block);
+            insert_data.columnIds.push_back(cd->columnId);
           }
+          const auto data_load_clock_begin = timer_start();
+          auto data_memory_holder =
+              import_export::fill_missing_columns(&catalog, insert_data);
+          insertDataLoader.insertData(*session, insert_data);
+          total_data_load_time_ms += timer_stop(data_load_clock_begin);
+          continue;
+        }
+        crt_row_idx = 0;  // reset block tracker
+        value_converters.clear();
+        int colNum = 0;
+        for (const auto targetDescriptor : target_column_descriptors) {
+          auto sourceDataMetaInfo = res.targets_meta[colNum++];
+
+          ConverterCreateParameter param{
+              num_rows_this_itr,
+              catalog,
+              sourceDataMetaInfo,
+              targetDescriptor,
+              targetDescriptor->columnType,
+              !targetDescriptor->columnType.get_notnull(),
+              result_rows->getRowSetMemOwner()->getLiteralStringDictProxy(),
+              g_enable_experimental_string_functions
+                  ? executor->getStringDictionaryProxy(
+                        sourceDataMetaInfo.get_type_info().get_comp_param(),
+                        result_rows->getRowSetMemOwner(),
+                        true)
+                  : nullptr};
+          auto converter = factory.create(param);
+          value_converters.push_back(std::move(converter));
+        }
 
-          // finalize the insert data
-          auto finalizer_func =
-              [](std::unique_ptr<TargetValueConverter>::pointer targetValueConverter) {
-                targetValueConverter->finalizeDataBlocksForInsertData();
-              };
-
+        const auto translate_clock_begin = timer_start();
+        if (can_go_parallel) {
           std::vector<std::future<void>> worker_threads;
-          for (auto& converterPtr : value_converters) {
+          for (int i = 0; i < num_worker_threads; ++i) {
             worker_threads.push_back(
-                std::async(std::launch::async, finalizer_func, converterPtr.get()));
+                std::async(std::launch::async, convert_function, i, num_rows_this_itr));
           }
 
           for (auto& child : worker_threads) {
@@ -3276,29 +3475,99 @@ void InsertIntoTableAsSelectStmt::populateData(QueryStateProxy query_state_proxy
             child.get();
           }
 
-          Fragmenter_Namespace::InsertData insert_data;
-          insert_data.databaseId = catalog.getCurrentDB().dbId;
-          CHECK(td);
-          insert_data.tableId = td->tableId;
-          insert_data.numRows = num_rows_this_itr;
+        } else {
+          single_threaded_convert_function(0, num_rows_this_itr);
+        }
 
-          for (int col_idx = 0; col_idx < target_column_descriptors.size(); col_idx++) {
-            if (UNLIKELY(g_enable_non_kernel_time_query_interrupt &&
-                         checkInterrupt(query_session, executor))) {
-              throw std::runtime_error(
-                  "Query execution has been interrupted while performing " +
-                  work_type_str);
-            }
-            value_converters[col_idx]->addDataBlocksToInsertData(insert_data);
-          }
-          total_target_value_translate_time_ms += timer_stop(translate_clock_begin);
+        // finalize the insert data
+        auto finalizer_func =
+            [](std::unique_ptr<TargetValueConverter>::pointer targetValueConverter) {
+              targetValueConverter->finalizeDataBlocksForInsertData();
+            };
 
-          const auto data_load_clock_begin = timer_start();
-          auto data_memory_holder =
-              import_export::fill_missing_columns(&catalog, insert_data);
-          insertDataLoader.insertData(*session, insert_data);
-          total_data_load_time_ms += timer_stop(data_load_clock_begin);
+        std::vector<std::future<void>> worker_threads;
+        for (auto& converterPtr : value_converters) {
+          worker_threads.push_back(
+              std::async(std::launch::async, finalizer_func, converterPtr.get()));
+        }
+
+        for (auto& child : worker_threads) {
+          child.wait();
+        }
+        for (auto& child : worker_threads) {
+          child.get();
+        }
+
+        Fragmenter_Namespace::InsertData insert_data;
+        insert_data.databaseId = catalog.getCurrentDB().dbId;
+        CHECK(td);
+        insert_data.tableId = td->tableId;
+        insert_data.numRows = num_rows_this_itr;
+
+        for (int col_idx = 0; col_idx < target_column_descriptors.size(); col_idx++) {
+          if (UNLIKELY(g_enable_non_kernel_time_query_interrupt &&
+                       checkInterrupt(query_session, executor))) {
+            throw std::runtime_error(
+                "Query execution has been interrupted while performing " +
+                work_type_str);
+          }
+          value_converters[col_idx]->addDataBlocksToInsertData(insert_data);
         }
+        total_target_value_translate_time_ms += timer_stop(translate_clock_begin);
+
+        const auto data_load_clock_begin = timer_start();
+        auto data_memory_holder =
+            import_export::fill_missing_columns(&catalog, insert_data);
+        insertDataLoader.insertData(*session, insert_data);
+        total_data_load_time_ms += timer_stop(data_load_clock_begin);
+      }
+    }
+  };
+
+  try {
+    // A pipelined load runs while the source query over the next fragment enrolls and
+    // clears the session under the submitted time of the query state, so the loads get
+    // an entry of their own, enrolled until the last of them is done. It also keeps the
+    // interrupt flag of the session, which a source query clearing the last entry of the
+    // session would drop.
+    const auto load_submitted_time = ::toString(std::chrono::system_clock::now());
+    if (g_enable_non_kernel_time_query_interrupt && pipelined_load) {
+      executor->enrollQuerySession(query_session,
+                                   insert_data_query_str,
+                                   load_submitted_time,
+                                   Executor::UNITARY_EXECUTOR_ID,
+                                   QuerySessionStatus::QueryStatus::RUNNING);
+    }
+    ScopeGuard clear_load_session_status =
+        [executor, &query_session, &load_submitted_time, pipelined_load] {
+          if (g_enable_non_kernel_time_query_interrupt && pipelined_load) {
+            executor->clearQuerySessionStatus(query_session, load_submitted_time, false);
+          }
+        };
+    std::future<void> pending_load;
+    for (size_t outer_frag_idx = 0; outer_frag_idx < outer_frag_end; outer_frag_idx++) {
+      std::vector<size_t> allowed_outer_fragment_indices;
+
+      if (outer_frag_count) {
+        allowed_outer_fragment_indices.push_back(outer_frag_idx);
+      }
+
+      const auto query_clock_begin = timer_start();
+      std::vector<AggregatedResult> query_results =
+          leafs_connector_->query(query_state_proxy,
+                                  select_query_,
+                                  allowed_outer_fragment_indices,
+                                  g_enable_non_kernel_time_query_interrupt);
+      total_source_query_time_ms += timer_stop(query_clock_begin);
+      if (pending_load.valid()) {
+        pending_load.get();
+      }
+
+      if (pipelined_load && outer_frag_idx + 1 < outer_frag_end) {
+        pending_load =
+            std::async(std::launch::async, load_query_results, std::move(query_results));
+      } else {
+        load_query_results(std::move(query_results));
       }
     }
   } catch (...) {
@@ -3576,7 +3845,8 @@ void CreateTableAsSelectStmt::execute(const Catalog_Namespace::SessionInfo& sess
     }
 
     // currently no means of defining sharding in CTAS
-    td.keyMetainfo = serialize_key_metainfo(nullptr, sharedDictionaryRefs);
+    validate_partition_options(td);
+    td.keyMetainfo = serialize_key_metainfo(nullptr, sharedDictionaryRefs, &td);
 
     catalog.createTable(td, column_descriptors_for_create, sharedDictionaryRefs, true);
     // TODO (max): It's transactionally unsafe, should be fixed: we may create object
@@ -5296,6 +5566,11 @@ void ExportQueryStmt::execute(const Catalog_Namespace::SessionInfo& session) {
 
   if (file_path_->empty()) {
     throw std::runtime_error("Invalid file path for COPY TO");
+  } else if (boost::istarts_with(*file_path_, "s3://")) {
+    // the exporter uploads the file to S3
+    if (file_type != import_export::QueryExporter::FileType::kParquet) {
+      throw std::runtime_error("COPY TO S3 is only supported for file type 'Parquet'");
+    }
   } else if (!boost::filesystem::path(*file_path_).is_absolute()) {
     std::string file_name = boost::filesystem::path(*file_path_).filename().string();
     std::string file_dir = g_base_path + "/mapd_export/" + session.get_session_id() + "/";
@@ -5445,10 +5720,12 @@ void ExportQueryStmt::parseOptions(
           file_type = import_export::QueryExporter::FileType::kGeoJSONL;
         } else if (file_type_str == "shapefile") {
           file_type = import_export::QueryExporter::FileType::kShapefile;
+        } else if (file_type_str == "parquet") {
+          file_type = import_export::QueryExporter::FileType::kParquet;
         } else {
           throw std::runtime_error(
-              "File Type option must be 'CSV', 'GeoJSON', 'GeoJSONL' or "
-              "'Shapefile'");
+              "File Type option must be 'CSV', 'GeoJSON', 'GeoJSONL', 'Shapefile' or "
+              "'Parquet'");
         }
       } else if (boost::iequals(*p->get_name(), "layer_name")) {
         const StringLiteral* str_literal =
@@ -5500,6 +5777,41 @@ void ExportQueryStmt::parseOptions(
               "Array Null Handling option must be 'Abort', 'Raw', 'Zero', or "
               "'NullField'");
         }
+      } else if (boost::iequals(*p->get_name(), "s3_access_key")) {
+        const StringLiteral* str_literal =
+            dynamic_cast<const StringLiteral*>(p->get_value());
+        if (str_literal == nullptr) {
+          throw std::runtime_error("Option s3_access_key must be a string.");
+        }
+        copy_params.s3_access_key = *str_literal->get_stringval();
+      } else if (boost::iequals(*p->get_name(), "s3_secret_key")) {
+        const StringLiteral* str_literal =
+            dynamic_cast<const StringLiteral*>(p->get_value());
+        if (str_literal == nullptr) {
+          throw std::runtime_error("Option s3_secret_key must be a string.");
+        }
+        copy_params.s3_secret_key = *str_literal->get_stringval();
+      } else if (boost::iequals(*p->get_name(), "s3_session_token")) {
+        const StringLiteral* str_literal =
+            dynamic_cast<const StringLiteral*>(p->get_value());
+        if (str_literal == nullptr) {
+          throw std::runtime_error("Option s3_session_token must be a string.");
+        }
+        copy_params.s3_session_token = *str_literal->get_stringval();
+      } else if (boost::iequals(*p->get_name(), "s3_region")) {
+        const StringLiteral* str_literal =
+            dynamic_cast<const StringLiteral*>(p->get_value());
+        if (str_literal == nullptr) {
+          throw std::runtime_error("Option s3_region must be a string.");
+        }
+        copy_params.s3_region = *str_literal->get_stringval();
+      } else if (boost::iequals(*p->get_name(), "s3_endpoint")) {
+        const StringLiteral* str_literal =
+            dynamic_cast<const StringLiteral*>(p->get_value());
+        if (str_literal == nullptr) {
+          throw std::runtime_error("Option s3_endpoint must be a string.");
+        }
+        copy_params.s3_endpoint = *str_literal->get_stringval();
       } else {
         throw std::runtime_error("Invalid option for COPY: " + *p->get_name());
       }
@@ -5917,7 +6229,7 @@ void DumpTableStmt::execute(const Catalog_Namespace::SessionInfo& session) {
   auto& catalog = session.getCatalog();
   const TableDescriptor* td = catalog.getMetadataForTable(*table_);
   TableArchiver table_archiver(&catalog);
-  table_archiver.dumpTable(td, *path_, compression_);
+  table_archiver.dumpTable(td, *path_, compression_, base_epoch_);
 }
 
 void RestoreTableStmt::execute(const Catalog_Namespace::SessionInfo& session) {
@@ -5936,7 +6248,8 @@ void RestoreTableStmt::execute(const Catalog_Namespace::SessionInfo& session) {
                                " will not be restored. User has no create privileges.");
     }
     TableArchiver table_archiver(&catalog);
-    table_archiver.restoreTable(session, *table_, *path_, compression_);
+    table_archiver.restoreTable(
+        session, *table_, *path_, compression_, incremental_paths_);
   }
 }
 
@@ -26,10 +26,15 @@
 
 #include <cstdint>
 #include <cstring>
+#include <limits>
 #include <list>
 #include <string>
+#include <vector>
 
+#include <boost/algorithm/string/classification.hpp>
 #include <boost/algorithm/string/predicate.hpp>
+#include <boost/algorithm/string/split.hpp>
+#include <boost/algorithm/string/trim.hpp>
 #include <boost/process/search_path.hpp>
 
 #include "../Analyzer/Analyzer.h"
@@ -1035,6 +1040,10 @@ struct LocalConnector : public DistributedConnector {
   void rollback(const Catalog_Namespace::SessionInfo& session, int tableId) override;
   std::list<ColumnDescriptor> getColumnDescriptors(AggregatedResult& result,
                                                    bool for_create);
+
+  // Asks for columnar projections, which INSERT INTO ... SELECT inserts from the query
+  // result buffers without converting them row by row.
+  bool output_columnar{false};
 };
 
 /*
@@ -1225,6 +1234,24 @@ class OptimizeTableStmt : public DDLStmt {
     return false;
   }
 
+  bool shouldClusterRows() const {
+    for (const auto& e : options_) {
+      if (boost::iequals(*(e->get_name()), "CLUSTER")) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool shouldCompactDictionaries() const {
+    for (const auto& e : options_) {
+      if (boost::iequals(*(e->get_name()), "COMPACT_DICTIONARIES")) {
+        return true;
+      }
+    }
+    return false;
+  }
+
   void execute(const Catalog_Namespace::SessionInfo& session) override {
     // Should pass optimize params to the table optimizer
     CHECK(false);
@@ -1403,7 +1430,7 @@ class DumpRestoreTableStmtBase : public DDLStmt {
     };
     std::unique_ptr<std::list<NameValueAssign*>, decltype(options_deleter)> options_ptr(
         options, options_deleter);
-    std::vector<std::string> allowed_compression_programs{"lz4", "gzip", "none"};
+    std::vector<std::string> allowed_compression_programs{"lz4", "gzip", "zstd", "none"};
     // specialize decompressor or break on osx bsdtar...
     if (options) {
       for (const auto option : *options) {
@@ -1423,6 +1450,26 @@ class DumpRestoreTableStmtBase : public DDLStmt {
           } else {
             throw std::runtime_error("Compression option must be a string.");
           }
+        } else if (!is_restore && boost::iequals(*option->get_name(), "base_epoch")) {
+          const auto int_literal = dynamic_cast<const IntLiteral*>(option->get_value());
+          if (!int_literal || int_literal->get_intval() < 0 ||
+              int_literal->get_intval() > std::numeric_limits<int32_t>::max()) {
+            throw std::runtime_error("Base epoch option must be a non-negative integer.");
+          }
+          base_epoch_ = int_literal->get_intval();
+        } else if (is_restore && boost::iequals(*option->get_name(), "incremental")) {
+          if (const auto str_literal =
+                  dynamic_cast<const StringLiteral*>(option->get_value())) {
+            boost::split(incremental_paths_,
+                         *str_literal->get_stringval(),
+                         boost::is_any_of(","),
+                         boost::token_compress_on);
+            for (auto& incremental_path : incremental_paths_) {
+              boost::algorithm::trim(incremental_path);
+            }
+          } else {
+            throw std::runtime_error("Incremental option must be a string.");
+          }
         } else {
           throw std::runtime_error("Invalid WITH option: " + *option->get_name());
         }
@@ -1439,14 +1486,25 @@ class DumpRestoreTableStmtBase : public DDLStmt {
     if (boost::iequals(compression_, "none")) {
       compression_.clear();
     } else {
-      std::map<std::string, std::string> decompression{{"lz4", "unlz4"},
-                                                       {"gzip", "gunzip"}};
-      const auto use_program = is_restore ? decompression[compression_] : compression_;
+      compression_ = boost::algorithm::to_lower_copy(compression_);
+      // pigz and zstd compress on all cores, gzip and lz4 on a single one. pigz writes
+      // gzip streams, so archives don't depend on whether it was found.
+      const bool use_pigz = compression_ == "gzip" &&
+                            !boost::process::search_path("pigz").string().empty() &&
+                            !boost::process::search_path("unpigz").string().empty();
+      std::map<std::string, std::string> compression{
+          {"lz4", "lz4"}, {"gzip", use_pigz ? "pigz" : "gzip"}, {"zstd", "zstd"}};
+      std::map<std::string, std::string> decompression{
+          {"lz4", "unlz4"}, {"gzip", use_pigz ? "unpigz" : "gunzip"}, {"zstd", "unzstd"}};
+      const auto use_program =
+          is_restore ? decompression[compression_] : compression[compression_];
       const auto prog_path = boost::process::search_path(use_program);
       if (prog_path.string().empty()) {
         throw std::runtime_error("Compression program " + use_program + " is not found.");
       }
-      compression_ = "--use-compress-program=" + use_program;
+      compression_ = !is_restore && compression_ == "zstd"
+                         ? "--use-compress-program=\"" + use_program + " -T0\""
+                         : "--use-compress-program=" + use_program;
     }
   }
   const std::string* getTable() const { return table_.get(); }
@@ -1457,6 +1515,8 @@ class DumpRestoreTableStmtBase : public DDLStmt {
   std::unique_ptr<std::string> table_;
   std::unique_ptr<std::string> path_;  // dump TO file path
   std::string compression_;
+  int32_t base_epoch_{-1};  // dump only the pages written after this epoch
+  std::vector<std::string> incremental_paths_;  // restore these archives on top of path_
 };
 
 class DumpTableStmt : public DumpRestoreTableStmtBase {
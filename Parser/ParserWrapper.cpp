@@ -42,7 +42,8 @@ const std::vector<std::string> ParserWrapper::ddl_cmd = {"ARCHIVE",
                                                          "REVOKE",
                                                          "SHOW",
                                                          "TRUNCATE",
-                                                         "KILL"};
+                                                         "KILL",
+                                                         "DEFRAGMENT"};
 
 const std::vector<std::string> ParserWrapper::update_dml_cmd = {
     "INSERT",
@@ -200,6 +201,11 @@ ParserWrapper::ParserWrapper(std::string query_string) {
         is_calcite_ddl_ = true;
         is_legacy_ddl_ = false;
         return;
+      } else if (ddl == "DEFRAGMENT") {
+        query_type_ = QueryType::Unknown;
+        is_calcite_ddl_ = true;
+        is_legacy_ddl_ = false;
+        return;
       } else if (ddl == "RENAME") {
         query_type_ = QueryType::SchemaWrite;
         boost::regex rename_regex{R"(RENAME\s+TABLE.*)",
@@ -23,6 +23,8 @@
 #include "TargetMetaInfo.h"
 #include "TargetValue.h"
 
+#include <future>
+#include <memory>
 #include <type_traits>
 
 #include "arrow/api.h"
@@ -80,6 +82,35 @@ class ArrowResultSetRowIterator {
       : result_set_(rs), crt_row_idx_(0){};
 
   friend class ArrowResultSet;
+  friend class ArrowResultSetStream;
+};
+
+/**
+ * Delivers a result set as a sequence of Arrow results of at most `batch_entries`
+ * result set entries each, so that large results do not have to be serialized at once.
+ * Each batch is serialized like a whole getArrowResult() is, schema and dictionaries
+ * included, and the next batch is converted while the current one is transferred.
+ */
+class ArrowResultSetStream {
+ public:
+  ArrowResultSetStream(std::unique_ptr<ArrowResultSetConverter> converter,
+                       const size_t batch_entries);
+
+  // Frees the shared memory of the batch converted ahead, if it was never returned.
+  ~ArrowResultSetStream();
+
+  ArrowResult getNextBatch();
+
+  bool hasMoreBatches() const { return next_batch_.valid(); }
+
+ private:
+  void convertNextBatch();
+
+  std::unique_ptr<ArrowResultSetConverter> converter_;
+  const size_t batch_entries_;
+  const size_t entry_count_;
+  size_t next_entry_;
+  std::future<ArrowResult> next_batch_;
 };
 
 enum class ArrowTransport { SHARED_MEMORY = 0, WIRE = 1 };
@@ -198,6 +229,13 @@ class ArrowResultSetConverter {
 
   ArrowResult getArrowResult() const;
 
+  // Serializes the given range of result set entries only, which must be within
+  // getEntryCount(). Only supported on CPU.
+  ArrowResult getArrowResult(const size_t start_entry, const size_t end_entry) const;
+
+  // Number of result set entries converted by getArrowResult(), `first_n` included.
+  size_t getEntryCount() const;
+
   // TODO(adb): Proper namespacing for this set of functionality. For now, make this
   // public and leverage the converter class as namespace
   struct ColumnBuilder {
@@ -214,9 +252,20 @@ class ArrowResultSetConverter {
 
   std::shared_ptr<arrow::RecordBatch> convertToArrow() const;
 
+  // Converts the given range of result set entries only, which must be within
+  // getEntryCount().
+  std::shared_ptr<arrow::RecordBatch> convertToArrow(const size_t start_entry,
+                                                     const size_t end_entry) const;
+
  private:
+
+  ArrowResult serializeArrowResult(
+      const std::shared_ptr<arrow::RecordBatch>& record_batch) const;
+
   std::shared_ptr<arrow::RecordBatch> getArrowBatch(
-      const std::shared_ptr<arrow::Schema>& schema) const;
+      const std::shared_ptr<arrow::Schema>& schema,
+      const size_t start_entry,
+      const size_t end_entry) const;
 
   std::shared_ptr<arrow::Field> makeField(const std::string name,
                                           const SQLTypeInfo& target_type) const;
@@ -248,6 +297,35 @@ class ArrowResultSetConverter {
   ArrowTransport transport_method_;
 
   friend class ArrowResultSet;
+  friend class ArrowResultSetStream;
+};
+
+/**
+ * Delivers a result set as a sequence of Arrow results of at most `batch_entries`
+ * result set entries each, so that large results do not have to be serialized at once.
+ * Each batch is serialized like a whole getArrowResult() is, schema and dictionaries
+ * included, and the next batch is converted while the current one is transferred.
+ */
+class ArrowResultSetStream {
+ public:
+  ArrowResultSetStream(std::unique_ptr<ArrowResultSetConverter> converter,
+                       const size_t batch_entries);
+
+  // Frees the shared memory of the batch converted ahead, if it was never returned.
+  ~ArrowResultSetStream();
+
+  ArrowResult getNextBatch();
+
+  bool hasMoreBatches() const { return next_batch_.valid(); }
+
+ private:
+  void convertNextBatch();
+
+  std::unique_ptr<ArrowResultSetConverter> converter_;
+  const size_t batch_entries_;
+  const size_t entry_count_;
+  size_t next_entry_;
+  std::future<ArrowResult> next_batch_;
 };
 
 template <typename T>
@@ -175,93 +175,187 @@ struct null_type<TYPE, std::enable_if_t<std::is_floating_point<TYPE>::value>> {
 template <typename TYPE>
 using null_type_t = typename null_type<TYPE>::type;
 
-template <typename C_TYPE,
-          typename ARROW_TYPE = typename arrow::CTypeTraits<C_TYPE>::ArrowType>
+// Sets the validity bits of the values in [start_entry, end_entry), where start_entry is
+// a multiple of 8, and returns the number of nulls among them.
+template <typename TYPE>
+int64_t convert_validity(const TYPE* vals,
+                         const TYPE null_val,
+                         const size_t start_entry,
+                         const size_t end_entry,
+                         uint8_t* is_valid_data) {
+  CHECK_EQ(start_entry % 8, size_t(0));
+  int64_t null_count = 0;
+  const size_t unroll_end = start_entry + ((end_entry - start_entry) & ~size_t(7));
+  for (size_t i = start_entry; i < unroll_end; i += 8) {
+    uint8_t valid_byte = 0;
+    for (size_t j = 0; j < 8; ++j) {
+      const bool valid = vals[i + j] != null_val;
+      valid_byte |= valid << j;
+      null_count += !valid;
+    }
+    is_valid_data[i >> 3] = valid_byte;
+  }
+  if (unroll_end != end_entry) {
+    uint8_t valid_byte = 0;
+    for (size_t i = unroll_end; i < end_entry; ++i) {
+      const bool valid = vals[i] != null_val;
+      valid_byte |= valid << (i & 7);
+      null_count += !valid;
+    }
+    is_valid_data[unroll_end >> 3] = valid_byte;
+  }
+  return null_count;
+}
+
+// Converts the values in [start_entry, end_entry) whose Arrow representation differs
+// from their result set slots: booleans are packed into bits, times are narrowed to
+// 32 bits, dates are scaled from seconds to days or milliseconds and decimals are
+// widened to 128 bits.
+template <typename SLOT_TYPE>
+void convert_values(const SLOT_TYPE* vals,
+                    const arrow::Type::type type_id,
+                    const size_t start_entry,
+                    const size_t end_entry,
+                    uint8_t* values_data) {
+  switch (type_id) {
+    case arrow::Type::BOOL: {
+      CHECK_EQ(start_entry % 8, size_t(0));
+      for (size_t i = start_entry; i < end_entry; i += 8) {
+        uint8_t value_byte = 0;
+        for (size_t j = 0; j < 8 && i + j < end_entry; ++j) {
+          value_byte |= (vals[i + j] == 1) << j;
+        }
+        values_data[i >> 3] = value_byte;
+      }
+      break;
+    }
+    case arrow::Type::TIME32: {
+      auto time_data = reinterpret_cast<int32_t*>(values_data);
+      for (size_t i = start_entry; i < end_entry; ++i) {
+        time_data[i] = static_cast<int32_t>(vals[i]);
+      }
+      break;
+    }
+    case arrow::Type::DATE32: {
+      auto date_data = reinterpret_cast<int32_t*>(values_data);
+      for (size_t i = start_entry; i < end_entry; ++i) {
+        date_data[i] = static_cast<int32_t>(
+            DateConverters::get_epoch_days_from_seconds(static_cast<int64_t>(vals[i])));
+      }
+      break;
+    }
+    case arrow::Type::DATE64: {
+      auto date_data = reinterpret_cast<int64_t*>(values_data);
+      for (size_t i = start_entry; i < end_entry; ++i) {
+        date_data[i] = static_cast<int64_t>(vals[i]) * kMilliSecsPerSec;
+      }
+      break;
+    }
+    case arrow::Type::DECIMAL: {
+      for (size_t i = start_entry; i < end_entry; ++i) {
+        arrow::Decimal128(static_cast<int64_t>(vals[i]))
+            .ToBytes(values_data + i * sizeof(arrow::Decimal128));
+      }
+      break;
+    }
+    default:
+      UNREACHABLE();
+  }
+}
+
+// Converts a column of a columnar projection result straight from its buffer in the
+// result set, on `num_threads` threads, each of which converts a range of entries.
+template <typename SLOT_TYPE>
 void convert_column(ResultSetPtr result,
                     size_t col,
                     size_t entry_count,
+                    const std::shared_ptr<arrow::DataType>& type,
+                    const size_t num_threads,
                     std::shared_ptr<arrow::Array>& out) {
-  CHECK(sizeof(C_TYPE) == result->getColType(col).get_size());
+  CHECK(sizeof(SLOT_TYPE) == result->getColType(col).get_size());
 
-  std::shared_ptr<arrow::Buffer> values;
-  std::shared_ptr<arrow::Buffer> is_valid;
-  const int64_t buf_size = entry_count * sizeof(C_TYPE);
+  std::shared_ptr<arrow::Buffer> slots;
+  const int64_t buf_size = entry_count * sizeof(SLOT_TYPE);
   if (result->isZeroCopyColumnarConversionPossible(col)) {
-    values.reset(new ResultSetBuffer(
+    slots.reset(new ResultSetBuffer(
         reinterpret_cast<const uint8_t*>(result->getColumnarBuffer(col)),
         buf_size,
         result));
   } else {
     auto res = arrow::AllocateBuffer(buf_size);
     CHECK(res.ok());
-    values = std::move(res).ValueOrDie();
+    slots = std::move(res).ValueOrDie();
     result->copyColumnIntoBuffer(
-        col, reinterpret_cast<int8_t*>(values->mutable_data()), buf_size);
+        col, reinterpret_cast<int8_t*>(slots->mutable_data()), buf_size);
+  }
+
+  std::shared_ptr<arrow::Buffer> values;
+  int64_t values_size = 0;
+  switch (type->id()) {
+    case arrow::Type::BOOL:
+      values_size = (entry_count + 7) / 8;
+      break;
+    case arrow::Type::TIME32:
+    case arrow::Type::DATE32:
+      values_size = entry_count * sizeof(int32_t);
+      break;
+    case arrow::Type::DATE64:
+      values_size = entry_count * sizeof(int64_t);
+      break;
+    case arrow::Type::DECIMAL:
+      values_size = entry_count * sizeof(arrow::Decimal128);
+      break;
+    default:
+      CHECK_EQ(static_cast<const arrow::FixedWidthType&>(*type).bit_width(),
+               static_cast<int>(8 * sizeof(SLOT_TYPE)));
+      // Same representation in the result set and in Arrow.
+      values = slots;
+  }
+  if (!values) {
+    auto res = arrow::AllocateBuffer(values_size);
+    CHECK(res.ok());
+    values = std::move(res).ValueOrDie();
   }
 
-  int64_t null_count = 0;
   auto res = arrow::AllocateBuffer((entry_count + 7) / 8);
   CHECK(res.ok());
-  is_valid = std::move(res).ValueOrDie();
-
-  auto is_valid_data = is_valid->mutable_data();
-
-  const null_type_t<C_TYPE>* vals =
-      reinterpret_cast<const null_type_t<C_TYPE>*>(values->data());
-  null_type_t<C_TYPE> null_val = null_type<C_TYPE>::value;
+  std::shared_ptr<arrow::Buffer> is_valid = std::move(res).ValueOrDie();
+
+  const null_type_t<SLOT_TYPE>* vals =
+      reinterpret_cast<const null_type_t<SLOT_TYPE>*>(slots->data());
+  null_type_t<SLOT_TYPE> null_val = null_type<SLOT_TYPE>::value;
+  auto convert_entries = [&](const size_t start_entry, const size_t end_entry) {
+    if (values != slots) {
+      convert_values(vals, type->id(), start_entry, end_entry, values->mutable_data());
+    }
+    return convert_validity(
+        vals, null_val, start_entry, end_entry, is_valid->mutable_data());
+  };
 
-  size_t unroll_count = entry_count & 0xFFFFFFFFFFFFFFF8ULL;
-  for (size_t i = 0; i < unroll_count; i += 8) {
-    uint8_t valid_byte = 0;
-    uint8_t valid;
-    valid = vals[i + 0] != null_val;
-    valid_byte |= valid << 0;
-    null_count += !valid;
-    valid = vals[i + 1] != null_val;
-    valid_byte |= valid << 1;
-    null_count += !valid;
-    valid = vals[i + 2] != null_val;
-    valid_byte |= valid << 2;
-    null_count += !valid;
-    valid = vals[i + 3] != null_val;
-    valid_byte |= valid << 3;
-    null_count += !valid;
-    valid = vals[i + 4] != null_val;
-    valid_byte |= valid << 4;
-    null_count += !valid;
-    valid = vals[i + 5] != null_val;
-    valid_byte |= valid << 5;
-    null_count += !valid;
-    valid = vals[i + 6] != null_val;
-    valid_byte |= valid << 6;
-    null_count += !valid;
-    valid = vals[i + 7] != null_val;
-    valid_byte |= valid << 7;
-    null_count += !valid;
-    is_valid_data[i >> 3] = valid_byte;
-  }
-  if (unroll_count != entry_count) {
-    uint8_t valid_byte = 0;
-    for (size_t i = unroll_count; i < entry_count; ++i) {
-      bool valid = vals[i] != null_val;
-      valid_byte |= valid << (i & 7);
-      null_count += !valid;
+  int64_t null_count = 0;
+  if (num_threads > 1) {
+    // Ranges are aligned to whole bytes of the bitmaps.
+    const auto stride = ((entry_count + num_threads - 1) / num_threads + 7) & ~size_t(7);
+    std::vector<std::future<int64_t>> child_threads;
+    for (size_t start_entry = 0; start_entry < entry_count; start_entry += stride) {
+      child_threads.push_back(std::async(std::launch::async,
+                                         convert_entries,
+                                         start_entry,
+                                         std::min(entry_count, start_entry + stride)));
+    }
+    for (auto& child : child_threads) {
+      null_count += child.get();
     }
-    is_valid_data[unroll_count >> 3] = valid_byte;
+  } else {
+    null_count = convert_entries(0, entry_count);
   }
 
   if (!null_count) {
     is_valid.reset();
   }
 
-  // TODO: support date/time + scaling
-  // TODO: support booleans
-  if (null_count) {
-    out.reset(
-        new arrow::NumericArray<ARROW_TYPE>(entry_count, values, is_valid, null_count));
-  } else {
-    out.reset(new arrow::NumericArray<ARROW_TYPE>(entry_count, values));
-  }
+  out = arrow::MakeArray(
+      arrow::ArrayData::Make(type, entry_count, {is_valid, values}, null_count));
 }
 
 #ifndef _MSC_VER
@@ -342,8 +436,23 @@ key_t get_and_copy_to_shm(const std::shared_ptr<Buffer>& data) {
 //! upon deserialization, and will be automatically freed when they go out of scope.
 ArrowResult ArrowResultSetConverter::getArrowResult() const {
   auto timer = DEBUG_TIMER(__func__);
-  std::shared_ptr<arrow::RecordBatch> record_batch = convertToArrow();
+  return serializeArrowResult(convertToArrow());
+}
+
+ArrowResult ArrowResultSetConverter::getArrowResult(const size_t start_entry,
+                                                    const size_t end_entry) const {
+  auto timer = DEBUG_TIMER(__func__);
+  CHECK(device_type_ == ExecutorDeviceType::CPU);
+  return serializeArrowResult(convertToArrow(start_entry, end_entry));
+}
+
+size_t ArrowResultSetConverter::getEntryCount() const {
+  return top_n_ < 0 ? results_->entryCount()
+                    : std::min(size_t(top_n_), results_->entryCount());
+}
 
+ArrowResult ArrowResultSetConverter::serializeArrowResult(
+    const std::shared_ptr<arrow::RecordBatch>& record_batch) const {
   if (device_type_ == ExecutorDeviceType::CPU ||
       transport_method_ == ArrowTransport::WIRE) {
     const auto getWireResult =
@@ -582,6 +691,12 @@ ArrowResultSetConverter::getSerializedArrowOutput(
 }
 
 std::shared_ptr<arrow::RecordBatch> ArrowResultSetConverter::convertToArrow() const {
+  return convertToArrow(0, getEntryCount());
+}
+
+std::shared_ptr<arrow::RecordBatch> ArrowResultSetConverter::convertToArrow(
+    const size_t start_entry,
+    const size_t end_entry) const {
   auto timer = DEBUG_TIMER(__func__);
   const auto col_count = results_->colCount();
   std::vector<std::shared_ptr<arrow::Field>> fields;
@@ -596,16 +711,18 @@ std::shared_ptr<arrow::RecordBatch> ArrowResultSetConverter::convertToArrow() co
     VLOG(1) << "\t" << f->ToString(true);
   }
 #endif
-  return getArrowBatch(arrow::schema(fields));
+  return getArrowBatch(arrow::schema(fields), start_entry, end_entry);
 }
 
 std::shared_ptr<arrow::RecordBatch> ArrowResultSetConverter::getArrowBatch(
-    const std::shared_ptr<arrow::Schema>& schema) const {
+    const std::shared_ptr<arrow::Schema>& schema,
+    const size_t start_entry,
+    const size_t end_entry) const {
   std::vector<std::shared_ptr<arrow::Array>> result_columns;
 
-  const size_t entry_count = top_n_ < 0
-                                 ? results_->entryCount()
-                                 : std::min(size_t(top_n_), results_->entryCount());
+  CHECK_LE(start_entry, end_entry);
+  CHECK_LE(end_entry, results_->entryCount());
+  const size_t entry_count = end_entry - start_entry;
   if (!entry_count) {
     return ARROW_RECORDBATCH_MAKE(schema, 0, result_columns);
   }
@@ -728,31 +845,44 @@ std::shared_ptr<arrow::RecordBatch> ArrowResultSetConverter::getArrowBatch(
   auto convert_columns = [&](std::vector<std::shared_ptr<arrow::Array>>& result,
                              const std::vector<bool>& non_lazy_cols,
                              const size_t start_col,
-                             const size_t end_col) {
+                             const size_t end_col,
+                             const size_t num_threads) {
     for (size_t col = start_col; col < end_col; ++col) {
       if (!non_lazy_cols.empty() && !non_lazy_cols[col]) {
         continue;
       }
 
       const auto& column = builders[col];
+      const auto& type = column.field->type();
       switch (column.physical_type) {
+        case kBOOLEAN:
         case kTINYINT:
-          convert_column<int8_t>(results_, col, entry_count, result[col]);
+          convert_column<int8_t>(
+              results_, col, entry_count, type, num_threads, result[col]);
           break;
         case kSMALLINT:
-          convert_column<int16_t>(results_, col, entry_count, result[col]);
+          convert_column<int16_t>(
+              results_, col, entry_count, type, num_threads, result[col]);
           break;
         case kINT:
-          convert_column<int32_t>(results_, col, entry_count, result[col]);
+          convert_column<int32_t>(
+              results_, col, entry_count, type, num_threads, result[col]);
           break;
         case kBIGINT:
-          convert_column<int64_t>(results_, col, entry_count, result[col]);
+        case kDECIMAL:
+        case kTIME:
+        case kTIMESTAMP:
+        case kDATE:
+          convert_column<int64_t>(
+              results_, col, entry_count, type, num_threads, result[col]);
           break;
         case kFLOAT:
-          convert_column<float>(results_, col, entry_count, result[col]);
+          convert_column<float>(
+              results_, col, entry_count, type, num_threads, result[col]);
           break;
         case kDOUBLE:
-          convert_column<double>(results_, col, entry_count, result[col]);
+          convert_column<double>(
+              results_, col, entry_count, type, num_threads, result[col]);
           break;
         default:
           throw std::runtime_error(column.col_type.get_type_name() +
@@ -764,9 +894,11 @@ std::shared_ptr<arrow::RecordBatch> ArrowResultSetConverter::getArrowBatch(
   std::vector<std::shared_ptr<ValueArray>> column_values(col_count, nullptr);
   std::vector<std::shared_ptr<std::vector<bool>>> null_bitmaps(col_count, nullptr);
   const bool multithreaded = entry_count > 10000 && !results_->isTruncated();
+  // The columnar converter only converts whole columns.
   bool use_columnar_converter = results_->isDirectColumnarConversionPossible() &&
                                 results_->getQueryMemDesc().getQueryDescriptionType() ==
                                     QueryDescriptionType::Projection &&
+                                start_entry == 0 &&
                                 entry_count == results_->entryCount();
   std::vector<bool> non_lazy_cols;
   if (use_columnar_converter) {
@@ -784,17 +916,24 @@ std::shared_ptr<arrow::RecordBatch> ArrowResultSetConverter::getArrowBatch(
       // Treat them as lazy.
       switch (builders[i].physical_type) {
         case kBOOLEAN:
-        case kTIME:
         case kDATE:
+        case kDECIMAL:
+        case kTIME:
         case kTIMESTAMP:
-          is_lazy = true;
+          // Converted from 8 byte slots, 1 byte for booleans.
+          is_lazy = is_lazy || builders[i].col_type.get_size() !=
+                                   (builders[i].physical_type == kBOOLEAN ? 1 : 8);
           break;
         default:
           break;
       }
+      // Dictionary arrays are built with the dictionary memo of the row path builders.
       if (builders[i].field->type()->id() == arrow::Type::DICTIONARY) {
         is_lazy = true;
       }
+      // The slots have to hold the values at their logical width.
+      is_lazy = is_lazy || results_->getQueryMemDesc().getPaddedSlotWidthBytes(i) !=
+                               builders[i].col_type.get_size();
       non_lazy_cols.emplace_back(!is_lazy);
       if (!is_lazy) {
         ++non_lazy_col_count;
@@ -812,6 +951,11 @@ std::shared_ptr<arrow::RecordBatch> ArrowResultSetConverter::getArrowBatch(
     std::vector<std::future<void>> child_threads;
     size_t num_threads =
         std::min(multithreaded ? (size_t)cpu_threads() : (size_t)1, non_lazy_col_count);
+    // Threads left over by the columns convert ranges of entries of their columns.
+    const size_t num_range_threads =
+        multithreaded && num_threads
+            ? std::max(size_t(1), static_cast<size_t>(cpu_threads()) / num_threads)
+            : size_t(1);
 
     size_t start_col = 0;
     size_t end_col = 0;
@@ -827,7 +971,8 @@ std::shared_ptr<arrow::RecordBatch> ArrowResultSetConverter::getArrowBatch(
                                          std::ref(result_columns),
                                          non_lazy_cols,
                                          phys_start_col,
-                                         phys_end_col));
+                                         phys_end_col,
+                                         num_range_threads));
     }
     for (auto& child : child_threads) {
       child.get();
@@ -845,16 +990,16 @@ std::shared_ptr<arrow::RecordBatch> ArrowResultSetConverter::getArrowBatch(
       std::vector<std::vector<std::shared_ptr<std::vector<bool>>>> null_bitmap_segs(
           cpu_count, std::vector<std::shared_ptr<std::vector<bool>>>(col_count, nullptr));
       const auto stride = (entry_count + cpu_count - 1) / cpu_count;
-      for (size_t i = 0, start_entry = 0; start_entry < entry_count;
-           ++i, start_entry += stride) {
-        const auto end_entry = std::min(entry_count, start_entry + stride);
+      for (size_t i = 0, seg_start_entry = start_entry; seg_start_entry < end_entry;
+           ++i, seg_start_entry += stride) {
+        const auto seg_end_entry = std::min(end_entry, seg_start_entry + stride);
         child_threads.push_back(std::async(std::launch::async,
                                            fetch,
                                            std::ref(column_value_segs[i]),
                                            std::ref(null_bitmap_segs[i]),
                                            non_lazy_cols,
-                                           start_entry,
-                                           end_entry));
+                                           seg_start_entry,
+                                           seg_end_entry));
       }
       for (auto& child : child_threads) {
         row_count += child.get();
@@ -876,7 +1021,7 @@ std::shared_ptr<arrow::RecordBatch> ArrowResultSetConverter::getArrowBatch(
       }
     } else {
       row_count =
-          fetch(column_values, null_bitmaps, non_lazy_cols, size_t(0), entry_count);
+          fetch(column_values, null_bitmaps, non_lazy_cols, start_entry, end_entry);
       {
         auto timer = DEBUG_TIMER("append rows to arrow single thread");
         for (int i = 0; i < schema->num_fields(); ++i) {
@@ -884,6 +1029,10 @@ std::shared_ptr<arrow::RecordBatch> ArrowResultSetConverter::getArrowBatch(
             continue;
           }
 
+          if (!column_values[i]) {
+            // Every entry of the range was empty.
+            continue;
+          }
           append(builders[i], *column_values[i], null_bitmaps[i]);
         }
       }
@@ -1020,6 +1169,51 @@ void ArrowResultSet::deallocateArrowResultBuffer(
 #endif
 }
 
+ArrowResultSetStream::ArrowResultSetStream(
+    std::unique_ptr<ArrowResultSetConverter> converter,
+    const size_t batch_entries)
+    : converter_(std::move(converter))
+    , batch_entries_(batch_entries)
+    , entry_count_(converter_->getEntryCount())
+    , next_entry_(0) {
+  CHECK_GT(batch_entries_, size_t(0));
+  // Empty results still get a batch, which carries the schema.
+  convertNextBatch();
+}
+
+ArrowResultSetStream::~ArrowResultSetStream() {
+  if (!next_batch_.valid()) {
+    return;
+  }
+  try {
+    const auto batch = next_batch_.get();
+    if (converter_->transport_method_ == ArrowTransport::SHARED_MEMORY) {
+      ArrowResultSet::deallocateArrowResultBuffer(
+          batch, ExecutorDeviceType::CPU, 0, converter_->data_mgr_);
+    }
+  } catch (const std::exception& e) {
+    LOG(WARNING) << "Discarding an Arrow result batch failed: " << e.what();
+  }
+}
+
+ArrowResult ArrowResultSetStream::getNextBatch() {
+  CHECK(next_batch_.valid());
+  auto batch = next_batch_.get();
+  if (next_entry_ < entry_count_) {
+    convertNextBatch();
+  }
+  return batch;
+}
+
+void ArrowResultSetStream::convertNextBatch() {
+  const auto start_entry = next_entry_;
+  const auto end_entry = std::min(start_entry + batch_entries_, entry_count_);
+  next_entry_ = end_entry;
+  next_batch_ = std::async(std::launch::async, [this, start_entry, end_entry] {
+    return converter_->getArrowResult(start_entry, end_entry);
+  });
+}
+
 void ArrowResultSetConverter::initializeColumnBuilder(
     ColumnBuilder& column_builder,
     const SQLTypeInfo& col_type,
@@ -0,0 +1,983 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "QueryEngine/BatchInterpreter.h"
+
+#include <atomic>
+#include <cmath>
+#include <optional>
+
+#include "Logger/Logger.h"
+#include "QueryEngine/Execute.h"
+#include "QueryEngine/OutputBufferInitialization.h"
+#include "Utils/ChunkIter.h"
+#include "Utils/StringLike.h"
+
+bool g_enable_batch_interpreter{true};
+
+namespace {
+
+constexpr size_t kBatchRowCount{4096};
+
+std::atomic<size_t> interpreted_step_count{0};
+
+const std::string kOverflowMessage{"Overflow or underflow"};
+
+// How the values of an expression are held in a batch, booleans are integers.
+enum class ValueKind { Integer, Fp, String };
+
+std::optional<ValueKind> get_value_kind(const SQLTypeInfo& ti) {
+  if (ti.is_integer() || ti.is_boolean()) {
+    return ValueKind::Integer;
+  }
+  if (ti.is_fp()) {
+    return ValueKind::Fp;
+  }
+  if (ti.is_string()) {
+    return ValueKind::String;
+  }
+  return std::nullopt;
+}
+
+ValueKind get_value_kind(const Analyzer::Expr* expr) {
+  const auto kind = get_value_kind(expr->get_type_info());
+  CHECK(kind);
+  return *kind;
+}
+
+// The values of an expression over the rows of a batch, only the vector of its kind is
+// filled in.
+struct BatchValues {
+  std::vector<int64_t> ints;
+  std::vector<double> fps;
+  std::vector<std::string> strs;
+  std::vector<int8_t> nulls;
+
+  BatchValues(const ValueKind kind, const size_t size) : nulls(size, 0) {
+    switch (kind) {
+      case ValueKind::Integer:
+        ints.resize(size);
+        break;
+      case ValueKind::Fp:
+        fps.resize(size);
+        break;
+      case ValueKind::String:
+        strs.resize(size);
+        break;
+    }
+  }
+
+  double getFp(const size_t i) const { return fps.empty() ? ints[i] : fps[i]; }
+};
+
+bool is_string_constant(const Analyzer::Expr* expr) {
+  const auto constant = dynamic_cast<const Analyzer::Constant*>(expr);
+  return constant && constant->get_type_info().is_string() && !constant->get_is_null();
+}
+
+// Whether the interpreter evaluates the expression, the operators the external executor
+// is used for (string concatenation and substrings) and the scalar ones around them.
+bool is_interpretable(const Analyzer::Expr* expr) {
+  if (!expr || !get_value_kind(expr->get_type_info())) {
+    return false;
+  }
+  if (dynamic_cast<const Analyzer::Var*>(expr)) {
+    return false;
+  }
+  if (const auto col_var = dynamic_cast<const Analyzer::ColumnVar*>(expr)) {
+    const auto& ti = col_var->get_type_info();
+    return col_var->get_rte_idx() == 0 &&
+           (ti.get_compression() == kENCODING_NONE ||
+            (ti.is_string() && ti.get_compression() == kENCODING_DICT));
+  }
+  if (dynamic_cast<const Analyzer::Constant*>(expr)) {
+    return true;
+  }
+  if (const auto uoper = dynamic_cast<const Analyzer::UOper*>(expr)) {
+    const auto operand = uoper->get_operand();
+    switch (uoper->get_optype()) {
+      case kNOT:
+      case kUMINUS:
+      case kISNULL:
+        return is_interpretable(operand);
+      case kCAST:
+        // Casts between numbers and between strings.
+        return is_interpretable(operand) &&
+               (get_value_kind(operand) == ValueKind::String) ==
+                   (get_value_kind(expr) == ValueKind::String);
+      default:
+        return false;
+    }
+  }
+  if (const auto bin_oper = dynamic_cast<const Analyzer::BinOper*>(expr)) {
+    const auto lhs = bin_oper->get_left_operand();
+    const auto rhs = bin_oper->get_right_operand();
+    if (bin_oper->get_qualifier() != kONE || !is_interpretable(lhs) ||
+        !is_interpretable(rhs)) {
+      return false;
+    }
+    const bool lhs_is_string = get_value_kind(lhs) == ValueKind::String;
+    const bool rhs_is_string = get_value_kind(rhs) == ValueKind::String;
+    switch (bin_oper->get_optype()) {
+      case kAND:
+      case kOR:
+        return lhs->get_type_info().is_boolean() && rhs->get_type_info().is_boolean();
+      case kEQ:
+      case kNE:
+      case kLT:
+      case kLE:
+      case kGT:
+      case kGE:
+        return lhs_is_string == rhs_is_string;
+      case kPLUS:
+      case kMINUS:
+      case kMULTIPLY:
+      case kDIVIDE:
+      case kMODULO:
+        return !lhs_is_string && !rhs_is_string &&
+               get_value_kind(expr) != ValueKind::String;
+      default:
+        return false;
+    }
+  }
+  if (const auto in_values = dynamic_cast<const Analyzer::InValues*>(expr)) {
+    const auto arg = in_values->get_arg();
+    if (!is_interpretable(arg)) {
+      return false;
+    }
+    const bool arg_is_string = get_value_kind(arg) == ValueKind::String;
+    for (const auto& value : in_values->get_value_list()) {
+      if (!dynamic_cast<const Analyzer::Constant*>(value.get()) ||
+          !is_interpretable(value.get()) ||
+          (get_value_kind(value.get()) == ValueKind::String) != arg_is_string) {
+        return false;
+      }
+    }
+    return true;
+  }
+  if (const auto like = dynamic_cast<const Analyzer::LikeExpr*>(expr)) {
+    return is_interpretable(like->get_arg()) &&
+           get_value_kind(like->get_arg()) == ValueKind::String &&
+           is_string_constant(like->get_like_expr()) &&
+           (!like->get_escape_expr() || is_string_constant(like->get_escape_expr()));
+  }
+  if (const auto case_expr = dynamic_cast<const Analyzer::CaseExpr*>(expr)) {
+    const bool is_string = get_value_kind(expr) == ValueKind::String;
+    for (const auto& expr_pair : case_expr->get_expr_pair_list()) {
+      if (!is_interpretable(expr_pair.first.get()) ||
+          !expr_pair.first->get_type_info().is_boolean() ||
+          !is_interpretable(expr_pair.second.get()) ||
+          (get_value_kind(expr_pair.second.get()) == ValueKind::String) != is_string) {
+        return false;
+      }
+    }
+    const auto else_expr = case_expr->get_else_expr();
+    return !else_expr ||
+           (is_interpretable(else_expr) &&
+            (get_value_kind(else_expr) == ValueKind::String) == is_string);
+  }
+  if (const auto func_oper = dynamic_cast<const Analyzer::FunctionOper*>(expr)) {
+    const auto& name = func_oper->getName();
+    const auto arity = func_oper->getArity();
+    for (size_t i = 0; i < arity; ++i) {
+      const auto arg = func_oper->getArg(i);
+      const auto expected_kind =
+          name == "||" || i == 0 ? ValueKind::String : ValueKind::Integer;
+      if (!is_interpretable(arg) || get_value_kind(arg) != expected_kind) {
+        return false;
+      }
+    }
+    return (name == "||" && arity == 2) ||
+           (name == "SUBSTRING" && (arity == 2 || arity == 3));
+  }
+  return false;
+}
+
+void check_int_range(const int64_t val, const SQLTypeInfo& ti) {
+  if (ti.is_boolean()) {
+    return;
+  }
+  const auto limits = inline_int_max_min(ti.get_logical_size());
+  if (val > limits.first || val < limits.second) {
+    throw std::runtime_error(kOverflowMessage);
+  }
+}
+
+int64_t get_int_constant(const Analyzer::Constant* constant) {
+  const auto& datum = constant->get_constval();
+  switch (constant->get_type_info().get_type()) {
+    case kBOOLEAN:
+      return datum.boolval;
+    case kTINYINT:
+      return datum.tinyintval;
+    case kSMALLINT:
+      return datum.smallintval;
+    case kINT:
+      return datum.intval;
+    case kBIGINT:
+      return datum.bigintval;
+    default:
+      UNREACHABLE() << constant->get_type_info().get_type_name();
+      return 0;
+  }
+}
+
+// SQLite's substr(), which the external executor used to run SUBSTRING through: a
+// 1-based start, counted from the end if negative, and a length counted backwards from
+// the start if negative.
+std::string sqlite_substr(const std::string& str,
+                          int64_t start,
+                          const std::optional<int64_t> length) {
+  const auto str_len = static_cast<int64_t>(str.size());
+  int64_t len = length ? *length : str_len;
+  const bool negative_len = len < 0;
+  if (negative_len) {
+    len = -len;
+  }
+  if (start < 0) {
+    start += str_len;
+    if (start < 0) {
+      len = std::max(len + start, int64_t(0));
+      start = 0;
+    }
+  } else if (start > 0) {
+    --start;
+  } else if (len > 0) {
+    --len;
+  }
+  if (negative_len) {
+    start -= len;
+    if (start < 0) {
+      len += start;
+      start = 0;
+    }
+  }
+  if (start + len > str_len) {
+    len = std::max(str_len - start, int64_t(0));
+  }
+  return len ? str.substr(start, len) : std::string();
+}
+
+template <class T>
+void read_ints(const int8_t* column, const size_t start, BatchValues& values) {
+  const auto typed_column = reinterpret_cast<const T*>(column) + start;
+  for (size_t i = 0; i < values.ints.size(); ++i) {
+    const auto val = typed_column[i];
+    values.nulls[i] = val == inline_int_null_value<T>();
+    values.ints[i] = val;
+  }
+}
+
+template <class T>
+void read_fps(const int8_t* column, const size_t start, BatchValues& values) {
+  const auto typed_column = reinterpret_cast<const T*>(column) + start;
+  for (size_t i = 0; i < values.fps.size(); ++i) {
+    const auto val = typed_column[i];
+    values.nulls[i] = val == inline_fp_null_value<T>();
+    values.fps[i] = val;
+  }
+}
+
+template <class T>
+void read_dictionary_strings(const int8_t* column,
+                             const size_t start,
+                             const StringDictionaryProxy* sdp,
+                             BatchValues& values) {
+  const auto ids_column = reinterpret_cast<const T*>(column) + start;
+  for (size_t i = 0; i < values.strs.size(); ++i) {
+    const auto val = ids_column[i];
+    values.nulls[i] = val == inline_int_null_value<T>();
+    if (!values.nulls[i]) {
+      values.strs[i] = sdp->getString(val);
+    }
+  }
+}
+
+// Evaluates expressions over a batch of rows of the one fragment of the fetch result.
+// Only the active rows of a batch have to be valid: errors like division by zero are
+// only raised for them, so that a row filtered out or a branch of a CASE not taken by
+// the row doesn't fail the query.
+class BatchEvaluator {
+ public:
+  BatchEvaluator(const FetchResult& fetch_result,
+                 const PlanState* plan_state,
+                 const Executor* executor)
+      : fetch_result_(fetch_result), plan_state_(plan_state), executor_(executor) {}
+
+  BatchValues eval(const Analyzer::Expr* expr,
+                   const size_t start,
+                   const std::vector<int8_t>& active) const {
+    if (const auto col_var = dynamic_cast<const Analyzer::ColumnVar*>(expr)) {
+      return evalColumnVar(col_var, start, active.size());
+    }
+    if (const auto constant = dynamic_cast<const Analyzer::Constant*>(expr)) {
+      return evalConstant(constant, active.size());
+    }
+    if (const auto uoper = dynamic_cast<const Analyzer::UOper*>(expr)) {
+      return evalUOper(uoper, start, active);
+    }
+    if (const auto bin_oper = dynamic_cast<const Analyzer::BinOper*>(expr)) {
+      return evalBinOper(bin_oper, start, active);
+    }
+    if (const auto in_values = dynamic_cast<const Analyzer::InValues*>(expr)) {
+      return evalInValues(in_values, start, active);
+    }
+    if (const auto like = dynamic_cast<const Analyzer::LikeExpr*>(expr)) {
+      return evalLike(like, start, active);
+    }
+    if (const auto case_expr = dynamic_cast<const Analyzer::CaseExpr*>(expr)) {
+      return evalCase(case_expr, start, active);
+    }
+    if (const auto func_oper = dynamic_cast<const Analyzer::FunctionOper*>(expr)) {
+      return evalFunctionOper(func_oper, start, active);
+    }
+    UNREACHABLE() << expr->toString();
+    return BatchValues(ValueKind::Integer, 0);
+  }
+
+  // The column buffer of a column of the outer table, nullptr if it isn't fetched.
+  const int8_t* getColumnBuffer(const int table_id, const int column_id) const {
+    const auto it = plan_state_->global_to_local_col_ids_.find(
+        InputColDescriptor(column_id, table_id, 0));
+    if (it == plan_state_->global_to_local_col_ids_.end()) {
+      return nullptr;
+    }
+    CHECK_LT(it->second, fetch_result_.col_buffers.front().size());
+    return fetch_result_.col_buffers.front()[it->second];
+  }
+
+ private:
+  BatchValues evalColumnVar(const Analyzer::ColumnVar* col_var,
+                            const size_t start,
+                            const size_t size) const {
+    const auto column =
+        getColumnBuffer(col_var->get_table_id(), col_var->get_column_id());
+    CHECK(column);
+    const auto& ti = col_var->get_type_info();
+    BatchValues result(get_value_kind(col_var), size);
+    if (ti.is_string() && ti.get_compression() == kENCODING_DICT) {
+      const auto sdp = executor_->getStringDictionaryProxy(
+          ti.get_comp_param(), executor_->getRowSetMemoryOwner(), true);
+      CHECK(sdp);
+      switch (ti.get_size()) {
+        case 1:
+          read_dictionary_strings<uint8_t>(column, start, sdp, result);
+          break;
+        case 2:
+          read_dictionary_strings<uint16_t>(column, start, sdp, result);
+          break;
+        case 4:
+          read_dictionary_strings<int32_t>(column, start, sdp, result);
+          break;
+        default:
+          LOG(FATAL) << "Invalid encoding size: " << ti.get_size();
+      }
+    } else if (ti.is_string()) {
+      const auto chunk_iter =
+          const_cast<ChunkIter*>(reinterpret_cast<const ChunkIter*>(column));
+      for (size_t i = 0; i < size; ++i) {
+        VarlenDatum vd;
+        bool is_end;
+        ChunkIter_get_nth(chunk_iter, start + i, false, &vd, &is_end);
+        result.nulls[i] = vd.is_null;
+        if (!vd.is_null) {
+          result.strs[i].assign(reinterpret_cast<const char*>(vd.pointer), vd.length);
+        }
+      }
+    } else if (ti.is_fp()) {
+      if (ti.get_type() == kFLOAT) {
+        read_fps<float>(column, start, result);
+      } else {
+        read_fps<double>(column, start, result);
+      }
+    } else {
+      switch (ti.get_size()) {
+        case 1:
+          read_ints<int8_t>(column, start, result);
+          break;
+        case 2:
+          read_ints<int16_t>(column, start, result);
+          break;
+        case 4:
+          read_ints<int32_t>(column, start, result);
+          break;
+        case 8:
+          read_ints<int64_t>(column, start, result);
+          break;
+        default:
+          LOG(FATAL) << "Invalid column size: " << ti.get_size();
+      }
+    }
+    return result;
+  }
+
+  BatchValues evalConstant(const Analyzer::Constant* constant, const size_t size) const {
+    const auto kind = get_value_kind(constant);
+    BatchValues result(kind, size);
+    if (constant->get_is_null()) {
+      std::fill(result.nulls.begin(), result.nulls.end(), 1);
+      return result;
+    }
+    const auto& datum = constant->get_constval();
+    switch (kind) {
+      case ValueKind::Integer:
+        std::fill(result.ints.begin(), result.ints.end(), get_int_constant(constant));
+        break;
+      case ValueKind::Fp:
+        std::fill(result.fps.begin(),
+                  result.fps.end(),
+                  constant->get_type_info().get_type() == kFLOAT ? datum.floatval
+                                                                 : datum.doubleval);
+        break;
+      case ValueKind::String:
+        CHECK(datum.stringval);
+        std::fill(result.strs.begin(), result.strs.end(), *datum.stringval);
+        break;
+    }
+    return result;
+  }
+
+  BatchValues evalUOper(const Analyzer::UOper* uoper,
+                        const size_t start,
+                        const std::vector<int8_t>& active) const {
+    const auto operand = eval(uoper->get_operand(), start, active);
+    const auto size = active.size();
+    const auto& ti = uoper->get_type_info();
+    const auto kind = get_value_kind(uoper);
+    BatchValues result(kind, size);
+    result.nulls = operand.nulls;
+    switch (uoper->get_optype()) {
+      case kNOT: {
+        for (size_t i = 0; i < size; ++i) {
+          result.ints[i] = !operand.ints[i];
+        }
+        break;
+      }
+      case kUMINUS: {
+        if (kind == ValueKind::Fp) {
+          for (size_t i = 0; i < size; ++i) {
+            result.fps[i] = -operand.fps[i];
+          }
+          break;
+        }
+        for (size_t i = 0; i < size; ++i) {
+          if (active[i] && !operand.nulls[i] &&
+              operand.ints[i] == std::numeric_limits<int64_t>::min()) {
+            throw std::runtime_error(kOverflowMessage);
+          }
+          result.ints[i] = -operand.ints[i];
+        }
+        break;
+      }
+      case kISNULL: {
+        for (size_t i = 0; i < size; ++i) {
+          result.ints[i] = operand.nulls[i];
+          result.nulls[i] = 0;
+        }
+        break;
+      }
+      case kCAST: {
+        const auto operand_kind = get_value_kind(uoper->get_operand());
+        if (kind == ValueKind::String) {
+          result.strs = operand.strs;
+        } else if (kind == ValueKind::Fp) {
+          for (size_t i = 0; i < size; ++i) {
+            const auto val = operand.getFp(i);
+            result.fps[i] = ti.get_type() == kFLOAT ? static_cast<float>(val) : val;
+          }
+        } else {
+          for (size_t i = 0; i < size; ++i) {
+            if (operand_kind == ValueKind::Fp) {
+              const auto val = operand.fps[i];
+              if (active[i] && !operand.nulls[i] &&
+                  !(std::abs(val) < std::numeric_limits<int64_t>::max())) {
+                throw std::runtime_error(kOverflowMessage);
+              }
+              result.ints[i] = std::llround(val);
+            } else {
+              result.ints[i] = operand.ints[i];
+            }
+            if (ti.is_boolean()) {
+              result.ints[i] = result.ints[i] != 0;
+            } else if (active[i] && !result.nulls[i]) {
+              check_int_range(result.ints[i], ti);
+            }
+          }
+        }
+        break;
+      }
+      default:
+        UNREACHABLE() << uoper->toString();
+    }
+    return result;
+  }
+
+  BatchValues evalBinOper(const Analyzer::BinOper* bin_oper,
+                          const size_t start,
+                          const std::vector<int8_t>& active) const {
+    const auto lhs_expr = bin_oper->get_left_operand();
+    const auto rhs_expr = bin_oper->get_right_operand();
+    const auto lhs = eval(lhs_expr, start, active);
+    const auto rhs = eval(rhs_expr, start, active);
+    const auto size = active.size();
+    const auto optype = bin_oper->get_optype();
+    BatchValues result(get_value_kind(bin_oper), size);
+    if (optype == kAND || optype == kOR) {
+      // A false (true) operand decides AND (OR), even if the other one is NULL.
+      const int64_t decisive = optype == kOR;
+      for (size_t i = 0; i < size; ++i) {
+        const bool lhs_decides = !lhs.nulls[i] && lhs.ints[i] == decisive;
+        const bool rhs_decides = !rhs.nulls[i] && rhs.ints[i] == decisive;
+        if (lhs_decides || rhs_decides) {
+          result.ints[i] = decisive;
+        } else {
+          result.nulls[i] = lhs.nulls[i] || rhs.nulls[i];
+          result.ints[i] = !decisive;
+        }
+      }
+      return result;
+    }
+    for (size_t i = 0; i < size; ++i) {
+      result.nulls[i] = lhs.nulls[i] || rhs.nulls[i];
+    }
+    if (IS_COMPARISON(optype)) {
+      const auto lhs_kind = get_value_kind(lhs_expr);
+      const auto rhs_kind = get_value_kind(rhs_expr);
+      for (size_t i = 0; i < size; ++i) {
+        int cmp{0};
+        if (lhs_kind == ValueKind::String) {
+          cmp = lhs.strs[i].compare(rhs.strs[i]);
+        } else if (lhs_kind == ValueKind::Fp || rhs_kind == ValueKind::Fp) {
+          const auto lhs_val = lhs.getFp(i);
+          const auto rhs_val = rhs.getFp(i);
+          cmp = lhs_val < rhs_val ? -1 : (lhs_val > rhs_val ? 1 : 0);
+        } else {
+          cmp = lhs.ints[i] < rhs.ints[i] ? -1 : (lhs.ints[i] > rhs.ints[i] ? 1 : 0);
+        }
+        switch (optype) {
+          case kEQ:
+            result.ints[i] = cmp == 0;
+            break;
+          case kNE:
+            result.ints[i] = cmp != 0;
+            break;
+          case kLT:
+            result.ints[i] = cmp < 0;
+            break;
+          case kLE:
+            result.ints[i] = cmp <= 0;
+            break;
+          case kGT:
+            result.ints[i] = cmp > 0;
+            break;
+          case kGE:
+            result.ints[i] = cmp >= 0;
+            break;
+          default:
+            UNREACHABLE();
+        }
+      }
+      return result;
+    }
+    CHECK(IS_ARITHMETIC(optype));
+    if (get_value_kind(bin_oper) == ValueKind::Fp) {
+      for (size_t i = 0; i < size; ++i) {
+        const auto lhs_val = lhs.getFp(i);
+        const auto rhs_val = rhs.getFp(i);
+        const bool check = active[i] && !result.nulls[i];
+        if (check && (optype == kDIVIDE || optype == kMODULO) && rhs_val == 0) {
+          throw std::runtime_error("Division by zero");
+        }
+        switch (optype) {
+          case kPLUS:
+            result.fps[i] = lhs_val + rhs_val;
+            break;
+          case kMINUS:
+            result.fps[i] = lhs_val - rhs_val;
+            break;
+          case kMULTIPLY:
+            result.fps[i] = lhs_val * rhs_val;
+            break;
+          case kDIVIDE:
+            result.fps[i] = lhs_val / rhs_val;
+            break;
+          case kMODULO:
+            result.fps[i] = std::fmod(lhs_val, rhs_val);
+            break;
+          default:
+            UNREACHABLE();
+        }
+      }
+      return result;
+    }
+    const auto& ti = bin_oper->get_type_info();
+    for (size_t i = 0; i < size; ++i) {
+      const bool check = active[i] && !result.nulls[i];
+      const auto lhs_val = lhs.ints[i];
+      const auto rhs_val = rhs.ints[i];
+      int64_t val{0};
+      bool overflow{false};
+      switch (optype) {
+        case kPLUS:
+          overflow = __builtin_add_overflow(lhs_val, rhs_val, &val);
+          break;
+        case kMINUS:
+          overflow = __builtin_sub_overflow(lhs_val, rhs_val, &val);
+          break;
+        case kMULTIPLY:
+          overflow = __builtin_mul_overflow(lhs_val, rhs_val, &val);
+          break;
+        case kDIVIDE:
+        case kMODULO:
+          if (!rhs_val) {
+            if (check) {
+              throw std::runtime_error("Division by zero");
+            }
+            break;
+          }
+          if (lhs_val == std::numeric_limits<int64_t>::min() && rhs_val == -1) {
+            overflow = optype == kDIVIDE;
+            break;
+          }
+          val = optype == kDIVIDE ? lhs_val / rhs_val : lhs_val % rhs_val;
+          break;
+        default:
+          UNREACHABLE();
+      }
+      if (check) {
+        if (overflow) {
+          throw std::runtime_error(kOverflowMessage);
+        }
+        check_int_range(val, ti);
+      }
+      result.ints[i] = val;
+    }
+    return result;
+  }
+
+  BatchValues evalInValues(const Analyzer::InValues* in_values,
+                           const size_t start,
+                           const std::vector<int8_t>& active) const {
+    const auto arg_expr = in_values->get_arg();
+    const auto arg = eval(arg_expr, start, active);
+    const auto size = active.size();
+    BatchValues result(ValueKind::Integer, size);
+    const auto arg_kind = get_value_kind(arg_expr);
+    bool has_null_value{false};
+    std::vector<BatchValues> values;
+    for (const auto& value : in_values->get_value_list()) {
+      const auto constant = dynamic_cast<const Analyzer::Constant*>(value.get());
+      CHECK(constant);
+      if (constant->get_is_null()) {
+        has_null_value = true;
+        continue;
+      }
+      values.push_back(evalConstant(constant, 1));
+    }
+    for (size_t i = 0; i < size; ++i) {
+      if (arg.nulls[i]) {
+        result.nulls[i] = 1;
+        continue;
+      }
+      bool found{false};
+      for (const auto& value : values) {
+        if (arg_kind == ValueKind::String) {
+          found = arg.strs[i] == value.strs.front();
+        } else if (arg_kind == ValueKind::Fp || value.ints.empty()) {
+          found = arg.getFp(i) == value.getFp(0);
+        } else {
+          found = arg.ints[i] == value.ints.front();
+        }
+        if (found) {
+          break;
+        }
+      }
+      // x IN (..., NULL) is NULL rather than false if x isn't in the list.
+      result.ints[i] = found;
+      result.nulls[i] = !found && has_null_value;
+    }
+    return result;
+  }
+
+  BatchValues evalLike(const Analyzer::LikeExpr* like,
+                       const size_t start,
+                       const std::vector<int8_t>& active) const {
+    const auto arg = eval(like->get_arg(), start, active);
+    const auto size = active.size();
+    const auto pattern_constant =
+        dynamic_cast<const Analyzer::Constant*>(like->get_like_expr());
+    CHECK(pattern_constant);
+    const auto& pattern = *pattern_constant->get_constval().stringval;
+    char escape_char{'\\'};
+    if (like->get_escape_expr()) {
+      const auto escape_constant =
+          dynamic_cast<const Analyzer::Constant*>(like->get_escape_expr());
+      CHECK(escape_constant);
+      const auto& escape_str = *escape_constant->get_constval().stringval;
+      if (escape_str.size() != 1) {
+        throw std::runtime_error("Escape must be a single character");
+      }
+      escape_char = escape_str.front();
+    }
+    BatchValues result(ValueKind::Integer, size);
+    result.nulls = arg.nulls;
+    for (size_t i = 0; i < size; ++i) {
+      if (arg.nulls[i]) {
+        continue;
+      }
+      const auto& str = arg.strs[i];
+      const auto like_fn = like->get_is_ilike() ? string_ilike : string_like;
+      result.ints[i] =
+          like_fn(str.c_str(), str.size(), pattern.c_str(), pattern.size(), escape_char);
+    }
+    return result;
+  }
+
+  BatchValues evalCase(const Analyzer::CaseExpr* case_expr,
+                       const size_t start,
+                       const std::vector<int8_t>& active) const {
+    const auto size = active.size();
+    const auto kind = get_value_kind(case_expr);
+    BatchValues result(kind, size);
+    // The rows which haven't taken a branch yet.
+    auto remaining = active;
+    auto take_branch = [&](const Analyzer::Expr* then_expr,
+                           const std::vector<int8_t>& taken) {
+      const auto then = eval(then_expr, start, taken);
+      for (size_t i = 0; i < size; ++i) {
+        if (!taken[i]) {
+          continue;
+        }
+        result.nulls[i] = then.nulls[i];
+        switch (kind) {
+          case ValueKind::Integer:
+            result.ints[i] = then.ints[i];
+            break;
+          case ValueKind::Fp:
+            result.fps[i] = then.getFp(i);
+            break;
+          case ValueKind::String:
+            result.strs[i] = then.strs[i];
+            break;
+        }
+      }
+    };
+    for (const auto& expr_pair : case_expr->get_expr_pair_list()) {
+      const auto when = eval(expr_pair.first.get(), start, remaining);
+      std::vector<int8_t> taken(size, 0);
+      for (size_t i = 0; i < size; ++i) {
+        taken[i] = remaining[i] && !when.nulls[i] && when.ints[i];
+        remaining[i] = remaining[i] && !taken[i];
+      }
+      take_branch(expr_pair.second.get(), taken);
+    }
+    if (case_expr->get_else_expr()) {
+      take_branch(case_expr->get_else_expr(), remaining);
+    } else {
+      for (size_t i = 0; i < size; ++i) {
+        result.nulls[i] = result.nulls[i] || remaining[i];
+      }
+    }
+    return result;
+  }
+
+  BatchValues evalFunctionOper(const Analyzer::FunctionOper* func_oper,
+                               const size_t start,
+                               const std::vector<int8_t>& active) const {
+    const auto size = active.size();
+    std::vector<BatchValues> args;
+    for (size_t i = 0; i < func_oper->getArity(); ++i) {
+      args.push_back(eval(func_oper->getArg(i), start, active));
+    }
+    BatchValues result(ValueKind::String, size);
+    for (size_t i = 0; i < size; ++i) {
+      for (const auto& arg : args) {
+        result.nulls[i] = result.nulls[i] || arg.nulls[i];
+      }
+      if (result.nulls[i]) {
+        continue;
+      }
+      if (func_oper->getName() == "||") {
+        result.strs[i] = args[0].strs[i] + args[1].strs[i];
+      } else {
+        CHECK_EQ(func_oper->getName(), "SUBSTRING");
+        result.strs[i] = sqlite_substr(
+            args[0].strs[i],
+            args[1].ints[i],
+            args.size() > 2 ? std::make_optional(args[2].ints[i]) : std::nullopt);
+      }
+    }
+    return result;
+  }
+
+  const FetchResult& fetch_result_;
+  const PlanState* plan_state_;
+  const Executor* executor_;
+};
+
+// Appends the active rows of a batch of values to the values of all batches.
+void append_active_rows(BatchValues& all_values,
+                        const BatchValues& batch_values,
+                        const std::vector<int8_t>& active) {
+  for (size_t i = 0; i < active.size(); ++i) {
+    if (!active[i]) {
+      continue;
+    }
+    all_values.nulls.push_back(batch_values.nulls[i]);
+    if (!batch_values.ints.empty()) {
+      all_values.ints.push_back(batch_values.ints[i]);
+    } else if (!batch_values.fps.empty()) {
+      all_values.fps.push_back(batch_values.fps[i]);
+    } else {
+      all_values.strs.push_back(batch_values.strs[i]);
+    }
+  }
+}
+
+}  // namespace
+
+std::unique_ptr<ResultSet> run_query_interpreted(
+    const RelAlgExecutionUnit& ra_exe_unit,
+    const FetchResult& fetch_result,
+    const PlanState* plan_state,
+    const ExternalQueryOutputSpec& output_spec) {
+  if (!g_enable_batch_interpreter || ra_exe_unit.input_descs.size() != 1 ||
+      ra_exe_unit.groupby_exprs.size() != 1 || ra_exe_unit.groupby_exprs.front() ||
+      !ra_exe_unit.join_quals.empty() || ra_exe_unit.estimator ||
+      fetch_result.col_buffers.size() != 1 || fetch_result.num_rows.size() != 1 ||
+      fetch_result.num_rows.front().size() != 1) {
+    return nullptr;
+  }
+  for (const auto target_expr : ra_exe_unit.target_exprs) {
+    const auto& ti = target_expr->get_type_info();
+    if (!is_interpretable(target_expr) ||
+        (ti.is_string() && ti.get_compression() != kENCODING_NONE)) {
+      return nullptr;
+    }
+  }
+  std::vector<const Analyzer::Expr*> quals;
+  for (const auto& qual : ra_exe_unit.simple_quals) {
+    quals.push_back(qual.get());
+  }
+  for (const auto& qual : ra_exe_unit.quals) {
+    quals.push_back(qual.get());
+  }
+  for (const auto qual : quals) {
+    if (!is_interpretable(qual) || !qual->get_type_info().is_boolean()) {
+      return nullptr;
+    }
+  }
+  CHECK_EQ(output_spec.target_infos.size(), ra_exe_unit.target_exprs.size());
+
+  const BatchEvaluator evaluator(fetch_result, plan_state, output_spec.executor);
+  const int table_id = ra_exe_unit.input_descs.front().getTableId();
+  const int8_t* deleted_column{nullptr};
+  const auto deleted_cd_it = plan_state->deleted_columns_.find(table_id);
+  if (deleted_cd_it != plan_state->deleted_columns_.end()) {
+    deleted_column =
+        evaluator.getColumnBuffer(table_id, deleted_cd_it->second->columnId);
+  }
+  std::vector<BatchValues> output_columns;
+  for (const auto target_expr : ra_exe_unit.target_exprs) {
+    output_columns.emplace_back(get_value_kind(target_expr), 0);
+  }
+  const auto num_rows = static_cast<size_t>(fetch_result.num_rows.front().front());
+  for (size_t batch_start = 0; batch_start < num_rows; batch_start += kBatchRowCount) {
+    const auto batch_size = std::min(kBatchRowCount, num_rows - batch_start);
+    std::vector<int8_t> active(batch_size, 1);
+    if (deleted_column) {
+      for (size_t i = 0; i < batch_size; ++i) {
+        active[i] = !deleted_column[batch_start + i];
+      }
+    }
+    for (const auto qual : quals) {
+      const auto qual_values = evaluator.eval(qual, batch_start, active);
+      for (size_t i = 0; i < batch_size; ++i) {
+        active[i] = active[i] && !qual_values.nulls[i] && qual_values.ints[i];
+      }
+    }
+    for (size_t target_idx = 0; target_idx < ra_exe_unit.target_exprs.size();
+         ++target_idx) {
+      const auto target_values =
+          evaluator.eval(ra_exe_unit.target_exprs[target_idx], batch_start, active);
+      append_active_rows(output_columns[target_idx], target_values, active);
+    }
+  }
+
+  // Writes the output the way SqliteMemDatabase::runSelect does.
+  const size_t output_row_count =
+      output_columns.empty() ? 0 : output_columns.front().nulls.size();
+  auto query_mem_desc = output_spec.query_mem_desc;
+  query_mem_desc.setEntryCount(output_row_count);
+  auto row_set_mem_owner = output_spec.executor->getRowSetMemoryOwner();
+  auto rs = std::make_unique<ResultSet>(output_spec.target_infos,
+                                        ExecutorDeviceType::CPU,
+                                        query_mem_desc,
+                                        row_set_mem_owner,
+                                        nullptr,
+                                        0,
+                                        0);
+  const auto storage = rs->allocateStorage();
+  auto output_buffer = reinterpret_cast<int64_t*>(storage->getUnderlyingBuffer());
+  CHECK(!output_row_count || output_buffer);
+  const auto row_size_quad = query_mem_desc.getRowSize() / sizeof(int64_t);
+  for (size_t row_idx = 0; row_idx < output_row_count; ++row_idx) {
+    const auto off = row_idx * row_size_quad;
+    output_buffer[off] = off;
+    auto row = output_buffer + off + 1;
+    size_t slot_idx = 0;
+    for (size_t col_idx = 0; col_idx < output_columns.size(); ++col_idx, ++slot_idx) {
+      const auto& col_type = output_spec.target_infos[col_idx].sql_type;
+      const auto& column = output_columns[col_idx];
+      const bool is_null = column.nulls[row_idx];
+      switch (get_value_kind(ra_exe_unit.target_exprs[col_idx])) {
+        case ValueKind::Integer: {
+          if (is_null) {
+            row[slot_idx] = inline_int_null_val(col_type);
+          } else {
+            check_int_range(column.ints[row_idx], col_type);
+            row[slot_idx] = column.ints[row_idx];
+          }
+          break;
+        }
+        case ValueKind::Fp: {
+          reinterpret_cast<double*>(row)[slot_idx] =
+              is_null ? (col_type.get_type() == kFLOAT ? inline_fp_null_value<float>()
+                                                       : inline_fp_null_value<double>())
+                      : column.fps[row_idx];
+          break;
+        }
+        case ValueKind::String: {
+          if (is_null) {
+            row[slot_idx] = 0;
+            row[++slot_idx] = 0;
+          } else {
+            const auto owned_str = row_set_mem_owner->addString(column.strs[row_idx]);
+            row[slot_idx] = reinterpret_cast<int64_t>(owned_str->c_str());
+            row[++slot_idx] = owned_str->size();
+          }
+          break;
+        }
+      }
+    }
+  }
+  ++interpreted_step_count;
+  return rs;
+}
+
+size_t get_interpreted_step_count() {
+  return interpreted_step_count;
+}
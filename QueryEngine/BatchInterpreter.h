@@ -0,0 +1,37 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "QueryEngine/ExternalExecutor.h"
+#include "QueryEngine/RelAlgExecutionUnit.h"
+
+/**
+ * Runs a single table projection handed to the external executor, a query step the code
+ * generator can't compile, by evaluating its filter and targets over batches of rows of
+ * the fetched column buffers. Returns nullptr if the step has an expression the
+ * interpreter doesn't support, the step then runs through SQLite.
+ */
+std::unique_ptr<ResultSet> run_query_interpreted(
+    const RelAlgExecutionUnit& ra_exe_unit,
+    const FetchResult& fetch_result,
+    const PlanState* plan_state,
+    const ExternalQueryOutputSpec& output_spec);
+
+// Number of query steps run by the interpreter since startup, for testing purposes only.
+size_t get_interpreted_step_count();
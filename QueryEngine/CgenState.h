@@ -18,6 +18,7 @@
 
 #include "IRCodegenUtils.h"
 #include "InValuesBitmap.h"
+#include "StringIdMap.h"
 #include "InputMetadata.h"
 #include "LLVMGlobalContext.h"
 
@@ -223,6 +224,11 @@ struct CgenState {
     in_values_bitmaps_.emplace_back(std::move(in_values_bitmap));
     return in_values_bitmaps_.back().get();
   }
+
+  const StringIdMap* addStringIdMap(std::unique_ptr<StringIdMap>& string_id_map) {
+    string_id_maps_.emplace_back(std::move(string_id_map));
+    return string_id_maps_.back().get();
+  }
   // look up a runtime function based on the name, return type and type of
   // the arguments and call it; x64 only, don't call from GPU codegen
   llvm::Value* emitExternalCall(
@@ -352,6 +358,7 @@ struct CgenState {
   std::unordered_map<int, llvm::Value*> scan_idx_to_hash_pos_;
   InsertionOrderedMap filter_func_args_;
   std::vector<std::unique_ptr<const InValuesBitmap>> in_values_bitmaps_;
+  std::vector<std::unique_ptr<const StringIdMap>> string_id_maps_;
   std::map<std::pair<llvm::Value*, llvm::Value*>, ArrayLoadCodegen>
       array_load_cache_;  // byte stream to array info
   std::unordered_map<std::string, llvm::Value*> geo_target_cache_;
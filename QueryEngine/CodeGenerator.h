@@ -135,6 +135,11 @@ class CodeGenerator {
                                                           const SQLTypeInfo& ti,
                                                           CgenState* cgen_state);
 
+  // Returns the row function argument holding the buffer of the column.
+  llvm::Value* colByteStream(const Analyzer::ColumnVar* col_var,
+                             const bool fetch_column,
+                             const bool hoist_literals);
+
  private:
   std::vector<llvm::Value*> codegen(const Analyzer::Constant*,
                                     const EncodingType enc_type,
@@ -275,6 +280,12 @@ class CodeGenerator {
                                         llvm::Value* col_byte_stream,
                                         llvm::Value* pos_arg);
 
+  // Loads a FIXED or DATE IN DAYS encoded column as the narrow integer it is stored as,
+  // null stays the null sentinel of the encoding. Returns nullptr if the column has to go
+  // through codegenColVar(), e.g. because it is already fetched or fetched lazily.
+  llvm::Value* codegenEncodedColVar(const Analyzer::ColumnVar* col_var,
+                                    const CompilationOptions& co);
+
   // Generates code for a fixed length column when a window function is active.
   llvm::Value* codegenFixedLengthColVarInWindow(const Analyzer::ColumnVar* col_var,
                                                 llvm::Value* col_byte_stream,
@@ -386,6 +397,10 @@ class CodeGenerator {
                                                        const SQLTypeInfo&,
                                                        const DatetruncField&);
 
+  // Returns the truncated value as a constant if the range of the argument truncates to
+  // a single value, nullptr otherwise.
+  llvm::Value* codegenFoldedDateTrunc(const Analyzer::DatetruncExpr*, llvm::Value*);
+
   llvm::Value* codegenCmpDecimalConst(const SQLOps,
                                       const SQLQualifier,
                                       const Analyzer::Expr*,
@@ -393,6 +408,13 @@ class CodeGenerator {
                                       const Analyzer::Expr*,
                                       const CompilationOptions&);
 
+  llvm::Value* codegenCmpEncodedConst(const SQLOps,
+                                      const SQLQualifier,
+                                      const Analyzer::Expr*,
+                                      const SQLTypeInfo&,
+                                      const Analyzer::Expr*,
+                                      const CompilationOptions&);
+
   llvm::Value* codegenOverlaps(const SQLOps,
                                const SQLQualifier,
                                const std::shared_ptr<Analyzer::Expr>,
@@ -437,10 +459,6 @@ class CodeGenerator {
 
   llvm::Value* resolveGroupedColumnReference(const Analyzer::ColumnVar*);
 
-  llvm::Value* colByteStream(const Analyzer::ColumnVar* col_var,
-                             const bool fetch_column,
-                             const bool hoist_literals);
-
   std::shared_ptr<const Analyzer::Expr> hashJoinLhs(const Analyzer::ColumnVar* rhs) const;
 
   std::shared_ptr<const Analyzer::ColumnVar> hashJoinLhsTuple(
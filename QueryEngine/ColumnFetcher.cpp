@@ -17,10 +17,13 @@
 #include "QueryEngine/ColumnFetcher.h"
 
 #include <memory>
+#include <numeric>
+#include <optional>
 
 #include "DataMgr/ArrayNoneEncoder.h"
 #include "QueryEngine/ErrorHandling.h"
 #include "QueryEngine/Execute.h"
+#include "QueryEngine/LinearizedColumnCache.h"
 #include "Shared/Intervals.h"
 #include "Shared/likely.h"
 #include "Shared/sqltypes.h"
@@ -43,6 +46,35 @@ inline const ColumnarResults* columnarize_result(
       row_set_mem_owner, *result, result->colCount(), col_types, thread_idx);
 }
 
+// Returns the key of the column in the linearized column cache, or std::nullopt if the
+// column can't be cached. Loads change the fragments of the table and its epoch.
+std::optional<LinearizedColumnCache::Key> get_linearized_column_cache_key(
+    const int table_id,
+    const int col_id,
+    const TableFragments& fragments,
+    const Catalog_Namespace::Catalog* catalog) {
+  if (!g_linearized_column_cache_max_bytes || !catalog || table_id <= 0) {
+    return std::nullopt;
+  }
+  const auto td = catalog->getMetadataForTable(table_id, false);
+  // Foreign tables change without going through the server.
+  if (!td || td->isForeignTable()) {
+    return std::nullopt;
+  }
+  size_t table_state = 0;
+  if (td->persistenceLevel == Data_Namespace::MemoryLevel::DISK_LEVEL) {
+    boost::hash_combine(
+        table_state,
+        catalog->getDataMgr().getTableEpoch(catalog->getDatabaseId(), table_id));
+  }
+  for (const auto& fragment : fragments) {
+    boost::hash_combine(table_state, fragment.fragmentId);
+    boost::hash_combine(table_state, fragment.getNumTuples());
+  }
+  return LinearizedColumnCache::Key{
+      catalog->getDatabaseId(), table_id, col_id, table_state};
+}
+
 std::string getMemoryLevelString(Data_Namespace::MemoryLevel memoryLevel) {
   switch (memoryLevel) {
     case DISK_LEVEL:
@@ -298,6 +330,19 @@ const int8_t* ColumnFetcher::getAllTableColumnFragments(
   {
     std::lock_guard<std::mutex> columnar_conversion_guard(columnar_fetch_mutex_);
     auto column_it = columnarized_scan_table_cache_.find(col_desc);
+    std::optional<LinearizedColumnCache::Key> cache_key;
+    if (column_it == columnarized_scan_table_cache_.end()) {
+      cache_key = get_linearized_column_cache_key(
+          table_id, col_id, *fragments, executor_->getCatalog());
+    }
+    std::shared_ptr<const ColumnarResults> cached_column;
+    if (cache_key) {
+      cached_column = LinearizedColumnCache::instance().get(*cache_key);
+      if (cached_column) {
+        VLOG(1) << "Reusing the linearized column " << col_id << " of table " << table_id;
+        column_it = columnarized_scan_table_cache_.emplace(col_desc, cached_column).first;
+      }
+    }
     if (column_it == columnarized_scan_table_cache_.end()) {
       for (size_t frag_id = 0; frag_id < frag_count; ++frag_id) {
         if (g_enable_non_kernel_time_query_interrupt && check_interrupt()) {
@@ -327,10 +372,36 @@ const int8_t* ColumnFetcher::getAllTableColumnFragments(
                                               chunk_meta_it->second->sqlType,
                                               thread_idx));
       }
-      auto merged_results =
-          ColumnarResults::mergeResults(executor_->row_set_mem_owner_, column_frags);
-      table_column = merged_results.get();
-      columnarized_scan_table_cache_.emplace(col_desc, std::move(merged_results));
+      if (cache_key) {
+        const auto size_bytes = std::accumulate(
+            column_frags.begin(),
+            column_frags.end(),
+            size_t(0),
+            [](const size_t init, const std::unique_ptr<ColumnarResults>& column_frag) {
+              return init +
+                     column_frag->size() * column_frag->getColumnType(0).get_size();
+            });
+        if (size_bytes && size_bytes <= g_linearized_column_cache_max_bytes) {
+          // The merged column outlives the query, so it gets its own memory owner.
+          auto row_set_mem_owner =
+              std::make_shared<RowSetMemoryOwner>(size_bytes + kArenaBlockOverhead);
+          auto merged_results =
+              ColumnarResults::mergeResults(row_set_mem_owner, column_frags);
+          if (merged_results) {
+            cached_column = LinearizedColumnCache::instance().put(
+                *cache_key, row_set_mem_owner, std::move(merged_results), size_bytes);
+          }
+        }
+      }
+      if (cached_column) {
+        table_column = cached_column.get();
+        columnarized_scan_table_cache_.emplace(col_desc, std::move(cached_column));
+      } else {
+        auto merged_results =
+            ColumnarResults::mergeResults(executor_->row_set_mem_owner_, column_frags);
+        table_column = merged_results.get();
+        columnarized_scan_table_cache_.emplace(col_desc, std::move(merged_results));
+      }
     } else {
       table_column = column_it->second.get();
     }
@@ -184,7 +184,7 @@ class ColumnFetcher {
   mutable std::mutex chunk_list_mutex_;
   mutable std::mutex linearized_col_cache_mutex_;
   mutable ColumnCacheMap columnarized_table_cache_;
-  mutable std::unordered_map<InputColDescriptor, std::unique_ptr<const ColumnarResults>>
+  mutable std::unordered_map<InputColDescriptor, std::shared_ptr<const ColumnarResults>>
       columnarized_scan_table_cache_;
   using DeviceMergedChunkIterMap = std::unordered_map<int, int8_t*>;
   using DeviceMergedChunkMap = std::unordered_map<int, AbstractBuffer*>;
@@ -273,6 +273,37 @@ llvm::Value* CodeGenerator::codegenFixedLengthColVar(const Analyzer::ColumnVar*
   return dec_val_cast;
 }
 
+llvm::Value* CodeGenerator::codegenEncodedColVar(const Analyzer::ColumnVar* col_var,
+                                                 const CompilationOptions& co) {
+  AUTOMATIC_IR_METADATA(cgen_state_);
+  const auto& col_ti = col_var->get_type_info();
+  size_t byte_width{0};
+  if (col_ti.get_compression() == kENCODING_FIXED) {
+    byte_width = col_ti.get_comp_param() / 8;
+  } else if (col_ti.get_compression() == kENCODING_DATE_IN_DAYS) {
+    byte_width = col_ti.get_comp_param() == 16 ? 2 : 4;
+  } else {
+    return nullptr;
+  }
+  if (col_var->get_rte_idx() > 0 ||
+      WindowProjectNodeContext::getActiveWindowFunctionContext(executor()) ||
+      resolveGroupedColumnReference(col_var) || hashJoinLhs(col_var)) {
+    return nullptr;
+  }
+  const int local_col_id = plan_state_->getLocalColumnId(col_var, true);
+  if (cgen_state_->fetch_cache_.count(local_col_id) ||
+      plan_state_->isLazyFetchColumn(col_var)) {
+    return nullptr;
+  }
+  auto pos_arg = posArg(col_var);
+  auto col_byte_stream = colByteStream(col_var, true, co.hoist_literals);
+  FixedWidthInt decoder(byte_width);
+  auto dec_val = decoder.codegenDecode(col_byte_stream, pos_arg, cgen_state_->module_);
+  cgen_state_->ir_builder_.Insert(dec_val);
+  return cgen_state_->ir_builder_.CreateTrunc(
+      dec_val, get_int_type(byte_width * 8, cgen_state_->context_));
+}
+
 llvm::Value* CodeGenerator::codegenFixedLengthColVarInWindow(
     const Analyzer::ColumnVar* col_var,
     llvm::Value* col_byte_stream,
@@ -549,6 +580,9 @@ const Analyzer::Expr* remove_cast_to_int(const Analyzer::Expr* expr) {
 std::shared_ptr<const Analyzer::Expr> CodeGenerator::hashJoinLhs(
     const Analyzer::ColumnVar* rhs) const {
   for (const auto& tautological_eq : plan_state_->join_info_.equi_join_tautologies_) {
+    if (!tautological_eq) {
+      continue;
+    }
     CHECK(IS_EQUIVALENCE(tautological_eq->get_optype()));
     if (dynamic_cast<const Analyzer::ExpressionTuple*>(
             tautological_eq->get_left_operand())) {
@@ -152,58 +152,69 @@ std::unique_ptr<ColumnarResults> ColumnarResults::mergeResults(
 /**
  * This function iterates through the result set (using the getRowAtNoTranslation and
  * getNextRow family of functions) and writes back the results into output column buffers.
+ *
+ * The parallel conversion splits the entries into one range per thread. A first pass
+ * counts the non-empty entries of each range, so that every thread then writes its rows
+ * from its own cursor, which keeps the rows in the order of the result set and avoids
+ * contending on a shared output index.
  */
 void ColumnarResults::materializeAllColumnsThroughIteration(const ResultSet& rows,
                                                             const size_t num_columns) {
   std::atomic<size_t> row_idx{0};
   if (isParallelConversion()) {
     const size_t worker_count = cpu_threads();
-    std::vector<std::future<void>> conversion_threads;
-    const auto do_work = [num_columns, &rows, &row_idx, this](const size_t i) {
-      const auto crt_row = rows.getRowAtNoTranslations(i);
-      if (!crt_row.empty()) {
-        auto cur_row_idx = row_idx.fetch_add(1);
-        for (size_t col_idx = 0; col_idx < num_columns; ++col_idx) {
-          writeBackCell(crt_row[col_idx], cur_row_idx, col_idx);
-        }
-      }
-    };
+    std::vector<Interval<size_t>> intervals;
     for (auto interval : makeIntervals(size_t(0), rows.entryCount(), worker_count)) {
-      conversion_threads.push_back(std::async(
-          std::launch::async,
-          [&do_work](const size_t start, const size_t end) {
-            if (g_enable_non_kernel_time_query_interrupt) {
-              size_t local_idx = 0;
-              for (size_t i = start; i < end; ++i, ++local_idx) {
-                if (UNLIKELY((local_idx & 0xFFFF) == 0 && check_interrupt())) {
+      intervals.push_back(interval);
+    }
+    const auto run_on_intervals = [&intervals](const auto& range_work) {
+      std::vector<std::future<void>> conversion_threads;
+      for (size_t interval_idx = 0; interval_idx < intervals.size(); ++interval_idx) {
+        conversion_threads.push_back(std::async(
+            std::launch::async,
+            [&range_work, &intervals, interval_idx] {
+              const auto& interval = intervals[interval_idx];
+              for (size_t i = interval.begin; i < interval.end; ++i) {
+                if (g_enable_non_kernel_time_query_interrupt &&
+                    UNLIKELY(((i - interval.begin) & 0xFFFF) == 0 && check_interrupt())) {
                   throw QueryExecutionError(Executor::ERR_INTERRUPTED);
                 }
-                do_work(i);
+                range_work(interval_idx, i);
               }
-            } else {
-              for (size_t i = start; i < end; ++i) {
-                do_work(i);
-              }
-            }
-          },
-          interval.begin,
-          interval.end));
-    }
-
-    try {
+            }));
+      }
       for (auto& child : conversion_threads) {
         child.wait();
       }
-    } catch (QueryExecutionError& e) {
-      if (e.getErrorCode() == Executor::ERR_INTERRUPTED) {
-        throw QueryExecutionError(Executor::ERR_INTERRUPTED);
+      for (auto& child : conversion_threads) {
+        child.get();
       }
-      throw e;
-    } catch (...) {
-      throw;
+    };
+
+    std::vector<size_t> write_cursors(intervals.size(), 0);
+    run_on_intervals([&rows, &write_cursors](const size_t interval_idx, const size_t i) {
+      if (!rows.isRowAtEmpty(i)) {
+        ++write_cursors[interval_idx];
+      }
+    });
+    size_t total_row_count = 0;
+    for (auto& write_cursor : write_cursors) {
+      const auto interval_row_count = write_cursor;
+      write_cursor = total_row_count;
+      total_row_count += interval_row_count;
     }
+    run_on_intervals([num_columns, &rows, &write_cursors, this](const size_t interval_idx,
+                                                                const size_t i) {
+      const auto crt_row = rows.getRowAtNoTranslations(i);
+      if (!crt_row.empty()) {
+        const auto cur_row_idx = write_cursors[interval_idx]++;
+        for (size_t col_idx = 0; col_idx < num_columns; ++col_idx) {
+          writeBackCell(crt_row[col_idx], cur_row_idx, col_idx);
+        }
+      }
+    });
 
-    num_rows_ = row_idx;
+    num_rows_ = total_row_count;
     rows.setCachedRowCount(num_rows_);
     return;
   }
@@ -16,6 +16,7 @@
 
 #include "CodeGenerator.h"
 #include "Execute.h"
+#include "ExtractFromTime.h"
 
 #include <typeinfo>
 
@@ -278,6 +279,14 @@ llvm::Value* CodeGenerator::codegenCmp(const Analyzer::BinOper* bin_oper,
       return cmp_decimal_const;
     }
   }
+  if (lhs_ti.get_compression() == kENCODING_FIXED ||
+      lhs_ti.get_compression() == kENCODING_DATE_IN_DAYS) {
+    auto cmp_encoded_const =
+        codegenCmpEncodedConst(optype, qualifier, lhs, lhs_ti, rhs, co);
+    if (cmp_encoded_const) {
+      return cmp_encoded_const;
+    }
+  }
   auto lhs_lvs = codegen(lhs, true, co);
   return codegenCmp(optype, qualifier, lhs_lvs, lhs_ti, rhs, co);
 }
@@ -446,6 +455,74 @@ llvm::Value* CodeGenerator::codegenCmpDecimalConst(const SQLOps optype,
   return codegenCmp(optype, qualifier, {lhs_lv}, new_ti, new_rhs_lit.get(), co);
 }
 
+// Compares a FIXED or DATE IN DAYS encoded column to a literal converted to the encoded
+// domain once, so that the rows are compared as stored instead of being widened and
+// having their null sentinel replaced first.
+llvm::Value* CodeGenerator::codegenCmpEncodedConst(const SQLOps optype,
+                                                   const SQLQualifier qualifier,
+                                                   const Analyzer::Expr* lhs,
+                                                   const SQLTypeInfo& lhs_ti,
+                                                   const Analyzer::Expr* rhs,
+                                                   const CompilationOptions& co) {
+  AUTOMATIC_IR_METADATA(cgen_state_);
+  const auto col_var = dynamic_cast<const Analyzer::ColumnVar*>(lhs);
+  const auto rhs_constant = dynamic_cast<const Analyzer::Constant*>(rhs);
+  if (!col_var || !rhs_constant || rhs_constant->get_is_null() || qualifier != kONE ||
+      lhs_ti.get_type() != rhs->get_type_info().get_type()) {
+    return nullptr;
+  }
+  int64_t encoded_val{0};
+  size_t byte_width{0};
+  if (lhs_ti.get_compression() == kENCODING_FIXED && lhs_ti.is_integer()) {
+    encoded_val = extract_from_datum(rhs_constant->get_constval(), lhs_ti);
+    byte_width = lhs_ti.get_comp_param() / 8;
+  } else if (lhs_ti.get_compression() == kENCODING_DATE_IN_DAYS) {
+    const auto epoch_seconds = rhs_constant->get_constval().bigintval;
+    if (epoch_seconds % kSecsPerDay) {
+      return nullptr;
+    }
+    encoded_val = epoch_seconds / kSecsPerDay;
+    byte_width = lhs_ti.get_comp_param() == 16 ? 2 : 4;
+  } else {
+    return nullptr;
+  }
+  // The minimum of the narrow type is the null sentinel of the encoding.
+  const int64_t encoded_max = (int64_t(1) << (byte_width * 8 - 1)) - 1;
+  if (encoded_val < -encoded_max || encoded_val > encoded_max) {
+    return nullptr;
+  }
+  Datum d;
+  SQLTypes encoded_type;
+  switch (byte_width) {
+    case 1:
+      encoded_type = kTINYINT;
+      d.tinyintval = encoded_val;
+      break;
+    case 2:
+      encoded_type = kSMALLINT;
+      d.smallintval = encoded_val;
+      break;
+    case 4:
+      encoded_type = kINT;
+      d.intval = encoded_val;
+      break;
+    default:
+      return nullptr;
+  }
+  const auto lhs_lv = codegenEncodedColVar(col_var, co);
+  if (!lhs_lv) {
+    return nullptr;
+  }
+  const auto encoded_rhs_lit =
+      makeExpr<Analyzer::Constant>(SQLTypeInfo(encoded_type, true), false, d);
+  return codegenCmp(optype,
+                    qualifier,
+                    {lhs_lv},
+                    SQLTypeInfo(encoded_type, lhs_ti.get_notnull()),
+                    encoded_rhs_lit.get(),
+                    co);
+}
+
 llvm::Value* CodeGenerator::codegenCmp(const SQLOps optype,
                                        const SQLQualifier qualifier,
                                        std::vector<llvm::Value*> lhs_lvs,
@@ -20,7 +20,10 @@
 #include <llvm/ExecutionEngine/JITEventListener.h>
 #include <llvm/IR/Module.h>
 
+#include <atomic>
 #include <memory>
+#include <string>
+#include <vector>
 
 class CompilationContext {
  public:
@@ -70,7 +73,26 @@ class CpuCompilationContext : public CompilationContext {
 
   void* func() const { return func_; }
 
+  // Code built without backend optimizations because of a small input keeps what is
+  // needed to compile it again at the full tier once it is reused often enough.
+  struct LowTierInfo {
+    // Copy of the module taken after the runtime modules, GEOS included, were linked
+    // into it and before the low tier passes ran.
+    std::unique_ptr<llvm::Module> module;
+    std::string query_func_name;
+    std::string multifrag_query_func_name;
+    std::vector<std::string> live_func_names;
+    std::atomic<size_t> reuse_count{0};
+  };
+
+  void setLowTierInfo(std::unique_ptr<LowTierInfo> low_tier_info) {
+    low_tier_info_ = std::move(low_tier_info);
+  }
+
+  LowTierInfo* lowTierInfo() const { return low_tier_info_.get(); }
+
  private:
   void* func_{nullptr};
   ExecutionEngineWrapper execution_engine_;
+  std::unique_ptr<LowTierInfo> low_tier_info_;
 };
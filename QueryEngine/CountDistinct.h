@@ -27,6 +27,7 @@
 
 #include "Descriptors/CountDistinctDescriptor.h"
 #include "HyperLogLog.h"
+#include "SparseBitmap.h"
 
 #include <bitset>
 #include <set>
@@ -93,6 +94,9 @@ inline int64_t count_distinct_set_size(
     }
     return bitmap_set_size(set_vals, count_distinct_desc.bitmapSizeBytes());
   }
+  if (count_distinct_desc.impl_type_ == CountDistinctImplType::SparseBitmap) {
+    return reinterpret_cast<SparseBitmap*>(set_handle)->size();
+  }
   CHECK(count_distinct_desc.impl_type_ == CountDistinctImplType::StdSet);
   return reinterpret_cast<std::set<int64_t>*>(set_handle)->size();
 }
@@ -141,6 +145,12 @@ inline void count_distinct_set_union(
                                       : old_count_distinct_desc.bitmapPaddedSizeBytes();
       bitmap_set_union(new_set, old_set, bitmap_byte_sz);
     }
+  } else if (new_count_distinct_desc.impl_type_ == CountDistinctImplType::SparseBitmap) {
+    CHECK(old_count_distinct_desc.impl_type_ == CountDistinctImplType::SparseBitmap);
+    auto old_set = reinterpret_cast<SparseBitmap*>(old_set_handle);
+    auto new_set = reinterpret_cast<SparseBitmap*>(new_set_handle);
+    new_set->unite(*old_set);
+    old_set->unite(*new_set);
   } else {
     CHECK(old_count_distinct_desc.impl_type_ == CountDistinctImplType::StdSet);
     auto old_set = reinterpret_cast<std::set<int64_t>*>(old_set_handle);
@@ -225,6 +225,9 @@ llvm::Value* CodeGenerator::codegen(const Analyzer::DatetruncExpr* datetrunc_exp
   const auto& datetrunc_expr_ti = datetrunc_expr->get_from_expr()->get_type_info();
   CHECK(from_expr->getType()->isIntegerTy(64));
   DatetruncField const field = datetrunc_expr->get_field();
+  if (auto folded_lv = codegenFoldedDateTrunc(datetrunc_expr, from_expr)) {
+    return folded_lv;
+  }
   if (datetrunc_expr_ti.is_high_precision_timestamp()) {
     return codegenDateTruncHighPrecisionTimestamps(from_expr, datetrunc_expr_ti, field);
   }
@@ -251,6 +254,38 @@ llvm::Value* CodeGenerator::codegen(const Analyzer::DatetruncExpr* datetrunc_exp
   return ret;
 }
 
+llvm::Value* CodeGenerator::codegenFoldedDateTrunc(
+    const Analyzer::DatetruncExpr* datetrunc_expr,
+    llvm::Value* from_expr) {
+  AUTOMATIC_IR_METADATA(cgen_state_);
+  const auto field = datetrunc_expr->get_field();
+  const auto& datetrunc_expr_ti = datetrunc_expr->get_from_expr()->get_type_info();
+  if ((dtSECOND <= field && field <= dtNANOSECOND) ||
+      datetrunc_expr_ti.get_type() != kTIMESTAMP) {
+    return nullptr;
+  }
+  CHECK(plan_state_);
+  if (!executor_ || plan_state_->query_infos_.empty()) {
+    return nullptr;
+  }
+  // The chunk metadata of the queried fragments bound the argument, if both bounds
+  // truncate to the same value then so does every row.
+  const auto expr_range =
+      getExpressionRange(datetrunc_expr, plan_state_->query_infos_, executor());
+  if (expr_range.getType() != ExpressionRangeType::Integer ||
+      expr_range.getIntMin() != expr_range.getIntMax()) {
+    return nullptr;
+  }
+  llvm::Value* ret = cgen_state_->llInt(expr_range.getIntMin());
+  if (expr_range.hasNulls() && !datetrunc_expr_ti.get_notnull()) {
+    auto is_null_lv = cgen_state_->ir_builder_.CreateICmpEQ(
+        from_expr, cgen_state_->inlineIntNull(datetrunc_expr_ti));
+    ret = cgen_state_->ir_builder_.CreateSelect(
+        is_null_lv, ll_int(NULL_BIGINT, cgen_state_->context_), ret);
+  }
+  return ret;
+}
+
 llvm::Value* CodeGenerator::codegenExtractHighPrecisionTimestamps(
     llvm::Value* ts_lv,
     const SQLTypeInfo& ti,
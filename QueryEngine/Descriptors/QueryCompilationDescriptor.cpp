@@ -35,6 +35,7 @@ std::unique_ptr<QueryMemoryDescriptor> QueryCompilationDescriptor::compile(
   CHECK(executor);
   std::unique_ptr<QueryMemoryDescriptor> query_mem_desc;
   const auto cat = executor->getCatalog();
+  const auto clock_begin = timer_start();
   try {
     std::tie(compilation_result_, query_mem_desc) = executor->compileWorkUnit(
         table_infos,
@@ -70,6 +71,10 @@ std::unique_ptr<QueryMemoryDescriptor> QueryCompilationDescriptor::compile(
                                   column_fetcher.columnarized_table_cache_,
                                   render_info);
   }
+  if (auto query_profile = executor->getQueryProfile()) {
+    query_profile->addCompilationTime(
+        timer_stop<decltype(clock_begin), std::chrono::microseconds>(clock_begin));
+  }
   actual_min_byte_width_ =
       std::max(query_mem_desc->updateActualMinByteWidth(MAX_BYTE_WIDTH_SUPPORTED),
                crt_min_byte_width);
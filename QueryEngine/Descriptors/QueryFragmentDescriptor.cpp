@@ -154,9 +154,18 @@ void QueryFragmentDescriptor::buildFragmentPerKernelForTable(
     const auto& fragment = (*fragments)[i];
     const auto skip_frag = executor->skipFragment(
         table_desc, fragment, ra_exe_unit.simple_quals, frag_offsets, i);
-    if (skip_frag.first) {
+    if (skip_frag.first ||
+        executor->skipFragmentJoinKeyRange(table_desc, fragment, frag_offsets, i)) {
       continue;
     }
+    if (ra_exe_unit.input_descs.size() == 1 && table_desc.getTableId() > 0) {
+      // The block zone maps may rule out every row which the fragment stats don't.
+      const auto [begin, end] =
+          executor->getFragmentCandidateRowRange(table_desc, fragment, ra_exe_unit);
+      if (begin >= end) {
+        continue;
+      }
+    }
     rowid_lookup_key_ = std::max(rowid_lookup_key_, skip_frag.second);
     const int chosen_device_count =
         device_type == ExecutorDeviceType::CPU ? 1 : device_count;
@@ -387,9 +396,19 @@ void QueryFragmentDescriptor::buildMultifragKernelMap(
       skip_frag = executor->skipFragmentInnerJoins(
           outer_table_desc, ra_exe_unit, fragment, frag_offsets, outer_frag_id);
     }
-    if (skip_frag.first) {
+    if (skip_frag.first || executor->skipFragmentJoinKeyRange(outer_table_desc,
+                                                              fragment,
+                                                              frag_offsets,
+                                                              outer_frag_id)) {
       continue;
     }
+    if (ra_exe_unit.input_descs.size() == 1 && outer_table_id > 0) {
+      const auto [begin, end] = executor->getFragmentCandidateRowRange(
+          outer_table_desc, fragment, ra_exe_unit);
+      if (begin >= end) {
+        continue;
+      }
+    }
     const int device_id =
         fragment.shard == -1
             ? fragment.deviceIds[static_cast<int>(Data_Namespace::GPU_LEVEL)]
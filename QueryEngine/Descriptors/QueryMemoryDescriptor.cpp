@@ -26,6 +26,7 @@
 #include <boost/algorithm/cxx11/any_of.hpp>
 
 bool g_enable_smem_group_by{true};
+size_t g_streaming_topn_max{100000};
 extern bool g_enable_columnar_output;
 
 namespace {
@@ -59,14 +60,19 @@ std::vector<int64_t> target_expr_group_by_indices(
   return indices;
 }
 
+// Lazily fetched columns of the outer table read their row id from the index of the
+// projected entry instead of a slot of their own, so a wide projection under a sort or a
+// join only carries one row id per row until its surviving rows are decoded. The lazily
+// fetched columns of the inner tables keep a row id slot, the index holds the outer one.
 std::vector<int64_t> target_expr_proj_indices(const RelAlgExecutionUnit& ra_exe_unit,
+                                              const bool streaming_top_n,
                                               const Catalog_Namespace::Catalog& cat) {
-  if (ra_exe_unit.input_descs.size() > 1 ||
-      !ra_exe_unit.sort_info.order_entries.empty()) {
+  if (ra_exe_unit.union_all || streaming_top_n) {
     return {};
   }
   std::vector<int64_t> target_indices(ra_exe_unit.target_exprs.size(), -1);
   UsedColumnsVisitor columns_visitor;
+  // Column ids of every table, which only makes joins share the index less often.
   std::unordered_set<int> used_columns;
   for (const auto& simple_qual : ra_exe_unit.simple_quals) {
     const auto crt_used_columns = columns_visitor.visit(simple_qual.get());
@@ -76,6 +82,12 @@ std::vector<int64_t> target_expr_proj_indices(const RelAlgExecutionUnit& ra_exe_
     const auto crt_used_columns = columns_visitor.visit(qual.get());
     used_columns.insert(crt_used_columns.begin(), crt_used_columns.end());
   }
+  for (const auto& join_condition : ra_exe_unit.join_quals) {
+    for (const auto& qual : join_condition.quals) {
+      const auto crt_used_columns = columns_visitor.visit(qual.get());
+      used_columns.insert(crt_used_columns.begin(), crt_used_columns.end());
+    }
+  }
   for (const auto& target : ra_exe_unit.target_exprs) {
     const auto col_var = dynamic_cast<const Analyzer::ColumnVar*>(target);
     if (col_var) {
@@ -98,7 +110,7 @@ std::vector<int64_t> target_expr_proj_indices(const RelAlgExecutionUnit& ra_exe_
       continue;
     }
     const auto col_var = dynamic_cast<const Analyzer::ColumnVar*>(target_expr);
-    if (!col_var) {
+    if (!col_var || col_var->get_rte_idx() > 0) {
       continue;
     }
     if (!ti.is_varlen() &&
@@ -171,9 +183,11 @@ bool use_streaming_top_n(const RelAlgExecutionUnit& ra_exe_unit,
              ra_exe_unit.target_exprs.size());
     const auto order_entry_expr = ra_exe_unit.target_exprs[only_order_entry.tle_no - 1];
     const auto n = ra_exe_unit.sort_info.offset + ra_exe_unit.sort_info.limit;
+    // The heaps are sized to the GPU slab later on, which disables streaming top n if
+    // they don't fit.
     if ((order_entry_expr->get_type_info().is_number() ||
          order_entry_expr->get_type_info().is_time()) &&
-        n <= 100000) {  // TODO(miyu): relax?
+        n <= g_streaming_topn_max) {
       return true;
     }
   }
@@ -399,9 +413,10 @@ std::unique_ptr<QueryMemoryDescriptor> QueryMemoryDescriptor::init(
 
       const auto catalog = executor->getCatalog();
       CHECK(catalog);
-      target_groupby_indices = executor->plan_state_->allow_lazy_fetch_
-                                   ? target_expr_proj_indices(ra_exe_unit, *catalog)
-                                   : std::vector<int64_t>{};
+      target_groupby_indices =
+          executor->plan_state_->allow_lazy_fetch_
+              ? target_expr_proj_indices(ra_exe_unit, streaming_top_n, *catalog)
+              : std::vector<int64_t>{};
 
       col_slot_context = ColSlotContext(ra_exe_unit.target_exprs, target_groupby_indices);
       break;
@@ -482,6 +497,7 @@ QueryMemoryDescriptor::QueryMemoryDescriptor(
     , is_table_function_(false)
     , use_streaming_top_n_(use_streaming_top_n)
     , force_4byte_float_(false)
+    , use_shared_cpu_group_by_buffer_(false)
     , col_slot_context_(col_slot_context) {
   col_slot_context_.setAllUnsetSlotsPaddedSize(8);
   col_slot_context_.validate();
@@ -557,7 +573,8 @@ QueryMemoryDescriptor::QueryMemoryDescriptor()
     , must_use_baseline_sort_(false)
     , is_table_function_(false)
     , use_streaming_top_n_(false)
-    , force_4byte_float_(false) {}
+    , force_4byte_float_(false)
+    , use_shared_cpu_group_by_buffer_(false) {}
 
 QueryMemoryDescriptor::QueryMemoryDescriptor(const Executor* executor,
                                              const size_t entry_count,
@@ -581,7 +598,8 @@ QueryMemoryDescriptor::QueryMemoryDescriptor(const Executor* executor,
     , must_use_baseline_sort_(false)
     , is_table_function_(is_table_function)
     , use_streaming_top_n_(false)
-    , force_4byte_float_(false) {}
+    , force_4byte_float_(false)
+    , use_shared_cpu_group_by_buffer_(false) {}
 
 QueryMemoryDescriptor::QueryMemoryDescriptor(const QueryDescriptionType query_desc_type,
                                              const int64_t min_val,
@@ -607,7 +625,8 @@ QueryMemoryDescriptor::QueryMemoryDescriptor(const QueryDescriptionType query_de
     , must_use_baseline_sort_(false)
     , is_table_function_(false)
     , use_streaming_top_n_(false)
-    , force_4byte_float_(false) {}
+    , force_4byte_float_(false)
+    , use_shared_cpu_group_by_buffer_(false) {}
 
 bool QueryMemoryDescriptor::operator==(const QueryMemoryDescriptor& other) const {
   // Note that this method does not check ptr reference members (e.g. executor_) or
@@ -627,6 +646,9 @@ bool QueryMemoryDescriptor::operator==(const QueryMemoryDescriptor& other) const
   if (force_4byte_float_ != other.force_4byte_float_) {
     return false;
   }
+  if (use_shared_cpu_group_by_buffer_ != other.use_shared_cpu_group_by_buffer_) {
+    return false;
+  }
   if (group_col_widths_ != other.group_col_widths_) {
     return false;
   }
@@ -686,6 +708,7 @@ std::unique_ptr<QueryExecutionContext> QueryMemoryDescriptor::getQueryExecutionC
     const bool output_columnar,
     const bool sort_on_gpu,
     const size_t thread_idx,
+    SharedCpuGroupByBuffer* shared_cpu_group_by_buffer,
     RenderInfo* render_info) const {
   auto timer = DEBUG_TIMER(__func__);
   if (frag_offsets.empty()) {
@@ -705,6 +728,7 @@ std::unique_ptr<QueryExecutionContext> QueryMemoryDescriptor::getQueryExecutionC
                                 output_columnar,
                                 sort_on_gpu,
                                 thread_idx,
+                                shared_cpu_group_by_buffer,
                                 render_info));
 }
 
@@ -1209,6 +1233,8 @@ std::string QueryMemoryDescriptor::toString() const {
   str += "\tOutput Columnar: " + ::toString(output_columnar_) + "\n";
   str += "\tRender Output: " + ::toString(render_output_) + "\n";
   str += "\tUse Baseline Sort: " + ::toString(must_use_baseline_sort_) + "\n";
+  str += "\tShared CPU Group By Buffer: " + ::toString(use_shared_cpu_group_by_buffer_) +
+         "\n";
   str += "\tIs Table Function: " + ::toString(is_table_function_) + "\n";
   return str;
 }
@@ -50,6 +50,7 @@ class Executor;
 class QueryExecutionContext;
 class RenderInfo;
 class RowSetMemoryOwner;
+class SharedCpuGroupByBuffer;
 struct InputTableInfo;
 struct RelAlgExecutionUnit;
 class TResultSetBufferDescriptor;
@@ -138,6 +139,7 @@ class QueryMemoryDescriptor {
       const bool output_columnar,
       const bool sort_on_gpu,
       const size_t thread_idx,
+      SharedCpuGroupByBuffer* shared_cpu_group_by_buffer,
       RenderInfo*) const;
 
   static bool many_entries(const int64_t max_val,
@@ -276,6 +278,13 @@ class QueryMemoryDescriptor {
   bool forceFourByteFloat() const { return force_4byte_float_; }
   void setForceFourByteFloat(const bool val) { force_4byte_float_ = val; }
 
+  // All the CPU kernels of the query insert into a single group by buffer, using the
+  // atomic variants of the runtime functions. Only set for baseline hash group by.
+  bool useSharedCpuGroupByBuffer() const { return use_shared_cpu_group_by_buffer_; }
+  void setUseSharedCpuGroupByBuffer(const bool val) {
+    use_shared_cpu_group_by_buffer_ = val;
+  }
+
   // Getters derived from state
   size_t getGroupbyColCount() const { return group_col_widths_.size(); }
   size_t getKeyCount() const { return keyless_hash_ ? 0 : getGroupbyColCount(); }
@@ -376,6 +385,7 @@ class QueryMemoryDescriptor {
   bool use_streaming_top_n_;
 
   bool force_4byte_float_;
+  bool use_shared_cpu_group_by_buffer_;
 
   ColSlotContext col_slot_context_;
 
@@ -94,6 +94,7 @@ ExecutionResult& ExecutionResult::operator=(const ExecutionResult& that) {
   success_ = that.success_;
   execution_time_ms_ = that.execution_time_ms_;
   type_ = that.type_;
+  query_profile_info_ = that.query_profile_info_;
   return *this;
 }
 
@@ -25,6 +25,7 @@
 #include "Shared/toString.h"
 
 class ResultSet;
+struct QueryProfileInfo;
 
 class ExecutionResult {
  public:
@@ -79,6 +80,12 @@ class ExecutionResult {
   void addExecutionTime(int64_t execution_time_ms) {
     execution_time_ms_ += execution_time_ms;
   }
+  const std::shared_ptr<const QueryProfileInfo>& getQueryProfileInfo() const {
+    return query_profile_info_;
+  }
+  void setQueryProfileInfo(std::shared_ptr<const QueryProfileInfo> query_profile_info) {
+    query_profile_info_ = std::move(query_profile_info);
+  }
 
  private:
   ResultSetPtr result_;
@@ -91,6 +98,7 @@ class ExecutionResult {
   bool success_;
   uint64_t execution_time_ms_;
   RType type_;
+  std::shared_ptr<const QueryProfileInfo> query_profile_info_;
 };
 
 class RelAlgNode;
@@ -17,7 +17,6 @@
 #pragma once
 
 #include <boost/noncopyable.hpp>
-#include <list>
 #include <memory>
 #include <mutex>
 #include <set>
@@ -29,6 +28,7 @@
 #include "DataMgr/Allocators/ArenaAllocator.h"
 #include "DataMgr/DataMgr.h"
 #include "Logger/Logger.h"
+#include "QueryEngine/SparseBitmap.h"
 #include "QueryEngine/StringDictionaryGenerations.h"
 #include "Shared/quantile.h"
 #include "StringDictionary/StringDictionaryProxy.h"
@@ -57,6 +57,7 @@ class RowSetMemoryOwner final : public SimpleAllocator, boost::noncopyable {
     CHECK_LT(thread_idx, allocators_.size());
     auto allocator = allocators_[thread_idx].get();
     std::lock_guard<std::mutex> lock(state_mutex_);
+    chargeMemoryBudget(num_bytes);
     return reinterpret_cast<int8_t*>(allocator->allocate(num_bytes));
   }
 
@@ -65,6 +66,7 @@ class RowSetMemoryOwner final : public SimpleAllocator, boost::noncopyable {
     CHECK_LT(thread_idx, allocators_.size());
     auto allocator = allocators_[thread_idx].get();
     std::lock_guard<std::mutex> lock(state_mutex_);
+    chargeMemoryBudget(num_bytes);
     auto ret = reinterpret_cast<int8_t*>(allocator->allocateAndZero(num_bytes));
     count_distinct_bitmaps_.emplace_back(
         CountDistinctBitmapBuffer{ret, num_bytes, /*physical_buffer=*/true});
@@ -79,14 +81,40 @@ class RowSetMemoryOwner final : public SimpleAllocator, boost::noncopyable {
         CountDistinctBitmapBuffer{count_distinct_buffer, bytes, physical_buffer});
   }
 
-  void addCountDistinctSet(std::set<int64_t>* count_distinct_set) {
+  std::set<int64_t>* allocateCountDistinctSet(const size_t thread_idx = 0) {
     std::lock_guard<std::mutex> lock(state_mutex_);
-    count_distinct_sets_.push_back(count_distinct_set);
+    return construct<std::set<int64_t>>(count_distinct_sets_, thread_idx);
   }
 
-  void addGroupByBuffer(int64_t* group_by_buffer) {
+  void addCountDistinctSparseBitmap(SparseBitmap* count_distinct_sparse_bitmap) {
     std::lock_guard<std::mutex> lock(state_mutex_);
+    count_distinct_sparse_bitmaps_.push_back(count_distinct_sparse_bitmap);
+  }
+
+  // calloc() rather than the arena, which maps large buffers to zero pages.
+  int64_t* allocateZeroedGroupByBuffer(const size_t num_bytes) {
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    chargeMemoryBudget(num_bytes);
+    auto group_by_buffer = reinterpret_cast<int64_t*>(checked_calloc(num_bytes, 1));
     group_by_buffers_.push_back(group_by_buffer);
+    return group_by_buffer;
+  }
+
+  /**
+   * Limits the bytes allocated through the buffer allocation calls from now on, 0 for no
+   * limit. Going over the budget throws OutOfHostMemory, which the executor handles as
+   * running out of CPU memory.
+   */
+  void setMemoryBudget(const size_t memory_budget) {
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    memory_budget_ = memory_budget;
+    memory_budget_used_ = 0;
+  }
+
+  // Gives the full budget again, to a new pass over the same step.
+  void resetMemoryBudgetUsage() {
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    memory_budget_used_ = 0;
   }
 
   void addVarlenBuffer(void* varlen_buffer) {
@@ -105,16 +133,15 @@ class RowSetMemoryOwner final : public SimpleAllocator, boost::noncopyable {
     varlen_input_buffers_.push_back(buffer);
   }
 
-  std::string* addString(const std::string& str) {
+  std::string* addString(const std::string& str, const size_t thread_idx = 0) {
     std::lock_guard<std::mutex> lock(state_mutex_);
-    strings_.emplace_back(str);
-    return &strings_.back();
+    return construct<std::string>(strings_, thread_idx, str);
   }
 
-  std::vector<int64_t>* addArray(const std::vector<int64_t>& arr) {
+  std::vector<int64_t>* addArray(const std::vector<int64_t>& arr,
+                                 const size_t thread_idx = 0) {
     std::lock_guard<std::mutex> lock(state_mutex_);
-    arrays_.emplace_back(arr);
-    return &arrays_.back();
+    return construct<std::vector<int64_t>>(arrays_, thread_idx, arr);
   }
 
   StringDictionaryProxy* addStringDict(std::shared_ptr<StringDictionary> str_dict,
@@ -163,8 +190,19 @@ class RowSetMemoryOwner final : public SimpleAllocator, boost::noncopyable {
   }
 
   ~RowSetMemoryOwner() {
+    // The objects live in the arenas, which release their memory in bulk; only the
+    // memory the objects own themselves is freed here.
     for (auto count_distinct_set : count_distinct_sets_) {
-      delete count_distinct_set;
+      count_distinct_set->~set();
+    }
+    for (auto str : strings_) {
+      str->~basic_string();
+    }
+    for (auto arr : arrays_) {
+      arr->~vector();
+    }
+    for (auto count_distinct_sparse_bitmap : count_distinct_sparse_bitmaps_) {
+      delete count_distinct_sparse_bitmap;
     }
     for (auto group_by_buffer : group_by_buffers_) {
       free(group_by_buffer);
@@ -199,6 +237,23 @@ class RowSetMemoryOwner final : public SimpleAllocator, boost::noncopyable {
   quantile::TDigest* nullTDigest(double const q);
 
  private:
+  void chargeMemoryBudget(const size_t num_bytes) {
+    if (memory_budget_ && memory_budget_used_ + num_bytes > memory_budget_) {
+      throw OutOfHostMemory(num_bytes);
+    }
+    memory_budget_used_ += num_bytes;
+  }
+
+  // Constructs an object in the arena of the given thread and records it for
+  // destruction; adjacent objects share arena blocks instead of a heap node each.
+  template <typename T, typename... Args>
+  T* construct(std::vector<T*>& objects, const size_t thread_idx, Args&&... args) {
+    CHECK_LT(thread_idx, allocators_.size());
+    auto ptr = allocators_[thread_idx]->allocate(sizeof(T));
+    objects.push_back(new (ptr) T(std::forward<Args>(args)...));
+    return objects.back();
+  }
+
   struct CountDistinctBitmapBuffer {
     int8_t* ptr;
     const size_t size;
@@ -207,10 +262,11 @@ class RowSetMemoryOwner final : public SimpleAllocator, boost::noncopyable {
 
   std::vector<CountDistinctBitmapBuffer> count_distinct_bitmaps_;
   std::vector<std::set<int64_t>*> count_distinct_sets_;
+  std::vector<SparseBitmap*> count_distinct_sparse_bitmaps_;
   std::vector<int64_t*> group_by_buffers_;
   std::vector<void*> varlen_buffers_;
-  std::list<std::string> strings_;
-  std::list<std::vector<int64_t>> arrays_;
+  std::vector<std::string*> strings_;
+  std::vector<std::vector<int64_t>*> arrays_;
   std::unordered_map<int, std::shared_ptr<StringDictionaryProxy>> str_dict_proxy_owned_;
   std::shared_ptr<StringDictionaryProxy> lit_str_dict_proxy_;
   StringDictionaryGenerations string_dictionary_generations_;
@@ -218,6 +274,9 @@ class RowSetMemoryOwner final : public SimpleAllocator, boost::noncopyable {
   std::vector<Data_Namespace::AbstractBuffer*> varlen_input_buffers_;
   std::vector<std::unique_ptr<quantile::TDigest>> t_digests_;
 
+  size_t memory_budget_{0};
+  size_t memory_budget_used_{0};
+
   size_t arena_block_size_;  // for cloning
   std::vector<std::unique_ptr<Arena>> allocators_;
 
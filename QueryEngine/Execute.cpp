@@ -29,12 +29,15 @@
 #include <iostream>
 #include <memory>
 #include <numeric>
+#include <optional>
 #include <set>
 #include <thread>
 
 #include "Catalog/Catalog.h"
 #include "CudaMgr/CudaMgr.h"
 #include "DataMgr/BufferMgr/BufferMgr.h"
+#include "DataMgr/BufferMgr/CpuBufferMgr/CpuBufferMgr.h"
+#include "OSDependent/omnisci_numa.h"
 #include "Parser/ParserNode.h"
 #include "QueryEngine/AggregateUtils.h"
 #include "QueryEngine/AggregatedColRange.h"
@@ -58,6 +61,7 @@
 #include "QueryEngine/QueryTemplateGenerator.h"
 #include "QueryEngine/ResultSetReductionJIT.h"
 #include "QueryEngine/RuntimeFunctions.h"
+#include "QueryEngine/SharedScan.h"
 #include "QueryEngine/SpeculativeTopN.h"
 #include "QueryEngine/StringDictionaryGenerations.h"
 #include "QueryEngine/TableFunctions/TableFunctionCompilationContext.h"
@@ -75,13 +79,17 @@
 bool g_enable_watchdog{false};
 bool g_enable_dynamic_watchdog{false};
 bool g_use_tbb_pool{false};
+bool g_enable_cpu_kernel_work_stealing{false};
 bool g_enable_filter_function{true};
 unsigned g_dynamic_watchdog_time_limit{10000};
 bool g_allow_cpu_retry{true};
 bool g_null_div_by_zero{false};
 unsigned g_trivial_loop_join_threshold{1000};
+size_t g_loop_join_inner_tile_bytes{256 * 1024};
 bool g_from_table_reordering{true};
 bool g_inner_join_fragment_skipping{true};
+bool g_join_key_range_fragment_skipping{true};
+size_t g_chunk_prefetch_depth{0};
 extern bool g_enable_smem_group_by;
 extern std::unique_ptr<llvm::Module> udf_gpu_module;
 extern std::unique_ptr<llvm::Module> udf_cpu_module;
@@ -116,6 +124,7 @@ bool g_enable_non_kernel_time_query_interrupt{true};
 bool g_use_estimator_result_cache{true};
 unsigned g_pending_query_interrupt_freq{1000};
 double g_running_query_interrupt_freq{0.1};
+size_t g_cpu_interrupt_check_rows{16384};
 size_t g_gpu_smem_threshold{
     4096};  // GPU shared memory threshold (in bytes), if larger
             // buffer sizes are required we do not use GPU shared
@@ -164,6 +173,18 @@ Executor::Executor(const ExecutorId executor_id,
     , temporary_tables_(nullptr)
     , input_table_info_cache_(this) {}
 
+Executor::~Executor() {
+  // Background compilations write into the code caches of this executor.
+  waitForBackgroundCodegen();
+}
+
+void Executor::waitForBackgroundCodegen() {
+  std::lock_guard<std::mutex> lock(background_compilations_mutex_);
+  for (auto& background_compilation : background_compilations_) {
+    background_compilation.wait();
+  }
+}
+
 std::shared_ptr<Executor> Executor::getExecutor(
     const ExecutorId executor_id,
     const std::string& debug_dir,
@@ -214,6 +235,19 @@ void Executor::clearMemory(const Data_Namespace::MemoryLevel memory_level) {
   }
 }
 
+size_t Executor::defragmentMemory(const Data_Namespace::MemoryLevel memory_level) {
+  if (memory_level != Data_Namespace::MemoryLevel::CPU_LEVEL &&
+      memory_level != Data_Namespace::MemoryLevel::GPU_LEVEL) {
+    throw std::runtime_error(
+        "Defragmenting memory levels other than the CPU level or GPU level is not "
+        "supported.");
+  }
+  mapd_unique_lock<mapd_shared_mutex> flush_lock(
+      execute_mutex_);  // Don't move chunks while queries are running
+  return Catalog_Namespace::SysCatalog::instance().getDataMgr().defragmentMemory(
+      memory_level);
+}
+
 size_t Executor::getArenaBlockSize() {
   return g_is_test_env ? 100000000 : (1UL << 32) + kArenaBlockOverhead;
 }
@@ -908,6 +942,13 @@ ResultSetPtr Executor::reduceMultiDeviceResults(
     std::shared_ptr<RowSetMemoryOwner> row_set_mem_owner,
     const QueryMemoryDescriptor& query_mem_desc) const {
   auto timer = DEBUG_TIMER(__func__);
+  const auto clock_begin = timer_start();
+  ScopeGuard profile_reduction = [this, clock_begin] {
+    if (auto query_profile = getQueryProfile()) {
+      query_profile->addReductionTime(
+          timer_stop<decltype(clock_begin), std::chrono::microseconds>(clock_begin));
+    }
+  };
   if (ra_exe_unit.estimator) {
     return reduce_estimator_results(ra_exe_unit, results_per_device);
   }
@@ -1001,10 +1042,11 @@ ResultSetPtr Executor::reduceMultiDeviceResultSets(
   const auto reduction_code =
       get_reduction_code(results_per_device, &compilation_queue_time);
 
+  std::vector<const ResultSetStorage*> storages{reduced_results->getStorage()};
   for (size_t i = 1; i < results_per_device.size(); ++i) {
-    reduced_results->getStorage()->reduce(
-        *(results_per_device[i].first->getStorage()), {}, reduction_code);
+    storages.push_back(results_per_device[i].first->getStorage());
   }
+  ResultSetStorage::reduceAll(storages, reduction_code);
   reduced_results->addCompilationQueueTime(compilation_queue_time);
   return reduced_results;
 }
@@ -1832,12 +1874,18 @@ void fill_entries_for_empty_input(std::vector<TargetInfo>& target_infos,
         continue;
       }
       if (count_distinct_desc.impl_type_ == CountDistinctImplType::StdSet) {
-        auto count_distinct_set = new std::set<int64_t>();
         CHECK(row_set_mem_owner);
-        row_set_mem_owner->addCountDistinctSet(count_distinct_set);
+        auto count_distinct_set = row_set_mem_owner->allocateCountDistinctSet();
         entry.push_back(reinterpret_cast<int64_t>(count_distinct_set));
         continue;
       }
+      if (count_distinct_desc.impl_type_ == CountDistinctImplType::SparseBitmap) {
+        auto count_distinct_sparse_bitmap = new SparseBitmap();
+        CHECK(row_set_mem_owner);
+        row_set_mem_owner->addCountDistinctSparseBitmap(count_distinct_sparse_bitmap);
+        entry.push_back(reinterpret_cast<int64_t>(count_distinct_sparse_bitmap));
+        continue;
+      }
     }
     const bool float_argument_input = takes_float_argument(agg_info);
     if (agg_info.agg_kind == kCOUNT || agg_info.agg_kind == kAPPROX_COUNT_DISTINCT) {
@@ -2075,6 +2123,9 @@ std::unordered_map<int, const Analyzer::BinOper*> Executor::getInnerTabIdToJoinC
   const auto& join_info = plan_state_->join_info_;
   CHECK_EQ(join_info.equi_join_tautologies_.size(), join_info.join_hash_tables_.size());
   for (size_t i = 0; i < join_info.join_hash_tables_.size(); ++i) {
+    if (!join_info.equi_join_tautologies_[i]) {
+      continue;
+    }
     int inner_table_id = join_info.join_hash_tables_[i]->getInnerTableId();
     id_to_cond.insert(
         std::make_pair(inner_table_id, join_info.equi_join_tautologies_[i].get()));
@@ -2229,6 +2280,87 @@ std::vector<std::unique_ptr<ExecutionKernel>> Executor::createKernels(
   return execution_kernels;
 }
 
+namespace {
+
+// Runs CPU kernels on the NUMA node whose buffer pool slabs hold their outer fragment.
+void run_kernel_on_numa_node(ExecutionKernel* kernel,
+                             Executor* executor,
+                             const size_t thread_idx,
+                             SharedKernelContext& shared_context,
+                             SharedScan* shared_scan) {
+  const auto outer_fragment_id =
+      kernel->getOuterFragmentId(shared_context.getQueryInfos());
+  if (shared_scan) {
+    shared_scan->fragmentStarted(outer_fragment_id);
+  }
+  std::optional<omnisci::NumaNodeThreadBinding> numa_node_binding;
+  if (kernel->getDeviceType() == ExecutorDeviceType::CPU) {
+    const auto numa_node =
+        Buffer_Namespace::CpuBufferMgr::getNumaNodeForFragment(outer_fragment_id);
+    if (numa_node >= 0) {
+      numa_node_binding.emplace(numa_node);
+    }
+  }
+  kernel->run(executor, thread_idx, shared_context);
+}
+
+// Registers the scan of a physical table by per fragment kernels, and rotates the
+// kernels to start at the fragment concurrent scans of the table are at.
+std::unique_ptr<SharedScan> attach_shared_scan(
+    std::vector<std::unique_ptr<ExecutionKernel>>& kernels,
+    const SharedKernelContext& shared_context,
+    const int db_id) {
+  if (!g_enable_shared_scans || kernels.size() < 2) {
+    return nullptr;
+  }
+  const auto table_id = kernels.front()->getOuterTableId();
+  if (table_id <= 0) {
+    return nullptr;
+  }
+  for (const auto& kernel : kernels) {
+    if (kernel->getDispatchMode() != ExecutorDispatchMode::KernelPerFragment ||
+        kernel->getOuterTableId() != table_id) {
+      return nullptr;
+    }
+  }
+  auto shared_scan = SharedScan::attach(db_id, table_id);
+  const auto start_fragment_id = shared_scan->getStartFragmentId();
+  if (start_fragment_id >= 0) {
+    const auto& query_infos = shared_context.getQueryInfos();
+    auto start_it = std::find_if(
+        kernels.begin(),
+        kernels.end(),
+        [&query_infos, start_fragment_id](const auto& kernel) {
+          return kernel->getOuterFragmentId(query_infos) >= start_fragment_id;
+        });
+    if (start_it != kernels.end()) {
+      VLOG(1) << "Attaching to the scan of table " << table_id << " at fragment "
+              << start_fragment_id;
+      std::rotate(kernels.begin(), start_it, kernels.end());
+    }
+  }
+  return shared_scan;
+}
+
+}  // namespace
+
+std::unique_ptr<Chunk_NS::ChunkPrefetcher> Executor::createChunkPrefetcher(
+    const std::vector<ExecutionKernel*>& kernels,
+    const SharedKernelContext& shared_context) const {
+  if (!g_chunk_prefetch_depth || kernels.size() <= static_cast<size_t>(cpu_threads())) {
+    return nullptr;
+  }
+  CHECK(catalog_);
+  std::vector<std::vector<Chunk_NS::ChunkPrefetchRequest>> batches;
+  batches.reserve(kernels.size());
+  for (const auto kernel : kernels) {
+    batches.push_back(kernel->getOuterChunkPrefetchRequests(
+        *catalog_, shared_context.getQueryInfos()));
+  }
+  return std::make_unique<Chunk_NS::ChunkPrefetcher>(
+      &catalog_->getDataMgr(), std::move(batches), g_chunk_prefetch_depth);
+}
+
 template <typename THREAD_POOL>
 void Executor::launchKernels(SharedKernelContext& shared_context,
                              std::vector<std::unique_ptr<ExecutionKernel>>&& kernels) {
@@ -2238,15 +2370,96 @@ void Executor::launchKernels(SharedKernelContext& shared_context,
 
   THREAD_POOL thread_pool;
   VLOG(1) << "Launching " << kernels.size() << " kernels for query.";
+  const auto shared_scan =
+      catalog_
+          ? attach_shared_scan(kernels, shared_context, catalog_->getCurrentDB().dbId)
+          : nullptr;
+  const size_t worker_count = static_cast<size_t>(cpu_threads());
+  const bool all_cpu_kernels =
+      std::all_of(kernels.begin(), kernels.end(), [](const auto& kernel) {
+        return kernel->getDeviceType() == ExecutorDeviceType::CPU;
+      });
+  if (g_enable_cpu_kernel_work_stealing && all_cpu_kernels &&
+      kernels.size() > worker_count) {
+    // Hand out the most expensive kernels first so that a large, skewed fragment
+    // does not end up being the last one picked up while the other workers sit idle.
+    const auto& query_infos = shared_context.getQueryInfos();
+    std::vector<std::pair<size_t, ExecutionKernel*>> kernels_by_cost;
+    kernels_by_cost.reserve(kernels.size());
+    for (auto& kernel : kernels) {
+      kernels_by_cost.emplace_back(kernel->getOuterTupleCount(query_infos),
+                                   kernel.get());
+    }
+    std::stable_sort(kernels_by_cost.begin(),
+                     kernels_by_cost.end(),
+                     [](const auto& lhs, const auto& rhs) {
+                       return lhs.first > rhs.first;
+                     });
+    if (shared_scan && shared_scan->getStartFragmentId() >= 0) {
+      // Keep the fragment order of the scans this one attached to.
+      for (size_t i = 0; i < kernels.size(); ++i) {
+        kernels_by_cost[i].second = kernels[i].get();
+      }
+    }
+    VLOG(1) << "Scheduling " << kernels.size() << " CPU kernels over " << worker_count
+            << " workers.";
+    std::vector<ExecutionKernel*> kernel_order;
+    for (const auto& [cost, kernel] : kernels_by_cost) {
+      kernel_order.push_back(kernel);
+    }
+    const auto chunk_prefetcher = createChunkPrefetcher(kernel_order, shared_context);
+    std::atomic<size_t> next_kernel_idx{0};
+    for (size_t worker_idx = 0; worker_idx < worker_count; ++worker_idx) {
+      thread_pool.spawn(
+          [this,
+           &shared_context,
+           &kernels_by_cost,
+           &next_kernel_idx,
+           chunk_prefetcher = chunk_prefetcher.get(),
+           shared_scan = shared_scan.get(),
+           parent_thread_id = logger::thread_id()](const size_t thread_idx) {
+            DEBUG_TIMER_NEW_THREAD(parent_thread_id);
+            // Each worker keeps its own thread index, and thereby its own arena in the
+            // row set memory owner, for every kernel it steals from the shared queue.
+            for (size_t kernel_idx = next_kernel_idx.fetch_add(1);
+                 kernel_idx < kernels_by_cost.size();
+                 kernel_idx = next_kernel_idx.fetch_add(1)) {
+              auto kernel = kernels_by_cost[kernel_idx].second;
+              CHECK(kernel);
+              if (chunk_prefetcher) {
+                chunk_prefetcher->startBatch(kernel_idx);
+              }
+              run_kernel_on_numa_node(
+                  kernel, this, thread_idx, shared_context, shared_scan);
+            }
+          },
+          worker_idx);
+    }
+    thread_pool.join();
+    return;
+  }
+
+  std::vector<ExecutionKernel*> kernel_order;
+  for (const auto& kernel : kernels) {
+    kernel_order.push_back(kernel.get());
+  }
+  const auto chunk_prefetcher = createChunkPrefetcher(kernel_order, shared_context);
   size_t kernel_idx = 1;
   for (auto& kernel : kernels) {
     thread_pool.spawn(
-        [this, &shared_context, parent_thread_id = logger::thread_id()](
-            ExecutionKernel* kernel, const size_t crt_kernel_idx) {
+        [this,
+         &shared_context,
+         chunk_prefetcher = chunk_prefetcher.get(),
+         shared_scan = shared_scan.get(),
+         parent_thread_id = logger::thread_id()](ExecutionKernel* kernel,
+                                                 const size_t crt_kernel_idx) {
           CHECK(kernel);
           DEBUG_TIMER_NEW_THREAD(parent_thread_id);
+          if (chunk_prefetcher) {
+            chunk_prefetcher->startBatch(crt_kernel_idx - 1);
+          }
           const size_t thread_idx = crt_kernel_idx % cpu_threads();
-          kernel->run(this, thread_idx, shared_context);
+          run_kernel_on_numa_node(kernel, this, thread_idx, shared_context, shared_scan);
         },
         kernel.get(),
         kernel_idx++);
@@ -2477,6 +2690,22 @@ std::ostream& operator<<(std::ostream& os, FetchResult const& fetch_result) {
             << " frag_offsets" << shared::printContainer(fetch_result.frag_offsets);
 }
 
+namespace {
+
+// Returns false if the metadata of the deleted column shows no deleted rows.
+bool may_have_deleted_rows(const Fragmenter_Namespace::FragmentInfo& fragment,
+                           const ColumnDescriptor* deleted_cd) {
+  CHECK(deleted_cd->columnType.is_boolean());
+  const auto& chunk_metadata = fragment.getChunkMetadataMap();
+  const auto chunk_meta_it = chunk_metadata.find(deleted_cd->columnId);
+  if (chunk_meta_it == chunk_metadata.end()) {
+    return true;
+  }
+  return extract_max_stat(chunk_meta_it->second->chunkStats, deleted_cd->columnType);
+}
+
+}  // namespace
+
 FetchResult Executor::fetchChunks(
     const ColumnFetcher& column_fetcher,
     const RelAlgExecutionUnit& ra_exe_unit,
@@ -2558,6 +2787,12 @@ FetchResult Executor::fetchChunks(
                                               device_allocator,
                                               thread_idx);
       } else {
+        if (cd && cd->isDeletedCol && col_id->getScanDesc().getNestLevel() == 0 &&
+            !may_have_deleted_rows((*fragments)[frag_id], cd)) {
+          // The row function skips the deleted check without a buffer, there is no need
+          // to read the column for the fragments without deleted rows.
+          continue;
+        }
         if (needFetchAllFragments(*col_id, ra_exe_unit, selected_fragments)) {
           // determine if we need special treatment to linearlize multi-frag table
           // i.e., a column that is classified as varlen type, i.e., array
@@ -2609,6 +2844,72 @@ FetchResult Executor::fetchChunks(
   return {all_frag_col_buffers, all_num_rows, all_frag_offsets};
 }
 
+// Splits the inner table of an innermost inner loop join into row tiles, each one a
+// separate entry of the fetch result. The query template then runs the outer rows
+// against one tile at a time, which keeps the tile in cache instead of streaming the
+// whole inner table once per outer row. Only fixed width inner columns can be offset.
+void Executor::tileLoopJoinInnerRows(FetchResult& fetch_result,
+                                     const RelAlgExecutionUnit& ra_exe_unit,
+                                     const Catalog_Namespace::Catalog& cat) const {
+  if (!g_loop_join_inner_tile_bytes || !plan_state_->innermost_inner_loop_join_ ||
+      ra_exe_unit.input_descs.size() < 2 || ra_exe_unit.union_all) {
+    return;
+  }
+  const int inner_nest_level = ra_exe_unit.input_descs.size() - 1;
+  if (ra_exe_unit.input_descs.back().getSourceType() != InputSourceType::TABLE) {
+    return;
+  }
+  std::vector<std::pair<size_t, size_t>> inner_col_widths;
+  size_t inner_row_bytes{0};
+  for (const auto& col_id : ra_exe_unit.input_col_descs) {
+    if (col_id->getScanDesc().getNestLevel() != inner_nest_level) {
+      continue;
+    }
+    const auto cd = try_get_column_descriptor(col_id.get(), cat);
+    if (!cd || cd->columnType.is_varlen() || cd->columnType.get_size() <= 0 ||
+        plan_state_->isLazyFetchColumn(*col_id)) {
+      return;
+    }
+    if (cd->isVirtualCol) {
+      continue;
+    }
+    const auto it = plan_state_->global_to_local_col_ids_.find(*col_id);
+    CHECK(it != plan_state_->global_to_local_col_ids_.end());
+    inner_col_widths.emplace_back(it->second, cd->columnType.get_size());
+    inner_row_bytes += cd->columnType.get_size();
+  }
+  if (!inner_row_bytes) {
+    return;
+  }
+  const int64_t tile_rows =
+      std::max(g_loop_join_inner_tile_bytes / inner_row_bytes, size_t(1));
+  FetchResult tiled;
+  for (size_t i = 0; i < fetch_result.col_buffers.size(); ++i) {
+    const auto inner_rows = fetch_result.num_rows[i][inner_nest_level];
+    for (int64_t tile_start = 0; tile_start < inner_rows || tile_start == 0;
+         tile_start += tile_rows) {
+      auto col_buffers = fetch_result.col_buffers[i];
+      auto num_rows = fetch_result.num_rows[i];
+      auto frag_offsets = fetch_result.frag_offsets[i];
+      for (const auto& [local_col_id, width] : inner_col_widths) {
+        if (col_buffers[local_col_id]) {
+          col_buffers[local_col_id] += tile_start * width;
+        }
+      }
+      num_rows[inner_nest_level] = std::min(tile_rows, inner_rows - tile_start);
+      frag_offsets[inner_nest_level] += tile_start;
+      tiled.col_buffers.push_back(std::move(col_buffers));
+      tiled.num_rows.push_back(std::move(num_rows));
+      tiled.frag_offsets.push_back(std::move(frag_offsets));
+    }
+  }
+  if (tiled.col_buffers.size() > fetch_result.col_buffers.size()) {
+    VLOG(1) << "Split the loop join inner table into " << tiled.col_buffers.size()
+            << " tiles of up to " << tile_rows << " rows";
+    fetch_result = std::move(tiled);
+  }
+}
+
 // fetchChunks() is written under the assumption that multiple inputs implies a JOIN.
 // This is written under the assumption that multiple inputs implies a UNION ALL.
 FetchResult Executor::fetchUnionChunks(
@@ -3736,6 +4037,298 @@ std::pair<bool, int64_t> Executor::skipFragment(
   return {false, -1};
 }
 
+namespace {
+
+// Bounding box of the literal shape compared by a ST_Contains or ST_Intersects call, if
+// neither argument is transformed to another SRID. Only a row whose bounding box
+// intersects it can match.
+std::optional<std::array<double, 4>> get_geo_literal_bounds(
+    const Analyzer::FunctionOper* func_oper) {
+  const auto& name = func_oper->getName();
+  if (name.rfind("ST_Contains_", 0) && name.rfind("ST_cContains_", 0) &&
+      name.rfind("ST_Intersects_", 0)) {
+    return std::nullopt;
+  }
+  // The geo arguments are followed by the compression and SRID of each input and the
+  // output SRID.
+  constexpr size_t kNumTrailingArgs{5};
+  const auto arity = func_oper->getArity();
+  if (arity < kNumTrailingArgs) {
+    return std::nullopt;
+  }
+  std::array<int32_t, kNumTrailingArgs> trailing_args;
+  for (size_t i = 0; i < kNumTrailingArgs; ++i) {
+    const auto arg = dynamic_cast<const Analyzer::Constant*>(
+        func_oper->getArg(arity - kNumTrailingArgs + i));
+    if (!arg || arg->get_type_info().get_type() != kINT) {
+      return std::nullopt;
+    }
+    trailing_args[i] = arg->get_constval().intval;
+  }
+  if (trailing_args[1] != trailing_args[4] || trailing_args[3] != trailing_args[4]) {
+    return std::nullopt;
+  }
+  // Literals carry their coords compressed, their bounds are the only double arrays.
+  std::optional<std::array<double, 4>> literal_bounds;
+  for (size_t i = 0; i < arity - kNumTrailingArgs; ++i) {
+    const auto arg = dynamic_cast<const Analyzer::Constant*>(func_oper->getArg(i));
+    if (!arg || !arg->get_type_info().is_array() ||
+        arg->get_type_info().get_subtype() != kDOUBLE) {
+      continue;
+    }
+    const auto& values = arg->get_value_list();
+    if (literal_bounds || values.size() != 4) {
+      return std::nullopt;
+    }
+    std::array<double, 4> bounds;
+    auto bounds_it = bounds.begin();
+    for (const auto& value : values) {
+      const auto value_const = dynamic_cast<const Analyzer::Constant*>(value.get());
+      if (!value_const || value_const->get_is_null()) {
+        return std::nullopt;
+      }
+      *bounds_it++ = value_const->get_constval().doubleval;
+    }
+    literal_bounds = bounds;
+  }
+  return literal_bounds;
+}
+
+}  // namespace
+
+std::pair<size_t, size_t> Executor::getFragmentCandidateRowRange(
+    const InputDescriptor& table_desc,
+    const Fragmenter_Namespace::FragmentInfo& fragment,
+    const RelAlgExecutionUnit& ra_exe_unit) {
+  const size_t num_rows = fragment.getNumTuples();
+  std::vector<bool> candidate_blocks;
+  const auto get_zone_maps = [&fragment](const Analyzer::ColumnVar* col_var) {
+    auto chunk_meta_it = fragment.getChunkMetadataMap().find(col_var->get_column_id());
+    return chunk_meta_it == fragment.getChunkMetadataMap().end()
+               ? nullptr
+               : chunk_meta_it->second->blockZoneMaps;
+  };
+  // Zone maps of the first filtered column, the others must have the same blocks.
+  std::shared_ptr<const BlockZoneMaps> block_layout;
+  // Drops the blocks of the zone maps of `col_var` which `may_match` rules out.
+  const auto filter_blocks = [&](const Analyzer::ColumnVar* col_var,
+                                 const auto& may_match) {
+    const auto zone_maps = get_zone_maps(col_var);
+    if (!zone_maps || !zone_maps->getNumBlocks(num_rows) ||
+        (block_layout && !block_layout->hasSameBlocks(*zone_maps))) {
+      return;
+    }
+    if (!block_layout) {
+      block_layout = zone_maps;
+      candidate_blocks.resize(zone_maps->getNumBlocks(num_rows), true);
+    }
+    // Blocks past the end of the zone maps are kept as candidates.
+    const auto num_blocks = std::min(candidate_blocks.size(), zone_maps->blocks.size());
+    for (size_t i = 0; i < num_blocks; ++i) {
+      if (!may_match(zone_maps->blocks[i])) {
+        candidate_blocks[i] = false;
+      }
+    }
+  };
+  const auto get_outer_col_var = [&table_desc](const Analyzer::Expr* expr) {
+    const auto col_var = dynamic_cast<const Analyzer::ColumnVar*>(expr);
+    if (!col_var || col_var->get_rte_idx() ||
+        col_var->get_table_id() != table_desc.getTableId()) {
+      return static_cast<const Analyzer::ColumnVar*>(nullptr);
+    }
+    return col_var;
+  };
+  // Dictionary id of a string literal compared with a dictionary encoded column.
+  const auto get_string_id =
+      [this](const Analyzer::ColumnVar* col_var,
+             const Analyzer::Expr* expr) -> std::optional<int64_t> {
+    const auto& col_ti = col_var->get_type_info();
+    const auto str_const =
+        dynamic_cast<const Analyzer::Constant*>(extract_cast_arg(expr));
+    if (!col_ti.is_dict_encoded_string() || !str_const || str_const->get_is_null() ||
+        !str_const->get_type_info().is_string() || !row_set_mem_owner_) {
+      return std::nullopt;
+    }
+    const auto sdp = getStringDictionaryProxy(col_ti.get_comp_param(), true);
+    CHECK(sdp);
+    return sdp->getIdOfString(*str_const->get_constval().stringval);
+  };
+
+  for (const auto& qual : ra_exe_unit.simple_quals) {
+    const auto comp_expr = std::dynamic_pointer_cast<const Analyzer::BinOper>(qual);
+    if (!comp_expr) {
+      continue;
+    }
+    const auto lhs_col = get_outer_col_var(comp_expr->get_left_operand());
+    const auto rhs_const =
+        dynamic_cast<const Analyzer::Constant*>(comp_expr->get_right_operand());
+    if (!lhs_col || !rhs_const) {
+      continue;
+    }
+    const auto& lhs_ti = lhs_col->get_type_info();
+    if (!lhs_ti.is_integer() && !lhs_ti.is_time()) {
+      continue;
+    }
+    if (lhs_ti.is_timestamp() &&
+        lhs_ti.get_dimension() != rhs_const->get_type_info().get_dimension()) {
+      continue;
+    }
+    if (!get_zone_maps(lhs_col)) {
+      continue;
+    }
+    llvm::LLVMContext local_context;
+    CgenState local_cgen_state(local_context);
+    CodeGenerator code_generator(&local_cgen_state, nullptr);
+
+    const auto rhs_val =
+        CodeGenerator::codegenIntConst(rhs_const, &local_cgen_state)->getSExtValue();
+
+    switch (comp_expr->get_optype()) {
+      case kGE:
+        filter_blocks(lhs_col, [rhs_val](const BlockStats& block) {
+          return block.max >= rhs_val;
+        });
+        break;
+      case kGT:
+        filter_blocks(lhs_col, [rhs_val](const BlockStats& block) {
+          return block.max > rhs_val;
+        });
+        break;
+      case kLE:
+        filter_blocks(lhs_col, [rhs_val](const BlockStats& block) {
+          return block.min <= rhs_val;
+        });
+        break;
+      case kLT:
+        filter_blocks(lhs_col, [rhs_val](const BlockStats& block) {
+          return block.min < rhs_val;
+        });
+        break;
+      case kEQ:
+        filter_blocks(lhs_col, [rhs_val](const BlockStats& block) {
+          return block.mayContain(rhs_val);
+        });
+        break;
+      default:
+        break;
+    }
+  }
+
+  // Equality and IN filters on dictionary encoded columns go through the value index.
+  std::list<std::shared_ptr<Analyzer::Expr>> all_quals(ra_exe_unit.simple_quals);
+  all_quals.insert(all_quals.end(), ra_exe_unit.quals.begin(), ra_exe_unit.quals.end());
+  for (const auto& qual : all_quals) {
+    std::vector<int64_t> string_ids;
+    const Analyzer::ColumnVar* col_var{nullptr};
+    if (const auto comp_expr = std::dynamic_pointer_cast<const Analyzer::BinOper>(qual)) {
+      if (comp_expr->get_optype() != kEQ || comp_expr->get_qualifier() != kONE) {
+        continue;
+      }
+      col_var = get_outer_col_var(comp_expr->get_left_operand());
+      if (!col_var || !get_zone_maps(col_var)) {
+        continue;
+      }
+      const auto string_id = get_string_id(col_var, comp_expr->get_right_operand());
+      if (!string_id) {
+        continue;
+      }
+      string_ids.push_back(*string_id);
+    } else if (const auto in_values =
+                   std::dynamic_pointer_cast<const Analyzer::InValues>(qual)) {
+      col_var = get_outer_col_var(in_values->get_arg());
+      if (!col_var || !get_zone_maps(col_var)) {
+        continue;
+      }
+      bool all_string_literals{true};
+      for (const auto& in_val : in_values->get_value_list()) {
+        const auto string_id = get_string_id(col_var, in_val.get());
+        if (!string_id) {
+          all_string_literals = false;
+          break;
+        }
+        string_ids.push_back(*string_id);
+      }
+      if (!all_string_literals) {
+        continue;
+      }
+    } else {
+      continue;
+    }
+    // Strings missing from the dictionary match no row.
+    string_ids.erase(std::remove(string_ids.begin(),
+                                 string_ids.end(),
+                                 StringDictionary::INVALID_STR_ID),
+                     string_ids.end());
+    filter_blocks(col_var, [&string_ids](const BlockStats& block) {
+      return std::any_of(
+          string_ids.begin(), string_ids.end(), [&block](const int64_t id) {
+            return block.mayContain(id);
+          });
+    });
+  }
+
+  // ST_Contains and ST_Intersects against a literal shape go through the block bounds
+  // of the geo column.
+  const auto filter_blocks_by_bounds = [&](const Analyzer::ColumnVar* col_var,
+                                           const std::array<double, 4>& box) {
+    // Points are passed as the logical column, whose coords column comes right after.
+    const auto column_id = col_var->get_type_info().get_type() == kPOINT
+                               ? col_var->get_column_id() + 1
+                               : col_var->get_column_id();
+    auto chunk_meta_it = fragment.getChunkMetadataMap().find(column_id);
+    if (chunk_meta_it == fragment.getChunkMetadataMap().end() ||
+        !chunk_meta_it->second->blockBounds) {
+      return;
+    }
+    const auto& block_bounds = *chunk_meta_it->second->blockBounds;
+    const BlockZoneMaps layout{block_bounds.block_rows, {}, {}};
+    if (!layout.getNumBlocks(num_rows) ||
+        (block_layout && !block_layout->hasSameBlocks(layout))) {
+      return;
+    }
+    if (!block_layout) {
+      block_layout = std::make_shared<BlockZoneMaps>(layout);
+      candidate_blocks.resize(layout.getNumBlocks(num_rows), true);
+    }
+    const auto num_blocks = std::min(candidate_blocks.size(), block_bounds.bounds.size());
+    for (size_t i = 0; i < num_blocks; ++i) {
+      if (!block_bounds.mayIntersect(i, box)) {
+        candidate_blocks[i] = false;
+      }
+    }
+  };
+  for (const auto& qual : all_quals) {
+    const auto func_oper = std::dynamic_pointer_cast<const Analyzer::FunctionOper>(qual);
+    if (!func_oper) {
+      continue;
+    }
+    const auto literal_bounds = get_geo_literal_bounds(func_oper.get());
+    if (!literal_bounds) {
+      continue;
+    }
+    for (size_t i = 0; i < func_oper->getArity(); ++i) {
+      if (const auto col_var = get_outer_col_var(func_oper->getArg(i))) {
+        filter_blocks_by_bounds(col_var, *literal_bounds);
+      }
+    }
+  }
+
+  if (candidate_blocks.empty()) {
+    return {0, num_rows};
+  }
+  const auto first_it = std::find(candidate_blocks.begin(), candidate_blocks.end(), true);
+  if (first_it == candidate_blocks.end()) {
+    return {0, 0};
+  }
+  const auto last_it =
+      std::find(candidate_blocks.rbegin(), candidate_blocks.rend(), true);
+  const size_t first_block = first_it - candidate_blocks.begin();
+  const size_t last_block = candidate_blocks.rend() - last_it - 1;
+  const size_t begin = first_block ? block_layout->getBlockEndRow(first_block - 1) : 0;
+  const size_t end = block_layout->getBlockEndRow(last_block);
+  return {std::min(begin, num_rows), std::min(end, num_rows)};
+}
+
 /*
  *   The skipFragmentInnerJoins process all quals stored in the execution unit's
  * join_quals and gather all the ones that meet the "simple_qual" characteristics
@@ -3793,6 +4386,28 @@ std::pair<bool, int64_t> Executor::skipFragmentInnerJoins(
   return skip_frag;
 }
 
+bool Executor::skipFragmentJoinKeyRange(
+    const InputDescriptor& table_desc,
+    const Fragmenter_Namespace::FragmentInfo& fragment,
+    const std::vector<uint64_t>& frag_offsets,
+    const size_t frag_idx) {
+  if (!g_join_key_range_fragment_skipping || table_desc.getNestLevel() != 0) {
+    return false;
+  }
+  CHECK(plan_state_);
+  const auto& range_quals = plan_state_->join_info_.outer_key_range_quals_;
+  if (range_quals.empty()) {
+    return false;
+  }
+  const auto skip_frag =
+      skipFragment(table_desc, fragment, range_quals, frag_offsets, frag_idx);
+  if (skip_frag.first) {
+    VLOG(2) << "Skipping fragment " << frag_idx << " of table "
+            << table_desc.getTableId() << " outside of the join key range";
+  }
+  return skip_frag.first;
+}
+
 AggregatedColRange Executor::computeColRangesCache(
     const std::unordered_set<PhysicalInput>& phys_inputs) {
   AggregatedColRange agg_col_range_cache;
@@ -4295,3 +4910,10 @@ std::mutex Executor::kernel_mutex_;
 QueryPlanDagCache Executor::query_plan_dag_cache_;
 mapd_shared_mutex Executor::recycler_mutex_;
 std::unordered_map<std::string, size_t> Executor::cardinality_cache_;
+
+std::atomic<size_t> Executor::code_cache_hits_{0};
+std::atomic<size_t> Executor::jit_low_tier_compilations_{0};
+std::atomic<size_t> Executor::jit_tier_promotions_{0};
+std::atomic<size_t> Executor::background_codegen_replacements_{0};
+std::atomic<size_t> Executor::background_codegen_failures_{0};
+std::atomic<size_t> Executor::code_cache_misses_{0};
@@ -24,6 +24,7 @@
 #include <cstdlib>
 #include <deque>
 #include <functional>
+#include <future>
 #include <limits>
 #include <map>
 #include <mutex>
@@ -54,6 +55,7 @@
 #include "QueryEngine/NvidiaKernel.h"
 #include "QueryEngine/PlanState.h"
 #include "QueryEngine/QueryPlanDagCache.h"
+#include "QueryEngine/QueryProfile.h"
 #include "QueryEngine/RelAlgExecutionUnit.h"
 #include "QueryEngine/RelAlgTranslator.h"
 #include "QueryEngine/StringDictionaryGenerations.h"
@@ -374,6 +376,8 @@ class Executor {
            const std::string& debug_dir,
            const std::string& debug_file);
 
+  ~Executor();
+
   static std::shared_ptr<Executor> getExecutor(
       const ExecutorId id,
       const std::string& debug_dir = "",
@@ -388,6 +392,8 @@ class Executor {
   }
 
   static void clearMemory(const Data_Namespace::MemoryLevel memory_level);
+  // Returns the number of buffer pool chunks moved to coalesce free space.
+  static size_t defragmentMemory(const Data_Namespace::MemoryLevel memory_level);
 
   static size_t getArenaBlockSize();
 
@@ -428,6 +434,14 @@ class Executor {
   const Catalog_Namespace::Catalog* getCatalog() const;
   void setCatalog(const Catalog_Namespace::Catalog* catalog);
 
+  ExecutorId getExecutorId() const { return executor_id_; }
+
+  // Profile of the query running on this executor, null unless it is being profiled.
+  QueryProfile* getQueryProfile() const { return query_profile_.get(); }
+  void setQueryProfile(std::shared_ptr<QueryProfile> query_profile) {
+    query_profile_ = std::move(query_profile);
+  }
+
   Data_Namespace::DataMgr* getDataMgr() const {
     CHECK(data_mgr_);
     return data_mgr_;
@@ -485,7 +499,8 @@ class Executor {
                                     const Catalog_Namespace::Catalog& cat,
                                     std::shared_ptr<RowSetMemoryOwner> row_set_mem_owner,
                                     const UpdateLogForFragment::Callback& cb,
-                                    const bool is_agg);
+                                    const bool is_agg,
+                                    const bool concurrent_fragment_updates);
 
   void addTransientStringLiterals(
       const RelAlgExecutionUnit& ra_exe_unit,
@@ -624,6 +639,15 @@ class Executor {
   void launchKernels(SharedKernelContext& shared_context,
                      std::vector<std::unique_ptr<ExecutionKernel>>&& kernels);
 
+  /**
+   * Returns a prefetcher which reads the outer table chunks of `kernels`, in the order
+   * they'll be started, up to `g_chunk_prefetch_depth` kernels ahead. Returns nullptr
+   * when prefetching is disabled or every kernel gets a worker right away.
+   */
+  std::unique_ptr<Chunk_NS::ChunkPrefetcher> createChunkPrefetcher(
+      const std::vector<ExecutionKernel*>& kernels,
+      const SharedKernelContext& shared_context) const;
+
   std::vector<size_t> getTableFragmentIndices(
       const RelAlgExecutionUnit& ra_exe_unit,
       const ExecutorDeviceType device_type,
@@ -667,6 +691,10 @@ class Executor {
                                const size_t thread_idx,
                                const bool allow_runtime_interrupt);
 
+  void tileLoopJoinInnerRows(FetchResult& fetch_result,
+                             const RelAlgExecutionUnit& ra_exe_unit,
+                             const Catalog_Namespace::Catalog& cat) const;
+
   std::pair<std::vector<std::vector<int64_t>>, std::vector<std::vector<uint64_t>>>
   getRowCountAndOffsetForAllFrags(
       const RelAlgExecutionUnit& ra_exe_unit,
@@ -876,7 +904,19 @@ class Executor {
       llvm::Function*,
       llvm::Function*,
       const std::unordered_set<llvm::Function*>&,
-      const CompilationOptions&);
+      const CompilationOptions&,
+      const size_t input_row_count_upper_bound);
+  /**
+   * Compiles `module` with full backend optimizations on a background thread and
+   * replaces the entry for `key` in the CPU code cache once done. Used to upgrade code
+   * which was compiled quickly for the first execution of a query.
+   */
+  void scheduleBackgroundCodegenCPU(const CodeCacheKey& key,
+                                    std::unique_ptr<llvm::Module> module,
+                                    const std::string& query_func_name,
+                                    const std::string& multifrag_query_func_name,
+                                    const std::vector<std::string>& live_func_names,
+                                    const CompilationOptions& co);
   std::shared_ptr<CompilationContext> optimizeAndCodegenGPU(
       llvm::Function*,
       llvm::Function*,
@@ -922,6 +962,13 @@ class Executor {
       const std::vector<uint64_t>& frag_offsets,
       const size_t frag_idx);
 
+  // Returns the [begin, end) rows of the fragment which the block zone maps of the
+  // filtered columns cannot rule out.
+  std::pair<size_t, size_t> getFragmentCandidateRowRange(
+      const InputDescriptor& table_desc,
+      const Fragmenter_Namespace::FragmentInfo& fragment,
+      const RelAlgExecutionUnit& ra_exe_unit);
+
   std::pair<bool, int64_t> skipFragmentInnerJoins(
       const InputDescriptor& table_desc,
       const RelAlgExecutionUnit& ra_exe_unit,
@@ -929,6 +976,13 @@ class Executor {
       const std::vector<uint64_t>& frag_offsets,
       const size_t frag_idx);
 
+  // Returns true iff no row of the outer table fragment can match the key range of the
+  // inner and semi join hash tables built for the current query step.
+  bool skipFragmentJoinKeyRange(const InputDescriptor& table_desc,
+                                const Fragmenter_Namespace::FragmentInfo& fragment,
+                                const std::vector<uint64_t>& frag_offsets,
+                                const size_t frag_idx);
+
   AggregatedColRange computeColRangesCache(
       const std::unordered_set<PhysicalInput>& phys_inputs);
   StringDictionaryGenerations computeStringDictionaryGenerations(
@@ -1011,10 +1065,34 @@ class Executor {
 
   mapd_shared_mutex& getDataRecyclerLock();
   QueryPlanDagCache& getQueryPlanDagCache();
+
+  // Lookups of the generated code caches of all Executors, hits and misses.
+  static std::pair<size_t, size_t> getCodeCacheLookupCounts() {
+    return {code_cache_hits_.load(std::memory_order_relaxed),
+            code_cache_misses_.load(std::memory_order_relaxed)};
+  }
+
   JoinColumnsInfo getJoinColumnsInfo(const Analyzer::Expr* join_expr,
                                      JoinColumnSide target_side,
                                      bool extract_only_col_id);
 
+  // Blocks until the background compilations scheduled by this executor are done.
+  void waitForBackgroundCodegen();
+
+  // The following methods are for testing purposes only
+  struct JitTierCounts {
+    size_t low_tier_compilations;  // CPU code compiled at the low tier
+    size_t promotions;             // low tier code scheduled for the full tier
+    size_t background_replacements;
+    size_t background_failures;
+  };
+  static JitTierCounts getJitTierCounts() {
+    return {jit_low_tier_compilations_.load(std::memory_order_relaxed),
+            jit_tier_promotions_.load(std::memory_order_relaxed),
+            background_codegen_replacements_.load(std::memory_order_relaxed),
+            background_codegen_failures_.load(std::memory_order_relaxed)};
+  }
+
  private:
   std::shared_ptr<CompilationContext> getCodeFromCache(const CodeCacheKey&,
                                                        const CodeCache&);
@@ -1064,6 +1142,9 @@ class Executor {
   CodeCache cpu_code_cache_;
   CodeCache gpu_code_cache_;
 
+  std::vector<std::future<void>> background_compilations_;
+  std::mutex background_compilations_mutex_;
+
   static const size_t baseline_threshold{
       1000000};  // if a perfect hash needs more entries, use baseline
   static const size_t code_cache_size{1000};
@@ -1081,6 +1162,7 @@ class Executor {
 
   int64_t kernel_queue_time_ms_ = 0;
   int64_t compilation_queue_time_ms_ = 0;
+  std::shared_ptr<QueryProfile> query_profile_;
 
   // Singleton instance used for an execution unit which is a project with window
   // functions.
@@ -1130,6 +1212,13 @@ class Executor {
   static mapd_shared_mutex recycler_mutex_;
   static std::unordered_map<std::string, size_t> cardinality_cache_;
 
+  static std::atomic<size_t> code_cache_hits_;
+  static std::atomic<size_t> jit_low_tier_compilations_;
+  static std::atomic<size_t> jit_tier_promotions_;
+  static std::atomic<size_t> background_codegen_replacements_;
+  static std::atomic<size_t> background_codegen_failures_;
+  static std::atomic<size_t> code_cache_misses_;
+
  public:
   static const int32_t ERR_DIV_BY_ZERO{1};
   static const int32_t ERR_OUT_OF_GPU_MEM{2};
@@ -1165,9 +1254,11 @@ class Executor {
   friend class QueryExecutionContext;
   friend class ResultSet;
   friend class InValuesBitmap;
+  friend class StringIdMap;
   friend class LeafAggregator;
   friend class PerfectJoinHashTable;
   friend class QueryRewriter;
+  friend class RangeJoinHashTable;
   friend class PendingExecutionClosure;
   friend class RelAlgExecutor;
   friend class TableOptimizer;
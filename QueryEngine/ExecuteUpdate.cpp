@@ -16,6 +16,8 @@
 
 #include "QueryEngine/Execute.h"
 
+#include <future>
+
 #include "QueryEngine/ColumnFetcher.h"
 #include "QueryEngine/Descriptors/QueryCompilationDescriptor.h"
 #include "QueryEngine/Descriptors/QueryFragmentDescriptor.h"
@@ -25,6 +27,28 @@
 
 extern bool g_enable_auto_metadata_update;
 
+// Fragments of an UPDATE or DELETE whose projected rows are written to storage while the
+// next fragments execute, 1 writes each fragment before executing the next one.
+size_t g_max_concurrent_update_fragments{4};
+
+namespace {
+
+void merge_table_update_metadata(TableUpdateMetadata& table_update_metadata,
+                                 const TableUpdateMetadata& fragment_update_metadata) {
+  for (const auto& [cd, fragment_ids] :
+       fragment_update_metadata.columns_for_metadata_update) {
+    table_update_metadata.columns_for_metadata_update[cd].insert(fragment_ids.begin(),
+                                                                 fragment_ids.end());
+  }
+  for (const auto& [table_id, fragment_ids] :
+       fragment_update_metadata.fragments_with_deleted_rows) {
+    table_update_metadata.fragments_with_deleted_rows[table_id].insert(
+        fragment_ids.begin(), fragment_ids.end());
+  }
+}
+
+}  // namespace
+
 UpdateLogForFragment::UpdateLogForFragment(FragmentInfoType const& fragment_info,
                                            size_t const fragment_index,
                                            const std::shared_ptr<ResultSet>& rs)
@@ -71,7 +95,8 @@ TableUpdateMetadata Executor::executeUpdate(
     const Catalog_Namespace::Catalog& cat,
     std::shared_ptr<RowSetMemoryOwner> row_set_mem_owner,
     const UpdateLogForFragment::Callback& cb,
-    const bool is_agg) {
+    const bool is_agg,
+    const bool concurrent_fragment_updates) {
   CHECK(cb);
   CHECK(table_desc_for_update);
   VLOG(1) << "Executor " << executor_id_
@@ -134,7 +159,35 @@ TableUpdateMetadata Executor::executeUpdate(
   }
   CHECK(query_mem_desc);
 
-  TableUpdateMetadata table_update_metadata;
+  // Updates of different fragments only share the transaction tracker, so with no inner
+  // tables to read the updated table through, the callbacks writing to storage overlap
+  // with executing the next fragments. Each callback collects the metadata to recompute
+  // for its fragment, merged into the table metadata once all of them are done.
+  const auto max_concurrent_fragments =
+      concurrent_fragment_updates && ra_exe_unit.input_descs.size() == 1
+          ? std::max(g_max_concurrent_update_fragments, size_t(1))
+          : size_t(1);
+  std::vector<TableUpdateMetadata> fragment_update_metadata(outer_fragments.size());
+  // declared after what the updates reference, if execution throws the destructor of
+  // each future waits for its update
+  std::vector<std::future<void>> fragment_updates;
+  auto wait_fragment_updates = [&fragment_updates]() {
+    std::exception_ptr first_exception;
+    for (auto& fragment_update : fragment_updates) {
+      try {
+        fragment_update.get();
+      } catch (...) {
+        if (!first_exception) {
+          first_exception = std::current_exception();
+        }
+      }
+    }
+    fragment_updates.clear();
+    if (first_exception) {
+      std::rethrow_exception(first_exception);
+    }
+  };
+
   for (size_t fragment_index = 0; fragment_index < outer_fragments.size();
        ++fragment_index) {
     const int64_t crt_fragment_tuple_count =
@@ -184,8 +237,28 @@ TableUpdateMetadata Executor::executeUpdate(
     const auto& proj_fragment_result = proj_fragment_results[0];
     const auto proj_result_set = proj_fragment_result.first;
     CHECK(proj_result_set);
-    cb({outer_fragments[fragment_index], fragment_index, proj_result_set},
-       table_update_metadata);
+    if (max_concurrent_fragments == 1) {
+      cb({outer_fragments[fragment_index], fragment_index, proj_result_set},
+         fragment_update_metadata[fragment_index]);
+      continue;
+    }
+    if (fragment_updates.size() >= max_concurrent_fragments) {
+      wait_fragment_updates();
+    }
+    fragment_updates.emplace_back(std::async(
+        std::launch::async,
+        [&cb, &outer_fragments, &fragment_update_metadata, fragment_index](
+            const std::shared_ptr<ResultSet> proj_result_set) {
+          cb({outer_fragments[fragment_index], fragment_index, proj_result_set},
+             fragment_update_metadata[fragment_index]);
+        },
+        proj_result_set));
+  }
+  wait_fragment_updates();
+
+  TableUpdateMetadata table_update_metadata;
+  for (const auto& metadata : fragment_update_metadata) {
+    merge_table_update_metadata(table_update_metadata, metadata);
   }
 
   if (g_enable_auto_metadata_update) {
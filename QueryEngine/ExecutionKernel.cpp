@@ -19,6 +19,7 @@
 #include <mutex>
 #include <vector>
 
+#include "QueryEngine/BatchInterpreter.h"
 #include "QueryEngine/Descriptors/RowSetMemoryOwner.h"
 #include "QueryEngine/DynamicWatchdog.h"
 #include "QueryEngine/ErrorHandling.h"
@@ -82,15 +83,118 @@ void SharedKernelContext::addDeviceResults(ResultSetPtr&& device_results,
   }
 }
 
+void SharedKernelContext::addSharedCpuGroupByResults(
+    ResultSetPtr&& device_results,
+    std::vector<size_t> outer_table_fragment_ids) {
+  CHECK(device_results);
+  std::lock_guard<std::mutex> lock(reduce_mutex_);
+  if (all_fragment_results_.empty()) {
+    all_fragment_results_.emplace_back(std::move(device_results),
+                                       outer_table_fragment_ids);
+    return;
+  }
+  CHECK_EQ(all_fragment_results_.size(), size_t(1));
+  auto& fragment_ids = all_fragment_results_.front().second;
+  fragment_ids.insert(fragment_ids.end(),
+                      outer_table_fragment_ids.begin(),
+                      outer_table_fragment_ids.end());
+}
+
 std::vector<std::pair<ResultSetPtr, std::vector<size_t>>>&
 SharedKernelContext::getFragmentResults() {
   return all_fragment_results_;
 }
 
+size_t ExecutionKernel::getOuterTupleCount(
+    const std::vector<InputTableInfo>& query_infos) const {
+  CHECK(!frag_list.empty());
+  const auto& outer_tab_frags = frag_list.front();
+  for (const auto& query_info : query_infos) {
+    if (query_info.table_id != outer_tab_frags.table_id) {
+      continue;
+    }
+    const auto& fragments = query_info.info.fragments;
+    size_t tuple_count{0};
+    for (const auto frag_id : outer_tab_frags.fragment_ids) {
+      if (frag_id < fragments.size()) {
+        tuple_count += fragments[frag_id].getNumTuples();
+      }
+    }
+    return tuple_count;
+  }
+  return 0;
+}
+
+int ExecutionKernel::getOuterFragmentId(
+    const std::vector<InputTableInfo>& query_infos) const {
+  CHECK(!frag_list.empty());
+  const auto& outer_tab_frags = frag_list.front();
+  if (outer_tab_frags.fragment_ids.empty()) {
+    return -1;
+  }
+  for (const auto& query_info : query_infos) {
+    if (query_info.table_id != outer_tab_frags.table_id) {
+      continue;
+    }
+    const auto& fragments = query_info.info.fragments;
+    const auto frag_id = outer_tab_frags.fragment_ids.front();
+    return frag_id < fragments.size() ? fragments[frag_id].fragmentId : -1;
+  }
+  return -1;
+}
+
+std::vector<Chunk_NS::ChunkPrefetchRequest>
+ExecutionKernel::getOuterChunkPrefetchRequests(
+    const Catalog_Namespace::Catalog& cat,
+    const std::vector<InputTableInfo>& query_infos) const {
+  CHECK(!frag_list.empty());
+  const auto& outer_tab_frags = frag_list.front();
+  std::vector<Chunk_NS::ChunkPrefetchRequest> requests;
+  if (outer_tab_frags.table_id <= 0) {
+    return requests;
+  }
+  const auto query_info_it =
+      std::find_if(query_infos.begin(),
+                   query_infos.end(),
+                   [&outer_tab_frags](const InputTableInfo& query_info) {
+                     return query_info.table_id == outer_tab_frags.table_id;
+                   });
+  if (query_info_it == query_infos.end()) {
+    return requests;
+  }
+  const auto& fragments = query_info_it->info.fragments;
+  for (const auto frag_id : outer_tab_frags.fragment_ids) {
+    if (frag_id >= fragments.size() || fragments[frag_id].isEmptyPhysicalFragment()) {
+      continue;
+    }
+    const auto& fragment = fragments[frag_id];
+    for (const auto& col_desc : ra_exe_unit_.input_col_descs) {
+      if (col_desc->getScanDesc().getNestLevel() != 0 ||
+          col_desc->getScanDesc().getTableId() != outer_tab_frags.table_id) {
+        continue;
+      }
+      const auto col_id = col_desc->getColId();
+      const auto chunk_meta_it = fragment.getChunkMetadataMap().find(col_id);
+      if (chunk_meta_it == fragment.getChunkMetadataMap().end()) {
+        continue;
+      }
+      const auto cd = get_column_descriptor(col_id, outer_tab_frags.table_id, cat);
+      CHECK(cd);
+      ChunkKey chunk_key{
+          cat.getCurrentDB().dbId, fragment.physicalTableId, col_id, fragment.fragmentId};
+      requests.push_back({cd,
+                          std::move(chunk_key),
+                          chunk_meta_it->second->numBytes,
+                          chunk_meta_it->second->numElements});
+    }
+  }
+  return requests;
+}
+
 void ExecutionKernel::run(Executor* executor,
                           const size_t thread_idx,
                           SharedKernelContext& shared_context) {
-  DEBUG_TIMER("ExecutionKernel::run");
+  auto timer = DEBUG_TIMER("ExecutionKernel::run");
   INJECT_TIMER(kernel_run);
   try {
     runImpl(executor, thread_idx, shared_context);
@@ -152,7 +256,9 @@ void ExecutionKernel::runImpl(Executor* executor,
     device_allocator = std::make_unique<CudaAllocator>(data_mgr, chosen_device_id);
   }
   FetchResult fetch_result;
+  auto query_profile = executor->getQueryProfile();
   try {
+    const auto fetch_clock_begin = timer_start();
     std::map<int, const TableFragments*> all_tables_fragments;
     QueryFragmentDescriptor::computeAllTablesFragments(
         all_tables_fragments, ra_exe_unit_, shared_context.getQueryInfos());
@@ -182,6 +288,18 @@ void ExecutionKernel::runImpl(Executor* executor,
                                                device_allocator.get(),
                                                thread_idx,
                                                eo.allow_runtime_query_interrupt);
+    if (query_profile) {
+      size_t fetched_bytes{0};
+      for (const auto& chunk : chunks) {
+        fetched_bytes += chunk->getBuffer() ? chunk->getBuffer()->size() : 0;
+        fetched_bytes += chunk->getIndexBuf() ? chunk->getIndexBuf()->size() : 0;
+      }
+      query_profile->addFetch(
+          memory_level,
+          fetched_bytes,
+          timer_stop<decltype(fetch_clock_begin), std::chrono::microseconds>(
+              fetch_clock_begin));
+    }
     if (fetch_result.num_rows.empty()) {
       return;
     }
@@ -207,7 +325,6 @@ void ExecutionKernel::runImpl(Executor* executor,
     if (ra_exe_unit_.input_descs.size() > 1) {
       throw std::runtime_error("Joins not supported through external execution");
     }
-    const auto query = serialize_to_sql(&ra_exe_unit_, catalog);
     GroupByAndAggregate group_by_and_aggregate(executor,
                                                ExecutorDeviceType::CPU,
                                                ra_exe_unit_,
@@ -216,17 +333,62 @@ void ExecutionKernel::runImpl(Executor* executor,
                                                std::nullopt);
     const auto query_mem_desc =
         group_by_and_aggregate.initQueryMemoryDescriptor(false, 0, 8, nullptr, false);
-    device_results_ = run_query_external(
-        query,
-        fetch_result,
-        executor->plan_state_.get(),
-        ExternalQueryOutputSpec{
-            *query_mem_desc,
-            target_exprs_to_infos(ra_exe_unit_.target_exprs, *query_mem_desc),
-            executor});
+    const ExternalQueryOutputSpec output_spec{
+        *query_mem_desc,
+        target_exprs_to_infos(ra_exe_unit_.target_exprs, *query_mem_desc),
+        executor};
+    device_results_ = run_query_interpreted(
+        ra_exe_unit_, fetch_result, executor->plan_state_.get(), output_spec);
+    if (!device_results_) {
+      VLOG(1) << "Running the query step through SQLite";
+      const auto query = serialize_to_sql(&ra_exe_unit_, catalog);
+      device_results_ = run_query_external(
+          query, fetch_result, executor->plan_state_.get(), output_spec);
+    }
     shared_context.addDeviceResults(std::move(device_results_), outer_tab_frag_ids);
     return;
   }
+  // Trim the scanned rows of each outer fragment to the range the block zone maps of
+  // the filtered columns cannot rule out.
+  size_t zone_map_start_row{0};
+  if (!ra_exe_unit_.union_all && ra_exe_unit_.input_descs.size() == 1 &&
+      (!ra_exe_unit_.simple_quals.empty() || !ra_exe_unit_.quals.empty()) &&
+      rowid_lookup_key < 0 && outer_table_id > 0 &&
+      fetch_result.num_rows.size() == outer_tab_frag_ids.size()) {
+    const auto& query_infos = shared_context.getQueryInfos();
+    const auto info_it = std::find_if(
+        query_infos.begin(), query_infos.end(), [outer_table_id](const auto& info) {
+          return info.table_id == outer_table_id;
+        });
+    CHECK(info_it != query_infos.end());
+    const auto& fragments = info_it->info.fragments;
+    for (size_t i = 0; i < outer_tab_frag_ids.size(); ++i) {
+      CHECK_LT(outer_tab_frag_ids[i], fragments.size());
+      CHECK_EQ(fetch_result.num_rows[i].size(), size_t(1));
+      const auto [begin, end] = executor->getFragmentCandidateRowRange(
+          ra_exe_unit_.input_descs[0],
+          fragments[outer_tab_frag_ids[i]],
+          ra_exe_unit_);
+      if (end < static_cast<size_t>(fetch_result.num_rows[i][0])) {
+        VLOG(2) << "Zone maps trimmed fragment " << outer_tab_frag_ids[i] << " from "
+                << fetch_result.num_rows[i][0] << " to " << end << " rows";
+        fetch_result.num_rows[i][0] = end;
+      }
+      // Only the CPU kernel of a single fragment can start past the first row.
+      if (outer_tab_frag_ids.size() == 1 &&
+          chosen_device_type == ExecutorDeviceType::CPU) {
+        zone_map_start_row = std::min(begin, end);
+      }
+    }
+  }
+
+  // Projections size their output from the input row counts, which repeat the outer
+  // rows for every tile.
+  if (chosen_device_type == ExecutorDeviceType::CPU &&
+      query_mem_desc.getQueryDescriptionType() != QueryDescriptionType::Projection) {
+    executor->tileLoopJoinInnerRows(fetch_result, ra_exe_unit_, *catalog);
+  }
+
   const CompilationResult& compilation_result = query_comp_desc.getCompilationResult();
   std::unique_ptr<QueryExecutionContext> query_exe_context_owned;
   const bool do_render = render_info_ && render_info_->isPotentialInSituRender();
@@ -256,6 +418,7 @@ void ExecutionKernel::runImpl(Executor* executor,
   }
 
   if (eo.executor_type == ExecutorType::Native) {
+    auto shared_cpu_group_by_buffer = shared_context.getSharedCpuGroupByBuffer();
     try {
       query_exe_context_owned =
           query_mem_desc.getQueryExecutionContext(ra_exe_unit_,
@@ -270,6 +433,7 @@ void ExecutionKernel::runImpl(Executor* executor,
                                                   compilation_result.output_columnar,
                                                   query_mem_desc.sortOnGpu(),
                                                   thread_idx,
+                                                  shared_cpu_group_by_buffer,
                                                   do_render ? render_info_ : nullptr);
     } catch (const OutOfHostMemory& e) {
       throw QueryExecutionError(Executor::ERR_OUT_OF_CPU_MEM);
@@ -278,7 +442,7 @@ void ExecutionKernel::runImpl(Executor* executor,
   QueryExecutionContext* query_exe_context{query_exe_context_owned.get()};
   CHECK(query_exe_context);
   int32_t err{0};
-  uint32_t start_rowid{0};
+  uint32_t start_rowid = zone_map_start_row;
   if (rowid_lookup_key >= 0) {
     if (!frag_list.empty()) {
       const auto& all_frag_row_offsets = shared_context.getFragOffsets();
@@ -287,6 +451,7 @@ void ExecutionKernel::runImpl(Executor* executor,
     }
   }
 
+  const auto kernel_clock_begin = timer_start();
   if (ra_exe_unit_.groupby_exprs.empty()) {
     err = executor->executePlanWithoutGroupBy(ra_exe_unit_,
                                               compilation_result,
@@ -328,6 +493,13 @@ void ExecutionKernel::runImpl(Executor* executor,
                                            eo.allow_runtime_query_interrupt,
                                            do_render ? render_info_ : nullptr);
   }
+  if (query_profile) {
+    query_profile->addKernelTime(
+        chosen_device_type,
+        chosen_device_id,
+        timer_stop<decltype(kernel_clock_begin), std::chrono::microseconds>(
+            kernel_clock_begin));
+  }
   if (device_results_) {
     std::list<std::shared_ptr<Chunk_NS::Chunk>> chunks_to_hold;
     for (const auto& chunk : chunks) {
@@ -343,5 +515,10 @@ void ExecutionKernel::runImpl(Executor* executor,
   if (err) {
     throw QueryExecutionError(err);
   }
+  if (query_mem_desc.useSharedCpuGroupByBuffer()) {
+    shared_context.addSharedCpuGroupByResults(std::move(device_results_),
+                                              outer_tab_frag_ids);
+    return;
+  }
   shared_context.addDeviceResults(std::move(device_results_), outer_tab_frag_ids);
 }
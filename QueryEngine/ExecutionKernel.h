@@ -16,9 +16,11 @@
 
 #pragma once
 
+#include "DataMgr/Chunk/ChunkPrefetcher.h"
 #include "Logger/Logger.h"
 #include "QueryEngine/ColumnFetcher.h"
 #include "QueryEngine/Descriptors/QueryCompilationDescriptor.h"
+#include "QueryEngine/QueryMemoryInitializer.h"
 
 class SharedKernelContext {
  public:
@@ -30,8 +32,20 @@ class SharedKernelContext {
   void addDeviceResults(ResultSetPtr&& device_results,
                         std::vector<size_t> outer_table_fragment_ids);
 
+  /**
+   * Registers the results of a kernel which ran against the group by buffer shared by
+   * all CPU kernels. The result sets of those kernels wrap the same storage, so only the
+   * first one is kept.
+   */
+  void addSharedCpuGroupByResults(ResultSetPtr&& device_results,
+                                  std::vector<size_t> outer_table_fragment_ids);
+
   std::vector<std::pair<ResultSetPtr, std::vector<size_t>>>& getFragmentResults();
 
+  SharedCpuGroupByBuffer* getSharedCpuGroupByBuffer() {
+    return &shared_cpu_group_by_buffer_;
+  }
+
   const std::vector<InputTableInfo>& getQueryInfos() const { return query_infos_; }
 
   std::atomic_flag dynamic_watchdog_set = ATOMIC_FLAG_INIT;
@@ -40,6 +54,8 @@ class SharedKernelContext {
   std::mutex reduce_mutex_;
   std::vector<std::pair<ResultSetPtr, std::vector<size_t>>> all_fragment_results_;
 
+  SharedCpuGroupByBuffer shared_cpu_group_by_buffer_;
+
   std::vector<uint64_t> all_frag_row_offsets_;
   std::mutex all_frag_row_offsets_mutex_;
   const std::vector<InputTableInfo>& query_infos_;
@@ -75,6 +91,29 @@ class ExecutionKernel {
            const size_t thread_idx,
            SharedKernelContext& shared_context);
 
+  ExecutorDeviceType getDeviceType() const { return chosen_device_type; }
+
+  ExecutorDispatchMode getDispatchMode() const { return kernel_dispatch_mode; }
+
+  int getOuterTableId() const {
+    CHECK(!frag_list.empty());
+    return frag_list.front().table_id;
+  }
+
+  /**
+   * Returns the number of outer table tuples scanned by this kernel. Used as a cost
+   * estimate when scheduling kernels over a fixed set of CPU workers.
+   */
+  size_t getOuterTupleCount(const std::vector<InputTableInfo>& query_infos) const;
+
+  // Returns the fragment id of the first outer table fragment, -1 if unknown.
+  int getOuterFragmentId(const std::vector<InputTableInfo>& query_infos) const;
+
+  // Returns the chunks of the outer table fragments this kernel reads.
+  std::vector<Chunk_NS::ChunkPrefetchRequest> getOuterChunkPrefetchRequests(
+      const Catalog_Namespace::Catalog& cat,
+      const std::vector<InputTableInfo>& query_infos) const;
+
  private:
   const RelAlgExecutionUnit& ra_exe_unit_;
   const ExecutorDeviceType chosen_device_type;
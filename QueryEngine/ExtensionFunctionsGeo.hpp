@@ -146,6 +146,91 @@ DEVICE ALWAYS_INLINE int32_t compressed_coord(const int8_t* data, const int32_t
   return compressed_coords[index];
 }
 
+// Coord accessor for the vertices of a ring or linestring which decompresses and
+// transforms the coords a batch at a time on CPU. The compression and transform checks
+// are hoisted out of the batch loops so that they vectorize, and walking the vertices in
+// order decodes each coord once. On GPU the coords are decoded on access instead, a batch
+// per thread would spill to local memory.
+class CoordDecoder {
+ public:
+  DEVICE CoordDecoder(const int8_t* data,
+                      const int64_t num_coords,
+                      const int32_t ic,
+                      const int32_t isr,
+                      const int32_t osr)
+      : data_(data), num_coords_(num_coords), ic_(ic), isr_(isr), osr_(osr) {}
+
+  // x coord at location index, index is even
+  DEVICE ALWAYS_INLINE double x(const int64_t index) {
+#ifdef __CUDACC__
+    return coord_x(data_, index, ic_, isr_, osr_);
+#else
+    return batchCoord(index);
+#endif
+  }
+
+  // y coord at location index, index is odd
+  DEVICE ALWAYS_INLINE double y(const int64_t index) {
+#ifdef __CUDACC__
+    return coord_y(data_, index, ic_, isr_, osr_);
+#else
+    return batchCoord(index);
+#endif
+  }
+
+ private:
+#ifndef __CUDACC__
+  // even, so that the coords of a batch start with an x coord
+  static constexpr int64_t kBatchCoords{128};
+
+  ALWAYS_INLINE double batchCoord(const int64_t index) {
+    if (UNLIKELY(index < batch_begin_ || index >= batch_end_)) {
+      decodeBatch(index);
+    }
+    return batch_[index - batch_begin_];
+  }
+
+  void decodeBatch(const int64_t index) {
+    batch_begin_ = index - index % kBatchCoords;
+    batch_end_ = batch_begin_ + kBatchCoords < num_coords_ ? batch_begin_ + kBatchCoords
+                                                           : num_coords_;
+    const auto batch_size = batch_end_ - batch_begin_;
+    if (ic_ == COMPRESSION_GEOINT32) {
+      const auto compressed_coords =
+          reinterpret_cast<const int32_t*>(data_) + batch_begin_;
+      // same products as the scalar decompression, the coords alternate x and y
+      const double scales[2] = {Geospatial::decompress_longitude_coord_geoint32(1),
+                                Geospatial::decompress_lattitude_coord_geoint32(1)};
+      for (int64_t i = 0; i < batch_size; ++i) {
+        batch_[i] = static_cast<double>(compressed_coords[i]) * scales[i & 1];
+      }
+    } else {
+      const auto double_coords = reinterpret_cast<const double*>(data_) + batch_begin_;
+      for (int64_t i = 0; i < batch_size; ++i) {
+        batch_[i] = double_coords[i];
+      }
+    }
+    if (isr_ == 4326 && osr_ == 900913) {
+      // WGS 84 --> Web Mercator
+      for (int64_t i = 0; i + 1 < batch_size; i += 2) {
+        batch_[i] = conv_4326_900913_x(batch_[i]);
+        batch_[i + 1] = conv_4326_900913_y(batch_[i + 1]);
+      }
+    }
+  }
+
+  double batch_[kBatchCoords];
+  int64_t batch_begin_{0};
+  int64_t batch_end_{0};
+#endif
+
+  const int8_t* data_;
+  const int64_t num_coords_;
+  const int32_t ic_;
+  const int32_t isr_;
+  const int32_t osr_;
+};
+
 // Cartesian distance between points, squared
 DEVICE ALWAYS_INLINE double distance_point_point_squared(double p1x,
                                                          double p1y,
@@ -539,18 +624,20 @@ DEVICE ALWAYS_INLINE bool point_in_polygon_winding_number(const int8_t* poly,
   constexpr bool include_point_on_edge =
       TEdgeBehavior == EdgeBehavior::kIncludePointOnEdge;
 
-  auto get_x_coord = [=](const auto data, const auto index) -> T {
+  CoordDecoder poly_coords(poly, poly_num_coords, ic1, isr1, osr);
+
+  auto get_x_coord = [&](const auto data, const auto index) -> T {
     if constexpr (std::is_floating_point<T>::value) {
-      return coord_x(data, index, ic1, isr1, osr);
+      return poly_coords.x(index);
     } else {
       return compressed_coord(data, index);
     }
     return T{};  // https://stackoverflow.com/a/64561686/2700898
   };
 
-  auto get_y_coord = [=](const auto data, const auto index) -> T {
+  auto get_y_coord = [&](const auto data, const auto index) -> T {
     if constexpr (std::is_floating_point<T>::value) {
-      return coord_y(data, index, ic1, isr1, osr);
+      return poly_coords.y(index);
     } else {
       return compressed_coord(data, index);
     }
@@ -673,11 +760,12 @@ DEVICE ALWAYS_INLINE bool polygon_contains_point(const int8_t* poly,
   bool horizontal_edge = false;
   bool yray_intersects = false;
 
-  double e1x = coord_x(poly, poly_num_coords - 2, ic1, isr1, osr);
-  double e1y = coord_y(poly, poly_num_coords - 1, ic1, isr1, osr);
+  CoordDecoder poly_coords(poly, poly_num_coords, ic1, isr1, osr);
+  double e1x = poly_coords.x(poly_num_coords - 2);
+  double e1y = poly_coords.y(poly_num_coords - 1);
   for (int64_t i = 0; i < poly_num_coords; i += 2) {
-    double e2x = coord_x(poly, i, ic1, isr1, osr);
-    double e2y = coord_y(poly, i + 1, ic1, isr1, osr);
+    double e2x = poly_coords.x(i);
+    double e2y = poly_coords.y(i + 1);
 
     // Check if point sits on an edge.
     if (tol_zero(distance_point_line(px, py, e1x, e1y, e2x, e2y))) {
@@ -1756,18 +1844,19 @@ DEVICE ALWAYS_INLINE double distance_point_linestring(int8_t* p,
   double py = coord_y(p, 1, ic1, isr1, osr);
 
   auto l_num_coords = lsize / compression_unit_size(ic2);
+  CoordDecoder l_coords(l, l_num_coords, ic2, isr2, osr);
 
-  double l1x = coord_x(l, 0, ic2, isr2, osr);
-  double l1y = coord_y(l, 1, ic2, isr2, osr);
-  double l2x = coord_x(l, 2, ic2, isr2, osr);
-  double l2y = coord_y(l, 3, ic2, isr2, osr);
+  double l1x = l_coords.x(0);
+  double l1y = l_coords.y(1);
+  double l2x = l_coords.x(2);
+  double l2y = l_coords.y(3);
 
   double dist = distance_point_line(px, py, l1x, l1y, l2x, l2y);
   for (int32_t i = 4; i < l_num_coords; i += 2) {
     l1x = l2x;  // advance one point
     l1y = l2y;
-    l2x = coord_x(l, i, ic2, isr2, osr);
-    l2y = coord_y(l, i + 1, ic2, isr2, osr);
+    l2x = l_coords.x(i);
+    l2y = l_coords.y(i + 1);
     double ldist = distance_point_line(px, py, l1x, l1y, l2x, l2y);
     if (dist > ldist) {
       dist = ldist;
@@ -2979,18 +3068,19 @@ DEVICE ALWAYS_INLINE double max_distance_point_linestring(int8_t* p,
   double py = coord_y(p, 1, ic1, isr1, osr);
 
   auto l_num_coords = lsize / compression_unit_size(ic2);
+  CoordDecoder l_coords(l, l_num_coords, ic2, isr2, osr);
 
-  double l1x = coord_x(l, 0, ic2, isr2, osr);
-  double l1y = coord_y(l, 1, ic2, isr2, osr);
-  double l2x = coord_x(l, 2, ic2, isr2, osr);
-  double l2y = coord_y(l, 3, ic2, isr2, osr);
+  double l1x = l_coords.x(0);
+  double l1y = l_coords.y(1);
+  double l2x = l_coords.x(2);
+  double l2y = l_coords.y(3);
 
   double max_dist = max_distance_point_line(px, py, l1x, l1y, l2x, l2y);
   for (int32_t i = 4; i < l_num_coords; i += 2) {
     l1x = l2x;  // advance one point
     l1y = l2y;
-    l2x = coord_x(l, i, ic2, isr2, osr);
-    l2y = coord_y(l, i + 1, ic2, isr2, osr);
+    l2x = l_coords.x(i);
+    l2y = l_coords.y(i + 1);
     double ldist = max_distance_point_line(px, py, l1x, l1y, l2x, l2y);
     if (max_dist < ldist) {
       max_dist = ldist;
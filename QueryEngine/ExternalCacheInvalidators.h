@@ -28,16 +28,26 @@
 #include "JoinHashTable/BaselineJoinHashTable.h"
 #include "JoinHashTable/OverlapsJoinHashTable.h"
 #include "JoinHashTable/PerfectJoinHashTable.h"
+#include "LinearizedColumnCache.h"
+#include "QueryResultCache.h"
+#include "ResultSetRecycler.h"
 
-using UpdateTriggeredCacheInvalidator =
-    CacheInvalidator<OverlapsJoinHashTable, BaselineJoinHashTable, PerfectJoinHashTable>;
+using UpdateTriggeredCacheInvalidator = CacheInvalidator<OverlapsJoinHashTable,
+                                                         BaselineJoinHashTable,
+                                                         PerfectJoinHashTable,
+                                                         LinearizedColumnCache,
+                                                         QueryResultCache,
+                                                         ResultSetRecycler>;
 using DeleteTriggeredCacheInvalidator = UpdateTriggeredCacheInvalidator;
 
-// Note that this is functionally the same as the above two invalidators. The
-// JoinHashTableCacheInvalidator is a generic invalidator used during `clear_cpu` calls.
-// The above cache invalidators are specific invalidators called during update/delete and
-// will likely be extended in the future.
-using JoinHashTableCacheInvalidator =
-    CacheInvalidator<OverlapsJoinHashTable, BaselineJoinHashTable, PerfectJoinHashTable>;
+// Note that this clears the join hash tables and the linearized columns cleared by the
+// above two invalidators. The JoinHashTableCacheInvalidator is a generic invalidator
+// used during `clear_cpu` calls, which leave query results intact. The above cache
+// invalidators are specific invalidators called during update/delete, which also clear
+// the cached query results and the recycled result sets.
+using JoinHashTableCacheInvalidator = CacheInvalidator<OverlapsJoinHashTable,
+                                                       BaselineJoinHashTable,
+                                                       PerfectJoinHashTable,
+                                                       LinearizedColumnCache>;
 
 #endif
@@ -16,13 +16,18 @@
 
 #include "FromTableReordering.h"
 #include "../Analyzer/Analyzer.h"
+#include "DataMgr/ColumnStats.h"
 #include "Execute.h"
 #include "RangeTableIndexVisitor.h"
 
+#include <limits>
 #include <numeric>
+#include <optional>
 #include <queue>
 #include <regex>
 
+bool g_enable_cost_based_join_ordering{false};
+
 namespace {
 
 using cost_t = unsigned;
@@ -248,12 +253,241 @@ std::vector<node_t> traverse_join_cost_graph(
   return input_permutation;
 }
 
+const Analyzer::ColumnVar* get_join_key_column(const Analyzer::Expr* expr) {
+  const auto uoper = dynamic_cast<const Analyzer::UOper*>(expr);
+  if (uoper && uoper->get_optype() == kCAST) {
+    expr = uoper->get_operand();
+  }
+  return dynamic_cast<const Analyzer::ColumnVar*>(expr);
+}
+
+// Returns the pairs of columns compared by an equi join qualifier, one pair per
+// component of the key, or nothing if the qualifier isn't an equi join of columns.
+std::vector<std::pair<const Analyzer::ColumnVar*, const Analyzer::ColumnVar*>>
+get_equi_join_columns(const Analyzer::Expr* qual) {
+  const auto bin_oper = dynamic_cast<const Analyzer::BinOper*>(qual);
+  if (!bin_oper || !IS_EQUIVALENCE(bin_oper->get_optype())) {
+    return {};
+  }
+  std::vector<const Analyzer::Expr*> lhs_keys{bin_oper->get_left_operand()};
+  std::vector<const Analyzer::Expr*> rhs_keys{bin_oper->get_right_operand()};
+  const auto lhs_tuple = dynamic_cast<const Analyzer::ExpressionTuple*>(lhs_keys.front());
+  const auto rhs_tuple = dynamic_cast<const Analyzer::ExpressionTuple*>(rhs_keys.front());
+  if (lhs_tuple || rhs_tuple) {
+    if (!lhs_tuple || !rhs_tuple ||
+        lhs_tuple->getTuple().size() != rhs_tuple->getTuple().size()) {
+      return {};
+    }
+    lhs_keys.clear();
+    rhs_keys.clear();
+    for (size_t i = 0; i < lhs_tuple->getTuple().size(); ++i) {
+      lhs_keys.push_back(lhs_tuple->getTuple()[i].get());
+      rhs_keys.push_back(rhs_tuple->getTuple()[i].get());
+    }
+  }
+  std::vector<std::pair<const Analyzer::ColumnVar*, const Analyzer::ColumnVar*>> columns;
+  for (size_t i = 0; i < lhs_keys.size(); ++i) {
+    const auto lhs_col = get_join_key_column(lhs_keys[i]);
+    const auto rhs_col = get_join_key_column(rhs_keys[i]);
+    if (!lhs_col || !rhs_col) {
+      return {};
+    }
+    columns.emplace_back(lhs_col, rhs_col);
+  }
+  return columns;
+}
+
+double get_num_tuples_estimate(const InputTableInfo& table_info) {
+  return std::max(table_info.info.getNumTuplesUpperBound(), size_t(1));
+}
+
+// Estimate of the number of distinct values of a join key column, from the value range
+// of its chunks, the distinct values of their value indexed zone map blocks and their
+// column stats sketches. Falls back to the number of tuples when the chunks have no
+// usable statistics.
+double get_distinct_values_estimate(const Analyzer::ColumnVar* col_var,
+                                    const std::vector<InputTableInfo>& table_infos) {
+  const auto nest_level = col_var->get_rte_idx();
+  CHECK_GE(nest_level, 0);
+  CHECK_LT(static_cast<size_t>(nest_level), table_infos.size());
+  const auto& table_info = table_infos[nest_level];
+  const auto num_tuples = get_num_tuples_estimate(table_info);
+  const auto& col_ti = col_var->get_type_info();
+  if (!col_ti.is_integer() && !col_ti.is_decimal() && !col_ti.is_time() &&
+      !col_ti.is_boolean() && !col_ti.is_dict_encoded_string()) {
+    return num_tuples;
+  }
+  const auto& fragments = table_info.info.fragments;
+  if (fragments.empty()) {
+    return num_tuples;
+  }
+  int64_t min = std::numeric_limits<int64_t>::max();
+  int64_t max = std::numeric_limits<int64_t>::min();
+  double block_distinct_values{0};
+  bool all_blocks_indexed{true};
+  ColumnStats column_stats;
+  bool all_column_stats{true};
+  for (const auto& fragment : fragments) {
+    // Result sets only get metadata by scanning their rows, don't synthesize it here.
+    const auto& chunk_metadata_map = fragment.getChunkMetadataMapPhysical();
+    const auto chunk_metadata_it = chunk_metadata_map.find(col_var->get_column_id());
+    if (fragment.resultSet || chunk_metadata_it == chunk_metadata_map.end()) {
+      return num_tuples;
+    }
+    const auto& chunk_metadata = *chunk_metadata_it->second;
+    if (chunk_metadata.sqlType.get_type() != col_ti.get_type() ||
+        chunk_metadata.sqlType.get_compression() != col_ti.get_compression()) {
+      return num_tuples;
+    }
+    if (!chunk_metadata.numElements) {
+      continue;
+    }
+    const auto& chunk_ti = chunk_metadata.sqlType;
+    min = std::min(min, extract_min_stat(chunk_metadata.chunkStats, chunk_ti));
+    max = std::max(max, extract_max_stat(chunk_metadata.chunkStats, chunk_ti));
+    if (chunk_metadata.columnStats) {
+      column_stats.merge(*chunk_metadata.columnStats);
+    } else {
+      all_column_stats = false;
+    }
+    const auto& block_zone_maps = chunk_metadata.blockZoneMaps;
+    if (!all_blocks_indexed || !block_zone_maps || block_zone_maps->blocks.empty()) {
+      all_blocks_indexed = false;
+      continue;
+    }
+    for (const auto& block : block_zone_maps->blocks) {
+      if (!block.values) {
+        all_blocks_indexed = false;
+        break;
+      }
+      block_distinct_values += block.values->size();
+    }
+  }
+  if (min > max) {
+    // Only nulls, which never match.
+    return 1;
+  }
+  auto distinct_values =
+      std::min(num_tuples, static_cast<double>(max) - static_cast<double>(min) + 1);
+  if (all_blocks_indexed) {
+    distinct_values = std::min(distinct_values, block_distinct_values);
+  }
+  if (all_column_stats && column_stats.num_values) {
+    distinct_values = std::min(distinct_values, column_stats.getDistinctValuesEstimate());
+  }
+  return std::max(distinct_values, 1.0);
+}
+
+// Builds a graph with nesting levels as nodes and the selectivity of the join
+// qualifiers between them as edges, estimated as 1 / max(NDV(lhs), NDV(rhs)) for each
+// equi join key and 1 for other qualifiers.
+std::vector<std::map<node_t, double>> build_join_selectivity_graph(
+    const JoinQualsPerNestingLevel& left_deep_join_quals,
+    const std::vector<InputTableInfo>& table_infos) {
+  CHECK_EQ(left_deep_join_quals.size() + 1, table_infos.size());
+  std::vector<std::map<node_t, double>> join_selectivity_graph(table_infos.size());
+  AllRangeTableIndexVisitor visitor;
+  for (const auto& current_level_join_conditions : left_deep_join_quals) {
+    for (const auto& qual : current_level_join_conditions.quals) {
+      const auto qual_nest_levels = visitor.visit(qual.get());
+      if (qual_nest_levels.size() != 2) {
+        continue;
+      }
+      const auto lhs_nest_level = *qual_nest_levels.begin();
+      const auto rhs_nest_level = *qual_nest_levels.rbegin();
+      CHECK_GE(lhs_nest_level, 0);
+      double selectivity{1};
+      for (const auto& [lhs_col, rhs_col] : get_equi_join_columns(qual.get())) {
+        if (lhs_col->get_rte_idx() == rhs_col->get_rte_idx()) {
+          continue;
+        }
+        selectivity /= std::max(get_distinct_values_estimate(lhs_col, table_infos),
+                                get_distinct_values_estimate(rhs_col, table_infos));
+      }
+      join_selectivity_graph[lhs_nest_level].emplace(rhs_nest_level, 1).first->second *=
+          selectivity;
+      join_selectivity_graph[rhs_nest_level].emplace(lhs_nest_level, 1).first->second *=
+          selectivity;
+    }
+  }
+  return join_selectivity_graph;
+}
+
+// Greedy cost based ordering: the largest table is the outer one, which is scanned
+// rather than built into a hash table, then each step joins the table connected to the
+// tables already joined which yields the fewest estimated rows. Tables without a
+// qualifier to the joined ones are only picked when no other is ready, as they would
+// make a cross join.
+std::vector<node_t> get_cost_based_input_permutation(
+    const JoinQualsPerNestingLevel& left_deep_join_quals,
+    const std::vector<InputTableInfo>& table_infos) {
+  const auto join_selectivity_graph =
+      build_join_selectivity_graph(left_deep_join_quals, table_infos);
+  std::vector<std::map<node_t, cost_t>> join_cost_graph(table_infos.size());
+  auto dependency_tracking =
+      build_dependency_tracking(left_deep_join_quals, join_cost_graph);
+  std::vector<node_t> input_permutation;
+  std::vector<bool> visited(table_infos.size(), false);
+  double joined_rows{0};
+  while (input_permutation.size() < table_infos.size()) {
+    const auto nodes_ready = dependency_tracking.getRoots();
+    std::optional<node_t> best_node;
+    bool best_connected{false};
+    double best_rows{0};
+    for (node_t node = 0; node < table_infos.size(); ++node) {
+      if (visited[node] || !nodes_ready.count(node)) {
+        continue;
+      }
+      const auto node_rows = get_num_tuples_estimate(table_infos[node]);
+      bool connected = input_permutation.empty();
+      double rows = node_rows;
+      if (!input_permutation.empty()) {
+        double selectivity{1};
+        for (const auto& [succ, succ_selectivity] : join_selectivity_graph[node]) {
+          if (visited[succ]) {
+            selectivity *= succ_selectivity;
+            connected = true;
+          }
+        }
+        rows = joined_rows * node_rows * selectivity;
+      }
+      bool better{false};
+      if (!best_node || connected != best_connected) {
+        better = !best_node || connected;
+      } else if (input_permutation.empty()) {
+        better = rows > best_rows;
+      } else if (rows != best_rows) {
+        better = rows < best_rows;
+      } else {
+        // Smaller inner tables make for cheaper hash table builds.
+        better = node_rows < get_num_tuples_estimate(table_infos[*best_node]);
+      }
+      if (better) {
+        best_node = node;
+        best_connected = connected;
+        best_rows = rows;
+      }
+    }
+    CHECK(best_node);
+    VLOG(2) << "Table reordering picked nest level " << *best_node
+            << " with estimated rows " << best_rows;
+    input_permutation.push_back(*best_node);
+    visited[*best_node] = true;
+    dependency_tracking.removeNode(*best_node);
+    joined_rows = std::max(best_rows, 1.0);
+  }
+  return input_permutation;
+}
+
 }  // namespace
 
 std::vector<node_t> get_node_input_permutation(
     const JoinQualsPerNestingLevel& left_deep_join_quals,
     const std::vector<InputTableInfo>& table_infos,
     const Executor* executor) {
+  if (g_enable_cost_based_join_ordering) {
+    return get_cost_based_input_permutation(left_deep_join_quals, table_infos);
+  }
   const auto join_cost_graph =
       build_join_cost_graph(left_deep_join_quals, table_infos, executor);
   // Use the number of tuples in each table to break ties in BFS.
@@ -19,7 +19,11 @@
 #include "InputMetadata.h"
 #include "RelAlgExecutionUnit.h"
 
-// Returns a FROM permutation for the given join qualifiers and table sizes.
+// Order the joined tables with a cost model based on the table and column statistics.
+extern bool g_enable_cost_based_join_ordering;
+
+// Returns a FROM permutation for the given join qualifiers and table sizes, and the
+// column statistics of the tables if g_enable_cost_based_join_ordering is set.
 std::vector<size_t> get_node_input_permutation(
     const JoinQualsPerNestingLevel& left_deep_join_quals,
     const std::vector<InputTableInfo>& table_infos,
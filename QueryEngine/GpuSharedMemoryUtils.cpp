@@ -77,12 +77,8 @@ void GpuSharedMemCodeBuilder::codegen() {
  * 2. We assign each thread to a specific entry (all targets within that entry), so any
  * thread with an index larger than max entries, will have an early return from this
  * function
- * 3. It is assumed here that there are at least as many threads in the GPU as there are
- * entries in the group by buffer. In practice, given the buffer sizes that we deal with,
- * this is a reasonable asumption, but can be easily relaxed in the future if needed to:
- * threads can form a loop and process all entries until all are finished. It should be
- * noted that we currently don't use shared memory if there are more entries than number
- * of threads.
+ * 3. If there are more entries than threads in the block, each thread loops over the
+ * entries with a stride of the block size, until all are finished.
  * 4. We loop over all slots corresponding to a specific entry, and use
  * ResultSetReductionJIT's reduce_one_entry_idx to reduce one slot from the destination
  * buffer into source buffer. The only difference is that we should replace all agg_*
@@ -114,6 +110,8 @@ void GpuSharedMemCodeBuilder::codegenReduction() {
 
   const auto func_thread_index = getFunction("get_thread_index");
   const auto thread_idx = ir_builder.CreateCall(func_thread_index, {}, "thread_index");
+  const auto func_block_dim = getFunction("get_block_dim");
+  const auto block_dim = ir_builder.CreateCall(func_block_dim, {}, "block_dim");
 
   // branching out of out of bound:
   const auto entry_count = ll_int(query_mem_desc_.getEntryCount(), context_);
@@ -124,6 +122,8 @@ void GpuSharedMemCodeBuilder::codegenReduction() {
   ir_builder.CreateCondBr(is_thread_inbound, bb_body, bb_exit);
 
   ir_builder.SetInsertPoint(bb_body);
+  auto entry_idx = ir_builder.CreatePHI(thread_idx->getType(), 2, "entry_idx");
+  entry_idx->addIncoming(thread_idx, bb_entry);
 
   // cast src/dest buffers into byte streams:
   auto src_byte_stream = ir_builder.CreatePointerCast(
@@ -187,18 +187,22 @@ void GpuSharedMemCodeBuilder::codegenReduction() {
   // disable for current shared memory support.
   const auto null_ptr_ll =
       llvm::ConstantPointerNull::get(llvm::Type::getInt8PtrTy(context_, 0));
-  const auto thread_idx_i32 = ir_builder.CreateCast(
-      llvm::Instruction::CastOps::Trunc, thread_idx, get_int_type(32, context_));
+  const auto entry_idx_i32 = ir_builder.CreateCast(
+      llvm::Instruction::CastOps::Trunc, entry_idx, get_int_type(32, context_));
   ir_builder.CreateCall(reduce_one_entry_idx_func,
                         {dest_byte_stream,
                          src_byte_stream,
-                         thread_idx_i32,
+                         entry_idx_i32,
                          entry_count_i32,
                          null_ptr_ll,
                          null_ptr_ll,
                          null_ptr_ll},
                         "");
-  ir_builder.CreateBr(bb_exit);
+  const auto next_entry_idx = ir_builder.CreateAdd(entry_idx, block_dim, "next_entry");
+  entry_idx->addIncoming(next_entry_idx, ir_builder.GetInsertBlock());
+  ir_builder.CreateCondBr(ir_builder.CreateICmpSLT(next_entry_idx, entry_count),
+                          bb_body,
+                          bb_exit);
   llvm::ReturnInst::Create(context_, bb_exit);
 }
 
@@ -237,9 +241,9 @@ llvm::Value* codegen_smem_dest_slot_ptr(llvm::LLVMContext& context,
 /**
  * This function generates code to initialize the shared memory buffer, the way we
  * initialize the group by output buffer on the host. Similar to the reduction function,
- * it is assumed that there are at least as many threads as there are entries in the
- * buffer. Each entry is assigned to a single thread, and then all slots corresponding to
- * that entry are initialized with aggregate init values.
+ * each entry is assigned to a single thread, looping with a stride of the block size
+ * when there are more entries than threads, and then all slots corresponding to that
+ * entry are initialized with aggregate init values.
  */
 void GpuSharedMemCodeBuilder::codegenInitialization() {
   CHECK(init_func_);
@@ -263,15 +267,20 @@ void GpuSharedMemCodeBuilder::codegenInitialization() {
   const auto shared_mem_buffer =
       ir_builder.CreateCall(declare_smem_func, {}, "shared_mem_buffer");
 
+  const auto func_block_dim = getFunction("get_block_dim");
+  const auto block_dim = ir_builder.CreateCall(func_block_dim, {}, "block_dim");
+
   const auto entry_count = ll_int(fixup_query_mem_desc.getEntryCount(), context_);
   const auto is_thread_inbound =
       ir_builder.CreateICmpSLT(thread_idx, entry_count, "is_thread_inbound");
   ir_builder.CreateCondBr(is_thread_inbound, bb_body, bb_exit);
 
   ir_builder.SetInsertPoint(bb_body);
-  // compute byte offset assigned to this thread:
+  auto entry_idx = ir_builder.CreatePHI(thread_idx->getType(), 2, "entry_idx");
+  entry_idx->addIncoming(thread_idx, bb_entry);
+  // compute byte offset of the entry assigned to this thread:
   const auto row_size_bytes = ll_int(fixup_query_mem_desc.getRowWidth(), context_);
-  auto byte_offset_ll = ir_builder.CreateMul(row_size_bytes, thread_idx, "byte_offset");
+  auto byte_offset_ll = ir_builder.CreateMul(row_size_bytes, entry_idx, "byte_offset");
 
   const auto dest_byte_stream = ir_builder.CreatePointerCast(
       shared_mem_buffer, llvm::Type::getInt8PtrTy(context_), "dest_byte_stream");
@@ -315,7 +324,11 @@ void GpuSharedMemCodeBuilder::codegenInitialization() {
     }
   }
 
-  ir_builder.CreateBr(bb_exit);
+  const auto next_entry_idx = ir_builder.CreateAdd(entry_idx, block_dim, "next_entry");
+  entry_idx->addIncoming(next_entry_idx, ir_builder.GetInsertBlock());
+  ir_builder.CreateCondBr(ir_builder.CreateICmpSLT(next_entry_idx, entry_count),
+                          bb_body,
+                          bb_exit);
 
   ir_builder.SetInsertPoint(bb_exit);
   // synchronize all threads within a threadblock:
@@ -37,6 +37,7 @@
 #include "Execute.h"
 #include "QueryTemplateGenerator.h"
 #include "RuntimeFunctions.h"
+#include "SparseBitmap.h"
 #include "StreamingTopN.h"
 #include "TopKSort.h"
 #include "WindowContext.h"
@@ -51,6 +52,7 @@
 bool g_cluster{false};
 bool g_bigint_count{false};
 int g_hll_precision_bits{11};
+bool g_enable_count_distinct_sparse_bitmap{true};
 size_t g_watchdog_baseline_max_groups{120000000};
 extern size_t g_leaf_count;
 
@@ -558,6 +560,38 @@ KeylessInfo get_keyless_info(const RelAlgExecutionUnit& ra_exe_unit,
   };
 }
 
+// Picks a sparse bitmap over a std::set, which costs far more per value, and over a
+// dense bitmap when the argument cannot have more distinct values than the input rows
+// and those would only fill a small fraction of the bitmap of every group. The sparse
+// bitmap only runs on CPU, GPU queries keep their dense bitmaps.
+bool should_use_sparse_bitmap(const CountDistinctImplType count_distinct_impl_type,
+                              const int64_t bitmap_sz_bits,
+                              const std::vector<InputTableInfo>& query_infos,
+                              const ExecutorDeviceType device_type) {
+  if (count_distinct_impl_type == CountDistinctImplType::StdSet) {
+    return true;
+  }
+  if (count_distinct_impl_type != CountDistinctImplType::Bitmap ||
+      device_type != ExecutorDeviceType::CPU) {
+    return false;
+  }
+  // Below a single chunk of the sparse bitmap the dense one is as small.
+  constexpr int64_t kMinSparseBitmapBits{1 << 16};
+  // A dense bitmap spends this many bits per distinct value or more, the sparse one
+  // about 16.
+  constexpr int64_t kMinBitsPerValue{256};
+  if (bitmap_sz_bits < kMinSparseBitmapBits) {
+    return false;
+  }
+  size_t num_tuples_upper_bound{0};
+  for (const auto& query_info : query_infos) {
+    num_tuples_upper_bound =
+        std::max(num_tuples_upper_bound, query_info.info.getNumTuplesUpperBound());
+  }
+  return static_cast<double>(bitmap_sz_bits) / kMinBitsPerValue >
+         static_cast<double>(num_tuples_upper_bound);
+}
+
 CountDistinctDescriptors init_count_distinct_descriptors(
     const RelAlgExecutionUnit& ra_exe_unit,
     const std::vector<InputTableInfo>& query_infos,
@@ -629,6 +663,12 @@ CountDistinctDescriptors init_count_distinct_descriptors(
           !(arg_ti.is_array() || arg_ti.is_geometry())) {
         count_distinct_impl_type = CountDistinctImplType::Bitmap;
       }
+      if (g_enable_count_distinct_sparse_bitmap && agg_info.agg_kind == kCOUNT &&
+          !(arg_ti.is_fp() || arg_ti.is_buffer() || arg_ti.is_geometry()) &&
+          should_use_sparse_bitmap(
+              count_distinct_impl_type, bitmap_sz_bits, query_infos, device_type)) {
+        count_distinct_impl_type = CountDistinctImplType::SparseBitmap;
+      }
 
       if (g_enable_watchdog && !(arg_range_info.isEmpty()) &&
           count_distinct_impl_type == CountDistinctImplType::StdSet) {
@@ -1294,6 +1334,11 @@ GroupByAndAggregate::codegenMultiColumnBaselineHash(
   } else {
     func_args.push_back(LL_INT(row_size_quad));
   }
+  if (query_mem_desc.useSharedCpuGroupByBuffer()) {
+    CHECK(co.device_type == ExecutorDeviceType::CPU);
+    CHECK(!query_mem_desc.didOutputColumnar());
+    func_name += "_atomic";
+  }
   if (co.with_dynamic_watchdog) {
     func_name += "_with_watchdog";
   }
@@ -1412,7 +1457,9 @@ llvm::Value* GroupByAndAggregate::codegenWindowRowPointer(
   AUTOMATIC_IR_METADATA(executor_->cgen_state_.get());
   const auto window_func_context =
       WindowProjectNodeContext::getActiveWindowFunctionContext(executor_);
-  if (window_func_context && window_function_is_aggregate(window_func->getKind())) {
+  // framed aggregates are already in row order, like the rank functions
+  if (window_func_context && window_function_is_aggregate(window_func->getKind()) &&
+      !window_func->getFrame()) {
     const int32_t row_size_quad = query_mem_desc.didOutputColumnar()
                                       ? 0
                                       : query_mem_desc.getRowSize() / sizeof(int64_t);
@@ -1614,6 +1661,20 @@ extern "C" RUNTIME_EXPORT void agg_count_distinct_skip_val(int64_t* agg,
   }
 }
 
+extern "C" RUNTIME_EXPORT void agg_count_distinct_sparse_bitmap(int64_t* agg,
+                                                                const int64_t val) {
+  reinterpret_cast<SparseBitmap*>(*agg)->insert(val);
+}
+
+extern "C" RUNTIME_EXPORT void agg_count_distinct_sparse_bitmap_skip_val(
+    int64_t* agg,
+    const int64_t val,
+    const int64_t skip_val) {
+  if (val != skip_val) {
+    agg_count_distinct_sparse_bitmap(agg, val);
+  }
+}
+
 extern "C" RUNTIME_EXPORT void agg_approx_quantile(int64_t* agg, const double val) {
   auto* t_digest = reinterpret_cast<quantile::TDigest*>(*agg);
   t_digest->allocate();
@@ -1655,6 +1716,9 @@ void GroupByAndAggregate::codegenCountDistinct(
   if (count_distinct_descriptor.impl_type_ == CountDistinctImplType::Bitmap) {
     agg_fname += "_bitmap";
     agg_args.push_back(LL_INT(static_cast<int64_t>(count_distinct_descriptor.min_val)));
+  } else if (count_distinct_descriptor.impl_type_ ==
+             CountDistinctImplType::SparseBitmap) {
+    agg_fname += "_sparse_bitmap";
   }
   if (agg_info.skip_null_val) {
     auto null_lv = executor_->cgen_state_->castToTypeIn(
@@ -43,6 +43,8 @@
 
 extern bool g_enable_smem_group_by;
 extern bool g_bigint_count;
+// Use sparse bitmaps for COUNT(DISTINCT) over wide or sparsely populated ranges on CPU.
+extern bool g_enable_count_distinct_sparse_bitmap;
 
 struct ColRangeInfo {
   QueryDescriptionType hash_type_;
@@ -289,6 +289,20 @@ hash_join_idx(int64_t hash_buff,
   return -1;
 }
 
+extern "C" RUNTIME_EXPORT ALWAYS_INLINE DEVICE int64_t
+sparse_hash_join_idx(int64_t hash_buff,
+                     const int64_t key,
+                     const int64_t min_key,
+                     const int64_t max_key,
+                     const int64_t bitmap_word_count) {
+  if (key >= min_key && key <= max_key) {
+    const auto slot = SUFFIX(get_sparse_hash_slot)(
+        reinterpret_cast<int32_t*>(hash_buff), key, min_key, bitmap_word_count);
+    return slot ? *slot : -1;
+  }
+  return -1;
+}
+
 extern "C" RUNTIME_EXPORT ALWAYS_INLINE DEVICE int64_t
 bucketized_hash_join_idx_nullable(int64_t hash_buff,
                                   const int64_t key,
@@ -310,6 +324,18 @@ hash_join_idx_nullable(int64_t hash_buff,
   return key != null_val ? hash_join_idx(hash_buff, key, min_key, max_key) : -1;
 }
 
+extern "C" RUNTIME_EXPORT ALWAYS_INLINE DEVICE int64_t
+sparse_hash_join_idx_nullable(int64_t hash_buff,
+                              const int64_t key,
+                              const int64_t min_key,
+                              const int64_t max_key,
+                              const int64_t bitmap_word_count,
+                              const int64_t null_val) {
+  return key != null_val
+             ? sparse_hash_join_idx(hash_buff, key, min_key, max_key, bitmap_word_count)
+             : -1;
+}
+
 extern "C" RUNTIME_EXPORT ALWAYS_INLINE DEVICE int64_t
 bucketized_hash_join_idx_bitwise(int64_t hash_buff,
                                  const int64_t key,
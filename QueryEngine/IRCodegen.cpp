@@ -18,12 +18,14 @@
 #include "CodeGenerator.h"
 #include "Execute.h"
 #include "ExternalExecutor.h"
+#include "JoinHashTable/RangeJoinHashTable.h"
 #include "MaxwellCodegenPatch.h"
 #include "RelAlgTranslator.h"
 
 // Driver methods for the IR generation.
 
 extern bool g_enable_left_join_filter_hoisting;
+extern bool g_join_key_range_fragment_skipping;
 
 std::vector<llvm::Value*> CodeGenerator::codegen(const Analyzer::Expr* expr,
                                                  const bool fetch_columns,
@@ -295,6 +297,7 @@ std::vector<JoinLoop> Executor::buildJoinLoops(
   INJECT_TIMER(buildJoinLoops);
   AUTOMATIC_IR_METADATA(cgen_state_.get());
   std::vector<JoinLoop> join_loops;
+  plan_state_->innermost_inner_loop_join_ = false;
   for (size_t level_idx = 0, current_hash_table_idx = 0;
        level_idx < ra_exe_unit.join_quals.size();
        ++level_idx) {
@@ -357,7 +360,11 @@ std::vector<JoinLoop> Executor::buildJoinLoops(
     if (current_level_hash_table) {
       const auto hoisted_filters_cb = buildHoistLeftHandSideFiltersCb(
           ra_exe_unit, level_idx, current_level_hash_table->getInnerTableId(), co);
-      if (current_level_hash_table->getHashType() == HashType::OneToOne) {
+      const bool is_semi_or_anti_join =
+          current_level_join_conditions.type == JoinType::SEMI ||
+          current_level_join_conditions.type == JoinType::ANTI;
+      if (current_level_hash_table->getHashType() == HashType::OneToOne ||
+          is_semi_or_anti_join) {
         join_loops.emplace_back(
             /*kind=*/JoinLoopKind::Singleton,
             /*type=*/current_level_join_conditions.type,
@@ -366,8 +373,21 @@ std::vector<JoinLoop> Executor::buildJoinLoops(
                 const std::vector<llvm::Value*>& prev_iters) {
               addJoinLoopIterator(prev_iters, level_idx);
               JoinLoopDomain domain{{0}};
-              domain.slot_lookup_result =
-                  current_level_hash_table->codegenSlot(co, current_hash_table_idx);
+              if (current_level_hash_table->getHashType() == HashType::OneToOne) {
+                domain.slot_lookup_result =
+                    current_level_hash_table->codegenSlot(co, current_hash_table_idx);
+                return domain;
+              }
+              // Semi and anti joins never read the inner row, they only need to know
+              // whether there is a match. Stop at the first one.
+              const auto matching_set = current_level_hash_table->codegenMatchingSet(
+                  co, current_hash_table_idx);
+              domain.slot_lookup_result = cgen_state_->ir_builder_.CreateSelect(
+                  cgen_state_->ir_builder_.CreateICmpSGT(
+                      cgen_state_->castToTypeIn(matching_set.count, 64),
+                      cgen_state_->llInt(int64_t(0))),
+                  cgen_state_->llInt(int64_t(0)),
+                  cgen_state_->llInt(int64_t(-1)));
               return domain;
             },
             /*outer_condition_match=*/nullptr,
@@ -407,12 +427,21 @@ std::vector<JoinLoop> Executor::buildJoinLoops(
       const auto fail_reasons_str = current_level_join_conditions.quals.empty()
                                         ? "No equijoin expression found"
                                         : boost::algorithm::join(fail_reasons, " | ");
+      if (current_level_join_conditions.type == JoinType::SEMI ||
+          current_level_join_conditions.type == JoinType::ANTI) {
+        throw std::runtime_error("Semi and anti joins require a hash table: " +
+                                 fail_reasons_str);
+      }
       check_if_loop_join_is_allowed(
           ra_exe_unit, eo, query_infos, level_idx, fail_reasons_str);
       // Callback provided to the `JoinLoop` framework to evaluate the (outer) join
       // condition.
       VLOG(1) << "Unable to build hash table, falling back to loop join: "
               << fail_reasons_str;
+      if (level_idx + 1 == ra_exe_unit.join_quals.size()) {
+        plan_state_->innermost_inner_loop_join_ =
+            current_level_join_conditions.type == JoinType::INNER;
+      }
       const auto outer_join_condition_cb =
           [this, level_idx, &co, &current_level_join_conditions](
               const std::vector<llvm::Value*>& prev_iters) {
@@ -710,6 +739,11 @@ std::shared_ptr<HashJoin> Executor::buildCurrentLevelHashTable(
     if (hash_table_or_error.hash_table) {
       plan_state_->join_info_.join_hash_tables_.push_back(hash_table_or_error.hash_table);
       plan_state_->join_info_.equi_join_tautologies_.push_back(qual_bin_oper);
+      if (g_join_key_range_fragment_skipping) {
+        auto range_quals = hash_table_or_error.hash_table->getOuterKeyRangeQuals();
+        plan_state_->join_info_.outer_key_range_quals_.splice(
+            plan_state_->join_info_.outer_key_range_quals_.end(), range_quals);
+      }
     } else {
       fail_reasons.push_back(hash_table_or_error.fail_reason);
       if (current_level_join_conditions.type == JoinType::INNER ||
@@ -719,6 +753,29 @@ std::shared_ptr<HashJoin> Executor::buildCurrentLevelHashTable(
       }
     }
   }
+  if (!current_level_hash_table && g_enable_range_joins &&
+      current_level_join_conditions.type == JoinType::INNER) {
+    // The quals were added to the filters above, the range join table only narrows the
+    // inner rows they are evaluated on.
+    const auto memory_level = co.device_type == ExecutorDeviceType::GPU
+                                  ? MemoryLevel::GPU_LEVEL
+                                  : MemoryLevel::CPU_LEVEL;
+    try {
+      current_level_hash_table =
+          RangeJoinHashTable::getInstance(current_level_join_conditions.quals,
+                                          query_infos,
+                                          memory_level,
+                                          deviceCountForMemoryLevel(memory_level),
+                                          column_cache,
+                                          this);
+    } catch (const HashJoinFail& e) {
+      fail_reasons.emplace_back(e.what());
+    }
+    if (current_level_hash_table) {
+      plan_state_->join_info_.join_hash_tables_.push_back(current_level_hash_table);
+      plan_state_->join_info_.equi_join_tautologies_.push_back(nullptr);
+    }
+  }
   return current_level_hash_table;
 }
 
@@ -929,6 +986,20 @@ Executor::GroupColLLVMValue Executor::groupByColumnCodegen(
                   {group_key,
                    code_generator.posArg(arr_expr),
                    cgen_state_->llInt(log2_bytes(elem_ti.get_logical_size()))});
+    const auto ar_ret_ty =
+        elem_ti.is_fp()
+            ? (elem_ti.get_type() == kDOUBLE
+                   ? llvm::Type::getDoubleTy(cgen_state_->context_)
+                   : llvm::Type::getFloatTy(cgen_state_->context_))
+            : get_int_type(elem_ti.get_logical_size() * 8, cgen_state_->context_);
+    // Locate the array once, the loop reads the elements straight from the buffer
+    // rather than decoding the chunk iterator again for each of them.
+    const auto array_buff = cgen_state_->ir_builder_.CreatePointerCast(
+        cgen_state_->emitExternalCall("array_buff",
+                                      llvm::Type::getInt8PtrTy(cgen_state_->context_),
+                                      {group_key, code_generator.posArg(arr_expr)}),
+        llvm::PointerType::get(ar_ret_ty, 0),
+        "array_buff");
     cgen_state_->ir_builder_.CreateBr(array_loop_head);
     cgen_state_->ir_builder_.SetInsertPoint(array_loop_head);
     CHECK(array_len);
@@ -945,23 +1016,8 @@ Executor::GroupColLLVMValue Executor::groupByColumnCodegen(
     cgen_state_->ir_builder_.CreateStore(
         cgen_state_->ir_builder_.CreateAdd(array_idx, cgen_state_->llInt(int32_t(1))),
         array_idx_ptr);
-    auto array_at_fname = "array_at_" + numeric_type_name(elem_ti);
-    if (array_ti.get_size() < 0) {
-      if (array_ti.get_notnull()) {
-        array_at_fname = "notnull_" + array_at_fname;
-      }
-      array_at_fname = "varlen_" + array_at_fname;
-    }
-    const auto ar_ret_ty =
-        elem_ti.is_fp()
-            ? (elem_ti.get_type() == kDOUBLE
-                   ? llvm::Type::getDoubleTy(cgen_state_->context_)
-                   : llvm::Type::getFloatTy(cgen_state_->context_))
-            : get_int_type(elem_ti.get_logical_size() * 8, cgen_state_->context_);
-    group_key = cgen_state_->emitExternalCall(
-        array_at_fname,
-        ar_ret_ty,
-        {group_key, code_generator.posArg(arr_expr), array_idx});
+    group_key = cgen_state_->ir_builder_.CreateLoad(
+        cgen_state_->ir_builder_.CreateGEP(array_buff, array_idx), "array_elem");
     if (need_patch_unnest_double(
             elem_ti, isArchMaxwell(co.device_type), thread_mem_shared)) {
       key_to_cache = spillDoubleElement(group_key, ar_ret_ty);
@@ -27,6 +27,7 @@
 #include "RuntimeFunctions.h"
 
 #include <boost/multiprecision/cpp_int.hpp>
+#include <algorithm>
 #include <limits>
 
 using checked_int64_t = boost::multiprecision::number<
@@ -36,6 +37,16 @@ using checked_int64_t = boost::multiprecision::number<
                                            boost::multiprecision::checked,
                                            void>>;
 
+namespace {
+
+// Bitmaps up to this size are always used, binary searches only pay off for sets which
+// are sparse enough to need a larger bitmap.
+constexpr size_t kMinSortedSetBitmapBytes{1 << 20};
+// Ratio of the bitmap size to the sorted array size above which sorted arrays are used.
+constexpr size_t kMaxBitmapToSortedSetSizeRatio{8};
+
+}  // namespace
+
 InValuesBitmap::InValuesBitmap(const std::vector<int64_t>& values,
                                const int64_t null_val,
                                const Data_Namespace::MemoryLevel memory_level,
@@ -78,16 +89,35 @@ InValuesBitmap::InValuesBitmap(const std::vector<int64_t>& values,
   const int64_t MAX_BITMAP_BITS{8 * 1000 * 1000 * 1000LL};
   const auto bitmap_sz_bits =
       static_cast<int64_t>(checked_int64_t(max_val_) - min_val_ + 1);
-  if (bitmap_sz_bits > MAX_BITMAP_BITS) {
-    throw FailedToCreateBitmap();
-  }
-  const auto bitmap_sz_bytes = bitmap_bits_to_bytes(bitmap_sz_bits);
-  auto cpu_bitset = static_cast<int8_t*>(checked_calloc(bitmap_sz_bytes, 1));
-  for (const auto value : values) {
-    if (value == null_val) {
-      continue;
+  const size_t sorted_set_sz_bytes = values.size() * sizeof(int64_t);
+  size_t bitmap_sz_bytes = bitmap_bits_to_bytes(bitmap_sz_bits);
+  int8_t* cpu_bitset{nullptr};
+  if (bitmap_sz_bits > MAX_BITMAP_BITS ||
+      (bitmap_sz_bytes > kMinSortedSetBitmapBytes &&
+       bitmap_sz_bytes > kMaxBitmapToSortedSetSizeRatio * sorted_set_sz_bytes)) {
+    std::vector<int64_t> sorted_values;
+    sorted_values.reserve(values.size());
+    for (const auto value : values) {
+      if (value != null_val) {
+        sorted_values.push_back(value);
+      }
+    }
+    std::sort(sorted_values.begin(), sorted_values.end());
+    sorted_values.erase(std::unique(sorted_values.begin(), sorted_values.end()),
+                        sorted_values.end());
+    sorted_set_size_ = sorted_values.size();
+    bitmap_sz_bytes = sorted_set_size_ * sizeof(int64_t);
+    cpu_bitset = static_cast<int8_t*>(checked_malloc(bitmap_sz_bytes));
+    memcpy(cpu_bitset, sorted_values.data(), bitmap_sz_bytes);
+  } else {
+    cpu_bitset = static_cast<int8_t*>(checked_calloc(bitmap_sz_bytes, 1));
+    for (const auto value : values) {
+      if (value == null_val) {
+        continue;
+      }
+      agg_count_distinct_bitmap(
+          reinterpret_cast<int64_t*>(&cpu_bitset), value, min_val_);
     }
-    agg_count_distinct_bitmap(reinterpret_cast<int64_t*>(&cpu_bitset), value, min_val_);
   }
 #ifdef HAVE_CUDA
   if (memory_level_ == Data_Namespace::GPU_LEVEL) {
@@ -156,6 +186,17 @@ llvm::Value* InValuesBitmap::codegen(llvm::Value* needle, Executor* executor) co
   const auto bitset_handle_lvs =
       code_generator.codegenHoistedConstants(constants, kENCODING_NONE, 0);
   CHECK_EQ(size_t(1), bitset_handle_lvs.size());
+  if (isSortedSet()) {
+    return executor->cgen_state_->emitCall(
+        "value_in_sorted_set",
+        {executor->cgen_state_->castToTypeIn(bitset_handle_lvs.front(), 64),
+         executor->cgen_state_->llInt(sorted_set_size_),
+         needle_i64,
+         executor->cgen_state_->llInt(min_val_),
+         executor->cgen_state_->llInt(max_val_),
+         executor->cgen_state_->llInt(null_val_),
+         executor->cgen_state_->llInt(null_bool_val)});
+  }
   return executor->cgen_state_->emitCall(
       "bit_is_set",
       {executor->cgen_state_->castToTypeIn(bitset_handle_lvs.front(), 64),
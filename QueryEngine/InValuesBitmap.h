@@ -39,6 +39,8 @@ class FailedToCreateBitmap : public std::runtime_error {
   FailedToCreateBitmap() : std::runtime_error("FailedToCreateBitmap") {}
 };
 
+// Set of the values on the right-hand side of an IN expression. Dense sets are bitmaps,
+// sets which would need a bitmap much larger than their values are sorted arrays.
 class InValuesBitmap {
  public:
   InValuesBitmap(const std::vector<int64_t>& values,
@@ -56,9 +58,13 @@ class InValuesBitmap {
 
   size_t gpuBuffers() const { return gpu_buffers_.size(); }
 
+  bool isSortedSet() const { return sorted_set_size_ > 0; }
+
  private:
   std::vector<Data_Namespace::AbstractBuffer*> gpu_buffers_;
+  // Bitmaps, or the sorted values for sorted sets, one for each device.
   std::vector<int8_t*> bitsets_;
+  int64_t sorted_set_size_{0};
   bool rhs_has_null_;
   int64_t min_val_;
   int64_t max_val_;
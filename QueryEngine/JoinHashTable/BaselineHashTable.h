@@ -17,6 +17,7 @@
 #pragma once
 
 #include "DataMgr/AbstractBuffer.h"
+#include "DataMgr/Allocators/HugePageAllocator.h"
 #include "DataMgr/Allocators/CudaAllocator.h"
 #include "QueryEngine/CompilationOptions.h"
 #include "QueryEngine/JoinHashTable/HashJoin.h"
@@ -96,7 +97,7 @@ class BaselineHashTable : public HashTable {
   size_t getEmittedKeysCount() const override { return emitted_keys_count_; }
 
  private:
-  std::vector<int8_t> cpu_hash_table_buff_;
+  std::vector<int8_t, HugePageAllocator<int8_t>> cpu_hash_table_buff_;
   Data_Namespace::AbstractBuffer* gpu_hash_table_buff_;
 
 #ifdef HAVE_CUDA
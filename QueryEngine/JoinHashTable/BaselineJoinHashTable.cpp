@@ -29,6 +29,9 @@
 #include "QueryEngine/JoinHashTable/Runtime/HashJoinKeyHandlers.h"
 #include "QueryEngine/JoinHashTable/Runtime/JoinHashTableGpuUtils.h"
 
+bool g_enable_radix_partitioned_join_build{false};
+size_t g_radix_partitioned_join_build_partition_bytes{256 * 1024};
+
 std::unique_ptr<
     HashTableCache<HashTableCacheKey, BaselineJoinHashTable::HashTableCacheValue>>
     BaselineJoinHashTable::hash_table_cache_ = std::make_unique<
@@ -343,10 +346,8 @@ std::pair<size_t, size_t> BaselineJoinHashTable::approximateTupleCount(
   CHECK(!columns_per_device.empty() && !columns_per_device.front().join_columns.empty());
 
   if (effective_memory_level == Data_Namespace::MemoryLevel::CPU_LEVEL) {
-    const auto composite_key_info =
-        HashJoin::getCompositeKeyInfo(inner_outer_pairs_, executor_);
     HashTableCacheKey cache_key{columns_per_device.front().join_columns.front().num_elems,
-                                composite_key_info.cache_key_chunks,
+                                getCacheKeyChunks(),
                                 condition_->get_optype(),
                                 join_type_};
     const auto cached_count_info = getApproximateTupleCountFromCache(cache_key);
@@ -509,6 +510,19 @@ size_t BaselineJoinHashTable::shardCount() const {
       condition_.get(), executor_, inner_outer_pairs_);
 }
 
+std::vector<ChunkKey> BaselineJoinHashTable::getCacheKeyChunks() const {
+  auto cache_key_chunks =
+      HashJoin::getCompositeKeyInfo(inner_outer_pairs_, executor_).cache_key_chunks;
+  CHECK(!cache_key_chunks.empty());
+  // Steps which only join some fragments of the inner table, like the windows of a
+  // clustered join, mustn't share a hash table with the same number of rows.
+  const auto& query_info = get_inner_query_info(getInnerTableId(), query_infos_).info;
+  for (const auto& fragment : query_info.fragments) {
+    cache_key_chunks.front().push_back(fragment.fragmentId);
+  }
+  return cache_key_chunks;
+}
+
 size_t BaselineJoinHashTable::getKeyComponentWidth() const {
   for (const auto& inner_outer_pair : inner_outer_pairs_) {
     const auto inner_col = inner_outer_pair.first;
@@ -557,7 +571,7 @@ int BaselineJoinHashTable::initHashTableForDevice(
 
     CHECK(!join_columns.empty());
     HashTableCacheKey cache_key{join_columns.front().num_elems,
-                                composite_key_info.cache_key_chunks,
+                                getCacheKeyChunks(),
                                 condition_->get_optype(),
                                 join_type_};
 
@@ -572,6 +586,17 @@ int BaselineJoinHashTable::initHashTableForDevice(
     } else {
       BaselineJoinHashTableBuilder builder;
 
+      for (size_t i = 0; i < composite_key_info.sd_inner_proxy_per_key.size(); ++i) {
+        const auto sd_inner_proxy = static_cast<const StringDictionaryProxy*>(
+            composite_key_info.sd_inner_proxy_per_key[i]);
+        if (sd_inner_proxy) {
+          const auto sd_outer_proxy = static_cast<const StringDictionaryProxy*>(
+              composite_key_info.sd_outer_proxy_per_key[i]);
+          CHECK(sd_outer_proxy);
+          sd_inner_proxy->prepareTranslationMap(sd_outer_proxy,
+                                                join_columns.front().num_elems);
+        }
+      }
       const auto key_handler =
           GenericKeyHandler(key_component_count,
                             true,
@@ -684,8 +709,16 @@ llvm::Value* BaselineJoinHashTable::codegenSlot(const CompilationOptions& co,
   const auto hash_ptr = hashPtr(index);
   const auto key_ptr_lv =
       LL_BUILDER.CreatePointerCast(key_buff_lv, llvm::Type::getInt8PtrTy(LL_CONTEXT));
-  const auto key_size_lv = LL_INT(getKeyComponentCount() * key_component_width);
+  const auto key_component_count = getKeyComponentCount();
   const auto hash_table = getHashTableForDevice(size_t(0));
+  if (key_component_count <= kMaxUnrolledKeyComponentCount) {
+    return executor_->cgen_state_->emitExternalCall(
+        "baseline_hash_join_idx_" + std::to_string(key_component_count) + "x" +
+            std::to_string(key_component_width * 8),
+        get_int_type(64, LL_CONTEXT),
+        {hash_ptr, key_ptr_lv, LL_INT(hash_table->getEntryCount())});
+  }
+  const auto key_size_lv = LL_INT(key_component_count * key_component_width);
   return executor_->cgen_state_->emitExternalCall(
       "baseline_hash_join_idx_" + std::to_string(key_component_width * 8),
       get_int_type(64, LL_CONTEXT),
@@ -710,13 +743,20 @@ HashJoinMatchingSet BaselineJoinHashTable::codegenMatchingSet(
           ? LL_BUILDER.CreatePointerCast(hash_ptr, composite_dict_ptr_type)
           : LL_BUILDER.CreateIntToPtr(hash_ptr, composite_dict_ptr_type);
   const auto key_component_count = getKeyComponentCount();
-  const auto key = executor_->cgen_state_->emitExternalCall(
-      "get_composite_key_index_" + std::to_string(key_component_width * 8),
-      get_int_type(64, LL_CONTEXT),
-      {key_buff_lv,
-       LL_INT(key_component_count),
-       composite_key_dict,
-       LL_INT(hash_table->getEntryCount())});
+  const auto key =
+      key_component_count <= kMaxUnrolledKeyComponentCount
+          ? executor_->cgen_state_->emitExternalCall(
+                "get_composite_key_index_" + std::to_string(key_component_count) + "x" +
+                    std::to_string(key_component_width * 8),
+                get_int_type(64, LL_CONTEXT),
+                {key_buff_lv, composite_key_dict, LL_INT(hash_table->getEntryCount())})
+          : executor_->cgen_state_->emitExternalCall(
+                "get_composite_key_index_" + std::to_string(key_component_width * 8),
+                get_int_type(64, LL_CONTEXT),
+                {key_buff_lv,
+                 LL_INT(key_component_count),
+                 composite_key_dict,
+                 LL_INT(hash_table->getEntryCount())});
   auto one_to_many_ptr = hash_ptr;
   if (one_to_many_ptr->getType()->isPointerTy()) {
     one_to_many_ptr =
@@ -48,6 +48,15 @@ struct HashTableCacheKey {
     return num_elements == that.num_elements && chunk_keys == that.chunk_keys &&
            optype == that.optype && join_type == that.join_type;
   }
+
+  size_t hash() const {
+    size_t hash{0};
+    boost::hash_combine(hash, num_elements);
+    boost::hash_combine(hash, chunk_keys);
+    boost::hash_combine(hash, static_cast<int>(optype));
+    boost::hash_combine(hash, static_cast<int>(join_type));
+    return hash;
+  }
 };
 
 class HashTypeCache {
@@ -167,6 +176,10 @@ class BaselineJoinHashTable : public HashJoin {
 
   size_t shardCount() const;
 
+  // The chunk keys of the hash table cache, which also cover the fragments of the inner
+  // table the hash table is built over.
+  std::vector<ChunkKey> getCacheKeyChunks() const;
+
   Data_Namespace::MemoryLevel getEffectiveMemoryLevel(
       const std::vector<InnerOuter>& inner_outer_pairs) const;
 
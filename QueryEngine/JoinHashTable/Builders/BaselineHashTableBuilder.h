@@ -220,6 +220,28 @@ void fill_one_to_many_baseline_hash_table_on_device(int32_t* buff,
   }
 }
 
+extern bool g_enable_radix_partitioned_join_build;
+// Hash table bytes filled by a single thread in the radix partitioned CPU build, about
+// the size of a per-core L2 cache by default.
+extern size_t g_radix_partitioned_join_build_partition_bytes;
+
+// Returns the number of radix partitions to fill a CPU baseline hash table with, or
+// 0 for the regular build where all threads insert into the whole table.
+template <class KEY_HANDLER>
+size_t get_radix_partition_count(const size_t hash_table_bytes, const int thread_count) {
+  // Overlaps keys are bucketized on the fly and may emit several keys per row.
+  if (!std::is_same<KEY_HANDLER, GenericKeyHandler>::value ||
+      !g_enable_radix_partitioned_join_build) {
+    return 0;
+  }
+  const auto partition_bytes = std::max(g_radix_partitioned_join_build_partition_bytes,
+                                        size_t(1));
+  const auto partition_count = (hash_table_bytes + partition_bytes - 1) / partition_bytes;
+  // Tables which fit in the caches of the building threads gain nothing from the extra
+  // partitioning pass.
+  return partition_count >= 4 * static_cast<size_t>(thread_count) ? partition_count : 0;
+}
+
 class BaselineJoinHashTableBuilder {
  public:
   BaselineJoinHashTableBuilder() {}
@@ -304,8 +326,27 @@ class BaselineJoinHashTableBuilder {
     for (auto& child : init_cpu_buff_threads) {
       child.get();
     }
+    int err = 0;
+    const auto radix_partition_count = get_radix_partition_count<KEY_HANDLER>(
+        keyspace_entry_count * entry_size, thread_count);
+    if constexpr (std::is_same<KEY_HANDLER, GenericKeyHandler>::value) {
+      if (radix_partition_count) {
+        VLOG(1) << "Filling CPU Join Hash Table in " << radix_partition_count
+                << " radix partitions";
+        err = fillPartitionedHashTableOnCpu(key_handler,
+                                            cpu_hash_table_ptr,
+                                            keyspace_entry_count,
+                                            for_semi_join,
+                                            key_component_count,
+                                            key_component_width,
+                                            layout,
+                                            radix_partition_count,
+                                            thread_count);
+      }
+    }
     std::vector<std::future<int>> fill_cpu_buff_threads;
-    for (int thread_idx = 0; thread_idx < thread_count; ++thread_idx) {
+    for (int thread_idx = 0; !radix_partition_count && thread_idx < thread_count;
+         ++thread_idx) {
       fill_cpu_buff_threads.emplace_back(std::async(
           std::launch::async,
           [key_handler,
@@ -351,7 +392,6 @@ class BaselineJoinHashTableBuilder {
             return -1;
           }));
     }
-    int err = 0;
     for (auto& child : fill_cpu_buff_threads) {
       int partial_err = child.get();
       if (partial_err) {
@@ -405,6 +445,42 @@ class BaselineJoinHashTableBuilder {
     return err;
   }
 
+  int fillPartitionedHashTableOnCpu(const GenericKeyHandler* key_handler,
+                                    int8_t* cpu_hash_table_ptr,
+                                    const size_t keyspace_entry_count,
+                                    const bool for_semi_join,
+                                    const size_t key_component_count,
+                                    const size_t key_component_width,
+                                    const HashType layout,
+                                    const size_t partition_count,
+                                    const int thread_count) {
+    switch (key_component_width) {
+      case 4:
+        return fill_baseline_hash_join_buff_partitioned_32(cpu_hash_table_ptr,
+                                                           keyspace_entry_count,
+                                                           -1,
+                                                           for_semi_join,
+                                                           key_component_count,
+                                                           layout == HashType::OneToOne,
+                                                           key_handler,
+                                                           partition_count,
+                                                           thread_count);
+      case 8:
+        return fill_baseline_hash_join_buff_partitioned_64(cpu_hash_table_ptr,
+                                                           keyspace_entry_count,
+                                                           -1,
+                                                           for_semi_join,
+                                                           key_component_count,
+                                                           layout == HashType::OneToOne,
+                                                           key_handler,
+                                                           partition_count,
+                                                           thread_count);
+      default:
+        CHECK(false);
+    }
+    return -1;
+  }
+
   void allocateDeviceMemory(const HashType layout,
                             const size_t key_component_width,
                             const size_t key_component_count,
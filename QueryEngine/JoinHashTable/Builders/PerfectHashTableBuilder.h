@@ -208,6 +208,7 @@ class PerfectJoinHashTableBuilder {
       sd_outer_proxy =
           executor->getStringDictionaryProxy(outer_col->get_comp_param(), true);
       CHECK(sd_outer_proxy);
+      sd_inner_proxy->prepareTranslationMap(sd_outer_proxy, join_column.num_elems);
     }
     int thread_count = cpu_threads();
     std::vector<std::thread> init_cpu_buff_threads;
@@ -274,6 +275,122 @@ class PerfectJoinHashTableBuilder {
     }
   }
 
+  void initSparseOneToOneHashTableOnCpu(const JoinColumn& join_column,
+                                        const ExpressionRange& col_range,
+                                        const InnerOuter& cols,
+                                        const JoinType join_type,
+                                        const HashEntryInfo hash_entry_info,
+                                        const int32_t hash_join_invalid_val,
+                                        const Executor* executor) {
+    auto timer = DEBUG_TIMER(__func__);
+    const auto inner_col = cols.first;
+    CHECK(inner_col);
+    const auto& ti = inner_col->get_type_info();
+    CHECK_EQ(hash_entry_info.bucket_normalization, 1);
+
+    CHECK(!hash_table_);
+    hash_table_ =
+        std::make_unique<PerfectHashTable>(executor->getDataMgr(),
+                                           HashType::OneToOne,
+                                           ExecutorDeviceType::CPU,
+                                           hash_entry_info.getNormalizedHashEntryCount(),
+                                           0,
+                                           /*sparse=*/true);
+    const StringDictionaryProxy* sd_inner_proxy{nullptr};
+    const StringDictionaryProxy* sd_outer_proxy{nullptr};
+    const auto outer_col = dynamic_cast<const Analyzer::ColumnVar*>(cols.second);
+    if (ti.is_string() &&
+        (outer_col && !(inner_col->get_comp_param() == outer_col->get_comp_param()))) {
+      CHECK_EQ(kENCODING_DICT, ti.get_compression());
+      sd_inner_proxy =
+          executor->getStringDictionaryProxy(inner_col->get_comp_param(), true);
+      CHECK(sd_inner_proxy);
+      sd_outer_proxy =
+          executor->getStringDictionaryProxy(outer_col->get_comp_param(), true);
+      CHECK(sd_outer_proxy);
+      sd_inner_proxy->prepareTranslationMap(sd_outer_proxy, join_column.num_elems);
+    }
+    const JoinColumnTypeInfo type_info{static_cast<size_t>(ti.get_size()),
+                                       col_range.getIntMin(),
+                                       col_range.getIntMax(),
+                                       inline_fixed_encoding_null_val(ti),
+                                       false,
+                                       col_range.getIntMax() + 1,
+                                       get_join_column_type_kind(ti)};
+    const auto bitmap_word_count = PerfectHashTable::getSparseBitmapWordCount(
+        hash_entry_info.getNormalizedHashEntryCount());
+    int thread_count = cpu_threads();
+    std::vector<std::thread> init_cpu_buff_threads;
+    auto bitmap = reinterpret_cast<uint64_t*>(hash_table_->getCpuBuffer());
+    for (int thread_idx = 0; thread_idx < thread_count; ++thread_idx) {
+      init_cpu_buff_threads.emplace_back([bitmap,
+                                          &join_column,
+                                          &type_info,
+                                          sd_inner_proxy,
+                                          sd_outer_proxy,
+                                          thread_idx,
+                                          thread_count] {
+        fill_sparse_hash_join_bitmap(bitmap,
+                                     join_column,
+                                     type_info,
+                                     sd_inner_proxy,
+                                     sd_outer_proxy,
+                                     thread_idx,
+                                     thread_count);
+      });
+    }
+    for (auto& t : init_cpu_buff_threads) {
+      t.join();
+    }
+    init_cpu_buff_threads.clear();
+    // The word ranks follow the bitmap, two 32 bit words per bitmap word.
+    auto word_ranks =
+        reinterpret_cast<int32_t*>(hash_table_->getCpuBuffer()) + 2 * bitmap_word_count;
+    size_t slot_count = 0;
+    for (size_t i = 0; i < bitmap_word_count; ++i) {
+      word_ranks[i] = static_cast<int32_t>(slot_count);
+      slot_count += __builtin_popcountll(bitmap[i]);
+    }
+    hash_table_->addSparseSlots(slot_count, hash_join_invalid_val);
+    auto cpu_hash_table_buff = reinterpret_cast<int32_t*>(hash_table_->getCpuBuffer());
+    const bool for_semi_join = for_semi_anti_join(join_type);
+    std::atomic<int> err{0};
+    for (int thread_idx = 0; thread_idx < thread_count; ++thread_idx) {
+      init_cpu_buff_threads.emplace_back([cpu_hash_table_buff,
+                                          bitmap_word_count,
+                                          hash_join_invalid_val,
+                                          for_semi_join,
+                                          &join_column,
+                                          &type_info,
+                                          sd_inner_proxy,
+                                          sd_outer_proxy,
+                                          thread_idx,
+                                          thread_count,
+                                          &err] {
+        int partial_err = fill_sparse_hash_join_buff(cpu_hash_table_buff,
+                                                     bitmap_word_count,
+                                                     hash_join_invalid_val,
+                                                     for_semi_join,
+                                                     join_column,
+                                                     type_info,
+                                                     sd_inner_proxy,
+                                                     sd_outer_proxy,
+                                                     thread_idx,
+                                                     thread_count);
+        int zero{0};
+        err.compare_exchange_strong(zero, partial_err);
+      });
+    }
+    for (auto& t : init_cpu_buff_threads) {
+      t.join();
+    }
+    if (err) {
+      // Duplicate keys, sparse tables do not have a 1:many layout
+      hash_table_ = nullptr;
+      throw NeedsOneToManyHash();
+    }
+  }
+
   void initOneToManyHashTableOnCpu(
       const JoinColumn& join_column,
       const ExpressionRange& col_range,
@@ -308,6 +425,7 @@ class PerfectJoinHashTableBuilder {
       sd_outer_proxy =
           executor->getStringDictionaryProxy(outer_col->get_comp_param(), true);
       CHECK(sd_outer_proxy);
+      sd_inner_proxy->prepareTranslationMap(sd_outer_proxy, join_column.num_elems);
     }
     int thread_count = cpu_threads();
     std::vector<std::future<void>> init_threads;
@@ -28,6 +28,17 @@
 
 extern bool g_enable_overlaps_hashjoin;
 
+size_t g_hash_table_cache_max_bytes{4UL * 1024 * 1024 * 1024};
+
+HashTableCacheStats HashJoin::getHashTableCacheStats() {
+  auto perfect_hash_table_cache = PerfectJoinHashTable::getHashTableCache();
+  CHECK(perfect_hash_table_cache);
+  auto stats = perfect_hash_table_cache->getStats();
+  stats += BaselineJoinHashTable::getHashTableCache()->getStats();
+  stats += OverlapsJoinHashTable::getHashTableCacheStats();
+  return stats;
+}
+
 void ColumnsForDevice::setBucketInfo(
     const std::vector<double>& inverse_bucket_sizes_for_dimension,
     const std::vector<InnerOuter> inner_outer_pairs) {
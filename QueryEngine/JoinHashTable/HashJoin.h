@@ -27,6 +27,7 @@
 #include "QueryEngine/CompilationOptions.h"
 #include "QueryEngine/Descriptors/RowSetMemoryOwner.h"
 #include "QueryEngine/JoinHashTable/HashTable.h"
+#include "QueryEngine/JoinHashTable/HashTableCache.h"
 #include "QueryEngine/JoinHashTable/Runtime/HashJoinRuntime.h"
 
 class TooManyHashEntries : public std::runtime_error {
@@ -135,6 +136,13 @@ class HashJoin {
     return HashTypeStrings[static_cast<int>(ht)];
   };
 
+  //! Keys of up to this many components are probed by runtime functions unrolled for
+  //! their number of key components, see JoinHashTableQueryRuntime.cpp.
+  static constexpr size_t kMaxUnrolledKeyComponentCount{2};
+
+  //! Combined statistics of the perfect, baseline and overlaps hash table caches.
+  static HashTableCacheStats getHashTableCacheStats();
+
   static HashJoinMatchingSet codegenMatchingSet(
       const std::vector<llvm::Value*>& hash_join_idx_args_in,
       const bool is_sharded,
@@ -158,6 +166,13 @@ class HashJoin {
 
   virtual std::string getHashJoinType() const = 0;
 
+  //! Range predicates on the outer key implied by the build side keys, used to skip outer
+  //! fragments which cannot produce any match. Empty when the join type allows unmatched
+  //! outer rows or the hash table doesn't know its key range.
+  virtual std::list<std::shared_ptr<Analyzer::Expr>> getOuterKeyRangeQuals() const {
+    return {};
+  }
+
   JoinColumn fetchJoinColumn(
       const Analyzer::ColumnVar* hash_col,
       const std::vector<Fragmenter_Namespace::FragmentInfo>& fragment_info,
@@ -17,11 +17,56 @@
 #pragma once
 
 #include <functional>
+#include <iterator>
+#include <list>
+#include <memory>
 #include <mutex>
-#include <vector>
+#include <optional>
+#include <unordered_map>
+
+#include <boost/functional/hash.hpp>
 
 #include "Logger/Logger.h"
+#include "QueryEngine/CompilationOptions.h"
+
+// Byte budget of each join hash table cache, 0 means unlimited.
+extern size_t g_hash_table_cache_max_bytes;
+
+struct HashTableCacheStats {
+  size_t num_entries{0};
+  size_t size_bytes{0};
+  size_t hits{0};
+  size_t misses{0};
+  size_t evictions{0};
 
+  HashTableCacheStats& operator+=(const HashTableCacheStats& that) {
+    num_entries += that.num_entries;
+    size_bytes += that.size_bytes;
+    hits += that.hits;
+    misses += that.misses;
+    evictions += that.evictions;
+    return *this;
+  }
+};
+
+// Cached join hash tables are CPU copies, GPU tables are rebuilt from those.
+template <class T>
+size_t get_hash_table_cache_value_size(const std::shared_ptr<T>& hash_table) {
+  return hash_table ? hash_table->getHashTableBufferSize(ExecutorDeviceType::CPU) : 0;
+}
+
+template <class V>
+size_t get_hash_table_cache_value_size(const V&) {
+  return sizeof(V);
+}
+
+/**
+ * Cache of join hash tables (or of their build parameters) keyed on the inner table
+ * contents. Keys provide a hash() consistent with their operator==, lookups go through
+ * a hash index and, once the entries exceed `g_hash_table_cache_max_bytes`, the least
+ * recently used entries are evicted. Entries keep their insertion order, which is what
+ * getCachedHashTable() indexes into.
+ */
 template <class K, class V>
 class HashTableCache {
  public:
@@ -31,14 +76,14 @@ class HashTableCache {
     return [this]() -> void {
       std::lock_guard<std::mutex> guard(mutex_);
       VLOG(1) << "Invalidating " << contents_.size() << " cached hash tables.";
-      contents_.clear();
+      clearUnlocked();
     };
   }
 
   V getCachedHashTable(const size_t idx) {
     std::lock_guard<std::mutex> guard(mutex_);
     CHECK_LT(idx, contents_.size());
-    return contents_.at(idx).second;
+    return std::next(contents_.begin(), idx)->value;
   }
 
   size_t getNumberOfCachedHashTables() {
@@ -46,35 +91,126 @@ class HashTableCache {
     return contents_.size();
   }
 
+  HashTableCacheStats getStats() {
+    std::lock_guard<std::mutex> guard(mutex_);
+    auto stats = stats_;
+    stats.num_entries = contents_.size();
+    stats.size_bytes = size_bytes_;
+    return stats;
+  }
+
   void clear() {
     std::lock_guard<std::mutex> guard(mutex_);
-    contents_.clear();
+    clearUnlocked();
   }
 
   void insert(const K& key, V& hash_table) {
     std::lock_guard<std::mutex> guard(mutex_);
-    for (auto& kv : contents_) {
-      if (kv.first == key) {
-        auto& cached_hash_table = kv.second;
-        cached_hash_table = hash_table;
+    const auto size_bytes = get_hash_table_cache_value_size(hash_table);
+    auto it = findUnlocked(key);
+    if (it != contents_.end()) {
+      size_bytes_ -= it->size_bytes;
+      it->value = hash_table;
+      it->size_bytes = size_bytes;
+      it->last_access = ++access_counter_;
+      size_bytes_ += size_bytes;
+    } else {
+      if (g_hash_table_cache_max_bytes && size_bytes > g_hash_table_cache_max_bytes) {
+        VLOG(1) << "Not caching a hash table of " << size_bytes
+                << " bytes, over the cache budget of " << g_hash_table_cache_max_bytes
+                << " bytes.";
         return;
       }
+      contents_.push_back(CacheEntry{key, hash_table, size_bytes, ++access_counter_});
+      index_.emplace(key.hash(), std::prev(contents_.end()));
+      size_bytes_ += size_bytes;
     }
-    contents_.emplace_back(key, hash_table);
+    evictUnlocked();
   }
 
   // makes a copy
   std::optional<V> get(const K& key) {
     std::lock_guard<std::mutex> guard(mutex_);
-    for (const auto& kv : contents_) {
-      if (kv.first == key) {
-        return kv.second;
-      }
+    auto it = lookupUnlocked(key);
+    if (it == contents_.end()) {
+      return std::nullopt;
     }
-    return std::nullopt;
+    return it->value;
   }
 
  protected:
-  std::vector<std::pair<K, V>> contents_;
+  struct CacheEntry {
+    K key;
+    V value;
+    size_t size_bytes;
+    size_t last_access;
+  };
+  using CacheEntries = std::list<CacheEntry>;
+
+  typename CacheEntries::iterator findUnlocked(const K& key) {
+    const auto range = index_.equal_range(key.hash());
+    for (auto it = range.first; it != range.second; ++it) {
+      if (it->second->key == key) {
+        return it->second;
+      }
+    }
+    return contents_.end();
+  }
+
+  // Like findUnlocked(), but counts as an access to the entry.
+  typename CacheEntries::iterator lookupUnlocked(const K& key) {
+    auto it = findUnlocked(key);
+    if (it == contents_.end()) {
+      ++stats_.misses;
+    } else {
+      ++stats_.hits;
+      it->last_access = ++access_counter_;
+    }
+    return it;
+  }
+
+  CacheEntries contents_;
   std::mutex mutex_;
+
+ private:
+  void eraseUnlocked(typename CacheEntries::iterator entry_it) {
+    const auto range = index_.equal_range(entry_it->key.hash());
+    for (auto it = range.first; it != range.second; ++it) {
+      if (it->second == entry_it) {
+        index_.erase(it);
+        break;
+      }
+    }
+    size_bytes_ -= entry_it->size_bytes;
+    contents_.erase(entry_it);
+  }
+
+  void evictUnlocked() {
+    if (!g_hash_table_cache_max_bytes) {
+      return;
+    }
+    while (size_bytes_ > g_hash_table_cache_max_bytes) {
+      CHECK(!contents_.empty());
+      auto lru_it = contents_.begin();
+      for (auto it = contents_.begin(); it != contents_.end(); ++it) {
+        if (it->last_access < lru_it->last_access) {
+          lru_it = it;
+        }
+      }
+      VLOG(1) << "Evicting a cached hash table of " << lru_it->size_bytes << " bytes.";
+      eraseUnlocked(lru_it);
+      ++stats_.evictions;
+    }
+  }
+
+  void clearUnlocked() {
+    contents_.clear();
+    index_.clear();
+    size_bytes_ = 0;
+  }
+
+  std::unordered_multimap<size_t, typename CacheEntries::iterator> index_;
+  size_t size_bytes_{0};
+  size_t access_counter_{0};
+  HashTableCacheStats stats_;
 };
@@ -24,6 +24,9 @@
 #include "QueryEngine/JoinHashTable/PerfectJoinHashTable.h"
 #include "QueryEngine/JoinHashTable/Runtime/HashJoinKeyHandlers.h"
 #include "QueryEngine/JoinHashTable/Runtime/JoinHashTableGpuUtils.h"
+#include "Shared/scope.h"
+
+size_t g_overlaps_tuning_sample_rows{0};
 
 std::unique_ptr<OverlapsHashTableCache<OverlapsHashTableCacheKey,
                                        OverlapsJoinHashTable::HashTableCacheValue>>
@@ -712,47 +715,98 @@ void OverlapsJoinHashTable::reifyWithLayout(const HashType layout) {
                   overlaps_bucket_threshold);
       }
     } else {
-      // compute bucket size using the auto tuner
-      BucketSizeTuner tuner(
-          /*initial_threshold=*/overlaps_bucket_threshold,
-          /*step=*/2.0,
-          /*min_threshold=*/1e-7,
-          getEffectiveMemoryLevel(inner_outer_pairs_),
-          columns_per_device,
-          inner_outer_pairs_,
-          total_num_tuples,
-          executor_);
-
-      VLOG(1) << "Running overlaps join size auto tune with parameters: " << tuner;
-
-      // manages the tuning state machine
-      TuningState tuning_state(overlaps_max_table_size_bytes,
-                               overlaps_target_entries_per_bin);
-      while (tuner.tuneOneStep(tuning_state.tuning_direction)) {
-        const auto inverse_bucket_sizes = tuner.getInverseBucketSizes();
+      // the counts of the tuning steps are estimated from a strided sample of the inner
+      // rows when there are many of them, only the chosen bucket sizes are counted over
+      // all the rows
+      const auto num_inner_rows =
+          columns_per_device.front().join_columns.front().num_elems;
+      tuning_sample_stride_ = 1;
+      if (g_overlaps_tuning_sample_rows &&
+          getEffectiveMemoryLevel(inner_outer_pairs_) ==
+              Data_Namespace::MemoryLevel::CPU_LEVEL &&
+          num_inner_rows > g_overlaps_tuning_sample_rows) {
+        tuning_sample_stride_ = (num_inner_rows + g_overlaps_tuning_sample_rows - 1) /
+                                g_overlaps_tuning_sample_rows;
+      }
+      ScopeGuard reset_tuning_sample_stride = [this] { tuning_sample_stride_ = 1; };
+
+      std::optional<TuningState> tuning_state_opt;
+      while (true) {
+        // compute bucket size using the auto tuner
+        BucketSizeTuner tuner(
+            /*initial_threshold=*/overlaps_bucket_threshold,
+            /*step=*/2.0,
+            /*min_threshold=*/1e-7,
+            getEffectiveMemoryLevel(inner_outer_pairs_),
+            columns_per_device,
+            inner_outer_pairs_,
+            total_num_tuples,
+            executor_);
+
+        VLOG(1) << "Running overlaps join size auto tune with parameters: " << tuner
+                << ", sample stride: " << tuning_sample_stride_;
+
+        // manages the tuning state machine
+        tuning_state_opt.emplace(overlaps_max_table_size_bytes,
+                                 overlaps_target_entries_per_bin);
+        auto& tuning_state = *tuning_state_opt;
+        while (tuner.tuneOneStep(tuning_state.tuning_direction)) {
+          const auto inverse_bucket_sizes = tuner.getInverseBucketSizes();
+
+          const auto [crt_entry_count, crt_emitted_keys_count] =
+              computeHashTableCounts(shard_count,
+                                     inverse_bucket_sizes,
+                                     columns_per_device,
+                                     tuning_state.overlaps_max_table_size_bytes,
+                                     tuning_state.chosen_overlaps_threshold);
+          const size_t hash_table_size = calculateHashTableSize(
+              inverse_bucket_sizes.size(), crt_emitted_keys_count, crt_entry_count);
+          HashTableProps crt_props(crt_entry_count,
+                                   crt_emitted_keys_count,
+                                   hash_table_size,
+                                   inverse_bucket_sizes);
+          VLOG(1) << "Tuner output: " << tuner << " with properties " << crt_props;
+
+          const auto should_continue = tuning_state(crt_props, tuner.getMinBucketSize());
+          setInverseBucketSizeInfo(
+              tuning_state.crt_props.bucket_sizes, columns_per_device, device_count_);
+          if (!should_continue) {
+            break;
+          }
+        }
 
-        const auto [crt_entry_count, crt_emitted_keys_count] =
-            computeHashTableCounts(shard_count,
-                                   inverse_bucket_sizes,
-                                   columns_per_device,
-                                   tuning_state.overlaps_max_table_size_bytes,
-                                   tuning_state.chosen_overlaps_threshold);
-        const size_t hash_table_size = calculateHashTableSize(
-            inverse_bucket_sizes.size(), crt_emitted_keys_count, crt_entry_count);
-        HashTableProps crt_props(crt_entry_count,
-                                 crt_emitted_keys_count,
-                                 hash_table_size,
-                                 inverse_bucket_sizes);
-        VLOG(1) << "Tuner output: " << tuner << " with properties " << crt_props;
-
-        const auto should_continue = tuning_state(crt_props, tuner.getMinBucketSize());
-        setInverseBucketSizeInfo(
-            tuning_state.crt_props.bucket_sizes, columns_per_device, device_count_);
-        if (!should_continue) {
+        VLOG(1) << "Final tuner output: " << tuner << " with properties "
+                << tuning_state.crt_props;
+        if (tuning_sample_stride_ == 1) {
           break;
         }
+        tuning_sample_stride_ = 1;
+        if (!inverse_bucket_sizes_for_dimension_.empty()) {
+          const auto [entry_count, emitted_keys_count] =
+              computeHashTableCounts(shard_count,
+                                     inverse_bucket_sizes_for_dimension_,
+                                     columns_per_device,
+                                     tuning_state.overlaps_max_table_size_bytes,
+                                     tuning_state.chosen_overlaps_threshold);
+          const size_t hash_table_size =
+              calculateHashTableSize(inverse_bucket_sizes_for_dimension_.size(),
+                                     emitted_keys_count,
+                                     entry_count);
+          if (hash_table_size <= overlaps_max_table_size_bytes) {
+            tuning_state.crt_props = HashTableProps(entry_count,
+                                                    emitted_keys_count,
+                                                    hash_table_size,
+                                                    inverse_bucket_sizes_for_dimension_);
+            VLOG(1) << "Counted the sampled tuner output over all rows: "
+                    << tuning_state.crt_props;
+            break;
+          }
+        }
+        VLOG(1) << "Sampled overlaps join tuning did not find a hash table under the "
+                   "maximum allowed size, tuning again over all rows";
       }
 
+      auto& tuning_state = *tuning_state_opt;
       const auto& crt_props = tuning_state.crt_props;
       // sanity check that the hash table size has not changed. this is a fairly
       // inexpensive check to ensure the above algorithm is consistent
@@ -770,7 +824,6 @@ void OverlapsJoinHashTable::reifyWithLayout(const HashType layout) {
         throw OverlapsHashTableTooBig(overlaps_max_table_size_bytes);
       }
 
-      VLOG(1) << "Final tuner output: " << tuner << " with properties " << crt_props;
       CHECK(!inverse_bucket_sizes_for_dimension_.empty());
       VLOG(1) << "Final bucket sizes: ";
       for (size_t dim = 0; dim < inverse_bucket_sizes_for_dimension_.size(); dim++) {
@@ -940,15 +993,26 @@ std::pair<size_t, size_t> OverlapsJoinHashTable::approximateTupleCount(
                                          columns_per_device.front().join_columns,
                                          columns_per_device.front().join_column_types,
                                          columns_per_device.front().join_buckets,
-                                         thread_count);
+                                         thread_count,
+                                         tuning_sample_stride_);
     for (int i = 1; i < thread_count; ++i) {
       hll_unify(hll_result,
                 hll_result + i * padded_size_bytes,
                 1 << count_distinct_desc.bitmap_sz_bits);
     }
-    return std::make_pair(
-        hll_size(hll_result, count_distinct_desc.bitmap_sz_bits),
-        static_cast<size_t>(num_keys_for_row.size() > 0 ? num_keys_for_row.back() : 0));
+    const size_t tuple_count = hll_size(hll_result, count_distinct_desc.bitmap_sz_bits);
+    const auto emitted_keys_count =
+        static_cast<size_t>(num_keys_for_row.size() > 0 ? num_keys_for_row.back() : 0);
+    if (tuning_sample_stride_ > 1) {
+      // scaling up the distinct keys of the sample overestimates them when the bins are
+      // shared by many rows, which errs on the side of larger hash tables while tuning
+      const auto scaled_emitted_keys_count = emitted_keys_count * tuning_sample_stride_;
+      return std::make_pair(
+          std::min(tuple_count * tuning_sample_stride_,
+                   scaled_emitted_keys_count),
+          scaled_emitted_keys_count);
+    }
+    return std::make_pair(tuple_count, emitted_keys_count);
   }
 #ifdef HAVE_CUDA
   auto data_mgr = executor_->getDataMgr();
@@ -1590,13 +1654,20 @@ HashJoinMatchingSet OverlapsJoinHashTable::codegenMatchingSet(
             ? LL_BUILDER.CreatePointerCast(hash_ptr, composite_dict_ptr_type)
             : LL_BUILDER.CreateIntToPtr(hash_ptr, composite_dict_ptr_type);
     const auto key_component_count = getKeyComponentCount();
-    const auto key = executor_->cgen_state_->emitExternalCall(
-        "get_composite_key_index_" + std::to_string(key_component_width * 8),
-        get_int_type(64, LL_CONTEXT),
-        {key_buff_lv,
-         LL_INT(key_component_count),
-         composite_key_dict,
-         LL_INT(getEntryCount())});
+    const auto key =
+        key_component_count <= kMaxUnrolledKeyComponentCount
+            ? executor_->cgen_state_->emitExternalCall(
+                  "get_composite_key_index_" + std::to_string(key_component_count) +
+                      "x" + std::to_string(key_component_width * 8),
+                  get_int_type(64, LL_CONTEXT),
+                  {key_buff_lv, composite_key_dict, LL_INT(getEntryCount())})
+            : executor_->cgen_state_->emitExternalCall(
+                  "get_composite_key_index_" + std::to_string(key_component_width * 8),
+                  get_int_type(64, LL_CONTEXT),
+                  {key_buff_lv,
+                   LL_INT(key_component_count),
+                   composite_key_dict,
+                   LL_INT(getEntryCount())});
     auto one_to_many_ptr = hash_ptr;
     if (one_to_many_ptr->getType()->isPointerTy()) {
       one_to_many_ptr =
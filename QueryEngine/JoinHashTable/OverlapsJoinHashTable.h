@@ -21,6 +21,10 @@
 #include "QueryEngine/JoinHashTable/HashJoin.h"
 #include "QueryEngine/JoinHashTable/HashTableCache.h"
 
+// Inner rows above which the overlaps join auto tuner counts the keys of its steps on a
+// sample of the rows, 0 to always count all of them.
+extern size_t g_overlaps_tuning_sample_rows;
+
 struct OverlapsHashTableCacheKey {
   const size_t num_elements;
   const std::vector<ChunkKey> chunk_keys;
@@ -44,6 +48,17 @@ struct OverlapsHashTableCacheKey {
            bucket_threshold == that.bucket_threshold;
   }
 
+  // Leaves out the bucket sizes, which are compared with a tolerance.
+  size_t hash() const {
+    size_t hash{0};
+    boost::hash_combine(hash, num_elements);
+    boost::hash_combine(hash, chunk_keys);
+    boost::hash_combine(hash, static_cast<int>(optype));
+    boost::hash_combine(hash, max_hashtable_size);
+    boost::hash_combine(hash, bucket_threshold);
+    return hash;
+  }
+
   OverlapsHashTableCacheKey(const size_t num_elements,
                             const std::vector<ChunkKey>& chunk_keys,
                             const SQLOps& optype,
@@ -75,12 +90,11 @@ class OverlapsHashTableCache : public HashTableCache<K, V> {
  public:
   std::optional<std::pair<K, V>> getWithKey(const K& key) {
     std::lock_guard<std::mutex> guard(this->mutex_);
-    for (const auto& kv : this->contents_) {
-      if (kv.first == key) {
-        return kv;
-      }
+    const auto it = this->lookupUnlocked(key);
+    if (it == this->contents_.end()) {
+      return std::nullopt;
     }
-    return std::nullopt;
+    return std::make_pair(it->key, it->value);
   }
 };
 
@@ -132,6 +146,13 @@ class OverlapsJoinHashTable : public HashJoin {
     };
   }
 
+  static HashTableCacheStats getHashTableCacheStats() {
+    CHECK(hash_table_cache_ && auto_tuner_cache_);
+    auto stats = hash_table_cache_->getStats();
+    stats += auto_tuner_cache_->getStats();
+    return stats;
+  }
+
   static size_t getCombinedHashTableCacheSize() {
     // for unit tests
     CHECK(hash_table_cache_ && auto_tuner_cache_);
@@ -355,6 +376,8 @@ class OverlapsJoinHashTable : public HashJoin {
   const int device_count_;
 
   std::vector<double> inverse_bucket_sizes_for_dimension_;
+  // only every tuning_sample_stride_-th group of rows is counted while auto tuning
+  size_t tuning_sample_stride_{1};
 
   std::optional<HashType>
       layout_override_;  // allows us to use a 1:many hash table for many:many
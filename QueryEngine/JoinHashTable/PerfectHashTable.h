@@ -19,6 +19,7 @@
 #include <memory>
 #include <vector>
 
+#include "DataMgr/Allocators/HugePageAllocator.h"
 #include "QueryEngine/JoinHashTable/HashTable.h"
 
 class PerfectHashTable : public HashTable {
@@ -28,12 +29,20 @@ class PerfectHashTable : public HashTable {
                    const HashType layout,
                    const ExecutorDeviceType device_type,
                    const size_t entry_count,
-                   const size_t emitted_keys_count)
+                   const size_t emitted_keys_count,
+                   const bool sparse = false)
       : data_mgr_(data_mgr)
       , layout_(layout)
       , entry_count_(entry_count)
-      , emitted_keys_count_(emitted_keys_count) {
-    if (device_type == ExecutorDeviceType::CPU) {
+      , emitted_keys_count_(emitted_keys_count)
+      , sparse_(sparse) {
+    if (sparse_) {
+      // Sparse tables are only built on CPU, their slots are added once the keys present
+      // are known.
+      CHECK(device_type == ExecutorDeviceType::CPU);
+      CHECK(layout_ == HashType::OneToOne);
+      cpu_hash_table_buff_.resize(3 * getSparseBitmapWordCount(entry_count_));
+    } else if (device_type == ExecutorDeviceType::CPU) {
       cpu_hash_table_buff_.resize(layout_ == HashType::OneToOne
                                       ? entry_count_
                                       : 2 * entry_count_ + emitted_keys_count_);
@@ -82,12 +91,45 @@ class PerfectHashTable : public HashTable {
 
   size_t getEmittedKeysCount() const override { return emitted_keys_count_; }
 
+  // A sparse table covers its key range with a bitmap of the keys present (two 32 bit
+  // words per 64 keys), the number of keys present before each word of the bitmap and
+  // one slot per key present, see get_sparse_hash_slot.
+  bool isSparse() const { return sparse_; }
+
+  static size_t getSparseBitmapWordCount(const size_t entry_count) {
+    return (entry_count + 63) / 64;
+  }
+
+  // Adds the slots of the keys present after the bitmap and the word ranks.
+  void addSparseSlots(const size_t slot_count, const int32_t invalid_slot_val) {
+    CHECK(sparse_);
+    cpu_hash_table_buff_.resize(3 * getSparseBitmapWordCount(entry_count_) + slot_count,
+                                invalid_slot_val);
+  }
+
+  // Expands a sparse table into the buffer of a dense one over the same key range.
+  std::vector<int32_t> getDenseCpuBufferFromSparse(const int32_t invalid_slot_val) const {
+    CHECK(sparse_);
+    const auto word_count = getSparseBitmapWordCount(entry_count_);
+    const auto bitmap = reinterpret_cast<const uint64_t*>(cpu_hash_table_buff_.data());
+    const auto slots = cpu_hash_table_buff_.data() + 3 * word_count;
+    std::vector<int32_t> dense_buff(entry_count_, invalid_slot_val);
+    size_t slot_idx = 0;
+    for (size_t i = 0; i < entry_count_; ++i) {
+      if (bitmap[i / 64] & (uint64_t(1) << (i % 64))) {
+        dense_buff[i] = slots[slot_idx++];
+      }
+    }
+    return dense_buff;
+  }
+
  private:
   Data_Namespace::AbstractBuffer* gpu_hash_table_buff_{nullptr};
   Data_Namespace::DataMgr* data_mgr_;
-  std::vector<int32_t> cpu_hash_table_buff_;
+  std::vector<int32_t, HugePageAllocator<int32_t>> cpu_hash_table_buff_;
 
   HashType layout_;
   size_t entry_count_;         // number of keys in the hash table
   size_t emitted_keys_count_;  // number of keys emitted across all rows
+  bool sparse_;
 };
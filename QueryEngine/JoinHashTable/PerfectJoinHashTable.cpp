@@ -30,6 +30,10 @@
 #include "QueryEngine/JoinHashTable/Runtime/HashJoinRuntime.h"
 #include "QueryEngine/RuntimeFunctions.h"
 
+bool g_enable_hash_table_gpu_broadcast{false};
+double g_sparse_perfect_hash_min_density{0.01};
+size_t g_sparse_perfect_hash_min_entries{size_t(1) << 26};
+
 std::unique_ptr<HashTableCache<PerfectJoinHashTable::JoinHashTableCacheKey,
                                PerfectJoinHashTable::HashTableCacheValue>>
     PerfectJoinHashTable::hash_table_cache_ =
@@ -84,9 +88,30 @@ size_t get_hash_entry_count(const ExpressionRange& col_range, const bool is_bw_e
   return col_range.getIntMax() - col_range.getIntMin() + 1 + (is_bw_eq ? 1 : 0);
 }
 
-}  // namespace
-
-namespace {
+// Sparse tables trade a bitmap lookup and a population count per probe for a table of
+// about 0.19 bytes per key of the range plus 4 bytes per inner row, instead of 4 bytes
+// per key of the range. They are only worth it for large ranges which the inner rows
+// still cover densely enough, below that a baseline table is smaller and as fast.
+bool use_sparse_layout(const HashEntryInfo& hash_entry_info,
+                       const size_t num_tuples,
+                       const Data_Namespace::MemoryLevel memory_level,
+                       const HashType preferred_hash_type,
+                       const bool is_bw_eq,
+                       const size_t shard_count) {
+  if (g_sparse_perfect_hash_min_density <= 0 ||
+      memory_level != Data_Namespace::MemoryLevel::CPU_LEVEL ||
+      preferred_hash_type != HashType::OneToOne || is_bw_eq || shard_count ||
+      hash_entry_info.bucket_normalization != 1) {
+    return false;
+  }
+  const auto entry_count = hash_entry_info.getNormalizedHashEntryCount();
+  if (entry_count <= g_sparse_perfect_hash_min_entries ||
+      num_tuples < g_sparse_perfect_hash_min_density * entry_count) {
+    return false;
+  }
+  return 3 * PerfectHashTable::getSparseBitmapWordCount(entry_count) + num_tuples <=
+         static_cast<size_t>(std::numeric_limits<int32_t>::max());
+}
 
 bool shard_count_less_or_equal_device_count(const int inner_table_id,
                                             const Executor* executor) {
@@ -200,9 +225,21 @@ std::shared_ptr<PerfectJoinHashTable> PerfectJoinHashTable::getInstance(
       ti, col_range, qual_bin_oper->get_optype() == kBW_EQ);
   auto bucketized_entry_count = bucketized_entry_count_info.getNormalizedHashEntryCount();
 
-  if (bucketized_entry_count > max_hash_entry_count) {
+  const bool sparse = use_sparse_layout(
+      bucketized_entry_count_info,
+      get_inner_query_info(inner_col->get_table_id(), query_infos)
+          .info.getNumTuplesUpperBound(),
+      memory_level,
+      preferred_hash_type,
+      qual_bin_oper->get_optype() == kBW_EQ,
+      get_shard_count(qual_bin_oper.get(), executor));
+  if (!sparse && bucketized_entry_count > max_hash_entry_count) {
     throw TooManyHashEntries();
   }
+  if (sparse) {
+    VLOG(1) << "Using a sparse layout for the perfect hash table over "
+            << bucketized_entry_count << " keys";
+  }
 
   if (qual_bin_oper->get_optype() == kBW_EQ &&
       col_range.getIntMax() >= std::numeric_limits<int64_t>::max()) {
@@ -218,9 +255,14 @@ std::shared_ptr<PerfectJoinHashTable> PerfectJoinHashTable::getInstance(
                                                                      col_range,
                                                                      column_cache,
                                                                      executor,
-                                                                     device_count));
+                                                                     device_count,
+                                                                     sparse));
   try {
     join_hash_table->reify();
+  } catch (const TooManyHashEntries&) {
+    // Retried with a baseline hash table
+    join_hash_table->freeHashBufferMemory();
+    throw;
   } catch (const TableMustBeReplicated& e) {
     // Throw a runtime error to abort the query
     join_hash_table->freeHashBufferMemory();
@@ -325,6 +367,14 @@ void PerfectJoinHashTable::reify() {
   inner_outer_pairs_.push_back(cols);
   CHECK_EQ(inner_outer_pairs_.size(), size_t(1));
 
+  // Every device of an unsharded join gets the same table, so with the broadcast enabled
+  // only device 0 fetches the inner column and builds it.
+  const bool broadcast = g_enable_hash_table_gpu_broadcast && !shard_count &&
+                         device_count_ > 1 &&
+                         getEffectiveMemoryLevel(inner_outer_pairs_) ==
+                             Data_Namespace::MemoryLevel::GPU_LEVEL;
+  const int build_device_count = broadcast ? 1 : device_count_;
+
   std::vector<ColumnsForDevice> columns_per_device;
   std::vector<std::unique_ptr<CudaAllocator>> dev_buff_owners;
   try {
@@ -335,7 +385,7 @@ void PerfectJoinHashTable::reify() {
             std::make_unique<CudaAllocator>(data_mgr, device_id));
       }
     }
-    for (int device_id = 0; device_id < device_count_; ++device_id) {
+    for (int device_id = 0; device_id < build_device_count; ++device_id) {
       const auto fragments =
           shard_count
               ? only_shards_for_device(query_info.fragments, device_id, device_count_)
@@ -367,14 +417,18 @@ void PerfectJoinHashTable::reify() {
     }
 
   } catch (const NeedsOneToManyHash& e) {
+    if (sparse_) {
+      // Sparse tables have no one to many layout, join with a baseline table instead.
+      throw TooManyHashEntries("Sparse perfect hash table over duplicate keys");
+    }
     hash_type_ = HashType::OneToMany;
     freeHashBufferMemory();
     init_threads.clear();
     if (memory_level_ == Data_Namespace::MemoryLevel::GPU_LEVEL) {
       CHECK_EQ(dev_buff_owners.size(), size_t(device_count_));
     }
-    CHECK_EQ(columns_per_device.size(), size_t(device_count_));
-    for (int device_id = 0; device_id < device_count_; ++device_id) {
+    CHECK_EQ(columns_per_device.size(), size_t(build_device_count));
+    for (int device_id = 0; device_id < build_device_count; ++device_id) {
       const auto fragments =
           shard_count
               ? only_shards_for_device(query_info.fragments, device_id, device_count_)
@@ -397,6 +451,47 @@ void PerfectJoinHashTable::reify() {
       init_thread.get();
     }
   }
+  if (broadcast) {
+    copyHashTableToPeerDevices();
+  }
+}
+
+void PerfectJoinHashTable::copyHashTableToPeerDevices() {
+#ifdef HAVE_CUDA
+  auto timer = DEBUG_TIMER(__func__);
+  CHECK_EQ(hash_tables_for_device_.size(), size_t(device_count_));
+  const auto src_hash_table =
+      std::dynamic_pointer_cast<PerfectHashTable>(hash_tables_for_device_.front());
+  if (!src_hash_table) {
+    // No table was built for an empty key range, the other devices do not need one.
+    return;
+  }
+  CHECK(src_hash_table->getGpuBuffer());
+  const size_t entry_count = src_hash_table->getEntryCount();
+  const size_t emitted_keys_count = src_hash_table->getEmittedKeysCount();
+  const size_t total_count = src_hash_table->getLayout() == HashType::OneToOne
+                                 ? entry_count
+                                 : 2 * entry_count + emitted_keys_count;
+  auto data_mgr = executor_->getDataMgr();
+  auto cuda_mgr = data_mgr->getCudaMgr();
+  CHECK(cuda_mgr);
+  for (int device_id = 1; device_id < device_count_; ++device_id) {
+    auto hash_table = std::make_shared<PerfectHashTable>(data_mgr,
+                                                         src_hash_table->getLayout(),
+                                                         ExecutorDeviceType::GPU,
+                                                         entry_count,
+                                                         emitted_keys_count);
+    hash_table->allocateGpuMemory(total_count, device_id);
+    cuda_mgr->copyDeviceToDevice(hash_table->getGpuBuffer(),
+                                 src_hash_table->getGpuBuffer(),
+                                 total_count * sizeof(int32_t),
+                                 device_id,
+                                 0);
+    hash_tables_for_device_[device_id] = std::move(hash_table);
+  }
+#else
+  UNREACHABLE();
+#endif
 }
 
 Data_Namespace::MemoryLevel PerfectJoinHashTable::getEffectiveMemoryLevel(
@@ -515,7 +610,17 @@ int PerfectJoinHashTable::initHashTableForDevice(
       std::lock_guard<std::mutex> cpu_hash_table_buff_lock(cpu_hash_table_buff_mutex_);
       if (!hash_table) {
         PerfectJoinHashTableBuilder builder;
-        if (layout == HashType::OneToOne) {
+        if (sparse_) {
+          CHECK(layout == HashType::OneToOne);
+          builder.initSparseOneToOneHashTableOnCpu(join_column,
+                                                   col_range_,
+                                                   cols,
+                                                   join_type_,
+                                                   hash_entry_info,
+                                                   hash_join_invalid_val,
+                                                   executor_);
+          hash_table = builder.getHashTable();
+        } else if (layout == HashType::OneToOne) {
           builder.initOneToOneHashTableOnCpu(join_column,
                                              col_range_,
                                              isBitwiseEq(),
@@ -537,7 +642,7 @@ int PerfectJoinHashTable::initHashTableForDevice(
           hash_table = builder.getHashTable();
         }
       } else {
-        if (layout == HashType::OneToOne &&
+        if (layout == HashType::OneToOne && !sparse_ &&
             hash_table->getHashTableBufferSize(ExecutorDeviceType::CPU) >
                 hash_entry_info.getNormalizedHashEntryCount() * sizeof(int32_t)) {
           // TODO: can this ever happen?
@@ -643,8 +748,10 @@ ChunkKey PerfectJoinHashTable::genHashTableKey(
     }
     hash_table_key.push_back(outer_elem_count);
   }
-  if (fragments.size() < 2) {
-    hash_table_key.push_back(fragments.front().fragmentId);
+  // Steps which only join some fragments of the inner table, like the windows of a
+  // clustered join, mustn't share a hash table with the same number of rows.
+  for (const auto& fragment : fragments) {
+    hash_table_key.push_back(fragment.fragmentId);
   }
   return hash_table_key;
 }
@@ -666,7 +773,8 @@ std::shared_ptr<PerfectHashTable> PerfectJoinHashTable::initHashTableOnCpuFromCa
                                   num_elements,
                                   chunk_key,
                                   qual_bin_oper_->get_optype(),
-                                  join_type_};
+                                  join_type_,
+                                  sparse_};
   auto hash_table_opt = (hash_table_cache_->get(cache_key));
   return hash_table_opt ? *hash_table_opt : nullptr;
 }
@@ -687,7 +795,8 @@ void PerfectJoinHashTable::putHashTableOnCpuToCache(const ChunkKey& chunk_key,
                                   num_elements,
                                   chunk_key,
                                   qual_bin_oper_->get_optype(),
-                                  join_type_};
+                                  join_type_,
+                                  sparse_};
   CHECK(hash_table_cache_);
   CHECK(hash_table && !hash_table->getGpuBuffer());
   hash_table_cache_->insert(cache_key, hash_table);
@@ -723,6 +832,13 @@ std::vector<llvm::Value*> PerfectJoinHashTable::getHashJoinArgs(
       executor_->cgen_state_->castToTypeIn(key_lvs.front(), 64),
       executor_->cgen_state_->llInt(col_range_.getIntMin()),
       executor_->cgen_state_->llInt(col_range_.getIntMax())};
+  if (sparse_) {
+    CHECK(!shard_count && !isBitwiseEq());
+    const auto bitmap_word_count = PerfectHashTable::getSparseBitmapWordCount(
+        get_hash_entry_count(col_range_, false));
+    hash_join_idx_args.push_back(
+        executor_->cgen_state_->llInt(static_cast<int64_t>(bitmap_word_count)));
+  }
   if (shard_count) {
     const auto expected_hash_entry_count =
         get_hash_entry_count(col_range_, isBitwiseEq());
@@ -833,6 +949,14 @@ std::string PerfectJoinHashTable::toString(const ExecutorDeviceType device_type,
   auto buffer = getJoinHashBuffer(device_type, device_id);
   auto buffer_size = getJoinHashBufferSize(device_type, device_id);
   auto hash_table = getHashTableForDevice(device_id);
+  // Sparse tables are decoded as the dense table over the same key range.
+  std::vector<int32_t> dense_buffer;
+  const auto perfect_hash_table = dynamic_cast<PerfectHashTable*>(hash_table);
+  if (perfect_hash_table && perfect_hash_table->isSparse()) {
+    dense_buffer = perfect_hash_table->getDenseCpuBufferFromSparse(-1);
+    buffer = reinterpret_cast<int64_t>(dense_buffer.data());
+    buffer_size = dense_buffer.size() * sizeof(int32_t);
+  }
 #ifdef HAVE_CUDA
   std::unique_ptr<int8_t[]> buffer_copy;
   if (device_type == ExecutorDeviceType::GPU) {
@@ -870,6 +994,14 @@ std::set<DecodedJoinHashBufferEntry> PerfectJoinHashTable::toSet(
   auto buffer = getJoinHashBuffer(device_type, device_id);
   auto buffer_size = getJoinHashBufferSize(device_type, device_id);
   auto hash_table = getHashTableForDevice(device_id);
+  // Sparse tables are decoded as the dense table over the same key range.
+  std::vector<int32_t> dense_buffer;
+  const auto perfect_hash_table = dynamic_cast<PerfectHashTable*>(hash_table);
+  if (perfect_hash_table && perfect_hash_table->isSparse()) {
+    dense_buffer = perfect_hash_table->getDenseCpuBufferFromSparse(-1);
+    buffer = reinterpret_cast<int64_t>(dense_buffer.data());
+    buffer_size = dense_buffer.size() * sizeof(int32_t);
+  }
 #ifdef HAVE_CUDA
   std::unique_ptr<int8_t[]> buffer_copy;
   if (device_type == ExecutorDeviceType::GPU) {
@@ -934,8 +1066,9 @@ llvm::Value* PerfectJoinHashTable::codegenSlot(const CompilationOptions& co,
   const auto hash_join_idx_args = getHashJoinArgs(hash_ptr, key_col, shard_count, co);
 
   const auto& key_col_ti = key_col->get_type_info();
-  std::string fname((key_col_ti.get_type() == kDATE) ? "bucketized_hash_join_idx"s
-                                                     : "hash_join_idx"s);
+  std::string fname(sparse_                              ? "sparse_hash_join_idx"s
+                    : (key_col_ti.get_type() == kDATE) ? "bucketized_hash_join_idx"s
+                                                       : "hash_join_idx"s);
 
   if (isBitwiseEq()) {
     fname += "_bitwise";
@@ -993,3 +1126,46 @@ size_t PerfectJoinHashTable::shardCount() const {
 bool PerfectJoinHashTable::isBitwiseEq() const {
   return qual_bin_oper_->get_optype() == kBW_EQ;
 }
+
+std::list<std::shared_ptr<Analyzer::Expr>> PerfectJoinHashTable::getOuterKeyRangeQuals()
+    const {
+  // Only inner and semi joins drop outer rows without a match. Null keys do match with
+  // the bitwise equality, which the range doesn't account for.
+  if ((join_type_ != JoinType::INNER && join_type_ != JoinType::SEMI) || isBitwiseEq()) {
+    return {};
+  }
+  CHECK_EQ(inner_outer_pairs_.size(), size_t(1));
+  const auto& [inner_col, outer_expr] = inner_outer_pairs_.front();
+  if (!inner_col->get_type_info().is_integer() ||
+      !outer_expr->get_type_info().is_integer()) {
+    return {};
+  }
+  // Executor::skipFragment only compares a column, or a cast of one, with the chunk
+  // min/max of the outer table.
+  const auto outer_uoper = dynamic_cast<const Analyzer::UOper*>(outer_expr);
+  const auto outer_col =
+      outer_uoper && outer_uoper->get_optype() == kCAST
+          ? dynamic_cast<const Analyzer::ColumnVar*>(outer_uoper->get_operand())
+          : dynamic_cast<const Analyzer::ColumnVar*>(outer_expr);
+  if (!outer_col) {
+    return {};
+  }
+  Datum min_key;
+  min_key.bigintval = col_range_.getIntMin();
+  Datum max_key;
+  max_key.bigintval = col_range_.getIntMax();
+  std::list<std::shared_ptr<Analyzer::Expr>> range_quals;
+  range_quals.push_back(
+      makeExpr<Analyzer::BinOper>(kBOOLEAN,
+                                  kGE,
+                                  kONE,
+                                  outer_expr->deep_copy(),
+                                  makeExpr<Analyzer::Constant>(kBIGINT, false, min_key)));
+  range_quals.push_back(
+      makeExpr<Analyzer::BinOper>(kBOOLEAN,
+                                  kLE,
+                                  kONE,
+                                  outer_expr->deep_copy(),
+                                  makeExpr<Analyzer::Constant>(kBIGINT, false, max_key)));
+  return range_quals;
+}
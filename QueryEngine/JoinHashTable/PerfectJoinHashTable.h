@@ -44,6 +44,16 @@
 #include <mutex>
 #include <stdexcept>
 
+// Build an unsharded GPU join hash table on the first device only and copy it to the
+// other devices, instead of fetching the inner column and building it on every device.
+extern bool g_enable_hash_table_gpu_broadcast;
+
+// CPU one to one tables over key ranges of more than `g_sparse_perfect_hash_min_entries`
+// keys use the sparse layout, as long as the inner rows cover at least
+// `g_sparse_perfect_hash_min_density` of the range. A density of 0 disables the layout.
+extern double g_sparse_perfect_hash_min_density;
+extern size_t g_sparse_perfect_hash_min_entries;
+
 struct HashEntryInfo;
 
 class PerfectJoinHashTable : public HashJoin {
@@ -97,6 +107,8 @@ class PerfectJoinHashTable : public HashJoin {
 
   std::string getHashJoinType() const final { return "Perfect"; }
 
+  std::list<std::shared_ptr<Analyzer::Expr>> getOuterKeyRangeQuals() const override;
+
   static auto getHashTableCache() { return hash_table_cache_.get(); }
 
   static auto getCacheInvalidator() -> std::function<void()> {
@@ -127,6 +139,9 @@ class PerfectJoinHashTable : public HashJoin {
                              const Data_Namespace::MemoryLevel effective_memory_level,
                              const int device_id);
 
+  // Copies the hash table built on device 0 to the other devices.
+  void copyHashTableToPeerDevices();
+
   Data_Namespace::MemoryLevel getEffectiveMemoryLevel(
       const std::vector<InnerOuter>& inner_outer_pairs) const;
 
@@ -141,7 +156,8 @@ class PerfectJoinHashTable : public HashJoin {
                        const ExpressionRange& col_range,
                        ColumnCacheMap& column_cache,
                        Executor* executor,
-                       const int device_count)
+                       const int device_count,
+                       const bool sparse)
       : qual_bin_oper_(qual_bin_oper)
       , join_type_(join_type)
       , col_var_(std::dynamic_pointer_cast<Analyzer::ColumnVar>(col_var->deep_copy()))
@@ -151,7 +167,8 @@ class PerfectJoinHashTable : public HashJoin {
       , col_range_(col_range)
       , executor_(executor)
       , column_cache_(column_cache)
-      , device_count_(device_count) {
+      , device_count_(device_count)
+      , sparse_(sparse) {
     CHECK(col_range.getType() == ExpressionRangeType::Integer);
     CHECK_GT(device_count_, 0);
     hash_tables_for_device_.resize(device_count_);
@@ -200,6 +217,8 @@ class PerfectJoinHashTable : public HashJoin {
   Executor* executor_;
   ColumnCacheMap& column_cache_;
   const int device_count_;
+  // Whether the table uses the sparse layout, see PerfectHashTable::isSparse.
+  const bool sparse_;
 
   struct JoinHashTableCacheKey {
     const ExpressionRange col_range;
@@ -209,12 +228,22 @@ class PerfectJoinHashTable : public HashJoin {
     const ChunkKey chunk_key;
     const SQLOps optype;
     const JoinType join_type;
+    const bool sparse;
 
     bool operator==(const struct JoinHashTableCacheKey& that) const {
       return col_range == that.col_range && inner_col == that.inner_col &&
              outer_col == that.outer_col && num_elements == that.num_elements &&
              chunk_key == that.chunk_key && optype == that.optype &&
-             join_type == that.join_type;
+             join_type == that.join_type && sparse == that.sparse;
+    }
+
+    size_t hash() const {
+      size_t hash{0};
+      boost::hash_combine(hash, num_elements);
+      boost::hash_combine(hash, chunk_key);
+      boost::hash_combine(hash, static_cast<int>(optype));
+      boost::hash_combine(hash, static_cast<int>(join_type));
+      return hash;
     }
   };
 
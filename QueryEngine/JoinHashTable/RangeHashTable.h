@@ -0,0 +1,107 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "DataMgr/Allocators/CudaAllocator.h"
+#include "QueryEngine/JoinHashTable/HashTable.h"
+
+// The sorted inner keys of a range join. The buffer starts with the number of keys and
+// the lower extent of the probed ranges, followed by the sorted keys and the row id of
+// each key, see range_join_lower_bound. One CPU buffer is shared by the tables of all
+// devices, the GPU tables hold a copy of it.
+class RangeHashTable : public HashTable {
+ public:
+  static constexpr size_t kHeaderSize{2 * sizeof(int64_t)};
+
+  static size_t getBufferSize(const size_t entry_count) {
+    return kHeaderSize + entry_count * (sizeof(int64_t) + sizeof(int32_t));
+  }
+
+  // CPU constructor
+  RangeHashTable(const size_t entry_count)
+      : cpu_buff_(std::make_shared<std::vector<int8_t>>(getBufferSize(entry_count)))
+      , entry_count_(entry_count) {
+    auto header = reinterpret_cast<int64_t*>(cpu_buff_->data());
+    header[0] = entry_count;
+    header[1] = 0;
+  }
+
+  // GPU constructor, copies the buffer of a CPU table to the device.
+  RangeHashTable(const RangeHashTable& cpu_table,
+                 Data_Namespace::DataMgr* data_mgr,
+                 const int device_id);
+
+  ~RangeHashTable() {
+    if (gpu_buff_) {
+      CHECK(data_mgr_);
+      data_mgr_->free(gpu_buff_);
+    }
+  }
+
+  size_t getHashTableBufferSize(const ExecutorDeviceType device_type) const override {
+    if (device_type == ExecutorDeviceType::CPU) {
+      return cpu_buff_->size();
+    }
+    return gpu_buff_ ? gpu_buff_->reservedSize() : 0;
+  }
+
+  int8_t* getCpuBuffer() override { return cpu_buff_->data(); }
+
+  int8_t* getGpuBuffer() const override {
+    return gpu_buff_ ? gpu_buff_->getMemoryPtr() : nullptr;
+  }
+
+  HashType getLayout() const override { return HashType::OneToMany; }
+
+  size_t getEntryCount() const override { return entry_count_; }
+
+  size_t getEmittedKeysCount() const override { return entry_count_; }
+
+  const int64_t* getKeys() const {
+    return reinterpret_cast<const int64_t*>(cpu_buff_->data() + kHeaderSize);
+  }
+
+  int64_t* getKeys() {
+    return reinterpret_cast<int64_t*>(cpu_buff_->data() + kHeaderSize);
+  }
+
+  const int32_t* getRowIds() const {
+    return reinterpret_cast<const int32_t*>(getKeys() + entry_count_);
+  }
+
+  int32_t* getRowIds() { return reinterpret_cast<int32_t*>(getKeys() + entry_count_); }
+
+  int64_t getLowerExtent() const {
+    return reinterpret_cast<const int64_t*>(cpu_buff_->data())[1];
+  }
+
+  // Keys down to this much below the lower end of a probed range match it, the longest
+  // interval when the keys are the starts of intervals.
+  void setLowerExtent(const int64_t lower_extent) {
+    CHECK_GE(lower_extent, 0);
+    reinterpret_cast<int64_t*>(cpu_buff_->data())[1] = lower_extent;
+  }
+
+ private:
+  std::shared_ptr<std::vector<int8_t>> cpu_buff_;
+  Data_Namespace::AbstractBuffer* gpu_buff_{nullptr};
+  Data_Namespace::DataMgr* data_mgr_{nullptr};
+  size_t entry_count_;
+};
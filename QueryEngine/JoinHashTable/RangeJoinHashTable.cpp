@@ -0,0 +1,469 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "QueryEngine/JoinHashTable/RangeJoinHashTable.h"
+
+#include <algorithm>
+#include <limits>
+#include <optional>
+
+#include "DataMgr/BufferMgr/BufferMgr.h"
+#include "QueryEngine/CodeGenerator.h"
+#include "QueryEngine/Execute.h"
+#include "QueryEngine/GpuMemUtils.h"
+#include "QueryEngine/JoinHashTable/PerfectJoinHashTable.h"
+#include "QueryEngine/JoinHashTable/Runtime/JoinColumnIterator.h"
+#include "QueryEngine/RangeTableIndexVisitor.h"
+
+bool g_enable_range_joins{true};
+
+#ifdef HAVE_CUDA
+RangeHashTable::RangeHashTable(const RangeHashTable& cpu_table,
+                               Data_Namespace::DataMgr* data_mgr,
+                               const int device_id)
+    : cpu_buff_(cpu_table.cpu_buff_)
+    , data_mgr_(data_mgr)
+    , entry_count_(cpu_table.entry_count_) {
+  CHECK(data_mgr_);
+  gpu_buff_ =
+      CudaAllocator::allocGpuAbstractBuffer(data_mgr_, cpu_buff_->size(), device_id);
+  copy_to_gpu(data_mgr_,
+              reinterpret_cast<CUdeviceptr>(gpu_buff_->getMemoryPtr()),
+              cpu_buff_->data(),
+              cpu_buff_->size(),
+              device_id);
+}
+#endif
+
+namespace {
+
+bool is_range_key_type(const SQLTypeInfo& ti) {
+  return ti.is_integer() || ti.is_decimal() || ti.is_time();
+}
+
+// Whether the logical values of both types compare as plain 64 bit integers.
+bool are_range_key_types_compatible(const SQLTypeInfo& key_ti,
+                                    const SQLTypeInfo& bound_ti) {
+  if (!is_range_key_type(key_ti) || !is_range_key_type(bound_ti)) {
+    return false;
+  }
+  if (key_ti.is_integer() && bound_ti.is_integer()) {
+    return true;
+  }
+  if (key_ti.is_decimal() && bound_ti.is_decimal()) {
+    return key_ti.get_scale() == bound_ti.get_scale();
+  }
+  return key_ti.get_type() == bound_ti.get_type() &&
+         key_ti.get_dimension() == bound_ti.get_dimension();
+}
+
+// The inner column an expression reads, directly or through a widening integer cast.
+const Analyzer::ColumnVar* get_inner_key_col(const Analyzer::Expr* expr,
+                                             const int inner_rte_idx) {
+  const auto uoper = dynamic_cast<const Analyzer::UOper*>(expr);
+  if (uoper && uoper->get_optype() == kCAST) {
+    const auto& ti = uoper->get_type_info();
+    const auto& operand_ti = uoper->get_operand()->get_type_info();
+    if (!ti.is_integer() || !operand_ti.is_integer() ||
+        ti.get_size() < operand_ti.get_size()) {
+      return nullptr;
+    }
+    expr = uoper->get_operand();
+  }
+  const auto col_var = dynamic_cast<const Analyzer::ColumnVar*>(expr);
+  if (!col_var || col_var->get_rte_idx() != inner_rte_idx ||
+      !is_range_key_type(col_var->get_type_info())) {
+    return nullptr;
+  }
+  return col_var;
+}
+
+bool is_outer_expr(const Analyzer::Expr* expr, const int inner_rte_idx) {
+  MaxRangeTableIndexVisitor rte_idx_visitor;
+  return rte_idx_visitor.visit(expr) < inner_rte_idx;
+}
+
+// An inner column bounded by an outer expression, `key >= outer` for a lower bound.
+struct InnerBound {
+  const Analyzer::ColumnVar* key_col;
+  SQLTypeInfo key_ti;
+  bool is_lower;
+  std::shared_ptr<Analyzer::Expr> outer;
+};
+
+std::optional<InnerBound> get_inner_bound(const Analyzer::BinOper* bin_oper,
+                                          const int inner_rte_idx) {
+  auto optype = bin_oper->get_optype();
+  if (optype != kLT && optype != kLE && optype != kGT && optype != kGE) {
+    return std::nullopt;
+  }
+  auto key = bin_oper->get_own_left_operand();
+  auto outer = bin_oper->get_own_right_operand();
+  auto key_col = get_inner_key_col(key.get(), inner_rte_idx);
+  if (!key_col) {
+    std::swap(key, outer);
+    optype = COMMUTE_COMPARISON(optype);
+    key_col = get_inner_key_col(key.get(), inner_rte_idx);
+  }
+  if (!key_col || !is_outer_expr(outer.get(), inner_rte_idx) ||
+      !are_range_key_types_compatible(key->get_type_info(), outer->get_type_info())) {
+    return std::nullopt;
+  }
+  return InnerBound{key_col, key->get_type_info(), optype == kGT || optype == kGE, outer};
+}
+
+struct RangeJoinCondition {
+  const Analyzer::ColumnVar* key_col;
+  const Analyzer::ColumnVar* end_col;
+  std::shared_ptr<Analyzer::Expr> lower_bound;
+  std::shared_ptr<Analyzer::Expr> upper_bound;
+};
+
+// Matches `ABS(outer - key) < d`, ABS is translated to a CASE expression.
+std::optional<RangeJoinCondition> get_abs_range_join_condition(
+    const Analyzer::BinOper* bin_oper,
+    const int inner_rte_idx) {
+  auto optype = bin_oper->get_optype();
+  auto abs_expr = bin_oper->get_own_left_operand();
+  auto distance = bin_oper->get_own_right_operand();
+  if (optype == kGT || optype == kGE) {
+    std::swap(abs_expr, distance);
+    optype = COMMUTE_COMPARISON(optype);
+  }
+  if (optype != kLT && optype != kLE) {
+    return std::nullopt;
+  }
+  const auto case_expr = dynamic_cast<const Analyzer::CaseExpr*>(abs_expr.get());
+  if (!case_expr || case_expr->get_expr_pair_list().size() != 1) {
+    return std::nullopt;
+  }
+  const auto minus = dynamic_cast<const Analyzer::BinOper*>(case_expr->get_else_expr());
+  const auto uminus = dynamic_cast<const Analyzer::UOper*>(
+      case_expr->get_expr_pair_list().front().second.get());
+  if (!minus || minus->get_optype() != kMINUS || !uminus ||
+      uminus->get_optype() != kUMINUS || !(*uminus->get_operand() == *minus)) {
+    return std::nullopt;
+  }
+  auto key = minus->get_own_left_operand();
+  auto outer = minus->get_own_right_operand();
+  auto key_col = get_inner_key_col(key.get(), inner_rte_idx);
+  if (!key_col) {
+    std::swap(key, outer);
+    key_col = get_inner_key_col(key.get(), inner_rte_idx);
+  }
+  const auto& ti = minus->get_type_info();
+  if (!key_col || !is_outer_expr(outer.get(), inner_rte_idx) ||
+      !is_outer_expr(distance.get(), inner_rte_idx) ||
+      !are_range_key_types_compatible(key->get_type_info(), ti) ||
+      !are_range_key_types_compatible(ti, distance->get_type_info())) {
+    return std::nullopt;
+  }
+  return RangeJoinCondition{
+      key_col,
+      nullptr,
+      makeExpr<Analyzer::BinOper>(ti, false, kMINUS, kONE, outer, distance),
+      makeExpr<Analyzer::BinOper>(ti, false, kPLUS, kONE, outer, distance)};
+}
+
+std::optional<RangeJoinCondition> get_range_join_condition(
+    const std::list<std::shared_ptr<Analyzer::Expr>>& quals,
+    const int inner_rte_idx) {
+  std::vector<InnerBound> bounds;
+  for (const auto& qual : quals) {
+    const auto bin_oper = dynamic_cast<const Analyzer::BinOper*>(qual.get());
+    if (!bin_oper || bin_oper->get_qualifier() != kONE) {
+      continue;
+    }
+    if (auto bound = get_inner_bound(bin_oper, inner_rte_idx)) {
+      bounds.push_back(*bound);
+    } else if (auto condition = get_abs_range_join_condition(bin_oper, inner_rte_idx)) {
+      return condition;
+    }
+  }
+  // A key between two outer expressions.
+  for (const auto& lower : bounds) {
+    for (const auto& upper : bounds) {
+      if (lower.is_lower && !upper.is_lower && *lower.key_col == *upper.key_col) {
+        return RangeJoinCondition{lower.key_col, nullptr, lower.outer, upper.outer};
+      }
+    }
+  }
+  // An interval from the key to an end column which contains an outer expression.
+  for (const auto& start : bounds) {
+    for (const auto& end : bounds) {
+      if (!start.is_lower && end.is_lower && !(*start.key_col == *end.key_col) &&
+          *start.outer == *end.outer &&
+          are_range_key_types_compatible(start.key_ti, end.key_ti)) {
+        return RangeJoinCondition{start.key_col, end.key_col, start.outer, start.outer};
+      }
+    }
+  }
+  return std::nullopt;
+}
+
+JoinColumnTypeInfo get_range_key_type_info(const Analyzer::ColumnVar* col_var) {
+  const auto& ti = col_var->get_type_info();
+  return JoinColumnTypeInfo{static_cast<size_t>(ti.get_size()),
+                            0,
+                            0,
+                            inline_fixed_encoding_null_val(ti),
+                            false,
+                            0,
+                            get_join_column_type_kind(ti)};
+}
+
+}  // namespace
+
+std::shared_ptr<RangeJoinHashTable> RangeJoinHashTable::getInstance(
+    const std::list<std::shared_ptr<Analyzer::Expr>>& quals,
+    const std::vector<InputTableInfo>& query_infos,
+    const Data_Namespace::MemoryLevel memory_level,
+    const int device_count,
+    ColumnCacheMap& column_cache,
+    Executor* executor) {
+  int inner_rte_idx{0};
+  MaxRangeTableIndexVisitor rte_idx_visitor;
+  for (const auto& qual : quals) {
+    inner_rte_idx = std::max(inner_rte_idx, rte_idx_visitor.visit(qual.get()));
+  }
+  if (!inner_rte_idx) {
+    return nullptr;
+  }
+  const auto condition = get_range_join_condition(quals, inner_rte_idx);
+  if (!condition) {
+    return nullptr;
+  }
+  VLOG(1) << "Building range join table on " << condition->key_col->toString()
+          << (condition->end_col ? " to " + condition->end_col->toString() : "");
+  auto join_hash_table = std::shared_ptr<RangeJoinHashTable>(
+      new RangeJoinHashTable(condition->key_col,
+                             condition->end_col,
+                             condition->lower_bound,
+                             condition->upper_bound,
+                             query_infos,
+                             memory_level,
+                             device_count,
+                             column_cache,
+                             executor));
+  try {
+    join_hash_table->reify();
+  } catch (const TableMustBeReplicated& e) {
+    // Throw a runtime error to abort the query
+    throw std::runtime_error(e.what());
+  } catch (const HashJoinFail& e) {
+    join_hash_table->freeHashBufferMemory();
+    throw HashJoinFail(std::string("Could not build a range join table | ") + e.what());
+  } catch (const TooManyHashEntries& e) {
+    throw HashJoinFail(std::string("Could not build a range join table | ") + e.what());
+  } catch (const OutOfMemory& e) {
+    throw HashJoinFail(
+        std::string("Ran out of memory while building the range join table | ") +
+        e.what());
+  }
+  return join_hash_table;
+}
+
+void RangeJoinHashTable::reify() {
+  auto timer = DEBUG_TIMER(__func__);
+  HashJoin::checkHashJoinReplicationConstraint(getInnerTableId(), 0, executor_);
+  const auto& query_info = get_inner_query_info(getInnerTableId(), query_infos_).info;
+  if (query_info.getNumTuplesUpperBound() >
+      static_cast<size_t>(std::numeric_limits<int32_t>::max())) {
+    throw TooManyHashEntries();
+  }
+  const auto catalog = executor_->getCatalog();
+  CHECK(catalog);
+  std::vector<std::shared_ptr<Chunk_NS::Chunk>> chunks_owner;
+  std::vector<std::shared_ptr<void>> malloc_owner;
+  const auto fetch_column = [&](const Analyzer::ColumnVar* col_var) {
+    const auto cd = get_column_descriptor_maybe(
+        col_var->get_column_id(), col_var->get_table_id(), *catalog);
+    if (cd && cd->isVirtualCol) {
+      throw FailedToJoinOnVirtualColumn();
+    }
+    // The keys are sorted on CPU and copied to the devices.
+    return fetchJoinColumn(col_var,
+                           query_info.fragments,
+                           Data_Namespace::CPU_LEVEL,
+                           0,
+                           chunks_owner,
+                           nullptr,
+                           malloc_owner,
+                           executor_,
+                           &column_cache_);
+  };
+
+  std::vector<std::pair<int64_t, int32_t>> entries;
+  int64_t lower_extent{0};
+  if (!query_info.fragments.empty()) {
+    const auto key_column = fetch_column(key_col_.get());
+    const auto key_type_info = get_range_key_type_info(key_col_.get());
+    JoinColumnTyped keys{&key_column, &key_type_info};
+    entries.reserve(key_column.num_elems);
+    if (end_col_) {
+      const auto end_column = fetch_column(end_col_.get());
+      const auto end_type_info = get_range_key_type_info(end_col_.get());
+      CHECK_EQ(end_column.num_elems, key_column.num_elems);
+      JoinColumnTyped ends{&end_column, &end_type_info};
+      auto end_it = ends.begin();
+      for (auto key_it = keys.begin(); key_it; ++key_it, ++end_it) {
+        CHECK(end_it);
+        const auto key = *key_it;
+        const auto end = *end_it;
+        if (key.element == key_type_info.null_val ||
+            end.element == end_type_info.null_val || end.element < key.element) {
+          continue;
+        }
+        const auto length =
+            static_cast<uint64_t>(end.element) - static_cast<uint64_t>(key.element);
+        if (length > static_cast<uint64_t>(std::numeric_limits<int64_t>::max())) {
+          throw HashJoinFail("Range join interval too long");
+        }
+        lower_extent = std::max(lower_extent, static_cast<int64_t>(length));
+        entries.emplace_back(key.element, key.index);
+      }
+    } else {
+      for (const auto key : keys) {
+        if (key.element != key_type_info.null_val) {
+          entries.emplace_back(key.element, key.index);
+        }
+      }
+    }
+    std::sort(entries.begin(), entries.end());
+  }
+
+  auto cpu_hash_table = std::make_shared<RangeHashTable>(entries.size());
+  cpu_hash_table->setLowerExtent(lower_extent);
+  auto sorted_keys = cpu_hash_table->getKeys();
+  auto row_ids = cpu_hash_table->getRowIds();
+  for (size_t i = 0; i < entries.size(); ++i) {
+    sorted_keys[i] = entries[i].first;
+    row_ids[i] = entries[i].second;
+  }
+  if (memory_level_ == Data_Namespace::GPU_LEVEL) {
+#ifdef HAVE_CUDA
+    for (int device_id = 0; device_id < device_count_; ++device_id) {
+      hash_tables_for_device_[device_id] = std::make_shared<RangeHashTable>(
+          *cpu_hash_table, executor_->getDataMgr(), device_id);
+    }
+#else
+    UNREACHABLE();
+#endif
+  } else {
+    CHECK_EQ(device_count_, 1);
+    hash_tables_for_device_[0] = cpu_hash_table;
+  }
+}
+
+llvm::Value* RangeJoinHashTable::codegenSlot(const CompilationOptions&, const size_t) {
+  // Only inner joins use range join tables, which always iterate the matching set.
+  UNREACHABLE();
+  return nullptr;
+}
+
+HashJoinMatchingSet RangeJoinHashTable::codegenMatchingSet(const CompilationOptions& co,
+                                                           const size_t index) {
+  auto cgen_state = executor_->cgen_state_.get();
+  AUTOMATIC_IR_METADATA(cgen_state);
+  auto hash_ptr = HashJoin::codegenHashTableLoad(index, executor_);
+  if (!hash_ptr->getType()->isIntegerTy(64)) {
+    CHECK(hash_ptr->getType()->isPointerTy());
+    hash_ptr = cgen_state->ir_builder_.CreatePtrToInt(
+        get_arg_by_name(cgen_state->row_func_, "join_hash_tables"),
+        llvm::Type::getInt64Ty(cgen_state->context_));
+  }
+  CodeGenerator code_generator(executor_);
+  llvm::Value* has_matches{nullptr};
+  const auto codegen_bound = [&](const Analyzer::Expr* bound) {
+    const auto bound_lv = cgen_state->castToTypeIn(
+        code_generator.codegen(bound, true, co).front(), 64);
+    const auto& bound_ti = bound->get_type_info();
+    if (!bound_ti.get_notnull()) {
+      // Null bounds match no key.
+      const auto not_null_lv = cgen_state->ir_builder_.CreateICmpNE(
+          bound_lv,
+          cgen_state->llInt(inline_int_null_val(get_logical_type_info(bound_ti))));
+      has_matches = has_matches
+                        ? cgen_state->ir_builder_.CreateAnd(has_matches, not_null_lv)
+                        : not_null_lv;
+    }
+    return bound_lv;
+  };
+  const auto begin_lv = cgen_state->emitCall(
+      "range_join_lower_bound", {hash_ptr, codegen_bound(lower_bound_.get())});
+  const auto end_lv = cgen_state->emitCall(
+      "range_join_upper_bound", {hash_ptr, codegen_bound(upper_bound_.get())});
+  const auto nonempty_lv = cgen_state->ir_builder_.CreateICmpSGT(end_lv, begin_lv);
+  has_matches = has_matches ? cgen_state->ir_builder_.CreateAnd(has_matches, nonempty_lv)
+                            : nonempty_lv;
+  const auto row_count_lv = cgen_state->ir_builder_.CreateSelect(
+      has_matches,
+      cgen_state->ir_builder_.CreateSub(end_lv, begin_lv),
+      cgen_state->llInt(int64_t(0)));
+  const auto row_ids_lv = cgen_state->ir_builder_.CreateIntToPtr(
+      cgen_state->emitCall("range_join_row_ids", {hash_ptr}),
+      llvm::Type::getInt32PtrTy(cgen_state->context_));
+  return {
+      cgen_state->ir_builder_.CreateGEP(row_ids_lv, begin_lv), row_count_lv, begin_lv};
+}
+
+size_t RangeJoinHashTable::payloadBufferOff() const noexcept {
+  if (hash_tables_for_device_.empty() || !hash_tables_for_device_.front()) {
+    return 0;
+  }
+  return RangeHashTable::kHeaderSize +
+         hash_tables_for_device_.front()->getEntryCount() * sizeof(int64_t);
+}
+
+std::string RangeJoinHashTable::toString(const ExecutorDeviceType device_type,
+                                         const int device_id,
+                                         bool raw) const {
+  const auto hash_table =
+      dynamic_cast<const RangeHashTable*>(getHashTableForDevice(device_id));
+  if (!hash_table) {
+    return "RangeHashTable: empty";
+  }
+  std::string txt = "RangeHashTable: " + std::to_string(hash_table->getEntryCount()) +
+                    " keys, lower extent " +
+                    std::to_string(hash_table->getLowerExtent());
+  if (raw) {
+    for (size_t i = 0; i < hash_table->getEntryCount(); ++i) {
+      txt += (i ? ", " : ": ") + std::to_string(hash_table->getKeys()[i]) + " -> " +
+             std::to_string(hash_table->getRowIds()[i]);
+    }
+  }
+  return txt;
+}
+
+DecodedJoinHashBufferSet RangeJoinHashTable::toSet(const ExecutorDeviceType device_type,
+                                                   const int device_id) const {
+  DecodedJoinHashBufferSet decoded_set;
+  const auto hash_table =
+      dynamic_cast<const RangeHashTable*>(getHashTableForDevice(device_id));
+  if (!hash_table) {
+    return decoded_set;
+  }
+  const auto keys = hash_table->getKeys();
+  const auto row_ids = hash_table->getRowIds();
+  for (size_t i = 0; i < hash_table->getEntryCount();) {
+    DecodedJoinHashBufferEntry entry{{keys[i]}, {}};
+    for (; i < hash_table->getEntryCount() && keys[i] == entry.key.front(); ++i) {
+      entry.payload.insert(row_ids[i]);
+    }
+    decoded_set.insert(std::move(entry));
+  }
+  return decoded_set;
+}
@@ -0,0 +1,120 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "Analyzer/Analyzer.h"
+#include "QueryEngine/InputMetadata.h"
+#include "QueryEngine/JoinHashTable/HashJoin.h"
+#include "QueryEngine/JoinHashTable/RangeHashTable.h"
+
+// Join inner join levels which only bound an inner column by outer expressions through
+// the sorted inner keys instead of a loop join.
+extern bool g_enable_range_joins;
+
+// Joins on ranges of a numeric, decimal or datetime inner column: `i BETWEEN o1 AND o2`,
+// `ABS(o - i) < d` and `i1 <= o AND i2 >= o`, the last one for intervals of the inner
+// table containing an outer value. The inner keys are sorted once and every outer row
+// probes the range with binary searches, which gives the candidate inner rows as a one
+// to many set. The range predicates stay in the filters of the query, the table only
+// narrows the inner rows tested against them.
+class RangeJoinHashTable : public HashJoin {
+ public:
+  //! Make a range join table for the quals of an inner join level, null when the quals
+  //! do not bound an inner column by outer expressions.
+  static std::shared_ptr<RangeJoinHashTable> getInstance(
+      const std::list<std::shared_ptr<Analyzer::Expr>>& quals,
+      const std::vector<InputTableInfo>& query_infos,
+      const Data_Namespace::MemoryLevel memory_level,
+      const int device_count,
+      ColumnCacheMap& column_cache,
+      Executor* executor);
+
+  std::string toString(const ExecutorDeviceType device_type,
+                       const int device_id = 0,
+                       bool raw = false) const override;
+
+  DecodedJoinHashBufferSet toSet(const ExecutorDeviceType device_type,
+                                 const int device_id) const override;
+
+  llvm::Value* codegenSlot(const CompilationOptions&, const size_t) override;
+
+  HashJoinMatchingSet codegenMatchingSet(const CompilationOptions&,
+                                         const size_t) override;
+
+  int getInnerTableId() const noexcept override { return key_col_->get_table_id(); }
+
+  int getInnerTableRteIdx() const noexcept override { return key_col_->get_rte_idx(); }
+
+  HashType getHashType() const noexcept override { return HashType::OneToMany; }
+
+  Data_Namespace::MemoryLevel getMemoryLevel() const noexcept override {
+    return memory_level_;
+  }
+
+  int getDeviceCount() const noexcept override { return device_count_; }
+
+  size_t offsetBufferOff() const noexcept override { return 0; }
+
+  size_t countBufferOff() const noexcept override { return 0; }
+
+  size_t payloadBufferOff() const noexcept override;
+
+  std::string getHashJoinType() const final { return "Range"; }
+
+  virtual ~RangeJoinHashTable() {}
+
+ private:
+  RangeJoinHashTable(const Analyzer::ColumnVar* key_col,
+                     const Analyzer::ColumnVar* end_col,
+                     const std::shared_ptr<Analyzer::Expr> lower_bound,
+                     const std::shared_ptr<Analyzer::Expr> upper_bound,
+                     const std::vector<InputTableInfo>& query_infos,
+                     const Data_Namespace::MemoryLevel memory_level,
+                     const int device_count,
+                     ColumnCacheMap& column_cache,
+                     Executor* executor)
+      : key_col_(std::dynamic_pointer_cast<Analyzer::ColumnVar>(key_col->deep_copy()))
+      , end_col_(end_col ? std::dynamic_pointer_cast<Analyzer::ColumnVar>(
+                               end_col->deep_copy())
+                         : nullptr)
+      , lower_bound_(lower_bound)
+      , upper_bound_(upper_bound)
+      , query_infos_(query_infos)
+      , memory_level_(memory_level)
+      , device_count_(device_count)
+      , column_cache_(column_cache)
+      , executor_(executor) {
+    CHECK_GT(device_count_, 0);
+    hash_tables_for_device_.resize(device_count_);
+  }
+
+  void reify();
+
+  size_t getComponentBufferSize() const noexcept override { return 0; }
+
+  // The sorted column, the starts of the intervals when `end_col_` is set.
+  std::shared_ptr<Analyzer::ColumnVar> key_col_;
+  std::shared_ptr<Analyzer::ColumnVar> end_col_;
+  // The probed key range, in terms of the outer tables.
+  std::shared_ptr<Analyzer::Expr> lower_bound_;
+  std::shared_ptr<Analyzer::Expr> upper_bound_;
+  const std::vector<InputTableInfo>& query_infos_;
+  const Data_Namespace::MemoryLevel memory_level_;
+  const int device_count_;
+  ColumnCacheMap& column_cache_;
+  Executor* executor_;
+};
@@ -89,8 +89,8 @@ struct GenericKeyHandler {
             static_cast<const StringDictionaryProxy*>(sd_inner_proxy);
         const auto sd_outer_dict_proxy =
             static_cast<const StringDictionaryProxy*>(sd_outer_proxy);
-        const auto elem_str = sd_inner_dict_proxy->getString(elem);
-        const auto outer_id = sd_outer_dict_proxy->getIdOfString(elem_str);
+        const auto outer_id =
+            sd_inner_dict_proxy->translateStringId(elem, sd_outer_dict_proxy);
         if (outer_id == StringDictionary::INVALID_STR_ID) {
           skip_entry = true;
           break;
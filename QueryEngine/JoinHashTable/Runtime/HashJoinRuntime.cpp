@@ -34,6 +34,7 @@
 #include "StringDictionary/StringDictionary.h"
 #include "StringDictionary/StringDictionaryProxy.h"
 
+#include <atomic>
 #include <future>
 #endif
 
@@ -78,8 +79,7 @@ inline int64_t translate_str_id_to_outer_dict(const int64_t elem,
       static_cast<const StringDictionaryProxy*>(sd_inner_proxy);
   const auto sd_outer_dict_proxy =
       static_cast<const StringDictionaryProxy*>(sd_outer_proxy);
-  const auto elem_str = sd_inner_dict_proxy->getString(elem);
-  const auto outer_id = sd_outer_dict_proxy->getIdOfString(elem_str);
+  const auto outer_id = sd_inner_dict_proxy->translateStringId(elem, sd_outer_dict_proxy);
   if (outer_id > max_elem || outer_id < min_elem) {
     return StringDictionary::INVALID_STR_ID;
   }
@@ -221,6 +221,67 @@ DEVICE int SUFFIX(fill_hash_join_buff)(int32_t* buff,
                                   hashtable_filling_func);
 }
 
+#ifndef __CUDACC__
+void fill_sparse_hash_join_bitmap(uint64_t* bitmap,
+                                  const JoinColumn join_column,
+                                  const JoinColumnTypeInfo type_info,
+                                  const void* sd_inner_proxy,
+                                  const void* sd_outer_proxy,
+                                  const int32_t cpu_thread_idx,
+                                  const int32_t cpu_thread_count) {
+  auto hashtable_filling_func = [&](auto elem, size_t) {
+    const int64_t bit_idx = elem - type_info.min_val;
+#ifdef _MSC_VER
+    InterlockedOr64(reinterpret_cast<volatile long long*>(bitmap + (bit_idx >> 6)),
+                    static_cast<long long>(uint64_t(1) << (bit_idx & 63)));
+#else
+    __sync_fetch_and_or(bitmap + (bit_idx >> 6), uint64_t(1) << (bit_idx & 63));
+#endif
+    return 0;
+  };
+
+  fill_hash_join_buff_impl(nullptr,
+                           -1,
+                           join_column,
+                           type_info,
+                           sd_inner_proxy,
+                           sd_outer_proxy,
+                           cpu_thread_idx,
+                           cpu_thread_count,
+                           hashtable_filling_func);
+}
+
+int fill_sparse_hash_join_buff(int32_t* buff,
+                               const int64_t bitmap_word_count,
+                               const int32_t invalid_slot_val,
+                               const bool for_semi_join,
+                               const JoinColumn join_column,
+                               const JoinColumnTypeInfo type_info,
+                               const void* sd_inner_proxy,
+                               const void* sd_outer_proxy,
+                               const int32_t cpu_thread_idx,
+                               const int32_t cpu_thread_count) {
+  auto filling_func = for_semi_join ? SUFFIX(fill_hashtable_for_semi_join)
+                                    : SUFFIX(fill_one_to_one_hashtable);
+  auto hashtable_filling_func = [&](auto elem, size_t index) {
+    auto entry_ptr =
+        SUFFIX(get_sparse_hash_slot)(buff, elem, type_info.min_val, bitmap_word_count);
+    CHECK(entry_ptr);
+    return filling_func(index, entry_ptr, invalid_slot_val);
+  };
+
+  return fill_hash_join_buff_impl(buff,
+                                  invalid_slot_val,
+                                  join_column,
+                                  type_info,
+                                  sd_inner_proxy,
+                                  sd_outer_proxy,
+                                  cpu_thread_idx,
+                                  cpu_thread_count,
+                                  hashtable_filling_func);
+}
+#endif
+
 template <typename HASHTABLE_FILLING_FUNC>
 DEVICE int fill_hash_join_buff_sharded_impl(int32_t* buff,
                                             const int32_t invalid_slot_val,
@@ -1821,6 +1882,175 @@ int overlaps_fill_baseline_hash_join_buff_64(int8_t* hash_buff,
                                                cpu_thread_count);
 }
 
+namespace {
+
+template <typename T>
+int fill_baseline_hash_join_buff_partitioned(int8_t* hash_buff,
+                                             const int64_t entry_count,
+                                             const int32_t invalid_slot_val,
+                                             const bool for_semi_join,
+                                             const size_t key_component_count,
+                                             const bool with_val_slot,
+                                             const GenericKeyHandler* key_handler,
+                                             const size_t partition_count,
+                                             const int32_t cpu_thread_count) {
+  CHECK_GT(partition_count, size_t(1));
+  const size_t key_size_in_bytes = key_component_count * sizeof(T);
+  const size_t hash_entry_size =
+      (key_component_count + (with_val_slot ? 1 : 0)) * sizeof(T);
+
+  // Keys of one thread's slice of the input, clustered by the partition of the hash
+  // table their home slot falls into. Partition i spans the keys in
+  // [partition_offsets[i], partition_offsets[i + 1]).
+  struct PartitionedKeys {
+    std::vector<T> keys;
+    std::vector<int32_t> row_ids;
+    std::vector<size_t> partition_offsets;
+  };
+  std::vector<PartitionedKeys> keys_per_thread(cpu_thread_count);
+
+  std::vector<std::future<void>> partition_threads;
+  for (int32_t cpu_thread_idx = 0; cpu_thread_idx < cpu_thread_count; ++cpu_thread_idx) {
+    partition_threads.push_back(std::async(std::launch::async, [&, cpu_thread_idx] {
+      std::vector<T> keys;
+      std::vector<int32_t> row_ids;
+      std::vector<size_t> partitions;
+      std::vector<size_t> partition_offsets(partition_count + 1, 0);
+      auto key_buff_handler = [&](const int64_t entry_idx,
+                                  const T* key_scratch_buffer,
+                                  const size_t key_count) {
+        const uint32_t h =
+            MurmurHash1Impl(key_scratch_buffer, key_size_in_bytes, 0) % entry_count;
+        const size_t partition = static_cast<uint64_t>(h) * partition_count / entry_count;
+        keys.insert(keys.end(), key_scratch_buffer, key_scratch_buffer + key_count);
+        row_ids.push_back(entry_idx);
+        partitions.push_back(partition);
+        ++partition_offsets[partition + 1];
+        return 0;
+      };
+      T key_scratch_buff[g_maximum_conditions_to_coalesce];
+      JoinColumnTuple cols(key_handler->get_number_of_columns(),
+                           key_handler->get_join_columns(),
+                           key_handler->get_join_column_type_infos());
+      for (auto& it : cols.slice(cpu_thread_idx, cpu_thread_count)) {
+        (*key_handler)(it.join_column_iterators, key_scratch_buff, key_buff_handler);
+      }
+      std::partial_sum(
+          partition_offsets.begin(), partition_offsets.end(), partition_offsets.begin());
+
+      auto& partitioned_keys = keys_per_thread[cpu_thread_idx];
+      partitioned_keys.keys.resize(keys.size());
+      partitioned_keys.row_ids.resize(row_ids.size());
+      auto write_pos = partition_offsets;
+      for (size_t i = 0; i < row_ids.size(); ++i) {
+        const auto pos = write_pos[partitions[i]]++;
+        std::copy(keys.begin() + i * key_component_count,
+                  keys.begin() + (i + 1) * key_component_count,
+                  partitioned_keys.keys.begin() + pos * key_component_count);
+        partitioned_keys.row_ids[pos] = row_ids[i];
+      }
+      partitioned_keys.partition_offsets = std::move(partition_offsets);
+    }));
+  }
+  for (auto& child : partition_threads) {
+    child.get();
+  }
+
+  // Each partition is inserted by a single thread, which keeps its writes to a slice of
+  // the hash table small enough to stay in cache. Probing may still run past the end of
+  // the slice, the slots are claimed with CAS as in the unpartitioned build.
+  std::atomic<size_t> next_partition{0};
+  std::vector<std::future<int>> insert_threads;
+  for (int32_t cpu_thread_idx = 0; cpu_thread_idx < cpu_thread_count; ++cpu_thread_idx) {
+    insert_threads.push_back(std::async(std::launch::async, [&] {
+      for (size_t partition = next_partition++; partition < partition_count;
+           partition = next_partition++) {
+        for (const auto& partitioned_keys : keys_per_thread) {
+          const auto& offsets = partitioned_keys.partition_offsets;
+          for (size_t i = offsets[partition]; i < offsets[partition + 1]; ++i) {
+            const auto key = &partitioned_keys.keys[i * key_component_count];
+            const auto err =
+                for_semi_join
+                    ? write_baseline_hash_slot_for_semi_join<T>(
+                          partitioned_keys.row_ids[i],
+                          hash_buff,
+                          entry_count,
+                          key,
+                          key_component_count,
+                          with_val_slot,
+                          invalid_slot_val,
+                          key_size_in_bytes,
+                          hash_entry_size)
+                    : write_baseline_hash_slot<T>(partitioned_keys.row_ids[i],
+                                                  hash_buff,
+                                                  entry_count,
+                                                  key,
+                                                  key_component_count,
+                                                  with_val_slot,
+                                                  invalid_slot_val,
+                                                  key_size_in_bytes,
+                                                  hash_entry_size);
+            if (err) {
+              return err;
+            }
+          }
+        }
+      }
+      return 0;
+    }));
+  }
+  int err = 0;
+  for (auto& child : insert_threads) {
+    const auto partial_err = child.get();
+    if (partial_err) {
+      err = partial_err;
+    }
+  }
+  return err;
+}
+
+}  // namespace
+
+int fill_baseline_hash_join_buff_partitioned_32(int8_t* hash_buff,
+                                                const int64_t entry_count,
+                                                const int32_t invalid_slot_val,
+                                                const bool for_semi_join,
+                                                const size_t key_component_count,
+                                                const bool with_val_slot,
+                                                const GenericKeyHandler* key_handler,
+                                                const size_t partition_count,
+                                                const int32_t cpu_thread_count) {
+  return fill_baseline_hash_join_buff_partitioned<int32_t>(hash_buff,
+                                                           entry_count,
+                                                           invalid_slot_val,
+                                                           for_semi_join,
+                                                           key_component_count,
+                                                           with_val_slot,
+                                                           key_handler,
+                                                           partition_count,
+                                                           cpu_thread_count);
+}
+
+int fill_baseline_hash_join_buff_partitioned_64(int8_t* hash_buff,
+                                                const int64_t entry_count,
+                                                const int32_t invalid_slot_val,
+                                                const bool for_semi_join,
+                                                const size_t key_component_count,
+                                                const bool with_val_slot,
+                                                const GenericKeyHandler* key_handler,
+                                                const size_t partition_count,
+                                                const int32_t cpu_thread_count) {
+  return fill_baseline_hash_join_buff_partitioned<int64_t>(hash_buff,
+                                                           entry_count,
+                                                           invalid_slot_val,
+                                                           for_semi_join,
+                                                           key_component_count,
+                                                           with_val_slot,
+                                                           key_handler,
+                                                           partition_count,
+                                                           cpu_thread_count);
+}
+
 template <typename T>
 void fill_one_to_many_baseline_hash_table(
     int32_t* buff,
@@ -2083,10 +2313,12 @@ void approximate_distinct_tuples_overlaps(
     const std::vector<JoinColumn>& join_column_per_key,
     const std::vector<JoinColumnTypeInfo>& type_info_per_key,
     const std::vector<JoinBucketInfo>& join_buckets_per_key,
-    const int thread_count) {
+    const int thread_count,
+    const size_t sample_stride) {
   CHECK_EQ(join_column_per_key.size(), join_buckets_per_key.size());
   CHECK_EQ(join_column_per_key.size(), type_info_per_key.size());
   CHECK(!join_column_per_key.empty());
+  CHECK_GE(sample_stride, size_t(1));
 
   std::vector<std::future<void>> approx_distinct_threads;
   for (int thread_idx = 0; thread_idx < thread_count; ++thread_idx) {
@@ -2099,20 +2331,24 @@ void approximate_distinct_tuples_overlaps(
          hll_buffer_all_cpus,
          padded_size_bytes,
          thread_idx,
-         thread_count] {
+         thread_count,
+         sample_stride] {
           auto hll_buffer = hll_buffer_all_cpus + thread_idx * padded_size_bytes;
 
           const auto key_handler = OverlapsKeyHandler(
               join_buckets_per_key[0].inverse_bucket_sizes_for_dimension.size(),
               &join_column_per_key[0],
               join_buckets_per_key[0].inverse_bucket_sizes_for_dimension.data());
+          // with a stride, the threads only visit the first thread_count rows out of
+          // every thread_count * sample_stride
+          const auto step = static_cast<int32_t>(thread_count * sample_stride);
           approximate_distinct_tuples_impl(hll_buffer,
                                            row_counts.data(),
                                            b,
                                            join_column_per_key[0].num_elems,
                                            &key_handler,
                                            thread_idx,
-                                           thread_count);
+                                           step);
         }));
   }
   for (auto& child : approx_distinct_threads) {
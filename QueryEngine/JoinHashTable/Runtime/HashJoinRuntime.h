@@ -158,6 +158,28 @@ int fill_hash_join_buff(int32_t* buff,
                         const int32_t cpu_thread_idx,
                         const int32_t cpu_thread_count);
 
+// Sets the bits of the keys present in `join_column` in the bitmap of a sparse perfect
+// hash table, see get_sparse_hash_slot.
+void fill_sparse_hash_join_bitmap(uint64_t* bitmap,
+                                  const JoinColumn join_column,
+                                  const JoinColumnTypeInfo type_info,
+                                  const void* sd_inner,
+                                  const void* sd_outer,
+                                  const int32_t cpu_thread_idx,
+                                  const int32_t cpu_thread_count);
+
+// Fills the slots of a sparse perfect hash table whose bitmap and word ranks are set.
+int fill_sparse_hash_join_buff(int32_t* buff,
+                               const int64_t bitmap_word_count,
+                               const int32_t invalid_slot_val,
+                               const bool for_semi_join,
+                               const JoinColumn join_column,
+                               const JoinColumnTypeInfo type_info,
+                               const void* sd_inner,
+                               const void* sd_outer,
+                               const int32_t cpu_thread_idx,
+                               const int32_t cpu_thread_count);
+
 void fill_hash_join_buff_on_device(int32_t* buff,
                                    const int32_t invalid_slot_val,
                                    const bool for_semi_join,
@@ -287,6 +309,30 @@ int overlaps_fill_baseline_hash_join_buff_64(int8_t* hash_buff,
                                              const int32_t cpu_thread_idx,
                                              const int32_t cpu_thread_count);
 
+// Radix partitioned variants of fill_baseline_hash_join_buff_{32,64}, which spawn their
+// own `cpu_thread_count` threads. The keys are first clustered by the slice of the hash
+// table their home slot falls into, then each of the `partition_count` slices is filled
+// by a single thread.
+int fill_baseline_hash_join_buff_partitioned_32(int8_t* hash_buff,
+                                                const int64_t entry_count,
+                                                const int32_t invalid_slot_val,
+                                                const bool for_semi_join,
+                                                const size_t key_component_count,
+                                                const bool with_val_slot,
+                                                const GenericKeyHandler* key_handler,
+                                                const size_t partition_count,
+                                                const int32_t cpu_thread_count);
+
+int fill_baseline_hash_join_buff_partitioned_64(int8_t* hash_buff,
+                                                const int64_t entry_count,
+                                                const int32_t invalid_slot_val,
+                                                const bool for_semi_join,
+                                                const size_t key_component_count,
+                                                const bool with_val_slot,
+                                                const GenericKeyHandler* key_handler,
+                                                const size_t partition_count,
+                                                const int32_t cpu_thread_count);
+
 void fill_baseline_hash_join_buff_on_device_32(int8_t* hash_buff,
                                                const int64_t entry_count,
                                                const int32_t invalid_slot_val,
@@ -383,7 +429,8 @@ void approximate_distinct_tuples_overlaps(
     const std::vector<JoinColumn>& join_column_per_key,
     const std::vector<JoinColumnTypeInfo>& type_info_per_key,
     const std::vector<JoinBucketInfo>& join_buckets_per_key,
-    const int thread_count);
+    const int thread_count,
+    const size_t sample_stride);
 
 void approximate_distinct_tuples_on_device(uint8_t* hll_buffer,
                                            const uint32_t b,
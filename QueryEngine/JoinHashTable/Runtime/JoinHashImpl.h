@@ -135,4 +135,35 @@ extern "C" ALWAYS_INLINE DEVICE int32_t* SUFFIX(get_hash_slot_sharded_opt)(
   return shard_buffer + (key - min_key) / num_shards;
 }
 
+#ifdef __CUDACC__
+#define sparse_hash_popcount(word) __popcll(word)
+#elif defined(_MSC_VER)
+#include <intrin.h>
+#define sparse_hash_popcount(word) __popcnt64(word)
+#else
+#define sparse_hash_popcount(word) __builtin_popcountll(word)
+#endif
+
+// Sparse perfect hash tables start with a bitmap of the keys present in the key range,
+// 64 keys per word, followed by the number of keys present before each word of the
+// bitmap and by one slot per key present, in key order. Returns nullptr for the keys
+// which are not present.
+extern "C" ALWAYS_INLINE DEVICE int32_t* SUFFIX(get_sparse_hash_slot)(
+    int32_t* buff,
+    const int64_t key,
+    const int64_t min_key,
+    const int64_t bitmap_word_count) {
+  const int64_t bit_idx = key - min_key;
+  const uint64_t word = reinterpret_cast<const uint64_t*>(buff)[bit_idx >> 6];
+  const uint64_t bit = uint64_t(1) << (bit_idx & 63);
+  if (!(word & bit)) {
+    return nullptr;
+  }
+  const int32_t* word_ranks = buff + 2 * bitmap_word_count;
+  int32_t* slots = buff + 3 * bitmap_word_count;
+  return slots + word_ranks[bit_idx >> 6] + sparse_hash_popcount(word & (bit - 1));
+}
+
+#undef sparse_hash_popcount
+
 #endif  // QUERYENGINE_GROUPBYFASTIMPL_H
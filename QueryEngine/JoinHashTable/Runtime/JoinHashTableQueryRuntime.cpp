@@ -21,6 +21,7 @@
 #include "Geospatial/CompressionRuntime.h"
 #include "QueryEngine/CompareKeysInl.h"
 #include "QueryEngine/MurmurHash.h"
+#include "QueryEngine/MurmurHash1Inl.h"
 
 DEVICE bool compare_to_key(const int8_t* entry,
                            const int8_t* key,
@@ -40,13 +41,22 @@ const int kNotPresent = -2;
 
 }  // namespace
 
-template <class T>
+// The probes below take the number of key components as a template argument for the
+// most common keys, which lets the hash and the key comparison be unrolled into a few
+// whole word operations, 0 stands for a number of key components only known at runtime.
+// Keys are made of components as wide as the slots of the hash table.
+
+template <class T, size_t KEY_COMPONENT_COUNT = 0>
 DEVICE int64_t get_matching_slot(const int8_t* hash_buff,
                                  const uint32_t h,
                                  const int8_t* key,
                                  const size_t key_bytes) {
   const auto lookup_result_ptr = hash_buff + h * (key_bytes + sizeof(T));
-  if (compare_to_key(lookup_result_ptr, key, key_bytes)) {
+  if (KEY_COMPONENT_COUNT
+          ? keys_are_equal(reinterpret_cast<const T*>(lookup_result_ptr),
+                           reinterpret_cast<const T*>(key),
+                           KEY_COMPONENT_COUNT)
+          : compare_to_key(lookup_result_ptr, key, key_bytes)) {
     return *reinterpret_cast<const T*>(lookup_result_ptr + key_bytes);
   }
   if (*reinterpret_cast<const T*>(lookup_result_ptr) ==
@@ -56,7 +66,7 @@ DEVICE int64_t get_matching_slot(const int8_t* hash_buff,
   return kNoMatch;
 }
 
-template <class T>
+template <class T, size_t KEY_COMPONENT_COUNT = 0>
 FORCE_INLINE DEVICE int64_t baseline_hash_join_idx_impl(const int8_t* hash_buff,
                                                         const int8_t* key,
                                                         const size_t key_bytes,
@@ -64,14 +74,18 @@ FORCE_INLINE DEVICE int64_t baseline_hash_join_idx_impl(const int8_t* hash_buff,
   if (!entry_count) {
     return kNoMatch;
   }
-  const uint32_t h = MurmurHash1(key, key_bytes, 0) % entry_count;
-  int64_t matching_slot = get_matching_slot<T>(hash_buff, h, key, key_bytes);
+  const uint32_t h = (KEY_COMPONENT_COUNT ? MurmurHash1Impl(key, key_bytes, 0)
+                                          : MurmurHash1(key, key_bytes, 0)) %
+                     entry_count;
+  int64_t matching_slot =
+      get_matching_slot<T, KEY_COMPONENT_COUNT>(hash_buff, h, key, key_bytes);
   if (matching_slot != kNoMatch) {
     return matching_slot;
   }
   uint32_t h_probe = (h + 1) % entry_count;
   while (h_probe != h) {
-    matching_slot = get_matching_slot<T>(hash_buff, h_probe, key, key_bytes);
+    matching_slot =
+        get_matching_slot<T, KEY_COMPONENT_COUNT>(hash_buff, h_probe, key, key_bytes);
     if (matching_slot != kNoMatch) {
       return matching_slot;
     }
@@ -96,6 +110,21 @@ baseline_hash_join_idx_64(const int8_t* hash_buff,
   return baseline_hash_join_idx_impl<int64_t>(hash_buff, key, key_bytes, entry_count);
 }
 
+#define DEF_BASELINE_HASH_JOIN_IDX_FIXED(key_component_count, width)                \
+  extern "C" RUNTIME_EXPORT NEVER_INLINE DEVICE int64_t                             \
+      baseline_hash_join_idx_##key_component_count##x##width(                       \
+          const int8_t* hash_buff, const int8_t* key, const size_t entry_count) {   \
+    return baseline_hash_join_idx_impl<int##width##_t, key_component_count>(        \
+        hash_buff, key, key_component_count * sizeof(int##width##_t), entry_count); \
+  }
+
+DEF_BASELINE_HASH_JOIN_IDX_FIXED(1, 32)
+DEF_BASELINE_HASH_JOIN_IDX_FIXED(1, 64)
+DEF_BASELINE_HASH_JOIN_IDX_FIXED(2, 32)
+DEF_BASELINE_HASH_JOIN_IDX_FIXED(2, 64)
+
+#undef DEF_BASELINE_HASH_JOIN_IDX_FIXED
+
 template <typename T>
 FORCE_INLINE DEVICE int64_t get_bucket_key_for_value_impl(const T value,
                                                           const double bucket_size) {
@@ -134,12 +163,15 @@ get_bucket_key_for_range_compressed(const int8_t* range,
       range, range_component_index, bucket_size);
 }
 
-template <typename T>
+template <typename T, size_t KEY_COMPONENT_COUNT = 0>
 FORCE_INLINE DEVICE int64_t get_composite_key_index_impl(const T* key,
                                                          const size_t key_component_count,
                                                          const T* composite_key_dict,
                                                          const size_t entry_count) {
-  const uint32_t h = MurmurHash1(key, key_component_count * sizeof(T), 0) % entry_count;
+  const auto key_bytes = key_component_count * sizeof(T);
+  const uint32_t h = (KEY_COMPONENT_COUNT ? MurmurHash1Impl(key, key_bytes, 0)
+                                          : MurmurHash1(key, key_bytes, 0)) %
+                     entry_count;
   uint32_t off = h * key_component_count;
   if (keys_are_equal(&composite_key_dict[off], key, key_component_count)) {
     return h;
@@ -176,6 +208,23 @@ get_composite_key_index_64(const int64_t* key,
       key, key_component_count, composite_key_dict, entry_count);
 }
 
+#define DEF_GET_COMPOSITE_KEY_INDEX_FIXED(key_component_count, width)         \
+  extern "C" RUNTIME_EXPORT NEVER_INLINE DEVICE int64_t                       \
+      get_composite_key_index_##key_component_count##x##width(                \
+          const int##width##_t* key,                                          \
+          const int##width##_t* composite_key_dict,                           \
+          const size_t entry_count) {                                         \
+    return get_composite_key_index_impl<int##width##_t, key_component_count>( \
+        key, key_component_count, composite_key_dict, entry_count);           \
+  }
+
+DEF_GET_COMPOSITE_KEY_INDEX_FIXED(1, 32)
+DEF_GET_COMPOSITE_KEY_INDEX_FIXED(1, 64)
+DEF_GET_COMPOSITE_KEY_INDEX_FIXED(2, 32)
+DEF_GET_COMPOSITE_KEY_INDEX_FIXED(2, 64)
+
+#undef DEF_GET_COMPOSITE_KEY_INDEX_FIXED
+
 extern "C" RUNTIME_EXPORT NEVER_INLINE DEVICE int32_t insert_sorted(int32_t* arr,
                                                                     size_t elem_count,
                                                                     int32_t elem) {
@@ -354,3 +403,51 @@ get_num_buckets_for_bounds(const int8_t* range_bytes,
 
   return num_buckets;
 }
+
+// Range join tables are made of the number of keys, the lower extent of the probed
+// ranges, the sorted keys and the row id of each key, see RangeHashTable.
+
+// Index of the first key not less than the lower end of a probed range.
+extern "C" RUNTIME_EXPORT ALWAYS_INLINE DEVICE int64_t
+range_join_lower_bound(int64_t range_buff, const int64_t lower) {
+  const auto header = reinterpret_cast<const int64_t*>(range_buff);
+  const auto keys = header + 2;
+  const int64_t min_int64 = -9223372036854775807LL - 1;
+  // Clamp rather than overflow for the lowest keys.
+  const auto key = lower < min_int64 + header[1] ? min_int64 : lower - header[1];
+  int64_t begin = 0;
+  int64_t end = header[0];
+  while (begin < end) {
+    const auto mid = begin + (end - begin) / 2;
+    if (keys[mid] < key) {
+      begin = mid + 1;
+    } else {
+      end = mid;
+    }
+  }
+  return begin;
+}
+
+// Index past the last key not greater than the upper end of a probed range.
+extern "C" RUNTIME_EXPORT ALWAYS_INLINE DEVICE int64_t
+range_join_upper_bound(int64_t range_buff, const int64_t upper) {
+  const auto header = reinterpret_cast<const int64_t*>(range_buff);
+  const auto keys = header + 2;
+  int64_t begin = 0;
+  int64_t end = header[0];
+  while (begin < end) {
+    const auto mid = begin + (end - begin) / 2;
+    if (keys[mid] <= upper) {
+      begin = mid + 1;
+    } else {
+      end = mid;
+    }
+  }
+  return begin;
+}
+
+extern "C" RUNTIME_EXPORT ALWAYS_INLINE DEVICE int64_t
+range_join_row_ids(int64_t range_buff) {
+  const auto header = reinterpret_cast<const int64_t*>(range_buff);
+  return reinterpret_cast<int64_t>(header + 2 + header[0]);
+}
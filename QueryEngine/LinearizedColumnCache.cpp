@@ -0,0 +1,111 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "QueryEngine/LinearizedColumnCache.h"
+
+#include "Logger/Logger.h"
+#include "QueryEngine/ColumnarResults.h"
+#include "QueryEngine/Descriptors/RowSetMemoryOwner.h"
+
+size_t g_linearized_column_cache_max_bytes{0};
+
+namespace {
+
+// Keeps the memory of a cached column alive for as long as the column is referenced.
+struct OwnedColumn {
+  std::shared_ptr<RowSetMemoryOwner> row_set_mem_owner;
+  std::unique_ptr<ColumnarResults> column;
+};
+
+}  // namespace
+
+LinearizedColumnCache& LinearizedColumnCache::instance() {
+  static LinearizedColumnCache linearized_column_cache;
+  return linearized_column_cache;
+}
+
+std::shared_ptr<const ColumnarResults> LinearizedColumnCache::get(const Key& key) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    return nullptr;
+  }
+  lru_.splice(lru_.begin(), lru_, it->second.lru_it);
+  return it->second.column;
+}
+
+std::shared_ptr<const ColumnarResults> LinearizedColumnCache::put(
+    const Key& key,
+    std::shared_ptr<RowSetMemoryOwner> row_set_mem_owner,
+    std::unique_ptr<ColumnarResults> column,
+    const size_t size_bytes) {
+  CHECK(row_set_mem_owner);
+  CHECK(column);
+  if (size_bytes > g_linearized_column_cache_max_bytes) {
+    VLOG(1) << "Not caching a linearized column of " << size_bytes
+            << " bytes, over the cache budget of " << g_linearized_column_cache_max_bytes
+            << " bytes.";
+    return nullptr;
+  }
+  auto owned_column = std::make_shared<OwnedColumn>(
+      OwnedColumn{std::move(row_set_mem_owner), std::move(column)});
+  const auto column_ptr = owned_column->column.get();
+  std::shared_ptr<const ColumnarResults> cached_column(std::move(owned_column),
+                                                       column_ptr);
+  std::lock_guard<std::mutex> guard(mutex_);
+  auto it = entries_.find(key);
+  if (it != entries_.end()) {
+    size_bytes_ -= it->second.size_bytes;
+    it->second.column = cached_column;
+    it->second.size_bytes = size_bytes;
+    lru_.splice(lru_.begin(), lru_, it->second.lru_it);
+  } else {
+    lru_.push_front(key);
+    entries_.emplace(key, CacheEntry{cached_column, size_bytes, lru_.begin()});
+  }
+  size_bytes_ += size_bytes;
+  evictUnlocked();
+  return cached_column;
+}
+
+void LinearizedColumnCache::clear() {
+  std::lock_guard<std::mutex> guard(mutex_);
+  VLOG(1) << "Invalidating " << entries_.size() << " linearized columns.";
+  entries_.clear();
+  lru_.clear();
+  size_bytes_ = 0;
+}
+
+size_t LinearizedColumnCache::getNumberOfCachedColumns() {
+  std::lock_guard<std::mutex> guard(mutex_);
+  return entries_.size();
+}
+
+size_t LinearizedColumnCache::getSizeBytes() {
+  std::lock_guard<std::mutex> guard(mutex_);
+  return size_bytes_;
+}
+
+void LinearizedColumnCache::evictUnlocked() {
+  while (size_bytes_ > g_linearized_column_cache_max_bytes) {
+    CHECK(!lru_.empty());
+    auto it = entries_.find(lru_.back());
+    CHECK(it != entries_.end());
+    size_bytes_ -= it->second.size_bytes;
+    lru_.pop_back();
+    entries_.erase(it);
+  }
+}
@@ -0,0 +1,107 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include <boost/functional/hash.hpp>
+
+class ColumnarResults;
+class RowSetMemoryOwner;
+
+// Byte budget of the columns linearized across queries, 0 disables the cache.
+extern size_t g_linearized_column_cache_max_bytes;
+
+/**
+ * Server wide cache of the table columns which the ColumnFetcher merges over all the
+ * fragments of a table, mostly the inner columns of joins, so that queries joining the
+ * same dimension tables do not linearize them over again. Keys include the state (epoch,
+ * fragments and their row counts) of the table, loads change the key of the columns of
+ * the table while updates and deletes clear the cache through the cache invalidators.
+ *
+ * A cached column owns its memory, separately from the queries using it; evicting a
+ * column in use only releases it once the last query using it is done.
+ */
+class LinearizedColumnCache {
+ public:
+  struct Key {
+    int db_id;
+    int table_id;
+    int column_id;
+    // Hash of the epoch of the table and of the ids and row counts of its fragments.
+    size_t table_state;
+
+    bool operator==(const Key& other) const {
+      return db_id == other.db_id && table_id == other.table_id &&
+             column_id == other.column_id && table_state == other.table_state;
+    }
+  };
+
+  struct KeyHash {
+    size_t operator()(const Key& key) const {
+      size_t hash = 0;
+      boost::hash_combine(hash, key.db_id);
+      boost::hash_combine(hash, key.table_id);
+      boost::hash_combine(hash, key.column_id);
+      boost::hash_combine(hash, key.table_state);
+      return hash;
+    }
+  };
+
+  static LinearizedColumnCache& instance();
+
+  static std::function<void()> getCacheInvalidator() {
+    return []() -> void { instance().clear(); };
+  }
+
+  std::shared_ptr<const ColumnarResults> get(const Key& key);
+
+  // Caches `column`, whose buffers are held by `row_set_mem_owner`, and returns it, or
+  // returns nullptr if the column is over the byte budget of the cache.
+  std::shared_ptr<const ColumnarResults> put(
+      const Key& key,
+      std::shared_ptr<RowSetMemoryOwner> row_set_mem_owner,
+      std::unique_ptr<ColumnarResults> column,
+      const size_t size_bytes);
+
+  void clear();
+
+  // For testing purposes only
+  size_t getNumberOfCachedColumns();
+  size_t getSizeBytes();
+
+ private:
+  LinearizedColumnCache() {}
+
+  void evictUnlocked();
+
+  struct CacheEntry {
+    std::shared_ptr<const ColumnarResults> column;
+    size_t size_bytes;
+    // Position in lru_, the most recently used columns come first.
+    std::list<Key>::iterator lru_it;
+  };
+
+  std::unordered_map<Key, CacheEntry, KeyHash> entries_;
+  std::list<Key> lru_;
+  size_t size_bytes_{0};
+  std::mutex mutex_;
+};
@@ -209,6 +209,16 @@ llvm::BasicBlock* JoinLoop::codegen(
             prev_comparison_result = ll_bool(true, context);
             break;
           }
+          case JoinType::SEMI: {
+            // Each outer row is visited at most once, since the lookup only produces
+            // the first match.
+            prev_comparison_result = match_found;
+            break;
+          }
+          case JoinType::ANTI: {
+            prev_comparison_result = builder.CreateNot(match_found);
+            break;
+          }
           default:
             CHECK(false);
         }
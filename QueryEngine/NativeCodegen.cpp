@@ -20,6 +20,7 @@
 #include "GpuSharedMemoryUtils.h"
 #include "LLVMFunctionAttributesUtil.h"
 #include "OutputBufferInitialization.h"
+#include "PersistentCodeCache.h"
 #include "QueryTemplateGenerator.h"
 
 #include "CudaMgr/CudaMgr.h"
@@ -32,6 +33,7 @@
 static_assert(false, "LLVM Version >= 9 is required.");
 #endif
 
+#include <llvm/Analysis/TargetTransformInfo.h>
 #include <llvm/Bitcode/BitcodeReader.h>
 #include <llvm/Bitcode/BitcodeWriter.h>
 #include <llvm/ExecutionEngine/MCJIT.h>
@@ -63,12 +65,19 @@ static_assert(false, "LLVM Version >= 9 is required.");
 #include <llvm/Transforms/Utils.h>
 #include <llvm/Transforms/Utils/BasicBlockUtils.h>
 #include <llvm/Transforms/Utils/Cloning.h>
+#include <llvm/Transforms/Vectorize.h>
 
 #if LLVM_VERSION_MAJOR >= 11
 #include <llvm/Support/Host.h>
 #endif
 
 float g_fraction_code_cache_to_evict = 0.2;
+bool g_enable_background_jit{false};
+size_t g_jit_low_tier_max_rows{10000};
+size_t g_jit_tier_promotion_count{3};
+bool g_enable_parallel_gpu_module_load{true};
+bool g_enable_cpu_loop_vectorization{false};
+bool g_enable_shared_cpu_group_by_buffer{false};
 
 std::unique_ptr<llvm::Module> udf_gpu_module;
 std::unique_ptr<llvm::Module> udf_cpu_module;
@@ -244,6 +253,11 @@ scan_function_calls(llvm::Module& module,
   return std::make_tuple(defined, undefined);
 }
 
+bool use_cpu_loop_vectorization(const CompilationOptions& co) {
+  return g_enable_cpu_loop_vectorization && co.device_type == ExecutorDeviceType::CPU &&
+         co.opt_level != ExecutorOptLevel::ReductionJIT;
+}
+
 #if defined(HAVE_CUDA) || !defined(WITH_JIT_DEBUG)
 void eliminate_dead_self_recursive_funcs(
     llvm::Module& M,
@@ -321,6 +335,16 @@ void optimize_ir(llvm::Function* query_func,
   if (co.opt_level == ExecutorOptLevel::LoopStrengthReduction) {
     pass_manager.add(llvm::createLoopStrengthReducePass());
   }
+  if (use_cpu_loop_vectorization(co)) {
+    // The row function has been inlined into the query loop by now, so the loop
+    // vectorizer sees the whole per-row computation. It leaves loops alone where it is
+    // not legal or not profitable, e.g. for output slot allocation in projections.
+    pass_manager.add(llvm::createLoopRotatePass());
+    pass_manager.add(llvm::createLoopVectorizePass());
+    pass_manager.add(llvm::createSLPVectorizerPass());
+    pass_manager.add(llvm::createInstructionCombiningPass());
+    pass_manager.add(llvm::createCFGSimplificationPass());
+  }
   pass_manager.run(*module);
 
   eliminate_dead_self_recursive_funcs(*module, live_funcs);
@@ -374,6 +398,11 @@ void verify_function_ir(const llvm::Function* func) {
 std::shared_ptr<CompilationContext> Executor::getCodeFromCache(const CodeCacheKey& key,
                                                                const CodeCache& cache) {
   auto it = cache.find(key);
+  (it != cache.cend() ? code_cache_hits_ : code_cache_misses_)
+      .fetch_add(1, std::memory_order_relaxed);
+  if (auto query_profile = getQueryProfile()) {
+    query_profile->addCodeCacheLookup(it != cache.cend());
+  }
   if (it != cache.cend()) {
     delete cgen_state_->module_;
     cgen_state_->module_ = it->second.second;
@@ -418,10 +447,26 @@ ExecutionEngineWrapper CodeGenerator::generateNativeCPUCode(
     const std::unordered_set<llvm::Function*>& live_funcs,
     const CompilationOptions& co) {
   auto module = func->getParent();
+  auto persistent_code_cache = PersistentCodeCache::get();
+  // Object code persisted by a previous run of the server replaces both the
+  // optimization and the native code generation for this module.
+  const bool has_persisted_object =
+      persistent_code_cache &&
+      persistent_code_cache->hasObject(module->getModuleIdentifier());
   // run optimizations
 #ifndef WITH_JIT_DEBUG
-  llvm::legacy::PassManager pass_manager;
-  optimize_ir(func, module, pass_manager, live_funcs, co);
+  if (!has_persisted_object) {
+    llvm::legacy::PassManager pass_manager;
+    std::unique_ptr<llvm::TargetMachine> host_target_machine;
+    if (use_cpu_loop_vectorization(co)) {
+      // The vectorizer cost model needs the vector register widths of the host.
+      host_target_machine.reset(llvm::EngineBuilder().selectTarget());
+      CHECK(host_target_machine);
+      pass_manager.add(llvm::createTargetTransformInfoWrapperPass(
+          host_target_machine->getTargetIRAnalysis()));
+    }
+    optimize_ir(func, module, pass_manager, live_funcs, co);
+  }
 #endif  // WITH_JIT_DEBUG
 
   auto init_err = llvm::InitializeNativeTarget();
@@ -452,6 +497,9 @@ ExecutionEngineWrapper CodeGenerator::generateNativeCPUCode(
 
   ExecutionEngineWrapper execution_engine(eb.create(), co);
   CHECK(execution_engine.get());
+  if (persistent_code_cache) {
+    execution_engine->setObjectCache(persistent_code_cache);
+  }
   LOG(ASM) << assemblyForCPU(execution_engine, module);
 
   execution_engine->finalizeObject();
@@ -462,7 +510,8 @@ std::shared_ptr<CompilationContext> Executor::optimizeAndCodegenCPU(
     llvm::Function* query_func,
     llvm::Function* multifrag_query_func,
     const std::unordered_set<llvm::Function*>& live_funcs,
-    const CompilationOptions& co) {
+    const CompilationOptions& co,
+    const size_t input_row_count_upper_bound) {
   auto module = multifrag_query_func->getParent();
   CodeCacheKey key{serialize_llvm_object(query_func),
                    serialize_llvm_object(cgen_state_->row_func_)};
@@ -474,9 +523,34 @@ std::shared_ptr<CompilationContext> Executor::optimizeAndCodegenCPU(
   }
   auto cached_code = getCodeFromCache(key, cpu_code_cache_);
   if (cached_code) {
+    auto cpu_compilation_context =
+        std::dynamic_pointer_cast<CpuCompilationContext>(cached_code);
+    CHECK(cpu_compilation_context);
+    auto low_tier_info = cpu_compilation_context->lowTierInfo();
+    // The module kept by the low tier code is compiled from scratch at the full tier,
+    // only the cache hit which reaches the promotion count hands it over.
+    if (low_tier_info &&
+        low_tier_info->reuse_count.fetch_add(1) + 1 == g_jit_tier_promotion_count) {
+      CHECK(low_tier_info->module);
+      jit_tier_promotions_.fetch_add(1, std::memory_order_relaxed);
+      scheduleBackgroundCodegenCPU(key,
+                                   std::move(low_tier_info->module),
+                                   low_tier_info->query_func_name,
+                                   low_tier_info->multifrag_query_func_name,
+                                   low_tier_info->live_func_names,
+                                   co);
+    }
     return cached_code;
   }
 
+  // Runtime UDFs are not part of the persistent cache build fingerprint, so modules
+  // which may link against them are never persisted.
+  auto persistent_code_cache = PersistentCodeCache::get();
+  const auto persistent_module_key =
+      persistent_code_cache && !rt_udf_cpu_module
+          ? persistent_code_cache->getModuleKey(key, "cpu")
+          : std::string{};
+
   if (cgen_state_->needs_geos_) {
 #ifdef ENABLE_GEOS
     load_geos_dynamic_library();
@@ -502,15 +576,131 @@ std::shared_ptr<CompilationContext> Executor::optimizeAndCodegenCPU(
 #endif
   }
 
+  // With background JIT enabled, the first execution of a query shape runs code built
+  // without backend optimizations, which takes a fraction of the time to compile, while
+  // a copy of the module is fully optimized in the background and takes its place in
+  // the code cache for later executions.
+  const bool has_persisted_object =
+      persistent_code_cache && persistent_code_cache->hasObject(persistent_module_key);
+  // Small inputs get the same quickly compiled code, which is only optimized fully if
+  // the query shape keeps coming back, see the code cache lookup above.
+  const bool compile_low_tier =
+      input_row_count_upper_bound <= g_jit_low_tier_max_rows &&
+      co.opt_level != ExecutorOptLevel::ReductionJIT && !has_persisted_object;
+  const bool compile_in_background = !compile_low_tier && g_enable_background_jit &&
+                                     co.opt_level != ExecutorOptLevel::ReductionJIT &&
+                                     !has_persisted_object;
+  std::unique_ptr<llvm::Module> background_module;
+  if (compile_in_background) {
+    background_module = llvm::CloneModule(*module);
+    background_module->setModuleIdentifier(persistent_module_key);
+  } else if (!persistent_module_key.empty() && !compile_low_tier) {
+    module->setModuleIdentifier(persistent_module_key);
+  }
+  std::unique_ptr<CpuCompilationContext::LowTierInfo> low_tier_info;
+  if (compile_low_tier) {
+    jit_low_tier_compilations_.fetch_add(1, std::memory_order_relaxed);
+    if (g_jit_tier_promotion_count > 0) {
+      low_tier_info = std::make_unique<CpuCompilationContext::LowTierInfo>();
+      low_tier_info->module = llvm::CloneModule(*module);
+      low_tier_info->module->setModuleIdentifier(persistent_module_key);
+      low_tier_info->query_func_name = query_func->getName().str();
+      low_tier_info->multifrag_query_func_name = multifrag_query_func->getName().str();
+      for (const auto live_func : live_funcs) {
+        low_tier_info->live_func_names.push_back(live_func->getName().str());
+      }
+    }
+  }
+
+  auto first_tier_co = co;
+  if (compile_in_background || compile_low_tier) {
+    first_tier_co.opt_level = ExecutorOptLevel::ReductionJIT;
+  }
   auto execution_engine =
-      CodeGenerator::generateNativeCPUCode(query_func, live_funcs, co);
+      CodeGenerator::generateNativeCPUCode(query_func, live_funcs, first_tier_co);
   auto cpu_compilation_context =
       std::make_shared<CpuCompilationContext>(std::move(execution_engine));
   cpu_compilation_context->setFunctionPointer(multifrag_query_func);
+  if (low_tier_info) {
+    cpu_compilation_context->setLowTierInfo(std::move(low_tier_info));
+  }
   addCodeToCache(key, cpu_compilation_context, module, cpu_code_cache_);
+
+  if (background_module) {
+    std::vector<std::string> live_func_names;
+    for (const auto live_func : live_funcs) {
+      live_func_names.push_back(live_func->getName().str());
+    }
+    scheduleBackgroundCodegenCPU(key,
+                                 std::move(background_module),
+                                 query_func->getName().str(),
+                                 multifrag_query_func->getName().str(),
+                                 live_func_names,
+                                 co);
+  }
   return cpu_compilation_context;
 }
 
+void Executor::scheduleBackgroundCodegenCPU(
+    const CodeCacheKey& key,
+    std::unique_ptr<llvm::Module> module,
+    const std::string& query_func_name,
+    const std::string& multifrag_query_func_name,
+    const std::vector<std::string>& live_func_names,
+    const CompilationOptions& co) {
+  std::lock_guard<std::mutex> lock(background_compilations_mutex_);
+  background_compilations_.erase(
+      std::remove_if(background_compilations_.begin(),
+                     background_compilations_.end(),
+                     [](const std::future<void>& background_compilation) {
+                       return background_compilation.wait_for(std::chrono::seconds(0)) ==
+                              std::future_status::ready;
+                     }),
+      background_compilations_.end());
+  background_compilations_.emplace_back(std::async(
+      std::launch::async,
+      [this,
+       key,
+       module = std::move(module),
+       query_func_name,
+       multifrag_query_func_name,
+       live_func_names,
+       co]() mutable {
+        // The LLVM context and the code caches are shared with query compilation.
+        std::lock_guard<std::mutex> compilation_lock(compilation_mutex_);
+        auto query_func = module->getFunction(query_func_name);
+        auto multifrag_query_func = module->getFunction(multifrag_query_func_name);
+        CHECK(query_func);
+        CHECK(multifrag_query_func);
+        std::unordered_set<llvm::Function*> live_funcs;
+        for (const auto& live_func_name : live_func_names) {
+          if (auto live_func = module->getFunction(live_func_name)) {
+            live_funcs.insert(live_func);
+          }
+        }
+        // The execution engine takes ownership of the module.
+        auto module_ptr = module.release();
+        try {
+          auto execution_engine =
+              CodeGenerator::generateNativeCPUCode(query_func, live_funcs, co);
+          auto cpu_compilation_context =
+              std::make_shared<CpuCompilationContext>(std::move(execution_engine));
+          cpu_compilation_context->setFunctionPointer(multifrag_query_func);
+          addCodeToCache(key, cpu_compilation_context, module_ptr, cpu_code_cache_);
+          background_codegen_replacements_.fetch_add(1, std::memory_order_relaxed);
+          VLOG(1) << "Replaced quickly compiled code with optimized code for "
+                  << query_func_name;
+        } catch (const std::exception& e) {
+          // The query which scheduled the compilation already ran on the quickly
+          // compiled code, which stays cached and correct, so the failure is only
+          // counted and logged.
+          background_codegen_failures_.fetch_add(1, std::memory_order_relaxed);
+          LOG(ERROR) << "Background compilation of " << query_func_name
+                     << " failed, keeping the unoptimized code: " << e.what();
+        }
+      }));
+}
+
 void CodeGenerator::link_udf_module(const std::unique_ptr<llvm::Module>& udf_module,
                                     llvm::Module& module,
                                     CgenState* cgen_state,
@@ -608,6 +798,7 @@ declare void @llvm.lifetime.start.p0i8(i64, i8* nocapture) nounwind
 declare void @llvm.lifetime.end.p0i8(i64, i8* nocapture) nounwind
 declare i64 @get_thread_index();
 declare i64 @get_block_index();
+declare i64 @get_block_dim();
 declare i32 @pos_start_impl(i32*);
 declare i32 @group_buff_idx_impl();
 declare i32 @pos_step_impl();
@@ -629,6 +820,14 @@ declare i64 @baseline_hash_join_idx_32(i8*, i8*, i64, i64);
 declare i64 @baseline_hash_join_idx_64(i8*, i8*, i64, i64);
 declare i64 @get_composite_key_index_32(i32*, i64, i32*, i64);
 declare i64 @get_composite_key_index_64(i64*, i64, i64*, i64);
+declare i64 @baseline_hash_join_idx_1x32(i8*, i8*, i64);
+declare i64 @baseline_hash_join_idx_1x64(i8*, i8*, i64);
+declare i64 @baseline_hash_join_idx_2x32(i8*, i8*, i64);
+declare i64 @baseline_hash_join_idx_2x64(i8*, i8*, i64);
+declare i64 @get_composite_key_index_1x32(i32*, i32*, i64);
+declare i64 @get_composite_key_index_1x64(i64*, i64*, i64);
+declare i64 @get_composite_key_index_2x32(i32*, i32*, i64);
+declare i64 @get_composite_key_index_2x64(i64*, i64*, i64);
 declare i64 @get_bucket_key_for_range_compressed(i8*, i64, double);
 declare i64 @get_bucket_key_for_range_double(i8*, i64, double);
 declare i32 @get_num_buckets_for_bounds(i8*, i32, double, double);
@@ -644,6 +843,10 @@ declare i32 @agg_count_float_skip_val_shared(i32*, float, float);
 declare i64 @agg_sum_shared(i64*, i64);
 declare i64 @agg_sum_skip_val_shared(i64*, i64, i64);
 declare i32 @agg_sum_int32_shared(i32*, i32);
+declare i64 @agg_count_warp_shared(i64*, i64);
+declare i32 @agg_count_int32_warp_shared(i32*, i32);
+declare i64 @agg_sum_warp_shared(i64*, i64);
+declare i32 @agg_sum_int32_warp_shared(i32*, i32);
 declare i32 @agg_sum_int32_skip_val_shared(i32*, i32, i32);
 declare void @agg_sum_double_shared(i64*, double);
 declare void @agg_sum_double_skip_val_shared(i64*, double, double);
@@ -1160,13 +1363,27 @@ std::shared_ptr<GpuCompilationContext> CodeGenerator::generateNativeGPUCode(
 
   auto cuda_llir = ss.str() + cuda_rt_decls + extension_function_decls(udf_declarations);
   std::string ptx;
-  try {
-    ptx = generatePTX(
-        cuda_llir, gpu_target.nvptx_target_machine, gpu_target.cgen_state->context_);
-  } catch (ParseIRError& e) {
-    LOG(WARNING) << "Failed to generate PTX: " << e.what()
-                 << ". Switching to CPU execution target.";
-    throw QueryMustRunOnCpu();
+  auto persistent_code_cache = PersistentCodeCache::get();
+  const auto persisted_ptx =
+      persistent_code_cache
+          ? persistent_code_cache->getPtx(module->getModuleIdentifier())
+          : std::nullopt;
+  if (persisted_ptx) {
+    VLOG(1) << "Loaded PTX for " << module->getModuleIdentifier()
+            << " from the persistent cache";
+    ptx = *persisted_ptx;
+  } else {
+    try {
+      ptx = generatePTX(
+          cuda_llir, gpu_target.nvptx_target_machine, gpu_target.cgen_state->context_);
+    } catch (ParseIRError& e) {
+      LOG(WARNING) << "Failed to generate PTX: " << e.what()
+                   << ". Switching to CPU execution target.";
+      throw QueryMustRunOnCpu();
+    }
+    if (persistent_code_cache) {
+      persistent_code_cache->putPtx(module->getModuleIdentifier(), ptx);
+    }
   }
   LOG(PTX) << "PTX for the GPU:\n" << ptx << "\nEnd of PTX";
 
@@ -1179,16 +1396,43 @@ std::shared_ptr<GpuCompilationContext> CodeGenerator::generateNativeGPUCode(
 
   auto func_name = wrapper_func->getName().str();
   auto gpu_compilation_context = std::make_shared<GpuCompilationContext>();
-  for (int device_id = 0; device_id < gpu_target.cuda_mgr->getDeviceCount();
-       ++device_id) {
-    gpu_compilation_context->addDeviceCode(
-        std::make_unique<GpuDeviceCompilationContext>(cubin,
-                                                      func_name,
-                                                      device_id,
-                                                      gpu_target.cuda_mgr,
-                                                      num_options,
-                                                      &option_keys[0],
-                                                      &option_values[0]));
+  const auto device_count = gpu_target.cuda_mgr->getDeviceCount();
+  if (g_enable_parallel_gpu_module_load && device_count > 1) {
+    // Loading the cubin JIT-compiles the final SASS for each device, which is
+    // independent across devices. Every thread binds its own device context.
+    std::vector<std::future<std::unique_ptr<GpuDeviceCompilationContext>>>
+        device_code_futures;
+    for (int device_id = 0; device_id < device_count; ++device_id) {
+      device_code_futures.emplace_back(
+          std::async(std::launch::async,
+                     [&cubin, &func_name, &gpu_target, &option_keys, &option_values](
+                         const int device_id, const size_t num_options) {
+                       return std::make_unique<GpuDeviceCompilationContext>(
+                           cubin,
+                           func_name,
+                           device_id,
+                           gpu_target.cuda_mgr,
+                           num_options,
+                           &option_keys[0],
+                           &option_values[0]);
+                     },
+                     device_id,
+                     num_options));
+    }
+    for (auto& device_code_future : device_code_futures) {
+      gpu_compilation_context->addDeviceCode(device_code_future.get());
+    }
+  } else {
+    for (int device_id = 0; device_id < device_count; ++device_id) {
+      gpu_compilation_context->addDeviceCode(
+          std::make_unique<GpuDeviceCompilationContext>(cubin,
+                                                        func_name,
+                                                        device_id,
+                                                        gpu_target.cuda_mgr,
+                                                        num_options,
+                                                        &option_keys[0],
+                                                        &option_values[0]));
+    }
   }
 
   checkCudaErrors(cuLinkDestroy(link_state));
@@ -1222,6 +1466,14 @@ std::shared_ptr<CompilationContext> Executor::optimizeAndCodegenGPU(
     return cached_code;
   }
 
+  initializeNVPTXBackend();
+  auto persistent_code_cache = PersistentCodeCache::get();
+  if (persistent_code_cache && !rt_udf_gpu_module) {
+    // PTX depends on the target architecture, make it part of the key.
+    module->setModuleIdentifier(persistent_code_cache->getModuleKey(
+        key, "gpu_" + nvptx_target_machine_->getTargetCPU().str()));
+  }
+
   bool row_func_not_inlined = false;
   if (no_inline) {
     for (auto it = llvm::inst_begin(cgen_state_->row_func_),
@@ -1240,7 +1492,6 @@ std::shared_ptr<CompilationContext> Executor::optimizeAndCodegenGPU(
     }
   }
 
-  initializeNVPTXBackend();
   CodeGenerator::GPUTarget gpu_target{nvptx_target_machine_.get(),
                                       cuda_mgr,
                                       blockSize(),
@@ -1473,6 +1724,21 @@ void bind_pos_placeholders(const std::string& pos_fn_name,
   }
 }
 
+void bind_pos_step_to_constant(llvm::Function* query_func) {
+  for (auto it = llvm::inst_begin(query_func), e = llvm::inst_end(query_func); it != e;
+       ++it) {
+    if (!llvm::isa<llvm::CallInst>(*it)) {
+      continue;
+    }
+    auto& pos_call = llvm::cast<llvm::CallInst>(*it);
+    if (std::string(pos_call.getCalledFunction()->getName()) == "pos_step") {
+      pos_call.replaceAllUsesWith(llvm::ConstantInt::get(pos_call.getType(), 1));
+      pos_call.eraseFromParent();
+      break;
+    }
+  }
+}
+
 void set_row_func_argnames(llvm::Function* row_func,
                            const size_t in_col_count,
                            const size_t agg_col_count,
@@ -1902,6 +2168,13 @@ void Executor::createErrorCheckControlFlow(
     }
   }
 
+  // CPU kernels check every g_cpu_interrupt_check_rows-th row, so that the clock read
+  // or the interrupt flag load is not on the path of most rows.
+  const auto cpu_check_rows = static_cast<unsigned>(
+      std::clamp(g_cpu_interrupt_check_rows, size_t(1), size_t(1) << 31));
+  const uint64_t cpu_check_mask =
+      (uint64_t(1) << shared::getExpOfTwo(cpu_check_rows)) - 1;
+
   llvm::Value* row_count = nullptr;
   if ((run_with_dynamic_watchdog || run_with_allowing_runtime_interrupt) &&
       device_type == ExecutorDeviceType::GPU) {
@@ -1957,8 +2230,8 @@ void Executor::createErrorCheckControlFlow(
             call_watchdog_lv =
                 ir_builder.CreateICmp(llvm::ICmpInst::ICMP_SLT, pos, crit_edge_threshold);
           } else {
-            // CPU path: run watchdog for every 64th row
-            auto dw_predicate = ir_builder.CreateAnd(pos, uint64_t(0x3f));
+            // CPU path: run watchdog for every cpu_check_mask + 1-th row
+            auto dw_predicate = ir_builder.CreateAnd(pos, cpu_check_mask);
             call_watchdog_lv = ir_builder.CreateICmp(
                 llvm::ICmpInst::ICMP_EQ, dw_predicate, cgen_state_->llInt(int64_t(0LL)));
           }
@@ -2060,8 +2333,8 @@ void Executor::createErrorCheckControlFlow(
                                       interrupt_predicate,
                                       cgen_state_->llInt(int64_t(0LL)));
           } else {
-            // CPU path: run interrupt checker for every 64th row
-            auto interrupt_predicate = ir_builder.CreateAnd(pos, uint64_t(0x3f));
+            // CPU path: run interrupt checker for every cpu_check_mask + 1-th row
+            auto interrupt_predicate = ir_builder.CreateAnd(pos, cpu_check_mask);
             call_check_interrupt_lv =
                 ir_builder.CreateICmp(llvm::ICmpInst::ICMP_EQ,
                                       interrupt_predicate,
@@ -2396,17 +2669,9 @@ bool is_gpu_shared_mem_supported(const QueryMemoryDescriptor* query_mem_desc_ptr
   if (query_mem_desc_ptr->getQueryDescriptionType() ==
           QueryDescriptionType::GroupByPerfectHash &&
       g_enable_smem_group_by) {
-    /**
-     * To simplify the implementation for practical purposes, we
-     * initially provide shared memory support for cases where there are at most as many
-     * entries in the output buffer as there are threads within each GPU device. In
-     * order to relax this assumption later, we need to add a for loop in generated
-     * codes such that each thread loops over multiple entries.
-     * TODO: relax this if necessary
-     */
-    if (gpu_blocksize < query_mem_desc_ptr->getEntryCount()) {
-      return false;
-    }
+    // The initialization and the reduction of the shared memory buffer loop over the
+    // entries with a stride of the block size, the buffer size is the only limit on the
+    // entry count.
 
     // Fundamentally, we should use shared memory whenever the output buffer
     // is small enough so that we can fit it in the shared memory and yet expect
@@ -2451,6 +2716,50 @@ bool is_gpu_shared_mem_supported(const QueryMemoryDescriptor* query_mem_desc_ptr
   return false;
 }
 
+bool is_shared_cpu_group_by_buffer_supported(
+    const QueryMemoryDescriptor* query_mem_desc_ptr,
+    const RelAlgExecutionUnit& ra_exe_unit,
+    const std::vector<InputTableInfo>& query_infos,
+    const ExecutorDeviceType device_type,
+    const RenderInfo* render_info) {
+  if (!g_enable_shared_cpu_group_by_buffer || device_type != ExecutorDeviceType::CPU) {
+    return false;
+  }
+  CHECK(query_mem_desc_ptr);
+  // The atomic runtime functions only cover the row-wise baseline layout with 4 or 8
+  // byte slots and no side buffers (count distinct sets, varlen output) which would
+  // have to be shared as well.
+  if (query_mem_desc_ptr->getQueryDescriptionType() !=
+          QueryDescriptionType::GroupByBaselineHash ||
+      query_mem_desc_ptr->didOutputColumnar() ||
+      query_mem_desc_ptr->hasVarlenOutput() ||
+      !query_mem_desc_ptr->countDistinctDescriptorsLogicallyEmpty()) {
+    return false;
+  }
+  if (ra_exe_unit.estimator || ra_exe_unit.use_bump_allocator ||
+      ra_exe_unit.union_all || (render_info && render_info->isPotentialInSituRender())) {
+    return false;
+  }
+  // With a single fragment there is a single kernel and nothing to share.
+  if (query_infos.empty() || query_infos.front().info.fragments.size() < 2) {
+    return false;
+  }
+  for (size_t i = 0; i < query_mem_desc_ptr->getSlotCount(); ++i) {
+    const auto slot_width = query_mem_desc_ptr->getPaddedSlotWidthBytes(i);
+    if (slot_width != sizeof(int32_t) && slot_width != sizeof(int64_t)) {
+      return false;
+    }
+  }
+  const auto target_infos =
+      target_exprs_to_infos(ra_exe_unit.target_exprs, *query_mem_desc_ptr);
+  const std::unordered_set<SQLAgg> supported_aggs{kCOUNT, kMIN, kMAX, kSUM, kAVG};
+  return std::all_of(
+      target_infos.begin(), target_infos.end(), [&supported_aggs](const TargetInfo& ti) {
+        return !ti.sql_type.is_varlen() && !ti.is_distinct &&
+               (!ti.is_agg || supported_aggs.count(ti.agg_kind));
+      });
+}
+
 #ifndef NDEBUG
 std::string serialize_llvm_metadata_footnotes(llvm::Function* query_func,
                                               CgenState* cgen_state) {
@@ -2520,6 +2829,14 @@ std::string serialize_llvm_metadata_footnotes(llvm::Function* query_func,
 }
 #endif  // NDEBUG
 
+size_t get_input_row_count_upper_bound(const std::vector<InputTableInfo>& query_infos) {
+  size_t row_count{0};
+  for (const auto& query_info : query_infos) {
+    row_count += query_info.info.getNumTuplesUpperBound();
+  }
+  return row_count;
+}
+
 }  // namespace
 
 std::tuple<CompilationResult, std::unique_ptr<QueryMemoryDescriptor>>
@@ -2602,6 +2919,13 @@ Executor::compileWorkUnit(const std::vector<InputTableInfo>& query_infos,
   const GpuSharedMemoryContext gpu_smem_context(
       get_shared_memory_size(gpu_shared_mem_optimization, query_mem_desc.get()));
 
+  if (is_shared_cpu_group_by_buffer_supported(
+          query_mem_desc.get(), ra_exe_unit, query_infos, co.device_type, render_info)) {
+    query_mem_desc->setUseSharedCpuGroupByBuffer(true);
+    LOG(DEBUG1) << "All CPU kernels share one group by buffer for the " +
+                       query_mem_desc->queryDescTypeToString() + " query.";
+  }
+
   if (co.device_type == ExecutorDeviceType::GPU) {
     const size_t num_count_distinct_descs =
         query_mem_desc->getCountDistinctDescriptorsSize();
@@ -2609,6 +2933,7 @@ Executor::compileWorkUnit(const std::vector<InputTableInfo>& query_infos,
       const auto& count_distinct_descriptor =
           query_mem_desc->getCountDistinctDescriptor(i);
       if (count_distinct_descriptor.impl_type_ == CountDistinctImplType::StdSet ||
+          count_distinct_descriptor.impl_type_ == CountDistinctImplType::SparseBitmap ||
           (count_distinct_descriptor.impl_type_ != CountDistinctImplType::Invalid &&
            !co.hoist_literals)) {
         throw QueryMustRunOnCpu();
@@ -2672,7 +2997,13 @@ Executor::compileWorkUnit(const std::vector<InputTableInfo>& query_infos,
                                                           gpu_smem_context);
   bind_pos_placeholders("pos_start", true, query_func, cgen_state_->module_);
   bind_pos_placeholders("group_buff_idx", false, query_func, cgen_state_->module_);
-  bind_pos_placeholders("pos_step", false, query_func, cgen_state_->module_);
+  if (use_cpu_loop_vectorization(co)) {
+    // A CPU kernel walks its rows one by one. Binding the step to a constant gives the
+    // loop vectorizer an induction variable with a known stride.
+    bind_pos_step_to_constant(query_func);
+  } else {
+    bind_pos_placeholders("pos_step", false, query_func, cgen_state_->module_);
+  }
 
   cgen_state_->query_func_ = query_func;
   cgen_state_->row_func_call_ = row_func_call;
@@ -2899,7 +3230,11 @@ Executor::compileWorkUnit(const std::vector<InputTableInfo>& query_infos,
   return std::make_tuple(
       CompilationResult{
           co.device_type == ExecutorDeviceType::CPU
-              ? optimizeAndCodegenCPU(query_func, multifrag_query_func, live_funcs, co)
+              ? optimizeAndCodegenCPU(query_func,
+                                      multifrag_query_func,
+                                      live_funcs,
+                                      co,
+                                      get_input_row_count_upper_bound(query_infos))
               : optimizeAndCodegenGPU(query_func,
                                       multifrag_query_func,
                                       live_funcs,
@@ -3021,12 +3356,28 @@ llvm::BasicBlock* Executor::codegenSkipDeletedOuterTableRow(
                                     deleted_cd->columnId,
                                     outer_input_desc.getNestLevel());
   CodeGenerator code_generator(this);
-  const auto is_deleted =
-      code_generator.toBool(code_generator.codegen(deleted_expr.get(), true, co).front());
-  const auto is_deleted_bb = llvm::BasicBlock::Create(
-      cgen_state_->context_, "is_deleted", cgen_state_->row_func_);
   llvm::BasicBlock* bb = llvm::BasicBlock::Create(
       cgen_state_->context_, "is_not_deleted", cgen_state_->row_func_);
+  // Fragments without deleted rows come without a deleted column buffer, see
+  // Executor::fetchChunks(), so their rows skip the check.
+  const auto deleted_col_buf =
+      code_generator.colByteStream(deleted_expr.get(), true, co.hoist_literals);
+  const auto has_deleted_col_buf = cgen_state_->ir_builder_.CreateICmpNE(
+      deleted_col_buf,
+      llvm::ConstantPointerNull::get(llvm::Type::getInt8PtrTy(cgen_state_->context_)));
+  const auto check_deleted_bb = llvm::BasicBlock::Create(
+      cgen_state_->context_, "check_deleted", cgen_state_->row_func_);
+  cgen_state_->ir_builder_.CreateCondBr(has_deleted_col_buf, check_deleted_bb, bb);
+  cgen_state_->ir_builder_.SetInsertPoint(check_deleted_bb);
+  llvm::Value* is_deleted{nullptr};
+  {
+    // The fetched value does not dominate the rest of the row function.
+    FetchCacheAnchor anchor(cgen_state_.get());
+    is_deleted = code_generator.toBool(
+        code_generator.codegen(deleted_expr.get(), true, co).front());
+  }
+  const auto is_deleted_bb = llvm::BasicBlock::Create(
+      cgen_state_->context_, "is_deleted", cgen_state_->row_func_);
   cgen_state_->ir_builder_.CreateCondBr(is_deleted, is_deleted_bb, bb);
   cgen_state_->ir_builder_.SetInsertPoint(is_deleted_bb);
   cgen_state_->ir_builder_.CreateRet(cgen_state_->llInt<int32_t>(0));
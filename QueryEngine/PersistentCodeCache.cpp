@@ -0,0 +1,222 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "QueryEngine/PersistentCodeCache.h"
+
+#include <llvm/Config/llvm-config.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <boost/filesystem.hpp>
+
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include "Logger/Logger.h"
+#include "OSDependent/omnisci_path.h"
+#include "QueryEngine/IRCodegenUtils.h"
+#include "QueryEngine/MurmurHash.h"
+
+bool g_enable_persistent_code_cache{false};
+
+extern std::unique_ptr<llvm::Module> udf_gpu_module;
+extern std::unique_ptr<llvm::Module> udf_cpu_module;
+
+std::unique_ptr<PersistentCodeCache> PersistentCodeCache::instance_;
+
+namespace {
+
+const std::string module_key_prefix{"omnisci_cc_"};
+
+std::string hash_to_string(const std::string& str) {
+  // Two independent 64-bit hashes make accidental collisions between distinct query
+  // shapes practically impossible.
+  const auto h1 = MurmurHash64A(str.data(), static_cast<int>(str.size()), 0);
+  const auto h2 = MurmurHash64A(str.data(), static_cast<int>(str.size()), 0x9E3779B9);
+  std::ostringstream oss;
+  oss << std::hex << std::setfill('0') << std::setw(16) << h1 << std::setw(16) << h2;
+  return oss.str();
+}
+
+// Returns std::nullopt when the runtime functions bitcode can't be read.
+std::optional<std::string> compute_build_hash() {
+  std::string fingerprint{LLVM_VERSION_STRING};
+  const auto rt_bc_path =
+      omnisci::get_root_abs_path() + "/QueryEngine/RuntimeFunctions.bc";
+  std::ifstream rt_bc(rt_bc_path, std::ios::binary);
+  if (!rt_bc.is_open()) {
+    LOG(WARNING) << "Could not read the runtime functions bitcode " << rt_bc_path
+                 << " for the persistent code cache build fingerprint.";
+    return std::nullopt;
+  }
+  fingerprint += std::string((std::istreambuf_iterator<char>(rt_bc)),
+                             std::istreambuf_iterator<char>());
+  if (udf_cpu_module) {
+    fingerprint += serialize_llvm_object(udf_cpu_module.get());
+  }
+  if (udf_gpu_module) {
+    fingerprint += serialize_llvm_object(udf_gpu_module.get());
+  }
+  return hash_to_string(fingerprint);
+}
+
+}  // namespace
+
+PersistentCodeCache::PersistentCodeCache(const std::string& cache_dir,
+                                         const std::string& build_hash)
+    : cache_dir_(cache_dir), build_hash_(build_hash) {}
+
+void PersistentCodeCache::init(const std::string& base_path) {
+  if (!g_enable_persistent_code_cache) {
+    return;
+  }
+  const auto cache_dir = boost::filesystem::path(base_path) / "omnisci_code_cache";
+  boost::system::error_code ec;
+  boost::filesystem::create_directories(cache_dir, ec);
+  if (ec) {
+    LOG(WARNING) << "Could not create persistent code cache directory "
+                 << cache_dir.string() << ": " << ec.message()
+                 << ". The persistent code cache is disabled.";
+    return;
+  }
+  const auto build_hash = compute_build_hash();
+  if (!build_hash) {
+    LOG(WARNING) << "The persistent code cache is disabled.";
+    return;
+  }
+  instance_ = std::make_unique<PersistentCodeCache>(cache_dir.string(), *build_hash);
+  LOG(INFO) << "Persistent code cache enabled at " << cache_dir.string();
+}
+
+PersistentCodeCache* PersistentCodeCache::get() {
+  return instance_.get();
+}
+
+std::string PersistentCodeCache::getModuleKey(const std::vector<std::string>& key,
+                                              const std::string& device_tag) const {
+  std::string key_str{device_tag};
+  for (const auto& str : key) {
+    key_str += '\0';
+    key_str += str;
+  }
+  return module_key_prefix + device_tag + "_" + hash_to_string(key_str);
+}
+
+bool PersistentCodeCache::isModuleKey(const std::string& module_id) {
+  return module_id.compare(0, module_key_prefix.size(), module_key_prefix) == 0;
+}
+
+bool PersistentCodeCache::hasObject(const std::string& module_key) const {
+  if (!isModuleKey(module_key)) {
+    return false;
+  }
+  std::ifstream in(getFilePath(module_key, "o"), std::ios::binary);
+  if (!in.is_open()) {
+    return false;
+  }
+  std::string entry_build_hash;
+  std::getline(in, entry_build_hash);
+  return entry_build_hash == build_hash_;
+}
+
+void PersistentCodeCache::notifyObjectCompiled(const llvm::Module* module,
+                                               llvm::MemoryBufferRef obj) {
+  CHECK(module);
+  const auto module_key = module->getModuleIdentifier();
+  if (!isModuleKey(module_key)) {
+    return;
+  }
+  writeEntry(getFilePath(module_key, "o"), obj.getBufferStart(), obj.getBufferSize());
+}
+
+std::unique_ptr<llvm::MemoryBuffer> PersistentCodeCache::getObject(
+    const llvm::Module* module) {
+  CHECK(module);
+  const auto module_key = module->getModuleIdentifier();
+  if (!isModuleKey(module_key)) {
+    return nullptr;
+  }
+  auto obj = readEntry(getFilePath(module_key, "o"));
+  if (!obj) {
+    return nullptr;
+  }
+  VLOG(1) << "Loaded CPU object code for " << module_key << " from the persistent cache";
+  return llvm::MemoryBuffer::getMemBufferCopy(*obj, module_key);
+}
+
+std::optional<std::string> PersistentCodeCache::getPtx(
+    const std::string& module_key) const {
+  if (!isModuleKey(module_key)) {
+    return std::nullopt;
+  }
+  return readEntry(getFilePath(module_key, "ptx"));
+}
+
+void PersistentCodeCache::putPtx(const std::string& module_key, const std::string& ptx) {
+  if (!isModuleKey(module_key)) {
+    return;
+  }
+  writeEntry(getFilePath(module_key, "ptx"), ptx.data(), ptx.size());
+}
+
+std::string PersistentCodeCache::getFilePath(const std::string& module_key,
+                                             const std::string& ext) const {
+  return cache_dir_ + "/" + module_key + "." + ext;
+}
+
+void PersistentCodeCache::writeEntry(const std::string& path,
+                                     const char* data,
+                                     const size_t size) {
+  std::lock_guard<std::mutex> write_lock(write_mutex_);
+  // Write to a temporary file first so a concurrent reader or a crash never observes a
+  // partially written entry.
+  const auto tmp_path = path + ".tmp";
+  {
+    std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+      LOG(WARNING) << "Could not write persistent code cache entry " << path;
+      return;
+    }
+    out << build_hash_ << '\n';
+    out.write(data, size);
+    if (!out.good()) {
+      LOG(WARNING) << "Could not write persistent code cache entry " << path;
+      return;
+    }
+  }
+  boost::system::error_code ec;
+  boost::filesystem::rename(tmp_path, path, ec);
+  if (ec) {
+    LOG(WARNING) << "Could not write persistent code cache entry " << path << ": "
+                 << ec.message();
+    boost::filesystem::remove(tmp_path, ec);
+  }
+}
+
+std::optional<std::string> PersistentCodeCache::readEntry(const std::string& path) const {
+  std::ifstream in(path, std::ios::binary);
+  if (!in.is_open()) {
+    return std::nullopt;
+  }
+  std::string entry_build_hash;
+  std::getline(in, entry_build_hash);
+  if (entry_build_hash != build_hash_) {
+    // Written by a different build, recompile and let the new entry overwrite it.
+    return std::nullopt;
+  }
+  return std::string((std::istreambuf_iterator<char>(in)),
+                     std::istreambuf_iterator<char>());
+}
@@ -0,0 +1,87 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    PersistentCodeCache.h
+ * @brief   On-disk tier for the in-memory code caches, which survives server restarts.
+ *
+ * CPU modules are persisted as native object files through the MCJIT object cache
+ * interface, GPU modules are persisted as PTX. Entries are keyed on the generated IR of
+ * the query (the same key used by the in-memory CodeCache) combined with a build
+ * fingerprint made of the LLVM version, the runtime functions bitcode and any load time
+ * UDF modules, so a rebuilt server never picks up stale code.
+ */
+
+#pragma once
+
+#include <llvm/ExecutionEngine/ObjectCache.h>
+
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+extern bool g_enable_persistent_code_cache;
+
+class PersistentCodeCache : public llvm::ObjectCache {
+ public:
+  PersistentCodeCache(const std::string& cache_dir, const std::string& build_hash);
+
+  /**
+   * Creates the process wide cache under `base_path`, if enabled with
+   * `g_enable_persistent_code_cache`. Must be called after load time UDFs have been
+   * read, since those are part of the build fingerprint.
+   */
+  static void init(const std::string& base_path);
+
+  // Returns nullptr when the persistent tier is disabled.
+  static PersistentCodeCache* get();
+
+  /**
+   * Returns the module identifier used as the on-disk key for the given code cache key
+   * (see CodeCacheKey) and device. Modules carrying this identifier are looked up and
+   * stored by the object cache callbacks below.
+   */
+  std::string getModuleKey(const std::vector<std::string>& key,
+                           const std::string& device_tag) const;
+
+  static bool isModuleKey(const std::string& module_id);
+
+  bool hasObject(const std::string& module_key) const;
+
+  void notifyObjectCompiled(const llvm::Module* module,
+                            llvm::MemoryBufferRef obj) override;
+
+  std::unique_ptr<llvm::MemoryBuffer> getObject(const llvm::Module* module) override;
+
+  std::optional<std::string> getPtx(const std::string& module_key) const;
+
+  void putPtx(const std::string& module_key, const std::string& ptx);
+
+ private:
+  std::string getFilePath(const std::string& module_key, const std::string& ext) const;
+
+  void writeEntry(const std::string& path, const char* data, const size_t size);
+
+  std::optional<std::string> readEntry(const std::string& path) const;
+
+  const std::string cache_dir_;
+  const std::string build_hash_;
+  std::mutex write_mutex_;
+
+  static std::unique_ptr<PersistentCodeCache> instance_;
+};
@@ -33,9 +33,13 @@ struct JoinInfo {
   std::vector<std::shared_ptr<Analyzer::BinOper>>
       equi_join_tautologies_;  // expressions we equi-join on are true by
                                // definition when using a hash join; we'll
-                               // fold them to true during code generation
+                               // fold them to true during code generation, null
+                               // for range join tables which keep their quals
   std::vector<std::shared_ptr<HashJoin>> join_hash_tables_;
   std::unordered_set<size_t> sharded_range_table_indices_;
+  // simple quals on the outer table implied by the key ranges of the hash tables above,
+  // only used to skip outer fragments
+  std::list<std::shared_ptr<Analyzer::Expr>> outer_key_range_quals_;
 };
 
 struct PlanState {
@@ -61,6 +65,8 @@ struct PlanState {
   std::set<std::pair<TableId, ColumnId>> columns_to_fetch_;
   std::set<std::pair<TableId, ColumnId>> columns_to_not_fetch_;
   bool allow_lazy_fetch_;
+  // the innermost join level is an inner loop join over the whole inner table
+  bool innermost_inner_loop_join_{false};
   JoinInfo join_info_;
   const DeletedColumnsMap deleted_columns_;
   const std::vector<InputTableInfo>& query_infos_;
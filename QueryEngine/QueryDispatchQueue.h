@@ -16,21 +16,38 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <chrono>
 #include <condition_variable>
 #include <future>
 #include <mutex>
+#include <optional>
 #include <queue>
 #include <thread>
 
 /**
  * QueryDispatchQueue maintains a list of pending queries and dispatches those queries as
- * Executors become available
+ * Executors become available. Pending queries of a higher priority are dispatched first,
+ * queries of the same priority in submission order. Low priority queries can be limited
+ * to a number of Executors, keeping the others free for the higher priorities.
  */
 class QueryDispatchQueue {
  public:
   using Task = std::packaged_task<void(size_t)>;
 
-  QueryDispatchQueue(const size_t parallel_executors_max) {
+  enum class Priority { High = 0, Normal, Low };
+
+  struct QueueTimeStats {
+    size_t dispatched_count{0};
+    int64_t total_queue_time_ms{0};
+    int64_t max_queue_time_ms{0};
+  };
+
+  // A `low_priority_executors_max` of 0 lets low priority queries use all Executors.
+  QueryDispatchQueue(const size_t parallel_executors_max,
+                     const size_t low_priority_executors_max = 0)
+      : low_priority_executors_max_(low_priority_executors_max) {
     workers_.resize(parallel_executors_max);
     for (size_t i = 0; i < workers_.size(); i++) {
       // worker IDs are 1-indexed, leaving Executor 0 for non-dispatch queue worker tasks
@@ -43,7 +60,9 @@ class QueryDispatchQueue {
    * expected to maintain a copy of the shared_ptr which will be used to access results
    * once the task runs.
    */
-  void submit(std::shared_ptr<Task> task, const bool is_update_delete) {
+  void submit(std::shared_ptr<Task> task,
+              const bool is_update_delete,
+              const Priority priority = Priority::Normal) {
     if (workers_.size() == 1 && is_update_delete) {
       std::lock_guard<decltype(update_delete_mutex_)> update_delete_lock(
           update_delete_mutex_);
@@ -58,12 +77,29 @@ class QueryDispatchQueue {
     }
     std::unique_lock<decltype(queue_mutex_)> lock(queue_mutex_);
 
-    LOG(INFO) << "Dispatching query with " << queue_.size() << " queries in the queue.";
-    queue_.push(task);
+    size_t queue_size{0};
+    for (const auto& queue : queues_) {
+      queue_size += queue.size();
+    }
+    LOG(INFO) << "Dispatching query with " << queue_size << " queries in the queue.";
+    queues_[static_cast<size_t>(priority)].push(
+        PendingTask{task, std::chrono::steady_clock::now()});
     lock.unlock();
     cv_.notify_all();
   }
 
+  // Time spent in the queue by the queries of `priority` dispatched so far.
+  QueueTimeStats getQueueTimeStats(const Priority priority) {
+    std::lock_guard<decltype(queue_mutex_)> lock(queue_mutex_);
+    return queue_time_stats_[static_cast<size_t>(priority)];
+  }
+
+  // Number of the queries of `priority` waiting in the queue.
+  size_t getQueueLength(const Priority priority) {
+    std::lock_guard<decltype(queue_mutex_)> lock(queue_mutex_);
+    return queues_[static_cast<size_t>(priority)].size();
+  }
+
   ~QueryDispatchQueue() {
     {
       std::lock_guard<decltype(queue_mutex_)> lock(queue_mutex_);
@@ -76,28 +112,72 @@ class QueryDispatchQueue {
   }
 
  private:
+  static constexpr size_t kNumPriorities{3};
+
+  struct PendingTask {
+    std::shared_ptr<Task> task;
+    std::chrono::steady_clock::time_point submit_time;
+  };
+
+  // Returns the priority of the next query to dispatch, if any can run now.
+  std::optional<size_t> getNextPriorityUnlocked() const {
+    for (size_t priority = 0; priority < kNumPriorities; ++priority) {
+      if (queues_[priority].empty()) {
+        continue;
+      }
+      if (priority == static_cast<size_t>(Priority::Low) && low_priority_executors_max_ &&
+          running_low_priority_count_ >= low_priority_executors_max_) {
+        continue;
+      }
+      return priority;
+    }
+    return std::nullopt;
+  }
+
   void worker(const size_t worker_idx) {
     std::unique_lock<std::mutex> lock(queue_mutex_);
     while (true) {
-      cv_.wait(lock, [this] { return !queue_.empty() || threads_should_exit_; });
+      std::optional<size_t> priority;
+      cv_.wait(lock, [this, &priority] {
+        priority = getNextPriorityUnlocked();
+        return priority || threads_should_exit_;
+      });
 
       if (threads_should_exit_) {
         return;
       }
 
-      if (!queue_.empty()) {
-        auto task = queue_.front();
-        queue_.pop();
-
-        LOG(INFO) << "Worker " << worker_idx
-                  << " running query and returning control. There are now "
-                  << queue_.size() << " queries in the queue.";
-        // allow other threads to pick up tasks
-        lock.unlock();
-        CHECK(task);
-        (*task)(worker_idx);
-        // wait for signal
-        lock.lock();
+      CHECK(priority);
+      auto& queue = queues_[*priority];
+      auto pending_task = queue.front();
+      queue.pop();
+      const bool is_low_priority = *priority == static_cast<size_t>(Priority::Low);
+      if (is_low_priority) {
+        ++running_low_priority_count_;
+      }
+      const int64_t queue_time_ms =
+          std::chrono::duration_cast<std::chrono::milliseconds>(
+              std::chrono::steady_clock::now() - pending_task.submit_time)
+              .count();
+      auto& stats = queue_time_stats_[*priority];
+      ++stats.dispatched_count;
+      stats.total_queue_time_ms += queue_time_ms;
+      stats.max_queue_time_ms = std::max(stats.max_queue_time_ms, queue_time_ms);
+
+      LOG(INFO) << "Worker " << worker_idx << " running query of priority " << *priority
+                << " after " << queue_time_ms
+                << " ms in the queue and returning control. There are now "
+                << queue.size() << " queries of that priority in the queue.";
+      // allow other threads to pick up tasks
+      lock.unlock();
+      CHECK(pending_task.task);
+      (*pending_task.task)(worker_idx);
+      // wait for signal
+      lock.lock();
+      if (is_low_priority) {
+        --running_low_priority_count_;
+        // a low priority query waiting on the limit may run now
+        cv_.notify_all();
       }
     }
   }
@@ -108,6 +188,10 @@ class QueryDispatchQueue {
   std::mutex update_delete_mutex_;
 
   bool threads_should_exit_{false};
-  std::queue<std::shared_ptr<Task>> queue_;
+  // Pending queries, indexed on priority.
+  std::array<std::queue<PendingTask>, kNumPriorities> queues_;
+  std::array<QueueTimeStats, kNumPriorities> queue_time_stats_;
+  const size_t low_priority_executors_max_;
+  size_t running_low_priority_count_{0};
   std::vector<std::thread> workers_;
 };
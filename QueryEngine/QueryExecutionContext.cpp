@@ -27,6 +27,8 @@
 #include "SpeculativeTopN.h"
 #include "StreamingTopN.h"
 
+bool g_enable_gpu_query_streams{false};
+
 QueryExecutionContext::QueryExecutionContext(
     const RelAlgExecutionUnit& ra_exe_unit,
     const QueryMemoryDescriptor& query_mem_desc,
@@ -41,6 +43,7 @@ QueryExecutionContext::QueryExecutionContext(
     const bool output_columnar,
     const bool sort_on_gpu,
     const size_t thread_idx,
+    SharedCpuGroupByBuffer* shared_cpu_group_by_buffer,
     RenderInfo* render_info)
     : query_mem_desc_(query_mem_desc)
     , executor_(executor)
@@ -72,6 +75,7 @@ QueryExecutionContext::QueryExecutionContext(
                                                             row_set_mem_owner,
                                                             gpu_allocator_.get(),
                                                             thread_idx,
+                                                            shared_cpu_group_by_buffer,
                                                             executor);
 }
 
@@ -196,6 +200,37 @@ int32_t aggregate_error_codes(const std::vector<int32_t>& error_codes) {
   return 0;
 }
 
+// Lays out the kernel parameters in one host buffer, so that they take a single device
+// allocation and a single copy. Offsets are 8-byte aligned, as the literals need.
+class KernelParamsBuffer {
+ public:
+  size_t append(const void* data, const size_t size) {
+    const auto offset = reserve(size);
+    if (size) {
+      memcpy(&buffer_[offset], data, size);
+    }
+    return offset;
+  }
+
+  size_t reserve(const size_t size) {
+    const auto offset = buffer_.size();
+    buffer_.resize(offset + align_to_int64(std::max(size, size_t(1))), 0);
+    return offset;
+  }
+
+  void write(const size_t offset, const void* data, const size_t size) {
+    CHECK_LE(offset + size, buffer_.size());
+    memcpy(&buffer_[offset], data, size);
+  }
+
+  size_t size() const { return buffer_.size(); }
+
+  const int8_t* data() const { return buffer_.data(); }
+
+ private:
+  std::vector<int8_t> buffer_;
+};
+
 }  // namespace
 #endif
 
@@ -238,6 +273,14 @@ std::vector<int64_t*> QueryExecutionContext::launchGpuCode(
   std::vector<int64_t*> out_vec;
   uint32_t num_fragments = col_buffers.size();
   std::vector<int32_t> error_codes(grid_size_x * block_size_x);
+  // Each executor launches its kernels on its own stream, so that the queries running on
+  // different executors can share the device.
+  CUstream query_stream{nullptr};
+  if (g_enable_gpu_query_streams) {
+    CHECK(data_mgr);
+    query_stream =
+        data_mgr->getCudaMgr()->getQueryStream(device_id, executor_->getExecutorId());
+  }
 
   CUevent start0, stop0;  // preparation
   cuEventCreate(&start0, 0);
@@ -333,7 +376,7 @@ std::vector<int64_t*> QueryExecutionContext::launchGpuCode(
                                      block_size_y,
                                      block_size_z,
                                      shared_memory_size,
-                                     nullptr,
+                                     query_stream,
                                      &param_ptrs[0],
                                      nullptr));
     } else {
@@ -346,7 +389,7 @@ std::vector<int64_t*> QueryExecutionContext::launchGpuCode(
                                      block_size_y,
                                      block_size_z,
                                      shared_memory_size,
-                                     nullptr,
+                                     query_stream,
                                      &param_ptrs[0],
                                      nullptr));
     }
@@ -362,6 +405,9 @@ std::vector<int64_t*> QueryExecutionContext::launchGpuCode(
               << std::to_string(milliseconds1) << " ms";
       cuEventRecord(start2, 0);
     }
+    if (query_stream) {
+      checkCudaErrors(cuStreamSynchronize(query_stream));
+    }
 
     gpu_allocator_->copyFromDevice(reinterpret_cast<int8_t*>(error_codes.data()),
                                    reinterpret_cast<int8_t*>(err_desc),
@@ -503,7 +549,7 @@ std::vector<int64_t*> QueryExecutionContext::launchGpuCode(
                                      block_size_y,
                                      block_size_z,
                                      shared_memory_size,
-                                     nullptr,
+                                     query_stream,
                                      &param_ptrs[0],
                                      nullptr));
     } else {
@@ -516,7 +562,7 @@ std::vector<int64_t*> QueryExecutionContext::launchGpuCode(
                                      block_size_y,
                                      block_size_z,
                                      shared_memory_size,
-                                     nullptr,
+                                     query_stream,
                                      &param_ptrs[0],
                                      nullptr));
     }
@@ -533,6 +579,9 @@ std::vector<int64_t*> QueryExecutionContext::launchGpuCode(
               << " ms";
       cuEventRecord(start2, 0);
     }
+    if (query_stream) {
+      checkCudaErrors(cuStreamSynchronize(query_stream));
+    }
 
     copy_from_gpu(data_mgr,
                   &error_codes[0],
@@ -867,39 +916,34 @@ std::vector<CUdeviceptr> QueryExecutionContext::prepareKernelParams(
     const bool is_group_by) const {
   CHECK(gpu_allocator_);
   std::vector<CUdeviceptr> params(KERN_PARAM_COUNT, 0);
+  // Offsets of the parameters into the packed buffer, those of device pointers inside
+  // of it are patched once the buffer has an address.
+  std::vector<size_t> param_offsets(KERN_PARAM_COUNT, 0);
+  std::vector<size_t> pointer_offsets;
+  std::vector<size_t> pointee_offsets;
+  KernelParamsBuffer params_buffer;
   const uint64_t num_fragments = static_cast<uint64_t>(col_buffers.size());
   const size_t col_count{num_fragments > 0 ? col_buffers.front().size() : 0};
   if (col_count) {
-    std::vector<CUdeviceptr> multifrag_col_dev_buffers;
+    std::vector<size_t> multifrag_col_buffers_offsets;
     for (auto frag_col_buffers : col_buffers) {
       std::vector<CUdeviceptr> col_dev_buffers;
       for (auto col_buffer : frag_col_buffers) {
         col_dev_buffers.push_back(reinterpret_cast<CUdeviceptr>(col_buffer));
       }
-      auto col_buffers_dev_ptr = reinterpret_cast<CUdeviceptr>(
-          gpu_allocator_->alloc(col_count * sizeof(CUdeviceptr)));
-      copy_to_gpu(data_mgr,
-                  col_buffers_dev_ptr,
-                  &col_dev_buffers[0],
-                  col_count * sizeof(CUdeviceptr),
-                  device_id);
-      multifrag_col_dev_buffers.push_back(col_buffers_dev_ptr);
+      multifrag_col_buffers_offsets.push_back(params_buffer.append(
+          &col_dev_buffers[0], col_count * sizeof(CUdeviceptr)));
+    }
+    param_offsets[COL_BUFFERS] =
+        params_buffer.reserve(num_fragments * sizeof(CUdeviceptr));
+    for (size_t i = 0; i < multifrag_col_buffers_offsets.size(); ++i) {
+      pointer_offsets.push_back(param_offsets[COL_BUFFERS] + i * sizeof(CUdeviceptr));
+      pointee_offsets.push_back(multifrag_col_buffers_offsets[i]);
     }
-    params[COL_BUFFERS] = reinterpret_cast<CUdeviceptr>(
-        gpu_allocator_->alloc(num_fragments * sizeof(CUdeviceptr)));
-    copy_to_gpu(data_mgr,
-                params[COL_BUFFERS],
-                &multifrag_col_dev_buffers[0],
-                num_fragments * sizeof(CUdeviceptr),
-                device_id);
   }
-  params[NUM_FRAGMENTS] =
-      reinterpret_cast<CUdeviceptr>(gpu_allocator_->alloc(sizeof(uint64_t)));
-  copy_to_gpu(
-      data_mgr, params[NUM_FRAGMENTS], &num_fragments, sizeof(uint64_t), device_id);
-  CUdeviceptr literals_and_addr_mapping = reinterpret_cast<CUdeviceptr>(
-      gpu_allocator_->alloc(literal_buff.size() + 2 * sizeof(int64_t)));
-  CHECK_EQ(CUdeviceptr{0}, literals_and_addr_mapping % 8);
+  param_offsets[NUM_FRAGMENTS] = params_buffer.append(&num_fragments, sizeof(uint64_t));
+  const auto literals_and_addr_mapping =
+      params_buffer.reserve(literal_buff.size() + 2 * sizeof(int64_t));
   std::vector<int64_t> additional_literal_bytes;
   const auto count_distinct_bitmap_mem = query_buffers_->getCountDistinctBitmapPtr();
   if (count_distinct_bitmap_mem) {
@@ -909,18 +953,17 @@ std::vector<CUdeviceptr> QueryExecutionContext::prepareKernelParams(
     additional_literal_bytes.push_back(
         reinterpret_cast<int64_t>(count_distinct_bitmap_host_mem));
     additional_literal_bytes.push_back(static_cast<int64_t>(count_distinct_bitmap_mem));
-    copy_to_gpu(data_mgr,
-                literals_and_addr_mapping,
-                &additional_literal_bytes[0],
-                additional_literal_bytes.size() * sizeof(additional_literal_bytes[0]),
-                device_id);
+    params_buffer.write(
+        literals_and_addr_mapping,
+        &additional_literal_bytes[0],
+        additional_literal_bytes.size() * sizeof(additional_literal_bytes[0]));
   }
-  params[LITERALS] = literals_and_addr_mapping + additional_literal_bytes.size() *
-                                                     sizeof(additional_literal_bytes[0]);
+  param_offsets[LITERALS] =
+      literals_and_addr_mapping +
+      additional_literal_bytes.size() * sizeof(additional_literal_bytes[0]);
   if (!literal_buff.empty()) {
     CHECK(hoist_literals);
-    copy_to_gpu(
-        data_mgr, params[LITERALS], &literal_buff[0], literal_buff.size(), device_id);
+    params_buffer.write(param_offsets[LITERALS], &literal_buff[0], literal_buff.size());
   }
   CHECK_EQ(num_rows.size(), col_buffers.size());
   std::vector<int64_t> flatened_num_rows;
@@ -928,13 +971,8 @@ std::vector<CUdeviceptr> QueryExecutionContext::prepareKernelParams(
     CHECK_EQ(nums.size(), num_tables);
     flatened_num_rows.insert(flatened_num_rows.end(), nums.begin(), nums.end());
   }
-  params[NUM_ROWS] = reinterpret_cast<CUdeviceptr>(
-      gpu_allocator_->alloc(sizeof(int64_t) * flatened_num_rows.size()));
-  copy_to_gpu(data_mgr,
-              params[NUM_ROWS],
-              &flatened_num_rows[0],
-              sizeof(int64_t) * flatened_num_rows.size(),
-              device_id);
+  param_offsets[NUM_ROWS] = params_buffer.append(
+      flatened_num_rows.data(), sizeof(int64_t) * flatened_num_rows.size());
 
   CHECK_EQ(frag_offsets.size(), col_buffers.size());
   std::vector<int64_t> flatened_frag_offsets;
@@ -943,61 +981,57 @@ std::vector<CUdeviceptr> QueryExecutionContext::prepareKernelParams(
     flatened_frag_offsets.insert(
         flatened_frag_offsets.end(), offsets.begin(), offsets.end());
   }
-  params[FRAG_ROW_OFFSETS] = reinterpret_cast<CUdeviceptr>(
-      gpu_allocator_->alloc(sizeof(int64_t) * flatened_frag_offsets.size()));
-  copy_to_gpu(data_mgr,
-              params[FRAG_ROW_OFFSETS],
-              &flatened_frag_offsets[0],
-              sizeof(int64_t) * flatened_frag_offsets.size(),
-              device_id);
+  param_offsets[FRAG_ROW_OFFSETS] = params_buffer.append(
+      flatened_frag_offsets.data(), sizeof(int64_t) * flatened_frag_offsets.size());
 
   // Note that this will be overwritten if we are setting the entry count during group by
   // buffer allocation and initialization
   const int32_t max_matched{scan_limit};
-  params[MAX_MATCHED] =
-      reinterpret_cast<CUdeviceptr>(gpu_allocator_->alloc(sizeof(max_matched)));
-  copy_to_gpu(
-      data_mgr, params[MAX_MATCHED], &max_matched, sizeof(max_matched), device_id);
+  param_offsets[MAX_MATCHED] = params_buffer.append(&max_matched, sizeof(max_matched));
 
   int32_t total_matched{0};
-  params[TOTAL_MATCHED] =
-      reinterpret_cast<CUdeviceptr>(gpu_allocator_->alloc(sizeof(total_matched)));
-  copy_to_gpu(
-      data_mgr, params[TOTAL_MATCHED], &total_matched, sizeof(total_matched), device_id);
+  param_offsets[TOTAL_MATCHED] =
+      params_buffer.append(&total_matched, sizeof(total_matched));
 
   if (is_group_by && !output_columnar_) {
     auto cmpt_sz = align_to_int64(query_mem_desc_.getColsSize()) / sizeof(int64_t);
     auto cmpt_val_buff = compact_init_vals(cmpt_sz, init_agg_vals, query_mem_desc_);
-    params[INIT_AGG_VALS] =
-        reinterpret_cast<CUdeviceptr>(gpu_allocator_->alloc(cmpt_sz * sizeof(int64_t)));
-    copy_to_gpu(data_mgr,
-                params[INIT_AGG_VALS],
-                &cmpt_val_buff[0],
-                cmpt_sz * sizeof(int64_t),
-                device_id);
+    param_offsets[INIT_AGG_VALS] =
+        params_buffer.append(&cmpt_val_buff[0], cmpt_sz * sizeof(int64_t));
   } else {
-    params[INIT_AGG_VALS] = reinterpret_cast<CUdeviceptr>(
-        gpu_allocator_->alloc(init_agg_vals.size() * sizeof(int64_t)));
-    copy_to_gpu(data_mgr,
-                params[INIT_AGG_VALS],
-                &init_agg_vals[0],
-                init_agg_vals.size() * sizeof(int64_t),
-                device_id);
+    param_offsets[INIT_AGG_VALS] = params_buffer.append(
+        init_agg_vals.data(), init_agg_vals.size() * sizeof(int64_t));
   }
 
-  params[ERROR_CODE] = reinterpret_cast<CUdeviceptr>(
-      gpu_allocator_->alloc(error_codes.size() * sizeof(error_codes[0])));
-  copy_to_gpu(data_mgr,
-              params[ERROR_CODE],
-              &error_codes[0],
-              error_codes.size() * sizeof(error_codes[0]),
-              device_id);
+  param_offsets[ERROR_CODE] = params_buffer.append(
+      error_codes.data(), error_codes.size() * sizeof(error_codes[0]));
 
-  params[NUM_TABLES] =
-      reinterpret_cast<CUdeviceptr>(gpu_allocator_->alloc(sizeof(uint32_t)));
-  copy_to_gpu(data_mgr, params[NUM_TABLES], &num_tables, sizeof(uint32_t), device_id);
+  param_offsets[NUM_TABLES] = params_buffer.append(&num_tables, sizeof(uint32_t));
 
   const auto hash_table_count = join_hash_tables.size();
+  if (hash_table_count > 1) {
+    param_offsets[JOIN_HASH_TABLES] = params_buffer.append(
+        &join_hash_tables[0], hash_table_count * sizeof(int64_t));
+  }
+
+  const auto params_dev_ptr =
+      reinterpret_cast<CUdeviceptr>(gpu_allocator_->alloc(params_buffer.size()));
+  CHECK_EQ(CUdeviceptr{0}, params_dev_ptr % 8);
+  for (size_t i = 0; i < pointer_offsets.size(); ++i) {
+    const CUdeviceptr pointee = params_dev_ptr + pointee_offsets[i];
+    params_buffer.write(pointer_offsets[i], &pointee, sizeof(pointee));
+  }
+  copy_to_gpu(
+      data_mgr, params_dev_ptr, params_buffer.data(), params_buffer.size(), device_id);
+
+  for (const auto param :
+       {NUM_FRAGMENTS, LITERALS, NUM_ROWS, FRAG_ROW_OFFSETS, MAX_MATCHED, TOTAL_MATCHED,
+        INIT_AGG_VALS, ERROR_CODE, NUM_TABLES}) {
+    params[param] = params_dev_ptr + param_offsets[param];
+  }
+  if (col_count) {
+    params[COL_BUFFERS] = params_dev_ptr + param_offsets[COL_BUFFERS];
+  }
   switch (hash_table_count) {
     case 0: {
       params[JOIN_HASH_TABLES] = CUdeviceptr(0);
@@ -1007,13 +1041,7 @@ std::vector<CUdeviceptr> QueryExecutionContext::prepareKernelParams(
       params[JOIN_HASH_TABLES] = static_cast<CUdeviceptr>(join_hash_tables[0]);
       break;
     default: {
-      params[JOIN_HASH_TABLES] = reinterpret_cast<CUdeviceptr>(
-          gpu_allocator_->alloc(hash_table_count * sizeof(int64_t)));
-      copy_to_gpu(data_mgr,
-                  params[JOIN_HASH_TABLES],
-                  &join_hash_tables[0],
-                  hash_table_count * sizeof(int64_t),
-                  device_id);
+      params[JOIN_HASH_TABLES] = params_dev_ptr + param_offsets[JOIN_HASH_TABLES];
       break;
     }
   }
@@ -28,6 +28,10 @@
 #include <boost/core/noncopyable.hpp>
 #include <vector>
 
+// Launch the kernels of each executor on its own CUDA streams rather than on the legacy
+// default stream, so that queries running on different executors share the GPUs.
+extern bool g_enable_gpu_query_streams;
+
 class GpuCompilationContext;
 class CpuCompilationContext;
 
@@ -51,6 +55,7 @@ class QueryExecutionContext : boost::noncopyable {
                         const bool output_columnar,
                         const bool sort_on_gpu,
                         const size_t thread_idx,
+                        SharedCpuGroupByBuffer* shared_cpu_group_by_buffer,
                         RenderInfo*);
 
   ResultSetPtr getRowSet(const RelAlgExecutionUnit& ra_exe_unit,
@@ -32,6 +32,8 @@ enum QueryHint {
   kOverlapsAllowGpuBuild,
   kOverlapsNoCache,
   kOverlapsKeysPerBin,
+  kTableSampleSystem,
+  kTableSampleBernoulli,
   kHintCount,   // should be at the last elem before INVALID enum value to count #
                 // supported hints correctly
   kInvalidHint  // this should be the last elem of this enum
@@ -43,7 +45,9 @@ static const std::unordered_map<std::string, QueryHint> SupportedQueryHints = {
     {"overlaps_max_size", QueryHint::kOverlapsMaxSize},
     {"overlaps_allow_gpu_build", QueryHint::kOverlapsAllowGpuBuild},
     {"overlaps_no_cache", QueryHint::kOverlapsNoCache},
-    {"overlaps_keys_per_bin", QueryHint::kOverlapsKeysPerBin}};
+    {"overlaps_keys_per_bin", QueryHint::kOverlapsKeysPerBin},
+    {"tablesample_system", QueryHint::kTableSampleSystem},
+    {"tablesample_bernoulli", QueryHint::kTableSampleBernoulli}};
 
 class ExplainedQueryHint {
   // this class represents parsed query hint's specification
@@ -137,6 +141,8 @@ struct RegisteredQueryHint {
       , overlaps_allow_gpu_build(true)
       , overlaps_no_cache(false)
       , overlaps_keys_per_bin(g_overlaps_target_entries_per_bin)
+      , tablesample_system_percent(100.0)
+      , tablesample_bernoulli_percent(100.0)
       , registered_hint(QueryHint::kHintCount, false) {}
 
   RegisteredQueryHint& operator=(const RegisteredQueryHint& other) {
@@ -146,6 +152,8 @@ struct RegisteredQueryHint {
     overlaps_allow_gpu_build = other.overlaps_allow_gpu_build;
     overlaps_no_cache = other.overlaps_no_cache;
     overlaps_keys_per_bin = other.overlaps_keys_per_bin;
+    tablesample_system_percent = other.tablesample_system_percent;
+    tablesample_bernoulli_percent = other.tablesample_bernoulli_percent;
     registered_hint = other.registered_hint;
     return *this;
   }
@@ -157,6 +165,8 @@ struct RegisteredQueryHint {
     overlaps_allow_gpu_build = other.overlaps_allow_gpu_build;
     overlaps_no_cache = other.overlaps_no_cache;
     overlaps_keys_per_bin = other.overlaps_keys_per_bin;
+    tablesample_system_percent = other.tablesample_system_percent;
+    tablesample_bernoulli_percent = other.tablesample_bernoulli_percent;
     registered_hint = other.registered_hint;
   }
 
@@ -170,6 +180,11 @@ struct RegisteredQueryHint {
   bool overlaps_no_cache;
   double overlaps_keys_per_bin;
 
+  // sampled execution, the percentage of the outer fragments (system) or of the rows
+  // (bernoulli) of the tables scanned by the query
+  double tablesample_system_percent;
+  double tablesample_bernoulli_percent;
+
   std::vector<bool> registered_hint;
 
   static RegisteredQueryHint defaults() { return RegisteredQueryHint(); }
@@ -207,6 +222,11 @@ struct RegisteredQueryHint {
     }
     return false;
   }
+
+  bool isTableSampled() const {
+    return isHintRegistered(QueryHint::kTableSampleSystem) ||
+           isHintRegistered(QueryHint::kTableSampleBernoulli);
+  }
 };
 
 // a map from hint_name to its detailed info
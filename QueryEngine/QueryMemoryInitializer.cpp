@@ -28,9 +28,13 @@
 
 // 8 GB, the limit of perfect hash group by under normal conditions
 int64_t g_bitmap_memory_limit{8LL * 1000 * 1000 * 1000};
+bool g_enable_lazy_group_by_buffer_init{true};
 
 namespace {
 
+// Smaller buffers are cheaper to initialize than to get from calloc().
+constexpr size_t kLazyInitMinBufferBytes{1 << 20};
+
 inline void check_total_bitmap_memory(const QueryMemoryDescriptor& query_mem_desc) {
   const int32_t groups_buffer_entry_count = query_mem_desc.getEntryCount();
   checked_int64_t total_bytes_per_group = 0;
@@ -74,6 +78,41 @@ int64_t* alloc_group_by_buffer(const size_t numBytes,
   }
 }
 
+int64_t* alloc_zeroed_group_by_buffer(const size_t numBytes,
+                                      RowSetMemoryOwner* mem_owner) {
+  return mem_owner->allocateZeroedGroupByBuffer(numBytes);
+}
+
+// Whether the initialized group by buffer would be all zero bytes, as for a keyless
+// perfect hash group by of counts and sums of non null columns. calloc() maps the large
+// buffers to zero pages, so the kernel only faults in the pages of the groups it updates
+// and the reduction only reads zero pages for the untouched ones.
+bool use_lazy_zeroed_group_by_buffer(const RelAlgExecutionUnit& ra_exe_unit,
+                                     const QueryMemoryDescriptor& query_mem_desc,
+                                     const std::vector<int64_t>& init_agg_vals,
+                                     const ExecutorDeviceType device_type,
+                                     const size_t buffer_size,
+                                     const RenderAllocatorMap* render_allocator_map) {
+  if (!g_enable_lazy_group_by_buffer_init || device_type != ExecutorDeviceType::CPU ||
+      render_allocator_map || buffer_size < kLazyInitMinBufferBytes) {
+    return false;
+  }
+  if (query_mem_desc.getQueryDescriptionType() !=
+          QueryDescriptionType::GroupByPerfectHash ||
+      !query_mem_desc.hasKeylessHash() || query_mem_desc.useStreamingTopN() ||
+      !query_mem_desc.countDistinctDescriptorsLogicallyEmpty()) {
+    return false;
+  }
+  for (const auto target_expr : ra_exe_unit.target_exprs) {
+    if (get_target_info(target_expr, g_bigint_count).agg_kind == kAPPROX_QUANTILE) {
+      return false;
+    }
+  }
+  return std::all_of(init_agg_vals.begin(),
+                     init_agg_vals.end(),
+                     [](const int64_t init_val) { return init_val == 0; });
+}
+
 inline int64_t get_consistent_frag_size(const std::vector<uint64_t>& frag_offsets) {
   if (frag_offsets.size() < 2) {
     return int64_t(-1);
@@ -168,6 +207,7 @@ QueryMemoryInitializer::QueryMemoryInitializer(
     std::shared_ptr<RowSetMemoryOwner> row_set_mem_owner,
     DeviceAllocator* device_allocator,
     const size_t thread_idx,
+    SharedCpuGroupByBuffer* shared_cpu_group_by_buffer,
     const Executor* executor)
     : num_rows_(num_rows)
     , row_set_mem_owner_(row_set_mem_owner)
@@ -228,8 +268,15 @@ QueryMemoryInitializer::QueryMemoryInitializer(
   CHECK_GE(group_buffer_size, size_t(0));
 
   const auto group_buffers_count = !query_mem_desc.isGroupBy() ? 1 : num_buffers_;
+  const bool lazy_zeroed_buffers = use_lazy_zeroed_group_by_buffer(ra_exe_unit,
+                                                                   query_mem_desc,
+                                                                   init_agg_vals_,
+                                                                   device_type,
+                                                                   group_buffer_size,
+                                                                   render_allocator_map);
   int64_t* group_by_buffer_template{nullptr};
-  if (!query_mem_desc.lazyInitGroups(device_type) && group_buffers_count > 1) {
+  if (!query_mem_desc.lazyInitGroups(device_type) && !lazy_zeroed_buffers &&
+      group_buffers_count > 1) {
     group_by_buffer_template = reinterpret_cast<int64_t*>(
         row_set_mem_owner_->allocate(group_buffer_size, thread_idx_));
     initGroupByBuffer(group_by_buffer_template,
@@ -267,22 +314,45 @@ QueryMemoryInitializer::QueryMemoryInitializer(
   }
 
   for (size_t i = 0; i < group_buffers_count; i += step) {
-    auto group_by_buffer = alloc_group_by_buffer(actual_group_buffer_size,
-                                                 render_allocator_map,
-                                                 thread_idx_,
-                                                 row_set_mem_owner_.get());
-    if (!query_mem_desc.lazyInitGroups(device_type)) {
-      if (group_by_buffer_template) {
-        memcpy(group_by_buffer + index_buffer_qw,
-               group_by_buffer_template,
-               group_buffer_size);
-      } else {
-        initGroupByBuffer(group_by_buffer + index_buffer_qw,
-                          ra_exe_unit,
-                          query_mem_desc,
-                          device_type,
-                          output_columnar,
-                          executor);
+    int64_t* group_by_buffer{nullptr};
+    if (query_mem_desc.useSharedCpuGroupByBuffer()) {
+      CHECK(device_type == ExecutorDeviceType::CPU);
+      CHECK_EQ(group_buffers_count, size_t(1));
+      CHECK(shared_cpu_group_by_buffer);
+      group_by_buffer = shared_cpu_group_by_buffer->getOrCreate([&]() {
+        if (lazy_zeroed_buffers) {
+          return alloc_zeroed_group_by_buffer(actual_group_buffer_size,
+                                              row_set_mem_owner_.get());
+        }
+        auto buffer = alloc_group_by_buffer(actual_group_buffer_size,
+                                            render_allocator_map,
+                                            thread_idx_,
+                                            row_set_mem_owner_.get());
+        initGroupByBuffer(
+            buffer, ra_exe_unit, query_mem_desc, device_type, output_columnar, executor);
+        return buffer;
+      });
+    } else if (lazy_zeroed_buffers) {
+      group_by_buffer = alloc_zeroed_group_by_buffer(actual_group_buffer_size,
+                                                     row_set_mem_owner_.get());
+    } else {
+      group_by_buffer = alloc_group_by_buffer(actual_group_buffer_size,
+                                              render_allocator_map,
+                                              thread_idx_,
+                                              row_set_mem_owner_.get());
+      if (!query_mem_desc.lazyInitGroups(device_type)) {
+        if (group_by_buffer_template) {
+          memcpy(group_by_buffer + index_buffer_qw,
+                 group_by_buffer_template,
+                 group_buffer_size);
+        } else {
+          initGroupByBuffer(group_by_buffer + index_buffer_qw,
+                            ra_exe_unit,
+                            query_mem_desc,
+                            device_type,
+                            output_columnar,
+                            executor);
+        }
       }
     }
     group_by_buffers_.push_back(group_by_buffer);
@@ -597,8 +667,9 @@ void QueryMemoryInitializer::initColumnsPerRow(
       // COUNT DISTINCT / APPROX_COUNT_DISTINCT
       CHECK_EQ(static_cast<size_t>(query_mem_desc.getPaddedSlotWidthBytes(col_idx)),
                sizeof(int64_t));
-      init_val =
-          bm_sz > 0 ? allocateCountDistinctBitmap(bm_sz) : allocateCountDistinctSet();
+      init_val = bm_sz > 0    ? allocateCountDistinctBitmap(bm_sz)
+                 : bm_sz == -1 ? allocateCountDistinctSet()
+                               : allocateCountDistinctSparseBitmap();
       ++init_vec_idx;
     } else if (query_mem_desc.isGroupBy() && quantile_params[col_idx]) {
       auto const q = *quantile_params[col_idx];
@@ -696,6 +767,12 @@ std::vector<int64_t> QueryMemoryInitializer::allocateCountDistinctBuffers(
         } else {
           init_agg_vals_[agg_col_idx] = allocateCountDistinctBitmap(bitmap_byte_sz);
         }
+      } else if (count_distinct_desc.impl_type_ == CountDistinctImplType::SparseBitmap) {
+        if (deferred) {
+          agg_bitmap_size[agg_col_idx] = -2;
+        } else {
+          init_agg_vals_[agg_col_idx] = allocateCountDistinctSparseBitmap();
+        }
       } else {
         CHECK(count_distinct_desc.impl_type_ == CountDistinctImplType::StdSet);
         if (deferred) {
@@ -724,9 +801,14 @@ int64_t QueryMemoryInitializer::allocateCountDistinctBitmap(const size_t bitmap_
 }
 
 int64_t QueryMemoryInitializer::allocateCountDistinctSet() {
-  auto count_distinct_set = new std::set<int64_t>();
-  row_set_mem_owner_->addCountDistinctSet(count_distinct_set);
-  return reinterpret_cast<int64_t>(count_distinct_set);
+  return reinterpret_cast<int64_t>(
+      row_set_mem_owner_->allocateCountDistinctSet(thread_idx_));
+}
+
+int64_t QueryMemoryInitializer::allocateCountDistinctSparseBitmap() {
+  auto count_distinct_sparse_bitmap = new SparseBitmap();
+  row_set_mem_owner_->addCountDistinctSparseBitmap(count_distinct_sparse_bitmap);
+  return reinterpret_cast<int64_t>(count_distinct_sparse_bitmap);
 }
 
 std::vector<QueryMemoryInitializer::QuantileParam>
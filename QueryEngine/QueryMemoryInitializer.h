@@ -24,7 +24,9 @@
 
 #include "Rendering/RenderAllocator.h"
 
+#include <functional>
 #include <memory>
+#include <mutex>
 
 #ifdef HAVE_CUDA
 #include <cuda.h>
@@ -32,6 +34,31 @@
 #include <Shared/nocuda.h>
 #endif
 
+// Get the CPU group by buffers whose initial values are all zero from calloc() instead
+// of initializing them, so that only the touched pages of the buffer are ever written.
+extern bool g_enable_lazy_group_by_buffer_init;
+
+/**
+ * Group by buffer shared by all the CPU kernels of a query step, see
+ * QueryMemoryDescriptor::useSharedCpuGroupByBuffer(). The first kernel to ask for it
+ * allocates and initializes the buffer, the others wait for it and then insert into it
+ * concurrently.
+ */
+class SharedCpuGroupByBuffer {
+ public:
+  int64_t* getOrCreate(const std::function<int64_t*()>& create) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!buffer_) {
+      buffer_ = create();
+    }
+    return buffer_;
+  }
+
+ private:
+  std::mutex mutex_;
+  int64_t* buffer_{nullptr};
+};
+
 class QueryMemoryInitializer {
  public:
   // Row-based execution constructor
@@ -50,6 +77,7 @@ class QueryMemoryInitializer {
                          std::shared_ptr<RowSetMemoryOwner> row_set_mem_owner,
                          DeviceAllocator* gpu_allocator,
                          const size_t thread_idx,
+                         SharedCpuGroupByBuffer* shared_cpu_group_by_buffer,
                          const Executor* executor);
 
   // Table functions execution constructor
@@ -171,6 +199,8 @@ class QueryMemoryInitializer {
 
   int64_t allocateCountDistinctSet();
 
+  int64_t allocateCountDistinctSparseBitmap();
+
   std::vector<QuantileParam> allocateTDigests(const QueryMemoryDescriptor& query_mem_desc,
                                               const bool deferred,
                                               const Executor* executor);
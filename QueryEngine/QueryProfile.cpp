@@ -0,0 +1,92 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "QueryEngine/QueryProfile.h"
+
+bool g_enable_query_profile{false};
+size_t g_query_profile_history_size{100};
+
+void QueryProfile::addKernelTime(const ExecutorDeviceType device_type,
+                                 const int device_id,
+                                 const int64_t time_us) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  auto it = kernel_times_.find({device_type, device_id});
+  if (it == kernel_times_.end()) {
+    kernel_times_.emplace(
+        std::make_pair(device_type, device_id),
+        QueryProfileInfo::KernelTime{device_type, device_id, 1, time_us});
+    return;
+  }
+  ++it->second.kernel_count;
+  it->second.time_us += time_us;
+}
+
+void QueryProfile::addStep(const std::string& step,
+                           const size_t row_count,
+                           const int64_t time_us) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  steps_.push_back({step, row_count, time_us});
+}
+
+QueryProfileInfo QueryProfile::getInfo() const {
+  QueryProfileInfo info;
+  info.user_name = user_name_;
+  info.public_session_id = public_session_id_;
+  info.query_str = query_str_;
+  info.submitted = submitted_;
+  info.compilation_time_us = compilation_time_us_.load(std::memory_order_relaxed);
+  info.fetch_time_us = fetch_time_us_.load(std::memory_order_relaxed);
+  for (size_t i = 0; i < fetched_bytes_.size(); ++i) {
+    info.fetched_bytes[i] = fetched_bytes_[i].load(std::memory_order_relaxed);
+  }
+  info.reduction_time_us = reduction_time_us_.load(std::memory_order_relaxed);
+  info.code_cache_hits = code_cache_hits_.load(std::memory_order_relaxed);
+  info.code_cache_misses = code_cache_misses_.load(std::memory_order_relaxed);
+  info.recycled_results = recycled_results_.load(std::memory_order_relaxed);
+  std::lock_guard<std::mutex> guard(mutex_);
+  for (const auto& kernel_time : kernel_times_) {
+    info.kernel_times.push_back(kernel_time.second);
+  }
+  info.steps = steps_;
+  return info;
+}
+
+QueryProfileHistory& QueryProfileHistory::instance() {
+  static QueryProfileHistory query_profile_history;
+  return query_profile_history;
+}
+
+void QueryProfileHistory::add(const QueryProfileInfo& profile) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  if (!g_query_profile_history_size) {
+    profiles_.clear();
+    return;
+  }
+  while (profiles_.size() >= g_query_profile_history_size) {
+    profiles_.pop_front();
+  }
+  profiles_.push_back(profile);
+}
+
+std::vector<QueryProfileInfo> QueryProfileHistory::get() const {
+  std::lock_guard<std::mutex> guard(mutex_);
+  return {profiles_.begin(), profiles_.end()};
+}
+
+void QueryProfileHistory::clear() {
+  std::lock_guard<std::mutex> guard(mutex_);
+  profiles_.clear();
+}
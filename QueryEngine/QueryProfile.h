@@ -0,0 +1,154 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "DataMgr/MemoryLevel.h"
+#include "QueryEngine/CompilationOptions.h"
+
+// Collect an execution profile of every query.
+extern bool g_enable_query_profile;
+// Number of the most recent query profiles kept by the server.
+extern size_t g_query_profile_history_size;
+
+struct QueryProfileInfo {
+  struct KernelTime {
+    ExecutorDeviceType device_type;
+    int device_id;
+    size_t kernel_count;
+    int64_t time_us;
+  };
+
+  struct StepInfo {
+    // Type and id of the query plan node executed by the step, e.g. RelCompound#3.
+    std::string step;
+    size_t row_count;
+    int64_t time_us;
+  };
+
+  std::string user_name;
+  std::string public_session_id;
+  std::string query_str;
+  std::string submitted;
+  int64_t compilation_time_us{0};
+  int64_t fetch_time_us{0};
+  // Bytes of the chunks fetched by the kernels, by Data_Namespace::MemoryLevel.
+  std::array<size_t, 3> fetched_bytes{};
+  std::vector<KernelTime> kernel_times;
+  int64_t reduction_time_us{0};
+  std::vector<StepInfo> steps;
+  size_t code_cache_hits{0};
+  size_t code_cache_misses{0};
+  size_t recycled_results{0};
+};
+
+/**
+ * Counters of the execution of a query, shared by its kernels through the Executor. The
+ * hot counters are relaxed atomics and kernels add to them once per kernel, so that
+ * profiling every query costs little more than the clock reads.
+ */
+class QueryProfile {
+ public:
+  QueryProfile(const std::string& user_name,
+               const std::string& public_session_id,
+               const std::string& query_str,
+               const std::string& submitted)
+      : user_name_(user_name)
+      , public_session_id_(public_session_id)
+      , query_str_(query_str)
+      , submitted_(submitted) {}
+
+  void addCompilationTime(const int64_t time_us) {
+    compilation_time_us_.fetch_add(time_us, std::memory_order_relaxed);
+  }
+
+  void addFetch(const Data_Namespace::MemoryLevel memory_level,
+                const size_t num_bytes,
+                const int64_t time_us) {
+    fetched_bytes_[memory_level].fetch_add(num_bytes, std::memory_order_relaxed);
+    fetch_time_us_.fetch_add(time_us, std::memory_order_relaxed);
+  }
+
+  void addKernelTime(const ExecutorDeviceType device_type,
+                     const int device_id,
+                     const int64_t time_us);
+
+  void addReductionTime(const int64_t time_us) {
+    reduction_time_us_.fetch_add(time_us, std::memory_order_relaxed);
+  }
+
+  void addStep(const std::string& step, const size_t row_count, const int64_t time_us);
+
+  void addCodeCacheLookup(const bool hit) {
+    (hit ? code_cache_hits_ : code_cache_misses_)
+        .fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void addRecycledResult() { recycled_results_.fetch_add(1, std::memory_order_relaxed); }
+
+  QueryProfileInfo getInfo() const;
+
+ private:
+  const std::string user_name_;
+  const std::string public_session_id_;
+  const std::string query_str_;
+  const std::string submitted_;
+
+  std::atomic<int64_t> compilation_time_us_{0};
+  std::atomic<int64_t> fetch_time_us_{0};
+  std::array<std::atomic<size_t>, 3> fetched_bytes_{};
+  std::atomic<int64_t> reduction_time_us_{0};
+  std::atomic<size_t> code_cache_hits_{0};
+  std::atomic<size_t> code_cache_misses_{0};
+  std::atomic<size_t> recycled_results_{0};
+
+  mutable std::mutex mutex_;
+  std::map<std::pair<ExecutorDeviceType, int>, QueryProfileInfo::KernelTime>
+      kernel_times_;
+  std::vector<QueryProfileInfo::StepInfo> steps_;
+};
+
+/**
+ * Ring buffer of the profiles of the most recent queries, bounded by
+ * `g_query_profile_history_size`.
+ */
+class QueryProfileHistory {
+ public:
+  static QueryProfileHistory& instance();
+
+  void add(const QueryProfileInfo& profile);
+
+  // Returns the kept profiles, oldest first.
+  std::vector<QueryProfileInfo> get() const;
+
+  void clear();
+
+ private:
+  QueryProfileHistory() {}
+
+  std::deque<QueryProfileInfo> profiles_;
+  mutable std::mutex mutex_;
+};
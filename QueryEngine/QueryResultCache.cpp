@@ -0,0 +1,93 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "QueryEngine/QueryResultCache.h"
+
+#include "Logger/Logger.h"
+
+size_t g_query_result_cache_max_bytes{0};
+
+namespace {
+
+size_t get_entry_size_bytes(const std::string& key, const std::string& result) {
+  return key.size() + result.size();
+}
+
+}  // namespace
+
+QueryResultCache& QueryResultCache::instance() {
+  static QueryResultCache query_result_cache;
+  return query_result_cache;
+}
+
+std::shared_ptr<const std::string> QueryResultCache::get(const std::string& key) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    return nullptr;
+  }
+  lru_.splice(lru_.begin(), lru_, it->second.lru_it);
+  return it->second.result;
+}
+
+void QueryResultCache::put(const std::string& key,
+                           std::shared_ptr<const std::string> result) {
+  CHECK(result);
+  const auto size_bytes = get_entry_size_bytes(key, *result);
+  if (size_bytes > g_query_result_cache_max_bytes) {
+    VLOG(1) << "Not caching a query result of " << size_bytes
+            << " bytes, over the cache budget of " << g_query_result_cache_max_bytes
+            << " bytes.";
+    return;
+  }
+  std::lock_guard<std::mutex> guard(mutex_);
+  auto it = entries_.find(key);
+  if (it != entries_.end()) {
+    size_bytes_ -= get_entry_size_bytes(key, *it->second.result);
+    it->second.result = std::move(result);
+    lru_.splice(lru_.begin(), lru_, it->second.lru_it);
+  } else {
+    it = entries_.emplace(key, CacheEntry{std::move(result), {}}).first;
+    lru_.push_front(&it->first);
+    it->second.lru_it = lru_.begin();
+  }
+  size_bytes_ += size_bytes;
+  evictUnlocked();
+}
+
+void QueryResultCache::clear() {
+  std::lock_guard<std::mutex> guard(mutex_);
+  VLOG(1) << "Invalidating " << entries_.size() << " cached query results.";
+  entries_.clear();
+  lru_.clear();
+  size_bytes_ = 0;
+}
+
+size_t QueryResultCache::getNumberOfCachedResults() {
+  std::lock_guard<std::mutex> guard(mutex_);
+  return entries_.size();
+}
+
+void QueryResultCache::evictUnlocked() {
+  while (size_bytes_ > g_query_result_cache_max_bytes) {
+    CHECK(!lru_.empty());
+    auto it = entries_.find(*lru_.back());
+    CHECK(it != entries_.end());
+    size_bytes_ -= get_entry_size_bytes(it->first, *it->second.result);
+    lru_.pop_back();
+    entries_.erase(it);
+  }
+}
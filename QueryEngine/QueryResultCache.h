@@ -0,0 +1,76 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+// Byte budget of the query result cache, 0 disables the cache.
+extern size_t g_query_result_cache_max_bytes;
+
+/**
+ * Server wide cache of the serialized results of read queries. Keys are built by the
+ * caller from the query plan and the state of the input tables (epochs and row counts),
+ * so that loads into a table produce new keys, while updates and deletes clear the cache
+ * through the update and delete triggered cache invalidators. Once the cached results
+ * exceed `g_query_result_cache_max_bytes`, the least recently used ones are evicted.
+ */
+class QueryResultCache {
+ public:
+  // Filled in by the query execution when its result can be cached.
+  struct Lookup {
+    // Empty if the query result can't be cached.
+    std::string key;
+    // The serialized result, if it was found in the cache.
+    std::shared_ptr<const std::string> result;
+  };
+
+  static QueryResultCache& instance();
+
+  static std::function<void()> getCacheInvalidator() {
+    return []() -> void { instance().clear(); };
+  }
+
+  std::shared_ptr<const std::string> get(const std::string& key);
+
+  void put(const std::string& key, std::shared_ptr<const std::string> result);
+
+  void clear();
+
+  // For testing purposes only
+  size_t getNumberOfCachedResults();
+
+ private:
+  QueryResultCache() {}
+
+  void evictUnlocked();
+
+  struct CacheEntry {
+    std::shared_ptr<const std::string> result;
+    // Position in lru_, the most recently used results come first.
+    std::list<const std::string*>::iterator lru_it;
+  };
+
+  std::unordered_map<std::string, CacheEntry> entries_;
+  std::list<const std::string*> lru_;
+  size_t size_bytes_{0};
+  std::mutex mutex_;
+};
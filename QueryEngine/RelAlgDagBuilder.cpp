@@ -36,6 +36,8 @@
 extern bool g_cluster;
 extern bool g_enable_union;
 
+bool g_enable_in_subquery_semi_join{false};
+
 namespace {
 
 const unsigned FIRST_RA_NODE_ID = 1;
@@ -810,6 +812,7 @@ std::vector<std::unique_ptr<const RexScalar>> parse_expr_array(
     const Catalog_Namespace::Catalog& cat,
     RelAlgDagBuilder& root_dag_builder) {
   std::vector<std::unique_ptr<const RexScalar>> exprs;
+  exprs.reserve(arr.Size());
   for (auto it = arr.Begin(); it != arr.End(); ++it) {
     exprs.emplace_back(parse_scalar_expr(*it, cat, root_dag_builder));
   }
@@ -873,6 +876,7 @@ std::vector<std::unique_ptr<const RexScalar>> parse_window_order_exprs(
     const Catalog_Namespace::Catalog& cat,
     RelAlgDagBuilder& root_dag_builder) {
   std::vector<std::unique_ptr<const RexScalar>> exprs;
+  exprs.reserve(arr.Size());
   for (auto it = arr.Begin(); it != arr.End(); ++it) {
     exprs.emplace_back(parse_scalar_expr(field(*it, "field"), cat, root_dag_builder));
   }
@@ -1010,10 +1014,11 @@ std::vector<std::string> strings_from_json_array(
     const rapidjson::Value& json_str_arr) noexcept {
   CHECK(json_str_arr.IsArray());
   std::vector<std::string> fields;
+  fields.reserve(json_str_arr.Size());
   for (auto json_str_arr_it = json_str_arr.Begin(); json_str_arr_it != json_str_arr.End();
        ++json_str_arr_it) {
     CHECK(json_str_arr_it->IsString());
-    fields.emplace_back(json_str_arr_it->GetString());
+    fields.emplace_back(json_str_arr_it->GetString(), json_str_arr_it->GetStringLength());
   }
   return fields;
 }
@@ -2223,6 +2228,7 @@ class RelAlgDispatcher {
     const auto& exprs_json = field(proj_ra, "exprs");
     CHECK(exprs_json.IsArray());
     std::vector<std::unique_ptr<const RexScalar>> exprs;
+    exprs.reserve(exprs_json.Size());
     for (auto exprs_json_it = exprs_json.Begin(); exprs_json_it != exprs_json.End();
          ++exprs_json_it) {
       exprs.emplace_back(parse_scalar_expr(*exprs_json_it, cat_, root_dag_builder));
@@ -2617,8 +2623,12 @@ RelAlgDagBuilder::RelAlgDagBuilder(const std::string& query_ra,
                                    const Catalog_Namespace::Catalog& cat,
                                    const RenderInfo* render_info)
     : cat_(cat), render_info_(render_info), query_hint_(RegisteredQueryHint::defaults()) {
+  // Parse in situ over a copy of the plan, the strings of the DOM then point into the
+  // copy instead of being allocated one by one, which dominates the parsing of wide
+  // projections. The copy outlives build(), no node keeps references into the DOM.
+  std::string query_ra_buffer(query_ra);
   rapidjson::Document query_ast;
-  query_ast.Parse(query_ra.c_str());
+  query_ast.ParseInsitu(&query_ra_buffer[0]);
   VLOG(2) << "Parsing query RA JSON: " << query_ra;
   if (query_ast.HasParseError()) {
     query_ast.GetParseError();
@@ -2644,6 +2654,7 @@ RelAlgDagBuilder::RelAlgDagBuilder(RelAlgDagBuilder& root_dag_builder,
 
 void RelAlgDagBuilder::build(const rapidjson::Value& query_ast,
                              RelAlgDagBuilder& lead_dag_builder) {
+  auto timer = DEBUG_TIMER(__func__);
   const auto& rels = field(query_ast, "rels");
   CHECK(rels.IsArray());
   try {
@@ -2691,6 +2702,10 @@ void RelAlgDagBuilder::build(const rapidjson::Value& query_ast,
   coalesce_nodes(nodes_, left_deep_joins);
   CHECK(nodes_.back().use_count() == 1);
   create_left_deep_join(nodes_);
+  if (g_enable_in_subquery_semi_join && !g_cluster) {
+    create_semi_joins_for_in_subqueries(nodes_, cat_);
+    eliminate_dead_subqueries(subqueries_, nodes_.back().get());
+  }
 }
 
 void RelAlgDagBuilder::eachNode(
@@ -345,6 +345,8 @@ class RexSubQuery : public RexScalar {
 
   const RelAlgNode* getRelAlg() const { return ra_.get(); }
 
+  std::shared_ptr<const RelAlgNode> getRelAlgShPtr() const { return ra_; }
+
   std::string toString() const override;
 
   size_t toHash() const override;
@@ -1514,6 +1516,8 @@ class RelLeftDeepInnerJoin : public RelAlgNode {
 
   const RexScalar* getOuterCondition(const size_t nesting_level) const;
 
+  JoinType getJoinType(const size_t nesting_level) const;
+
   std::string toString() const override;
 
   size_t toHash() const override;
@@ -1530,7 +1534,9 @@ class RelLeftDeepInnerJoin : public RelAlgNode {
 
  private:
   std::unique_ptr<const RexScalar> condition_;
+  // Conditions of the outer, semi and anti joins, which only apply to their own level.
   std::vector<std::unique_ptr<const RexScalar>> outer_conditions_per_level_;
+  std::vector<JoinType> join_types_per_level_;
   const std::shared_ptr<RelFilter> original_filter_;
   const std::vector<std::shared_ptr<const RelJoin>> original_joins_;
 };
@@ -2250,6 +2256,29 @@ class RelAlgDagBuilder : public boost::noncopyable {
           }
           break;
         }
+        case QueryHint::kTableSampleSystem:
+        case QueryHint::kTableSampleBernoulli: {
+          CHECK(target.getListOptions().size() == 1);
+          const bool is_system = hint_type == QueryHint::kTableSampleSystem;
+          const auto hint_name =
+              is_system ? "tablesample_system" : "tablesample_bernoulli";
+          double sample_percent = std::stod(target.getListOptions()[0]);
+          if (sample_percent > 0.0 && sample_percent <= 100.0) {
+            query_hint_.registerHint(hint_type);
+            if (is_system) {
+              query_hint_.tablesample_system_percent = sample_percent;
+            } else {
+              query_hint_.tablesample_bernoulli_percent = sample_percent;
+            }
+            VLOG(1) << "Sampling " << sample_percent << "% of the "
+                    << (is_system ? "fragments" : "rows") << " of the scanned tables.";
+          } else {
+            VLOG(1) << "Skip the given query hint \"" << hint_name << "\" ("
+                    << sample_percent
+                    << ") : the hint value should be within 0.0 ~ 100.0";
+          }
+          break;
+        }
         default:
           break;
       }
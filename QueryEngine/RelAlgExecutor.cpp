@@ -21,8 +21,10 @@
 #include "QueryEngine/CalciteDeserializerUtils.h"
 #include "QueryEngine/CardinalityEstimator.h"
 #include "QueryEngine/ColumnFetcher.h"
+#include "QueryEngine/DeepCopyVisitor.h"
 #include "QueryEngine/EquiJoinCondition.h"
 #include "QueryEngine/ErrorHandling.h"
+#include "QueryEngine/ExpressionRange.h"
 #include "QueryEngine/ExpressionRewrite.h"
 #include "QueryEngine/ExtensionFunctionsBinding.h"
 #include "QueryEngine/ExternalExecutor.h"
@@ -34,7 +36,9 @@
 #include "QueryEngine/RelAlgTranslator.h"
 #include "QueryEngine/RelAlgVisitor.h"
 #include "QueryEngine/ResultSetBuilder.h"
+#include "QueryEngine/ResultSetRecycler.h"
 #include "QueryEngine/RexVisitor.h"
+#include "QueryEngine/SpaceSavingSketch.h"
 #include "QueryEngine/TableOptimizer.h"
 #include "QueryEngine/WindowContext.h"
 #include "Shared/TypedDataAccessors.h"
@@ -46,19 +50,39 @@
 #include <boost/range/adaptor/reversed.hpp>
 
 #include <algorithm>
+#include <atomic>
 #include <functional>
+#include <future>
 #include <numeric>
+#include <sstream>
 
 bool g_skip_intermediate_count{true};
 bool g_enable_interop{false};
 bool g_enable_union{false};
 size_t g_estimator_failure_max_groupby_size{256000000};
+bool g_enable_partitioned_group_by{true};
+size_t g_max_group_by_partitions{64};
+size_t g_query_cpu_memory_budget{0};
+size_t g_cpu_small_step_max_rows{0};
+bool g_enable_cpu_gpu_projection{false};
+bool g_enable_qual_specialization{true};
+bool g_enable_null_check_elision{true};
+size_t g_max_parallel_union_branches{0};
+bool g_enable_clustered_join_windows{false};
+size_t g_clustered_join_window_rows{64000000};
+bool g_enable_approx_top_k_group_by{false};
+size_t g_approx_top_k_sketch_factor{16};
 
 extern bool g_enable_bump_allocator;
 extern size_t g_default_max_groups_buffer_entry_guess;
 
 namespace {
 
+// Steps which completed as a partitioned group by, and steps retried after running out
+// of memory, since startup.
+std::atomic<size_t> partitioned_group_by_count{0};
+std::atomic<size_t> out_of_memory_retry_count{0};
+
 bool node_is_aggregate(const RelAlgNode* ra) {
   const auto compound = dynamic_cast<const RelCompound*>(ra);
   const auto aggregate = dynamic_cast<const RelAggregate*>(ra);
@@ -155,6 +179,104 @@ void prepare_foreign_table_for_execution(const RelAlgNode& ra_node,
   prepare_string_dictionaries(ra_node, catalog);
 }
 
+// Appends the nodes of the subtree rooted at `node` to `key`, returns false if the
+// result of the subtree can differ across executions of the same plan.
+bool serialize_recyclable_subtree(const RelAlgNode* node, std::ostringstream& key) {
+  static const std::vector<std::string> non_deterministic_functions{"NOW",
+                                                                    "DATETIME",
+                                                                    "CURRENT_DATE",
+                                                                    "CURRENT_TIME",
+                                                                    "CURRENT_TIMESTAMP",
+                                                                    "CURRENT_USER"};
+  if (dynamic_cast<const RelTableFunction*>(node) ||
+      dynamic_cast<const RelModify*>(node)) {
+    return false;
+  }
+  if (const auto modify_target = dynamic_cast<const ModifyManipulationTarget*>(node)) {
+    if (modify_target->isUpdateViaSelect() || modify_target->isDeleteViaSelect()) {
+      return false;
+    }
+  }
+  const auto node_str = node->toString();
+  for (const auto& function_name : non_deterministic_functions) {
+    if (node_str.find("RexFunctionOperator(" + function_name + ",") !=
+        std::string::npos) {
+      return false;
+    }
+  }
+  key << '(' << node_str;
+  for (size_t i = 0; i < node->inputCount(); ++i) {
+    if (!serialize_recyclable_subtree(node->getInput(i), key)) {
+      return false;
+    }
+  }
+  key << ')';
+  return true;
+}
+
+// Returns the key of the result of the subtree rooted at `node` in the result set
+// recycler, or std::nullopt if it can't be recycled. Loads into the input tables change
+// their row counts and epochs, hence the key.
+std::optional<std::string> get_result_set_recycler_key(
+    const RelAlgNode* node,
+    const Catalog_Namespace::Catalog& catalog) {
+  std::ostringstream key;
+  key << catalog.getDatabaseId();
+  if (!serialize_recyclable_subtree(node, key)) {
+    return std::nullopt;
+  }
+  std::set<int> table_ids;
+  for (const auto& phys_input : get_physical_inputs(node)) {
+    table_ids.insert(phys_input.table_id);
+  }
+  for (const auto table_id : table_ids) {
+    const auto td = catalog.getMetadataForTable(table_id, false);
+    // Foreign tables change without going through the server.
+    if (!td || td->isForeignTable()) {
+      return std::nullopt;
+    }
+    for (const auto physical_td : catalog.getPhysicalTablesDescriptors(td)) {
+      if (!physical_td->fragmenter) {
+        return std::nullopt;
+      }
+      key << ':' << physical_td->tableId << ',' << physical_td->fragmenter->getNumRows();
+      if (physical_td->persistenceLevel == Data_Namespace::MemoryLevel::DISK_LEVEL) {
+        key << ','
+            << catalog.getDataMgr().getTableEpoch(catalog.getDatabaseId(),
+                                                  physical_td->tableId);
+      }
+    }
+  }
+  return key.str();
+}
+
+// Names a step of a query profile by the type and id of its node, e.g. RelCompound#3.
+std::string get_query_step_name(const RelAlgNode* node) {
+  const auto node_str = node->toString();
+  return node_str.substr(0, node_str.find('(')) + "#" + std::to_string(node->getId());
+}
+
+// Returns true if the result of `node` is the cursor input of a later table function
+// step of `seq`. Table functions read their input columns as contiguous buffers, those
+// are taken from a columnar, fully materialized result without a conversion pass.
+bool is_table_function_input(const RaExecutionSequence& seq,
+                             const size_t step_idx,
+                             const RelAlgNode* node) {
+  for (size_t i = step_idx + 1; i < seq.size(); ++i) {
+    const auto table_func =
+        dynamic_cast<const RelTableFunction*>(seq.getDescriptor(i)->getBody());
+    if (!table_func) {
+      continue;
+    }
+    for (size_t j = 0; j < table_func->inputCount(); ++j) {
+      if (table_func->getInput(j) == node) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
 bool is_extracted_dag_valid(ExtractedPlanDag& dag) {
   return !dag.contain_not_supported_rel_node &&
          dag.extracted_dag.compare(EMPTY_QUERY_PLAN) != 0;
@@ -267,8 +389,12 @@ ExecutionResult RelAlgExecutor::executeRelAlgQuery(const CompilationOptions& co,
   INJECT_TIMER(executeRelAlgQuery);
 
   auto run_query = [&](const CompilationOptions& co_in) {
+    query_profile_info_.reset();
     auto execution_result =
         executeRelAlgQueryNoRetry(co_in, eo, just_explain_plan, render_info);
+    if (query_profile_info_) {
+      QueryProfileHistory::instance().add(*query_profile_info_);
+    }
     if (post_execution_callback_) {
       VLOG(1) << "Running post execution callback.";
       (*post_execution_callback_)();
@@ -402,6 +528,26 @@ ExecutionResult RelAlgExecutor::executeRelAlgQueryNoRetry(const CompilationOptio
     }
   }
 
+  // The kernels of the query add to its profile through the executor, which is held by
+  // this query until it completes.
+  std::shared_ptr<QueryProfile> query_profile;
+  if (g_enable_query_profile && !validate_or_explain_query && query_state_) {
+    const auto& session_data = query_state_->getSessionData();
+    query_profile = std::make_shared<QueryProfile>(
+        session_data ? session_data->user_name : "",
+        session_data ? session_data->public_session_id : "",
+        query_state_->getQueryStr(),
+        query_submitted_time);
+  }
+  executor_->setQueryProfile(query_profile);
+  ScopeGuard collect_query_profile = [this, query_profile] {
+    executor_->setQueryProfile(nullptr);
+    if (query_profile) {
+      query_profile_info_ =
+          std::make_shared<const QueryProfileInfo>(query_profile->getInfo());
+    }
+  };
+
   // Notify foreign tables to load prior to caching
   prepare_foreign_table_for_execution(ra, cat_);
 
@@ -476,10 +622,29 @@ ExecutionResult RelAlgExecutor::executeRelAlgQueryNoRetry(const CompilationOptio
     if (subquery_ra->hasContextData()) {
       continue;
     }
+    std::optional<std::string> recycler_key;
+    if (g_result_set_recycler_max_bytes && !eo.just_explain && !eo.just_validate &&
+        !(query_dag_ && query_dag_->getQueryHints().isTableSampled())) {
+      recycler_key = get_result_set_recycler_key(subquery_ra, cat_);
+      if (recycler_key) {
+        if (auto recycled_result = ResultSetRecycler::instance().get(*recycler_key)) {
+          VLOG(1) << "Recycled the result of subquery " << subquery_ra->toString();
+          if (auto query_profile = executor_->getQueryProfile()) {
+            query_profile->addRecycledResult();
+          }
+          subquery->setExecutionResult(
+              std::make_shared<ExecutionResult>(*recycled_result));
+          continue;
+        }
+      }
+    }
     // Execute the subquery and cache the result.
     RelAlgExecutor ra_executor(executor_, cat_, query_state_);
     RaExecutionSequence subquery_seq(subquery_ra);
     auto result = ra_executor.executeRelAlgSeq(subquery_seq, co, eo, nullptr, 0);
+    if (recycler_key) {
+      ResultSetRecycler::instance().put(*recycler_key, result);
+    }
     subquery->setExecutionResult(std::make_shared<ExecutionResult>(result));
   }
   return executeRelAlgSeq(ed_seq, co, eo, render_info, queue_time_ms);
@@ -525,6 +690,42 @@ RelAlgExecutor::getJoinInfo(const RelAlgNode* root_node) {
 
 namespace {
 
+// Returns the number of steps starting at first_step which compute inputs of the UNION
+// ALL executed right after them and don't depend on each other, 0 if there are none.
+size_t get_union_branch_step_count(const RaExecutionSequence& seq,
+                                   const size_t first_step,
+                                   const size_t step_count) {
+  std::vector<const RelAlgNode*> branches;
+  for (size_t i = first_step; i < step_count; ++i) {
+    const auto body = seq.getDescriptor(i)->getBody();
+    if (const auto logical_union = dynamic_cast<const RelLogicalUnion*>(body)) {
+      const bool all_union_inputs =
+          std::all_of(branches.begin(),
+                      branches.end(),
+                      [logical_union](const RelAlgNode* branch) {
+                        return logical_union->hasInput(branch);
+                      });
+      return all_union_inputs ? branches.size() : 0;
+    }
+    for (const auto branch : branches) {
+      if (body->hasInput(branch)) {
+        return 0;
+      }
+    }
+    branches.push_back(body);
+  }
+  return 0;
+}
+
+// Union branches of different queries run on different executors, one query runs on an
+// executor at a time.
+Executor::ExecutorId get_union_branch_executor_id(const Executor::ExecutorId executor_id,
+                                                  const size_t branch_executor_idx) {
+  constexpr Executor::ExecutorId kUnionBranchExecutorIdOffset{1 << 20};
+  CHECK_LT(branch_executor_idx, size_t(1 << 16));
+  return kUnionBranchExecutorIdOffset + (executor_id << 16) + branch_executor_idx;
+}
+
 inline void check_sort_node_source_constraint(const RelSort* sort) {
   CHECK_EQ(size_t(1), sort->inputCount());
   const auto source = sort->getInput(0);
@@ -660,8 +861,21 @@ ExecutionResult RelAlgExecutor::executeRelAlgSeq(const RaExecutionSequence& seq,
   };
 
   const auto exec_desc_count = get_descriptor_count();
+  const bool parallel_union_branches =
+      g_max_parallel_union_branches > 1 && !g_cluster && !g_enable_interop &&
+      !eo.just_explain && !eo.just_validate && !eo.find_push_down_candidates &&
+      eo.executor_type == ::ExecutorType::Native && query_dag_ &&
+      !query_dag_->getQueryHints().isAnyQueryHintDelivered();
   // this join info needs to be maintained throughout an entire query runtime
   for (size_t i = 0; i < exec_desc_count; i++) {
+    if (parallel_union_branches) {
+      const auto branch_count = get_union_branch_step_count(seq, i, exec_desc_count);
+      if (branch_count > 1) {
+        executeUnionBranchSteps(seq, {i, i + branch_count}, co, eo, queue_time_ms);
+        i += branch_count - 1;
+        continue;
+      }
+    }
     VLOG(1) << "Executing query step " << i;
     // only render on the last step
     try {
@@ -696,6 +910,89 @@ ExecutionResult RelAlgExecutor::executeRelAlgSeq(const RaExecutionSequence& seq,
   return seq.getDescriptor(exec_desc_count - 1)->getResult();
 }
 
+void RelAlgExecutor::executeUnionBranchSteps(const RaExecutionSequence& seq,
+                                             const std::pair<size_t, size_t> interval,
+                                             const CompilationOptions& co,
+                                             const ExecutionOptions& eo,
+                                             const int64_t queue_time_ms) {
+  auto timer = DEBUG_TIMER(__func__);
+  const size_t branch_count = interval.second - interval.first;
+  const size_t branch_executor_count =
+      std::min(branch_count, g_max_parallel_union_branches);
+  VLOG(1) << "Executing query steps " << interval.first << " to "
+          << interval.second - 1 << " on " << branch_executor_count << " executors";
+  SystemParameters system_parameters;
+  system_parameters.cuda_block_size = executor_->block_size_x_;
+  system_parameters.cuda_grid_size = executor_->grid_size_x_;
+  system_parameters.max_gpu_slab_size = executor_->max_gpu_slab_size_;
+  // The branches share the caches, the memory owner and the profile of this query, so
+  // their results can be read by the union step like the ones of any previous step.
+  std::vector<Executor*> branch_executors;
+  std::vector<std::unique_ptr<RelAlgExecutor>> branch_ra_executors;
+  ScopeGuard reset_branch_executors = [&branch_executors] {
+    for (auto branch_executor : branch_executors) {
+      branch_executor->row_set_mem_owner_ = nullptr;
+      branch_executor->setQueryProfile(nullptr);
+      branch_executor->clearMetaInfoCache();
+    }
+  };
+  for (size_t i = 0; i < branch_executor_count; ++i) {
+    auto branch_executor =
+        Executor::getExecutor(get_union_branch_executor_id(executor_->getExecutorId(), i),
+                              executor_->debug_dir_,
+                              executor_->debug_file_,
+                              system_parameters)
+            .get();
+    branch_executor->setCatalog(&cat_);
+    branch_executor->row_set_mem_owner_ = executor_->row_set_mem_owner_;
+    branch_executor->agg_col_range_cache_ = executor_->agg_col_range_cache_;
+    branch_executor->table_generations_ = executor_->table_generations_;
+    branch_executor->setQueryProfile(executor_->query_profile_);
+    branch_executors.push_back(branch_executor);
+    auto branch_ra_executor =
+        std::make_unique<RelAlgExecutor>(branch_executor, cat_, query_state_);
+    branch_ra_executor->temporary_tables_.insert(temporary_tables_.begin(),
+                                                 temporary_tables_.end());
+    branch_ra_executors.push_back(std::move(branch_ra_executor));
+  }
+
+  std::atomic<size_t> next_step{interval.first};
+  std::vector<std::future<void>> branch_futures;
+  for (auto& branch_ra_executor : branch_ra_executors) {
+    branch_futures.push_back(std::async(
+        std::launch::async,
+        [&seq, &co, &eo, &next_step, &interval, queue_time_ms, &branch_ra_executor] {
+          for (size_t step_idx = next_step++; step_idx < interval.second;
+               step_idx = next_step++) {
+            VLOG(1) << "Executing query step " << step_idx;
+            branch_ra_executor->executeRelAlgSubSeq(
+                seq, {step_idx, step_idx + 1}, co, eo, nullptr, queue_time_ms);
+          }
+        }));
+  }
+  std::exception_ptr branch_error;
+  for (auto& branch_future : branch_futures) {
+    try {
+      branch_future.get();
+    } catch (...) {
+      if (!branch_error) {
+        branch_error = std::current_exception();
+      }
+    }
+  }
+  if (branch_error) {
+    std::rethrow_exception(branch_error);
+  }
+
+  for (auto& branch_ra_executor : branch_ra_executors) {
+    temporary_tables_.insert(branch_ra_executor->temporary_tables_.begin(),
+                             branch_ra_executor->temporary_tables_.end());
+    target_exprs_owned_.insert(target_exprs_owned_.end(),
+                               branch_ra_executor->target_exprs_owned_.begin(),
+                               branch_ra_executor->target_exprs_owned_.end());
+  }
+}
+
 ExecutionResult RelAlgExecutor::executeRelAlgSubSeq(
     const RaExecutionSequence& seq,
     const std::pair<size_t, size_t> interval,
@@ -738,8 +1035,16 @@ void RelAlgExecutor::executeRelAlgStep(const RaExecutionSequence& seq,
     handleNop(exec_desc);
     return;
   }
+  // The columns of a columnar projection without lazily fetched targets are handed to a
+  // table function as they are (or with one copy per fragment), instead of converting
+  // the result row by row.
+  auto co_step = co;
+  const bool table_function_input = is_table_function_input(seq, step_idx, body);
+  if (table_function_input) {
+    co_step.allow_lazy_fetch = false;
+  }
   const ExecutionOptions eo_work_unit{
-      eo.output_columnar_hint,
+      eo.output_columnar_hint || table_function_input,
       eo.allow_multifrag,
       eo.just_explain,
       eo.allow_loop_joins,
@@ -757,6 +1062,44 @@ void RelAlgExecutor::executeRelAlgStep(const RaExecutionSequence& seq,
       eo.executor_type,
       step_idx == 0 ? eo.outer_fragment_indices : std::vector<size_t>()};
 
+  // Intermediate steps may be shared with earlier queries, the result of the last step
+  // is iterated over by the caller.
+  std::optional<std::string> recycler_key;
+  if (g_result_set_recycler_max_bytes && step_idx + 1 < seq.size() && !render_info &&
+      !eo.just_explain && !eo.just_validate && !eo.find_push_down_candidates &&
+      !(query_dag_ && query_dag_->getQueryHints().isTableSampled())) {
+    recycler_key = get_result_set_recycler_key(body, cat_);
+    if (recycler_key) {
+      if (auto recycled_result = ResultSetRecycler::instance().get(*recycler_key)) {
+        VLOG(1) << "Recycled the result of query step " << step_idx;
+        if (auto query_profile = executor_->getQueryProfile()) {
+          query_profile->addRecycledResult();
+        }
+        body->setOutputMetainfo(recycled_result->getTargetsMeta());
+        exec_desc.setResult(*recycled_result);
+        addTemporaryTable(-body->getId(), recycled_result->getDataPtr());
+        return;
+      }
+    }
+  }
+  ScopeGuard recycle_result = [this, &recycler_key, &exec_desc, body] {
+    if (recycler_key && temporary_tables_.count(-body->getId())) {
+      ResultSetRecycler::instance().put(*recycler_key, exec_desc.getResult());
+    }
+  };
+  const auto step_clock_begin = timer_start();
+  ScopeGuard profile_step = [this, &exec_desc, body, step_clock_begin] {
+    auto query_profile = executor_->getQueryProfile();
+    const auto& rows = exec_desc.getResult().getDataPtr();
+    if (query_profile && rows) {
+      query_profile->addStep(
+          get_query_step_name(body),
+          rows->rowCount(),
+          timer_stop<decltype(step_clock_begin), std::chrono::microseconds>(
+              step_clock_begin));
+    }
+  };
+
   // Notify foreign tables to load prior to execution
   prepare_foreign_table_for_execution(*body, cat_);
 
@@ -768,7 +1111,7 @@ void RelAlgExecutor::executeRelAlgStep(const RaExecutionSequence& seq,
       executeUpdate(compound, co, eo_work_unit, queue_time_ms);
     } else {
       exec_desc.setResult(
-          executeCompound(compound, co, eo_work_unit, render_info, queue_time_ms));
+          executeCompound(compound, co_step, eo_work_unit, render_info, queue_time_ms));
       VLOG(3) << "Returned from executeCompound(), addTemporaryTable("
               << static_cast<int>(-compound->getId()) << ", ...)"
               << " exec_desc.getResult().getDataPtr()->rowCount()="
@@ -813,7 +1156,7 @@ void RelAlgExecutor::executeRelAlgStep(const RaExecutionSequence& seq,
         }
       }
       exec_desc.setResult(executeProject(
-          project, co, eo_work_unit, render_info, queue_time_ms, prev_count));
+          project, co_step, eo_work_unit, render_info, queue_time_ms, prev_count));
       VLOG(3) << "Returned from executeProject(), addTemporaryTable("
               << static_cast<int>(-project->getId()) << ", ...)"
               << " exec_desc.getResult().getDataPtr()->rowCount()="
@@ -828,20 +1171,21 @@ void RelAlgExecutor::executeRelAlgStep(const RaExecutionSequence& seq,
   const auto aggregate = dynamic_cast<const RelAggregate*>(body);
   if (aggregate) {
     exec_desc.setResult(
-        executeAggregate(aggregate, co, eo_work_unit, render_info, queue_time_ms));
+        executeAggregate(aggregate, co_step, eo_work_unit, render_info, queue_time_ms));
     addTemporaryTable(-aggregate->getId(), exec_desc.getResult().getDataPtr());
     return;
   }
   const auto filter = dynamic_cast<const RelFilter*>(body);
   if (filter) {
     exec_desc.setResult(
-        executeFilter(filter, co, eo_work_unit, render_info, queue_time_ms));
+        executeFilter(filter, co_step, eo_work_unit, render_info, queue_time_ms));
     addTemporaryTable(-filter->getId(), exec_desc.getResult().getDataPtr());
     return;
   }
   const auto sort = dynamic_cast<const RelSort*>(body);
   if (sort) {
-    exec_desc.setResult(executeSort(sort, co, eo_work_unit, render_info, queue_time_ms));
+    exec_desc.setResult(
+        executeSort(sort, co_step, eo_work_unit, render_info, queue_time_ms));
     if (exec_desc.getResult().isFilterPushDownEnabled()) {
       return;
     }
@@ -861,8 +1205,8 @@ void RelAlgExecutor::executeRelAlgStep(const RaExecutionSequence& seq,
   }
   const auto logical_union = dynamic_cast<const RelLogicalUnion*>(body);
   if (logical_union) {
-    exec_desc.setResult(
-        executeUnion(logical_union, seq, co, eo_work_unit, render_info, queue_time_ms));
+    exec_desc.setResult(executeUnion(
+        logical_union, seq, co_step, eo_work_unit, render_info, queue_time_ms));
     addTemporaryTable(-logical_union->getId(), exec_desc.getResult().getDataPtr());
     return;
   }
@@ -1583,6 +1927,11 @@ void RelAlgExecutor::executeUpdate(const RelAlgNode* node,
               dml_transaction_parameters_.get());
           CHECK(update_transaction_parameters);
           auto update_callback = yieldUpdateCallback(*update_transaction_parameters);
+          // Varlen updates append to the fragments and temporary table updates write
+          // the fragment metadata directly, both update one fragment at a time.
+          const bool concurrent_fragment_updates =
+              !update_transaction_parameters->isVarlenUpdateRequired() &&
+              !update_transaction_parameters->tableIsTemporary();
           try {
             auto table_update_metadata =
                 executor_->executeUpdate(ra_exe_unit,
@@ -1593,7 +1942,8 @@ void RelAlgExecutor::executeUpdate(const RelAlgNode* node,
                                          cat_,
                                          executor_->row_set_mem_owner_,
                                          update_callback,
-                                         is_aggregate);
+                                         is_aggregate,
+                                         concurrent_fragment_updates);
             post_execution_callback_ = [table_update_metadata, this]() {
               dml_transaction_parameters_->finalizeTransaction(cat_);
               TableOptimizer table_optimizer{
@@ -1716,7 +2066,8 @@ void RelAlgExecutor::executeDelete(const RelAlgNode* node,
                                          cat_,
                                          executor_->row_set_mem_owner_,
                                          delete_callback,
-                                         is_aggregate);
+                                         is_aggregate,
+                                         !delete_params->tableIsTemporary());
             post_execution_callback_ = [table_update_metadata, this]() {
               dml_transaction_parameters_->finalizeTransaction(cat_);
               TableOptimizer table_optimizer{
@@ -1811,6 +2162,416 @@ bool is_window_execution_unit(const RelAlgExecutionUnit& ra_exe_unit) {
                      });
 }
 
+// The t-digests of APPROX_QUANTILE only exist on CPU.
+bool has_approx_quantile_target(const RelAlgExecutionUnit& ra_exe_unit) {
+  return std::any_of(ra_exe_unit.target_exprs.begin(),
+                     ra_exe_unit.target_exprs.end(),
+                     [](const Analyzer::Expr* expr) {
+                       const auto agg_expr = dynamic_cast<const Analyzer::AggExpr*>(expr);
+                       return agg_expr && agg_expr->get_aggtype() == kAPPROX_QUANTILE;
+                     });
+}
+
+// Whether the input chunks of the step in the fragment of `table_id` are all in the GPU
+// buffer pool of the device the fragment is assigned to.
+bool is_fragment_resident_on_gpu(const RelAlgExecutionUnit& ra_exe_unit,
+                                 const int table_id,
+                                 const Fragmenter_Namespace::FragmentInfo& fragment,
+                                 const Catalog_Namespace::Catalog& cat) {
+  auto& data_mgr = cat.getDataMgr();
+  const auto device_id = fragment.deviceIds[static_cast<int>(Data_Namespace::GPU_LEVEL)];
+  for (const auto& col_desc : ra_exe_unit.input_col_descs) {
+    if (col_desc->getScanDesc().getTableId() != table_id) {
+      continue;
+    }
+    const auto cd = cat.getMetadataForColumn(table_id, col_desc->getColId());
+    if (!cd) {
+      continue;
+    }
+    ChunkKey chunk_key{cat.getDatabaseId(), table_id, cd->columnId, fragment.fragmentId};
+    if (cd->columnType.is_varlen_indeed()) {
+      chunk_key.push_back(1);
+    }
+    if (!data_mgr.isBufferOnDevice(chunk_key, Data_Namespace::GPU_LEVEL, device_id)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Whether a GPU step is cheaper on CPU: it scans at most g_cpu_small_step_max_rows rows
+// and some of its input chunks would first have to be copied to the GPU, which costs
+// small steps more than running their kernels on CPU.
+bool is_small_step_not_resident_on_gpu(const RelAlgExecutionUnit& ra_exe_unit,
+                                       const std::vector<InputTableInfo>& table_infos,
+                                       const Catalog_Namespace::Catalog& cat) {
+  if (!g_cpu_small_step_max_rows) {
+    return false;
+  }
+  size_t row_count{0};
+  for (const auto& table_info : table_infos) {
+    row_count += table_info.info.getNumTuplesUpperBound();
+  }
+  if (row_count > g_cpu_small_step_max_rows) {
+    return false;
+  }
+  for (const auto& table_info : table_infos) {
+    if (table_info.table_id < 0) {
+      // The results of previous steps are in CPU memory.
+      return true;
+    }
+    for (const auto& fragment : table_info.info.fragments) {
+      if (!is_fragment_resident_on_gpu(ra_exe_unit, table_info.table_id, fragment, cat)) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+// The columns of the outer and the inner table compared by the equi-join of a step
+// which only inner joins two tables on integer, decimal or time columns of the same
+// type, std::nullopt for other steps.
+std::optional<std::pair<const Analyzer::ColumnVar*, const Analyzer::ColumnVar*>>
+get_clustered_join_key(const RelAlgExecutionUnit& ra_exe_unit) {
+  if (ra_exe_unit.input_descs.size() != 2 || ra_exe_unit.join_quals.size() != 1) {
+    return std::nullopt;
+  }
+  for (const auto& input_desc : ra_exe_unit.input_descs) {
+    if (input_desc.getSourceType() != InputSourceType::TABLE ||
+        input_desc.getTableId() < 0) {
+      return std::nullopt;
+    }
+  }
+  const auto& join_condition = ra_exe_unit.join_quals.front();
+  if (join_condition.type != JoinType::INNER || join_condition.quals.size() != 1) {
+    return std::nullopt;
+  }
+  const auto bin_oper =
+      dynamic_cast<const Analyzer::BinOper*>(join_condition.quals.front().get());
+  if (!bin_oper || bin_oper->get_optype() != kEQ) {
+    return std::nullopt;
+  }
+  auto outer_col = dynamic_cast<const Analyzer::ColumnVar*>(bin_oper->get_left_operand());
+  auto inner_col =
+      dynamic_cast<const Analyzer::ColumnVar*>(bin_oper->get_right_operand());
+  if (!outer_col || !inner_col) {
+    return std::nullopt;
+  }
+  if (outer_col->get_rte_idx() == 1) {
+    std::swap(outer_col, inner_col);
+  }
+  if (outer_col->get_rte_idx() != 0 || inner_col->get_rte_idx() != 1) {
+    return std::nullopt;
+  }
+  const auto& outer_ti = outer_col->get_type_info();
+  const auto& inner_ti = inner_col->get_type_info();
+  if (!(outer_ti.is_integer() || outer_ti.is_decimal() || outer_ti.is_time()) ||
+      outer_ti.get_type() != inner_ti.get_type() ||
+      outer_ti.get_dimension() != inner_ti.get_dimension() ||
+      outer_ti.get_scale() != inner_ti.get_scale()) {
+    return std::nullopt;
+  }
+  return std::make_pair(outer_col, inner_col);
+}
+
+// The range of the non-null values of the column in the fragment according to its chunk
+// metadata, std::nullopt if the fragment has no valid metadata for the column.
+std::optional<std::pair<int64_t, int64_t>> get_fragment_key_range(
+    const Fragmenter_Namespace::FragmentInfo& fragment,
+    const Analyzer::ColumnVar* col_var) {
+  const auto& chunk_metadata_map = fragment.getChunkMetadataMap();
+  const auto it = chunk_metadata_map.find(col_var->get_column_id());
+  if (it == chunk_metadata_map.end()) {
+    return std::nullopt;
+  }
+  const auto& ti = col_var->get_type_info();
+  const auto min = extract_min_stat(it->second->chunkStats, ti);
+  const auto max = extract_max_stat(it->second->chunkStats, ti);
+  if (min > max) {
+    return std::nullopt;
+  }
+  return std::make_pair(min, max);
+}
+
+// Restricts the step to a sample of its outer table for the tablesample hints: by a hash
+// of their ids, the given percentage of the outer fragments for tablesample_system and
+// of the rows in them for tablesample_bernoulli. Returns the inverse of the fraction of
+// the rows sampled, the factor which scales the COUNT and SUM targets over the sample
+// to estimates of them over the whole table.
+double apply_table_sample(RelAlgExecutionUnit& ra_exe_unit,
+                          const std::vector<InputTableInfo>& table_infos,
+                          ExecutionOptions& eo) {
+  const auto& query_hint = ra_exe_unit.query_hint;
+  if (!query_hint.isTableSampled() || ra_exe_unit.union_all ||
+      ra_exe_unit.input_descs.empty() ||
+      ra_exe_unit.input_descs.front().getSourceType() != InputSourceType::TABLE ||
+      ra_exe_unit.input_descs.front().getTableId() < 0) {
+    return 1.0;
+  }
+  CHECK(!table_infos.empty());
+  double scale_factor{1.0};
+  if (query_hint.isHintRegistered(QueryHint::kTableSampleSystem) &&
+      query_hint.tablesample_system_percent < 100.0) {
+    const auto& outer_table_info = table_infos.front();
+    const auto& fragments = outer_table_info.info.fragments;
+    auto fragment_indices = eo.outer_fragment_indices;
+    if (fragment_indices.empty()) {
+      fragment_indices.resize(fragments.size());
+      std::iota(fragment_indices.begin(), fragment_indices.end(), 0);
+    }
+    // Ranking the fragments by a hash samples the same ones from one run of the query to
+    // the next, without favoring the oldest or the newest rows of the table.
+    std::vector<std::pair<size_t, size_t>> ranked_fragments;
+    size_t total_rows{0};
+    for (const auto frag_idx : fragment_indices) {
+      CHECK_LT(frag_idx, fragments.size());
+      const auto num_tuples = fragments[frag_idx].getNumTuples();
+      if (!num_tuples) {
+        continue;
+      }
+      total_rows += num_tuples;
+      size_t hash = outer_table_info.table_id;
+      boost::hash_combine(hash, fragments[frag_idx].fragmentId);
+      ranked_fragments.emplace_back(hash, frag_idx);
+    }
+    if (!ranked_fragments.empty()) {
+      std::sort(ranked_fragments.begin(), ranked_fragments.end());
+      const auto sample_fragment_count = std::max(
+          size_t(1),
+          static_cast<size_t>(std::llround(ranked_fragments.size() *
+                                           query_hint.tablesample_system_percent / 100)));
+      ranked_fragments.resize(std::min(sample_fragment_count, ranked_fragments.size()));
+      eo.outer_fragment_indices.clear();
+      size_t sample_rows{0};
+      for (const auto& ranked_fragment : ranked_fragments) {
+        eo.outer_fragment_indices.push_back(ranked_fragment.second);
+        sample_rows += fragments[ranked_fragment.second].getNumTuples();
+      }
+      std::sort(eo.outer_fragment_indices.begin(), eo.outer_fragment_indices.end());
+      CHECK_GT(sample_rows, size_t(0));
+      scale_factor = static_cast<double>(total_rows) / sample_rows;
+      VLOG(1) << "Sampling " << eo.outer_fragment_indices.size() << " of "
+              << fragment_indices.size() << " outer fragments, " << sample_rows
+              << " of " << total_rows << " rows.";
+    }
+  }
+  if (query_hint.isHintRegistered(QueryHint::kTableSampleBernoulli) &&
+      query_hint.tablesample_bernoulli_percent < 100.0) {
+    Datum proportion;
+    proportion.doubleval = query_hint.tablesample_bernoulli_percent / 100;
+    ra_exe_unit.quals.push_back(makeExpr<Analyzer::SampleRatioExpr>(
+        makeExpr<Analyzer::Constant>(kDOUBLE, false, proportion)));
+    scale_factor /= proportion.doubleval;
+  }
+  return scale_factor;
+}
+
+// Whether the results of the same projection on CPU and on GPU have the same layout, so
+// that the storage of one can be appended to the other.
+bool have_same_projection_layout(const ResultSet& lhs, const ResultSet& rhs) {
+  const auto& lhs_desc = lhs.getQueryMemDesc();
+  const auto& rhs_desc = rhs.getQueryMemDesc();
+  if (lhs_desc.getQueryDescriptionType() != QueryDescriptionType::Projection ||
+      rhs_desc.getQueryDescriptionType() != QueryDescriptionType::Projection ||
+      lhs_desc.didOutputColumnar() != rhs_desc.didOutputColumnar() ||
+      lhs_desc.getSlotCount() != rhs_desc.getSlotCount() ||
+      lhs.isSeparateVarlenStorageValid() != rhs.isSeparateVarlenStorageValid()) {
+    return false;
+  }
+  for (size_t slot_idx = 0; slot_idx < lhs_desc.getSlotCount(); ++slot_idx) {
+    if (lhs_desc.getPaddedSlotWidthBytes(slot_idx) !=
+        rhs_desc.getPaddedSlotWidthBytes(slot_idx)) {
+      return false;
+    }
+  }
+  const auto& lhs_lazy_fetch_info = lhs.getLazyFetchInfo();
+  const auto& rhs_lazy_fetch_info = rhs.getLazyFetchInfo();
+  if (lhs_lazy_fetch_info.size() != rhs_lazy_fetch_info.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < lhs_lazy_fetch_info.size(); ++i) {
+    if (lhs_lazy_fetch_info[i].is_lazily_fetched !=
+            rhs_lazy_fetch_info[i].is_lazily_fetched ||
+        lhs_lazy_fetch_info[i].local_col_id != rhs_lazy_fetch_info[i].local_col_id) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Whether every non-empty fragment of the outer table has chunk metadata for the column
+// which shows no nulls.
+bool has_no_nulls(const int col_id, const InputTableInfo& table_info) {
+  for (const auto& fragment : table_info.info.fragments) {
+    if (fragment.isEmptyPhysicalFragment()) {
+      continue;
+    }
+    const auto& chunk_metadata_map = fragment.getChunkMetadataMap();
+    const auto it = chunk_metadata_map.find(col_id);
+    if (it == chunk_metadata_map.end() || it->second->chunkStats.has_nulls) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Copies expressions, with the columns of the outer table which have no nulls in any of
+// its fragments marked as not null, so that their null checks aren't generated.
+class NotNullColumnMarker : public DeepCopyVisitor {
+ public:
+  NotNullColumnMarker(const InputTableInfo& outer_table_info)
+      : outer_table_info_(outer_table_info) {}
+
+ protected:
+  RetType visitColumnVar(const Analyzer::ColumnVar* col_var) const override {
+    auto col_var_copy = col_var->deep_copy();
+    const auto& ti = col_var->get_type_info();
+    if (col_var->get_rte_idx() || col_var->get_table_id() != outer_table_info_.table_id ||
+        ti.get_notnull() || ti.is_varlen()) {
+      return col_var_copy;
+    }
+    const auto col_id = col_var->get_column_id();
+    auto it = has_no_nulls_.find(col_id);
+    if (it == has_no_nulls_.end()) {
+      it = has_no_nulls_.emplace(col_id, has_no_nulls(col_id, outer_table_info_)).first;
+    }
+    if (it->second) {
+      auto notnull_ti = ti;
+      notnull_ti.set_notnull(true);
+      col_var_copy->set_type_info(notnull_ti);
+    }
+    return col_var_copy;
+  }
+
+ private:
+  const InputTableInfo& outer_table_info_;
+  mutable std::unordered_map<int, bool> has_no_nulls_;
+};
+
+std::optional<int64_t> get_int_constant(const Analyzer::Constant* constant) {
+  if (constant->get_is_null()) {
+    return std::nullopt;
+  }
+  const auto& datum = constant->get_constval();
+  switch (constant->get_type_info().get_type()) {
+    case kTINYINT:
+      return datum.tinyintval;
+    case kSMALLINT:
+      return datum.smallintval;
+    case kINT:
+      return datum.intval;
+    case kBIGINT:
+      return datum.bigintval;
+    default:
+      return std::nullopt;
+  }
+}
+
+// Whether every row of the outer table passes the simple qual, from the range of its
+// column over all fragments.
+bool is_qual_always_true(const Analyzer::Expr* simple_qual,
+                         const InputTableInfo& outer_table_info,
+                         const std::vector<InputTableInfo>& table_infos,
+                         const Executor* executor) {
+  const auto comp_expr = dynamic_cast<const Analyzer::BinOper*>(simple_qual);
+  if (!comp_expr) {
+    return false;
+  }
+  const auto lhs_col =
+      dynamic_cast<const Analyzer::ColumnVar*>(comp_expr->get_left_operand());
+  const auto rhs_const =
+      dynamic_cast<const Analyzer::Constant*>(comp_expr->get_right_operand());
+  if (!lhs_col || !rhs_const || lhs_col->get_rte_idx() ||
+      lhs_col->get_table_id() != outer_table_info.table_id ||
+      !lhs_col->get_type_info().is_integer() ||
+      lhs_col->get_type_info().get_type() != rhs_const->get_type_info().get_type()) {
+    return false;
+  }
+  const auto rhs_val = get_int_constant(rhs_const);
+  if (!rhs_val || !has_no_nulls(lhs_col->get_column_id(), outer_table_info)) {
+    return false;
+  }
+  const auto col_range = getLeafColumnRange(lhs_col, table_infos, executor, false);
+  if (col_range.getType() != ExpressionRangeType::Integer ||
+      col_range.getIntMin() > col_range.getIntMax()) {
+    return false;
+  }
+  switch (comp_expr->get_optype()) {
+    case kGE:
+      return col_range.getIntMin() >= *rhs_val;
+    case kGT:
+      return col_range.getIntMin() > *rhs_val;
+    case kLE:
+      return col_range.getIntMax() <= *rhs_val;
+    case kLT:
+      return col_range.getIntMax() < *rhs_val;
+    case kEQ:
+      return col_range.getIntMin() == *rhs_val && col_range.getIntMax() == *rhs_val;
+    default:
+      return false;
+  }
+}
+
+// Specializes the work unit on the chunk metadata of the outer table: drops the simple
+// quals which all of its rows pass and drops the null checks of its columns without nulls
+// from the quals and the targets. The generated code differs, so the code cache keeps
+// both variants.
+RelAlgExecutionUnit specialize_on_chunk_metadata(
+    const RelAlgExecutionUnit& ra_exe_unit,
+    const std::vector<InputTableInfo>& table_infos,
+    const Executor* executor,
+    const Catalog_Namespace::Catalog& cat,
+    std::vector<std::shared_ptr<Analyzer::Expr>>& target_exprs_owned) {
+  if ((!g_enable_qual_specialization && !g_enable_null_check_elision) ||
+      ra_exe_unit.union_all || ra_exe_unit.input_descs.empty() ||
+      ra_exe_unit.input_descs.front().getSourceType() != InputSourceType::TABLE ||
+      is_window_execution_unit(ra_exe_unit)) {
+    return ra_exe_unit;
+  }
+  const auto outer_table_id = ra_exe_unit.input_descs.front().getTableId();
+  const auto td = cat.getMetadataForTable(outer_table_id, false);
+  if (outer_table_id <= 0 || !td || td->isForeignTable()) {
+    return ra_exe_unit;
+  }
+  const auto outer_table_info_it =
+      std::find_if(table_infos.begin(), table_infos.end(), [outer_table_id](auto& info) {
+        return info.table_id == outer_table_id;
+      });
+  CHECK(outer_table_info_it != table_infos.end());
+  const auto& outer_table_info = *outer_table_info_it;
+
+  auto specialized_exe_unit = ra_exe_unit;
+  NotNullColumnMarker not_null_column_marker(outer_table_info);
+  const auto mark_not_null_columns = [&not_null_column_marker](const auto& expr) {
+    return g_enable_null_check_elision ? not_null_column_marker.visit(expr.get()) : expr;
+  };
+  specialized_exe_unit.simple_quals.clear();
+  for (const auto& simple_qual : ra_exe_unit.simple_quals) {
+    if (g_enable_qual_specialization &&
+        is_qual_always_true(simple_qual.get(), outer_table_info, table_infos, executor)) {
+      VLOG(1) << "Dropping qual " << simple_qual->toString()
+              << " which all rows of table " << outer_table_id << " pass.";
+      continue;
+    }
+    specialized_exe_unit.simple_quals.push_back(mark_not_null_columns(simple_qual));
+  }
+  specialized_exe_unit.quals.clear();
+  for (const auto& qual : ra_exe_unit.quals) {
+    specialized_exe_unit.quals.push_back(mark_not_null_columns(qual));
+  }
+  if (g_enable_null_check_elision) {
+    for (auto& target_expr : specialized_exe_unit.target_exprs) {
+      if (!target_expr) {
+        continue;
+      }
+      target_exprs_owned.push_back(not_null_column_marker.visit(target_expr));
+      target_expr = target_exprs_owned.back().get();
+    }
+  }
+  return specialized_exe_unit;
+}
+
 }  // namespace
 
 ExecutionResult RelAlgExecutor::executeProject(
@@ -1915,6 +2676,25 @@ std::shared_ptr<Analyzer::Expr> transform_to_inner(const Analyzer::Expr* expr) {
       col->get_type_info(), col->get_table_id(), col->get_column_id(), 1);
 }
 
+// Window functions with the same partition and order keys partition and sort the rows
+// the same way.
+bool window_functions_share_partitions(const Analyzer::WindowFunction* lhs,
+                                       const Analyzer::WindowFunction* rhs) {
+  const auto& lhs_collation = lhs->getCollation();
+  const auto& rhs_collation = rhs->getCollation();
+  if (lhs_collation.size() != rhs_collation.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < lhs_collation.size(); ++i) {
+    if (lhs_collation[i].is_desc != rhs_collation[i].is_desc ||
+        lhs_collation[i].nulls_first != rhs_collation[i].nulls_first) {
+      return false;
+    }
+  }
+  return expr_list_match(lhs->getPartitionKeys(), rhs->getPartitionKeys()) &&
+         expr_list_match(lhs->getOrderKeys(), rhs->getOrderKeys());
+}
+
 }  // namespace
 
 void RelAlgExecutor::computeWindow(const RelAlgExecutionUnit& ra_exe_unit,
@@ -1933,13 +2713,31 @@ void RelAlgExecutor::computeWindow(const RelAlgExecutionUnit& ra_exe_unit,
   }
   query_infos.push_back(query_infos.front());
   auto window_project_node_context = WindowProjectNodeContext::create(executor_);
+  std::vector<const Analyzer::WindowFunction*> window_funcs;
+  for (const auto target_expr : ra_exe_unit.target_exprs) {
+    window_funcs.push_back(dynamic_cast<const Analyzer::WindowFunction*>(target_expr));
+  }
+  // The partitions and their sorted order, computed by the first window function with
+  // the given partition and order keys for the ones after it.
+  struct SharedPartitions {
+    const Analyzer::WindowFunction* window_func;
+    std::shared_ptr<HashJoin> partitions;
+    std::shared_ptr<std::vector<int64_t>> sorted_partition_buf;
+  };
+  std::vector<SharedPartitions> shared_partitions;
   for (size_t target_index = 0; target_index < ra_exe_unit.target_exprs.size();
        ++target_index) {
-    const auto& target_expr = ra_exe_unit.target_exprs[target_index];
-    const auto window_func = dynamic_cast<const Analyzer::WindowFunction*>(target_expr);
+    const auto window_func = window_funcs[target_index];
     if (!window_func) {
       continue;
     }
+    auto shared_partitions_it =
+        std::find_if(shared_partitions.begin(),
+                     shared_partitions.end(),
+                     [window_func](const SharedPartitions& shared) {
+                       return window_functions_share_partitions(shared.window_func,
+                                                                window_func);
+                     });
     // Always use baseline layout hash tables for now, make the expression a tuple.
     const auto& partition_keys = window_func->getPartitionKeys();
     std::shared_ptr<Analyzer::Expr> partition_key_tuple;
@@ -1960,13 +2758,29 @@ void RelAlgExecutor::computeWindow(const RelAlgExecutionUnit& ra_exe_unit,
                                     kONE,
                                     partition_key_tuple,
                                     transform_to_inner(partition_key_tuple.get()));
-    auto context = createWindowFunctionContext(window_func,
-                                               partition_key_cond,
-                                               ra_exe_unit,
-                                               query_infos,
-                                               co,
-                                               column_cache_map,
-                                               executor_->getRowSetMemoryOwner());
+    auto context = createWindowFunctionContext(
+        window_func,
+        partition_key_cond,
+        shared_partitions_it != shared_partitions.end() ? shared_partitions_it->partitions
+                                                        : nullptr,
+        ra_exe_unit,
+        query_infos,
+        co,
+        column_cache_map,
+        executor_->getRowSetMemoryOwner());
+    if (shared_partitions_it != shared_partitions.end()) {
+      context->setSortedPartitionBuffer(shared_partitions_it->sorted_partition_buf);
+    } else if (std::any_of(window_funcs.begin() + target_index + 1,
+                           window_funcs.end(),
+                           [window_func](const Analyzer::WindowFunction* later) {
+                             return later &&
+                                    window_functions_share_partitions(window_func, later);
+                           })) {
+      shared_partitions.push_back({window_func,
+                                   context->getPartitions(),
+                                   std::make_shared<std::vector<int64_t>>()});
+      context->setSortedPartitionBuffer(shared_partitions.back().sorted_partition_buf);
+    }
     context->compute();
     window_project_node_context->addWindowFunctionContext(std::move(context),
                                                           target_index);
@@ -1976,6 +2790,7 @@ void RelAlgExecutor::computeWindow(const RelAlgExecutionUnit& ra_exe_unit,
 std::unique_ptr<WindowFunctionContext> RelAlgExecutor::createWindowFunctionContext(
     const Analyzer::WindowFunction* window_func,
     const std::shared_ptr<Analyzer::BinOper>& partition_key_cond,
+    std::shared_ptr<HashJoin> partitions,
     const RelAlgExecutionUnit& ra_exe_unit,
     const std::vector<InputTableInfo>& query_infos,
     const CompilationOptions& co,
@@ -1984,23 +2799,26 @@ std::unique_ptr<WindowFunctionContext> RelAlgExecutor::createWindowFunctionConte
   const auto memory_level = co.device_type == ExecutorDeviceType::GPU
                                 ? MemoryLevel::GPU_LEVEL
                                 : MemoryLevel::CPU_LEVEL;
-  const auto join_table_or_err =
-      executor_->buildHashTableForQualifier(partition_key_cond,
-                                            query_infos,
-                                            memory_level,
-                                            JoinType::INVALID,  // for window function
-                                            HashType::OneToMany,
-                                            column_cache_map,
-                                            ra_exe_unit.query_hint);
-  if (!join_table_or_err.fail_reason.empty()) {
-    throw std::runtime_error(join_table_or_err.fail_reason);
-  }
-  CHECK(join_table_or_err.hash_table->getHashType() == HashType::OneToMany);
+  if (!partitions) {
+    const auto join_table_or_err =
+        executor_->buildHashTableForQualifier(partition_key_cond,
+                                              query_infos,
+                                              memory_level,
+                                              JoinType::INVALID,  // for window function
+                                              HashType::OneToMany,
+                                              column_cache_map,
+                                              ra_exe_unit.query_hint);
+    if (!join_table_or_err.fail_reason.empty()) {
+      throw std::runtime_error(join_table_or_err.fail_reason);
+    }
+    partitions = join_table_or_err.hash_table;
+  }
+  CHECK(partitions->getHashType() == HashType::OneToMany);
   const auto& order_keys = window_func->getOrderKeys();
   std::vector<std::shared_ptr<Chunk_NS::Chunk>> chunks_owner;
   const size_t elem_count = query_infos.front().info.fragments.front().getNumTuples();
   auto context = std::make_unique<WindowFunctionContext>(window_func,
-                                                         join_table_or_err.hash_table,
+                                                         partitions,
                                                          elem_count,
                                                          co.device_type,
                                                          row_set_mem_owner);
@@ -2025,6 +2843,43 @@ std::unique_ptr<WindowFunctionContext> RelAlgExecutor::createWindowFunctionConte
     CHECK_EQ(join_col_elem_count, elem_count);
     context->addOrderColumn(column, order_col.get(), chunks_owner);
   }
+  const auto& args = window_func->getArgs();
+  if (window_func->getFrame() && !args.empty()) {
+    const auto arg_col =
+        std::dynamic_pointer_cast<const Analyzer::ColumnVar>(args.front());
+    if (!arg_col) {
+      throw std::runtime_error("Only aggregates of columns supported for window frames");
+    }
+    const auto& arg_ti = arg_col->get_type_info();
+    const bool is_numeric = arg_ti.is_integer() || arg_ti.is_decimal() || arg_ti.is_fp();
+    const bool is_time =
+        arg_ti.is_time() && arg_ti.get_compression() != kENCODING_DATE_IN_DAYS;
+    const auto kind = window_func->getKind();
+    const bool is_supported_arg =
+        kind == SqlWindowFunctionKind::COUNT
+            ? is_numeric || is_time || arg_ti.is_boolean() ||
+                  (arg_ti.is_string() && arg_ti.get_compression() == kENCODING_DICT)
+            : is_numeric || (is_time && (kind == SqlWindowFunctionKind::MIN ||
+                                         kind == SqlWindowFunctionKind::MAX));
+    if (!is_supported_arg) {
+      throw std::runtime_error("Type " + arg_ti.get_type_name() +
+                               " not supported yet for window frames");
+    }
+    const int8_t* column;
+    size_t join_col_elem_count;
+    std::tie(column, join_col_elem_count) =
+        ColumnFetcher::getOneColumnFragment(executor_,
+                                            *arg_col,
+                                            query_infos.front().info.fragments.front(),
+                                            memory_level,
+                                            0,
+                                            nullptr,
+                                            /*thread_idx=*/0,
+                                            chunks_owner,
+                                            column_cache_map);
+    CHECK_EQ(join_col_elem_count, elem_count);
+    context->addFramedAggregateColumn(column, chunks_owner);
+  }
   return context;
 }
 
@@ -2915,7 +3770,7 @@ ExecutionResult RelAlgExecutor::executeWorkUnit(
     const std::vector<TargetMetaInfo>& targets_meta,
     const bool is_agg,
     const CompilationOptions& co_in,
-    const ExecutionOptions& eo,
+    const ExecutionOptions& eo_in,
     RenderInfo* render_info,
     const int64_t queue_time_ms,
     const std::optional<size_t> previous_count) {
@@ -2923,7 +3778,12 @@ ExecutionResult RelAlgExecutor::executeWorkUnit(
   auto timer = DEBUG_TIMER(__func__);
 
   auto co = co_in;
+  auto eo = eo_in;
   ColumnCacheMap column_cache;
+  // Each step gets the budget anew: the partitioned group by fallback below only helps
+  // if running out of the budget is detected when the buffers are allocated, long before
+  // the host is out of memory.
+  executor_->row_set_mem_owner_->setMemoryBudget(g_query_cpu_memory_budget);
   if (is_window_execution_unit(work_unit.exe_unit)) {
     if (!g_enable_window_functions) {
       throw std::runtime_error("Window functions support is disabled");
@@ -2932,6 +3792,16 @@ ExecutionResult RelAlgExecutor::executeWorkUnit(
     co.allow_lazy_fetch = false;
     computeWindow(work_unit.exe_unit, co, eo, column_cache, queue_time_ms);
   }
+  if (co.device_type == ExecutorDeviceType::GPU && g_allow_cpu_retry &&
+      has_approx_quantile_target(work_unit.exe_unit)) {
+    // Runs only this step on CPU, rather than retrying the whole query on CPU once its
+    // code generation fails.
+    VLOG(1) << "Running the APPROX_QUANTILE step on CPU.";
+    co.device_type = ExecutorDeviceType::CPU;
+    if (render_info) {
+      render_info->setForceNonInSituData();
+    }
+  }
   if (!eo.just_explain && eo.find_push_down_candidates) {
     // find potential candidates:
     auto selected_filters = selectFiltersToBePushedDown(work_unit, co, eo);
@@ -2960,13 +3830,47 @@ ExecutionResult RelAlgExecutor::executeWorkUnit(
     return result;
   }
   const auto table_infos = get_table_infos(work_unit.exe_unit, executor_);
+  if (co.device_type == ExecutorDeviceType::GPU && !render_info &&
+      is_small_step_not_resident_on_gpu(work_unit.exe_unit, table_infos, cat_)) {
+    VLOG(1) << "Running the step on CPU, its inputs are small and not on GPU.";
+    co.device_type = ExecutorDeviceType::CPU;
+  }
 
-  auto ra_exe_unit = decide_approx_count_distinct_implementation(
-      work_unit.exe_unit, table_infos, executor_, co.device_type, target_exprs_owned_);
+  auto ra_exe_unit = specialize_on_chunk_metadata(
+      decide_approx_count_distinct_implementation(work_unit.exe_unit,
+                                                  table_infos,
+                                                  executor_,
+                                                  co.device_type,
+                                                  target_exprs_owned_),
+      table_infos,
+      executor_,
+      cat_,
+      target_exprs_owned_);
 
   // register query hint if query_dag_ is valid
   ra_exe_unit.query_hint =
       query_dag_ ? query_dag_->getQueryHints() : RegisteredQueryHint::defaults();
+  const auto sample_scale_factor = apply_table_sample(ra_exe_unit, table_infos, eo);
+
+  if (is_agg && !render_info) {
+    if (auto top_k_qual = getApproxTopKGroupsQual(ra_exe_unit, table_infos, co, eo)) {
+      ra_exe_unit.quals.push_back(top_k_qual);
+    }
+  }
+  if (!is_agg && !render_info) {
+    auto windowed_result =
+        executeClusteredJoinInWindows(ra_exe_unit,
+                                      table_infos,
+                                      targets_meta,
+                                      work_unit.max_groups_buffer_entry_guess,
+                                      co,
+                                      eo,
+                                      column_cache);
+    if (windowed_result) {
+      windowed_result->setQueueTime(queue_time_ms);
+      return *windowed_result;
+    }
+  }
 
   auto max_groups_buffer_entry_guess = work_unit.max_groups_buffer_entry_guess;
   if (is_window_execution_unit(ra_exe_unit)) {
@@ -2986,7 +3890,8 @@ ExecutionResult RelAlgExecutor::executeWorkUnit(
       } else if (eo.executor_type == ::ExecutorType::Extern) {
         ra_exe_unit.scan_limit = 0;
       } else if (!eo.just_explain) {
-        const auto filter_count_all = getFilteredCountAll(work_unit, true, co, eo);
+        const auto filter_count_all =
+            getFilteredCountAll(work_unit.exe_unit, table_infos, true, co, eo);
         if (filter_count_all) {
           ra_exe_unit.scan_limit = std::max(*filter_count_all, size_t(1));
         }
@@ -3002,6 +3907,8 @@ ExecutionResult RelAlgExecutor::executeWorkUnit(
                                                      executor_->gridSize()),
                          {}};
 
+  // Set when the groups buffer entry guess turned out too small for the query.
+  bool retried_with_larger_buffer{false};
   auto execute_and_handle_errors = [&](const auto max_groups_buffer_entry_guess_in,
                                        const bool has_cardinality_estimation,
                                        const bool has_ndv_estimation) -> ExecutionResult {
@@ -3009,6 +3916,7 @@ ExecutionResult RelAlgExecutor::executeWorkUnit(
     // Create a local copy so we can track those changes if we need to attempt a retry
     // due to OOM
     auto local_groups_buffer_entry_guess = max_groups_buffer_entry_guess_in;
+    retried_with_larger_buffer = false;
     try {
       return {executor_->executeWorkUnit(local_groups_buffer_entry_guess,
                                          is_agg,
@@ -3021,11 +3929,43 @@ ExecutionResult RelAlgExecutor::executeWorkUnit(
                                          has_cardinality_estimation,
                                          column_cache),
               targets_meta};
+    } catch (const QueryMustRunOnCpu&) {
+      if (!is_agg && !render_info) {
+        auto co_executed_result =
+            executeProjectionOnCpuAndGpu(ra_exe_unit,
+                                         table_infos,
+                                         targets_meta,
+                                         local_groups_buffer_entry_guess,
+                                         co,
+                                         eo,
+                                         column_cache);
+        if (co_executed_result) {
+          return *co_executed_result;
+        }
+      }
+      throw;
     } catch (const QueryExecutionError& e) {
       if (!has_ndv_estimation && e.getErrorCode() < 0) {
         throw CardinalityEstimationRequired(/*range=*/0);
       }
-      handlePersistentError(e.getErrorCode());
+      if (e.getErrorCode() == Executor::ERR_OUT_OF_CPU_MEM) {
+        auto partitioned_result = executePartitionedGroupBy(
+            {ra_exe_unit, work_unit.body, local_groups_buffer_entry_guess},
+            targets_meta,
+            is_agg,
+            co,
+            eo,
+            queue_time_ms);
+        if (partitioned_result) {
+          return *partitioned_result;
+        }
+      }
+      // Out of the memory budget, it may still fit the host without one.
+      if (e.getErrorCode() != Executor::ERR_OUT_OF_CPU_MEM ||
+          !g_query_cpu_memory_budget) {
+        handlePersistentError(e.getErrorCode());
+      }
+      retried_with_larger_buffer = true;
       return handleOutOfMemoryRetry(
           {ra_exe_unit, work_unit.body, local_groups_buffer_entry_guess},
           targets_meta,
@@ -3039,12 +3979,31 @@ ExecutionResult RelAlgExecutor::executeWorkUnit(
   };
 
   auto cache_key = ra_exec_unit_desc_for_caching(ra_exe_unit);
+  // Caches the number of groups the query actually produced, with the same headroom as
+  // the NDV estimation, so that repeated queries size their groups buffer from what they
+  // output rather than running the estimator query or retrying with larger buffers.
+  auto cache_observed_cardinality = [&](const ExecutionResult& result,
+                                        const size_t fallback_cardinality) {
+    if (eo.just_validate || eo.just_explain) {
+      return;
+    }
+    const auto& rows = result.getRows();
+    const bool has_rows =
+        rows && !(render_info && render_info->isPotentialInSituRender());
+    const auto cardinality =
+        has_rows ? std::max(2 * rows->rowCount(), size_t(1)) : fallback_cardinality;
+    VLOG(1) << "Caching a cardinality of " << cardinality << " for the work unit.";
+    executor_->addToCardinalityCache(cache_key, cardinality);
+  };
   try {
     auto cached_cardinality = executor_->getCachedCardinality(cache_key);
     auto card = cached_cardinality.second;
     if (cached_cardinality.first && card >= 0) {
       result = execute_and_handle_errors(
           card, /*has_cardinality_estimation=*/true, /*has_ndv_estimation=*/false);
+      if (retried_with_larger_buffer) {
+        cache_observed_cardinality(result, card);
+      }
     } else {
       result = execute_and_handle_errors(
           max_groups_buffer_entry_guess,
@@ -3057,6 +4016,9 @@ ExecutionResult RelAlgExecutor::executeWorkUnit(
     auto card = cached_cardinality.second;
     if (cached_cardinality.first && card >= 0) {
       result = execute_and_handle_errors(card, true, /*has_ndv_estimation=*/true);
+      if (retried_with_larger_buffer) {
+        cache_observed_cardinality(result, card);
+      }
     } else {
       const auto ndv_groups_estimation =
           getNDVEstimation(work_unit, e.range(), is_agg, co, eo);
@@ -3067,13 +4029,15 @@ ExecutionResult RelAlgExecutor::executeWorkUnit(
       CHECK_GT(estimated_groups_buffer_entry_guess, size_t(0));
       result = execute_and_handle_errors(
           estimated_groups_buffer_entry_guess, true, /*has_ndv_estimation=*/true);
-      if (!(eo.just_validate || eo.just_explain)) {
-        executor_->addToCardinalityCache(cache_key, estimated_groups_buffer_entry_guess);
-      }
+      cache_observed_cardinality(result, estimated_groups_buffer_entry_guess);
     }
   }
 
   result.setQueueTime(queue_time_ms);
+  if (is_agg && sample_scale_factor != 1.0 && result.getRows() && !eo.just_explain &&
+      !eo.just_validate) {
+    result.getRows()->scaleAggregates(sample_scale_factor);
+  }
   if (render_info) {
     build_render_targets(*render_info, work_unit.exe_unit.target_exprs, targets_meta);
     if (render_info->isPotentialInSituRender()) {
@@ -3090,18 +4054,19 @@ ExecutionResult RelAlgExecutor::executeWorkUnit(
   return result;
 }
 
-std::optional<size_t> RelAlgExecutor::getFilteredCountAll(const WorkUnit& work_unit,
-                                                          const bool is_agg,
-                                                          const CompilationOptions& co,
-                                                          const ExecutionOptions& eo) {
+std::optional<size_t> RelAlgExecutor::getFilteredCountAll(
+    const RelAlgExecutionUnit& ra_exe_unit,
+    const std::vector<InputTableInfo>& table_infos,
+    const bool is_agg,
+    const CompilationOptions& co,
+    const ExecutionOptions& eo) {
   const auto count =
       makeExpr<Analyzer::AggExpr>(SQLTypeInfo(g_bigint_count ? kBIGINT : kINT, false),
                                   kCOUNT,
                                   nullptr,
                                   false,
                                   nullptr);
-  const auto count_all_exe_unit =
-      create_count_all_execution_unit(work_unit.exe_unit, count);
+  const auto count_all_exe_unit = create_count_all_execution_unit(ra_exe_unit, count);
   size_t one{1};
   ResultSetPtr count_all_result;
   try {
@@ -3109,7 +4074,7 @@ std::optional<size_t> RelAlgExecutor::getFilteredCountAll(const WorkUnit& work_u
     count_all_result =
         executor_->executeWorkUnit(one,
                                    is_agg,
-                                   get_table_infos(work_unit.exe_unit, executor_),
+                                   table_infos,
                                    count_all_exe_unit,
                                    co,
                                    eo,
@@ -3182,12 +4147,15 @@ ExecutionResult RelAlgExecutor::handleOutOfMemoryRetry(
     RenderInfo* render_info,
     const bool was_multifrag_kernel_launch,
     const int64_t queue_time_ms) {
+  ++out_of_memory_retry_count;
   // Disable the bump allocator
   // Note that this will have basically the same affect as using the bump allocator for
   // the kernel per fragment path. Need to unify the max_groups_buffer_entry_guess = 0
   // path and the bump allocator path for kernel per fragment execution.
   auto ra_exe_unit_in = work_unit.exe_unit;
   ra_exe_unit_in.use_bump_allocator = false;
+  // The last resort, run without the memory budget rather than fail the query.
+  executor_->row_set_mem_owner_->setMemoryBudget(0);
 
   auto result = ExecutionResult{std::make_shared<ResultSet>(std::vector<TargetInfo>{},
                                                             co.device_type,
@@ -3294,6 +4262,17 @@ ExecutionResult RelAlgExecutor::handleOutOfMemoryRetry(
                         "guess equal to "
                      << max_groups_buffer_entry_guess;
       } else {
+        if (e.getErrorCode() == Executor::ERR_OUT_OF_CPU_MEM) {
+          auto partitioned_result = executePartitionedGroupBy(work_unit,
+                                                              targets_meta,
+                                                              is_agg,
+                                                              co_cpu,
+                                                              eo_no_multifrag,
+                                                              queue_time_ms);
+          if (partitioned_result) {
+            return *partitioned_result;
+          }
+        }
         handlePersistentError(e.getErrorCode());
       }
       continue;
@@ -3304,6 +4283,620 @@ ExecutionResult RelAlgExecutor::handleOutOfMemoryRetry(
   return result;
 }
 
+namespace {
+
+struct GroupByPartitionKey {
+  std::shared_ptr<Analyzer::Expr> expr;
+  size_t groupby_idx;
+  int64_t min;
+  int64_t max;
+  bool has_nulls;
+};
+
+// Picks the integer column group key with the widest range, which gives the most even
+// split of the groups across partitions. Only the ranges of columns are narrowed by the
+// simple quals bounding the partitions, see apply_simple_quals().
+std::optional<GroupByPartitionKey> get_group_by_partition_key(
+    const RelAlgExecutionUnit& ra_exe_unit,
+    const std::vector<InputTableInfo>& table_infos,
+    const Executor* executor) {
+  std::optional<GroupByPartitionKey> partition_key;
+  uint64_t widest_span{0};
+  size_t groupby_idx{0};
+  for (const auto& groupby_expr : ra_exe_unit.groupby_exprs) {
+    const auto col_var = dynamic_cast<const Analyzer::ColumnVar*>(groupby_expr.get());
+    if (!col_var || col_var->get_table_id() <= 0 ||
+        !col_var->get_type_info().is_integer()) {
+      ++groupby_idx;
+      continue;
+    }
+    const auto range = getExpressionRange(col_var, table_infos, executor);
+    if (range.getType() == ExpressionRangeType::Integer) {
+      const auto span = static_cast<uint64_t>(range.getIntMax()) -
+                        static_cast<uint64_t>(range.getIntMin());
+      if (span > widest_span) {
+        widest_span = span;
+        partition_key = GroupByPartitionKey{groupby_expr,
+                                            groupby_idx,
+                                            range.getIntMin(),
+                                            range.getIntMax(),
+                                            range.hasNulls()};
+      }
+    }
+    ++groupby_idx;
+  }
+  return partition_key;
+}
+
+// Builds the column versus constant bounds selecting the rows of partition
+// `partition_idx` out of `partition_count` equal width ranges of the partition key. As
+// simple quals they narrow the range of the key, and so the perfect hash group by
+// buffer, to the partition. The bounds leave out the nulls.
+std::list<std::shared_ptr<Analyzer::Expr>> make_group_by_partition_quals(
+    const GroupByPartitionKey& partition_key,
+    const size_t partition_idx,
+    const size_t partition_count) {
+  CHECK_LT(partition_idx, partition_count);
+  const auto span = static_cast<uint64_t>(partition_key.max) -
+                    static_cast<uint64_t>(partition_key.min);
+  const auto width = span / partition_count + 1;
+  const auto& key_ti = partition_key.expr->get_type_info();
+  const auto key = makeExpr<Analyzer::UOper>(
+      SQLTypeInfo(kBIGINT, key_ti.get_notnull()), false, kCAST, partition_key.expr);
+  auto make_bound = [&key, &partition_key, width](const SQLOps op, const size_t idx) {
+    Datum d;
+    d.bigintval =
+        static_cast<int64_t>(static_cast<uint64_t>(partition_key.min) + idx * width);
+    return makeExpr<Analyzer::BinOper>(
+        kBOOLEAN, op, kONE, key, makeExpr<Analyzer::Constant>(kBIGINT, false, d));
+  };
+  std::list<std::shared_ptr<Analyzer::Expr>> quals;
+  quals.push_back(make_bound(kGE, partition_idx));
+  if (partition_idx + 1 < partition_count) {
+    quals.push_back(make_bound(kLT, partition_idx + 1));
+  }
+  return quals;
+}
+
+// Restricts the execution unit to the groups whose partition key is null. The key is
+// replaced by a null constant, whose range doesn't size the group by buffer for the
+// whole range of the key.
+RelAlgExecutionUnit make_group_by_null_partition(
+    const RelAlgExecutionUnit& ra_exe_unit,
+    const GroupByPartitionKey& partition_key) {
+  auto quals = ra_exe_unit.quals;
+  quals.push_back(makeExpr<Analyzer::UOper>(kBOOLEAN, kISNULL, partition_key.expr));
+  auto groupby_exprs = ra_exe_unit.groupby_exprs;
+  CHECK_LT(partition_key.groupby_idx, groupby_exprs.size());
+  *std::next(groupby_exprs.begin(), partition_key.groupby_idx) =
+      makeExpr<Analyzer::Constant>(partition_key.expr->get_type_info(), true, Datum{});
+  return {ra_exe_unit.input_descs,
+          ra_exe_unit.input_col_descs,
+          ra_exe_unit.simple_quals,
+          quals,
+          ra_exe_unit.join_quals,
+          groupby_exprs,
+          ra_exe_unit.target_exprs,
+          ra_exe_unit.estimator,
+          ra_exe_unit.sort_info,
+          ra_exe_unit.scan_limit,
+          ra_exe_unit.query_hint,
+          ra_exe_unit.query_plan_dag,
+          ra_exe_unit.hash_table_build_plan_dag,
+          ra_exe_unit.use_bump_allocator,
+          ra_exe_unit.union_all,
+          ra_exe_unit.query_state};
+}
+
+}  // namespace
+
+std::optional<ExecutionResult> RelAlgExecutor::executePartitionedGroupBy(
+    const RelAlgExecutor::WorkUnit& work_unit,
+    const std::vector<TargetMetaInfo>& targets_meta,
+    const bool is_agg,
+    const CompilationOptions& co,
+    const ExecutionOptions& eo,
+    const int64_t queue_time_ms) {
+  const auto& ra_exe_unit_in = work_unit.exe_unit;
+  if (!g_enable_partitioned_group_by || !is_agg || ra_exe_unit_in.groupby_exprs.empty() ||
+      !ra_exe_unit_in.groupby_exprs.front() || ra_exe_unit_in.union_all ||
+      !work_unit.max_groups_buffer_entry_guess || eo.just_explain || eo.just_validate) {
+    return std::nullopt;
+  }
+  const auto table_infos = get_table_infos(ra_exe_unit_in, executor_);
+  const auto partition_key =
+      get_group_by_partition_key(ra_exe_unit_in, table_infos, executor_);
+  if (!partition_key) {
+    return std::nullopt;
+  }
+
+  const auto co_cpu = CompilationOptions::makeCpuOnly(co);
+  auto eo_no_multifrag = eo;
+  eo_no_multifrag.allow_multifrag = false;
+  // The partitions hold disjoint sets of groups, so their results are simply
+  // concatenated. Memory for a partition that ran out of memory itself is only released
+  // at the end of the query, hence the geometric growth of the partition count. The
+  // groups with a null key get a pass of their own after the partitions.
+  for (size_t partition_count = 4; partition_count <= g_max_group_by_partitions;
+       partition_count *= 2) {
+    LOG(WARNING) << "Group by ran out of CPU memory, retrying in " << partition_count
+                 << " partitions on " << partition_key->expr->toString();
+    try {
+      ResultSetPtr result;
+      const size_t pass_count = partition_count + (partition_key->has_nulls ? 1 : 0);
+      for (size_t partition_idx = 0; partition_idx < pass_count; ++partition_idx) {
+        auto ra_exe_unit_partition =
+            partition_idx < partition_count
+                ? ra_exe_unit_in
+                : make_group_by_null_partition(ra_exe_unit_in, *partition_key);
+        ra_exe_unit_partition.use_bump_allocator = false;
+        if (partition_idx < partition_count) {
+          ra_exe_unit_partition.simple_quals.splice(
+              ra_exe_unit_partition.simple_quals.end(),
+              make_group_by_partition_quals(
+                  *partition_key, partition_idx, partition_count));
+        }
+        const auto ra_exe_unit =
+            decide_approx_count_distinct_implementation(ra_exe_unit_partition,
+                                                        table_infos,
+                                                        executor_,
+                                                        co_cpu.device_type,
+                                                        target_exprs_owned_);
+        auto max_groups_buffer_entry_guess =
+            std::max(work_unit.max_groups_buffer_entry_guess / partition_count,
+                     g_default_max_groups_buffer_entry_guess);
+        ResultSetPtr partition_result;
+        for (int iteration_ctr = 0;; ++iteration_ctr) {
+          ColumnCacheMap column_cache;
+          executor_->row_set_mem_owner_->resetMemoryBudgetUsage();
+          try {
+            partition_result = executor_->executeWorkUnit(max_groups_buffer_entry_guess,
+                                                          is_agg,
+                                                          table_infos,
+                                                          ra_exe_unit,
+                                                          co_cpu,
+                                                          eo_no_multifrag,
+                                                          cat_,
+                                                          nullptr,
+                                                          true,
+                                                          column_cache);
+            break;
+          } catch (const QueryExecutionError& e) {
+            // Ran out of slots, the partitions are not necessarily balanced
+            if (e.getErrorCode() < 0 && !g_enable_watchdog && iteration_ctr < 2) {
+              max_groups_buffer_entry_guess *= 2;
+              continue;
+            }
+            throw;
+          }
+        }
+        CHECK(partition_result);
+        if (result) {
+          result->append(*partition_result);
+        } else {
+          result = partition_result;
+        }
+      }
+      ExecutionResult partitioned_result{result, targets_meta};
+      partitioned_result.setQueueTime(queue_time_ms);
+      ++partitioned_group_by_count;
+      return partitioned_result;
+    } catch (const QueryExecutionError& e) {
+      if (e.getErrorCode() != Executor::ERR_OUT_OF_CPU_MEM) {
+        handlePersistentError(e.getErrorCode());
+      }
+    }
+  }
+  return std::nullopt;
+}
+
+std::optional<ExecutionResult> RelAlgExecutor::executeProjectionOnCpuAndGpu(
+    const RelAlgExecutionUnit& ra_exe_unit,
+    const std::vector<InputTableInfo>& table_infos,
+    const std::vector<TargetMetaInfo>& targets_meta,
+    const size_t max_groups_buffer_entry_guess,
+    const CompilationOptions& co,
+    const ExecutionOptions& eo,
+    ColumnCacheMap& column_cache) {
+  // Only projections without a limit or an order are the union of their results over
+  // disjoint sets of outer fragments.
+  if (!g_enable_cpu_gpu_projection || co.device_type != ExecutorDeviceType::GPU ||
+      ra_exe_unit.union_all || ra_exe_unit.input_descs.size() != 1 ||
+      ra_exe_unit.input_descs.front().getSourceType() != InputSourceType::TABLE ||
+      ra_exe_unit.input_descs.front().getTableId() < 0 ||
+      !ra_exe_unit.sort_info.order_entries.empty() || ra_exe_unit.sort_info.limit ||
+      ra_exe_unit.sort_info.offset || !eo.outer_fragment_indices.empty() ||
+      eo.just_explain || eo.just_validate) {
+    return std::nullopt;
+  }
+  CHECK_EQ(table_infos.size(), size_t(1));
+  const auto table_id = table_infos.front().table_id;
+  const auto& fragments = table_infos.front().info.fragments;
+  std::vector<size_t> gpu_fragment_indices;
+  std::vector<size_t> cpu_fragment_indices;
+  for (size_t frag_idx = 0; frag_idx < fragments.size(); ++frag_idx) {
+    if (is_fragment_resident_on_gpu(ra_exe_unit, table_id, fragments[frag_idx], cat_)) {
+      gpu_fragment_indices.push_back(frag_idx);
+    } else {
+      cpu_fragment_indices.push_back(frag_idx);
+    }
+  }
+  if (gpu_fragment_indices.empty() || cpu_fragment_indices.empty()) {
+    return std::nullopt;
+  }
+  VLOG(1) << "Running the projection on " << gpu_fragment_indices.size()
+          << " fragments resident on GPU and " << cpu_fragment_indices.size()
+          << " fragments on CPU.";
+
+  auto eo_gpu = eo;
+  eo_gpu.outer_fragment_indices = gpu_fragment_indices;
+  auto eo_cpu = eo;
+  eo_cpu.outer_fragment_indices = cpu_fragment_indices;
+  ResultSetPtr gpu_result;
+  try {
+    auto groups_buffer_entry_guess = max_groups_buffer_entry_guess;
+    gpu_result = executor_->executeWorkUnit(groups_buffer_entry_guess,
+                                            /*is_agg=*/false,
+                                            table_infos,
+                                            ra_exe_unit,
+                                            co,
+                                            eo_gpu,
+                                            cat_,
+                                            nullptr,
+                                            true,
+                                            column_cache);
+  } catch (const QueryMustRunOnCpu&) {
+    return std::nullopt;
+  }
+  const auto co_cpu = CompilationOptions::makeCpuOnly(co);
+  auto groups_buffer_entry_guess = max_groups_buffer_entry_guess;
+  auto cpu_result = executor_->executeWorkUnit(groups_buffer_entry_guess,
+                                               /*is_agg=*/false,
+                                               table_infos,
+                                               ra_exe_unit,
+                                               co_cpu,
+                                               eo_cpu,
+                                               cat_,
+                                               nullptr,
+                                               true,
+                                               column_cache);
+  CHECK(gpu_result);
+  CHECK(cpu_result);
+  if (!gpu_result->getStorage()) {
+    return ExecutionResult{cpu_result, targets_meta};
+  }
+  if (!cpu_result->getStorage()) {
+    return ExecutionResult{gpu_result, targets_meta};
+  }
+  if (!have_same_projection_layout(*gpu_result, *cpu_result)) {
+    VLOG(1) << "The CPU and GPU projection results have different layouts.";
+    return std::nullopt;
+  }
+  gpu_result->append(*cpu_result);
+  return ExecutionResult{gpu_result, targets_meta};
+}
+
+std::optional<ExecutionResult> RelAlgExecutor::executeClusteredJoinInWindows(
+    const RelAlgExecutionUnit& ra_exe_unit,
+    const std::vector<InputTableInfo>& table_infos,
+    const std::vector<TargetMetaInfo>& targets_meta,
+    const size_t max_groups_buffer_entry_guess,
+    const CompilationOptions& co,
+    const ExecutionOptions& eo,
+    ColumnCacheMap& column_cache) {
+  // Like the projection on CPU and GPU, the windows must be the union of their results.
+  if (!g_enable_clustered_join_windows || !g_clustered_join_window_rows ||
+      ra_exe_unit.union_all || is_window_execution_unit(ra_exe_unit) ||
+      !ra_exe_unit.sort_info.order_entries.empty() || ra_exe_unit.sort_info.limit ||
+      ra_exe_unit.sort_info.offset || ra_exe_unit.scan_limit ||
+      !eo.outer_fragment_indices.empty() || eo.just_explain || eo.just_validate ||
+      eo.executor_type == ::ExecutorType::Extern) {
+    return std::nullopt;
+  }
+  const auto join_key = get_clustered_join_key(ra_exe_unit);
+  if (!join_key) {
+    return std::nullopt;
+  }
+  for (const auto& col_desc : ra_exe_unit.input_col_descs) {
+    // The windows number the rows of the inner table differently.
+    const auto cd = cat_.getMetadataForColumn(col_desc->getScanDesc().getTableId(),
+                                              col_desc->getColId());
+    if (cd && cd->isVirtualCol) {
+      return std::nullopt;
+    }
+  }
+  CHECK_EQ(table_infos.size(), size_t(2));
+  const auto& outer_fragments = table_infos[0].info.fragments;
+  const auto& inner_fragments = table_infos[1].info.fragments;
+
+  struct FragmentKeyRange {
+    size_t frag_idx;
+    int64_t min;
+    int64_t max;
+  };
+  std::vector<FragmentKeyRange> outer_ranges;
+  for (size_t frag_idx = 0; frag_idx < outer_fragments.size(); ++frag_idx) {
+    if (outer_fragments[frag_idx].isEmptyPhysicalFragment()) {
+      continue;
+    }
+    const auto range = get_fragment_key_range(outer_fragments[frag_idx], join_key->first);
+    if (!range) {
+      return std::nullopt;
+    }
+    outer_ranges.push_back({frag_idx, range->first, range->second});
+  }
+  std::sort(outer_ranges.begin(),
+            outer_ranges.end(),
+            [](const FragmentKeyRange& lhs, const FragmentKeyRange& rhs) {
+              return lhs.min < rhs.min;
+            });
+  // The inner fragments without valid metadata are joined in every window.
+  std::vector<std::pair<size_t, std::optional<std::pair<int64_t, int64_t>>>>
+      inner_ranges;
+  for (size_t frag_idx = 0; frag_idx < inner_fragments.size(); ++frag_idx) {
+    if (!inner_fragments[frag_idx].isEmptyPhysicalFragment()) {
+      inner_ranges.emplace_back(
+          frag_idx, get_fragment_key_range(inner_fragments[frag_idx], join_key->second));
+    }
+  }
+
+  // Windows of at least one fragment and g_clustered_join_window_rows outer rows at
+  // most, each with the inner fragments whose key range overlaps its own.
+  struct JoinWindow {
+    std::vector<size_t> outer_fragment_indices;
+    std::vector<Fragmenter_Namespace::FragmentInfo> inner_fragments;
+  };
+  std::vector<JoinWindow> windows;
+  for (size_t range_idx = 0; range_idx < outer_ranges.size();) {
+    JoinWindow window;
+    int64_t window_min = outer_ranges[range_idx].min;
+    int64_t window_max = outer_ranges[range_idx].max;
+    size_t window_rows{0};
+    for (; range_idx < outer_ranges.size(); ++range_idx) {
+      const auto& range = outer_ranges[range_idx];
+      const auto fragment_rows = outer_fragments[range.frag_idx].getNumTuples();
+      if (!window.outer_fragment_indices.empty() &&
+          window_rows + fragment_rows > g_clustered_join_window_rows) {
+        break;
+      }
+      window.outer_fragment_indices.push_back(range.frag_idx);
+      window_max = std::max(window_max, range.max);
+      window_rows += fragment_rows;
+    }
+    for (const auto& [frag_idx, inner_range] : inner_ranges) {
+      if (!inner_range ||
+          (inner_range->first <= window_max && inner_range->second >= window_min)) {
+        window.inner_fragments.push_back(inner_fragments[frag_idx]);
+      }
+    }
+    if (window.inner_fragments.size() == inner_ranges.size()) {
+      // Each window would join the whole inner table, its keys aren't clustered.
+      return std::nullopt;
+    }
+    windows.push_back(std::move(window));
+  }
+  if (windows.size() < 2) {
+    return std::nullopt;
+  }
+  VLOG(1) << "Running the join on " << join_key->first->toString() << " in "
+          << windows.size() << " windows of clustered fragments.";
+
+  ResultSetPtr result;
+  try {
+    for (const auto& window : windows) {
+      auto window_table_infos = table_infos;
+      auto& inner_info = window_table_infos[1].info;
+      inner_info.fragments = window.inner_fragments;
+      size_t inner_rows{0};
+      for (const auto& fragment : inner_info.fragments) {
+        inner_rows += fragment.getNumTuples();
+      }
+      inner_info.setPhysicalNumTuples(inner_rows);
+      auto eo_window = eo;
+      eo_window.outer_fragment_indices = window.outer_fragment_indices;
+      // Sizes the output of each window for its own rows.
+      auto ra_exe_unit_window = ra_exe_unit;
+      if (can_use_bump_allocator(ra_exe_unit, co, eo)) {
+        ra_exe_unit_window.use_bump_allocator = true;
+      } else if (compute_output_buffer_size(ra_exe_unit)) {
+        const auto filter_count_all = getFilteredCountAll(
+            ra_exe_unit, window_table_infos, /*is_agg=*/true, co, eo_window);
+        if (!filter_count_all) {
+          return std::nullopt;
+        }
+        ra_exe_unit_window.scan_limit = std::max(*filter_count_all, size_t(1));
+      }
+      auto groups_buffer_entry_guess = max_groups_buffer_entry_guess;
+      auto window_result = executor_->executeWorkUnit(groups_buffer_entry_guess,
+                                                      /*is_agg=*/false,
+                                                      window_table_infos,
+                                                      ra_exe_unit_window,
+                                                      co,
+                                                      eo_window,
+                                                      cat_,
+                                                      nullptr,
+                                                      true,
+                                                      column_cache);
+      CHECK(window_result);
+      if (!result || !result->getStorage()) {
+        result = window_result;
+      } else if (window_result->getStorage()) {
+        if (!have_same_projection_layout(*result, *window_result)) {
+          VLOG(1) << "The projection results of the join windows have different "
+                     "layouts.";
+          return std::nullopt;
+        }
+        result->append(*window_result);
+      }
+    }
+  } catch (const QueryExecutionError& e) {
+    // The projection at once reports the error, or retries it.
+    VLOG(1) << "A join window failed with error "
+            << getErrorMessageFromCode(e.getErrorCode());
+    return std::nullopt;
+  }
+  CHECK(result);
+  return ExecutionResult{result, targets_meta};
+}
+
+std::shared_ptr<Analyzer::Expr> RelAlgExecutor::getApproxTopKGroupsQual(
+    const RelAlgExecutionUnit& ra_exe_unit,
+    const std::vector<InputTableInfo>& table_infos,
+    const CompilationOptions& co,
+    const ExecutionOptions& eo) {
+  const auto& sort_info = ra_exe_unit.sort_info;
+  if (!g_enable_approx_top_k_group_by || !g_approx_top_k_sketch_factor ||
+      !co.hoist_literals || ra_exe_unit.groupby_exprs.size() != 1 ||
+      ra_exe_unit.input_descs.size() != 1 ||
+      ra_exe_unit.input_descs.front().getSourceType() != InputSourceType::TABLE ||
+      ra_exe_unit.input_descs.front().getTableId() < 0 || ra_exe_unit.union_all ||
+      ra_exe_unit.estimator || sort_info.order_entries.empty() || !sort_info.limit ||
+      !eo.outer_fragment_indices.empty() || eo.just_explain || eo.just_validate ||
+      eo.executor_type == ::ExecutorType::Extern) {
+    return nullptr;
+  }
+  const auto& order_entry = sort_info.order_entries.front();
+  CHECK_GT(order_entry.tle_no, 0);
+  CHECK_LE(static_cast<size_t>(order_entry.tle_no), ra_exe_unit.target_exprs.size());
+  const auto count_expr = dynamic_cast<const Analyzer::AggExpr*>(
+      ra_exe_unit.target_exprs[order_entry.tle_no - 1]);
+  if (!order_entry.is_desc || !count_expr || count_expr->get_aggtype() != kCOUNT ||
+      count_expr->get_arg()) {
+    return nullptr;
+  }
+  const auto key =
+      std::dynamic_pointer_cast<Analyzer::ColumnVar>(ra_exe_unit.groupby_exprs.front());
+  if (!key) {
+    return nullptr;
+  }
+  const auto& key_ti = key->get_type_info();
+  if (!key_ti.is_integer() &&
+      !(key_ti.is_string() && key_ti.get_compression() == kENCODING_DICT)) {
+    return nullptr;
+  }
+  const auto sketch_capacity =
+      (sort_info.limit + sort_info.offset) * g_approx_top_k_sketch_factor;
+  const auto key_range = getExpressionRange(key.get(), table_infos, executor_);
+  if (key_range.getType() != ExpressionRangeType::Integer ||
+      static_cast<uint64_t>(key_range.getIntMax()) -
+              static_cast<uint64_t>(key_range.getIntMin()) <
+          sketch_capacity) {
+    // There are about as few groups as counters, the group by is small already.
+    return nullptr;
+  }
+
+  // Streams the group key of the filtered rows through the sketch, a few outer fragments
+  // at a time so that only their projection is held in memory.
+  const RelAlgExecutionUnit key_exe_unit{ra_exe_unit.input_descs,
+                                         ra_exe_unit.input_col_descs,
+                                         ra_exe_unit.simple_quals,
+                                         ra_exe_unit.quals,
+                                         ra_exe_unit.join_quals,
+                                         {nullptr},
+                                         {key.get()},
+                                         nullptr,
+                                         SortInfo{{}, SortAlgorithm::Default, 0, 0},
+                                         0,
+                                         ra_exe_unit.query_hint,
+                                         ra_exe_unit.query_plan_dag,
+                                         ra_exe_unit.hash_table_build_plan_dag,
+                                         false,
+                                         ra_exe_unit.union_all,
+                                         ra_exe_unit.query_state};
+  auto co_key = co;
+  co_key.allow_lazy_fetch = false;
+  const auto& fragments = table_infos.front().info.fragments;
+  const size_t batch_fragment_count = std::max(cpu_threads(), 1);
+  const auto null_val = inline_int_null_val(key_ti);
+  SpaceSavingSketch sketch(sketch_capacity);
+  try {
+    for (size_t batch_start = 0; batch_start < fragments.size();
+         batch_start += batch_fragment_count) {
+      auto eo_batch = eo;
+      eo_batch.allow_multifrag = false;
+      eo_batch.outer_fragment_indices.clear();
+      for (size_t frag_idx = batch_start;
+           frag_idx < std::min(batch_start + batch_fragment_count, fragments.size());
+           ++frag_idx) {
+        eo_batch.outer_fragment_indices.push_back(frag_idx);
+      }
+      ColumnCacheMap column_cache;
+      size_t groups_buffer_entry_guess{0};
+      const auto rows = executor_->executeWorkUnit(groups_buffer_entry_guess,
+                                                   /*is_agg=*/false,
+                                                   table_infos,
+                                                   key_exe_unit,
+                                                   co_key,
+                                                   eo_batch,
+                                                   cat_,
+                                                   nullptr,
+                                                   true,
+                                                   column_cache);
+      CHECK(rows);
+      // One sketch per thread over a slice of the rows, merged into the sketch of all.
+      const auto entry_count = rows->entryCount();
+      const size_t worker_count = entry_count > 100000 ? cpu_threads() : 1;
+      const auto stride = (entry_count + worker_count - 1) / worker_count;
+      std::vector<SpaceSavingSketch> worker_sketches(worker_count,
+                                                     SpaceSavingSketch(sketch_capacity));
+      std::vector<std::future<void>> workers;
+      for (size_t i = 0; i < worker_count; ++i) {
+        workers.push_back(std::async(
+            std::launch::async,
+            [&rows, null_val](
+                SpaceSavingSketch& worker_sketch, const size_t start, const size_t end) {
+              for (size_t entry_idx = start; entry_idx < end; ++entry_idx) {
+                const auto row = rows->getRowAtNoTranslations(entry_idx);
+                if (row.empty()) {
+                  continue;
+                }
+                const auto scalar_tv = boost::get<ScalarTargetValue>(&row.front());
+                CHECK(scalar_tv);
+                const auto value_ptr = boost::get<int64_t>(scalar_tv);
+                CHECK(value_ptr);
+                // The null group always stays in the exact group by.
+                if (*value_ptr != null_val) {
+                  worker_sketch.add(*value_ptr);
+                }
+              }
+            },
+            std::ref(worker_sketches[i]),
+            std::min(i * stride, entry_count),
+            std::min((i + 1) * stride, entry_count)));
+      }
+      for (auto& worker : workers) {
+        worker.get();
+      }
+      for (const auto& worker_sketch : worker_sketches) {
+        sketch.merge(worker_sketch);
+      }
+    }
+  } catch (const QueryExecutionError& e) {
+    VLOG(1) << "The top k groups sketch failed with error "
+            << getErrorMessageFromCode(e.getErrorCode());
+    return nullptr;
+  } catch (const QueryMustRunOnCpu&) {
+    return nullptr;
+  }
+
+  std::vector<int64_t> candidates;
+  for (const auto& value_and_count : sketch.getMostFrequent()) {
+    candidates.push_back(value_and_count.first);
+  }
+  if (candidates.empty()) {
+    return nullptr;
+  }
+  VLOG(1) << "Restricting the group by on " << key->toString() << " to the "
+          << candidates.size() << " most frequent keys of its sketch.";
+  std::shared_ptr<Analyzer::Expr> qual =
+      makeExpr<Analyzer::InIntegerSet>(key, candidates, key_ti.get_notnull());
+  if (!key_ti.get_notnull()) {
+    qual = makeExpr<Analyzer::BinOper>(
+        kBOOLEAN, kOR, kONE, qual, makeExpr<Analyzer::UOper>(kBOOLEAN, kISNULL, key));
+  }
+  return qual;
+}
+
 void RelAlgExecutor::handlePersistentError(const int32_t error_code) {
   LOG(ERROR) << "Query execution failed with error "
              << getErrorMessageFromCode(error_code);
@@ -3380,6 +4973,14 @@ ErrorInfo getErrorDescription(const int32_t error_code) {
 
 }  // namespace
 
+size_t RelAlgExecutor::getPartitionedGroupByCount() {
+  return partitioned_group_by_count;
+}
+
+size_t RelAlgExecutor::getOutOfMemoryRetryCount() {
+  return out_of_memory_retry_count;
+}
+
 std::string RelAlgExecutor::getErrorMessageFromCode(const int32_t error_code) {
   if (error_code < 0) {
     return "Ran out of slots in the query output buffer";
@@ -3510,9 +5111,7 @@ std::vector<JoinType> left_deep_join_types(const RelLeftDeepInnerJoin* left_deep
   std::vector<JoinType> join_types(left_deep_join->inputCount() - 1, JoinType::INNER);
   for (size_t nesting_level = 1; nesting_level <= left_deep_join->inputCount() - 1;
        ++nesting_level) {
-    if (left_deep_join->getOuterCondition(nesting_level)) {
-      join_types[nesting_level - 1] = JoinType::LEFT;
-    }
+    join_types[nesting_level - 1] = left_deep_join->getJoinType(nesting_level);
   }
   return join_types;
 }
@@ -3531,6 +5130,12 @@ std::vector<size_t> do_table_reordering(
     // information to break ties
     return {};
   }
+  for (const auto& join_condition : left_deep_join_quals) {
+    // The inner table of semi and anti joins cannot move.
+    if (join_condition.type == JoinType::SEMI || join_condition.type == JoinType::ANTI) {
+      return {};
+    }
+  }
   const auto& cat = *executor->getCatalog();
   for (const auto& table_info : query_infos) {
     if (table_info.table_id < 0) {
@@ -3827,8 +5432,8 @@ JoinQualsPerNestingLevel RelAlgExecutor::translateLeftDeepJoinFilter(
       result[rte_idx - 1].quals =
           makeJoinQuals(outer_condition, join_types, input_to_nest_level, just_explain);
       CHECK_LE(rte_idx, join_types.size());
-      CHECK(join_types[rte_idx - 1] == JoinType::LEFT);
-      result[rte_idx - 1].type = JoinType::LEFT;
+      CHECK(join_types[rte_idx - 1] != JoinType::INNER);
+      result[rte_idx - 1].type = join_types[rte_idx - 1];
       continue;
     }
     for (const auto& qual : join_condition_quals) {
@@ -3843,8 +5448,8 @@ JoinQualsPerNestingLevel RelAlgExecutor::translateLeftDeepJoinFilter(
       }
     }
     CHECK_LE(rte_idx, join_types.size());
-    CHECK(join_types[rte_idx - 1] == JoinType::INNER);
-    result[rte_idx - 1].type = JoinType::INNER;
+    CHECK(join_types[rte_idx - 1] != JoinType::LEFT);
+    result[rte_idx - 1].type = join_types[rte_idx - 1];
   }
   return result;
 }
@@ -158,10 +158,19 @@ class RelAlgExecutor : private StorageIOFacility {
 
   Executor* getExecutor() const;
 
+  // Profile of the last query executed, null unless g_enable_query_profile is set.
+  std::shared_ptr<const QueryProfileInfo> getQueryProfileInfo() const {
+    return query_profile_info_;
+  }
+
   void cleanupPostExecution();
 
   static std::string getErrorMessageFromCode(const int32_t error_code);
 
+  // The following methods are for testing purposes only
+  static size_t getPartitionedGroupByCount();
+  static size_t getOutOfMemoryRetryCount();
+
   void executePostExecutionCallback();
 
  private:
@@ -177,6 +186,14 @@ class RelAlgExecutor : private StorageIOFacility {
                          RenderInfo*,
                          const int64_t queue_time_ms);
 
+  // Runs the steps computing the branches of a UNION ALL concurrently, each on an
+  // executor of its own.
+  void executeUnionBranchSteps(const RaExecutionSequence& seq,
+                               const std::pair<size_t, size_t> interval,
+                               const CompilationOptions&,
+                               const ExecutionOptions&,
+                               const int64_t queue_time_ms);
+
   void executeUpdate(const RelAlgNode* node,
                      const CompilationOptions& co,
                      const ExecutionOptions& eo,
@@ -222,6 +239,7 @@ class RelAlgExecutor : private StorageIOFacility {
   std::unique_ptr<WindowFunctionContext> createWindowFunctionContext(
       const Analyzer::WindowFunction* window_func,
       const std::shared_ptr<Analyzer::BinOper>& partition_key_cond,
+      std::shared_ptr<HashJoin> partitions,
       const RelAlgExecutionUnit& ra_exe_unit,
       const std::vector<InputTableInfo>& query_infos,
       const CompilationOptions& co,
@@ -285,10 +303,12 @@ class RelAlgExecutor : private StorageIOFacility {
                           const CompilationOptions& co,
                           const ExecutionOptions& eo);
 
-  std::optional<size_t> getFilteredCountAll(const WorkUnit& work_unit,
-                                            const bool is_agg,
-                                            const CompilationOptions& co,
-                                            const ExecutionOptions& eo);
+  std::optional<size_t> getFilteredCountAll(
+      const RelAlgExecutionUnit& ra_exe_unit,
+      const std::vector<InputTableInfo>& table_infos,
+      const bool is_agg,
+      const CompilationOptions& co,
+      const ExecutionOptions& eo);
 
   FilterSelectivity getFilterSelectivity(
       const std::vector<std::shared_ptr<Analyzer::Expr>>& filter_expressions,
@@ -311,6 +331,54 @@ class RelAlgExecutor : private StorageIOFacility {
                                          const bool was_multifrag_kernel_launch,
                                          const int64_t queue_time_ms);
 
+  // Splits an aggregate which ran out of CPU memory into several passes over disjoint
+  // ranges of one of its integer group keys. Returns std::nullopt if the work unit
+  // can't be partitioned, in which case the caller reports the original error.
+  std::optional<ExecutionResult> executePartitionedGroupBy(
+      const RelAlgExecutor::WorkUnit& work_unit,
+      const std::vector<TargetMetaInfo>& targets_meta,
+      const bool is_agg,
+      const CompilationOptions& co,
+      const ExecutionOptions& eo,
+      const int64_t queue_time_ms);
+
+  // Runs a projection whose inputs don't fit in GPU memory on both devices: the outer
+  // fragments resident on GPU on GPU, the others on CPU, and appends the results.
+  // Returns std::nullopt if the projection can't be split, in which case the caller
+  // retries it on CPU.
+  std::optional<ExecutionResult> executeProjectionOnCpuAndGpu(
+      const RelAlgExecutionUnit& ra_exe_unit,
+      const std::vector<InputTableInfo>& table_infos,
+      const std::vector<TargetMetaInfo>& targets_meta,
+      const size_t max_groups_buffer_entry_guess,
+      const CompilationOptions& co,
+      const ExecutionOptions& eo,
+      ColumnCacheMap& column_cache);
+
+  // Runs a projection over the inner join of two tables clustered on the equi-join key
+  // in windows of outer fragments with adjacent key ranges, each joined with a hash
+  // table over only the inner fragments whose key range overlaps the window. Returns
+  // std::nullopt if the chunk metadata doesn't show clustered join keys, in which case
+  // the caller runs the projection at once.
+  std::optional<ExecutionResult> executeClusteredJoinInWindows(
+      const RelAlgExecutionUnit& ra_exe_unit,
+      const std::vector<InputTableInfo>& table_infos,
+      const std::vector<TargetMetaInfo>& targets_meta,
+      const size_t max_groups_buffer_entry_guess,
+      const CompilationOptions& co,
+      const ExecutionOptions& eo,
+      ColumnCacheMap& column_cache);
+
+  // Builds the filter which restricts a group by on one key ordered by a descending
+  // COUNT(*) with a limit to the most frequent keys, according to a Space-Saving sketch
+  // of the key over the filtered rows. Returns nullptr if the group by isn't of that
+  // form or has few groups already.
+  std::shared_ptr<Analyzer::Expr> getApproxTopKGroupsQual(
+      const RelAlgExecutionUnit& ra_exe_unit,
+      const std::vector<InputTableInfo>& table_infos,
+      const CompilationOptions& co,
+      const ExecutionOptions& eo);
+
   // Allows an out of memory error through if CPU retry is enabled. Otherwise, throws an
   // appropriate exception corresponding to the query error code.
   static void handlePersistentError(const int32_t error_code);
@@ -386,6 +454,7 @@ class RelAlgExecutor : private StorageIOFacility {
 
   std::unique_ptr<TransactionParameters> dml_transaction_parameters_;
   std::optional<std::function<void()>> post_execution_callback_;
+  std::shared_ptr<const QueryProfileInfo> query_profile_info_;
 
   friend class PendingExecutionClosure;
 };
@@ -1724,15 +1724,62 @@ bool supported_upper_bound(const RexWindowFunctionOperator* rex_window_function)
   }
 }
 
+// Returns the offset from the current row of a ROWS frame bound, if it's a supported one.
+std::optional<int64_t> get_rows_frame_bound_offset(
+    const RexWindowFunctionOperator::RexWindowBound& window_bound) {
+  if (window_bound.unbounded) {
+    return window_bound.preceding ? std::numeric_limits<int64_t>::min()
+                                  : std::numeric_limits<int64_t>::max();
+  }
+  if (window_bound.is_current_row) {
+    return 0;
+  }
+  const auto offset_literal = dynamic_cast<const RexLiteral*>(window_bound.offset.get());
+  if (!offset_literal || offset_literal->getScale() ||
+      (offset_literal->getType() != kDECIMAL && offset_literal->getType() != kINT &&
+       offset_literal->getType() != kBIGINT)) {
+    return std::nullopt;
+  }
+  const auto offset = offset_literal->getVal<int64_t>();
+  if (offset < 0) {
+    return std::nullopt;
+  }
+  return window_bound.preceding ? -offset : offset;
+}
+
+// Returns the explicit ROWS frame of an aggregate window function, if supported.
+std::optional<Analyzer::WindowFunction::Frame> get_rows_frame(
+    const RexWindowFunctionOperator* rex_window_function) {
+  if (!rex_window_function->isRows() ||
+      !window_function_is_aggregate(rex_window_function->getKind())) {
+    return std::nullopt;
+  }
+  const auto lower_offset =
+      get_rows_frame_bound_offset(rex_window_function->getLowerBound());
+  const auto upper_offset =
+      get_rows_frame_bound_offset(rex_window_function->getUpperBound());
+  if (!lower_offset || !upper_offset ||
+      *lower_offset == std::numeric_limits<int64_t>::max() ||
+      *upper_offset == std::numeric_limits<int64_t>::min()) {
+    return std::nullopt;
+  }
+  return Analyzer::WindowFunction::Frame{*lower_offset, *upper_offset};
+}
+
 }  // namespace
 
 std::shared_ptr<Analyzer::Expr> RelAlgTranslator::translateWindowFunction(
     const RexWindowFunctionOperator* rex_window_function) const {
+  std::optional<Analyzer::WindowFunction::Frame> frame;
   if (!supported_lower_bound(rex_window_function->getLowerBound()) ||
       !supported_upper_bound(rex_window_function) ||
       ((rex_window_function->getKind() == SqlWindowFunctionKind::ROW_NUMBER) !=
        rex_window_function->isRows())) {
-    throw std::runtime_error("Frame specification not supported");
+    // Aggregates over other ROWS frames are computed ahead of the projection.
+    frame = get_rows_frame(rex_window_function);
+    if (!frame) {
+      throw std::runtime_error("Frame specification not supported");
+    }
   }
   std::vector<std::shared_ptr<Analyzer::Expr>> args;
   for (size_t i = 0; i < rex_window_function->size(); ++i) {
@@ -1757,7 +1804,8 @@ std::shared_ptr<Analyzer::Expr> RelAlgTranslator::translateWindowFunction(
       args,
       partition_keys,
       order_keys,
-      translate_collation(rex_window_function->getCollation()));
+      translate_collation(rex_window_function->getCollation()),
+      frame);
 }
 
 Analyzer::ExpressionPtrVector RelAlgTranslator::translateFunctionArgs(
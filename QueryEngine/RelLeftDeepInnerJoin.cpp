@@ -15,11 +15,14 @@
  */
 
 #include "RelLeftDeepInnerJoin.h"
+#include "Catalog/Catalog.h"
 #include "Logger/Logger.h"
 #include "RelAlgDagBuilder.h"
 #include "RexVisitor.h"
 
+#include <list>
 #include <numeric>
+#include <unordered_set>
 
 RelLeftDeepInnerJoin::RelLeftDeepInnerJoin(
     const std::shared_ptr<RelFilter>& filter,
@@ -33,8 +36,14 @@ RelLeftDeepInnerJoin::RelLeftDeepInnerJoin(
   // Accumulate join conditions from the (explicit) joins themselves and
   // from the filter node at the root of the left-deep tree pattern.
   outer_conditions_per_level_.resize(original_joins.size());
+  join_types_per_level_.resize(original_joins.size(), JoinType::INNER);
   for (size_t nesting_level = 0; nesting_level < original_joins.size(); ++nesting_level) {
     const auto& original_join = original_joins[nesting_level];
+    if (original_join->getJoinType() == JoinType::SEMI ||
+        original_join->getJoinType() == JoinType::ANTI) {
+      // Never a cross join, even if the condition is trivial.
+      join_types_per_level_[nesting_level] = original_join->getJoinType();
+    }
     const auto condition_true =
         dynamic_cast<const RexLiteral*>(original_join->getCondition());
     if (!condition_true || !condition_true->getVal<bool>()) {
@@ -51,7 +60,10 @@ RelLeftDeepInnerJoin::RelLeftDeepInnerJoin(
           }
           break;
         }
-        case JoinType::LEFT: {
+        case JoinType::LEFT:
+        case JoinType::SEMI:
+        case JoinType::ANTI: {
+          join_types_per_level_[nesting_level] = original_join->getJoinType();
           if (original_join->getCondition()) {
             outer_conditions_per_level_[nesting_level].reset(
                 original_join->getAndReleaseCondition());
@@ -100,6 +112,13 @@ const RexScalar* RelLeftDeepInnerJoin::getOuterCondition(
       .get();
 }
 
+JoinType RelLeftDeepInnerJoin::getJoinType(const size_t nesting_level) const {
+  CHECK_GE(nesting_level, size_t(1));
+  CHECK_LE(nesting_level, join_types_per_level_.size());
+  // Same order as the outer conditions.
+  return join_types_per_level_[join_types_per_level_.size() - nesting_level];
+}
+
 std::string RelLeftDeepInnerJoin::toString() const {
   std::string ret = ::typeName(this) + "(";
   ret += ::toString(condition_);
@@ -115,6 +134,9 @@ size_t RelLeftDeepInnerJoin::toHash() const {
     hash_ = typeid(RelLeftDeepInnerJoin).hash_code();
     boost::hash_combine(*hash_,
                         condition_ ? condition_->toHash() : boost::hash_value("n"));
+    for (const auto join_type : join_types_per_level_) {
+      boost::hash_combine(*hash_, ::toString(join_type));
+    }
     for (auto& node : inputs_) {
       boost::hash_combine(*hash_, node->toHash());
     }
@@ -317,3 +339,110 @@ void create_left_deep_join(std::vector<std::shared_ptr<RelAlgNode>>& nodes) {
   // visitation, such as RelAlgDagBuilder::resetQueryExecutionState.
   nodes.insert(nodes.begin(), new_nodes.begin(), new_nodes.end());
 }
+
+namespace {
+
+// Returns the subquery of an `integer column IN (subquery)` expression. Other types might
+// not be supported by join hash tables.
+const RexSubQuery* get_in_subquery(const RexScalar* rex,
+                                   const Catalog_Namespace::Catalog& cat) {
+  const auto in_oper = dynamic_cast<const RexOperator*>(rex);
+  if (!in_oper || in_oper->getOperator() != kIN || in_oper->size() != 2) {
+    return nullptr;
+  }
+  const auto lhs = dynamic_cast<const RexInput*>(in_oper->getOperand(0));
+  const auto scan = lhs ? dynamic_cast<const RelScan*>(lhs->getSourceNode()) : nullptr;
+  if (!scan) {
+    return nullptr;
+  }
+  const auto cd = cat.getMetadataForColumn(scan->getTableDescriptor()->tableId,
+                                           scan->getFieldName(lhs->getIndex()));
+  if (!cd || !cd->columnType.is_integer()) {
+    return nullptr;
+  }
+  return dynamic_cast<const RexSubQuery*>(in_oper->getOperand(1));
+}
+
+void collect_subquery_nodes(const std::shared_ptr<const RelAlgNode>& node,
+                            std::unordered_set<const RelAlgNode*>& visited,
+                            std::list<std::shared_ptr<RelAlgNode>>& subquery_nodes) {
+  if (!visited.insert(node.get()).second) {
+    return;
+  }
+  for (size_t i = 0; i < node->inputCount(); ++i) {
+    collect_subquery_nodes(node->getAndOwnInput(i), visited, subquery_nodes);
+  }
+  subquery_nodes.push_back(std::const_pointer_cast<RelAlgNode>(node));
+}
+
+}  // namespace
+
+void create_semi_joins_for_in_subqueries(std::vector<std::shared_ptr<RelAlgNode>>& nodes,
+                                         const Catalog_Namespace::Catalog& cat) {
+  std::list<std::shared_ptr<RelAlgNode>> new_nodes;
+  std::unordered_set<const RelAlgNode*> visited;
+  for (const auto& node : nodes) {
+    const auto compound = std::dynamic_pointer_cast<RelCompound>(node);
+    if (!compound || !compound->getFilterExpr() || compound->inputCount() != 1 ||
+        compound->isUpdateViaSelect() || compound->isDeleteViaSelect()) {
+      continue;
+    }
+    const auto input = compound->getAndOwnInput(0);
+    if (!dynamic_cast<const RelScan*>(input.get())) {
+      continue;
+    }
+    const auto filter_expr = compound->getFilterExpr();
+    const auto and_oper = dynamic_cast<const RexOperator*>(filter_expr);
+    const bool is_conjunction = and_oper && and_oper->getOperator() == kAND;
+    std::vector<const RexScalar*> conjuncts;
+    if (is_conjunction) {
+      for (size_t i = 0; i < and_oper->size(); ++i) {
+        conjuncts.push_back(and_oper->getOperand(i));
+      }
+    } else {
+      conjuncts.push_back(filter_expr);
+    }
+    const auto in_it =
+        std::find_if(conjuncts.begin(), conjuncts.end(), [&cat](const RexScalar* rex) {
+          return get_in_subquery(rex, cat);
+        });
+    if (in_it == conjuncts.end()) {
+      continue;
+    }
+    const auto in_oper = static_cast<const RexOperator*>(*in_it);
+    const auto subquery_ra = get_in_subquery(in_oper, cat)->getRelAlgShPtr();
+    std::vector<std::unique_ptr<const RexScalar>> eq_operands;
+    eq_operands.emplace_back(
+        static_cast<const RexInput*>(in_oper->getOperand(0))->deepCopy());
+    eq_operands.emplace_back(std::make_unique<RexInput>(subquery_ra.get(), 0));
+    std::unique_ptr<const RexScalar> join_condition(
+        new RexOperator(kEQ, eq_operands, in_oper->getType()));
+    std::vector<std::shared_ptr<const RelJoin>> original_joins{
+        std::make_shared<RelJoin>(input, subquery_ra, join_condition, JoinType::SEMI)};
+    auto left_deep_join = std::make_shared<RelLeftDeepInnerJoin>(
+        nullptr, RelAlgInputs{input, subquery_ra}, original_joins);
+
+    std::vector<std::unique_ptr<const RexScalar>> remaining_conjuncts;
+    for (size_t i = 0; is_conjunction && i < conjuncts.size(); ++i) {
+      if (conjuncts[i] != in_oper) {
+        remaining_conjuncts.emplace_back(and_oper->getOperandAndRelease(i));
+      }
+    }
+    std::unique_ptr<const RexScalar> new_filter_expr;
+    if (remaining_conjuncts.size() > 1) {
+      new_filter_expr.reset(
+          new RexOperator(kAND, remaining_conjuncts, and_oper->getType()));
+    } else if (remaining_conjuncts.size() == 1) {
+      new_filter_expr = std::move(remaining_conjuncts.front());
+    }
+    compound->setFilterExpr(new_filter_expr);
+    // The inputs of the compound expressions already are the inputs of the join.
+    compound->replaceInput(input, left_deep_join);
+    VLOG(1) << "Running IN subquery " << subquery_ra->getId() << " as a semi join";
+    new_nodes.emplace_back(std::move(left_deep_join));
+    // Keep the subquery nodes with the other nodes of the query, so their execution
+    // state gets reset along with them.
+    collect_subquery_nodes(subquery_ra, visited, new_nodes);
+  }
+  nodes.insert(nodes.begin(), new_nodes.begin(), new_nodes.end());
+}
@@ -23,11 +23,21 @@ class RelAlgNode;
 class RelLeftDeepInnerJoin;
 class RexScalar;
 
+namespace Catalog_Namespace {
+class Catalog;
+}  // namespace Catalog_Namespace
+
 // Gets the start node of a left-deep pattern starting at the node itself or its child.
 std::shared_ptr<const RelAlgNode> get_left_deep_join_root(
     const std::shared_ptr<RelAlgNode>& node);
 
 void create_left_deep_join(std::vector<std::shared_ptr<RelAlgNode>>& nodes);
 
+// Turns an `integer column IN (subquery)` conjunct of the filter of a compound over a
+// single table into a semi join with the subquery, which runs as a hash join instead of
+// an IN set.
+void create_semi_joins_for_in_subqueries(std::vector<std::shared_ptr<RelAlgNode>>& nodes,
+                                         const Catalog_Namespace::Catalog& cat);
+
 void rebind_inputs_from_left_deep_join(const RexScalar* rex,
                                        const RelLeftDeepInnerJoin* left_deep_join);
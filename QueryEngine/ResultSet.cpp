@@ -46,6 +46,7 @@ extern bool g_use_tbb_pool;
 
 size_t g_parallel_top_min = 100e3;
 size_t g_parallel_top_max = 20e6;  // In effect only with g_enable_watchdog.
+size_t g_parallel_sort_min = 100e3;
 
 void ResultSet::keepFirstN(const size_t n) {
   CHECK_EQ(-1, cached_row_count_);
@@ -240,6 +241,15 @@ size_t ResultSet::getCurrentRowBufferIndex() const {
   return crt_row_buff_idx_ - 1;
 }
 
+void ResultSet::scaleAggregates(const double factor) {
+  if (storage_) {
+    storage_->scaleAggregates(factor);
+  }
+  for (auto& storage : appended_storage_) {
+    storage->scaleAggregates(factor);
+  }
+}
+
 // Note: that.appended_storage_ does not get appended to this.
 void ResultSet::append(ResultSet& that) {
   CHECK_EQ(-1, cached_row_count_);
@@ -247,6 +257,8 @@ void ResultSet::append(ResultSet& that) {
     return;
   }
   appended_storage_.push_back(std::move(that.storage_));
+  non_empty_entries_valid_ = false;
+  non_empty_entries_.clear();
   query_mem_desc_.setEntryCount(
       query_mem_desc_.getEntryCount() +
       appended_storage_.back()->query_mem_desc_.getEntryCount());
@@ -365,6 +377,9 @@ size_t ResultSet::binSearchRowCount() const {
 }
 
 size_t ResultSet::parallelRowCount() const {
+  if (entryCount() <= std::numeric_limits<PermutationIdx>::max()) {
+    return get_truncated_row_count(getNonEmptyEntries().size(), getLimit(), drop_first_);
+  }
   auto execute_parallel_row_count = [this](auto counter_threads) -> size_t {
     const size_t worker_count = cpu_threads();
     for (size_t i = 0,
@@ -399,6 +414,48 @@ size_t ResultSet::parallelRowCount() const {
   return get_truncated_row_count(row_count, getLimit(), drop_first_);
 }
 
+const Permutation& ResultSet::getNonEmptyEntries() const {
+  CHECK(permutation_.empty());
+  std::lock_guard<std::mutex> lock(non_empty_entries_mutex_);
+  if (non_empty_entries_valid_) {
+    return non_empty_entries_;
+  }
+  auto timer = DEBUG_TIMER(__func__);
+  CHECK_LE(entryCount(), std::numeric_limits<PermutationIdx>::max());
+  auto collect_non_empty_entries = [this](auto collector_threads) {
+    for (auto interval : makeIntervals<PermutationIdx>(0, entryCount(), cpu_threads())) {
+      collector_threads.spawn(
+          [this](const auto interval) {
+            Permutation entries;
+            for (PermutationIdx i = interval.begin; i < interval.end; ++i) {
+              if (!isRowAtEmpty(i)) {
+                entries.push_back(i);
+              }
+            }
+            return entries;
+          },
+          interval);
+    }
+    return collector_threads.join();
+  };
+  // will fall back to futures threadpool if TBB is not enabled
+  const auto interval_entries =
+      g_use_tbb_pool
+          ? collect_non_empty_entries(threadpool::ThreadPool<Permutation>())
+          : collect_non_empty_entries(threadpool::FuturesThreadPool<Permutation>());
+  size_t row_count{0};
+  for (const auto& entries : interval_entries) {
+    row_count += entries.size();
+  }
+  non_empty_entries_.clear();
+  non_empty_entries_.reserve(row_count);
+  for (const auto& entries : interval_entries) {
+    non_empty_entries_.insert(non_empty_entries_.end(), entries.begin(), entries.end());
+  }
+  non_empty_entries_valid_ = true;
+  return non_empty_entries_;
+}
+
 bool ResultSet::definitelyHasNoRows() const {
   return !storage_ && !estimator_ && !just_explain_;
 }
@@ -544,6 +601,10 @@ void ResultSet::sort(const std::list<Analyzer::OrderEntry>& order_entries,
     if (g_enable_watchdog && Executor::baseline_threshold < entryCount()) {
       throw WatchdogException("Sorting the result would be too slow");
     }
+    if (!top_n && g_parallel_sort_min < entryCount() && cpu_threads() > 1) {
+      parallelSort(order_entries, executor);
+      return;
+    }
     permutation_.resize(query_mem_desc_.getEntryCount());
     // PermutationView is used to share common API with parallelTop().
     PermutationView pv(permutation_.data(), 0, permutation_.size());
@@ -582,6 +643,15 @@ PermutationView ResultSet::initPermutationBuffer(PermutationView permutation,
                                                  PermutationIdx const begin,
                                                  PermutationIdx const end) const {
   auto timer = DEBUG_TIMER(__func__);
+  if (non_empty_entries_valid_) {
+    const auto first = std::lower_bound(
+        non_empty_entries_.begin(), non_empty_entries_.end(), begin);
+    const auto last = std::lower_bound(first, non_empty_entries_.end(), end);
+    for (auto it = first; it != last; ++it) {
+      permutation.push_back(*it);
+    }
+    return permutation;
+  }
   for (PermutationIdx i = begin; i < end; ++i) {
     const auto storage_lookup_result = findStorage(i);
     const auto lhs_storage = storage_lookup_result.storage_ptr;
@@ -640,6 +710,86 @@ void ResultSet::parallelTop(const std::list<Analyzer::OrderEntry>& order_entries
   permutation_.shrink_to_fit();
 }
 
+void ResultSet::parallelSort(const std::list<Analyzer::OrderEntry>& order_entries,
+                             const Executor* executor) {
+  auto timer = DEBUG_TIMER(__func__);
+  const size_t nthreads = cpu_threads();
+  using PermutationRange = std::pair<PermutationIdx, PermutationIdx>;
+
+  // Collect the non-empty entries of nthreads subranges in parallel.
+  permutation_.resize(query_mem_desc_.getEntryCount());
+  std::vector<PermutationView> permutation_views(nthreads);
+  threadpool::FuturesThreadPool<void> init_threads;
+  for (auto interval : makeIntervals<PermutationIdx>(0, permutation_.size(), nthreads)) {
+    init_threads.spawn(
+        [this, &permutation_views](const auto interval) {
+          PermutationView pv(permutation_.data() + interval.begin, 0, interval.size());
+          permutation_views[interval.index] =
+              initPermutationBuffer(pv, interval.begin, interval.end);
+        },
+        interval);
+  }
+  init_threads.join();
+  auto end = permutation_.begin() + permutation_views.front().size();
+  for (size_t i = 1; i < nthreads; ++i) {
+    std::copy(permutation_views[i].begin(), permutation_views[i].end(), end);
+    end += permutation_views[i].size();
+  }
+  permutation_.resize(end - permutation_.begin());
+
+  // A single comparator, which materializes the columns it needs once, is shared by all
+  // the threads. It is passed by reference, std::sort and std::inplace_merge would copy
+  // it along with those columns otherwise.
+  PermutationView pv(permutation_.data(), permutation_.size());
+  const auto compare = createComparator(order_entries, pv, executor, false);
+
+  // Sort nthreads runs in parallel, then merge pairs of adjacent runs in parallel until
+  // one is left.
+  std::vector<PermutationRange> runs;
+  threadpool::FuturesThreadPool<void> sort_threads;
+  for (auto interval : makeIntervals<PermutationIdx>(0, permutation_.size(), nthreads)) {
+    if (interval.begin == interval.end) {
+      continue;
+    }
+    runs.emplace_back(interval.begin, interval.end);
+    sort_threads.spawn(
+        [this, &compare](const PermutationIdx begin, const PermutationIdx end) {
+          std::sort(permutation_.begin() + begin,
+                    permutation_.begin() + end,
+                    std::cref(compare));
+        },
+        interval.begin,
+        interval.end);
+  }
+  sort_threads.join();
+  while (runs.size() > 1) {
+    std::vector<PermutationRange> merged_runs;
+    threadpool::FuturesThreadPool<void> merge_threads;
+    for (size_t i = 0; i + 1 < runs.size(); i += 2) {
+      CHECK_EQ(runs[i].second, runs[i + 1].first);
+      merged_runs.emplace_back(runs[i].first, runs[i + 1].second);
+      merge_threads.spawn(
+          [this, &compare](const PermutationIdx begin,
+                           const PermutationIdx middle,
+                           const PermutationIdx end) {
+            std::inplace_merge(permutation_.begin() + begin,
+                               permutation_.begin() + middle,
+                               permutation_.begin() + end,
+                               std::cref(compare));
+          },
+          runs[i].first,
+          runs[i].second,
+          runs[i + 1].second);
+    }
+    if (runs.size() % 2) {
+      merged_runs.push_back(runs.back());
+    }
+    merge_threads.join();
+    runs.swap(merged_runs);
+  }
+  permutation_.shrink_to_fit();
+}
+
 std::pair<size_t, size_t> ResultSet::getStorageIndex(const size_t entry_idx) const {
   size_t fixedup_entry_idx = entry_idx;
   auto entry_count = storage_->query_mem_desc_.getEntryCount();
@@ -696,6 +846,24 @@ ResultSet::ApproxQuantileBuffers ResultSet::ResultSetComparator<
   return approx_quantile_materialized_buffers;
 }
 
+template <typename BUFFER_ITERATOR_TYPE>
+std::vector<std::shared_ptr<const std::vector<int32_t>>> ResultSet::ResultSetComparator<
+    BUFFER_ITERATOR_TYPE>::materializeStringRanks() const {
+  std::vector<std::shared_ptr<const std::vector<int32_t>>> string_ranks;
+  for (const auto& order_entry : order_entries_) {
+    const auto entry_ti = get_compact_type(result_set_->targets_[order_entry.tle_no - 1]);
+    if (entry_ti.is_string() && entry_ti.get_compression() == kENCODING_DICT &&
+        executor_) {
+      const auto string_dict_proxy = executor_->getStringDictionaryProxy(
+          entry_ti.get_comp_param(), result_set_->row_set_mem_owner_, false);
+      string_ranks.push_back(string_dict_proxy->getSortedRanks(permutation_.size()));
+    } else {
+      string_ranks.emplace_back();
+    }
+  }
+  return string_ranks;
+}
+
 template <typename BUFFER_ITERATOR_TYPE>
 std::vector<int64_t>
 ResultSet::ResultSetComparator<BUFFER_ITERATOR_TYPE>::materializeCountDistinctColumn(
@@ -785,9 +953,11 @@ bool ResultSet::ResultSetComparator<BUFFER_ITERATOR_TYPE>::operator()(
   const auto fixedup_rhs = rhs_storage_lookup_result.fixedup_entry_idx;
   size_t materialized_count_distinct_buffer_idx{0};
   size_t materialized_approx_quantile_buffer_idx{0};
+  size_t order_entry_idx{0};
 
   for (const auto& order_entry : order_entries_) {
     CHECK_GE(order_entry.tle_no, 1);
+    const auto& string_ranks = string_ranks_[order_entry_idx++];
     const auto& agg_info = result_set_->targets_[order_entry.tle_no - 1];
     const auto entry_ti = get_compact_type(agg_info);
     bool float_argument_input = takes_float_argument(agg_info);
@@ -867,6 +1037,21 @@ bool ResultSet::ResultSetComparator<BUFFER_ITERATOR_TYPE>::operator()(
       if (UNLIKELY(entry_ti.is_string() &&
                    entry_ti.get_compression() == kENCODING_DICT)) {
         CHECK_EQ(4, entry_ti.get_logical_size());
+        if (string_ranks) {
+          const auto lhs_id = static_cast<int32_t>(lhs_v.i1);
+          const auto rhs_id = static_cast<int32_t>(rhs_v.i1);
+          // Transient strings aren't ranked, nor are ids of a later generation.
+          if (lhs_id >= 0 && rhs_id >= 0 &&
+              static_cast<size_t>(lhs_id) < string_ranks->size() &&
+              static_cast<size_t>(rhs_id) < string_ranks->size()) {
+            const auto lhs_rank = (*string_ranks)[lhs_id];
+            const auto rhs_rank = (*string_ranks)[rhs_id];
+            if (lhs_rank == rhs_rank) {
+              continue;
+            }
+            return (lhs_rank < rhs_rank) != order_entry.is_desc;
+          }
+        }
         CHECK(executor_);
         const auto string_dict_proxy = executor_->getStringDictionaryProxy(
             entry_ti.get_comp_param(), result_set_->row_set_mem_owner_, false);
@@ -243,6 +243,12 @@ class ResultSet {
 
   std::vector<TargetValue> getRowAt(const size_t index) const;
 
+  // Random access getter with the conversions of getNextRow(). Unlike getNextRow(), it
+  // ignores the limit and the offset of truncated result sets.
+  std::vector<TargetValue> getRowAt(const size_t index,
+                                    const bool translate_strings,
+                                    const bool decimal_to_double) const;
+
   TargetValue getRowAt(const size_t row_idx,
                        const size_t col_idx,
                        const bool translate_strings,
@@ -257,6 +263,21 @@ class ResultSet {
       const size_t index,
       const std::vector<bool>& targets_to_skip = {}) const;
 
+  // Fetches up to max_rows rows with the conversions and the cursor of getNextRow(),
+  // one ColumnBatch per column. Returns the number of rows fetched, 0 at the end.
+  size_t getNextRowBatch(const size_t max_rows,
+                         const bool translate_strings,
+                         const bool decimal_to_double,
+                         std::vector<ColumnBatch>& columns) const;
+
+  // Random access counterpart of getNextRowBatch() over the logical indices
+  // [first_index, first_index + index_count), skipping empty entries like getRowAt().
+  size_t getRowBatchAt(const size_t first_index,
+                       const size_t index_count,
+                       const bool translate_strings,
+                       const bool decimal_to_double,
+                       std::vector<ColumnBatch>& columns) const;
+
   bool isRowAtEmpty(const size_t index) const;
 
   void sort(const std::list<Analyzer::OrderEntry>& order_entries,
@@ -349,6 +370,10 @@ class ResultSet {
 
   void initializeStorage() const;
 
+  // Multiplies the COUNT and SUM targets by `factor`, which turns their values over a
+  // sample of the input into estimates of their values over the whole input.
+  void scaleAggregates(const double factor);
+
   void holdChunks(const std::list<std::shared_ptr<Chunk_NS::Chunk>>& chunks) {
     chunks_ = chunks;
   }
@@ -422,6 +447,8 @@ class ResultSet {
     separate_varlen_storage_valid_ = val;
   }
 
+  bool isSeparateVarlenStorageValid() const { return separate_varlen_storage_valid_; }
+
   std::shared_ptr<const std::vector<std::string>> getStringDictionaryPayloadCopy(
       const int dict_id) const;
 
@@ -447,6 +474,30 @@ class ResultSet {
                                     const bool fixup_count_distinct_pointers,
                                     const std::vector<bool>& targets_to_skip = {}) const;
 
+  // Decodes the targets of a non-empty entry and hands them to consume(target_idx,
+  // TargetValue&&), so that callers don't need to collect a row first.
+  template <typename TARGET_VALUE_CONSUMER>
+  void visitRowAt(const ResultSetStorage* storage,
+                  const size_t local_entry_idx,
+                  const size_t global_entry_idx,
+                  const bool translate_strings,
+                  const bool decimal_to_double,
+                  const bool fixup_count_distinct_pointers,
+                  const std::vector<bool>& targets_to_skip,
+                  TARGET_VALUE_CONSUMER&& consume) const;
+
+  // Moves the cursor to the next entry within the limit and the offset, returns false
+  // once the result set is exhausted.
+  bool advanceToNextRow(size_t& entry_buff_idx) const;
+
+  std::vector<SQLTypeInfo> getColTypes() const;
+
+  bool appendRowToBatch(const size_t global_entry_idx,
+                        const bool translate_strings,
+                        const bool decimal_to_double,
+                        const std::vector<SQLTypeInfo>& col_types,
+                        std::vector<ColumnBatch>& columns) const;
+
   // NOTE: just for direct columnarization use at the moment
   template <typename ENTRY_TYPE>
   ENTRY_TYPE getColumnarPerfectHashEntryAt(const size_t row_idx,
@@ -472,6 +523,10 @@ class ResultSet {
 
   size_t parallelRowCount() const;
 
+  // Ascending indices of the non-empty entries of a result set without a permutation,
+  // found in parallel on first use and kept for the cursor and the sort.
+  const Permutation& getNonEmptyEntries() const;
+
   size_t advanceCursorToNextEntry() const;
 
   void radixSortOnGpu(const std::list<Analyzer::OrderEntry>& order_entries) const;
@@ -637,12 +692,17 @@ class ResultSet {
         , buffer_itr_(result_set)
         , executor_(executor)
         , single_threaded_(single_threaded)
-        , approx_quantile_materialized_buffers_(materializeApproxQuantileColumns()) {
+        , approx_quantile_materialized_buffers_(materializeApproxQuantileColumns())
+        , string_ranks_(materializeStringRanks()) {
       materializeCountDistinctColumns();
     }
 
     void materializeCountDistinctColumns();
     ApproxQuantileBuffers materializeApproxQuantileColumns() const;
+    // Per order entry, the ranks of the strings of a dictionary encoded column if worth
+    // building, which then get compared instead of the strings.
+    std::vector<std::shared_ptr<const std::vector<int32_t>>> materializeStringRanks()
+        const;
 
     std::vector<int64_t> materializeCountDistinctColumn(
         const Analyzer::OrderEntry& order_entry) const;
@@ -659,6 +719,7 @@ class ResultSet {
     const bool single_threaded_;
     std::vector<std::vector<int64_t>> count_distinct_materialized_buffers_;
     const ApproxQuantileBuffers approx_quantile_materialized_buffers_;
+    const std::vector<std::shared_ptr<const std::vector<int32_t>>> string_ranks_;
   };
 
   Comparator createComparator(const std::list<Analyzer::OrderEntry>& order_entries,
@@ -693,6 +754,10 @@ class ResultSet {
                    const size_t top_n,
                    const Executor* executor);
 
+  // Full sort of the permutation, sorting subranges in parallel before merging them.
+  void parallelSort(const std::list<Analyzer::OrderEntry>& order_entries,
+                    const Executor* executor);
+
   void baselineSort(const std::list<Analyzer::OrderEntry>& order_entries,
                     const size_t top_n,
                     const Executor* executor);
@@ -768,6 +833,9 @@ class ResultSet {
   bool for_validation_only_;
   mutable std::atomic<int64_t> cached_row_count_;
   mutable std::mutex row_iteration_mutex_;
+  mutable Permutation non_empty_entries_;
+  mutable std::atomic<bool> non_empty_entries_valid_{false};
+  mutable std::mutex non_empty_entries_mutex_;
 
   // only used by geo
   mutable GeoReturnType geo_return_type_;
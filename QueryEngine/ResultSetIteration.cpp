@@ -116,25 +116,17 @@ size_t result_set::get_byteoff_of_slot(const size_t slot_idx,
   return query_mem_desc.getPaddedColWidthForRange(0, slot_idx);
 }
 
-std::vector<TargetValue> ResultSet::getRowAt(
-    const size_t global_entry_idx,
-    const bool translate_strings,
-    const bool decimal_to_double,
-    const bool fixup_count_distinct_pointers,
-    const std::vector<bool>& targets_to_skip /* = {}*/) const {
-  const auto storage_lookup_result =
-      fixup_count_distinct_pointers
-          ? StorageLookupResult{storage_.get(), global_entry_idx, 0}
-          : findStorage(global_entry_idx);
-  const auto storage = storage_lookup_result.storage_ptr;
-  const auto local_entry_idx = storage_lookup_result.fixedup_entry_idx;
-  if (!fixup_count_distinct_pointers && storage->isEmptyEntry(local_entry_idx)) {
-    return {};
-  }
-
+template <typename TARGET_VALUE_CONSUMER>
+void ResultSet::visitRowAt(const ResultSetStorage* storage,
+                           const size_t local_entry_idx,
+                           const size_t global_entry_idx,
+                           const bool translate_strings,
+                           const bool decimal_to_double,
+                           const bool fixup_count_distinct_pointers,
+                           const std::vector<bool>& targets_to_skip,
+                           TARGET_VALUE_CONSUMER&& consume) const {
   const auto buff = storage->buff_;
   CHECK(buff);
-  std::vector<TargetValue> row;
   size_t agg_col_idx = 0;
   int8_t* rowwise_target_ptr{nullptr};
   int8_t* keys_ptr{nullptr};
@@ -152,20 +144,9 @@ std::vector<TargetValue> ResultSet::getRowAt(
     const auto& agg_info = storage->targets_[target_idx];
     if (query_mem_desc_.didOutputColumnar()) {
       if (UNLIKELY(!targets_to_skip.empty())) {
-        row.push_back(!targets_to_skip[target_idx]
-                          ? getTargetValueFromBufferColwise(crt_col_ptr,
-                                                            keys_ptr,
-                                                            storage->query_mem_desc_,
-                                                            local_entry_idx,
-                                                            global_entry_idx,
-                                                            agg_info,
-                                                            target_idx,
-                                                            agg_col_idx,
-                                                            translate_strings,
-                                                            decimal_to_double)
-                          : nullptr);
-      } else {
-        row.push_back(getTargetValueFromBufferColwise(crt_col_ptr,
+        consume(target_idx,
+                !targets_to_skip[target_idx]
+                    ? getTargetValueFromBufferColwise(crt_col_ptr,
                                                       keys_ptr,
                                                       storage->query_mem_desc_,
                                                       local_entry_idx,
@@ -174,7 +155,20 @@ std::vector<TargetValue> ResultSet::getRowAt(
                                                       target_idx,
                                                       agg_col_idx,
                                                       translate_strings,
-                                                      decimal_to_double));
+                                                      decimal_to_double)
+                    : nullptr);
+      } else {
+        consume(target_idx,
+                getTargetValueFromBufferColwise(crt_col_ptr,
+                                                keys_ptr,
+                                                storage->query_mem_desc_,
+                                                local_entry_idx,
+                                                global_entry_idx,
+                                                agg_info,
+                                                target_idx,
+                                                agg_col_idx,
+                                                translate_strings,
+                                                decimal_to_double));
       }
       crt_col_ptr = advance_target_ptr_col_wise(crt_col_ptr,
                                                 agg_info,
@@ -183,19 +177,9 @@ std::vector<TargetValue> ResultSet::getRowAt(
                                                 separate_varlen_storage_valid_);
     } else {
       if (UNLIKELY(!targets_to_skip.empty())) {
-        row.push_back(!targets_to_skip[target_idx]
-                          ? getTargetValueFromBufferRowwise(rowwise_target_ptr,
-                                                            keys_ptr,
-                                                            global_entry_idx,
-                                                            agg_info,
-                                                            target_idx,
-                                                            agg_col_idx,
-                                                            translate_strings,
-                                                            decimal_to_double,
-                                                            fixup_count_distinct_pointers)
-                          : nullptr);
-      } else {
-        row.push_back(getTargetValueFromBufferRowwise(rowwise_target_ptr,
+        consume(target_idx,
+                !targets_to_skip[target_idx]
+                    ? getTargetValueFromBufferRowwise(rowwise_target_ptr,
                                                       keys_ptr,
                                                       global_entry_idx,
                                                       agg_info,
@@ -203,7 +187,19 @@ std::vector<TargetValue> ResultSet::getRowAt(
                                                       agg_col_idx,
                                                       translate_strings,
                                                       decimal_to_double,
-                                                      fixup_count_distinct_pointers));
+                                                      fixup_count_distinct_pointers)
+                    : nullptr);
+      } else {
+        consume(target_idx,
+                getTargetValueFromBufferRowwise(rowwise_target_ptr,
+                                                keys_ptr,
+                                                global_entry_idx,
+                                                agg_info,
+                                                target_idx,
+                                                agg_col_idx,
+                                                translate_strings,
+                                                decimal_to_double,
+                                                fixup_count_distinct_pointers));
       }
       rowwise_target_ptr = advance_target_ptr_row_wise(rowwise_target_ptr,
                                                        agg_info,
@@ -213,7 +209,34 @@ std::vector<TargetValue> ResultSet::getRowAt(
     }
     agg_col_idx = advance_slot(agg_col_idx, agg_info, separate_varlen_storage_valid_);
   }
+}
 
+std::vector<TargetValue> ResultSet::getRowAt(
+    const size_t global_entry_idx,
+    const bool translate_strings,
+    const bool decimal_to_double,
+    const bool fixup_count_distinct_pointers,
+    const std::vector<bool>& targets_to_skip /* = {}*/) const {
+  const auto storage_lookup_result =
+      fixup_count_distinct_pointers
+          ? StorageLookupResult{storage_.get(), global_entry_idx, 0}
+          : findStorage(global_entry_idx);
+  const auto storage = storage_lookup_result.storage_ptr;
+  const auto local_entry_idx = storage_lookup_result.fixedup_entry_idx;
+  if (!fixup_count_distinct_pointers && storage->isEmptyEntry(local_entry_idx)) {
+    return {};
+  }
+
+  std::vector<TargetValue> row;
+  row.reserve(storage->targets_.size());
+  visitRowAt(storage,
+             local_entry_idx,
+             global_entry_idx,
+             translate_strings,
+             decimal_to_double,
+             fixup_count_distinct_pointers,
+             targets_to_skip,
+             [&row](const size_t, TargetValue&& tv) { row.push_back(std::move(tv)); });
   return row;
 }
 
@@ -271,6 +294,17 @@ std::vector<TargetValue> ResultSet::getRowAt(const size_t logical_index) const {
   return getRowAt(entry_idx, true, false, false);
 }
 
+std::vector<TargetValue> ResultSet::getRowAt(const size_t logical_index,
+                                             const bool translate_strings,
+                                             const bool decimal_to_double) const {
+  if (logical_index >= entryCount()) {
+    return {};
+  }
+  const auto entry_idx =
+      permutation_.empty() ? logical_index : permutation_[logical_index];
+  return getRowAt(entry_idx, translate_strings, decimal_to_double, false);
+}
+
 std::vector<TargetValue> ResultSet::getRowAtNoTranslations(
     const size_t logical_index,
     const std::vector<bool>& targets_to_skip /* = {}*/) const {
@@ -319,26 +353,186 @@ std::vector<TargetValue> ResultSet::getNextRowUnlocked(
 std::vector<TargetValue> ResultSet::getNextRowImpl(const bool translate_strings,
                                                    const bool decimal_to_double) const {
   size_t entry_buff_idx = 0;
+  if (!advanceToNextRow(entry_buff_idx)) {
+    return {};
+  }
+
+  auto row = getRowAt(entry_buff_idx, translate_strings, decimal_to_double, false);
+  CHECK(!row.empty());
+
+  return row;
+}
+
+bool ResultSet::advanceToNextRow(size_t& entry_buff_idx) const {
   do {
     if (keep_first_ && fetched_so_far_ >= drop_first_ + keep_first_) {
-      return {};
+      return false;
     }
 
     entry_buff_idx = advanceCursorToNextEntry();
 
     if (crt_row_buff_idx_ >= entryCount()) {
       CHECK_EQ(entryCount(), crt_row_buff_idx_);
-      return {};
+      return false;
     }
     ++crt_row_buff_idx_;
     ++fetched_so_far_;
 
   } while (drop_first_ && fetched_so_far_ <= drop_first_);
+  return true;
+}
 
-  auto row = getRowAt(entry_buff_idx, translate_strings, decimal_to_double, false);
-  CHECK(!row.empty());
+size_t ResultSet::getNextRowBatch(const size_t max_rows,
+                                  const bool translate_strings,
+                                  const bool decimal_to_double,
+                                  std::vector<ColumnBatch>& columns) const {
+  std::lock_guard<std::mutex> lock(row_iteration_mutex_);
+  columns.resize(just_explain_ ? 1 : colCount());
+  for (auto& column : columns) {
+    column.clear();
+  }
+  if (!storage_ && !just_explain_) {
+    return 0;
+  }
+  if (just_explain_) {
+    if (fetched_so_far_ || !max_rows) {
+      return 0;
+    }
+    fetched_so_far_ = 1;
+    columns.front().append(TargetValue(explanation_), SQLTypeInfo(kTEXT, false));
+    return 1;
+  }
+  const auto col_types = getColTypes();
+  size_t row_count = 0;
+  size_t entry_buff_idx = 0;
+  while (row_count < max_rows && advanceToNextRow(entry_buff_idx)) {
+    appendRowToBatch(entry_buff_idx,
+                     translate_strings,
+                     decimal_to_double,
+                     col_types,
+                     columns);
+    ++row_count;
+  }
+  return row_count;
+}
 
-  return row;
+size_t ResultSet::getRowBatchAt(const size_t first_index,
+                                const size_t index_count,
+                                const bool translate_strings,
+                                const bool decimal_to_double,
+                                std::vector<ColumnBatch>& columns) const {
+  columns.resize(colCount());
+  for (auto& column : columns) {
+    column.clear();
+  }
+  const auto col_types = getColTypes();
+  const auto end_index = std::min(first_index + index_count, entryCount());
+  size_t row_count = 0;
+  for (size_t logical_index = first_index; logical_index < end_index; ++logical_index) {
+    const auto entry_idx =
+        permutation_.empty() ? logical_index : permutation_[logical_index];
+    if (appendRowToBatch(
+            entry_idx, translate_strings, decimal_to_double, col_types, columns)) {
+      ++row_count;
+    }
+  }
+  return row_count;
+}
+
+std::vector<SQLTypeInfo> ResultSet::getColTypes() const {
+  std::vector<SQLTypeInfo> col_types;
+  col_types.reserve(colCount());
+  for (size_t col_idx = 0; col_idx < colCount(); ++col_idx) {
+    col_types.push_back(getColType(col_idx));
+  }
+  return col_types;
+}
+
+bool ResultSet::appendRowToBatch(const size_t global_entry_idx,
+                                 const bool translate_strings,
+                                 const bool decimal_to_double,
+                                 const std::vector<SQLTypeInfo>& col_types,
+                                 std::vector<ColumnBatch>& columns) const {
+  const auto storage_lookup_result = findStorage(global_entry_idx);
+  const auto storage = storage_lookup_result.storage_ptr;
+  const auto local_entry_idx = storage_lookup_result.fixedup_entry_idx;
+  if (storage->isEmptyEntry(local_entry_idx)) {
+    return false;
+  }
+  visitRowAt(storage,
+             local_entry_idx,
+             global_entry_idx,
+             translate_strings,
+             decimal_to_double,
+             false,
+             {},
+             [&columns, &col_types](const size_t target_idx, TargetValue&& tv) {
+               columns[target_idx].append(std::move(tv), col_types[target_idx]);
+             });
+  return true;
+}
+
+namespace {
+
+bool is_null_int_value(const int64_t value, const SQLTypeInfo& ti) {
+  if (ti.is_string()) {
+    // Dictionary ids read without translate_strings.
+    return value == NULL_INT;
+  }
+  switch (ti.get_type()) {
+    case kBOOLEAN:
+      return value == NULL_BOOLEAN;
+    case kTINYINT:
+      return value == NULL_TINYINT;
+    case kSMALLINT:
+      return value == NULL_SMALLINT;
+    case kINT:
+      return value == NULL_INT;
+    case kBIGINT:
+    case kNUMERIC:
+    case kDECIMAL:
+    case kTIME:
+    case kTIMESTAMP:
+    case kDATE:
+    case kINTERVAL_DAY_TIME:
+    case kINTERVAL_YEAR_MONTH:
+      return value == NULL_BIGINT;
+    default:
+      return false;
+  }
+}
+
+}  // namespace
+
+void ColumnBatch::append(TargetValue&& tv, const SQLTypeInfo& ti) {
+  auto scalar_tv = boost::get<ScalarTargetValue>(&tv);
+  if (!scalar_tv) {
+    values.push_back(std::move(tv));
+    nulls.push_back(false);
+    return;
+  }
+  bool is_null{false};
+  if (const auto int_value = boost::get<int64_t>(scalar_tv)) {
+    int_values.push_back(*int_value);
+    is_null = is_null_int_value(*int_value, ti);
+  } else if (const auto double_value = boost::get<double>(scalar_tv)) {
+    double_values.push_back(*double_value);
+    is_null = ti.get_type() == kFLOAT ? *double_value == NULL_FLOAT
+                                      : *double_value == NULL_DOUBLE;
+  } else if (const auto float_value = boost::get<float>(scalar_tv)) {
+    float_values.push_back(*float_value);
+    is_null = *float_value == NULL_FLOAT;
+  } else {
+    auto s_n = boost::get<NullableString>(scalar_tv);
+    CHECK(s_n);
+    if (auto s = boost::get<std::string>(s_n)) {
+      str_values.push_back(std::move(*s));
+    } else {
+      str_values.emplace_back();
+      is_null = true;
+    }
+  }
+  nulls.push_back(is_null && !ti.get_notnull());
 }
 
 namespace {
@@ -692,6 +886,19 @@ void ResultSet::advanceCursorToNextEntry(ResultSetRowIterator& iter) const {
     return;
   }
 
+  if (permutation_.empty() && non_empty_entries_valid_) {
+    // Jump to the next non-empty entry, past the ones dropped by the offset.
+    auto it = std::lower_bound(
+        non_empty_entries_.begin(), non_empty_entries_.end(), iter.crt_row_buff_idx_);
+    if (iter.fetched_so_far_ < drop_first_) {
+      const auto dropped =
+          std::min(drop_first_ - iter.fetched_so_far_,
+                   static_cast<size_t>(non_empty_entries_.end() - it));
+      it += dropped;
+      iter.fetched_so_far_ += dropped;
+    }
+    iter.crt_row_buff_idx_ = it == non_empty_entries_.end() ? entryCount() : *it;
+  }
   while (iter.crt_row_buff_idx_ < entryCount()) {
     const auto entry_idx = permutation_.empty() ? iter.crt_row_buff_idx_
                                                 : permutation_[iter.crt_row_buff_idx_];
@@ -727,6 +934,12 @@ void ResultSet::advanceCursorToNextEntry(ResultSetRowIterator& iter) const {
 // Not all entries in the buffer represent a valid row. Advance the internal cursor
 // used for the getNextRow method to the next row which is valid.
 size_t ResultSet::advanceCursorToNextEntry() const {
+  if (permutation_.empty() && non_empty_entries_valid_) {
+    const auto it = std::lower_bound(
+        non_empty_entries_.begin(), non_empty_entries_.end(), crt_row_buff_idx_);
+    crt_row_buff_idx_ = it == non_empty_entries_.end() ? entryCount() : *it;
+    return crt_row_buff_idx_;
+  }
   while (crt_row_buff_idx_ < entryCount()) {
     const auto entry_idx =
         permutation_.empty() ? crt_row_buff_idx_ : permutation_[crt_row_buff_idx_];
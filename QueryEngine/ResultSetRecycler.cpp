@@ -0,0 +1,124 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "QueryEngine/ResultSetRecycler.h"
+
+#include <algorithm>
+
+#include "Logger/Logger.h"
+
+size_t g_result_set_recycler_max_bytes{0};
+
+namespace {
+
+bool is_shareable(const ExecutionResult& result) {
+  const auto& rows = result.getDataPtr();
+  if (!rows || result.isFilterPushDownEnabled() || !rows->getStorage() ||
+      rows->isExplain()) {
+    return false;
+  }
+  // Lazily fetched columns point into the chunks of the input tables.
+  const auto& lazy_fetch_info = rows->getLazyFetchInfo();
+  if (std::any_of(lazy_fetch_info.begin(),
+                  lazy_fetch_info.end(),
+                  [](const ColumnLazyFetchInfo& col_lazy_fetch_info) {
+                    return col_lazy_fetch_info.is_lazily_fetched;
+                  })) {
+    return false;
+  }
+  // Dictionary encoded results may hold transient string ids, which are only known to
+  // the string dictionary proxies of the query that computed them.
+  const auto& targets_meta = result.getTargetsMeta();
+  return std::none_of(
+      targets_meta.begin(), targets_meta.end(), [](const TargetMetaInfo& target_meta) {
+        return target_meta.get_type_info().is_dict_encoded_type();
+      });
+}
+
+}  // namespace
+
+ResultSetRecycler& ResultSetRecycler::instance() {
+  static ResultSetRecycler result_set_recycler;
+  return result_set_recycler;
+}
+
+std::optional<ExecutionResult> ResultSetRecycler::get(const std::string& key) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    return std::nullopt;
+  }
+  // A result held by another query may be in the middle of an iteration, a query which
+  // gets the result holds it until it is done with it.
+  if (it->second.result.getDataPtr().use_count() > 1) {
+    VLOG(1) << "Not recycling a result set in use by another query.";
+    return std::nullopt;
+  }
+  lru_.splice(lru_.begin(), lru_, it->second.lru_it);
+  return it->second.result;
+}
+
+void ResultSetRecycler::put(const std::string& key, const ExecutionResult& result) {
+  if (!is_shareable(result)) {
+    return;
+  }
+  const auto size_bytes =
+      key.size() + result.getDataPtr()->getBufferSizeBytes(ExecutorDeviceType::CPU);
+  if (size_bytes > g_result_set_recycler_max_bytes) {
+    VLOG(1) << "Not recycling a result set of " << size_bytes
+            << " bytes, over the recycler budget of " << g_result_set_recycler_max_bytes
+            << " bytes.";
+    return;
+  }
+  std::lock_guard<std::mutex> guard(mutex_);
+  auto it = entries_.find(key);
+  if (it != entries_.end()) {
+    size_bytes_ -= it->second.size_bytes;
+    it->second.result = result;
+    it->second.size_bytes = size_bytes;
+    lru_.splice(lru_.begin(), lru_, it->second.lru_it);
+  } else {
+    it = entries_.emplace(key, CacheEntry{result, size_bytes, {}}).first;
+    lru_.push_front(&it->first);
+    it->second.lru_it = lru_.begin();
+  }
+  size_bytes_ += size_bytes;
+  evictUnlocked();
+}
+
+void ResultSetRecycler::clear() {
+  std::lock_guard<std::mutex> guard(mutex_);
+  VLOG(1) << "Invalidating " << entries_.size() << " recycled result sets.";
+  entries_.clear();
+  lru_.clear();
+  size_bytes_ = 0;
+}
+
+size_t ResultSetRecycler::getNumberOfCachedResults() {
+  std::lock_guard<std::mutex> guard(mutex_);
+  return entries_.size();
+}
+
+void ResultSetRecycler::evictUnlocked() {
+  while (size_bytes_ > g_result_set_recycler_max_bytes) {
+    CHECK(!lru_.empty());
+    auto it = entries_.find(*lru_.back());
+    CHECK(it != entries_.end());
+    size_bytes_ -= it->second.size_bytes;
+    lru_.pop_back();
+    entries_.erase(it);
+  }
+}
@@ -0,0 +1,78 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <functional>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+#include "QueryEngine/Descriptors/RelAlgExecutionDescriptor.h"
+
+// Byte budget of the recycled intermediate results, 0 disables the recycler.
+extern size_t g_result_set_recycler_max_bytes;
+
+/**
+ * Server wide cache of the results of subqueries and intermediate query steps, so that
+ * later queries sharing the same step reuse its result as a temporary table. Keys are
+ * the serialized subtree of the step in the query plan and the state (row counts and
+ * epochs) of the tables it reads, computed by the RelAlgExecutor; updates and deletes
+ * clear the recycler through the update and delete triggered cache invalidators.
+ *
+ * Result sets carry iteration state, so a cached result is only handed out while no
+ * other query holds it. A cached result keeps the memory of the query which computed it
+ * alive, `g_result_set_recycler_max_bytes` only bounds the keys and the result buffers
+ * themselves.
+ */
+class ResultSetRecycler {
+ public:
+  static ResultSetRecycler& instance();
+
+  static std::function<void()> getCacheInvalidator() {
+    return []() -> void { instance().clear(); };
+  }
+
+  // Returns the result cached for `key`, unless there is none or it is in use.
+  std::optional<ExecutionResult> get(const std::string& key);
+
+  // Caches `result` if its result set can be shared across queries.
+  void put(const std::string& key, const ExecutionResult& result);
+
+  void clear();
+
+  // For testing purposes only
+  size_t getNumberOfCachedResults();
+
+ private:
+  ResultSetRecycler() {}
+
+  void evictUnlocked();
+
+  struct CacheEntry {
+    ExecutionResult result;
+    size_t size_bytes;
+    // Position in lru_, the most recently used results come first.
+    std::list<const std::string*>::iterator lru_it;
+  };
+
+  std::unordered_map<std::string, CacheEntry> entries_;
+  std::list<const std::string*> lru_;
+  size_t size_bytes_{0};
+  std::mutex mutex_;
+};
@@ -28,9 +28,11 @@
 #include "ResultSetReductionInterpreter.h"
 #include "ResultSetReductionJIT.h"
 #include "RuntimeFunctions.h"
+#include "Shared/Intervals.h"
 #include "Shared/SqlTypesLayout.h"
 #include "Shared/likely.h"
 #include "Shared/thread_count.h"
+#include "Shared/threadpool.h"
 
 #include <llvm/ExecutionEngine/GenericValue.h>
 
@@ -1040,6 +1042,44 @@ void ResultSet::initializeStorage() const {
 // Driver for reductions. Needed because the result of a reduction on the baseline
 // layout, which can have collisions, cannot be done in place and something needs
 // to take the ownership of the new result set with the bigger underlying buffer.
+void ResultSetStorage::reduceAll(const std::vector<const ResultSetStorage*>& storages,
+                                 const ReductionCode& reduction_code) {
+  CHECK(!storages.empty());
+  const auto& query_mem_desc = storages.front()->query_mem_desc_;
+  if (storages.size() < 3 || cpu_threads() < 2 ||
+      query_mem_desc.getQueryDescriptionType() ==
+          QueryDescriptionType::GroupByBaselineHash ||
+      use_multithreaded_reduction(query_mem_desc.getEntryCount())) {
+    for (size_t i = 1; i < storages.size(); ++i) {
+      storages.front()->reduce(*storages[i], {}, reduction_code);
+    }
+    return;
+  }
+  // Each round reduces the storage at every odd position into the one before it.
+  auto round_storages = storages;
+  while (round_storages.size() > 1) {
+    const size_t pair_count = round_storages.size() / 2;
+    threadpool::FuturesThreadPool<void> reduction_threads;
+    for (auto interval : makeIntervals<size_t>(0, pair_count, cpu_threads())) {
+      reduction_threads.spawn(
+          [&round_storages, &reduction_code](const size_t begin, const size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+              round_storages[2 * i]->reduce(
+                  *round_storages[2 * i + 1], {}, reduction_code);
+            }
+          },
+          interval.begin,
+          interval.end);
+    }
+    reduction_threads.join();
+    std::vector<const ResultSetStorage*> next_round_storages;
+    for (size_t i = 0; i < round_storages.size(); i += 2) {
+      next_round_storages.push_back(round_storages[i]);
+    }
+    round_storages.swap(next_round_storages);
+  }
+}
+
 ResultSet* ResultSetManager::reduce(std::vector<ResultSet*>& result_sets) {
   CHECK(!result_sets.empty());
   auto result_rs = result_sets.front();
@@ -1107,15 +1147,20 @@ ResultSet* ResultSetManager::reduce(std::vector<ResultSet*>& result_sets) {
                                       result_rs->getTargetInfos(),
                                       result_rs->getTargetInitVals());
   auto reduction_code = reduction_jit.codegen();
+  if (serialized_varlen_buffer.empty()) {
+    std::vector<const ResultSetStorage*> storages{result};
+    for (auto result_it = result_sets.begin() + 1; result_it != result_sets.end();
+         ++result_it) {
+      storages.push_back((*result_it)->storage_.get());
+    }
+    ResultSetStorage::reduceAll(storages, reduction_code);
+    return result_rs;
+  }
   size_t ctr = 1;
   for (auto result_it = result_sets.begin() + 1; result_it != result_sets.end();
        ++result_it) {
-    if (!serialized_varlen_buffer.empty()) {
-      result->reduce(
-          *((*result_it)->storage_), serialized_varlen_buffer[ctr++], reduction_code);
-    } else {
-      result->reduce(*((*result_it)->storage_), {}, reduction_code);
-    }
+    result->reduce(
+        *((*result_it)->storage_), serialized_varlen_buffer[ctr++], reduction_code);
   }
   return result_rs;
 }
@@ -24,6 +24,7 @@
 
 #include "ResultSetStorage.h"
 
+#include "AggregateUtils.h"
 #include "DataMgr/Allocators/CudaAllocator.h"
 #include "DataMgr/BufferMgr/BufferMgr.h"
 #include "Execute.h"
@@ -39,6 +40,7 @@
 
 #include <algorithm>
 #include <bitset>
+#include <cmath>
 #include <future>
 #include <numeric>
 
@@ -84,6 +86,54 @@ int64_t ResultSetStorage::mappedPtr(const int64_t remote_ptr) const {
   return it->second;
 }
 
+void ResultSetStorage::scaleAggregates(const double factor) {
+  const bool is_columnar = query_mem_desc_.didOutputColumnar();
+  const auto entry_count = query_mem_desc_.getEntryCount();
+  for (size_t entry_idx = 0; entry_idx < entry_count; ++entry_idx) {
+    if (isEmptyEntry(entry_idx, buff_)) {
+      continue;
+    }
+    size_t slot_idx = 0;
+    for (const auto& target_info : targets_) {
+      const auto target_slot_idx = slot_idx;
+      slot_idx = advance_slot(slot_idx, target_info, false);
+      if (!target_info.is_agg || target_info.is_distinct ||
+          (target_info.agg_kind != kCOUNT && target_info.agg_kind != kSUM)) {
+        continue;
+      }
+      const bool float_argument_input = takes_float_argument(target_info);
+      const auto slot_bytes =
+          float_argument_input
+              ? sizeof(float)
+              : query_mem_desc_.getPaddedSlotWidthBytes(target_slot_idx);
+      auto slot_ptr =
+          is_columnar
+              ? buff_ + query_mem_desc_.getColOffInBytes(target_slot_idx) +
+                    entry_idx * query_mem_desc_.getPaddedSlotWidthBytes(target_slot_idx)
+              : row_ptr_rowwise(buff_, query_mem_desc_, entry_idx) +
+                    query_mem_desc_.getColOffInBytes(target_slot_idx);
+      const auto val = read_int_from_buff(slot_ptr, slot_bytes);
+      // A nullable sum slot is initialized to NULL, it still holds it if none of the rows
+      // of its group had a value.
+      const auto init_val = target_init_vals_[target_slot_idx];
+      if (target_info.agg_kind == kSUM && !target_info.sql_type.get_notnull() &&
+          val == read_int_from_buff(reinterpret_cast<const int8_t*>(&init_val),
+                                    slot_bytes)) {
+        continue;
+      }
+      if (target_info.sql_type.is_fp()) {
+        if (slot_bytes == sizeof(float)) {
+          *reinterpret_cast<float*>(slot_ptr) *= factor;
+        } else {
+          *reinterpret_cast<double*>(slot_ptr) *= factor;
+        }
+      } else {
+        set_component(slot_ptr, slot_bytes, std::llround(val * factor));
+      }
+    }
+  }
+}
+
 std::vector<int64_t> result_set::initialize_target_values_for_storage(
     const std::vector<TargetInfo>& targets) {
   std::vector<int64_t> target_init_vals;
@@ -107,9 +107,20 @@ class ResultSetStorage {
               const std::vector<std::string>& serialized_varlen_buffer,
               const ReductionCode& reduction_code) const;
 
+  // Reduces all the storages into the first one. Unless they're large enough for
+  // reduce() to use all the threads or use the baseline layout, where the first storage
+  // is the only one sized to hold all of them, pairs of storages are reduced in parallel
+  // rounds instead of one after another.
+  static void reduceAll(const std::vector<const ResultSetStorage*>& storages,
+                        const ReductionCode& reduction_code);
+
   void rewriteAggregateBufferOffsets(
       const std::vector<std::string>& serialized_varlen_buffer) const;
 
+  // Multiplies the non-distinct COUNT and SUM slots of the non-empty entries by
+  // `factor`, leaving the NULL sums of empty groups alone.
+  void scaleAggregates(const double factor);
+
   int8_t* getUnderlyingBuffer() const;
 
   size_t getEntryCount() const { return query_mem_desc_.getEntryCount(); }
@@ -336,6 +336,16 @@ extern "C" GPU_RT_STUB void agg_approximate_count_distinct_gpu(int64_t*,
                                                                const int64_t,
                                                                const int64_t) {}
 
+extern "C" ALWAYS_INLINE int32_t map_string_id(const int64_t id_map,
+                                              const int32_t string_id,
+                                              const int32_t entry_count,
+                                              const int32_t null_val) {
+  if (string_id < 0 || string_id >= entry_count) {
+    return null_val;
+  }
+  return reinterpret_cast<const int32_t*>(id_map)[string_id];
+}
+
 extern "C" ALWAYS_INLINE int8_t bit_is_set(const int64_t bitset,
                                            const int64_t val,
                                            const int64_t min_val,
@@ -358,6 +368,34 @@ extern "C" ALWAYS_INLINE int8_t bit_is_set(const int64_t bitset,
              : 0;
 }
 
+// Branchless binary search of the sorted, unique values of an IN set which is too sparse
+// for a bitmap.
+extern "C" ALWAYS_INLINE int8_t value_in_sorted_set(const int64_t sorted_set,
+                                                    const int64_t set_size,
+                                                    const int64_t val,
+                                                    const int64_t min_val,
+                                                    const int64_t max_val,
+                                                    const int64_t null_val,
+                                                    const int8_t null_bool_val) {
+  if (val == null_val) {
+    return null_bool_val;
+  }
+  if (val < min_val || val > max_val) {
+    return 0;
+  }
+  if (!sorted_set) {
+    return 0;
+  }
+  const auto values = reinterpret_cast<const int64_t*>(sorted_set);
+  int64_t base = 0;
+  for (int64_t n = set_size; n > 1;) {
+    const int64_t half = n >> 1;
+    base = values[base + half] <= val ? base + half : base;
+    n -= half;
+  }
+  return values[base] == val ? 1 : 0;
+}
+
 extern "C" ALWAYS_INLINE int64_t agg_sum(int64_t* agg, const int64_t val) {
   const auto old = *agg;
   *agg += val;
@@ -890,6 +928,24 @@ extern "C" GPU_RT_STUB int32_t agg_sum_int32_shared(int32_t* agg, const int32_t
   return 0;
 }
 
+extern "C" GPU_RT_STUB uint64_t agg_count_warp_shared(uint64_t* agg, const int64_t val) {
+  return 0;
+}
+
+extern "C" GPU_RT_STUB uint32_t agg_count_int32_warp_shared(uint32_t* agg,
+                                                            const int32_t val) {
+  return 0;
+}
+
+extern "C" GPU_RT_STUB int64_t agg_sum_warp_shared(int64_t* agg, const int64_t val) {
+  return 0;
+}
+
+extern "C" GPU_RT_STUB int32_t agg_sum_int32_warp_shared(int32_t* agg,
+                                                         const int32_t val) {
+  return 0;
+}
+
 extern "C" GPU_RT_STUB int32_t agg_sum_int32_skip_val_shared(int32_t* agg,
                                                              const int32_t val,
                                                              const int32_t skip_val) {
@@ -907,6 +963,138 @@ extern "C" GPU_RT_STUB void agg_sum_float_skip_val_shared(int32_t* agg,
                                                           const float val,
                                                           const float skip_val) {}
 
+// Aggregators for group by buffers updated concurrently by all the CPU kernels of a
+// query, see QueryMemoryDescriptor::useSharedCpuGroupByBuffer(). The kernels only need
+// to agree on the final value, so relaxed ordering is enough.
+
+template <typename T, typename F>
+ALWAYS_INLINE T atomic_update(T* agg, F get_new_val) {
+  T old = __atomic_load_n(agg, __ATOMIC_RELAXED);
+  while (true) {
+    const T new_val = get_new_val(old);
+    if (new_val == old ||
+        __atomic_compare_exchange_n(
+            agg, &old, new_val, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+      return old;
+    }
+  }
+}
+
+#define DEF_ATOMIC_AGG_COUNT(suffix, ADDR_T, DATA_T)                            \
+  extern "C" ALWAYS_INLINE ADDR_T agg_count##suffix##_atomic(ADDR_T* agg,       \
+                                                            const DATA_T val) { \
+    return __atomic_fetch_add(agg, ADDR_T(1), __ATOMIC_RELAXED);                \
+  }                                                                             \
+                                                                                \
+  extern "C" ALWAYS_INLINE ADDR_T agg_count##suffix##_skip_val_atomic(          \
+      ADDR_T* agg, const DATA_T val, const DATA_T skip_val) {                   \
+    if (val != skip_val) {                                                      \
+      return agg_count##suffix##_atomic(agg, val);                              \
+    }                                                                           \
+    return __atomic_load_n(agg, __ATOMIC_RELAXED);                              \
+  }
+
+DEF_ATOMIC_AGG_COUNT(, uint64_t, int64_t)
+DEF_ATOMIC_AGG_COUNT(_int32, uint32_t, int32_t)
+DEF_ATOMIC_AGG_COUNT(_double, uint64_t, double)
+DEF_ATOMIC_AGG_COUNT(_float, uint32_t, float)
+#undef DEF_ATOMIC_AGG_COUNT
+
+#define DEF_ATOMIC_AGG_SUM_INT(suffix, T)                                    \
+  extern "C" ALWAYS_INLINE T agg_sum##suffix##_atomic(T* agg, const T val) { \
+    return __atomic_fetch_add(agg, val, __ATOMIC_RELAXED);                   \
+  }                                                                          \
+                                                                             \
+  extern "C" ALWAYS_INLINE T agg_sum##suffix##_skip_val_atomic(              \
+      T* agg, const T val, const T skip_val) {                               \
+    if (val == skip_val) {                                                   \
+      return __atomic_load_n(agg, __ATOMIC_RELAXED);                         \
+    }                                                                        \
+    return atomic_update(agg, [val, skip_val](const T old) {                 \
+      return old != skip_val ? old + val : val;                              \
+    });                                                                      \
+  }
+
+DEF_ATOMIC_AGG_SUM_INT(, int64_t)
+DEF_ATOMIC_AGG_SUM_INT(_int32, int32_t)
+#undef DEF_ATOMIC_AGG_SUM_INT
+
+#define DEF_ATOMIC_AGG_MIN_MAX_INT(agg_func, suffix, T, op)                      \
+  extern "C" ALWAYS_INLINE void agg_func##suffix##_atomic(T* agg, const T val) { \
+    atomic_update(agg, [val](const T old) { return op(old, val); });             \
+  }                                                                              \
+                                                                                 \
+  extern "C" ALWAYS_INLINE void agg_func##suffix##_skip_val_atomic(              \
+      T* agg, const T val, const T skip_val) {                                   \
+    if (val != skip_val) {                                                       \
+      atomic_update(agg, [val, skip_val](const T old) {                          \
+        return old != skip_val ? op(old, val) : val;                             \
+      });                                                                        \
+    }                                                                            \
+  }
+
+DEF_ATOMIC_AGG_MIN_MAX_INT(agg_max, , int64_t, std::max)
+DEF_ATOMIC_AGG_MIN_MAX_INT(agg_min, , int64_t, std::min)
+DEF_ATOMIC_AGG_MIN_MAX_INT(agg_max, _int32, int32_t, std::max)
+DEF_ATOMIC_AGG_MIN_MAX_INT(agg_min, _int32, int32_t, std::min)
+#undef DEF_ATOMIC_AGG_MIN_MAX_INT
+
+template <typename T>
+ALWAYS_INLINE T fp_sum(const T lhs, const T rhs) {
+  return lhs + rhs;
+}
+
+template <typename ADDR_T, typename DATA_T>
+ALWAYS_INLINE ADDR_T to_slot(const DATA_T val) {
+  return *reinterpret_cast<const ADDR_T*>(may_alias_ptr(&val));
+}
+
+template <typename DATA_T, typename ADDR_T>
+ALWAYS_INLINE DATA_T from_slot(const ADDR_T slot) {
+  return *reinterpret_cast<const DATA_T*>(may_alias_ptr(&slot));
+}
+
+// The floating point slots hold the bit pattern of the value, so update them through a
+// compare and swap of the integer representation.
+#define DEF_ATOMIC_AGG_FP(agg_func, suffix, ADDR_T, DATA_T, op)                    \
+  extern "C" ALWAYS_INLINE void agg_func##suffix##_atomic(ADDR_T* agg,             \
+                                                         const DATA_T val) {       \
+    atomic_update(agg, [val](const ADDR_T old) {                                   \
+      return to_slot<ADDR_T>(op(from_slot<DATA_T>(old), val));                     \
+    });                                                                            \
+  }                                                                                \
+                                                                                   \
+  extern "C" ALWAYS_INLINE void agg_func##suffix##_skip_val_atomic(                \
+      ADDR_T* agg, const DATA_T val, const DATA_T skip_val) {                      \
+    if (val != skip_val) {                                                         \
+      const auto skip_slot = to_slot<ADDR_T>(skip_val);                            \
+      atomic_update(agg, [val, skip_slot](const ADDR_T old) {                      \
+        return old != skip_slot ? to_slot<ADDR_T>(op(from_slot<DATA_T>(old), val)) \
+                                : to_slot<ADDR_T>(val);                            \
+      });                                                                          \
+    }                                                                              \
+  }
+
+DEF_ATOMIC_AGG_FP(agg_sum, _double, int64_t, double, fp_sum)
+DEF_ATOMIC_AGG_FP(agg_max, _double, int64_t, double, std::max)
+DEF_ATOMIC_AGG_FP(agg_min, _double, int64_t, double, std::min)
+DEF_ATOMIC_AGG_FP(agg_sum, _float, int32_t, float, fp_sum)
+DEF_ATOMIC_AGG_FP(agg_max, _float, int32_t, float, std::max)
+DEF_ATOMIC_AGG_FP(agg_min, _float, int32_t, float, std::min)
+#undef DEF_ATOMIC_AGG_FP
+
+#define DEF_ATOMIC_AGG_ID(suffix, ADDR_T, DATA_T)                          \
+  extern "C" ALWAYS_INLINE void agg_id##suffix##_atomic(ADDR_T* agg,       \
+                                                       const DATA_T val) { \
+    __atomic_store_n(agg, to_slot<ADDR_T>(val), __ATOMIC_RELAXED);         \
+  }
+
+DEF_ATOMIC_AGG_ID(, int64_t, int64_t)
+DEF_ATOMIC_AGG_ID(_int32, int32_t, int32_t)
+DEF_ATOMIC_AGG_ID(_double, int64_t, double)
+DEF_ATOMIC_AGG_ID(_float, int32_t, float)
+#undef DEF_ATOMIC_AGG_ID
+
 extern "C" GPU_RT_STUB void force_sync() {}
 
 extern "C" GPU_RT_STUB void sync_warp() {}
@@ -951,6 +1139,10 @@ extern "C" GPU_RT_STUB int64_t get_block_index() {
   return 0;
 }
 
+extern "C" GPU_RT_STUB int64_t get_block_dim() {
+  return 1;
+}
+
 #undef GPU_RT_STUB
 
 extern "C" ALWAYS_INLINE void record_error_code(const int32_t err_code,
@@ -1075,6 +1267,63 @@ extern "C" ALWAYS_INLINE int64_t* get_matching_group_value(int64_t* groups_buffe
   return nullptr;
 }
 
+template <typename T>
+ALWAYS_INLINE int64_t* get_matching_group_value_atomic(int64_t* groups_buffer,
+                                                       const uint32_t h,
+                                                       const T* key,
+                                                       const uint32_t key_count,
+                                                       const uint32_t row_size_quad) {
+  const T empty_key = get_empty_key<T>();
+  auto row_ptr = reinterpret_cast<T*>(groups_buffer + h * row_size_quad);
+  T old = empty_key;
+  if (__atomic_compare_exchange_n(
+          row_ptr, &old, key[0], false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+    // We own the entry now, publish the rest of the key
+    for (uint32_t i = 1; i < key_count; ++i) {
+      __atomic_store_n(row_ptr + i, key[i], __ATOMIC_RELEASE);
+    }
+  } else if (old != key[0]) {
+    return nullptr;
+  }
+  if (key_count > 1) {
+    while (__atomic_load_n(row_ptr + key_count - 1, __ATOMIC_ACQUIRE) == empty_key) {
+      // spin until the winning thread has finished writing the entire key
+    }
+    for (uint32_t i = 1; i < key_count; ++i) {
+      if (__atomic_load_n(row_ptr + i, __ATOMIC_RELAXED) != key[i]) {
+        return nullptr;
+      }
+    }
+  }
+  auto row_ptr_i8 = reinterpret_cast<int8_t*>(row_ptr + key_count);
+  return reinterpret_cast<int64_t*>(align_to_int64(row_ptr_i8));
+}
+
+// Same as get_matching_group_value, but safe to call concurrently on the same buffer.
+// The aggregate slots have been initialized before any kernel started, so only the
+// key needs to be claimed.
+extern "C" ALWAYS_INLINE int64_t* get_matching_group_value_atomic(
+    int64_t* groups_buffer,
+    const uint32_t h,
+    const int64_t* key,
+    const uint32_t key_count,
+    const uint32_t key_width,
+    const uint32_t row_size_quad) {
+  switch (key_width) {
+    case 4:
+      return get_matching_group_value_atomic(groups_buffer,
+                                             h,
+                                             reinterpret_cast<const int32_t*>(key),
+                                             key_count,
+                                             row_size_quad);
+    case 8:
+      return get_matching_group_value_atomic(
+          groups_buffer, h, key, key_count, row_size_quad);
+    default:;
+  }
+  return nullptr;
+}
+
 template <typename T>
 ALWAYS_INLINE int32_t get_matching_group_value_columnar_slot(int64_t* groups_buffer,
                                                              const uint32_t entry_count,
@@ -1207,6 +1456,53 @@ extern "C" ALWAYS_INLINE void set_matching_group_value_perfect_hash_columnar(
 #include "GroupByRuntime.cpp"
 #include "JoinHashTable/Runtime/JoinHashTableQueryRuntime.cpp"
 
+extern "C" NEVER_INLINE int64_t* get_group_value_atomic(
+    int64_t* groups_buffer,
+    const uint32_t groups_buffer_entry_count,
+    const int64_t* key,
+    const uint32_t key_count,
+    const uint32_t key_width,
+    const uint32_t row_size_quad) {
+  uint32_t h = key_hash(key, key_count, key_width) % groups_buffer_entry_count;
+  uint32_t h_probe = h;
+  do {
+    auto matching_group = get_matching_group_value_atomic(
+        groups_buffer, h_probe, key, key_count, key_width, row_size_quad);
+    if (matching_group) {
+      return matching_group;
+    }
+    h_probe = (h_probe + 1) % groups_buffer_entry_count;
+  } while (h_probe != h);
+  return nullptr;
+}
+
+extern "C" NEVER_INLINE int64_t* get_group_value_atomic_with_watchdog(
+    int64_t* groups_buffer,
+    const uint32_t groups_buffer_entry_count,
+    const int64_t* key,
+    const uint32_t key_count,
+    const uint32_t key_width,
+    const uint32_t row_size_quad) {
+  uint32_t h = key_hash(key, key_count, key_width) % groups_buffer_entry_count;
+  uint32_t h_probe = h;
+  uint32_t watchdog_countdown = 100;
+  do {
+    auto matching_group = get_matching_group_value_atomic(
+        groups_buffer, h_probe, key, key_count, key_width, row_size_quad);
+    if (matching_group) {
+      return matching_group;
+    }
+    h_probe = (h_probe + 1) % groups_buffer_entry_count;
+    if (--watchdog_countdown == 0) {
+      if (dynamic_watchdog()) {
+        return nullptr;
+      }
+      watchdog_countdown = 100;
+    }
+  } while (h_probe != h);
+  return nullptr;
+}
+
 extern "C" ALWAYS_INLINE int64_t* get_group_value_fast_keyless(
     int64_t* groups_buffer,
     const int64_t key,
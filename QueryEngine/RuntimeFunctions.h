@@ -195,6 +195,11 @@ extern "C" int32_t* get_hash_slot(int32_t* buff,
                                   const int64_t key,
                                   const int64_t min_key);
 
+extern "C" int32_t* get_sparse_hash_slot(int32_t* buff,
+                                         const int64_t key,
+                                         const int64_t min_key,
+                                         const int64_t bitmap_word_count);
+
 extern "C" int32_t* get_hash_slot_sharded(int32_t* buff,
                                           const int64_t key,
                                           const int64_t min_key,
@@ -0,0 +1,62 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "QueryEngine/SharedScan.h"
+
+#include "Logger/Logger.h"
+
+bool g_enable_shared_scans{false};
+
+std::mutex SharedScan::scans_mutex_;
+std::map<SharedScan::TableKey, std::shared_ptr<SharedScan::TableScans>>
+    SharedScan::scans_;
+
+std::unique_ptr<SharedScan> SharedScan::attach(const int db_id, const int table_id) {
+  const TableKey table_key{db_id, table_id};
+  std::lock_guard<std::mutex> lock(scans_mutex_);
+  auto& table_scans = scans_[table_key];
+  if (!table_scans) {
+    table_scans = std::make_shared<TableScans>();
+  }
+  const int start_fragment_id =
+      table_scans->scan_count ? table_scans->last_fragment_id.load() : -1;
+  ++table_scans->scan_count;
+  return std::unique_ptr<SharedScan>(
+      new SharedScan(table_key, table_scans, start_fragment_id));
+}
+
+SharedScan::~SharedScan() {
+  std::lock_guard<std::mutex> lock(scans_mutex_);
+  CHECK_GT(table_scans_->scan_count, size_t(0));
+  if (--table_scans_->scan_count == 0) {
+    scans_.erase(table_key_);
+  }
+}
+
+void SharedScan::fragmentStarted(const int fragment_id) {
+  if (fragment_id >= 0) {
+    table_scans_->last_fragment_id.store(fragment_id);
+  }
+}
+
+size_t SharedScan::getActiveScanCount() {
+  std::lock_guard<std::mutex> lock(scans_mutex_);
+  size_t scan_count{0};
+  for (const auto& [table_key, table_scans] : scans_) {
+    scan_count += table_scans->scan_count;
+  }
+  return scan_count;
+}
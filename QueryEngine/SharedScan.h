@@ -0,0 +1,71 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+// Lines up the fragment order of concurrent scans of the same table.
+extern bool g_enable_shared_scans;
+
+/**
+ * A scan of a table by the fragment kernels of one query. Concurrent scans of the same
+ * table share their progress: a query attaching while other queries are scanning the
+ * table starts at the fragment they last started, and wraps around to the fragments it
+ * skipped. The scans then read each fragment at about the same time, so its chunks are
+ * fetched into the buffer pool once and are still resident for the other queries,
+ * instead of every query streaming the whole table through the pool on its own.
+ */
+class SharedScan {
+ public:
+  // Registers a scan of the table until the returned scan is destroyed.
+  static std::unique_ptr<SharedScan> attach(const int db_id, const int table_id);
+
+  ~SharedScan();
+
+  // Fragment id the scan should start at, -1 if no other scan of the table is running.
+  int getStartFragmentId() const { return start_fragment_id_; }
+
+  // Records that a kernel of this scan started on the fragment.
+  void fragmentStarted(const int fragment_id);
+
+  static size_t getActiveScanCount();
+
+ private:
+  struct TableScans {
+    size_t scan_count{0};
+    std::atomic<int> last_fragment_id{-1};
+  };
+  using TableKey = std::pair<int, int>;
+
+  SharedScan(const TableKey& table_key,
+             std::shared_ptr<TableScans> table_scans,
+             const int start_fragment_id)
+      : table_key_(table_key)
+      , table_scans_(std::move(table_scans))
+      , start_fragment_id_(start_fragment_id) {}
+
+  const TableKey table_key_;
+  const std::shared_ptr<TableScans> table_scans_;
+  const int start_fragment_id_;
+
+  static std::mutex scans_mutex_;
+  static std::map<TableKey, std::shared_ptr<TableScans>> scans_;
+};
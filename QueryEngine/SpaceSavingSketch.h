@@ -0,0 +1,115 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Logger/Logger.h"
+
+// Space-Saving sketch of the most frequent values of a stream, with at most `capacity`
+// counters. A new value takes over the counter with the smallest count, so every value
+// more frequent than 1 / capacity of the stream has a counter, whose count overestimates
+// its frequency by at most the count it took over. Sketches of disjoint streams merge
+// into a sketch of their union with the same guarantee.
+class SpaceSavingSketch {
+ public:
+  explicit SpaceSavingSketch(const size_t capacity) : capacity_(capacity) {
+    CHECK_GT(capacity_, size_t(0));
+  }
+
+  void add(const int64_t value, const size_t count = 1) {
+    auto it = counts_.find(value);
+    if (it != counts_.end()) {
+      setCount(it, it->second + count);
+      return;
+    }
+    if (counts_.size() < capacity_) {
+      counts_.emplace(value, count);
+      ordered_counts_.emplace(count, value);
+      return;
+    }
+    const auto min_count = *ordered_counts_.begin();
+    ordered_counts_.erase(ordered_counts_.begin());
+    counts_.erase(min_count.second);
+    counts_.emplace(value, min_count.first + count);
+    ordered_counts_.emplace(min_count.first + count, value);
+  }
+
+  void merge(const SpaceSavingSketch& that) {
+    // The values missing from a full sketch may have occurred as often as its smallest
+    // count.
+    const auto this_min_count = getMinCount();
+    const auto that_min_count = that.getMinCount();
+    std::unordered_map<int64_t, size_t> merged_counts;
+    for (const auto& [value, count] : counts_) {
+      const auto that_it = that.counts_.find(value);
+      const auto that_count =
+          that_it != that.counts_.end() ? that_it->second : that_min_count;
+      merged_counts.emplace(value, count + that_count);
+    }
+    for (const auto& [value, count] : that.counts_) {
+      merged_counts.emplace(value, count + this_min_count);
+    }
+    std::vector<std::pair<size_t, int64_t>> by_count;
+    by_count.reserve(merged_counts.size());
+    for (const auto& [value, count] : merged_counts) {
+      by_count.emplace_back(count, value);
+    }
+    const auto kept = std::min(capacity_, by_count.size());
+    std::partial_sort(by_count.begin(),
+                      by_count.begin() + kept,
+                      by_count.end(),
+                      std::greater<std::pair<size_t, int64_t>>());
+    counts_.clear();
+    ordered_counts_.clear();
+    for (size_t i = 0; i < kept; ++i) {
+      counts_.emplace(by_count[i].second, by_count[i].first);
+      ordered_counts_.insert(by_count[i]);
+    }
+  }
+
+  // The values with a counter and their counts, the most frequent first.
+  std::vector<std::pair<int64_t, size_t>> getMostFrequent() const {
+    std::vector<std::pair<int64_t, size_t>> most_frequent;
+    most_frequent.reserve(counts_.size());
+    for (auto it = ordered_counts_.rbegin(); it != ordered_counts_.rend(); ++it) {
+      most_frequent.emplace_back(it->second, it->first);
+    }
+    return most_frequent;
+  }
+
+ private:
+  void setCount(std::unordered_map<int64_t, size_t>::iterator it, const size_t count) {
+    ordered_counts_.erase({it->second, it->first});
+    it->second = count;
+    ordered_counts_.emplace(count, it->first);
+  }
+
+  size_t getMinCount() const {
+    return counts_.size() < capacity_ ? 0 : ordered_counts_.begin()->first;
+  }
+
+  size_t capacity_;
+  std::unordered_map<int64_t, size_t> counts_;
+  std::set<std::pair<size_t, int64_t>> ordered_counts_;
+};
@@ -0,0 +1,136 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Compressed set of 64-bit integers, laid out like a roaring bitmap. Values are split
+ * on their upper 48 bits into chunks of 2^16 values, each stored as a sorted array of
+ * the low 16 bits while it holds at most `kMaxArraySize` values and as a dense 8 KB
+ * bitmap past that. Sets over wide, sparsely populated ranges stay small and unions
+ * work a chunk at a time rather than a value at a time.
+ */
+class SparseBitmap {
+ public:
+  SparseBitmap() = default;
+  SparseBitmap(const SparseBitmap&) = delete;
+  SparseBitmap& operator=(const SparseBitmap&) = delete;
+
+  void insert(const int64_t val) {
+    const auto chunk_key = val >> 16;
+    if (!last_chunk_ || chunk_key != last_chunk_key_) {
+      last_chunk_ = &chunks_[chunk_key];
+      last_chunk_key_ = chunk_key;
+    }
+    last_chunk_->insert(static_cast<uint16_t>(val));
+  }
+
+  void unite(const SparseBitmap& that) {
+    for (const auto& [chunk_key, that_chunk] : that.chunks_) {
+      chunks_[chunk_key].unite(that_chunk);
+    }
+  }
+
+  size_t size() const {
+    size_t size{0};
+    for (const auto& chunk : chunks_) {
+      size += chunk.second.cardinality;
+    }
+    return size;
+  }
+
+ private:
+  static constexpr size_t kMaxArraySize{4096};
+  static constexpr size_t kBitmapWords{(1 << 16) / 64};
+
+  struct Chunk {
+    std::vector<uint16_t> array;
+    std::vector<uint64_t> bitmap;
+    size_t cardinality{0};
+
+    void insert(const uint16_t low) {
+      if (!bitmap.empty()) {
+        auto& word = bitmap[low >> 6];
+        const uint64_t bit = uint64_t(1) << (low & 63);
+        cardinality += (word & bit) ? 0 : 1;
+        word |= bit;
+        return;
+      }
+      auto it = std::lower_bound(array.begin(), array.end(), low);
+      if (it != array.end() && *it == low) {
+        return;
+      }
+      array.insert(it, low);
+      ++cardinality;
+      if (array.size() > kMaxArraySize) {
+        toBitmap();
+      }
+    }
+
+    void unite(const Chunk& that) {
+      if (bitmap.empty() && that.bitmap.empty()) {
+        std::vector<uint16_t> merged;
+        merged.reserve(array.size() + that.array.size());
+        std::set_union(array.begin(),
+                       array.end(),
+                       that.array.begin(),
+                       that.array.end(),
+                       std::back_inserter(merged));
+        array.swap(merged);
+        cardinality = array.size();
+        if (array.size() > kMaxArraySize) {
+          toBitmap();
+        }
+        return;
+      }
+      if (bitmap.empty()) {
+        toBitmap();
+      }
+      if (that.bitmap.empty()) {
+        for (const auto low : that.array) {
+          insert(low);
+        }
+        return;
+      }
+      cardinality = 0;
+      for (size_t i = 0; i < kBitmapWords; ++i) {
+        bitmap[i] |= that.bitmap[i];
+        cardinality += __builtin_popcountll(bitmap[i]);
+      }
+    }
+
+    void toBitmap() {
+      bitmap.assign(kBitmapWords, 0);
+      for (const auto low : array) {
+        bitmap[low >> 6] |= uint64_t(1) << (low & 63);
+      }
+      array.clear();
+      array.shrink_to_fit();
+    }
+  };
+
+  std::unordered_map<int64_t, Chunk> chunks_;
+  // Consecutive inserts mostly land in the same chunk, references to unordered_map
+  // elements survive rehashing.
+  Chunk* last_chunk_{nullptr};
+  int64_t last_chunk_key_{0};
+};
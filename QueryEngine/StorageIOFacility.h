@@ -315,8 +315,10 @@ class StorageIOFacility {
           return;
         }
 
+        const auto update_column_count = update_parameters.getUpdateColumnCount();
         OffsetVector column_offsets(rows_per_column);
-        ScalarTargetValueVector scalar_target_values(rows_per_column);
+        std::vector<ScalarTargetValueVector> scalar_target_values(
+            update_column_count, ScalarTargetValueVector(rows_per_column));
 
         auto complete_entry_block_size = entries_per_column / normalized_cpu_threads();
         auto partial_row_block_size = entries_per_column % normalized_cpu_threads();
@@ -327,14 +329,32 @@ class StorageIOFacility {
           usable_threads = 1;
         }
 
+        // Translating strings leaves the other columns as they are, so each row is
+        // fetched once for all the updated columns.
+        bool translate_strings{false};
+        for (size_t column_index = 0; column_index < update_column_count;
+             ++column_index) {
+          if (update_log.getColumnType(column_index).is_string()) {
+            translate_strings = true;
+          }
+        }
+        auto get_entry_at_func = [&update_log,
+                                  translate_strings](const size_t entry_index) {
+          if (UNLIKELY(translate_strings)) {
+            return update_log.getTranslatedEntryAt(entry_index);
+          } else {
+            return update_log.getEntryAt(entry_index);
+          }
+        };
+
         std::atomic<size_t> row_idx{0};
 
-        auto process_rows =
-            [&update_parameters, &column_offsets, &scalar_target_values, &row_idx](
-                auto get_entry_at_func,
-                uint64_t column_index,
-                uint64_t entry_start,
-                uint64_t entry_count) -> uint64_t {
+        auto process_rows = [update_column_count,
+                             &get_entry_at_func,
+                             &column_offsets,
+                             &scalar_target_values,
+                             &row_idx](uint64_t entry_start,
+                                       uint64_t entry_count) -> uint64_t {
           uint64_t entries_processed = 0;
           for (uint64_t entry_index = entry_start;
                entry_index < (entry_start + entry_count);
@@ -347,7 +367,7 @@ class StorageIOFacility {
             entries_processed++;
             size_t row_index = row_idx.fetch_add(1);
 
-            CHECK(row.size() == update_parameters.getUpdateColumnCount() + 1);
+            CHECK(row.size() == update_column_count + 1);
 
             auto terminal_column_iter = std::prev(row.end());
             const auto frag_offset_scalar_tv =
@@ -356,8 +376,11 @@ class StorageIOFacility {
 
             column_offsets[row_index] =
                 static_cast<uint64_t>(*(boost::get<int64_t>(frag_offset_scalar_tv)));
-            scalar_target_values[row_index] =
-                boost::get<ScalarTargetValue>(row[column_index]);
+            for (size_t column_index = 0; column_index < update_column_count;
+                 ++column_index) {
+              scalar_target_values[column_index][row_index] =
+                  boost::get<ScalarTargetValue>(row[column_index]);
+            }
           }
           return entries_processed;
         };
@@ -367,55 +390,39 @@ class StorageIOFacility {
           return (thread_index * complete_entry_block_size);
         };
 
+        RowProcessingFuturesVector entry_processing_futures;
+        entry_processing_futures.reserve(usable_threads);
+        for (unsigned i = 0; i < static_cast<unsigned>(usable_threads); i++) {
+          entry_processing_futures.emplace_back(
+              std::async(std::launch::async,
+                         std::forward<decltype(process_rows)>(process_rows),
+                         get_row_index(i),
+                         complete_entry_block_size));
+        }
+        if (partial_row_block_size) {
+          entry_processing_futures.emplace_back(
+              std::async(std::launch::async,
+                         std::forward<decltype(process_rows)>(process_rows),
+                         get_row_index(usable_threads),
+                         partial_row_block_size));
+        }
+
+        uint64_t entries_processed(0);
+        for (auto& t : entry_processing_futures) {
+          t.wait();
+          entries_processed += t.get();
+        }
+
+        CHECK(row_idx == rows_per_column);
+
         auto const* table_descriptor =
             catalog_.getMetadataForTable(update_log.getPhysicalTableId());
         CHECK(table_descriptor);
         auto fragment_id = update_log.getFragmentId();
 
         // Iterate over each column
-        for (decltype(update_parameters.getUpdateColumnCount()) column_index = 0;
-             column_index < update_parameters.getUpdateColumnCount();
+        for (size_t column_index = 0; column_index < update_column_count;
              column_index++) {
-          row_idx = 0;
-          RowProcessingFuturesVector entry_processing_futures;
-          entry_processing_futures.reserve(usable_threads);
-
-          auto get_entry_at_func = [&update_log,
-                                    &column_index](const size_t entry_index) {
-            if (UNLIKELY(update_log.getColumnType(column_index).is_string())) {
-              return update_log.getTranslatedEntryAt(entry_index);
-            } else {
-              return update_log.getEntryAt(entry_index);
-            }
-          };
-
-          for (unsigned i = 0; i < static_cast<unsigned>(usable_threads); i++) {
-            entry_processing_futures.emplace_back(
-                std::async(std::launch::async,
-                           std::forward<decltype(process_rows)>(process_rows),
-                           get_entry_at_func,
-                           column_index,
-                           get_row_index(i),
-                           complete_entry_block_size));
-          }
-          if (partial_row_block_size) {
-            entry_processing_futures.emplace_back(
-                std::async(std::launch::async,
-                           std::forward<decltype(process_rows)>(process_rows),
-                           get_entry_at_func,
-                           column_index,
-                           get_row_index(usable_threads),
-                           partial_row_block_size));
-          }
-
-          uint64_t entries_processed(0);
-          for (auto& t : entry_processing_futures) {
-            t.wait();
-            entries_processed += t.get();
-          }
-
-          CHECK(row_idx == rows_per_column);
-
           const auto table_id = update_log.getPhysicalTableId();
           const auto fragmenter = table_descriptor->fragmenter;
           CHECK(fragmenter);
@@ -427,7 +434,7 @@ class StorageIOFacility {
                                        target_column,
                                        fragment_id,
                                        column_offsets,
-                                       scalar_target_values,
+                                       scalar_target_values[column_index],
                                        update_log.getColumnType(column_index),
                                        Data_Namespace::MemoryLevel::CPU_LEVEL,
                                        update_parameters.getTransactionTracker());
@@ -29,6 +29,9 @@
 #include <cstdint>
 #include <vector>
 
+// Largest offset + limit of a projection sorted through per thread top n heaps.
+extern size_t g_streaming_topn_max;
+
 namespace streaming_top_n {
 
 size_t get_heap_size(const size_t row_size, const size_t n, const size_t thread_count);
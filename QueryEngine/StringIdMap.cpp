@@ -0,0 +1,102 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "QueryEngine/StringIdMap.h"
+
+#include "Logger/Logger.h"
+#include "Parser/ParserNode.h"
+#include "QueryEngine/CodeGenerator.h"
+#include "QueryEngine/Execute.h"
+#ifdef HAVE_CUDA
+#include "QueryEngine/GpuMemUtils.h"
+#endif  // HAVE_CUDA
+#include "Shared/checked_alloc.h"
+
+#include <cstring>
+
+StringIdMap::StringIdMap(const std::vector<int32_t>& id_map,
+                         const Data_Namespace::MemoryLevel memory_level,
+                         const int device_count,
+                         Data_Namespace::DataMgr* data_mgr)
+    : entry_count_(id_map.size()), memory_level_(memory_level), data_mgr_(data_mgr) {
+#ifdef HAVE_CUDA
+  CHECK(memory_level_ == Data_Namespace::CPU_LEVEL ||
+        memory_level == Data_Namespace::GPU_LEVEL);
+#else
+  CHECK_EQ(Data_Namespace::CPU_LEVEL, memory_level_);
+#endif  // HAVE_CUDA
+  const size_t id_map_bytes = std::max(id_map.size(), size_t(1)) * sizeof(int32_t);
+  auto cpu_id_map = static_cast<int8_t*>(checked_malloc(id_map_bytes));
+  std::memcpy(cpu_id_map, id_map.data(), id_map.size() * sizeof(int32_t));
+#ifdef HAVE_CUDA
+  if (memory_level_ == Data_Namespace::GPU_LEVEL) {
+    for (int device_id = 0; device_id < device_count; ++device_id) {
+      gpu_buffers_.emplace_back(
+          CudaAllocator::allocGpuAbstractBuffer(data_mgr, id_map_bytes, device_id));
+      auto gpu_id_map = gpu_buffers_.back()->getMemoryPtr();
+      copy_to_gpu(data_mgr,
+                  reinterpret_cast<CUdeviceptr>(gpu_id_map),
+                  cpu_id_map,
+                  id_map_bytes,
+                  device_id);
+      id_maps_.push_back(gpu_id_map);
+    }
+    free(cpu_id_map);
+  } else {
+    id_maps_.push_back(cpu_id_map);
+  }
+#else
+  CHECK_EQ(1, device_count);
+  id_maps_.push_back(cpu_id_map);
+#endif  // HAVE_CUDA
+}
+
+StringIdMap::~StringIdMap() {
+  if (memory_level_ == Data_Namespace::CPU_LEVEL) {
+    CHECK_EQ(size_t(1), id_maps_.size());
+    free(id_maps_.front());
+  } else {
+    CHECK(data_mgr_);
+    for (auto& gpu_buffer : gpu_buffers_) {
+      data_mgr_->free(gpu_buffer);
+    }
+  }
+}
+
+llvm::Value* StringIdMap::codegen(llvm::Value* string_id, Executor* executor) const {
+  AUTOMATIC_IR_METADATA(executor->cgen_state_.get());
+  std::vector<std::shared_ptr<const Analyzer::Constant>> constants_owned;
+  std::vector<const Analyzer::Constant*> constants;
+  for (const auto id_map : id_maps_) {
+    const int64_t id_map_handle = reinterpret_cast<int64_t>(id_map);
+    const auto id_map_handle_literal = std::dynamic_pointer_cast<Analyzer::Constant>(
+        Parser::IntLiteral::analyzeValue(id_map_handle));
+    CHECK(id_map_handle_literal);
+    CHECK_EQ(kENCODING_NONE, id_map_handle_literal->get_type_info().get_compression());
+    constants_owned.push_back(id_map_handle_literal);
+    constants.push_back(id_map_handle_literal.get());
+  }
+  CodeGenerator code_generator(executor);
+  const auto id_map_handle_lvs =
+      code_generator.codegenHoistedConstants(constants, kENCODING_NONE, 0);
+  CHECK_EQ(size_t(1), id_map_handle_lvs.size());
+  return executor->cgen_state_->emitCall(
+      "map_string_id",
+      {executor->cgen_state_->castToTypeIn(id_map_handle_lvs.front(), 64),
+       executor->cgen_state_->castToTypeIn(string_id, 32),
+       executor->cgen_state_->llInt(entry_count_),
+       executor->cgen_state_->llInt(inline_int_null_value<int32_t>())});
+}
@@ -0,0 +1,55 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "DataMgr/DataMgr.h"
+
+#include <llvm/IR/Value.h>
+
+#include <cstdint>
+#include <vector>
+
+class Executor;
+
+// Largest string dictionary whose strings are transformed once per entry to run a string
+// function on GPU, the queries over larger dictionaries run on CPU.
+extern size_t g_string_id_map_max_entries;
+
+/**
+ * Lookup array from the ids of a string dictionary to the ids of the strings some
+ * transform of the strings maps them to, e.g. LOWER. The transform is applied once per
+ * dictionary entry when building the map, queries then just look up the id of each row,
+ * which also runs on GPU. The array is copied to every device for a GPU query.
+ */
+class StringIdMap {
+ public:
+  StringIdMap(const std::vector<int32_t>& id_map,
+              const Data_Namespace::MemoryLevel memory_level,
+              const int device_count,
+              Data_Namespace::DataMgr* data_mgr);
+  ~StringIdMap();
+
+  // Returns the id `string_id` maps to, or null for a null or out of range id.
+  llvm::Value* codegen(llvm::Value* string_id, Executor* executor) const;
+
+ private:
+  std::vector<Data_Namespace::AbstractBuffer*> gpu_buffers_;
+  std::vector<int8_t*> id_maps_;
+  const int32_t entry_count_;
+  const Data_Namespace::MemoryLevel memory_level_;
+  Data_Namespace::DataMgr* data_mgr_;
+};
@@ -20,9 +20,45 @@
 #include "../Shared/funcannotations.h"
 #include "../Shared/sqldefs.h"
 #include "Parser/ParserNode.h"
+#include "QueryEngine/StringIdMap.h"
+#include "Shared/thread_count.h"
 
 #include <boost/locale/conversion.hpp>
 
+#include <future>
+
+size_t g_string_id_map_max_entries{10000000};
+
+namespace {
+
+// Maps the ids of the strings of the dictionary of `string_dict_proxy` to the ids of
+// their lowercase forms, adding the forms missing from the dictionary as transients.
+std::vector<int32_t> build_lower_string_id_map(StringDictionaryProxy* string_dict_proxy,
+                                               const size_t entry_count) {
+  std::vector<std::string> lower_strings(entry_count);
+  const size_t worker_count = std::min(static_cast<size_t>(cpu_threads()), entry_count);
+  std::vector<std::future<void>> lower_threads;
+  for (size_t w = 0; w < worker_count; ++w) {
+    lower_threads.push_back(std::async(
+        std::launch::async,
+        [&lower_strings, string_dict_proxy, entry_count, worker_count, w] {
+          for (size_t i = w; i < entry_count; i += worker_count) {
+            lower_strings[i] = boost::locale::to_lower(string_dict_proxy->getString(i));
+          }
+        }));
+  }
+  for (auto& lower_thread : lower_threads) {
+    lower_thread.get();
+  }
+  std::vector<int32_t> id_map(entry_count);
+  for (size_t i = 0; i < entry_count; ++i) {
+    id_map[i] = string_dict_proxy->getOrAddTransient(lower_strings[i]);
+  }
+  return id_map;
+}
+
+}  // namespace
+
 extern "C" RUNTIME_EXPORT uint64_t string_decode(int8_t* chunk_iter_, int64_t pos) {
   auto chunk_iter = reinterpret_cast<ChunkIter*>(chunk_iter_);
   VarlenDatum vd;
@@ -107,17 +143,37 @@ llvm::Value* CodeGenerator::codegen(const Analyzer::KeyForStringExpr* expr,
 llvm::Value* CodeGenerator::codegen(const Analyzer::LowerExpr* expr,
                                     const CompilationOptions& co) {
   AUTOMATIC_IR_METADATA(cgen_state_);
+  const auto string_dictionary_proxy = executor()->getStringDictionaryProxy(
+      expr->get_type_info().get_comp_param(), executor()->getRowSetMemoryOwner(), true);
+  CHECK(string_dictionary_proxy);
+
   if (co.device_type == ExecutorDeviceType::GPU) {
-    throw QueryMustRunOnCpu();
+    // Columns of physical tables only hold ids of the dictionary itself, intermediate
+    // results may hold transient ids the map does not cover.
+    const auto col_var = dynamic_cast<const Analyzer::ColumnVar*>(expr->get_arg());
+    const auto generation = string_dictionary_proxy->getGeneration();
+    const auto entry_count =
+        generation >= 0 ? std::min(static_cast<size_t>(generation),
+                                   string_dictionary_proxy->storageEntryCount())
+                        : string_dictionary_proxy->storageEntryCount();
+    if (!col_var || col_var->get_table_id() <= 0 || !co.hoist_literals ||
+        entry_count > g_string_id_map_max_entries) {
+      throw QueryMustRunOnCpu();
+    }
+    auto str_id_lv = codegen(expr->get_arg(), true, co);
+    CHECK_EQ(size_t(1), str_id_lv.size());
+    auto string_id_map = std::make_unique<StringIdMap>(
+        build_lower_string_id_map(string_dictionary_proxy, entry_count),
+        Data_Namespace::GPU_LEVEL,
+        executor()->deviceCount(co.device_type),
+        executor()->data_mgr_);
+    return cgen_state_->addStringIdMap(string_id_map)
+        ->codegen(str_id_lv.front(), executor());
   }
 
   auto str_id_lv = codegen(expr->get_arg(), true, co);
   CHECK_EQ(size_t(1), str_id_lv.size());
 
-  const auto string_dictionary_proxy = executor()->getStringDictionaryProxy(
-      expr->get_type_info().get_comp_param(), executor()->getRowSetMemoryOwner(), true);
-  CHECK(string_dictionary_proxy);
-
   std::vector<llvm::Value*> args{
       str_id_lv[0],
       cgen_state_->llInt(reinterpret_cast<int64_t>(string_dictionary_proxy))};
@@ -41,6 +41,12 @@
   of output columns. It must not be greater than the count specified
   in the `set_output_row_size` call but may be a smaller value.
 
+  A table function that sets the number of rows itself and can not
+  predict it may call `set_output_row_size` again with a larger count
+  when its output columns are full, e.g. doubling the count, and keep
+  writing rows. The rows written so far are moved to the new buffers
+  and the output Column instances are updated to point to them.
+
   4. After returning the table function, one can access the output
   Column instances until the memory manager of output columns is
   destroyed (when leaving launchCpuCode). The buffers of output
@@ -55,10 +61,12 @@ struct QueryOutputBufferMemoryManager {
     QueryOutputBufferMemoryManager is a dynamic singleton:
     `get_singleton()` returns a pointer to the singleton instance when
     in the scope of QueryOutputBufferMemoryManager life-time,
-    otherwise returns nullptr. For internal usage.
+    otherwise returns nullptr. For internal usage. There is one
+    instance per thread so that the partitions of partitionable table
+    functions can run concurrently.
   */
   static QueryOutputBufferMemoryManager*& get_singleton() {
-    static QueryOutputBufferMemoryManager* instance = nullptr;
+    static thread_local QueryOutputBufferMemoryManager* instance = nullptr;
     return instance;
   }
 
@@ -99,7 +107,12 @@ struct QueryOutputBufferMemoryManager {
   }
 
   void allocate_output_buffers(int64_t output_num_rows) {
-    CHECK_EQ(output_num_rows_, 0);  // re-allocation of output buffers is not supported
+    // Growing the output buffers keeps the rows written so far, shrinking is not
+    // supported
+    CHECK_GE(static_cast<size_t>(output_num_rows), output_num_rows_);
+    const auto prev_output_num_rows = output_num_rows_;
+    const auto prev_output_col_buf_ptrs = output_col_buf_ptrs;
+    auto prev_query_buffers = std::move(query_buffers);
     output_num_rows_ = output_num_rows;
     auto num_out_columns = get_ncols();
     QueryMemoryDescriptor query_mem_desc(executor_,
@@ -143,6 +156,11 @@ struct QueryOutputBufferMemoryManager {
       Column* col = reinterpret_cast<Column*>(output_column_ptrs[i]);
       CHECK(col);
       output_col_buf_ptrs[i] = output_buffers_ptr + i * output_num_rows_;
+      if (prev_query_buffers) {
+        memcpy(output_col_buf_ptrs[i],
+               prev_output_col_buf_ptrs[i],
+               prev_output_num_rows * sizeof(int64_t));
+      }
       // set the members of output Column instances:
       col->ptr = reinterpret_cast<int8_t*>(output_col_buf_ptrs[i]);
       col->size = output_num_rows_;
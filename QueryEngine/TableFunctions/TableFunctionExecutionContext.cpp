@@ -23,6 +23,12 @@
 #include "QueryEngine/TableFunctions/QueryOutputBufferMemoryManager.h"
 #include "QueryEngine/TableFunctions/TableFunctionCompilationContext.h"
 #include "Shared/funcannotations.h"
+#include "Shared/thread_count.h"
+
+#include <future>
+#include <optional>
+
+size_t g_table_function_partition_rows{0};
 
 namespace {
 
@@ -75,6 +81,33 @@ size_t get_output_row_count(const TableFunctionExecutionUnit& exe_unit,
   return allocated_output_row_count;
 }
 
+// Returns the element sizes of the inputs when the table function can run over
+// partitions of its input rows: a partitionable function whose column inputs all have
+// `elem_count` fixed width elements. Literals have an element size of 0.
+std::optional<std::vector<size_t>> get_partitionable_input_elem_sizes(
+    const TableFunctionExecutionUnit& exe_unit,
+    const std::vector<int64_t>& col_sizes,
+    const size_t elem_count) {
+  if (!exe_unit.table_func.isPartitionable()) {
+    return std::nullopt;
+  }
+  std::vector<size_t> col_elem_sizes;
+  for (size_t i = 0; i < exe_unit.input_exprs.size(); ++i) {
+    const auto input_expr = exe_unit.input_exprs[i];
+    if (dynamic_cast<const Analyzer::Constant*>(input_expr)) {
+      col_elem_sizes.push_back(0);
+      continue;
+    }
+    const auto& ti = input_expr->get_type_info();
+    if (ti.is_column_list() || ti.get_size() <= 0 ||
+        static_cast<size_t>(col_sizes[i]) != elem_count) {
+      return std::nullopt;
+    }
+    col_elem_sizes.push_back(ti.get_size());
+  }
+  return col_elem_sizes;
+}
+
 }  // namespace
 
 ResultSetPtr TableFunctionExecutionContext::execute(
@@ -211,6 +244,20 @@ ResultSetPtr TableFunctionExecutionContext::execute(
   CHECK(output_column_size);
   switch (device_type) {
     case ExecutorDeviceType::CPU:
+      if (g_table_function_partition_rows &&
+          *output_column_size > g_table_function_partition_rows) {
+        const auto col_elem_sizes = get_partitionable_input_elem_sizes(
+            exe_unit, col_sizes, *output_column_size);
+        if (col_elem_sizes) {
+          return launchCpuCodePartitioned(exe_unit,
+                                          compilation_context,
+                                          col_buf_ptrs,
+                                          col_sizes,
+                                          *col_elem_sizes,
+                                          *output_column_size,
+                                          executor);
+        }
+      }
       return launchCpuCode(exe_unit,
                            compilation_context,
                            col_buf_ptrs,
@@ -301,6 +348,90 @@ ResultSetPtr TableFunctionExecutionContext::launchCpuCode(
   return mgr->query_buffers->getResultSetOwned(0);
 }
 
+ResultSetPtr TableFunctionExecutionContext::launchCpuCodePartitioned(
+    const TableFunctionExecutionUnit& exe_unit,
+    const TableFunctionCompilationContext* compilation_context,
+    std::vector<const int8_t*>& col_buf_ptrs,
+    std::vector<int64_t>& col_sizes,
+    const std::vector<size_t>& col_elem_sizes,
+    const size_t elem_count,
+    Executor* executor) {
+  CHECK_EQ(col_elem_sizes.size(), col_buf_ptrs.size());
+  CHECK_GT(g_table_function_partition_rows, size_t(0));
+  const size_t partition_count =
+      std::min(static_cast<size_t>(cpu_threads()),
+               (elem_count + g_table_function_partition_rows - 1) /
+                   g_table_function_partition_rows);
+  const size_t partition_rows = (elem_count + partition_count - 1) / partition_count;
+  VLOG(1) << "Running table function " << exe_unit.table_func.getName() << " over "
+          << partition_count << " partitions of " << partition_rows << " rows";
+
+  auto timer = DEBUG_TIMER(__func__);
+  std::vector<std::future<ResultSetPtr>> partition_threads;
+  for (size_t begin = 0; begin < elem_count; begin += partition_rows) {
+    const size_t end = std::min(begin + partition_rows, elem_count);
+    std::vector<const int8_t*> partition_col_buf_ptrs(col_buf_ptrs);
+    std::vector<int64_t> partition_col_sizes(col_sizes);
+    for (size_t i = 0; i < col_buf_ptrs.size(); ++i) {
+      if (col_elem_sizes[i]) {
+        partition_col_buf_ptrs[i] += begin * col_elem_sizes[i];
+        partition_col_sizes[i] = end - begin;
+      }
+    }
+    partition_threads.push_back(std::async(
+        std::launch::async,
+        [this,
+         &exe_unit,
+         compilation_context,
+         partition_col_buf_ptrs = std::move(partition_col_buf_ptrs),
+         partition_col_sizes = std::move(partition_col_sizes),
+         partition_elem_count = end - begin,
+         executor]() mutable {
+          return launchCpuCode(exe_unit,
+                               compilation_context,
+                               partition_col_buf_ptrs,
+                               partition_col_sizes,
+                               partition_elem_count,
+                               executor);
+        }));
+  }
+  std::vector<ResultSetPtr> partition_results;
+  size_t output_row_count = 0;
+  for (auto& partition_thread : partition_threads) {
+    partition_results.push_back(partition_thread.get());
+    output_row_count += partition_results.back()->entryCount();
+  }
+
+  // the buffers of the concatenated output are written here rather than through output
+  // Column instances of a table function call, the instances only receive the buffers
+  struct OutputColumn {
+    int8_t* ptr;
+    int64_t size;
+  };
+  const auto num_out_columns = exe_unit.target_exprs.size();
+  std::vector<OutputColumn> output_columns(num_out_columns);
+  auto mgr = std::make_unique<QueryOutputBufferMemoryManager>(
+      exe_unit, executor, col_buf_ptrs, row_set_mem_owner_);
+  for (size_t i = 0; i < num_out_columns; ++i) {
+    mgr->set_output_column(i, reinterpret_cast<int8_t*>(&output_columns[i]));
+  }
+  mgr->allocate_output_buffers(output_row_count);
+
+  // the outputs are columnar with all columns padded to 8 bytes
+  size_t partition_offset = 0;
+  for (const auto& partition_result : partition_results) {
+    const auto partition_row_count = partition_result->entryCount();
+    const auto partition_buffer = partition_result->getStorage()->getUnderlyingBuffer();
+    for (size_t i = 0; i < num_out_columns; ++i) {
+      std::memcpy(output_columns[i].ptr + partition_offset * sizeof(int64_t),
+                  partition_buffer + i * partition_row_count * sizeof(int64_t),
+                  partition_row_count * sizeof(int64_t));
+    }
+    partition_offset += partition_row_count;
+  }
+  return mgr->query_buffers->getResultSetOwned(0);
+}
+
 namespace {
 enum {
   ERROR_BUFFER,
@@ -20,6 +20,10 @@
 #include "QueryEngine/Descriptors/RowSetMemoryOwner.h"
 #include "QueryEngine/RelAlgExecutionUnit.h"
 
+// Minimum number of input rows of each partition of partitionable table functions run
+// in parallel on CPU, 0 to run them over all the input rows at once.
+extern size_t g_table_function_partition_rows;
+
 struct InputTableInfo;
 class TableFunctionCompilationContext;
 class ColumnFetcher;
@@ -48,6 +52,16 @@ class TableFunctionExecutionContext {
                              std::vector<int64_t>& col_sizes,
                              const size_t elem_count,
                              Executor* executor);
+  // Runs the table function over partitions of the input rows on CPU threads and
+  // concatenates the outputs of the partitions.
+  ResultSetPtr launchCpuCodePartitioned(
+      const TableFunctionExecutionUnit& exe_unit,
+      const TableFunctionCompilationContext* compilation_context,
+      std::vector<const int8_t*>& col_buf_ptrs,
+      std::vector<int64_t>& col_sizes,
+      const std::vector<size_t>& col_elem_sizes,
+      const size_t elem_count,
+      Executor* executor);
   ResultSetPtr launchGpuCode(const TableFunctionExecutionUnit& exe_unit,
                              const TableFunctionCompilationContext* compilation_context,
                              std::vector<const int8_t*>& col_buf_ptrs,
@@ -22,10 +22,11 @@
   set_output_row_size sets the row size of output Columns and
   allocates the corresponding column buffers.
 
-  `set_output_row_size` can be called exactly one time when entering a
+  `set_output_row_size` is called exactly one time when entering a
   table function (when not using TableFunctionSpecifiedParameter
-  sizer) or within a table function (when using
-  TableFunctionSpecifiedParameter sizer).
+  sizer), otherwise it is called within a table function (when using
+  TableFunctionSpecifiedParameter sizer), possibly several times with
+  growing row counts while the function emits its output.
 */
 extern "C" DEVICE RUNTIME_EXPORT void set_output_row_size(int64_t num_rows) {
   auto& mgr = QueryOutputBufferMemoryManager::get_singleton();
@@ -175,6 +175,19 @@ const std::map<std::string, std::string>& TableFunction::getOutputAnnotation(
   return getAnnotation(output_arg_idx + sql_args_.size());
 }
 
+bool TableFunction::isPartitionable() const {
+  if (!hasUserSpecifiedOutputSizeMultiplier()) {
+    return false;
+  }
+  for (const auto& annotation : annotations_) {
+    const auto it = annotation.find("partitionable");
+    if (it != annotation.end() && it->second == "true") {
+      return true;
+    }
+  }
+  return false;
+}
+
 std::pair<int32_t, int32_t> TableFunction::getInputID(const size_t idx) const {
   // if the annotation is of the form args<INT,INT>, it is refering to a column list
 #define PREFIX_LENGTH 5
@@ -73,6 +73,12 @@
     function implementation that must be equal or smaller to the
     allocated output column size.
 
+    A UserSpecifiedRowMultiplier sizer can be annotated with
+    `partitionable=true` when the output rows of any range of input
+    rows do not depend on the other input rows. Such table functions
+    may run over partitions of the input rows in parallel, the output
+    is then the concatenation of the outputs of the partitions.
+
   - the list of input argument types. The input argument type can be a
     scalar or a column type (that is `Column<scalar>`). Supported
     scalar types are int8, ..., int64, double, float, bool.
@@ -192,6 +198,8 @@ class TableFunction {
 
   OutputBufferSizeType getOutputRowSizeType() const { return output_sizer_.type; }
 
+  bool isPartitionable() const;
+
   size_t getOutputRowSizeParameter() const { return output_sizer_.val; }
 
   const std::map<std::string, std::string>& getAnnotation(const size_t idx) const;
@@ -495,3 +495,28 @@ int32_t ct_binding_columnlist(const Column<T>& input1,
   }
   return 1;
 }
+
+// clang-format off
+/*
+  UDTF: ct_repeat_values__cpu_(Cursor<int32_t>) -> Column<int32_t>
+*/
+// clang-format on
+// Emits every positive input value as many times as the value, growing the output
+// columns while emitting since the output size is not known upfront.
+EXTENSION_NOINLINE int32_t ct_repeat_values__cpu_(const Column<int32_t>& input,
+                                                  Column<int32_t>& out) {
+  int64_t output_row_count = 0;
+  set_output_row_size(1);
+  for (int64_t i = 0; i < input.size(); i++) {
+    if (input.isNull(i)) {
+      continue;
+    }
+    for (int32_t j = 0; j < input[i]; j++) {
+      if (output_row_count == out.size()) {
+        set_output_row_size(2 * out.size());
+      }
+      out[output_row_count++] = input[i];
+    }
+  }
+  return output_row_count;
+}
@@ -20,12 +20,15 @@
 #include "LockMgr/LockMgr.h"
 #include "Logger/Logger.h"
 #include "QueryEngine/Execute.h"
+#include "QueryEngine/ExternalCacheInvalidators.h"
 #include "Shared/misc.h"
 #include "Shared/scope.h"
 
 // By default, when rows are deleted, vacuum fragments with a least 10% deleted rows
 float g_vacuum_min_selectivity{0.1};
 
+extern bool g_cache_string_hash;
+
 TableOptimizer::TableOptimizer(const TableDescriptor* td,
                                Executor* executor,
                                const Catalog_Namespace::Catalog& cat)
@@ -550,3 +553,439 @@ void TableOptimizer::vacuumFragmentsAboveMinSelectivity(
     cat_.checkpointWithAutoRollback(td_->tableId);
   }
 }
+
+size_t TableOptimizer::vacuumFragmentsAboveDeletedFraction(
+    const float min_deleted_fraction,
+    const size_t max_bytes,
+    const std::function<bool()>& can_vacuum) const {
+  if (!td_->hasDeletedCol ||
+      td_->persistenceLevel != Data_Namespace::MemoryLevel::DISK_LEVEL ||
+      td_->maxRollbackEpochs == -1) {
+    return 0;
+  }
+  auto timer = DEBUG_TIMER(__func__);
+  const auto db_id = cat_.getDatabaseId();
+  size_t vacuumed_bytes{0};
+  for (const auto shard : cat_.getPhysicalTablesDescriptors(td_)) {
+    const auto cd = cat_.getDeletedColumn(shard);
+    CHECK(cd);
+    // Only count the deleted rows of fragments whose metadata shows deleted rows.
+    ChunkMetadataVector chunk_metadata_vec;
+    cat_.getDataMgr().getChunkMetadataVecForKeyPrefix(
+        chunk_metadata_vec, {db_id, shard->tableId, cd->columnId});
+    std::set<int> fragment_ids;
+    for (const auto& [chunk_key, chunk_metadata] : chunk_metadata_vec) {
+      if (chunk_metadata->chunkStats.max.tinyintval == 1) {
+        fragment_ids.emplace(chunk_key[CHUNK_KEY_FRAGMENT_IDX]);
+      }
+    }
+    if (fragment_ids.empty()) {
+      continue;
+    }
+
+    DeletedColumnStats deleted_column_stats;
+    {
+      mapd_unique_lock<mapd_shared_mutex> executor_lock(executor_->execute_mutex_);
+      ScopeGuard row_set_holder = [this] { executor_->row_set_mem_owner_ = nullptr; };
+      executor_->row_set_mem_owner_ =
+          std::make_shared<RowSetMemoryOwner>(ROW_SET_SIZE, /*num_threads=*/1);
+      deleted_column_stats =
+          getDeletedColumnStats(shard, getFragmentIndexes(shard, fragment_ids));
+      executor_->clearMetaInfoCache();
+    }
+
+    for (const auto fragment_id : fragment_ids) {
+      auto visible_row_count_it =
+          deleted_column_stats.visible_row_count_per_fragment.find(fragment_id);
+      if (visible_row_count_it ==
+          deleted_column_stats.visible_row_count_per_fragment.end()) {
+        continue;
+      }
+      const auto fragment = shard->fragmenter->getFragmentInfo(fragment_id);
+      const auto total_row_count = fragment->getPhysicalNumTuples();
+      if (!total_row_count) {
+        continue;
+      }
+      const float deleted_row_count = total_row_count - visible_row_count_it->second;
+      if (deleted_row_count / total_row_count < min_deleted_fraction) {
+        continue;
+      }
+      if ((max_bytes && vacuumed_bytes >= max_bytes) || (can_vacuum && !can_vacuum())) {
+        return vacuumed_bytes;
+      }
+      size_t fragment_bytes{0};
+      for (const auto& [column_id, chunk_metadata] :
+           fragment->getChunkMetadataMapPhysical()) {
+        fragment_bytes += chunk_metadata->numBytes;
+      }
+
+      // Same lock order as inserts, which may append to the fragment.
+      const auto insert_data_lock =
+          lockmgr::InsertDataLockMgr::getWriteLockForTable({db_id, td_->tableId});
+      const auto table_lock =
+          lockmgr::TableDataLockMgr::getWriteLockForTable({db_id, td_->tableId});
+      const auto table_epochs = cat_.getTableEpochs(db_id, td_->tableId);
+      try {
+        vacuumFragments(shard, {fragment_id});
+        cat_.checkpoint(td_->tableId);
+      } catch (...) {
+        cat_.setTableEpochsLogExceptions(db_id, table_epochs);
+        throw;
+      }
+      vacuumed_bytes += fragment_bytes;
+      VLOG(1) << "Vacuumed fragment " << fragment_id << " of table id "
+              << shard->tableId << " with " << deleted_row_count << " of "
+              << total_row_count << " rows deleted.";
+    }
+  }
+  return vacuumed_bytes;
+}
+
+namespace {
+
+bool is_clusterable_column(const ColumnDescriptor* cd) {
+  const auto& ti = cd->columnType;
+  if (ti.is_string()) {
+    // ordered on dictionary ids, which keeps equal strings together
+    return ti.get_compression() == kENCODING_DICT;
+  }
+  return !ti.is_array() && !ti.is_geometry() &&
+         (ti.is_number() || ti.is_time() || ti.is_boolean());
+}
+
+// Groups the fragments whose sort key ranges overlap, each group ordered by its minimum
+// sort key. Fragments with nulls extend to the end of the key space since nulls sort
+// last.
+template <typename T>
+std::vector<std::vector<int>> get_overlapping_fragment_groups(
+    const std::vector<Fragmenter_Namespace::FragmentInfo>& fragments,
+    const ColumnDescriptor* sort_cd) {
+  struct KeyRange {
+    T min;
+    T max;
+    int fragment_id;
+  };
+  std::vector<KeyRange> ranges;
+  for (const auto& fragment : fragments) {
+    if (!fragment.getPhysicalNumTuples()) {
+      continue;
+    }
+    const auto& chunk_metadata_map = fragment.getChunkMetadataMapPhysical();
+    const auto chunk_metadata_it = chunk_metadata_map.find(sort_cd->columnId);
+    CHECK(chunk_metadata_it != chunk_metadata_map.end());
+    const auto& stats = chunk_metadata_it->second->chunkStats;
+    const auto& ti = sort_cd->columnType;
+    KeyRange range;
+    if constexpr (std::is_floating_point_v<T>) {
+      range.min = ti.get_type() == kFLOAT ? stats.min.floatval : stats.min.doubleval;
+      range.max = ti.get_type() == kFLOAT ? stats.max.floatval : stats.max.doubleval;
+    } else {
+      range.min = extract_min_stat(stats, ti);
+      range.max = extract_max_stat(stats, ti);
+    }
+    if (stats.has_nulls) {
+      range.max = std::numeric_limits<T>::max();
+    }
+    if (range.max < range.min) {
+      // Only nulls.
+      range.min = range.max;
+    }
+    range.fragment_id = fragment.fragmentId;
+    ranges.push_back(range);
+  }
+  std::sort(ranges.begin(), ranges.end(), [](const KeyRange& a, const KeyRange& b) {
+    return a.min < b.min || (a.min == b.min && a.fragment_id < b.fragment_id);
+  });
+  std::vector<std::vector<int>> groups;
+  std::optional<T> group_max;
+  for (const auto& range : ranges) {
+    if (!group_max || !(range.min < *group_max)) {
+      groups.emplace_back();
+      group_max = range.max;
+    }
+    groups.back().push_back(range.fragment_id);
+    group_max = std::max(*group_max, range.max);
+  }
+  return groups;
+}
+
+}  // namespace
+
+size_t TableOptimizer::clusterFragments(const size_t max_fragments_per_merge,
+                                        const size_t max_bytes,
+                                        const std::function<bool()>& can_cluster) const {
+  if ((!td_->sortedColumnId && td_->clusterColumnIds.empty()) ||
+      td_->persistenceLevel != Data_Namespace::MemoryLevel::DISK_LEVEL ||
+      max_fragments_per_merge < 2) {
+    return 0;
+  }
+  const auto db_id = cat_.getDatabaseId();
+  size_t clustered_bytes{0};
+  for (const auto shard : cat_.getPhysicalTablesDescriptors(td_)) {
+    std::vector<const ColumnDescriptor*> cluster_cds;
+    for (const auto column_id : td_->clusterColumnIds.empty()
+                                    ? std::vector<int>{td_->sortedColumnId}
+                                    : td_->clusterColumnIds) {
+      const auto cd = cat_.getMetadataForColumn(shard->tableId, column_id);
+      CHECK(cd);
+      if (!is_clusterable_column(cd)) {
+        VLOG(1) << "Not clustering table " << td_->tableName << " on column "
+                << cd->columnName << " of type " << cd->columnType.to_string();
+        return clustered_bytes;
+      }
+      cluster_cds.push_back(cd);
+    }
+    auto timer = DEBUG_TIMER(__func__);
+    const auto fragments = shard->fragmenter->getFragmentsForQuery().fragments;
+    std::vector<std::vector<int>> merges;
+    if (cluster_cds.size() > 1) {
+      // The Z-order ranges of the fragments can't be told from the stats of each
+      // column, so the whole table is reordered.
+      std::vector<int> fragment_ids;
+      for (const auto& fragment : fragments) {
+        if (fragment.getPhysicalNumTuples()) {
+          fragment_ids.push_back(fragment.fragmentId);
+        }
+      }
+      if (fragment_ids.size() > 1) {
+        merges.push_back(fragment_ids);
+      }
+    } else {
+      const auto cluster_cd = cluster_cds.front();
+      const auto groups =
+          cluster_cd->columnType.is_fp()
+              ? get_overlapping_fragment_groups<double>(fragments, cluster_cd)
+              : get_overlapping_fragment_groups<int64_t>(fragments, cluster_cd);
+      for (const auto& group : groups) {
+        for (size_t i = 0; i + 1 < group.size(); i += max_fragments_per_merge) {
+          const auto merge_end = std::min(group.size(), i + max_fragments_per_merge);
+          merges.emplace_back(group.begin() + i, group.begin() + merge_end);
+        }
+      }
+    }
+    // One pass over the overlaps found up front, a merge of part of a large group can
+    // leave overlaps for the next run to merge.
+    for (auto& fragment_ids : merges) {
+      if ((max_bytes && clustered_bytes >= max_bytes) ||
+          (can_cluster && !can_cluster())) {
+        return clustered_bytes;
+      }
+      // The smallest keys go to the lowest fragment id, in insert order.
+      std::sort(fragment_ids.begin(), fragment_ids.end());
+      size_t merge_bytes{0};
+      for (const auto fragment_id : fragment_ids) {
+        const auto fragment = shard->fragmenter->getFragmentInfo(fragment_id);
+        CHECK(fragment);
+        for (const auto& [column_id, chunk_metadata] :
+             fragment->getChunkMetadataMapPhysical()) {
+          merge_bytes += chunk_metadata->numBytes;
+        }
+      }
+
+      // Same lock order as inserts, which may append to the fragments.
+      const auto insert_data_lock =
+          lockmgr::InsertDataLockMgr::getWriteLockForTable({db_id, td_->tableId});
+      const auto table_lock =
+          lockmgr::TableDataLockMgr::getWriteLockForTable({db_id, td_->tableId});
+      const auto table_epochs = cat_.getTableEpochs(db_id, td_->tableId);
+      try {
+        UpdelRoll updel_roll;
+        updel_roll.catalog = &cat_;
+        updel_roll.logicalTableId = cat_.getLogicalTableId(shard->tableId);
+        updel_roll.memoryLevel = Data_Namespace::MemoryLevel::CPU_LEVEL;
+        updel_roll.table_descriptor = shard;
+        shard->fragmenter->clusterRows(
+            &cat_, shard, fragment_ids, cluster_cds, updel_roll.memoryLevel, updel_roll);
+        updel_roll.stageUpdate();
+        shard->fragmenter->resetSizesFromFragments();
+        cat_.checkpoint(td_->tableId);
+      } catch (...) {
+        cat_.setTableEpochsLogExceptions(db_id, table_epochs);
+        throw;
+      }
+      clustered_bytes += merge_bytes;
+      VLOG(1) << "Clustered " << fragment_ids.size() << " fragments of table id "
+              << shard->tableId << " on " << cluster_cds.size() << " columns.";
+    }
+  }
+  return clustered_bytes;
+}
+
+namespace {
+
+template <typename T>
+void mark_live_string_ids(const int8_t* data_addr,
+                          const size_t nrows,
+                          const T null_id,
+                          std::vector<bool>& is_live) {
+  const auto string_ids = reinterpret_cast<const T*>(data_addr);
+  for (size_t irow = 0; irow < nrows; ++irow) {
+    const auto string_id = string_ids[irow];
+    if (string_id != null_id) {
+      CHECK_LT(static_cast<size_t>(string_id), is_live.size());
+      is_live[string_id] = true;
+    }
+  }
+}
+
+// Live strings are moved to the compacted dictionary this many at a time.
+constexpr size_t kCompactedStringsBatchSize{1 << 20};
+
+}  // namespace
+
+size_t TableOptimizer::compactDictionaries() const {
+  if (td_->persistenceLevel != Data_Namespace::MemoryLevel::DISK_LEVEL || td_->nShards ||
+      !cat_.getStringDictionaryHosts().empty()) {
+    VLOG(1) << "Not compacting the dictionaries of table " << td_->tableName;
+    return 0;
+  }
+  auto timer = DEBUG_TIMER(__func__);
+  const auto db_id = cat_.getDatabaseId();
+  // Inserts add strings to the dictionaries, so they are locked out along with queries.
+  const auto insert_data_lock =
+      lockmgr::InsertDataLockMgr::getWriteLockForTable({db_id, td_->tableId});
+  const auto table_lock =
+      lockmgr::TableDataLockMgr::getWriteLockForTable({db_id, td_->tableId});
+  // Vacuuming drops the fragmenter of the table, this reloads it.
+  const auto td = cat_.getMetadataForTable(td_->tableId);
+  CHECK(td);
+  size_t removed_string_count{0};
+  for (const auto cd :
+       cat_.getAllColumnMetadataForTable(td_->tableId, false, false, true)) {
+    if (!cd->columnType.is_dict_encoded_string()) {
+      continue;
+    }
+    const auto dd = cat_.getMetadataForDict(cd->columnType.get_comp_param(), true);
+    CHECK(dd);
+    // Columns of other tables which share the dictionary are not locked.
+    if (dd->refcount != 1 || dd->dictIsTemp) {
+      VLOG(1) << "Not compacting the shared dictionary of column " << cd->columnName;
+      continue;
+    }
+    removed_string_count += compactDictionary(td, cd, *dd);
+  }
+  if (removed_string_count) {
+    UpdateTriggeredCacheInvalidator::invalidateCaches();
+  }
+  return removed_string_count;
+}
+
+size_t TableOptimizer::compactDictionary(const TableDescriptor* td,
+                                         const ColumnDescriptor* cd,
+                                         const DictDescriptor& dd) const {
+  const auto db_id = cat_.getDatabaseId();
+  const auto string_dict = dd.stringDict;
+  CHECK(string_dict);
+  const auto str_count = string_dict->storageEntryCount();
+  const auto null_id = inline_fixed_encoding_null_val(cd->columnType);
+  const auto fragments = td->fragmenter->getFragmentsForQuery().fragments;
+  std::vector<bool> is_live(str_count, false);
+  for (const auto& fragment : fragments) {
+    const auto& chunk_metadata_map = fragment.getChunkMetadataMapPhysical();
+    const auto chunk_metadata_it = chunk_metadata_map.find(cd->columnId);
+    CHECK(chunk_metadata_it != chunk_metadata_map.end());
+    const auto& chunk_metadata = chunk_metadata_it->second;
+    const auto chunk =
+        Chunk_NS::Chunk::getChunk(cd,
+                                  &cat_.getDataMgr(),
+                                  {db_id, td->tableId, cd->columnId, fragment.fragmentId},
+                                  Data_Namespace::MemoryLevel::CPU_LEVEL,
+                                  0,
+                                  chunk_metadata->numBytes,
+                                  chunk_metadata->numElements);
+    const auto data_addr = chunk->getBuffer()->getMemoryPtr();
+    const auto nrows = fragment.getPhysicalNumTuples();
+    switch (cd->columnType.get_size()) {
+      case 1:
+        mark_live_string_ids<uint8_t>(data_addr, nrows, null_id, is_live);
+        break;
+      case 2:
+        mark_live_string_ids<uint16_t>(data_addr, nrows, null_id, is_live);
+        break;
+      case 4:
+        mark_live_string_ids<int32_t>(data_addr, nrows, null_id, is_live);
+        break;
+      default:
+        UNREACHABLE();
+    }
+  }
+  const auto live_count =
+      static_cast<size_t>(std::count(is_live.begin(), is_live.end(), true));
+  if (live_count == str_count) {
+    return 0;
+  }
+
+  // Live strings keep their order, so ids only move down and still fit the encoding.
+  std::vector<int32_t> id_map(str_count, StringDictionary::INVALID_STR_ID);
+  const auto compacted_path = Catalog_Namespace::Catalog::getCompactedDictionaryPath(dd);
+  cat_.removeCompactedDictionary(dd);
+  try {
+    boost::filesystem::create_directory(compacted_path);
+    {
+      StringDictionary compacted_dict(compacted_path, false, false, g_cache_string_hash);
+      std::vector<std::string> strings;
+      std::vector<int32_t> old_ids;
+      std::vector<int32_t> new_ids;
+      const auto add_strings = [&]() {
+        new_ids.resize(strings.size());
+        compacted_dict.getOrAddBulk(strings, new_ids.data());
+        for (size_t i = 0; i < old_ids.size(); ++i) {
+          id_map[old_ids[i]] = new_ids[i];
+        }
+        strings.clear();
+        old_ids.clear();
+      };
+      for (size_t string_id = 0; string_id < str_count; ++string_id) {
+        if (!is_live[string_id]) {
+          continue;
+        }
+        strings.push_back(string_dict->getString(string_id));
+        old_ids.push_back(string_id);
+        if (strings.size() == kCompactedStringsBatchSize) {
+          add_strings();
+        }
+      }
+      add_strings();
+      if (!compacted_dict.checkpoint()) {
+        throw std::runtime_error("Failed to checkpoint the compacted dictionary " +
+                                 compacted_path);
+      }
+    }
+    cat_.writeDictionaryCompactionJournal(dd, td->tableId);
+  } catch (...) {
+    cat_.removeCompactedDictionary(dd);
+    throw;
+  }
+
+  const auto table_epochs = cat_.getTableEpochs(db_id, td->tableId);
+  try {
+    UpdelRoll updel_roll;
+    updel_roll.catalog = &cat_;
+    updel_roll.logicalTableId = td->tableId;
+    updel_roll.memoryLevel = Data_Namespace::MemoryLevel::CPU_LEVEL;
+    updel_roll.table_descriptor = td;
+    for (const auto& fragment : fragments) {
+      td->fragmenter->remapDictionaryIds(&cat_,
+                                          td,
+                                          cd,
+                                          fragment.fragmentId,
+                                          id_map,
+                                          updel_roll.memoryLevel,
+                                          updel_roll);
+    }
+    updel_roll.stageUpdate();
+    cat_.checkpoint(td->tableId);
+  } catch (...) {
+    cat_.setTableEpochsLogExceptions(db_id, table_epochs);
+    cat_.removeCompactedDictionary(dd);
+    throw;
+  }
+  // The table checkpointed past the journaled epoch, the compacted copy is now the
+  // dictionary even if the swap below is interrupted.
+  cat_.replaceWithCompactedDictionary(dd.dictRef.dictId);
+  const auto removed_string_count = str_count - live_count;
+  LOG(INFO) << "Removed " << removed_string_count << " unreferenced strings from the "
+            << "dictionary of column " << cd->columnName << " of table "
+            << td->tableName;
+  return removed_string_count;
+}
@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <functional>
+
 #include "Catalog/Catalog.h"
 
 class Executor;
@@ -72,7 +74,47 @@ class TableOptimizer {
   void vacuumFragmentsAboveMinSelectivity(
       const TableUpdateMetadata& table_update_metadata) const;
 
+  /**
+   * Vacuums the fragments whose fraction of deleted rows is at least
+   * `min_deleted_fraction`, one fragment per acquisition of the table write lock. Stops
+   * once the chunks of the vacuumed fragments add up to `max_bytes`, 0 for no limit, or
+   * once `can_vacuum`, asked before each fragment, returns false. Returns the chunk
+   * bytes of the vacuumed fragments.
+   */
+  size_t vacuumFragmentsAboveDeletedFraction(
+      const float min_deleted_fraction,
+      const size_t max_bytes,
+      const std::function<bool()>& can_vacuum) const;
+
+  /**
+   * Merges fragments whose sort column (SORT_COLUMN table option) ranges overlap,
+   * sorting the rows of up to `max_fragments_per_merge` fragments together per
+   * acquisition of the table write lock, so that later filters on the sort column skip
+   * more fragments. Stops once the chunks of the merged fragments add up to
+   * `max_bytes`, 0 for no limit, or once `can_cluster`, asked before each merge, returns
+   * false. Returns the chunk bytes of the merged fragments.
+   *
+   * Tables with several CLUSTER_COLUMNS are instead reordered as a whole on a Z-order
+   * curve over those columns, so that filters on any of them skip fragments.
+   */
+  size_t clusterFragments(const size_t max_fragments_per_merge,
+                          const size_t max_bytes,
+                          const std::function<bool()>& can_cluster) const;
+
+  /**
+   * Rebuilds the dictionaries of the dictionary encoded string columns with only the
+   * strings the table still references, and rewrites the chunks of those columns to the
+   * new ids. Dictionaries shared with other columns, dictionaries of sharded tables and
+   * remote dictionaries are left alone. Strings only referenced by deleted rows stay
+   * until the table is vacuumed. Returns the number of strings removed.
+   */
+  size_t compactDictionaries() const;
+
  private:
+  size_t compactDictionary(const TableDescriptor* td,
+                           const ColumnDescriptor* cd,
+                           const DictDescriptor& dd) const;
+
   DeletedColumnStats recomputeDeletedColumnMetadata(
       const TableDescriptor* td,
       const std::set<size_t>& fragment_indexes = {}) const;
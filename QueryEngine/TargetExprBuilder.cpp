@@ -36,6 +36,8 @@
 #define LL_FP(v) executor->cgen_state_->llFp(v)
 #define ROW_FUNC executor->cgen_state_->row_func_
 
+size_t g_gpu_warp_agg_max_entries{64};
+
 namespace {
 
 inline bool is_varlen_projection(const Analyzer::Expr* target_expr,
@@ -93,6 +95,18 @@ inline bool is_columnar_projection(const QueryMemoryDescriptor& query_mem_desc)
          query_mem_desc.didOutputColumnar();
 }
 
+// With few groups, many lanes of a warp update the same slot and the atomics serialize.
+bool use_warp_aggregation(const std::string& agg_fname,
+                          const QueryMemoryDescriptor& query_mem_desc) {
+  if (query_mem_desc.getQueryDescriptionType() !=
+          QueryDescriptionType::GroupByPerfectHash ||
+      query_mem_desc.getEntryCount() > g_gpu_warp_agg_max_entries) {
+    return false;
+  }
+  return agg_fname == "agg_count" || agg_fname == "agg_count_int32" ||
+         agg_fname == "agg_sum" || agg_fname == "agg_sum_int32";
+}
+
 bool is_simple_count(const TargetInfo& target_info) {
   return target_info.is_agg && target_info.agg_kind == kCOUNT && !target_info.is_distinct;
 }
@@ -540,10 +554,16 @@ void TargetExprCodegen::codegenAggregate(
       if (!target_info.is_distinct) {
         if (co.device_type == ExecutorDeviceType::GPU &&
             query_mem_desc.threadsShareMemory()) {
+          if (is_group_by && use_warp_aggregation(agg_fname, query_mem_desc)) {
+            agg_fname += "_warp";
+          }
           agg_fname += "_shared";
           if (needs_unnest_double_patch) {
             agg_fname = patch_agg_fname(agg_fname);
           }
+        } else if (query_mem_desc.useSharedCpuGroupByBuffer()) {
+          // other CPU kernels update the same group concurrently
+          agg_fname += "_atomic";
         }
         auto agg_fname_call_ret_lv = group_by_and_agg->emitCall(agg_fname, agg_args);
 
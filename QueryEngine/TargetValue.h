@@ -166,4 +166,29 @@ using GeoTargetValuePtr = boost::variant<GeoPointTargetValuePtr,
 using TargetValue = boost::
     variant<ScalarTargetValue, ArrayTargetValue, GeoTargetValue, GeoTargetValuePtr>;
 
+// A column of a batch of rows, filled by ResultSet::getNextRowBatch() and
+// ResultSet::getRowBatchAt(). Scalars land in the typed vector which matches the
+// decoded value, everything else (arrays, geo) is kept as a TargetValue in values.
+struct ColumnBatch {
+  std::vector<int64_t> int_values;
+  std::vector<double> double_values;
+  std::vector<float> float_values;
+  std::vector<std::string> str_values;
+  std::vector<TargetValue> values;
+  std::vector<bool> nulls;
+
+  size_t size() const { return nulls.size(); }
+
+  void clear() {
+    int_values.clear();
+    double_values.clear();
+    float_values.clear();
+    str_values.clear();
+    values.clear();
+    nulls.clear();
+  }
+
+  void append(TargetValue&& tv, const SQLTypeInfo& ti);
+};
+
 #endif  // QUERYENGINE_TARGETVALUE_H
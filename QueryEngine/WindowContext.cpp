@@ -16,7 +16,10 @@
 
 #include "QueryEngine/WindowContext.h"
 
+#include <algorithm>
+#include <atomic>
 #include <numeric>
+#include <optional>
 
 #include "QueryEngine/Descriptors/CountDistinctDescriptor.h"
 #include "QueryEngine/Execute.h"
@@ -24,8 +27,15 @@
 #include "QueryEngine/ResultSetBufferAccessors.h"
 #include "QueryEngine/RuntimeFunctions.h"
 #include "QueryEngine/TypePunning.h"
+#include "Shared/InlineNullValues.h"
+#include "Shared/Intervals.h"
+#include "Shared/SqlTypesLayout.h"
 #include "Shared/checked_alloc.h"
 #include "Shared/funcannotations.h"
+#include "Shared/thread_count.h"
+#include "Shared/threadpool.h"
+
+size_t g_parallel_window_partition_min{100000};
 
 WindowFunctionContext::WindowFunctionContext(
     const Analyzer::WindowFunction* window_func,
@@ -36,6 +46,7 @@ WindowFunctionContext::WindowFunctionContext(
     : window_func_(window_func)
     , partitions_(partitions)
     , elem_count_(elem_count)
+    , framed_aggregate_column_(nullptr)
     , output_(nullptr)
     , partition_start_(nullptr)
     , partition_end_(nullptr)
@@ -55,6 +66,22 @@ void WindowFunctionContext::addOrderColumn(
   order_columns_.push_back(column);
 }
 
+void WindowFunctionContext::addFramedAggregateColumn(
+    const int8_t* column,
+    const std::vector<std::shared_ptr<Chunk_NS::Chunk>>& chunks_owner) {
+  CHECK(window_func_->getFrame());
+  CHECK(!framed_aggregate_column_);
+  order_columns_owner_.push_back(chunks_owner);
+  framed_aggregate_column_ = column;
+}
+
+void WindowFunctionContext::setSortedPartitionBuffer(
+    const std::shared_ptr<std::vector<int64_t>>& sorted_partition_buf) {
+  CHECK(!output_);
+  CHECK(sorted_partition_buf->empty() || sorted_partition_buf->size() == elem_count_);
+  sorted_partition_buf_ = sorted_partition_buf;
+}
+
 namespace {
 
 // Converts the sorted indices to a mapping from row position to row number.
@@ -267,20 +294,68 @@ void apply_last_value_to_partition(const int32_t* original_indices,
       original_indices, original_indices + partition_size, output_for_partition_buff);
 }
 
+// Partitions computed in parallel can share the bitmap bytes at their boundaries.
+void set_partition_end_bit(const int8_t* partition_end, const size_t pos) {
+  __atomic_fetch_or(const_cast<int8_t*>(partition_end) + (pos >> 3),
+                    static_cast<int8_t>(1 << (pos & 7)),
+                    __ATOMIC_RELAXED);
+}
+
 void index_to_partition_end(
     const int8_t* partition_end,
     const size_t off,
     const int64_t* index,
     const size_t index_size,
     const std::function<bool(const int64_t lhs, const int64_t rhs)>& comparator) {
-  int64_t partition_end_handle = reinterpret_cast<int64_t>(partition_end);
   for (size_t i = 0; i < index_size; ++i) {
     if (advance_current_rank(comparator, index, i)) {
-      agg_count_distinct_bitmap(&partition_end_handle, off + i - 1, 0);
+      set_partition_end_bit(partition_end, off + i - 1);
     }
   }
   CHECK(index_size);
-  agg_count_distinct_bitmap(&partition_end_handle, off + index_size - 1, 0);
+  set_partition_end_bit(partition_end, off + index_size - 1);
+}
+
+// Sorts one run per thread, then merges pairs of adjacent runs in parallel until one is
+// left.
+template <class Comparator>
+void parallel_sort_partition(int64_t* begin, int64_t* end, const Comparator& comparator) {
+  const size_t thread_count = cpu_threads();
+  std::vector<std::pair<int64_t*, int64_t*>> runs;
+  threadpool::FuturesThreadPool<void> sort_threads;
+  for (auto interval : makeIntervals<size_t>(0, end - begin, thread_count)) {
+    if (interval.begin == interval.end) {
+      continue;
+    }
+    runs.emplace_back(begin + interval.begin, begin + interval.end);
+    sort_threads.spawn(
+        [&comparator](int64_t* run_begin, int64_t* run_end) {
+          std::sort(run_begin, run_end, std::cref(comparator));
+        },
+        runs.back().first,
+        runs.back().second);
+  }
+  sort_threads.join();
+  while (runs.size() > 1) {
+    std::vector<std::pair<int64_t*, int64_t*>> merged_runs;
+    threadpool::FuturesThreadPool<void> merge_threads;
+    for (size_t i = 0; i + 1 < runs.size(); i += 2) {
+      CHECK(runs[i].second == runs[i + 1].first);
+      merged_runs.emplace_back(runs[i].first, runs[i + 1].second);
+      merge_threads.spawn(
+          [&comparator](int64_t* run_begin, int64_t* run_middle, int64_t* run_end) {
+            std::inplace_merge(run_begin, run_middle, run_end, std::cref(comparator));
+          },
+          runs[i].first,
+          runs[i].second,
+          runs[i + 1].second);
+    }
+    if (runs.size() % 2) {
+      merged_runs.push_back(runs.back());
+    }
+    merge_threads.join();
+    runs.swap(merged_runs);
+  }
 }
 
 bool pos_is_set(const int64_t bitset, const int64_t pos) {
@@ -304,6 +379,113 @@ void apply_window_pending_outputs_int(const int64_t handle,
   pending_output_slots.clear();
 }
 
+// Bottom-up segment tree over the values of a partition in window order, answers the
+// aggregate of any range of positions in logarithmic time. Null values are skipped.
+template <class T, class Combine>
+class SegmentTree {
+ public:
+  SegmentTree(const std::vector<std::optional<T>>& values, const Combine& combine)
+      : leaf_count_(values.size()), nodes_(2 * values.size()), combine_(combine) {
+    std::copy(values.begin(), values.end(), nodes_.begin() + leaf_count_);
+    for (size_t i = leaf_count_ - 1; i > 0; --i) {
+      nodes_[i] = merge(nodes_[2 * i], nodes_[2 * i + 1]);
+    }
+  }
+
+  // Aggregate of the positions in [first, last], nullopt if all of them are null.
+  std::optional<T> query(size_t first, size_t last) const {
+    std::optional<T> result;
+    for (first += leaf_count_, last += leaf_count_ + 1; first < last;
+         first >>= 1, last >>= 1) {
+      if (first & 1) {
+        result = merge(result, nodes_[first++]);
+      }
+      if (last & 1) {
+        result = merge(result, nodes_[--last]);
+      }
+    }
+    return result;
+  }
+
+ private:
+  std::optional<T> merge(const std::optional<T>& lhs,
+                         const std::optional<T>& rhs) const {
+    if (!lhs) {
+      return rhs;
+    }
+    if (!rhs) {
+      return lhs;
+    }
+    return combine_(*lhs, *rhs);
+  }
+
+  const size_t leaf_count_;
+  std::vector<std::optional<T>> nodes_;
+  const Combine combine_;
+};
+
+// Returns the first and the last position of the frame of the row at the given position,
+// the frame is empty if the first one is greater.
+std::pair<int64_t, int64_t> get_frame_bounds(const Analyzer::WindowFunction::Frame& frame,
+                                             const int64_t pos,
+                                             const int64_t partition_size) {
+  // unbounded offsets must not overflow
+  const auto lower_offset =
+      std::clamp(frame.lower_offset, -partition_size, partition_size);
+  const auto upper_offset =
+      std::clamp(frame.upper_offset, -partition_size, partition_size);
+  return {std::max(pos + lower_offset, int64_t(0)),
+          std::min(pos + upper_offset, partition_size - 1)};
+}
+
+std::optional<int64_t> read_framed_integer_value(const int8_t* column,
+                                                 const SQLTypeInfo& ti,
+                                                 const int32_t row) {
+  int64_t value{0};
+  switch (ti.get_size()) {
+    case 1: {
+      value = column[row];
+      break;
+    }
+    case 2: {
+      value = reinterpret_cast<const int16_t*>(column)[row];
+      break;
+    }
+    case 4: {
+      value = reinterpret_cast<const int32_t*>(column)[row];
+      break;
+    }
+    case 8: {
+      value = reinterpret_cast<const int64_t*>(column)[row];
+      break;
+    }
+    default: {
+      LOG(FATAL) << "Invalid type size: " << ti.get_size();
+    }
+  }
+  if (value == inline_fixed_encoding_null_val(ti)) {
+    return std::nullopt;
+  }
+  return value;
+}
+
+std::optional<double> read_framed_fp_value(const int8_t* column,
+                                           const SQLTypeInfo& ti,
+                                           const int32_t row) {
+  if (ti.get_type() == kFLOAT) {
+    const auto value = reinterpret_cast<const float*>(column)[row];
+    if (value == NULL_FLOAT) {
+      return std::nullopt;
+    }
+    return value;
+  }
+  const auto value = reinterpret_cast<const double*>(column)[row];
+  if (value == NULL_DOUBLE) {
+    return std::nullopt;
+  }
+  return value;
+}
+
 }  // namespace
 
 extern "C" RUNTIME_EXPORT void apply_window_pending_outputs_int64(const int64_t handle,
@@ -386,7 +568,7 @@ extern "C" RUNTIME_EXPORT void add_window_pending_output(void* pending_output,
 // Returns true iff the aggregate window function requires special multiplicity handling
 // to ensure that peer rows have the same value for the window function.
 bool window_function_requires_peer_handling(const Analyzer::WindowFunction* window_func) {
-  if (!window_function_is_aggregate(window_func->getKind())) {
+  if (!window_function_is_aggregate(window_func->getKind()) || window_func->getFrame()) {
     return false;
   }
   if (window_func->getOrderKeys().empty()) {
@@ -408,74 +590,76 @@ void WindowFunctionContext::compute() {
   output_ = static_cast<int8_t*>(row_set_mem_owner_->allocate(
       elem_count_ * window_function_buffer_element_size(window_func_->getKind()),
       /*thread_idx=*/0));
-  if (window_function_is_aggregate(window_func_->getKind())) {
+  const bool is_framed_aggregate = window_func_->getFrame().has_value();
+  if (window_function_is_aggregate(window_func_->getKind()) && !is_framed_aggregate) {
     fillPartitionStart();
     if (window_function_requires_peer_handling(window_func_)) {
       fillPartitionEnd();
     }
   }
   std::unique_ptr<int64_t[]> scratchpad(new int64_t[elem_count_]);
-  int64_t off = 0;
-  for (size_t i = 0; i < partitionCount(); ++i) {
-    auto partition_size = counts()[i];
-    if (partition_size == 0) {
-      continue;
+  const bool sort_partitions = !sorted_partition_buf_ || sorted_partition_buf_->empty();
+  if (sorted_partition_buf_ && sort_partitions) {
+    sorted_partition_buf_->resize(elem_count_);
+  }
+  const size_t partition_count = partitionCount();
+  // Value and aggregate functions address the rows of a partition at the sum of the sizes
+  // of the partitions before it.
+  std::vector<size_t> partition_offs(partition_count);
+  size_t off = 0;
+  for (size_t i = 0; i < partition_count; ++i) {
+    partition_offs[i] = off;
+    if (window_function_is_value(window_func_->getKind()) ||
+        window_function_is_aggregate(window_func_->getKind())) {
+      off += counts()[i];
     }
-    auto output_for_partition_buff = scratchpad.get() + offsets()[i];
-    std::iota(output_for_partition_buff,
-              output_for_partition_buff + partition_size,
-              int64_t(0));
-    std::vector<Comparator> comparators;
-    const auto& order_keys = window_func_->getOrderKeys();
-    const auto& collation = window_func_->getCollation();
-    CHECK_EQ(order_keys.size(), collation.size());
-    for (size_t order_column_idx = 0; order_column_idx < order_columns_.size();
-         ++order_column_idx) {
-      auto order_column_buffer = order_columns_[order_column_idx];
-      const auto order_col =
-          dynamic_cast<const Analyzer::ColumnVar*>(order_keys[order_column_idx].get());
-      CHECK(order_col);
-      const auto& order_col_collation = collation[order_column_idx];
-      const auto asc_comparator = makeComparator(order_col,
-                                                 order_column_buffer,
-                                                 payload() + offsets()[i],
-                                                 order_col_collation.nulls_first);
-      auto comparator = asc_comparator;
-      if (order_col_collation.is_desc) {
-        comparator = [asc_comparator](const int64_t lhs, const int64_t rhs) {
-          return asc_comparator(rhs, lhs);
-        };
+  }
+  if (elem_count_ <= g_parallel_window_partition_min || cpu_threads() < 2) {
+    for (size_t i = 0; i < partition_count; ++i) {
+      sortAndComputePartition(i,
+                              scratchpad.get() + offsets()[i],
+                              partition_offs[i],
+                              sort_partitions,
+                              false);
+    }
+  } else {
+    // Large partitions are sorted by all the threads, one after another. The other ones
+    // are sorted and computed as a whole by each thread.
+    std::vector<size_t> small_partitions;
+    for (size_t i = 0; i < partition_count; ++i) {
+      if (static_cast<size_t>(counts()[i]) > g_parallel_window_partition_min) {
+        sortAndComputePartition(i,
+                                scratchpad.get() + offsets()[i],
+                                partition_offs[i],
+                                sort_partitions,
+                                true);
+      } else if (counts()[i]) {
+        small_partitions.push_back(i);
       }
-      comparators.push_back(comparator);
     }
-    const auto col_tuple_comparator = [&comparators](const int64_t lhs,
-                                                     const int64_t rhs) {
-      for (const auto& comparator : comparators) {
-        if (comparator(lhs, rhs)) {
-          return true;
+    std::atomic<size_t> next_small_partition{0};
+    threadpool::FuturesThreadPool<void> partition_threads;
+    for (int thread_idx = 0; thread_idx < cpu_threads(); ++thread_idx) {
+      partition_threads.spawn([&] {
+        for (size_t j = next_small_partition++; j < small_partitions.size();
+             j = next_small_partition++) {
+          const auto i = small_partitions[j];
+          sortAndComputePartition(i,
+                                  scratchpad.get() + offsets()[i],
+                                  partition_offs[i],
+                                  sort_partitions,
+                                  false);
         }
-      }
-      return false;
-    };
-    std::sort(output_for_partition_buff,
-              output_for_partition_buff + partition_size,
-              col_tuple_comparator);
-    computePartition(output_for_partition_buff,
-                     partition_size,
-                     off,
-                     window_func_,
-                     col_tuple_comparator);
-    if (window_function_is_value(window_func_->getKind()) ||
-        window_function_is_aggregate(window_func_->getKind())) {
-      off += partition_size;
+      });
     }
+    partition_threads.join();
   }
   if (window_function_is_value(window_func_->getKind()) ||
       window_function_is_aggregate(window_func_->getKind())) {
     CHECK_EQ(static_cast<size_t>(off), elem_count_);
   }
   auto output_i64 = reinterpret_cast<int64_t*>(output_);
-  if (window_function_is_aggregate(window_func_->getKind())) {
+  if (window_function_is_aggregate(window_func_->getKind()) && !is_framed_aggregate) {
     std::copy(scratchpad.get(), scratchpad.get() + elem_count_, output_i64);
   } else {
     for (size_t i = 0; i < elem_count_; ++i) {
@@ -484,6 +668,84 @@ void WindowFunctionContext::compute() {
   }
 }
 
+void WindowFunctionContext::sortAndComputePartition(const size_t partition_idx,
+                                                    int64_t* output_for_partition_buff,
+                                                    const size_t off,
+                                                    const bool sort_partition,
+                                                    const bool parallel_sort) {
+  const size_t partition_size = counts()[partition_idx];
+  if (partition_size == 0) {
+    return;
+  }
+  std::vector<Comparator> comparators;
+  const auto& order_keys = window_func_->getOrderKeys();
+  const auto& collation = window_func_->getCollation();
+  CHECK_EQ(order_keys.size(), collation.size());
+  for (size_t order_column_idx = 0; order_column_idx < order_columns_.size();
+       ++order_column_idx) {
+    auto order_column_buffer = order_columns_[order_column_idx];
+    const auto order_col =
+        dynamic_cast<const Analyzer::ColumnVar*>(order_keys[order_column_idx].get());
+    CHECK(order_col);
+    const auto& order_col_collation = collation[order_column_idx];
+    const auto asc_comparator = makeComparator(order_col,
+                                               order_column_buffer,
+                                               payload() + offsets()[partition_idx],
+                                               order_col_collation.nulls_first);
+    auto comparator = asc_comparator;
+    if (order_col_collation.is_desc) {
+      comparator = [asc_comparator](const int64_t lhs, const int64_t rhs) {
+        return asc_comparator(rhs, lhs);
+      };
+    }
+    comparators.push_back(comparator);
+  }
+  const auto col_tuple_comparator = [&comparators](const int64_t lhs,
+                                                   const int64_t rhs) {
+    for (const auto& comparator : comparators) {
+      if (comparator(lhs, rhs)) {
+        return true;
+      }
+    }
+    return false;
+  };
+  const auto sorted_partition_it =
+      sorted_partition_buf_ ? sorted_partition_buf_->begin() + offsets()[partition_idx]
+                            : std::vector<int64_t>::iterator();
+  if (!sort_partition) {
+    std::copy(sorted_partition_it,
+              sorted_partition_it + partition_size,
+              output_for_partition_buff);
+  } else {
+    std::iota(output_for_partition_buff,
+              output_for_partition_buff + partition_size,
+              int64_t(0));
+    if (parallel_sort) {
+      parallel_sort_partition(output_for_partition_buff,
+                              output_for_partition_buff + partition_size,
+                              col_tuple_comparator);
+    } else {
+      std::sort(output_for_partition_buff,
+                output_for_partition_buff + partition_size,
+                col_tuple_comparator);
+    }
+    if (sorted_partition_buf_) {
+      std::copy(output_for_partition_buff,
+                output_for_partition_buff + partition_size,
+                sorted_partition_it);
+    }
+  }
+  computePartition(output_for_partition_buff,
+                   partition_size,
+                   off,
+                   window_func_,
+                   col_tuple_comparator);
+}
+
+const std::shared_ptr<HashJoin>& WindowFunctionContext::getPartitions() const {
+  return partitions_;
+}
+
 const Analyzer::WindowFunction* WindowFunctionContext::getWindowFunction() const {
   return window_func_;
 }
@@ -713,6 +975,11 @@ void WindowFunctionContext::computePartition(
     case SqlWindowFunctionKind::SUM:
     case SqlWindowFunctionKind::COUNT: {
       const auto partition_row_offsets = payload() + off;
+      if (window_func->getFrame()) {
+        computeFramedAggregatePartition(
+            output_for_partition_buff, partition_size, partition_row_offsets);
+        break;
+      }
       if (window_function_requires_peer_handling(window_func)) {
         index_to_partition_end(
             partitionEnd(), off, output_for_partition_buff, partition_size, comparator);
@@ -728,6 +995,142 @@ void WindowFunctionContext::computePartition(
   }
 }
 
+void WindowFunctionContext::computeFramedAggregatePartition(
+    int64_t* output_for_partition_buff,
+    const size_t partition_size,
+    const int32_t* partition_row_offsets) const {
+  const auto& frame = *window_func_->getFrame();
+  const auto kind = window_func_->getKind();
+  const auto& window_ti = window_func_->get_type_info();
+  const auto& args = window_func_->getArgs();
+  const int64_t frame_partition_size = partition_size;
+  // The buffer holds the positions in the partition in window order, each aggregate goes
+  // to its row position like the rank functions do.
+  std::vector<int64_t> aggregates(partition_size);
+  // Same null sentinels as the aggregates computed while projecting.
+  auto null_ti = window_ti;
+  null_ti.set_compression(kENCODING_NONE);
+  null_ti.set_comp_param(0);
+  const auto null_val = window_ti.is_fp() ? 0 : inline_int_null_val(null_ti);
+  const auto set_aggregate = [&](const int64_t pos, const auto& value) {
+    auto& aggregate = aggregates[output_for_partition_buff[pos]];
+    if (window_ti.is_fp()) {
+      double fp_aggregate = value ? static_cast<double>(*value)
+                                  : (window_ti.get_type() == kFLOAT
+                                         ? static_cast<double>(NULL_FLOAT)
+                                         : NULL_DOUBLE);
+      aggregate = *reinterpret_cast<const int64_t*>(may_alias_ptr(&fp_aggregate));
+    } else {
+      aggregate = value ? static_cast<int64_t>(*value) : null_val;
+    }
+  };
+  const auto compute_aggregates = [&](const auto& values) {
+    using T = typename std::decay_t<decltype(values)>::value_type::value_type;
+    std::vector<int64_t> prefix_counts(partition_size + 1);
+    for (size_t pos = 0; pos < partition_size; ++pos) {
+      prefix_counts[pos + 1] = prefix_counts[pos] + (values[pos] ? 1 : 0);
+    }
+    const auto frame_count = [&prefix_counts](const int64_t first, const int64_t last) {
+      return first > last ? 0 : prefix_counts[last + 1] - prefix_counts[first];
+    };
+    const bool is_sum =
+        kind == SqlWindowFunctionKind::SUM || kind == SqlWindowFunctionKind::AVG;
+    std::vector<T> prefix_sums;
+    if (std::is_integral<T>::value && is_sum) {
+      prefix_sums.resize(partition_size + 1);
+      for (size_t pos = 0; pos < partition_size; ++pos) {
+        prefix_sums[pos + 1] = prefix_sums[pos] + values[pos].value_or(0);
+      }
+    }
+    // Subtracting floating point prefix sums loses precision, use the tree for those.
+    const auto plus = [](const T lhs, const T rhs) { return lhs + rhs; };
+    std::optional<SegmentTree<T, decltype(plus)>> sum_tree;
+    if (std::is_floating_point<T>::value && is_sum) {
+      sum_tree.emplace(values, plus);
+    }
+    const auto frame_sum = [&](const int64_t first, const int64_t last) {
+      return sum_tree ? sum_tree->query(first, last).value_or(0)
+                      : prefix_sums[last + 1] - prefix_sums[first];
+    };
+    const auto min = [](const T lhs, const T rhs) { return std::min(lhs, rhs); };
+    const auto max = [](const T lhs, const T rhs) { return std::max(lhs, rhs); };
+    std::optional<SegmentTree<T, decltype(min)>> min_tree;
+    std::optional<SegmentTree<T, decltype(max)>> max_tree;
+    if (kind == SqlWindowFunctionKind::MIN) {
+      min_tree.emplace(values, min);
+    } else if (kind == SqlWindowFunctionKind::MAX) {
+      max_tree.emplace(values, max);
+    }
+    double avg_scale{1};
+    if (kind == SqlWindowFunctionKind::AVG) {
+      const auto& arg_ti = args.front()->get_type_info();
+      avg_scale = arg_ti.is_decimal() ? exp_to_scale(arg_ti.get_scale()) : 1;
+    }
+    for (int64_t pos = 0; pos < frame_partition_size; ++pos) {
+      const auto [first, last] = get_frame_bounds(frame, pos, frame_partition_size);
+      const auto count = frame_count(first, last);
+      switch (kind) {
+        case SqlWindowFunctionKind::COUNT: {
+          set_aggregate(pos, std::optional<int64_t>(count));
+          break;
+        }
+        case SqlWindowFunctionKind::SUM: {
+          set_aggregate(pos,
+                        count ? std::optional<T>(frame_sum(first, last)) : std::nullopt);
+          break;
+        }
+        case SqlWindowFunctionKind::AVG: {
+          set_aggregate(pos,
+                        count ? std::optional<double>(static_cast<double>(
+                                                          frame_sum(first, last)) /
+                                                      count / avg_scale)
+                              : std::nullopt);
+          break;
+        }
+        case SqlWindowFunctionKind::MIN: {
+          set_aggregate(pos, count ? min_tree->query(first, last) : std::nullopt);
+          break;
+        }
+        case SqlWindowFunctionKind::MAX: {
+          set_aggregate(pos, count ? max_tree->query(first, last) : std::nullopt);
+          break;
+        }
+        default: {
+          CHECK(false);
+        }
+      }
+    }
+  };
+  if (args.empty()) {
+    // COUNT(*) counts every row of the frame
+    CHECK(kind == SqlWindowFunctionKind::COUNT);
+    compute_aggregates(std::vector<std::optional<int64_t>>(partition_size, int64_t(0)));
+  } else {
+    CHECK(framed_aggregate_column_);
+    const auto& arg_ti = args.front()->get_type_info();
+    if (arg_ti.is_fp()) {
+      std::vector<std::optional<double>> values(partition_size);
+      for (size_t pos = 0; pos < partition_size; ++pos) {
+        values[pos] = read_framed_fp_value(
+            framed_aggregate_column_,
+            arg_ti,
+            partition_row_offsets[output_for_partition_buff[pos]]);
+      }
+      compute_aggregates(values);
+    } else {
+      std::vector<std::optional<int64_t>> values(partition_size);
+      for (size_t pos = 0; pos < partition_size; ++pos) {
+        values[pos] = read_framed_integer_value(
+            framed_aggregate_column_,
+            arg_ti,
+            partition_row_offsets[output_for_partition_buff[pos]]);
+      }
+      compute_aggregates(values);
+    }
+  }
+  std::copy(aggregates.begin(), aggregates.end(), output_for_partition_buff);
+}
+
 void WindowFunctionContext::fillPartitionStart() {
   CountDistinctDescriptor partition_start_bitmap{CountDistinctImplType::Bitmap,
                                                  0,
@@ -23,6 +23,10 @@
 #include <functional>
 #include <unordered_map>
 
+// Rows of a window function above which its partitions are computed in parallel, and
+// rows of a partition above which the partition is sorted in parallel.
+extern size_t g_parallel_window_partition_min;
+
 // Returns true for value window functions, false otherwise.
 inline bool window_function_is_value(const SqlWindowFunctionKind kind) {
   switch (kind) {
@@ -62,7 +66,8 @@ class Executor;
 // rank functions, the code generated for the projection simply reads the values and
 // writes them to the result set. For value and aggregate functions, only the iteration
 // order is written to the buffer, the rest is handled by generating code in a similar way
-// we do for non-window queries.
+// we do for non-window queries. Aggregates over an explicit frame are the exception, they
+// are computed here like rank functions.
 class WindowFunctionContext {
  public:
   WindowFunctionContext(const Analyzer::WindowFunction* window_func,
@@ -82,9 +87,24 @@ class WindowFunctionContext {
                       const Analyzer::ColumnVar* col_var,
                       const std::vector<std::shared_ptr<Chunk_NS::Chunk>>& chunks_owner);
 
+  // Adds the argument column of an aggregate over an explicit frame to the context and
+  // keeps ownership of it.
+  void addFramedAggregateColumn(
+      const int8_t* column,
+      const std::vector<std::shared_ptr<Chunk_NS::Chunk>>& chunks_owner);
+
+  // Shares the sorted partitions with the window functions which have the same partition
+  // and order keys. An empty buffer gets filled by compute(), a filled one takes the
+  // place of sorting the partitions.
+  void setSortedPartitionBuffer(
+      const std::shared_ptr<std::vector<int64_t>>& sorted_partition_buf);
+
   // Computes the window function result to be used during the actual projection query.
   void compute();
 
+  // Returns the hash table which contains the partitions.
+  const std::shared_ptr<HashJoin>& getPartitions() const;
+
   // Returns a pointer to the window function associated with this context.
   const Analyzer::WindowFunction* getWindowFunction() const;
 
@@ -125,6 +145,14 @@ class WindowFunctionContext {
                                    const int32_t* partition_indices,
                                    const bool nulls_first);
 
+  // Sorts the partition in window order into the buffer, or copies it from the shared
+  // sorted partitions if it's not to be sorted, then computes it.
+  void sortAndComputePartition(const size_t partition_idx,
+                               int64_t* output_for_partition_buff,
+                               const size_t off,
+                               const bool sort_partition,
+                               const bool parallel_sort);
+
   void computePartition(
       int64_t* output_for_partition_buff,
       const size_t partition_size,
@@ -132,6 +160,12 @@ class WindowFunctionContext {
       const Analyzer::WindowFunction* window_func,
       const std::function<bool(const int64_t lhs, const int64_t rhs)>& comparator);
 
+  // Writes the aggregate over the frame of each row of a partition, given in window
+  // order, to the same buffer.
+  void computeFramedAggregatePartition(int64_t* output_for_partition_buff,
+                                       const size_t partition_size,
+                                       const int32_t* partition_row_offsets) const;
+
   void fillPartitionStart();
 
   void fillPartitionEnd();
@@ -149,8 +183,13 @@ class WindowFunctionContext {
   std::vector<std::vector<std::shared_ptr<Chunk_NS::Chunk>>> order_columns_owner_;
   // Order column buffers.
   std::vector<const int8_t*> order_columns_;
+  // Argument column buffer of an aggregate over an explicit frame.
+  const int8_t* framed_aggregate_column_;
   // Hash table which contains the partitions specified by the window.
   std::shared_ptr<HashJoin> partitions_;
+  // The row positions of the partitions in window order, shared with the window
+  // functions with the same partition and order keys.
+  std::shared_ptr<std::vector<int64_t>> sorted_partition_buf_;
   // The number of elements in the table.
   size_t elem_count_;
   // The output of the window function.
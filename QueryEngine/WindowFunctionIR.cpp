@@ -26,6 +26,22 @@ llvm::Value* Executor::codegenWindowFunction(const size_t target_index,
       WindowProjectNodeContext::get(this)->activateWindowFunctionContext(this,
                                                                          target_index);
   const auto window_func = window_func_context->getWindowFunction();
+  if (window_func->getFrame()) {
+    // framed aggregates are computed by the window function context
+    const auto& window_func_ti = window_func->get_type_info();
+    const auto output_lv = cgen_state_->llInt(
+        reinterpret_cast<const int64_t>(window_func_context->output()));
+    if (!window_func_ti.is_fp()) {
+      return cgen_state_->emitCall("row_number_window_func",
+                                   {output_lv, code_generator.posArg(nullptr)});
+    }
+    const auto aggregate_lv = cgen_state_->emitCall(
+        "percent_window_func", {output_lv, code_generator.posArg(nullptr)});
+    return window_func_ti.get_type() == kFLOAT
+               ? cgen_state_->ir_builder_.CreateFPTrunc(
+                     aggregate_lv, llvm::Type::getFloatTy(cgen_state_->context_))
+               : aggregate_lv;
+  }
   switch (window_func->getKind()) {
     case SqlWindowFunctionKind::ROW_NUMBER:
     case SqlWindowFunctionKind::RANK:
@@ -25,6 +25,10 @@ extern "C" __device__ int64_t get_block_index() {
   return blockIdx.x;
 }
 
+extern "C" __device__ int64_t get_block_dim() {
+  return blockDim.x;
+}
+
 extern "C" __device__ int32_t pos_start_impl(const int32_t* row_index_resume) {
   return blockIdx.x * blockDim.x + threadIdx.x;
 }
@@ -118,7 +122,7 @@ extern "C" __device__ bool dynamic_watchdog() {
   if (dw_cycle_budget == 0LL) {
     return false;  // Uninitialized watchdog can't check time
   }
-  if (dw_abort == 1) {
+  if (*reinterpret_cast<volatile int32_t*>(&dw_abort) == 1) {
     return true;  // Received host request to abort
   }
   uint32_t smid = get_smid();
@@ -157,8 +161,10 @@ extern "C" __device__ bool dynamic_watchdog() {
   return dw_should_terminate;
 }
 
+// The flag is set by the host while the kernel runs, as is dw_abort; a volatile load
+// keeps the compiler from hoisting it out of the row loop.
 extern "C" __device__ bool check_interrupt() {
-  return (runtime_interrupt_flag == 1) ? true : false;
+  return *reinterpret_cast<volatile int32_t*>(&runtime_interrupt_flag) == 1;
 }
 
 template <typename T = unsigned long long>
@@ -452,6 +458,70 @@ extern "C" __device__ int32_t agg_sum_int32_shared(int32_t* agg, const int32_t v
   return atomicAdd(agg, val);
 }
 
+// Warp aggregated variants, for group by buffers with few entries: the lanes of a warp
+// which update the same slot add up their values, and only the lowest of them issues the
+// atomic. Each lane gets back the value its own atomic would have returned.
+#if CUDA_VERSION > 10000 && defined(__CUDA_ARCH__) && __CUDA_ARCH__ >= 700
+template <typename T>
+__device__ T warp_peers_add(T* agg, const T val) {
+  const uint32_t peers =
+      __match_any_sync(__activemask(), reinterpret_cast<uint64_t>(agg));
+  const int lane = threadIdx.x & 31;
+  const int leader = __ffs(peers) - 1;
+  T total{0};
+  T preceding{0};
+  for (uint32_t remaining = peers; remaining; remaining &= remaining - 1) {
+    const int peer = __ffs(remaining) - 1;
+    const T peer_val = __shfl_sync(peers, val, peer);
+    total += peer_val;
+    if (peer < lane) {
+      preceding += peer_val;
+    }
+  }
+  T old{0};
+  if (lane == leader) {
+    old = atomicAdd(agg, total);
+  }
+  return __shfl_sync(peers, old, leader) + preceding;
+}
+#endif
+
+extern "C" __device__ uint64_t agg_count_warp_shared(uint64_t* agg, const int64_t val) {
+#if CUDA_VERSION > 10000 && defined(__CUDA_ARCH__) && __CUDA_ARCH__ >= 700
+  // Same 32-bit counter as agg_count_shared().
+  return static_cast<uint64_t>(
+      warp_peers_add(reinterpret_cast<uint32_t*>(agg), static_cast<uint32_t>(1)));
+#else
+  return agg_count_shared(agg, val);
+#endif
+}
+
+extern "C" __device__ uint32_t agg_count_int32_warp_shared(uint32_t* agg,
+                                                           const int32_t val) {
+#if CUDA_VERSION > 10000 && defined(__CUDA_ARCH__) && __CUDA_ARCH__ >= 700
+  return warp_peers_add(agg, static_cast<uint32_t>(1));
+#else
+  return agg_count_int32_shared(agg, val);
+#endif
+}
+
+extern "C" __device__ int64_t agg_sum_warp_shared(int64_t* agg, const int64_t val) {
+#if CUDA_VERSION > 10000 && defined(__CUDA_ARCH__) && __CUDA_ARCH__ >= 700
+  return warp_peers_add(reinterpret_cast<unsigned long long*>(agg),
+                        static_cast<unsigned long long>(val));
+#else
+  return agg_sum_shared(agg, val);
+#endif
+}
+
+extern "C" __device__ int32_t agg_sum_int32_warp_shared(int32_t* agg, const int32_t val) {
+#if CUDA_VERSION > 10000 && defined(__CUDA_ARCH__) && __CUDA_ARCH__ >= 700
+  return warp_peers_add(agg, val);
+#else
+  return agg_sum_int32_shared(agg, val);
+#endif
+}
+
 extern "C" __device__ void agg_sum_float_shared(int32_t* agg, const float val) {
   atomicAdd(reinterpret_cast<float*>(agg), val);
 }
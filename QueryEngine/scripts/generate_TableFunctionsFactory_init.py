@@ -39,6 +39,8 @@ Supported annotation labels are:
 
 - name: to specify argument name
 - input_id: to specify the dict id mapping for output TextEncodingDict columns.
+- partitionable: `true` on a RowMultiplier sizer when the table function can run
+  over partitions of its input rows and have its outputs concatenated.
 """
 # Author: Pearu Peterson
 # Created: January 2021
@@ -66,7 +68,7 @@ kConstant, kUserSpecifiedConstantParameter, kUserSpecifiedRowMultiplier, kTableF
 '''.strip().replace(' ', '').split(',')
 
 SupportedAnnotations = '''
-input_id, name
+input_id, name, partitionable
 '''.strip().replace(' ', '').split(',')
 
 translate_map = dict(
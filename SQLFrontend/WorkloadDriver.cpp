@@ -0,0 +1,640 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    WorkloadDriver.cpp
+ * @brief   Mixed workload load generator for a running server.
+ *
+ * Runs several classes of requests at once over Thrift, each with its own connections:
+ * weighted query mixes, ingest streams of load_table batches, and replays of the
+ * sql_execute calls of a server log. A class with a rate schedules its requests at
+ * random arrivals of that rate and reports how long they queued for a free
+ * connection, without a rate its connections send requests back to back.
+ *
+ * The workload is a JSON file:
+ *
+ * {
+ *   "duration_s": 60,
+ *   "classes": [
+ *     {"name": "dashboards", "concurrency": 16, "qps": 200,
+ *      "queries": [{"sql": "SELECT ...", "weight": 3}, {"sql": "SELECT ..."}]},
+ *     {"name": "ingest", "concurrency": 2, "qps": 5,
+ *      "ingest": {"table": "t", "file": "rows.csv", "batch_rows": 10000}},
+ *     {"name": "replay", "concurrency": 8,
+ *      "replay": {"file": "omnisci_server.INFO", "speed": 2.0}}
+ *   ]
+ * }
+ *
+ * and the report gives, per class, the throughput and the p50, p95 and p99 of the
+ * latency, of the queue time and of the time the server reports for its queries.
+ */
+
+#include <rapidjson/document.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/program_options.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Shared/ThriftClient.h"
+#include "gen-cpp/OmniSci.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct ConnectionParams {
+  std::string server_host{"localhost"};
+  int port{6274};
+  bool http{false};
+  bool https{false};
+  bool skip_host_verify{false};
+  std::string ca_cert_name;
+  std::string user_name{"admin"};
+  std::string passwd{"HyperInteractive"};
+  std::string db_name;
+};
+
+struct Connection {
+  explicit Connection(const ConnectionParams& params)
+      : thrift_connection(params.server_host,
+                          params.port,
+                          params.https  ? ThriftConnectionType::HTTPS
+                          : params.http ? ThriftConnectionType::HTTP
+                                        : ThriftConnectionType::BINARY,
+                          params.skip_host_verify,
+                          params.ca_cert_name,
+                          params.ca_cert_name)
+      , client(thrift_connection.get_protocol()) {
+    client.connect(session, params.user_name, params.passwd, params.db_name);
+  }
+
+  ~Connection() {
+    try {
+      client.disconnect(session);
+    } catch (const std::exception&) {
+    }
+  }
+
+  ThriftClientConnection thrift_connection;
+  OmniSciClient client;
+  TSessionId session;
+};
+
+// A query to run, or a batch of rows to load, at a given time.
+struct Request {
+  Clock::time_point scheduled;
+  const std::string* sql{nullptr};
+  const std::vector<TStringRow>* rows{nullptr};
+};
+
+struct Samples {
+  std::vector<double> latency_ms;
+  std::vector<double> queue_ms;
+  std::vector<double> server_ms;
+  size_t errors{0};
+  size_t rows{0};
+
+  void append(const Samples& other) {
+    latency_ms.insert(latency_ms.end(), other.latency_ms.begin(), other.latency_ms.end());
+    queue_ms.insert(queue_ms.end(), other.queue_ms.begin(), other.queue_ms.end());
+    server_ms.insert(server_ms.end(), other.server_ms.begin(), other.server_ms.end());
+    errors += other.errors;
+    rows += other.rows;
+  }
+};
+
+struct WorkloadClass {
+  std::string name;
+  size_t concurrency{1};
+  double qps{0};
+
+  std::vector<std::string> queries;
+  std::vector<double> weights;
+
+  std::string ingest_table;
+  std::vector<std::vector<TStringRow>> ingest_batches;
+
+  // Offsets from the first replayed query, in seconds, and queries.
+  std::vector<std::pair<double, std::string>> replay;
+  double replay_speed{1};
+
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::deque<Request> queue;
+  bool done{false};
+  Samples samples;
+};
+
+std::vector<std::vector<TStringRow>> read_ingest_batches(const std::string& file_path,
+                                                         const std::string& delimiter,
+                                                         const std::string& null_str,
+                                                         const size_t batch_rows) {
+  std::ifstream file(file_path);
+  if (!file) {
+    throw std::runtime_error("Could not open ingest file " + file_path);
+  }
+  std::vector<std::vector<TStringRow>> batches(1);
+  std::string line;
+  while (std::getline(file, line)) {
+    if (line.empty()) {
+      continue;
+    }
+    std::vector<std::string> fields;
+    boost::split(fields, line, boost::is_any_of(delimiter));
+    TStringRow row;
+    for (const auto& field : fields) {
+      TStringValue value;
+      value.is_null = field == null_str;
+      value.str_val = value.is_null ? "" : field;
+      row.cols.push_back(value);
+    }
+    if (batches.back().size() == batch_rows) {
+      batches.emplace_back();
+    }
+    batches.back().push_back(std::move(row));
+  }
+  if (batches.back().empty()) {
+    throw std::runtime_error("No rows in ingest file " + file_path);
+  }
+  return batches;
+}
+
+// Reads the queries of the sql_execute stdlog lines of a server log, with the time of
+// each line. The values of a stdlog line are quoted with their quotes doubled, the
+// query first.
+std::vector<std::pair<double, std::string>> read_replay_log(
+    const std::string& file_path) {
+  std::ifstream file(file_path);
+  if (!file) {
+    throw std::runtime_error("Could not open replay log " + file_path);
+  }
+  std::vector<std::pair<double, std::string>> replay;
+  std::optional<boost::posix_time::ptime> first_time;
+  std::string line;
+  while (std::getline(file, line)) {
+    if (line.find(" stdlog sql_execute ") == std::string::npos) {
+      continue;
+    }
+    const auto names_pos = line.find("{\"query_str\"");
+    if (names_pos == std::string::npos) {
+      continue;
+    }
+    const auto values_pos = line.find("} {\"", names_pos);
+    if (values_pos == std::string::npos) {
+      continue;
+    }
+    std::string query;
+    size_t pos = values_pos + 4;
+    for (; pos < line.size(); ++pos) {
+      if (line[pos] == '"') {
+        if (pos + 1 == line.size() || line[pos + 1] != '"') {
+          break;
+        }
+        ++pos;
+      }
+      query += line[pos];
+    }
+    if (pos == line.size()) {
+      continue;
+    }
+    const auto timestamp = line.substr(0, line.find(' '));
+    boost::posix_time::ptime time;
+    try {
+      time = boost::posix_time::time_from_string(
+          boost::algorithm::replace_first_copy(timestamp, "T", " "));
+    } catch (const std::exception&) {
+      continue;
+    }
+    if (!first_time) {
+      first_time = time;
+    }
+    replay.emplace_back((time - *first_time).total_microseconds() / 1e6, query);
+  }
+  if (replay.empty()) {
+    throw std::runtime_error("No sql_execute stdlog lines in " + file_path);
+  }
+  std::stable_sort(replay.begin(), replay.end(), [](const auto& lhs, const auto& rhs) {
+    return lhs.first < rhs.first;
+  });
+  return replay;
+}
+
+std::vector<std::unique_ptr<WorkloadClass>> read_workload(const std::string& file_path,
+                                                          double& duration_s) {
+  std::ifstream file(file_path);
+  if (!file) {
+    throw std::runtime_error("Could not open workload file " + file_path);
+  }
+  const std::string json((std::istreambuf_iterator<char>(file)),
+                         std::istreambuf_iterator<char>());
+  rapidjson::Document doc;
+  if (doc.Parse(json.c_str()).HasParseError() || !doc.IsObject() ||
+      !doc.HasMember("classes") || !doc["classes"].IsArray()) {
+    throw std::runtime_error("Workload file " + file_path +
+                             " must be an object with a \"classes\" array");
+  }
+  if (doc.HasMember("duration_s")) {
+    duration_s = doc["duration_s"].GetDouble();
+  }
+  std::vector<std::unique_ptr<WorkloadClass>> workload_classes;
+  for (const auto& spec : doc["classes"].GetArray()) {
+    auto workload_class = std::make_unique<WorkloadClass>();
+    workload_class->name = spec["name"].GetString();
+    if (spec.HasMember("concurrency")) {
+      workload_class->concurrency = spec["concurrency"].GetUint();
+    }
+    if (spec.HasMember("qps")) {
+      workload_class->qps = spec["qps"].GetDouble();
+    }
+    if (spec.HasMember("queries")) {
+      for (const auto& query : spec["queries"].GetArray()) {
+        workload_class->queries.emplace_back(query["sql"].GetString());
+        workload_class->weights.push_back(
+            query.HasMember("weight") ? query["weight"].GetDouble() : 1.0);
+      }
+    } else if (spec.HasMember("ingest")) {
+      const auto& ingest = spec["ingest"];
+      workload_class->ingest_table = ingest["table"].GetString();
+      workload_class->ingest_batches = read_ingest_batches(
+          ingest["file"].GetString(),
+          ingest.HasMember("delimiter") ? ingest["delimiter"].GetString() : ",",
+          ingest.HasMember("null_str") ? ingest["null_str"].GetString() : "\\N",
+          ingest.HasMember("batch_rows") ? ingest["batch_rows"].GetUint() : 10000);
+    } else if (spec.HasMember("replay")) {
+      const auto& replay = spec["replay"];
+      workload_class->replay = read_replay_log(replay["file"].GetString());
+      if (replay.HasMember("speed")) {
+        workload_class->replay_speed = replay["speed"].GetDouble();
+      }
+    } else {
+      throw std::runtime_error("Class " + workload_class->name +
+                               " needs \"queries\", \"ingest\" or \"replay\"");
+    }
+    workload_classes.push_back(std::move(workload_class));
+  }
+  return workload_classes;
+}
+
+double elapsed_ms(const Clock::time_point from, const Clock::time_point to) {
+  return std::chrono::duration<double, std::milli>(to - from).count();
+}
+
+class WorkloadDriver {
+ public:
+  WorkloadDriver(const ConnectionParams& connection_params,
+                 std::vector<std::unique_ptr<WorkloadClass>> workload_classes,
+                 const double duration_s)
+      : connection_params_(connection_params)
+      , workload_classes_(std::move(workload_classes))
+      , duration_(std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(duration_s))) {}
+
+  void run() {
+    start_ = Clock::now();
+    std::vector<std::thread> threads;
+    for (auto& workload_class : workload_classes_) {
+      if (workload_class->qps > 0 || !workload_class->replay.empty()) {
+        threads.emplace_back([this, &workload_class] { schedule(*workload_class); });
+      }
+      for (size_t i = 0; i < workload_class->concurrency; ++i) {
+        threads.emplace_back([this, &workload_class, i] { work(*workload_class, i); });
+      }
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    run_time_ = Clock::now() - start_;
+  }
+
+  void report(std::ostream& os, const bool json) const;
+
+ private:
+  Clock::time_point end() const { return start_ + duration_; }
+
+  Request makeRequest(WorkloadClass& workload_class,
+                      const size_t idx,
+                      std::mt19937& gen) const {
+    Request request;
+    request.scheduled = Clock::now();
+    if (!workload_class.queries.empty()) {
+      std::discrete_distribution<size_t> dist(workload_class.weights.begin(),
+                                              workload_class.weights.end());
+      request.sql = &workload_class.queries[dist(gen)];
+    } else if (!workload_class.ingest_batches.empty()) {
+      request.rows =
+          &workload_class.ingest_batches[idx % workload_class.ingest_batches.size()];
+    } else {
+      request.sql = &workload_class.replay[idx % workload_class.replay.size()].second;
+    }
+    return request;
+  }
+
+  // Queues the requests of a class at their arrival times, random arrivals at the rate
+  // of the class or the times of the replayed log.
+  void schedule(WorkloadClass& workload_class) {
+    std::mt19937 gen(std::hash<std::string>()(workload_class.name));
+    std::exponential_distribution<double> interarrival_s(
+        workload_class.qps > 0 ? workload_class.qps : 1);
+    auto next = start_;
+    for (size_t idx = 0;; ++idx) {
+      if (!workload_class.replay.empty()) {
+        if (idx == workload_class.replay.size()) {
+          break;
+        }
+        next = start_ + std::chrono::duration_cast<Clock::duration>(
+                            std::chrono::duration<double>(
+                                workload_class.replay[idx].first /
+                                workload_class.replay_speed));
+      } else {
+        next += std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(interarrival_s(gen)));
+      }
+      if (next >= end()) {
+        break;
+      }
+      std::this_thread::sleep_until(next);
+      auto request = makeRequest(workload_class, idx, gen);
+      request.scheduled = next;
+      {
+        std::lock_guard<std::mutex> lock(workload_class.mutex);
+        workload_class.queue.push_back(request);
+      }
+      workload_class.cv.notify_one();
+    }
+    {
+      std::lock_guard<std::mutex> lock(workload_class.mutex);
+      workload_class.done = true;
+    }
+    workload_class.cv.notify_all();
+  }
+
+  std::optional<Request> nextRequest(WorkloadClass& workload_class,
+                                     const size_t idx,
+                                     std::mt19937& gen) const {
+    if (workload_class.qps <= 0 && workload_class.replay.empty()) {
+      if (Clock::now() >= end()) {
+        return std::nullopt;
+      }
+      return makeRequest(workload_class, idx, gen);
+    }
+    std::unique_lock<std::mutex> lock(workload_class.mutex);
+    workload_class.cv.wait(
+        lock, [&] { return !workload_class.queue.empty() || workload_class.done; });
+    if (workload_class.queue.empty()) {
+      return std::nullopt;
+    }
+    const auto request = workload_class.queue.front();
+    workload_class.queue.pop_front();
+    return request;
+  }
+
+  void work(WorkloadClass& workload_class, const size_t worker_idx) {
+    std::unique_ptr<Connection> connection;
+    try {
+      connection = std::make_unique<Connection>(connection_params_);
+    } catch (const std::exception& e) {
+      std::cerr << workload_class.name << ": could not connect: " << e.what()
+                << std::endl;
+      return;
+    }
+    std::mt19937 gen(worker_idx + std::hash<std::string>()(workload_class.name));
+    Samples samples;
+    for (size_t idx = worker_idx;; idx += workload_class.concurrency) {
+      const auto request = nextRequest(workload_class, idx, gen);
+      if (!request) {
+        break;
+      }
+      const auto start = Clock::now();
+      try {
+        if (request->sql) {
+          TQueryResult result;
+          connection->client.sql_execute(
+              result, connection->session, *request->sql, true, "", -1, -1);
+          samples.server_ms.push_back(result.total_time_ms);
+        } else {
+          connection->client.load_table(
+              connection->session, workload_class.ingest_table, *request->rows, {});
+          samples.rows += request->rows->size();
+        }
+      } catch (const std::exception&) {
+        ++samples.errors;
+        continue;
+      }
+      const auto finish = Clock::now();
+      samples.latency_ms.push_back(elapsed_ms(start, finish));
+      samples.queue_ms.push_back(elapsed_ms(request->scheduled, start));
+    }
+    std::lock_guard<std::mutex> lock(workload_class.mutex);
+    workload_class.samples.append(samples);
+  }
+
+  const ConnectionParams connection_params_;
+  std::vector<std::unique_ptr<WorkloadClass>> workload_classes_;
+  const Clock::duration duration_;
+  Clock::time_point start_;
+  Clock::duration run_time_{0};
+};
+
+// Nearest rank percentile of the sorted `values`.
+double percentile(const std::vector<double>& values, const double p) {
+  if (values.empty()) {
+    return 0;
+  }
+  const size_t rank = std::ceil(p / 100 * values.size());
+  return values[std::max(rank, size_t(1)) - 1];
+}
+
+void WorkloadDriver::report(std::ostream& os, const bool json) const {
+  const double run_time_s = std::chrono::duration<double>(run_time_).count();
+  rapidjson::StringBuffer buffer;
+  rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+  writer.StartObject();
+  writer.Key("duration_s");
+  writer.Double(run_time_s);
+  writer.Key("classes");
+  writer.StartArray();
+  if (!json) {
+    os << std::left << std::setw(16) << "class" << std::right << std::setw(9)
+       << "requests" << std::setw(8) << "errors" << std::setw(10) << "req/s"
+       << std::setw(12) << "rows/s";
+    for (const auto* metric : {"latency", "queue", "server"}) {
+      for (const auto* p : {"p50", "p95", "p99"}) {
+        os << std::setw(13) << (std::string(metric) + " " + p);
+      }
+    }
+    os << "\n";
+  }
+  for (const auto& workload_class : workload_classes_) {
+    auto samples = workload_class->samples;
+    for (auto* values : {&samples.latency_ms, &samples.queue_ms, &samples.server_ms}) {
+      std::sort(values->begin(), values->end());
+    }
+    const std::array<std::pair<const char*, const std::vector<double>*>, 3> metrics{
+        {{"latency", &samples.latency_ms},
+         {"queue", &samples.queue_ms},
+         {"server", &samples.server_ms}}};
+    const auto requests = samples.latency_ms.size();
+    const double req_per_s = requests / run_time_s;
+    const double rows_per_s = samples.rows / run_time_s;
+    if (json) {
+      writer.StartObject();
+      writer.Key("name");
+      writer.String(workload_class->name.c_str());
+      writer.Key("requests");
+      writer.Uint64(requests);
+      writer.Key("errors");
+      writer.Uint64(samples.errors);
+      writer.Key("requests_per_s");
+      writer.Double(req_per_s);
+      writer.Key("rows_per_s");
+      writer.Double(rows_per_s);
+      for (const auto& [metric, values] : metrics) {
+        for (const auto p : {50, 95, 99}) {
+          const auto key = std::string(metric) + "_p" + std::to_string(p) + "_ms";
+          writer.Key(key.c_str());
+          writer.Double(percentile(*values, p));
+        }
+      }
+      writer.EndObject();
+    } else {
+      os << std::left << std::setw(16) << workload_class->name << std::right
+         << std::setw(9) << requests << std::setw(8) << samples.errors << std::fixed
+         << std::setprecision(1) << std::setw(10) << req_per_s << std::setw(12)
+         << rows_per_s;
+      for (const auto& metric : metrics) {
+        for (const auto p : {50, 95, 99}) {
+          os << std::setw(13) << percentile(*metric.second, p);
+        }
+      }
+      os << "\n";
+    }
+  }
+  writer.EndArray();
+  writer.EndObject();
+  if (json) {
+    os << buffer.GetString() << "\n";
+  }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  namespace po = boost::program_options;
+
+  ConnectionParams connection_params;
+  std::string workload_file;
+  double duration_s{60};
+  bool json{false};
+
+  po::options_description desc("Options");
+  desc.add_options()("help,h", "Print help messages");
+  desc.add_options()("workload",
+                     po::value<std::string>(&workload_file)->required(),
+                     "JSON file of the classes of requests to run.");
+  desc.add_options()("duration",
+                     po::value<double>(&duration_s),
+                     "Seconds to run for, overrides duration_s of the workload file.");
+  desc.add_options()("json",
+                     po::bool_switch(&json)->default_value(json),
+                     "Report in JSON instead of a table.");
+  desc.add_options()("server,s",
+                     po::value<std::string>(&connection_params.server_host)
+                         ->default_value(connection_params.server_host),
+                     "Server hostname.");
+  desc.add_options()(
+      "port,p",
+      po::value<int>(&connection_params.port)->default_value(connection_params.port),
+      "Port number.");
+  desc.add_options()("http",
+                     po::bool_switch(&connection_params.http)->default_value(false),
+                     "Use HTTP transport.");
+  desc.add_options()("https",
+                     po::bool_switch(&connection_params.https)->default_value(false),
+                     "Use HTTPS transport.");
+  desc.add_options()(
+      "skip-verify",
+      po::bool_switch(&connection_params.skip_host_verify)->default_value(false),
+      "Don't verify SSL certificate validity.");
+  desc.add_options()(
+      "ca-cert",
+      po::value<std::string>(&connection_params.ca_cert_name)->default_value(""),
+      "Path to trusted server certificate.");
+  desc.add_options()("user,u",
+                     po::value<std::string>(&connection_params.user_name)
+                         ->default_value(connection_params.user_name),
+                     "User name.");
+  desc.add_options()("passwd",
+                     po::value<std::string>(&connection_params.passwd)
+                         ->default_value(connection_params.passwd),
+                     "Password.");
+  desc.add_options()("db",
+                     po::value<std::string>(&connection_params.db_name),
+                     "Database name.");
+
+  po::positional_options_description positional_options;
+  positional_options.add("workload", 1);
+
+  po::variables_map vm;
+  try {
+    po::store(po::command_line_parser(argc, argv)
+                  .options(desc)
+                  .positional(positional_options)
+                  .run(),
+              vm);
+    if (vm.count("help")) {
+      std::cout << "Usage: WorkloadDriver <workload file> [options]\n" << desc;
+      return 0;
+    }
+    po::notify(vm);
+  } catch (const po::error& e) {
+    std::cerr << "Usage Error: " << e.what() << std::endl;
+    return 1;
+  }
+
+  try {
+    double workload_duration_s{duration_s};
+    auto workload_classes = read_workload(workload_file, workload_duration_s);
+    if (!vm.count("duration")) {
+      duration_s = workload_duration_s;
+    }
+    WorkloadDriver driver(connection_params, std::move(workload_classes), duration_s);
+    driver.run();
+    driver.report(std::cout, json);
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -797,6 +797,9 @@ void print_memory_info(ClientContext& context, std::string memory_level) {
 
       tss << std::endl;
     }
+    tss << "Free segments: " << nodeIt.num_free_segments
+        << ", largest: " << nodeIt.largest_free_segment_pages
+        << " pages, fragmentation: " << nodeIt.fragmentation_percent << "%" << std::endl;
     tss << "---------------------------------------------------------------" << std::endl;
   }
   std::cout << tss.str() << std::endl;
@@ -1088,6 +1091,10 @@ void print_status(ClientContext& context) {
         << ": " << buf << " : " << tm_ptr->tm_hour << ":" << tm_ptr->tm_min << ":"
         << tm_ptr->tm_sec << std::endl;
 
+    tss << std::left << std::setfill(' ') << std::setw(lhs_width);
+    tss << process_role + " Ready"
+        << ": " << (node->ready ? "true" : "false") << std::endl;
+
     if (agg_version != node->version) {
       tss << std::left << std::setfill(' ') << std::setw(lhs_width);
       tss << process_role + " Version "
@@ -208,6 +208,51 @@ void BloscCompressor::getBloscBufferSizes(const uint8_t* data_ptr,
   blosc_cbuffer_sizes(data_ptr, num_bytes_uncompressed, num_bytes_compressed, block_size);
 }
 
+size_t BloscCompressor::compressBlock(const uint8_t* buffer,
+                                      const size_t buffer_size,
+                                      uint8_t* compressed_buffer,
+                                      const size_t compressed_buffer_size,
+                                      const char* codec,
+                                      const size_t type_size,
+                                      const bool bit_shuffle) {
+  if (compressed_buffer_size < BLOSC_MIN_HEADER_LENGTH) {
+    return 0;
+  }
+  const auto compressed_len = blosc_compress_ctx(5,
+                                                 bit_shuffle ? BLOSC_BITSHUFFLE
+                                                             : BLOSC_SHUFFLE,
+                                                 type_size,
+                                                 buffer_size,
+                                                 buffer,
+                                                 compressed_buffer,
+                                                 compressed_buffer_size,
+                                                 codec,
+                                                 0 /* automatic block size */,
+                                                 1 /* single threaded */);
+  if (compressed_len < 0) {
+    throw CompressionFailedError(std::string("failed to compress block of length ") +
+                                 std::to_string(buffer_size) + " with " + codec);
+  }
+  return compressed_len;
+}
+
+size_t BloscCompressor::decompressBlock(const uint8_t* compressed_buffer,
+                                        uint8_t* decompressed_buffer,
+                                        const size_t decompressed_buffer_size) {
+  const auto decompressed_len = blosc_decompress_ctx(
+      compressed_buffer, decompressed_buffer, decompressed_buffer_size, 1);
+  if (decompressed_len < 0) {
+    throw CompressionFailedError(
+        std::string("failed to decompress block into buffer of length ") +
+        std::to_string(decompressed_buffer_size));
+  }
+  return decompressed_len;
+}
+
+bool BloscCompressor::isCodecAvailable(const char* codec) {
+  return blosc_compname_to_compcode(codec) >= 0;
+}
+
 BloscCompressor* BloscCompressor::instance = NULL;
 
 BloscCompressor* BloscCompressor::getCompressor() {
@@ -77,6 +77,22 @@ class BloscCompressor {
                            size_t* num_bytes_uncompressed,
                            size_t* block_size);
 
+  // Compress and decompress independent blocks, such as file pages, with the given blosc
+  // codec name. These do not use the global blosc state, so blocks can be processed
+  // concurrently. compressBlock() returns 0 if the compressed block does not fit. Bit
+  // shuffling suits data with few significant bits per value better than byte shuffling.
+  static size_t compressBlock(const uint8_t* buffer,
+                              const size_t buffer_size,
+                              uint8_t* compressed_buffer,
+                              const size_t compressed_buffer_size,
+                              const char* codec,
+                              const size_t type_size,
+                              const bool bit_shuffle = false);
+  static size_t decompressBlock(const uint8_t* compressed_buffer,
+                                uint8_t* decompressed_buffer,
+                                const size_t decompressed_buffer_size);
+  static bool isCodecAvailable(const char* codec);
+
   int setThreads(size_t num_threads);
 
   int setCompressor(std::string& compressor);
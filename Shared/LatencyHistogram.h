@@ -0,0 +1,65 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+/**
+ * Histogram of latencies in milliseconds over fixed bucket bounds, in the shape of a
+ * Prometheus histogram. Recording a latency is a few relaxed atomic adds, so it can be
+ * updated from any thread without a lock.
+ */
+class LatencyHistogram {
+ public:
+  // Upper bounds of the buckets, the last bucket counts the latencies above them all.
+  static constexpr std::array<int64_t, 10> kBucketBoundsMs{
+      1, 5, 10, 25, 50, 100, 250, 500, 1000, 5000};
+
+  struct Snapshot {
+    // Cumulative counts, bucket i counts the latencies of at most kBucketBoundsMs[i].
+    std::array<size_t, kBucketBoundsMs.size()> bucket_counts{};
+    size_t count{0};
+    int64_t sum_ms{0};
+  };
+
+  void record(const int64_t latency_ms) {
+    const auto bucket =
+        std::lower_bound(kBucketBoundsMs.begin(), kBucketBoundsMs.end(), latency_ms) -
+        kBucketBoundsMs.begin();
+    counts_[bucket].fetch_add(1, std::memory_order_relaxed);
+    sum_ms_.fetch_add(latency_ms, std::memory_order_relaxed);
+  }
+
+  Snapshot get() const {
+    Snapshot snapshot;
+    for (size_t i = 0; i < counts_.size(); ++i) {
+      snapshot.count += counts_[i].load(std::memory_order_relaxed);
+      if (i < kBucketBoundsMs.size()) {
+        snapshot.bucket_counts[i] = snapshot.count;
+      }
+    }
+    snapshot.sum_ms = sum_ms_.load(std::memory_order_relaxed);
+    return snapshot;
+  }
+
+ private:
+  std::array<std::atomic<size_t>, kBucketBoundsMs.size() + 1> counts_{};
+  std::atomic<int64_t> sum_ms_{0};
+};
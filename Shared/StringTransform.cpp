@@ -20,6 +20,7 @@
 #include <boost/algorithm/string/classification.hpp>  // Include boost::for is_any_of
 #include <boost/algorithm/string/split.hpp>           // Include for boost::split
 
+#include <algorithm>
 #include <numeric>
 #include <random>
 #include <regex>
@@ -249,6 +250,38 @@ std::string get_quoted_string(const std::string& filename, char quote, char esca
 #endif  // __CUDACC__
 
 #ifndef __CUDACC__
+std::vector<std::string> split_on_sql_parameter_markers(const std::string& sql) {
+  std::vector<std::string> parts(1);
+  char inside_quote = 0;
+  for (size_t i = 0; i < sql.size(); ++i) {
+    const char c = sql[i];
+    if (inside_quote) {
+      // a doubled quote ends and restarts the quoted region, which is the same
+      if (c == inside_quote) {
+        inside_quote = 0;
+      }
+    } else if (c == '\'' || c == '"') {
+      inside_quote = c;
+    } else if (c == '-' && i + 1 < sql.size() && sql[i + 1] == '-') {
+      const auto comment_end = std::min(sql.find('\n', i), sql.size());
+      parts.back().append(sql, i, comment_end - i);
+      i = comment_end - 1;
+      continue;
+    } else if (c == '/' && i + 1 < sql.size() && sql[i + 1] == '*') {
+      const auto comment_end = sql.find("*/", i + 2);
+      const auto end = comment_end == std::string::npos ? sql.size() : comment_end + 2;
+      parts.back().append(sql, i, end - i);
+      i = end - 1;
+      continue;
+    } else if (c == '?') {
+      parts.emplace_back();
+      continue;
+    }
+    parts.back() += c;
+  }
+  return parts;
+}
+
 std::string simple_sanitize(const std::string& str) {
   auto sanitized_str{str};
   for (auto& c : sanitized_str) {
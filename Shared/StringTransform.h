@@ -115,6 +115,12 @@ std::string strip(std::string_view str);
 bool remove_unquoted_newlines_linefeeds_and_tabs_from_sql_string(
     std::string& str) noexcept;
 
+#ifndef __CUDACC__
+//! split an SQL string on the ? parameter markers outside of quotes and comments, the
+//! result has one more part than there are markers
+std::vector<std::string> split_on_sql_parameter_markers(const std::string& sql);
+#endif  // __CUDACC__
+
 //! simple sanitize string (replace control characters with space)
 #ifndef __CUDACC__
 std::string simple_sanitize(const std::string& str);
@@ -71,7 +71,12 @@ struct SystemParameters {
   size_t calcite_timeout = 5000;     // calcite connect/send/receive timeout
   size_t calcite_keepalive = false;  // calcite keepalive connection
   int num_executors = 1;
+  int num_low_priority_executors = 0;        // executors for low priority queries, 0=all
+  std::string high_priority_query_grantees;  // users and roles whose queries go first
+  std::string low_priority_query_grantees;   // users and roles whose queries go last
   int num_sessions = -1;  // maximum number of user sessions
+  std::string calcite_warmup_queries_file;  // queries planned at startup to warm Calcite
+  size_t calcite_warmup_threads = 4;        // threads planning the warmup queries
 
   SystemParameters() : cuda_block_size(0), cuda_grid_size(0), calcite_max_mem(1024) {}
 };
@@ -23,6 +23,8 @@
 #include <type_traits>
 #include <vector>
 
+#include "Shared/threadpool.h"
+
 namespace ThreadController_NS {
 
 template <typename FutureReturnType>
@@ -68,7 +70,7 @@ class SimpleThreadController {
   }
   template <typename FuncType, typename... Args>
   void startThread(FuncType&& func, Args&&... args) {
-    threads_.emplace_back(std::async(std::launch::async, func, args...));
+    threads_.emplace_back(threadpool::async(func, args...));
   }
   virtual void finish() {
     for (auto& t : threads_) {
@@ -66,6 +66,12 @@ struct UpdelRoll {
   // level.
   void stageUpdate();
 
+  // Sets the catalog, logical table and memory level of the update. Fragments of a table
+  // may be updated concurrently through the same roll.
+  void setUpdatedTable(const Catalog_Namespace::Catalog* catalog,
+                       int logical_table_id,
+                       Data_Namespace::MemoryLevel memory_level);
+
   void addDirtyChunk(std::shared_ptr<Chunk_NS::Chunk> chunk, int fragment_id);
 
   std::shared_ptr<ChunkMetadata> getChunkMetadata(
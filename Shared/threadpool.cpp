@@ -0,0 +1,84 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Shared/threadpool.h"
+
+#include <chrono>
+#include <thread>
+
+#include "Shared/thread_count.h"
+
+namespace threadpool {
+
+namespace {
+
+// Workers above the cpu_threads() limit exit after being idle for this long.
+constexpr std::chrono::seconds kIdleWorkerTimeout{5};
+
+}  // namespace
+
+WorkerPool& WorkerPool::instance() {
+  // Never destroyed: detached workers may still be running during static destruction.
+  static auto pool = new WorkerPool();
+  return *pool;
+}
+
+size_t WorkerPool::workerCount() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return worker_count_;
+}
+
+size_t WorkerPool::idleWorkerCount() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return idle_worker_count_;
+}
+
+void WorkerPool::submit(std::function<void()> task) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  tasks_.push_back(std::move(task));
+  if (idle_worker_count_ >= tasks_.size()) {
+    cv_.notify_one();
+    return;
+  }
+  std::thread([this] { workerLoop(); }).detach();
+  ++worker_count_;
+}
+
+void WorkerPool::workerLoop() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    if (tasks_.empty()) {
+      ++idle_worker_count_;
+      const bool has_task =
+          cv_.wait_for(lock, kIdleWorkerTimeout, [this] { return !tasks_.empty(); });
+      --idle_worker_count_;
+      if (!has_task) {
+        if (worker_count_ > static_cast<size_t>(cpu_threads())) {
+          --worker_count_;
+          return;
+        }
+        continue;
+      }
+    }
+    auto task = std::move(tasks_.front());
+    tasks_.pop_front();
+    lock.unlock();
+    task();
+    lock.lock();
+  }
+}
+
+}  // namespace threadpool
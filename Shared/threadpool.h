@@ -20,18 +20,73 @@
 #include "tbb/task_group.h"
 #endif
 
+#include <condition_variable>
+#include <deque>
+#include <functional>
 #include <future>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <tuple>
 #include <type_traits>
 
 namespace threadpool {
 
+/*
+ * Process wide pool of persistent worker threads. Tasks never wait for a free worker:
+ * a new thread is started when all the workers are busy, so tasks which block on
+ * other tasks cannot deadlock the pool. Idle workers are kept around, up to
+ * cpu_threads() of them, which saves the thread creation and teardown for the many
+ * short parallel sections run by queries and loads.
+ */
+class WorkerPool {
+ public:
+  static WorkerPool& instance();
+
+  template <class Function, class... Args>
+  auto async(Function&& f, Args&&... args) {
+    using R = std::invoke_result_t<std::decay_t<Function>, std::decay_t<Args>...>;
+    auto task = std::make_shared<std::packaged_task<R()>>(
+        [f = std::decay_t<Function>(std::forward<Function>(f)),
+         args = std::make_tuple(std::forward<Args>(args)...)]() mutable {
+          return std::apply(f, std::move(args));
+        });
+    auto future = task->get_future();
+    submit([task] { (*task)(); });
+    return future;
+  }
+
+  size_t workerCount() const;
+
+  size_t idleWorkerCount() const;
+
+ private:
+  WorkerPool() = default;
+
+  void submit(std::function<void()> task);
+
+  void workerLoop();
+
+  mutable std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<std::function<void()>> tasks_;
+  size_t worker_count_{0};
+  size_t idle_worker_count_{0};
+};
+
+// Drop-in replacement for std::async(std::launch::async, ...) running on the pool.
+template <class Function, class... Args>
+auto async(Function&& f, Args&&... args) {
+  return WorkerPool::instance().async(std::forward<Function>(f),
+                                      std::forward<Args>(args)...);
+}
+
 template <typename T>
 class FuturesThreadPoolBase {
  public:
   template <class Function, class... Args>
   void spawn(Function&& f, Args&&... args) {
-    threads_.push_back(std::async(std::launch::async, f, args...));
+    threads_.push_back(threadpool::async(f, args...));
   }
 
  protected:
@@ -20,8 +20,12 @@
 #include <boost/filesystem/operations.hpp>
 #include <boost/filesystem/path.hpp>
 #include <boost/sort/spreadsort/string_sort.hpp>
+#include <algorithm>
+#include <fstream>
+#include <functional>
 #include <future>
 #include <iostream>
+#include <optional>
 #include <string_view>
 #include <thread>
 
@@ -36,6 +40,7 @@
 #include "OSDependent/omnisci_fs.h"
 #include "Shared/sqltypes.h"
 #include "Shared/thread_count.h"
+#include "Shared/threadpool.h"
 #include "StringDictionaryClient.h"
 #include "Utils/Regexp.h"
 #include "Utils/StringLike.h"
@@ -48,6 +53,17 @@ namespace {
 
 const int SYSTEM_PAGE_SIZE = omnisci::get_page_size();
 
+// Syncs the bytes [begin, end) of a mapped file, msync() needs a page aligned start.
+bool sync_mapped_range(void* map, const size_t begin, const size_t end) {
+  if (begin >= end) {
+    return true;
+  }
+  const size_t aligned_begin = begin - begin % SYSTEM_PAGE_SIZE;
+  return omnisci::msync(static_cast<char*>(map) + aligned_begin,
+                        end - aligned_begin,
+                        /*async=*/false) == 0;
+}
+
 int checked_open(const char* path, const bool recover) {
   auto fd = omnisci::open(path, O_RDWR | O_CREAT | (recover ? O_APPEND : O_TRUNC), 0644);
   if (fd > 0) {
@@ -85,9 +101,28 @@ string_dict_hash_t hash_string(const std::string_view& str) {
   }
   return str_hash;
 }
+
+// Layout of the DictHashTable file: the header, the hash table and, for dictionaries
+// which materialize hashes, the hashes of the first `str_count` strings.
+struct HashTableSnapshotHeader {
+  uint64_t magic;
+  uint32_t version;
+  uint32_t has_hashes;
+  uint64_t str_count;
+  uint64_t payload_file_off;
+  uint64_t table_size;
+  uint64_t collisions;
+};
+
+constexpr uint64_t kHashTableSnapshotMagic{0x4f4d4e4944494354};
+constexpr uint32_t kHashTableSnapshotVersion{1};
+// Number of strings looked up through a loaded snapshot to make sure it belongs to the
+// payload on disk.
+constexpr size_t kHashTableSnapshotChecks{1024};
 }  // namespace
 
 bool g_enable_stringdict_parallel{false};
+bool g_enable_stringdict_hash_table_snapshot{true};
 constexpr int32_t StringDictionary::INVALID_STR_ID;
 constexpr size_t StringDictionary::MAX_STRLEN;
 constexpr size_t StringDictionary::MAX_STRCOUNT;
@@ -122,6 +157,12 @@ StringDictionary::StringDictionary(const std::string& folder,
     offsets_path_ = (storage_path / boost::filesystem::path("DictOffsets")).string();
     const auto payload_path =
         (storage_path / boost::filesystem::path("DictPayload")).string();
+    hash_table_path_ = (storage_path / boost::filesystem::path("DictHashTable")).string();
+    if (!recover) {
+      // the payload is truncated, a hash table left behind would describe other strings
+      boost::system::error_code ec;
+      boost::filesystem::remove(hash_table_path_, ec);
+    }
     payload_fd_ = checked_open(payload_path.c_str(), recover);
     offset_fd_ = checked_open(offsets_path_.c_str(), recover);
     payload_file_size_ = omnisci::file_size(payload_fd_);
@@ -167,6 +208,10 @@ StringDictionary::StringDictionary(const std::string& folder,
 
       unsigned string_id = 0;
       mapd_lock_guard<mapd_shared_mutex> write_lock(rw_mutex_);
+      if (g_enable_stringdict_hash_table_snapshot) {
+        // only the strings past the snapshot need to be hashed below
+        loadHashTableSnapshot(str_count);
+      }
 
       uint32_t thread_inits = 0;
       const auto thread_count = std::thread::hardware_concurrency();
@@ -174,9 +219,10 @@ StringDictionary::StringDictionary(const std::string& folder,
           2000, std::min<uint32_t>(200000, (str_count / thread_count) + 1));
       std::vector<std::future<std::vector<std::pair<string_dict_hash_t, unsigned int>>>>
           dictionary_futures;
-      for (string_id = 0; string_id < str_count; string_id += items_per_thread) {
-        dictionary_futures.emplace_back(std::async(
-            std::launch::async, [string_id, str_count, items_per_thread, this] {
+      for (string_id = str_count_; string_id < str_count;
+           string_id += items_per_thread) {
+        dictionary_futures.emplace_back(
+            threadpool::async([string_id, str_count, items_per_thread, this] {
               std::vector<std::pair<string_dict_hash_t, unsigned int>> hashVec;
               for (uint32_t curr_id = string_id;
                    curr_id < string_id + items_per_thread && curr_id < str_count;
@@ -201,13 +247,136 @@ StringDictionary::StringDictionary(const std::string& folder,
       if (dictionary_futures.size() != 0) {
         processDictionaryFutures(dictionary_futures);
       }
+      // the recovered strings were read from the files
+      checkpoint_str_count_ = str_count_;
+      checkpoint_payload_off_ = payload_file_off_;
       VLOG(1) << "Opened string dictionary " << folder << " # Strings: " << str_count_
               << " Hash table size: " << string_id_string_dict_hash_table_.size()
               << " Fill rate: "
               << static_cast<double>(str_count_) * 100.0 /
                      string_id_string_dict_hash_table_.size()
-              << "% Collisions: " << collisions_;
+              << "% Collisions: " << collisions_
+              << " Strings from hash table snapshot: " << snapshot_str_count_;
+    }
+  }
+}
+
+size_t StringDictionary::loadHashTableSnapshot(const size_t str_count) {
+  CHECK_EQ(str_count_, size_t(0));
+  boost::system::error_code ec;
+  const auto file_size = boost::filesystem::file_size(hash_table_path_, ec);
+  if (ec) {
+    return 0;
+  }
+  std::ifstream snapshot(hash_table_path_, std::ios::binary);
+  HashTableSnapshotHeader header;
+  if (!snapshot.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+      header.magic != kHashTableSnapshotMagic ||
+      header.version != kHashTableSnapshotVersion) {
+    LOG(WARNING) << "Ignoring unreadable string dictionary hash table "
+                 << hash_table_path_;
+    return 0;
+  }
+  const bool has_hashes = header.has_hashes;
+  const auto expected_file_size =
+      sizeof(header) + header.table_size * sizeof(int32_t) +
+      (has_hashes ? header.str_count * sizeof(string_dict_hash_t) : 0);
+  // The table must be large enough for all the strings in storage, otherwise it would
+  // have to be rebuilt anyway.
+  if (header.str_count == 0 || header.str_count > str_count ||
+      header.table_size < string_id_string_dict_hash_table_.size() ||
+      (header.table_size & (header.table_size - 1)) ||
+      (materialize_hashes_ && !has_hashes) || file_size != expected_file_size) {
+    VLOG(1) << "Ignoring stale string dictionary hash table " << hash_table_path_;
+    return 0;
+  }
+  const auto& last_str_meta = offset_map_[header.str_count - 1];
+  if (last_str_meta.off + last_str_meta.size != header.payload_file_off) {
+    VLOG(1) << "Ignoring stale string dictionary hash table " << hash_table_path_;
+    return 0;
+  }
+  std::vector<int32_t> str_ids(header.table_size);
+  snapshot.read(reinterpret_cast<char*>(str_ids.data()),
+                str_ids.size() * sizeof(int32_t));
+  std::vector<string_dict_hash_t> hashes;
+  if (materialize_hashes_) {
+    hashes.resize(header.table_size / 2);
+    snapshot.read(reinterpret_cast<char*>(hashes.data()),
+                  header.str_count * sizeof(string_dict_hash_t));
+  }
+  if (!snapshot) {
+    LOG(WARNING) << "Ignoring unreadable string dictionary hash table "
+                 << hash_table_path_;
+    return 0;
+  }
+  const size_t check_stride =
+      std::max(header.str_count / kHashTableSnapshotChecks, uint64_t(1));
+  for (size_t string_id = 0; string_id < header.str_count; string_id += check_stride) {
+    const auto str = getStringFromStorage(string_id);
+    CHECK(!str.canary);
+    const std::string_view str_view(str.c_str_ptr, str.size);
+    const auto bucket = computeBucket(hash_string(str_view), str_view, str_ids);
+    if (str_ids[bucket] != static_cast<int32_t>(string_id)) {
+      LOG(WARNING) << "Ignoring string dictionary hash table " << hash_table_path_
+                   << " which doesn't match the dictionary payload";
+      return 0;
+    }
+  }
+  string_id_string_dict_hash_table_.swap(str_ids);
+  if (materialize_hashes_) {
+    hash_cache_.swap(hashes);
+  }
+  str_count_ = header.str_count;
+  payload_file_off_ = header.payload_file_off;
+  collisions_ = header.collisions;
+  snapshot_str_count_ = header.str_count;
+  snapshot_table_size_ = header.table_size;
+  return str_count_;
+}
+
+void StringDictionary::writeHashTableSnapshot() noexcept {
+  std::lock_guard<std::mutex> snapshot_lock(snapshot_mutex_);
+  mapd_shared_lock<mapd_shared_mutex> read_lock(rw_mutex_);
+  // Strings added since the last snapshot get hashed when the dictionary is opened, so
+  // the table is only rewritten once the dictionary grew by a tenth or got resized.
+  // Otherwise every checkpoint of a few new strings would write out the whole table.
+  if (str_count_ == 0 ||
+      (snapshot_table_size_ == string_id_string_dict_hash_table_.size() &&
+       str_count_ < snapshot_str_count_ + snapshot_str_count_ / 10)) {
+    return;
+  }
+  const auto tmp_path = hash_table_path_ + ".tmp";
+  try {
+    {
+      std::ofstream snapshot(tmp_path, std::ios::binary | std::ios::trunc);
+      HashTableSnapshotHeader header{kHashTableSnapshotMagic,
+                                     kHashTableSnapshotVersion,
+                                     materialize_hashes_,
+                                     str_count_,
+                                     payload_file_off_,
+                                     string_id_string_dict_hash_table_.size(),
+                                     collisions_};
+      snapshot.write(reinterpret_cast<const char*>(&header), sizeof(header));
+      snapshot.write(
+          reinterpret_cast<const char*>(string_id_string_dict_hash_table_.data()),
+          string_id_string_dict_hash_table_.size() * sizeof(int32_t));
+      if (materialize_hashes_) {
+        snapshot.write(reinterpret_cast<const char*>(hash_cache_.data()),
+                       str_count_ * sizeof(string_dict_hash_t));
+      }
+      if (!snapshot.good()) {
+        throw std::runtime_error("write failed");
+      }
     }
+    boost::filesystem::rename(tmp_path, hash_table_path_);
+    snapshot_str_count_ = str_count_;
+    snapshot_table_size_ = string_id_string_dict_hash_table_.size();
+  } catch (const std::exception& e) {
+    // not fatal, the next start hashes the strings again
+    LOG(WARNING) << "Could not write string dictionary hash table " << hash_table_path_
+                 << ": " << e.what();
+    boost::system::error_code ec;
+    boost::filesystem::remove(tmp_path, ec);
   }
 }
 
@@ -355,18 +524,74 @@ void StringDictionary::hashStrings(const std::vector<String>& string_vec,
                     });
 }
 
+template <class T, class String>
+std::vector<size_t> StringDictionary::getBulkExisting(
+    const std::vector<String>& input_strings,
+    const std::vector<string_dict_hash_t>& input_strings_hashes,
+    T* output_string_ids) const {
+  CHECK_EQ(input_strings.size(), input_strings_hashes.size());
+  std::vector<size_t> missing_string_indices;
+  mapd_shared_lock<mapd_shared_mutex> read_lock(rw_mutex_);
+  for (size_t input_string_idx = 0; input_string_idx < input_strings.size();
+       ++input_string_idx) {
+    const auto& input_string = input_strings[input_string_idx];
+    if (input_string.empty()) {
+      output_string_ids[input_string_idx] = inline_int_null_value<T>();
+      continue;
+    }
+    const auto hash_bucket = computeBucket(input_strings_hashes[input_string_idx],
+                                           input_string,
+                                           string_id_string_dict_hash_table_);
+    const auto string_id = string_id_string_dict_hash_table_[hash_bucket];
+    if (string_id == INVALID_STR_ID) {
+      missing_string_indices.push_back(input_string_idx);
+      continue;
+    }
+    output_string_ids[input_string_idx] = string_id;
+  }
+  return missing_string_indices;
+}
+
 template <class T, class String>
 void StringDictionary::getOrAddBulk(const std::vector<String>& input_strings,
                                     T* output_string_ids) {
-  if (g_enable_stringdict_parallel) {
-    getOrAddBulkParallel(input_strings, output_string_ids);
-    return;
-  }
-  // Single-thread path.
   if (client_no_timeout_) {
     getOrAddBulkRemote(input_strings, output_string_ids);
     return;
   }
+  // Resolve the strings already in the dictionary under the read lock first. Batches
+  // made of known strings, the common case once a load is under way, then never take
+  // the write lock and don't serialize concurrent loads sharing the dictionary.
+  std::vector<string_dict_hash_t> input_strings_hashes(input_strings.size());
+  hashStrings(input_strings, input_strings_hashes);
+  const auto missing_string_indices =
+      getBulkExisting(input_strings, input_strings_hashes, output_string_ids);
+  if (missing_string_indices.empty()) {
+    return;
+  }
+  std::vector<std::string_view> missing_strings;
+  missing_strings.reserve(missing_string_indices.size());
+  for (const auto input_string_idx : missing_string_indices) {
+    missing_strings.emplace_back(input_strings[input_string_idx].data(),
+                                 input_strings[input_string_idx].size());
+  }
+  // Another load may add some of the missing strings before the write lock is taken,
+  // the write paths look every string up again.
+  std::vector<T> missing_string_ids(missing_strings.size());
+  if (g_enable_stringdict_parallel) {
+    getOrAddBulkParallel(missing_strings, missing_string_ids.data());
+  } else {
+    getOrAddBulkSerial(missing_strings, missing_string_ids.data());
+  }
+  for (size_t i = 0; i < missing_string_indices.size(); ++i) {
+    output_string_ids[missing_string_indices[i]] = missing_string_ids[i];
+  }
+}
+
+template <class T, class String>
+void StringDictionary::getOrAddBulkSerial(const std::vector<String>& input_strings,
+                                          T* output_string_ids) {
+  CHECK(!client_no_timeout_);
   mapd_lock_guard<mapd_shared_mutex> write_lock(rw_mutex_);
 
   const size_t initial_str_count = str_count_;
@@ -607,30 +832,106 @@ size_t StringDictionary::storageEntryCount() const {
 
 namespace {
 
-bool is_like(const std::string& str,
+bool is_like(const char* str,
+             const size_t str_len,
              const std::string& pattern,
              const bool icase,
              const bool is_simple,
              const char escape) {
   return icase
              ? (is_simple ? string_ilike_simple(
-                                str.c_str(), str.size(), pattern.c_str(), pattern.size())
-                          : string_ilike(str.c_str(),
-                                         str.size(),
-                                         pattern.c_str(),
-                                         pattern.size(),
-                                         escape))
+                                str, str_len, pattern.c_str(), pattern.size())
+                          : string_ilike(
+                                str, str_len, pattern.c_str(), pattern.size(), escape))
              : (is_simple ? string_like_simple(
-                                str.c_str(), str.size(), pattern.c_str(), pattern.size())
-                          : string_like(str.c_str(),
-                                        str.size(),
-                                        pattern.c_str(),
-                                        pattern.size(),
-                                        escape));
+                                str, str_len, pattern.c_str(), pattern.size())
+                          : string_like(
+                                str, str_len, pattern.c_str(), pattern.size(), escape));
+}
+
+char to_lower_ascii(const char c) {
+  return 'A' <= c && c <= 'Z' ? c - 'A' + 'a' : c;
 }
 
+struct LowerCaseHash {
+  size_t operator()(const char c) const { return std::hash<char>()(to_lower_ascii(c)); }
+};
+
+struct LowerCaseEquals {
+  bool operator()(const char lhs, const char rhs) const {
+    return to_lower_ascii(lhs) == to_lower_ascii(rhs);
+  }
+};
+
+// Substring search of a simple LIKE pattern, i.e. '%pattern%'. The searcher skips over
+// the string using the pattern characters it has seen instead of comparing the pattern
+// at every position, like string_like_simple() does. The pattern of an ILIKE is
+// lowercase already, so comparing both sides lowercased gives the same matches.
+template <class Searcher>
+bool contains(const char* str, const size_t str_len, const Searcher& searcher) {
+  return std::search(str, str + str_len, searcher) != str + str_len;
+}
+
+// Every worker of a pattern match scan gets at least this many strings, so scanning the
+// few strings added since a match was cached doesn't spawn a thread per core.
+constexpr size_t kMinStringsPerMatchWorker{64 * 1024};
+
 }  // namespace
 
+template <class Matcher>
+std::vector<int32_t> StringDictionary::getMatchingIdsUnlocked(
+    PatternMatchCacheEntry& cache_entry,
+    const size_t generation,
+    const Matcher& matcher) const {
+  CHECK_LE(generation, str_count_);
+  auto& string_ids = cache_entry.string_ids;
+  if (cache_entry.generation < generation) {
+    // Only the strings added since the entry was last extended need to be matched.
+    const size_t first_string_id = cache_entry.generation;
+    const size_t str_count = generation - first_string_id;
+    const size_t worker_count =
+        std::min(static_cast<size_t>(cpu_threads()),
+                 (str_count + kMinStringsPerMatchWorker - 1) / kMinStringsPerMatchWorker);
+    CHECK_GT(worker_count, size_t(0));
+    const size_t strings_per_worker = (str_count + worker_count - 1) / worker_count;
+    std::vector<std::vector<int32_t>> worker_results(worker_count);
+    auto match_strings = [&worker_results,
+                          &matcher,
+                          first_string_id,
+                          strings_per_worker,
+                          generation,
+                          this](const size_t worker_idx) {
+      const size_t start = first_string_id + worker_idx * strings_per_worker;
+      const size_t end = std::min(start + strings_per_worker, generation);
+      for (size_t string_id = start; string_id < end; ++string_id) {
+        const auto str = getStringBytesChecked(string_id);
+        if (matcher(str.first, str.second)) {
+          worker_results[worker_idx].push_back(string_id);
+        }
+      }
+    };
+    if (worker_count == 1) {
+      match_strings(0);
+    } else {
+      std::vector<std::thread> workers;
+      for (size_t worker_idx = 0; worker_idx < worker_count; ++worker_idx) {
+        workers.emplace_back(match_strings, worker_idx);
+      }
+      for (auto& worker : workers) {
+        worker.join();
+      }
+    }
+    // Workers cover consecutive ranges, so the concatenation stays sorted.
+    for (const auto& worker_result : worker_results) {
+      string_ids.insert(string_ids.end(), worker_result.begin(), worker_result.end());
+    }
+    cache_entry.generation = generation;
+  }
+  const auto generation_end = std::lower_bound(
+      string_ids.begin(), string_ids.end(), static_cast<int32_t>(generation));
+  return std::vector<int32_t>(string_ids.begin(), generation_end);
+}
+
 std::vector<int32_t> StringDictionary::getLike(const std::string& pattern,
                                                const bool icase,
                                                const bool is_simple,
@@ -641,47 +942,33 @@ std::vector<int32_t> StringDictionary::getLike(const std::string& pattern,
     return client_->get_like(pattern, icase, is_simple, escape, generation);
   }
   const auto cache_key = std::make_tuple(pattern, icase, is_simple, escape);
-  const auto it = like_cache_.find(cache_key);
-  if (it != like_cache_.end()) {
-    return it->second;
-  }
-  std::vector<int32_t> result;
-  std::vector<std::thread> workers;
-  int worker_count = cpu_threads();
-  CHECK_GT(worker_count, 0);
-  std::vector<std::vector<int32_t>> worker_results(worker_count);
-  CHECK_LE(generation, str_count_);
-  for (int worker_idx = 0; worker_idx < worker_count; ++worker_idx) {
-    workers.emplace_back([&worker_results,
-                          &pattern,
-                          generation,
-                          icase,
-                          is_simple,
-                          escape,
-                          worker_idx,
-                          worker_count,
-                          this]() {
-      for (size_t string_id = worker_idx; string_id < generation;
-           string_id += worker_count) {
-        const auto str = getStringUnlocked(string_id);
-        if (is_like(str, pattern, icase, is_simple, escape)) {
-          worker_results[worker_idx].push_back(string_id);
-        }
-      }
-    });
-  }
-  for (auto& worker : workers) {
-    worker.join();
-  }
-  for (const auto& worker_result : worker_results) {
-    result.insert(result.end(), worker_result.begin(), worker_result.end());
-  }
-  // place result into cache for reuse if similar query
-  const auto it_ok = like_cache_.insert(std::make_pair(cache_key, result));
-
-  CHECK(it_ok.second);
-
-  return result;
+  if (is_simple && !pattern.empty()) {
+    if (icase) {
+      const std::boyer_moore_horspool_searcher<std::string::const_iterator,
+                                               LowerCaseHash,
+                                               LowerCaseEquals>
+          searcher(pattern.begin(), pattern.end());
+      return getMatchingIdsUnlocked(
+          like_cache_[cache_key],
+          generation,
+          [&searcher](const char* str, const size_t str_len) {
+            return contains(str, str_len, searcher);
+          });
+    }
+    const std::boyer_moore_horspool_searcher<std::string::const_iterator> searcher(
+        pattern.begin(), pattern.end());
+    return getMatchingIdsUnlocked(like_cache_[cache_key],
+                                  generation,
+                                  [&searcher](const char* str, const size_t str_len) {
+                                    return contains(str, str_len, searcher);
+                                  });
+  }
+  return getMatchingIdsUnlocked(
+      like_cache_[cache_key],
+      generation,
+      [&pattern, icase, is_simple, escape](const char* str, const size_t str_len) {
+        return is_like(str, str_len, pattern, icase, is_simple, escape);
+      });
 }
 
 std::vector<int32_t> StringDictionary::getEquals(std::string pattern,
@@ -895,16 +1182,6 @@ std::vector<int32_t> StringDictionary::getCompare(const std::string& pattern,
   return ret;
 }
 
-namespace {
-
-bool is_regexp_like(const std::string& str,
-                    const std::string& pattern,
-                    const char escape) {
-  return regexp_like(str.c_str(), str.size(), pattern.c_str(), pattern.size(), escape);
-}
-
-}  // namespace
-
 std::vector<int32_t> StringDictionary::getRegexpLike(const std::string& pattern,
                                                      const char escape,
                                                      const size_t generation) const {
@@ -913,43 +1190,49 @@ std::vector<int32_t> StringDictionary::getRegexpLike(const std::string& pattern,
     return client_->get_regexp_like(pattern, escape, generation);
   }
   const auto cache_key = std::make_pair(pattern, escape);
-  const auto it = regex_cache_.find(cache_key);
-  if (it != regex_cache_.end()) {
-    return it->second;
-  }
-  std::vector<int32_t> result;
-  std::vector<std::thread> workers;
-  int worker_count = cpu_threads();
-  CHECK_GT(worker_count, 0);
-  std::vector<std::vector<int32_t>> worker_results(worker_count);
-  CHECK_LE(generation, str_count_);
-  for (int worker_idx = 0; worker_idx < worker_count; ++worker_idx) {
-    workers.emplace_back([&worker_results,
-                          &pattern,
-                          generation,
-                          escape,
-                          worker_idx,
-                          worker_count,
-                          this]() {
-      for (size_t string_id = worker_idx; string_id < generation;
-           string_id += worker_count) {
-        const auto str = getStringUnlocked(string_id);
-        if (is_regexp_like(str, pattern, escape)) {
-          worker_results[worker_idx].push_back(string_id);
-        }
-      }
-    });
-  }
-  for (auto& worker : workers) {
-    worker.join();
-  }
-  for (const auto& worker_result : worker_results) {
-    result.insert(result.end(), worker_result.begin(), worker_result.end());
-  }
-  const auto it_ok = regex_cache_.insert(std::make_pair(cache_key, result));
-  CHECK(it_ok.second);
+  return getMatchingIdsUnlocked(
+      regex_cache_[cache_key],
+      generation,
+      [&pattern, escape](const char* str, const size_t str_len) {
+        return regexp_like(str, str_len, pattern.c_str(), pattern.size(), escape);
+      });
+}
 
-  return result;
+std::vector<int32_t> StringDictionary::buildDictionaryTranslationMap(
+    const StringDictionary* dest_dict,
+    const size_t source_generation,
+    const size_t dest_generation) const {
+  CHECK(dest_dict);
+  std::vector<int32_t> translation_map(source_generation, INVALID_STR_ID);
+  if (client_ || dest_dict->client_) {
+    // remote dictionaries are only accessible one string at a time
+    for (size_t source_id = 0; source_id < source_generation; ++source_id) {
+      translation_map[source_id] = truncate_to_generation(
+          dest_dict->getIdOfString(getString(source_id)), dest_generation);
+    }
+    return translation_map;
+  }
+  mapd_shared_lock<mapd_shared_mutex> source_read_lock(rw_mutex_);
+  CHECK_LE(source_generation, str_count_);
+  std::optional<mapd_shared_lock<mapd_shared_mutex>> dest_read_lock;
+  if (dest_dict != this) {
+    dest_read_lock.emplace(dest_dict->rw_mutex_);
+  }
+  tbb::parallel_for(
+      tbb::blocked_range<size_t>(0, source_generation),
+      [this, dest_dict, dest_generation, &translation_map](
+          const tbb::blocked_range<size_t>& r) {
+        for (size_t source_id = r.begin(); source_id != r.end(); ++source_id) {
+          const auto source_str = getStringBytesChecked(source_id);
+          const std::string_view str(source_str.first, source_str.second);
+          const auto& dest_hash_table = dest_dict->string_id_string_dict_hash_table_;
+          const auto dest_bucket =
+              dest_dict->computeBucket(hash_string(str), str, dest_hash_table);
+          translation_map[source_id] =
+              truncate_to_generation(dest_hash_table[dest_bucket], dest_generation);
+        }
+      });
+  return translation_map;
 }
 
 std::shared_ptr<const std::vector<std::string>> StringDictionary::copyStrings() const {
@@ -986,8 +1269,8 @@ std::shared_ptr<const std::vector<std::string>> StringDictionary::copyStrings()
     for (size_t worker_idx = 0, start = 0, end = std::min(start + stride, str_count_);
          worker_idx < worker_count && start < str_count_;
          ++worker_idx, start += stride, end = std::min(start + stride, str_count_)) {
-      workers.push_back(std::async(
-          std::launch::async, copy, std::ref(worker_results[worker_idx]), start, end));
+      workers.push_back(threadpool::async(
+          copy, std::ref(worker_results[worker_idx]), start, end));
     }
     for (auto& worker : workers) {
       worker.get();
@@ -1371,12 +1654,8 @@ void* StringDictionary::addMemoryCapacity(void* addr,
 }
 
 void StringDictionary::invalidateInvertedIndex() noexcept {
-  if (!like_cache_.empty()) {
-    decltype(like_cache_)().swap(like_cache_);
-  }
-  if (!regex_cache_.empty()) {
-    decltype(regex_cache_)().swap(regex_cache_);
-  }
+  // The LIKE and REGEXP caches stay valid as the dictionary grows, see
+  // getMatchingIdsUnlocked().
   if (!equal_cache_.empty()) {
     decltype(equal_cache_)().swap(equal_cache_);
   }
@@ -1396,16 +1675,68 @@ bool StringDictionary::checkpoint() noexcept {
     }
   }
   CHECK(!isTemp_);
+  std::lock_guard<std::mutex> checkpoint_lock(checkpoint_mutex_);
   bool ret = true;
-  ret = ret &&
-        (omnisci::msync((void*)offset_map_, offset_file_size_, /*async=*/false) == 0);
-  ret = ret &&
-        (omnisci::msync((void*)payload_map_, payload_file_size_, /*async=*/false) == 0);
+  size_t str_count{0};
+  size_t payload_file_off{0};
+  {
+    // Appends remap the files when they grow, the read lock keeps the mappings alive
+    // while the ranges appended since the last checkpoint are synced. Lookups go on.
+    mapd_shared_lock<mapd_shared_mutex> read_lock(rw_mutex_);
+    str_count = str_count_;
+    payload_file_off = payload_file_off_;
+    ret = ret && sync_mapped_range(offset_map_,
+                                   checkpoint_str_count_ * sizeof(StringIdxEntry),
+                                   str_count * sizeof(StringIdxEntry));
+    ret = ret &&
+          sync_mapped_range(payload_map_, checkpoint_payload_off_, payload_file_off);
+  }
+  // The capacity added by appends is written through the file descriptors, syncing
+  // those needs no lock.
   ret = ret && (omnisci::fsync(offset_fd_) == 0);
   ret = ret && (omnisci::fsync(payload_fd_) == 0);
+  if (ret) {
+    checkpoint_str_count_ = str_count;
+    checkpoint_payload_off_ = payload_file_off;
+  }
+  if (ret && g_enable_stringdict_hash_table_snapshot) {
+    writeHashTableSnapshot();
+  }
   return ret;
 }
 
+std::shared_ptr<const std::vector<int32_t>> StringDictionary::getSortedRanks(
+    const size_t generation) {
+  if (client_) {
+    return nullptr;
+  }
+  // Ids are handed out in order, so the ranks of a generation never change.
+  {
+    mapd_shared_lock<mapd_shared_mutex> read_lock(rw_mutex_);
+    if (sorted_ranks_ && sorted_ranks_->size() == std::min(generation, str_count_)) {
+      return sorted_ranks_;
+    }
+  }
+  mapd_lock_guard<mapd_shared_mutex> write_lock(rw_mutex_);
+  const auto str_count = std::min(generation, str_count_);
+  if (sorted_ranks_ && sorted_ranks_->size() == str_count) {
+    return sorted_ranks_;
+  }
+  if (sorted_cache.size() < str_count_) {
+    buildSortedCache();
+  }
+  auto sorted_ranks = std::make_shared<std::vector<int32_t>>(str_count);
+  int32_t rank{0};
+  for (const auto string_id : sorted_cache) {
+    if (static_cast<size_t>(string_id) < str_count) {
+      (*sorted_ranks)[string_id] = rank++;
+    }
+  }
+  CHECK_EQ(static_cast<size_t>(rank), str_count);
+  sorted_ranks_ = sorted_ranks;
+  return sorted_ranks_;
+}
+
 void StringDictionary::buildSortedCache() {
   // This method is not thread-safe.
   const auto cur_cache_size = sorted_cache.size();
@@ -1508,7 +1839,7 @@ void StringDictionary::populate_string_array_ids(
   if (source_array_ids.size() / num_worker_threads > 10) {
     std::vector<std::future<void>> worker_threads;
     for (int i = 0; i < num_worker_threads; ++i) {
-      worker_threads.push_back(std::async(std::launch::async, processor, i));
+      worker_threads.push_back(threadpool::async(processor, i));
     }
 
     for (auto& child : worker_threads) {
@@ -24,11 +24,13 @@
 
 #include <future>
 #include <map>
+#include <mutex>
 #include <string>
 #include <tuple>
 #include <vector>
 
 extern bool g_enable_stringdict_parallel;
+extern bool g_enable_stringdict_hash_table_snapshot;
 
 class StringDictionaryClient;
 
@@ -80,6 +82,27 @@ class StringDictionary {
 
   std::shared_ptr<const std::vector<std::string>> copyStrings() const;
 
+  /**
+   * @brief Ranks of the first \p generation strings in string order, indexed on string
+   * id, so that comparing the ranks of two ids compares their strings
+   *
+   * Built from the sorted cache and kept for the last generation asked for. Returns
+   * nullptr for remote dictionaries.
+   */
+  std::shared_ptr<const std::vector<int32_t>> getSortedRanks(const size_t generation);
+
+  /**
+   * @brief Maps the first \p source_generation ids of this dictionary to the ids of the
+   * same strings in \p dest_dict
+   *
+   * Strings which aren't among the first \p dest_generation strings of the destination
+   * map to INVALID_STR_ID. Both dictionaries are read locked once for the whole build,
+   * which runs in parallel.
+   */
+  std::vector<int32_t> buildDictionaryTranslationMap(const StringDictionary* dest_dict,
+                                                     const size_t source_generation,
+                                                     const size_t dest_generation) const;
+
   bool checkpoint() noexcept;
 
   /**
@@ -137,6 +160,14 @@ class StringDictionary {
     bool canary;
   };
 
+  // Sorted ids of the strings matching a pattern among the first `generation` strings.
+  // Strings are never removed or renumbered, so entries are extended with the strings
+  // added since rather than thrown away when the dictionary grows.
+  struct PatternMatchCacheEntry {
+    std::vector<int32_t> string_ids;
+    size_t generation{0};
+  };
+
   void processDictionaryFutures(
       std::vector<std::future<std::vector<std::pair<string_dict_hash_t, unsigned int>>>>&
           dictionary_futures);
@@ -156,6 +187,15 @@ class StringDictionary {
                    std::vector<string_dict_hash_t>& hashes) const noexcept;
   template <class T, class String>
   void getOrAddBulkRemote(const std::vector<String>& string_vec, T* encoded_vec);
+  template <class T, class String>
+  void getOrAddBulkSerial(const std::vector<String>& string_vec, T* encoded_vec);
+  // Fills in the ids of the strings already in the dictionary and returns the indices
+  // of the ones which aren't.
+  template <class T, class String>
+  std::vector<size_t> getBulkExisting(
+      const std::vector<String>& input_strings,
+      const std::vector<string_dict_hash_t>& input_strings_hashes,
+      T* output_string_ids) const;
   int32_t getUnlocked(const std::string& str) const noexcept;
   std::string getStringUnlocked(int32_t string_id) const noexcept;
   std::string getStringChecked(const int string_id) const noexcept;
@@ -194,6 +234,12 @@ class StringDictionary {
                           size_t& mem_size,
                           const size_t min_capacity_requested = 0) noexcept;
   void invalidateInvertedIndex() noexcept;
+  size_t loadHashTableSnapshot(const size_t str_count);
+  void writeHashTableSnapshot() noexcept;
+  template <class Matcher>
+  std::vector<int32_t> getMatchingIdsUnlocked(PatternMatchCacheEntry& cache_entry,
+                                              const size_t generation,
+                                              const Matcher& matcher) const;
   std::vector<int32_t> getEquals(std::string pattern,
                                  std::string comp_operator,
                                  size_t generation);
@@ -209,9 +255,21 @@ class StringDictionary {
   std::vector<int32_t> string_id_string_dict_hash_table_;
   std::vector<string_dict_hash_t> hash_cache_;
   std::vector<int32_t> sorted_cache;
+  std::shared_ptr<const std::vector<int32_t>> sorted_ranks_;
   bool isTemp_;
   bool materialize_hashes_;
   std::string offsets_path_;
+  // Hash table persisted on checkpoint, so that opening the dictionary only hashes the
+  // strings added since.
+  std::string hash_table_path_;
+  std::mutex snapshot_mutex_;
+  size_t snapshot_str_count_{0};
+  size_t snapshot_table_size_{0};
+  // Storage synced by the last checkpoint. Strings are only appended, so a checkpoint
+  // only syncs the offsets and the payload past these.
+  std::mutex checkpoint_mutex_;
+  size_t checkpoint_str_count_{0};
+  size_t checkpoint_payload_off_{0};
   int payload_fd_;
   int offset_fd_;
   StringIdxEntry* offset_map_;
@@ -220,9 +278,9 @@ class StringDictionary {
   size_t payload_file_size_;
   size_t payload_file_off_;
   mutable mapd_shared_mutex rw_mutex_;
-  mutable std::map<std::tuple<std::string, bool, bool, char>, std::vector<int32_t>>
+  mutable std::map<std::tuple<std::string, bool, bool, char>, PatternMatchCacheEntry>
       like_cache_;
-  mutable std::map<std::pair<std::string, char>, std::vector<int32_t>> regex_cache_;
+  mutable std::map<std::pair<std::string, char>, PatternMatchCacheEntry> regex_cache_;
   mutable std::map<std::string, int32_t> equal_cache_;
   mutable DictionaryCache<std::string, compare_cache_value_t> compare_cache_;
   mutable std::shared_ptr<std::vector<std::string>> strings_cache_;
@@ -16,6 +16,7 @@
 
 #include "StringDictionary/StringDictionaryProxy.h"
 
+#include <algorithm>
 #include <thread>
 
 #include "Logger/Logger.h"
@@ -101,6 +102,82 @@ std::string StringDictionaryProxy::getString(int32_t string_id) const {
 
 namespace {
 
+// A translation map, or the sorted ranks, cost a pass over the source dictionary, which
+// only pays off once the expected lookups are a sizeable fraction of it.
+constexpr size_t kTranslationMapMinLookupRatio{4};
+
+}  // namespace
+
+void StringDictionaryProxy::prepareTranslationMap(const StringDictionaryProxy* dest_proxy,
+                                                  const size_t expected_lookups) const {
+  CHECK(dest_proxy);
+  // Proxies without a generation see every string, translateStringId() then looks the
+  // strings up one at a time.
+  if (dest_proxy == this || !expected_lookups || generation_ < 0 ||
+      dest_proxy->generation_ < 0) {
+    return;
+  }
+  const auto source_generation = std::min(static_cast<size_t>(generation_),
+                                          string_dict_->storageEntryCount());
+  if (expected_lookups * kTranslationMapMinLookupRatio < source_generation) {
+    return;
+  }
+  const auto dest_dict = dest_proxy->string_dict_.get();
+  std::lock_guard<std::mutex> lock(translation_maps_mutex_);
+  for (const auto& translation_map : translation_maps_) {
+    if (translation_map.dest_dict == dest_dict &&
+        translation_map.dest_generation == dest_proxy->generation_ &&
+        translation_map.source_generation == generation_) {
+      last_translation_map_.store(&translation_map);
+      return;
+    }
+  }
+  translation_maps_.push_back(
+      TranslationMap{dest_dict,
+                     dest_proxy->generation_,
+                     generation_,
+                     string_dict_->buildDictionaryTranslationMap(
+                         dest_dict, source_generation, dest_proxy->generation_)});
+  last_translation_map_.store(&translation_maps_.back());
+}
+
+int32_t StringDictionaryProxy::translateStringId(
+    const int32_t source_string_id,
+    const StringDictionaryProxy* dest_proxy) const {
+  CHECK(dest_proxy);
+  const auto translation_map = last_translation_map_.load();
+  if (source_string_id >= 0 && translation_map &&
+      translation_map->dest_dict == dest_proxy->string_dict_.get() &&
+      translation_map->dest_generation == dest_proxy->generation_ &&
+      translation_map->source_generation == generation_ &&
+      static_cast<size_t>(source_string_id) < translation_map->dest_ids.size()) {
+    const auto dest_id = translation_map->dest_ids[source_string_id];
+    // transient strings of the destination aren't part of the map
+    if (dest_id != StringDictionary::INVALID_STR_ID || !dest_proxy->hasTransients()) {
+      return dest_id;
+    }
+  }
+  return dest_proxy->getIdOfString(getString(source_string_id));
+}
+
+std::shared_ptr<const std::vector<int32_t>> StringDictionaryProxy::getSortedRanks(
+    const size_t expected_lookups) const {
+  CHECK_GE(generation_, 0);
+  const auto generation = std::min(static_cast<size_t>(generation_),
+                                   string_dict_->storageEntryCount());
+  if (expected_lookups * kTranslationMapMinLookupRatio < generation) {
+    return nullptr;
+  }
+  return string_dict_->getSortedRanks(generation);
+}
+
+bool StringDictionaryProxy::hasTransients() const {
+  mapd_shared_lock<mapd_shared_mutex> read_lock(rw_mutex_);
+  return !transient_str_to_int_.empty();
+}
+
+namespace {
+
 bool is_like(const std::string& str,
              const std::string& pattern,
              const bool icase,
@@ -20,7 +20,10 @@
 #include "../Shared/mapd_shared_mutex.h"
 #include "StringDictionary.h"
 
+#include <atomic>
+#include <list>
 #include <map>
+#include <mutex>
 #include <string>
 #include <tuple>
 #include <vector>
@@ -56,11 +59,45 @@ class StringDictionaryProxy {
     return transient_int_to_str_;
   }
 
+  /**
+   * Builds a map from every id of this proxy's dictionary to the ids of the same strings
+   * in `dest_proxy`, which translateStringId() then uses instead of per string lookups.
+   * Skipped when `expected_lookups` are too few to amortize a pass over the dictionary.
+   */
+  void prepareTranslationMap(const StringDictionaryProxy* dest_proxy,
+                             const size_t expected_lookups) const;
+
+  // Returns the id of the string `source_string_id` in `dest_proxy`, or INVALID_STR_ID.
+  int32_t translateStringId(const int32_t source_string_id,
+                            const StringDictionaryProxy* dest_proxy) const;
+
+  /**
+   * Ranks of the dictionary strings of this proxy's generation in string order, indexed
+   * on string id, for sorts to compare ranks rather than strings. Transient ids aren't
+   * ranked. Returns nullptr when `expected_lookups` are too few to amortize a pass over
+   * the dictionary.
+   */
+  std::shared_ptr<const std::vector<int32_t>> getSortedRanks(
+      const size_t expected_lookups) const;
+
  private:
+  struct TranslationMap {
+    const StringDictionary* dest_dict;
+    int64_t dest_generation;
+    int64_t source_generation;
+    std::vector<int32_t> dest_ids;
+  };
+
+  bool hasTransients() const;
+
   std::shared_ptr<StringDictionary> string_dict_;
   std::map<int32_t, std::string> transient_int_to_str_;
   std::map<std::string, int32_t> transient_str_to_int_;
   int64_t generation_;
   mutable mapd_shared_mutex rw_mutex_;
+  // entries are never removed, so readers can hold on to them without the mutex
+  mutable std::list<TranslationMap> translation_maps_;
+  mutable std::atomic<const TranslationMap*> last_translation_map_{nullptr};
+  mutable std::mutex translation_maps_mutex_;
 };
 #endif  // STRINGDICTIONARY_STRINGDICTIONARYPROXY_H
@@ -48,6 +48,7 @@ bool g_test_rollback_dump_restore{false};
 constexpr static char const* table_schema_filename = "_table.sql";
 constexpr static char const* table_oldinfo_filename = "_table.oldinfo";
 constexpr static char const* table_epoch_filename = "_table.epoch";
+constexpr static char const* table_base_epoch_filename = "_table.base_epoch";
 
 #if BOOST_VERSION < 107300
 namespace std {
@@ -216,6 +217,67 @@ void adjust_altered_table_files(const std::string& temp_data_dir,
   thread_controller.finish();
 }
 
+// Whether a data file has a page written after `base_epoch`, i.e. a page an incremental
+// dump from `base_epoch` has to archive.
+bool has_page_after_epoch(const std::string& file_path,
+                          const int64_t page_size,
+                          const int32_t base_epoch) {
+  const auto file_size = boost::filesystem::file_size(file_path);
+  std::unique_ptr<FILE, decltype(simple_file_closer)> fp(
+      std::fopen(file_path.c_str(), "r"), simple_file_closer);
+  if (!fp) {
+    throw std::runtime_error("Failed to open " + file_path +
+                             " for read: " + std::strerror(errno));
+  }
+  // ref. FileInfo::openExistingFile for hint of chunk header layout
+  for (size_t page = 0; page < file_size / page_size; ++page) {
+    int ints[8];
+    if (0 != std::fseek(fp.get(), page * page_size, SEEK_SET)) {
+      throw std::runtime_error("Failed to seek to page# " + std::to_string(page) +
+                               file_path + " for read: " + std::strerror(errno));
+    }
+    if (1 != fread(ints, sizeof ints, 1, fp.get())) {
+      throw std::runtime_error("Failed to read " + file_path + ": " +
+                               std::strerror(errno));
+    }
+    const auto num_header_elems = ints[0] / sizeof(int32_t);
+    if (num_header_elems >= 2 && num_header_elems < 8) {
+      // the version epoch is the last element of the header
+      if (ints[num_header_elems] > base_epoch) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+// Paths, relative to the base path of the global file mgr, of the files of a table data
+// directory archived by an incremental dump from `base_epoch`. Data files without a page
+// written since are left out, the small metadata files of the FileMgr are always kept.
+std::vector<std::string> get_incremental_data_files(
+    const File_Namespace::GlobalFileMgr* global_file_mgr,
+    const std::string& data_file_dir,
+    const int32_t base_epoch) {
+  std::vector<std::string> file_paths;
+  boost::filesystem::path dir_path(abs_path(global_file_mgr) + "/" + data_file_dir);
+  boost::filesystem::directory_iterator end_it;
+  for (boost::filesystem::directory_iterator fit(dir_path); fit != end_it; ++fit) {
+    const std::string file_name = fit->path().filename().string();
+    std::vector<std::string> tokens;
+    boost::split(tokens, file_name, boost::is_any_of("."));
+    // ref. FileMgr::init for hint of data file name layout
+    if (boost::filesystem::is_regular_file(fit->status()) && tokens.size() > 2 &&
+        MAPD_FILE_EXT == "." + tokens[2] &&
+        !has_page_after_epoch(fit->path().string(),
+                              boost::lexical_cast<int64_t>(tokens[1]),
+                              base_epoch)) {
+      continue;
+    }
+    file_paths.push_back(data_file_dir + "/" + file_name);
+  }
+  return file_paths;
+}
+
 void rename_table_directories(const File_Namespace::GlobalFileMgr* global_file_mgr,
                               const std::string& temp_data_dir,
                               const std::vector<std::string>& target_paths,
@@ -243,7 +305,8 @@ void rename_table_directories(const File_Namespace::GlobalFileMgr* global_file_m
 
 void TableArchiver::dumpTable(const TableDescriptor* td,
                               const std::string& archive_path,
-                              const std::string& compression) {
+                              const std::string& compression,
+                              const int32_t base_epoch) {
   ddl_utils::validate_allowed_file_path(archive_path,
                                         ddl_utils::DataTransferType::EXPORT);
   if (g_cluster) {
@@ -300,7 +363,24 @@ void TableArchiver::dumpTable(const TableDescriptor* td,
     file_writer(table_epoch_filename, "table epoch", std::to_string(epoch));
     // - collect table data file paths ...
     const auto data_file_dirs = cat_->getTableDataDirectories(td);
-    file_paths.insert(file_paths.end(), data_file_dirs.begin(), data_file_dirs.end());
+    if (base_epoch < 0) {
+      file_paths.insert(file_paths.end(), data_file_dirs.begin(), data_file_dirs.end());
+    } else {
+      if (base_epoch > epoch) {
+        throw std::runtime_error("Base epoch " + std::to_string(base_epoch) +
+                                 " is newer than the epoch " + std::to_string(epoch) +
+                                 " of table " + table_name + ".");
+      }
+      // - gen table base epoch, restore checks it against the epoch of the base archive
+      file_writer(
+          table_base_epoch_filename, "table base epoch", std::to_string(base_epoch));
+      for (const auto& data_file_dir : data_file_dirs) {
+        const auto data_file_paths =
+            get_incremental_data_files(global_file_mgr, data_file_dir, base_epoch);
+        file_paths.insert(
+            file_paths.end(), data_file_paths.begin(), data_file_paths.end());
+      }
+    }
     // - collect table dict file paths ...
     const auto dict_file_dirs = cat_->getTableDictDirectories(td);
     file_paths.insert(file_paths.end(), dict_file_dirs.begin(), dict_file_dirs.end());
@@ -316,15 +396,25 @@ void TableArchiver::dumpTable(const TableDescriptor* td,
 void TableArchiver::restoreTable(const Catalog_Namespace::SessionInfo& session,
                                  const TableDescriptor* td,
                                  const std::string& archive_path,
-                                 const std::string& compression) {
+                                 const std::string& compression,
+                                 const std::vector<std::string>& incremental_paths) {
   ddl_utils::validate_allowed_file_path(archive_path,
                                         ddl_utils::DataTransferType::IMPORT);
+  for (const auto& incremental_path : incremental_paths) {
+    ddl_utils::validate_allowed_file_path(incremental_path,
+                                          ddl_utils::DataTransferType::IMPORT);
+  }
   if (g_cluster) {
     throw std::runtime_error("DUMP/RESTORE is not supported yet on distributed setup.");
   }
   if (!boost::filesystem::exists(archive_path)) {
     throw std::runtime_error("Archive " + archive_path + " does not exist.");
   }
+  for (const auto& incremental_path : incremental_paths) {
+    if (!boost::filesystem::exists(incremental_path)) {
+      throw std::runtime_error("Archive " + incremental_path + " does not exist.");
+    }
+  }
   if (td->isView || td->persistenceLevel != Data_Namespace::MemoryLevel::DISK_LEVEL) {
     throw std::runtime_error("Restoring view or temporary table is not supported.");
   }
@@ -349,11 +439,30 @@ void TableArchiver::restoreTable(const Catalog_Namespace::SessionInfo& session,
     run("rm -f " + abs_path(global_file_mgr) + "/" + table_schema_filename);
     run("rm -f " + abs_path(global_file_mgr) + "/" + table_oldinfo_filename);
     run("rm -f " + abs_path(global_file_mgr) + "/" + table_epoch_filename);
+    run("rm -f " + abs_path(global_file_mgr) + "/" + table_base_epoch_filename);
   };
   std::unique_ptr<decltype(tmp_files_cleaner), decltype(tmp_files_cleaner)> tfc(
       &tmp_files_cleaner, tmp_files_cleaner);
+  // each incremental archive has to cover all the pages written after the previous one
+  auto prev_archive_path = archive_path;
+  for (const auto& incremental_path : incremental_paths) {
+    const auto prev_epoch = boost::lexical_cast<int32_t>(
+        simple_file_cat(prev_archive_path, table_epoch_filename, compression));
+    const auto base_epoch = boost::lexical_cast<int32_t>(
+        simple_file_cat(incremental_path, table_base_epoch_filename, compression));
+    if (base_epoch > prev_epoch) {
+      throw std::runtime_error("Archive " + incremental_path + " starts at epoch " +
+                               std::to_string(base_epoch) + " but archive " +
+                               prev_archive_path + " ends at epoch " +
+                               std::to_string(prev_epoch) + ".");
+    }
+    prev_archive_path = incremental_path;
+  }
+  // schema, column info and epoch of the table are those of the latest archive
+  const auto& latest_archive_path = prev_archive_path;
   // extract & parse schema
-  const auto schema_str = get_table_schema(archive_path, td->tableName, compression);
+  const auto schema_str =
+      get_table_schema(latest_archive_path, td->tableName, compression);
   const auto create_table_stmt =
       Parser::parseDDL<Parser::CreateTableStmt>("table schema", schema_str);
   // verify compatibility between source and destination schemas
@@ -387,7 +496,7 @@ void TableArchiver::restoreTable(const Catalog_Namespace::SessionInfo& session,
   }
   // extract src table column ids (ALL columns incl. system/virtual/phy geo cols)
   const auto all_src_oldinfo_str =
-      simple_file_cat(archive_path, table_oldinfo_filename, compression);
+      simple_file_cat(latest_archive_path, table_oldinfo_filename, compression);
   std::vector<std::string> src_oldinfo_strs;
   boost::algorithm::split(src_oldinfo_strs,
                           all_src_oldinfo_str,
@@ -445,6 +554,11 @@ void TableArchiver::restoreTable(const Catalog_Namespace::SessionInfo& session,
   run("rm -rf " + temp_data_dir);
   run("mkdir -p " + temp_data_dir);
   run("tar " + compression + " -xvf " + get_quoted_string(archive_path), temp_data_dir);
+  // files of the incremental archives replace the older versions of the files
+  for (const auto& incremental_path : incremental_paths) {
+    run("tar " + compression + " -xvf " + get_quoted_string(incremental_path),
+        temp_data_dir);
+  }
   // if table was ever altered after it was created, update column ids in chunk headers.
   if (was_table_altered) {
     const auto time_ms = measure<>::execution(
@@ -503,7 +617,8 @@ void TableArchiver::restoreTable(const Catalog_Namespace::SessionInfo& session,
     throw;
   }
   // set for reloading table from the restored/migrated files
-  const auto epoch = simple_file_cat(archive_path, table_epoch_filename, compression);
+  const auto epoch =
+      simple_file_cat(latest_archive_path, table_epoch_filename, compression);
   cat_->setTableEpoch(
       cat_->getCurrentDB().dbId, td->tableId, boost::lexical_cast<int>(epoch));
 }
@@ -513,13 +628,20 @@ void TableArchiver::restoreTable(const Catalog_Namespace::SessionInfo& session,
 void TableArchiver::restoreTable(const Catalog_Namespace::SessionInfo& session,
                                  const std::string& table_name,
                                  const std::string& archive_path,
-                                 const std::string& compression) {
+                                 const std::string& compression,
+                                 const std::vector<std::string>& incremental_paths) {
   // replace table name and drop foreign dict references
-  const auto schema_str = get_table_schema(archive_path, table_name, compression);
+  const auto schema_str = get_table_schema(
+      incremental_paths.empty() ? archive_path : incremental_paths.back(),
+      table_name,
+      compression);
   Parser::parseDDL<Parser::CreateTableStmt>("table schema", schema_str)->execute(session);
   try {
-    restoreTable(
-        session, cat_->getMetadataForTable(table_name), archive_path, compression);
+    restoreTable(session,
+                 cat_->getMetadataForTable(table_name),
+                 archive_path,
+                 compression,
+                 incremental_paths);
   } catch (...) {
     Parser::parseDDL<Parser::DropTableStmt>("statement",
                                             "DROP TABLE IF EXISTS " + table_name + ";")
@@ -17,6 +17,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 #include "Catalog/Catalog.h"
 #include "Catalog/SessionInfo.h"
@@ -25,19 +26,26 @@ class TableArchiver {
  public:
   TableArchiver(Catalog_Namespace::Catalog* cat) : cat_(cat){};
 
+  // Archives the files of the table. With a `base_epoch`, only the data files with pages
+  // written after that epoch, the one of an earlier dump of the table, are archived.
   void dumpTable(const TableDescriptor* td,
                  const std::string& archive_path,
-                 const std::string& compression);
+                 const std::string& compression,
+                 const int32_t base_epoch = -1);
 
+  // Restores the table from a full archive and the chain of incremental archives dumped
+  // after it, oldest first.
   void restoreTable(const Catalog_Namespace::SessionInfo& session,
                     const TableDescriptor* td,
                     const std::string& archive_path,
-                    const std::string& compression);
+                    const std::string& compression,
+                    const std::vector<std::string>& incremental_paths = {});
 
   void restoreTable(const Catalog_Namespace::SessionInfo& session,
                     const std::string& table_name,
                     const std::string& archive_path,
-                    const std::string& compression);
+                    const std::string& compression,
+                    const std::vector<std::string>& incremental_paths = {});
 
  private:
   Catalog_Namespace::Catalog* cat_;
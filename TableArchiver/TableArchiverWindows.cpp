@@ -18,20 +18,23 @@
 
 void TableArchiver::dumpTable(const TableDescriptor* td,
                               const std::string& archive_path,
-                              const std::string& compression) {
+                              const std::string& compression,
+                              const int32_t base_epoch) {
   throw std::runtime_error("Dump/restore table not yet supported on Windows.");
 }
 
 void TableArchiver::restoreTable(const Catalog_Namespace::SessionInfo& session,
                                  const TableDescriptor* td,
                                  const std::string& archive_path,
-                                 const std::string& compression) {
+                                 const std::string& compression,
+                                 const std::vector<std::string>& incremental_paths) {
   throw std::runtime_error("Dump/restore table not yet supported on Windows.");
 }
 
 void TableArchiver::restoreTable(const Catalog_Namespace::SessionInfo& session,
                                  const std::string& table_name,
                                  const std::string& archive_path,
-                                 const std::string& compression) {
+                                 const std::string& compression,
+                                 const std::vector<std::string>& incremental_paths) {
   throw std::runtime_error("Dump/restore table not yet supported on Windows.");
 }
\ No newline at end of file
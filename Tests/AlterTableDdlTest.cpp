@@ -265,6 +265,38 @@ TEST_F(AlterColumnTest, Add_column_with_null) {
   }
 }
 
+TEST_F(AlterColumnTest, Add_column_with_replicated_default) {
+  ScopeGuard reset_flag = [orig = g_enable_replicated_add_column_defaults] {
+    g_enable_replicated_add_column_defaults = orig;
+  };
+  g_enable_replicated_add_column_defaults = true;
+  int cid = 0;
+  for (const auto& tv : type_vals) {
+    if (std::get<3>(tv) != "") {
+      continue;  // geometry columns are always stored in full
+    }
+    const auto column = "x" + std::to_string(++cid);
+    EXPECT_TRUE(alter_common("trips",
+                             column,
+                             std::get<0>(tv),
+                             std::get<1>(tv),
+                             std::get<2>(tv),
+                             std::get<3>(tv),
+                             false));
+  }
+  // The first fragment stores the defaults once, its rows still read back after some of
+  // them are updated.
+  EXPECT_NO_THROW(run_query("UPDATE trips SET x6 = 7 WHERE rate_code_id = 1;"));
+  auto rows = run_query("SELECT COUNT(*) FROM trips WHERE x6 = 123 OR x6 = 7;");
+  auto crt_row = rows->getNextRow(true, true);
+  ASSERT_EQ(size_t(1), crt_row.size());
+  EXPECT_EQ(int64_t(100), v<int64_t>(crt_row[0]));
+  rows = run_query("SELECT COUNT(*) FROM trips WHERE x7 = 123;");
+  crt_row = rows->getNextRow(true, true);
+  ASSERT_EQ(size_t(1), crt_row.size());
+  EXPECT_EQ(int64_t(100), v<int64_t>(crt_row[0]));
+}
+
 TEST(AlterColumnTest2, Drop_after_fail_to_add) {
   EXPECT_NO_THROW(run_ddl_statement("drop table if exists t;"););
   EXPECT_NO_THROW(run_ddl_statement("create table t(c1 int);"););
@@ -479,6 +479,21 @@ TEST(NullValuesTest, NullDifferentTypes) {
       76.2, v<double>(run_simple_agg("SELECT fp8 FROM fsi_nulls WHERE fp4 IS NULL;")));
 }
 
+TEST(NullValuesTest, NullCounts) {
+  run_ddl_statement(
+      "CREATE DATAFRAME fsi_null_counts (int4 INTEGER, int8 BIGINT, fp4 FLOAT, fp8 "
+      "DOUBLE) from 'CSV:../../Tests/Import/datafiles/null_values_numeric.csv';");
+  ASSERT_EQ(2, v<int64_t>(run_simple_agg("SELECT COUNT(*) FROM fsi_null_counts;")));
+  for (const auto& column : {"int4", "int8", "fp4", "fp8"}) {
+    ASSERT_EQ(1,
+              v<int64_t>(run_simple_agg("SELECT COUNT(" + std::string(column) +
+                                        ") FROM fsi_null_counts;")));
+  }
+  ASSERT_EQ(77,
+            v<int64_t>(run_simple_agg("SELECT SUM(int4) + SUM(int8) FROM "
+                                      "fsi_null_counts;")));
+}
+
 TEST(NullValuesTest, NullFullColumn) {
   run_ddl_statement(
       "CREATE DATAFRAME fsi_nulls_full (int4 INTEGER, int8 BIGINT, fp4 FLOAT, fp8 "
@@ -210,7 +210,8 @@ TDataFrame execute_arrow_ipc(
     const ExecutorDeviceType device_type,
     const size_t device_id = 0,
     const int32_t first_n = -1,
-    const TArrowTransport::type transport_method = TArrowTransport::type::SHARED_MEMORY) {
+    const TArrowTransport::type transport_method = TArrowTransport::type::SHARED_MEMORY,
+    const int64_t batch_rows = 0) {
   TDataFrame result;
   g_client->sql_execute_df(
       result,
@@ -219,7 +220,8 @@ TDataFrame execute_arrow_ipc(
       device_type == ExecutorDeviceType::GPU ? TDeviceType::GPU : TDeviceType::CPU,
       0,
       first_n,
-      transport_method);
+      transport_method,
+      batch_rows);
   return result;
 }
 
@@ -363,6 +365,46 @@ TEST_F(ArrowIpcBasic, IpcWire) {
   }
 }
 
+TEST_F(ArrowIpcBasic, IpcWireBatched) {
+  auto data_frame = execute_arrow_ipc("SELECT x, t FROM arrow_ipc_test;",
+                                      ExecutorDeviceType::CPU,
+                                      0,
+                                      -1,
+                                      TArrowTransport::type::WIRE,
+                                      2);
+  const auto stream_id = data_frame.stream_id;
+  std::vector<int64_t> batch_row_counts;
+  while (true) {
+    auto df =
+        ArrowOutput(data_frame, ExecutorDeviceType::CPU, TArrowTransport::type::WIRE);
+    ASSERT_EQ(df.schema->num_fields(), 2);
+    ASSERT_EQ(df.record_batch->column(1)->type()->id(), arrow::Type::type::DICTIONARY);
+    batch_row_counts.push_back(df.record_batch->num_rows());
+    if (!data_frame.has_more_batches) {
+      break;
+    }
+    ASSERT_EQ(data_frame.stream_id, stream_id);
+    g_client->get_next_df_batch(data_frame, g_session_id, stream_id);
+  }
+  ASSERT_EQ(batch_row_counts, (std::vector<int64_t>{2, 2, 1}));
+  // The stream is gone once its last batch has been returned.
+  EXPECT_ANY_THROW(g_client->get_next_df_batch(data_frame, g_session_id, stream_id));
+  g_client->close_df_stream(g_session_id, stream_id);
+}
+
+TEST_F(ArrowIpcBasic, IpcWireBatchedClose) {
+  auto data_frame = execute_arrow_ipc("SELECT x FROM arrow_ipc_test;",
+                                      ExecutorDeviceType::CPU,
+                                      0,
+                                      -1,
+                                      TArrowTransport::type::WIRE,
+                                      2);
+  ASSERT_TRUE(data_frame.has_more_batches);
+  g_client->close_df_stream(g_session_id, data_frame.stream_id);
+  EXPECT_ANY_THROW(
+      g_client->get_next_df_batch(data_frame, g_session_id, data_frame.stream_id));
+}
+
 TEST_F(ArrowIpcBasic, IpcCpu) {
   auto data_frame =
       execute_arrow_ipc("SELECT * FROM arrow_ipc_test;", ExecutorDeviceType::CPU);
@@ -29,10 +29,12 @@
 #include "DataMgr/DataMgr.h"
 #include "Logger/Logger.h"
 #include "QueryEngine/Execute.h"
+#include "QueryEngine/JoinHashTable/HashJoin.h"
 #include "QueryEngine/MurmurHash1Inl.h"
 #include "QueryEngine/ResultSet.h"
 #include "QueryRunner/QueryRunner.h"
 #include "Shared/SystemParameters.h"
+#include "Shared/scope.h"
 #include "TestHelpers.h"
 
 namespace po = boost::program_options;
@@ -823,6 +825,44 @@ TEST(Delete, JoinCacheInvalidationTest_DropTable) {
   }
 }
 
+TEST(Eviction, LeastRecentlyUsedJoinHashTable) {
+  import_tables_cache_invalidation_for_CPU_one_to_one_join(false);
+  ScopeGuard reset_cache_budget = [orig = g_hash_table_cache_max_bytes] {
+    g_hash_table_cache_max_bytes = orig;
+  };
+
+  run_query(
+      "SELECT t1.id1, t2.id1 FROM cache_invalid_t1 t1 join cache_invalid_t2 t2 on "
+      "t1.id1 = t2.id1;",
+      ExecutorDeviceType::CPU);
+  CHECK_EQ(QR::get()->getNumberOfCachedJoinHashTables(), (unsigned long)1);
+  const auto first_run_stats = HashJoin::getHashTableCacheStats();
+  ASSERT_GT(first_run_stats.size_bytes, size_t(0));
+
+  // both join columns span the same range, so only one of the two tables fits
+  g_hash_table_cache_max_bytes = first_run_stats.size_bytes;
+  run_query(
+      "SELECT t1.id2, t2.id2 FROM cache_invalid_t1 t1 join cache_invalid_t2 t2 on "
+      "t1.id2 = t2.id2;",
+      ExecutorDeviceType::CPU);
+  CHECK_EQ(QR::get()->getNumberOfCachedJoinHashTables(), (unsigned long)1);
+  const auto second_run_stats = HashJoin::getHashTableCacheStats();
+  EXPECT_EQ(second_run_stats.evictions, first_run_stats.evictions + 1);
+  EXPECT_LE(second_run_stats.size_bytes, g_hash_table_cache_max_bytes);
+
+  // the most recently built table survived the eviction
+  run_query(
+      "SELECT t1.id2, t2.id2 FROM cache_invalid_t1 t1 join cache_invalid_t2 t2 on "
+      "t1.id2 = t2.id2;",
+      ExecutorDeviceType::CPU);
+  const auto third_run_stats = HashJoin::getHashTableCacheStats();
+  EXPECT_GT(third_run_stats.hits, second_run_stats.hits);
+  EXPECT_EQ(third_run_stats.evictions, second_run_stats.evictions);
+
+  run_ddl_statement("DROP TABLE cache_invalid_t1;");
+  run_ddl_statement("DROP TABLE cache_invalid_t2;");
+}
+
 int main(int argc, char** argv) {
   TestHelpers::init_logger_stderr_only(argc, argv);
   testing::InitGoogleTest(&argc, argv);
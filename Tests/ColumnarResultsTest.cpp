@@ -651,6 +651,23 @@ TEST(BaselineHashRowWise, TwoCol_64_64_MixedAggs_wo_avg) {
   }
 }
 
+TEST(BaselineHashRowWise, TwoCol_64_64_MixedAggs_ManyEntries) {
+  // Enough entries for the parallel conversion to split them over several threads.
+  std::vector<int8_t> key_column_widths{8, 8};
+  const int8_t suggested_agg_width = 8;
+  std::vector<TargetInfo> target_infos = generate_custom_agg_target_infos(
+      key_column_widths,
+      {kMAX, kMAX, kMAX, kMAX, kMAX, kMAX},
+      {kFLOAT, kBIGINT, kTINYINT, kINT, kSMALLINT, kDOUBLE},
+      {kFLOAT, kBIGINT, kTINYINT, kINT, kSMALLINT, kDOUBLE});
+  auto query_mem_desc = baseline_hash_two_col_desc(target_infos, suggested_agg_width);
+  query_mem_desc.setAllTargetGroupbyIndices({0, 1, -1, -1, -1, -1, -1, -1});
+  query_mem_desc.setEntryCount(100000);
+  for (auto step_size : {1, 3, 1001}) {
+    test_columnar_conversion(target_infos, query_mem_desc, step_size, true);
+  }
+}
+
 TEST(BaselineHashRowWise, TwoCol_64_64_MixedAggs_w_avg) {
   std::vector<int8_t> key_column_widths{8, 8};
   const int8_t suggested_agg_width = 8;
@@ -19,6 +19,7 @@
 #include "Catalog/Catalog.h"
 #include "DBHandlerTestHelpers.h"
 #include "QueryEngine/TableOptimizer.h"
+#include "ThriftHandler/AutoVacuumScheduler.h"
 
 #include <gtest/gtest.h>
 #include <string>
@@ -1834,6 +1835,214 @@ TEST_F(OpportunisticVacuumingTest, VarLenColumnUpdateOfConsecutiveInnerFragments
   // clang-format on
 }
 
+class AutoVacuumTest : public OpportunisticVacuumingTest {
+ protected:
+  void SetUp() override {
+    OpportunisticVacuumingTest::SetUp();
+    // only vacuum in the background
+    g_vacuum_min_selectivity = 1.1;
+    g_auto_vacuum_min_deleted_fraction = 0.5;
+    g_auto_vacuum_max_bytes_per_pass = 0;
+  }
+
+  void TearDown() override {
+    g_auto_vacuum_min_deleted_fraction = min_deleted_fraction_;
+    g_auto_vacuum_max_bytes_per_pass = max_bytes_per_pass_;
+    OpportunisticVacuumingTest::TearDown();
+  }
+
+ private:
+  const float min_deleted_fraction_{g_auto_vacuum_min_deleted_fraction};
+  const size_t max_bytes_per_pass_{g_auto_vacuum_max_bytes_per_pass};
+};
+
+TEST_F(AutoVacuumTest, FragmentsAboveDeletedFraction) {
+  sql("create table test_table (i int) with (fragment_size = 5, "
+      "max_rollback_epochs = 25);");
+  OptimizeTableVacuumTest::insertRange(1, 10);
+  sql("delete from test_table where i <= 3 or i >= 10;");
+
+  assertChunkContentAndMetadata(0, {1, 2, 3, 4, 5});
+  assertChunkContentAndMetadata(1, {6, 7, 8, 9, 10});
+
+  EXPECT_GT(AutoVacuumScheduler::vacuumTables(), size_t(0));
+  assertChunkContentAndMetadata(0, {4, 5});
+  assertChunkContentAndMetadata(1, {6, 7, 8, 9, 10});
+  assertFragmentRowCount(7);
+  sqlAndCompareResult("select * from test_table;",
+                      {{i(4)}, {i(5)}, {i(6)}, {i(7)}, {i(8)}, {i(9)}});
+}
+
+TEST_F(AutoVacuumTest, MaxBytesPerPass) {
+  sql("create table test_table (i int) with (fragment_size = 5, "
+      "max_rollback_epochs = 25);");
+  OptimizeTableVacuumTest::insertRange(1, 10);
+  sql("delete from test_table where i <= 3 or i >= 8;");
+
+  // a pass goes over its budget by at most one fragment
+  g_auto_vacuum_max_bytes_per_pass = 1;
+  EXPECT_GT(AutoVacuumScheduler::vacuumTables(), size_t(0));
+  assertChunkContentAndMetadata(0, {4, 5});
+  assertChunkContentAndMetadata(1, {6, 7, 8, 9, 10});
+
+  EXPECT_GT(AutoVacuumScheduler::vacuumTables(), size_t(0));
+  assertChunkContentAndMetadata(0, {4, 5});
+  assertChunkContentAndMetadata(1, {6, 7});
+  assertFragmentRowCount(4);
+  sqlAndCompareResult("select * from test_table;", {{i(4)}, {i(5)}, {i(6)}, {i(7)}});
+}
+
+TEST_F(AutoVacuumTest, UncappedEpoch) {
+  sql("create table test_table (i int) with (fragment_size = 5);");
+  getCatalog().setUncappedTableEpoch("test_table");
+  OptimizeTableVacuumTest::insertRange(1, 10);
+  sql("delete from test_table where i <= 3;");
+
+  AutoVacuumScheduler::vacuumTables();
+  assertChunkContentAndMetadata(0, {1, 2, 3, 4, 5});
+  assertFragmentRowCount(10);
+}
+
+class ClusteringTest : public OpportunisticVacuumingTest {
+ protected:
+  void insertValues(const std::vector<int32_t>& values) {
+    for (const auto value : values) {
+      auto number_str = std::to_string(value);
+      sql("insert into test_table values (" + number_str + ", 'str" + number_str +
+          "');");
+    }
+  }
+};
+
+TEST_F(ClusteringTest, OverlappingFragments) {
+  sql("create table test_table (i int, t text encoding none) with (fragment_size = 4, "
+      "sort_column = 'i', max_rollback_epochs = 25);");
+  insertValues({8, 1, 5, 2, 7, 3, 6, 4, 9, 10});
+
+  assertChunkContentAndMetadata(0, {8, 1, 5, 2});
+  assertChunkContentAndMetadata(1, {7, 3, 6, 4});
+
+  EXPECT_GT(AutoVacuumScheduler::clusterTables(), size_t(0));
+  assertChunkContentAndMetadata(0, {1, 2, 3, 4});
+  assertChunkContentAndMetadata(1, {5, 6, 7, 8});
+  assertChunkContentAndMetadata(2, {9, 10});
+  assertTextChunkContentAndMetadata(0, {"str1", "str2", "str3", "str4"});
+  assertTextChunkContentAndMetadata(1, {"str5", "str6", "str7", "str8"});
+  assertFragmentRowCount(10);
+  sqlAndCompareResult("select count(*) from test_table where i <= 4 and t like 'str%';",
+                      {{i(4)}});
+
+  // disjoint fragments are left alone
+  EXPECT_EQ(AutoVacuumScheduler::clusterTables(), size_t(0));
+}
+
+TEST_F(ClusteringTest, NullsSortLast) {
+  sql("create table test_table (i int, t text encoding none) with (fragment_size = 2, "
+      "sort_column = 'i');");
+  sql("insert into test_table values (null, 'null');");
+  insertValues({2, 1});
+  sql("insert into test_table values (3, null);");
+
+  sql("optimize table test_table with (cluster = 'true');");
+  assertChunkContentAndMetadata(0, {1, 2});
+  sqlAndCompareResult("select i, t from test_table where i is not null order by i;",
+                      {{i(1), "str1"}, {i(2), "str2"}, {i(3), Null}});
+  sqlAndCompareResult("select t from test_table where i is null;", {{"null"}});
+}
+
+TEST_F(ClusteringTest, ZOrderClusterColumns) {
+  sql("create table test_table (x int, y int) with (fragment_size = 4, "
+      "cluster_columns = 'x, y');");
+  for (int x = 0; x < 4; ++x) {
+    for (int y = 0; y < 4; ++y) {
+      sql("insert into test_table values (" + std::to_string(x) + ", " +
+          std::to_string(y) + ");");
+    }
+  }
+
+  // background clustering leaves Z-order clustering to OPTIMIZE TABLE
+  EXPECT_EQ(AutoVacuumScheduler::clusterTables(), size_t(0));
+
+  // each fragment gets one quadrant of the grid
+  sql("optimize table test_table with (cluster = 'true');");
+  const std::vector<std::pair<int32_t, int32_t>> x_ranges{{0, 1}, {0, 1}, {2, 3}, {2, 3}};
+  const std::vector<std::pair<int32_t, int32_t>> y_ranges{{0, 1}, {2, 3}, {0, 1}, {2, 3}};
+  for (int32_t fragment_id = 0; fragment_id < 4; ++fragment_id) {
+    auto [x_chunk, x_metadata] = getChunkAndMetadata("x", fragment_id);
+    assertMinAndMax(
+        x_ranges[fragment_id].first, x_ranges[fragment_id].second, x_metadata);
+    auto [y_chunk, y_metadata] = getChunkAndMetadata("y", fragment_id);
+    assertMinAndMax(
+        y_ranges[fragment_id].first, y_ranges[fragment_id].second, y_metadata);
+  }
+  sqlAndCompareResult("select count(*) from test_table where y = 3;", {{i(4)}});
+}
+
+class PartitionedTableTest : public OpportunisticVacuumingTest {};
+
+TEST_F(PartitionedTableTest, FragmentPerPartitionAndRetention) {
+  sql("create table test_table (ts timestamp(0), i int) with (fragment_size = 10, "
+      "partition_column = 'ts', partition_interval = 'DAY', partition_retention = 2);");
+  sql("insert into test_table values ('2021-01-01 10:00:00', 1);");
+  sql("insert into test_table values ('2021-01-01 23:00:00', 2);");
+  sql("insert into test_table values ('2021-01-02 01:00:00', 3);");
+  sql("insert into test_table values (null, 4);");
+
+  // a fragment never mixes partitions
+  assertChunkContentAndMetadata(0, {1, 2});
+  assertChunkContentAndMetadata(1, {3});
+  assertChunkContentAndMetadata(2, {4});
+  sqlAndCompareResult("select count(*) from test_table where ts < '2021-01-02';",
+                      {{i(2)}});
+
+  // the partitions older than the two newest days are dropped, nulls never expire
+  sql("insert into test_table values ('2021-01-03 12:00:00', 5);");
+  assertFragmentRowCount(3);
+  sqlAndCompareResult("select i from test_table order by i;", {{i(3)}, {i(4)}, {i(5)}});
+}
+
+class DictionaryCompactionTest : public OpportunisticVacuumingTest {
+ protected:
+  size_t getDictionaryEntryCount(const std::string& column_name) {
+    const auto& cat = getCatalog();
+    const auto td = cat.getMetadataForTable("test_table");
+    CHECK(td);
+    const auto cd = cat.getMetadataForColumn(td->tableId, column_name);
+    CHECK(cd);
+    const auto dd = cat.getMetadataForDict(cd->columnType.get_comp_param(), true);
+    CHECK(dd);
+    return dd->stringDict->storageEntryCount();
+  }
+};
+
+TEST_F(DictionaryCompactionTest, RemovesUnreferencedStrings) {
+  sql("create table test_table (i int, t text encoding dict(16)) with "
+      "(fragment_size = 2);");
+  for (int value = 1; value <= 6; ++value) {
+    sql("insert into test_table values (" + std::to_string(value) + ", 'str" +
+        std::to_string(value) + "');");
+  }
+  sql("insert into test_table values (7, null);");
+  sql("delete from test_table where i <= 3;");
+  EXPECT_EQ(getDictionaryEntryCount("t"), size_t(6));
+
+  sql("optimize table test_table with (vacuum = 'true', compact_dictionaries = 'true');");
+  EXPECT_EQ(getDictionaryEntryCount("t"), size_t(3));
+  sqlAndCompareResult("select i, t from test_table order by i;",
+                      {{i(4), "str4"}, {i(5), "str5"}, {i(6), "str6"}, {i(7), Null}});
+  sqlAndCompareResult("select count(*) from test_table where t = 'str5';", {{i(1)}});
+
+  // new strings get ids after the compacted ones
+  sql("insert into test_table values (8, 'str8');");
+  sql("insert into test_table values (9, 'str4');");
+  EXPECT_EQ(getDictionaryEntryCount("t"), size_t(4));
+  sqlAndCompareResult("select count(*) from test_table where t = 'str4';", {{i(2)}});
+
+  // a dictionary without unreferenced strings is left alone
+  sql("optimize table test_table with (compact_dictionaries = 'true');");
+  EXPECT_EQ(getDictionaryEntryCount("t"), size_t(4));
+}
+
 int main(int argc, char** argv) {
   TestHelpers::init_logger_stderr_only(argc, argv);
   testing::InitGoogleTest(&argc, argv);
@@ -32,6 +32,8 @@
 extern bool g_enable_fsi;
 extern bool g_enable_s3_fsi;
 extern bool g_enable_calcite_ddl_parser;
+extern bool g_enable_adaptive_fragment_size;
+extern size_t g_adaptive_fragment_target_bytes;
 
 using namespace std;
 using namespace TestHelpers;
@@ -1696,6 +1698,54 @@ TEST_F(CreateNonReservedKeywordsTest, NonReservedRename) {
   sql("ALTER TABLE test_table RENAME COLUMN QUERY to virtual;");
 }
 
+class AdaptiveFragmentSizeTest : public CreateAndDropTableDdlTest {
+ protected:
+  void SetUp() override {
+    CreateAndDropTableDdlTest::SetUp();
+    sql(getDropTableQuery(ddl_utils::TableType::TABLE, "test_table", true));
+    g_enable_adaptive_fragment_size = true;
+    g_adaptive_fragment_target_bytes = 64 * 1024 * 1024;
+  }
+
+  void TearDown() override {
+    g_enable_adaptive_fragment_size = false;
+    g_adaptive_fragment_target_bytes = target_bytes_;
+    sql(getDropTableQuery(ddl_utils::TableType::TABLE, "test_table", true));
+    CreateAndDropTableDdlTest::TearDown();
+  }
+
+ private:
+  const size_t target_bytes_{g_adaptive_fragment_target_bytes};
+};
+
+TEST_F(AdaptiveFragmentSizeTest, FromRowWidth) {
+  sql(getCreateTableQuery(
+      ddl_utils::TableType::TABLE, "test_table", "(i BIGINT, j INTEGER, d DOUBLE)"));
+  auto td = getCatalog().getMetadataForTable("test_table", false);
+  // 64 MB over 20 bytes per row, rounded down to whole millions (2^20) of rows
+  EXPECT_EQ(3 * 1024 * 1024, td->maxFragRows);
+}
+
+TEST_F(AdaptiveFragmentSizeTest, WideRowsClampedToMinimum) {
+  std::string columns{"("};
+  for (int i = 0; i < 100; ++i) {
+    columns += (i ? ", t" : "t") + std::to_string(i) + " TEXT ENCODING NONE";
+  }
+  columns += ")";
+  sql(getCreateTableQuery(ddl_utils::TableType::TABLE, "test_table", columns));
+  auto td = getCatalog().getMetadataForTable("test_table", false);
+  EXPECT_EQ(1024 * 1024, td->maxFragRows);
+}
+
+TEST_F(AdaptiveFragmentSizeTest, ExplicitFragmentSize) {
+  sql(getCreateTableQuery(ddl_utils::TableType::TABLE,
+                          "test_table",
+                          "(i BIGINT)",
+                          {{"fragment_size", "10"}}));
+  auto td = getCatalog().getMetadataForTable("test_table", false);
+  EXPECT_EQ(10, td->maxFragRows);
+}
+
 class RenameTableTest : public CreateAndDropTableDdlTest {
  protected:
   void SetUp() override {
@@ -959,6 +959,54 @@ TEST_P(Itas, InsertIntoShardedTableFromSelectReplicated) {
                ") WITH (partitions='REPLICATED')");
 }
 
+TEST(ItasColumnar, InsertFixedWidthColumns) {
+  run_ddl_statement("DROP TABLE IF EXISTS ITAS_SOURCE;");
+  run_ddl_statement("DROP TABLE IF EXISTS ITAS_TARGET;");
+  const std::string columns{
+      " (id int, b bigint, d double, f float, ts timestamp(0), dc decimal(10,2)"};
+  run_ddl_statement("CREATE TABLE ITAS_SOURCE" + columns + ") WITH (FRAGMENT_SIZE=3);");
+  run_ddl_statement("CREATE TABLE ITAS_TARGET" + columns + ");");
+
+  for (int row = 0; row < 10; ++row) {
+    const auto id = std::to_string(row);
+    run_multiple_agg(row % 3 == 0
+                         ? "INSERT INTO ITAS_SOURCE VALUES (" + id +
+                               ", NULL, NULL, NULL, NULL, NULL);"
+                         : "INSERT INTO ITAS_SOURCE VALUES (" + id + ", " + id +
+                               "000000000, " + id + ".5, " + id +
+                               ".25, '2021-01-0" + id + " 01:02:03', " + id + ".75);");
+  }
+
+  // every target is a fixed width column of the same type, so the rows are inserted from
+  // the columnar query result buffers
+  run_ddl_statement("INSERT INTO ITAS_TARGET SELECT * FROM ITAS_SOURCE WHERE id > 1;");
+  // an INT into the BIGINT column sends all the rows through the value converters
+  run_ddl_statement(
+      "INSERT INTO ITAS_TARGET SELECT id + 100, id, d, f, ts, dc FROM ITAS_SOURCE;");
+
+  const auto check_rows = [](const std::string& expected_sql,
+                             const std::string& actual_sql,
+                             const size_t row_count) {
+    const auto expected = run_multiple_agg(expected_sql);
+    const auto actual = run_multiple_agg(actual_sql);
+    ASSERT_EQ(row_count, actual.row_set.rows.size());
+    ASSERT_EQ(row_count, expected.row_set.rows.size());
+    for (size_t row = 0; row < row_count; ++row) {
+      EXPECT_TRUE(expected.row_set.rows[row] == actual.row_set.rows[row]) << row;
+    }
+  };
+  check_rows("SELECT * FROM ITAS_SOURCE WHERE id > 1 ORDER BY id;",
+             "SELECT * FROM ITAS_TARGET WHERE id < 100 ORDER BY id;",
+             8);
+  check_rows(
+      "SELECT id + 100, CAST(id AS BIGINT), d, f, ts, dc FROM ITAS_SOURCE ORDER BY id;",
+      "SELECT * FROM ITAS_TARGET WHERE id >= 100 ORDER BY id;",
+      10);
+
+  run_ddl_statement("DROP TABLE ITAS_SOURCE;");
+  run_ddl_statement("DROP TABLE ITAS_TARGET;");
+}
+
 const std::shared_ptr<TestColumnDescriptor> STRING_NONE_BASE =
     std::make_shared<StringColumnDescriptor>("TEXT ENCODING NONE",
                                              kTEXT,
@@ -19,6 +19,7 @@
 #include <iostream>
 #include "DBHandlerTestHelpers.h"
 #include "QueryEngine/ErrorHandling.h"
+#include "Shared/scope.h"
 #include "TestHelpers.h"
 
 // uncomment to run full test suite
@@ -28,6 +29,8 @@
 #define BASE_PATH "./tmp"
 #endif
 
+extern bool g_enable_pipelined_itas;
+
 class TestColumnDescriptor {
  public:
   virtual std::string get_column_definition() = 0;
@@ -1728,6 +1731,33 @@ TEST_F(Itas, AllowDifferentFixedEncodings) {
   EXPECT_NO_THROW(sql("INSERT INTO ITAS_TARGET SELECT * FROM ITAS_SOURCE;"));
 }
 
+TEST_F(Itas, PipelinedLoad) {
+  ScopeGuard reset = [orig = g_enable_pipelined_itas] { g_enable_pipelined_itas = orig; };
+  g_enable_pipelined_itas = true;
+  sql("DROP TABLE IF EXISTS ITAS_SOURCE;");
+  sql("DROP TABLE IF EXISTS ITAS_TARGET;");
+
+  sql("CREATE TABLE ITAS_SOURCE (id int, str text) WITH (FRAGMENT_SIZE=2);");
+  sql("CREATE TABLE ITAS_TARGET (id bigint, str text);");
+  for (int id = 1; id <= 7; ++id) {
+    sql("INSERT INTO ITAS_SOURCE VALUES(" + std::to_string(id) + ", 'str" +
+        std::to_string(id % 3) + "');");
+  }
+
+  // the rows of every source fragment are loaded while the next fragment is queried
+  sql("INSERT INTO ITAS_TARGET SELECT id, str FROM ITAS_SOURCE;");
+  sql("INSERT INTO ITAS_TARGET SELECT id + 10, str FROM ITAS_SOURCE WHERE id > 3;");
+
+  TQueryResult result;
+  sql(result, "SELECT COUNT(*), SUM(id), COUNT(DISTINCT str) FROM ITAS_TARGET;");
+  assertResultSetEqual({{i(11), i(90), i(3)}}, result);
+  sql(result, "SELECT COUNT(*) FROM ITAS_TARGET WHERE str = 'str1';");
+  assertResultSetEqual({{i(5)}}, result);
+
+  sql("DROP TABLE ITAS_SOURCE;");
+  sql("DROP TABLE ITAS_TARGET;");
+}
+
 TEST_F(Itas, SelectStar) {
   sql("DROP TABLE IF EXISTS ITAS_SOURCE_1;");
   sql("DROP TABLE IF EXISTS ITAS_SOURCE_2;");
@@ -3016,6 +3046,62 @@ TEST_F(Non_Kernel_Time_Interrupt, Interrupt_ITAS) {
   }
 }
 
+TEST_F(Non_Kernel_Time_Interrupt, Interrupt_Pipelined_ITAS) {
+  ScopeGuard reset = [orig = g_enable_pipelined_itas] { g_enable_pipelined_itas = orig; };
+  g_enable_pipelined_itas = true;
+  const auto& [db_handler, session_id] = getDbHandlerAndSessionId();
+  sql("DROP TABLE IF EXISTS t_ITAS;");
+  sql("CREATE TABLE t_ITAS (x int not null);");
+
+  // t_very_large has two fragments, the rows of the first one are loaded while the
+  // source query runs over the second one
+  std::atomic<bool> catchInterruption(false);
+  auto itas_thread = std::async(std::launch::async, [&] {
+    try {
+      sql("INSERT INTO t_ITAS SELECT x FROM t_very_large");
+    } catch (const QueryExecutionError& e) {
+      if (e.getErrorCode() == Executor::ERR_INTERRUPTED) {
+        catchInterruption.store(true);
+      } else if (e.getErrorCode() >= 0) {
+        throw;
+      }
+    } catch (const std::runtime_error& e) {
+      EXPECT_NE(std::string(e.what()).find("interrupted"), std::string::npos)
+          << e.what();
+      catchInterruption.store(true);
+    }
+  });
+
+  auto executor = Executor::getExecutor(Executor::UNITARY_EXECUTOR_ID);
+  auto get_query_status = [&executor, session_id = session_id] {
+    mapd_shared_lock<mapd_shared_mutex> session_read_lock(executor->getSessionLock());
+    return executor->getQuerySessionInfo(session_id, session_read_lock);
+  };
+  const auto start_time = std::chrono::system_clock::now();
+  while (itas_thread.wait_for(std::chrono::milliseconds(100)) !=
+         std::future_status::ready) {
+    auto query_status = get_query_status();
+    const bool loading =
+        std::any_of(query_status.begin(), query_status.end(), [](auto& status) {
+          return status.getQueryStr().find("INSERT_DATA") != std::string::npos;
+        });
+    if (loading || std::chrono::system_clock::now() - start_time >
+                       std::chrono::seconds(60)) {
+      executor->interrupt(session_id, session_id);
+      break;
+    }
+  }
+  itas_thread.get();
+
+  // the load and the source queries leave no session entry behind, whichever of them
+  // saw the interrupt
+  EXPECT_TRUE(get_query_status().empty());
+  if (catchInterruption.load()) {
+    std::cout << "Detect interrupt request while performing pipelined ITAS" << std::endl;
+  }
+  sql("DROP TABLE t_ITAS;");
+}
+
 TEST_F(Non_Kernel_Time_Interrupt, Interrupt_CTAS) {
   std::atomic<bool> catchInterruption(false);
   try {
@@ -19,7 +19,10 @@
 #include "Logger/Logger.h"
 #include "QueryEngine/CompilationOptions.h"
 #include "QueryEngine/Execute.h"
+#include "QueryEngine/LinearizedColumnCache.h"
 #include "QueryEngine/QueryPlanDagExtractor.h"
+#include "QueryEngine/ResultSetRecycler.h"
+#include "Shared/scope.h"
 
 #include "QueryRunner/QueryRunner.h"
 
@@ -439,6 +442,100 @@ TEST(DataRecycler, DAG_Cache_Size_Management) {
   CHECK_GE(DAG_CACHE.getCurrentNodeMapSize(), 48u);
 }
 
+TEST(DataRecycler, Subquery_Result_Recycling) {
+  g_result_set_recycler_max_bytes = 1 << 20;
+  ScopeGuard reset_recycler = [] {
+    g_result_set_recycler_max_bytes = 0;
+    ResultSetRecycler::instance().clear();
+    run_ddl_statement("DROP TABLE IF EXISTS recycler_test;");
+  };
+  ResultSetRecycler::instance().clear();
+  run_ddl_statement("DROP TABLE IF EXISTS recycler_test;");
+  run_ddl_statement("CREATE TABLE recycler_test (x int);");
+  for (int i = 1; i <= 3; ++i) {
+    QR::get()->runSQL("INSERT INTO recycler_test VALUES (" + std::to_string(i) + ");",
+                      ExecutorDeviceType::CPU);
+  }
+  auto get_count = []() -> int64_t {
+    const auto rows = QR::get()->runSQL(
+        "SELECT COUNT(*) FROM recycler_test WHERE x < (SELECT MAX(x) FROM "
+        "recycler_test);",
+        ExecutorDeviceType::CPU);
+    const auto row = rows->getNextRow(true, false);
+    CHECK_EQ(row.size(), size_t(1));
+    return TestHelpers::v<int64_t>(row[0]);
+  };
+
+  EXPECT_EQ(get_count(), 2);
+  EXPECT_EQ(ResultSetRecycler::instance().getNumberOfCachedResults(), 1u);
+  EXPECT_EQ(get_count(), 2);
+  EXPECT_EQ(ResultSetRecycler::instance().getNumberOfCachedResults(), 1u);
+
+  // inserts change the key of the subquery
+  QR::get()->runSQL("INSERT INTO recycler_test VALUES (4);", ExecutorDeviceType::CPU);
+  EXPECT_EQ(get_count(), 3);
+  EXPECT_EQ(ResultSetRecycler::instance().getNumberOfCachedResults(), 2u);
+
+  // deletes clear the recycler
+  QR::get()->runSQL("DELETE FROM recycler_test WHERE x = 1;", ExecutorDeviceType::CPU);
+  EXPECT_EQ(ResultSetRecycler::instance().getNumberOfCachedResults(), 0u);
+  EXPECT_EQ(get_count(), 2);
+}
+
+TEST(DataRecycler, Linearized_Column_Caching) {
+  g_linearized_column_cache_max_bytes = 1 << 20;
+  ScopeGuard reset_cache = [] {
+    g_linearized_column_cache_max_bytes = 0;
+    LinearizedColumnCache::instance().clear();
+    run_ddl_statement("DROP TABLE IF EXISTS linearized_outer;");
+    run_ddl_statement("DROP TABLE IF EXISTS linearized_inner;");
+  };
+  LinearizedColumnCache::instance().clear();
+  run_ddl_statement("DROP TABLE IF EXISTS linearized_outer;");
+  run_ddl_statement("DROP TABLE IF EXISTS linearized_inner;");
+  run_ddl_statement("CREATE TABLE linearized_outer (x int);");
+  // the inner table spans several fragments, so its columns are merged for the join
+  run_ddl_statement(
+      "CREATE TABLE linearized_inner (x int, y int) WITH (fragment_size = 2);");
+  for (int i = 1; i <= 4; ++i) {
+    QR::get()->runSQL("INSERT INTO linearized_outer VALUES (" + std::to_string(i) + ");",
+                      ExecutorDeviceType::CPU);
+    QR::get()->runSQL("INSERT INTO linearized_inner VALUES (" + std::to_string(i) +
+                          ", " + std::to_string(10 * i) + ");",
+                      ExecutorDeviceType::CPU);
+  }
+  auto get_sum = []() -> int64_t {
+    const auto rows = QR::get()->runSQL(
+        "SELECT SUM(b.y) FROM linearized_outer a, linearized_inner b WHERE a.x = b.x;",
+        ExecutorDeviceType::CPU);
+    const auto row = rows->getNextRow(true, false);
+    CHECK_EQ(row.size(), size_t(1));
+    return TestHelpers::v<int64_t>(row[0]);
+  };
+
+  EXPECT_EQ(get_sum(), 100);
+  const auto num_cached_columns =
+      LinearizedColumnCache::instance().getNumberOfCachedColumns();
+  EXPECT_GE(num_cached_columns, 1u);
+  EXPECT_LE(LinearizedColumnCache::instance().getSizeBytes(),
+            g_linearized_column_cache_max_bytes);
+  EXPECT_EQ(get_sum(), 100);
+  EXPECT_EQ(LinearizedColumnCache::instance().getNumberOfCachedColumns(),
+            num_cached_columns);
+
+  // inserts change the key of the columns of the table
+  QR::get()->runSQL("INSERT INTO linearized_inner VALUES (4, 50);",
+                    ExecutorDeviceType::CPU);
+  EXPECT_EQ(get_sum(), 150);
+  EXPECT_EQ(LinearizedColumnCache::instance().getNumberOfCachedColumns(),
+            2 * num_cached_columns);
+
+  // deletes clear the cache
+  QR::get()->runSQL("DELETE FROM linearized_inner WHERE x = 1;", ExecutorDeviceType::CPU);
+  EXPECT_EQ(LinearizedColumnCache::instance().getNumberOfCachedColumns(), 0u);
+  EXPECT_EQ(get_sum(), 140);
+}
+
 int main(int argc, char* argv[]) {
   testing::InitGoogleTest(&argc, argv);
   TestHelpers::init_logger_stderr_only(argc, argv);
@@ -91,11 +91,15 @@ class TableTest : public DBHandlerTestFixture {
   }
 
   static void resetPersistentStorageMgr(File_Namespace::DiskCacheLevel cache_level) {
+    resetPersistentStorageMgr({psm_->getDiskCacheConfig().path, cache_level});
+  }
+
+  static void resetPersistentStorageMgr(
+      const File_Namespace::DiskCacheConfig& cache_config) {
     for (auto table_it : cat_->getAllTableMetadata()) {
       cat_->removeFragmenterForTable(table_it->tableId);
     }
-    cat_->getDataMgr().resetPersistentStorage(
-        {psm_->getDiskCacheConfig().path, cache_level}, 0, getSystemParameters());
+    cat_->getDataMgr().resetPersistentStorage(cache_config, 0, getSystemParameters());
     psm_ = cat_->getDataMgr().getPersistentStorageMgr();
     cache_ = psm_->getDiskCache();
   }
@@ -180,6 +184,31 @@ TEST_F(TableTest, RecoverCache_NonFSI) {
   resetStorageManagerAndClearTableMemory(table_key, File_Namespace::DiskCacheLevel::all);
 }
 
+TEST_F(TableTest, AdmissionFetchCount) {
+  sqlCreateTable("(i INTEGER)");
+  sql("INSERT INTO " + default_table_name + " VALUES(1);");
+  const ChunkKey table_key{cat_->getCurrentDB().dbId,
+                           cat_->getMetadataForTable(default_table_name)->tableId};
+  const ChunkKey key1{table_key[0], table_key[1], 1, 0};
+  File_Namespace::DiskCacheConfig cache_config{psm_->getDiskCacheConfig().path,
+                                               File_Namespace::DiskCacheLevel::non_fsi};
+  cache_config.admission_fetch_count = 2;
+  resetPersistentStorageMgr(cache_config);
+  cache_->clear();
+
+  cat_->getDataMgr().deleteChunksWithPrefix(table_key, MemoryLevel::CPU_LEVEL);
+  cat_->getDataMgr().deleteChunksWithPrefix(table_key, MemoryLevel::GPU_LEVEL);
+  sqlAndCompareResult("SELECT * FROM " + default_table_name + ";", {{i(1)}});
+  ASSERT_EQ(cache_->getCachedChunkIfExists(key1), nullptr);
+
+  cat_->getDataMgr().deleteChunksWithPrefix(table_key, MemoryLevel::CPU_LEVEL);
+  cat_->getDataMgr().deleteChunksWithPrefix(table_key, MemoryLevel::GPU_LEVEL);
+  sqlAndCompareResult("SELECT * FROM " + default_table_name + ";", {{i(1)}});
+  ASSERT_NE(cache_->getCachedChunkIfExists(key1), nullptr);
+  sqlDropTable();
+  resetStorageManagerAndClearTableMemory(table_key, File_Namespace::DiskCacheLevel::all);
+}
+
 int main(int argc, char** argv) {
   TestHelpers::init_logger_stderr_only(argc, argv);
   testing::InitGoogleTest(&argc, argv);
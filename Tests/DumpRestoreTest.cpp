@@ -226,6 +226,13 @@ void BODY_F(DumpRestoreTest, DumpMigrate_Altered) {
 void BODY_F(DumpRestoreTest, DumpMigrate_Altered_Rollback) {
   dump_restore(true, true, true);
 }
+void BODY_F(DumpRestoreTest, DumpMigrate_Zstd) {
+  if (boost::process::search_path("zstd").string().empty()) {
+    LOG(ERROR) << "zstd is not found. Skipping test.";
+    return;
+  }
+  dump_restore(true, false, false, {"compression='zstd'"});
+}
 
 // restore table tests
 TEST_UNSHARDED_AND_SHARDED(DumpRestoreTest, DumpRestore)
@@ -237,6 +244,7 @@ TEST_UNSHARDED_AND_SHARDED(DumpRestoreTest, DumpMigrate)
 TEST_UNSHARDED_AND_SHARDED(DumpRestoreTest, DumpMigrate_Rollback)
 TEST_UNSHARDED_AND_SHARDED(DumpRestoreTest, DumpMigrate_Altered)
 TEST_UNSHARDED_AND_SHARDED(DumpRestoreTest, DumpMigrate_Altered_Rollback)
+TEST_UNSHARDED_AND_SHARDED(DumpRestoreTest, DumpMigrate_Zstd)
 
 class DumpAndRestoreTest : public ::testing::Test {
  protected:
@@ -419,6 +427,36 @@ TEST_F(DumpAndRestoreTest, TableWithMaxRollbackEpochs) {
   ASSERT_EQ(10, td->maxRollbackEpochs);
 }
 
+TEST_F(DumpAndRestoreTest, IncrementalDump) {
+  const auto incremental_path = tar_ball_path + "_incremental";
+  boost::filesystem::remove_all(incremental_path);
+  run_ddl_statement("CREATE TABLE test_table (i INTEGER);");
+  run_multiple_agg("INSERT INTO test_table VALUES(1);");
+  run_multiple_agg("INSERT INTO test_table VALUES(2);");
+  run_ddl_statement("DUMP TABLE test_table TO '" + tar_ball_path + "';");
+  const auto catalog = QR::get()->getCatalog();
+  const auto td = catalog->getMetadataForTable("test_table", false);
+  ASSERT_TRUE(td != nullptr);
+  const auto base_epoch =
+      catalog->getTableEpoch(catalog->getCurrentDB().dbId, td->tableId);
+  run_multiple_agg("INSERT INTO test_table VALUES(3);");
+
+  run_ddl_statement("DUMP TABLE test_table TO '" + incremental_path +
+                    "' WITH (base_epoch=" + std::to_string(base_epoch) + ");");
+  run_ddl_statement("RESTORE TABLE test_table_2 FROM '" + tar_ball_path +
+                    "' WITH (incremental='" + incremental_path + "');");
+  sqlAndCompareResult("SELECT * FROM test_table_2 ORDER BY i;", {1, 2, 3});
+  // an incremental dump from a newer epoch doesn't cover the inserted row
+  run_ddl_statement("DROP TABLE test_table_2;");
+  boost::filesystem::remove_all(incremental_path);
+  run_ddl_statement("DUMP TABLE test_table TO '" + incremental_path +
+                    "' WITH (base_epoch=" + std::to_string(base_epoch + 1) + ");");
+  EXPECT_THROW(run_ddl_statement("RESTORE TABLE test_table_2 FROM '" + tar_ball_path +
+                                 "' WITH (incremental='" + incremental_path + "');"),
+               std::runtime_error);
+  boost::filesystem::remove_all(incremental_path);
+}
+
 int main(int argc, char** argv) {
   testing::InitGoogleTest(&argc, argv);
 
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <arrow/api.h>
 #include <gtest/gtest.h>
 #include <boost/program_options.hpp>
 #include "Embedded/DBEngine.h"
@@ -25,6 +26,9 @@
 using namespace std;
 using namespace EmbeddedDatabase;
 
+extern bool g_enable_columnar_output;
+extern bool g_enable_lazy_fetch;
+
 std::shared_ptr<DBEngine> engine;
 
 class DBEngineSQLTest : public ::testing::Test {
@@ -130,6 +134,26 @@ TEST_F(DBEngineSQLTest, UpdateText) {
   ASSERT_EQ(4, select_int("select count(t) from dbe_test where t='pizza';"));
 }
 
+TEST_F(DBEngineSQLTest, ZeroCopyArrowResults) {
+  // --zero-copy-arrow-results is on unless the engine command line turns it off
+  EXPECT_TRUE(g_enable_columnar_output);
+  EXPECT_FALSE(g_enable_lazy_fetch);
+
+  EXPECT_NO_THROW(SetUp("(x INT, d DOUBLE)"));
+  EXPECT_NO_THROW(run_dml("INSERT INTO dbe_test VALUES(1, 1.5);"));
+  EXPECT_NO_THROW(run_dml("INSERT INTO dbe_test VALUES(2, 2.5);"));
+  auto record_batch = run_dml("SELECT x, d FROM dbe_test ORDER BY x;");
+  ASSERT_NE(record_batch, nullptr);
+  ASSERT_EQ(record_batch->num_rows(), 2);
+  ASSERT_EQ(record_batch->num_columns(), 2);
+  auto x_column = std::static_pointer_cast<arrow::Int32Array>(record_batch->column(0));
+  EXPECT_EQ(x_column->Value(0), 1);
+  EXPECT_EQ(x_column->Value(1), 2);
+  auto d_column = std::static_pointer_cast<arrow::DoubleArray>(record_batch->column(1));
+  EXPECT_EQ(d_column->Value(0), 1.5);
+  EXPECT_EQ(d_column->Value(1), 2.5);
+}
+
 TEST_F(DBEngineSQLTest, FilterAndSimpleAggregation) {
   const ssize_t num_rows{10};
 
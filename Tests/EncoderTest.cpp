@@ -763,6 +763,77 @@ TYPED_TEST(FixedLengthArrayNoneEncoderUpdateStatsTest, TypedTest) {
   TestFixture::runTest();
 }
 
+TEST(ColumnStats, SketchAndHistogram) {
+  const bool enable_column_stats = g_enable_column_stats;
+  g_enable_column_stats = true;
+  ColumnStatsBuilder builder;
+  builder.reset();
+  g_enable_column_stats = enable_column_stats;
+
+  // 10000 rows cycling through 1000 values, every tenth row is null.
+  constexpr size_t num_rows{10000};
+  for (size_t row = 0; row < num_rows; ++row) {
+    builder.update(row, row % 1000, row % 10 == 9);
+  }
+  EXPECT_EQ(nullptr, builder.get(num_rows - 1));
+  auto stats = builder.get(num_rows);
+  ASSERT_NE(nullptr, stats);
+  EXPECT_EQ(size_t(9000), stats->num_values);
+  EXPECT_EQ(size_t(1000), stats->num_nulls);
+  EXPECT_DOUBLE_EQ(0.1, stats->getNullFraction());
+  // The values ending with 9 are all null.
+  EXPECT_NEAR(900, stats->getDistinctValuesEstimate(), 900 * 0.1);
+  const auto bounds = stats->getHistogramBounds(4);
+  ASSERT_EQ(size_t(5), bounds.size());
+  EXPECT_TRUE(std::is_sorted(bounds.begin(), bounds.end()));
+  EXPECT_NEAR(500, bounds[2], 150);
+
+  // Merging the stats of a chunk with the same values only adds to the counts.
+  ColumnStats merged = *stats;
+  merged.merge(*stats);
+  EXPECT_EQ(size_t(18000), merged.num_values);
+  EXPECT_DOUBLE_EQ(stats->getDistinctValuesEstimate(),
+                   merged.getDistinctValuesEstimate());
+  EXPECT_LE(merged.sample.size(), ColumnStats::kMaxSampleSize);
+
+  // Appends which don't follow the rows seen drop the stats.
+  builder.beginAppend(num_rows + 1);
+  EXPECT_EQ(nullptr, builder.get(num_rows));
+}
+
+TEST(BlockBounds, PointCoords) {
+  const bool enable_geo_block_bounds = g_enable_geo_block_bounds;
+  const auto zone_map_block_rows = g_zone_map_block_rows;
+  g_enable_geo_block_bounds = true;
+  g_zone_map_block_rows = 2;
+  SQLTypeInfo coords_ti(kARRAY, false);
+  coords_ti.set_subtype(kTINYINT);
+  coords_ti.set_size(2 * sizeof(double));
+  BlockBoundsBuilder builder;
+  builder.reset(coords_ti);
+  g_enable_geo_block_bounds = enable_geo_block_bounds;
+  g_zone_map_block_rows = zone_map_block_rows;
+
+  const std::vector<std::array<double, 2>> points{{0, 0}, {1, 2}, {10, 10}, {-1, 11}};
+  for (size_t row = 0; row < points.size(); ++row) {
+    builder.update(row, reinterpret_cast<const int8_t*>(points[row].data()), false);
+  }
+  const std::array<double, 2> null_point{NULL_ARRAY_DOUBLE, NULL_ARRAY_DOUBLE};
+  builder.update(points.size(), reinterpret_cast<const int8_t*>(null_point.data()), true);
+  const auto block_bounds = builder.get(points.size() + 1);
+  ASSERT_NE(nullptr, block_bounds);
+  ASSERT_EQ(size_t(3), block_bounds->bounds.size());
+  EXPECT_EQ((std::array<double, 4>{0, 0, 1, 2}), block_bounds->bounds[0]);
+  EXPECT_EQ((std::array<double, 4>{-1, 10, 10, 11}), block_bounds->bounds[1]);
+  EXPECT_TRUE(block_bounds->mayIntersect(0, {0.5, 0.5, 5, 5}));
+  EXPECT_FALSE(block_bounds->mayIntersect(1, {0.5, 0.5, 5, 5}));
+  EXPECT_FALSE(block_bounds->mayIntersect(2, {-100, -100, 100, 100}));
+
+  // Only appends in row order are tracked.
+  builder.update(2, reinterpret_cast<const int8_t*>(points[0].data()), false);
+  EXPECT_EQ(nullptr, builder.get(points.size() + 1));
+}
+
 int main(int argc, char** argv) {
   TestHelpers::init_logger_stderr_only(argc, argv);
   testing::InitGoogleTest(&argc, argv);
@@ -19,9 +19,12 @@
 #include "../ImportExport/Importer.h"
 #include "../Parser/parser.h"
 #include "../QueryEngine/ArrowResultSet.h"
+#include "../QueryEngine/BatchInterpreter.h"
 #include "../QueryEngine/Descriptors/RelAlgExecutionDescriptor.h"
 #include "../QueryEngine/Execute.h"
+#include "../QueryEngine/RelAlgExecutor.h"
 #include "../QueryEngine/ResultSetReductionJIT.h"
+#include "../QueryEngine/SharedScan.h"
 #include "../QueryRunner/QueryRunner.h"
 #include "../Shared/DateConverters.h"
 #include "../Shared/StringTransform.h"
@@ -53,18 +56,49 @@ extern bool g_allow_cpu_retry;
 extern bool g_enable_watchdog;
 extern bool g_skip_intermediate_count;
 extern bool g_use_tbb_pool;
+extern bool g_enable_cpu_kernel_work_stealing;
+extern bool g_enable_shared_cpu_group_by_buffer;
 extern bool g_enable_left_join_filter_hoisting;
+extern bool g_join_key_range_fragment_skipping;
+extern bool g_enable_in_subquery_semi_join;
+extern size_t g_max_parallel_union_branches;
+extern size_t g_chunk_prefetch_depth;
 
 extern unsigned g_trivial_loop_join_threshold;
+extern size_t g_loop_join_inner_tile_bytes;
 extern bool g_enable_overlaps_hashjoin;
+extern bool g_enable_range_joins;
+extern bool g_enable_clustered_join_windows;
+extern size_t g_clustered_join_window_rows;
+extern bool g_enable_approx_top_k_group_by;
+extern size_t g_approx_top_k_sketch_factor;
 extern double g_gpu_mem_limit_percent;
 extern size_t g_parallel_top_min;
+extern size_t g_parallel_sort_min;
+extern size_t g_streaming_topn_max;
+extern size_t g_parallel_window_partition_min;
+extern bool g_enable_count_distinct_sparse_bitmap;
+extern bool g_enable_lazy_group_by_buffer_init;
+extern size_t g_cpu_small_step_max_rows;
+extern bool g_enable_cpu_gpu_projection;
+extern bool g_enable_qual_specialization;
+extern bool g_enable_null_check_elision;
+extern size_t g_max_concurrent_update_fragments;
 
 extern bool g_enable_window_functions;
 extern bool g_enable_calcite_view_optimize;
 extern bool g_enable_bump_allocator;
 extern bool g_enable_interop;
+extern bool g_enable_batch_interpreter;
 extern bool g_enable_union;
+extern double g_sparse_perfect_hash_min_density;
+extern size_t g_sparse_perfect_hash_min_entries;
+extern size_t g_query_cpu_memory_budget;
+extern bool g_enable_partitioned_group_by;
+extern size_t g_zone_map_block_rows;
+extern size_t g_dictionary_index_max_block_values;
+extern size_t g_jit_low_tier_max_rows;
+extern size_t g_jit_tier_promotion_count;
 
 extern size_t g_leaf_count;
 extern bool g_cluster;
@@ -1145,6 +1179,179 @@ TEST(Select, NullGroupBy) {
   }
 }
 
+TEST(Select, FilterSpecializedOnChunkMetadata) {
+  ScopeGuard reset = [orig = g_enable_qual_specialization] {
+    g_enable_qual_specialization = orig;
+  };
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    for (const bool enable_specialization : {true, false}) {
+      g_enable_qual_specialization = enable_specialization;
+      // all rows pass
+      c("SELECT COUNT(*) FROM test WHERE y > 0;", dt);
+      c("SELECT COUNT(*) FROM test WHERE y >= 42 AND z < 200;", dt);
+      c("SELECT x, COUNT(*) FROM test WHERE t <= 1002 GROUP BY x ORDER BY x;", dt);
+      // some rows pass
+      c("SELECT COUNT(*) FROM test WHERE y > 42;", dt);
+      c("SELECT SUM(y) FROM test WHERE z + 1 > 102;", dt);
+      // columns with and without nulls
+      c("SELECT COUNT(*) FROM test WHERE y IS NULL;", dt);
+      c("SELECT COUNT(*) FROM test WHERE fn IS NULL OR fn > 0;", dt);
+      c("SELECT COUNT(*) FROM test WHERE y + fn > 0;", dt);
+    }
+  }
+}
+
+TEST(Select, LowTierJitPromotion) {
+  SKIP_ALL_ON_AGGREGATOR();
+  ScopeGuard reset = [orig_max_rows = g_jit_low_tier_max_rows,
+                      orig_promotion_count = g_jit_tier_promotion_count] {
+    g_jit_low_tier_max_rows = orig_max_rows;
+    g_jit_tier_promotion_count = orig_promotion_count;
+  };
+  g_jit_low_tier_max_rows = 10000;
+  g_jit_tier_promotion_count = 2;
+  // A query shape no other test compiles, over a table well below the row limit.
+  const std::string query{"SELECT COUNT(*) FROM test WHERE x * 7919 - y * 31 > 0;"};
+  const auto before = Executor::getJitTierCounts();
+  c(query, ExecutorDeviceType::CPU);
+  auto after = Executor::getJitTierCounts();
+  EXPECT_GE(after.low_tier_compilations, before.low_tier_compilations + 1);
+  EXPECT_EQ(after.promotions, before.promotions);
+  // The second cache hit promotes the code, the third run may use either tier.
+  for (int run = 0; run < 3; ++run) {
+    c(query, ExecutorDeviceType::CPU);
+  }
+  QR::get()->getExecutor()->waitForBackgroundCodegen();
+  after = Executor::getJitTierCounts();
+  EXPECT_EQ(after.promotions, before.promotions + 1);
+  EXPECT_EQ(after.background_replacements, before.background_replacements + 1);
+  EXPECT_EQ(after.background_failures, before.background_failures);
+  // The full tier code replaced the low tier entry and is not promoted again.
+  c(query, ExecutorDeviceType::CPU);
+  EXPECT_EQ(Executor::getJitTierCounts().promotions, before.promotions + 1);
+}
+
+TEST(Select, NullCheckElision) {
+  ScopeGuard reset = [orig = g_enable_null_check_elision] {
+    g_enable_null_check_elision = orig;
+  };
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    for (const bool enable_elision : {true, false}) {
+      g_enable_null_check_elision = enable_elision;
+      // y and z are nullable without nulls, fn and dn have nulls
+      c("SELECT SUM(y + z), MIN(y * 2), MAX(z - y) FROM test;", dt);
+      c("SELECT x, SUM(y + fn), COUNT(dn) FROM test GROUP BY x ORDER BY x;", dt);
+      c("SELECT y + z, fn FROM test WHERE y > z - 100 ORDER BY y, z, fn;", dt);
+      c("SELECT COUNT(*) FROM test WHERE y IS NOT NULL AND fn IS NULL;", dt);
+      c("SELECT a.y + b.y FROM test a LEFT JOIN test_inner b ON a.x = b.x ORDER BY 1;",
+        dt);
+    }
+  }
+}
+
+namespace {
+
+void drop_zone_map_test() {
+  const std::string drop_ddl{"DROP TABLE IF EXISTS zone_map_test;"};
+  run_ddl_statement(drop_ddl);
+  g_sqlite_comparator.query(drop_ddl);
+}
+
+// (Re-)creates zone_map_test with its rows in key order, so that each block of 4 rows
+// holds a short range of i and b and a single string of s, or nulls. The encoders build
+// the zone maps and dictionary indexes of the loaded chunks from the flags in effect.
+void create_zone_map_test(const size_t fragment_size) {
+  drop_zone_map_test();
+  run_ddl_statement(
+      "CREATE TABLE zone_map_test (i INT, b BIGINT, s TEXT ENCODING DICT(32), s2 TEXT "
+      "ENCODING DICT(32)) WITH (fragment_size=" +
+      std::to_string(fragment_size) + ");");
+  g_sqlite_comparator.query(
+      "CREATE TABLE zone_map_test (i INT, b BIGINT, s TEXT, s2 TEXT);");
+  for (int r = 0; r < 40; ++r) {
+    const auto i = r % 10 == 7 ? std::string("NULL") : std::to_string(r);
+    const auto s =
+        r % 9 == 4 ? std::string("NULL") : "'str" + std::to_string(r / 8) + "'";
+    const auto insert_query = "INSERT INTO zone_map_test VALUES(" + i + ", " +
+                              std::to_string(r * 3 - 50) + ", " + s + ", 'v" +
+                              std::to_string(r % 3) + "');";
+    run_multiple_agg(insert_query, ExecutorDeviceType::CPU);
+    g_sqlite_comparator.query(insert_query);
+  }
+}
+
+}  // namespace
+
+TEST(Select, ZoneMapBlockRowTrimming) {
+  ScopeGuard reset = [orig_block_rows = g_zone_map_block_rows] {
+    g_zone_map_block_rows = orig_block_rows;
+    drop_zone_map_test();
+  };
+  // Without zone maps, with zone maps over a single fragment, whose CPU scan also starts
+  // at the first candidate block, and with zone maps over fragments of 16 rows.
+  for (const auto& [block_rows, fragment_size] :
+       std::vector<std::pair<size_t, size_t>>{{0, 64}, {4, 64}, {4, 16}}) {
+    g_zone_map_block_rows = block_rows;
+    create_zone_map_test(fragment_size);
+    for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+      SKIP_NO_GPU();
+      c("SELECT COUNT(*), SUM(b) FROM zone_map_test WHERE i BETWEEN 10 AND 13;", dt);
+      c("SELECT COUNT(*), MIN(i) FROM zone_map_test WHERE i > 33;", dt);
+      c("SELECT COUNT(*) FROM zone_map_test WHERE i < 3;", dt);
+      c("SELECT COUNT(*) FROM zone_map_test WHERE i >= 100;", dt);
+      c("SELECT COUNT(*) FROM zone_map_test WHERE i > 5 AND i < 2;", dt);
+      c("SELECT i, b FROM zone_map_test WHERE i >= 30 AND i < 36 ORDER BY i;", dt);
+      c("SELECT COUNT(*), SUM(i) FROM zone_map_test WHERE b > 40;", dt);
+      c("SELECT b FROM zone_map_test WHERE i = 21;", dt);
+      // the row of key 17 holds a null
+      c("SELECT COUNT(*) FROM zone_map_test WHERE i = 17;", dt);
+      c("SELECT SUM(b) FROM zone_map_test WHERE i IN (2, 30, 31);", dt);
+      c("SELECT COUNT(*), SUM(b) FROM zone_map_test WHERE i IS NULL;", dt);
+      c("SELECT COUNT(*) FROM zone_map_test WHERE i IS NOT NULL AND i < 5;", dt);
+    }
+  }
+}
+
+TEST(Select, DictionaryIndexBlockSkipping) {
+  ScopeGuard reset = [orig_block_rows = g_zone_map_block_rows,
+                      orig_max_block_values = g_dictionary_index_max_block_values] {
+    g_zone_map_block_rows = orig_block_rows;
+    g_dictionary_index_max_block_values = orig_max_block_values;
+    drop_zone_map_test();
+  };
+  // Without dictionary indexes, and with indexes of at most 2 ids per block over one
+  // fragment and over fragments of 16 rows. The blocks of s2 hold 3 strings each and go
+  // unindexed.
+  for (const auto& [block_rows, max_block_values, fragment_size] :
+       std::vector<std::tuple<size_t, size_t, size_t>>{
+           {0, 0, 64}, {4, 2, 64}, {4, 2, 16}}) {
+    g_zone_map_block_rows = block_rows;
+    g_dictionary_index_max_block_values = max_block_values;
+    create_zone_map_test(fragment_size);
+    for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+      SKIP_NO_GPU();
+      c("SELECT COUNT(*), SUM(i) FROM zone_map_test WHERE s = 'str2';", dt);
+      c("SELECT b FROM zone_map_test WHERE s = 'str3' ORDER BY b;", dt);
+      c("SELECT COUNT(*), SUM(b) FROM zone_map_test WHERE s IN ('str0', 'str4');", dt);
+      c("SELECT s, COUNT(*) FROM zone_map_test WHERE s IN ('str1', 'str3') GROUP BY s "
+        "ORDER BY s;",
+        dt);
+      // strings missing from the dictionary rule out every block
+      c("SELECT COUNT(*) FROM zone_map_test WHERE s = 'missing';", dt);
+      c("SELECT COUNT(*), SUM(b) FROM zone_map_test WHERE s IN ('missing', 'str3');",
+        dt);
+      c("SELECT COUNT(*), SUM(b) FROM zone_map_test WHERE s IS NULL;", dt);
+      c("SELECT COUNT(*) FROM zone_map_test WHERE s = 'str1' AND i > 10;", dt);
+      c("SELECT COUNT(*) FROM zone_map_test WHERE s = 'str1' AND i IS NULL;", dt);
+      c("SELECT COUNT(*), SUM(b) FROM zone_map_test WHERE s2 = 'v1';", dt);
+      c("SELECT COUNT(*) FROM zone_map_test WHERE s2 IN ('v0', 'v2') AND s = 'str4';",
+        dt);
+    }
+  }
+}
+
 TEST(Select, FilterAndSimpleAggregation) {
   for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
     SKIP_NO_GPU();
@@ -1296,6 +1503,10 @@ TEST(Select, FilterAndSimpleAggregation) {
         static_cast<double>(0.2));
     c("SELECT COUNT(*) FROM test WHERE d = 2.2", dt);
     c("SELECT COUNT(*) FROM test WHERE fx + 1 IS NULL;", dt);
+    c("SELECT COUNT(*) FROM test WHERE fx = 9;", dt);
+    c("SELECT COUNT(*) FROM test WHERE fx >= 10;", dt);
+    c("SELECT COUNT(*) FROM test WHERE fx < 100000;", dt);
+    c("SELECT COUNT(*) FROM test WHERE fx <> -32767;", dt);
     c("SELECT COUNT(ss) FROM test;", dt);
     c("SELECT COUNT(*) FROM test WHERE null IS NULL;", dt);
     c("SELECT COUNT(*) FROM test WHERE null_str IS NULL;", dt);
@@ -1461,6 +1672,85 @@ TEST(Select, FilterAndSimpleAggregation) {
   }
 }
 
+TEST(Select, ChunkPrefetch) {
+  const auto drop_table = [] {
+    const std::string drop_ddl{"DROP TABLE IF EXISTS chunk_prefetch_test;"};
+    run_ddl_statement(drop_ddl);
+    g_sqlite_comparator.query(drop_ddl);
+  };
+  drop_table();
+  ScopeGuard cleanup = [&drop_table, orig_depth = g_chunk_prefetch_depth] {
+    g_chunk_prefetch_depth = orig_depth;
+    drop_table();
+  };
+  run_ddl_statement(
+      "CREATE TABLE chunk_prefetch_test (x INT, s TEXT ENCODING NONE) WITH "
+      "(fragment_size=2);");
+  g_sqlite_comparator.query("CREATE TABLE chunk_prefetch_test (x INT, s TEXT);");
+  // many more fragments, and thereby kernels, than workers
+  const int row_count = 4 * cpu_threads() + 2;
+  for (int i = 0; i < row_count; ++i) {
+    const auto insert_query = "INSERT INTO chunk_prefetch_test VALUES(" +
+                              std::to_string(i) + ", 'str" + std::to_string(i % 3) +
+                              "');";
+    run_multiple_agg(insert_query, ExecutorDeviceType::CPU);
+    g_sqlite_comparator.query(insert_query);
+  }
+  for (const size_t depth : {size_t(0), size_t(1), size_t(4)}) {
+    g_chunk_prefetch_depth = depth;
+    for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+      SKIP_NO_GPU();
+      QR::get()->clearCpuMemory();
+      c("SELECT SUM(x) FROM chunk_prefetch_test;", dt);
+      QR::get()->clearCpuMemory();
+      c("SELECT COUNT(*) FROM chunk_prefetch_test WHERE s = 'str1';", dt);
+      c("SELECT x, s FROM chunk_prefetch_test WHERE x > 3 ORDER BY x;", dt);
+    }
+  }
+}
+
+TEST(Select, SharedScan) {
+  const auto drop_table = [] {
+    const std::string drop_ddl{"DROP TABLE IF EXISTS shared_scan_test;"};
+    run_ddl_statement(drop_ddl);
+    g_sqlite_comparator.query(drop_ddl);
+  };
+  drop_table();
+  ScopeGuard cleanup = [&drop_table, orig_shared_scans = g_enable_shared_scans] {
+    g_enable_shared_scans = orig_shared_scans;
+    drop_table();
+  };
+  run_ddl_statement("CREATE TABLE shared_scan_test (x INT) WITH (fragment_size=2);");
+  g_sqlite_comparator.query("CREATE TABLE shared_scan_test (x INT);");
+  for (int i = 0; i < 10; ++i) {
+    const auto insert_query = "INSERT INTO shared_scan_test VALUES(" + std::to_string(i) +
+                              ");";
+    run_multiple_agg(insert_query, ExecutorDeviceType::CPU);
+    g_sqlite_comparator.query(insert_query);
+  }
+  const auto& cat = QR::get()->getSession()->getCatalog();
+  const auto td = cat.getMetadataForTable("shared_scan_test");
+  CHECK(td);
+  g_enable_shared_scans = true;
+  {
+    // A scan of the table in flight at the middle fragment, which queries attach to.
+    auto running_scan = SharedScan::attach(cat.getCurrentDB().dbId, td->tableId);
+    EXPECT_EQ(running_scan->getStartFragmentId(), -1);
+    running_scan->fragmentStarted(2);
+    EXPECT_EQ(
+        SharedScan::attach(cat.getCurrentDB().dbId, td->tableId)->getStartFragmentId(),
+        2);
+    for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+      SKIP_NO_GPU();
+      c("SELECT SUM(x) FROM shared_scan_test;", dt);
+      c("SELECT COUNT(*) FROM shared_scan_test WHERE x > 3;", dt);
+      c("SELECT x FROM shared_scan_test WHERE x % 2 = 0 ORDER BY x;", dt);
+    }
+    EXPECT_EQ(SharedScan::getActiveScanCount(), size_t(1));
+  }
+  EXPECT_EQ(SharedScan::getActiveScanCount(), size_t(0));
+}
+
 TEST(Select, AggregateOnEmptyDecimalColumn) {
   for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
     SKIP_NO_GPU();
@@ -1734,6 +2024,10 @@ TEST(Select, InValues) {
     c(R"(SELECT y FROM test WHERE y IN (43, 44, 45, 46, 47, 48, 49) GROUP BY y ORDER BY y;)",
       dt);
     c(R"(SELECT t FROM test WHERE t NOT IN (NULL) GROUP BY t ORDER BY t;)", dt);
+    // too sparse for a bitmap, uses a sorted set
+    c(R"(SELECT x FROM test WHERE x IN (7, 9, 1000000, -2000000000, 2000000000) GROUP BY x ORDER BY x;)",
+      dt);
+    c(R"(SELECT COUNT(*) FROM test WHERE x NOT IN (8, -2000000000, 2000000000);)", dt);
     c(R"(SELECT t FROM test WHERE t NOT IN (1001, 1003, 1005, 1007, 1009, -10) GROUP BY t ORDER BY t;)",
       dt);
     c(R"(WITH dimensionValues AS (SELECT b FROM test GROUP BY b ORDER BY b) SELECT x FROM test WHERE b in (SELECT b FROM dimensionValues) GROUP BY x ORDER BY x;)",
@@ -1858,6 +2152,97 @@ TEST(Select, FilterAndGroupBy) {
   }
 }
 
+TEST(Select, GroupByMemoryBudget) {
+  ScopeGuard reset = [orig_budget = g_query_cpu_memory_budget] {
+    g_query_cpu_memory_budget = orig_budget;
+  };
+  // A budget of one byte is over at the first output buffer of a step, even for the
+  // partitions of a group by, so the steps degrade to the retry without a budget. The
+  // partitioned group by is tested in PartitionedGroupByRetry.
+  g_query_cpu_memory_budget = 1;
+  const std::vector<std::string> queries{
+      "SELECT x, COUNT(*) FROM test GROUP BY x ORDER BY x;",
+      "SELECT y, SUM(x), MAX(z) FROM test GROUP BY y ORDER BY y;",
+      "SELECT x, COUNT(DISTINCT y) AS n FROM test GROUP BY x ORDER BY x;",
+      "SELECT str, COUNT(*) FROM test GROUP BY str ORDER BY str;",
+      "SELECT COUNT(*) FROM test WHERE x > 7;"};
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    for (const auto& query : queries) {
+      const auto partitioned_count = RelAlgExecutor::getPartitionedGroupByCount();
+      const auto retry_count = RelAlgExecutor::getOutOfMemoryRetryCount();
+      c(query, dt);
+      if (dt == ExecutorDeviceType::CPU) {
+        EXPECT_GT(RelAlgExecutor::getOutOfMemoryRetryCount(), retry_count) << query;
+        EXPECT_EQ(RelAlgExecutor::getPartitionedGroupByCount(), partitioned_count)
+            << query;
+      }
+    }
+  }
+}
+
+TEST(Select, PartitionedGroupByRetry) {
+  const std::string drop_ddl{"DROP TABLE IF EXISTS partitioned_group_by_test;"};
+  run_ddl_statement(drop_ddl);
+  ScopeGuard reset = [&drop_ddl,
+                      orig_budget = g_query_cpu_memory_budget,
+                      orig_partitioned = g_enable_partitioned_group_by] {
+    g_query_cpu_memory_budget = orig_budget;
+    g_enable_partitioned_group_by = orig_partitioned;
+    run_ddl_statement(drop_ddl);
+  };
+  run_ddl_statement("CREATE TABLE partitioned_group_by_test (k BIGINT, g INT, v INT);");
+  // k spans 10000 values, its perfect hash group by buffer is over the budget below
+  // while the buffer of a partition fits in it. The single fragment makes for a single
+  // buffer per pass.
+  for (int r = 0; r < 512; ++r) {
+    const auto k = r % 17 == 3 ? std::string("NULL") : std::to_string(r * 7919 % 10000);
+    const auto val = r % 13 == 0 ? std::string("NULL") : std::to_string(r % 11);
+    run_multiple_agg("INSERT INTO partitioned_group_by_test VALUES(" + k + ", " +
+                         std::to_string(r % 5) + ", " + val + ");",
+                     ExecutorDeviceType::CPU);
+  }
+  auto get_rows = [](const std::string& query, const ExecutorDeviceType dt) {
+    std::vector<std::vector<int64_t>> rows;
+    const auto result = run_multiple_agg(query, dt);
+    for (auto row = result->getNextRow(true, true); !row.empty();
+         row = result->getNextRow(true, true)) {
+      std::vector<int64_t> values;
+      for (const auto& value : row) {
+        values.push_back(v<int64_t>(value));
+      }
+      rows.push_back(values);
+    }
+    return rows;
+  };
+  const std::vector<std::string> queries{
+      "SELECT k, COUNT(*), SUM(v) FROM partitioned_group_by_test GROUP BY k ORDER BY k;",
+      "SELECT k, g, MAX(v) FROM partitioned_group_by_test GROUP BY k, g ORDER BY k, g;",
+      "SELECT k, COUNT(DISTINCT v) FROM partitioned_group_by_test WHERE g > 0 GROUP BY "
+      "k ORDER BY k;",
+      "SELECT COUNT(*) FROM (SELECT k, COUNT(*) AS n FROM partitioned_group_by_test "
+      "GROUP BY k) WHERE n > 1;"};
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    for (const auto& query : queries) {
+      g_query_cpu_memory_budget = 0;
+      const auto expected_rows = get_rows(query, dt);
+      // The group by runs out of the budget and is retried in partitions, which fit the
+      // budget, without the retry that drops the budget.
+      g_query_cpu_memory_budget = 64 * 1024;
+      g_enable_partitioned_group_by = true;
+      const auto partitioned_count = RelAlgExecutor::getPartitionedGroupByCount();
+      const auto retry_count = RelAlgExecutor::getOutOfMemoryRetryCount();
+      EXPECT_EQ(expected_rows, get_rows(query, dt)) << query;
+      if (dt == ExecutorDeviceType::CPU) {
+        EXPECT_GT(RelAlgExecutor::getPartitionedGroupByCount(), partitioned_count)
+            << query;
+        EXPECT_EQ(RelAlgExecutor::getOutOfMemoryRetryCount(), retry_count) << query;
+      }
+    }
+  }
+}
+
 TEST(Select, GroupByBoundariesAndNull) {
   for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
     SKIP_NO_GPU();
@@ -2370,6 +2755,23 @@ TEST(Select, CountDistinct) {
   }
 }
 
+TEST(Select, CountDistinctSparseBitmap) {
+  const ExecutorDeviceType dt = ExecutorDeviceType::CPU;
+  ScopeGuard reset = [orig = g_enable_count_distinct_sparse_bitmap] {
+    g_enable_count_distinct_sparse_bitmap = orig;
+  };
+  for (const bool enable_sparse_bitmap : {true, false}) {
+    g_enable_count_distinct_sparse_bitmap = enable_sparse_bitmap;
+    c("SELECT COUNT(distinct x * (50000 - 1)) FROM test;", dt);
+    c("SELECT COUNT(distinct x * 1000000 + y) FROM test;", dt);
+    c("SELECT y, COUNT(distinct x * 1000000 + z) AS n FROM test GROUP BY y ORDER BY y;",
+      dt);
+    c("SELECT COUNT(distinct t), COUNT(distinct ofq), COUNT(distinct ufq) FROM test;",
+      dt);
+    c("SELECT z, COUNT(distinct ofq) FROM test GROUP BY z ORDER BY z;", dt);
+  }
+}
+
 TEST(Select, ApproxCountDistinct) {
   for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
     SKIP_NO_GPU();
@@ -2747,6 +3149,7 @@ TEST(Select, ScanNoAggregation) {
 TEST(Select, OrderBy) {
   for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
     SKIP_NO_GPU();
+    c("SELECT x, w, z, t FROM test ORDER BY x, w, z, t;", dt);
     const auto rows = run_multiple_agg(
         "SELECT x, y, z + t, x * y AS m FROM test ORDER BY 3 desc LIMIT 5;", dt);
     CHECK_EQ(rows->rowCount(), std::min(size_t(5), static_cast<size_t>(g_num_rows)) + 0);
@@ -2895,6 +3298,17 @@ TEST(Select, TopKHeap) {
   }
 }
 
+TEST(Select, TopKHeapOverStreamingMax) {
+  ScopeGuard reset = [orig = g_streaming_topn_max] { g_streaming_topn_max = orig; };
+  // an offset + limit over the max sorts the whole projection instead
+  g_streaming_topn_max = 1;
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    c("SELECT str, x FROM proj_top ORDER BY x DESC LIMIT 1;", dt);
+    c("SELECT str, x FROM proj_top ORDER BY x DESC LIMIT 2;", dt);
+  }
+}
+
 TEST(Select, ComplexQueries) {
   for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
     SKIP_NO_GPU();
@@ -3381,6 +3795,19 @@ TEST(Select, Strings) {
               v<int64_t>(run_simple_agg(
                   "SELECT COUNT(*) FROM test WHERE str REGEXP 'ba.' or str REGEXP 'fo.';",
                   dt)));
+    ASSERT_EQ(static_cast<int64_t>(g_num_rows),
+              v<int64_t>(run_simple_agg(
+                  "SELECT COUNT(*) FROM test WHERE real_str REGEXP 'real_foo';", dt)));
+    ASSERT_EQ(static_cast<int64_t>(g_num_rows),
+              v<int64_t>(run_simple_agg(
+                  "SELECT COUNT(*) FROM test WHERE real_str REGEXP 'real_ba.';", dt)));
+    ASSERT_EQ(static_cast<int64_t>(g_num_rows / 2),
+              v<int64_t>(run_simple_agg(
+                  "SELECT COUNT(*) FROM test WHERE real_str REGEXP '^real_bar?z';", dt)));
+    ASSERT_EQ(static_cast<int64_t>(2 * g_num_rows),
+              v<int64_t>(run_simple_agg(
+                  "SELECT COUNT(*) FROM test WHERE real_str REGEXP 'real_foo|.*ba.';",
+                  dt)));
     EXPECT_ANY_THROW(run_simple_agg("SELECT LENGTH(NULL) FROM test;", dt));
   }
 }
@@ -5243,6 +5670,17 @@ TEST(Select, Time) {
                                   "test WHERE (m >= TIMESTAMP(3) '1970-01-01 "
                                   "00:00:00.000') GROUP BY key0 ORDER BY key0 LIMIT 1;",
                                   dt)));
+    // all the values of m are in December 2014
+    ASSERT_EQ(static_cast<int64_t>(2 * g_num_rows),
+              v<int64_t>(run_simple_agg("SELECT COUNT(*) FROM test WHERE "
+                                        "date_trunc(month, m) = TIMESTAMP(0) '2014-12-01 "
+                                        "00:00:00';",
+                                        dt)));
+    ASSERT_EQ(static_cast<int64_t>(g_num_rows + g_num_rows / 2),
+              v<int64_t>(run_simple_agg("SELECT COUNT(*) FROM test WHERE "
+                                        "date_trunc(day, m) = TIMESTAMP(0) '2014-12-13 "
+                                        "00:00:00';",
+                                        dt)));
   }
 }
 
@@ -7954,6 +8392,27 @@ TEST(Select, SpeculativeTopNSort) {
   }
 }
 
+TEST(Select, ParallelSort) {
+  ScopeGuard reset = [orig = g_parallel_sort_min] { g_parallel_sort_min = orig; };
+  size_t test_values[]{size_t(0), g_parallel_sort_min};
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    for (auto parallel_sort_min : test_values) {
+      g_parallel_sort_min = parallel_sort_min;
+      c("SELECT x, y, COUNT(*) AS val FROM gpu_sort_test GROUP BY x, y ORDER BY val "
+        "DESC, x, y;",
+        dt);
+      c("SELECT x, y, z, t FROM gpu_sort_test ORDER BY x DESC, y, z DESC, t;", dt);
+      c("SELECT x, y, str, COUNT(*) AS val FROM test GROUP BY x, y, str ORDER BY str "
+        "DESC, val, x, y;",
+        dt);
+      c("SELECT w, APPROX_COUNT_DISTINCT(x) acd FROM test GROUP BY w ORDER BY acd, w;",
+        "SELECT w, COUNT(DISTINCT x) acd FROM test GROUP BY w ORDER BY acd, w;",
+        dt);
+    }
+  }
+}
+
 TEST(Select, GroupByPerfectHash) {
   const auto default_bigint_flag = g_bigint_count;
   ScopeGuard reset = [default_bigint_flag] { g_bigint_count = default_bigint_flag; };
@@ -8027,6 +8486,39 @@ TEST(Select, GroupByPerfectHash) {
   SKIP_ON_AGGREGATOR(run_test(true));
 }
 
+TEST(Select, GroupByPerfectHashLazyInit) {
+  const ExecutorDeviceType dt = ExecutorDeviceType::CPU;
+  ScopeGuard reset = [orig = g_enable_lazy_group_by_buffer_init] {
+    g_enable_lazy_group_by_buffer_init = orig;
+  };
+  for (const bool enable_lazy_init : {true, false}) {
+    g_enable_lazy_group_by_buffer_init = enable_lazy_init;
+    // a wide key range, with few groups hit, over a buffer of more than a megabyte
+    c("SELECT x * 200000 AS k, COUNT(*) FROM test GROUP BY k ORDER BY k;", dt);
+    c("SELECT x * 200000 + z AS k, COUNT(*), SUM(x) FROM test GROUP BY k ORDER BY k;",
+      dt);
+    c("SELECT x * 200000 AS k, COUNT(*), SUM(y) FROM test GROUP BY k ORDER BY k;", dt);
+  }
+}
+
+TEST(Select, SmallStepOnCpu) {
+  ScopeGuard reset = [orig = g_cpu_small_step_max_rows] {
+    g_cpu_small_step_max_rows = orig;
+  };
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    for (const size_t max_rows : {size_t(0), size_t(1), size_t(1000000)}) {
+      g_cpu_small_step_max_rows = max_rows;
+      c("SELECT COUNT(*) FROM test WHERE x > 7;", dt);
+      c("SELECT x, SUM(y) FROM test GROUP BY x ORDER BY x;", dt);
+      c("SELECT str, COUNT(*) FROM test GROUP BY str ORDER BY str;", dt);
+      c("SELECT a.x, COUNT(*) FROM test a JOIN test_inner b ON a.x = b.x GROUP BY a.x "
+        "ORDER BY a.x;",
+        dt);
+    }
+  }
+}
+
 TEST(Select, GroupByBaselineHash) {
   for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
     SKIP_NO_GPU();
@@ -8562,6 +9054,31 @@ TEST(Select, Subqueries) {
   }
 }
 
+TEST(Select, InSubqueriesAsSemiJoins) {
+  ScopeGuard reset = [orig = g_enable_in_subquery_semi_join] {
+    g_enable_in_subquery_semi_join = orig;
+  };
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    for (const bool enable_semi_join : {true, false}) {
+      g_enable_in_subquery_semi_join = enable_semi_join;
+      c("SELECT COUNT(*) FROM test WHERE x IN (SELECT x FROM join_test);", dt);
+      c("SELECT COUNT(*) FROM test WHERE x IN (SELECT x FROM test WHERE y > 42);", dt);
+      c("SELECT COUNT(*) FROM test WHERE y > 41 AND x IN (SELECT x FROM test GROUP BY "
+        "x);",
+        dt);
+      c("SELECT x, COUNT(*) FROM test WHERE x IN (SELECT x FROM test_inner) GROUP BY x "
+        "ORDER BY x;",
+        dt);
+      c("SELECT COUNT(*) FROM subquery_test WHERE x IN (SELECT x AS foobar FROM "
+        "subquery_test GROUP BY foobar);",
+        dt);
+      // not rewritten, the lhs is not an integer column
+      c("SELECT COUNT(*) FROM test WHERE f IN (SELECT DISTINCT f FROM test);", dt);
+    }
+  }
+}
+
 TEST(Select, Export_Via_Query_Having_Scalar_Subquery) {
   // EXPORT stmt needs "validation_query" to gather some info from the query
   // before doing the actual data export
@@ -8920,6 +9437,67 @@ TEST(Select, Joins_DifferentIntegerTypes) {
   }
 }
 
+TEST(Select, Joins_KeyRangeFragmentSkipping) {
+  const auto drop_tables = [] {
+    for (const auto& table : {"key_range_outer", "key_range_inner"}) {
+      const auto drop_ddl = std::string("DROP TABLE IF EXISTS ") + table + ";";
+      run_ddl_statement(drop_ddl);
+      g_sqlite_comparator.query(drop_ddl);
+    }
+  };
+  drop_tables();
+  ScopeGuard cleanup = [&drop_tables,
+                        orig_skipping = g_join_key_range_fragment_skipping] {
+    g_join_key_range_fragment_skipping = orig_skipping;
+    drop_tables();
+  };
+  run_ddl_statement(
+      "CREATE TABLE key_range_outer (k INT, v BIGINT) WITH (fragment_size=2);");
+  g_sqlite_comparator.query("CREATE TABLE key_range_outer (k INT, v BIGINT);");
+  run_ddl_statement("CREATE TABLE key_range_inner (k INT, w INT);");
+  g_sqlite_comparator.query("CREATE TABLE key_range_inner (k INT, w INT);");
+  // every outer fragment holds two consecutive keys, only the middle ones can match
+  for (int k = 0; k < 12; ++k) {
+    const auto insert_query = "INSERT INTO key_range_outer VALUES(" + std::to_string(k) +
+                              ", " + std::to_string(k * 10) + ");";
+    run_multiple_agg(insert_query, ExecutorDeviceType::CPU);
+    g_sqlite_comparator.query(insert_query);
+  }
+  for (int k = 5; k < 8; ++k) {
+    const auto insert_query = "INSERT INTO key_range_inner VALUES(" + std::to_string(k) +
+                              ", " + std::to_string(k) + ");";
+    run_multiple_agg(insert_query, ExecutorDeviceType::CPU);
+    g_sqlite_comparator.query(insert_query);
+  }
+
+  for (bool enable_skipping : {false, true}) {
+    g_join_key_range_fragment_skipping = enable_skipping;
+    for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+      SKIP_NO_GPU();
+      c("SELECT COUNT(*) FROM key_range_outer o, key_range_inner i WHERE o.k = i.k;", dt);
+      c("SELECT o.k, o.v, i.w FROM key_range_outer o JOIN key_range_inner i ON o.k = "
+        "i.k ORDER BY o.k;",
+        dt);
+      c("SELECT o.k, i.w FROM key_range_outer o LEFT JOIN key_range_inner i ON o.k = "
+        "i.k ORDER BY o.k;",
+        dt);
+      c("SELECT SUM(v) FROM key_range_outer WHERE k IN (SELECT k FROM "
+        "key_range_inner);",
+        dt);
+      c("SELECT COUNT(*) FROM key_range_outer WHERE k NOT IN (SELECT k FROM "
+        "key_range_inner);",
+        dt);
+      // outer keys which are expressions rather than columns derive no range
+      c("SELECT o.k, i.w FROM key_range_outer o JOIN key_range_inner i ON -(o.k - 12) "
+        "= i.k ORDER BY o.k;",
+        dt);
+      c("SELECT COUNT(*) FROM key_range_outer o JOIN key_range_inner i ON -(o.k + 1) = "
+        "i.k;",
+        dt);
+    }
+  }
+}
+
 TEST(Select, Joins_FilterPushDown) {
   auto default_flag = g_enable_filter_push_down;
   auto default_lower_frac = g_filter_push_down_low_frac;
@@ -8989,6 +9567,12 @@ TEST(Select, Joins_InnerJoin_TwoTables) {
     c("SELECT COUNT(*) from test a JOIN single_row_test b ON a.ofd = b.x;", dt);
     c("SELECT COUNT(*) FROM test JOIN test_inner ON test.x = test_inner.x;", dt);
     c("SELECT a.y, z FROM test a JOIN test_inner b ON a.x = b.x order by a.y;", dt);
+    c("SELECT a.w, a.z, a.t, b.y, b.xx FROM test a JOIN test_inner b ON a.x = b.x ORDER "
+      "BY a.w, a.z, a.t, b.y, b.xx;",
+      dt);
+    c("SELECT a.z, a.t, b.xx FROM test a JOIN test_inner b ON a.x = b.x ORDER BY a.t "
+      "DESC, a.z, b.xx LIMIT 5;",
+      dt);
     c("SELECT COUNT(*) FROM test a JOIN join_test b ON a.str = b.dup_str;", dt);
     THROW_ON_AGGREGATOR(
         c("SELECT COUNT(*) FROM test_inner_x a JOIN test_x b ON a.x = b.x;",
@@ -10265,6 +10849,10 @@ TEST(Select, Joins_MultiCompositeColumns) {
     c("SELECT a.z, b.str FROM test a JOIN test_inner b ON a.y = b.y AND a.x = b.x ORDER "
       "BY a.z, b.str;",
       dt);
+    // three key components, past the probes unrolled for the number of components
+    c("SELECT COUNT(*) FROM test a JOIN join_test b ON a.x = b.x AND a.y = b.y AND "
+      "a.str = b.str;",
+      dt);
     c("SELECT COUNT(*) FROM test a JOIN join_test b ON a.x = b.x AND a.y = b.x JOIN "
       "test_inner c ON a.x = c.x WHERE "
       "c.str <> 'foo';",
@@ -10480,6 +11068,27 @@ TEST(Select, Joins_OneOuterExpression) {
   }
 }
 
+TEST(Select, Joins_SparsePerfectHash) {
+  ScopeGuard reset = [orig_density = g_sparse_perfect_hash_min_density,
+                      orig_entries = g_sparse_perfect_hash_min_entries] {
+    g_sparse_perfect_hash_min_density = orig_density;
+    g_sparse_perfect_hash_min_entries = orig_entries;
+  };
+  g_sparse_perfect_hash_min_density = 0.001;
+  g_sparse_perfect_hash_min_entries = 0;
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    c("SELECT COUNT(*) FROM test, test_inner WHERE test.x = test_inner.x;", dt);
+    c("SELECT COUNT(*) FROM test, test_inner WHERE test.x - 1 = test_inner.x;", dt);
+    c("SELECT test_inner.x, COUNT(*) AS n FROM test, test_inner WHERE test.x = "
+      "test_inner.x GROUP BY test_inner.x ORDER BY test_inner.x;",
+      dt);
+    c("SELECT COUNT(*) FROM test LEFT JOIN test_inner ON test.x = test_inner.x;", dt);
+    c("SELECT COUNT(*) FROM test a, test b WHERE a.o = b.o;", dt);
+    c("SELECT COUNT(*) FROM test a, test b WHERE a.x = b.x;", dt);
+  }
+}
+
 TEST(Select, Joins_Subqueries) {
   if (g_enable_columnar_output) {
     // TODO(adb): fixup these tests under columnar
@@ -10701,6 +11310,131 @@ TEST(Select, Joins_Decimal) {
   }
 }
 
+TEST(Select, RangeJoin) {
+  const auto range_joins_state = g_enable_range_joins;
+  const auto trivial_join_loop_state = g_trivial_loop_join_threshold;
+  ScopeGuard reset = [&] {
+    g_enable_range_joins = range_joins_state;
+    g_trivial_loop_join_threshold = trivial_join_loop_state;
+  };
+  g_enable_range_joins = true;
+  if (!g_aggregator) {
+    // Disallow loop joins, the queries below must use a range join table.
+    g_trivial_loop_join_threshold = 1;
+  }
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    c("SELECT COUNT(*) FROM test a, test b WHERE b.y BETWEEN a.x AND a.x + 35;", dt);
+    c("SELECT COUNT(*) FROM test a, test b WHERE b.z >= a.y AND b.z < a.y + 60;", dt);
+    c("SELECT a.x, SUM(b.t) FROM test a, test b WHERE b.t > a.y * 20 AND b.t <= a.y * "
+      "30 GROUP BY a.x ORDER BY a.x;",
+      dt);
+    c("SELECT COUNT(*) FROM test a, test b WHERE ABS(a.y - b.y) < 1;", dt);
+    c("SELECT COUNT(*) FROM test a, test b WHERE ABS(b.dd - a.dd) <= 10.5;", dt);
+    c("SELECT COUNT(*) FROM test a, test b WHERE b.x <= a.y AND b.y >= a.y;", dt);
+    c("SELECT COUNT(*) FROM test a, test b WHERE b.x <= a.x AND b.y >= a.x AND "
+      "b.z <> a.z;",
+      dt);
+  }
+}
+
+TEST(Select, LoopJoinInnerTiles) {
+  const auto tile_bytes_state = g_loop_join_inner_tile_bytes;
+  ScopeGuard reset = [&] { g_loop_join_inner_tile_bytes = tile_bytes_state; };
+  // A few inner rows per tile, so the inner table is split into several tiles.
+  g_loop_join_inner_tile_bytes = 16;
+  const auto dt = ExecutorDeviceType::CPU;
+  c("SELECT COUNT(*), SUM(t1.x + t2.y) FROM test t1, test t2 WHERE t1.x < t2.y;", dt);
+  c("SELECT t1.x, COUNT(*) FROM test t1, test t2 WHERE t1.y > t2.x * 10 GROUP BY t1.x "
+    "ORDER BY t1.x;",
+    dt);
+  c("SELECT COUNT(*) FROM test t1 LEFT JOIN test t2 ON t1.x < t2.y;", dt);
+}
+
+TEST(Select, ClusteredJoinWindows) {
+  SKIP_ALL_ON_AGGREGATOR();
+  const auto drop_tables = [] {
+    run_ddl_statement("DROP TABLE IF EXISTS clustered_join_outer;");
+    run_ddl_statement("DROP TABLE IF EXISTS clustered_join_inner;");
+  };
+  drop_tables();
+  ScopeGuard reset = [&drop_tables,
+                      windows_state = g_enable_clustered_join_windows,
+                      window_rows_state = g_clustered_join_window_rows] {
+    g_enable_clustered_join_windows = windows_state;
+    g_clustered_join_window_rows = window_rows_state;
+    drop_tables();
+  };
+  run_ddl_statement(
+      "CREATE TABLE clustered_join_outer (k INT, v INT) WITH (fragment_size=4);");
+  run_ddl_statement(
+      "CREATE TABLE clustered_join_inner (k INT, w INT) WITH (fragment_size=4);");
+  // Both tables are loaded in key order, their fragments have disjoint key ranges. The
+  // even keys have two inner rows.
+  for (int i = 0; i < 32; ++i) {
+    run_multiple_agg("INSERT INTO clustered_join_outer VALUES(" + std::to_string(i) +
+                         ", " + std::to_string(10 * i) + ");",
+                     ExecutorDeviceType::CPU);
+    for (int j = 0; j < (i % 2 ? 1 : 2); ++j) {
+      run_multiple_agg("INSERT INTO clustered_join_inner VALUES(" + std::to_string(i) +
+                           ", " + std::to_string(i + j) + ");",
+                       ExecutorDeviceType::CPU);
+    }
+  }
+  const auto sorted_rows = [](const std::string& query, const ExecutorDeviceType dt) {
+    const auto rows = run_multiple_agg(query, dt);
+    std::vector<std::vector<int64_t>> sorted;
+    for (auto row = rows->getNextRow(true, true); !row.empty();
+         row = rows->getNextRow(true, true)) {
+      std::vector<int64_t> values;
+      for (const auto& value : row) {
+        values.push_back(v<int64_t>(value));
+      }
+      sorted.push_back(values);
+    }
+    std::sort(sorted.begin(), sorted.end());
+    return sorted;
+  };
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    for (const std::string query :
+         {"SELECT a.k, a.v, b.w FROM clustered_join_outer a JOIN clustered_join_inner b "
+          "ON a.k = b.k;",
+          "SELECT a.v, b.w FROM clustered_join_outer a, clustered_join_inner b WHERE "
+          "b.k = a.k AND a.v > 75 AND b.w < 29;"}) {
+      g_enable_clustered_join_windows = false;
+      const auto expected = sorted_rows(query, dt);
+      g_enable_clustered_join_windows = true;
+      g_clustered_join_window_rows = 8;
+      EXPECT_EQ(sorted_rows(query, dt), expected);
+      g_clustered_join_window_rows = 1;
+      EXPECT_EQ(sorted_rows(query, dt), expected);
+    }
+  }
+}
+
+TEST(Select, ApproxTopKGroupBy) {
+  SKIP_ALL_ON_AGGREGATOR();
+  ScopeGuard reset = [top_k_state = g_enable_approx_top_k_group_by,
+                      sketch_factor_state = g_approx_top_k_sketch_factor] {
+    g_enable_approx_top_k_group_by = top_k_state;
+    g_approx_top_k_sketch_factor = sketch_factor_state;
+  };
+  g_enable_approx_top_k_group_by = true;
+  // Enough counters for the three values of z, fewer than its range.
+  g_approx_top_k_sketch_factor = 3;
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    c("SELECT z, COUNT(*) AS n FROM test GROUP BY z ORDER BY n DESC, z LIMIT 1;", dt);
+    c("SELECT z, COUNT(*) AS n, SUM(x) FROM test WHERE y > 42 GROUP BY z ORDER BY n "
+      "DESC, z LIMIT 2;",
+      dt);
+    c("SELECT z, COUNT(*) AS n FROM test GROUP BY z ORDER BY n DESC, z LIMIT 1 OFFSET "
+      "1;",
+      dt);
+  }
+}
+
 TEST(Select, RuntimeFunctions) {
   for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
     SKIP_NO_GPU();
@@ -11005,6 +11739,22 @@ TEST(Select, ArrowOutput) {
   }
 }
 
+TEST(Select, ArrowOutputColumnar) {
+  SKIP_ALL_ON_AGGREGATOR();
+
+  // Columnar projections are converted straight from the result set buffers.
+  ScopeGuard reset_columnar_output = [orig = g_enable_columnar_output] {
+    g_enable_columnar_output = orig;
+  };
+  g_enable_columnar_output = true;
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    c_arrow("SELECT x, y, w, z, t, f, d, fn, dn, smallint_nulls from test", dt);
+    c_arrow("SELECT m, m_3, m_6, m_9, n from test", dt);
+    c_arrow("SELECT o, o1, o2 from test", dt);
+  }
+}
+
 TEST(Select, WatchdogTest) {
   const auto watchdog_state = g_enable_watchdog;
   g_enable_watchdog = true;
@@ -11050,6 +11800,30 @@ TEST(Select, PuntToCPU) {
       "SELECT COUNT(*) FROM test WHERE x IN (SELECT y FROM test WHERE y > 3);", dt));
 }
 
+TEST(Select, PuntProjectionToCpuAndGpu) {
+  SKIP_ALL_ON_AGGREGATOR();
+
+  ScopeGuard reset_global_flag_state = [orig = g_enable_cpu_gpu_projection] {
+    g_enable_cpu_gpu_projection = orig;
+    g_gpu_mem_limit_percent = 0.9;  // Reset to 90%
+  };
+
+  const auto dt = ExecutorDeviceType::GPU;
+  if (skip_tests(dt)) {
+    return;
+  }
+
+  g_enable_cpu_gpu_projection = true;
+  const auto expected_row_count = v<int64_t>(
+      run_simple_agg("SELECT COUNT(*) FROM test WHERE y > 0;", ExecutorDeviceType::CPU));
+  // load the inputs on GPU first, then force the projection off the GPU
+  EXPECT_EQ(run_multiple_agg("SELECT x, y, str FROM test WHERE y > 0;", dt)->rowCount(),
+            static_cast<size_t>(expected_row_count));
+  g_gpu_mem_limit_percent = 1e-10;
+  EXPECT_EQ(run_multiple_agg("SELECT x, y, str FROM test WHERE y > 0;", dt)->rowCount(),
+            static_cast<size_t>(expected_row_count));
+}
+
 TEST(Select, TimestampMeridiesEncoding) {
   for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
     SKIP_NO_GPU();
@@ -15693,6 +16467,58 @@ TEST(Update, MultiColumnInteger) {
   }
 }
 
+TEST(Update, ConcurrentFragments) {
+  if (g_use_temporary_tables) {
+    LOG(ERROR) << "Test not supported for temporary tables.";
+    return;
+  }
+  const auto max_concurrent_update_fragments_state = g_max_concurrent_update_fragments;
+  ScopeGuard reset_state = [max_concurrent_update_fragments_state] {
+    g_max_concurrent_update_fragments = max_concurrent_update_fragments_state;
+    run_ddl_statement("DROP TABLE IF EXISTS concurrent_updates;");
+  };
+  const auto dt = ExecutorDeviceType::CPU;
+  for (const size_t max_concurrent_fragments : {1, 3}) {
+    g_max_concurrent_update_fragments = max_concurrent_fragments;
+    run_ddl_statement("DROP TABLE IF EXISTS concurrent_updates;");
+    run_ddl_statement(build_create_table_statement("x integer, y double, s text",
+                                                   "concurrent_updates",
+                                                   {"", 0},
+                                                   {},
+                                                   2,
+                                                   g_use_temporary_tables,
+                                                   true,
+                                                   false));
+    for (int i = 0; i < 20; ++i) {
+      run_multiple_agg("INSERT INTO concurrent_updates VALUES (" + std::to_string(i) +
+                           ", " + std::to_string(i) + ".5, 'str" +
+                           std::to_string(i % 3) + "');",
+                       dt);
+    }
+
+    run_multiple_agg(
+        "UPDATE concurrent_updates SET x = x * 2, y = y + 1, s = 'odd' WHERE MOD(x, 2) "
+        "= 1;",
+        dt);
+    ASSERT_EQ(int64_t(90 + 2 * 100),
+              v<int64_t>(run_simple_agg("SELECT SUM(x) FROM concurrent_updates;", dt)));
+    ASSERT_DOUBLE_EQ(double(200 + 10),
+                     v<double>(run_simple_agg("SELECT SUM(y) FROM concurrent_updates;",
+                                              dt)));
+    ASSERT_EQ(int64_t(10),
+              v<int64_t>(run_simple_agg(
+                  "SELECT COUNT(*) FROM concurrent_updates WHERE s = 'odd';", dt)));
+    ASSERT_EQ(int64_t(38),
+              v<int64_t>(run_simple_agg("SELECT MAX(x) FROM concurrent_updates;", dt)));
+
+    run_multiple_agg("DELETE FROM concurrent_updates WHERE s = 'odd';", dt);
+    ASSERT_EQ(int64_t(10),
+              v<int64_t>(run_simple_agg("SELECT COUNT(*) FROM concurrent_updates;", dt)));
+    ASSERT_EQ(int64_t(90),
+              v<int64_t>(run_simple_agg("SELECT SUM(x) FROM concurrent_updates;", dt)));
+  }
+}
+
 TEST(Update, TimestampUpdate) {
   for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
     SKIP_NO_GPU();
@@ -17636,6 +18462,51 @@ TEST(Delete, MultiDelete) {
   }
 }
 
+TEST(Delete, FragmentsWithoutDeletedRows) {
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+
+    run_ddl_statement("DROP TABLE IF EXISTS partial_delete;");
+    run_ddl_statement(build_create_table_statement("x int, str text",
+                                                   "partial_delete",
+                                                   {"", 0},
+                                                   {},
+                                                   2,
+                                                   g_use_temporary_tables,
+                                                   true,
+                                                   false));
+    ScopeGuard drop_table = [] {
+      run_ddl_statement("DROP TABLE IF EXISTS partial_delete;");
+    };
+
+    for (int i = 1; i <= 6; ++i) {
+      run_multiple_agg("INSERT INTO partial_delete VALUES (" + std::to_string(i) +
+                           ", 'str" + std::to_string(i) + "');",
+                       ExecutorDeviceType::CPU);
+    }
+
+    // Only the second of the three fragments has a deleted row, the others are scanned
+    // without their deleted column.
+    run_multiple_agg("DELETE FROM partial_delete WHERE x = 3;", dt);
+    EXPECT_EQ(18, v<int64_t>(run_simple_agg("SELECT SUM(x) FROM partial_delete;", dt)));
+    EXPECT_EQ(int64_t(5),
+              v<int64_t>(run_simple_agg("SELECT COUNT(*) FROM partial_delete;", dt)));
+    EXPECT_EQ(int64_t(2),
+              v<int64_t>(run_simple_agg(
+                  "SELECT COUNT(*) FROM partial_delete WHERE x BETWEEN 2 AND 4;", dt)));
+
+    // Varlen updates delete the updated rows and append them to the last fragment.
+    run_multiple_agg("UPDATE partial_delete SET str = 'updated' WHERE x = 5;", dt);
+    EXPECT_EQ(18, v<int64_t>(run_simple_agg("SELECT SUM(x) FROM partial_delete;", dt)));
+    EXPECT_EQ(int64_t(1),
+              v<int64_t>(run_simple_agg(
+                  "SELECT COUNT(*) FROM partial_delete WHERE str = 'updated';", dt)));
+    EXPECT_EQ(int64_t(0),
+              v<int64_t>(run_simple_agg(
+                  "SELECT COUNT(*) FROM partial_delete WHERE str = 'str5';", dt)));
+  }
+}
+
 TEST(Delete, Joins_ImplicitJoins) {
   for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
     SKIP_NO_GPU();
@@ -18853,6 +19724,65 @@ TEST(Select, WindowFunctionSum) {
   c(query + " NULLS FIRST;", query + ";", dt);
 }
 
+TEST(Select, WindowFunctionFramedAggregate) {
+  const ExecutorDeviceType dt = ExecutorDeviceType::CPU;
+  for (const std::string frame :
+       {"ROWS BETWEEN 2 PRECEDING AND 1 FOLLOWING",
+        "ROWS BETWEEN UNBOUNDED PRECEDING AND CURRENT ROW",
+        "ROWS BETWEEN 3 PRECEDING AND 1 PRECEDING",
+        "ROWS BETWEEN CURRENT ROW AND UNBOUNDED FOLLOWING"}) {
+    const std::string window = "(PARTITION BY y ORDER BY t ASC " + frame + ")";
+    c("SELECT t, SUM(x) OVER " + window + " s, AVG(x) OVER " + window +
+          " a, MIN(x) OVER " + window + " m1, MAX(x) OVER " + window +
+          " m2, COUNT(x) OVER " + window + " c1, COUNT(*) OVER " + window +
+          " c2, SUM(dd) OVER " + window + " s_dd, MIN(f) OVER " + window +
+          " m_f FROM test_window_func ORDER BY t ASC;",
+      dt);
+  }
+}
+
+TEST(Select, WindowFunctionParallelPartitions) {
+  const ExecutorDeviceType dt = ExecutorDeviceType::CPU;
+  ScopeGuard reset = [orig = g_parallel_window_partition_min] {
+    g_parallel_window_partition_min = orig;
+  };
+  // all the partitions sorted in parallel, then only the largest one
+  for (const size_t parallel_window_partition_min : {size_t(0), size_t(2)}) {
+    g_parallel_window_partition_min = parallel_window_partition_min;
+    c("SELECT x, y, ROW_NUMBER() OVER (PARTITION BY y ORDER BY x ASC) r1, RANK() OVER "
+      "(PARTITION BY y ORDER BY x ASC) r2, DENSE_RANK() OVER (PARTITION BY y ORDER BY x "
+      "DESC) r3 FROM test_window_func ORDER BY x ASC, y ASC, r1 ASC, r2 ASC, r3 ASC;",
+      dt);
+    {
+      std::string query =
+          "SELECT x, y, LAG(x) OVER (PARTITION BY y ORDER BY x ASC NULLS LAST) l FROM "
+          "test_window_func ORDER BY x ASC";
+      c(query + " NULLS FIRST, y ASC NULLS FIRST, l ASC NULLS FIRST;",
+        query + ", y ASC, l ASC;",
+        dt);
+    }
+    {
+      std::string query =
+          "SELECT t, SUM(x) OVER (PARTITION BY y ORDER BY t ASC) s, MIN(x) OVER "
+          "(PARTITION BY y ORDER BY t ASC) m, COUNT(x) OVER (PARTITION BY y ORDER BY t "
+          "ASC ROWS BETWEEN 1 PRECEDING AND 1 FOLLOWING) c FROM test_window_func "
+          "ORDER BY t ASC;";
+      c(query, dt);
+    }
+  }
+}
+
+TEST(Select, WindowFunctionSharedPartitions) {
+  const ExecutorDeviceType dt = ExecutorDeviceType::CPU;
+  // the window functions over (PARTITION BY y ORDER BY t ASC) share one sort
+  c("SELECT t, ROW_NUMBER() OVER (PARTITION BY y ORDER BY t ASC) r1, RANK() OVER "
+    "(PARTITION BY y ORDER BY t DESC) r2, SUM(x) OVER (PARTITION BY y ORDER BY t ASC) s, "
+    "COUNT(x) OVER (PARTITION BY y ORDER BY t ASC ROWS BETWEEN 1 PRECEDING AND CURRENT "
+    "ROW) c, DENSE_RANK() OVER (PARTITION BY y ORDER BY t ASC) r3, MAX(x) OVER "
+    "(PARTITION BY y ORDER BY t DESC) m FROM test_window_func ORDER BY t ASC;",
+    dt);
+}
+
 TEST(Select, WindowFunctionComplexExpressions) {
   const ExecutorDeviceType dt = ExecutorDeviceType::CPU;
   {
@@ -19384,6 +20314,57 @@ TEST(Select, UnionAll) {
   g_enable_union = enable_union;
 }
 
+// Uses tables from import_union_all_tests().
+TEST(Select, UnionAllParallelBranches) {
+  ScopeGuard reset = [orig_enable_union = g_enable_union,
+                      orig_max_branches = g_max_parallel_union_branches] {
+    g_enable_union = orig_enable_union;
+    g_max_parallel_union_branches = orig_max_branches;
+  };
+  g_enable_union = true;
+  for (auto dt : {ExecutorDeviceType::CPU /*, ExecutorDeviceType::GPU*/}) {
+    SKIP_NO_GPU();
+    for (const size_t max_branches : {size_t(2), size_t(3)}) {
+      g_max_parallel_union_branches = max_branches;
+      c("SELECT a0, a1, a2, a3 FROM union_all_a"
+        " WHERE a0 < 116"
+        " UNION ALL"
+        " SELECT b0, b1, b2, b3 FROM union_all_b"
+        " WHERE b0 < 216"
+        " ORDER BY a0;",
+        dt);
+      c("SELECT MAX(a0) max0, a1 % 3, MAX(a2), MAX(a3) FROM union_all_a"
+        " GROUP BY a1 % 3"
+        " UNION ALL"
+        " SELECT MAX(b0), b1 % 2, MAX(b2), MAX(b3) FROM union_all_b"
+        " GROUP BY b1 % 2"
+        " UNION ALL"
+        " SELECT a0, a1, a2, a3 FROM union_all_a"
+        " WHERE a0 < 116"
+        " ORDER BY max0;",
+        dt);
+      c("SELECT a0, a1, a2, a3 FROM union_all_a"
+        " WHERE a0 < 116"
+        " UNION ALL"
+        " SELECT b0, b1, b2, b3 FROM union_all_b"
+        " WHERE b0 < 215"
+        " UNION ALL"
+        " SELECT a0, a1, a2, a3 FROM union_all_a"
+        " WHERE a0 < 117"
+        " UNION ALL"
+        " SELECT MAX(b0), b1 % 3, MAX(b2), MAX(b3) FROM union_all_b"
+        " GROUP BY b1 % 3"
+        " ORDER BY a0;",
+        dt);
+      c("SELECT str FROM test"
+        " UNION ALL"
+        " SELECT COALESCE(shared_dict,'NULL') FROM test"
+        " ORDER BY str;",
+        dt);
+    }
+  }
+}
+
 TEST(Select, VariableLengthAggs) {
   for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
     SKIP_NO_GPU();
@@ -19484,6 +20465,47 @@ TEST(Select, Interop) {
   g_enable_interop = false;
 }
 
+TEST(Select, InteropInterpreter) {
+  SKIP_ALL_ON_AGGREGATOR();
+  g_enable_interop = true;
+  ScopeGuard reset_guard = [orig_enable_batch_interpreter = g_enable_batch_interpreter] {
+    g_enable_interop = false;
+    g_enable_batch_interpreter = orig_enable_batch_interpreter;
+  };
+  // The same projections through the batch interpreter and through SQLite.
+  for (const bool enable_batch_interpreter : {true, false}) {
+    g_enable_batch_interpreter = enable_batch_interpreter;
+    const auto dt = ExecutorDeviceType::CPU;
+    // Each query has one step run by the external executor.
+    auto expect_interpreted = [enable_batch_interpreter,
+                               step_count = get_interpreted_step_count()]() mutable {
+      const auto new_step_count = get_interpreted_step_count();
+      if (enable_batch_interpreter) {
+        EXPECT_GT(new_step_count, step_count);
+      } else {
+        EXPECT_EQ(new_step_count, step_count);
+      }
+      step_count = new_step_count;
+    };
+    c("SELECT x, substring(real_str, -3, 2) c1, substring(real_str, 2) c2 FROM test "
+      "ORDER BY x ASC, c1 ASC, c2 ASC;",
+      "SELECT x, substr(real_str, -3, 2) c1, substr(real_str, 2) c2 FROM test ORDER BY "
+      "x ASC, c1 ASC, c2 ASC;",
+      dt);
+    expect_interpreted();
+    c("SELECT str || '_' || real_str c1, CASE WHEN x > 7 THEN 'big' ELSE 'small' END "
+      "c2 FROM test WHERE y IN (42, 43) AND real_str || '' LIKE 'real_%' ORDER BY c1 "
+      "ASC, c2 ASC;",
+      dt);
+    expect_interpreted();
+    c("SELECT 'n_' || null_str c1, smallint_nulls + 1 c2, (x * 2 - y) / 3 c3 FROM "
+      "test WHERE (str || '') NOT LIKE '%z%' OR smallint_nulls IS NULL ORDER BY c1 "
+      "ASC, c2 ASC, c3 ASC;",
+      dt);
+    expect_interpreted();
+  }
+}
+
 // Test https://github.com/omnisci/omniscidb/issues/463
 TEST(Select, LeftJoinDictionaryGenerationIssue463) {
   for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
@@ -19760,6 +20782,36 @@ TEST(Select, ParseIntegerExceptions) {
   }
 }
 
+TEST(Select, QueryProfile) {
+  SKIP_ALL_ON_AGGREGATOR();
+  g_enable_query_profile = true;
+  ScopeGuard reset_query_profile = [] {
+    g_enable_query_profile = false;
+    QueryProfileHistory::instance().clear();
+  };
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    QueryProfileHistory::instance().clear();
+    const std::string query{"SELECT x, COUNT(*) FROM test GROUP BY x;"};
+    run_multiple_agg(query, dt);
+    const auto query_profiles = QueryProfileHistory::instance().get();
+    ASSERT_EQ(query_profiles.size(), size_t(1));
+    const auto& query_profile = query_profiles.front();
+    EXPECT_EQ(query_profile.query_str, query);
+    EXPECT_GT(query_profile.code_cache_hits + query_profile.code_cache_misses, size_t(0));
+    ASSERT_FALSE(query_profile.kernel_times.empty());
+    for (const auto& kernel_time : query_profile.kernel_times) {
+      EXPECT_EQ(kernel_time.device_type, dt);
+      EXPECT_GT(kernel_time.kernel_count, size_t(0));
+    }
+    const auto memory_level = dt == ExecutorDeviceType::GPU ? Data_Namespace::GPU_LEVEL
+                                                            : Data_Namespace::CPU_LEVEL;
+    EXPECT_GT(query_profile.fetched_bytes[memory_level], size_t(0));
+    ASSERT_EQ(query_profile.steps.size(), size_t(1));
+    EXPECT_EQ(query_profile.steps.front().row_count, size_t(2));
+  }
+}
+
 class SubqueryTestEnv : public ::testing::Test {
  protected:
   void SetUp() override {
@@ -21365,6 +22417,16 @@ int main(int argc, char** argv) {
                          ->default_value(g_use_tbb_pool)
                          ->implicit_value(true),
                      "Use TBB thread pool implementation for query dispatch.");
+  desc.add_options()("use-cpu-work-stealing",
+                     po::value<bool>(&g_enable_cpu_kernel_work_stealing)
+                         ->default_value(g_enable_cpu_kernel_work_stealing)
+                         ->implicit_value(true),
+                     "Dispatch CPU kernels through the work stealing scheduler.");
+  desc.add_options()("use-shared-cpu-group-by-buffer",
+                     po::value<bool>(&g_enable_shared_cpu_group_by_buffer)
+                         ->default_value(g_enable_shared_cpu_group_by_buffer)
+                         ->implicit_value(true),
+                     "Let CPU kernels share one baseline hash group by buffer.");
   desc.add_options()("use-disk-cache",
                      "Use the disk cache for all tables with minimum size settings.");
 
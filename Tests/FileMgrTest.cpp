@@ -21,13 +21,27 @@
 #include <gtest/gtest.h>
 #include <boost/filesystem.hpp>
 
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <numeric>
+#include <thread>
+
+#include "DataMgr/BufferMgr/CpuBufferMgr/CpuBufferMgr.h"
+#include "DataMgr/FileMgr/FileBuffer.h"
 #include "DataMgr/FileMgr/FileMgr.h"
 #include "DataMgr/FileMgr/GlobalFileMgr.h"
 #include "DataMgr/ForeignStorage/ArrowForeignStorage.h"
 #include "DataMgrTestHelpers.h"
 #include "Shared/File.h"
+#include "Shared/scope.h"
 #include "TestHelpers.h"
 
+#ifdef HAVE_CUDA
+#include "CudaMgr/CudaMgr.h"
+#endif  // HAVE_CUDA
+
 class FileMgrTest : public testing::Test {
  protected:
   inline static const std::string TEST_DATA_DIR{"./test_dir"};
@@ -184,6 +198,166 @@ TEST_F(FileMgrTest, putBuffer_append) {
   compareBuffersAndMetadata(&source_buffer, file_buffer);
 }
 
+TEST_F(FileMgrTest, vectored_page_reads) {
+  constexpr size_t page_size{1024};
+  constexpr size_t value_count{4096};
+  auto file_mgr = getFileMgr();
+  const ChunkKey chunk_key{1, 1, 2, 0};
+  auto buffer = file_mgr->createBuffer(chunk_key, page_size);
+  buffer->initEncoder(SQLTypeInfo{kINT});
+  std::vector<int32_t> data(value_count);
+  std::iota(data.begin(), data.end(), 0);
+  writeData(buffer, data, 0);
+  ASSERT_GT(buffer->pageCount(), size_t(1));
+
+  ScopeGuard reset_vectored_reads = [orig = g_enable_vectored_page_reads] {
+    g_enable_vectored_page_reads = orig;
+  };
+  // reads straddling page boundaries, before and after the checkpoint
+  for (const bool checkpointed : {false, true}) {
+    if (checkpointed) {
+      file_mgr->checkpoint();
+    }
+    for (const size_t offset : {size_t(0), size_t(1), page_size + 3}) {
+      const size_t num_bytes = buffer->size() - offset;
+      g_enable_vectored_page_reads = false;
+      std::vector<int8_t> expected(num_bytes);
+      buffer->read(expected.data(), num_bytes, offset);
+      g_enable_vectored_page_reads = true;
+      std::vector<int8_t> actual(num_bytes);
+      buffer->read(actual.data(), num_bytes, offset);
+      ASSERT_EQ(expected, actual);
+    }
+  }
+  std::vector<int32_t> read_data(value_count);
+  buffer->read(reinterpret_cast<int8_t*>(read_data.data()), buffer->size());
+  ASSERT_EQ(data, read_data);
+}
+
+TEST_F(FileMgrTest, compressed_pages) {
+  constexpr size_t page_size{1024};
+  constexpr size_t value_count{4096};
+  ScopeGuard reset_page_compression_codec = [orig = g_page_compression_codec] {
+    g_page_compression_codec = orig;
+  };
+  g_page_compression_codec = "lz4";
+  auto file_mgr = getFileMgr();
+  const ChunkKey chunk_key{1, 1, 2, 0};
+  auto buffer = file_mgr->createBuffer(chunk_key, page_size);
+  ASSERT_EQ(buffer->getPageCompressionCodec(), File_Namespace::PageCompressionCodec::LZ4);
+  buffer->initEncoder(SQLTypeInfo{kINT});
+  std::vector<int32_t> data(value_count);
+  std::iota(data.begin(), data.end(), 0);
+  writeData(buffer, data, 0);
+  file_mgr->checkpoint();
+
+  // appends to a partially filled page and overwrites straddling page boundaries, in
+  // the same epoch and in a later one
+  std::vector<int32_t> appended_data(100, 7);
+  appendData(buffer, appended_data);
+  data.insert(data.end(), appended_data.begin(), appended_data.end());
+  for (const size_t offset : {page_size - 2, 10 * page_size + 1}) {
+    std::vector<int32_t> overwritten_data(300, -1);
+    buffer->write(reinterpret_cast<int8_t*>(overwritten_data.data()),
+                  overwritten_data.size() * sizeof(int32_t),
+                  offset);
+    std::memcpy(reinterpret_cast<int8_t*>(data.data()) + offset,
+                overwritten_data.data(),
+                overwritten_data.size() * sizeof(int32_t));
+    file_mgr->checkpoint();
+  }
+  std::vector<int32_t> read_data(data.size());
+  buffer->read(reinterpret_cast<int8_t*>(read_data.data()), buffer->size());
+  ASSERT_EQ(data, read_data);
+
+  // the codec is read back from the chunk metadata, regardless of the current setting
+  g_page_compression_codec = "none";
+  global_file_mgr_->closeFileMgr(TEST_CHUNK_KEY[CHUNK_KEY_DB_IDX],
+                                 TEST_CHUNK_KEY[CHUNK_KEY_TABLE_IDX]);
+  file_mgr = getFileMgr();
+  buffer = file_mgr->getBuffer(chunk_key);
+  ASSERT_EQ(buffer->getPageCompressionCodec(), File_Namespace::PageCompressionCodec::LZ4);
+  std::fill(read_data.begin(), read_data.end(), 0);
+  buffer->read(reinterpret_cast<int8_t*>(read_data.data()), buffer->size());
+  ASSERT_EQ(data, read_data);
+  ASSERT_EQ(file_mgr->getBuffer(TEST_CHUNK_KEY)->getPageCompressionCodec(),
+            File_Namespace::PageCompressionCodec::NONE);
+}
+
+TEST_F(FileMgrTest, group_commit_checkpoints) {
+  constexpr int32_t table_count{4};
+  ScopeGuard reset_group_commit_window = [orig = g_checkpoint_group_commit_window_us] {
+    g_checkpoint_group_commit_window_us = orig;
+  };
+  g_checkpoint_group_commit_window_us = 10000;
+  const int32_t db_id = TEST_CHUNK_KEY[CHUNK_KEY_DB_IDX];
+  std::vector<std::thread> threads;
+  for (int32_t table_id = 2; table_id < 2 + table_count; ++table_id) {
+    threads.emplace_back([this, db_id, table_id] {
+      const ChunkKey chunk_key{db_id, table_id, 1, 0};
+      auto buffer = global_file_mgr_->createBuffer(chunk_key, DEFAULT_PAGE_SIZE, 0);
+      buffer->initEncoder(SQLTypeInfo{kINT});
+      std::vector<int32_t> data{table_id};
+      writeData(buffer, data, 0);
+      global_file_mgr_->checkpoint(db_id, table_id);
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  // A checkpoint of all tables also syncs their files together
+  global_file_mgr_->checkpoint();
+
+  // Data and epochs are persisted per table
+  global_file_mgr_ = std::make_unique<File_Namespace::GlobalFileMgr>(
+      0, std::make_shared<ForeignStorageInterface>(), TEST_DATA_DIR, 0);
+  for (int32_t table_id = 2; table_id < 2 + table_count; ++table_id) {
+    EXPECT_EQ(global_file_mgr_->getTableEpoch(db_id, table_id), size_t(2));
+    int32_t value{0};
+    global_file_mgr_->getBuffer({db_id, table_id, 1, 0})
+        ->read(reinterpret_cast<int8_t*>(&value), sizeof(int32_t));
+    EXPECT_EQ(value, table_id);
+  }
+}
+
+TEST_F(FileMgrTest, delta_compressed_pages) {
+  constexpr size_t page_size{1024};
+  ScopeGuard reset_page_compression_codec = [orig = g_page_compression_codec] {
+    g_page_compression_codec = orig;
+  };
+  g_page_compression_codec = "zstd-delta";
+  auto file_mgr = getFileMgr();
+  const ChunkKey chunk_key{1, 1, 2, 0};
+  auto buffer = file_mgr->createBuffer(chunk_key, page_size);
+  ASSERT_EQ(buffer->getPageCompressionCodec(),
+            File_Namespace::PageCompressionCodec::ZSTD_DELTA);
+  buffer->initEncoder(SQLTypeInfo{kINT});
+
+  // sorted values, followed by low variance values around a large base, so deltas are
+  // both positive and negative and page data does not start on value boundaries
+  std::vector<int32_t> data(2048);
+  std::iota(data.begin(), data.end(), 1 << 20);
+  for (size_t i = 0; i < 2048; ++i) {
+    data.emplace_back(std::numeric_limits<int32_t>::max() - static_cast<int32_t>(i % 7));
+  }
+  writeData(buffer, data, 0);
+  file_mgr->checkpoint();
+  std::vector<int32_t> appended_data{std::numeric_limits<int32_t>::min(), -1, 0, 1};
+  appendData(buffer, appended_data);
+  data.insert(data.end(), appended_data.begin(), appended_data.end());
+  file_mgr->checkpoint();
+
+  global_file_mgr_->closeFileMgr(TEST_CHUNK_KEY[CHUNK_KEY_DB_IDX],
+                                 TEST_CHUNK_KEY[CHUNK_KEY_TABLE_IDX]);
+  file_mgr = getFileMgr();
+  buffer = file_mgr->getBuffer(chunk_key);
+  ASSERT_EQ(buffer->getPageCompressionCodec(),
+            File_Namespace::PageCompressionCodec::ZSTD_DELTA);
+  std::vector<int32_t> read_data(data.size());
+  buffer->read(reinterpret_cast<int8_t*>(read_data.data()), buffer->size());
+  ASSERT_EQ(data, read_data);
+}
+
 TEST_F(FileMgrTest, put_checkpoint_get) {
   TestHelpers::TestBuffer source_buffer{std::vector<int32_t>{1}};
   std::vector<int32_t> data_v1 = {1, 2, 3, 5, 7};
@@ -300,6 +474,60 @@ TEST_F(FileMgrTest, buffer_append_and_recovery) {
   }
 }
 
+TEST_F(FileMgrTest, chunk_index_snapshot) {
+  ScopeGuard reset_chunk_index_snapshot = [orig = g_enable_chunk_index_snapshot] {
+    g_enable_chunk_index_snapshot = orig;
+  };
+  g_enable_chunk_index_snapshot = true;
+  global_file_mgr_->closeFileMgr(TEST_CHUNK_KEY[CHUNK_KEY_DB_IDX],
+                                 TEST_CHUNK_KEY[CHUNK_KEY_TABLE_IDX]);
+  std::string snapshot_path;
+  const auto read_snapshot_epoch = [&snapshot_path]() {
+    std::ifstream snapshot_file{snapshot_path, std::ios::in | std::ios::binary};
+    int32_t version_and_epoch[2];
+    snapshot_file.read(reinterpret_cast<char*>(version_and_epoch),
+                       sizeof(version_and_epoch));
+    return version_and_epoch[1];
+  };
+
+  TestHelpers::TestBuffer source_buffer{std::vector<int32_t>{1}};
+  std::vector<int32_t> data_v1 = {1, 2, 3, 5, 7};
+  std::vector<int32_t> data_v2 = {11, 13, 17, 19};
+  appendData(&source_buffer, data_v1);
+  {
+    auto file_mgr = getFileMgr();
+    file_mgr->putBuffer(TEST_CHUNK_KEY, &source_buffer, 24);
+    file_mgr->checkpoint();
+    snapshot_path =
+        file_mgr->getFilePath(File_Namespace::FileMgr::CHUNK_INDEX_SNAPSHOT_FILENAME)
+            .string();
+    ASSERT_EQ(read_snapshot_epoch(), file_mgr->lastCheckpointedEpoch());
+    global_file_mgr_->closeFileMgr(TEST_CHUNK_KEY[CHUNK_KEY_DB_IDX],
+                                   TEST_CHUNK_KEY[CHUNK_KEY_TABLE_IDX]);
+  }
+
+  {
+    // Opened from the snapshot, which the uncheckpointed append invalidates
+    auto file_mgr = getFileMgr();
+    AbstractBuffer* file_buffer = file_mgr->getBuffer(TEST_CHUNK_KEY, 24);
+    {
+      SCOPED_TRACE("Chunk Index Snapshot - Compare #1");
+      compareBuffersAndMetadata(&source_buffer, file_buffer);
+    }
+    appendData(file_buffer, data_v2);
+    ASSERT_EQ(read_snapshot_epoch(), -1);
+    global_file_mgr_->closeFileMgr(TEST_CHUNK_KEY[CHUNK_KEY_DB_IDX],
+                                   TEST_CHUNK_KEY[CHUNK_KEY_TABLE_IDX]);
+  }
+
+  {
+    auto file_mgr = getFileMgr();
+    AbstractBuffer* file_buffer = file_mgr->getBuffer(TEST_CHUNK_KEY, 24);
+    SCOPED_TRACE("Chunk Index Snapshot - Compare #2");
+    compareBuffersAndMetadata(&source_buffer, file_buffer);
+  }
+}
+
 TEST_F(FileMgrTest, buffer_update_and_recovery) {
   std::vector<int32_t> data_v1 = {
       2,
@@ -809,6 +1037,45 @@ TEST_F(DataCompactionTest, SingleDataAndMetadataPages) {
   assertBufferValueAndMetadata(3, 1);
 }
 
+TEST_F(DataCompactionTest, ThrottledCompactionKeepsFileMgr) {
+  File_Namespace::FileMgr::setNumPagesPerDataFile(2);
+  ScopeGuard reset_compaction_rate = [orig = g_data_compaction_max_bytes_per_sec] {
+    g_data_compaction_max_bytes_per_sec = orig;
+  };
+
+  // Buffers "i1" and "i2" use the first data file, "i3" and "i4" the second one.
+  for (int32_t column_id = 1; column_id <= 4; column_id++) {
+    writeValue(createBuffer(column_id), column_id);
+  }
+  assertStorageStats(1, 4092, 2, 0);
+
+  // Leave one used page in each data file
+  deleteBuffer(1);
+  deleteBuffer(3);
+  assertStorageStats(1, 4094, 2, 2);
+
+  // The single used page of one data file is copied to the other data file, at a
+  // rate of 4 pages per second.
+  g_data_compaction_max_bytes_per_sec = 4 * DEFAULT_PAGE_SIZE;
+  auto file_mgr = getFileMgr();
+  auto start_time = std::chrono::steady_clock::now();
+  compactDataFiles();
+  auto elapsed_time = std::chrono::steady_clock::now() - start_time;
+  EXPECT_GE(elapsed_time, std::chrono::milliseconds(200));
+  assertStorageStats(1, 4094, 1, 0);
+
+  // The file mgr is not re-initialized and its buffers point to the copied pages
+  EXPECT_EQ(file_mgr, getFileMgr());
+  assertBufferValueAndMetadata(2, 2);
+  assertBufferValueAndMetadata(4, 4);
+
+  // Contents are the same after reading them back from disk
+  deleteFileMgr();
+  assertStorageStats(1, 4094, 1, 0);
+  assertBufferValueAndMetadata(2, 2);
+  assertBufferValueAndMetadata(4, 4);
+}
+
 TEST_F(DataCompactionTest, RecoveryFromCopyPageStatus) {
   // One page per file for the data file (metadata file default
   // configuration of 4096 pages remains the same), so each
@@ -1120,6 +1387,197 @@ TEST_F(FileMgrUnitTest, InitializeWithUncheckpointedAppendPages) {
   ASSERT_EQ(buffer->pageCount(), 1U);
 }
 
+class BufferMgrTest : public FileMgrTest {
+ protected:
+  static constexpr size_t kChunkBytes{512};
+  static constexpr size_t kChunkValues{kChunkBytes / sizeof(int32_t)};
+  // The pool is a single slab of one page per chunk.
+  static constexpr size_t kPoolChunks{4};
+
+  void SetUp() override { initializeGlobalFileMgr(); }
+
+  // Checkpoints one chunk per column of the table, each filled with its column id.
+  void createChunks(const int32_t table_id, const int32_t column_count) {
+    for (int32_t column_id = 1; column_id <= column_count; ++column_id) {
+      auto buffer = global_file_mgr_->createBuffer({1, table_id, column_id, 0});
+      buffer->initEncoder(SQLTypeInfo{kINT});
+      std::vector<int32_t> data(kChunkValues, column_id);
+      writeData(buffer, data, 0);
+    }
+    global_file_mgr_->checkpoint(1, table_id);
+  }
+
+  std::unique_ptr<Buffer_Namespace::CpuBufferMgr> createBufferPool(
+      CudaMgr_Namespace::CudaMgr* cuda_mgr = nullptr) {
+    const size_t pool_bytes = kPoolChunks * kChunkBytes;
+    return std::make_unique<Buffer_Namespace::CpuBufferMgr>(0,
+                                                            pool_bytes,
+                                                            cuda_mgr,
+                                                            pool_bytes,
+                                                            pool_bytes,
+                                                            kChunkBytes,
+                                                            global_file_mgr_.get());
+  }
+
+  // Reads the chunk through the pool the way a query does and checks its values.
+  void readChunk(Buffer_Namespace::BufferMgr* pool, const ChunkKey& chunk_key) {
+    auto buffer = pool->getBuffer(chunk_key, kChunkBytes);
+    ScopeGuard unpin = [buffer] { buffer->unPin(); };
+    ASSERT_EQ(buffer->size(), kChunkBytes);
+    const auto values = reinterpret_cast<const int32_t*>(buffer->getMemoryPtr());
+    EXPECT_EQ(std::vector<int32_t>(values, values + kChunkValues),
+              std::vector<int32_t>(kChunkValues, chunk_key[CHUNK_KEY_COLUMN_IDX]));
+  }
+};
+
+TEST_F(BufferMgrTest, ScanResistantEviction) {
+  const auto enable_scan_resistant_eviction = g_enable_scan_resistant_buffer_eviction;
+  ScopeGuard reset = [enable_scan_resistant_eviction] {
+    g_enable_scan_resistant_buffer_eviction = enable_scan_resistant_eviction;
+  };
+  createChunks(1, 8);
+  for (const bool scan_resistant : {false, true}) {
+    g_enable_scan_resistant_buffer_eviction = scan_resistant;
+    auto pool = createBufferPool();
+    // Columns 1 and 2 are the working set, then a scan reads columns 3 to 8 once.
+    for (int pass = 0; pass < 2; ++pass) {
+      readChunk(pool.get(), {1, 1, 1, 0});
+      readChunk(pool.get(), {1, 1, 2, 0});
+    }
+    for (int32_t column_id = 3; column_id <= 8; ++column_id) {
+      readChunk(pool.get(), {1, 1, column_id, 0});
+    }
+    EXPECT_EQ(pool->isBufferOnDevice({1, 1, 1, 0}), scan_resistant);
+    EXPECT_EQ(pool->isBufferOnDevice({1, 1, 2, 0}), scan_resistant);
+    EXPECT_TRUE(pool->isBufferOnDevice({1, 1, 8, 0}));
+
+    const auto stats = pool->getBufferPoolStats();
+    EXPECT_EQ(stats.hits, 2U);
+    EXPECT_EQ(stats.misses, 8U);
+    EXPECT_EQ(stats.evicted_chunks, 4U);
+    EXPECT_EQ(stats.evicted_reused_chunks, scan_resistant ? 0U : 2U);
+    EXPECT_EQ(stats.evicted_single_use_chunks, scan_resistant ? 4U : 2U);
+
+    // The working set reads back from the pool or the file mgr alike.
+    readChunk(pool.get(), {1, 1, 1, 0});
+    EXPECT_EQ(pool->getBufferPoolStats().hits, scan_resistant ? 3U : 2U);
+  }
+}
+
+TEST_F(BufferMgrTest, TableEvictionHint) {
+  createChunks(1, 6);
+  createChunks(2, 1);
+  auto pool = createBufferPool();
+  pool->setTableEvictionHint(1, 2, true);
+  // The hinted chunk is the least recently used one when the scan of table 1 evicts.
+  readChunk(pool.get(), {1, 2, 1, 0});
+  for (int32_t column_id = 1; column_id <= 6; ++column_id) {
+    readChunk(pool.get(), {1, 1, column_id, 0});
+  }
+  EXPECT_TRUE(pool->isBufferOnDevice({1, 2, 1, 0}));
+  auto stats = pool->getBufferPoolStats();
+  EXPECT_EQ(stats.evicted_chunks, 3U);
+  EXPECT_EQ(stats.evicted_hinted_chunks, 0U);
+
+  // Without the hint it goes first.
+  pool->setTableEvictionHint(1, 2, false);
+  readChunk(pool.get(), {1, 1, 1, 0});
+  EXPECT_FALSE(pool->isBufferOnDevice({1, 2, 1, 0}));
+  stats = pool->getBufferPoolStats();
+  EXPECT_EQ(stats.evicted_chunks, 4U);
+  EXPECT_EQ(stats.evicted_hinted_chunks, 0U);
+}
+
+TEST_F(BufferMgrTest, Defragmentation) {
+  const auto enable_defragmentation = g_enable_buffer_pool_defragmentation;
+  ScopeGuard reset = [enable_defragmentation] {
+    g_enable_buffer_pool_defragmentation = enable_defragmentation;
+  };
+  createChunks(1, 4);
+  for (const bool on_allocation : {false, true}) {
+    g_enable_buffer_pool_defragmentation = on_allocation;
+    auto pool = createBufferPool();
+    for (int32_t column_id = 1; column_id <= 4; ++column_id) {
+      readChunk(pool.get(), {1, 1, column_id, 0});
+    }
+    // Freeing every other chunk leaves two holes of one page.
+    pool->deleteBuffer({1, 1, 1, 0});
+    pool->deleteBuffer({1, 1, 3, 0});
+    auto fragmentation = pool->getFragmentationInfo();
+    EXPECT_EQ(fragmentation.free_pages, 2U);
+    EXPECT_EQ(fragmentation.num_free_segments, 2U);
+    EXPECT_EQ(fragmentation.largest_free_segment_pages, 1U);
+    if (on_allocation) {
+      // A chunk of two pages fits once the holes coalesce, so nothing is evicted.
+      auto buffer = pool->createBuffer({1, 2, 1, 0}, kChunkBytes, 2 * kChunkBytes);
+      buffer->unPin();
+      EXPECT_EQ(pool->getBufferPoolStats().evicted_chunks, 0U);
+    } else {
+      EXPECT_EQ(pool->defragmentSlabs(), 2U);
+      fragmentation = pool->getFragmentationInfo();
+      EXPECT_EQ(fragmentation.free_pages, 2U);
+      EXPECT_EQ(fragmentation.num_free_segments, 1U);
+      EXPECT_EQ(fragmentation.largest_free_segment_pages, 2U);
+    }
+    // The moved chunks still hold their values.
+    readChunk(pool.get(), {1, 1, 2, 0});
+    readChunk(pool.get(), {1, 1, 4, 0});
+    EXPECT_EQ(pool->getBufferPoolStats().hits, 2U);
+  }
+}
+
+TEST_F(BufferMgrTest, PinnedSlabs) {
+  const auto cpu_buffer_pool_pinned_bytes = g_cpu_buffer_pool_pinned_bytes;
+  ScopeGuard reset = [cpu_buffer_pool_pinned_bytes] {
+    g_cpu_buffer_pool_pinned_bytes = cpu_buffer_pool_pinned_bytes;
+  };
+  g_cpu_buffer_pool_pinned_bytes = kPoolChunks * kChunkBytes;
+  createChunks(1, 6);
+  {
+    // Without a CudaMgr the slab falls back to pageable memory.
+    auto pool = createBufferPool();
+    for (int32_t column_id = 1; column_id <= 6; ++column_id) {
+      readChunk(pool.get(), {1, 1, column_id, 0});
+    }
+  }
+#ifdef HAVE_CUDA
+  std::unique_ptr<CudaMgr_Namespace::CudaMgr> cuda_mgr;
+  try {
+    cuda_mgr = std::make_unique<CudaMgr_Namespace::CudaMgr>(-1, 0);
+  } catch (const std::exception& e) {
+    GTEST_SKIP() << "No CUDA devices: " << e.what();
+  }
+  if (cuda_mgr->getDeviceCount() == 0) {
+    GTEST_SKIP() << "No CUDA devices";
+  }
+  for (const bool pinned : {true, false}) {
+    // The slab is pinned only when it fits in the limit.
+    g_cpu_buffer_pool_pinned_bytes = kPoolChunks * kChunkBytes - (pinned ? 0 : 1);
+    auto pool = createBufferPool(cuda_mgr.get());
+    for (int32_t column_id = 1; column_id <= 6; ++column_id) {
+      readChunk(pool.get(), {1, 1, column_id, 0});
+      auto buffer = pool->getBuffer({1, 1, column_id, 0}, kChunkBytes);
+      ScopeGuard unpin = [buffer] { buffer->unPin(); };
+      EXPECT_EQ(cuda_mgr->isPinnedHostMem(buffer->getMemoryPtr(), kChunkBytes), pinned);
+      if (!pinned) {
+        continue;
+      }
+      // Round trip the chunk through the device on the copy stream.
+      auto device_ptr = cuda_mgr->allocateDeviceMem(kChunkBytes, 0);
+      ScopeGuard free_device_mem = [&cuda_mgr, device_ptr] {
+        cuda_mgr->freeDeviceMem(device_ptr);
+      };
+      cuda_mgr->copyPinnedHostToDevice(
+          device_ptr, buffer->getMemoryPtr(), kChunkBytes, 0);
+      std::vector<int32_t> values(kChunkValues);
+      cuda_mgr->copyDeviceToHost(
+          reinterpret_cast<int8_t*>(values.data()), device_ptr, kChunkBytes, 0);
+      EXPECT_EQ(values, std::vector<int32_t>(kChunkValues, column_id));
+    }
+  }
+#endif  // HAVE_CUDA
+}
+
 int main(int argc, char** argv) {
   TestHelpers::init_logger_stderr_only(argc, argv);
   testing::InitGoogleTest(&argc, argv);
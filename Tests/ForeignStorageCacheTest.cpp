@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include "DataMgr/ForeignStorage/CacheEvictionAlgorithms/CostAwareEvictionAlgorithm.h"
 #include "DataMgr/ForeignStorage/ForeignStorageCache.h"
 #include "DataMgr/ForeignStorage/ForeignStorageInterface.h"
 #include "DataMgr/ForeignStorage/ForeignStorageMgr.h"
@@ -481,6 +482,90 @@ TEST_F(ForeignStorageCacheLRUTest, Reorder) {
   ASSERT_THROW(lru_alg.evictNextChunk(), NoEntryFoundException);
 }
 
+class ForeignStorageCacheCostAwareTest : public testing::Test {};
+TEST_F(ForeignStorageCacheCostAwareTest, EmptyChunksFirst) {
+  CostAwareEvictionAlgorithm alg{};
+  alg.touchChunk(chunk_key1);
+  alg.touchChunk(chunk_key2);
+  alg.setChunkSize(chunk_key1, 1024);
+  ASSERT_EQ(alg.evictNextChunk(), chunk_key2);
+  ASSERT_EQ(alg.evictNextChunk(), chunk_key1);
+  ASSERT_THROW(alg.evictNextChunk(), NoEntryFoundException);
+}
+
+TEST_F(ForeignStorageCacheCostAwareTest, Frequency) {
+  CostAwareEvictionAlgorithm alg{};
+  alg.touchChunk(chunk_key1);
+  alg.touchChunk(chunk_key1);
+  alg.touchChunk(chunk_key2);
+  alg.setChunkSize(chunk_key1, 1024);
+  alg.setChunkSize(chunk_key2, 1024);
+  ASSERT_EQ(alg.evictNextChunk(), chunk_key2);
+  ASSERT_EQ(alg.evictNextChunk(), chunk_key1);
+}
+
+TEST_F(ForeignStorageCacheCostAwareTest, LargerChunksFirst) {
+  CostAwareEvictionAlgorithm alg{};
+  alg.touchChunk(chunk_key1);
+  alg.touchChunk(chunk_key2);
+  alg.setChunkSize(chunk_key1, 1024);
+  alg.setChunkSize(chunk_key2, 64 * 1024 * 1024);
+  ASSERT_EQ(alg.evictNextChunk(), chunk_key2);
+  ASSERT_EQ(alg.evictNextChunk(), chunk_key1);
+}
+
+TEST_F(ForeignStorageCacheCostAwareTest, RefetchCost) {
+  const ChunkKey remote_chunk_key{1, 2, 1, 0};
+  CostAwareEvictionAlgorithm alg{};
+  alg.setTableRefetchCost(table_prefix2, 100.0);
+  alg.touchChunk(remote_chunk_key);
+  alg.touchChunk(chunk_key1);
+  alg.touchChunk(chunk_key1);
+  alg.setChunkSize(remote_chunk_key, 1024);
+  alg.setChunkSize(chunk_key1, 1024);
+  ASSERT_EQ(alg.evictNextChunk(), chunk_key1);
+  ASSERT_EQ(alg.evictNextChunk(), remote_chunk_key);
+}
+
+TEST_F(ForeignStorageCacheCostAwareTest, Aging) {
+  CostAwareEvictionAlgorithm alg{};
+  alg.touchChunk(chunk_key1);
+  alg.touchChunk(chunk_key1);
+  alg.touchChunk(chunk_key2);
+  alg.setChunkSize(chunk_key1, 1024);
+  alg.setChunkSize(chunk_key2, 1024);
+  ASSERT_EQ(alg.evictNextChunk(), chunk_key2);
+  // Chunks added after an eviction start from the priority of the evicted chunk.
+  alg.touchChunk(chunk_key3);
+  alg.setChunkSize(chunk_key3, 1024);
+  ASSERT_EQ(alg.evictNextChunk(), chunk_key1);
+  ASSERT_EQ(alg.evictNextChunk(), chunk_key3);
+}
+
+TEST_F(ForeignStorageCacheCostAwareTest, RemoveChunk) {
+  CostAwareEvictionAlgorithm alg{};
+  alg.touchChunk(chunk_key1);
+  alg.touchChunk(chunk_key2);
+  alg.removeChunk(chunk_key1);
+  ASSERT_EQ(alg.evictNextChunk(), chunk_key2);
+  ASSERT_THROW(alg.evictNextChunk(), NoEntryFoundException);
+}
+
+TEST_F(ForeignStorageCacheCostAwareTest, TableSizeLimit) {
+  const ChunkKey other_chunk_key{1, 2, 1, 0};
+  CostAwareEvictionAlgorithm alg{2048};
+  alg.touchChunk(other_chunk_key);
+  alg.setChunkSize(other_chunk_key, 64 * 1024 * 1024);
+  alg.touchChunk(chunk_key1);
+  alg.touchChunk(chunk_key2);
+  alg.touchChunk(chunk_key3);
+  alg.setChunkSize(chunk_key1, 1024);
+  alg.setChunkSize(chunk_key2, 1024);
+  alg.setChunkSize(chunk_key3, 1024);
+  ASSERT_EQ(alg.evictNextChunk(), chunk_key1);
+  ASSERT_EQ(alg.evictNextChunk(), other_chunk_key);
+}
+
 int main(int argc, char** argv) {
   TestHelpers::init_logger_stderr_only(argc, argv);
   testing::InitGoogleTest(&argc, argv);
@@ -361,6 +361,77 @@ TEST(Ordering, Triple) {
   }
 }
 
+namespace {
+
+Fragmenter_Namespace::FragmentInfo make_fragment_with_int_ranges(
+    const size_t num_tuples,
+    const std::vector<std::pair<int, int>>& column_ranges) {
+  Fragmenter_Namespace::FragmentInfo fragment;
+  fragment.setPhysicalNumTuples(num_tuples);
+  for (size_t i = 0; i < column_ranges.size(); ++i) {
+    ChunkStats chunk_stats;
+    chunk_stats.min.intval = column_ranges[i].first;
+    chunk_stats.max.intval = column_ranges[i].second;
+    chunk_stats.has_nulls = false;
+    const size_t num_bytes = num_tuples * sizeof(int32_t);
+    fragment.setChunkMetadata(
+        i + 1,
+        std::make_shared<ChunkMetadata>(
+            SQLTypeInfo{kINT, true}, num_bytes, num_tuples, chunk_stats));
+  }
+  return fragment;
+}
+
+}  // namespace
+
+TEST(Ordering, CostBased) {
+  const bool enable_cost_based_join_ordering = g_enable_cost_based_join_ordering;
+  ScopeGuard reset = [enable_cost_based_join_ordering] {
+    g_enable_cost_based_join_ordering = enable_cost_based_join_ordering;
+  };
+  // Star join of a fact table with two dimensions. The key of the smaller dimension has
+  // more distinct values in the fact table, so joining it first yields fewer rows.
+  auto fact_a = std::make_shared<Analyzer::ColumnVar>(SQLTypeInfo{kINT, true}, 1, 1, 0);
+  auto fact_b = std::make_shared<Analyzer::ColumnVar>(SQLTypeInfo{kINT, true}, 1, 2, 0);
+  auto dim1_a = std::make_shared<Analyzer::ColumnVar>(SQLTypeInfo{kINT, true}, 2, 1, 1);
+  auto dim2_b = std::make_shared<Analyzer::ColumnVar>(SQLTypeInfo{kINT, true}, 3, 1, 2);
+  auto op1 = std::make_shared<Analyzer::BinOper>(kBOOLEAN, kEQ, kONE, fact_a, dim1_a);
+  auto op2 = std::make_shared<Analyzer::BinOper>(kBOOLEAN, kEQ, kONE, fact_b, dim2_b);
+
+  JoinCondition jc1{{op1}, JoinType::INNER};
+  JoinCondition jc2{{op2}, JoinType::INNER};
+  JoinQualsPerNestingLevel nesting_levels;
+  nesting_levels.push_back(jc1);
+  nesting_levels.push_back(jc2);
+
+  std::vector<InputTableInfo> viti(3);
+  viti[0].info.setPhysicalNumTuples(1000);
+  viti[0].info.fragments.push_back(
+      make_fragment_with_int_ranges(1000, {{1, 10}, {1, 1000}}));
+  viti[1].info.setPhysicalNumTuples(100);
+  viti[1].info.fragments.push_back(make_fragment_with_int_ranges(100, {{1, 100}}));
+  viti[2].info.setPhysicalNumTuples(10);
+  viti[2].info.fragments.push_back(make_fragment_with_int_ranges(10, {{1, 10}}));
+
+  g_enable_cost_based_join_ordering = false;
+  auto input_permutation = get_node_input_permutation(nesting_levels, viti, nullptr);
+  decltype(input_permutation) expected_input_permutation{0, 1, 2};
+  ASSERT_EQ(expected_input_permutation, input_permutation);
+
+  g_enable_cost_based_join_ordering = true;
+  input_permutation = get_node_input_permutation(nesting_levels, viti, nullptr);
+  expected_input_permutation = {0, 2, 1};
+  ASSERT_EQ(expected_input_permutation, input_permutation);
+
+  // Without column statistics the estimates only depend on the table sizes.
+  for (auto& table_info : viti) {
+    table_info.info.fragments.clear();
+  }
+  input_permutation = get_node_input_permutation(nesting_levels, viti, nullptr);
+  expected_input_permutation = {0, 2, 1};
+  ASSERT_EQ(expected_input_permutation, input_permutation);
+}
+
 int main(int argc, char** argv) {
   TestHelpers::init_logger_stderr_only(argc, argv);
   testing::InitGoogleTest(&argc, argv);
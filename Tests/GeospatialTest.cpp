@@ -33,6 +33,8 @@ bool g_hoist_literals{true};
 extern size_t g_leaf_count;
 extern bool g_cluster;
 extern bool g_is_test_env;
+extern size_t g_jit_low_tier_max_rows;
+extern size_t g_jit_tier_promotion_count;
 
 using QR = QueryRunner::QueryRunner;
 using namespace TestHelpers;
@@ -2214,6 +2216,41 @@ TEST_F(GeoSpatialTempTables, Geos) {
   }
 }
 
+#ifdef ENABLE_GEOS
+TEST_F(GeoSpatialTempTables, GeosLowTierJitPromotion) {
+  SKIP_ALL_ON_AGGREGATOR();
+  ScopeGuard reset = [orig_max_rows = g_jit_low_tier_max_rows,
+                      orig_promotion_count = g_jit_tier_promotion_count] {
+    g_jit_low_tier_max_rows = orig_max_rows;
+    g_jit_tier_promotion_count = orig_promotion_count;
+  };
+  g_jit_low_tier_max_rows = 10000;
+  g_jit_tier_promotion_count = 2;
+  // The promoted module has to carry the GEOS runtime functions linked into the low
+  // tier one.
+  const std::string query{
+      "SELECT ST_Area(ST_Intersection(poly, 'POLYGON((1 1,3 1,3 3,1 3,1 1))')) + "
+      "ST_Area(ST_Union(poly, 'POLYGON((1 1,3 1,3 3,1 3,1 1))')) "
+      "FROM geospatial_test WHERE id = 2;"};
+  const auto before = Executor::getJitTierCounts();
+  for (int run = 0; run < 4; ++run) {
+    ASSERT_NEAR(static_cast<double>(8.5),
+                v<double>(run_simple_agg(query, ExecutorDeviceType::CPU)),
+                static_cast<double>(0.00001));
+  }
+  QR::get()->getExecutor()->waitForBackgroundCodegen();
+  const auto after = Executor::getJitTierCounts();
+  EXPECT_GE(after.low_tier_compilations, before.low_tier_compilations + 1);
+  EXPECT_EQ(after.promotions, before.promotions + 1);
+  EXPECT_EQ(after.background_replacements, before.background_replacements + 1);
+  EXPECT_EQ(after.background_failures, before.background_failures);
+  // The full tier code gives the same result.
+  ASSERT_NEAR(static_cast<double>(8.5),
+              v<double>(run_simple_agg(query, ExecutorDeviceType::CPU)),
+              static_cast<double>(0.00001));
+}
+#endif
+
 class GeoSpatialJoinTablesFixture : public ::testing::TestWithParam<bool> {
  protected:
   void SetUp() override {
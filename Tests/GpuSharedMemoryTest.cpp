@@ -475,7 +475,7 @@ void GpuReductionTester::performReductionTest(
 }
 
 TEST(SingleColumn, VariableEntries_CountQuery_4B_Group) {
-  for (auto num_entries : {1, 2, 3, 5, 13, 31, 63, 126, 241, 511, 1021}) {
+  for (auto num_entries : {1, 2, 3, 5, 13, 31, 63, 126, 241, 511, 1021, 2047, 4093}) {
     TestInputData input;
     input.setDeviceId(0)
         .setNumInputBuffers(4)
@@ -491,7 +491,7 @@ TEST(SingleColumn, VariableEntries_CountQuery_4B_Group) {
 }
 
 TEST(SingleColumn, VariableEntries_CountQuery_8B_Group) {
-  for (auto num_entries : {1, 2, 3, 5, 13, 31, 63, 126, 241, 511, 1021}) {
+  for (auto num_entries : {1, 2, 3, 5, 13, 31, 63, 126, 241, 511, 1021, 2047, 4093}) {
     TestInputData input;
     input.setDeviceId(0)
         .setNumInputBuffers(4)
@@ -366,6 +366,19 @@ TEST_F(LowCardinalityThresholdTest, GroupBy) {
   }
 }
 
+TEST_F(LowCardinalityThresholdTest, RepeatedGroupBy) {
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+
+    // the repeated queries size their groups buffer from the cached output cardinality
+    for (size_t i = 0; i < 3; ++i) {
+      auto result = QR::get()->runSQL(
+          R"(select fl,ar,dep,count(*) from low_cardinality group by fl,ar,dep;)", dt);
+      EXPECT_EQ(result->rowCount(), g_big_group_threshold);
+    }
+  }
+}
+
 class BigCardinalityThresholdTest : public ::testing::Test {
  protected:
   void SetUp() override {
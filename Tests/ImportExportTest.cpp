@@ -58,6 +58,10 @@ extern bool g_use_date_in_days_default_encoding;
 extern size_t g_leaf_count;
 extern bool g_is_test_env;
 extern bool g_allow_s3_server_privileges;
+extern bool g_enable_columnar_delimited_import;
+extern bool g_enable_parquet_import_chunk_loader;
+extern size_t g_csv_export_range_entries;
+extern size_t g_parquet_export_row_group_rows;
 
 namespace {
 
@@ -562,6 +566,33 @@ TEST_F(ImportTestInt, ImportGoodInt) {
   ASSERT_EQ(86u, rows->entryCount());
 };
 
+void run_mixed_int_test() {
+  // this dataset interleaves the rows of the two datasets above, only the rows of the
+  // good one should be added
+  ASSERT_NO_THROW(
+      run_ddl_statement("COPY inttable FROM "
+                        "'../../Tests/Import/datafiles/int_mixed_test.txt';"));
+
+  auto rows = run_query("SELECT COUNT(*), SUM(b8), SUM(tnn) FROM inttable;");
+  auto crt_row = rows->getNextRow(true, true);
+  ASSERT_EQ(size_t(3), crt_row.size());
+  ASSERT_EQ(int64_t(86), v<int64_t>(crt_row[0]));
+  ASSERT_EQ(int64_t(82), v<int64_t>(crt_row[1]));
+  ASSERT_EQ(int64_t(-178), v<int64_t>(crt_row[2]));
+}
+
+TEST_F(ImportTestInt, ImportMixedInt) {
+  SKIP_ALL_ON_AGGREGATOR();  // global variable not available on leaf nodes
+  run_mixed_int_test();
+}
+
+TEST_F(ImportTestInt, ImportMixedIntByColumn) {
+  SKIP_ALL_ON_AGGREGATOR();  // global variable not available on leaf nodes
+  g_enable_columnar_delimited_import = true;
+  ScopeGuard reset_columnar_import = [] { g_enable_columnar_delimited_import = false; };
+  run_mixed_int_test();
+}
+
 class ImportTestLegacyDate : public ::testing::Test {
  protected:
   void SetUp() override {
@@ -939,6 +970,115 @@ TEST_F(ImportTest, OneParquetFileWithUniqueRowGroups) {
   }
   ASSERT_NO_THROW(run_ddl_statement("DROP TABLE unique_rowgroups;"));
 }
+TEST_F(ImportTest, OneParquetFileWithAndWithoutChunkLoader) {
+  ScopeGuard reset_chunk_loader =
+      [chunk_loader_state = g_enable_parquet_import_chunk_loader] {
+        g_enable_parquet_import_chunk_loader = chunk_loader_state;
+      };
+  for (const bool enable_chunk_loader : {false, true}) {
+    g_enable_parquet_import_chunk_loader = enable_chunk_loader;
+    ASSERT_NO_THROW(run_ddl_statement("DROP TABLE IF EXISTS unique_rowgroups;"));
+    ASSERT_NO_THROW(run_ddl_statement(
+        "CREATE TABLE unique_rowgroups (a float, b float, c float, d float) WITH "
+        "(fragment_size=4);"));
+    ASSERT_NO_THROW(
+        run_ddl_statement("COPY unique_rowgroups FROM "
+                          "'../../Tests/Import/datafiles/unique_rowgroups.parquet' "
+                          "WITH (parquet='true');"));
+    auto row_set = run_query(
+        "SELECT COUNT(*), CAST(SUM(a) AS DOUBLE), CAST(SUM(b) AS DOUBLE), CAST(SUM(c) AS "
+        "DOUBLE), MIN(d), MAX(d) FROM unique_rowgroups;");
+    auto row = row_set->getNextRow(true, false);
+    ASSERT_EQ(size_t(6), row.size());
+    EXPECT_EQ(int64_t(6), v<int64_t>(row[0]));
+    EXPECT_DOUBLE_EQ(21., v<double>(row[1]));
+    EXPECT_DOUBLE_EQ(33., v<double>(row[2]));
+    EXPECT_DOUBLE_EQ(41., v<double>(row[3]));
+    EXPECT_FLOAT_EQ(-100., v<float>(row[4]));
+    EXPECT_FLOAT_EQ(7.1f, v<float>(row[5]));
+  }
+  ASSERT_NO_THROW(run_ddl_statement("DROP TABLE unique_rowgroups;"));
+}
+
+TEST_F(ImportTest, ParquetTextAndNullsWithAndWithoutChunkLoader) {
+  const std::string parquet_file{BASE_PATH "/mapd_export/parquet_chunk_loader.parquet"};
+  ScopeGuard cleanup = [chunk_loader_state = g_enable_parquet_import_chunk_loader,
+                        row_group_rows_state = g_parquet_export_row_group_rows,
+                        &parquet_file] {
+    g_enable_parquet_import_chunk_loader = chunk_loader_state;
+    g_parquet_export_row_group_rows = row_group_rows_state;
+    boost::filesystem::remove(parquet_file);
+    run_ddl_statement("DROP TABLE IF EXISTS parquet_chunk_loader_source;");
+    run_ddl_statement("DROP TABLE IF EXISTS parquet_chunk_loader;");
+  };
+  // Small row groups so that the file is loaded as several of them.
+  g_parquet_export_row_group_rows = 2;
+  boost::filesystem::create_directories(BASE_PATH "/mapd_export");
+  ASSERT_NO_THROW(run_ddl_statement("DROP TABLE IF EXISTS parquet_chunk_loader_source;"));
+  ASSERT_NO_THROW(
+      run_ddl_statement("CREATE TABLE parquet_chunk_loader_source (i INTEGER, t TEXT "
+                        "ENCODING NONE, d TEXT ENCODING DICT(32));"));
+  for (const auto& values : {"1, 'a', 'x'",
+                             "2, NULL, 'y'",
+                             "NULL, 'ccc', NULL",
+                             "4, 'dd', 'x'",
+                             "5, 'eeeee', NULL",
+                             "6, 'ffffff', 'z'"}) {
+    ASSERT_NO_THROW(run_query("INSERT INTO parquet_chunk_loader_source VALUES (" +
+                              std::string(values) + ");"));
+  }
+  ASSERT_NO_THROW(
+      run_ddl_statement("COPY (SELECT i, t, d FROM parquet_chunk_loader_source) TO '" +
+                        parquet_file + "' WITH (file_type='Parquet');"));
+
+  auto import_and_aggregate = [&parquet_file](const std::string& columns) {
+    run_ddl_statement("DROP TABLE IF EXISTS parquet_chunk_loader;");
+    run_ddl_statement("CREATE TABLE parquet_chunk_loader (" + columns +
+                      ") WITH (fragment_size=4);");
+    run_ddl_statement("COPY parquet_chunk_loader FROM '" + parquet_file +
+                      "' WITH (parquet='true');");
+    auto rows = run_query(
+        "SELECT COUNT(*), SUM(i), COUNT(i), COUNT(t), SUM(CHAR_LENGTH(t)), COUNT(d), "
+        "COUNT(DISTINCT d), SUM(CASE WHEN d = 'x' THEN i ELSE 0 END) FROM "
+        "parquet_chunk_loader;");
+    const auto row = rows->getNextRow(true, true);
+    std::vector<int64_t> aggregates;
+    for (const auto& value : row) {
+      aggregates.push_back(v<int64_t>(value));
+    }
+    return aggregates;
+  };
+  // Columns the chunk loader supports, columns it doesn't so that the import is done
+  // value by value, and a not null column the parquet encoders reject the nulls of, in
+  // which case the import is rolled back and done again value by value.
+  for (const auto& columns : {"i INTEGER, t TEXT ENCODING NONE, d TEXT ENCODING DICT(32)",
+                              "i INTEGER ENCODING FIXED(16), t TEXT ENCODING NONE, d "
+                              "TEXT ENCODING DICT(16)",
+                              "i INTEGER NOT NULL, t TEXT ENCODING NONE, d TEXT "
+                              "ENCODING DICT(32)"}) {
+    std::pair<bool, std::vector<int64_t>> expected_result;
+    for (const bool enable_chunk_loader : {false, true}) {
+      g_enable_parquet_import_chunk_loader = enable_chunk_loader;
+      // Whether the import fails, and the rows it leaves otherwise.
+      std::pair<bool, std::vector<int64_t>> result{false, {}};
+      try {
+        result.second = import_and_aggregate(columns);
+      } catch (const std::exception&) {
+        result.first = true;
+      }
+      if (enable_chunk_loader) {
+        EXPECT_EQ(expected_result, result) << columns;
+      } else {
+        expected_result = result;
+      }
+    }
+  }
+  // The rows themselves, for the columns the chunk loader supports.
+  g_enable_parquet_import_chunk_loader = true;
+  EXPECT_EQ(std::vector<int64_t>({6, 18, 5, 5, 17, 4, 3, 5}),
+            import_and_aggregate(
+                "i INTEGER, t TEXT ENCODING NONE, d TEXT ENCODING DICT(32)"));
+}
 #ifdef HAVE_AWS_S3
 // s3 parquet test cases
 TEST_F(ImportTest, S3_One_parquet_file) {
@@ -2310,22 +2450,121 @@ TEST_F(ExportTest, CSV_Zip_Unimplemented) {
   RUN_TEST_ON_ALL_GEO_TYPES();
 }
 
-TEST_F(ExportTest, CSV_GZip_Unimplemented) {
+TEST_F(ExportTest, CSV_GZip) {
   SKIP_ALL_ON_AGGREGATOR();
   doCreateAndImport();
   auto run_test = [&](const std::string& geo_type) {
-    std::string exp_file = "query_export_test_geojson_" + geo_type + ".geojson";
-    EXPECT_THROW(doExport(exp_file, "CSV", "GZip", geo_type, WITH_ARRAYS, DEFAULT_SRID),
-                 std::runtime_error);
+    std::string exp_file = "query_export_test_csv_" + geo_type + ".csv";
+    ASSERT_NO_THROW(
+        doExport(exp_file, "CSV", "GZip", geo_type, WITH_ARRAYS, DEFAULT_SRID));
+    if (!g_regenerate_export_test_reference_files) {
+      // Same rows as the uncompressed export.
+      auto exported_lines =
+          readTextFile(BASE_PATH "/mapd_export/" + exp_file + ".gz", GZIPPED);
+      auto reference_lines = readTextFile(
+          "../../Tests/Export/QueryExport/datafiles/" + exp_file, PLAIN_TEXT);
+      std::sort(exported_lines.begin(), exported_lines.end());
+      std::sort(reference_lines.begin(), reference_lines.end());
+      compareLines(exported_lines, reference_lines, COMPARE_IGNORING_COMMA_DIFF);
+    }
+    doImportAgainAndCompare(exp_file + ".gz", "CSV", geo_type, WITH_ARRAYS);
+    ASSERT_NO_THROW(
+        boost::filesystem::remove(BASE_PATH "/mapd_export/" + exp_file + ".gz"));
+  };
+  RUN_TEST_ON_ALL_GEO_TYPES();
+}
+
+TEST_F(ExportTest, CSV_Parallel) {
+  SKIP_ALL_ON_AGGREGATOR();
+  // Small ranges so that the few rows of the test table are formatted in parallel.
+  const auto range_entries_state = g_csv_export_range_entries;
+  g_csv_export_range_entries = 2;
+  ScopeGuard reset_range_entries = [range_entries_state] {
+    g_csv_export_range_entries = range_entries_state;
+  };
+  doCreateAndImport();
+  auto run_test = [&](const std::string& geo_type) {
+    std::string exp_file = "query_export_test_csv_" + geo_type + ".csv";
+    ASSERT_NO_THROW(doExport(exp_file, "CSV", "", geo_type, WITH_ARRAYS, DEFAULT_SRID));
+    ASSERT_NO_THROW(doCompareText(exp_file, PLAIN_TEXT));
+    removeExportedFile(exp_file);
+    ASSERT_NO_THROW(
+        doExport(exp_file, "CSV", "GZip", geo_type, WITH_ARRAYS, DEFAULT_SRID));
+    doImportAgainAndCompare(exp_file + ".gz", "CSV", geo_type, WITH_ARRAYS);
+    ASSERT_NO_THROW(
+        boost::filesystem::remove(BASE_PATH "/mapd_export/" + exp_file + ".gz"));
   };
   RUN_TEST_ON_ALL_GEO_TYPES();
 }
 
+TEST_F(ExportTest, CSV_GZip_InvalidName) {
+  SKIP_ALL_ON_AGGREGATOR();
+  doCreateAndImport();
+  std::string geo_type = "point";
+  std::string exp_file = "query_export_test_geojson_" + geo_type + ".geojson";
+  EXPECT_THROW(doExport(exp_file, "CSV", "GZip", geo_type, WITH_ARRAYS, DEFAULT_SRID),
+               std::runtime_error);
+}
+
 TEST_F(ExportTest, CSV_Nulls) {
   SKIP_ALL_ON_AGGREGATOR();
   ASSERT_NO_THROW(doTestNulls("query_export_test_csv_nulls.csv", "CSV", "*"));
 }
 
+#ifdef ENABLE_IMPORT_PARQUET
+TEST_F(ExportTest, Parquet) {
+  SKIP_ALL_ON_AGGREGATOR();
+  // Small row groups so that the test table is written as several of them.
+  const auto row_group_rows_state = g_parquet_export_row_group_rows;
+  g_parquet_export_row_group_rows = 2;
+  ScopeGuard reset_row_group_rows = [row_group_rows_state] {
+    g_parquet_export_row_group_rows = row_group_rows_state;
+  };
+  doCreateAndImport();
+  for (const auto file_compression : {"None", "GZip"}) {
+    std::string exp_file = BASE_PATH "/mapd_export/query_export_test_parquet.parquet";
+    ASSERT_NO_THROW(run_ddl_statement(
+        "COPY (SELECT col_big, col_dict_text1, col_double, col_ts3 FROM "
+        "query_export_test) TO '" +
+        exp_file + "' WITH (file_type='Parquet', file_compression='" +
+        file_compression + "');"));
+    ASSERT_NO_THROW(
+        run_ddl_statement("CREATE TABLE query_export_test_reimport (col_big BIGINT, "
+                          "col_dict_text1 TEXT ENCODING DICT(32), col_double DOUBLE, "
+                          "col_ts3 TIMESTAMP(3));"));
+    ASSERT_NO_THROW(run_ddl_statement("COPY query_export_test_reimport FROM '" +
+                                      exp_file + "' WITH (parquet='true');"));
+    // Same rows as the exported table.
+    const std::string aggregates{
+        "SELECT COUNT(*), SUM(col_big), COUNT(DISTINCT col_dict_text1), "
+        "SUM(col_double), MAX(col_ts3) FROM "};
+    {
+      auto rows = run_query(aggregates + "query_export_test;");
+      auto reimport_rows = run_query(aggregates + "query_export_test_reimport;");
+      const auto crt_row = rows->getNextRow(true, true);
+      const auto reimport_row = reimport_rows->getNextRow(true, true);
+      ASSERT_EQ(v<int64_t>(crt_row[0]), v<int64_t>(reimport_row[0]));
+      ASSERT_EQ(v<int64_t>(crt_row[1]), v<int64_t>(reimport_row[1]));
+      ASSERT_EQ(v<int64_t>(crt_row[2]), v<int64_t>(reimport_row[2]));
+      ASSERT_DOUBLE_EQ(v<double>(crt_row[3]), v<double>(reimport_row[3]));
+      ASSERT_EQ(v<int64_t>(crt_row[4]), v<int64_t>(reimport_row[4]));
+    }
+    ASSERT_NO_THROW(run_ddl_statement("DROP TABLE query_export_test_reimport;"));
+    ASSERT_NO_THROW(boost::filesystem::remove(exp_file));
+  }
+}
+
+TEST_F(ExportTest, Parquet_UnsupportedType) {
+  SKIP_ALL_ON_AGGREGATOR();
+  doCreateAndImport();
+  EXPECT_THROW(run_ddl_statement("COPY (SELECT col_point FROM query_export_test) TO '" +
+                                 std::string(BASE_PATH) +
+                                 "/mapd_export/query_export_test_parquet.parquet' WITH "
+                                 "(file_type='Parquet');"),
+               std::runtime_error);
+}
+#endif  // ENABLE_IMPORT_PARQUET
+
 TEST_F(ExportTest, GeoJSON) {
   SKIP_ALL_ON_AGGREGATOR();
   doCreateAndImport();
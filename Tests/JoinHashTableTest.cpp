@@ -32,8 +32,10 @@
 #include "QueryEngine/ExtensionFunctionsWhitelist.h"
 #include "QueryEngine/ExternalCacheInvalidators.h"
 #include "QueryEngine/JoinHashTable/OverlapsJoinHashTable.h"
+#include "QueryEngine/JoinHashTable/PerfectJoinHashTable.h"
 #include "QueryEngine/ResultSet.h"
 #include "QueryRunner/QueryRunner.h"
+#include "Shared/scope.h"
 #include "Shared/thread_count.h"
 #include "TestHelpers.h"
 
@@ -44,6 +46,9 @@
 using namespace Catalog_Namespace;
 using namespace TestHelpers;
 
+extern bool g_enable_radix_partitioned_join_build;
+extern size_t g_radix_partitioned_join_build_partition_bytes;
+
 using QR = QueryRunner::QueryRunner;
 
 namespace {
@@ -450,6 +455,92 @@ TEST(Build, KeyedOneToMany) {
   }
 }
 
+TEST(Build, KeyedRadixPartitioned) {
+  auto catalog = QR::get()->getCatalog();
+  CHECK(catalog);
+
+  auto executor = Executor::getExecutor(catalog->getCurrentDB().dbId);
+  CHECK(executor);
+  executor->setCatalog(catalog.get());
+
+  ScopeGuard reset = [orig_enable = g_enable_radix_partitioned_join_build,
+                      orig_partition_bytes =
+                          g_radix_partitioned_join_build_partition_bytes] {
+    g_enable_radix_partitioned_join_build = orig_enable;
+    g_radix_partitioned_join_build_partition_bytes = orig_partition_bytes;
+  };
+  // The partitioned build only runs on CPU, over tables spanning at least 4 partitions
+  // per build thread; 64 byte partitions get there with a few thousand keys.
+  g_device_type = ExecutorDeviceType::CPU;
+  g_radix_partitioned_join_build_partition_bytes = 64;
+
+  // table2 holds the keys 0 to 4095 once, then the keys under 100 twice.
+  sql(R"(
+    drop table if exists table1;
+    drop table if exists table2;
+
+    create table table1 (a1 integer, a2 integer);
+    create table table2 (b integer);
+
+    insert into table1 values (1, 1);
+    insert into table1 values (2, 3);
+    insert into table1 values (99, 99);
+    insert into table1 values (100, 100);
+    insert into table1 values (4095, 4095);
+    insert into table1 values (4096, 4096);
+
+    insert into table2 values (0);
+    insert into table2 values (1);
+  )");
+  for (int keys = 2; keys < 4096; keys *= 2) {
+    sql("insert into table2 select b + " + std::to_string(keys) + " from table2;");
+  }
+
+  auto a1 = getSyntheticColumnVar("table1", "a1", 0, executor.get());
+  auto a2 = getSyntheticColumnVar("table1", "a2", 0, executor.get());
+  auto b = getSyntheticColumnVar("table2", "b", 1, executor.get());
+
+  using VE = std::vector<std::shared_ptr<Analyzer::Expr>>;
+  auto et1 = std::make_shared<Analyzer::ExpressionTuple>(VE{a1, a2});
+  auto et2 = std::make_shared<Analyzer::ExpressionTuple>(VE{b, b});
+
+  // a1 = b and a2 = b
+  auto op = std::make_shared<Analyzer::BinOper>(kBOOLEAN, kEQ, kONE, et1, et2);
+  auto build_and_join = [&op](const bool enable_radix_partitioning) {
+    g_enable_radix_partitioned_join_build = enable_radix_partitioning;
+    JoinHashTableCacheInvalidator::invalidateCaches();
+    auto hash_table = buildKeyed(op);
+    CHECK(std::dynamic_pointer_cast<BaselineJoinHashTable>(hash_table));
+    const auto rows = QR::get()->runSQL(
+        "select count(*), sum(b) from table1, table2 where a1 = b and a2 = b;",
+        g_device_type);
+    const auto row = rows->getNextRow(true, true);
+    CHECK_EQ(row.size(), size_t(2));
+    return std::make_tuple(hash_table->getHashType(),
+                           hash_table->toSet(g_device_type, 0),
+                           v<int64_t>(row[0]),
+                           v<int64_t>(row[1]));
+  };
+
+  // one-to-one keys
+  const auto regular_one_to_one = build_and_join(false);
+  EXPECT_EQ(std::get<0>(regular_one_to_one), HashType::OneToOne);
+  EXPECT_EQ(std::get<2>(regular_one_to_one), 4);
+  EXPECT_EQ(regular_one_to_one, build_and_join(true));
+
+  // one-to-many keys
+  sql("insert into table2 select b from table2 where b < 100;");
+  const auto regular_one_to_many = build_and_join(false);
+  EXPECT_EQ(std::get<0>(regular_one_to_many), HashType::OneToMany);
+  EXPECT_EQ(std::get<2>(regular_one_to_many), 6);
+  EXPECT_EQ(regular_one_to_many, build_and_join(true));
+
+  sql(R"(
+    drop table if exists table1;
+    drop table if exists table2;
+  )");
+}
+
 TEST(Build, GeoOneToMany1) {
   auto catalog = QR::get()->getCatalog();
   CHECK(catalog);
@@ -920,6 +1011,58 @@ TEST(MultiFragment, KeyedOneToMany) {
   }
 }
 
+TEST(MultiDevice, PerfectBroadcast) {
+  g_device_type = ExecutorDeviceType::GPU;
+  if (skip_tests(g_device_type)) {
+    LOG(WARNING) << "GPU not available, skipping GPU tests";
+    return;
+  }
+  ScopeGuard reset = [orig = g_enable_hash_table_gpu_broadcast] {
+    g_enable_hash_table_gpu_broadcast = orig;
+  };
+
+  sql(R"(
+    drop table if exists table1;
+    drop table if exists table2;
+
+    create table table1 (nums1 integer);
+    create table table2 (nums2 integer) with (fragment_size = 3);
+
+    insert into table1 values (1);
+    insert into table1 values (7);
+
+    insert into table2 values (0);
+    insert into table2 values (1);
+    insert into table2 values (1);
+    insert into table2 values (3);
+    insert into table2 values (7);
+    insert into table2 values (7);
+    insert into table2 values (9);
+  )");
+
+  const auto device_count = deviceCount(QR::get()->getCatalog().get(), g_device_type);
+
+  JoinHashTableCacheInvalidator::invalidateCaches();
+  g_enable_hash_table_gpu_broadcast = false;
+  auto built_per_device = buildPerfect("table1", "nums1", "table2", "nums2");
+
+  JoinHashTableCacheInvalidator::invalidateCaches();
+  g_enable_hash_table_gpu_broadcast = true;
+  auto broadcast = buildPerfect("table1", "nums1", "table2", "nums2");
+  EXPECT_EQ(broadcast->getHashType(), HashType::OneToMany);
+
+  // Every device gets the table device 0 built, equal to the one built per device.
+  for (int device_id = 0; device_id < device_count; ++device_id) {
+    EXPECT_EQ(broadcast->toSet(g_device_type, device_id),
+              built_per_device->toSet(g_device_type, device_id));
+  }
+
+  sql(R"(
+    drop table if exists table1;
+    drop table if exists table2;
+  )");
+}
+
 TEST(Other, Regression) {
   sql(R"(
       drop table if exists table_a;
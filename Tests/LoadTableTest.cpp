@@ -23,16 +23,23 @@
 #ifdef HAVE_AWS_S3
 #include "AwsHelpers.h"
 #include "DataMgr/OmniSciAwsSdk.h"
+#include "Fragmenter/InsertOrderFragmenter.h"
 #include "Shared/ThriftTypesConvert.h"
 #endif  // HAVE_AWS_S3
+#include "QueryEngine/QueryResultCache.h"
 #include "Shared/ArrowUtil.h"
+#include "Shared/Compressor.h"
+#include "Shared/scope.h"
 #include "Tests/DBHandlerTestHelpers.h"
 #include "Tests/TestHelpers.h"
+#include "ThriftHandler/DeferredCheckpointScheduler.h"
 
 #ifndef BASE_PATH
 #define BASE_PATH "./tmp"
 #endif
 
+extern bool g_enable_dictionary_encoding_widening;
+
 class LoadTableTest : public DBHandlerTestFixture {
  protected:
   void SetUp() override {
@@ -219,6 +226,71 @@ TEST_F(LoadTableTest, BinaryAllColumnsNoGeo) {
   sqlAndCompareResult("SELECT * FROM load_test", {{i(1), "s", "nns"}});
 }
 
+TEST_F(LoadTableTest, DeferredCheckpoint) {
+  g_deferred_load_checkpoint_rows = 3;
+  ScopeGuard reset_deferred_checkpoint_rows = [] {
+    g_deferred_load_checkpoint_rows = 0;
+    DeferredCheckpointScheduler::checkpointDeferredTables();
+  };
+  auto* handler = getDbHandlerAndSessionId().first;
+  auto& session = getDbHandlerAndSessionId().second;
+  const auto td = getCatalog().getMetadataForTable("load_test", false);
+  ASSERT_NE(td, nullptr);
+  const auto db_id = getCatalog().getDatabaseId();
+  TRow row;
+  row.cols = {i1_datum, s_datum, nns_datum};
+
+  // Rows of deferred loads are visible before the table is checkpointed.
+  handler->load_table_binary(session, "load_test", {row}, {});
+  handler->load_table_binary(session, "load_test", {row}, {});
+  EXPECT_EQ(DeferredCheckpointScheduler::getDeferredRowCount(db_id, td->tableId), 2U);
+  sqlAndCompareResult("SELECT COUNT(*) FROM load_test", {{i(2)}});
+
+  // Reaching the row threshold checkpoints the table.
+  handler->load_table_binary(session, "load_test", {row}, {});
+  EXPECT_EQ(DeferredCheckpointScheduler::getDeferredRowCount(db_id, td->tableId), 0U);
+  sqlAndCompareResult("SELECT COUNT(*) FROM load_test", {{i(3)}});
+
+  handler->load_table_binary(session, "load_test", {row}, {});
+  EXPECT_EQ(DeferredCheckpointScheduler::getDeferredRowCount(db_id, td->tableId), 1U);
+  DeferredCheckpointScheduler::checkpointDeferredTables();
+  EXPECT_EQ(DeferredCheckpointScheduler::getDeferredRowCount(db_id, td->tableId), 0U);
+  sqlAndCompareResult("SELECT COUNT(*) FROM load_test", {{i(4)}});
+}
+
+TEST_F(LoadTableTest, QueryResultCache) {
+  g_query_result_cache_max_bytes = 1 << 20;
+  ScopeGuard reset_query_result_cache_max_bytes = [] {
+    g_query_result_cache_max_bytes = 0;
+    QueryResultCache::instance().clear();
+  };
+  QueryResultCache::instance().clear();
+  auto* handler = getDbHandlerAndSessionId().first;
+  auto& session = getDbHandlerAndSessionId().second;
+  TRow row;
+  row.cols = {i1_datum, s_datum, nns_datum};
+
+  handler->load_table_binary(session, "load_test", {row}, {});
+  sqlAndCompareResult("SELECT COUNT(*) FROM load_test", {{i(1)}});
+  EXPECT_EQ(QueryResultCache::instance().getNumberOfCachedResults(), 1U);
+  sqlAndCompareResult("SELECT COUNT(*) FROM load_test", {{i(1)}});
+  EXPECT_EQ(QueryResultCache::instance().getNumberOfCachedResults(), 1U);
+
+  // Loads change the key of the results of the table.
+  handler->load_table_binary(session, "load_test", {row}, {});
+  sqlAndCompareResult("SELECT COUNT(*) FROM load_test", {{i(2)}});
+  EXPECT_EQ(QueryResultCache::instance().getNumberOfCachedResults(), 2U);
+
+  // Deletes clear the cache.
+  sql("DELETE FROM load_test WHERE i1 = 1;");
+  EXPECT_EQ(QueryResultCache::instance().getNumberOfCachedResults(), 0U);
+  sqlAndCompareResult("SELECT COUNT(*) FROM load_test", {{i(0)}});
+
+  // Non-deterministic results are not cached.
+  sql("SELECT NOW() FROM load_test;");
+  EXPECT_EQ(QueryResultCache::instance().getNumberOfCachedResults(), 1U);
+}
+
 TEST_F(LoadTableTest, DictOutOfBounds) {
   auto* handler = getDbHandlerAndSessionId().first;
   auto& session = getDbHandlerAndSessionId().second;
@@ -242,6 +314,51 @@ TEST_F(LoadTableTest, DictOutOfBounds) {
   sqlAndCompareResult("SELECT count(*) FROM load_test", {{i(0)}});
 }
 
+TEST_F(LoadTableTest, DictEncodingWidening) {
+  auto* handler = getDbHandlerAndSessionId().first;
+  auto& session = getDbHandlerAndSessionId().second;
+  g_enable_dictionary_encoding_widening = true;
+  ScopeGuard reset_widening = [] { g_enable_dictionary_encoding_widening = false; };
+  auto load_strings = [&](const int begin, const int end) {
+    std::vector<TRow> rows;
+    for (int i = begin; i < end; i++) {
+      TRow row;
+      TDatum str_datum;
+      str_datum.is_null = false;
+      str_datum.val.str_val = std::to_string(i);
+      row.cols = {i1_datum, str_datum, nns_datum};
+      rows.emplace_back(row);
+    }
+    handler->load_table_binary(session, "load_test", rows, {});
+  };
+  auto get_encoding_size = [&]() {
+    const auto& cat = getCatalog();
+    const auto td = cat.getMetadataForTable("load_test");
+    CHECK(td);
+    const auto cd = cat.getMetadataForColumn(td->tableId, "s");
+    CHECK(cd);
+    return cd->columnType.get_size();
+  };
+
+  // fits in 8 bits
+  load_strings(0, 200);
+  EXPECT_EQ(get_encoding_size(), 1);
+
+  // the existing chunks are rewritten with 16 bit ids
+  load_strings(200, 300);
+  EXPECT_EQ(get_encoding_size(), 2);
+  sqlAndCompareResult("SELECT count(*), count(distinct s) FROM load_test",
+                      {{i(300), i(300)}});
+  sqlAndCompareResult("SELECT count(*) FROM load_test WHERE s = '7' OR s = '254'",
+                      {{i(2)}});
+  sqlAndCompareResult("SELECT count(*) FROM load_test WHERE s IS NULL", {{i(0)}});
+
+  // a batch of strings that are all in the dictionary keeps the width
+  load_strings(0, 300);
+  EXPECT_EQ(get_encoding_size(), 2);
+  sqlAndCompareResult("SELECT count(distinct s) FROM load_test", {{i(300)}});
+}
+
 // TODO(max): load_table_binary doesn't support tables with geo columns yet
 TEST_F(LoadTableTest, DISABLED_BinaryAllColumns) {
   auto* handler = getDbHandlerAndSessionId().first;
@@ -442,6 +559,43 @@ TEST_F(LoadTableTest, ColumnarNoColumns) {
       "No columns to insert");
 }
 
+TEST_F(LoadTableTest, ColumnarWideTable) {
+  constexpr size_t num_int_columns{64};
+  constexpr size_t num_rows{2000};
+  std::string create_table{"CREATE TABLE wide_load_test("};
+  std::vector<TColumn> columns(num_int_columns + 1);
+  for (size_t col = 0; col < num_int_columns; ++col) {
+    create_table += "c" + std::to_string(col) + " INTEGER, ";
+    for (size_t row = 0; row < num_rows; ++row) {
+      columns[col].data.int_col.push_back(row + col);
+    }
+  }
+  create_table += "s TEXT ENCODING DICT(32));";
+  for (size_t row = 0; row < num_rows; ++row) {
+    columns.back().data.str_col.push_back("s" + std::to_string(row % 10));
+  }
+  for (auto& column : columns) {
+    column.nulls.resize(num_rows, false);
+  }
+  sql("DROP TABLE IF EXISTS wide_load_test;");
+  sql(create_table);
+  ScopeGuard reset_parallel_column_inserts = [orig = g_enable_parallel_column_inserts] {
+    g_enable_parallel_column_inserts = orig;
+  };
+
+  // Both ways of appending the columns to their chunks store the same rows.
+  auto* handler = getDbHandlerAndSessionId().first;
+  auto& session = getDbHandlerAndSessionId().second;
+  g_enable_parallel_column_inserts = false;
+  handler->load_table_binary_columnar(session, "wide_load_test", columns, {});
+  g_enable_parallel_column_inserts = true;
+  handler->load_table_binary_columnar(session, "wide_load_test", columns, {});
+  sqlAndCompareResult(
+      "SELECT COUNT(*), SUM(c0), SUM(c63), COUNT(DISTINCT s) FROM wide_load_test;",
+      {{i(2 * num_rows), i(3998000), i(4250000), i(10)}});
+  sql("DROP TABLE wide_load_test;");
+}
+
 // A small helper to build Arrow stream for load_table_binary_arrow
 class ArrowStreamBuilder {
  public:
@@ -501,6 +655,101 @@ TEST_F(LoadTableTest, ArrowAllColumnsNoGeo) {
   sqlAndCompareResult("SELECT * FROM load_test", {{i(1), "s", "nns"}});
 }
 
+TEST_F(LoadTableTest, ArrowNullsNoGeo) {
+  auto* handler = getDbHandlerAndSessionId().first;
+  auto& session = getDbHandlerAndSessionId().second;
+  auto schema = arrow::schema({i1_field, s_field, nns_field});
+  ArrowStreamBuilder builder(schema);
+  builder.appendInt32({1, 0, 3}, {false, true, false});
+  builder.appendString({"s1", "", "s3"}, {false, true, false});
+  builder.appendString({"nns1", "nns2", "nns3"});
+  handler->load_table_binary_arrow(session, "load_test", builder.finish(), false);
+  sqlAndCompareResult("SELECT * FROM load_test ORDER BY nns;",
+                      {{i(1), "s1", "nns1"},
+                       {nullptr, nullptr, "nns2"},
+                       {i(3), "s3", "nns3"}});
+}
+
+TEST_F(LoadTableTest, ColumnBuffersResult) {
+  auto* handler = getDbHandlerAndSessionId().first;
+  auto& session = getDbHandlerAndSessionId().second;
+  auto schema = arrow::schema({i1_field, s_field, nns_field});
+  ArrowStreamBuilder builder(schema);
+  builder.appendInt32({1, 0, 3}, {false, true, false});
+  builder.appendString({"s1", "", "s3"}, {false, true, false});
+  builder.appendString({"nns1", "nns2", "nns3"});
+  handler->load_table_binary_arrow(session, "load_test", builder.finish(), false);
+  const std::string query{"SELECT i1, s, nns FROM load_test ORDER BY nns;"};
+
+  TQueryResult result;
+  handler->sql_execute_buffers(result, session, query, false, "", -1, -1);
+  ASSERT_EQ(result.row_set.column_encoding, TColumnEncoding::BUFFERS);
+  const auto& columns = result.row_set.columns;
+  ASSERT_EQ(columns.size(), size_t(3));
+  ASSERT_EQ(columns[0].values.size(), 3 * sizeof(int32_t));
+  const auto i1_values = reinterpret_cast<const int32_t*>(columns[0].values.data());
+  EXPECT_EQ(i1_values[0], 1);
+  EXPECT_EQ(i1_values[2], 3);
+  EXPECT_TRUE(columns[0].offsets.empty());
+  EXPECT_EQ(columns[0].null_bitmap, std::string(1, 0x02));
+  EXPECT_TRUE(columns[0].data.int_col.empty());
+  EXPECT_TRUE(columns[0].nulls.empty());
+  EXPECT_EQ(columns[1].values, "s1s3");
+  ASSERT_EQ(columns[1].offsets.size(), 4 * sizeof(int32_t));
+  const auto s_offsets = reinterpret_cast<const int32_t*>(columns[1].offsets.data());
+  EXPECT_EQ(std::vector<int32_t>(s_offsets, s_offsets + 4),
+            std::vector<int32_t>({0, 2, 2, 4}));
+  EXPECT_EQ(columns[1].null_bitmap, std::string(1, 0x02));
+  EXPECT_EQ(columns[2].values, "nns1nns2nns3");
+  EXPECT_TRUE(columns[2].null_bitmap.empty());
+
+  TQueryResult compressed_result;
+  handler->sql_execute_buffers(compressed_result, session, query, true, "", -1, -1);
+  ASSERT_EQ(compressed_result.row_set.column_encoding,
+            TColumnEncoding::COMPRESSED_BUFFERS);
+  const auto decompress = [](const std::string& buffer, const size_t size) {
+    if (buffer.empty()) {
+      return std::string{};
+    }
+    std::string decompressed(size, '\0');
+    EXPECT_EQ(BloscCompressor::decompressBlock(
+                  reinterpret_cast<const uint8_t*>(buffer.data()),
+                  reinterpret_cast<uint8_t*>(&decompressed[0]),
+                  decompressed.size()),
+              size);
+    return decompressed;
+  };
+  ASSERT_EQ(compressed_result.row_set.columns.size(), size_t(3));
+  for (size_t i = 0; i < columns.size(); ++i) {
+    const auto& compressed_column = compressed_result.row_set.columns[i];
+    EXPECT_EQ(decompress(compressed_column.values, columns[i].values.size()),
+              columns[i].values);
+    EXPECT_EQ(decompress(compressed_column.offsets, columns[i].offsets.size()),
+              columns[i].offsets);
+    EXPECT_EQ(decompress(compressed_column.null_bitmap, columns[i].null_bitmap.size()),
+              columns[i].null_bitmap);
+  }
+}
+
+TEST_F(LoadTableTest, ColumnBuffersResultGeo) {
+  auto* handler = getDbHandlerAndSessionId().first;
+  auto& session = getDbHandlerAndSessionId().second;
+  TStringRow row;
+  row.cols = {
+      getSV("1"), getSV(LINESTRING), getSV("s"), getSV(MULTIPOLYGON), getSV("nns")};
+  handler->load_table(session, "geo_load_test", {row}, {});
+  TQueryResult result;
+  handler->sql_execute_buffers(
+      result, session, "SELECT i1, ls FROM geo_load_test;", false, "", -1, -1);
+  ASSERT_EQ(result.row_set.columns.size(), size_t(2));
+  // Geo columns keep the list encoding.
+  const auto& ls_column = result.row_set.columns[1];
+  EXPECT_TRUE(ls_column.values.empty());
+  EXPECT_EQ(ls_column.data.str_col, std::vector<std::string>({LINESTRING}));
+  EXPECT_EQ(ls_column.nulls, std::vector<bool>({false}));
+  EXPECT_EQ(result.row_set.columns[0].values.size(), sizeof(int32_t));
+}
+
 // TODO (max) load_table_binary_arrow doesn't support tables with geocolumns properly yet
 TEST_F(LoadTableTest, DISABLED_ArrowAllColumns) {
   auto* handler = getDbHandlerAndSessionId().first;
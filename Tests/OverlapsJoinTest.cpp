@@ -538,6 +538,36 @@ TEST_F(OverlapsTest, SkipHashtableCaching) {
   ASSERT_EQ(QR::get()->getNumberOfCachedOverlapsHashTables(), (size_t)0);
 }
 
+TEST_F(OverlapsTest, SampledAutoTuning) {
+  const auto enable_overlaps_hashjoin_state = g_enable_overlaps_hashjoin;
+  const auto enable_hashjoin_many_to_many_state = g_enable_hashjoin_many_to_many;
+  const auto overlaps_tuning_sample_rows_state = g_overlaps_tuning_sample_rows;
+
+  g_enable_overlaps_hashjoin = true;
+  g_enable_hashjoin_many_to_many = true;
+  g_trivial_loop_join_threshold = 1;
+  g_overlaps_tuning_sample_rows = 1;
+
+  ScopeGuard reset_overlaps_state = [&enable_overlaps_hashjoin_state,
+                                     &enable_hashjoin_many_to_many_state,
+                                     &overlaps_tuning_sample_rows_state] {
+    g_enable_overlaps_hashjoin = enable_overlaps_hashjoin_state;
+    g_enable_hashjoin_many_to_many = enable_hashjoin_many_to_many_state;
+    g_trivial_loop_join_threshold = 1000;
+    g_overlaps_tuning_sample_rows = overlaps_tuning_sample_rows_state;
+  };
+
+  // the tuning steps only count one of the inner rows, the hash table is then sized from
+  // all of them
+  QR::get()->clearCpuMemory();
+  const auto sql = R"(SELECT count(*) from does_intersect_a as a
+                      JOIN does_intersect_b as b
+                      ON ST_Intersects(a.poly, b.poly);)";
+  ASSERT_EQ(static_cast<int64_t>(4),
+            v<int64_t>(execSQL(sql, ExecutorDeviceType::CPU)));
+  QR::get()->clearCpuMemory();
+}
+
 TEST_F(OverlapsTest, CacheBehaviorUnderQueryHint) {
   // consider the following symbols:
   // T_E: bucket_threshold_hint_enabled
@@ -25,6 +25,7 @@
 #include "Logger/Logger.h"
 #include "QueryEngine/Descriptors/RelAlgExecutionDescriptor.h"
 #include "QueryEngine/Execute.h"
+#include "QueryEngine/QueryDispatchQueue.h"
 #include "QueryRunner/QueryRunner.h"
 
 #ifndef BASE_PATH
@@ -527,6 +528,47 @@ TEST_F(UpdateDeleteTestEnv, UpdateDelete_TwoTables) {
   }
 }
 
+TEST(QueryDispatchQueue, Priorities) {
+  QueryDispatchQueue dispatch_queue(/*parallel_executors_max=*/1);
+  std::promise<void> release_worker;
+  auto worker_released = release_worker.get_future().share();
+  std::mutex run_order_mutex;
+  std::vector<std::string> run_order;
+  auto make_task = [&](const std::string& name) {
+    return std::make_shared<QueryDispatchQueue::Task>([&, name](const size_t) {
+      worker_released.wait();
+      std::lock_guard<std::mutex> lock(run_order_mutex);
+      run_order.push_back(name);
+    });
+  };
+
+  // The first task keeps the only worker busy while the others are queued.
+  auto first_task = make_task("first");
+  dispatch_queue.submit(first_task, false, QueryDispatchQueue::Priority::Low);
+  while (dispatch_queue.getQueueTimeStats(QueryDispatchQueue::Priority::Low)
+             .dispatched_count == 0) {
+    std::this_thread::yield();
+  }
+  auto low_task = make_task("low");
+  dispatch_queue.submit(low_task, false, QueryDispatchQueue::Priority::Low);
+  auto normal_task = make_task("normal");
+  dispatch_queue.submit(normal_task, false, QueryDispatchQueue::Priority::Normal);
+  auto high_task = make_task("high");
+  dispatch_queue.submit(high_task, false, QueryDispatchQueue::Priority::High);
+  release_worker.set_value();
+  for (auto& task : {first_task, low_task, normal_task, high_task}) {
+    task->get_future().get();
+  }
+
+  EXPECT_EQ(run_order, (std::vector<std::string>{"first", "high", "normal", "low"}));
+  EXPECT_EQ(dispatch_queue.getQueueTimeStats(QueryDispatchQueue::Priority::High)
+                .dispatched_count,
+            size_t(1));
+  EXPECT_EQ(dispatch_queue.getQueueTimeStats(QueryDispatchQueue::Priority::Low)
+                .dispatched_count,
+            size_t(2));
+}
+
 int main(int argc, char* argv[]) {
   g_is_test_env = true;
 
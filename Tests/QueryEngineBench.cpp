@@ -0,0 +1,335 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * Micro-benchmarks of the hot paths of the query engine which do not need a query to
+ * run: hash join build and probe, group by reduction, result set sort and Arrow
+ * conversion, string dictionary encoding and delimited parsing.
+ *
+ * Run with --benchmark_out=<file> --benchmark_out_format=json to record the results,
+ * ThirdParty/googlebenchmark/tools/compare.py compares two such files.
+ */
+
+#include "TestHelpers.h"
+
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <mutex>
+#include <numeric>
+#include <random>
+
+#include "ImportExport/CopyParams.h"
+#include "ImportExport/DelimitedParserUtils.h"
+#include "Logger/Logger.h"
+#include "QueryEngine/ArrowResultSet.h"
+#include "QueryEngine/Descriptors/RowSetMemoryOwner.h"
+#include "QueryEngine/Execute.h"
+#include "QueryEngine/JoinHashTable/Runtime/HashJoinRuntime.h"
+#include "QueryEngine/ResultSet.h"
+#include "QueryEngine/ResultSetReductionJIT.h"
+#include "QueryEngine/RuntimeFunctions.h"
+#include "QueryRunner/QueryRunner.h"
+#include "StringDictionary/StringDictionary.h"
+#include "Tests/ResultSetTestUtils.h"
+
+#ifndef BASE_PATH
+#define BASE_PATH "./tmp"
+#endif
+
+extern bool g_is_test_env;
+
+using QR = QueryRunner::QueryRunner;
+
+namespace {
+
+std::once_flag setup_flag;
+void global_setup() {
+  g_is_test_env = true;
+  TestHelpers::init_logger_stderr_only();
+  QR::init(BASE_PATH);
+}
+
+constexpr int32_t kInvalidSlot{-1};
+
+// Distinct keys in [0, count), in random order.
+std::vector<int32_t> make_shuffled_keys(const size_t count) {
+  std::vector<int32_t> keys(count);
+  std::iota(keys.begin(), keys.end(), 0);
+  std::shuffle(keys.begin(), keys.end(), std::mt19937(42));
+  return keys;
+}
+
+JoinColumnTypeInfo make_type_info(const size_t count) {
+  return {sizeof(int32_t),
+          0,
+          static_cast<int64_t>(count) - 1,
+          inline_int_null_val(SQLTypeInfo(kINT, false)),
+          false,
+          0,
+          Signed};
+}
+
+void build_perfect_hash_table(std::vector<int32_t>& hash_table,
+                              const std::vector<int32_t>& keys) {
+  JoinChunk chunk{reinterpret_cast<const int8_t*>(keys.data()), keys.size()};
+  const JoinColumn join_column{reinterpret_cast<const int8_t*>(&chunk),
+                               sizeof(chunk),
+                               1,
+                               keys.size(),
+                               sizeof(int32_t)};
+  const auto type_info = make_type_info(keys.size());
+  init_hash_join_buff(hash_table.data(), hash_table.size(), kInvalidSlot, 0, 1);
+  const auto err = fill_hash_join_buff_bucketized(hash_table.data(),
+                                                  kInvalidSlot,
+                                                  false,
+                                                  join_column,
+                                                  type_info,
+                                                  nullptr,
+                                                  nullptr,
+                                                  0,
+                                                  1,
+                                                  1);
+  CHECK_EQ(err, 0);
+}
+
+std::vector<TargetInfo> reduction_target_infos() {
+  return generate_custom_agg_target_infos({8},
+                                          {kSUM, kCOUNT, kMIN, kMAX, kAVG},
+                                          {kBIGINT, kBIGINT, kBIGINT, kBIGINT, kDOUBLE},
+                                          {kBIGINT, kBIGINT, kBIGINT, kBIGINT, kBIGINT});
+}
+
+std::unique_ptr<ResultSet> make_filled_result_set(
+    const std::vector<TargetInfo>& target_infos,
+    const QueryMemoryDescriptor& query_mem_desc,
+    const std::shared_ptr<RowSetMemoryOwner>& row_set_mem_owner) {
+  auto rs = std::make_unique<ResultSet>(target_infos,
+                                        ExecutorDeviceType::CPU,
+                                        query_mem_desc,
+                                        row_set_mem_owner,
+                                        nullptr,
+                                        0,
+                                        0);
+  const auto storage = rs->allocateStorage();
+  EvenNumberGenerator generator;
+  fill_storage_buffer(
+      storage->getUnderlyingBuffer(), target_infos, query_mem_desc, generator, 1);
+  return rs;
+}
+
+// Reduces `count` result sets of the given layout into the first one.
+std::shared_ptr<ResultSet> make_reduced_result_set(const size_t entry_count,
+                                                   const size_t count) {
+  const auto target_infos = reduction_target_infos();
+  const auto query_mem_desc =
+      perfect_hash_one_col_desc(target_infos, 8, 0, entry_count - 1);
+  const auto row_set_mem_owner =
+      std::make_shared<RowSetMemoryOwner>(Executor::getArenaBlockSize());
+  std::vector<std::unique_ptr<ResultSet>> result_sets;
+  std::vector<ResultSet*> storage_set;
+  for (size_t i = 0; i < count; ++i) {
+    result_sets.push_back(
+        make_filled_result_set(target_infos, query_mem_desc, row_set_mem_owner));
+    storage_set.push_back(result_sets.back().get());
+  }
+  ResultSetManager rs_manager;
+  rs_manager.reduce(storage_set);
+  return std::shared_ptr<ResultSet>(std::move(result_sets.front()));
+}
+
+std::vector<std::string> make_strings(const size_t count, const size_t distinct_count) {
+  std::vector<std::string> strings;
+  strings.reserve(count);
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<size_t> dist(0, distinct_count - 1);
+  for (size_t i = 0; i < count; ++i) {
+    strings.push_back("str_" + std::to_string(dist(gen)));
+  }
+  return strings;
+}
+
+std::string make_delimited_rows(const size_t count) {
+  std::string rows;
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int32_t> dist(0, 1000000);
+  for (size_t i = 0; i < count; ++i) {
+    rows += std::to_string(dist(gen)) + "," + std::to_string(dist(gen) / 7.0) +
+            ",\"quoted, " + std::to_string(i) + "\",2021-01-0" +
+            std::to_string(1 + i % 9) + "\n";
+  }
+  return rows;
+}
+
+}  // namespace
+
+//! Build a one-to-one perfect hash table over distinct integer keys
+static void BM_PerfectHashJoinBuild(benchmark::State& state) {
+  const auto keys = make_shuffled_keys(state.range(0));
+  std::vector<int32_t> hash_table(keys.size());
+  for (auto _ : state) {
+    build_perfect_hash_table(hash_table, keys);
+    benchmark::DoNotOptimize(hash_table.data());
+  }
+  state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+BENCHMARK(BM_PerfectHashJoinBuild)->Range(1 << 10, 1 << 24);
+
+//! Probe a one-to-one perfect hash table, half of the probed keys are out of range
+static void BM_PerfectHashJoinProbe(benchmark::State& state) {
+  const auto keys = make_shuffled_keys(state.range(0));
+  std::vector<int32_t> hash_table(keys.size());
+  build_perfect_hash_table(hash_table, keys);
+  const auto probe_keys = make_shuffled_keys(2 * keys.size());
+  for (auto _ : state) {
+    int64_t matches{0};
+    for (const auto key : probe_keys) {
+      if (key < static_cast<int64_t>(keys.size())) {
+        matches += *get_hash_slot(hash_table.data(), key, 0) != kInvalidSlot;
+      }
+    }
+    benchmark::DoNotOptimize(matches);
+  }
+  state.SetItemsProcessed(state.iterations() * probe_keys.size());
+}
+
+BENCHMARK(BM_PerfectHashJoinProbe)->Range(1 << 10, 1 << 24);
+
+//! Reduce the perfect hash group by buffers of several devices or threads
+static void BM_GroupByReduction(benchmark::State& state) {
+  std::call_once(setup_flag, global_setup);
+  const size_t entry_count = state.range(0);
+  const auto target_infos = reduction_target_infos();
+  const auto query_mem_desc =
+      perfect_hash_one_col_desc(target_infos, 8, 0, entry_count - 1);
+  const auto row_set_mem_owner =
+      std::make_shared<RowSetMemoryOwner>(Executor::getArenaBlockSize());
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto rs1 = make_filled_result_set(target_infos, query_mem_desc, row_set_mem_owner);
+    auto rs2 = make_filled_result_set(target_infos, query_mem_desc, row_set_mem_owner);
+    std::vector<ResultSet*> storage_set{rs1.get(), rs2.get()};
+    state.ResumeTiming();
+    ResultSetManager rs_manager;
+    benchmark::DoNotOptimize(rs_manager.reduce(storage_set));
+  }
+  state.SetItemsProcessed(state.iterations() * entry_count);
+}
+
+BENCHMARK(BM_GroupByReduction)->Range(1 << 10, 1 << 20)->Unit(benchmark::kMicrosecond);
+
+//! Sort a reduced group by result on its first aggregate
+static void BM_ResultSetSort(benchmark::State& state) {
+  std::call_once(setup_flag, global_setup);
+  const size_t entry_count = state.range(0);
+  const size_t top_n = state.range(1);
+  std::list<Analyzer::OrderEntry> order_entries;
+  order_entries.emplace_back(2, true, false);
+  for (auto _ : state) {
+    state.PauseTiming();
+    // Sorting sets the permutation of the result set, it can only be sorted once.
+    auto rs = make_reduced_result_set(entry_count, 2);
+    state.ResumeTiming();
+    rs->sort(order_entries, top_n, nullptr);
+  }
+  state.SetItemsProcessed(state.iterations() * entry_count);
+}
+
+BENCHMARK(BM_ResultSetSort)
+    ->Args({1 << 10, 0})
+    ->Args({1 << 10, 100})
+    ->Args({1 << 20, 0})
+    ->Args({1 << 20, 100})
+    ->Unit(benchmark::kMicrosecond);
+
+//! Convert a reduced group by result to an Arrow record batch
+static void BM_ArrowResultSetConverter(benchmark::State& state) {
+  std::call_once(setup_flag, global_setup);
+  const size_t entry_count = state.range(0);
+  const auto rs = make_reduced_result_set(entry_count, 2);
+  const std::vector<std::string> col_names{"k", "s", "c", "mn", "mx", "av"};
+  for (auto _ : state) {
+    ArrowResultSetConverter converter(rs, col_names, -1);
+    benchmark::DoNotOptimize(converter.convertToArrow());
+  }
+  state.SetItemsProcessed(state.iterations() * entry_count);
+}
+
+BENCHMARK(BM_ArrowResultSetConverter)
+    ->Range(1 << 10, 1 << 20)
+    ->Unit(benchmark::kMicrosecond);
+
+//! Encode strings into a new dictionary, with the given number of distinct strings
+static void BM_StringDictionaryGetOrAddBulk(benchmark::State& state) {
+  const auto strings = make_strings(state.range(0), state.range(1));
+  std::vector<int32_t> encoded(strings.size());
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto string_dict = std::make_unique<StringDictionary>("", false, true);
+    state.ResumeTiming();
+    string_dict->getOrAddBulk(strings, encoded.data());
+    benchmark::DoNotOptimize(encoded.data());
+  }
+  state.SetItemsProcessed(state.iterations() * strings.size());
+}
+
+BENCHMARK(BM_StringDictionaryGetOrAddBulk)
+    ->Ranges({{1 << 16, 1 << 20}, {100, 1 << 16}})
+    ->Unit(benchmark::kMicrosecond);
+
+//! Split delimited rows into fields, as the importer and the CSV foreign tables do
+static void BM_DelimitedParserGetRow(benchmark::State& state) {
+  const auto rows = make_delimited_rows(state.range(0));
+  const auto rows_end = rows.data() + rows.size();
+  import_export::CopyParams copy_params;
+  copy_params.has_header = import_export::ImportHeaderRow::NO_HEADER;
+  const std::unique_ptr<bool[]> is_array_flags(new bool[4]());
+  std::vector<std::string_view> row;
+  std::vector<std::unique_ptr<char[]>> tmp_buffers;
+  for (auto _ : state) {
+    bool try_single_thread{false};
+    for (const char* p = rows.data(); p < rows_end;) {
+      row.clear();
+      p = import_export::delimited_parser::get_row(p,
+                                                   rows_end,
+                                                   rows_end,
+                                                   copy_params,
+                                                   is_array_flags.get(),
+                                                   row,
+                                                   tmp_buffers,
+                                                   try_single_thread,
+                                                   false);
+      benchmark::DoNotOptimize(row.data());
+    }
+    tmp_buffers.clear();
+  }
+  state.SetBytesProcessed(state.iterations() * rows.size());
+}
+
+BENCHMARK(BM_DelimitedParserGetRow)
+    ->Range(1 << 10, 1 << 18)
+    ->Unit(benchmark::kMicrosecond);
+
+int main(int argc, char** argv) {
+  ::benchmark::Initialize(&argc, argv);
+  if (::benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+  ::benchmark::RunSpecifiedBenchmarks();
+  ResultSetReductionJIT::clearCache();
+  QR::reset();
+  return 0;
+}
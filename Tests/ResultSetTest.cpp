@@ -73,6 +73,31 @@ TEST(Construct, Allocate) {
   result_set.allocateStorage();
 }
 
+TEST(Construct, MemoryOwnerArenaObjects) {
+  auto row_set_mem_owner = std::make_shared<RowSetMemoryOwner>(
+      Executor::getArenaBlockSize(), /*num_kernel_threads=*/2);
+  std::vector<std::string*> strings;
+  std::vector<std::vector<int64_t>*> arrays;
+  std::vector<std::set<int64_t>*> count_distinct_sets;
+  const size_t num_objects{10000};
+  for (size_t i = 0; i < num_objects; ++i) {
+    const size_t thread_idx = i % 3;
+    // Long enough to not fit the small string buffer.
+    strings.push_back(row_set_mem_owner->addString(
+        std::string(32, 'a') + std::to_string(i), thread_idx));
+    arrays.push_back(row_set_mem_owner->addArray(
+        std::vector<int64_t>(i % 8, static_cast<int64_t>(i)), thread_idx));
+    count_distinct_sets.push_back(
+        row_set_mem_owner->allocateCountDistinctSet(thread_idx));
+    count_distinct_sets.back()->insert(i);
+  }
+  for (size_t i = 0; i < num_objects; ++i) {
+    ASSERT_EQ(*strings[i], std::string(32, 'a') + std::to_string(i));
+    ASSERT_EQ(*arrays[i], std::vector<int64_t>(i % 8, static_cast<int64_t>(i)));
+    ASSERT_EQ(*count_distinct_sets[i], std::set<int64_t>{static_cast<int64_t>(i)});
+  }
+}
+
 namespace {
 
 using OneRow = std::vector<TargetValue>;
@@ -1610,6 +1635,128 @@ TEST(Iterate, BaselineHashColumnar) {
   test_iterate(target_infos, query_mem_desc);
 }
 
+TEST(Iterate, RowBatch) {
+  const auto target_infos = generate_test_target_infos();
+  const auto query_mem_desc = baseline_hash_two_col_desc(target_infos, 8);
+  auto row_set_mem_owner =
+      std::make_shared<RowSetMemoryOwner>(Executor::getArenaBlockSize());
+  StringDictionaryProxy* sdp =
+      row_set_mem_owner->addStringDict(g_sd, 1, g_sd->storageEntryCount());
+  ResultSet result_set(target_infos,
+                       ExecutorDeviceType::CPU,
+                       query_mem_desc,
+                       row_set_mem_owner,
+                       nullptr,
+                       0,
+                       0);
+  for (size_t i = 0; i < query_mem_desc.getEntryCount(); ++i) {
+    sdp->getOrAddTransient(std::to_string(i));
+  }
+  const auto storage = result_set.allocateStorage();
+  EvenNumberGenerator generator;
+  fill_storage_buffer(
+      storage->getUnderlyingBuffer(), target_infos, query_mem_desc, generator, 2);
+  std::vector<std::vector<TargetValue>> rows;
+  while (true) {
+    auto row = result_set.getNextRow(true, false);
+    if (row.empty()) {
+      break;
+    }
+    rows.push_back(std::move(row));
+  }
+  ASSERT_FALSE(rows.empty());
+
+  const auto check_batch = [&rows](const std::vector<ColumnBatch>& columns,
+                                   const size_t first_row,
+                                   const size_t row_count) {
+    for (size_t row_idx = 0; row_idx < row_count; ++row_idx) {
+      const auto& row = rows[first_row + row_idx];
+      ASSERT_EQ(row.size(), columns.size());
+      for (size_t i = 0; i < row.size(); ++i) {
+        const auto& column = columns[i];
+        ASSERT_EQ(row_count, column.size());
+        ASSERT_FALSE(column.nulls[row_idx]);
+        const auto scalar_tv = boost::get<ScalarTargetValue>(&row[i]);
+        ASSERT_TRUE(scalar_tv);
+        if (const auto ival = boost::get<int64_t>(scalar_tv)) {
+          ASSERT_EQ(*ival, column.int_values[row_idx]);
+        } else if (const auto dval = boost::get<double>(scalar_tv)) {
+          ASSERT_EQ(*dval, column.double_values[row_idx]);
+        } else {
+          const auto sval = boost::get<NullableString>(scalar_tv);
+          ASSERT_TRUE(sval);
+          ASSERT_EQ(boost::get<std::string>(*sval), column.str_values[row_idx]);
+        }
+      }
+    }
+  };
+
+  // Batches continue from the cursor and stop at the end of the rows.
+  result_set.moveToBegin();
+  std::vector<ColumnBatch> columns;
+  size_t fetched{0};
+  while (true) {
+    const auto row_count = result_set.getNextRowBatch(7, true, false, columns);
+    if (!row_count) {
+      break;
+    }
+    ASSERT_LE(row_count, size_t(7));
+    check_batch(columns, fetched, row_count);
+    fetched += row_count;
+  }
+  ASSERT_EQ(rows.size(), fetched);
+
+  // Random access over all the entries skips the empty ones.
+  ASSERT_EQ(rows.size(),
+            result_set.getRowBatchAt(0, result_set.entryCount(), true, false, columns));
+  check_batch(columns, 0, rows.size());
+}
+
+TEST(Iterate, NonEmptyEntries) {
+  const auto target_infos = generate_test_target_infos();
+  const auto query_mem_desc = perfect_hash_one_col_desc(target_infos, 8, 0, 99);
+  auto row_set_mem_owner =
+      std::make_shared<RowSetMemoryOwner>(Executor::getArenaBlockSize());
+  ResultSet result_set(target_infos,
+                       ExecutorDeviceType::CPU,
+                       query_mem_desc,
+                       row_set_mem_owner,
+                       nullptr,
+                       0,
+                       0);
+  const auto storage = result_set.allocateStorage();
+  EvenNumberGenerator generator;
+  fill_storage_buffer(
+      storage->getUnderlyingBuffer(), target_infos, query_mem_desc, generator, 3);
+  std::vector<int64_t> ref_keys;
+  while (true) {
+    const auto row = result_set.getNextRow(false, false);
+    if (row.empty()) {
+      break;
+    }
+    ref_keys.push_back(v<int64_t>(row[0]));
+  }
+  ASSERT_GT(ref_keys.size(), size_t(3));
+  ASSERT_LT(ref_keys.size(), result_set.entryCount());
+
+  // The parallel count collects the non-empty entries, which the cursor then uses.
+  result_set.moveToBegin();
+  ASSERT_EQ(ref_keys.size(), result_set.rowCount(true));
+  const auto check_keys = [&result_set, &ref_keys](const size_t offset) {
+    result_set.moveToBegin();
+    for (size_t i = offset; i < ref_keys.size(); ++i) {
+      const auto row = result_set.getNextRow(false, false);
+      ASSERT_FALSE(row.empty());
+      ASSERT_EQ(ref_keys[i], v<int64_t>(row[0]));
+    }
+    ASSERT_TRUE(result_set.getNextRow(false, false).empty());
+  };
+  check_keys(0);
+  result_set.dropFirstN(3);
+  ASSERT_EQ(ref_keys.size() - 3, result_set.rowCount(true));
+  check_keys(3);
+}
+
 TEST(Reduce, PerfectHashOneCol) {
   const auto target_infos = generate_test_target_infos();
   const auto query_mem_desc = perfect_hash_one_col_desc(target_infos, 8, 0, 99);
@@ -1847,6 +1994,62 @@ TEST(Reduce, BaselineHashColumnar) {
   test_reduce(target_infos, query_mem_desc, generator1, generator2, 1, true);
 }
 
+TEST(Reduce, PerfectHashOneColManyResultSets) {
+  const auto target_infos = generate_test_target_infos();
+  const auto query_mem_desc = perfect_hash_one_col_desc(target_infos, 8, 0, 99);
+  const auto row_set_mem_owner =
+      std::make_shared<RowSetMemoryOwner>(Executor::getArenaBlockSize());
+  row_set_mem_owner->addStringDict(g_sd, 1, g_sd->storageEntryCount());
+  // The result set manager reduces the first ones in parallel rounds, the second ones
+  // get reduced one after another.
+  std::vector<std::unique_ptr<ResultSet>> tree_results;
+  std::vector<std::unique_ptr<ResultSet>> sequential_results;
+  for (size_t i = 0; i < 7; ++i) {
+    for (auto results : {&tree_results, &sequential_results}) {
+      results->push_back(std::make_unique<ResultSet>(target_infos,
+                                                     ExecutorDeviceType::CPU,
+                                                     query_mem_desc,
+                                                     row_set_mem_owner,
+                                                     nullptr,
+                                                     0,
+                                                     0));
+      EvenNumberGenerator generator;
+      fill_storage_buffer(results->back()->allocateStorage()->getUnderlyingBuffer(),
+                          target_infos,
+                          query_mem_desc,
+                          generator,
+                          2);
+    }
+  }
+  ResultSetManager rs_manager;
+  std::vector<ResultSet*> storage_set;
+  for (const auto& result : tree_results) {
+    storage_set.push_back(result.get());
+  }
+  const auto tree_rs = rs_manager.reduce(storage_set);
+  const auto& sequential_rs = sequential_results.front();
+  ResultSetReductionJIT reduction_jit(sequential_rs->getQueryMemDesc(),
+                                      sequential_rs->getTargetInfos(),
+                                      sequential_rs->getTargetInitVals());
+  const auto reduction_code = reduction_jit.codegen();
+  for (size_t i = 1; i < sequential_results.size(); ++i) {
+    sequential_rs->getStorage()->reduce(
+        *sequential_results[i]->getStorage(), {}, reduction_code);
+  }
+  ASSERT_EQ(sequential_rs->rowCount(), tree_rs->rowCount());
+  for (size_t row_idx = 0; row_idx < tree_rs->rowCount(); ++row_idx) {
+    const auto tree_row = tree_rs->getRowAtNoTranslations(row_idx);
+    const auto sequential_row = sequential_rs->getRowAtNoTranslations(row_idx);
+    ASSERT_EQ(sequential_row.size(), tree_row.size());
+    for (size_t i = 0; i < tree_row.size(); ++i) {
+      const auto tree_val = boost::get<ScalarTargetValue>(&tree_row[i]);
+      const auto sequential_val = boost::get<ScalarTargetValue>(&sequential_row[i]);
+      ASSERT_TRUE(tree_val && sequential_val);
+      ASSERT_TRUE(*tree_val == *sequential_val);
+    }
+  }
+}
+
 #ifndef HAVE_TSAN
 // The large buffers tests allocate too much memory to instrument under TSAN
 TEST(ReduceLargeBuffers, PerfectHashOne_Overflow32) {
@@ -227,6 +227,72 @@ TEST(QueryHint, CheckQueryHintForOverlapsJoin) {
   }
 }
 
+TEST(QueryHint, TableSample) {
+  const auto drop_table_ddl = "DROP TABLE IF EXISTS SQL_HINT_SAMPLE";
+  QR::get()->runDDLStatement(drop_table_ddl);
+  QR::get()->runDDLStatement(
+      "CREATE TABLE SQL_HINT_SAMPLE(x INT, y DOUBLE) WITH (fragment_size=10);");
+  ScopeGuard cleanup = [&] { QR::get()->runDDLStatement(drop_table_ddl); };
+  for (size_t i = 0; i < 100; ++i) {
+    run_query("INSERT INTO SQL_HINT_SAMPLE VALUES(1, 0.5);", ExecutorDeviceType::CPU);
+  }
+
+  {
+    const auto hints = QR::get()->getParsedQueryHint(
+        "SELECT /*+ tablesample_system(12.5) */ COUNT(*) FROM SQL_HINT_SAMPLE;");
+    EXPECT_TRUE(hints.isHintRegistered(QueryHint::kTableSampleSystem) &&
+                approx_eq(hints.tablesample_system_percent, 12.5));
+    EXPECT_TRUE(hints.isTableSampled());
+  }
+  {
+    const auto hints = QR::get()->getParsedQueryHint(
+        "SELECT /*+ tablesample_bernoulli(1) */ COUNT(*) FROM SQL_HINT_SAMPLE;");
+    EXPECT_TRUE(hints.isHintRegistered(QueryHint::kTableSampleBernoulli) &&
+                approx_eq(hints.tablesample_bernoulli_percent, 1));
+  }
+  {
+    const auto wrong_hints = QR::get()->getParsedQueryHint(
+        "SELECT /*+ tablesample_system(0), tablesample_bernoulli(100.5) */ COUNT(*) "
+        "FROM SQL_HINT_SAMPLE;");
+    EXPECT_FALSE(wrong_hints.isTableSampled());
+  }
+
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    {
+      // Half of the fragments, all of the same size and values: the estimates are exact.
+      const auto rows = run_query(
+          "SELECT /*+ tablesample_system(50) */ COUNT(*), SUM(x), SUM(y), AVG(x), "
+          "MAX(x) FROM SQL_HINT_SAMPLE;",
+          dt);
+      const auto crt_row = rows->getNextRow(true, true);
+      ASSERT_EQ(crt_row.size(), size_t(5));
+      EXPECT_EQ(int64_t(100), TestHelpers::v<int64_t>(crt_row[0]));
+      EXPECT_EQ(int64_t(100), TestHelpers::v<int64_t>(crt_row[1]));
+      EXPECT_TRUE(approx_eq(TestHelpers::v<double>(crt_row[2]), 50.0));
+      EXPECT_TRUE(approx_eq(TestHelpers::v<double>(crt_row[3]), 1.0));
+      EXPECT_EQ(int64_t(1), TestHelpers::v<int64_t>(crt_row[4]));
+    }
+    {
+      const auto rows = run_query(
+          "SELECT /*+ tablesample_system(50) */ x, COUNT(*) FROM SQL_HINT_SAMPLE GROUP "
+          "BY x;",
+          dt);
+      ASSERT_EQ(rows->rowCount(), size_t(1));
+      const auto crt_row = rows->getNextRow(true, true);
+      EXPECT_EQ(int64_t(100), TestHelpers::v<int64_t>(crt_row[1]));
+    }
+    {
+      const auto rows = run_query(
+          "SELECT /*+ tablesample_bernoulli(50) */ COUNT(*) FROM SQL_HINT_SAMPLE;", dt);
+      const auto crt_row = rows->getNextRow(true, true);
+      const auto count = TestHelpers::v<int64_t>(crt_row[0]);
+      EXPECT_EQ(int64_t(0), count % 2);
+      EXPECT_NEAR(100, count, 50);
+    }
+  }
+}
+
 int main(int argc, char** argv) {
   TestHelpers::init_logger_stderr_only(argc, argv);
   testing::InitGoogleTest(&argc, argv);
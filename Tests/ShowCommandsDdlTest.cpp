@@ -21,6 +21,7 @@
 
 #include <gtest/gtest.h>
 #include "DBHandlerTestHelpers.h"
+#include "QueryEngine/QueryProfile.h"
 #include "Shared/File.h"
 #include "TestHelpers.h"
 #include "boost/filesystem.hpp"
@@ -921,6 +922,8 @@ TEST_F(ShowCreateTableTest, Identity) {
     "CREATE TABLE showcreatetabletest (\n  i INTEGER)\nWITH (PARTITIONS='REPLICATED');",
     "CREATE TABLE showcreatetabletest (\n  i INTEGER,\n  SHARD KEY (i))\nWITH (SHARD_COUNT=4);",
     "CREATE TABLE showcreatetabletest (\n  i INTEGER)\nWITH (SORT_COLUMN='i');",
+    "CREATE TABLE showcreatetabletest (\n  i1 INTEGER,\n  i2 INTEGER)\nWITH (CLUSTER_COLUMNS='i1,i2');",
+    "CREATE TABLE showcreatetabletest (\n  i INTEGER)\nWITH (KEEP_RESIDENT='TRUE');",
     "CREATE TABLE showcreatetabletest (\n  i1 INTEGER,\n  i2 INTEGER)\nWITH (MAX_ROWS=123, VACUUM='IMMEDIATE');",
     "CREATE TABLE showcreatetabletest (\n  id TEXT ENCODING DICT(32),\n  abbr TEXT ENCODING DICT(32),\n  name TEXT ENCODING DICT(32),\n  omnisci_geo GEOMETRY(MULTIPOLYGON, 4326) NOT NULL ENCODING COMPRESSED(32));",
     "CREATE TABLE showcreatetabletest (\n  flight_year SMALLINT,\n  flight_month SMALLINT,\n  flight_dayofmonth SMALLINT,\n  flight_dayofweek SMALLINT,\n  deptime SMALLINT,\n  crsdeptime SMALLINT,\n  arrtime SMALLINT,\n  crsarrtime SMALLINT,\n  uniquecarrier TEXT ENCODING DICT(32),\n  flightnum SMALLINT,\n  tailnum TEXT ENCODING DICT(32),\n  actualelapsedtime SMALLINT,\n  crselapsedtime SMALLINT,\n  airtime SMALLINT,\n  arrdelay SMALLINT,\n  depdelay SMALLINT,\n  origin TEXT ENCODING DICT(32),\n  dest TEXT ENCODING DICT(32),\n  distance SMALLINT,\n  taxiin SMALLINT,\n  taxiout SMALLINT,\n  cancelled SMALLINT,\n  cancellationcode TEXT ENCODING DICT(32),\n  diverted SMALLINT,\n  carrierdelay SMALLINT,\n  weatherdelay SMALLINT,\n  nasdelay SMALLINT,\n  securitydelay SMALLINT,\n  lateaircraftdelay SMALLINT,\n  dep_timestamp TIMESTAMP(0),\n  arr_timestamp TIMESTAMP(0),\n  carrier_name TEXT ENCODING DICT(32),\n  plane_type TEXT ENCODING DICT(32),\n  plane_manufacturer TEXT ENCODING DICT(32),\n  plane_issue_date DATE ENCODING DAYS(32),\n  plane_model TEXT ENCODING DICT(32),\n  plane_status TEXT ENCODING DICT(32),\n  plane_aircraft_type TEXT ENCODING DICT(32),\n  plane_engine_type TEXT ENCODING DICT(32),\n  plane_year SMALLINT,\n  origin_name TEXT ENCODING DICT(32),\n  origin_city TEXT ENCODING DICT(32),\n  origin_state TEXT ENCODING DICT(32),\n  origin_country TEXT ENCODING DICT(32),\n  origin_lat FLOAT,\n  origin_lon FLOAT,\n  dest_name TEXT ENCODING DICT(32),\n  dest_city TEXT ENCODING DICT(32),\n  dest_state TEXT ENCODING DICT(32),\n  dest_country TEXT ENCODING DICT(32),\n  dest_lat FLOAT,\n  dest_lon FLOAT,\n  origin_merc_x FLOAT,\n  origin_merc_y FLOAT,\n  dest_merc_x FLOAT,\n  dest_merc_y FLOAT)\nWITH (FRAGMENT_SIZE=2000000);",
@@ -959,6 +962,33 @@ TEST_F(ShowCreateTableTest, Defaults) {
   }
 }
 
+TEST_F(ShowCreateTableTest, KeepResident) {
+  sql("CREATE TABLE showcreatetabletest (i INTEGER) WITH (KEEP_RESIDENT='TRUE');");
+  auto& catalog = getCatalog();
+  const auto db_id = catalog.getCurrentDB().dbId;
+  const auto td = catalog.getMetadataForTable("showcreatetabletest", false);
+  ASSERT_NE(td, nullptr);
+  const auto table_id = td->tableId;
+  EXPECT_TRUE(catalog.getDataMgr().hasTableEvictionHint(db_id, table_id));
+  sql("TRUNCATE TABLE showcreatetabletest;");
+  EXPECT_TRUE(catalog.getDataMgr().hasTableEvictionHint(db_id, table_id));
+  sql("DROP TABLE showcreatetabletest;");
+  EXPECT_FALSE(catalog.getDataMgr().hasTableEvictionHint(db_id, table_id));
+
+  sql("CREATE TABLE showcreatetabletest (i INTEGER) WITH (KEEP_RESIDENT='FALSE');");
+  const auto plain_td = catalog.getMetadataForTable("showcreatetabletest", false);
+  ASSERT_NE(plain_td, nullptr);
+  EXPECT_FALSE(catalog.getDataMgr().hasTableEvictionHint(db_id, plain_td->tableId));
+  TQueryResult result;
+  sql(result, "SHOW CREATE TABLE showcreatetabletest;");
+  EXPECT_EQ("CREATE TABLE showcreatetabletest (\n  i INTEGER);",
+            result.row_set.columns[0].data.str_col[0]);
+
+  queryAndAssertPartialException(
+      "CREATE TABLE showcreatetabletest1 (i INTEGER) WITH (KEEP_RESIDENT='MAYBE');",
+      "Option KEEP_RESIDENT support only 'true' or 'false' values.");
+}
+
 TEST_F(ShowCreateTableTest, Other) {
   {
     sql("CREATE TABLE showcreatetabletest (i INTEGER);");
@@ -1445,6 +1475,91 @@ TEST_F(ShowDiskCacheUsageForNormalTableTest, NormalTableMinimum) {
                        {table1, i(chunk_size * 2 + getWrapperSizeForTable(table1))}});
 }
 
+class DefragmentMemoryTest : public ShowTableDdlTest {};
+
+TEST_F(DefragmentMemoryTest, CpuMemory) {
+  sql("CREATE TABLE test_table (i INTEGER);");
+  sql("INSERT INTO test_table VALUES (1), (2);");
+  sqlAndCompareResult("SELECT SUM(i) FROM test_table;", {{i(3)}});
+
+  TQueryResult result;
+  sql(result, "DEFRAGMENT CPU MEMORY;");
+  ASSERT_EQ(result.row_set.row_desc.size(), 1U);
+  EXPECT_EQ(result.row_set.row_desc[0].col_name, "moved chunks");
+  EXPECT_EQ(getRowCount(result), 1U);
+  // The chunks read by the first query may have moved, they still read the same.
+  sqlAndCompareResult("SELECT SUM(i) FROM test_table;", {{i(3)}});
+}
+
+TEST_F(DefragmentMemoryTest, NonSuperUser) {
+  login("test_user", "test_pass");
+  queryAndAssertException("DEFRAGMENT CPU MEMORY;",
+                          "Superuser privilege is required to defragment memory.");
+}
+
+class ShowQueryProfilesTest : public ShowTableDdlTest {
+ protected:
+  void SetUp() override {
+    ShowTableDdlTest::SetUp();
+    sql("CREATE TABLE test_table (i INTEGER);");
+    sql("INSERT INTO test_table VALUES (1), (2);");
+    sql("GRANT SELECT ON TABLE test_table TO test_user;");
+    g_enable_query_profile = true;
+    QueryProfileHistory::instance().clear();
+  }
+
+  void TearDown() override {
+    g_enable_query_profile = false;
+    QueryProfileHistory::instance().clear();
+    ShowTableDdlTest::TearDown();
+  }
+
+  // Returns the query strings of the profiles shown to the current user.
+  std::vector<std::string> getProfiledQueries() {
+    TQueryResult result;
+    sql(result, "SHOW QUERY PROFILES;");
+    EXPECT_EQ(result.row_set.row_desc.size(), 15U);
+    EXPECT_EQ(result.row_set.row_desc[2].col_name, "query_str");
+    std::vector<std::string> queries;
+    for (size_t i = 0; i < getRowCount(result); ++i) {
+      queries.emplace_back(result.row_set.columns[2].data.str_col[i]);
+    }
+    return queries;
+  }
+};
+
+TEST_F(ShowQueryProfilesTest, Columns) {
+  sqlAndCompareResult("SELECT SUM(i) FROM test_table;", {{i(3)}});
+  TQueryResult result;
+  sql(result, "SHOW QUERY PROFILES;");
+  ASSERT_EQ(getRowCount(result), 1U);
+  const auto& columns = result.row_set.columns;
+  EXPECT_EQ(columns[0].data.str_col[0], "admin");
+  EXPECT_EQ(columns[2].data.str_col[0], "SELECT SUM(i) FROM test_table;");
+  // kernel_count
+  EXPECT_GT(columns[8].data.int_col[0], 0);
+  // step_count
+  EXPECT_EQ(columns[11].data.int_col[0], 1);
+}
+
+TEST_F(ShowQueryProfilesTest, ProfilingDisabled) {
+  g_enable_query_profile = false;
+  sql("SELECT SUM(i) FROM test_table;");
+  EXPECT_TRUE(getProfiledQueries().empty());
+}
+
+TEST_F(ShowQueryProfilesTest, NonSuperUser) {
+  sql("SELECT SUM(i) FROM test_table;");
+  login("test_user", "test_pass");
+  sql("SELECT COUNT(*) FROM test_table;");
+  EXPECT_EQ(getProfiledQueries(),
+            std::vector<std::string>{"SELECT COUNT(*) FROM test_table;"});
+  switchToAdmin();
+  EXPECT_EQ(getProfiledQueries(),
+            (std::vector<std::string>{"SELECT SUM(i) FROM test_table;",
+                                      "SELECT COUNT(*) FROM test_table;"}));
+}
+
 class ShowTableDetailsTest : public ShowTest,
                              public testing::WithParamInterface<int32_t> {
  protected:
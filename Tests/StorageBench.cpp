@@ -0,0 +1,462 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * Benchmarks of the storage layer and of ingest: FileMgr cold and warm reads,
+ * checkpoint latency under concurrent appends, compaction, CachingFileMgr hits and
+ * misses, and load_table_binary_columnar and Arrow ingest at several batch sizes.
+ *
+ * The FileMgr benchmarks write under --data-dir, which should be on the disk to
+ * measure, and scale with --data-mb. The ingest benchmarks load --ingest-rows rows into
+ * the database under BASE_PATH. The remaining arguments are those of Google Benchmark,
+ * use --benchmark_out=<file> --benchmark_out_format=json to record the results.
+ */
+
+#include <arrow/api.h>
+#include <arrow/io/memory.h>
+#include <arrow/ipc/api.h>
+#include <arrow/ipc/writer.h>
+#include <benchmark/benchmark.h>
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <thread>
+
+#include "DataMgr/FileMgr/CachingFileMgr.h"
+#include "DataMgr/FileMgr/FileMgr.h"
+#include "DataMgr/FileMgr/GlobalFileMgr.h"
+#include "DataMgr/ForeignStorage/ArrowForeignStorage.h"
+#include "DataMgrTestHelpers.h"
+#include "Shared/ArrowUtil.h"
+#include "Tests/DBHandlerTestHelpers.h"
+#include "Tests/TestHelpers.h"
+
+namespace bf = boost::filesystem;
+namespace fn = File_Namespace;
+
+namespace {
+
+std::string g_data_dir{"./storage_bench"};
+size_t g_data_mb{256};
+size_t g_ingest_rows{1000000};
+
+constexpr size_t kChunkBytes{16 * 1024 * 1024};
+constexpr int32_t kDbId{1};
+constexpr int32_t kTableId{1};
+
+size_t chunk_count() {
+  return std::max(size_t(1), g_data_mb * 1024 * 1024 / kChunkBytes);
+}
+
+ChunkKey chunk_key(const int32_t table_id, const size_t chunk_idx) {
+  return {kDbId, table_id, 1, static_cast<int32_t>(chunk_idx)};
+}
+
+std::vector<int8_t> make_chunk_data(const size_t num_bytes) {
+  std::vector<int8_t> data(num_bytes);
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int32_t> dist(-128, 127);
+  std::generate(data.begin(), data.end(), [&] { return dist(gen); });
+  return data;
+}
+
+std::unique_ptr<fn::GlobalFileMgr> make_global_file_mgr() {
+  return std::make_unique<fn::GlobalFileMgr>(
+      0, std::make_shared<ForeignStorageInterface>(), g_data_dir, 0);
+}
+
+fn::FileMgr* get_file_mgr(fn::GlobalFileMgr& global_file_mgr,
+                          const int32_t table_id = kTableId) {
+  return dynamic_cast<fn::FileMgr*>(global_file_mgr.getFileMgr(kDbId, table_id));
+}
+
+void write_chunks(fn::FileMgr& file_mgr,
+                  const int32_t table_id,
+                  const size_t count,
+                  const std::vector<int8_t>& data) {
+  for (size_t i = 0; i < count; ++i) {
+    TestHelpers::TestBuffer buffer{data};
+    file_mgr.putBuffer(chunk_key(table_id, i), &buffer, data.size());
+  }
+  file_mgr.checkpoint();
+}
+
+size_t read_chunks(fn::FileMgr& file_mgr, const size_t count, std::vector<int8_t>& dst) {
+  size_t num_bytes{0};
+  for (size_t i = 0; i < count; ++i) {
+    auto buffer = file_mgr.getBuffer(chunk_key(kTableId, i));
+    dst.resize(buffer->size());
+    buffer->read(dst.data(), buffer->size());
+    num_bytes += buffer->size();
+  }
+  return num_bytes;
+}
+
+// Drops the pages of the files under `dir` from the page cache of the OS, so that the
+// next reads go to the disk. The files have all been synced by a checkpoint.
+void evict_from_page_cache(const std::string& dir) {
+#ifdef __linux__
+  for (const auto& entry : bf::recursive_directory_iterator(dir)) {
+    if (!bf::is_regular_file(entry.path())) {
+      continue;
+    }
+    const int fd = open(entry.path().c_str(), O_RDONLY);
+    if (fd >= 0) {
+      posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+      close(fd);
+    }
+  }
+#endif
+}
+
+class FileMgrFixture : public benchmark::Fixture {
+ public:
+  void SetUp(const ::benchmark::State& state) override {
+    bf::remove_all(g_data_dir);
+    global_file_mgr_ = make_global_file_mgr();
+  }
+
+  void TearDown(const ::benchmark::State& state) override {
+    global_file_mgr_.reset();
+    bf::remove_all(g_data_dir);
+  }
+
+ protected:
+  std::unique_ptr<fn::GlobalFileMgr> global_file_mgr_;
+};
+
+// Wraps the DBHandler of the test fixture for the ingest benchmarks.
+class IngestHandler : public DBHandlerTestFixture {
+ public:
+  static void init() { createDBHandler(); }
+
+  static void run(const std::string& query) { sql(query); }
+
+  std::pair<DBHandler*, TSessionId&> get() { return getDbHandlerAndSessionId(); }
+
+ private:
+  void TestBody() override {}
+};
+
+void create_ingest_table() {
+  IngestHandler::init();
+  IngestHandler::run("DROP TABLE IF EXISTS ingest_bench;");
+  IngestHandler::run(
+      "CREATE TABLE ingest_bench (i INTEGER, b BIGINT, d DOUBLE, s TEXT ENCODING "
+      "DICT(32));");
+}
+
+std::vector<TColumn> make_columnar_batch(const size_t row_count) {
+  std::vector<TColumn> columns(4);
+  for (auto& column : columns) {
+    column.nulls.resize(row_count, false);
+  }
+  for (size_t i = 0; i < row_count; ++i) {
+    columns[0].data.int_col.push_back(i);
+    columns[1].data.int_col.push_back(i * 1000003);
+    columns[2].data.real_col.push_back(i / 7.0);
+    columns[3].data.str_col.push_back("str_" + std::to_string(i % 1000));
+  }
+  return columns;
+}
+
+std::string make_arrow_batch(const size_t row_count) {
+  arrow::Int32Builder i_builder;
+  arrow::Int64Builder b_builder;
+  arrow::DoubleBuilder d_builder;
+  arrow::StringBuilder s_builder;
+  for (size_t i = 0; i < row_count; ++i) {
+    ARROW_THROW_NOT_OK(i_builder.Append(i));
+    ARROW_THROW_NOT_OK(b_builder.Append(i * 1000003));
+    ARROW_THROW_NOT_OK(d_builder.Append(i / 7.0));
+    ARROW_THROW_NOT_OK(s_builder.Append("str_" + std::to_string(i % 1000)));
+  }
+  std::vector<std::shared_ptr<arrow::Array>> arrays(4);
+  ARROW_THROW_NOT_OK(i_builder.Finish(&arrays[0]));
+  ARROW_THROW_NOT_OK(b_builder.Finish(&arrays[1]));
+  ARROW_THROW_NOT_OK(d_builder.Finish(&arrays[2]));
+  ARROW_THROW_NOT_OK(s_builder.Finish(&arrays[3]));
+  const auto schema = arrow::schema({arrow::field("i", arrow::int32()),
+                                     arrow::field("b", arrow::int64()),
+                                     arrow::field("d", arrow::float64()),
+                                     arrow::field("s", arrow::utf8())});
+  const auto batch = arrow::RecordBatch::Make(schema, row_count, arrays);
+  auto out_stream = *arrow::io::BufferOutputStream::Create();
+  auto stream_writer = *arrow::ipc::MakeStreamWriter(out_stream.get(), schema);
+  ARROW_THROW_NOT_OK(stream_writer->WriteRecordBatch(*batch));
+  ARROW_THROW_NOT_OK(stream_writer->Close());
+  return (*out_stream->Finish())->ToString();
+}
+
+}  // namespace
+
+//! Read all chunks with a newly opened FileMgr, after dropping its files from the page
+//! cache
+BENCHMARK_DEFINE_F(FileMgrFixture, ColdRead)(benchmark::State& state) {
+  const auto data = make_chunk_data(kChunkBytes);
+  write_chunks(*get_file_mgr(*global_file_mgr_), kTableId, chunk_count(), data);
+  std::vector<int8_t> dst;
+  size_t num_bytes{0};
+  for (auto _ : state) {
+    state.PauseTiming();
+    global_file_mgr_.reset();
+    evict_from_page_cache(g_data_dir);
+    global_file_mgr_ = make_global_file_mgr();
+    state.ResumeTiming();
+    num_bytes += read_chunks(*get_file_mgr(*global_file_mgr_), chunk_count(), dst);
+  }
+  state.SetBytesProcessed(num_bytes);
+}
+
+BENCHMARK_REGISTER_F(FileMgrFixture, ColdRead)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+//! Read all chunks again with the same FileMgr, from the page cache
+BENCHMARK_DEFINE_F(FileMgrFixture, WarmRead)(benchmark::State& state) {
+  const auto data = make_chunk_data(kChunkBytes);
+  auto file_mgr = get_file_mgr(*global_file_mgr_);
+  write_chunks(*file_mgr, kTableId, chunk_count(), data);
+  std::vector<int8_t> dst;
+  read_chunks(*file_mgr, chunk_count(), dst);
+  size_t num_bytes{0};
+  for (auto _ : state) {
+    num_bytes += read_chunks(*file_mgr, chunk_count(), dst);
+  }
+  state.SetBytesProcessed(num_bytes);
+}
+
+BENCHMARK_REGISTER_F(FileMgrFixture, WarmRead)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+//! Checkpoint an appended chunk while the given number of threads append to the chunks
+//! of other tables, which share the disk but not the FileMgr
+BENCHMARK_DEFINE_F(FileMgrFixture, CheckpointUnderConcurrentAppends)
+(benchmark::State& state) {
+  const size_t appender_count = state.range(0);
+  const auto data = make_chunk_data(kChunkBytes / 16);
+  auto file_mgr = get_file_mgr(*global_file_mgr_);
+  std::atomic<bool> done{false};
+  std::vector<std::thread> appenders;
+  for (size_t i = 0; i < appender_count; ++i) {
+    const int32_t table_id = kTableId + 1 + i;
+    auto appender_file_mgr = get_file_mgr(*global_file_mgr_, table_id);
+    appenders.emplace_back([appender_file_mgr, table_id, &data, &done] {
+      const auto buffer = appender_file_mgr->createBuffer(chunk_key(table_id, 0));
+      while (!done.load()) {
+        buffer->append(const_cast<int8_t*>(data.data()), data.size());
+        appender_file_mgr->checkpoint();
+      }
+    });
+  }
+  const auto buffer = file_mgr->createBuffer(chunk_key(kTableId, 0));
+  for (auto _ : state) {
+    buffer->append(const_cast<int8_t*>(data.data()), data.size());
+    const auto start = std::chrono::steady_clock::now();
+    file_mgr->checkpoint();
+    state.SetIterationTime(
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start)
+            .count());
+  }
+  done = true;
+  for (auto& appender : appenders) {
+    appender.join();
+  }
+}
+
+BENCHMARK_REGISTER_F(FileMgrFixture, CheckpointUnderConcurrentAppends)
+    ->Arg(0)
+    ->Arg(1)
+    ->Arg(4)
+    ->UseManualTime()
+    ->Unit(benchmark::kMillisecond);
+
+//! Compact the data files of a table after half of its chunks were deleted
+BENCHMARK_DEFINE_F(FileMgrFixture, Compaction)(benchmark::State& state) {
+  const auto data = make_chunk_data(kChunkBytes);
+  const auto count = std::max(size_t(2), chunk_count());
+  File_Namespace::FileMgrParams file_mgr_params;
+  file_mgr_params.max_rollback_epochs = 0;
+  size_t num_bytes{0};
+  for (auto _ : state) {
+    state.PauseTiming();
+    global_file_mgr_.reset();
+    bf::remove_all(g_data_dir);
+    global_file_mgr_ = make_global_file_mgr();
+    global_file_mgr_->setFileMgrParams(kDbId, kTableId, file_mgr_params);
+    auto file_mgr = get_file_mgr(*global_file_mgr_);
+    write_chunks(*file_mgr, kTableId, count, data);
+    for (size_t i = 0; i < count; i += 2) {
+      file_mgr->deleteBuffer(chunk_key(kTableId, i));
+    }
+    file_mgr->checkpoint();
+    state.ResumeTiming();
+    file_mgr->compactFiles();
+    num_bytes += count / 2 * data.size();
+  }
+  state.SetBytesProcessed(num_bytes);
+}
+
+BENCHMARK_REGISTER_F(FileMgrFixture, Compaction)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+//! Read random chunks through a CachingFileMgr which holds the given percentage of them.
+//! Misses put the chunk in the cache, as the foreign storage cache does after a fetch.
+BENCHMARK_DEFINE_F(FileMgrFixture, CachingFileMgrReads)(benchmark::State& state) {
+  const auto data = make_chunk_data(kChunkBytes / 16);
+  const size_t count = 16 * chunk_count();
+  const size_t cached_percent = state.range(0);
+  // The cache has a directory of its own, the FileMgr of the fixture owns g_data_dir.
+  const auto cache_dir = (bf::path(g_data_dir) / "disk_cache").string();
+  const size_t cache_size =
+      std::max(size_t(1), count * cached_percent / 100) * data.size();
+  fn::DiskCacheConfig disk_cache_config{cache_dir,
+                                        fn::DiskCacheLevel::all,
+                                        0,
+                                        cache_size,
+                                        fn::DiskCacheConfig::DEFAULT_PAGE_SIZE};
+  bf::create_directories(cache_dir);
+  fn::CachingFileMgr cfm(disk_cache_config);
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<size_t> dist(0, count - 1);
+  std::vector<int8_t> dst(data.size());
+  size_t hits{0};
+  size_t misses{0};
+  for (auto _ : state) {
+    const auto key = chunk_key(kTableId, dist(gen));
+    if (cfm.isBufferOnDevice(key)) {
+      cfm.getBuffer(key)->read(dst.data(), data.size());
+      ++hits;
+    } else {
+      TestHelpers::TestBuffer buffer{data};
+      buffer.clearDirtyBits();
+      cfm.putBuffer(key, &buffer);
+      cfm.checkpoint(kDbId, kTableId);
+      ++misses;
+    }
+  }
+  state.counters["hit_ratio"] =
+      static_cast<double>(hits) / std::max(size_t(1), hits + misses);
+  state.SetBytesProcessed(state.iterations() * data.size());
+}
+
+BENCHMARK_REGISTER_F(FileMgrFixture, CachingFileMgrReads)
+    ->Arg(10)
+    ->Arg(50)
+    ->Arg(90)
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+
+//! Load --ingest-rows rows with load_table_binary_columnar, in batches of the given size
+static void BM_LoadTableBinaryColumnar(benchmark::State& state) {
+  create_ingest_table();
+  const size_t batch_size = state.range(0);
+  const auto batch = make_columnar_batch(batch_size);
+  IngestHandler handler;
+  auto [db_handler, session_id] = handler.get();
+  size_t row_count{0};
+  for (auto _ : state) {
+    for (size_t i = 0; i < g_ingest_rows; i += batch_size) {
+      db_handler->load_table_binary_columnar(session_id, "ingest_bench", batch, {});
+      row_count += batch_size;
+    }
+    state.PauseTiming();
+    IngestHandler::run("TRUNCATE TABLE ingest_bench;");
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(row_count);
+  IngestHandler::run("DROP TABLE IF EXISTS ingest_bench;");
+}
+
+BENCHMARK(BM_LoadTableBinaryColumnar)
+    ->Arg(1000)
+    ->Arg(10000)
+    ->Arg(100000)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+//! Load --ingest-rows rows with load_table_binary_arrow, in batches of the given size
+static void BM_LoadTableBinaryArrow(benchmark::State& state) {
+  create_ingest_table();
+  const size_t batch_size = state.range(0);
+  const auto batch = make_arrow_batch(batch_size);
+  IngestHandler handler;
+  auto [db_handler, session_id] = handler.get();
+  size_t row_count{0};
+  for (auto _ : state) {
+    for (size_t i = 0; i < g_ingest_rows; i += batch_size) {
+      db_handler->load_table_binary_arrow(session_id, "ingest_bench", batch, false);
+      row_count += batch_size;
+    }
+    state.PauseTiming();
+    IngestHandler::run("TRUNCATE TABLE ingest_bench;");
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(row_count);
+  IngestHandler::run("DROP TABLE IF EXISTS ingest_bench;");
+}
+
+BENCHMARK(BM_LoadTableBinaryArrow)
+    ->Arg(1000)
+    ->Arg(10000)
+    ->Arg(100000)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+int main(int argc, char** argv) {
+  TestHelpers::init_logger_stderr_only();
+
+  namespace po = boost::program_options;
+  po::options_description desc("Options");
+  desc.add_options()("data-dir",
+                     po::value<std::string>(&g_data_dir)->default_value(g_data_dir),
+                     "Directory of the FileMgr benchmarks, on the disk to measure.");
+  desc.add_options()("data-mb",
+                     po::value<size_t>(&g_data_mb)->default_value(g_data_mb),
+                     "Megabytes of chunk data written by the FileMgr benchmarks.");
+  desc.add_options()("ingest-rows",
+                     po::value<size_t>(&g_ingest_rows)->default_value(g_ingest_rows),
+                     "Rows loaded per iteration of the ingest benchmarks.");
+  po::variables_map vm;
+  const auto parsed =
+      po::command_line_parser(argc, argv).options(desc).allow_unregistered().run();
+  po::store(parsed, vm);
+  po::notify(vm);
+
+  // Google Benchmark gets the arguments which are not ours.
+  auto benchmark_args = po::collect_unrecognized(parsed.options, po::include_positional);
+  std::vector<char*> benchmark_argv{argv[0]};
+  for (auto& arg : benchmark_args) {
+    benchmark_argv.push_back(arg.data());
+  }
+  int benchmark_argc = benchmark_argv.size();
+  ::benchmark::Initialize(&benchmark_argc, benchmark_argv.data());
+  if (::benchmark::ReportUnrecognizedArguments(benchmark_argc, benchmark_argv.data())) {
+    return 1;
+  }
+  ::benchmark::RunSpecifiedBenchmarks();
+  return 0;
+}
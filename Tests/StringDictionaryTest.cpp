@@ -17,9 +17,15 @@
 #include "TestHelpers.h"
 
 #include "../StringDictionary/StringDictionary.h"
+#include "../StringDictionary/StringDictionaryProxy.h"
+
+#include <algorithm>
+#include <boost/filesystem.hpp>
 
 #include <cstdlib>
 #include <limits>
+#include <string_view>
+#include <thread>
 
 #ifndef BASE_PATH
 #define BASE_PATH "./tmp"
@@ -101,6 +107,230 @@ TEST(StringDictionary, RecoverMany) {
   }
 }
 
+TEST(StringDictionary, RecoverFromHashTableSnapshot) {
+  const auto dict_path = std::string(BASE_PATH) + "/hash_table_snapshot";
+  boost::filesystem::remove_all(dict_path);
+  boost::filesystem::create_directories(dict_path);
+  const int num_strings{1000};
+  {
+    StringDictionary string_dict(dict_path, false, false, g_cache_string_hash);
+    for (int i = 0; i < num_strings; ++i) {
+      ASSERT_EQ(i, string_dict.getOrAdd(std::to_string(i)));
+    }
+    ASSERT_TRUE(string_dict.checkpoint());
+    // strings added past the snapshot are hashed again when recovering
+    ASSERT_EQ(num_strings, string_dict.getOrAdd("past the snapshot"));
+  }
+  ASSERT_TRUE(boost::filesystem::exists(dict_path + "/DictHashTable"));
+  {
+    StringDictionary string_dict(dict_path, false, true, g_cache_string_hash);
+    ASSERT_EQ(static_cast<size_t>(num_strings + 1), string_dict.storageEntryCount());
+    for (int i = 0; i < num_strings; ++i) {
+      ASSERT_EQ(i, string_dict.getIdOfString(std::to_string(i)));
+    }
+    ASSERT_EQ(num_strings, string_dict.getIdOfString("past the snapshot"));
+    ASSERT_EQ(num_strings + 1, string_dict.getOrAdd("new string"));
+  }
+  // a snapshot for other contents is ignored
+  {
+    StringDictionary string_dict(dict_path, false, false, g_cache_string_hash);
+    ASSERT_FALSE(boost::filesystem::exists(dict_path + "/DictHashTable"));
+    ASSERT_EQ(0, string_dict.getOrAdd("other"));
+  }
+  StringDictionary string_dict(dict_path, false, true, g_cache_string_hash);
+  ASSERT_EQ(size_t(1), string_dict.storageEntryCount());
+  ASSERT_EQ(0, string_dict.getIdOfString("other"));
+  ASSERT_EQ(StringDictionary::INVALID_STR_ID, string_dict.getIdOfString("0"));
+}
+
+TEST(StringDictionary, IncrementalCheckpoints) {
+  const auto dict_path = std::string(BASE_PATH) + "/incremental_checkpoints";
+  boost::filesystem::remove_all(dict_path);
+  boost::filesystem::create_directories(dict_path);
+  const int num_strings{10000};
+  {
+    StringDictionary string_dict(dict_path, false, false, g_cache_string_hash);
+    for (int i = 0; i < num_strings; ++i) {
+      ASSERT_EQ(i, string_dict.getOrAdd(std::to_string(i)));
+      // the synced ranges start in the middle of pages and span file growths
+      if (i % 999 == 0) {
+        ASSERT_TRUE(string_dict.checkpoint());
+      }
+    }
+    ASSERT_TRUE(string_dict.checkpoint());
+    ASSERT_TRUE(string_dict.checkpoint());
+  }
+  StringDictionary string_dict(dict_path, false, true, g_cache_string_hash);
+  ASSERT_EQ(static_cast<size_t>(num_strings), string_dict.storageEntryCount());
+  for (int i = 0; i < num_strings; ++i) {
+    ASSERT_EQ(std::to_string(i), string_dict.getString(i));
+  }
+  ASSERT_EQ(num_strings, string_dict.getOrAdd("after recovery"));
+  ASSERT_TRUE(string_dict.checkpoint());
+}
+
+TEST(StringDictionary, ConcurrentBulkAdds) {
+  StringDictionary string_dict(BASE_PATH, true, false, g_cache_string_hash);
+  constexpr size_t num_strings{10000};
+  constexpr size_t num_loaders{4};
+  std::vector<std::string> strings;
+  for (size_t i = 0; i < num_strings; ++i) {
+    strings.push_back(std::to_string(i));
+  }
+  // every loader adds half of the strings, then the whole set once half is known
+  std::vector<std::vector<int32_t>> loader_ids(num_loaders);
+  std::vector<std::thread> loaders;
+  for (size_t loader_idx = 0; loader_idx < num_loaders; ++loader_idx) {
+    loaders.emplace_back([&string_dict, &strings, &loader_ids, loader_idx] {
+      std::vector<std::string_view> first_half(strings.begin(),
+                                               strings.begin() + strings.size() / 2);
+      std::vector<int32_t> first_half_ids(first_half.size());
+      string_dict.getOrAddBulk(first_half, first_half_ids.data());
+      loader_ids[loader_idx].resize(strings.size());
+      string_dict.getOrAddBulk(strings, loader_ids[loader_idx].data());
+      for (size_t i = 0; i < first_half_ids.size(); ++i) {
+        CHECK_EQ(first_half_ids[i], loader_ids[loader_idx][i]);
+      }
+    });
+  }
+  for (auto& loader : loaders) {
+    loader.join();
+  }
+  ASSERT_EQ(num_strings, string_dict.storageEntryCount());
+  for (size_t loader_idx = 1; loader_idx < num_loaders; ++loader_idx) {
+    ASSERT_EQ(loader_ids.front(), loader_ids[loader_idx]);
+  }
+  for (size_t i = 0; i < num_strings; ++i) {
+    ASSERT_EQ(strings[i], string_dict.getString(loader_ids.front()[i]));
+  }
+}
+
+TEST(StringDictionary, PatternMatchAfterGrowth) {
+  StringDictionary string_dict(BASE_PATH, true, false, g_cache_string_hash);
+  for (int i = 0; i < 10; ++i) {
+    string_dict.getOrAdd("foo" + std::to_string(i));
+    string_dict.getOrAdd("bar" + std::to_string(i));
+  }
+  const auto first_generation = string_dict.storageEntryCount();
+  const auto foo_ids = string_dict.getLike("foo%", false, false, '\\', first_generation);
+  ASSERT_EQ(size_t(10), foo_ids.size());
+  const auto bar_ids = string_dict.getRegexpLike("bar[0-9]+", '\\', first_generation);
+  ASSERT_EQ(size_t(10), bar_ids.size());
+
+  // growing the dictionary extends the cached matches
+  const auto new_foo_id = string_dict.getOrAdd("foo10");
+  const auto new_bar_id = string_dict.getOrAdd("bar10");
+  const auto second_generation = string_dict.storageEntryCount();
+  auto grown_foo_ids = string_dict.getLike("foo%", false, false, '\\', second_generation);
+  ASSERT_EQ(size_t(11), grown_foo_ids.size());
+  ASSERT_EQ(new_foo_id, grown_foo_ids.back());
+  ASSERT_TRUE(std::is_sorted(grown_foo_ids.begin(), grown_foo_ids.end()));
+  auto grown_bar_ids = string_dict.getRegexpLike("bar[0-9]+", '\\', second_generation);
+  ASSERT_EQ(size_t(11), grown_bar_ids.size());
+  ASSERT_EQ(new_bar_id, grown_bar_ids.back());
+
+  // older generations don't see the strings added since
+  ASSERT_EQ(foo_ids, string_dict.getLike("foo%", false, false, '\\', first_generation));
+  ASSERT_EQ(size_t(10),
+            string_dict.getRegexpLike("bar[0-9]+", '\\', first_generation).size());
+}
+
+TEST(StringDictionary, SimpleLike) {
+  StringDictionary string_dict(BASE_PATH, true, false, g_cache_string_hash);
+  const auto foobar_id = string_dict.getOrAdd("foobar");
+  const auto upper_foobar_id = string_dict.getOrAdd("FOOBAR");
+  string_dict.getOrAdd("fo");
+  string_dict.getOrAdd("barfo");
+  const auto generation = string_dict.storageEntryCount();
+  ASSERT_EQ(std::vector<int32_t>{foobar_id},
+            string_dict.getLike("oba", false, true, '\\', generation));
+  ASSERT_EQ((std::vector<int32_t>{foobar_id, upper_foobar_id}),
+            string_dict.getLike("oba", true, true, '\\', generation));
+  ASSERT_TRUE(string_dict.getLike("foof", false, true, '\\', generation).empty());
+}
+
+TEST(StringDictionaryProxy, TranslateStringIds) {
+  auto source_dict =
+      std::make_shared<StringDictionary>(BASE_PATH, true, false, g_cache_string_hash);
+  auto dest_dict =
+      std::make_shared<StringDictionary>(BASE_PATH, true, false, g_cache_string_hash);
+  for (int i = 0; i < 100; ++i) {
+    source_dict->getOrAdd("str" + std::to_string(i));
+  }
+  // only the even strings are in the destination, in a different order
+  for (int i = 98; i >= 0; i -= 2) {
+    dest_dict->getOrAdd("str" + std::to_string(i));
+  }
+  const auto translation_map =
+      source_dict->buildDictionaryTranslationMap(dest_dict.get(), 100, 50);
+  ASSERT_EQ(size_t(100), translation_map.size());
+  for (int i = 0; i < 100; ++i) {
+    ASSERT_EQ(dest_dict->getIdOfString("str" + std::to_string(i)), translation_map[i]);
+  }
+  // ids past the destination generation aren't visible
+  const auto truncated_map =
+      source_dict->buildDictionaryTranslationMap(dest_dict.get(), 100, 10);
+  ASSERT_EQ(StringDictionary::INVALID_STR_ID, truncated_map[0]);
+  ASSERT_EQ(0, truncated_map[98]);
+
+  StringDictionaryProxy source_proxy(source_dict, source_dict->storageEntryCount());
+  StringDictionaryProxy dest_proxy(dest_dict, dest_dict->storageEntryCount());
+  const auto transient_id = dest_proxy.getOrAddTransient("str1");
+  source_proxy.prepareTranslationMap(&dest_proxy, 100);
+  ASSERT_EQ(dest_dict->getIdOfString("str0"),
+            source_proxy.translateStringId(0, &dest_proxy));
+  // strings only in the destination proxy still translate
+  ASSERT_EQ(transient_id, source_proxy.translateStringId(1, &dest_proxy));
+  ASSERT_EQ(StringDictionary::INVALID_STR_ID,
+            source_proxy.translateStringId(3, &dest_proxy));
+
+  // proxies without a generation skip the translation map
+  StringDictionaryProxy no_generation_proxy(source_dict, -1);
+  no_generation_proxy.prepareTranslationMap(&dest_proxy, 100);
+  ASSERT_EQ(dest_dict->getIdOfString("str0"),
+            no_generation_proxy.translateStringId(0, &dest_proxy));
+  ASSERT_EQ(StringDictionary::INVALID_STR_ID,
+            no_generation_proxy.translateStringId(3, &dest_proxy));
+  source_proxy.prepareTranslationMap(&no_generation_proxy, 100);
+  ASSERT_EQ(0, source_proxy.translateStringId(0, &no_generation_proxy));
+}
+
+TEST(StringDictionaryProxy, SortedRanks) {
+  auto string_dict =
+      std::make_shared<StringDictionary>(BASE_PATH, true, false, g_cache_string_hash);
+  std::vector<std::string> strings{"pear", "apple", "fig", "banana", "apricot"};
+  for (const auto& str : strings) {
+    string_dict->getOrAdd(str);
+  }
+  auto check_ranks = [&string_dict](const std::vector<int32_t>& ranks) {
+    for (size_t lhs = 0; lhs < ranks.size(); ++lhs) {
+      for (size_t rhs = 0; rhs < ranks.size(); ++rhs) {
+        ASSERT_EQ(string_dict->getString(lhs) < string_dict->getString(rhs),
+                  ranks[lhs] < ranks[rhs]);
+      }
+    }
+  };
+  StringDictionaryProxy first_proxy(string_dict, string_dict->storageEntryCount());
+  const auto first_ranks = first_proxy.getSortedRanks(strings.size());
+  ASSERT_TRUE(first_ranks);
+  ASSERT_EQ(strings.size(), first_ranks->size());
+  check_ranks(*first_ranks);
+  // too few lookups to be worth ranking the dictionary
+  ASSERT_FALSE(first_proxy.getSortedRanks(1));
+
+  // strings added later rank among the earlier ones, earlier generations don't see them
+  string_dict->getOrAdd("cherry");
+  string_dict->getOrAdd("aardvark");
+  StringDictionaryProxy second_proxy(string_dict, string_dict->storageEntryCount());
+  const auto second_ranks = second_proxy.getSortedRanks(strings.size());
+  ASSERT_TRUE(second_ranks);
+  ASSERT_EQ(strings.size() + 2, second_ranks->size());
+  check_ranks(*second_ranks);
+  const auto older_ranks = first_proxy.getSortedRanks(strings.size());
+  ASSERT_EQ(strings.size(), older_ranks->size());
+  check_ranks(*older_ranks);
+}
+
 int main(int argc, char** argv) {
   testing::InitGoogleTest(&argc, argv);
 
@@ -283,6 +283,24 @@ TEST_F(LowerFunctionTest, LowercaseGpuMode) {
 #endif
 }
 
+TEST_F(LowerFunctionTest, LowercaseGpuModeGroupBy) {
+#ifndef HAVE_CUDA
+  LOG(ERROR)
+      << "This test case only applies to uses case where CUDA is enabled. Skipping test.";
+  return;
+#else
+  auto result_set = QueryRunner::QueryRunner::get()->runSQL(
+      "select lower(country_code), count(*) from lower_function_test_people "
+      "group by lower(country_code) order by 1;",
+      ExecutorDeviceType::GPU,
+      true,
+      true);
+  std::vector<std::vector<ScalarTargetValue>> expected_result_set{{"ca", int64_t(2)},
+                                                                  {"us", int64_t(2)}};
+  compare_result_set(expected_result_set, result_set);
+#endif
+}
+
 TEST_F(LowerFunctionTest, LowercaseNullColumn) {
   auto result_set = multi_sql(R"(
        insert into lower_function_test_people values(null, 'Empty', 25, 'US');
@@ -20,6 +20,7 @@
 
 #include "QueryEngine/ResultSet.h"
 #include "QueryRunner/QueryRunner.h"
+#include "Shared/scope.h"
 
 #ifndef BASE_PATH
 #define BASE_PATH "./tmp"
@@ -28,6 +29,7 @@
 using QR = QueryRunner::QueryRunner;
 
 extern bool g_enable_table_functions;
+extern size_t g_table_function_partition_rows;
 namespace {
 
 inline void run_ddl_statement(const std::string& stmt) {
@@ -345,6 +347,52 @@ TEST_F(TableFunctions, GroupByInAndOut) {
   }
 }
 
+TEST_F(TableFunctions, PartitionedProjection) {
+  const auto table_function_partition_rows_state = g_table_function_partition_rows;
+  ScopeGuard reset_partition_rows = [&table_function_partition_rows_state] {
+    g_table_function_partition_rows = table_function_partition_rows_state;
+  };
+  for (const size_t partition_rows : {0, 1, 2}) {
+    g_table_function_partition_rows = partition_rows;
+    {
+      const auto rows = run_multiple_agg(
+          "SELECT out0 FROM TABLE(row_adder(1, cursor(SELECT d, d2 FROM tf_test))) ORDER "
+          "BY out0 DESC;",
+          ExecutorDeviceType::CPU);
+      ASSERT_EQ(rows->rowCount(), size_t(5));
+      for (int i = 0; i < 5; i++) {
+        auto row = rows->getNextRow(true, false);
+        ASSERT_NEAR(TestHelpers::v<double>(row[0]), 1.0 - i * 1.1, 1e-9);
+      }
+    }
+    {
+      const auto rows = run_multiple_agg(
+          "SELECT out0 FROM TABLE(row_adder(4, cursor(SELECT d, d2 FROM tf_test)));",
+          ExecutorDeviceType::CPU);
+      ASSERT_EQ(rows->rowCount(), size_t(20));
+    }
+    {
+      const auto rows = run_multiple_agg(
+          "SELECT SUM(out0), SUM(out1) FROM TABLE(row_addsub(2, cursor(SELECT d, d2 FROM "
+          "tf_test)));",
+          ExecutorDeviceType::CPU);
+      auto row = rows->getNextRow(true, false);
+      ASSERT_NEAR(TestHelpers::v<double>(row[0]), 2 * (5.0 - 11.0), 1e-9);
+      ASSERT_NEAR(TestHelpers::v<double>(row[1]), 2 * (33.0 - 5.0), 1e-9);
+    }
+  }
+}
+
+TEST_F(TableFunctions, GrowingOutput) {
+  const auto rows = run_multiple_agg(
+      "SELECT COUNT(*), SUM(out0) FROM TABLE(ct_repeat_values(cursor(SELECT x FROM "
+      "tf_test)));",
+      ExecutorDeviceType::CPU);
+  auto row = rows->getNextRow(true, false);
+  ASSERT_EQ(TestHelpers::v<int64_t>(row[0]), int64_t(10));
+  ASSERT_EQ(TestHelpers::v<int64_t>(row[1]), int64_t(30));
+}
+
 TEST_F(TableFunctions, Unsupported) {
   for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
     SKIP_NO_GPU();
@@ -201,6 +201,19 @@ TEST_F(UDFCompilerTest, CompileTest) {
   }
 }
 
+TEST_F(UDFCompilerTest, CachedCompileTest) {
+  UdfCompiler compiler(g_device_arch);
+  const auto [cpu_ir_file, cuda_ir_file] = compiler.compileUdf(getUdfFileName());
+  const auto cpu_ir_write_time = boost::filesystem::last_write_time(cpu_ir_file);
+
+  // The second compilation of the unchanged file reuses the IR of the first one
+  const auto [cached_cpu_ir_file, cached_cuda_ir_file] =
+      compiler.compileUdf(getUdfFileName());
+  EXPECT_EQ(cached_cpu_ir_file, cpu_ir_file);
+  EXPECT_EQ(cached_cuda_ir_file, cuda_ir_file);
+  EXPECT_EQ(boost::filesystem::last_write_time(cached_cpu_ir_file), cpu_ir_write_time);
+}
+
 TEST_F(UDFCompilerTest, InvalidPath) {
   UdfCompiler compiler(g_device_arch);
   EXPECT_ANY_THROW(compiler.compileUdf(getUdfFileName() + ".invalid"));
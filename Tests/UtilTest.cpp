@@ -15,6 +15,10 @@
  */
 
 #include "Shared/Intervals.h"
+#include "LogCaptureTestHelper.h"
+#include "Shared/LatencyHistogram.h"
+#include "Shared/StringTransform.h"
+#include "Shared/threadpool.h"
 #include "TestHelpers.h"
 #include "Utils/Regexp.h"
 #include "Utils/StringLike.h"
@@ -147,6 +151,72 @@ TEST(Shared, IntervalsInvalidBounds) {
   EXPECT_TRUE(loop_body_executed);
 }
 
+TEST(Shared, LatencyHistogram) {
+  LatencyHistogram histogram;
+  EXPECT_EQ(histogram.get().count, size_t(0));
+  for (const int64_t latency_ms : {0, 1, 2, 30, 30, 6000}) {
+    histogram.record(latency_ms);
+  }
+  const auto snapshot = histogram.get();
+  EXPECT_EQ(snapshot.count, size_t(6));
+  EXPECT_EQ(snapshot.sum_ms, 6063);
+  // Buckets are cumulative, and a latency on a bound falls in that bound's bucket.
+  EXPECT_EQ(snapshot.bucket_counts[0], size_t(2));  // <= 1
+  EXPECT_EQ(snapshot.bucket_counts[1], size_t(3));  // <= 5
+  EXPECT_EQ(snapshot.bucket_counts[3], size_t(3));  // <= 25
+  EXPECT_EQ(snapshot.bucket_counts[4], size_t(5));  // <= 50
+  EXPECT_EQ(snapshot.bucket_counts.back(), size_t(5));
+}
+
+TEST(Shared, WorkerPool) {
+  std::vector<std::future<int>> futures;
+  for (int i = 0; i < 16; ++i) {
+    // Each task waits on a nested task, which must not deadlock when workers are busy.
+    futures.push_back(threadpool::async([i] {
+      return threadpool::async([](const int value) { return 2 * value; }, i).get();
+    }));
+  }
+  for (int i = 0; i < 16; ++i) {
+    EXPECT_EQ(futures[i].get(), 2 * i);
+  }
+  EXPECT_GE(threadpool::WorkerPool::instance().workerCount(), size_t(1));
+
+  auto failed = threadpool::async([] { throw std::runtime_error("failed task"); });
+  EXPECT_THROW(failed.get(), std::runtime_error);
+
+  int value{0};
+  threadpool::async([](int& target) { target = 42; }, std::ref(value)).get();
+  EXPECT_EQ(value, 42);
+}
+
+namespace {
+
+void log_every_other(const int i) {
+  LOG_EVERY_N(ERROR, 2) << "log_every_other " << i;
+}
+
+}  // namespace
+
+TEST(Logger, LogEveryN) {
+  LogCapture log_capture;
+  for (int i = 0; i < 5; ++i) {
+    log_every_other(i);
+    const bool logged{log_capture.contains("log_every_other " + std::to_string(i))};
+    EXPECT_EQ(i % 2 == 0, logged);
+  }
+}
+
+TEST(Shared, SplitOnSqlParameterMarkers) {
+  using Parts = std::vector<std::string>;
+  ASSERT_EQ(split_on_sql_parameter_markers("SELECT 1;"), Parts{"SELECT 1;"});
+  ASSERT_EQ(split_on_sql_parameter_markers("SELECT * FROM t WHERE a = ? AND b < ?;"),
+            (Parts{"SELECT * FROM t WHERE a = ", " AND b < ", ";"}));
+  ASSERT_EQ(split_on_sql_parameter_markers("SELECT 'a?''?', \"b?\" FROM t WHERE c = ?"),
+            (Parts{"SELECT 'a?''?', \"b?\" FROM t WHERE c = ", ""}));
+  ASSERT_EQ(split_on_sql_parameter_markers("SELECT ? -- a?\n/* b? */ FROM t"),
+            (Parts{"SELECT ", " -- a?\n/* b? */ FROM t"}));
+}
+
 TEST(Utils, StringLike) {
   ASSERT_TRUE(string_like("abc", 3, "abc", 3, '\\'));
   ASSERT_FALSE(string_like("abc", 3, "ABC", 3, '\\'));
@@ -0,0 +1,209 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ThriftHandler/ArrowFlightServer.h"
+
+#include <arrow/api.h>
+#include <arrow/io/memory.h>
+#include <arrow/ipc/api.h>
+#include <rapidjson/document.h>
+
+#include "Logger/Logger.h"
+#include "ThriftHandler/DBHandler.h"
+
+namespace {
+
+// DBHandler reports errors as exceptions, Flight clients get them as a Status.
+template <typename FUNC>
+arrow::Status call_db_handler(FUNC func) {
+  try {
+    func();
+  } catch (const TOmniSciException& e) {
+    return arrow::Status::Invalid(e.error_msg);
+  } catch (const std::exception& e) {
+    return arrow::Status::UnknownError(e.what());
+  }
+  return arrow::Status::OK();
+}
+
+arrow::Status parse_json_command(const std::string& command,
+                                 rapidjson::Document& document) {
+  document.Parse(command.data(), command.size());
+  if (document.HasParseError() || !document.IsObject()) {
+    return arrow::Status::Invalid("Expected a JSON object, got: ", command);
+  }
+  return arrow::Status::OK();
+}
+
+arrow::Status get_string_member(const rapidjson::Document& document,
+                                const char* name,
+                                std::string& value) {
+  const auto it = document.FindMember(name);
+  if (it == document.MemberEnd() || !it->value.IsString()) {
+    return arrow::Status::Invalid("Missing string member \"", name, "\"");
+  }
+  value = it->value.GetString();
+  return arrow::Status::OK();
+}
+
+/**
+ * Reads the record batches of a sql_execute_df() result. The batches of a batched
+ * result are fetched with get_next_df_batch() as the previous ones are consumed, and a
+ * reader destroyed before the last batch closes the stream along with its table locks.
+ */
+class DataFrameReader : public arrow::RecordBatchReader {
+ public:
+  DataFrameReader(std::shared_ptr<DBHandler> db_handler, const TSessionId& session)
+      : db_handler_(std::move(db_handler)), session_(session) {}
+
+  ~DataFrameReader() override {
+    if (!stream_id_.empty()) {
+      const auto status = call_db_handler(
+          [this] { db_handler_->close_df_stream(session_, stream_id_); });
+      if (!status.ok()) {
+        LOG(WARNING) << "Failed to close data frame stream: " << status.ToString();
+      }
+    }
+  }
+
+  arrow::Status open(const std::string& query, const int64_t batch_rows) {
+    TDataFrame df;
+    ARROW_RETURN_NOT_OK(call_db_handler([&] {
+      db_handler_->sql_execute_df(df,
+                                  session_,
+                                  query,
+                                  TDeviceType::CPU,
+                                  0,
+                                  -1,
+                                  TArrowTransport::WIRE,
+                                  batch_rows);
+    }));
+    ARROW_RETURN_NOT_OK(openDataFrame(df));
+    schema_ = batch_reader_->schema();
+    return arrow::Status::OK();
+  }
+
+  std::shared_ptr<arrow::Schema> schema() const override { return schema_; }
+
+  arrow::Status ReadNext(std::shared_ptr<arrow::RecordBatch>* batch) override {
+    while (true) {
+      ARROW_RETURN_NOT_OK(batch_reader_->ReadNext(batch));
+      if (*batch || stream_id_.empty()) {
+        return arrow::Status::OK();
+      }
+      TDataFrame df;
+      ARROW_RETURN_NOT_OK(call_db_handler(
+          [&] { db_handler_->get_next_df_batch(df, session_, stream_id_); }));
+      ARROW_RETURN_NOT_OK(openDataFrame(df));
+    }
+  }
+
+ private:
+  arrow::Status openDataFrame(TDataFrame& df) {
+    // Streams are gone once they returned their last batch.
+    stream_id_ = df.has_more_batches ? df.stream_id : std::string{};
+    // The batches read from the buffer reference the serialized stream it takes over,
+    // rather than copying it.
+    auto buffer = arrow::Buffer::FromString(std::move(df.df_buffer));
+    ARROW_ASSIGN_OR_RAISE(batch_reader_,
+                          arrow::ipc::RecordBatchStreamReader::Open(
+                              std::make_shared<arrow::io::BufferReader>(buffer)));
+    return arrow::Status::OK();
+  }
+
+  std::shared_ptr<DBHandler> db_handler_;
+  const TSessionId session_;
+  std::string stream_id_;
+  std::shared_ptr<arrow::Schema> schema_;
+  std::shared_ptr<arrow::RecordBatchReader> batch_reader_;
+};
+
+}  // namespace
+
+ArrowFlightServer::ArrowFlightServer(std::shared_ptr<DBHandler> db_handler)
+    : db_handler_(std::move(db_handler)) {
+  CHECK(db_handler_);
+}
+
+arrow::Status ArrowFlightServer::init(const int port) {
+  arrow::flight::Location location;
+  ARROW_RETURN_NOT_OK(arrow::flight::Location::ForGrpcTcp("0.0.0.0", port, &location));
+  arrow::flight::FlightServerOptions options(location);
+  return Init(options);
+}
+
+arrow::Status ArrowFlightServer::DoGet(
+    const arrow::flight::ServerCallContext& context,
+    const arrow::flight::Ticket& request,
+    std::unique_ptr<arrow::flight::FlightDataStream>* stream) {
+  rapidjson::Document ticket;
+  ARROW_RETURN_NOT_OK(parse_json_command(request.ticket, ticket));
+  std::string session;
+  ARROW_RETURN_NOT_OK(get_string_member(ticket, "session", session));
+  std::string query;
+  ARROW_RETURN_NOT_OK(get_string_member(ticket, "query", query));
+  int64_t batch_rows{0};
+  const auto batch_rows_it = ticket.FindMember("batch_rows");
+  if (batch_rows_it != ticket.MemberEnd()) {
+    if (!batch_rows_it->value.IsInt64()) {
+      return arrow::Status::Invalid("Expected an integer \"batch_rows\"");
+    }
+    batch_rows = batch_rows_it->value.GetInt64();
+  }
+
+  auto reader = std::make_shared<DataFrameReader>(db_handler_, session);
+  ARROW_RETURN_NOT_OK(reader->open(query, batch_rows));
+  *stream = std::make_unique<arrow::flight::RecordBatchStream>(reader);
+  return arrow::Status::OK();
+}
+
+arrow::Status ArrowFlightServer::DoPut(
+    const arrow::flight::ServerCallContext& context,
+    std::unique_ptr<arrow::flight::FlightMessageReader> reader,
+    std::unique_ptr<arrow::flight::FlightMetadataWriter> writer) {
+  const auto& descriptor = reader->descriptor();
+  if (descriptor.type != arrow::flight::FlightDescriptor::CMD) {
+    return arrow::Status::Invalid("Expected a command descriptor");
+  }
+  rapidjson::Document command;
+  ARROW_RETURN_NOT_OK(parse_json_command(descriptor.cmd, command));
+  std::string session;
+  ARROW_RETURN_NOT_OK(get_string_member(command, "session", session));
+  std::string table;
+  ARROW_RETURN_NOT_OK(get_string_member(command, "table", table));
+  bool use_column_names{false};
+  const auto use_column_names_it = command.FindMember("use_column_names");
+  if (use_column_names_it != command.MemberEnd()) {
+    if (!use_column_names_it->value.IsBool()) {
+      return arrow::Status::Invalid("Expected a boolean \"use_column_names\"");
+    }
+    use_column_names = use_column_names_it->value.GetBool();
+  }
+
+  // Each batch is a load of its own, the checkpoints of small ones can be deferred with
+  // DeferredCheckpointScheduler.
+  while (true) {
+    arrow::flight::FlightStreamChunk chunk;
+    ARROW_RETURN_NOT_OK(reader->Next(&chunk));
+    if (!chunk.data) {
+      break;
+    }
+    ARROW_RETURN_NOT_OK(call_db_handler([&] {
+      db_handler_->load_table_arrow_batch(session, table, *chunk.data, use_column_names);
+    }));
+  }
+  return arrow::Status::OK();
+}
@@ -0,0 +1,58 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <arrow/flight/server.h>
+
+#include <memory>
+
+class DBHandler;
+
+/**
+ * Arrow Flight service of the server, for clients moving query results or loads as
+ * streams of Arrow record batches. Requests are served by DBHandler in process, with the
+ * same sessions as the Thrift API:
+ *
+ * - DoGet runs the query of a JSON ticket
+ *   `{"session": ..., "query": ..., "batch_rows": ...}` and streams its result in
+ *   batches of `batch_rows` rows (a single batch if omitted or 0), as sql_execute_df()
+ *   and get_next_df_batch() do.
+ * - DoPut loads the record batches it receives into the table of a JSON command
+ *   descriptor `{"session": ..., "table": ..., "use_column_names": ...}`, each batch as
+ *   load_table_binary_arrow() does.
+ *
+ * Concurrent DoGet and DoPut calls are served in parallel.
+ */
+class ArrowFlightServer : public arrow::flight::FlightServerBase {
+ public:
+  explicit ArrowFlightServer(std::shared_ptr<DBHandler> db_handler);
+
+  // Binds the server to `port`, Serve() then blocks until Shutdown().
+  arrow::Status init(const int port);
+
+  arrow::Status DoGet(const arrow::flight::ServerCallContext& context,
+                      const arrow::flight::Ticket& request,
+                      std::unique_ptr<arrow::flight::FlightDataStream>* stream) override;
+
+  arrow::Status DoPut(
+      const arrow::flight::ServerCallContext& context,
+      std::unique_ptr<arrow::flight::FlightMessageReader> reader,
+      std::unique_ptr<arrow::flight::FlightMetadataWriter> writer) override;
+
+ private:
+  std::shared_ptr<DBHandler> db_handler_;
+};
@@ -0,0 +1,184 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "AutoVacuumScheduler.h"
+
+#include "Catalog/SysCatalog.h"
+#include "LockMgr/LegacyLockMgr.h"
+#include "LockMgr/LockMgr.h"
+#include "Logger/Logger.h"
+#include "QueryEngine/Execute.h"
+#include "QueryEngine/TableOptimizer.h"
+
+bool g_enable_auto_vacuum{false};
+float g_auto_vacuum_min_deleted_fraction{0.5};
+size_t g_auto_vacuum_max_bytes_per_pass{size_t(1) << 30};
+size_t g_auto_vacuum_interval_seconds{300};
+bool g_enable_auto_clustering{false};
+size_t g_auto_clustering_max_fragments_per_merge{4};
+
+void AutoVacuumScheduler::start(std::atomic<bool>& is_program_running) {
+  if (is_program_running && !is_scheduler_running_ &&
+      (g_enable_auto_vacuum || g_enable_auto_clustering)) {
+    is_scheduler_running_ = true;
+    scheduler_thread_ = std::thread([&is_program_running]() {
+      auto is_running = [&is_program_running]() {
+        return is_program_running && is_scheduler_running_;
+      };
+      while (is_running()) {
+        {
+          std::unique_lock<std::mutex> wait_lock(wait_mutex_);
+          wait_condition_.wait_for(
+              wait_lock, std::chrono::seconds(g_auto_vacuum_interval_seconds));
+        }
+        if (!is_running()) {
+          return;
+        }
+        const auto vacuumed_bytes = g_enable_auto_vacuum ? vacuumTables(is_running) : 0;
+        if (vacuumed_bytes) {
+          VLOG(1) << "Background vacuum rewrote " << vacuumed_bytes << " bytes.";
+        }
+        if (!g_enable_auto_clustering ||
+            (g_auto_vacuum_max_bytes_per_pass &&
+             vacuumed_bytes >= g_auto_vacuum_max_bytes_per_pass)) {
+          continue;
+        }
+        const auto clustered_bytes = clusterTables(
+            is_running,
+            g_auto_vacuum_max_bytes_per_pass
+                ? g_auto_vacuum_max_bytes_per_pass - vacuumed_bytes
+                : 0);
+        if (clustered_bytes) {
+          VLOG(1) << "Background clustering rewrote " << clustered_bytes << " bytes.";
+        }
+      }
+    });
+  }
+}
+
+void AutoVacuumScheduler::stop() {
+  if (is_scheduler_running_) {
+    is_scheduler_running_ = false;
+    wait_condition_.notify_one();
+    scheduler_thread_.join();
+  }
+}
+
+size_t AutoVacuumScheduler::vacuumTables() {
+  return vacuumTables([]() { return true; });
+}
+
+size_t AutoVacuumScheduler::vacuumTables(const std::function<bool()>& is_running) {
+  size_t vacuumed_bytes{0};
+  auto can_vacuum = [&is_running]() { return is_running() && isExecutorIdle(); };
+  auto& sys_catalog = Catalog_Namespace::SysCatalog::instance();
+  for (const auto& catalog : sys_catalog.getCatalogsForAllDbs()) {
+    for (const auto td : catalog->getAllTableMetadata()) {
+      if (!can_vacuum()) {
+        return vacuumed_bytes;
+      }
+      if (g_auto_vacuum_max_bytes_per_pass &&
+          vacuumed_bytes >= g_auto_vacuum_max_bytes_per_pass) {
+        return vacuumed_bytes;
+      }
+      // shards are vacuumed along with their logical table
+      if (td->isView || td->shard >= 0 || td->isForeignTable() || !td->hasDeletedCol ||
+          td->persistenceLevel != Data_Namespace::MemoryLevel::DISK_LEVEL ||
+          td->maxRollbackEpochs == -1) {
+        continue;
+      }
+      try {
+        const auto td_with_lock =
+            lockmgr::TableSchemaLockContainer<lockmgr::ReadLock>::acquireTableDescriptor(
+                *catalog, td->tableId);
+        auto executor = Executor::getExecutor(Executor::UNITARY_EXECUTOR_ID);
+        const TableOptimizer optimizer(td_with_lock(), executor.get(), *catalog);
+        vacuumed_bytes += optimizer.vacuumFragmentsAboveDeletedFraction(
+            g_auto_vacuum_min_deleted_fraction,
+            g_auto_vacuum_max_bytes_per_pass
+                ? g_auto_vacuum_max_bytes_per_pass - vacuumed_bytes
+                : 0,
+            can_vacuum);
+      } catch (const std::exception& e) {
+        LOG(ERROR) << "Background vacuum of table " << td->tableName << " in database "
+                   << catalog->getCurrentDB().dbName << " failed. " << e.what();
+      }
+    }
+  }
+  return vacuumed_bytes;
+}
+
+size_t AutoVacuumScheduler::clusterTables() {
+  return clusterTables([]() { return true; }, g_auto_vacuum_max_bytes_per_pass);
+}
+
+size_t AutoVacuumScheduler::clusterTables(const std::function<bool()>& is_running,
+                                          const size_t max_bytes) {
+  size_t clustered_bytes{0};
+  auto can_cluster = [&is_running]() { return is_running() && isExecutorIdle(); };
+  auto& sys_catalog = Catalog_Namespace::SysCatalog::instance();
+  for (const auto& catalog : sys_catalog.getCatalogsForAllDbs()) {
+    for (const auto td : catalog->getAllTableMetadata()) {
+      if (!can_cluster()) {
+        return clustered_bytes;
+      }
+      if (max_bytes && clustered_bytes >= max_bytes) {
+        return clustered_bytes;
+      }
+      // shards are clustered along with their logical table
+      if (td->isView || td->shard >= 0 || td->isForeignTable() ||
+          td->persistenceLevel != Data_Namespace::MemoryLevel::DISK_LEVEL ||
+          td->maxRollbackEpochs == -1) {
+        continue;
+      }
+      // Z-order clustering rewrites the whole table, only OPTIMIZE TABLE runs it
+      if (td->clusterColumnIds.size() > 1 ||
+          (!td->sortedColumnId && td->clusterColumnIds.empty())) {
+        continue;
+      }
+      try {
+        const auto td_with_lock =
+            lockmgr::TableSchemaLockContainer<lockmgr::ReadLock>::acquireTableDescriptor(
+                *catalog, td->tableId);
+        auto executor = Executor::getExecutor(Executor::UNITARY_EXECUTOR_ID);
+        const TableOptimizer optimizer(td_with_lock(), executor.get(), *catalog);
+        clustered_bytes += optimizer.clusterFragments(
+            g_auto_clustering_max_fragments_per_merge,
+            max_bytes ? max_bytes - clustered_bytes : 0,
+            can_cluster);
+      } catch (const std::exception& e) {
+        LOG(ERROR) << "Background clustering of table " << td->tableName
+                   << " in database " << catalog->getCurrentDB().dbName << " failed. "
+                   << e.what();
+      }
+    }
+  }
+  return clustered_bytes;
+}
+
+bool AutoVacuumScheduler::isExecutorIdle() {
+  // Queries hold a shared lock on the executor outer lock while they run.
+  mapd_unique_lock<mapd_shared_mutex> execute_write_lock(
+      *legacylockmgr::LockMgr<mapd_shared_mutex, bool>::getMutex(
+          legacylockmgr::ExecutorOuterLock, true),
+      std::try_to_lock);
+  return execute_write_lock.owns_lock();
+}
+
+std::atomic<bool> AutoVacuumScheduler::is_scheduler_running_{false};
+std::thread AutoVacuumScheduler::scheduler_thread_;
+std::mutex AutoVacuumScheduler::wait_mutex_;
+std::condition_variable AutoVacuumScheduler::wait_condition_;
@@ -0,0 +1,71 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+// Vacuums fragments with many deleted rows in the background.
+extern bool g_enable_auto_vacuum;
+// Fraction of deleted rows at which a fragment gets vacuumed in the background.
+extern float g_auto_vacuum_min_deleted_fraction;
+// Chunk bytes rewritten by each background vacuum pass, 0 means unlimited.
+extern size_t g_auto_vacuum_max_bytes_per_pass;
+// Time between background vacuum passes.
+extern size_t g_auto_vacuum_interval_seconds;
+// Merges fragments with overlapping sort column ranges in the background.
+extern bool g_enable_auto_clustering;
+// Fragments sorted together by each background clustering merge.
+extern size_t g_auto_clustering_max_fragments_per_merge;
+
+/**
+ * Periodically vacuums the fragments of the tables whose fraction of deleted rows is at
+ * least `g_auto_vacuum_min_deleted_fraction`, so that scans stop reading and filtering
+ * those rows. Fragments are only vacuumed while no query is running, each pass rewrites
+ * about `g_auto_vacuum_max_bytes_per_pass` of chunks, and a table is only locked for the
+ * vacuum and checkpoint of one fragment at a time. Tables with uncapped epochs are not
+ * vacuumed, as for the vacuum following deletes.
+ *
+ * With `g_enable_auto_clustering`, the same passes also merge the fragments of tables
+ * with a SORT_COLUMN whose sort key ranges overlap, up to
+ * `g_auto_clustering_max_fragments_per_merge` fragments per lock of the table, within
+ * what is left of the bytes per pass after vacuuming. Tables with several
+ * CLUSTER_COLUMNS are left to OPTIMIZE TABLE, which reorders them as a whole.
+ */
+class AutoVacuumScheduler {
+ public:
+  static void start(std::atomic<bool>& is_program_running);
+  static void stop();
+
+  // The following methods are for testing purposes only, return the bytes rewritten.
+  static size_t vacuumTables();
+  static size_t clusterTables();
+
+ private:
+  static size_t vacuumTables(const std::function<bool()>& is_running);
+  static size_t clusterTables(const std::function<bool()>& is_running,
+                              const size_t max_bytes);
+  static bool isExecutorIdle();
+
+  static std::atomic<bool> is_scheduler_running_;
+  static std::thread scheduler_thread_;
+  static std::mutex wait_mutex_;
+  static std::condition_variable wait_condition_;
+};
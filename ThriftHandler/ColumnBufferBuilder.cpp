@@ -0,0 +1,236 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ThriftHandler/ColumnBufferBuilder.h"
+
+#include <cmath>
+#include <limits>
+
+#include "Logger/Logger.h"
+#include "Shared/Compressor.h"
+#include "Shared/InlineNullValues.h"
+
+namespace {
+
+// Results are compressed as they are returned, which favors a fast codec.
+const char* buffer_compression_codec{"lz4"};
+
+// BLOSC_MAX_OVERHEAD, Blosc frames are at most that much larger than their data.
+constexpr size_t blosc_max_overhead{16};
+
+size_t get_value_size(const SQLTypeInfo& ti) {
+  switch (ti.get_type()) {
+    case kBOOLEAN:
+    case kTINYINT:
+      return 1;
+    case kSMALLINT:
+      return 2;
+    case kINT:
+    case kFLOAT:
+      return 4;
+    case kCHAR:
+    case kVARCHAR:
+    case kTEXT:
+      return 1;
+    default:
+      return 8;
+  }
+}
+
+template <typename T>
+void append_value(std::string& buffer, const T value) {
+  buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+bool is_null_int(const int64_t value, const SQLTypeInfo& ti) {
+  switch (ti.get_type()) {
+    case kBOOLEAN:
+      return value == NULL_BOOLEAN;
+    case kTINYINT:
+      return value == NULL_TINYINT;
+    case kSMALLINT:
+      return value == NULL_SMALLINT;
+    case kINT:
+      return value == NULL_INT;
+    default:
+      return value == NULL_BIGINT;
+  }
+}
+
+void compress_buffer(std::string& buffer, const size_t type_size) {
+  if (buffer.empty()) {
+    return;
+  }
+  std::string compressed(buffer.size() + blosc_max_overhead, '\0');
+  const auto compressed_size =
+      BloscCompressor::compressBlock(reinterpret_cast<const uint8_t*>(buffer.data()),
+                                     buffer.size(),
+                                     reinterpret_cast<uint8_t*>(&compressed[0]),
+                                     compressed.size(),
+                                     buffer_compression_codec,
+                                     type_size);
+  CHECK_GT(compressed_size, size_t(0));
+  compressed.resize(compressed_size);
+  buffer.swap(compressed);
+}
+
+}  // namespace
+
+bool ColumnBufferBuilder::isSupported(const SQLTypeInfo& ti) {
+  if (ti.is_array() || ti.is_geometry()) {
+    return false;
+  }
+  switch (ti.get_type()) {
+    case kBOOLEAN:
+    case kTINYINT:
+    case kSMALLINT:
+    case kINT:
+    case kBIGINT:
+    case kNUMERIC:
+    case kDECIMAL:
+    case kFLOAT:
+    case kDOUBLE:
+    case kTIME:
+    case kTIMESTAMP:
+    case kDATE:
+    case kINTERVAL_DAY_TIME:
+    case kINTERVAL_YEAR_MONTH:
+    case kCHAR:
+    case kVARCHAR:
+    case kTEXT:
+      return true;
+    default:
+      return false;
+  }
+}
+
+ColumnBufferBuilder::ColumnBufferBuilder(const SQLTypeInfo& ti)
+    : ti_(ti), value_size_(get_value_size(ti)) {
+  CHECK(isSupported(ti_));
+  if (ti_.is_string()) {
+    append_value(offsets_, int32_t(0));
+  }
+}
+
+void ColumnBufferBuilder::append(const TargetValue& tv) {
+  const auto scalar_tv = boost::get<ScalarTargetValue>(&tv);
+  CHECK(scalar_tv);
+  if (const auto int_value = boost::get<int64_t>(scalar_tv)) {
+    appendInt(*int_value, is_null_int(*int_value, ti_) && !ti_.get_notnull());
+  } else if (const auto double_value = boost::get<double>(scalar_tv)) {
+    const auto null_value = ti_.get_type() == kFLOAT ? NULL_FLOAT : NULL_DOUBLE;
+    appendFp(*double_value, *double_value == null_value && !ti_.get_notnull());
+  } else if (const auto float_value = boost::get<float>(scalar_tv)) {
+    CHECK_EQ(kFLOAT, ti_.get_type());
+    appendFp(*float_value, *float_value == NULL_FLOAT && !ti_.get_notnull());
+  } else {
+    const auto s_n = boost::get<NullableString>(scalar_tv);
+    CHECK(s_n);
+    const auto s = boost::get<std::string>(s_n);
+    appendString(s, !s && !ti_.get_notnull());
+  }
+}
+
+void ColumnBufferBuilder::append(const ColumnBatch& batch) {
+  // A scalar column decodes to a single type, the nulls line up with its values.
+  CHECK(batch.values.empty());
+  CHECK_EQ(batch.size(),
+           batch.int_values.size() + batch.double_values.size() +
+               batch.float_values.size() + batch.str_values.size());
+  for (size_t i = 0; i < batch.int_values.size(); ++i) {
+    appendInt(batch.int_values[i], batch.nulls[i]);
+  }
+  for (size_t i = 0; i < batch.double_values.size(); ++i) {
+    appendFp(batch.double_values[i], batch.nulls[i]);
+  }
+  for (size_t i = 0; i < batch.float_values.size(); ++i) {
+    appendFp(batch.float_values[i], batch.nulls[i]);
+  }
+  for (size_t i = 0; i < batch.str_values.size(); ++i) {
+    appendString(batch.nulls[i] ? nullptr : &batch.str_values[i], batch.nulls[i]);
+  }
+}
+
+void ColumnBufferBuilder::appendInt(const int64_t value, const bool is_null) {
+  if (ti_.is_decimal()) {
+    // Decimals are doubles, as they are in TColumnData.
+    double decimal_value = static_cast<double>(value);
+    if (ti_.get_scale() > 0) {
+      decimal_value /= pow(10.0, std::abs(ti_.get_scale()));
+    }
+    append_value(values_, decimal_value);
+  } else {
+    switch (value_size_) {
+      case 1:
+        append_value(values_, static_cast<int8_t>(value));
+        break;
+      case 2:
+        append_value(values_, static_cast<int16_t>(value));
+        break;
+      case 4:
+        append_value(values_, static_cast<int32_t>(value));
+        break;
+      default:
+        append_value(values_, value);
+    }
+  }
+  appendNull(is_null);
+  ++row_count_;
+}
+
+void ColumnBufferBuilder::appendFp(const double value, const bool is_null) {
+  if (ti_.get_type() == kFLOAT) {
+    append_value(values_, static_cast<float>(value));
+  } else {
+    append_value(values_, value);
+  }
+  appendNull(is_null);
+  ++row_count_;
+}
+
+void ColumnBufferBuilder::appendString(const std::string* value, const bool is_null) {
+  if (value) {
+    values_.append(*value);
+  }
+  CHECK_LE(values_.size(), static_cast<size_t>(std::numeric_limits<int32_t>::max()));
+  append_value(offsets_, static_cast<int32_t>(values_.size()));
+  appendNull(is_null);
+  ++row_count_;
+}
+
+void ColumnBufferBuilder::appendNull(const bool is_null) {
+  if (row_count_ % 8 == 0) {
+    null_bitmap_.push_back('\0');
+  }
+  if (is_null) {
+    null_bitmap_.back() |= static_cast<char>(1 << (row_count_ % 8));
+    has_nulls_ = true;
+  }
+}
+
+void ColumnBufferBuilder::finish(TColumn& column, const bool compress) {
+  if (!has_nulls_) {
+    null_bitmap_.clear();
+  }
+  if (compress) {
+    compress_buffer(values_, value_size_);
+    compress_buffer(offsets_, sizeof(int32_t));
+    compress_buffer(null_bitmap_, 1);
+  }
+  column.values = std::move(values_);
+  column.offsets = std::move(offsets_);
+  column.null_bitmap = std::move(null_bitmap_);
+}
@@ -0,0 +1,59 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <string>
+
+#include "QueryEngine/TargetValue.h"
+#include "Shared/sqltypes.h"
+#include "gen-cpp/omnisci_types.h"
+
+/**
+ * Encodes the values of a scalar result column into the buffers of a TColumn, as
+ * described by the BUFFERS and COMPRESSED_BUFFERS encodings of TColumnEncoding.
+ */
+class ColumnBufferBuilder {
+ public:
+  // Array and geo columns keep the list encoding.
+  static bool isSupported(const SQLTypeInfo& ti);
+
+  explicit ColumnBufferBuilder(const SQLTypeInfo& ti);
+
+  void append(const TargetValue& tv);
+
+  void append(const ColumnBatch& batch);
+
+  // Moves the buffers into `column`, as Blosc frames if `compress` is set.
+  void finish(TColumn& column, const bool compress);
+
+ private:
+  void appendInt(const int64_t value, const bool is_null);
+
+  void appendFp(const double value, const bool is_null);
+
+  void appendString(const std::string* value, const bool is_null);
+
+  void appendNull(const bool is_null);
+
+  const SQLTypeInfo ti_;
+  const size_t value_size_;
+  size_t row_count_{0};
+  bool has_nulls_{false};
+  std::string values_;
+  std::string offsets_;
+  std::string null_bitmap_;
+};
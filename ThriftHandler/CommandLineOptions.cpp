@@ -21,6 +21,7 @@
 #include <iostream>
 
 #include "CommandLineOptions.h"
+#include "DataMgr/FileMgr/FileBuffer.h"
 #include "LeafHostInfo.h"
 #include "MapDRelease.h"
 #include "QueryEngine/GroupByAndAggregate.h"
@@ -48,6 +49,7 @@ extern size_t g_approx_quantile_buffer;
 extern size_t g_approx_quantile_centroids;
 extern size_t g_parallel_top_min;
 extern size_t g_parallel_top_max;
+extern size_t g_parallel_sort_min;
 extern size_t g_estimator_failure_max_groupby_size;
 
 namespace Catalog_Namespace {
@@ -90,6 +92,24 @@ void CommandLineOptions::fillOptions() {
                           po::value<size_t>(&system_parameters.calcite_max_mem)
                               ->default_value(system_parameters.calcite_max_mem),
                           "Max memory available to calcite JVM.");
+  help_desc.add_options()(
+      "calcite-plan-cache-size",
+      po::value<size_t>(&g_calcite_plan_cache_size)
+          ->default_value(g_calcite_plan_cache_size),
+      "Number of query plans kept by the server to skip Calcite for repeated queries. "
+      "0 disables the plan cache.");
+  help_desc.add_options()(
+      "calcite-warmup-queries-file",
+      po::value<std::string>(&system_parameters.calcite_warmup_queries_file)
+          ->default_value(system_parameters.calcite_warmup_queries_file),
+      "File of queries to plan through Calcite in the background at startup, one per "
+      "line, optionally prefixed with a database name and a tab. The server status "
+      "reports the server as ready once they are all planned.");
+  help_desc.add_options()(
+      "calcite-warmup-threads",
+      po::value<size_t>(&system_parameters.calcite_warmup_threads)
+          ->default_value(system_parameters.calcite_warmup_threads),
+      "Number of threads planning the Calcite warmup queries in parallel.");
   if (!dist_v5_) {
     help_desc.add_options()("calcite-port",
                             po::value<int>(&system_parameters.calcite_port)
@@ -141,6 +161,13 @@ void CommandLineOptions::fillOptions() {
                               ->default_value(g_enable_debug_timer)
                               ->implicit_value(true),
                           "Enable debug timer logging.");
+  help_desc.add_options()(
+      "debug-timer-trace-dir",
+      po::value<std::string>(&g_debug_timer_trace_dir)
+          ->default_value(g_debug_timer_trace_dir),
+      "Directory of the Chrome trace event files written for every root debug timer, "
+      "e.g. each query, when the debug timers are enabled. The files can be loaded in "
+      "chrome://tracing or Perfetto. Empty disables them.");
   help_desc.add_options()("enable-dynamic-watchdog",
                           po::value<bool>(&enable_dynamic_watchdog)
                               ->default_value(enable_dynamic_watchdog)
@@ -157,6 +184,13 @@ void CommandLineOptions::fillOptions() {
                               ->implicit_value(true),
                           "Enable the overlaps hash join framework allowing for range "
                           "join (e.g. spatial overlaps) computation using a hash table.");
+  help_desc.add_options()("enable-range-joins",
+                          po::value<bool>(&g_enable_range_joins)
+                              ->default_value(g_enable_range_joins)
+                              ->implicit_value(true),
+                          "Join on BETWEEN, distance and interval predicates of a "
+                          "numeric or datetime inner column through its sorted values "
+                          "instead of a loop join.");
   help_desc.add_options()("enable-hashjoin-many-to-many",
                           po::value<bool>(&g_enable_hashjoin_many_to_many)
                               ->default_value(g_enable_hashjoin_many_to_many)
@@ -234,6 +268,13 @@ void CommandLineOptions::fillOptions() {
                               ->default_value(g_from_table_reordering)
                               ->implicit_value(true),
                           "Enable automatic table reordering in FROM clause.");
+  help_desc.add_options()(
+      "enable-cost-based-join-ordering",
+      po::value<bool>(&g_enable_cost_based_join_ordering)
+          ->default_value(g_enable_cost_based_join_ordering)
+          ->implicit_value(true),
+      "Order the tables of inner joins by the estimated number of joined rows, using "
+      "the value ranges and distinct values of the join key columns.");
   help_desc.add_options()("gpu-buffer-mem-bytes",
                           po::value<size_t>(&system_parameters.gpu_buffer_mem_bytes)
                               ->default_value(system_parameters.gpu_buffer_mem_bytes),
@@ -254,6 +295,31 @@ void CommandLineOptions::fillOptions() {
                             po::value<int>(&http_port)->default_value(http_port),
                             "HTTP port number.");
   }
+#ifdef HAVE_ARROW_FLIGHT
+  help_desc.add_options()(
+      "arrow-flight-port",
+      po::value<int>(&arrow_flight_port)->default_value(arrow_flight_port),
+      "Arrow Flight port number, for query results and loads as Arrow record batches. "
+      "0 disables the Arrow Flight server.");
+#endif
+#ifdef HAVE_THRIFT_NONBLOCKING_SERVER
+  help_desc.add_options()(
+      "nonblocking-port",
+      po::value<int>(&nonblocking_port)->default_value(nonblocking_port),
+      "Port number of the non-blocking Thrift server, which serves connections on an "
+      "event loop with a bounded pool of worker threads. Clients must use the framed "
+      "transport and the binary protocol. 0 disables the non-blocking server.");
+  help_desc.add_options()("nonblocking-server-threads",
+                          po::value<size_t>(&nonblocking_server_threads)
+                              ->default_value(nonblocking_server_threads),
+                          "Number of worker threads of the non-blocking Thrift server.");
+#endif
+  help_desc.add_options()(
+      "metrics-port",
+      po::value<int>(&metrics_port)->default_value(metrics_port),
+      "Port number of the HTTP server exposing the buffer pool, cache and queue metrics "
+      "of the server at /metrics, in the Prometheus text format. 0 disables the metrics "
+      "server.");
   help_desc.add_options()(
       "idle-session-duration",
       po::value<int>(&idle_session_duration)->default_value(idle_session_duration),
@@ -297,6 +363,12 @@ void CommandLineOptions::fillOptions() {
                           po::value<double>(&g_overlaps_target_entries_per_bin)
                               ->default_value(g_overlaps_target_entries_per_bin),
                           "The target number of hash entries per bin for overlaps join");
+  help_desc.add_options()(
+      "overlaps-tuning-sample-rows",
+      po::value<size_t>(&g_overlaps_tuning_sample_rows)
+          ->default_value(g_overlaps_tuning_sample_rows),
+      "Number of inner rows above which the overlaps join auto tuner estimates the "
+      "hash table size of its steps from a sample of the rows (0 to disable).");
   if (!dist_v5_) {
     help_desc.add_options()("port,p",
                             po::value<int>(&system_parameters.omnisci_server_port)
@@ -352,6 +424,13 @@ void CommandLineOptions::fillOptions() {
       "enable-fsi",
       po::value<bool>(&g_enable_fsi)->default_value(g_enable_fsi)->implicit_value(true),
       "Enable foreign storage interface.");
+  help_desc.add_options()("preload-catalogs",
+                          po::value<bool>(&g_preload_catalogs)
+                              ->default_value(g_preload_catalogs)
+                              ->implicit_value(true),
+                          "Load the catalogs of all databases in parallel at startup, so "
+                          "that the first connection to a database does not wait for "
+                          "its catalog to load.");
   help_desc.add_options()("disk-cache-path",
                           po::value<std::string>(&disk_cache_config.path),
                           "Specify the path for the disk cache.");
@@ -366,6 +445,36 @@ void CommandLineOptions::fillOptions() {
                           po::value<std::uint64_t>(&(disk_cache_config.size_limit)),
                           "Specify a maximum size for the disk cache in bytes.");
 
+  help_desc.add_options()(
+      "disk-cache-cost-aware-eviction",
+      po::value<bool>(&disk_cache_config.cost_aware_eviction)
+          ->default_value(disk_cache_config.cost_aware_eviction)
+          ->implicit_value(true),
+      "Evict disk cache chunks by refetch cost, size and access frequency instead of "
+      "by least recent use.");
+
+  help_desc.add_options()(
+      "disk-cache-table-size-limit",
+      po::value<size_t>(&disk_cache_config.table_size_limit)
+          ->default_value(disk_cache_config.table_size_limit),
+      "With disk-cache-cost-aware-eviction, the bytes of chunk data a table can cache "
+      "before its chunks are evicted ahead of those of other tables, 0 means no "
+      "limit.");
+
+  help_desc.add_options()(
+      "disk-cache-async-population",
+      po::value<bool>(&disk_cache_config.async_population)
+          ->default_value(disk_cache_config.async_population)
+          ->implicit_value(true),
+      "Cache the non-FSI table chunks fetched from storage in the background, and "
+      "checkpoint them so they are still cached after a restart.");
+
+  help_desc.add_options()(
+      "disk-cache-admission-fetch-count",
+      po::value<size_t>(&disk_cache_config.admission_fetch_count)
+          ->default_value(disk_cache_config.admission_fetch_count),
+      "Number of fetches from storage of a non-FSI table chunk before it is cached.");
+
 #ifdef HAVE_AWS_S3
   help_desc.add_options()(
       "allow-s3-server-privileges",
@@ -384,6 +493,14 @@ void CommandLineOptions::fillOptions() {
           ->default_value(g_enable_interop)
           ->implicit_value(true),
       "Enable offloading of query portions to an external execution engine.");
+  developer_desc.add_options()(
+      "enable-batch-interpreter",
+      po::value<bool>(&g_enable_batch_interpreter)
+          ->default_value(g_enable_batch_interpreter)
+          ->implicit_value(true),
+      "Evaluate the single table projections offloaded to the external execution "
+      "engine with a native batch interpreter, falling back to SQLite for the "
+      "expressions the interpreter doesn't support.");
   help_desc.add_options()("enable-union",
                           po::value<bool>(&g_enable_union)
                               ->default_value(g_enable_union)
@@ -406,6 +523,13 @@ void CommandLineOptions::fillOptions() {
           ->default_value(g_enable_stringdict_parallel)
           ->implicit_value(true),
       "Allow StringDictionary to parallelize loads using multiple threads");
+  help_desc.add_options()(
+      "stringdict-hash-table-snapshot",
+      po::value<bool>(&g_enable_stringdict_hash_table_snapshot)
+          ->default_value(g_enable_stringdict_hash_table_snapshot)
+          ->implicit_value(true),
+      "Persist StringDictionary hash tables on checkpoint, so that opening a dictionary "
+      "only hashes the strings added since.");
   help_desc.add_options()(
       "log-user-id",
       po::value<bool>(&Catalog_Namespace::g_log_user_id)
@@ -444,6 +568,12 @@ void CommandLineOptions::fillAdvancedOptions() {
           ->default_value(g_enable_columnar_output)
           ->implicit_value(true),
       "Enable columnar output for intermediate/final query steps.");
+  developer_desc.add_options()(
+      "string-id-map-max-entries",
+      po::value<size_t>(&g_string_id_map_max_entries)
+          ->default_value(g_string_id_map_max_entries),
+      "Largest string dictionary whose strings are transformed once per entry to run a "
+      "string function (LOWER) on GPU, queries over larger dictionaries run on CPU.");
   developer_desc.add_options()(
       "enable-left-join-filter-hoisting",
       po::value<bool>(&g_enable_left_join_filter_hoisting)
@@ -455,6 +585,13 @@ void CommandLineOptions::fillAdvancedOptions() {
                                    ->default_value(g_optimize_row_initialization)
                                    ->implicit_value(true),
                                "Optimize row initialization.");
+  developer_desc.add_options()(
+      "enable-lazy-group-by-buffer-init",
+      po::value<bool>(&g_enable_lazy_group_by_buffer_init)
+          ->default_value(g_enable_lazy_group_by_buffer_init)
+          ->implicit_value(true),
+      "Get the large CPU group by buffers whose initial values are all zero from zero "
+      "filled pages, instead of initializing the whole buffer.");
   developer_desc.add_options()("enable-legacy-syntax",
                                po::value<bool>(&enable_legacy_syntax)
                                    ->default_value(enable_legacy_syntax)
@@ -481,6 +618,31 @@ void CommandLineOptions::fillAdvancedOptions() {
                                po::value<int>(&system_parameters.num_executors)
                                    ->default_value(system_parameters.num_executors),
                                "Number of executors to run in parallel.");
+  developer_desc.add_options()(
+      "enable-gpu-query-streams",
+      po::value<bool>(&g_enable_gpu_query_streams)
+          ->default_value(g_enable_gpu_query_streams)
+          ->implicit_value(true),
+      "Launch the GPU kernels of each executor on its own CUDA stream, so that queries "
+      "running on different executors share the GPUs.");
+  developer_desc.add_options()(
+      "num-low-priority-executors",
+      po::value<int>(&system_parameters.num_low_priority_executors)
+          ->default_value(system_parameters.num_low_priority_executors),
+      "Number of executors which may run low priority queries at the same time, 0 lets "
+      "them use all executors.");
+  developer_desc.add_options()(
+      "high-priority-query-grantees",
+      po::value<std::string>(&system_parameters.high_priority_query_grantees)
+          ->default_value(system_parameters.high_priority_query_grantees),
+      "Comma separated users and roles whose queries are dispatched ahead of the "
+      "queries of other users.");
+  developer_desc.add_options()(
+      "low-priority-query-grantees",
+      po::value<std::string>(&system_parameters.low_priority_query_grantees)
+          ->default_value(system_parameters.low_priority_query_grantees),
+      "Comma separated users and roles whose queries are dispatched after the queries "
+      "of other users.");
   developer_desc.add_options()(
       "gpu-shared-mem-threshold",
       po::value<size_t>(&g_gpu_smem_threshold)->default_value(g_gpu_smem_threshold),
@@ -498,12 +660,25 @@ void CommandLineOptions::fillAdvancedOptions() {
           ->default_value(g_enable_smem_non_grouped_agg)
           ->implicit_value(true),
       "Enable using GPU shared memory for non-grouped aggregate queries.");
+  developer_desc.add_options()(
+      "gpu-warp-agg-max-entries",
+      po::value<size_t>(&g_gpu_warp_agg_max_entries)
+          ->default_value(g_gpu_warp_agg_max_entries),
+      "Perfect hash group by buffers with at most this many entries combine the COUNT "
+      "and SUM updates of a warp before the atomics on the GPU. 0 disables it.");
   developer_desc.add_options()("enable-direct-columnarization",
                                po::value<bool>(&g_enable_direct_columnarization)
                                    ->default_value(g_enable_direct_columnarization)
                                    ->implicit_value(true),
                                "Enables/disables a more optimized columnarization method "
                                "for intermediate steps in multi-step queries.");
+  developer_desc.add_options()(
+      "enable-gpu-peer-access",
+      po::value<bool>(&g_enable_gpu_peer_access)
+          ->default_value(g_enable_gpu_peer_access)
+          ->implicit_value(true),
+      "Enable peer to peer access between the GPUs which support it, for direct "
+      "copies between GPUs.");
   developer_desc.add_options()(
       "offset-device-by-table-id",
       po::value<bool>(&g_use_table_device_offset)
@@ -521,6 +696,12 @@ void CommandLineOptions::fillAdvancedOptions() {
                                    ->default_value(g_enable_table_functions)
                                    ->implicit_value(true),
                                "Enable experimental table functions support.");
+  developer_desc.add_options()(
+      "table-function-partition-rows",
+      po::value<size_t>(&g_table_function_partition_rows)
+          ->default_value(g_table_function_partition_rows),
+      "Minimum number of input rows of each partition of partitionable table functions "
+      "run in parallel on CPU (0 to run them over all the input rows at once).");
   developer_desc.add_options()(
       "jit-debug-ir",
       po::value<bool>(&jit_debug)->default_value(jit_debug)->implicit_value(true),
@@ -540,6 +721,27 @@ void CommandLineOptions::fillAdvancedOptions() {
           ->default_value(g_use_tbb_pool)
           ->implicit_value(true),
       "Enable a new thread pool implementation for queuing kernels for execution.");
+  developer_desc.add_options()(
+      "enable-cpu-kernel-work-stealing",
+      po::value<bool>(&g_enable_cpu_kernel_work_stealing)
+          ->default_value(g_enable_cpu_kernel_work_stealing)
+          ->implicit_value(true),
+      "Execute per-fragment CPU kernels on a fixed set of workers which pull kernels "
+      "from a shared queue, largest fragments first, instead of one task per kernel.");
+  developer_desc.add_options()(
+      "enable-shared-scans",
+      po::value<bool>(&g_enable_shared_scans)
+          ->default_value(g_enable_shared_scans)
+          ->implicit_value(true),
+      "Start per-fragment scans of a table at the fragment concurrent scans of the table "
+      "are at, so the queries read each fragment while its chunks are resident.");
+  developer_desc.add_options()(
+      "loop-join-inner-tile-bytes",
+      po::value<size_t>(&g_loop_join_inner_tile_bytes)
+          ->default_value(g_loop_join_inner_tile_bytes),
+      "Split the inner table of a CPU inner loop join into tiles of about this many "
+      "bytes, so the inner rows stay in cache while matched against the outer rows. "
+      "0 disables tiling.");
   developer_desc.add_options()(
       "skip-intermediate-count",
       po::value<bool>(&g_skip_intermediate_count)
@@ -617,6 +819,390 @@ void CommandLineOptions::fillAdvancedOptions() {
           ->default_value(g_fraction_code_cache_to_evict),
       "Percentage of the GPU code cache to evict if an out of memory error is "
       "encountered while attempting to place generated code on the GPU.");
+  developer_desc.add_options()(
+      "enable-persistent-code-cache",
+      po::value<bool>(&g_enable_persistent_code_cache)
+          ->default_value(g_enable_persistent_code_cache)
+          ->implicit_value(true),
+      "Persist generated CPU object code and GPU PTX in the data directory, so that "
+      "query compilation can be skipped after a server restart.");
+  developer_desc.add_options()(
+      "enable-background-jit",
+      po::value<bool>(&g_enable_background_jit)
+          ->default_value(g_enable_background_jit)
+          ->implicit_value(true),
+      "Run the first execution of a new CPU query with code compiled without backend "
+      "optimizations, and compile the optimized code for later executions in the "
+      "background.");
+  developer_desc.add_options()(
+      "jit-low-tier-max-rows",
+      po::value<size_t>(&g_jit_low_tier_max_rows)
+          ->default_value(g_jit_low_tier_max_rows),
+      "Compile CPU queries over at most this many input rows without backend "
+      "optimizations.");
+  developer_desc.add_options()(
+      "jit-tier-promotion-count",
+      po::value<size_t>(&g_jit_tier_promotion_count)
+          ->default_value(g_jit_tier_promotion_count),
+      "Number of code cache hits after which CPU code compiled for a small input is "
+      "optimized fully in the background. 0 never promotes it.");
+  developer_desc.add_options()(
+      "enable-parallel-gpu-module-load",
+      po::value<bool>(&g_enable_parallel_gpu_module_load)
+          ->default_value(g_enable_parallel_gpu_module_load)
+          ->implicit_value(true),
+      "Load generated GPU code onto all devices concurrently.");
+  developer_desc.add_options()(
+      "enable-cpu-loop-vectorization",
+      po::value<bool>(&g_enable_cpu_loop_vectorization)
+          ->default_value(g_enable_cpu_loop_vectorization)
+          ->implicit_value(true),
+      "Run the LLVM loop and SLP vectorizers on generated CPU code.");
+  developer_desc.add_options()(
+      "enable-shared-cpu-group-by-buffer",
+      po::value<bool>(&g_enable_shared_cpu_group_by_buffer)
+          ->default_value(g_enable_shared_cpu_group_by_buffer)
+          ->implicit_value(true),
+      "Let all CPU kernels of a baseline hash group by insert into one shared buffer "
+      "instead of reducing per-kernel buffers.");
+  developer_desc.add_options()(
+      "enable-partitioned-group-by",
+      po::value<bool>(&g_enable_partitioned_group_by)
+          ->default_value(g_enable_partitioned_group_by)
+          ->implicit_value(true),
+      "Retry group by queries which run out of CPU memory in several passes, each over "
+      "a disjoint range of an integer group key.");
+  developer_desc.add_options()(
+      "max-group-by-partitions",
+      po::value<size_t>(&g_max_group_by_partitions)
+          ->default_value(g_max_group_by_partitions),
+      "Maximum number of passes of a partitioned group by.");
+  developer_desc.add_options()(
+      "cpu-interrupt-check-rows",
+      po::value<size_t>(&g_cpu_interrupt_check_rows)
+          ->default_value(g_cpu_interrupt_check_rows),
+      "Number of rows between the dynamic watchdog and runtime interrupt checks of a CPU "
+      "kernel, rounded down to a power of two. Multi-fragment kernels also check after "
+      "every fragment.");
+  developer_desc.add_options()(
+      "query-cpu-memory-budget",
+      po::value<size_t>(&g_query_cpu_memory_budget)
+          ->default_value(g_query_cpu_memory_budget),
+      "Bytes of CPU memory a query step may allocate for its group by, count distinct, "
+      "window and columnar buffers before it falls back to a partitioned group by, 0 "
+      "for no budget.");
+  developer_desc.add_options()(
+      "cpu-small-step-max-rows",
+      po::value<size_t>(&g_cpu_small_step_max_rows)
+          ->default_value(g_cpu_small_step_max_rows),
+      "Run the GPU query steps scanning at most this many rows on CPU when some of "
+      "their input chunks are not resident on GPU, 0 to always run them on GPU.");
+  developer_desc.add_options()(
+      "enable-cpu-gpu-projection",
+      po::value<bool>(&g_enable_cpu_gpu_projection)
+          ->default_value(g_enable_cpu_gpu_projection)
+          ->implicit_value(true),
+      "Run the projections whose inputs don't fit in GPU memory on the fragments "
+      "resident on GPU on GPU and on the other fragments on CPU, rather than retrying "
+      "them on CPU.");
+  developer_desc.add_options()(
+      "enable-clustered-join-windows",
+      po::value<bool>(&g_enable_clustered_join_windows)
+          ->default_value(g_enable_clustered_join_windows)
+          ->implicit_value(true),
+      "Run the projections over an inner equi-join of two tables whose chunk metadata "
+      "shows them clustered on the join key in windows of outer fragments, each joined "
+      "with a hash table over only the inner fragments in its key range.");
+  developer_desc.add_options()(
+      "clustered-join-window-rows",
+      po::value<size_t>(&g_clustered_join_window_rows)
+          ->default_value(g_clustered_join_window_rows),
+      "Maximum number of outer rows of a clustered join window, windows have at least "
+      "one fragment.");
+  developer_desc.add_options()(
+      "enable-approx-top-k-group-by",
+      po::value<bool>(&g_enable_approx_top_k_group_by)
+          ->default_value(g_enable_approx_top_k_group_by)
+          ->implicit_value(true),
+      "Group the queries on one key ordered by a descending COUNT(*) with a limit only "
+      "by the most frequent keys of a Space-Saving sketch of the key. The counts of the "
+      "returned groups are exact, but a group missed by the sketch isn't returned.");
+  developer_desc.add_options()(
+      "approx-top-k-sketch-factor",
+      po::value<size_t>(&g_approx_top_k_sketch_factor)
+          ->default_value(g_approx_top_k_sketch_factor),
+      "Number of counters of the sketch of an approximate top k group by for each row "
+      "of its limit. The sketch keeps every key more frequent than one counter's share "
+      "of the rows.");
+  developer_desc.add_options()(
+      "enable-qual-specialization",
+      po::value<bool>(&g_enable_qual_specialization)
+          ->default_value(g_enable_qual_specialization)
+          ->implicit_value(true),
+      "Generate the filters of a query step without the comparisons which the chunk "
+      "metadata of the scanned table shows all rows pass.");
+  developer_desc.add_options()(
+      "enable-null-check-elision",
+      po::value<bool>(&g_enable_null_check_elision)
+          ->default_value(g_enable_null_check_elision)
+          ->implicit_value(true),
+      "Generate the filters and targets of a query step without the null checks of the "
+      "nullable columns whose chunk metadata shows no nulls.");
+  developer_desc.add_options()(
+      "max-parallel-union-branches",
+      po::value<size_t>(&g_max_parallel_union_branches)
+          ->default_value(g_max_parallel_union_branches),
+      "Maximum number of UNION ALL branches of a query to execute at the same time, each "
+      "on an executor of its own, 0 or 1 to execute them one after another.");
+  developer_desc.add_options()(
+      "enable-radix-partitioned-join-build",
+      po::value<bool>(&g_enable_radix_partitioned_join_build)
+          ->default_value(g_enable_radix_partitioned_join_build)
+          ->implicit_value(true),
+      "Cluster the keys of large CPU baseline join hash tables by hash table slice "
+      "before inserting them, so each thread fills a cache sized slice of the table.");
+  developer_desc.add_options()(
+      "radix-partitioned-join-build-partition-bytes",
+      po::value<size_t>(&g_radix_partitioned_join_build_partition_bytes)
+          ->default_value(g_radix_partitioned_join_build_partition_bytes),
+      "Bytes of the hash table slice filled by one thread in the radix partitioned join "
+      "hash table build.");
+  developer_desc.add_options()(
+      "enable-hash-table-gpu-broadcast",
+      po::value<bool>(&g_enable_hash_table_gpu_broadcast)
+          ->default_value(g_enable_hash_table_gpu_broadcast)
+          ->implicit_value(true),
+      "Build unsharded perfect join hash tables on the first GPU only and copy them to "
+      "the other GPUs device to device.");
+  developer_desc.add_options()(
+      "sparse-perfect-hash-min-density",
+      po::value<double>(&g_sparse_perfect_hash_min_density)
+          ->default_value(g_sparse_perfect_hash_min_density),
+      "Minimum ratio of inner rows to keys of the range for CPU perfect join hash "
+      "tables over large key ranges to use the compressed sparse layout, 0 disables "
+      "the sparse layout.");
+  developer_desc.add_options()(
+      "sparse-perfect-hash-min-entries",
+      po::value<size_t>(&g_sparse_perfect_hash_min_entries)
+          ->default_value(g_sparse_perfect_hash_min_entries),
+      "Number of keys past which the ranges of CPU perfect join hash tables are "
+      "considered for the compressed sparse layout.");
+  developer_desc.add_options()(
+      "hash-table-cache-max-bytes",
+      po::value<size_t>(&g_hash_table_cache_max_bytes)
+          ->default_value(g_hash_table_cache_max_bytes),
+      "Byte budget of each join hash table cache, least recently used tables are "
+      "evicted past it. 0 disables the limit.");
+  developer_desc.add_options()(
+      "join-key-range-fragment-skipping",
+      po::value<bool>(&g_join_key_range_fragment_skipping)
+          ->default_value(g_join_key_range_fragment_skipping)
+          ->implicit_value(true),
+      "Skip outer table fragments whose join key range doesn't overlap the keys of an "
+      "inner join hash table.");
+  developer_desc.add_options()(
+      "enable-numa-aware-buffers",
+      po::value<bool>(&g_enable_numa_aware_buffers)
+          ->default_value(g_enable_numa_aware_buffers)
+          ->implicit_value(true),
+      "Spread CPU buffer pool slabs and fragments over NUMA nodes, and run the CPU "
+      "kernels of a fragment on the node holding it.");
+  developer_desc.add_options()(
+      "enable-huge-pages",
+      po::value<bool>(&g_enable_huge_pages)
+          ->default_value(g_enable_huge_pages)
+          ->implicit_value(true),
+      "Place CPU buffer pool slabs, query arenas and join hash tables of 2MB or more "
+      "on huge pages, explicit ones while reserved pages last and transparent ones "
+      "otherwise.");
+  developer_desc.add_options()(
+      "enable-vectored-page-reads",
+      po::value<bool>(&g_enable_vectored_page_reads)
+          ->default_value(g_enable_vectored_page_reads)
+          ->implicit_value(true),
+      "Read the pages of a chunk which are consecutive in a data file with a single "
+      "vectored read instead of one read per page.");
+  developer_desc.add_options()(
+      "chunk-prefetch-depth",
+      po::value<size_t>(&g_chunk_prefetch_depth)->default_value(g_chunk_prefetch_depth),
+      "Number of queued kernels whose outer table chunks are read into the CPU buffer "
+      "pool in the background while earlier kernels run. 0 disables prefetching.");
+  developer_desc.add_options()(
+      "data-compaction-max-bytes-per-sec",
+      po::value<size_t>(&g_data_compaction_max_bytes_per_sec)
+          ->default_value(g_data_compaction_max_bytes_per_sec),
+      "Maximum rate, in bytes per second, at which data compaction copies pages after "
+      "a table is vacuumed. 0 means unlimited.");
+  developer_desc.add_options()(
+      "enable-chunk-index-snapshot",
+      po::value<bool>(&g_enable_chunk_index_snapshot)
+          ->default_value(g_enable_chunk_index_snapshot)
+          ->implicit_value(true),
+      "Write the page headers of each table to a snapshot at checkpoints, and open "
+      "tables from it instead of reading the header of every page when nothing was "
+      "written since.");
+  developer_desc.add_options()(
+      "page-compression-codec",
+      po::value<std::string>(&g_page_compression_codec)
+          ->default_value(g_page_compression_codec),
+      "Codec used to compress the data pages of chunks created from now on, one of "
+      "none, lz4, zstd, lz4-delta or zstd-delta. The delta codecs compress the "
+      "differences between consecutive values of integer columns, which suits sorted "
+      "and low variance data. Existing chunks keep the codec they were written with.");
+  developer_desc.add_options()(
+      "checkpoint-group-commit-window-us",
+      po::value<size_t>(&g_checkpoint_group_commit_window_us)
+          ->default_value(g_checkpoint_group_commit_window_us),
+      "Window in microseconds during which table checkpoints are grouped to sync "
+      "their files together, once per file system. 0 disables grouping.");
+  developer_desc.add_options()(
+      "enable-scan-resistant-buffer-eviction",
+      po::value<bool>(&g_enable_scan_resistant_buffer_eviction)
+          ->default_value(g_enable_scan_resistant_buffer_eviction)
+          ->implicit_value(true),
+      "Evict buffer pool chunks read only once before the reused ones, so large scans "
+      "do not flush the working set out of CPU and GPU memory.");
+  developer_desc.add_options()(
+      "enable-buffer-pool-defragmentation",
+      po::value<bool>(&g_enable_buffer_pool_defragmentation)
+          ->default_value(g_enable_buffer_pool_defragmentation)
+          ->implicit_value(true),
+      "Move unpinned chunks within and across buffer pool slabs to coalesce free "
+      "space when an allocation would otherwise fail or evict.");
+  developer_desc.add_options()(
+      "cpu-buffer-pool-pinned-bytes",
+      po::value<size_t>(&g_cpu_buffer_pool_pinned_bytes)
+          ->default_value(g_cpu_buffer_pool_pinned_bytes),
+      "Bytes of CPU buffer pool slabs to allocate as CUDA pinned host memory, so chunks "
+      "are copied to and from the GPUs without staging. 0 disables pinned slabs.");
+  developer_desc.add_options()(
+      "cpu-compressed-chunk-cache-bytes",
+      po::value<size_t>(&g_cpu_compressed_chunk_cache_bytes)
+          ->default_value(g_cpu_compressed_chunk_cache_bytes),
+      "Bytes of memory for compressed copies of chunks evicted from the CPU buffer "
+      "pool, which are restored without reading the disk again. 0 disables.");
+  developer_desc.add_options()(
+      "zone-map-block-rows",
+      po::value<size_t>(&g_zone_map_block_rows)->default_value(g_zone_map_block_rows),
+      "Rows per block of the in-memory zone maps kept for integer and time columns, "
+      "which narrow the rows scanned in each fragment by filters. 0 disables.");
+  developer_desc.add_options()(
+      "enable-geo-block-bounds",
+      po::value<bool>(&g_enable_geo_block_bounds)
+          ->default_value(g_enable_geo_block_bounds)
+          ->implicit_value(true),
+      "Keep in-memory bounding boxes of the zone map blocks of point, linestring and "
+      "polygon columns, which narrow the rows scanned by ST_Contains and ST_Intersects "
+      "against literal shapes. Needs zone-map-block-rows.");
+  developer_desc.add_options()(
+      "enable-column-stats",
+      po::value<bool>(&g_enable_column_stats)
+          ->default_value(g_enable_column_stats)
+          ->implicit_value(true),
+      "Keep in-memory distinct value sketches and histograms of the chunks of integer, "
+      "time and dictionary encoded columns, used by the cost based join ordering.");
+  developer_desc.add_options()(
+      "dictionary-index-max-block-values",
+      po::value<size_t>(&g_dictionary_index_max_block_values)
+          ->default_value(g_dictionary_index_max_block_values),
+      "Max distinct ids of a dictionary encoded column indexed per zone map block, "
+      "which lets equality and IN filters skip the blocks without the string. Blocks "
+      "with more distinct ids are not indexed. 0 disables.");
+  developer_desc.add_options()(
+      "parquet-row-group-read-ahead",
+      po::value<size_t>(&g_parquet_row_group_read_ahead)
+          ->default_value(g_parquet_row_group_read_ahead),
+      "Number of row groups of a fixed width Parquet column decoded in parallel ahead "
+      "of the chunk being loaded. 0 decodes row groups serially.");
+  developer_desc.add_options()(
+      "parquet-read-part-size",
+      po::value<size_t>(&g_parquet_read_part_size)
+          ->default_value(g_parquet_read_part_size),
+      "Size in bytes of the ranged reads of Parquet foreign table files. Larger reads "
+      "are split into parts read concurrently, and smaller reads read a whole part "
+      "which serves the reads next to them. 0 disables ranged reads.");
+  developer_desc.add_options()(
+      "parquet-max-concurrent-part-reads",
+      po::value<size_t>(&g_parquet_max_concurrent_part_reads)
+          ->default_value(g_parquet_max_concurrent_part_reads),
+      "Max ranged reads of a Parquet foreign table file in flight for a single read.");
+  developer_desc.add_options()(
+      "enable-parquet-row-group-zone-maps",
+      po::value<bool>(&g_enable_parquet_row_group_zone_maps)
+          ->default_value(g_enable_parquet_row_group_zone_maps)
+          ->implicit_value(true),
+      "Keep the statistics of each Parquet row group as zone maps of the fragment, so "
+      "filters skip the row groups which cannot match.");
+  developer_desc.add_options()(
+      "enable-csv-read-ahead",
+      po::value<bool>(&g_enable_csv_read_ahead)
+          ->default_value(g_enable_csv_read_ahead)
+          ->implicit_value(true),
+      "Read CSV files on a separate thread during metadata scans, so that reading and "
+      "decompressing the files overlaps with splitting the data into rows.");
+  developer_desc.add_options()(
+      "skip-unchanged-append-refreshes",
+      po::value<bool>(&g_skip_unchanged_append_refreshes)
+          ->default_value(g_skip_unchanged_append_refreshes)
+          ->implicit_value(true),
+      "Skip the scheduled refreshes of append mode foreign tables whose local files "
+      "have not changed size or modification time since their last scheduled refresh.");
+  developer_desc.add_options()(
+      "enable-columnar-delimited-import",
+      po::value<bool>(&g_enable_columnar_delimited_import)
+          ->default_value(g_enable_columnar_delimited_import)
+          ->implicit_value(true),
+      "Convert the fields of delimited files a column at a time, over blocks of rows, "
+      "when importing into tables without array or geo columns.");
+  developer_desc.add_options()(
+      "deferred-load-checkpoint-rows",
+      po::value<size_t>(&g_deferred_load_checkpoint_rows)
+          ->default_value(g_deferred_load_checkpoint_rows),
+      "Defer the checkpoint of tables loaded through the load_table APIs until this "
+      "many rows have been loaded into them, 0 checkpoints after every load. Deferred "
+      "rows are visible to queries right away, but are lost on a crash or on a failed "
+      "load into the same table before the next checkpoint, within up to "
+      "deferred-load-checkpoint-interval-ms of the first deferred load. The error of "
+      "such a failed load reports the earlier loads and rows it rolled back, which "
+      "must be retried.");
+  developer_desc.add_options()(
+      "deferred-load-checkpoint-interval-ms",
+      po::value<size_t>(&g_deferred_load_checkpoint_interval_ms)
+          ->default_value(g_deferred_load_checkpoint_interval_ms),
+      "Checkpoint the tables with deferred load checkpoints at most this long after "
+      "their first deferred load.");
+  developer_desc.add_options()(
+      "enable-parallel-column-inserts",
+      po::value<bool>(&g_enable_parallel_column_inserts)
+          ->default_value(g_enable_parallel_column_inserts)
+          ->implicit_value(true),
+      "Append the columns of large insert batches to their chunks in parallel.");
+  developer_desc.add_options()(
+      "enable-replicated-add-column-defaults",
+      po::value<bool>(&g_enable_replicated_add_column_defaults)
+          ->default_value(g_enable_replicated_add_column_defaults)
+          ->implicit_value(true),
+      "Store the default value of fixed length columns added with ALTER TABLE ADD COLUMN "
+      "once per existing fragment, replicating it over the rows when the chunk is read.");
+  developer_desc.add_options()(
+      "csv-export-range-entries",
+      po::value<size_t>(&g_csv_export_range_entries)
+          ->default_value(g_csv_export_range_entries),
+      "Result set entries formatted at a time by each thread of a CSV export. Smaller "
+      "results are formatted sequentially.");
+#ifdef ENABLE_IMPORT_PARQUET
+  developer_desc.add_options()(
+      "parquet-export-row-group-rows",
+      po::value<size_t>(&g_parquet_export_row_group_rows)
+          ->default_value(g_parquet_export_row_group_rows),
+      "Result set entries written to each row group of a Parquet export.");
+#endif
+  developer_desc.add_options()(
+      "max-concurrent-update-fragments",
+      po::value<size_t>(&g_max_concurrent_update_fragments)
+          ->default_value(g_max_concurrent_update_fragments),
+      "Fragments of an UPDATE or DELETE written to storage concurrently, while the next "
+      "fragments execute.");
 
   developer_desc.add_options()("ssl-cert",
                                po::value<std::string>(&system_parameters.ssl_cert_file)
@@ -717,6 +1303,13 @@ void CommandLineOptions::fillAdvancedOptions() {
           ->default_value(g_enable_calcite_ddl_parser)
           ->implicit_value(true),
       "Enable using Calcite for supported DDL parsing when available.");
+  developer_desc.add_options()(
+      "enable-pipelined-itas",
+      po::value<bool>(&g_enable_pipelined_itas)
+          ->default_value(g_enable_pipelined_itas)
+          ->implicit_value(true),
+      "Load the rows computed by an INSERT INTO ... SELECT or CREATE TABLE AS SELECT "
+      "query over an outer fragment while the query runs over the next one.");
   developer_desc.add_options()(
       "enable-seconds-refresh-interval",
       po::value<bool>(&g_enable_seconds_refresh)
@@ -738,6 +1331,60 @@ void CommandLineOptions::fillAdvancedOptions() {
       po::value<size_t>(&g_parallel_top_max)->default_value(g_parallel_top_max),
       "For ResultSets requiring a heap sort, the maximum number of rows allowed by "
       "watchdog.");
+  developer_desc.add_options()(
+      "parallel-sort-min",
+      po::value<size_t>(&g_parallel_sort_min)->default_value(g_parallel_sort_min),
+      "For ResultSets requiring a full sort, the number of rows necessary to trigger "
+      "parallelSort() to sort.");
+  developer_desc.add_options()(
+      "streaming-top-n-max",
+      po::value<size_t>(&g_streaming_topn_max)->default_value(g_streaming_topn_max),
+      "For projections ordered by a single key, the maximum offset + limit sorted by "
+      "per thread top n heaps while executing the query.");
+  developer_desc.add_options()(
+      "parallel-window-partition-min",
+      po::value<size_t>(&g_parallel_window_partition_min)
+          ->default_value(g_parallel_window_partition_min),
+      "For window functions, the number of rows necessary to compute the partitions in "
+      "parallel, which is also the number of rows of a partition necessary to sort it "
+      "in parallel.");
+  developer_desc.add_options()(
+      "enable-count-distinct-sparse-bitmap",
+      po::value<bool>(&g_enable_count_distinct_sparse_bitmap)
+          ->default_value(g_enable_count_distinct_sparse_bitmap)
+          ->implicit_value(true),
+      "Use sparse bitmaps rather than std::set or sparsely populated dense bitmaps for "
+      "COUNT(DISTINCT) on CPU.");
+  developer_desc.add_options()(
+      "query-result-cache-max-bytes",
+      po::value<size_t>(&g_query_result_cache_max_bytes)
+          ->default_value(g_query_result_cache_max_bytes),
+      "Maximum bytes of serialized read query results cached by the server, 0 disables "
+      "the query result cache.");
+  developer_desc.add_options()(
+      "result-set-recycler-max-bytes",
+      po::value<size_t>(&g_result_set_recycler_max_bytes)
+          ->default_value(g_result_set_recycler_max_bytes),
+      "Maximum bytes of subquery and intermediate query step results kept for reuse "
+      "by later queries, 0 disables the result set recycler.");
+  developer_desc.add_options()(
+      "linearized-column-cache-max-bytes",
+      po::value<size_t>(&g_linearized_column_cache_max_bytes)
+          ->default_value(g_linearized_column_cache_max_bytes),
+      "Maximum bytes of join columns merged over the fragments of their table kept for "
+      "reuse by later queries, 0 disables the linearized column cache.");
+  developer_desc.add_options()(
+      "enable-query-profile",
+      po::value<bool>(&g_enable_query_profile)
+          ->default_value(g_enable_query_profile)
+          ->implicit_value(true),
+      "Collect the compilation, fetch, kernel and reduction times of each query, "
+      "returned with the query results and by get_query_profiles.");
+  developer_desc.add_options()(
+      "query-profile-history-size",
+      po::value<size_t>(&g_query_profile_history_size)
+          ->default_value(g_query_profile_history_size),
+      "Number of the most recent query profiles kept by the server.");
   developer_desc.add_options()("vacuum-min-selectivity",
                                po::value<float>(&g_vacuum_min_selectivity)
                                    ->default_value(g_vacuum_min_selectivity),
@@ -747,6 +1394,74 @@ void CommandLineOptions::fillAdvancedOptions() {
                                "deleted rows in a fragment at which to perform "
                                "automatic vacuuming. A number greater than 1 can "
                                "be used to disable automatic vacuuming.");
+  developer_desc.add_options()("enable-auto-vacuum",
+                               po::value<bool>(&g_enable_auto_vacuum)
+                                   ->default_value(g_enable_auto_vacuum)
+                                   ->implicit_value(true),
+                               "Vacuum fragments with many deleted rows in the "
+                               "background while no query is running.");
+  developer_desc.add_options()(
+      "auto-vacuum-min-deleted-fraction",
+      po::value<float>(&g_auto_vacuum_min_deleted_fraction)
+          ->default_value(g_auto_vacuum_min_deleted_fraction),
+      "Fraction of deleted rows (from 0 to 1) at which a fragment is vacuumed in the "
+      "background.");
+  developer_desc.add_options()(
+      "auto-vacuum-max-bytes-per-pass",
+      po::value<size_t>(&g_auto_vacuum_max_bytes_per_pass)
+          ->default_value(g_auto_vacuum_max_bytes_per_pass),
+      "Chunk bytes rewritten by each background vacuum pass, 0 means unlimited.");
+  developer_desc.add_options()(
+      "auto-vacuum-interval-seconds",
+      po::value<size_t>(&g_auto_vacuum_interval_seconds)
+          ->default_value(g_auto_vacuum_interval_seconds),
+      "Time between background vacuum passes.");
+  developer_desc.add_options()("enable-auto-clustering",
+                               po::value<bool>(&g_enable_auto_clustering)
+                                   ->default_value(g_enable_auto_clustering)
+                                   ->implicit_value(true),
+                               "Merge the fragments of tables with a SORT_COLUMN whose "
+                               "sort key ranges overlap in the background passes.");
+  developer_desc.add_options()(
+      "auto-clustering-max-fragments-per-merge",
+      po::value<size_t>(&g_auto_clustering_max_fragments_per_merge)
+          ->default_value(g_auto_clustering_max_fragments_per_merge),
+      "Fragments sorted together by each background clustering merge.");
+  developer_desc.add_options()(
+      "enable-adaptive-fragment-size",
+      po::value<bool>(&g_enable_adaptive_fragment_size)
+          ->default_value(g_enable_adaptive_fragment_size)
+          ->implicit_value(true),
+      "Pick the fragment size of new tables without a FRAGMENT_SIZE from their row "
+      "width, the target fragment bytes and the memory of the smallest GPU.");
+  developer_desc.add_options()(
+      "adaptive-fragment-target-bytes",
+      po::value<size_t>(&g_adaptive_fragment_target_bytes)
+          ->default_value(g_adaptive_fragment_target_bytes),
+      "Target bytes of all the columns of a fragment for adaptive fragment sizes.");
+  developer_desc.add_options()(
+      "enable-dictionary-encoding-widening",
+      po::value<bool>(&g_enable_dictionary_encoding_widening)
+          ->default_value(g_enable_dictionary_encoding_widening)
+          ->implicit_value(true),
+      "Widen the ids of a dictionary encoded text column, and rewrite its chunks, when a "
+      "load would add more strings than its encoding holds.");
+  developer_desc.add_options()(
+      "enable-parquet-import-chunk-loader",
+      po::value<bool>(&g_enable_parquet_import_chunk_loader)
+          ->default_value(g_enable_parquet_import_chunk_loader)
+          ->implicit_value(true),
+      "Import local parquet files by decoding their row groups in parallel with the "
+      "parquet foreign table encoders, for tables without arrays, geo or compressed "
+      "fixed length columns. Files with values the encoders reject are rolled back and "
+      "imported again value by value.");
+  developer_desc.add_options()(
+      "enable-in-subquery-semi-join",
+      po::value<bool>(&g_enable_in_subquery_semi_join)
+          ->default_value(g_enable_in_subquery_semi_join)
+          ->implicit_value(true),
+      "Run IN subqueries of filters over a single table as hash semi joins with the "
+      "subquery result, instead of building an IN set from it.");
   developer_desc.add_options()("enable-automatic-ir-metadata",
                                po::value<bool>(&g_enable_automatic_ir_metadata)
                                    ->default_value(g_enable_automatic_ir_metadata)
@@ -872,6 +1587,8 @@ void CommandLineOptions::validate() {
   }
   g_read_only = read_only;
   LOG(INFO) << " Server read-only mode is " << read_only;
+  File_Namespace::get_page_compression_codec(g_page_compression_codec);
+  LOG(INFO) << " Page compression codec is set to " << g_page_compression_codec;
   LOG(INFO) << " Watchdog is set to " << enable_watchdog;
   LOG(INFO) << " Dynamic Watchdog is set to " << enable_dynamic_watchdog;
   if (enable_dynamic_watchdog) {
@@ -955,6 +1672,17 @@ void CommandLineOptions::validate() {
     throw std::runtime_error{"vacuum-min-selectivity cannot be less than 0."};
   }
   LOG(INFO) << "Vacuum Min Selectivity: " << g_vacuum_min_selectivity;
+  if (g_auto_vacuum_min_deleted_fraction <= 0 || g_auto_vacuum_min_deleted_fraction > 1) {
+    throw std::runtime_error{
+        "auto-vacuum-min-deleted-fraction must be greater than 0 and at most 1."};
+  }
+  if (g_auto_clustering_max_fragments_per_merge < 2) {
+    throw std::runtime_error{
+        "auto-clustering-max-fragments-per-merge must be at least 2."};
+  }
+  if (g_adaptive_fragment_target_bytes == 0) {
+    throw std::runtime_error{"adaptive-fragment-target-bytes must be greater than 0."};
+  }
 }
 
 boost::optional<int> CommandLineOptions::parse_command_line(
@@ -1141,6 +1869,7 @@ boost::optional<int> CommandLineOptions::parse_command_line(
             << (authMetadata.allowLocalAuthFallback ? "enabled" : "disabled");
   LOG(INFO) << " ParallelTop min threshold: " << g_parallel_top_min;
   LOG(INFO) << " ParallelTop watchdog max: " << g_parallel_top_max;
+  LOG(INFO) << " ParallelSort min threshold: " << g_parallel_sort_min;
 
   boost::algorithm::trim_if(authMetadata.distinguishedName, boost::is_any_of("\"'"));
   boost::algorithm::trim_if(authMetadata.uri, boost::is_any_of("\"'"));
@@ -113,6 +113,18 @@ class CommandLineOptions {
 #ifdef ENABLE_GEOS
   std::string libgeos_so_filename = {"libgeos_c.so"};
 #endif
+#ifdef HAVE_ARROW_FLIGHT
+  // Port of the Arrow Flight server, 0 disables it.
+  int arrow_flight_port = 0;
+#endif
+#ifdef HAVE_THRIFT_NONBLOCKING_SERVER
+  // Port of the non-blocking Thrift server, 0 disables it.
+  int nonblocking_port = 0;
+  // Worker threads running the requests of the non-blocking Thrift server.
+  size_t nonblocking_server_threads = 16;
+#endif
+  // Port of the HTTP server of the Prometheus metrics, 0 disables it.
+  int metrics_port = 0;
 
   void fillOptions();
   void fillAdvancedOptions();
@@ -147,7 +159,9 @@ extern bool g_enable_watchdog;
 extern bool g_enable_dynamic_watchdog;
 extern unsigned g_dynamic_watchdog_time_limit;
 extern unsigned g_trivial_loop_join_threshold;
+extern size_t g_loop_join_inner_tile_bytes;
 extern bool g_from_table_reordering;
+extern bool g_enable_cost_based_join_ordering;
 extern bool g_enable_filter_push_down;
 extern bool g_allow_cpu_retry;
 extern bool g_null_div_by_zero;
@@ -157,11 +171,15 @@ extern float g_filter_push_down_low_frac;
 extern float g_filter_push_down_high_frac;
 extern size_t g_filter_push_down_passing_row_ubound;
 extern bool g_enable_columnar_output;
+extern size_t g_string_id_map_max_entries;
 extern bool g_optimize_row_initialization;
+extern bool g_enable_lazy_group_by_buffer_init;
 extern bool g_enable_overlaps_hashjoin;
+extern bool g_enable_range_joins;
 extern bool g_enable_hashjoin_many_to_many;
 extern size_t g_overlaps_max_table_size_bytes;
 extern double g_overlaps_target_entries_per_bin;
+extern size_t g_overlaps_tuning_sample_rows;
 extern bool g_strip_join_covered_quals;
 extern size_t g_constrained_by_in_threshold;
 extern size_t g_big_group_threshold;
@@ -173,10 +191,12 @@ extern bool g_enable_direct_columnarization;
 extern bool g_enable_runtime_query_interrupt;
 extern unsigned g_pending_query_interrupt_freq;
 extern double g_running_query_interrupt_freq;
+extern size_t g_cpu_interrupt_check_rows;
 extern bool g_enable_non_kernel_time_query_interrupt;
 extern size_t g_gpu_smem_threshold;
 extern bool g_enable_smem_non_grouped_agg;
 extern bool g_enable_smem_grouped_non_count_agg;
+extern size_t g_gpu_warp_agg_max_entries;
 extern bool g_use_estimator_result_cache;
 extern bool g_enable_lazy_fetch;
 
@@ -189,16 +209,99 @@ extern size_t g_max_memory_allocation_size;
 extern size_t g_min_memory_allocation_size;
 extern bool g_enable_experimental_string_functions;
 extern bool g_enable_table_functions;
+extern size_t g_table_function_partition_rows;
 extern bool g_enable_fsi;
+extern size_t g_calcite_plan_cache_size;
+extern bool g_preload_catalogs;
 extern bool g_enable_s3_fsi;
 extern bool g_enable_interop;
+extern bool g_enable_batch_interpreter;
 extern bool g_enable_union;
 extern bool g_use_tbb_pool;
+extern bool g_enable_cpu_kernel_work_stealing;
+extern bool g_enable_shared_scans;
+extern bool g_enable_persistent_code_cache;
+extern bool g_enable_background_jit;
+extern size_t g_jit_low_tier_max_rows;
+extern size_t g_jit_tier_promotion_count;
+extern bool g_enable_parallel_gpu_module_load;
+extern bool g_enable_cpu_loop_vectorization;
+extern bool g_enable_shared_cpu_group_by_buffer;
+extern bool g_enable_partitioned_group_by;
+extern size_t g_max_group_by_partitions;
+extern size_t g_query_cpu_memory_budget;
+extern size_t g_cpu_small_step_max_rows;
+extern bool g_enable_cpu_gpu_projection;
+extern bool g_enable_qual_specialization;
+extern bool g_enable_null_check_elision;
+extern size_t g_max_parallel_union_branches;
+extern bool g_enable_clustered_join_windows;
+extern size_t g_clustered_join_window_rows;
+extern bool g_enable_approx_top_k_group_by;
+extern size_t g_approx_top_k_sketch_factor;
+extern bool g_enable_pipelined_itas;
+extern bool g_enable_radix_partitioned_join_build;
+extern size_t g_radix_partitioned_join_build_partition_bytes;
+extern bool g_enable_hash_table_gpu_broadcast;
+extern double g_sparse_perfect_hash_min_density;
+extern size_t g_sparse_perfect_hash_min_entries;
+extern size_t g_hash_table_cache_max_bytes;
+extern bool g_join_key_range_fragment_skipping;
+extern bool g_enable_numa_aware_buffers;
+extern bool g_enable_huge_pages;
+extern bool g_enable_vectored_page_reads;
+extern size_t g_chunk_prefetch_depth;
+extern size_t g_data_compaction_max_bytes_per_sec;
+extern bool g_enable_chunk_index_snapshot;
+extern size_t g_checkpoint_group_commit_window_us;
+extern bool g_enable_scan_resistant_buffer_eviction;
+extern bool g_enable_buffer_pool_defragmentation;
+extern size_t g_cpu_buffer_pool_pinned_bytes;
+extern size_t g_cpu_compressed_chunk_cache_bytes;
+extern size_t g_zone_map_block_rows;
+extern bool g_enable_column_stats;
+extern bool g_enable_geo_block_bounds;
+extern size_t g_dictionary_index_max_block_values;
+extern size_t g_parquet_row_group_read_ahead;
+extern size_t g_parquet_read_part_size;
+extern size_t g_parquet_max_concurrent_part_reads;
+extern bool g_enable_parquet_row_group_zone_maps;
+extern bool g_enable_csv_read_ahead;
+extern bool g_skip_unchanged_append_refreshes;
+extern bool g_enable_columnar_delimited_import;
+extern size_t g_deferred_load_checkpoint_rows;
+extern size_t g_deferred_load_checkpoint_interval_ms;
+extern bool g_enable_parallel_column_inserts;
+extern bool g_enable_replicated_add_column_defaults;
+extern size_t g_csv_export_range_entries;
+extern size_t g_parquet_export_row_group_rows;
+extern size_t g_max_concurrent_update_fragments;
+extern size_t g_streaming_topn_max;
+extern size_t g_parallel_window_partition_min;
+extern bool g_enable_gpu_peer_access;
+extern bool g_enable_count_distinct_sparse_bitmap;
+extern size_t g_query_result_cache_max_bytes;
+extern size_t g_result_set_recycler_max_bytes;
+extern size_t g_linearized_column_cache_max_bytes;
+extern bool g_enable_gpu_query_streams;
+extern bool g_enable_query_profile;
+extern size_t g_query_profile_history_size;
 extern bool g_enable_filter_function;
 extern size_t g_max_import_threads;
+extern bool g_enable_dictionary_encoding_widening;
+extern bool g_enable_parquet_import_chunk_loader;
+extern bool g_enable_in_subquery_semi_join;
 extern bool g_enable_auto_metadata_update;
 extern bool g_allow_s3_server_privileges;
 extern float g_vacuum_min_selectivity;
+extern bool g_enable_auto_vacuum;
+extern float g_auto_vacuum_min_deleted_fraction;
+extern size_t g_auto_vacuum_max_bytes_per_pass;
+extern size_t g_auto_vacuum_interval_seconds;
+extern bool g_enable_auto_clustering;
+extern size_t g_auto_clustering_max_fragments_per_merge;
+extern bool g_enable_adaptive_fragment_size;
+extern size_t g_adaptive_fragment_target_bytes;
 extern bool g_read_only;
 extern bool g_enable_automatic_ir_metadata;
 extern size_t g_enable_parallel_linearization;
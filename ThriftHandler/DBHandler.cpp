@@ -22,6 +22,8 @@
  */
 
 #include "DBHandler.h"
+#include "ColumnBufferBuilder.h"
+#include "DeferredCheckpointScheduler.h"
 #include "DistributedLoader.h"
 #include "TokenCompletionHints.h"
 
@@ -49,6 +51,7 @@
 #include "ImportExport/Importer.h"
 #include "LockMgr/LockMgr.h"
 #include "OSDependent/omnisci_hostname.h"
+#include "OSDependent/omnisci_hugepages.h"
 #include "Parser/ParserWrapper.h"
 #include "Parser/ReservedKeywords.h"
 #include "Parser/parser.h"
@@ -58,7 +61,9 @@
 #include "QueryEngine/ExtensionFunctionsWhitelist.h"
 #include "QueryEngine/GpuMemUtils.h"
 #include "QueryEngine/JoinFilterPushDown.h"
+#include "QueryEngine/JoinHashTable/HashJoin.h"
 #include "QueryEngine/JsonAccessors.h"
+#include "QueryEngine/PersistentCodeCache.h"
 #include "QueryEngine/QueryDispatchQueue.h"
 #include "QueryEngine/ResultSetBuilder.h"
 #include "QueryEngine/TableFunctions/TableFunctionsFactory.h"
@@ -96,6 +101,8 @@
 #include <regex>
 #include <string>
 #include <thread>
+#include <thrift/protocol/TBinaryProtocol.h>
+#include <thrift/transport/TBufferTransports.h>
 #include <typeinfo>
 
 #include <arrow/api.h>
@@ -141,6 +148,9 @@ struct ForceDisconnect : public std::runtime_error {
   ForceDisconnect(const std::string& cause) : std::runtime_error(cause) {}
 };
 
+// Rows fetched from a result set at a time by the columnar conversion.
+constexpr size_t kRowBatchSize{4096};
+
 }  // namespace
 
 template <>
@@ -264,8 +274,9 @@ DBHandler::DBHandler(const std::vector<LeafHostInfo>& db_leaves,
     , authMetadata_(authMetadata)
     , system_parameters_(system_parameters)
     , legacy_syntax_(legacy_syntax)
-    , dispatch_queue_(
-          std::make_unique<QueryDispatchQueue>(system_parameters.num_executors))
+    , dispatch_queue_(std::make_unique<QueryDispatchQueue>(
+          system_parameters.num_executors,
+          system_parameters.num_low_priority_executors))
     , super_user_rights_(false)
     , idle_session_duration_(idle_session_duration * 60)
     , max_session_duration_(max_session_duration * 60)
@@ -378,6 +389,12 @@ void DBHandler::initialize(const bool is_new_db) {
     LOG(FATAL) << "Failed to initialize UDF compiler: " << e.what();
   }
 
+  try {
+    PersistentCodeCache::init(base_data_path_);
+  } catch (const std::exception& e) {
+    LOG(ERROR) << "Failed to initialize persistent code cache: " << e.what();
+  }
+
   try {
     calcite_ =
         std::make_shared<Calcite>(system_parameters_, base_data_path_, udf_ast_filename);
@@ -437,8 +454,16 @@ void DBHandler::initialize(const bool is_new_db) {
     LOG(FATAL) << "Failed to initialize system catalog: " << e.what();
   }
 
+  if (g_preload_catalogs) {
+    const auto clock_begin = timer_start();
+    const auto catalogs = SysCatalog::instance().getCatalogsForAllDbs();
+    LOG(INFO) << "Loaded the catalogs of " << catalogs.size() << " databases in "
+              << timer_stop(clock_begin) << " ms";
+  }
+
   import_path_ = boost::filesystem::path(base_data_path_) / "mapd_import";
   start_time_ = std::time(nullptr);
+  startPlannerWarmup();
 
   if (is_rendering_enabled) {
     try {
@@ -481,6 +506,109 @@ DBHandler::~DBHandler() {
   shutdown();
 }
 
+void DBHandler::startPlannerWarmup() {
+  const auto& queries_file = system_parameters_.calcite_warmup_queries_file;
+  if (queries_file.empty()) {
+    return;
+  }
+  std::ifstream queries_stream(queries_file);
+  if (!queries_stream) {
+    LOG(ERROR) << "Could not open the Calcite warmup queries file " << queries_file;
+    return;
+  }
+  std::vector<std::pair<std::string, std::string>> queries;
+  std::string line;
+  while (std::getline(queries_stream, line)) {
+    boost::algorithm::trim(line);
+    if (line.empty()) {
+      continue;
+    }
+    const auto tab_pos = line.find('\t');
+    if (tab_pos == std::string::npos) {
+      queries.emplace_back(OMNISCI_DEFAULT_DB, line);
+    } else {
+      queries.emplace_back(boost::algorithm::trim_copy(line.substr(0, tab_pos)),
+                           line.substr(tab_pos + 1));
+    }
+  }
+  if (queries.empty()) {
+    return;
+  }
+  planner_ready_ = false;
+  planner_warmup_thread_ =
+      std::thread([this, queries = std::move(queries)] { warmupPlanner(queries); });
+}
+
+void DBHandler::warmupPlanner(
+    const std::vector<std::pair<std::string, std::string>>& queries) {
+  // Calcite fetches the metadata of the tables of a query from this server, so wait for
+  // the server to accept connections first.
+  bool server_listening{false};
+  const auto wait_begin = std::chrono::steady_clock::now();
+  while (!server_listening && !stop_planner_warmup_ &&
+         std::chrono::steady_clock::now() - wait_begin < std::chrono::minutes(5)) {
+    try {
+      apache::thrift::transport::TSocket socket("localhost",
+                                                system_parameters_.omnisci_server_port);
+      socket.open();
+      socket.close();
+      server_listening = true;
+    } catch (const apache::thrift::transport::TTransportException&) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+  }
+  if (!server_listening) {
+    LOG(WARNING) << "Skipped the Calcite warmup, the server is not accepting connections";
+    planner_ready_ = true;
+    return;
+  }
+  const auto clock_begin = timer_start();
+  std::atomic<size_t> next_query_idx{0};
+  std::atomic<size_t> failed_query_count{0};
+  auto plan_queries = [&] {
+    for (auto query_idx = next_query_idx++;
+         query_idx < queries.size() && !stop_planner_warmup_;
+         query_idx = next_query_idx++) {
+      const auto& [dbname, query_str] = queries[query_idx];
+      try {
+        TSessionId session;
+        internal_connect(session, OMNISCI_ROOT_USER, dbname);
+        ScopeGuard disconnect_guard = [this, &session] {
+          try {
+            disconnect(session);
+          } catch (const std::exception& e) {
+            LOG(WARNING) << "Failed to close a Calcite warmup session: " << e.what();
+          }
+        };
+        auto query_state = create_query_state(get_session_ptr(session), query_str);
+        parse_to_ra(query_state->createQueryStateProxy(),
+                    query_str,
+                    {},
+                    false,
+                    system_parameters_,
+                    false);
+      } catch (const std::exception& e) {
+        ++failed_query_count;
+        LOG(WARNING) << "Calcite warmup query '" << query_str << "' failed: " << e.what();
+      }
+    }
+  };
+  std::vector<std::thread> planner_threads;
+  const auto thread_count =
+      std::max(std::min(system_parameters_.calcite_warmup_threads, queries.size()),
+               size_t(1));
+  for (size_t i = 0; i < thread_count; ++i) {
+    planner_threads.emplace_back(plan_queries);
+  }
+  for (auto& planner_thread : planner_threads) {
+    planner_thread.join();
+  }
+  LOG(INFO) << "Planned " << queries.size() - failed_query_count
+            << " Calcite warmup queries (" << failed_query_count << " failed) in "
+            << timer_stop(clock_begin) << " ms";
+  planner_ready_ = true;
+}
+
 void DBHandler::parser_with_error_handler(
     const std::string& query_str,
     std::list<std::unique_ptr<Parser::Stmt>>& parse_trees) {
@@ -716,6 +844,31 @@ void DBHandler::disconnect_impl(const SessionMap::iterator& session_it,
     render_group_assignment_map_.erase(session_id);
   }
 
+  // Destroyed once out of the map lock, see close_df_stream().
+  std::vector<std::shared_ptr<DataFrameStream>> df_streams;
+  {
+    std::lock_guard<std::mutex> map_lock(df_streams_mutex_);
+    for (auto it = df_streams_.begin(); it != df_streams_.end();) {
+      if (it->second->session_id == session_id) {
+        df_streams.push_back(std::move(it->second));
+        it = df_streams_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+
+  {
+    std::lock_guard<std::mutex> map_lock(prepared_statements_mutex_);
+    for (auto it = prepared_statements_.begin(); it != prepared_statements_.end();) {
+      if (it->second.session_id == session_id) {
+        it = prepared_statements_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+
   sessions_.erase(session_it);
   write_lock.unlock();
 
@@ -828,6 +981,7 @@ void DBHandler::get_server_status(TServerStatus& _return, const TSessionId& sess
   _return.role = getServerRole();
   _return.renderer_status_json =
       render_handler_ ? render_handler_->get_renderer_status_json() : "";
+  _return.ready = planner_ready_;
 }
 
 void DBHandler::get_status(std::vector<TServerStatus>& _return,
@@ -862,6 +1016,7 @@ void DBHandler::get_status(std::vector<TServerStatus>& _return,
   ret.role = getServerRole();
   ret.renderer_status_json =
       render_handler_ ? render_handler_->get_renderer_status_json() : "";
+  ret.ready = planner_ready_;
 
   _return.push_back(ret);
   if (leaf_aggregator_.leafCount() > 0) {
@@ -1045,6 +1200,34 @@ void DBHandler::value_to_thrift_column(const TargetValue& tv,
   }
 }
 
+void DBHandler::batch_to_thrift_column(ColumnBatch& batch,
+                                       const SQLTypeInfo& ti,
+                                       TColumn& column) {
+  for (const auto& tv : batch.values) {
+    value_to_thrift_column(tv, ti, column);
+  }
+  if (!batch.values.empty()) {
+    return;
+  }
+  if (ti.is_decimal()) {
+    const double divisor = ti.get_scale() > 0 ? pow(10.0, std::abs(ti.get_scale())) : 1;
+    for (const auto int_value : batch.int_values) {
+      column.data.real_col.push_back(static_cast<double>(int_value) / divisor);
+    }
+  } else {
+    column.data.int_col.insert(
+        column.data.int_col.end(), batch.int_values.begin(), batch.int_values.end());
+  }
+  column.data.real_col.insert(
+      column.data.real_col.end(), batch.double_values.begin(), batch.double_values.end());
+  column.data.real_col.insert(
+      column.data.real_col.end(), batch.float_values.begin(), batch.float_values.end());
+  column.data.str_col.insert(column.data.str_col.end(),
+                             std::make_move_iterator(batch.str_values.begin()),
+                             std::make_move_iterator(batch.str_values.end()));
+  column.nulls.insert(column.nulls.end(), batch.nulls.begin(), batch.nulls.end());
+}
+
 TDatum DBHandler::value_to_thrift(const TargetValue& tv, const SQLTypeInfo& ti) {
   TDatum datum;
   const auto scalar_tv = boost::get<ScalarTargetValue>(&tv);
@@ -1133,6 +1316,61 @@ TDatum DBHandler::value_to_thrift(const TargetValue& tv, const SQLTypeInfo& ti)
   return datum;
 }
 
+namespace {
+
+std::shared_ptr<const std::string> serialize_row_set(const TRowSet& row_set) {
+  auto buffer = std::make_shared<apache::thrift::transport::TMemoryBuffer>();
+  apache::thrift::protocol::TBinaryProtocol protocol(buffer);
+  row_set.write(&protocol);
+  return std::make_shared<const std::string>(buffer->getBufferAsString());
+}
+
+void deserialize_row_set(TRowSet& row_set, const std::string& serialized_row_set) {
+  auto buffer = std::make_shared<apache::thrift::transport::TMemoryBuffer>(
+      reinterpret_cast<uint8_t*>(const_cast<char*>(serialized_row_set.data())),
+      serialized_row_set.size());
+  apache::thrift::protocol::TBinaryProtocol protocol(buffer);
+  row_set.read(&protocol);
+}
+
+TQueryProfile convert_query_profile(const QueryProfileInfo& query_profile_info) {
+  TQueryProfile query_profile;
+  query_profile.user_name = query_profile_info.user_name;
+  query_profile.session_id = query_profile_info.public_session_id;
+  query_profile.query_str = query_profile_info.query_str;
+  query_profile.submitted = query_profile_info.submitted;
+  query_profile.compilation_time_us = query_profile_info.compilation_time_us;
+  query_profile.fetch_time_us = query_profile_info.fetch_time_us;
+  query_profile.cpu_bytes_fetched =
+      query_profile_info.fetched_bytes[Data_Namespace::CPU_LEVEL];
+  query_profile.gpu_bytes_fetched =
+      query_profile_info.fetched_bytes[Data_Namespace::GPU_LEVEL];
+  for (const auto& kernel_time : query_profile_info.kernel_times) {
+    TQueryKernelTime query_kernel_time;
+    query_kernel_time.device_type = kernel_time.device_type == ExecutorDeviceType::GPU
+                                        ? TDeviceType::GPU
+                                        : TDeviceType::CPU;
+    query_kernel_time.device_id = kernel_time.device_id;
+    query_kernel_time.kernel_count = kernel_time.kernel_count;
+    query_kernel_time.time_us = kernel_time.time_us;
+    query_profile.kernel_times.push_back(query_kernel_time);
+  }
+  query_profile.reduction_time_us = query_profile_info.reduction_time_us;
+  for (const auto& step : query_profile_info.steps) {
+    TQueryStepProfile query_step;
+    query_step.step = step.step;
+    query_step.row_count = step.row_count;
+    query_step.time_us = step.time_us;
+    query_profile.steps.push_back(query_step);
+  }
+  query_profile.code_cache_hits = query_profile_info.code_cache_hits;
+  query_profile.code_cache_misses = query_profile_info.code_cache_misses;
+  query_profile.recycled_results = query_profile_info.recycled_results;
+  return query_profile;
+}
+
+}  // namespace
+
 void DBHandler::sql_execute_local(
     TQueryResult& _return,
     const QueryStateProxy& query_state_proxy,
@@ -1142,7 +1380,8 @@ void DBHandler::sql_execute_local(
     const std::string& nonce,
     const int32_t first_n,
     const int32_t at_most_n,
-    const bool use_calcite) {
+    const bool use_calcite,
+    const TColumnEncoding::type column_encoding) {
   _return.total_time_ms = 0;
   _return.nonce = nonce;
   ParserWrapper pw{query_str};
@@ -1175,15 +1414,39 @@ void DBHandler::sql_execute_local(
   }
   ExecutionResult result;
   _return.total_time_ms += measure<>::execution([&]() {
+    // Cached results are serialized row sets, which depend on the conversion options.
+    QueryResultCache::Lookup result_cache_lookup;
+    if (g_query_result_cache_max_bytes) {
+      result_cache_lookup.key = std::to_string(column_format) + ',' +
+                                std::to_string(first_n) + ',' +
+                                std::to_string(at_most_n) + ',' +
+                                std::to_string(static_cast<int>(column_encoding)) + ':';
+    }
     DBHandler::sql_execute_impl(result,
                                 query_state_proxy,
                                 column_format,
                                 session_ptr->get_executor_device_type(),
                                 first_n,
                                 at_most_n,
-                                use_calcite);
-    DBHandler::convertData(
-        _return, result, query_state_proxy, query_str, column_format, first_n, at_most_n);
+                                use_calcite,
+                                &result_cache_lookup);
+    if (result_cache_lookup.result) {
+      deserialize_row_set(_return.row_set, *result_cache_lookup.result);
+      return;
+    }
+    DBHandler::convertData(_return,
+                           result,
+                           query_state_proxy,
+                           query_str,
+                           column_format,
+                           first_n,
+                           at_most_n,
+                           column_encoding);
+    if (!result_cache_lookup.key.empty() && !result.empty() &&
+        result.getResultType() == ExecutionResult::QueryResult) {
+      QueryResultCache::instance().put(result_cache_lookup.key,
+                                       serialize_row_set(_return.row_set));
+    }
   });
 }
 
@@ -1193,11 +1456,16 @@ void DBHandler::convertData(TQueryResult& _return,
                             const std::string& query_str,
                             const bool column_format,
                             const int32_t first_n,
-                            const int32_t at_most_n) {
+                            const int32_t at_most_n,
+                            const TColumnEncoding::type column_encoding) {
+  auto timer = DEBUG_TIMER(__func__);
   _return.execution_time_ms += result.getExecutionTime();
   if (result.empty()) {
     return;
   }
+  if (const auto& query_profile_info = result.getQueryProfileInfo()) {
+    _return.__set_profile(convert_query_profile(*query_profile_info));
+  }
 
   switch (result.getResultType()) {
     case ExecutionResult::QueryResult:
@@ -1207,7 +1475,8 @@ void DBHandler::convertData(TQueryResult& _return,
                   *result.getRows(),
                   column_format,
                   first_n,
-                  at_most_n);
+                  at_most_n,
+                  column_encoding);
       break;
     case ExecutionResult::SimpleResult:
       convertResult(_return, *result.getRows(), true);
@@ -1222,7 +1491,8 @@ void DBHandler::convertData(TQueryResult& _return,
                   *result.getRows(),
                   column_format,
                   -1,
-                  -1);
+                  -1,
+                  column_encoding);
       break;
   }
 }
@@ -1234,6 +1504,41 @@ void DBHandler::sql_execute(TQueryResult& _return,
                             const std::string& nonce,
                             const int32_t first_n,
                             const int32_t at_most_n) {
+  sql_execute(_return,
+              session,
+              query_str,
+              column_format,
+              nonce,
+              first_n,
+              at_most_n,
+              TColumnEncoding::LISTS);
+}
+
+void DBHandler::sql_execute_buffers(TQueryResult& _return,
+                                    const TSessionId& session,
+                                    const std::string& query_str,
+                                    const bool compress,
+                                    const std::string& nonce,
+                                    const int32_t first_n,
+                                    const int32_t at_most_n) {
+  sql_execute(_return,
+              session,
+              query_str,
+              true,
+              nonce,
+              first_n,
+              at_most_n,
+              compress ? TColumnEncoding::COMPRESSED_BUFFERS : TColumnEncoding::BUFFERS);
+}
+
+void DBHandler::sql_execute(TQueryResult& _return,
+                            const TSessionId& session,
+                            const std::string& query_str,
+                            const bool column_format,
+                            const std::string& nonce,
+                            const int32_t first_n,
+                            const int32_t at_most_n,
+                            const TColumnEncoding::type column_encoding) {
   const std::string exec_ra_prefix = "execute relalg";
   const bool use_calcite = !boost::starts_with(query_str, exec_ra_prefix);
   auto actual_query =
@@ -1258,6 +1563,9 @@ void DBHandler::sql_execute(TQueryResult& _return,
       if (!agg_handler_) {
         THROW_MAPD_EXCEPTION("Distributed support is disabled.");
       }
+      if (column_encoding != TColumnEncoding::LISTS) {
+        THROW_MAPD_EXCEPTION("Column buffers are not supported in distributed mode.");
+      }
       _return.total_time_ms = measure<>::execution([&]() {
         agg_handler_->cluster_execute(_return,
                                       query_state->createQueryStateProxy(),
@@ -1278,7 +1586,8 @@ void DBHandler::sql_execute(TQueryResult& _return,
                         nonce,
                         first_n,
                         at_most_n,
-                        use_calcite);
+                        use_calcite,
+                        column_encoding);
     }
     _return.total_time_ms += process_geo_copy_from(session);
     std::string debug_json = timer.stopAndGetJson();
@@ -1400,11 +1709,18 @@ void DBHandler::sql_execute_df(TDataFrame& _return,
                                const TDeviceType::type device_type,
                                const int32_t device_id,
                                const int32_t first_n,
-                               const TArrowTransport::type transport_method) {
+                               const TArrowTransport::type transport_method,
+                               const int64_t batch_rows) {
   auto session_ptr = get_session_ptr(session);
   auto query_state = create_query_state(session_ptr, query_str);
   auto stdlog = STDLOG(session_ptr, query_state);
 
+  if (batch_rows < 0) {
+    THROW_MAPD_EXCEPTION("Invalid batch_rows " + std::to_string(batch_rows));
+  }
+  if (batch_rows && device_type == TDeviceType::GPU) {
+    THROW_MAPD_EXCEPTION("Batched data frames are only supported on CPU");
+  }
   if (device_type == TDeviceType::GPU) {
     const auto executor_device_type = session_ptr->get_executor_device_type();
     if (executor_device_type != ExecutorDeviceType::GPU) {
@@ -1456,7 +1772,9 @@ void DBHandler::sql_execute_df(TDataFrame& _return,
                                                          : ExecutorDeviceType::GPU,
                          static_cast<size_t>(device_id),
                          first_n,
-                         transport_method);
+                         transport_method,
+                         static_cast<size_t>(batch_rows),
+                         locks);
       return;
     }
   } catch (std::exception& e) {
@@ -1477,7 +1795,181 @@ void DBHandler::sql_execute_gdf(TDataFrame& _return,
                  TDeviceType::GPU,
                  device_id,
                  first_n,
-                 TArrowTransport::SHARED_MEMORY);
+                 TArrowTransport::SHARED_MEMORY,
+                 0);
+}
+
+void DBHandler::get_next_df_batch(TDataFrame& _return,
+                                  const TSessionId& session,
+                                  const std::string& stream_id) {
+  auto session_ptr = get_session_ptr(session);
+  auto stdlog = STDLOG(session_ptr);
+  std::shared_ptr<DataFrameStream> stream;
+  {
+    std::lock_guard<std::mutex> map_lock(df_streams_mutex_);
+    auto it = df_streams_.find(stream_id);
+    if (it != df_streams_.end() &&
+        it->second->session_id == session_ptr->get_session_id()) {
+      stream = it->second;
+    }
+  }
+  if (!stream) {
+    THROW_MAPD_EXCEPTION("Data frame stream " + stream_id +
+                         " does not exist or has no batches left");
+  }
+  std::lock_guard<std::mutex> stream_lock(stream->mutex);
+  if (!stream->result_stream->hasMoreBatches()) {
+    THROW_MAPD_EXCEPTION("Data frame stream " + stream_id +
+                         " does not exist or has no batches left");
+  }
+  ArrowResult arrow_result;
+  try {
+    _return.arrow_conversion_time_ms = measure<>::execution(
+        [&] { arrow_result = stream->result_stream->getNextBatch(); });
+  } catch (std::exception& e) {
+    close_df_stream(session, stream_id);
+    THROW_MAPD_EXCEPTION(e.what());
+  }
+  set_data_frame(_return, arrow_result);
+  _return.execution_time_ms = 0;
+  _return.stream_id = stream_id;
+  _return.has_more_batches = stream->result_stream->hasMoreBatches();
+  if (!_return.has_more_batches) {
+    std::lock_guard<std::mutex> map_lock(df_streams_mutex_);
+    df_streams_.erase(stream_id);
+  }
+}
+
+void DBHandler::close_df_stream(const TSessionId& session, const std::string& stream_id) {
+  auto session_ptr = get_session_ptr(session);
+  auto stdlog = STDLOG(session_ptr);
+  // Streams which already returned their last batch are gone, closing them is a no-op.
+  // The stream is destroyed outside of the map lock, since that waits for the
+  // conversion of its next batch.
+  std::shared_ptr<DataFrameStream> stream;
+  {
+    std::lock_guard<std::mutex> map_lock(df_streams_mutex_);
+    auto it = df_streams_.find(stream_id);
+    if (it != df_streams_.end() &&
+        it->second->session_id == session_ptr->get_session_id()) {
+      stream = std::move(it->second);
+      df_streams_.erase(it);
+    }
+  }
+}
+
+void DBHandler::prepare(TPreparedStatement& _return,
+                        const TSessionId& session,
+                        const std::string& query) {
+  auto session_ptr = get_session_ptr(session);
+  auto stdlog = STDLOG(session_ptr);
+  PreparedStatement statement{session_ptr->get_session_id(),
+                              split_on_sql_parameter_markers(query)};
+  _return.statement_id = generate_random_string(32);
+  _return.num_params = statement.query_parts.size() - 1;
+  std::lock_guard<std::mutex> map_lock(prepared_statements_mutex_);
+  prepared_statements_.emplace(_return.statement_id, std::move(statement));
+}
+
+namespace {
+
+// Returns the SQL literal of a parameter of a prepared statement.
+std::string to_sql_literal(const TQueryParameter& param) {
+  if (param.value.is_null) {
+    return "NULL";
+  }
+  switch (param.type) {
+    case TDatumType::BOOL:
+      return param.value.val.int_val ? "TRUE" : "FALSE";
+    case TDatumType::TINYINT:
+    case TDatumType::SMALLINT:
+    case TDatumType::INT:
+    case TDatumType::BIGINT:
+      return std::to_string(param.value.val.int_val);
+    case TDatumType::FLOAT:
+    case TDatumType::DOUBLE: {
+      if (!std::isfinite(param.value.val.real_val)) {
+        THROW_MAPD_EXCEPTION("Parameter value " +
+                             std::to_string(param.value.val.real_val) +
+                             " is not a finite number.");
+      }
+      std::ostringstream oss;
+      oss << std::setprecision(std::numeric_limits<double>::max_digits10)
+          << param.value.val.real_val;
+      return oss.str();
+    }
+    case TDatumType::DECIMAL: {
+      static const boost::regex decimal_regex{R"([+-]?\d+(\.\d*)?)"};
+      if (!boost::regex_match(param.value.val.str_val, decimal_regex)) {
+        THROW_MAPD_EXCEPTION("Parameter value " + param.value.val.str_val +
+                             " is not a decimal.");
+      }
+      return param.value.val.str_val;
+    }
+    case TDatumType::STR:
+      return get_quoted_string(param.value.val.str_val, '\'', '\'');
+    case TDatumType::TIME:
+      return "TIME " + get_quoted_string(param.value.val.str_val, '\'', '\'');
+    case TDatumType::TIMESTAMP:
+      return "TIMESTAMP " + get_quoted_string(param.value.val.str_val, '\'', '\'');
+    case TDatumType::DATE:
+      return "DATE " + get_quoted_string(param.value.val.str_val, '\'', '\'');
+    default:
+      THROW_MAPD_EXCEPTION("Parameters of type " + std::to_string(param.type) +
+                           " are not supported.");
+  }
+  UNREACHABLE();
+  return "";
+}
+
+}  // namespace
+
+/**
+ * Executes the query of a prepared statement with the given parameters, bound as
+ * literals. As the literals of a query are hoisted into the literal buffer of its
+ * kernels, executing a statement again with other parameters reuses its compiled code.
+ */
+void DBHandler::execute_prepared(TQueryResult& _return,
+                                 const TSessionId& session,
+                                 const std::string& statement_id,
+                                 const std::vector<TQueryParameter>& params,
+                                 const bool column_format,
+                                 const std::string& nonce,
+                                 const int32_t first_n,
+                                 const int32_t at_most_n) {
+  std::string query;
+  {
+    auto session_ptr = get_session_ptr(session);
+    std::lock_guard<std::mutex> map_lock(prepared_statements_mutex_);
+    auto it = prepared_statements_.find(statement_id);
+    if (it == prepared_statements_.end() ||
+        it->second.session_id != session_ptr->get_session_id()) {
+      THROW_MAPD_EXCEPTION("Prepared statement " + statement_id + " does not exist.");
+    }
+    const auto& query_parts = it->second.query_parts;
+    if (params.size() != query_parts.size() - 1) {
+      THROW_MAPD_EXCEPTION("Prepared statement takes " +
+                           std::to_string(query_parts.size() - 1) + " parameters, " +
+                           std::to_string(params.size()) + " given.");
+    }
+    query = query_parts.front();
+    for (size_t i = 0; i < params.size(); ++i) {
+      query += to_sql_literal(params[i]) + query_parts[i + 1];
+    }
+  }
+  sql_execute(_return, session, query, column_format, nonce, first_n, at_most_n);
+}
+
+void DBHandler::close_prepared(const TSessionId& session,
+                               const std::string& statement_id) {
+  auto session_ptr = get_session_ptr(session);
+  auto stdlog = STDLOG(session_ptr);
+  std::lock_guard<std::mutex> map_lock(prepared_statements_mutex_);
+  auto it = prepared_statements_.find(statement_id);
+  if (it != prepared_statements_.end() &&
+      it->second.session_id == session_ptr->get_session_id()) {
+    prepared_statements_.erase(it);
+  }
 }
 
 // For now we have only one user of a data frame in all cases.
@@ -2717,6 +3209,18 @@ void DBHandler::get_memory(std::vector<TNodeMemoryInfo>& _return,
         SysCatalog::instance().getDataMgr().getMemoryInfo(MemoryLevel::CPU_LEVEL);
   }
 
+  // Cached join hash tables live in host memory, outside of the buffer pool.
+  TJoinHashTableCacheInfo join_hash_table_cache_info;
+  if (mem_level == Data_Namespace::MemoryLevel::CPU_LEVEL) {
+    const auto stats = HashJoin::getHashTableCacheStats();
+    join_hash_table_cache_info.num_entries = stats.num_entries;
+    join_hash_table_cache_info.size_bytes = stats.size_bytes;
+    join_hash_table_cache_info.max_size_bytes = g_hash_table_cache_max_bytes;
+    join_hash_table_cache_info.hits = stats.hits;
+    join_hash_table_cache_info.misses = stats.misses;
+    join_hash_table_cache_info.evictions = stats.evictions;
+  }
+
   for (auto memInfo : internal_memory) {
     TNodeMemoryInfo nodeInfo;
     if (leaf_aggregator_.leafCount() > 0) {
@@ -2726,6 +3230,10 @@ void DBHandler::get_memory(std::vector<TNodeMemoryInfo>& _return,
     nodeInfo.max_num_pages = memInfo.maxNumPages;
     nodeInfo.num_pages_allocated = memInfo.numPageAllocated;
     nodeInfo.is_allocation_capped = memInfo.isAllocationCapped;
+    nodeInfo.join_hash_table_cache = join_hash_table_cache_info;
+    nodeInfo.num_free_segments = memInfo.numFreeSegments;
+    nodeInfo.largest_free_segment_pages = memInfo.largestFreeSegmentPages;
+    nodeInfo.fragmentation_percent = memInfo.fragmentationPercent;
     for (auto gpu : memInfo.nodeMemoryData) {
       TMemoryData md;
       md.slab = gpu.slabNum;
@@ -2745,6 +3253,259 @@ void DBHandler::get_memory(std::vector<TNodeMemoryInfo>& _return,
   }
 }
 
+void DBHandler::get_query_profiles(std::vector<TQueryProfile>& _return,
+                                   const TSessionId& session) {
+  auto stdlog = STDLOG(get_session_ptr(session));
+  stdlog.appendNameValuePairs("client", getConnectionInfo().toString());
+  auto session_ptr = stdlog.getConstSessionInfo();
+  const auto& user = session_ptr->get_currentUser();
+  // Users other than super users only see the profiles of their own queries.
+  for (const auto& query_profile_info : QueryProfileHistory::instance().get()) {
+    if (user.isSuper || query_profile_info.user_name == user.userLoggable()) {
+      _return.push_back(convert_query_profile(query_profile_info));
+    }
+  }
+}
+
+namespace {
+
+void append_metric_family(std::ostringstream& oss,
+                          const std::string& name,
+                          const std::string& type,
+                          const std::string& help) {
+  oss << "# HELP " << name << " " << help << "\n";
+  oss << "# TYPE " << name << " " << type << "\n";
+}
+
+template <typename T>
+void append_metric(std::ostringstream& oss,
+                   const std::string& name,
+                   const std::string& labels,
+                   const T value) {
+  oss << name;
+  if (!labels.empty()) {
+    oss << "{" << labels << "}";
+  }
+  oss << " " << value << "\n";
+}
+
+std::string memory_level_label(const MemoryLevel memory_level, const size_t device_id) {
+  return std::string("level=\"") +
+         (memory_level == MemoryLevel::GPU_LEVEL ? "gpu" : "cpu") + "\",device=\"" +
+         std::to_string(device_id) + "\"";
+}
+
+}  // namespace
+
+std::string DBHandler::getPrometheusMetrics() {
+  std::ostringstream oss;
+  auto& data_mgr = SysCatalog::instance().getDataMgr();
+
+  std::vector<std::pair<MemoryLevel, std::vector<Data_Namespace::MemoryInfo>>>
+      memory_infos;
+  std::vector<std::vector<Buffer_Namespace::BufferPoolStats>> pool_stats;
+  for (const auto memory_level : {MemoryLevel::CPU_LEVEL, MemoryLevel::GPU_LEVEL}) {
+    memory_infos.emplace_back(memory_level, data_mgr.getMemoryInfo(memory_level));
+    pool_stats.push_back(data_mgr.getBufferPoolStatsPerDevice(memory_level));
+  }
+  append_metric_family(oss,
+                       "omnisci_buffer_pool_max_bytes",
+                       "gauge",
+                       "Maximum size of the buffer pool of a device.");
+  for (const auto& [memory_level, infos] : memory_infos) {
+    for (size_t device_id = 0; device_id < infos.size(); ++device_id) {
+      append_metric(oss,
+                    "omnisci_buffer_pool_max_bytes",
+                    memory_level_label(memory_level, device_id),
+                    infos[device_id].pageSize * infos[device_id].maxNumPages);
+    }
+  }
+  append_metric_family(oss,
+                       "omnisci_buffer_pool_allocated_bytes",
+                       "gauge",
+                       "Bytes allocated to the buffer pool of a device.");
+  for (const auto& [memory_level, infos] : memory_infos) {
+    for (size_t device_id = 0; device_id < infos.size(); ++device_id) {
+      append_metric(oss,
+                    "omnisci_buffer_pool_allocated_bytes",
+                    memory_level_label(memory_level, device_id),
+                    infos[device_id].pageSize * infos[device_id].numPageAllocated);
+    }
+  }
+  const std::vector<std::pair<std::string, size_t Buffer_Namespace::BufferPoolStats::*>>
+      pool_counters{{"hits", &Buffer_Namespace::BufferPoolStats::hits},
+                    {"misses", &Buffer_Namespace::BufferPoolStats::misses},
+                    {"evictions", &Buffer_Namespace::BufferPoolStats::evicted_chunks},
+                    {"restores", &Buffer_Namespace::BufferPoolStats::restored_chunks}};
+  for (const auto& [counter, member] : pool_counters) {
+    const auto name = "omnisci_buffer_pool_" + counter + "_total";
+    append_metric_family(
+        oss, name, "counter", "Chunk " + counter + " of the buffer pool of a device.");
+    for (size_t i = 0; i < memory_infos.size(); ++i) {
+      for (size_t device_id = 0; device_id < pool_stats[i].size(); ++device_id) {
+        append_metric(oss,
+                      name,
+                      memory_level_label(memory_infos[i].first, device_id),
+                      pool_stats[i][device_id].*member);
+      }
+    }
+  }
+  append_metric_family(oss,
+                       "omnisci_buffer_pool_retained_chunk_bytes",
+                       "gauge",
+                       "Bytes of compressed evicted chunks kept by the buffer pool.");
+  for (size_t i = 0; i < memory_infos.size(); ++i) {
+    for (size_t device_id = 0; device_id < pool_stats[i].size(); ++device_id) {
+      append_metric(oss,
+                    "omnisci_buffer_pool_retained_chunk_bytes",
+                    memory_level_label(memory_infos[i].first, device_id),
+                    pool_stats[i][device_id].retained_chunk_bytes);
+    }
+  }
+
+  const auto [code_cache_hits, code_cache_misses] = Executor::getCodeCacheLookupCounts();
+  append_metric_family(oss,
+                       "omnisci_code_cache_hits_total",
+                       "counter",
+                       "Generated code reused from the code caches of the Executors.");
+  append_metric(oss, "omnisci_code_cache_hits_total", "", code_cache_hits);
+  append_metric_family(oss,
+                       "omnisci_code_cache_misses_total",
+                       "counter",
+                       "Generated code missing from the code caches of the Executors.");
+  append_metric(oss, "omnisci_code_cache_misses_total", "", code_cache_misses);
+
+  const auto hash_table_stats = HashJoin::getHashTableCacheStats();
+  append_metric_family(oss,
+                       "omnisci_join_hash_table_cache_bytes",
+                       "gauge",
+                       "Bytes of the cached join hash tables.");
+  append_metric(
+      oss, "omnisci_join_hash_table_cache_bytes", "", hash_table_stats.size_bytes);
+  append_metric_family(oss,
+                       "omnisci_join_hash_table_cache_entries",
+                       "gauge",
+                       "Number of the cached join hash tables.");
+  append_metric(
+      oss, "omnisci_join_hash_table_cache_entries", "", hash_table_stats.num_entries);
+  append_metric_family(oss,
+                       "omnisci_join_hash_table_cache_hits_total",
+                       "counter",
+                       "Join hash tables reused from the cache.");
+  append_metric(
+      oss, "omnisci_join_hash_table_cache_hits_total", "", hash_table_stats.hits);
+  append_metric_family(oss,
+                       "omnisci_join_hash_table_cache_misses_total",
+                       "counter",
+                       "Join hash tables missing from the cache.");
+  append_metric(
+      oss, "omnisci_join_hash_table_cache_misses_total", "", hash_table_stats.misses);
+  append_metric_family(oss,
+                       "omnisci_join_hash_table_cache_evictions_total",
+                       "counter",
+                       "Join hash tables evicted from the cache.");
+  append_metric(oss,
+                "omnisci_join_hash_table_cache_evictions_total",
+                "",
+                hash_table_stats.evictions);
+
+  const auto huge_page_stats = omnisci::get_huge_page_stats();
+  append_metric_family(oss,
+                       "omnisci_huge_page_allocated_bytes",
+                       "gauge",
+                       "Bytes of the live allocations placed on huge pages, by kind.");
+  append_metric(oss,
+                "omnisci_huge_page_allocated_bytes",
+                "kind=\"hugetlb\"",
+                huge_page_stats.hugetlb_bytes);
+  append_metric(oss,
+                "omnisci_huge_page_allocated_bytes",
+                "kind=\"transparent\"",
+                huge_page_stats.transparent_bytes);
+  append_metric_family(oss,
+                       "omnisci_anon_huge_page_bytes",
+                       "gauge",
+                       "Process memory backed by transparent huge pages.");
+  append_metric(
+      oss, "omnisci_anon_huge_page_bytes", "", huge_page_stats.anon_huge_page_bytes);
+
+  if (auto disk_cache = data_mgr.getPersistentStorageMgr()->getDiskCache()) {
+    append_metric_family(oss,
+                         "omnisci_disk_cache_chunks",
+                         "gauge",
+                         "Number of the chunks in the disk cache.");
+    append_metric(oss, "omnisci_disk_cache_chunks", "", disk_cache->getNumCachedChunks());
+    append_metric_family(oss,
+                         "omnisci_disk_cache_hits_total",
+                         "counter",
+                         "Chunk fetches served by the disk cache.");
+    append_metric(
+        oss, "omnisci_disk_cache_hits_total", "", disk_cache->getNumChunkHits());
+    append_metric_family(oss,
+                         "omnisci_disk_cache_misses_total",
+                         "counter",
+                         "Chunk fetches missing from the disk cache.");
+    append_metric(
+        oss, "omnisci_disk_cache_misses_total", "", disk_cache->getNumChunkMisses());
+  }
+
+  CHECK(dispatch_queue_);
+  append_metric_family(oss,
+                       "omnisci_dispatch_queue_length",
+                       "gauge",
+                       "Number of the queries waiting for an Executor, by priority.");
+  for (const auto& [priority, priority_name] :
+       std::vector<std::pair<QueryDispatchQueue::Priority, std::string>>{
+           {QueryDispatchQueue::Priority::High, "high"},
+           {QueryDispatchQueue::Priority::Normal, "normal"},
+           {QueryDispatchQueue::Priority::Low, "low"}}) {
+    append_metric(oss,
+                  "omnisci_dispatch_queue_length",
+                  "priority=\"" + priority_name + "\"",
+                  dispatch_queue_->getQueueLength(priority));
+  }
+
+  append_metric_family(oss,
+                       "omnisci_string_dictionary_entries",
+                       "gauge",
+                       "Number of the strings of a dictionary loaded in memory.");
+  for (const auto& db : SysCatalog::instance().getAllDBMetadata()) {
+    // Only the catalogs already loaded, to not load every database on a scrape.
+    auto cat = SysCatalog::instance().getCatalog(db.dbId);
+    if (!cat) {
+      continue;
+    }
+    for (const auto& [dict_id, entry_count] : cat->getLoadedDictionaryEntryCounts()) {
+      append_metric(oss,
+                    "omnisci_string_dictionary_entries",
+                    "database=\"" + db.dbName + "\",dict_id=\"" +
+                        std::to_string(dict_id) + "\"",
+                    entry_count);
+    }
+  }
+
+  const auto checkpoint_latencies = data_mgr.getCheckpointLatencies();
+  append_metric_family(oss,
+                       "omnisci_checkpoint_latency_ms",
+                       "histogram",
+                       "Latency of the table checkpoints, in milliseconds.");
+  for (size_t i = 0; i < LatencyHistogram::kBucketBoundsMs.size(); ++i) {
+    append_metric(oss,
+                  "omnisci_checkpoint_latency_ms_bucket",
+                  "le=\"" + std::to_string(LatencyHistogram::kBucketBoundsMs[i]) + "\"",
+                  checkpoint_latencies.bucket_counts[i]);
+  }
+  append_metric(oss,
+                "omnisci_checkpoint_latency_ms_bucket",
+                "le=\"+Inf\"",
+                checkpoint_latencies.count);
+  append_metric(
+      oss, "omnisci_checkpoint_latency_ms_sum", "", checkpoint_latencies.sum_ms);
+  append_metric(
+      oss, "omnisci_checkpoint_latency_ms_count", "", checkpoint_latencies.count);
+  return oss.str();
+}
+
 void DBHandler::get_databases(std::vector<TDBInfo>& dbinfos, const TSessionId& session) {
   auto stdlog = STDLOG(get_session_ptr(session));
   stdlog.appendNameValuePairs("client", getConnectionInfo().toString());
@@ -2904,7 +3665,7 @@ void DBHandler::load_table_binary(const TSessionId& session,
     }
     auto insert_data_lock = lockmgr::InsertDataLockMgr::getWriteLockForTable(
         session_ptr->getCatalog(), table_name);
-    if (!loader->load(import_buffers, rows.size(), session_ptr.get())) {
+    if (!load_import_buffers(*loader, import_buffers, rows.size(), *session_ptr)) {
       THROW_MAPD_EXCEPTION(loader->getErrorMessage());
     }
   } catch (const std::exception& e) {
@@ -2912,6 +3673,19 @@ void DBHandler::load_table_binary(const TSessionId& session,
   }
 }
 
+bool DBHandler::load_import_buffers(
+    import_export::Loader& loader,
+    const std::vector<std::unique_ptr<import_export::TypedImportBuffer>>& import_buffers,
+    const size_t row_count,
+    const Catalog_Namespace::SessionInfo& session_info) {
+  if (leaf_aggregator_.leafCount() > 0) {
+    // Leaves checkpoint their own shards of the table.
+    return loader.load(import_buffers, row_count, &session_info);
+  }
+  return DeferredCheckpointScheduler::load(
+      loader, import_buffers, row_count, &session_info);
+}
+
 std::unique_ptr<lockmgr::AbstractLockContainer<const TableDescriptor*>>
 DBHandler::prepare_loader_generic(
     const Catalog_Namespace::SessionInfo& session_info,
@@ -3190,7 +3964,7 @@ void DBHandler::load_table_binary_columnar_internal(
   }
   auto insert_data_lock = lockmgr::InsertDataLockMgr::getWriteLockForTable(
       session_ptr->getCatalog(), table_name);
-  if (!loader->load(import_buffers, num_rows, session_ptr.get())) {
+  if (!load_import_buffers(*loader, import_buffers, num_rows, *session_ptr)) {
     THROW_MAPD_EXCEPTION(loader->getErrorMessage());
   }
 }
@@ -3252,21 +4026,39 @@ void DBHandler::load_table_binary_arrow(const TSessionId& session,
   if (batches.size() != 1) {
     THROW_MAPD_EXCEPTION("Expected a single Arrow record batch. Import aborted");
   }
-  std::shared_ptr<arrow::RecordBatch> batch = batches[0];
+  load_arrow_batch_impl(
+      *session_ptr, table_name, *batches[0], use_column_names, "load_table_binary_arrow");
+}
+
+void DBHandler::load_table_arrow_batch(const TSessionId& session,
+                                       const std::string& table_name,
+                                       const arrow::RecordBatch& batch,
+                                       const bool use_column_names) {
+  auto stdlog = STDLOG(get_session_ptr(session), "table_name", table_name);
+  auto session_ptr = stdlog.getConstSessionInfo();
+  load_arrow_batch_impl(
+      *session_ptr, table_name, batch, use_column_names, "load_table_arrow_batch");
+}
+
+void DBHandler::load_arrow_batch_impl(const Catalog_Namespace::SessionInfo& session_info,
+                                      const std::string& table_name,
+                                      const arrow::RecordBatch& batch,
+                                      const bool use_column_names,
+                                      const std::string& load_type) {
   std::unique_ptr<import_export::Loader> loader;
   std::vector<std::unique_ptr<import_export::TypedImportBuffer>> import_buffers;
   std::vector<std::string> column_names;
   if (use_column_names) {
-    column_names = batch->schema()->field_names();
+    column_names = batch.schema()->field_names();
   }
   auto schema_read_lock =
-      prepare_loader_generic(*session_ptr,
+      prepare_loader_generic(session_info,
                              table_name,
-                             static_cast<size_t>(batch->num_columns()),
+                             static_cast<size_t>(batch.num_columns()),
                              &loader,
                              &import_buffers,
                              column_names,
-                             "load_table_binary_arrow");
+                             load_type);
 
   auto desc_id_to_column_id =
       column_ids_by_names(loader->get_column_descs(), column_names);
@@ -3275,8 +4067,8 @@ void DBHandler::load_table_binary_arrow(const TSessionId& session,
   std::shared_ptr<arrow::Array> empty_array;
   {
     arrow::BooleanBuilder builder;
-    ARROW_THROW_NOT_OK(builder.Resize(batch->num_rows()));
-    ARROW_THROW_NOT_OK(builder.AppendNulls(batch->num_rows()));
+    ARROW_THROW_NOT_OK(builder.Resize(batch.num_rows()));
+    ARROW_THROW_NOT_OK(builder.AppendNulls(batch.num_rows()));
     auto status = builder.Finish(&empty_array);
     if (!status.ok()) {
       THROW_MAPD_EXCEPTION("Failed to load data: " + status.message());
@@ -3287,7 +4079,7 @@ void DBHandler::load_table_binary_arrow(const TSessionId& session,
     for (auto cd : loader->get_column_descs()) {
       int mapped_idx = desc_id_to_column_id[col_idx];
       if (mapped_idx != -1) {
-        auto& array = *batch->column(mapped_idx);
+        auto& array = *batch.column(mapped_idx);
         import_export::ArraySliceRange row_slice(0, array.length());
         num_rows = import_buffers[col_idx]->add_arrow_values(
             cd, array, true, row_slice, nullptr);
@@ -3306,8 +4098,8 @@ void DBHandler::load_table_binary_arrow(const TSessionId& session,
     THROW_MAPD_EXCEPTION(e.what());
   }
   auto insert_data_lock = lockmgr::InsertDataLockMgr::getWriteLockForTable(
-      session_ptr->getCatalog(), table_name);
-  if (!loader->load(import_buffers, num_rows, session_ptr.get())) {
+      session_info.getCatalog(), table_name);
+  if (!load_import_buffers(*loader, import_buffers, num_rows, session_info)) {
     THROW_MAPD_EXCEPTION(loader->getErrorMessage());
   }
 }
@@ -3409,7 +4201,7 @@ void DBHandler::load_table(const TSessionId& session,
     }
     auto insert_data_lock = lockmgr::InsertDataLockMgr::getWriteLockForTable(
         session_ptr->getCatalog(), table_name);
-    if (!loader->load(import_buffers, rows_completed, session_ptr.get())) {
+    if (!load_import_buffers(*loader, import_buffers, rows_completed, *session_ptr)) {
       THROW_MAPD_EXCEPTION(loader->getErrorMessage());
     }
 
@@ -5597,6 +6389,7 @@ std::vector<PushedDownFilterInfo> DBHandler::execute_rel_alg(
     execution_time_ms -= rs->getQueueTime();
   }
   _return.setExecutionTime(execution_time_ms);
+  _return.setQueryProfileInfo(ra_executor.getQueryProfileInfo());
   VLOG(1) << cat.getDataMgr().getSystemMemoryUsage();
   const auto& filter_push_down_info = _return.getPushedDownFilterInfo();
   if (!filter_push_down_info.empty()) {
@@ -5610,6 +6403,21 @@ std::vector<PushedDownFilterInfo> DBHandler::execute_rel_alg(
   return {};
 }
 
+namespace {
+
+void set_data_frame(TDataFrame& df, const ArrowResult& arrow_result) {
+  df.sm_handle =
+      std::string(arrow_result.sm_handle.begin(), arrow_result.sm_handle.end());
+  df.sm_size = arrow_result.sm_size;
+  df.df_handle =
+      std::string(arrow_result.df_handle.begin(), arrow_result.df_handle.end());
+  df.df_buffer =
+      std::string(arrow_result.df_buffer.begin(), arrow_result.df_buffer.end());
+  df.df_size = arrow_result.df_size;
+}
+
+}  // namespace
+
 void DBHandler::execute_rel_alg_df(TDataFrame& _return,
                                    const std::string& query_ra,
                                    QueryStateProxy query_state_proxy,
@@ -5617,7 +6425,9 @@ void DBHandler::execute_rel_alg_df(TDataFrame& _return,
                                    const ExecutorDeviceType device_type,
                                    const size_t device_id,
                                    const int32_t first_n,
-                                   const TArrowTransport::type transport_method) const {
+                                   const TArrowTransport::type transport_method,
+                                   const size_t batch_rows,
+                                   lockmgr::LockedTableDescriptors& locks) const {
   const auto& cat = session_info.getCatalog();
   CHECK(device_type == ExecutorDeviceType::CPU ||
         session_info.get_executor_device_type() == ExecutorDeviceType::GPU);
@@ -5670,7 +6480,7 @@ void DBHandler::execute_rel_alg_df(TDataFrame& _return,
       [&]() { result = ra_executor.executeRelAlgQuery(co, eo, false, nullptr); });
   _return.execution_time_ms -= result.getRows()->getQueueTime();
   const auto rs = result.getRows();
-  const auto converter =
+  auto converter =
       std::make_unique<ArrowResultSetConverter>(rs,
                                                 data_mgr_,
                                                 device_type,
@@ -5679,22 +6489,35 @@ void DBHandler::execute_rel_alg_df(TDataFrame& _return,
                                                 first_n,
                                                 ArrowTransport(transport_method));
   ArrowResult arrow_result;
-  _return.arrow_conversion_time_ms +=
-      measure<>::execution([&] { arrow_result = converter->getArrowResult(); });
-  _return.sm_handle =
-      std::string(arrow_result.sm_handle.begin(), arrow_result.sm_handle.end());
-  _return.sm_size = arrow_result.sm_size;
-  _return.df_handle =
-      std::string(arrow_result.df_handle.begin(), arrow_result.df_handle.end());
-  _return.df_buffer =
-      std::string(arrow_result.df_buffer.begin(), arrow_result.df_buffer.end());
+  if (batch_rows) {
+    CHECK(device_type == ExecutorDeviceType::CPU);
+    auto stream = std::make_shared<DataFrameStream>();
+    stream->session_id = session_info.get_session_id();
+    _return.arrow_conversion_time_ms += measure<>::execution([&] {
+      stream->result_stream =
+          std::make_unique<ArrowResultSetStream>(std::move(converter), batch_rows);
+      arrow_result = stream->result_stream->getNextBatch();
+    });
+    _return.has_more_batches = stream->result_stream->hasMoreBatches();
+    if (_return.has_more_batches) {
+      // The remaining batches are converted from the result set, which may lazily
+      // fetch from the tables of the query.
+      stream->locks = std::move(locks);
+      _return.stream_id = generate_random_string(32);
+      std::lock_guard<std::mutex> map_lock(df_streams_mutex_);
+      df_streams_.emplace(_return.stream_id, std::move(stream));
+    }
+  } else {
+    _return.arrow_conversion_time_ms +=
+        measure<>::execution([&] { arrow_result = converter->getArrowResult(); });
+  }
+  set_data_frame(_return, arrow_result);
   if (device_type == ExecutorDeviceType::GPU) {
     std::lock_guard<std::mutex> map_lock(handle_to_dev_ptr_mutex_);
     CHECK(!ipc_handle_to_dev_ptr_.count(_return.df_handle));
     ipc_handle_to_dev_ptr_.insert(
         std::make_pair(_return.df_handle, arrow_result.serialized_cuda_handle));
   }
-  _return.df_size = arrow_result.df_size;
 }
 
 std::vector<TargetMetaInfo> DBHandler::getTargetMetaInfo(
@@ -5734,30 +6557,75 @@ void DBHandler::convertRows(TQueryResult& _return,
                             const ResultSet& results,
                             const bool column_format,
                             const int32_t first_n,
-                            const int32_t at_most_n) {
+                            const int32_t at_most_n,
+                            const TColumnEncoding::type column_encoding) {
   query_state::Timer timer = query_state_proxy.createTimer(__func__);
   _return.row_set.row_desc = ThriftSerializers::target_meta_infos_to_thrift(targets);
   int32_t fetched{0};
   if (column_format) {
     _return.row_set.is_columnar = true;
+    _return.row_set.column_encoding = column_encoding;
     std::vector<TColumn> tcolumns(results.colCount());
+    // Columns which keep the list encoding have no buffers.
+    std::vector<std::unique_ptr<ColumnBufferBuilder>> column_buffers(results.colCount());
+    if (column_encoding != TColumnEncoding::LISTS) {
+      for (size_t i = 0; i < results.colCount(); ++i) {
+        if (ColumnBufferBuilder::isSupported(targets[i].get_type_info())) {
+          column_buffers[i] =
+              std::make_unique<ColumnBufferBuilder>(targets[i].get_type_info());
+        }
+      }
+    }
+    std::vector<ColumnBatch> batches;
     while (first_n == -1 || fetched < first_n) {
-      const auto crt_row = results.getNextRow(true, true);
-      if (crt_row.empty()) {
+      // Fetch one row past the cap, so that exceeding it is detected.
+      size_t max_rows = kRowBatchSize;
+      if (first_n != -1) {
+        max_rows = std::min(max_rows, size_t(first_n - fetched));
+      }
+      if (at_most_n >= 0) {
+        max_rows = std::min(max_rows, size_t(at_most_n - fetched + 1));
+      }
+      const auto row_count = results.getNextRowBatch(max_rows, true, true, batches);
+      if (!row_count) {
         break;
       }
-      ++fetched;
+      fetched += row_count;
       if (at_most_n >= 0 && fetched > at_most_n) {
         THROW_MAPD_EXCEPTION("The result contains more rows than the specified cap of " +
                              std::to_string(at_most_n));
       }
       for (size_t i = 0; i < results.colCount(); ++i) {
-        const auto agg_result = crt_row[i];
-        value_to_thrift_column(agg_result, targets[i].get_type_info(), tcolumns[i]);
+        if (column_buffers[i]) {
+          column_buffers[i]->append(batches[i]);
+        } else {
+          batch_to_thrift_column(batches[i], targets[i].get_type_info(), tcolumns[i]);
+        }
+      }
+    }
+    const bool compress = column_encoding == TColumnEncoding::COMPRESSED_BUFFERS;
+    std::vector<std::future<void>> compression_futures;
+    for (size_t i = 0; i < results.colCount(); ++i) {
+      if (!column_buffers[i]) {
+        continue;
+      }
+      if (compress) {
+        compression_futures.emplace_back(
+            std::async(std::launch::async, [&column_buffers, &tcolumns, i] {
+              column_buffers[i]->finish(tcolumns[i], true);
+            }));
+      } else {
+        column_buffers[i]->finish(tcolumns[i], false);
       }
     }
+    for (auto& compression_future : compression_futures) {
+      compression_future.wait();
+    }
+    for (auto& compression_future : compression_futures) {
+      compression_future.get();
+    }
     for (size_t i = 0; i < results.colCount(); ++i) {
-      _return.row_set.columns.push_back(tcolumns[i]);
+      _return.row_set.columns.push_back(std::move(tcolumns[i]));
     }
   } else {
     _return.row_set.is_columnar = false;
@@ -5886,16 +6754,106 @@ void DBHandler::check_and_invalidate_sessions(Parser::DDLStmt* ddl) {
   }
 }
 
+namespace {
+
+// Returns the part of the query result cache key given by the plan of a read query and
+// the state of the tables it reads, or an empty string if its result can't be cached.
+// Loads into the tables change their row counts and epochs, hence the key.
+std::string get_query_result_cache_key(const std::string& query_ra,
+                                       const Catalog_Namespace::Catalog& cat,
+                                       const lockmgr::LockedTableDescriptors& locks) {
+  // Operators whose results differ across executions of the same plan.
+  static const std::vector<std::string> non_deterministic_ops{"\"NOW\"",
+                                                              "\"CURRENT_DATE\"",
+                                                              "\"CURRENT_TIME\"",
+                                                              "\"CURRENT_TIMESTAMP\"",
+                                                              "\"DATETIME\"",
+                                                              "\"CURRENT_USER\"",
+                                                              "LogicalTableFunctionScan"};
+  if (locks.empty()) {
+    return {};
+  }
+  for (const auto& op : non_deterministic_ops) {
+    if (query_ra.find(op) != std::string::npos) {
+      return {};
+    }
+  }
+  std::ostringstream key;
+  key << cat.getDatabaseId();
+  std::set<int> table_ids;
+  for (const auto& lock : locks) {
+    const auto td = (*lock)();
+    // Foreign tables change without going through the server.
+    if (!td || td->isView || td->isForeignTable()) {
+      return {};
+    }
+    // The locks hold both the schema and the data lock of each table.
+    if (!table_ids.insert(td->tableId).second) {
+      continue;
+    }
+    for (const auto physical_td : cat.getPhysicalTablesDescriptors(td)) {
+      if (!physical_td->fragmenter) {
+        return {};
+      }
+      key << ':' << physical_td->tableId << ',' << physical_td->fragmenter->getNumRows();
+      if (physical_td->persistenceLevel == Data_Namespace::MemoryLevel::DISK_LEVEL) {
+        key << ','
+            << cat.getDataMgr().getTableEpoch(cat.getDatabaseId(), physical_td->tableId);
+      }
+    }
+  }
+  key << ':' << query_ra;
+  return key.str();
+}
+
+// Returns whether the user is one of the comma separated `grantees`, or was granted one
+// of them as a role.
+bool is_user_in_grantees(const std::string& user_name, const std::string& grantees) {
+  if (grantees.empty()) {
+    return false;
+  }
+  const auto& sys_catalog = Catalog_Namespace::SysCatalog::instance();
+  for (const auto& grantee : split(grantees, ",")) {
+    const auto grantee_name = strip(grantee);
+    if (!grantee_name.empty() &&
+        sys_catalog.isRoleGrantedToGrantee(user_name, grantee_name, false)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+QueryDispatchQueue::Priority get_dispatch_priority(
+    const SystemParameters& system_parameters,
+    const Catalog_Namespace::SessionInfo& session_info) {
+  const auto& user_name = session_info.get_currentUser().userName;
+  if (is_user_in_grantees(user_name, system_parameters.high_priority_query_grantees)) {
+    return QueryDispatchQueue::Priority::High;
+  }
+  if (is_user_in_grantees(user_name, system_parameters.low_priority_query_grantees)) {
+    return QueryDispatchQueue::Priority::Low;
+  }
+  return QueryDispatchQueue::Priority::Normal;
+}
+
+}  // namespace
+
 void DBHandler::sql_execute_impl(ExecutionResult& _return,
                                  QueryStateProxy query_state_proxy,
                                  const bool column_format,
                                  const ExecutorDeviceType executor_device_type,
                                  const int32_t first_n,
                                  const int32_t at_most_n,
-                                 const bool use_calcite) {
+                                 const bool use_calcite,
+                                 QueryResultCache::Lookup* result_cache_lookup) {
   if (leaf_handler_) {
     leaf_handler_->flush_queue();
   }
+  // The key is only filled in for read queries whose results can be cached.
+  std::string result_cache_key_prefix;
+  if (result_cache_lookup) {
+    result_cache_key_prefix.swap(result_cache_lookup->key);
+  }
   auto const query_str = strip(query_state_proxy.getQueryState().getQueryStr());
   auto session_ptr = query_state_proxy.getQueryState().getConstSessionInfo();
   // Call to DistributedValidate() below may change cat.
@@ -5991,6 +6949,19 @@ void DBHandler::sql_execute_impl(ExecutionResult& _return,
               .first.plan_result;
     }
     const auto explain_info = pw.getExplainInfo();
+    if (!result_cache_key_prefix.empty() && use_calcite && !explain_info.justExplain() &&
+        !explain_info.justCalciteExplain()) {
+      const auto key = get_query_result_cache_key(query_ra, cat, locks);
+      if (!key.empty()) {
+        result_cache_lookup->key = result_cache_key_prefix + key;
+        result_cache_lookup->result =
+            QueryResultCache::instance().get(result_cache_lookup->key);
+        if (result_cache_lookup->result) {
+          VLOG(1) << "Query result found in the query result cache.";
+          return;
+        }
+      }
+    }
     std::vector<PushedDownFilterInfo> filter_push_down_requests;
     auto execute_rel_alg_task = std::make_shared<QueryDispatchQueue::Task>(
         [this,
@@ -6073,7 +7044,8 @@ void DBHandler::sql_execute_impl(ExecutionResult& _return,
     }
     dispatch_queue_->submit(execute_rel_alg_task,
                             pw.getDMLType() == ParserWrapper::DMLType::Update ||
-                                pw.getDMLType() == ParserWrapper::DMLType::Delete);
+                                pw.getDMLType() == ParserWrapper::DMLType::Delete,
+                            get_dispatch_priority(system_parameters_, *session_ptr));
     auto result_future = execute_rel_alg_task->get_future();
     result_future.get();
     return;
@@ -6107,6 +7079,13 @@ void DBHandler::sql_execute_impl(ExecutionResult& _return,
         if (optimize_stmt->shouldVacuumDeletedRows()) {
           optimizer.vacuumDeletedRows();
         }
+        if (optimize_stmt->shouldClusterRows()) {
+          // Sorts each group of overlapping fragments in one merge.
+          optimizer.clusterFragments(std::numeric_limits<size_t>::max(), 0, {});
+        }
+        if (optimize_stmt->shouldCompactDictionaries()) {
+          optimizer.compactDictionaries();
+        }
         optimizer.recomputeMetadata();
       }));
       return;
@@ -6321,6 +7300,7 @@ std::pair<TPlanResult, lockmgr::LockedTableDescriptors> DBHandler::parse_to_ra(
     const SystemParameters& system_parameters,
     bool check_privileges) {
   query_state::Timer timer = query_state_proxy.createTimer(__func__);
+  auto debug_timer = DEBUG_TIMER(__func__);
   ParserWrapper pw{query_str};
   const std::string actual_query{pw.isSelectExplain() ? pw.actual_query : query_str};
   TPlanResult result;
@@ -6826,6 +7806,10 @@ void DBHandler::get_license_claims(TLicenseInfo& _return,
 }
 
 void DBHandler::shutdown() {
+  stop_planner_warmup_ = true;
+  if (planner_warmup_thread_.joinable()) {
+    planner_warmup_thread_.join();
+  }
   emergency_shutdown();
 
   if (render_handler_) {
@@ -7209,5 +8193,6 @@ void DBHandler::executeDdl(
 }
 
 void DBHandler::resizeDispatchQueue(size_t queue_size) {
-  dispatch_queue_ = std::make_unique<QueryDispatchQueue>(queue_size);
+  dispatch_queue_ = std::make_unique<QueryDispatchQueue>(
+      queue_size, system_parameters_.num_low_priority_executors);
 }
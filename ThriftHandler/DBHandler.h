@@ -47,6 +47,7 @@
 #include "QueryEngine/GpuMemUtils.h"
 #include "QueryEngine/JsonAccessors.h"
 #include "QueryEngine/QueryDispatchQueue.h"
+#include "QueryEngine/QueryResultCache.h"
 #include "QueryEngine/TableGenerations.h"
 #include "Shared/StringTransform.h"
 #include "Shared/SystemParameters.h"
@@ -95,6 +96,11 @@
 
 using namespace std::string_literals;
 
+namespace arrow {
+class RecordBatch;
+}  // namespace arrow
+
+class ArrowResultSetStream;
 class MapDAggHandler;
 class MapDLeafHandler;
 
@@ -254,6 +260,8 @@ class DBHandler : public OmniSciIf {
   void get_memory(std::vector<TNodeMemoryInfo>& _return,
                   const TSessionId& session,
                   const std::string& memory_level) override;
+  void get_query_profiles(std::vector<TQueryProfile>& _return,
+                          const TSessionId& session) override;
   void clear_cpu_memory(const TSessionId& session) override;
   void clear_gpu_memory(const TSessionId& session) override;
   void set_cur_session(const TSessionId& parent_session,
@@ -300,6 +308,13 @@ class DBHandler : public OmniSciIf {
                    const std::string& nonce,
                    const int32_t first_n,
                    const int32_t at_most_n) override;
+  void sql_execute_buffers(TQueryResult& _return,
+                           const TSessionId& session,
+                           const std::string& query,
+                           const bool compress,
+                           const std::string& nonce,
+                           const int32_t first_n,
+                           const int32_t at_most_n) override;
   void get_completion_hints(std::vector<TCompletionHint>& hints,
                             const TSessionId& session,
                             const std::string& sql,
@@ -311,7 +326,25 @@ class DBHandler : public OmniSciIf {
                       const TDeviceType::type device_type,
                       const int32_t device_id,
                       const int32_t first_n,
-                      const TArrowTransport::type transport_method) override;
+                      const TArrowTransport::type transport_method,
+                      const int64_t batch_rows) override;
+  void get_next_df_batch(TDataFrame& _return,
+                         const TSessionId& session,
+                         const std::string& stream_id) override;
+  void close_df_stream(const TSessionId& session, const std::string& stream_id) override;
+  void prepare(TPreparedStatement& _return,
+               const TSessionId& session,
+               const std::string& query) override;
+  void execute_prepared(TQueryResult& _return,
+                        const TSessionId& session,
+                        const std::string& statement_id,
+                        const std::vector<TQueryParameter>& params,
+                        const bool column_format,
+                        const std::string& nonce,
+                        const int32_t first_n,
+                        const int32_t at_most_n) override;
+  void close_prepared(const TSessionId& session,
+                      const std::string& statement_id) override;
   void sql_execute_gdf(TDataFrame& _return,
                        const TSessionId& session,
                        const std::string& query,
@@ -436,6 +469,11 @@ class DBHandler : public OmniSciIf {
                                const std::string& table_name,
                                const std::string& arrow_stream,
                                const bool use_column_names) override;
+  // Loads an Arrow record batch as load_table_binary_arrow() does for a serialized one.
+  void load_table_arrow_batch(const TSessionId& session,
+                              const std::string& table_name,
+                              const arrow::RecordBatch& batch,
+                              const bool use_column_names);
 
   void load_table(const TSessionId& session,
                   const std::string& table_name,
@@ -574,6 +612,9 @@ class DBHandler : public OmniSciIf {
 
   bool isAggregator() const;
 
+  // Buffer pool, cache and queue metrics of the server in the Prometheus text format.
+  std::string getPrometheusMetrics();
+
   std::shared_ptr<Data_Namespace::DataMgr> data_mgr_;
 
   LeafAggregator leaf_aggregator_;
@@ -630,6 +671,13 @@ class DBHandler : public OmniSciIf {
 
  private:
   std::atomic<bool> initialized_{false};
+  // Plans the queries of --calcite-warmup-queries-file in the background, the server
+  // status reports the server as not ready until they have all been planned.
+  void startPlannerWarmup();
+  void warmupPlanner(const std::vector<std::pair<std::string, std::string>>& queries);
+  std::atomic<bool> planner_ready_{true};
+  std::atomic<bool> stop_planner_warmup_{false};
+  std::thread planner_warmup_thread_;
   std::shared_ptr<Catalog_Namespace::SessionInfo> create_new_session(
       TSessionId& session,
       const std::string& dbname,
@@ -684,6 +732,9 @@ class DBHandler : public OmniSciIf {
   static void value_to_thrift_column(const TargetValue& tv,
                                      const SQLTypeInfo& ti,
                                      TColumn& column);
+  static void batch_to_thrift_column(ColumnBatch& batch,
+                                     const SQLTypeInfo& ti,
+                                     TColumn& column);
   static TDatum value_to_thrift(const TargetValue& tv, const SQLTypeInfo& ti);
   static std::string apply_copy_to_shim(const std::string& query_str);
 
@@ -704,7 +755,18 @@ class DBHandler : public OmniSciIf {
       const std::string& nonce,
       const int32_t first_n,
       const int32_t at_most_n,
-      const bool use_calcite);
+      const bool use_calcite,
+      const TColumnEncoding::type column_encoding);
+
+  // Runs sql_execute() with the given encoding of columnar results.
+  void sql_execute(TQueryResult& _return,
+                   const TSessionId& session,
+                   const std::string& query,
+                   const bool column_format,
+                   const std::string& nonce,
+                   const int32_t first_n,
+                   const int32_t at_most_n,
+                   const TColumnEncoding::type column_encoding);
 
   int64_t process_geo_copy_from(const TSessionId& session_id);
 
@@ -714,7 +776,9 @@ class DBHandler : public OmniSciIf {
                           const std::string& query_str,
                           const bool column_format,
                           const int32_t first_n,
-                          const int32_t at_most_n);
+                          const int32_t at_most_n,
+                          const TColumnEncoding::type column_encoding =
+                              TColumnEncoding::LISTS);
 
   void sql_execute_impl(ExecutionResult& _return,
                         QueryStateProxy,
@@ -722,7 +786,8 @@ class DBHandler : public OmniSciIf {
                         const ExecutorDeviceType executor_device_type,
                         const int32_t first_n,
                         const int32_t at_most_n,
-                        const bool use_calcite);
+                        const bool use_calcite,
+                        QueryResultCache::Lookup* result_cache_lookup = nullptr);
 
   bool user_can_access_table(const Catalog_Namespace::SessionInfo&,
                              const TableDescriptor* td,
@@ -766,7 +831,9 @@ class DBHandler : public OmniSciIf {
                           const ExecutorDeviceType device_type,
                           const size_t device_id,
                           const int32_t first_n,
-                          const TArrowTransport::type transport_method) const;
+                          const TArrowTransport::type transport_method,
+                          const size_t batch_rows,
+                          lockmgr::LockedTableDescriptors& locks) const;
 
   void executeDdl(TQueryResult& _return,
                   const std::string& query_ra,
@@ -811,7 +878,9 @@ class DBHandler : public OmniSciIf {
                           const ResultSet& results,
                           const bool column_format,
                           const int32_t first_n,
-                          const int32_t at_most_n);
+                          const int32_t at_most_n,
+                          const TColumnEncoding::type column_encoding =
+                              TColumnEncoding::LISTS);
 
   // Use ExecutionResult to populate a TQueryResult
   //    calls convertRows, but after some setup using session_info
@@ -884,6 +953,21 @@ class DBHandler : public OmniSciIf {
       const std::vector<std::string>& column_names,
       std::string load_type);
 
+  void load_arrow_batch_impl(const Catalog_Namespace::SessionInfo& session_info,
+                             const std::string& table_name,
+                             const arrow::RecordBatch& batch,
+                             const bool use_column_names,
+                             const std::string& load_type);
+
+  // Loads into a table through Loader::load(), with its checkpoint possibly deferred by
+  // DeferredCheckpointScheduler.
+  bool load_import_buffers(
+      import_export::Loader& loader,
+      const std::vector<std::unique_ptr<import_export::TypedImportBuffer>>&
+          import_buffers,
+      const size_t row_count,
+      const Catalog_Namespace::SessionInfo& session_info);
+
   query_state::QueryStates query_states_;
   SessionMap sessions_;
 
@@ -949,6 +1033,26 @@ class DBHandler : public OmniSciIf {
   mutable std::mutex handle_to_dev_ptr_mutex_;
   mutable std::unordered_map<std::string, std::string> ipc_handle_to_dev_ptr_;
 
+  // Batched data frames with batches left, keyed on their stream id. Each keeps the
+  // locks of its query until its last batch is returned or it is closed.
+  struct DataFrameStream {
+    TSessionId session_id;
+    lockmgr::LockedTableDescriptors locks;
+    std::mutex mutex;
+    std::unique_ptr<ArrowResultSetStream> result_stream;
+  };
+  mutable std::mutex df_streams_mutex_;
+  mutable std::unordered_map<std::string, std::shared_ptr<DataFrameStream>> df_streams_;
+
+  // Prepared statements keyed on their statement id, with the parts of their query
+  // around the parameter markers.
+  struct PreparedStatement {
+    TSessionId session_id;
+    std::vector<std::string> query_parts;
+  };
+  mutable std::mutex prepared_statements_mutex_;
+  mutable std::unordered_map<std::string, PreparedStatement> prepared_statements_;
+
   friend void run_warmup_queries(std::shared_ptr<DBHandler> handler,
                                  std::string base_path,
                                  std::string query_file_path);
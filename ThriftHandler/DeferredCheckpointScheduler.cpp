@@ -0,0 +1,184 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "DeferredCheckpointScheduler.h"
+
+#include "Catalog/SysCatalog.h"
+#include "LockMgr/LockMgr.h"
+#include "Logger/Logger.h"
+
+#include <sstream>
+
+size_t g_deferred_load_checkpoint_rows{0};
+size_t g_deferred_load_checkpoint_interval_ms{1000};
+
+void DeferredCheckpointScheduler::start(std::atomic<bool>& is_program_running) {
+  if (is_program_running && !is_scheduler_running_ && g_deferred_load_checkpoint_rows) {
+    is_scheduler_running_ = true;
+    scheduler_thread_ = std::thread([&is_program_running]() {
+      while (is_program_running && is_scheduler_running_) {
+        checkpointTables(true);
+        // Checking a few times per interval bounds how late an overdue table gets
+        // checkpointed.
+        std::unique_lock<std::mutex> wait_lock(wait_mutex_);
+        wait_condition_.wait_for(
+            wait_lock,
+            std::chrono::milliseconds(g_deferred_load_checkpoint_interval_ms / 4 + 1));
+      }
+    });
+  }
+}
+
+void DeferredCheckpointScheduler::stop() {
+  if (is_scheduler_running_) {
+    is_scheduler_running_ = false;
+    wait_condition_.notify_one();
+    scheduler_thread_.join();
+  }
+  checkpointTables(false);
+}
+
+bool DeferredCheckpointScheduler::load(
+    import_export::Loader& loader,
+    const std::vector<std::unique_ptr<import_export::TypedImportBuffer>>& import_buffers,
+    const size_t row_count,
+    const Catalog_Namespace::SessionInfo* session_info) {
+  const auto td = loader.getTableDesc();
+  if (!g_deferred_load_checkpoint_rows ||
+      td->persistenceLevel != Data_Namespace::MemoryLevel::DISK_LEVEL) {
+    return loader.load(import_buffers, row_count, session_info);
+  }
+  const std::pair<int32_t, int32_t> key{loader.getCatalog().getDatabaseId(),
+                                        td->tableId};
+  size_t deferred_row_count{0};
+  {
+    std::lock_guard<std::mutex> deferred_rows_lock(deferred_rows_mutex_);
+    auto it = deferred_rows_.find(key);
+    if (it != deferred_rows_.end()) {
+      deferred_row_count = it->second.row_count;
+    }
+  }
+  if (deferred_row_count + row_count >= g_deferred_load_checkpoint_rows) {
+    // The checkpoint of this load covers the deferred rows as well, and so does the
+    // rollback if it fails.
+    const auto loaded = loader.load(import_buffers, row_count, session_info);
+    const auto deferred_rows = takeDeferredRows(key);
+    if (!loaded) {
+      reportRolledBackRows(loader, deferred_rows);
+    }
+    return loaded;
+  }
+  if (!loader.loadNoCheckpoint(import_buffers, row_count, session_info)) {
+    // Undo whatever part of the rows made it into the table, which also rolls back the
+    // rows of earlier loads since the last checkpoint.
+    const auto deferred_rows = takeDeferredRows(key);
+    loader.setTableEpochs(loader.getTableEpochs());
+    reportRolledBackRows(loader, deferred_rows);
+    return false;
+  }
+  std::lock_guard<std::mutex> deferred_rows_lock(deferred_rows_mutex_);
+  auto it = deferred_rows_
+                .emplace(key, DeferredRows{0, 0, std::chrono::steady_clock::now()})
+                .first;
+  it->second.row_count += row_count;
+  it->second.load_count++;
+  return true;
+}
+
+size_t DeferredCheckpointScheduler::getDeferredRowCount(const int32_t db_id,
+                                                        const int32_t table_id) {
+  std::lock_guard<std::mutex> deferred_rows_lock(deferred_rows_mutex_);
+  auto it = deferred_rows_.find({db_id, table_id});
+  return it == deferred_rows_.end() ? 0 : it->second.row_count;
+}
+
+void DeferredCheckpointScheduler::checkpointDeferredTables() {
+  checkpointTables(false);
+}
+
+DeferredCheckpointScheduler::DeferredRows DeferredCheckpointScheduler::takeDeferredRows(
+    const std::pair<int32_t, int32_t>& key) {
+  std::lock_guard<std::mutex> deferred_rows_lock(deferred_rows_mutex_);
+  auto it = deferred_rows_.find(key);
+  if (it == deferred_rows_.end()) {
+    return DeferredRows{0, 0, {}};
+  }
+  const auto deferred_rows = it->second;
+  deferred_rows_.erase(it);
+  return deferred_rows;
+}
+
+void DeferredCheckpointScheduler::reportRolledBackRows(
+    import_export::Loader& loader,
+    const DeferredRows& deferred_rows) {
+  if (!deferred_rows.row_count) {
+    return;
+  }
+  std::ostringstream oss;
+  oss << "Failed load into table " << loader.getTableDesc()->tableName
+      << " rolled back " << deferred_rows.row_count << " rows of "
+      << deferred_rows.load_count
+      << " earlier loads not yet checkpointed. Those loads must be retried.";
+  LOG(ERROR) << oss.str();
+  const auto error_msg = loader.getErrorMessage();
+  loader.setErrorMessage(error_msg.empty() ? oss.str() : error_msg + " " + oss.str());
+}
+
+void DeferredCheckpointScheduler::checkpointTables(const bool overdue_only) {
+  std::vector<std::pair<int32_t, int32_t>> keys;
+  {
+    std::lock_guard<std::mutex> deferred_rows_lock(deferred_rows_mutex_);
+    const auto now = std::chrono::steady_clock::now();
+    const std::chrono::milliseconds interval{g_deferred_load_checkpoint_interval_ms};
+    for (const auto& [key, deferred_rows] : deferred_rows_) {
+      if (!overdue_only || now - deferred_rows.first_load_time >= interval) {
+        keys.emplace_back(key);
+      }
+    }
+  }
+  for (const auto& key : keys) {
+    try {
+      auto catalog = Catalog_Namespace::SysCatalog::instance().getCatalog(key.first);
+      if (!catalog || !catalog->getMetadataForTable(key.second, false)) {
+        // The table or its database was dropped along with the deferred rows.
+        takeDeferredRows(key);
+        continue;
+      }
+      // Same locks as the loads, which checkpoint the table themselves.
+      const auto td_with_lock =
+          lockmgr::TableSchemaLockContainer<lockmgr::ReadLock>::acquireTableDescriptor(
+              *catalog, key.second);
+      const auto insert_data_lock = lockmgr::InsertDataLockMgr::getWriteLockForTable(
+          *catalog, td_with_lock()->tableName);
+      // A load may have checkpointed the table while this waited for the locks.
+      if (takeDeferredRows(key).row_count) {
+        catalog->checkpointWithAutoRollback(key.second);
+      }
+    } catch (const std::exception& e) {
+      takeDeferredRows(key);
+      LOG(ERROR) << "Deferred checkpoint of table " << key.second << " in database "
+                 << key.first << " failed. " << e.what();
+    }
+  }
+}
+
+std::atomic<bool> DeferredCheckpointScheduler::is_scheduler_running_{false};
+std::thread DeferredCheckpointScheduler::scheduler_thread_;
+std::mutex DeferredCheckpointScheduler::wait_mutex_;
+std::condition_variable DeferredCheckpointScheduler::wait_condition_;
+std::mutex DeferredCheckpointScheduler::deferred_rows_mutex_;
+std::map<std::pair<int32_t, int32_t>, DeferredCheckpointScheduler::DeferredRows>
+    DeferredCheckpointScheduler::deferred_rows_;
@@ -0,0 +1,88 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "ImportExport/Importer.h"
+
+// Rows loaded into a table through the load APIs before it is checkpointed, 0
+// checkpoints after every load.
+extern size_t g_deferred_load_checkpoint_rows;
+// Time after a deferred load by which its table gets checkpointed.
+extern size_t g_deferred_load_checkpoint_interval_ms;
+
+/**
+ * Defers the checkpoint of small loads, so that tables receiving many small loads are
+ * checkpointed once per `g_deferred_load_checkpoint_rows` rows, or once per
+ * `g_deferred_load_checkpoint_interval_ms`, rather than once per load. Deferred rows are
+ * visible to queries right away, but are rolled back by a crash or by a failed load into
+ * the same table before the next checkpoint. The error of such a load reports the
+ * earlier loads and rows it rolled back.
+ */
+class DeferredCheckpointScheduler {
+ public:
+  static void start(std::atomic<bool>& is_program_running);
+
+  // Checkpoints the tables with deferred rows, then stops the scheduler thread.
+  static void stop();
+
+  /**
+   * Loads the import buffers into the table of `loader` as Loader::load() does,
+   * checkpointing the table only if it has reached the row threshold. The caller must
+   * hold the insert data write lock of the table.
+   */
+  static bool load(
+      import_export::Loader& loader,
+      const std::vector<std::unique_ptr<import_export::TypedImportBuffer>>&
+          import_buffers,
+      const size_t row_count,
+      const Catalog_Namespace::SessionInfo* session_info);
+
+  // The following methods are for testing purposes only
+  static size_t getDeferredRowCount(const int32_t db_id, const int32_t table_id);
+  static void checkpointDeferredTables();
+
+ private:
+  struct DeferredRows {
+    size_t row_count;
+    size_t load_count;
+    std::chrono::steady_clock::time_point first_load_time;
+  };
+
+  // Returns the loads and rows deferred for the table and forgets them.
+  static DeferredRows takeDeferredRows(const std::pair<int32_t, int32_t>& key);
+  // Adds the deferred loads rolled back by a failed load to its error message.
+  static void reportRolledBackRows(import_export::Loader& loader,
+                                   const DeferredRows& deferred_rows);
+  static void checkpointTables(const bool overdue_only);
+
+  static std::atomic<bool> is_scheduler_running_;
+  static std::thread scheduler_thread_;
+  static std::mutex wait_mutex_;
+  static std::condition_variable wait_condition_;
+  // Rows loaded since the last checkpoint, keyed on database and table ids.
+  static std::mutex deferred_rows_mutex_;
+  static std::map<std::pair<int32_t, int32_t>, DeferredRows> deferred_rows_;
+};
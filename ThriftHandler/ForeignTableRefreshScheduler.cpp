@@ -20,6 +20,8 @@
 #include "LockMgr/LockMgr.h"
 #include "QueryEngine/ExternalCacheInvalidators.h"
 
+bool g_skip_unchanged_append_refreshes{false};
+
 namespace foreign_storage {
 
 void ForeignTableRefreshScheduler::invalidateQueryEngineCaches() {
@@ -51,8 +53,29 @@ void ForeignTableRefreshScheduler::start(std::atomic<bool>& is_program_running)
             if (!is_program_running || !is_scheduler_running_) {
               return;
             }
+            const std::pair<int32_t, int32_t> table_id{catalog->getCurrentDB().dbId,
+                                                       table->tableId};
+            std::optional<size_t> files_signature;
+            if (g_skip_unchanged_append_refreshes) {
+              auto foreign_table = dynamic_cast<const ForeignTable*>(table);
+              CHECK(foreign_table);
+              if (foreign_table->isAppendMode()) {
+                files_signature = get_foreign_table_files_signature(*foreign_table);
+              }
+            }
+            if (files_signature) {
+              auto it = table_files_signatures_.find(table_id);
+              if (it != table_files_signatures_.end() && it->second == *files_signature) {
+                // Nothing was appended, only move on to the next refresh time.
+                catalog->updateForeignTableRefreshTimes(table->tableId);
+                continue;
+              }
+            }
             try {
               refresh_foreign_table(*catalog, table->tableName, false);
+              if (files_signature) {
+                table_files_signatures_[table_id] = *files_signature;
+              }
             } catch (std::runtime_error& e) {
               LOG(ERROR) << "Scheduled refresh for table \"" << table->tableName
                          << "\" resulted in an error. " << e.what();
@@ -109,4 +132,6 @@ std::thread ForeignTableRefreshScheduler::scheduler_thread_;
 std::atomic<bool> ForeignTableRefreshScheduler::has_refreshed_table_{false};
 std::mutex ForeignTableRefreshScheduler::wait_mutex_;
 std::condition_variable ForeignTableRefreshScheduler::wait_condition_;
+std::map<std::pair<int32_t, int32_t>, size_t>
+    ForeignTableRefreshScheduler::table_files_signatures_;
 }  // namespace foreign_storage
@@ -18,10 +18,14 @@
 
 #include <atomic>
 #include <condition_variable>
+#include <map>
 #include <mutex>
 #include <string>
 #include <thread>
 
+// Skips scheduled refreshes of append mode tables whose files have not changed.
+extern bool g_skip_unchanged_append_refreshes;
+
 namespace foreign_storage {
 class ForeignTableRefreshScheduler {
  public:
@@ -42,5 +46,8 @@ class ForeignTableRefreshScheduler {
   static std::atomic<bool> has_refreshed_table_;
   static std::mutex wait_mutex_;
   static std::condition_variable wait_condition_;
+  // File signatures of append mode tables at their last scheduled refresh, keyed on
+  // database and table ids. Only accessed by the scheduler thread.
+  static std::map<std::pair<int32_t, int32_t>, size_t> table_files_signatures_;
 };
 }  // namespace foreign_storage
@@ -0,0 +1,131 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ThriftHandler/MetricsServer.h"
+
+#include <istream>
+#include <sstream>
+
+#include "Logger/Logger.h"
+
+namespace {
+
+// Requests are a request line and headers, anything longer is not a scrape.
+constexpr size_t kMaxRequestBytes{8192};
+
+}  // namespace
+
+struct MetricsServer::Connection {
+  explicit Connection(boost::asio::io_context& io_context)
+      : socket(io_context), request(kMaxRequestBytes) {}
+
+  boost::asio::ip::tcp::socket socket;
+  boost::asio::streambuf request;
+  std::string response;
+};
+
+MetricsServer::MetricsServer(MetricsRenderer render_metrics)
+    : render_metrics_(std::move(render_metrics)), acceptor_(io_context_) {
+  CHECK(render_metrics_);
+}
+
+void MetricsServer::init(const int port) {
+  const boost::asio::ip::tcp::endpoint endpoint(boost::asio::ip::tcp::v4(), port);
+  acceptor_.open(endpoint.protocol());
+  acceptor_.set_option(boost::asio::ip::tcp::acceptor::reuse_address(true));
+  acceptor_.bind(endpoint);
+  acceptor_.listen();
+  accept();
+}
+
+void MetricsServer::serve() {
+  io_context_.run();
+}
+
+void MetricsServer::stop() {
+  io_context_.stop();
+}
+
+void MetricsServer::accept() {
+  auto connection = std::make_shared<Connection>(io_context_);
+  acceptor_.async_accept(connection->socket,
+                         [this, connection](const boost::system::error_code& ec) {
+                           if (!ec) {
+                             readRequest(connection);
+                           } else if (ec == boost::asio::error::operation_aborted) {
+                             return;
+                           } else {
+                             LOG(WARNING) << "Metrics server accept failed: "
+                                          << ec.message();
+                           }
+                           accept();
+                         });
+}
+
+void MetricsServer::readRequest(std::shared_ptr<Connection> connection) {
+  boost::asio::async_read_until(
+      connection->socket,
+      connection->request,
+      "\r\n\r\n",
+      [this, connection](const boost::system::error_code& ec, size_t) {
+        if (ec) {
+          if (ec == boost::asio::error::not_found) {
+            writeResponse(connection, "413 Payload Too Large", "text/plain", "");
+          }
+          return;
+        }
+        std::istream request_stream(&connection->request);
+        std::string method, target;
+        request_stream >> method >> target;
+        if (method != "GET") {
+          writeResponse(connection, "405 Method Not Allowed", "text/plain", "");
+        } else if (target != "/metrics") {
+          writeResponse(connection, "404 Not Found", "text/plain", "");
+        } else {
+          std::string metrics;
+          try {
+            metrics = render_metrics_();
+          } catch (const std::exception& e) {
+            LOG(ERROR) << "Failed to render the metrics: " << e.what();
+            writeResponse(connection, "500 Internal Server Error", "text/plain", "");
+            return;
+          }
+          writeResponse(
+              connection, "200 OK", "text/plain; version=0.0.4; charset=utf-8", metrics);
+        }
+      });
+}
+
+void MetricsServer::writeResponse(std::shared_ptr<Connection> connection,
+                                  const std::string& status,
+                                  const std::string& content_type,
+                                  const std::string& body) {
+  std::ostringstream oss;
+  oss << "HTTP/1.1 " << status << "\r\n"
+      << "Content-Type: " << content_type << "\r\n"
+      << "Content-Length: " << body.size() << "\r\n"
+      << "Connection: close\r\n\r\n"
+      << body;
+  connection->response = oss.str();
+  boost::asio::async_write(
+      connection->socket,
+      boost::asio::buffer(connection->response),
+      [connection](const boost::system::error_code& ec, size_t) {
+        boost::system::error_code ignored_ec;
+        connection->socket.shutdown(boost::asio::ip::tcp::socket::shutdown_both,
+                                    ignored_ec);
+      });
+}
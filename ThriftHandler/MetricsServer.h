@@ -0,0 +1,60 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <boost/asio.hpp>
+
+#include <functional>
+#include <memory>
+#include <string>
+
+/**
+ * Minimal HTTP server answering GET /metrics with the metrics of the server in the
+ * Prometheus text exposition format, so that a Prometheus server can scrape them without
+ * a Thrift client. The metrics are rendered on each request by the given function.
+ *
+ * Requests are served one at a time on the thread calling serve(); scrapes are few and
+ * rendering the metrics only reads counters, so it does not need worker threads.
+ */
+class MetricsServer {
+ public:
+  using MetricsRenderer = std::function<std::string()>;
+
+  explicit MetricsServer(MetricsRenderer render_metrics);
+
+  // Binds the server to `port`, throws if the port can not be bound.
+  void init(const int port);
+
+  // Serves requests until stop().
+  void serve();
+
+  void stop();
+
+ private:
+  struct Connection;
+
+  void accept();
+  void readRequest(std::shared_ptr<Connection> connection);
+  void writeResponse(std::shared_ptr<Connection> connection,
+                     const std::string& status,
+                     const std::string& content_type,
+                     const std::string& body);
+
+  MetricsRenderer render_metrics_;
+  boost::asio::io_context io_context_;
+  boost::asio::ip::tcp::acceptor acceptor_;
+};
@@ -29,7 +29,9 @@
 #include <clang/Tooling/Tooling.h>
 #include <llvm/Support/Program.h>
 #include <llvm/Support/raw_ostream.h>
+#include <boost/functional/hash.hpp>
 #include <boost/process/search_path.hpp>
+#include <fstream>
 #include <iterator>
 #include <memory>
 #include "clang/Basic/Version.h"
@@ -315,6 +317,27 @@ std::pair<std::string, std::string> UdfCompiler::compileUdf(
                              " does not exist.");
   }
 
+  // Reuse the artifacts of a previous compilation of the same preprocessed source with
+  // the same compiler and options
+  const auto cache_key = getCacheKey(udf_file_name);
+  const auto cache_key_file_name = genCacheKeyFilename(udf_file_name);
+  if (!cache_key.empty() && boost::filesystem::exists(cache_key_file_name)) {
+    std::ifstream cache_key_file(cache_key_file_name);
+    std::string cached_key, cached_cuda_file_name;
+    std::getline(cache_key_file, cached_key);
+    std::getline(cache_key_file, cached_cuda_file_name);
+    const auto cpu_file_name = genLLVMIRFilename(udf_file_name);
+    if (cached_key == cache_key &&
+        boost::filesystem::exists(getAstFileName(udf_file_name)) &&
+        boost::filesystem::exists(cpu_file_name) &&
+        (cached_cuda_file_name.empty() ||
+         boost::filesystem::exists(cached_cuda_file_name))) {
+      LOG(INFO) << "Using the cached compilation of UDF file " << udf_file_name;
+      return std::make_pair(cpu_file_name, cached_cuda_file_name);
+    }
+  }
+  boost::filesystem::remove(cache_key_file_name);
+
   // create the AST file  for the input function
   generateAST(udf_file_name);
 
@@ -334,6 +357,10 @@ std::pair<std::string, std::string> UdfCompiler::compileUdf(
                e.what();
   }
 #endif
+  if (!cache_key.empty()) {
+    std::ofstream cache_key_file(cache_key_file_name);
+    cache_key_file << cache_key << "\n" << cuda_file_name << "\n";
+  }
   return std::make_pair(cpu_file_name, cuda_file_name);
 }
 
@@ -377,6 +404,43 @@ std::string UdfCompiler::genLLVMIRFilename(const std::string& udf_file_name) {
   return remove_file_extension(udf_file_name) + "_cpu.bc";
 }
 
+std::string UdfCompiler::genCacheKeyFilename(const std::string& udf_file_name) {
+  return remove_file_extension(udf_file_name) + "_cache.key";
+}
+
+std::string UdfCompiler::getCacheKey(const std::string& udf_file_name) const {
+  // The preprocessed source covers the headers included by the UDF file as well
+  const auto preprocessed_file_name = remove_file_extension(udf_file_name) + "_pp.cpp";
+  std::vector<std::string> command_line{clang_path_,
+                                        "-E",
+                                        "-o",
+                                        preprocessed_file_name,
+                                        "-std=c++14",
+                                        "-DNO_BOOST",
+                                        udf_file_name};
+  boost::filesystem::remove(preprocessed_file_name);
+  const auto status = compileFromCommandLine(command_line);
+  if (status != 0 || !boost::filesystem::exists(preprocessed_file_name)) {
+    LOG(WARNING) << "Failed to preprocess UDF file " << udf_file_name
+                 << ", its compilation will not be cached";
+    return "";
+  }
+  std::ifstream preprocessed_file(preprocessed_file_name);
+  const std::string preprocessed_source{std::istreambuf_iterator<char>(preprocessed_file),
+                                        std::istreambuf_iterator<char>()};
+  preprocessed_file.close();
+  boost::filesystem::remove(preprocessed_file_name);
+
+  size_t key = std::hash<std::string>{}(preprocessed_source);
+  boost::hash_combine(key, exec_output(clang_path_ + " --version"));
+  boost::hash_combine(key, clang_options_);
+#ifdef HAVE_CUDA
+  boost::hash_combine(key, CudaMgr_Namespace::CudaMgr::deviceArchToSM(target_arch_));
+  boost::hash_combine(key, get_cuda_home());
+#endif
+  return std::to_string(key);
+}
+
 int UdfCompiler::compileFromCommandLine(
     const std::vector<std::string>& command_line) const {
   UdfClangDriver compiler_driver = UdfClangDriver::init(clang_path_);
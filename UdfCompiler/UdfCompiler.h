@@ -41,6 +41,10 @@ class UdfCompiler {
    * files on disk. Three artifacts will be generated; the AST file, the CPU LLVM IR, and
    * GPU LLVM IR (if CUDA is enabled and compilation succeeds). These LLVM IR files can be
    * loaded by the Executor. The AST will be processed by Calcite.
+   *
+   * The artifacts are reused, without calling clang to compile them again, when the
+   * preprocessed source, the clang binary and options and the GPU target are the same as
+   * for the artifacts found on disk.
    */
   std::pair<std::string, std::string> compileUdf(const std::string& udf_file_name) const;
 
@@ -54,6 +58,13 @@ class UdfCompiler {
 
   static std::string genLLVMIRFilename(const std::string& udf_file_name);
   static std::string genNVVMIRFilename(const std::string& udf_file_name);
+  static std::string genCacheKeyFilename(const std::string& udf_file_name);
+
+  /**
+   * Returns the key of the compilation of the UDF file, a hash of its preprocessed source
+   * and the compiler setup, or an empty string if the file can not be preprocessed.
+   */
+  std::string getCacheKey(const std::string& udf_file_name) const;
 
   /**
    * Formulate Clang command line command and call clang binary to generate LLVM IR for
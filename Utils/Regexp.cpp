@@ -26,7 +26,82 @@
 
 #ifndef __CUDACC__
 #include <boost/regex.hpp>
+#include <cstring>
+#include <memory>
 #include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+namespace {
+
+// Patterns compiled by a thread, regexp_like runs once per row so compiling the pattern
+// on each call dominates the match for most patterns.
+constexpr size_t kMaxCachedRegexps{64};
+
+struct CompiledRegexp {
+  std::unique_ptr<boost::regex> re;  // null if the pattern does not compile
+  // Literal every matched string starts with, checked before running the regex.
+  std::string prefix;
+  // The pattern has no metacharacters, a match is a string equal to it.
+  bool is_literal{false};
+};
+
+bool is_regexp_metachar(const char c) {
+  return std::strchr("\\^$.[]|()*+?{}", c) != nullptr;
+}
+
+bool is_regexp_quantifier(const char c) {
+  return c == '*' || c == '+' || c == '?' || c == '{';
+}
+
+// The literal prefix of an extended regex, empty if there is an alternation since the
+// prefix then only holds for the first branch.
+void find_literal_prefix(const std::string& pattern, CompiledRegexp& compiled) {
+  if (pattern.find('|') != std::string::npos) {
+    return;
+  }
+  size_t pos = !pattern.empty() && pattern.front() == '^' ? 1 : 0;
+  const auto literal_begin = pos;
+  while (pos < pattern.size() && !is_regexp_metachar(pattern[pos])) {
+    ++pos;
+  }
+  if (pos == pattern.size() && literal_begin == 0) {
+    compiled.prefix = pattern;
+    compiled.is_literal = true;
+    return;
+  }
+  auto literal_end = pos;
+  if (pos < pattern.size() && is_regexp_quantifier(pattern[pos]) &&
+      literal_end > literal_begin) {
+    // The quantifier applies to the last literal character.
+    --literal_end;
+  }
+  compiled.prefix = pattern.substr(literal_begin, literal_end - literal_begin);
+}
+
+const CompiledRegexp& get_compiled_regexp(const char* pattern, const int32_t pat_len) {
+  thread_local std::unordered_map<std::string, CompiledRegexp> compiled_regexps;
+  std::string pattern_str(pattern, pat_len);
+  auto it = compiled_regexps.find(pattern_str);
+  if (it != compiled_regexps.end()) {
+    return it->second;
+  }
+  if (compiled_regexps.size() >= kMaxCachedRegexps) {
+    compiled_regexps.clear();
+  }
+  CompiledRegexp compiled;
+  try {
+    compiled.re = std::make_unique<boost::regex>(
+        pattern_str.data(), pattern_str.size(), boost::regex::extended);
+    find_literal_prefix(pattern_str, compiled);
+  } catch (std::runtime_error& error) {
+    compiled.re.reset();
+  }
+  return compiled_regexps.emplace(std::move(pattern_str), std::move(compiled))
+      .first->second;
+}
+
+}  // namespace
 #endif
 
 /*
@@ -44,11 +119,22 @@ extern "C" RUNTIME_EXPORT DEVICE bool regexp_like(const char* str,
                                                   const int32_t pat_len,
                                                   const char escape_char) {
 #ifndef __CUDACC__
+  const auto& compiled = get_compiled_regexp(pattern, pat_len);
+  if (!compiled.re) {
+    return false;
+  }
+  const auto prefix_len = static_cast<int32_t>(compiled.prefix.size());
+  if (compiled.is_literal) {
+    return str_len == prefix_len &&
+           std::memcmp(str, compiled.prefix.data(), prefix_len) == 0;
+  }
+  if (str_len < prefix_len || std::memcmp(str, compiled.prefix.data(), prefix_len)) {
+    return false;
+  }
   bool result;
   try {
-    boost::regex re(pattern, pat_len, boost::regex::extended);
     boost::cmatch what;
-    result = boost::regex_match(str, str + str_len, what, re);
+    result = boost::regex_match(str, str + str_len, what, *compiled.re);
   } catch (std::runtime_error& error) {
     // LOG(ERROR) << "Regexp match error: " << error.what();
     result = false;
@@ -0,0 +1,77 @@
+#.rst:
+# FindThriftNonblocking.cmake
+# -------------
+#
+# Find the Thrift non-blocking server library and libevent, which it runs on.
+#
+# This module finds if ThriftNonblocking is installed and selects a default
+# configuration to use.
+#
+# find_package(ThriftNonblocking ...)
+#
+#
+# The following variables control which libraries are found::
+#
+#   ThriftNonblocking_USE_STATIC_LIBS  - Set to ON to force use of static libraries.
+#
+# The following are set after the configuration is done:
+#
+# ::
+#
+#   ThriftNonblocking_FOUND            - Set to TRUE if ThriftNonblocking was found.
+#   ThriftNonblocking_LIBRARIES        - Path to the thriftnb and libevent libraries.
+#   ThriftNonblocking_LIBRARY_DIRS     - compile time link directories
+#   ThriftNonblocking_INCLUDE_DIRS     - compile time include directories
+#
+#
+# Sample usage:
+#
+# ::
+#
+#    find_package(ThriftNonblocking)
+#    if(ThriftNonblocking_FOUND)
+#      target_link_libraries(<YourTarget> ${ThriftNonblocking_LIBRARIES})
+#    endif()
+
+if(ThriftNonblocking_USE_STATIC_LIBS)
+  set(_CMAKE_FIND_LIBRARY_SUFFIXES ${CMAKE_FIND_LIBRARY_SUFFIXES})
+  set(CMAKE_FIND_LIBRARY_SUFFIXES .lib .a ${CMAKE_FIND_LIBRARY_SUFFIXES})
+endif()
+
+
+find_library(ThriftNonblocking_LIBRARY
+  NAMES thriftnb
+  HINTS
+  ENV LD_LIBRARY_PATH
+  ENV DYLD_LIBRARY_PATH
+  PATHS
+  /usr/lib
+  /usr/local/lib
+  /usr/local/homebrew/lib
+  /opt/local/lib)
+
+find_library(ThriftNonblocking_EVENT_LIBRARY
+  NAMES event
+  HINTS
+  ENV LD_LIBRARY_PATH
+  ENV DYLD_LIBRARY_PATH
+  PATHS
+  /usr/lib
+  /usr/local/lib
+  /usr/local/homebrew/lib
+  /opt/local/lib)
+
+if(ThriftNonblocking_USE_STATIC_LIBS)
+  set(CMAKE_FIND_LIBRARY_SUFFIXES ${_CMAKE_FIND_LIBRARY_SUFFIXES})
+endif()
+
+get_filename_component(ThriftNonblocking_LIBRARY_DIR ${ThriftNonblocking_LIBRARY} DIRECTORY)
+
+# Set standard CMake FindPackage variables if found.
+set(ThriftNonblocking_LIBRARIES ${ThriftNonblocking_LIBRARY} ${ThriftNonblocking_EVENT_LIBRARY})
+set(ThriftNonblocking_LIBRARY_DIRS ${ThriftNonblocking_LIBRARY_DIR})
+set(ThriftNonblocking_INCLUDE_DIRS ${ThriftNonblocking_LIBRARY_DIR}/../include)
+
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(ThriftNonblocking REQUIRED_VARS ThriftNonblocking_LIBRARY
+  ThriftNonblocking_EVENT_LIBRARY)
@@ -918,3 +918,26 @@ SqlDdl SqlAlterUser(Span s) :
     }
 }
 
+
+/*
+ * Defragment the CPU or GPU buffer pools using the following syntax:
+ *
+ * DEFRAGMENT CPU MEMORY
+ * DEFRAGMENT GPU MEMORY
+ */
+SqlDdl SqlDefragmentMemory(Span s) :
+{
+    String memoryLevel;
+}
+{
+    <DEFRAGMENT>
+    (
+        <CPU> { memoryLevel = "CPU"; }
+    |
+        <GPU> { memoryLevel = "GPU"; }
+    )
+    <MEMORY>
+    {
+        return new SqlDefragmentMemory(s.end(this), memoryLevel);
+    }
+}
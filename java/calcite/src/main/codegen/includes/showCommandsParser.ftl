@@ -99,6 +99,22 @@ SqlDdl SqlShowQueries(Span s) :
     }
 }
 
+/*
+ * Show the profiles of the most recent queries using the following syntax:
+ *
+ * SHOW QUERY PROFILES
+ */
+
+SqlDdl SqlShowQueryProfiles(Span s) :
+{
+}
+{
+    <SHOW> <QUERY> <PROFILES>
+    {
+        return new SqlShowQueryProfiles(s.end(this));
+    }
+}
+
 SqlDdl SqlShowDiskCacheUsage(Span s) : {
     SqlIdentifier tableName = null;
     List<String> tableNames = new ArrayList<String>();
@@ -0,0 +1,39 @@
+package com.mapd.parser.extension.ddl;
+import static java.util.Objects.requireNonNull;
+
+import com.google.gson.annotations.Expose;
+
+import org.apache.calcite.sql.*;
+import org.apache.calcite.sql.parser.SqlParserPos;
+
+import java.util.List;
+
+/**
+ * Class that encapsulates all information associated with a DEFRAGMENT MEMORY DDL
+ * command.
+ */
+public class SqlDefragmentMemory extends SqlDdl implements JsonSerializableDdl {
+  private static final SqlOperator OPERATOR =
+          new SqlSpecialOperator("DEFRAGMENT_MEMORY", SqlKind.OTHER_DDL);
+  @Expose
+  private String command;
+  @Expose
+  private String memoryLevel;
+
+  public SqlDefragmentMemory(final SqlParserPos pos, final String memoryLevel) {
+    super(OPERATOR, pos);
+    requireNonNull(memoryLevel);
+    this.command = OPERATOR.getName();
+    this.memoryLevel = memoryLevel;
+  }
+
+  @Override
+  public List<SqlNode> getOperandList() {
+    return null;
+  }
+
+  @Override
+  public String toString() {
+    return toJsonString();
+  }
+}
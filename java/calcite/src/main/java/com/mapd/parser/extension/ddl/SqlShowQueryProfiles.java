@@ -0,0 +1,15 @@
+package com.mapd.parser.extension.ddl;
+
+import org.apache.calcite.sql.SqlKind;
+import org.apache.calcite.sql.SqlOperator;
+import org.apache.calcite.sql.SqlSpecialOperator;
+import org.apache.calcite.sql.parser.SqlParserPos;
+
+public class SqlShowQueryProfiles extends SqlShowCommand {
+  private static final SqlOperator OPERATOR =
+          new SqlSpecialOperator("SHOW_QUERY_PROFILES", SqlKind.OTHER_DDL);
+
+  public SqlShowQueryProfiles(final SqlParserPos pos) {
+    super(OPERATOR, pos);
+  }
+}
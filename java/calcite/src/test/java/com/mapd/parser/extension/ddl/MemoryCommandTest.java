@@ -0,0 +1,33 @@
+package com.mapd.parser.extension.ddl;
+
+import static org.junit.Assert.assertEquals;
+
+import com.google.gson.JsonObject;
+import com.omnisci.thrift.calciteserver.TPlanResult;
+
+import org.junit.Test;
+
+public class MemoryCommandTest extends DDLTest {
+  public MemoryCommandTest() {
+    resourceDirPath = MemoryCommandTest.class.getClassLoader().getResource("").getPath();
+    jsonTestDir = "memorycommands";
+  }
+
+  @Test
+  public void defragmentCpuMemory() throws Exception {
+    final JsonObject expectedJsonObject = getJsonFromFile("defragment_cpu_memory.json");
+    final TPlanResult result = processDdlCommand("DEFRAGMENT CPU MEMORY;");
+    final JsonObject actualJsonObject =
+            gson.fromJson(result.plan_result, JsonObject.class);
+    assertEquals(expectedJsonObject, actualJsonObject);
+  }
+
+  @Test
+  public void defragmentGpuMemory() throws Exception {
+    final JsonObject expectedJsonObject = getJsonFromFile("defragment_gpu_memory.json");
+    final TPlanResult result = processDdlCommand("DEFRAGMENT GPU MEMORY;");
+    final JsonObject actualJsonObject =
+            gson.fromJson(result.plan_result, JsonObject.class);
+    assertEquals(expectedJsonObject, actualJsonObject);
+  }
+}
@@ -69,6 +69,15 @@ public class ShowCommandTest extends DDLTest {
     assertEquals(expectedJsonObject, actualJsonObject);
   }
 
+  @Test
+  public void showQueryProfiles() throws Exception {
+    final JsonObject expectedJsonObject = getJsonFromFile("show_query_profiles.json");
+    final TPlanResult result = processDdlCommand("SHOW QUERY PROFILES;");
+    final JsonObject actualJsonObject =
+            gson.fromJson(result.plan_result, JsonObject.class);
+    assertEquals(expectedJsonObject, actualJsonObject);
+  }
+
   @Test
   public void showTableDetails() throws Exception {
     final JsonObject expectedJsonObject = getJsonFromFile("show_table_details.json");
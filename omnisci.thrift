@@ -75,6 +75,19 @@ struct TRow {
   1: list<TDatum> cols;
 }
 
+/* How the values of a TColumn are encoded. With LISTS they are in data and nulls. With
+   BUFFERS, columns of scalar types instead have their values in values as little-endian
+   fixed-width values of the column type (doubles for decimals), or as the concatenated
+   bytes of the strings delimited by offsets, n + 1 little-endian i32 starting with 0.
+   The nulls are a bitmap with the bit of each null row set, empty if there are none.
+   COMPRESSED_BUFFERS are BUFFERS with each non-empty buffer compressed as a Blosc
+   frame. Array and geo columns keep their values in data and nulls. */
+enum TColumnEncoding {
+  LISTS,
+  BUFFERS,
+  COMPRESSED_BUFFERS
+}
+
 /* union */ struct TColumnData {
   1: list<i64> int_col;
   2: list<double> real_col;
@@ -85,6 +98,9 @@ struct TRow {
 struct TColumn {
   1: TColumnData data;
   2: list<bool> nulls;
+  3: binary values;
+  4: binary offsets;
+  5: binary null_bitmap;
 }
 
 struct TStringRow {
@@ -121,6 +137,7 @@ struct TRowSet {
   2: list<TRow> rows;
   3: list<TColumn> columns;
   4: bool is_columnar;
+  5: TColumnEncoding column_encoding=TColumnEncoding.LISTS;
 }
 
 enum TQueryType {
@@ -136,6 +153,36 @@ enum TArrowTransport {
   WIRE
 }
 
+struct TQueryKernelTime {
+  1: common.TDeviceType device_type;
+  2: i32 device_id;
+  3: i64 kernel_count;
+  4: i64 time_us;
+}
+
+struct TQueryStepProfile {
+  1: string step;
+  2: i64 row_count;
+  3: i64 time_us;
+}
+
+struct TQueryProfile {
+  1: string user_name;
+  2: string session_id;
+  3: string query_str;
+  4: string submitted;
+  5: i64 compilation_time_us;
+  6: i64 fetch_time_us;
+  7: i64 cpu_bytes_fetched;
+  8: i64 gpu_bytes_fetched;
+  9: list<TQueryKernelTime> kernel_times;
+  10: i64 reduction_time_us;
+  11: list<TQueryStepProfile> steps;
+  12: i64 code_cache_hits;
+  13: i64 code_cache_misses;
+  14: i64 recycled_results;
+}
+
 struct TQueryResult {
   1: TRowSet row_set;
   2: i64 execution_time_ms;
@@ -144,6 +191,17 @@ struct TQueryResult {
   5: string debug;
   6: bool success=true;
   7: TQueryType query_type=TQueryType.UNKNOWN;
+  8: optional TQueryProfile profile;
+}
+
+struct TPreparedStatement {
+  1: string statement_id;
+  2: i32 num_params;
+}
+
+struct TQueryParameter {
+  1: common.TDatumType type;
+  2: TDatum value;
 }
 
 struct TDataFrame {
@@ -154,6 +212,8 @@ struct TDataFrame {
   5: i64 execution_time_ms;
   6: i64 arrow_conversion_time_ms;
   7: binary df_buffer;
+  8: string stream_id;
+  9: bool has_more_batches=false;
 }
 
 struct TDBInfo {
@@ -228,6 +288,7 @@ struct TServerStatus {
   7: bool poly_rendering_enabled;
   8: TRole role;
   9: string renderer_status_json;
+  10: bool ready = true;
 }
 
 struct TPixel {
@@ -284,6 +345,15 @@ struct TMemoryData {
   7: bool is_free;
 }
 
+struct TJoinHashTableCacheInfo {
+  1: i64 num_entries;
+  2: i64 size_bytes;
+  3: i64 max_size_bytes;
+  4: i64 hits;
+  5: i64 misses;
+  6: i64 evictions;
+}
+
 struct TNodeMemoryInfo {
   1: string host_name;
   2: i64 page_size;
@@ -291,6 +361,10 @@ struct TNodeMemoryInfo {
   4: i64 num_pages_allocated;
   5: bool is_allocation_capped;
   6: list<TMemoryData> node_memory_data;
+  7: TJoinHashTableCacheInfo join_hash_table_cache;
+  8: i64 num_free_segments;
+  9: i64 largest_free_segment_pages;
+  10: i64 fragmentation_percent;
 }
 
 struct TTableMeta {
@@ -567,6 +641,7 @@ service OmniSci {
   void stop_heap_profile(1: TSessionId session) throws (1: TOmniSciException e)
   string get_heap_profile(1: TSessionId session) throws (1: TOmniSciException e)
   list<TNodeMemoryInfo> get_memory(1: TSessionId session, 2: string memory_level) throws (1: TOmniSciException e)
+  list<TQueryProfile> get_query_profiles(1: TSessionId session) throws (1: TOmniSciException e)
   void clear_cpu_memory(1: TSessionId session) throws (1: TOmniSciException e)
   void clear_gpu_memory(1: TSessionId session) throws (1: TOmniSciException e)
   void set_cur_session(1: TSessionId parent_session, 2: TSessionId leaf_session, 3: string start_time_str, 4: string label) throws (1: TOmniSciException e)
@@ -580,7 +655,13 @@ service OmniSci {
   TSessionInfo get_session_info(1: TSessionId session) throws (1: TOmniSciException e)
   # query, render
   TQueryResult sql_execute(1: TSessionId session, 2: string query, 3: bool column_format, 4: string nonce, 5: i32 first_n = -1, 6: i32 at_most_n = -1) throws (1: TOmniSciException e)
-  TDataFrame sql_execute_df(1: TSessionId session, 2: string query, 3: common.TDeviceType device_type, 4: i32 device_id = 0, 5: i32 first_n = -1, 6: TArrowTransport transport_method) throws (1: TOmniSciException e)
+  TQueryResult sql_execute_buffers(1: TSessionId session, 2: string query, 3: bool compress = false, 4: string nonce, 5: i32 first_n = -1, 6: i32 at_most_n = -1) throws (1: TOmniSciException e)
+  TDataFrame sql_execute_df(1: TSessionId session, 2: string query, 3: common.TDeviceType device_type, 4: i32 device_id = 0, 5: i32 first_n = -1, 6: TArrowTransport transport_method, 7: i64 batch_rows = 0) throws (1: TOmniSciException e)
+  TDataFrame get_next_df_batch(1: TSessionId session, 2: string stream_id) throws (1: TOmniSciException e)
+  void close_df_stream(1: TSessionId session, 2: string stream_id) throws (1: TOmniSciException e)
+  TPreparedStatement prepare(1: TSessionId session, 2: string query) throws (1: TOmniSciException e)
+  TQueryResult execute_prepared(1: TSessionId session, 2: string statement_id, 3: list<TQueryParameter> params, 4: bool column_format, 5: string nonce, 6: i32 first_n = -1, 7: i32 at_most_n = -1) throws (1: TOmniSciException e)
+  void close_prepared(1: TSessionId session, 2: string statement_id) throws (1: TOmniSciException e)
   TDataFrame sql_execute_gdf(1: TSessionId session, 2: string query, 3: i32 device_id = 0, 4: i32 first_n = -1) throws (1: TOmniSciException e)
   void deallocate_df(1: TSessionId session, 2: TDataFrame df, 3: common.TDeviceType device_type, 4: i32 device_id = 0) throws (1: TOmniSciException e)
   void interrupt(1: TSessionId query_session, 2: TSessionId interrupt_session) throws (1: TOmniSciException e)